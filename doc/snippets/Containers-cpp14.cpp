@@ -0,0 +1,67 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstdint>
+
+#include "Corrade/Containers/StaticArray.h"
+#include "Corrade/Utility/Algorithms.h"
+
+using namespace Corrade;
+
+/* [StaticArray-constexpr] */
+constexpr Containers::StaticArray<256, std::uint32_t> crc32Table() {
+    Containers::StaticArray<256, std::uint32_t> out{Containers::ValueInit};
+    for(std::uint32_t i = 0; i != out.size(); ++i) {
+        std::uint32_t c = i;
+        for(int k = 0; k != 8; ++k)
+            c = c & 1 ? 0xedb88320u ^ (c >> 1) : c >> 1;
+        out[i] = c;
+    }
+    return out;
+}
+
+constexpr std::uint8_t reverseBits(std::uint8_t value) {
+    std::uint8_t out = 0;
+    for(int i = 0; i != 8; ++i) out |= ((value >> i) & 1) << (7 - i);
+    return out;
+}
+
+constexpr Containers::StaticArray<256, std::uint8_t> bitReverseTable() {
+    Containers::StaticArray<256, std::uint8_t> out{Containers::ValueInit};
+    for(std::size_t i = 0; i != out.size(); ++i) out[i] = i;
+    Utility::transform(Containers::staticArrayView(out),
+                       Containers::staticArrayView(out), reverseBits);
+    return out;
+}
+
+/* Calculated at compile time, no static initializers involved */
+constexpr Containers::StaticArray<256, std::uint32_t> Crc32Table = crc32Table();
+constexpr Containers::StaticArray<256, std::uint8_t> BitReverseTable = bitReverseTable();
+/* [StaticArray-constexpr] */
+
+int main() {
+    static_assert(Crc32Table[1] == 0x77073096u, "");
+    static_assert(BitReverseTable[1] == 0x80, "");
+}
@@ -30,15 +30,36 @@
 #include <unistd.h>
 #endif
 
+#include "Corrade/Containers/AllocationTracking.h"
 #include "Corrade/Containers/Array.h"
+#include "Corrade/Containers/ArrayArena.h"
+#include "Corrade/Containers/ArrayRecycler.h"
+#include "Corrade/Containers/ArrayTuple.h"
+#if defined(CORRADE_TARGET_UNIX) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+#include "Corrade/Containers/ArrayFileAllocator.h"
+#endif
+#include "Corrade/Containers/ArrayMappedAllocator.h"
+#include "Corrade/Containers/BigEnumSet.hpp"
+#include "Corrade/Containers/BitArray.h"
+#include "Corrade/Containers/ConcurrentArrayAppender.h"
+#include "Corrade/Containers/ConcurrentQueue.h"
 #include "Corrade/Containers/GrowableArray.h"
+#include "Corrade/Containers/HashMap.h"
 #include "Corrade/Containers/EnumSet.hpp"
 #include "Corrade/Containers/LinkedList.h"
+#include "Corrade/Containers/ObjectPool.h"
 #include "Corrade/Containers/Optional.h"
 #include "Corrade/Containers/Pointer.h"
+#include "Corrade/Containers/RingBuffer.h"
 #include "Corrade/Containers/ScopeGuard.h"
+#include "Corrade/Containers/SharedArray.h"
+#include "Corrade/Containers/SlotMap.h"
+#include "Corrade/Containers/SmallArray.h"
 #include "Corrade/Containers/StaticArray.h"
+#include "Corrade/Containers/StaticStridedArrayView.h"
 #include "Corrade/Containers/StridedArrayView.h"
+#include "Corrade/Containers/String.h"
+#include "Corrade/Containers/StringView.h"
 #include "Corrade/Utility/Debug.h"
 #include "Corrade/Utility/Directory.h"
 
@@ -58,6 +79,39 @@ CORRADE_ENUMSET_OPERATORS(Features)
 /* [EnumSet-usage] */
 }
 
+namespace OptionalSentinelNamespace { struct MeshIndex; }
+/* [OptionalSentinel] */
+namespace OptionalSentinelNamespace {
+    struct MeshIndex {
+        unsigned int value;
+    };
+}
+
+namespace Corrade { namespace Containers {
+
+template<> struct OptionalSentinel<OptionalSentinelNamespace::MeshIndex> {
+    static OptionalSentinelNamespace::MeshIndex value() {
+        return OptionalSentinelNamespace::MeshIndex{~0u};
+    }
+    static bool isEmpty(const OptionalSentinelNamespace::MeshIndex& index) {
+        return index.value == ~0u;
+    }
+};
+
+}}
+
+/* sizeof(Containers::Optional<MeshIndex>) == sizeof(MeshIndex) */
+/* [OptionalSentinel] */
+
+namespace Other {
+/* [BasicArrayMappedAllocator-alias] */
+template<class T> using HugeInterleavedAllocator =
+    Containers::BasicArrayMappedAllocator<T,
+        Utility::Memory::PageSize::TransparentHuge,
+        Utility::Memory::NumaNodeInterleaved>;
+/* [BasicArrayMappedAllocator-alias] */
+}
+
 /* [EnumSet-friend] */
 class Application {
     private:
@@ -98,6 +152,34 @@ Utility::Debug& operator<<(Utility::Debug& debug, Features value) {
 }
 /* [enumSetDebugOutput] */
 
+namespace BigEnumSetNamespace {
+/* [BigEnumSet-usage] */
+enum class Component: unsigned char {
+    Position = 0,
+    Velocity = 1,
+    Mesh = 2,
+    // ...
+    Collider = 199
+};
+
+typedef Containers::BigEnumSet<Component> Components;
+CORRADE_ENUMSET_OPERATORS(Components)
+
+constexpr Components MovableMesh = Component::Position|Component::Velocity|Component::Mesh;
+/* [BigEnumSet-usage] */
+
+Utility::Debug& operator<<(Utility::Debug& debug, const Components& value);
+/* [bigEnumSetDebugOutput] */
+// already defined to print values as e.g. Component::Mesh and
+// Component(0xab) for unknown values
+Utility::Debug& operator<<(Utility::Debug&, Component);
+
+Utility::Debug& operator<<(Utility::Debug& debug, const Components& value) {
+    return Containers::bigEnumSetDebugOutput(debug, value, "Components{}");
+}
+/* [bigEnumSetDebugOutput] */
+}
+
 namespace LL1 {
 class Object;
 /* [LinkedList-list-pointer] */
@@ -229,6 +311,18 @@ Containers::Array<char, UnmapBuffer> array{data, bufferSize, UnmapBuffer{buffer}
 #pragma GCC diagnostic pop
 #endif
 
+{
+/* [Array-stateless-deleter] */
+// Just a pointer and a size, no deleter stored
+Containers::Array<float, Containers::ArrayNewDeleter<float>> a{Containers::ValueInit, 16};
+static_assert(sizeof(a) == 2*sizeof(void*), "");
+
+// Converting to an array with the default deleter
+Containers::Array<float> b = std::move(a);
+/* [Array-stateless-deleter] */
+static_cast<void>(b);
+}
+
 {
 struct Face {
     int vertexCount;
@@ -253,6 +347,39 @@ for(const Face& face: mesh) {
 /* [Array-growable] */
 }
 
+{
+std::FILE* file{};
+/* [Array-growable-noinit] */
+Containers::Array<char> data;
+std::size_t read;
+do {
+    /* Read directly into the newly added tail, then trim what wasn't used */
+    Containers::ArrayView<char> chunk = Containers::arrayAppend(data,
+        Containers::NoInit, 4096);
+    read = std::fread(chunk.data(), 1, chunk.size(), file);
+    Containers::arrayRemoveSuffix(data, chunk.size() - read);
+} while(read);
+
+/* Put a header in front */
+Containers::arrayInsert(data, 0, {'D', 'A', 'T', 'A'});
+/* [Array-growable-noinit] */
+}
+
+{
+struct Entity { bool dead; };
+/* [Array-growable-remove] */
+Containers::Array<Entity> entities;
+
+/* Remove the second entity, order of the rest doesn't matter */
+Containers::arrayRemoveUnordered(entities, 1);
+
+/* Remove all dead entities, keeping the order */
+Containers::arrayRemoveIf(entities, [](const Entity& entity) {
+    return entity.dead;
+});
+/* [Array-growable-remove] */
+}
+
 {
 /* [Array-growable-sanitizer] */
 Containers::Array<int> a;
@@ -271,6 +398,371 @@ arrayAppend(floats, 37.0f);
 /* [arrayAllocatorCast] */
 }
 
+{
+/* [ArrayGrowthAllocator] */
+/* Huge array, grows linearly by 64 MB once it's over 64 MB */
+Containers::Array<char> vertexData;
+Containers::arrayAppend<char, Containers::ArrayGrowthAllocator<
+    Containers::ArrayMallocAllocator<char>,
+    Containers::ArrayCappedLinearGrowth<64*1024*1024>>>(vertexData, 'a');
+
+/* Can be appended to with the default allocator again, without any copy */
+Containers::arrayAppend(vertexData, 'b');
+/* [ArrayGrowthAllocator] */
+}
+
+{
+/* [ArrayAlignedAllocator] */
+/* The front is aligned to 32 bytes for AVX loads and stores */
+Containers::Array<float> samples;
+Containers::arrayResize<float, Containers::ArrayAlignedAllocator<float, 32>>(
+    samples, Containers::NoInit, 1024);
+/* [ArrayAlignedAllocator] */
+}
+
+{
+/* [ArrayMappedAllocator] */
+Containers::Array<char> data;
+for(std::size_t i = 0; i != 2048; ++i) {
+    /* Growing the array to 2 GB in 1 MB steps never copies */
+    Containers::arrayResize<Containers::ArrayMappedAllocator>(data,
+        Containers::NoInit, (i + 1)*1024*1024);
+    // …
+}
+/* [ArrayMappedAllocator] */
+}
+
+{
+/* [AllocationTracking] */
+/* Estimates how many bytes are allocated with each tag */
+struct Profiler {
+    std::size_t sampleRate;
+    std::ptrdiff_t meshBytes;
+} profiler{16, 0};
+
+Containers::setAllocationTracker([](void* state, Containers::AllocationEvent event, const void*, const void*, std::size_t size, const char* tag) {
+    Profiler& profiler = *static_cast<Profiler*>(state);
+    if(!tag || tag != Containers::StringView{"meshes"}) return;
+    if(event == Containers::AllocationEvent::Allocate)
+        profiler.meshBytes += size*profiler.sampleRate;
+    else if(event == Containers::AllocationEvent::Deallocate)
+        profiler.meshBytes -= size*profiler.sampleRate;
+}, &profiler, profiler.sampleRate);
+
+{
+    Containers::ScopedAllocationTag tag{"meshes"};
+    // load the meshes …
+}
+/* [AllocationTracking] */
+Containers::setAllocationTracker(nullptr);
+}
+
+#if defined(CORRADE_TARGET_UNIX) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+{
+struct Record {
+    std::uint64_t timestamp;
+    float value;
+};
+std::uint64_t timestamp{};
+float value{};
+/* [ArrayFileAllocator] */
+/* Opens the log, creating it if it doesn't exist yet */
+Containers::Array<Record> log =
+    Containers::arrayMapFile<Record>("measurements.bin");
+
+/* Appends directly to the file */
+Containers::arrayAppend<Containers::ArrayFileAllocator>(log,
+    Record{timestamp, value});
+
+/* Once the array is destroyed, the file contains exactly log.size() records */
+/* [ArrayFileAllocator] */
+}
+#endif
+
+{
+using Other::HugeInterleavedAllocator;
+/* [BasicArrayMappedAllocator] */
+// A large table accessed from threads running on all NUMA nodes
+Containers::Array<float> table;
+Containers::arrayResize<HugeInterleavedAllocator>(table,
+    Containers::ValueInit, 64*1024*1024);
+/* [BasicArrayMappedAllocator] */
+}
+
+{
+struct Consumer {
+    void consume(Containers::SharedArray<char>) {}
+} compressor, hasher;
+/* [SharedArray] */
+/* Adopts the file contents without copying them */
+Containers::SharedArray<char> data = Utility::Directory::read("image.png");
+
+/* Both consumers share the same data, freed after the last one is done */
+compressor.consume(data);
+hasher.consume(data);
+
+/* Views work the same as with Array */
+Containers::ArrayView<const char> header = Containers::arrayView(data).prefix(8);
+/* [SharedArray] */
+static_cast<void>(header);
+}
+
+{
+/* [SmallArray] */
+/* Up to four indices are stored inline, no allocation happens */
+Containers::SmallArray<4, int> indices;
+indices.append(3);
+indices.append({5, 7, 11});
+
+/* The fifth one moves everything to a heap allocation */
+indices.append(13);
+
+for(int i: indices) Utility::Debug{} << i;
+/* [SmallArray] */
+}
+
+{
+Containers::StringView file;
+/* [StringView] */
+/* Each line and each key and value is just a view into the file data,
+   nothing gets copied or allocated except for the two arrays */
+for(Containers::StringView line: file.splitWithoutEmptyParts('\n')) {
+    Containers::StaticArray<3, Containers::StringView> keyValue =
+        line.trimmed().partition('=');
+    if(keyValue[0].hasPrefix('#')) continue;
+
+    Utility::Debug{} << keyValue[0].trimmed() << "is" << keyValue[2].trimmed();
+}
+/* [StringView] */
+}
+
+{
+/* [StringView-lazySplit] */
+/* Print the third column of each line in a log file. Nothing is allocated,
+   parts after the third one are not even searched for. */
+const Containers::Array<const char, Utility::Directory::MapDeleter> log =
+    Utility::Directory::mapRead("access.log");
+for(Containers::StringView line: Containers::StringView{log}.lazySplit('\n')) {
+    std::size_t column = 0;
+    for(Containers::StringView field: line.lazySplitWithoutEmptyParts()) {
+        if(++column != 3) continue;
+        Utility::Debug{} << field;
+        break;
+    }
+}
+/* [StringView-lazySplit] */
+}
+
+{
+/* [StringView-literal] */
+using namespace Containers::Literals;
+
+constexpr Containers::StringView hello = "hello"_s;
+static_assert(hello.size() == 5, "");
+/* [StringView-literal] */
+}
+
+{
+/* [String] */
+/* Stored inline, no allocation */
+Containers::String a = "short";
+
+/* Allocated, the output size is calculated upfront */
+Containers::String b = Containers::StringView{", "}.join({a, "and a rather long one"});
+/* [String] */
+}
+
+{
+Containers::String string;
+/* [String-algorithms] */
+Containers::StringView extension = Containers::StringView{string}.rpartition('.')[2];
+/* [String-algorithms] */
+static_cast<void>(extension);
+}
+
+{
+/* [ArrayArena] */
+Containers::ArrayArena arena;
+for(std::size_t frame = 0; frame != 100; ++frame) {
+    Containers::ArrayArenaScope scope{arena};
+
+    /* All growable arrays using the arena allocator are a pointer bump */
+    Containers::Array<int> indices;
+    for(int i = 0; i != 1000; ++i)
+        Containers::arrayAppend<Containers::ArrayArenaAllocator>(indices, i);
+
+    // …
+
+    /* Free everything at once at the end of the frame */
+    indices = nullptr;
+    arena.reset();
+}
+/* [ArrayArena] */
+}
+
+{
+std::size_t size{};
+/* [ArrayRecycler] */
+/* Cap the memory kept around by this worker thread */
+Containers::ArrayRecycler::current().setMaxCachedSize(64*1024*1024);
+
+for(std::size_t job = 0; job != 100; ++job) {
+    /* After the first iteration, the memory is taken from the cache */
+    Containers::Array<char> scratch =
+        Containers::recycledArray<char>(Containers::NoInit, size);
+
+    // …
+}
+
+/* Release everything when the worker goes idle */
+Containers::ArrayRecycler::current().trim();
+/* [ArrayRecycler] */
+}
+
+{
+/* [ArrayRecyclingAllocator] */
+Containers::Array<int> indices;
+for(int i = 0; i != 1000; ++i)
+    Containers::arrayAppend<Containers::ArrayRecyclingAllocator>(indices, i);
+/* [ArrayRecyclingAllocator] */
+}
+
+{
+struct Vector3 { float x, y, z; };
+/* [ArrayTuple] */
+Containers::ArrayView<Vector3> positions;
+Containers::ArrayView<Vector3> normals;
+Containers::ArrayView<std::uint32_t> indices;
+Containers::ArrayTuple data{
+    {Containers::NoInit, 1000, positions},
+    {Containers::NoInit, 1000, normals},
+    /* Aligned to a cache line */
+    {Containers::ValueInit, 3000, 64, indices}
+};
+
+/* The views point into a single allocation now */
+positions[0] = {1.0f, 0.0f, 0.0f};
+indices[2] = 7;
+/* [ArrayTuple] */
+
+/* [ArrayTuple-release] */
+std::size_t size = data.size();
+Containers::Array<char> array{data.release(), size, Containers::ArrayTuple::deleter()};
+/* [ArrayTuple-release] */
+static_cast<void>(normals);
+}
+
+{
+/* [HashMap] */
+Containers::HashMap<Containers::String, int> counts;
+for(Containers::StringView word: Containers::StringView{"a b a c b a"}.split(' ')) {
+    /* Looking up by a view doesn't allocate, only inserting does */
+    if(int* count = counts.find(word)) ++*count;
+    else counts.insert(word, 1);
+}
+
+for(const Containers::HashMapEntry<Containers::String, int>& entry: counts)
+    Utility::Debug{} << entry.key() << entry.value();
+/* [HashMap] */
+}
+
+{
+std::uint64_t visible[16]{}, dirty[16]{};
+/* [BitArrayView] */
+/* Views on existing bit masks, 1024 entities each */
+Containers::MutableBitArrayView visibleBits{visible, 0, 1024};
+Containers::BitArrayView dirtyBits{dirty, 0, 1024};
+
+/* Update only entities that are both visible and dirty */
+visibleBits.andWith(dirtyBits);
+Utility::Debug{} << visibleBits.count() << "entities to update";
+visibleBits.forEachSet([](std::size_t i) {
+    // update entity i …
+    static_cast<void>(i);
+});
+/* [BitArrayView] */
+}
+
+{
+/* [BitArray] */
+Containers::BitArray flags;
+for(std::size_t i = 0; i != 100; ++i)
+    flags.append(i % 3 == 0);
+
+std::size_t firstUnset = Containers::BitArrayView{flags}.findFirstUnset();
+/* [BitArray] */
+static_cast<void>(firstUnset);
+}
+
+{
+std::FILE* file{};
+/* [RingBuffer] */
+Containers::RingBuffer<char> buffer{4096};
+// fill the buffer …
+
+/* Write everything that's in the buffer with at most two calls */
+std::pair<Containers::ArrayView<char>, Containers::ArrayView<char>> data = buffer.readable();
+std::fwrite(data.first.data(), 1, data.first.size(), file);
+std::fwrite(data.second.data(), 1, data.second.size(), file);
+buffer.consume(data.first.size() + data.second.size());
+/* [RingBuffer] */
+}
+
+{
+/* [SlotMap] */
+struct Particle {
+    float position, velocity;
+};
+Containers::SlotMap<Particle> particles;
+
+/* The handle stays valid until the particle is erased */
+Containers::SlotMapHandle spark = particles.insert({0.0f, 1.5f});
+
+/* The update loop goes over a contiguous array */
+for(Particle& particle: particles)
+    particle.position += particle.velocity;
+
+if(particles[spark].position > 1.0f)
+    particles.erase(spark);
+/* [SlotMap] */
+}
+
+{
+/* [SpscQueue] */
+Containers::SpscQueue<float> queue{1024};
+
+/* On the producer thread, a whole batch is published at once */
+float samples[256]{};
+Containers::ArrayView<const float> pending = samples;
+while(!pending.empty())
+    pending = pending.suffix(queue.push(pending));
+
+/* On the consumer thread, take whatever is available */
+float received[64];
+std::size_t count = queue.pop(received);
+/* [SpscQueue] */
+static_cast<void>(count);
+}
+
+{
+std::size_t expectedCount = 1000;
+/* [ConcurrentArrayAppender] */
+Containers::Array<float> output;
+Containers::arrayReserve(output, expectedCount);
+{
+    Containers::ConcurrentArrayAppender<float> appender{output};
+
+    /* On each worker thread, claim a chunk and fill it in place */
+    Containers::ArrayView<float> chunk = appender.append(16);
+    for(float& i: chunk) i = 0.0f;
+
+    // ...
+}
+/* Once the workers are joined and the appender destroyed, output contains
+   values from all threads */
+/* [ConcurrentArrayAppender] */
+}
+
 {
 /* [Array-arrayView] */
 Containers::Array<std::uint32_t> data;
@@ -473,6 +965,15 @@ Utility::Debug{} << Features{};
 /* [enumSetDebugOutput-usage] */
 }
 
+{
+Features features;
+/* [EnumSet-iteration] */
+for(Feature feature: features) {
+    Utility::Debug{} << feature;
+}
+/* [EnumSet-iteration] */
+}
+
 {
 /* [LinkedList-usage] */
 class Object: public Containers::LinkedListItem<Object> {
@@ -576,6 +1077,29 @@ FILE* f{};
 }
 
 /* [ScopeGuard-usage-no-handle] */
+
+{
+Containers::ArrayView<int> counts;
+/* [ScopeExit-usage] */
+for(std::size_t i = 0; i != counts.size(); ++i) {
+    /* Inlined at every exit from the loop body, no indirect call */
+    auto e = Containers::scopeExit([&counts, i]() { ++counts[i]; });
+
+    if(counts[i] > 100) continue;
+    // …
+}
+/* [ScopeExit-usage] */
+
+{
+/* [scopeExit] */
+auto callable = []() { Utility::Debug{} << "Done"; };
+
+Containers::ScopeExit<decltype(callable)> a{callable};
+auto b = Containers::scopeExit(callable);
+/* [scopeExit] */
+}
+}
+
 {
     Containers::ScopeGuard e{[]() {
         Utility::Debug{} << "We're done here!";
@@ -761,6 +1285,90 @@ Containers::StridedArrayView2D<int> gradient =
 static_cast<void>(gradient);
 }
 
+{
+Containers::StridedArrayView3D<std::uint32_t> images;
+/* [StridedArrayView-usage-forEach] */
+/* Same as the nested range-for above, but with a single inner loop over
+   a contiguous row of pixels that the compiler can vectorize */
+Containers::forEachElement(images.slice({0, 96, 96}, {16, 160, 160}),
+    [](std::uint32_t& pixel) { pixel = 0xff0000ff; });
+
+/* Each row passed as a plain ArrayView */
+Containers::forEachRow(images[5], [](Containers::ArrayView<std::uint32_t> row) {
+    for(std::uint32_t& pixel: row) pixel = 0x000000ff;
+});
+/* [StridedArrayView-usage-forEach] */
+}
+
+{
+struct Vector3 { float x, y, z; };
+/* [StridedArrayView-usage-forEachZipped] */
+Containers::StridedArrayView1D<const Vector3> positions;
+Containers::StridedArrayView1D<const Vector3> velocities;
+Containers::StridedArrayView1D<Vector3> out;
+float dt = 1.0f/60.0f;
+
+Containers::forEachZipped([dt](const Vector3& position, const Vector3& velocity, Vector3& result) {
+    result.x = position.x + velocity.x*dt;
+    result.y = position.y + velocity.y*dt;
+    result.z = position.z + velocity.z*dt;
+}, positions, velocities, out);
+/* [StridedArrayView-usage-forEachZipped] */
+}
+
+{
+/* [StridedArrayView-usage-forEachTile] */
+Containers::StridedArrayView2D<const float> src;
+Containers::StridedArrayView2D<float> dst;
+
+/* Transpose in 32x32 tiles so both the source and the destination tile stay
+   in the L1 cache */
+Containers::forEachTile(src, {32, 32}, [&](
+    const Containers::StridedDimensions<2, std::size_t>& offset,
+    Containers::StridedArrayView2D<const float> tile)
+{
+    for(std::size_t i = 0; i != tile.size()[0]; ++i)
+        for(std::size_t j = 0; j != tile.size()[1]; ++j)
+            dst[offset[1] + j][offset[0] + i] = tile[i][j];
+});
+
+/* Or without having to pick a tile size */
+Containers::forEachElementMorton(src, [&](
+    const Containers::StridedDimensions<2, std::size_t>& position,
+    const float& value)
+{
+    dst[position[1]][position[0]] = value;
+});
+/* [StridedArrayView-usage-forEachTile] */
+}
+
+{
+/* [StaticStridedArrayView] */
+struct Vertex {
+    float position[3];
+    std::uint32_t color;
+    float textureCoordinates[2];
+    float weight;
+    std::uint32_t id;
+};
+Containers::ArrayView<Vertex> vertices;
+
+/* The stride is a constant, so the loop body is a constant-offset load */
+Containers::StaticStridedArrayView<sizeof(Vertex), std::uint32_t> ids{
+    vertices, &vertices[0].id, vertices.size()};
+for(std::size_t i = 0; i != ids.size(); ++i)
+    ids[i] = i;
+
+/* Converting from and to a runtime-strided view */
+Containers::StridedArrayView1D<std::uint32_t> colors{
+    vertices, &vertices[0].color, vertices.size(), sizeof(Vertex)};
+Containers::StaticStridedArrayView<32, std::uint32_t> staticColors{colors};
+Containers::StridedArrayView1D<const std::uint32_t> runtimeIds = ids;
+/* [StaticStridedArrayView] */
+static_cast<void>(staticColors);
+static_cast<void>(runtimeIds);
+}
+
 {
 struct Position {
     float x, y;
@@ -859,4 +1467,50 @@ auto b = Containers::pointer<std::string>('a', 'b');
 /* [pointer-inplace] */
 }
 
+{
+/* [Pointer-deleter] */
+struct FileCloser {
+    void operator()(std::FILE* file) const { std::fclose(file); }
+};
+
+// Same size as a plain pointer, calls std::fclose() on destruction
+Containers::Pointer<std::FILE, FileCloser> file{std::fopen("data.bin", "rb"), FileCloser{}};
+static_assert(sizeof(file) == sizeof(std::FILE*), "");
+/* [Pointer-deleter] */
+}
+
+{
+/* [ObjectPool] */
+struct Shape {
+    virtual ~Shape() = default;
+    virtual float area() const = 0;
+};
+struct Circle: Shape {
+    explicit Circle(float radius): radius{radius} {}
+    float area() const override { return 3.14159f*radius*radius; }
+    float radius;
+};
+
+Containers::ObjectPool<Circle> circles;
+
+/* Allocated from the pool and returned back to it on destruction, the
+   pointer can be converted to the base type */
+Containers::Pointer<Shape, Containers::ObjectPoolDeleter> shape =
+    circles.create(2.5f);
+/* [ObjectPool] */
+static_cast<void>(shape);
+}
+
+{
+struct Circle {
+    explicit Circle(float radius): radius{radius} {}
+    float radius;
+};
+Containers::ObjectPool<Circle> pool;
+/* [ObjectPool-pointer] */
+auto a = pool.create(2.5f);
+auto b = Containers::pointer(pool, 2.5f);
+/* [ObjectPool-pointer] */
+}
+
 }
@@ -24,6 +24,7 @@
 */
 
 #include <string>
+#include <thread>
 
 #include "Corrade/Interconnect/Emitter.h"
 #include "Corrade/Interconnect/Receiver.h"
@@ -31,6 +32,62 @@
 
 using namespace Corrade;
 
+namespace { namespace StaticPrinter {
+
+enum class State: std::uint8_t {
+    Ready,
+    Printing,
+    Finished
+};
+
+enum class Input: std::uint8_t {
+    Operate,
+    TakeDocument
+};
+
+/* [StaticStateMachine-typedef] */
+template<State from, Input input, State to> using T =
+    Interconnect::StaticStateTransition<State, Input, from, input, to>;
+
+typedef Interconnect::StaticStateMachine<3, 2, State, Input,
+    T<State::Ready,     Input::Operate,         State::Printing>,
+    T<State::Printing,  Input::Operate,         State::Finished>,
+    T<State::Finished,  Input::TakeDocument,    State::Ready>> Printer;
+
+static_assert(Printer::next(State::Ready, Input::Operate) == State::Printing,
+    "the table is available at compile time");
+/* [StaticStateMachine-typedef] */
+
+/* [StaticStateMachine-step] */
+struct PrinterHandler {
+    void exited(State state, State) {
+        if(state == State::Printing)
+            Utility::Debug{} << "Finishing the print...";
+    }
+
+    void stepped(State, State) {}
+
+    void entered(State state, State) {
+        if(state == State::Ready)
+            Utility::Debug{} << "Printer is ready.";
+        else if(state == State::Finished)
+            Utility::Debug{} << "Finished. Please take the document.";
+        else if(state == State::Printing)
+            Utility::Debug{} << "Starting the print...";
+    }
+};
+
+void print() {
+    Printer p;
+    PrinterHandler handler;
+    p.step(Input::Operate, handler)
+     .step(Input::Operate, handler)
+     .step(Input::TakeDocument, handler);
+}
+/* [StaticStateMachine-step] */
+
+}}
+
 int main() {
 
 {
@@ -158,6 +215,91 @@ Interconnect::connect(foo, &Foo::signal, d, &std::string::clear);      // ok
 /* [Emitter-connect-receiver-multiple-inheritance] */
 }
 
+{
+/* [Emitter-emitBatch] */
+struct Entity {
+    std::size_t id;
+    float position[3];
+    float velocity[3];
+};
+
+class World: public Interconnect::Emitter {
+    public:
+        Signal moved(std::size_t id) {
+            return emit(&World::moved, id);
+        }
+
+        void update(Containers::ArrayView<Entity> entities) {
+            // ...
+            emitBatch(&World::moved, Containers::StridedArrayView1D<const std::size_t>{entities, &entities[0].id, entities.size(), sizeof(Entity)});
+        }
+};
+/* [Emitter-emitBatch] */
+
+/* [connectBatch] */
+World world;
+Interconnect::connectBatch(world, &World::moved,
+    [](Containers::StridedArrayView1D<const std::size_t> ids) {
+        for(std::size_t id: ids) {
+            // ...
+            static_cast<void>(id);
+        }
+    });
+/* [connectBatch] */
+}
+
+{
+bool running = true;
+/* [Emitter-connectQueued] */
+class Downloader: public Interconnect::Emitter {
+    public:
+        Signal finished(const std::string& url, std::size_t size) {
+            return emit(&Downloader::finished, url, size);
+        }
+};
+
+class Window: public Interconnect::Receiver {
+    public:
+        void showFinished(const std::string& url, std::size_t size) {
+            Utility::Debug{} << "Downloaded" << size << "bytes from" << url.data();
+        }
+};
+
+Downloader downloader;
+Window window;
+Interconnect::connectQueued(downloader, &Downloader::finished,
+    window, &Window::showFinished);
+
+/* Emitted from a worker thread ... */
+std::thread worker{[&downloader]() {
+    downloader.finished("https://example.com/", 1337);
+}};
+
+/* ... but the slot gets called on the main thread */
+while(running) {
+    window.processEvents();
+    // ...
+}
+/* [Emitter-connectQueued] */
+worker.join();
+}
+
+#ifdef CORRADE_INTERCONNECT_PROFILE
+{
+class World: public Interconnect::Emitter {
+    public:
+        Signal moved(std::size_t id) {
+            return emit(&World::moved, id);
+        }
+};
+World world;
+/* [Emitter-signalProfile] */
+Utility::Debug{} << world.signalProfile(&World::moved);
+world.resetSignalProfiles();
+/* [Emitter-signalProfile] */
+}
+#endif
+
 {
 /* [StateMachine-states-inputs] */
 enum class State: std::uint8_t {
@@ -203,4 +345,36 @@ p.step(Input::TakeDocument);
 /* [StateMachine-step] */
 }
 
+StaticPrinter::print();
+
+{
+enum class State: std::uint8_t {
+    Idle,
+    Walking,
+    Running
+};
+
+enum class Input: std::uint8_t {
+    Faster,
+    Slower
+};
+
+/* [StateMachinePool] */
+Interconnect::StateMachinePool<3, 2, State, Input> agents{10000};
+agents.addTransitions({
+    {State::Idle,       Input::Faster,  State::Walking},
+    {State::Walking,    Input::Faster,  State::Running},
+    {State::Walking,    Input::Slower,  State::Idle},
+    {State::Running,    Input::Slower,  State::Walking}
+});
+/* [StateMachinePool] */
+
+Containers::Array<Input> input{Containers::ValueInit, agents.size()};
+/* [StateMachinePool-step] */
+for(const Interconnect::StateMachinePoolChange<State>& change: agents.step(input))
+    if(change.to == State::Running)
+        Utility::Debug{} << "Agent" << change.index << "started running";
+/* [StateMachinePool-step] */
+}
+
 }
@@ -24,10 +24,13 @@
 */
 
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "Corrade/PluginManager/AbstractManager.h"
 #include "Corrade/PluginManager/AbstractPlugin.h"
+#include "Corrade/PluginManager/InstancePool.h"
+#include "Corrade/PluginManager/Registry.h"
 #include "Corrade/Utility/Directory.h"
 #include "Corrade/Utility/Macros.h"
 
@@ -41,7 +44,7 @@ class AbstractFilesystem: public PluginManager::AbstractPlugin {
             return "cz.mosra.corrade.AbstractFilesystem/1.0";
         }
 
-        std::vector<std::string> pluginSearchPaths() {
+        static std::vector<std::string> pluginSearchPaths() {
             return {
                 "corrade/filesystems",
                 Utility::Directory::join(CMAKE_INSTALL_PREFIX, "lib/corrade/filesystems")
@@ -64,6 +67,74 @@ static int corradeZipFilesystemStaticImport() {
 } CORRADE_AUTOMATIC_INITIALIZER(corradeZipFilesystemStaticImport)
 /* [CORRADE_PLUGIN_IMPORT] */
 
+namespace {
+
+void processFile(AbstractFilesystem&, const std::string&) {}
+
+void instancePool(PluginManager::Manager<AbstractFilesystem>& manager, const std::vector<std::string>& files) {
+/* [InstancePool] */
+/* Keep up to 8 idle instances around, create 4 of them upfront */
+PluginManager::InstancePool<AbstractFilesystem> pool{manager, "ZipFilesystem", 8};
+pool.prewarm(4);
+
+/* In each job, possibly running on a different thread */
+for(const std::string& file: files) {
+    PluginManager::PooledInstance<AbstractFilesystem> filesystem = pool.acquire();
+    if(!filesystem) continue;
+
+    processFile(*filesystem, file);
+} /* The instance gets put back into the pool here */
+/* [InstancePool] */
+}
+
+#ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+void registry(std::size_t threadCount) {
+/* [Registry] */
+PluginManager::Registry registry;
+
+/* Only the first manager scans the plugin directory, the others reuse it */
+std::vector<std::thread> threads;
+for(std::size_t i = 0; i != threadCount; ++i) threads.emplace_back([&registry] {
+    PluginManager::Manager<AbstractFilesystem> manager{registry};
+    Containers::Pointer<AbstractFilesystem> filesystem =
+        manager.loadAndInstantiate("ZipFilesystem");
+    // ...
+});
+for(std::thread& thread: threads) thread.join();
+/* [Registry] */
+}
+
+bool running() { return false; }
+
+void hotReload(PluginManager::Manager<AbstractFilesystem>& manager) {
+/* [hot-reload] */
+Containers::Pointer<AbstractFilesystem> filesystem;
+manager.setReloadCallback([](PluginManager::AbstractManager& manager,
+    const std::string& plugin, PluginManager::ReloadEvent event, void* state)
+{
+    auto& filesystem = *static_cast<Containers::Pointer<AbstractFilesystem>*>(state);
+    if(plugin != "ZipFilesystem") return;
+
+    /* Destroy the instance before the plugin gets unloaded and create a new
+       one once it's loaded again */
+    if(event == PluginManager::ReloadEvent::Unload)
+        filesystem = nullptr;
+    else filesystem = static_cast<PluginManager::Manager<AbstractFilesystem>&>(
+        manager).instantiate(plugin);
+}, &filesystem);
+
+filesystem = manager.loadAndInstantiate("ZipFilesystem");
+while(running()) {
+    manager.reloadChanged();
+
+    // ...
+}
+/* [hot-reload] */
+}
+#endif
+
+}
+
 int main() {
 #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
 {
@@ -76,4 +147,11 @@ if(loadState & (PluginManager::LoadState::WrongPluginVersion|
 /* [LoadStates] */
 }
 #endif
+
+/* Silence unused function warnings */
+static_cast<void>(instancePool);
+#ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+static_cast<void>(registry);
+static_cast<void>(hotReload);
+#endif
 }
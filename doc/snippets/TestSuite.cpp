@@ -28,6 +28,7 @@
 #include "Corrade/Containers/Pointer.h"
 #include "Corrade/TestSuite/Compare/File.h"
 #include "Corrade/TestSuite/Compare/FileToString.h"
+#include "Corrade/TestSuite/Compare/FloatingPointArray.h"
 #include "Corrade/TestSuite/Compare/Numeric.h"
 #include "Corrade/TestSuite/Compare/SortedContainer.h"
 #include "Corrade/TestSuite/Compare/StringToFile.h"
@@ -146,6 +147,16 @@ CORRADE_COMPARE_WITH(a, 9.28f, TestSuite::Compare::around(0.1f));
 /* [Compare-around] */
 }
 
+{
+/* [Compare-FloatingPointArray] */
+Containers::ArrayView<const float> positions, expectedPositions;
+CORRADE_COMPARE_WITH(positions, expectedPositions,
+    (TestSuite::Compare::FloatingPointArray<float>{1.0e-5f, 1.0e-4f}));
+CORRADE_COMPARE_WITH(positions, expectedPositions,
+    TestSuite::Compare::FloatingPointArray<float>::ulps(4));
+/* [Compare-FloatingPointArray] */
+}
+
 {
 /* [CORRADE_VERIFY] */
 std::string s("hello");
@@ -245,6 +256,95 @@ void benchmark() {
 }
 /* [CORRADE_BENCHMARK] */
 
+void parseJson(const std::string&);
+/* [Tester-setBenchmarkThroughput] */
+void parse() {
+    std::string input = Utility::Directory::readString("data.json");
+    setBenchmarkThroughput(input.size(), BenchmarkUnits::Bytes);
+    CORRADE_BENCHMARK(100) {
+        parseJson(input);
+    }
+}
+/* [Tester-setBenchmarkThroughput] */
+
+std::vector<std::string> tokenize(const std::string&);
+/* [CORRADE_EXPECT_MAX_ALLOCATIONS] */
+void tokenize() {
+    std::string input = Utility::Directory::readString("data.json");
+    std::vector<std::string> tokens;
+
+    CORRADE_EXPECT_MAX_ALLOCATIONS(2) {
+        tokens = tokenize(input);
+    }
+
+    CORRADE_EXPECT_MAX_TIME(50.0) {
+        tokens = tokenize(input);
+    }
+
+    CORRADE_EXPECT_MAX_PEAK_MEMORY(4*input.size()) {
+        tokens = tokenize(input);
+    }
+}
+/* [CORRADE_EXPECT_MAX_ALLOCATIONS] */
+
+std::size_t findLinear(const std::vector<int>&, int);
+std::size_t findBinary(const std::vector<int>&, int);
+/* [Tester-addComparisonBenchmarks] */
+// addComparisonBenchmarks({&MyTest::findLinear, &MyTest::findBinary}, 10)
+// called in the constructor
+std::vector<int> sorted;
+
+void findLinear() {
+    std::size_t found = 0;
+    CORRADE_BENCHMARK(100) {
+        found += findLinear(sorted, 1337);
+    }
+    CORRADE_VERIFY(found);
+}
+
+void findBinary() {
+    std::size_t found = 0;
+    CORRADE_BENCHMARK(100) {
+        found += findBinary(sorted, 1337);
+    }
+    CORRADE_VERIFY(found);
+}
+/* [Tester-addComparisonBenchmarks] */
+
+/* [Tester-addSweepBenchmarks] */
+// addSweepBenchmarks({&MyTest::find}, 10, 1 << 10, 1 << 18, &MyTest::setupFind,
+//      &MyTest::teardownFind) called in the constructor
+std::vector<int> input;
+
+void setupFind() {
+    input.assign(testCaseSweepSize(), 0);
+}
+
+void teardownFind() {
+    input = {};
+}
+
+void find() {
+    std::size_t found = 0;
+    CORRADE_BENCHMARK(100) {
+        found += findLinear(input, 1337);
+    }
+    CORRADE_VERIFY(found);
+}
+/* [Tester-addSweepBenchmarks] */
+
+/* [Tester-addThreadedBenchmarks] */
+// addThreadedBenchmarks({&MyTest::push}, 10, 16) called in the constructor
+std::vector<int> data[16];
+
+void push() {
+    std::vector<int>& threadData = data[testCaseThreadId()];
+    CORRADE_BENCHMARK(100000) {
+        threadData.push_back(42);
+    }
+}
+/* [Tester-addThreadedBenchmarks] */
+
 /* [Tester-Debug] */
 void myTestCase() {
     int a = 4;
@@ -254,5 +354,21 @@ void myTestCase() {
 /* [Tester-Debug] */
 };
 
+/* [Tester-setBenchmarkResultCallback] */
+struct MyBenchmark: TestSuite::Tester {
+    explicit MyBenchmark();
+
+    std::vector<double> means;
+};
+
+MyBenchmark::MyBenchmark(): TestSuite::Tester{TesterConfiguration{}
+    .setBenchmarkResultCallback([](const BenchmarkResult& result, void* userData) {
+        static_cast<MyBenchmark*>(userData)->means.push_back(result.mean);
+    }, this)}
+{
+    // addBenchmarks(...)
+}
+/* [Tester-setBenchmarkResultCallback] */
+
 /* To prevent macOS ranlib complaining that there are no symbols */
 int main() {}
@@ -0,0 +1,84 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Corrade/Corrade.h"
+
+#include <string>
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Utility/Directory.h"
+#include "Corrade/Utility/Task.h"
+
+using namespace Corrade;
+
+namespace {
+
+/* [Task] */
+Utility::Task<int> answer() {
+    co_return 42;
+}
+
+Utility::Task<int> twiceTheAnswer() {
+    int a = co_await answer();
+    co_return a*2;
+}
+/* [Task] */
+
+}
+
+#if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+namespace {
+
+/* [Task-resumeOn] */
+Utility::Task<std::size_t> fileSize(Utility::ThreadPool::TaskGroup& group, std::string filename) {
+    /* Everything after this line runs on the thread pool */
+    co_await Utility::resumeOn(group);
+    Containers::Array<char> data = Utility::Directory::read(filename);
+    co_return data.size();
+}
+/* [Task-resumeOn] */
+
+}
+#endif
+
+int main() {
+{
+/* [Task-start] */
+Utility::Task<int> task = twiceTheAnswer();
+task.start();
+// task.isDone() is true, task.result() is 84
+/* [Task-start] */
+}
+
+#if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+{
+Utility::ThreadPool pool;
+Utility::ThreadPool::TaskGroup group{pool};
+Utility::Task<std::size_t> task = fileSize(group, "file.dat");
+task.start();
+group.wait();
+}
+#endif
+}
@@ -28,20 +28,50 @@
 #include <iostream>
 #include <map>
 #include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include "Corrade/Containers/Array.h"
+#include "Corrade/Containers/Optional.h"
+#include "Corrade/Containers/StridedArrayView.h"
+#include "Corrade/Utility/Algorithms.h"
 #include "Corrade/Utility/Arguments.h"
 #include "Corrade/Utility/Assert.h"
+#include "Corrade/Utility/BinaryLog.h"
+#if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+#include "Corrade/Utility/AsyncOutput.h"
+#endif
+#include "Corrade/Utility/BinaryReader.h"
+#include "Corrade/Utility/BinaryWriter.h"
+#include "Corrade/Utility/BufferedFile.h"
 #include "Corrade/Utility/Configuration.h"
+#include "Corrade/Utility/ConfigurationReader.h"
+#include "Corrade/Utility/Cpu.h"
+#include "Corrade/Utility/Crc32.h"
+#include "Corrade/Utility/DebugLevel.h"
 #include "Corrade/Utility/DebugStl.h"
 #include "Corrade/Utility/Directory.h"
+#include "Corrade/Utility/Encoding.h"
 #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)) || defined(CORRADE_TARGET_EMSCRIPTEN)
 #include "Corrade/Utility/FileWatcher.h"
+#include "Corrade/Utility/FileWatcherSet.h"
 #endif
 #include "Corrade/Utility/Format.h"
 #include "Corrade/Utility/FormatStl.h"
 #include "Corrade/Utility/Macros.h"
+#include "Corrade/Utility/Move.h"
+#include "Corrade/Utility/Parse.h"
+#include "Corrade/Utility/Profiler.h"
+#include "Corrade/Utility/Resource.h"
 #include "Corrade/Utility/Sha1.h"
+#include "Corrade/Utility/String.h"
+#include "Corrade/Utility/StringPool.h"
+#if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+#include "Corrade/Utility/ThreadPool.h"
+#endif
+#include "Corrade/Utility/TreeHash.h"
+#include "Corrade/Utility/XxHash3.h"
 
 /* [Tweakable-disable-header] */
 #define CORRADE_TWEAKABLE
@@ -78,8 +108,88 @@ template<> struct ConfigurationValue<Foo> {
 }}
 /* [ConfigurationValue] */
 
+/* [IsTriviallyRelocatable] */
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Utility/TypeTraits.h>
+
+struct Mesh {
+    Corrade::Containers::Pointer<Foo> data;
+    std::size_t size;
+};
+
+namespace Corrade { namespace Utility {
+
+/* Both members are trivially relocatable, so the whole type is as well */
+template<> struct IsTriviallyRelocatable<Mesh>: std::true_type {};
+
+}}
+/* [IsTriviallyRelocatable] */
+
 using namespace Corrade;
 
+/* [swap] */
+template<class T> void reverse(T* const data, const std::size_t size) {
+    for(std::size_t i = 0; i < size/2; ++i) {
+        /* Picks a swap() overload specific to T via ADL if there's any */
+        using Utility::swap;
+        swap(data[i], data[size - i - 1]);
+    }
+}
+/* [swap] */
+
+void threadExecutor(void*, std::size_t, void(*)(void*, std::size_t), void*);
+void copyImage(const Containers::StridedArrayView2D<const int>&, const Containers::StridedArrayView2D<int>&);
+/* [ParallelExecutor] */
+void threadExecutor(void*, std::size_t count, void(*job)(void*, std::size_t),
+    void* jobState)
+{
+    std::vector<std::thread> threads;
+    for(std::size_t i = 0; i != count; ++i)
+        threads.emplace_back(job, jobState, i);
+    for(std::thread& thread: threads) thread.join();
+}
+
+// …
+
+void copyImage(const Containers::StridedArrayView2D<const int>& src,
+    const Containers::StridedArrayView2D<int>& dst)
+{
+    Utility::copy(src, dst, threadExecutor, nullptr,
+        std::thread::hardware_concurrency());
+}
+/* [ParallelExecutor] */
+
+#ifdef CORRADE_TARGET_X86
+float sum(const float*, std::size_t);
+/* [Cpu-dispatch] */
+namespace {
+
+float sumScalar(const float* data, std::size_t size) {
+    float out{};
+    for(std::size_t i = 0; i != size; ++i) out += data[i];
+    return out;
+}
+
+/* The same loop, but the compiler is allowed to use AVX2 for it. Could be
+   also written using AVX2 intrinsics. */
+CORRADE_ENABLE_AVX2 float sumAvx2(const float* data, std::size_t size) {
+    float out{};
+    for(std::size_t i = 0; i != size; ++i) out += data[i];
+    return out;
+}
+
+}
+
+float sum(const float* data, std::size_t size) {
+    static float(*const implementation)(const float*, std::size_t) =
+        Utility::Cpu::dispatch({
+            {Utility::Cpu::Feature::Avx2, sumAvx2}
+        }, sumScalar);
+    return implementation(data, size);
+}
+/* [Cpu-dispatch] */
+#endif
+
 class Vec {
 typedef char T;
 std::size_t size() const;
@@ -261,6 +371,8 @@ args.addOption("width", "80").setHelp("width", "number of columns")
 }
 };
 
+int expensiveComputation();
+
 int main() {
 {
 /* [Configuration-usage] */
@@ -284,6 +396,51 @@ conf.save();
 /* [Configuration-usage] */
 }
 
+{
+/* [ConfigurationReader-usage] */
+/* Collects names of all top-level [plugin] groups in a huge file */
+struct PluginNames: Utility::ConfigurationReader {
+    std::vector<std::string> names;
+    std::size_t depth = 0;
+    bool inPlugin = false;
+
+    private:
+        void doGroupOpen(Containers::StringView name) override {
+            if(++depth != 1) return;
+            inPlugin = name == "plugin";
+            if(inPlugin) names.emplace_back();
+        }
+        void doValue(Containers::StringView key, Containers::StringView value) override {
+            if(depth == 1 && inPlugin && key == "name")
+                names.back().assign(value.data(), value.size());
+        }
+        void doGroupClose() override { --depth; }
+} reader;
+
+reader.parse("manifest.conf");
+/* [ConfigurationReader-usage] */
+}
+
+{
+/* [Configuration-snapshot] */
+Utility::Configuration conf{"server.conf"};
+conf.publish();
+
+/* Worker threads take a snapshot for every request, no locking involved */
+std::thread worker{[&conf] {
+    Utility::ConfigurationSnapshot snapshot = conf.snapshot();
+    int port = snapshot.group("network").value<int>("port");
+    // ...
+    static_cast<void>(port);
+}};
+
+/* Meanwhile, an update is applied and published on the main thread */
+conf.group("network")->setValue("port", 8080);
+conf.publish();
+/* [Configuration-snapshot] */
+worker.join();
+}
+
 {
 /* [CORRADE_IGNORE_DEPRECATED] */
 CORRADE_DEPRECATED("use bar() instead") void foo(int);
@@ -340,6 +497,106 @@ Utility::Error{} << "this is still printed into errorOut";
 /* [Debug-scoped-output] */
 }
 
+{
+/* [Debug-writer] */
+/* Writes directly to a FILE, with no iostreams involved */
+Utility::Error{Utility::Debug::fileWriter, stderr} << "Something failed:" << 42;
+
+/* Output collected into a string by a custom writer */
+std::string out;
+{
+    Utility::Debug redirectDebug{[](void* state, const char* data, std::size_t size) {
+        static_cast<std::string*>(state)->append(data, size);
+    }, &out};
+
+    Utility::Debug{} << "this is collected into out";
+}
+/* [Debug-writer] */
+}
+
+{
+Containers::StringView assetDir, name;
+/* [Directory-joinInto] */
+char path[4096];
+const std::size_t size = Utility::Directory::joinInto(path, assetDir, name);
+if(size < sizeof(path)) {
+    path[size] = '\0'; /* for the C API */
+    if(std::FILE* f = std::fopen(path, "rb")) {
+        // ...
+        std::fclose(f);
+    }
+}
+/* [Directory-joinInto] */
+}
+
+{
+/* [DebugModule] */
+/* Usually a global */
+Utility::DebugModule sceneLoader{"SceneLoader", Utility::DebugLevel::Warning};
+
+/* Printed */
+CORRADE_WARNING(sceneLoader) << "Mesh" << "foo" << "has no normals";
+
+/* Not printed, expensiveComputation() isn't called */
+CORRADE_DEBUG(sceneLoader) << "Processed" << expensiveComputation() << "nodes";
+
+/* Printed from now on */
+sceneLoader.setLevel(Utility::DebugLevel::Debug);
+/* [DebugModule] */
+}
+
+{
+Utility::DebugModule sceneLoader{"SceneLoader", Utility::DebugLevel::Warning};
+struct {
+    const char* name;
+    bool hasNormals;
+} meshes[1]{};
+/* [CORRADE_WARNING_ONCE] */
+for(const auto& mesh: meshes) {
+    /* Printed just for the first mesh without normals */
+    if(!mesh.hasNormals)
+        CORRADE_WARNING_ONCE(sceneLoader) << "Some meshes have no normals";
+
+    /* Printed for the 1st, 1001st, 2001st... mesh, together with the count
+       of suppressed messages */
+    CORRADE_WARNING_EVERY_N(sceneLoader, 1000) << "Mesh" << mesh.name
+        << "not found, falling back to a default";
+}
+/* [CORRADE_WARNING_ONCE] */
+}
+
+{
+int requestId{};
+float duration{};
+/* [BinaryLog] */
+/* Keep the last 16 MB of messages */
+Utility::BinaryLog log{16*1024*1024};
+
+/* Only the site ID and the argument values are stored */
+CORRADE_BINARY_LOG(log, "Request {} took {:.2f} ms", requestId, duration);
+
+/* Format the messages when needed */
+Containers::Optional<std::string> text = Utility::BinaryLog::decode(log.data());
+/* [BinaryLog] */
+static_cast<void>(text);
+}
+
+{
+struct {
+    void update() {}
+} physics;
+/* [Profiler] */
+Utility::Profiler::setEnabled(true);
+
+{
+    CORRADE_PROFILE_SCOPE("Physics update");
+    physics.update();
+}
+
+Utility::Directory::writeString("trace.json", Utility::Profiler::chromeTrace());
+/* [Profiler] */
+}
+
 {
 /* [Debug-modifiers-whitespace] */
 // Prints "Value: 16, 24"
@@ -408,6 +665,16 @@ Utility::Debug{} << "Value:" << 16 << Utility::Debug::nospace << "," << 24;
 /* [Debug-nospace] */
 }
 
+{
+Containers::Array<float> data;
+/* [Debug-elementLimit] */
+Utility::Debug::setElementLimit(6);
+
+/* Prints just {0, 0.5, 1, …, 4999, 4999.5, 5000} for 10k elements */
+Utility::Debug{} << data;
+/* [Debug-elementLimit] */
+}
+
 {
 /* [Debug-newline] */
 Utility::Debug{} << "Value:" << Utility::Debug::newline << 16;
@@ -516,6 +783,60 @@ Utility::formatInto(stdout, "Hello, {}!", "world");
 /* [formatInto-stdout] */
 }
 
+{
+std::vector<float> positions;
+/* [formatInto-array] */
+Containers::Array<char> out;
+for(std::size_t i = 0; i < positions.size(); i += 3)
+    Utility::formatInto(out, "v {} {} {}\n",
+        positions[i + 0], positions[i + 1], positions[i + 2]);
+/* [formatInto-array] */
+}
+
+{
+Containers::ArrayView<const float> positions;
+/* [formatNumbersInto] */
+/* Three columns, one vertex per row */
+Containers::StridedArrayView2D<const float> table{positions,
+    {positions.size()/3, 3}};
+
+Containers::Array<char> csv;
+Utility::formatNumbersInto(csv, table, ",", "\n");
+
+/* And back, treating both commas and newlines as delimiters */
+Containers::Array<float> parsed{Containers::NoInit, positions.size()};
+if(Utility::parseNumbersInto(csv, parsed, ",\n") != parsed.size())
+    Utility::Error{} << "Invalid data";
+/* [formatNumbersInto] */
+}
+
+{
+std::vector<float> positions;
+/* [BufferedFile] */
+std::FILE* f = std::fopen("mesh.obj", "w");
+{
+    /* Written to the file in 64 kB chunks */
+    Utility::BufferedFile file{f};
+    for(std::size_t i = 0; i < positions.size(); i += 3)
+        Utility::formatInto(file, "v {} {} {}\n",
+            positions[i + 0], positions[i + 1], positions[i + 2]);
+} /* The rest gets written here */
+std::fclose(f);
+/* [BufferedFile] */
+}
+
+{
+float frameTime{};
+std::size_t drawCount{};
+/* [CORRADE_FORMAT] */
+/* The format string is validated at compile time and parsed only once */
+char buffer[128];
+std::size_t size = Utility::formatInto(buffer,
+    CORRADE_FORMAT("frame time: {:.2f} ms, {} draws"), frameTime, drawCount);
+/* [CORRADE_FORMAT] */
+static_cast<void>(size);
+}
+
 #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)) || defined(CORRADE_TARGET_EMSCRIPTEN)
 {
 /* [FileWatcher] */
@@ -527,6 +848,31 @@ if(watcher.hasChanged()) {
 }
 /* [FileWatcher] */
 }
+
+{
+void reload(const std::string&);
+/* [FileWatcherSet] */
+Utility::FileWatcherSet watchers;
+watchers.add("shaders/flat.vert");
+watchers.add("shaders/flat.frag");
+watchers.add("settings.conf");
+
+// in the main application loop
+for(std::size_t id: watchers.changed()) {
+    reload(watchers.filename(id));
+}
+/* [FileWatcherSet] */
+}
+
+#if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+{
+/* [FileWatcherSet-parallel] */
+Utility::ThreadPool pool;
+Utility::FileWatcherSet watchers{Utility::FileWatcher::Flag::CheckContents};
+watchers.setParallelExecutor(Utility::ThreadPool::execute, &pool);
+/* [FileWatcherSet-parallel] */
+}
+#endif
 #endif
 
 {
@@ -642,6 +988,312 @@ Utility::Debug{} << sha1.digest().hexString();
 Utility::Debug{} << Utility::Sha1::digest("corrade");
 /* [Sha1-usage] */
 }
+
+{
+/* [StringPool-usage] */
+Utility::StringPool pool;
+
+std::uint32_t width = pool.intern("width");
+std::uint32_t height = pool.intern("height");
+
+/* Interning the same string again gives back the same ID and the same
+   memory */
+CORRADE_INTERNAL_ASSERT(pool.intern("width") == width);
+CORRADE_INTERNAL_ASSERT(pool[width].data() == pool.internView("width").data());
+
+/* Looking up doesn't add anything */
+CORRADE_INTERNAL_ASSERT(pool.find("depth") == 0xffffffffu);
+/* [StringPool-usage] */
+static_cast<void>(height);
+}
+
+{
+Containers::ArrayView<const char> data;
+/* [Encoding-usage] */
+/* Text size is known upfront, so the output can be on stack or reused */
+Containers::Array<char> text{Containers::NoInit,
+    Utility::Encoding::base64EncodedSize(data.size())};
+Utility::Encoding::base64Encode(data, text);
+
+/* Decoding reports invalid input instead of asserting */
+Containers::Array<char> decoded{Containers::NoInit,
+    Utility::Encoding::base64DecodedSize(text)};
+if(!Utility::Encoding::base64Decode(text, decoded))
+    Utility::Error{} << "Invalid Base64 data";
+/* [Encoding-usage] */
+}
+
+{
+/* [ResourceKey] */
+constexpr Utility::ResourceKey VertexShader{"Flat.vert"};
+
+Utility::Resource rs{"shaders"};
+Containers::ArrayView<const char> source = rs.getRaw(VertexShader);
+/* [ResourceKey] */
+static_cast<void>(source);
+}
+
+{
+/* [Resource-packs] */
+/* Produced at build time with `corrade-rc --pack - levels.conf levels.pack` */
+if(!Utility::Resource::loadPack("levels.pack"))
+    Utility::Fatal{} << "Cannot load game levels";
+
+Utility::Resource rs{"levels"};
+Containers::ArrayView<const char> level = rs.getRaw("level1.json");
+
+// ...
+
+/* Any views into the data are invalidated after this */
+Utility::Resource::unloadPack("levels");
+/* [Resource-packs] */
+static_cast<void>(level);
+}
+
+{
+/* [XxHash3-usage] */
+/* 64-bit variant with a custom seed */
+Utility::XxHash3<8> hash{0x1337};
+
+/* Data can be added incrementally, of arbitrary sizes */
+hash << std::string{"corrade"};
+const char data[4] = { '\x35', '\xf6', '\x00', '\xab' };
+hash << Containers::arrayView(data);
+
+Utility::Debug{} << hash.digest().hexString();
+
+/* Shorthand 128-bit variant, treating the argument as a string */
+Utility::Debug{} << Utility::XxHash3<16>::digest("corrade");
+/* [XxHash3-usage] */
+}
+
+{
+/* [BinaryReader-usage] */
+Containers::Array<const char, Utility::Directory::MapDeleter> data =
+    Utility::Directory::mapRead("points.bin");
+Utility::BinaryReader reader{data};
+
+Containers::Optional<std::uint32_t> magic =
+    reader.readLittleEndian<std::uint32_t>();
+Containers::Optional<std::uint32_t> count =
+    reader.readBigEndian<std::uint32_t>();
+if(!magic || *magic != 0x50544e53 || !count) Utility::Fatal{} << "Bad header";
+
+/* A view pointing directly into the mapped file, no copy involved */
+Containers::Optional<Containers::ArrayView<const float>> points =
+    reader.readArray<float>(*count*3);
+if(!points) Utility::Fatal{} << "Bad data";
+/* [BinaryReader-usage] */
+}
+
+{
+Containers::ArrayView<const float> points;
+/* [BinaryWriter-usage] */
+Utility::BinaryWriter writer;
+writer.writeLittleEndian(std::uint32_t{0x50544e53})
+      .writeBigEndian(std::uint32_t(points.size()/3))
+      .writeArray(points);
+
+Utility::Directory::write("points.bin", writer.data());
+/* [BinaryWriter-usage] */
+}
+
+{
+Containers::ArrayView<const char> packet;
+/* [Crc32-usage] */
+/* Numeric value of a checksum in a single call */
+std::uint32_t checksum = Utility::Crc32::checksum(packet);
+
+/* Checksum of two halves calculated independently, for example on different
+   threads, and then combined */
+std::uint32_t a = Utility::Crc32::checksum(packet.prefix(packet.size()/2));
+std::uint32_t b = Utility::Crc32::checksum(packet.suffix(packet.size()/2));
+CORRADE_INTERNAL_ASSERT(Utility::Crc32::combine(a, b,
+    packet.size() - packet.size()/2) == checksum);
+
+/* Digest with the same interface as other hashes, printing 414fa339 */
+Utility::Debug{} << Utility::Crc32::digest(
+    "The quick brown fox jumps over the lazy dog");
+/* [Crc32-usage] */
+}
+
+{
+Containers::ArrayView<const char> chunk1, chunk2;
+/* [Crc32c-usage] */
+Utility::Crc32c crc;
+crc << chunk1 << chunk2;
+std::uint32_t checksum = crc.value();
+/* [Crc32c-usage] */
+static_cast<void>(checksum);
+}
+
+{
+/* [treeHash] */
+Containers::Array<const char, Utility::Directory::MapDeleter> data =
+    Utility::Directory::mapRead("large.bin");
+Utility::Debug{} << Utility::treeHash<Utility::XxHash3<16>>(data,
+    threadExecutor, nullptr, std::thread::hardware_concurrency());
+/* [treeHash] */
+}
+
+{
+Containers::StridedArrayView2D<float> image;
+/* [parallelFor] */
+/* Each call gets a range of complete rows */
+Utility::parallelFor(image, [](const Containers::StridedArrayView2D<float>& rows) {
+    for(std::size_t y = 0; y != rows.size()[0]; ++y)
+        for(float& pixel: rows[y]) pixel = pixel*pixel;
+}, threadExecutor, nullptr, std::thread::hardware_concurrency());
+/* [parallelFor] */
+}
+
+{
+Containers::StridedArrayView1D<const float> values;
+/* [parallelReduce] */
+float sum = Utility::parallelReduce(values, 0.0f,
+    [](const Containers::StridedArrayView1D<const float>& part) {
+        float sum = 0.0f;
+        for(float i: part) sum += i;
+        return sum;
+    }, [](float a, float b) { return a + b; },
+    threadExecutor, nullptr, std::thread::hardware_concurrency());
+/* [parallelReduce] */
+static_cast<void>(sum);
+}
+
+{
+struct Particle {
+    float position[3];
+    std::uint32_t cell;
+};
+Containers::ArrayView<const Particle> particles;
+/* [sortPermutation] */
+Containers::StridedArrayView1D<const std::uint32_t> cells{particles,
+    &particles[0].cell, particles.size(), sizeof(Particle)};
+
+/* Order the particles by the grid cell they're in, without touching the
+   original data */
+Containers::Array<std::uint32_t> order{Containers::NoInit, particles.size()};
+Utility::radixSortPermutation(cells, Containers::stridedArrayView(order));
+
+/* Find the particles in cell 42 in the sorted order */
+Containers::Array<std::uint32_t> sortedCells{Containers::NoInit, particles.size()};
+Utility::gather(cells, Containers::StridedArrayView1D<const std::uint32_t>{order},
+    Containers::stridedArrayView(sortedCells));
+std::size_t begin = Utility::lowerBound(
+    Containers::StridedArrayView1D<const std::uint32_t>{sortedCells}, 42u);
+std::size_t end = Utility::upperBound(
+    Containers::StridedArrayView1D<const std::uint32_t>{sortedCells}, 42u);
+/* [sortPermutation] */
+static_cast<void>(begin);
+static_cast<void>(end);
+}
+
+{
+Containers::ArrayView<const float> positions, normals;
+Containers::ArrayView<const std::uint32_t> ids;
+Containers::ArrayView<const std::uint32_t> order;
+Containers::ArrayView<float> sortedPositions, sortedNormals;
+Containers::ArrayView<std::uint32_t> sortedIds;
+/* [applyPermutation] */
+/* Reorder all attributes by the same permutation at once */
+Utility::applyPermutation(Containers::stridedArrayView(order), {
+    {Containers::stridedArrayView(positions),
+     Containers::stridedArrayView(sortedPositions)},
+    {Containers::stridedArrayView(normals),
+     Containers::stridedArrayView(sortedNormals)},
+    {Containers::stridedArrayView(ids),
+     Containers::stridedArrayView(sortedIds)}
+});
+/* [applyPermutation] */
+}
+
+#if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+{
+/* [AsyncOutput] */
+Utility::AsyncOutput output{std::cout};
+
+std::vector<std::thread> threads;
+for(std::size_t i = 0; i != 4; ++i) threads.emplace_back([&output, i] {
+    /* Each thread needs its own stream and redirection */
+    Utility::AsyncOutputStream stream{output};
+    Utility::Debug redirectOutput{&stream};
+
+    Utility::Debug{} << "Hello from thread" << i;
+});
+for(std::thread& thread: threads) thread.join();
+/* [AsyncOutput] */
+}
+
+{
+Containers::ArrayView<float> pixels;
+/* [ThreadPool-parallelFor] */
+Utility::ThreadPool pool;
+
+/* Each call gets at most 4096 pixels */
+pool.parallelFor(pixels.size(), 4096, [&](std::size_t begin, std::size_t end) {
+    for(float& pixel: pixels.slice(begin, end))
+        pixel = pixel*pixel;
+});
+/* [ThreadPool-parallelFor] */
+}
+
+{
+Utility::ThreadPool pool;
+Containers::StridedArrayView2D<const int> src;
+Containers::StridedArrayView2D<int> dst;
+/* [ThreadPool-execute] */
+Utility::copy(src, dst, Utility::ThreadPool::execute, &pool, pool.jobCount());
+/* [ThreadPool-execute] */
+}
+
+{
+Utility::ThreadPool pool;
+/* [ThreadPool-TaskGroup] */
+std::string config, shaders;
+auto loadConfig = [&] { config = Utility::Directory::readString("config.conf"); };
+auto loadShaders = [&] { shaders = Utility::Directory::readString("shaders.glsl"); };
+
+Utility::ThreadPool::TaskGroup group{pool};
+group.run(loadConfig);
+group.run(loadShaders);
+group.wait();
+/* [ThreadPool-TaskGroup] */
+}
+#endif
+
+{
+std::string source;
+/* [String-replaceAll-multiple] */
+/* A single pass over the source and a single allocation of the output */
+source = Utility::String::replaceAll(source, {
+    {"$SAMPLER", "textureData"},
+    {"$CHANNELS", "rgba"},
+    {"$LAYER_COUNT", "16"}
+});
+/* [String-replaceAll-multiple] */
+}
+
+{
+/* [String-caseInsensitiveHash] */
+struct CaseInsensitiveHash {
+    std::size_t operator()(const std::string& key) const {
+        return Utility::String::caseInsensitiveHash({key.data(), key.size()});
+    }
+};
+struct CaseInsensitiveEqual {
+    bool operator()(const std::string& a, const std::string& b) const {
+        return Utility::String::caseInsensitiveEquals({a.data(), a.size()},
+                                                      {b.data(), b.size()});
+    }
+};
+
+std::unordered_map<std::string, int, CaseInsensitiveHash, CaseInsensitiveEqual> options;
+options["FullScreen"] = 1;
+int value = options["fullscreen"]; // 1
+/* [String-caseInsensitiveHash] */
+static_cast<void>(value);
+}
 }
 
 typedef std::pair<int, int> T;
@@ -721,6 +1373,53 @@ int counter = 0;
 CORRADE_NEVER_INLINE void testFunctionCallOverhead();
 /* [CORRADE_NEVER_INLINE] */
 
+int parse(const char*, std::size_t);
+/* [CORRADE_LIKELY] */
+int parse(const char* data, std::size_t size) {
+    int value = 0;
+    for(std::size_t i = 0; i != size; ++i) {
+        if(CORRADE_UNLIKELY(data[i] < '0' || data[i] > '9')) return -1;
+        value = value*10 + data[i] - '0';
+    }
+    return value;
+}
+/* [CORRADE_LIKELY] */
+
+struct Node {
+    Node* next;
+    float value;
+};
+float sum(const Node* const*, std::size_t);
+/* [CORRADE_PREFETCH] */
+float sum(const Node* const* nodes, std::size_t count) {
+    float sum = 0.0f;
+    for(std::size_t i = 0; i != count; ++i) {
+        /* Fetch a node eight iterations ahead, to be only read */
+        if(i + 8 < count) CORRADE_PREFETCH(nodes[i + 8], 0, 3);
+        sum += nodes[i]->value;
+    }
+    return sum;
+}
+/* [CORRADE_PREFETCH] */
+
+void add(float*, const float*, std::size_t);
+/* [CORRADE_RESTRICT] */
+void add(float* CORRADE_RESTRICT dst, const float* CORRADE_RESTRICT src,
+    std::size_t count)
+{
+    for(std::size_t i = 0; i != count; ++i) dst[i] += src[i];
+}
+/* [CORRADE_RESTRICT] */
+
+void scale(float*, std::size_t, float);
+/* [CORRADE_ASSUME_ALIGNED] */
+void scale(float* data, std::size_t count, float factor) {
+    /* The data come from an allocator that aligns to 16 bytes */
+    float* aligned = CORRADE_ASSUME_ALIGNED(data, 16);
+    for(std::size_t i = 0; i != count; ++i) aligned[i] *= factor;
+}
+/* [CORRADE_ASSUME_ALIGNED] */
+
 /* [CORRADE_VISIBILITY_EXPORT] */
 void privateFunction(); /* can't be used outside of the shared library */
 
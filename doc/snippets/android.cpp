@@ -24,6 +24,8 @@
 */
 
 #include <Corrade/Utility/AndroidLogStreamBuffer.h>
+#include <Corrade/Utility/AsyncOutput.h>
+#include <Corrade/Utility/Debug.h>
 
 using namespace Corrade;
 
@@ -40,4 +42,21 @@ out << "Hello World!" << std::endl;
 /** [AndroidLogStreamBuffer] */
 }
 
+#ifdef CORRADE_BUILD_MULTITHREADED
+{
+/** [AndroidLogStreamBuffer-async] */
+Utility::AndroidLogStreamBuffer buffer{
+    Utility::AndroidLogStreamBuffer::LogPriority::Info, "my-application"};
+std::ostream out{&buffer};
+Utility::AsyncOutput output{out};
+
+/* In the render thread */
+Utility::AsyncOutputStream stream{output};
+Utility::Debug redirectOutput{&stream};
+
+Utility::Debug{} << "Frame took" << 16.7f << "ms";
+/** [AndroidLogStreamBuffer-async] */
+}
+#endif
+
 }
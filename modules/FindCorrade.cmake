@@ -55,6 +55,15 @@
 #   :prop_tgt:`CMAKE_CXX_STANDARD` property. Allowed value is 11, 14 or 17.
 #  CORRADE_USE_PEDANTIC_FLAGS   - Enable additional compiler/linker flags.
 #   Boolean.
+#  CORRADE_PRECOMPILED_HEADERS  - Headers to precompile for targets created
+#   with :command:`corrade_add_test`, :command:`corrade_add_plugin` and
+#   :command:`corrade_add_static_plugin`. All tests in a directory share a
+#   single precompiled header, plugins each get their own. Requires CMake 3.16,
+#   ignored on older versions.
+#  CORRADE_UNITY_BUILD          - Enable :prop_tgt:`UNITY_BUILD` for targets
+#   created with :command:`corrade_add_test`, :command:`corrade_add_plugin`
+#   and :command:`corrade_add_static_plugin`. Boolean. Requires CMake 3.16,
+#   ignored on older versions.
 #
 # These properties are inherited from directory properties, meaning that if you
 # set them on directories, they get implicitly set on all targets in given
@@ -63,6 +72,19 @@
 # 11, meaning that you will always have at least C++11 enabled once you link to
 # any Corrade library.
 #
+# The :prop_tgt:`CORRADE_PRECOMPILED_HEADERS` and :prop_tgt:`CORRADE_UNITY_BUILD`
+# properties are applied when the target is created and thus only setting them
+# on a directory has an effect, for example::
+#
+#  set_directory_properties(PROPERTIES
+#      CORRADE_PRECOMPILED_HEADERS "<Corrade/TestSuite/Tester.h>"
+#      CORRADE_UNITY_BUILD ON)
+#
+# As the precompiled header is shared by all tests in given directory, tests
+# that need different compiler flags or preprocessor definitions than the rest
+# should be put into a separate directory. Files generated by
+# :command:`corrade_add_resource` are always excluded from unity builds.
+#
 # Features of found Corrade library are exposed in these variables:
 #
 #  CORRADE_MSVC2019_COMPATIBILITY - Defined if compiled with compatibility
@@ -98,6 +120,8 @@
 #  CORRADE_TARGET_MSVC          - Defined if compiling with MSVC or Clang with
 #   a MSVC frontend
 #  CORRADE_TARGET_MINGW         - Defined if compiling under MinGW
+#  CORRADE_INTERCONNECT_PROFILE - Defined if Interconnect records signal
+#   emission statistics
 #  CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT - Defined if PluginManager
 #   doesn't support dynamic plugin loading due to platform limitations
 #  CORRADE_TESTSUITE_TARGET_XCTEST - Defined if TestSuite is targetting Xcode
@@ -140,7 +164,8 @@
 #                   <sources>...
 #                   [LIBRARIES <libraries>...]
 #                   [FILES <files>...]
-#                   [ARGUMENTS <arguments>...])
+#                   [ARGUMENTS <arguments>...]
+#                   [PGO_TRAINING])
 #
 # Test name is also executable name. You can use ``LIBRARIES`` to specify
 # libraries to link with instead of using :command:`target_link_libraries()`.
@@ -162,6 +187,14 @@
 # filesystem location. The remote location can't be absolute or contain ``..``
 # / ``@`` characters.
 #
+# If ``PGO_TRAINING`` is specified, the test gets a ``pgo-training``
+# :prop_test:`LABELS` entry and is added to the ``CORRADE_PGO_TRAINING_TESTS``
+# global property. Such tests, usually benchmarks, are meant to be run with
+# ``ctest -L pgo-training`` against libraries instrumented for profile-guided
+# optimization in order to collect the profiles. When building Corrade itself
+# with ``BUILD_PGO_GENERATE`` and ``BUILD_TESTS`` enabled, the ``pgo-training``
+# target builds and runs them automatically.
+#
 # Unless :variable:`CORRADE_TESTSUITE_TARGET_XCTEST` is set, test cases on iOS
 # targets are created as bundles with bundle identifier set to CMake project
 # name by default. Use the cache variable :variable:`CORRADE_TESTSUITE_BUNDLE_IDENTIFIER_PREFIX`
@@ -171,7 +204,7 @@
 #
 # Compile data resources into application binary::
 #
-#  corrade_add_resource(<name> <resources.conf>)
+#  corrade_add_resource(<name> <resources.conf> [INCBIN])
 #
 # Depends on ``Corrade::rc``, which is part of Corrade utilities. This command
 # generates resource data using given configuration file in current build
@@ -183,6 +216,11 @@
 #  corrade_add_resource(app_resources resources.conf)
 #  add_executable(app source1 source2 ... ${app_resources})
 #
+# If ``INCBIN`` is specified, the data are put into a separate file that's
+# included using the assembler ``.incbin`` directive instead of being embedded
+# as a hexadecimal array, which makes compilation of large resources
+# significantly faster. Supported only by GCC and Clang, ignored elsewhere.
+#
 # .. command:: corrade_add_plugin
 #
 # Add dynamic plugin::
@@ -215,6 +253,13 @@
 # ``${CMAKE_CURRENT_BINARY_DIR}/${CMAKE_CFG_INTDIR}``. See documentation of
 # :variable:`CMAKE_CFG_INTDIR` variable for more information.
 #
+# If ``EMBED_METADATA`` is specified right after ``<metadata file>``, the
+# metadata are embedded into a dedicated section of the plugin binary
+# (``.corrade`` on ELF and PE platforms, ``__TEXT,__corrade`` on Apple
+# platforms) instead of being copied and installed alongside it. The plugin
+# manager then reads them directly from the binary without loading it. A
+# metadata file next to the binary still takes precedence.
+#
 # .. command:: corrade_add_static_plugin
 #
 # Add static plugin::
@@ -231,7 +276,9 @@
 # ``<library install dir>``. Note that plugins built in debug configuration
 # (e.g. with :variable:`CMAKE_BUILD_TYPE` set to ``Debug``) have ``"-d"``
 # suffix to make it possible to have both debug and release plugins installed
-# alongside each other.
+# alongside each other. The plugin metadata are compiled in as a resource
+# that's registered by ``CORRADE_PLUGIN_IMPORT()`` together with the plugin
+# itself and not by an automatic initializer at startup.
 #
 #  corrade_add_static_plugin(<plugin name>
 #                            <install dir>
@@ -320,6 +367,7 @@ set(_corradeFlags
     # is unclear on platforms with multi-arch binaries or when mixing different
     # STL implementations. TARGET_GCC etc are figured out via UseCorrade.cmake,
     # as the compiler can be different when compiling the lib & when using it.
+    INTERCONNECT_PROFILE
     PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
     TESTSUITE_TARGET_XCTEST
     UTILITY_USE_ANSI_COLORS)
@@ -533,6 +581,12 @@ foreach(_component ${Corrade_FIND_COMPONENTS})
                 set_property(TARGET Corrade::${_component} APPEND PROPERTY
                     INTERFACE_LINK_LIBRARIES "log")
             endif()
+            # AsyncOutput class needs to be linked to threads
+            if(CORRADE_BUILD_MULTITHREADED AND NOT CORRADE_TARGET_EMSCRIPTEN)
+                find_package(Threads REQUIRED)
+                set_property(TARGET Corrade::${_component} APPEND PROPERTY
+                    INTERFACE_LINK_LIBRARIES Threads::Threads)
+            endif()
         endif()
 
         # Find library includes
@@ -242,6 +242,16 @@ define_property(TARGET PROPERTY CORRADE_USE_PEDANTIC_FLAGS INHERITED
     BRIEF_DOCS "Use pedantic compiler/linker flags"
     FULL_DOCS "Enables additional pedantic C, C++ and linker flags on given
         targets or directories.")
+define_property(TARGET PROPERTY CORRADE_PRECOMPILED_HEADERS INHERITED
+    BRIEF_DOCS "Headers to precompile"
+    FULL_DOCS "Headers to precompile for targets created with
+        corrade_add_test(), corrade_add_plugin() and
+        corrade_add_static_plugin() in given directory. Requires CMake 3.16.")
+define_property(TARGET PROPERTY CORRADE_UNITY_BUILD INHERITED
+    BRIEF_DOCS "Use unity builds"
+    FULL_DOCS "Enables unity builds for targets created with
+        corrade_add_test(), corrade_add_plugin() and
+        corrade_add_static_plugin() in given directory. Requires CMake 3.16.")
 
 # In order to avoid clashes with builtin CMake features, we won't add the
 # standard flag in case the CXX_STANDARD property is present. Additionally,
@@ -322,6 +332,15 @@ endif()
 if(CORRADE_TARGET_EMSCRIPTEN)
     # For bundling files to the tests
     include(UseEmscripten)
+
+    # Threads on Emscripten need the whole project to be built with -pthread.
+    # Detect that from the global flags so corrade_add_test() can set up the
+    # runners accordingly.
+    if(CMAKE_CXX_FLAGS MATCHES "(-pthread|USE_PTHREADS=1)")
+        set(_CORRADE_TESTSUITE_EMSCRIPTEN_PTHREADS ON)
+    else()
+        set(_CORRADE_TESTSUITE_EMSCRIPTEN_PTHREADS OFF)
+    endif()
 endif()
 
 if(CORRADE_TARGET_IOS AND NOT CORRADE_TESTSUITE_TARGET_XCTEST)
@@ -329,6 +348,52 @@ if(CORRADE_TARGET_IOS AND NOT CORRADE_TESTSUITE_TARGET_XCTEST)
         "Bundle identifier prefix for tests ran on iOS device")
 endif()
 
+# Sets up precompiled headers and unity builds for a target created by
+# corrade_add_test(), corrade_add_plugin() or corrade_add_static_plugin()
+# based on the CORRADE_PRECOMPILED_HEADERS and CORRADE_UNITY_BUILD properties.
+# If shared_pch is set, all such targets in the directory reuse the same
+# precompiled header instead of each building its own.
+function(_corrade_setup_build_acceleration target shared_pch)
+    if(CMAKE_VERSION VERSION_LESS 3.16)
+        return()
+    endif()
+
+    get_target_property(unity_build ${target} CORRADE_UNITY_BUILD)
+    if(unity_build)
+        set_target_properties(${target} PROPERTIES UNITY_BUILD ON)
+    endif()
+
+    get_target_property(headers ${target} CORRADE_PRECOMPILED_HEADERS)
+    if(NOT headers)
+        return()
+    endif()
+
+    if(NOT shared_pch)
+        target_precompile_headers(${target} PRIVATE ${headers})
+        return()
+    endif()
+
+    # Tests are usually a single file each, so building a precompiled header
+    # for each of them would only make things slower. Instead, the header is
+    # built once for the whole directory by a dummy target compiled with the
+    # same options as the tests and all tests then reuse it.
+    get_directory_property(pch_target _CORRADE_TEST_PCH_TARGET)
+    if(NOT pch_target)
+        file(RELATIVE_PATH pch_directory ${CMAKE_SOURCE_DIR} ${CMAKE_CURRENT_SOURCE_DIR})
+        string(MAKE_C_IDENTIFIER "CorradeTestPch_${pch_directory}" pch_target)
+        set(pch_source ${CMAKE_CURRENT_BINARY_DIR}/${pch_target}.cpp)
+        if(NOT EXISTS ${pch_source})
+            file(WRITE ${pch_source} "")
+        endif()
+        add_library(${pch_target} OBJECT ${pch_source})
+        target_link_libraries(${pch_target} PRIVATE Corrade::TestSuite)
+        set_property(TARGET ${pch_target} APPEND PROPERTY COMPILE_OPTIONS "$<$<BOOL:$<TARGET_PROPERTY:CORRADE_USE_PEDANTIC_FLAGS>>:${CORRADE_PEDANTIC_TEST_COMPILER_OPTIONS}>")
+        target_precompile_headers(${pch_target} PRIVATE ${headers})
+        set_directory_properties(PROPERTIES _CORRADE_TEST_PCH_TARGET ${pch_target})
+    endif()
+    target_precompile_headers(${target} REUSE_FROM ${pch_target})
+endfunction()
+
 function(corrade_add_test test_name)
     set(_corrade_file_pair_match "^(.+)@([^@]+)$")
     set(_corrade_file_pair_replace "\\1;\\2")
@@ -344,6 +409,8 @@ function(corrade_add_test test_name)
             set(_DOING_LIBRARIES OFF)
             set(_DOING_FILES OFF)
             set(_DOING_ARGUMENTS ON)
+        elseif(arg STREQUAL PGO_TRAINING)
+            set(pgo_training ON)
         else()
             if(_DOING_LIBRARIES)
                 list(APPEND libraries ${arg})
@@ -426,6 +493,12 @@ function(corrade_add_test test_name)
             # properly. See TestSuite CMakeLists for further information.
             set_property(TARGET ${test_name} APPEND_STRING PROPERTY COMPILE_FLAGS " -s DISABLE_EXCEPTION_CATCHING=0")
             set_property(TARGET ${test_name} APPEND_STRING PROPERTY LINK_FLAGS " -s DISABLE_EXCEPTION_CATCHING=0")
+            # With threads enabled, run main() in a worker. Threads can't be
+            # spawned while the browser main thread is blocked, which the
+            # test would otherwise do for its whole duration.
+            if(_CORRADE_TESTSUITE_EMSCRIPTEN_PTHREADS)
+                set_property(TARGET ${test_name} APPEND_STRING PROPERTY LINK_FLAGS " -s PROXY_TO_PTHREAD=1")
+            endif()
             find_package(NodeJs REQUIRED)
             add_test(NAME ${test_name} COMMAND NodeJs::NodeJs --stack-trace-limit=0 $<TARGET_FILE:${test_name}> ${arguments})
 
@@ -437,10 +510,12 @@ function(corrade_add_test test_name)
                 emscripten_embed_file(${test_name} ${input_filename} "/${output_filename}")
             endforeach()
 
-            # Generate the runner file, first replacing ${test_name} with
-            # configure_file() and then copying that into the final location.
-            # Two steps because file(GENERATE) can't replace variables while
-            # configure_file() can't have generator expressions in the path.
+            # Generate the runner file, first replacing ${test_name} and
+            # ${test_pthreads} with configure_file() and then copying that
+            # into the final location. Two steps because file(GENERATE) can't
+            # replace variables while configure_file() can't have generator
+            # expressions in the path.
+            set(test_pthreads ${_CORRADE_TESTSUITE_EMSCRIPTEN_PTHREADS})
             configure_file(${CORRADE_TESTSUITE_EMSCRIPTEN_RUNNER}
                            ${CMAKE_CURRENT_BINARY_DIR}/${test_name}.html)
             file(GENERATE OUTPUT $<TARGET_FILE_DIR:${test_name}>/${test_name}.html
@@ -457,6 +532,13 @@ function(corrade_add_test test_name)
             string(REPLACE ";" " " arguments_str "${arguments}")
             add_test(NAME ${test_name} COMMAND ${CORRADE_TESTSUITE_ADB_RUNNER} $<TARGET_FILE_DIR:${test_name}> "$<TARGET_FILE_NAME:${test_name}> ${arguments_str}" ${files})
 
+            # Save the same information into a manifest file so all tests can
+            # be run at once using `AdbRunner.sh --batch`, avoiding the adb
+            # round-trips for every test
+            string(REPLACE ";" "\n" files_str "${files}")
+            file(GENERATE OUTPUT ${CMAKE_BINARY_DIR}/CorradeAdbTests/${test_name}.txt
+                CONTENT "$<TARGET_FILE_DIR:${test_name}>\n$<TARGET_FILE_NAME:${test_name}> ${arguments_str}\n${files_str}\n")
+
         # Run tests natively elsewhere
         else()
             add_test(NAME ${test_name} COMMAND ${test_name} ${arguments})
@@ -472,12 +554,31 @@ function(corrade_add_test test_name)
     endif()
 
     set_property(TARGET ${test_name} APPEND PROPERTY COMPILE_OPTIONS "$<$<BOOL:$<TARGET_PROPERTY:CORRADE_USE_PEDANTIC_FLAGS>>:${CORRADE_PEDANTIC_TEST_COMPILER_OPTIONS}>")
+    _corrade_setup_build_acceleration(${test_name} ON)
 
     # Add the file to list of required files for given test case
     set_tests_properties(${test_name} PROPERTIES REQUIRED_FILES "${absolute_files}")
+
+    # Mark the test as a profile-guided optimization training run
+    if(pgo_training)
+        set_property(TEST ${test_name} APPEND PROPERTY LABELS pgo-training)
+        set_property(GLOBAL APPEND PROPERTY CORRADE_PGO_TRAINING_TESTS ${test_name})
+    endif()
 endfunction()
 
 function(corrade_add_resource name configurationFile)
+    # Embedding the data via .incbin is supported only by GCC-compatible
+    # compilers, silently fall back to a hexadecimal array elsewhere
+    set(rcOptions )
+    set(outBinary )
+    if(ARGN STREQUAL INCBIN)
+        if(NOT MSVC AND NOT CORRADE_TARGET_EMSCRIPTEN AND CMAKE_CXX_COMPILER_ID MATCHES "GNU|Clang")
+            set(rcOptions --incbin)
+        endif()
+    elseif(ARGN)
+        message(SEND_ERROR "corrade_add_resource(): unrecognized arguments ${ARGN}")
+    endif()
+
     # Parse dependencies from the file
     set(dependencies )
     set(filenameRegex "^[ \t]*filename[ \t]*=[ \t]*\"?([^\"]+)\"?[ \t]*$")
@@ -505,14 +606,27 @@ function(corrade_add_resource name configurationFile)
     # deletions are not recognized automatically)
     configure_file(${configurationFile} ${outDepends} COPYONLY)
 
-    # Run command
+    # The .incbin'd data file is not tracked by the compiler dependency
+    # scanning, but the generated source contains its hash so it changes every
+    # time the data change
+    if(rcOptions)
+        set(outBinary BYPRODUCTS "${out}.bin")
+    endif()
+
+    # Run command. Corrade::rc writes the output only if it changed.
     add_custom_command(
         OUTPUT "${out}"
-        COMMAND Corrade::rc ${name} "${configurationFile}" "${out}"
+        ${outBinary}
+        COMMAND Corrade::rc ${rcOptions} ${name} "${configurationFile}" "${out}"
         DEPENDS Corrade::rc ${outDepends} ${dependencies} ${name}-dependencies
         COMMENT "Compiling data resource file ${out}"
         WORKING_DIRECTORY "${CMAKE_CURRENT_SOURCE_DIR}")
 
+    # Every generated file defines the same names in an anonymous namespace,
+    # so it can't be merged with other sources in a unity build. The property
+    # is ignored on CMake < 3.16.
+    set_source_files_properties("${out}" PROPERTIES SKIP_UNITY_BUILD_INCLUSION ON)
+
     # Save output filename
     set(${name} "${out}" PARENT_SCOPE)
 endfunction()
@@ -551,6 +665,50 @@ function(corrade_add_plugin plugin_name debug_install_dirs release_install_dirs
         endif()
     endif()
 
+    # Metadata embedded into the binary instead of a file next to it
+    set(sources ${ARGN})
+    set(embed_metadata OFF)
+    list(GET sources 0 first_source)
+    if(first_source STREQUAL EMBED_METADATA)
+        list(REMOVE_AT sources 0)
+        set(embed_metadata ON)
+
+        # Put the metadata into a dedicated section that the plugin manager
+        # finds without loading the binary, see
+        # PluginManager/Implementation/embeddedMetadata.h. The data are
+        # regenerated on every CMake run, and CMake is rerun on every metadata
+        # change; configure_file() only updates the output if it's different.
+        set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS ${CMAKE_CURRENT_SOURCE_DIR}/${metadata_file})
+        file(READ ${CMAKE_CURRENT_SOURCE_DIR}/${metadata_file} metadata_hex HEX)
+        string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," metadata_hex "${metadata_hex}")
+        set(metadata_source ${CMAKE_CURRENT_BINARY_DIR}/${plugin_name}-metadata.cpp)
+        file(WRITE ${metadata_source}.in "/* Plugin metadata embedded by corrade_add_plugin(). DO NOT EDIT! */
+
+/* MSVC would discard unreferenced data, so there it's an external symbol
+   that's explicitly included by the linker, elsewhere it's enough to mark it
+   as used */
+#ifdef _MSC_VER
+#pragma section(\".corrade\", read)
+#define CORRADE_PLUGIN_METADATA extern \"C\" __declspec(allocate(\".corrade\"))
+#ifdef _M_IX86
+#pragma comment(linker, \"/include:_corradePluginMetadata\")
+#else
+#pragma comment(linker, \"/include:corradePluginMetadata\")
+#endif
+#elif defined(__APPLE__)
+#define CORRADE_PLUGIN_METADATA static __attribute__((used, section(\"__TEXT,__corrade\")))
+#else
+#define CORRADE_PLUGIN_METADATA static __attribute__((used, section(\".corrade\")))
+#endif
+
+CORRADE_PLUGIN_METADATA const unsigned char corradePluginMetadata[] = {
+    ${metadata_hex}0x00
+};
+")
+        configure_file(${metadata_source}.in ${metadata_source} COPYONLY)
+        list(APPEND sources ${metadata_source})
+    endif()
+
     # Create dynamic library and bring all needed options along. On Windows a
     # DLL cannot have undefined references, so we need to link against all its
     # dependencies *at compile time*, as opposed to runtime like in all sane
@@ -560,14 +718,16 @@ function(corrade_add_plugin plugin_name debug_install_dirs release_install_dirs
     # create the corresponding import lib for it. So we work around that by
     # using SHARED on Windows.
     if(CORRADE_TARGET_WINDOWS)
-        add_library(${plugin_name} SHARED ${ARGN})
+        add_library(${plugin_name} SHARED ${sources})
     else()
-        add_library(${plugin_name} MODULE ${ARGN})
+        add_library(${plugin_name} MODULE ${sources})
     endif()
     set_target_properties(${plugin_name} PROPERTIES CORRADE_CXX_STANDARD 11)
     target_compile_definitions(${plugin_name} PRIVATE "CORRADE_DYNAMIC_PLUGIN")
     target_include_directories(${plugin_name} PUBLIC $<TARGET_PROPERTY:Corrade::PluginManager,INTERFACE_INCLUDE_DIRECTORIES>)
 
+    _corrade_setup_build_acceleration(${plugin_name} OFF)
+
     # Plugins don't have any prefix (e.g. 'lib' on Linux)
     set_target_properties(${plugin_name} PROPERTIES PREFIX "")
 
@@ -581,13 +741,15 @@ function(corrade_add_plugin plugin_name debug_install_dirs release_install_dirs
     add_custom_target(${plugin_name}-metadata SOURCES ${CMAKE_CURRENT_SOURCE_DIR}/${metadata_file})
 
     # Copy metadata next to the binary so tests and CMake subprojects can use
-    # it as well
-    add_custom_command(TARGET ${plugin_name} POST_BUILD
-        # This would be nice to Ninja, but BYPRODUCTS don't support generator
-        # expressions right now (last checked: CMake 3.16)
-        #BYPRODUCTS $<TARGET_FILE_DIR:${plugin_name}>/${plugin_name}.conf
-        COMMAND ${CMAKE_COMMAND} -E copy ${CMAKE_CURRENT_SOURCE_DIR}/${metadata_file} $<TARGET_FILE_DIR:${plugin_name}>/${plugin_name}.conf
-        DEPENDS ${CMAKE_CURRENT_SOURCE_DIR}/${metadata_file} ${name}-metadata)
+    # it as well, unless they're embedded
+    if(NOT embed_metadata)
+        add_custom_command(TARGET ${plugin_name} POST_BUILD
+            # This would be nice to Ninja, but BYPRODUCTS don't support
+            # generator expressions right now (last checked: CMake 3.16)
+            #BYPRODUCTS $<TARGET_FILE_DIR:${plugin_name}>/${plugin_name}.conf
+            COMMAND ${CMAKE_COMMAND} -E copy ${CMAKE_CURRENT_SOURCE_DIR}/${metadata_file} $<TARGET_FILE_DIR:${plugin_name}>/${plugin_name}.conf
+            DEPENDS ${CMAKE_CURRENT_SOURCE_DIR}/${metadata_file} ${name}-metadata)
+    endif()
 
     # Install it somewhere, unless that's explicitly not wanted
     if(NOT debug_install_dirs STREQUAL CMAKE_CURRENT_BINARY_DIR)
@@ -604,12 +766,14 @@ function(corrade_add_plugin plugin_name debug_install_dirs release_install_dirs
             RUNTIME DESTINATION ${release_binary_install_dir}
             LIBRARY DESTINATION ${release_library_install_dir}
             ARCHIVE DESTINATION ${release_library_install_dir})
-        install(FILES ${metadata_file} DESTINATION ${debug_conf_install_dir}
-            RENAME "${plugin_name}.conf"
-            CONFIGURATIONS Debug)
-        install(FILES ${metadata_file} DESTINATION ${release_conf_install_dir}
-            RENAME "${plugin_name}.conf"
-            CONFIGURATIONS "" None Release RelWithDebInfo MinSizeRel)
+        if(NOT embed_metadata)
+            install(FILES ${metadata_file} DESTINATION ${debug_conf_install_dir}
+                RENAME "${plugin_name}.conf"
+                CONFIGURATIONS Debug)
+            install(FILES ${metadata_file} DESTINATION ${release_conf_install_dir}
+                RENAME "${plugin_name}.conf"
+                CONFIGURATIONS "" None Release RelWithDebInfo MinSizeRel)
+        endif()
     endif()
 endfunction()
 
@@ -628,6 +792,11 @@ function(corrade_add_static_plugin plugin_name install_dirs metadata_file)
     set(resource_file "${CMAKE_CURRENT_BINARY_DIR}/resources_${plugin_name}.conf")
     file(WRITE "${resource_file}" "group=CorradeStaticPlugin_${plugin_name}\n[file]\nfilename=\"${CMAKE_CURRENT_SOURCE_DIR}/${metadata_file}\"\nalias=${plugin_name}.conf")
     corrade_add_resource(${plugin_name} "${resource_file}")
+    # The metadata get registered by CORRADE_PLUGIN_IMPORT() together with
+    # the plugin itself, so there's no need to run anything at startup
+    set_property(SOURCE ${${plugin_name}} APPEND PROPERTY COMPILE_DEFINITIONS
+        "CORRADE_AUTOMATIC_INITIALIZER=CORRADE_NOOP"
+        "CORRADE_AUTOMATIC_FINALIZER=CORRADE_NOOP")
 
     # Create static library and bring all needed options along
     add_library(${plugin_name} STATIC ${ARGN} ${${plugin_name}})
@@ -636,6 +805,7 @@ function(corrade_add_static_plugin plugin_name install_dirs metadata_file)
     target_include_directories(${plugin_name} PUBLIC $<TARGET_PROPERTY:Corrade::PluginManager,INTERFACE_INCLUDE_DIRECTORIES>)
 
     set_target_properties(${plugin_name} PROPERTIES DEBUG_POSTFIX "-d")
+    _corrade_setup_build_acceleration(${plugin_name} OFF)
 
     # Install, if not into the same place
     if(NOT install_dirs STREQUAL CMAKE_CURRENT_BINARY_DIR)
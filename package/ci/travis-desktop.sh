@@ -10,6 +10,7 @@ cmake .. \
     -DBUILD_TESTS=ON \
     -DBUILD_DEPRECATED=$BUILD_DEPRECATED \
     -DBUILD_STATIC=$BUILD_STATIC \
+    -DINTERCONNECT_PROFILE=$INTERCONNECT_PROFILE \
     -DCMAKE_BUILD_TYPE=Debug \
     -G Ninja
 ninja
@@ -0,0 +1,96 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "AllocationTracking.h"
+
+#include <cstdint>
+
+#include "Corrade/Utility/Assert.h"
+#include "Corrade/Utility/Debug.h"
+#include "Corrade/Utility/Macros.h"
+
+namespace Corrade { namespace Containers {
+
+namespace {
+
+AllocationTracker globalTracker{};
+void* globalTrackerState{};
+std::size_t globalSampleRate = 1;
+
+CORRADE_THREAD_LOCAL const char* currentTag = nullptr;
+
+/* Fibonacci hashing, dropping the low bits that are always zero due to the
+   allocation alignment so neighboring allocations spread over the samples */
+inline bool sampled(const void* const pointer) {
+    const std::size_t hash = (reinterpret_cast<std::uintptr_t>(pointer) >> 4)*std::size_t(0x9e3779b97f4a7c15ull);
+    return (hash >> sizeof(std::size_t)*4) % globalSampleRate == 0;
+}
+
+}
+
+Utility::Debug& operator<<(Utility::Debug& debug, const AllocationEvent value) {
+    debug << "Containers::AllocationEvent" << Utility::Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case AllocationEvent::value: return debug << "::" #value;
+        _c(Allocate)
+        _c(Reallocate)
+        _c(Deallocate)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Utility::Debug::nospace << reinterpret_cast<void*>(std::size_t(value)) << Utility::Debug::nospace << ")";
+}
+
+void setAllocationTracker(const AllocationTracker tracker, void* const state, const std::size_t sampleRate) {
+    CORRADE_ASSERT(sampleRate,
+        "Containers::setAllocationTracker(): sample rate can't be zero", );
+    globalTracker = tracker;
+    globalTrackerState = state;
+    globalSampleRate = sampleRate;
+}
+
+const char* allocationTag() { return currentTag; }
+
+ScopedAllocationTag::ScopedAllocationTag(const char* const tag): _previous{currentTag} {
+    currentTag = tag;
+}
+
+ScopedAllocationTag::~ScopedAllocationTag() { currentTag = _previous; }
+
+namespace Implementation {
+
+void trackAllocation(const AllocationEvent event, const void* const pointer, const void* const previousPointer, const std::size_t size) {
+    if(!globalTracker) return;
+    if(globalSampleRate != 1 && !sampled(pointer) && !(previousPointer && sampled(previousPointer)))
+        return;
+    globalTracker(globalTrackerState, event, pointer, previousPointer, size, currentTag);
+}
+
+}
+
+}}
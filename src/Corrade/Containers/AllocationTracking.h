@@ -0,0 +1,210 @@
+#ifndef Corrade_Containers_AllocationTracking_h
+#define Corrade_Containers_AllocationTracking_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Containers::ScopedAllocationTag, enum @ref Corrade::Containers::AllocationEvent, typedef @ref Corrade::Containers::AllocationTracker, function @ref Corrade::Containers::setAllocationTracker(), @ref Corrade::Containers::allocationTag(), macro @ref CORRADE_CONTAINERS_TRACK_ALLOCATIONS
+ * @m_since_latest
+ */
+
+#include <cstddef>
+
+#include "Corrade/Utility/Utility.h"
+#include "Corrade/Utility/visibility.h"
+
+#ifdef DOXYGEN_GENERATING_OUTPUT
+/**
+@brief Enable allocation tracking
+@m_since_latest
+
+This macro is not defined by Corrade, but rather meant to be defined by the
+user. When defined, every allocation, reallocation and deallocation done by
+@ref Corrade::Containers::Array "Containers::Array" with the default deleter,
+by the @ref Corrade::Containers::ArrayNewAllocator "ArrayNewAllocator",
+@ref Corrade::Containers::ArrayMallocAllocator "ArrayMallocAllocator" and
+@ref Corrade::Containers::ArrayAlignedAllocator "ArrayAlignedAllocator"
+growable array allocators, by @ref Corrade::Containers::Pointer "Containers::Pointer"
+and by @ref Corrade::Containers::SharedArray "Containers::SharedArray" is
+reported to a callback set with
+@ref Corrade::Containers::setAllocationTracker() "Containers::setAllocationTracker()".
+The reported events can be attributed to subsystems using
+@ref Corrade::Containers::ScopedAllocationTag "Containers::ScopedAllocationTag",
+and with a sample rate the overhead can be kept low enough to be enabled in
+production builds:
+
+@snippet Containers.cpp AllocationTracking
+
+Memory that is not allocated by the containers themselves, such as arrays
+with a custom deleter or the @ref Corrade::Containers::ArrayMappedAllocator "ArrayMappedAllocator",
+isn't reported. On the other hand, if an @ref Corrade::Containers::Array "Array"
+with the default deleter or a @ref Corrade::Containers::Pointer "Pointer"
+adopts memory allocated elsewhere, its deallocation is reported without a
+matching allocation. Memory released from the containers with
+@ref Corrade::Containers::Array::release() "release()" is never reported as
+deallocated.
+
+As the containers are header-only templates, the macro should be defined
+globally for the whole project, for example via the compiler command line,
+otherwise the same template instantiated in two places may or may not report
+the allocations depending on which instance the linker picks.
+*/
+#define CORRADE_CONTAINERS_TRACK_ALLOCATIONS
+#undef CORRADE_CONTAINERS_TRACK_ALLOCATIONS
+#endif
+
+namespace Corrade { namespace Containers {
+
+/**
+@brief Allocation event
+@m_since_latest
+
+@see @ref AllocationTracker, @ref setAllocationTracker()
+*/
+enum class AllocationEvent: unsigned char {
+    /**
+     * A new allocation. The pointer is the newly allocated memory, the
+     * previous pointer is @cpp nullptr @ce and the size is the allocated
+     * size in bytes.
+     */
+    Allocate = 1,
+
+    /**
+     * A reallocation of a growable array. The pointer is the new location,
+     * the previous pointer is the original location and the size is the new
+     * allocated size in bytes. If the two pointers differ, the contents were
+     * copied or moved to the new location and the original memory freed.
+     */
+    Reallocate,
+
+    /**
+     * A deallocation. The pointer is the freed memory, the previous pointer
+     * is @cpp nullptr @ce and the size is the freed size in bytes.
+     */
+    Deallocate
+};
+
+/**
+@debugoperatorenum{AllocationEvent}
+@m_since_latest
+*/
+CORRADE_UTILITY_EXPORT Utility::Debug& operator<<(Utility::Debug& debug, AllocationEvent value);
+
+/**
+@brief Allocation tracker
+@m_since_latest
+
+Called with the state passed to @ref setAllocationTracker(), the event, the
+pointer and previous pointer, size in bytes and the tag set by the innermost
+@ref ScopedAllocationTag on the calling thread, or @cpp nullptr @ce if there's
+none. See @ref AllocationEvent for the meaning of the arguments for each
+event. The callback is called from the thread doing the allocation, it's
+thus expected to be thread-safe if the containers are used from multiple
+threads. It shouldn't itself allocate through the tracked containers, as
+that would recurse.
+*/
+typedef void(*AllocationTracker)(void* state, AllocationEvent event, const void* pointer, const void* previousPointer, std::size_t size, const char* tag);
+
+/**
+@brief Set an allocation tracker
+@param tracker      Tracker callback or @cpp nullptr @ce to disable the
+    tracking
+@param state        State passed to the tracker
+@param sampleRate   Report roughly one in @p sampleRate allocations
+@m_since_latest
+
+Events are reported only from code compiled with
+@ref CORRADE_CONTAINERS_TRACK_ALLOCATIONS defined. With no tracker set, each
+tracked operation costs just a single non-inline function call.
+
+If @p sampleRate is larger than @cpp 1 @ce, the event is reported only if a
+hash of its address falls into given sample, which means that an allocation
+and its later deallocation are either both reported or both not and the
+tracker doesn't need to maintain any extra state. A reallocation is reported
+if either the new or the previous address is sampled, so the tracker should
+ignore events for addresses it hasn't seen allocated before. Multiplying the
+sampled sizes by @p sampleRate then gives an estimate of the total. Expects
+that @p sampleRate is not zero.
+
+Not thread-safe --- the tracker is expected to be set up before other
+threads start allocating.
+*/
+CORRADE_UTILITY_EXPORT void setAllocationTracker(AllocationTracker tracker, void* state = nullptr, std::size_t sampleRate = 1);
+
+/**
+@brief Current allocation tag
+@m_since_latest
+
+Tag set by the innermost @ref ScopedAllocationTag on the calling thread or
+@cpp nullptr @ce if there's none.
+*/
+CORRADE_UTILITY_EXPORT const char* allocationTag();
+
+/**
+@brief Scoped allocation tag
+@m_since_latest
+
+Sets a tag that's passed to the @ref AllocationTracker for all allocations
+done by the calling thread until the instance goes out of scope, restoring
+the previous tag after. The tag is usually a string literal naming a
+subsystem or a call site, such as @ref CORRADE_LINE_STRING together with the
+file name. Its memory is expected to stay in scope for as long as the
+tracker may refer to it.
+*/
+class CORRADE_UTILITY_EXPORT ScopedAllocationTag {
+    public:
+        /** @brief Constructor */
+        explicit ScopedAllocationTag(const char* tag);
+
+        /** @brief Copying is not allowed */
+        ScopedAllocationTag(const ScopedAllocationTag&) = delete;
+
+        /** @brief Moving is not allowed */
+        ScopedAllocationTag(ScopedAllocationTag&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Restores the tag that was set before.
+         */
+        ~ScopedAllocationTag();
+
+        /** @brief Copying is not allowed */
+        ScopedAllocationTag& operator=(const ScopedAllocationTag&) = delete;
+
+        /** @brief Moving is not allowed */
+        ScopedAllocationTag& operator=(ScopedAllocationTag&&) = delete;
+
+    private:
+        const char* _previous;
+};
+
+namespace Implementation {
+    CORRADE_UTILITY_EXPORT void trackAllocation(AllocationEvent event, const void* pointer, const void* previousPointer, std::size_t size);
+}
+
+}}
+
+#endif
@@ -26,20 +26,47 @@
 */
 
 /** @file
- * @brief Class @ref Corrade::Containers::Array
+ * @brief Class @ref Corrade::Containers::Array, @ref Corrade::Containers::ArrayNewDeleter
  */
 
+#include <cstdlib>
 #include <initializer_list>
 #include <new>
 #include <type_traits>
-#include <utility>
 
 #include "Corrade/configure.h"
 #include "Corrade/Containers/ArrayView.h"
 #include "Corrade/Containers/Tags.h"
+#include "Corrade/Utility/Move.h"
+#include "Corrade/Utility/TypeTraits.h"
+#ifdef CORRADE_CONTAINERS_TRACK_ALLOCATIONS
+#include "Corrade/Containers/AllocationTracking.h"
+#endif
 
 namespace Corrade { namespace Containers {
 
+/**
+@brief Stateless array deleter
+@m_since_latest
+
+Calls @cpp delete[] @ce on the array, same as the default @ref Array deleter
+does when set to @cpp nullptr @ce. As the deleter is an empty type, an
+@ref Array using it takes just a pointer and a size and the deletion is a
+direct call instead of a branch and an indirect function call. See
+@ref Containers-Array-stateless-deleter for more information.
+*/
+template<class T> struct ArrayNewDeleter {
+    /** @brief Delete the array */
+    void operator()(T* data, std::size_t size) const {
+        #ifdef CORRADE_CONTAINERS_TRACK_ALLOCATIONS
+        if(data) Implementation::trackAllocation(AllocationEvent::Deallocate, data, nullptr, size*sizeof(T));
+        #else
+        static_cast<void>(size);
+        #endif
+        delete[] data;
+    }
+};
+
 namespace Implementation {
     template<class T> struct DefaultDeleter {
         T operator()() const { return T{}; }
@@ -56,15 +83,45 @@ namespace Implementation {
     template<class T> struct CallDeleter<T, void(*)(T*, std::size_t)> {
         void operator()(void(*deleter)(T*, std::size_t), T* data, std::size_t size) const {
             if(deleter) deleter(data, size);
-            else delete[] data;
+            else {
+                #ifdef CORRADE_CONTAINERS_TRACK_ALLOCATIONS
+                if(data) trackAllocation(AllocationEvent::Deallocate, data, nullptr, size*sizeof(T));
+                #endif
+                delete[] data;
+            }
         }
     };
 
     template<class T> T* noInitAllocate(std::size_t size, typename std::enable_if<std::is_trivial<T>::value>::type* = nullptr) {
-        return new T[size];
+        T* const data = new T[size];
+        #ifdef CORRADE_CONTAINERS_TRACK_ALLOCATIONS
+        trackAllocation(AllocationEvent::Allocate, data, nullptr, size*sizeof(T));
+        #endif
+        return data;
     }
     template<class T> T* noInitAllocate(std::size_t size, typename std::enable_if<!std::is_trivial<T>::value>::type* = nullptr) {
-        return reinterpret_cast<T*>(new char[size*sizeof(T)]);
+        T* const data = reinterpret_cast<T*>(new char[size*sizeof(T)]);
+        #ifdef CORRADE_CONTAINERS_TRACK_ALLOCATIONS
+        trackAllocation(AllocationEvent::Allocate, data, nullptr, size*sizeof(T));
+        #endif
+        return data;
+    }
+
+    template<class T> void arrayFreeDeleter(T* data, std::size_t size) {
+        #ifdef CORRADE_CONTAINERS_TRACK_ALLOCATIONS
+        if(data) trackAllocation(AllocationEvent::Deallocate, data, nullptr, size*sizeof(T));
+        #else
+        static_cast<void>(size);
+        #endif
+        std::free(data);
+    }
+
+    template<class T> T* valueInitAllocate(std::size_t size) {
+        T* const data = new T[size]();
+        #ifdef CORRADE_CONTAINERS_TRACK_ALLOCATIONS
+        trackAllocation(AllocationEvent::Allocate, data, nullptr, size*sizeof(T));
+        #endif
+        return data;
     }
 
     template<class T> auto noInitDeleter(typename std::enable_if<std::is_trivial<T>::value>::type* = nullptr) -> void(*)(T*, std::size_t) {
@@ -74,9 +131,54 @@ namespace Implementation {
         return [](T* data, std::size_t size) {
             if(data) for(T *it = data, *end = data + size; it != end; ++it)
                 it->~T();
+            #ifdef CORRADE_CONTAINERS_TRACK_ALLOCATIONS
+            if(data) trackAllocation(AllocationEvent::Deallocate, data, nullptr, size*sizeof(T));
+            #endif
             delete[] reinterpret_cast<char*>(data);
         };
     }
+
+    /* Deleters for arrays allocated by the Array itself. Not defined for
+       custom deleter types, as it's not known how they delete the memory. */
+    template<class T, class D> struct ArrayAllocationDeleter;
+    template<class T> struct ArrayAllocationDeleter<T, void(*)(T*, std::size_t)> {
+        static void(*newDeleter())(T*, std::size_t) { return nullptr; }
+        static void(*noInitDeleter())(T*, std::size_t) {
+            return Implementation::noInitDeleter<T>();
+        }
+    };
+    template<class T> struct ArrayAllocationDeleter<T, ArrayNewDeleter<T>> {
+        static ArrayNewDeleter<T> newDeleter() { return {}; }
+        static ArrayNewDeleter<T> noInitDeleter() {
+            static_assert(std::is_trivial<T>::value,
+                "only arrays of trivial types can be constructed without initialization with ArrayNewDeleter");
+            return {};
+        }
+    };
+
+    /* Stores a stateless deleter as an empty base to not make the array
+       larger. The pointer and size are always first to allow direct access
+       from GrowableArray.h. */
+    template<class T, class D, bool = std::is_empty<D>::value> struct ArrayStorage {
+        /* GCC <=4.8 breaks on _deleter{} */
+        explicit ArrayStorage(T* data, std::size_t size, D deleter) noexcept: _data{data}, _size{size}, _deleter(deleter) {}
+
+        D& deleterRef() { return _deleter; }
+        const D& deleterRef() const { return _deleter; }
+
+        T* _data;
+        std::size_t _size;
+        D _deleter;
+    };
+    template<class T, class D> struct ArrayStorage<T, D, true>: D {
+        explicit ArrayStorage(T* data, std::size_t size, D deleter) noexcept: D(deleter), _data{data}, _size{size} {}
+
+        D& deleterRef() { return *this; }
+        const D& deleterRef() const { return *this; }
+
+        T* _data;
+        std::size_t _size;
+    };
 }
 
 /**
@@ -125,6 +227,15 @@ Example:
 
 @snippet Containers.cpp Array-initialization
 
+For large arrays of trivially constructible types, @ref arrayCalloc() can be
+used instead of value initialization. It allocates the memory with
+@ref std::calloc(), and since large allocations are commonly satisfied
+directly with fresh memory pages from the operating system, which are already
+zeroed, the zero-initialization is practically free and no physical memory
+gets used until the pages are touched. Such arrays have a custom
+@ref deleter() calling @ref std::free(), which is why this isn't done
+implicitly.
+
 @section Containers-Array-wrapping Wrapping externally allocated arrays
 
 By default the class makes all allocations using @cpp operator new[] @ce and
@@ -146,6 +257,22 @@ deleter type can be used:
 
 @snippet Containers.cpp Array-deleter
 
+@subsection Containers-Array-stateless-deleter Stateless deleters
+
+If the deleter type is empty, such as a non-capturing function object, it
+isn't stored at all and the array takes just a pointer and a size. The
+@ref ArrayNewDeleter type makes use of that for the common case of arrays
+deleted with @cpp delete[] @ce. Compared to the default deleter, which has to
+check for @cpp nullptr @ce and otherwise call through a function pointer, the
+destruction is a direct @cpp delete[] @ce. Such an array can be created with
+all constructors except that the @ref Array(NoInitT, std::size_t),
+@ref Array(DirectInitT, std::size_t, Args&&... args) and
+@ref Array(InPlaceInitT, std::initializer_list<T>) constructors are
+available only for trivial types. It's implicitly move-convertible to an @ref Array
+with the default deleter:
+
+@snippet Containers.cpp Array-stateless-deleter
+
 @section Containers-Array-growable Growable arrays
 
 The @ref Array class provides no reallocation or growing capabilities on its
@@ -164,6 +291,20 @@ populating an array with an undetermined amount of elements:
 
 @snippet Containers.cpp Array-growable
 
+If the data come from a file or a decoder, @ref arrayAppend(Array<T>&, NoInitT, std::size_t)
+returns a view on given count of uninitialized items at the end, which can be
+written to directly without any intermediate copy. Items can be inserted at
+arbitrary positions with @ref arrayInsert():
+
+@snippet Containers.cpp Array-growable-noinit
+
+Items are removed from arbitrary positions with @ref arrayRemove(), which
+shifts the rest, or in constant time with @ref arrayRemoveUnordered() if the
+order doesn't matter. All items matching a predicate can be removed in a single
+pass using @ref arrayRemoveIf():
+
+@snippet Containers.cpp Array-growable-remove
+
 A growable array can be turned back into a regular one using
 @ref arrayShrink() if desired. That'll free all extra memory, moving the
 elements to an array of exactly the size needed.
@@ -186,13 +327,47 @@ array is converted to a growable version (or back, with @ref arrayShrink()).
 The @ref ArrayAllocator is by default aliased to @ref ArrayNewAllocator, which
 uses the standard C++ @cpp new[] @ce / @cpp delete[] @ce constructs and is
 fully move-aware, requiring the types to be only nothrow-move-constructible at
-the very least. If a type is trivially copyable, the @ref ArrayMallocAllocator
-will get picked instead, make use of @ref std::realloc() to avoid unnecessary
-memory copies when growing the array. The typeless nature of
+the very least. If a type is trivially copyable or
+@ref Utility::IsTriviallyRelocatable "trivially relocatable", the
+@ref ArrayMallocAllocator will get picked instead, make use of
+@ref std::realloc() to avoid unnecessary memory copies when growing the array. The typeless nature of
 @ref ArrayMallocAllocator internals allows for free type-casting of the array
 instance with @ref arrayAllocatorCast(), an operation not easily doable using
 typed allocators.
 
+Types with an alignment larger than what these two allocators can guarantee
+use the @ref ArrayAlignedAllocator, which can be also picked explicitly to
+get arrays with a custom alignment, for example for SIMD processing:
+
+@snippet Containers.cpp ArrayAlignedAllocator
+
+The growth strategy of any allocator can be changed using
+@ref ArrayGrowthAllocator, for example to round allocations to whole memory
+pages with @ref ArrayPageRoundedGrowth or to bound overallocation of huge
+arrays with @ref ArrayCappedLinearGrowth.
+
+Very large trivially copyable arrays can use the @ref ArrayMappedAllocator
+from @ref Corrade/Containers/ArrayMappedAllocator.h, which maps memory pages
+directly from the OS and grows them without copying the contents.
+
+For many short-lived growable arrays, such as per-frame scratch buffers, the
+@ref ArrayArenaAllocator from @ref Corrade/Containers/ArrayArena.h allocates
+from a bump-pointer @ref ArrayArena instead of the global heap, with all memory
+reclaimed at once using @ref ArrayArena::reset().
+
+@subsection Containers-Array-growable-relocation Trivially relocatable types
+
+When a growable array is reallocated or when items are inserted in the middle,
+the existing elements are moved to a new location and the originals
+destructed. For types marked with @ref Utility::IsTriviallyRelocatable this is
+done with a single @ref std::memcpy() or @ref std::memmove() instead, and the
+@ref ArrayMallocAllocator is used by default, making it possible to grow the
+array in-place with @ref std::realloc(). The trait is enabled for all trivially
+copyable types and Corrade's own move-only containers including
+@ref Array, @ref Pointer, @ref Optional, @ref SharedArray and
+@ref StaticArray of trivially relocatable types, and you can opt-in your own
+types as well.
+
 @subsection Containers-Array-growable-sanitizer AddressSanitizer container annotations
 
 Because the alloacted growable arrays have an area between @ref size() and
@@ -263,12 +438,21 @@ template<class T, class D = void(*)(T*, std::size_t)>
 #else
 template<class T, class D>
 #endif
-class Array {
+class Array
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    : Implementation::ArrayStorage<T, D>
+    #endif
+{
     /* Ideally this could be derived from ArrayView<T>, avoiding a lot of
        redundant code, however I'm unable to find a way to add const/non-const
        overloads of all slicing functions and also prevent const Array<T>& from
        being sliced to a (mutable) ArrayView<T>. */
 
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    using Implementation::ArrayStorage<T, D>::_data;
+    using Implementation::ArrayStorage<T, D>::_size;
+    #endif
+
     public:
         typedef T Type;     /**< @brief Element type */
         typedef D Deleter;  /**< @brief Deleter type */
@@ -279,8 +463,7 @@ class Array {
         #else
         template<class U, class V = typename std::enable_if<std::is_same<std::nullptr_t, U>::value>::type> /*implicit*/ Array(U) noexcept:
         #endif
-            /* GCC <=4.8 breaks on _deleter{} */
-            _data{nullptr}, _size{0}, _deleter(Implementation::DefaultDeleter<D>{}()) {}
+            Implementation::ArrayStorage<T, D>(nullptr, 0, Implementation::DefaultDeleter<D>{}()) {}
 
         /**
          * @brief Default constructor
@@ -288,8 +471,7 @@ class Array {
          * Creates a zero-sized array. Move an array with a nonzero size onto
          * the instance to make it useful.
          */
-        /* GCC <=4.8 breaks on _deleter{} */
-        /*implicit*/ Array() noexcept: _data(nullptr), _size(0), _deleter(Implementation::DefaultDeleter<D>{}()) {}
+        /*implicit*/ Array() noexcept: Implementation::ArrayStorage<T, D>(nullptr, 0, Implementation::DefaultDeleter<D>{}()) {}
 
         /**
          * @brief Construct a default-initialized array
@@ -299,7 +481,11 @@ class Array {
          * allocation is done.
          * @see @ref DefaultInit, @ref Array(ValueInitT, std::size_t)
          */
-        explicit Array(DefaultInitT, std::size_t size): _data{size ? new T[size] : nullptr}, _size{size}, _deleter{nullptr} {}
+        explicit Array(DefaultInitT, std::size_t size): Implementation::ArrayStorage<T, D>(size ? new T[size] : nullptr, size, Implementation::ArrayAllocationDeleter<T, D>::newDeleter()) {
+            #ifdef CORRADE_CONTAINERS_TRACK_ALLOCATIONS
+            if(_data) Implementation::trackAllocation(AllocationEvent::Allocate, _data, nullptr, size*sizeof(T));
+            #endif
+        }
 
         /**
          * @brief Construct a value-initialized array
@@ -307,13 +493,17 @@ class Array {
          * Creates array of given size, the contents are value-initialized
          * (i.e. builtin types are zero-initialized). For other than builtin
          * types this is the same as @ref Array(std::size_t). If the size is
-         * zero, no allocation is done.
+         * zero, no allocation is done. See also @ref arrayCalloc() for
+         * a cheaper alternative for large arrays of trivially
+         * constructible types.
          *
          * Useful if you want to create an array of primitive types and sett
          * them to zero.
          * @see @ref ValueInit, @ref Array(DefaultInitT, std::size_t)
          */
-        explicit Array(ValueInitT, std::size_t size): _data{size ? new T[size]() : nullptr}, _size{size}, _deleter{nullptr} {}
+        explicit Array(ValueInitT, std::size_t size): Implementation::ArrayStorage<T, D>(nullptr, size, Implementation::ArrayAllocationDeleter<T, D>::newDeleter()) {
+            if(size) _data = Implementation::valueInitAllocate<T>(size);
+        }
 
         /**
          * @brief Construct an array without initializing its contents
@@ -337,7 +527,7 @@ class Array {
          * @see @ref NoInit, @ref Array(DirectInitT, std::size_t, Args&&... args),
          *      @ref deleter(), @ref std::is_trivial
          */
-        explicit Array(NoInitT, std::size_t size): _data{size ? Implementation::noInitAllocate<T>(size) : nullptr}, _size{size}, _deleter{Implementation::noInitDeleter<T>()} {}
+        explicit Array(NoInitT, std::size_t size): Implementation::ArrayStorage<T, D>(size ? Implementation::noInitAllocate<T>(size) : nullptr, size, Implementation::ArrayAllocationDeleter<T, D>::noInitDeleter()) {}
 
         /**
          * @brief Construct a direct-initialized array
@@ -380,10 +570,26 @@ class Array {
          * @p deleter. See class documentation for more information about
          * custom deleters and @ref ArrayView for non-owning array wrapper.
          */
-        /* GCC <=4.8 breaks on _deleter{} */
-        explicit Array(T* data, std::size_t size, D deleter = Implementation::DefaultDeleter<D>{}()): _data{data}, _size{size}, _deleter(deleter) {}
+        explicit Array(T* data, std::size_t size, D deleter = Implementation::DefaultDeleter<D>{}()): Implementation::ArrayStorage<T, D>(data, size, deleter) {}
+
+        /**
+         * @brief Convert from an array with a stateless deleter
+         * @m_since_latest
+         *
+         * Enabled only for the default deleter. Takes over the data of
+         * @p other, which is then empty, and deletes them using
+         * @cpp operator delete[] @ce on destruction. See
+         * @ref Containers-Array-stateless-deleter for more information.
+         */
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        /*implicit*/ Array(Array<T, ArrayNewDeleter<T>>&& other) noexcept;
+        #else
+        template<class U, class = typename std::enable_if<std::is_same<D, void(*)(T*, std::size_t)>::value && std::is_same<U, ArrayNewDeleter<T>>::value>::type> /*implicit*/ Array(Array<T, U>&& other) noexcept: Implementation::ArrayStorage<T, D>(other.data(), other.size(), nullptr) {
+            other.release();
+        }
+        #endif
 
-        ~Array() { Implementation::CallDeleter<T, D>{}(_deleter, _data, _size); }
+        ~Array() { Implementation::CallDeleter<T, D>{}(this->deleterRef(), _data, _size); }
 
         /** @brief Copying is not allowed */
         Array(const Array<T, D>&) = delete;
@@ -455,7 +661,7 @@ class Array {
          * @cpp operator delete[] @ce.
          * @see @ref Array(T*, std::size_t, D)
          */
-        D deleter() const { return _deleter; }
+        D deleter() const { return this->deleterRef(); }
 
         /** @brief Array size */
         std::size_t size() const { return _size; }
@@ -640,10 +846,6 @@ class Array {
          */
         T* release();
 
-    private:
-        T* _data;
-        std::size_t _size;
-        D _deleter;
 };
 
 /** @relatesalso Array
@@ -657,6 +859,39 @@ template<class T> inline Array<T> array(std::initializer_list<T> list) {
     return Array<T>{InPlaceInit, list};
 }
 
+/** @relatesalso Array
+@brief Construct a zero-initialized array using @ref std::calloc()
+@m_since_latest
+
+Compared to @ref Array::Array(ValueInitT, std::size_t), large allocations
+are usually satisfied directly with fresh memory pages from the operating
+system, which are already zeroed, so the zero-initialization is practically
+free. The returned array has a custom @ref Array::deleter() calling
+@ref std::free(), so when using @ref Array::release(), the memory has to be
+freed with @ref std::free() as well. If @p size is zero, no allocation is
+done. If the allocation fails, the program is aborted, similarly to
+@cpp new[] @ce with exceptions disabled. Expects that @p T is trivially
+constructible.
+@see @ref Containers-Array-initialization
+*/
+template<class T> Array<T> arrayCalloc(const std::size_t size) {
+    static_assert(
+        #ifdef CORRADE_STD_IS_TRIVIALLY_TRAITS_SUPPORTED
+        std::is_trivially_constructible<T>::value
+        #else
+        __has_trivial_constructor(T)
+        #endif
+        , "only trivially constructible types can be zero-initialized with calloc()");
+    if(!size) return {};
+
+    T* const data = static_cast<T*>(std::calloc(size, sizeof(T)));
+    if(!data) std::abort(); /* LCOV_EXCL_LINE */
+    #ifdef CORRADE_CONTAINERS_TRACK_ALLOCATIONS
+    Implementation::trackAllocation(AllocationEvent::Allocate, data, nullptr, size*sizeof(T));
+    #endif
+    return Array<T>{data, size, Implementation::arrayFreeDeleter<T>};
+}
+
 /** @relatesalso ArrayView
 @brief Make view on @ref Array
 
@@ -704,15 +939,15 @@ template<class T> std::size_t arraySize(const Array<T>& view) {
     return view.size();
 }
 
-template<class T, class D> inline Array<T, D>::Array(Array<T, D>&& other) noexcept: _data{other._data}, _size{other._size}, _deleter{other._deleter} {
+template<class T, class D> inline Array<T, D>::Array(Array<T, D>&& other) noexcept: Implementation::ArrayStorage<T, D>(other._data, other._size, other.deleterRef()) {
     other._data = nullptr;
     other._size = 0;
-    other._deleter = D{};
+    other.deleterRef() = D{};
 }
 
 template<class T, class D> template<class ...Args> Array<T, D>::Array(DirectInitT, std::size_t size, Args&&... args): Array{NoInit, size} {
     for(std::size_t i = 0; i != size; ++i)
-        new(_data + i) T{std::forward<Args>(args)...};
+        new(_data + i) T{Utility::forward<Args>(args)...};
 }
 
 template<class T, class D> Array<T, D>::Array(InPlaceInitT, std::initializer_list<T> list): Array{NoInit, list.size()} {
@@ -721,10 +956,10 @@ template<class T, class D> Array<T, D>::Array(InPlaceInitT, std::initializer_lis
 }
 
 template<class T, class D> inline Array<T, D>& Array<T, D>::operator=(Array<T, D>&& other) noexcept {
-    using std::swap;
+    using Utility::swap;
     swap(_data, other._data);
     swap(_size, other._size);
-    swap(_deleter, other._deleter);
+    swap(this->deleterRef(), other.deleterRef());
     return *this;
 }
 
@@ -750,7 +985,7 @@ template<class T, class D> inline T* Array<T, D>::release() {
     T* const data = _data;
     _data = nullptr;
     _size = 0;
-    _deleter = D{};
+    this->deleterRef() = D{};
     return data;
 }
 
@@ -783,6 +1018,14 @@ template<class T, class D> struct ErasedArrayViewConverter<const Array<T, D>>: A
 
 }
 
+}
+
+namespace Utility {
+
+/* Array is just a pointer, a size and a deleter, which is trivially
+   relocatable unless it's a custom stateful type */
+template<class T, class D> struct IsTriviallyRelocatable<Containers::Array<T, D>>: IsTriviallyRelocatable<D> {};
+
 }}
 
 #endif
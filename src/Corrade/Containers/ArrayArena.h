@@ -0,0 +1,439 @@
+#ifndef Corrade_Containers_ArrayArena_h
+#define Corrade_Containers_ArrayArena_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Containers::ArrayArena, @ref Corrade::Containers::ArrayArenaScope, @ref Corrade::Containers::ArrayArenaAllocator
+ * @m_since_latest
+ */
+
+#include <cstdlib>
+#include <cstdint>
+
+#include "Corrade/Containers/GrowableArray.h"
+#include "Corrade/Utility/Macros.h"
+
+/* Same as in GrowableArray.h, which undefines it at the end. The
+   __sanitizer_annotate_contiguous_container() declaration is taken from
+   there. */
+#ifdef __has_feature
+#if __has_feature(address_sanitizer)
+#define _CORRADE_CONTAINERS_SANITIZER_ENABLED
+#endif
+#endif
+#ifdef __SANITIZE_ADDRESS__
+#define _CORRADE_CONTAINERS_SANITIZER_ENABLED
+#endif
+
+namespace Corrade { namespace Containers {
+
+/**
+@brief Bump allocator arena for growable arrays
+@m_since_latest
+
+Hands out memory by bumping a pointer inside a list of large blocks. Freeing
+individual allocations is a no-op (except for the most recent allocation,
+which gets rewound), all memory gets reclaimed at once by calling @ref reset()
+or by destroying the arena. Blocks are kept across @ref reset() calls, so a
+per-frame arena that's reset at the end of every frame reaches a steady state
+where it doesn't touch the global heap at all.
+
+The arena is meant to be used through @ref ArrayArenaAllocator together with
+the @ref arrayAppend(), @ref arrayReserve(), ... family of functions. Because
+the @ref ArrayAllocator interface is static, the allocator always uses the
+arena made current for the calling thread using @ref ArrayArenaScope:
+
+@snippet Containers.cpp ArrayArena
+
+@attention All arrays allocated from the arena become dangling after
+    @ref reset() or arena destruction. Their deleters don't free any memory, so
+    it's fine to let them go out of scope after that, but their contents
+    shouldn't be accessed anymore.
+
+If Corrade is compiled with @ref CORRADE_BUILD_MULTITHREADED enabled (the
+default), the current arena is stored in a thread-local variable, which means
+each thread has its own current arena. The arena itself isn't thread-safe,
+each instance is expected to be used by a single thread only.
+*/
+class ArrayArena {
+    public:
+        /**
+         * @brief Arena that's current for the calling thread
+         *
+         * Returns @cpp nullptr @ce if no @ref ArrayArenaScope is active.
+         */
+        static ArrayArena* current() { return currentInternal(); }
+
+        /**
+         * @brief Constructor
+         * @param blockSize     Size of a single block in bytes
+         *
+         * No memory is allocated upfront, the first block gets allocated on
+         * the first call to @ref allocate(). Allocations larger than
+         * @p blockSize get a dedicated block.
+         */
+        explicit ArrayArena(std::size_t blockSize = 65536) noexcept: _blockSize{blockSize}, _first{}, _current{}, _top{}, _end{}, _last{} {}
+
+        /** @brief Copying is not allowed */
+        ArrayArena(const ArrayArena&) = delete;
+
+        /** @brief Moving is not allowed */
+        ArrayArena(ArrayArena&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Frees all blocks. Expects that the arena isn't current in any
+         * thread.
+         */
+        ~ArrayArena() {
+            for(Block* block = _first; block; ) {
+                Block* const next = block->next;
+                std::free(block);
+                block = next;
+            }
+        }
+
+        /** @brief Copying is not allowed */
+        ArrayArena& operator=(const ArrayArena&) = delete;
+
+        /** @brief Moving is not allowed */
+        ArrayArena& operator=(ArrayArena&&) = delete;
+
+        /** @brief Block size */
+        std::size_t blockSize() const { return _blockSize; }
+
+        /**
+         * @brief Count of allocated blocks
+         *
+         * Blocks are kept allocated across @ref reset() calls.
+         */
+        std::size_t blockCount() const {
+            std::size_t count = 0;
+            for(Block* block = _first; block; block = block->next) ++count;
+            return count;
+        }
+
+        /**
+         * @brief Count of bytes used since the last reset
+         *
+         * Includes alignment padding and space wasted at the end of blocks.
+         */
+        std::size_t usedSize() const {
+            std::size_t size = 0;
+            for(Block* block = _first; block; block = block->next) {
+                if(block == _current) return size + (_top - block->data());
+                size += block->size;
+            }
+            return size;
+        }
+
+        /**
+         * @brief Allocate memory
+         * @param size          Size in bytes
+         * @param alignment     Alignment in bytes. Expected to be a power of
+         *      two.
+         *
+         * The returned memory is uninitialized.
+         */
+        void* allocate(std::size_t size, std::size_t alignment) {
+            #ifdef _CORRADE_CONTAINERS_SANITIZER_ENABLED
+            /* ASan expects annotated containers to start at an 8-byte
+               boundary, which alignof(std::size_t) isn't on 32-bit */
+            if(alignment < 8) alignment = 8;
+            #endif
+
+            char* aligned = alignUp(_top, alignment);
+            if(!_current || aligned + size > _end) {
+                nextBlock(size + alignment);
+                aligned = alignUp(_top, alignment);
+            }
+
+            _last = aligned;
+            _top = aligned + size;
+
+            #ifdef _CORRADE_CONTAINERS_SANITIZER_ENABLED
+            /* The memory may have been used by a growable array before a
+               release() or reset(), clear the container annotations it left
+               behind so ASan sees it as a fresh allocation. Going from an
+               empty to a full container makes the whole range addressable
+               regardless of its previous state. */
+            __sanitizer_annotate_contiguous_container(aligned, aligned + size, aligned, aligned + size);
+            #endif
+
+            return aligned;
+        }
+
+        /**
+         * @brief Try to grow an allocation in-place
+         *
+         * If @p data is the most recent allocation and the current block has
+         * enough space, extends it to @p size bytes and returns
+         * @cpp true @ce. Returns @cpp false @ce otherwise.
+         */
+        bool growInPlace(void* data, std::size_t size) {
+            char* const begin = static_cast<char*>(data);
+            if(begin != _last || begin + size > _end) return false;
+            _top = begin + size;
+
+            #ifdef _CORRADE_CONTAINERS_SANITIZER_ENABLED
+            /* Growable arrays annotate the whole grown capacity as if it was
+               a new allocation, which expects no leftover annotations from
+               before */
+            __sanitizer_annotate_contiguous_container(begin, begin + size, begin, begin + size);
+            #endif
+
+            return true;
+        }
+
+        /**
+         * @brief Release an allocation
+         *
+         * If @p data is the most recent allocation, the arena is rewound to
+         * reuse its memory. Otherwise the memory is reclaimed only on
+         * @ref reset().
+         */
+        void release(void* data) {
+            if(static_cast<char*>(data) != _last) return;
+            _top = _last;
+            _last = nullptr;
+        }
+
+        /**
+         * @brief Reset the arena
+         *
+         * Makes all memory available for reuse again without freeing any
+         * blocks. All arrays previously allocated from the arena become
+         * dangling.
+         */
+        void reset() {
+            _current = _first;
+            _top = _first ? _first->data() : nullptr;
+            _end = _first ? _top + _first->size : nullptr;
+            _last = nullptr;
+        }
+
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        static ArrayArena*& currentInternal() {
+            #ifdef CORRADE_BUILD_MULTITHREADED
+            CORRADE_THREAD_LOCAL
+            #endif
+            static ArrayArena* current = nullptr;
+            return current;
+        }
+        #endif
+
+    private:
+        struct Block {
+            Block* next;
+            std::size_t size;
+
+            char* data() { return reinterpret_cast<char*>(this + 1); }
+        };
+
+        static char* alignUp(char* pointer, std::size_t alignment) {
+            return reinterpret_cast<char*>((reinterpret_cast<std::uintptr_t>(pointer) + alignment - 1) & ~std::uintptr_t(alignment - 1));
+        }
+
+        void nextBlock(std::size_t minSize) {
+            /* Reuse the next block if it's large enough, otherwise insert a
+               new one after the current one */
+            Block* next = _current ? _current->next : _first;
+            if(!next || next->size < minSize) {
+                const std::size_t size = minSize > _blockSize ? minSize : _blockSize;
+                Block* const block = static_cast<Block*>(std::malloc(sizeof(Block) + size));
+                block->size = size;
+                block->next = next;
+                if(_current) _current->next = block;
+                else _first = block;
+                next = block;
+            }
+
+            _current = next;
+            _top = next->data();
+            _end = _top + next->size;
+            _last = nullptr;
+        }
+
+        std::size_t _blockSize;
+        Block *_first, *_current;
+        char *_top, *_end, *_last;
+};
+
+/**
+@brief Scope making an arena current
+@m_since_latest
+
+Makes given @ref ArrayArena current for the calling thread for the lifetime of
+this object, restoring the previously current arena on destruction. Scopes can
+be nested.
+*/
+class ArrayArenaScope {
+    public:
+        /** @brief Constructor */
+        explicit ArrayArenaScope(ArrayArena& arena) noexcept: _previous{ArrayArena::currentInternal()} {
+            ArrayArena::currentInternal() = &arena;
+        }
+
+        /** @brief Copying is not allowed */
+        ArrayArenaScope(const ArrayArenaScope&) = delete;
+
+        /** @brief Moving is not allowed */
+        ArrayArenaScope(ArrayArenaScope&&) = delete;
+
+        /** @brief Destructor */
+        ~ArrayArenaScope() { ArrayArena::currentInternal() = _previous; }
+
+        /** @brief Copying is not allowed */
+        ArrayArenaScope& operator=(const ArrayArenaScope&) = delete;
+
+        /** @brief Moving is not allowed */
+        ArrayArenaScope& operator=(ArrayArenaScope&&) = delete;
+
+    private:
+        ArrayArena* _previous;
+};
+
+/**
+@brief Arena allocator for growable arrays
+@m_since_latest
+
+An @ref ArrayAllocator that allocates memory from the @ref ArrayArena that's
+current for the calling thread. Similarly to @ref ArrayNewAllocator it's
+reserving an extra space *before* the data to store array capacity. Growing
+the most recently allocated array is done in-place, without any copy;
+deallocation is a no-op unless the array is the most recent allocation, in
+which case the arena gets rewound. Expects that @p T is nothrow
+move-constructible. Example usage:
+
+@snippet Containers.cpp ArrayArena
+
+@see @ref Containers-Array-growable
+*/
+template<class T> struct ArrayArenaAllocator {
+    typedef T Type; /**< Pointer type */
+
+    /**
+     * @brief Allocate (but not construct) an array of given capacity
+     *
+     * Expects that an arena is current for the calling thread.
+     */
+    static T* allocate(std::size_t capacity) {
+        ArrayArena* const arena = ArrayArena::current();
+        CORRADE_ASSERT(arena, "Containers::ArrayArenaAllocator: no arena is current", nullptr);
+        char* const memory = static_cast<char*>(arena->allocate(capacity*sizeof(T) + Offset, Alignment));
+        reinterpret_cast<std::size_t*>(memory + Offset)[-1] = capacity;
+        return reinterpret_cast<T*>(memory + Offset);
+    }
+
+    /**
+     * @brief Reallocate an array to given capacity
+     *
+     * If @p array is the most recent allocation of the current arena and
+     * there's enough space left, grows it in-place. Otherwise delegates to
+     * @ref allocate(), move-constructs @p prevSize elements from @p array
+     * into the new array and calls destructors on the original elements.
+     */
+    static void reallocate(T*& array, std::size_t prevSize, std::size_t newCapacity) {
+        ArrayArena* const arena = ArrayArena::current();
+        if(arena && arena->growInPlace(base(array), newCapacity*sizeof(T) + Offset)) {
+            reinterpret_cast<std::size_t*>(array)[-1] = newCapacity;
+            return;
+        }
+
+        T* const newArray = allocate(newCapacity);
+        Implementation::arrayMoveConstruct<T>(array, newArray, prevSize);
+        Implementation::arrayDestruct<T>(array, array + prevSize);
+        deallocate(array);
+        array = newArray;
+    }
+
+    /**
+     * @brief Deallocate an array
+     *
+     * If @p data is the most recent allocation of the current arena, the
+     * arena is rewound. Otherwise does nothing, the memory is reclaimed on
+     * @ref ArrayArena::reset().
+     */
+    static void deallocate(T* data) {
+        ArrayArena* const arena = ArrayArena::current();
+        if(data && arena) arena->release(base(data));
+    }
+
+    /**
+     * @brief Grow the array
+     *
+     * Behaves the same as @ref ArrayNewAllocator::grow().
+     */
+    static std::size_t grow(T* array, std::size_t desired) {
+        return ArrayDefaultGrowth::grow(array ? capacity(array) : 0, desired, sizeof(T));
+    }
+
+    /**
+     * @brief Array capacity
+     *
+     * Retrieves the capacity that's stored *before* the front of the @p array.
+     */
+    static std::size_t capacity(T* array) {
+        return reinterpret_cast<std::size_t*>(array)[-1];
+    }
+
+    /**
+     * @brief Array base address
+     *
+     * Returns the address of the allocation, which is *before* the stored
+     * capacity.
+     */
+    static void* base(T* array) {
+        return reinterpret_cast<char*>(array) - Offset;
+    }
+
+    /**
+     * @brief Array deleter
+     *
+     * Calls a destructor on @p size elements and then delegates into
+     * @ref deallocate().
+     */
+    static void deleter(T* data, std::size_t size) {
+        Implementation::arrayDestruct<T>(data, data + size);
+        deallocate(data);
+    }
+
+    private:
+        enum: std::size_t {
+            Alignment = alignof(T) > alignof(std::size_t) ? alignof(T) : alignof(std::size_t),
+            /* Space for the capacity, rounded up to keep the data aligned */
+            Offset = (sizeof(std::size_t) + Alignment - 1)/Alignment*Alignment
+        };
+};
+
+}}
+
+#ifdef _CORRADE_CONTAINERS_SANITIZER_ENABLED
+#undef _CORRADE_CONTAINERS_SANITIZER_ENABLED
+#endif
+
+#endif
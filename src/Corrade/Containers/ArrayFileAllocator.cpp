@@ -0,0 +1,218 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ArrayFileAllocator.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Corrade/Containers/String.h"
+#include "Corrade/Utility/Debug.h"
+#include "Corrade/Utility/Memory.h"
+
+/* Same as in GrowableArray.h, which undefines it at the end. The
+   __sanitizer_annotate_contiguous_container() declaration is taken from
+   there. */
+#ifdef __has_feature
+#if __has_feature(address_sanitizer)
+#define _CORRADE_CONTAINERS_SANITIZER_ENABLED
+#endif
+#endif
+#ifdef __SANITIZE_ADDRESS__
+#define _CORRADE_CONTAINERS_SANITIZER_ENABLED
+#endif
+
+namespace Corrade { namespace Containers { namespace Implementation {
+
+namespace {
+
+#ifdef _CORRADE_CONTAINERS_SANITIZER_ENABLED
+/* ASan doesn't reset the shadow memory on munmap() / mremap(), so container
+   annotations done by the growable array functions would survive into a new
+   mapping at the same address. Going from an empty to a full container makes
+   the whole range addressable regardless of its previous state. */
+void resetAnnotation(char* const begin, const std::size_t size) {
+    __sanitizer_annotate_contiguous_container(begin, begin + size, begin, begin + size);
+}
+#endif
+
+inline ArrayFileAllocatorHeader& header(char* const data) {
+    return reinterpret_cast<ArrayFileAllocatorHeader*>(data)[-1];
+}
+
+std::size_t roundToPages(const std::size_t size) {
+    const std::size_t pageSize = Utility::Memory::pageSize();
+    return (size + pageSize - 1)/pageSize*pageSize;
+}
+
+/* Reserves a bookkeeping page followed by an address range for the file and
+   maps the file into it. The page is anonymous and thus never written to the
+   file. */
+char* mapFile(const int fd, const std::size_t capacity) {
+    const std::size_t pageSize = Utility::Memory::pageSize();
+    void* const base = mmap(nullptr, pageSize + capacity, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+    if(base == MAP_FAILED) return nullptr;
+
+    char* const data = static_cast<char*>(base) + pageSize;
+    if(mmap(data, capacity, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_FIXED, fd, 0) == MAP_FAILED) {
+        munmap(base, pageSize + capacity);
+        return nullptr;
+    }
+
+    #ifdef _CORRADE_CONTAINERS_SANITIZER_ENABLED
+    resetAnnotation(static_cast<char*>(base), pageSize + capacity);
+    #endif
+
+    header(data) = ArrayFileAllocatorHeader{capacity, pageSize, fd};
+    return data;
+}
+
+}
+
+char* arrayFileAllocatorAllocate(const std::size_t size) {
+    const std::size_t pageSize = Utility::Memory::pageSize();
+    const std::size_t capacity = roundToPages(size);
+    char* const memory = static_cast<char*>(Utility::Memory::mapPages(pageSize + capacity));
+    /* mapPages() already printed a message */
+    if(!memory) std::abort(); /* LCOV_EXCL_LINE */
+    #ifdef _CORRADE_CONTAINERS_SANITIZER_ENABLED
+    resetAnnotation(memory, pageSize + capacity);
+    #endif
+    char* const data = memory + pageSize;
+    header(data) = ArrayFileAllocatorHeader{capacity, pageSize, -1};
+    return data;
+}
+
+char* arrayFileAllocatorReallocate(char* data, const std::size_t newSize) {
+    const ArrayFileAllocatorHeader previous = header(data);
+    const std::size_t capacity = roundToPages(newSize);
+
+    /* Anonymous memory can be remapped as a whole, which on Linux again
+       doesn't copy anything */
+    if(previous.fd == -1) {
+        #ifdef _CORRADE_CONTAINERS_SANITIZER_ENABLED
+        resetAnnotation(data - previous.offset, previous.offset + previous.capacity);
+        #endif
+        char* const memory = static_cast<char*>(Utility::Memory::remapPages(data - previous.offset, previous.offset + previous.capacity, previous.offset + capacity));
+        /* remapPages() already printed a message */
+        if(!memory) std::abort(); /* LCOV_EXCL_LINE */
+        #ifdef _CORRADE_CONTAINERS_SANITIZER_ENABLED
+        resetAnnotation(memory, previous.offset + capacity);
+        #endif
+        data = memory + previous.offset;
+        header(data).capacity = capacity;
+        return data;
+    }
+
+    if(ftruncate(previous.fd, capacity) != 0) {
+        Utility::Error{} << "Containers::ArrayFileAllocator: can't resize the file to" << capacity << "bytes:" << std::strerror(errno);
+        std::abort(); /* LCOV_EXCL_LINE */
+    }
+
+    #ifdef _CORRADE_CONTAINERS_SANITIZER_ENABLED
+    resetAnnotation(data - previous.offset, previous.offset + previous.capacity);
+    #endif
+
+    /* Try to grow the file mapping in-place first. The bookkeeping page is a
+       separate mapping, so the remap can't be allowed to move. */
+    #ifdef __linux__
+    if(mremap(data, previous.capacity, capacity, 0) != MAP_FAILED) {
+        #ifdef _CORRADE_CONTAINERS_SANITIZER_ENABLED
+        resetAnnotation(data, capacity);
+        #endif
+        header(data).capacity = capacity;
+        return data;
+    }
+    #endif
+
+    /* Otherwise map the file again elsewhere. It's a shared mapping, so no
+       data need to be copied. */
+    char* const newData = mapFile(previous.fd, capacity);
+    if(!newData) {
+        Utility::Error{} << "Containers::ArrayFileAllocator: can't map" << capacity << "bytes:" << std::strerror(errno);
+        std::abort(); /* LCOV_EXCL_LINE */
+    }
+    munmap(data - previous.offset, previous.offset + previous.capacity);
+    return newData;
+}
+
+void arrayFileAllocatorDeallocate(char* const data, const std::size_t usedSize) {
+    const ArrayFileAllocatorHeader previous = header(data);
+    #ifdef _CORRADE_CONTAINERS_SANITIZER_ENABLED
+    resetAnnotation(data - previous.offset, previous.offset + previous.capacity);
+    #endif
+    munmap(data - previous.offset, previous.offset + previous.capacity);
+    if(previous.fd == -1) return;
+
+    /* Dirty pages stay in the page cache after unmapping, so it's fine to
+       truncate only after */
+    if(usedSize != ~std::size_t{} && ftruncate(previous.fd, usedSize) != 0)
+        Utility::Error{} << "Containers::ArrayFileAllocator: can't truncate the file to" << usedSize << "bytes:" << std::strerror(errno);
+    close(previous.fd);
+}
+
+char* arrayFileAllocatorOpen(const StringView filename, const std::size_t itemSize, std::size_t& size) {
+    const int fd = open(String{filename}.data(), O_RDWR|O_CREAT|O_CLOEXEC, 0666);
+    if(fd == -1) {
+        Utility::Error{} << "Containers::arrayMapFile(): can't open" << filename << Utility::Debug::nospace << ":" << std::strerror(errno);
+        return nullptr;
+    }
+
+    struct stat st;
+    if(fstat(fd, &st) != 0) {
+        Utility::Error{} << "Containers::arrayMapFile(): can't get size of" << filename << Utility::Debug::nospace << ":" << std::strerror(errno);
+        close(fd);
+        return nullptr;
+    }
+
+    size = st.st_size;
+    if(size % itemSize) {
+        Utility::Error{} << "Containers::arrayMapFile(): size" << size << "of" << filename << "is not a multiple of" << itemSize << "bytes";
+        close(fd);
+        return nullptr;
+    }
+
+    /* Mapping zero bytes isn't possible, make space for at least a page */
+    std::size_t capacity = roundToPages(size);
+    if(!capacity) capacity = Utility::Memory::pageSize();
+
+    char* data;
+    if(ftruncate(fd, capacity) != 0 || !(data = mapFile(fd, capacity))) {
+        Utility::Error{} << "Containers::arrayMapFile(): can't map" << filename << Utility::Debug::nospace << ":" << std::strerror(errno);
+        /* Don't leave the file enlarged */
+        if(ftruncate(fd, size) != 0) {}
+        close(fd);
+        return nullptr;
+    }
+
+    return data;
+}
+
+}}}
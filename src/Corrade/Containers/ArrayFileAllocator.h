@@ -0,0 +1,217 @@
+#ifndef Corrade_Containers_ArrayFileAllocator_h
+#define Corrade_Containers_ArrayFileAllocator_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if (defined(CORRADE_TARGET_UNIX) && !defined(CORRADE_TARGET_EMSCRIPTEN)) || defined(DOXYGEN_GENERATING_OUTPUT)
+/** @file
+ * @brief Class @ref Corrade::Containers::ArrayFileAllocator, function @ref Corrade::Containers::arrayMapFile()
+ * @m_since_latest
+ */
+#endif
+
+#include "Corrade/configure.h"
+
+#if (defined(CORRADE_TARGET_UNIX) && !defined(CORRADE_TARGET_EMSCRIPTEN)) || defined(DOXYGEN_GENERATING_OUTPUT)
+#include "Corrade/Containers/GrowableArray.h"
+#include "Corrade/Containers/StringView.h"
+#include "Corrade/Utility/visibility.h"
+
+namespace Corrade { namespace Containers {
+
+namespace Implementation {
+
+/* Stored right before the data, so capacity() doesn't need to query the page
+   size */
+struct ArrayFileAllocatorHeader {
+    std::size_t capacity;   /* In bytes */
+    std::size_t offset;     /* Distance from the mapping base to the data */
+    int fd;                 /* -1 for anonymous memory */
+};
+
+CORRADE_UTILITY_EXPORT char* arrayFileAllocatorAllocate(std::size_t size);
+CORRADE_UTILITY_EXPORT char* arrayFileAllocatorReallocate(char* data, std::size_t newSize);
+CORRADE_UTILITY_EXPORT void arrayFileAllocatorDeallocate(char* data, std::size_t usedSize);
+CORRADE_UTILITY_EXPORT char* arrayFileAllocatorOpen(StringView filename, std::size_t itemSize, std::size_t& size);
+
+}
+
+/**
+@brief File-backed allocator for growable arrays
+@m_since_latest
+
+An @ref ArrayAllocator that backs the array with a shared mapping of a file,
+making it possible to have an appendable on-disk array with the same API as
+any other growable array --- for example a log of fixed-size records that
+grows to many gigabytes, without a serialization step. Expects that @p T is
+trivially copyable.
+
+The array is opened using @ref arrayMapFile() and then grown with the usual
+@ref arrayAppend(), @ref arrayReserve() and other functions:
+
+@snippet Containers.cpp ArrayFileAllocator
+
+@section Containers-ArrayFileAllocator-growth Growth and persistence
+
+When the array grows, the file is enlarged with @cpp ftruncate() @ce and the
+mapping grown in-place with @cpp mremap() @ce on Linux. If that's not
+possible or on other Unix systems, the file is mapped again to a new location.
+As the mapping is shared, the data are never copied during growth, only the
+page table is updated. Array capacity is rounded up to whole pages and the
+file is kept at the capacity while the array is alive. On destruction the
+file is truncated to the actual array size, so it contains only the items that
+were appended. If the process terminates without destroying the array, the
+file may contain zero-filled items past the array size. If enlarging or
+mapping the file fails during growth, a message is printed to
+@ref Utility::Error and the program is aborted.
+
+The bookkeeping is stored in a memory page *before* the file mapping and isn't
+written to the file, so the file contains just the raw items. Similarly to
+@ref ArrayMappedAllocator, each array allocation is thus rounded up to whole
+pages, making this allocator suitable only for large arrays.
+
+@section Containers-ArrayFileAllocator-anonymous Arrays without a file
+
+If an array that's not file-backed is grown with this allocator, it's backed
+by anonymous memory instead, behaving the same as with
+@ref ArrayMappedAllocator, including aborting the program if mapping the
+memory fails. Conversely, calling @ref arrayShrink() on a
+file-backed array copies the data to an array with a default deleter,
+truncating and closing the file in the process.
+
+@partialsupport Available only on @ref CORRADE_TARGET_UNIX "Unix" platforms
+    except @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten".
+@see @ref Containers-Array-growable
+*/
+template<class T> struct ArrayFileAllocator {
+    static_assert(
+        #ifdef CORRADE_STD_IS_TRIVIALLY_TRAITS_SUPPORTED
+        std::is_trivially_copyable<T>::value
+        #else
+        Implementation::IsTriviallyCopyableOnOldGcc<T>::value
+        #endif
+        , "only trivially copyable types are usable with this allocator");
+
+    typedef T Type; /**< Pointer type */
+
+    /**
+     * @brief Allocate an array of given capacity
+     *
+     * Maps enough anonymous pages to fit @p capacity elements, preceded by
+     * a page for bookkeeping. Use @ref arrayMapFile() to create a
+     * file-backed array.
+     */
+    static T* allocate(std::size_t capacity) {
+        return reinterpret_cast<T*>(Implementation::arrayFileAllocatorAllocate(capacity*sizeof(T)));
+    }
+
+    /**
+     * @brief Reallocate an array to given capacity
+     *
+     * Grows the file backing @p array to fit @p newCapacity, updating the
+     * @p array reference in case the mapping wasn't grown in-place. The
+     * @p prevSize parameter is ignored, the whole mapping is always
+     * preserved.
+     */
+    static void reallocate(T*& array, std::size_t, std::size_t newCapacity) {
+        array = reinterpret_cast<T*>(Implementation::arrayFileAllocatorReallocate(reinterpret_cast<char*>(array), newCapacity*sizeof(T)));
+    }
+
+    /**
+     * @brief Deallocate an array
+     *
+     * Unmaps @p data and closes the file, keeping it at the full capacity.
+     * Use @ref deleter() to truncate the file to the actual array size.
+     */
+    static void deallocate(T* data) {
+        if(data) Implementation::arrayFileAllocatorDeallocate(reinterpret_cast<char*>(data), ~std::size_t{});
+    }
+
+    /**
+     * @brief Grow the array
+     *
+     * Behaves the same as @ref ArrayNewAllocator::grow(). The mapping is
+     * then rounded up to whole pages, which is reflected in the capacity.
+     */
+    static std::size_t grow(T* array, std::size_t desired) {
+        return ArrayDefaultGrowth::grow(array ? capacity(array) : 0, desired, sizeof(T));
+    }
+
+    /**
+     * @brief Array capacity
+     *
+     * Calculated from the mapping size that's stored *before* the front of
+     * the @p array.
+     */
+    static std::size_t capacity(T* array) {
+        return reinterpret_cast<Implementation::ArrayFileAllocatorHeader*>(array)[-1].capacity/sizeof(T);
+    }
+
+    /**
+     * @brief Array base address
+     *
+     * Returns the beginning of the bookkeeping page.
+     */
+    static void* base(T* array) {
+        return reinterpret_cast<char*>(array) - reinterpret_cast<Implementation::ArrayFileAllocatorHeader*>(array)[-1].offset;
+    }
+
+    /**
+     * @brief Array deleter
+     *
+     * Unmaps @p data, truncates the file to @p size elements and closes
+     * it.
+     */
+    static void deleter(T* data, std::size_t size) {
+        if(data) Implementation::arrayFileAllocatorDeallocate(reinterpret_cast<char*>(data), size*sizeof(T));
+    }
+};
+
+/**
+@brief Map a file as a growable array
+@m_since_latest
+
+Opens @p filename for reading and writing, creating it if it doesn't exist,
+and maps its contents as an array of @p T with @ref ArrayFileAllocator as the
+deleter. The array can be then grown using @ref arrayAppend() and other
+growable array functions with @ref ArrayFileAllocator. If the file can't be
+opened or mapped, or its size isn't a multiple of @cpp sizeof(T) @ce,
+@cpp nullptr @ce is returned and a message is printed to @ref Utility::Error.
+@partialsupport Available only on @ref CORRADE_TARGET_UNIX "Unix" platforms
+    except @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten".
+*/
+template<class T> Array<T> arrayMapFile(const StringView filename) {
+    std::size_t size;
+    char* const data = Implementation::arrayFileAllocatorOpen(filename, sizeof(T), size);
+    if(!data) return {};
+    return Array<T>{reinterpret_cast<T*>(data), size/sizeof(T), ArrayFileAllocator<T>::deleter};
+}
+
+}}
+#else
+#error this file is available only on Unix platforms except Emscripten
+#endif
+
+#endif
@@ -0,0 +1,251 @@
+#ifndef Corrade_Containers_ArrayMappedAllocator_h
+#define Corrade_Containers_ArrayMappedAllocator_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Containers::BasicArrayMappedAllocator, alias @ref Corrade::Containers::ArrayMappedAllocator
+ * @m_since_latest
+ */
+
+#include <cstdlib>
+
+#include "Corrade/Containers/GrowableArray.h"
+#include "Corrade/Utility/Memory.h"
+
+/* Same as in GrowableArray.h, which undefines it at the end. The
+   __sanitizer_annotate_contiguous_container() declaration is taken from
+   there. */
+#ifdef __has_feature
+#if __has_feature(address_sanitizer)
+#define _CORRADE_CONTAINERS_SANITIZER_ENABLED
+#endif
+#endif
+#ifdef __SANITIZE_ADDRESS__
+#define _CORRADE_CONTAINERS_SANITIZER_ENABLED
+#endif
+
+namespace Corrade { namespace Containers {
+
+/**
+@brief Page-mapping allocator for large growable arrays with given page size and NUMA placement
+@m_since_latest
+
+An @ref ArrayAllocator that allocates whole memory pages directly from the OS
+using @ref Utility::Memory::mapPages() and grows them using
+@ref Utility::Memory::remapPages(). On Linux that's done via @cpp mremap() @ce
+and on Windows by committing pages of a larger reserved address range, so
+growing even a multi-gigabyte array never copies its contents. Expects that
+@p T is trivially copyable. Similarly to @ref ArrayMallocAllocator it's
+reserving an extra space *before* to store the mapping size.
+
+Because each allocation is rounded up to whole pages, this allocator is
+suitable only for arrays that are at least several hundreds of kilobytes
+large. Array capacity reflects the whole mapped area, so for example reserving
+a single-byte array will result in a capacity of a whole page minus the space
+needed to store the mapping size. Example usage:
+
+@snippet Containers.cpp ArrayMappedAllocator
+
+Calling @ref arrayShrink() frees the mapping, giving all pages back to the OS,
+but it copies the data to an array with a default deleter in the process.
+
+If mapping or remapping the pages fails, the message printed by
+@ref Utility::Memory::mapPages() or @ref Utility::Memory::remapPages() is
+followed by a call to @ref std::abort().
+
+@section Containers-BasicArrayMappedAllocator-placement Huge pages and NUMA placement
+
+The @p pageSize and @p numaNode template parameters are passed to
+@ref Utility::Memory::mapPages(std::size_t, Utility::Memory::PageSize, int)
+and @ref Utility::Memory::remapPages(void*, std::size_t, std::size_t, Utility::Memory::PageSize, int),
+allowing large arrays to be backed by huge pages and to be placed on a
+particular NUMA node or interleaved across all nodes. With huge pages the
+allocation is rounded up to @ref Utility::Memory::pageSize(Utility::Memory::PageSize)
+instead. The @ref ArrayMappedAllocator alias uses regular pages and the
+default placement. A variant is picked by passing a template alias to the
+growable array functions:
+
+@snippet Containers.cpp BasicArrayMappedAllocator-alias
+
+<b></b>
+
+@snippet Containers.cpp BasicArrayMappedAllocator
+
+The @ref deleter() can be used also with a plain @ref Array, given the memory
+is allocated with @ref allocate() of the same variant. Each variant has a
+distinct deleter, so an array allocated with one variant isn't considered
+growable by another.
+@see @ref Containers-Array-growable
+*/
+template<class T, Utility::Memory::PageSize pageSize, int numaNode> struct BasicArrayMappedAllocator {
+    static_assert(
+        #ifdef CORRADE_STD_IS_TRIVIALLY_TRAITS_SUPPORTED
+        std::is_trivially_copyable<T>::value
+        #else
+        Implementation::IsTriviallyCopyableOnOldGcc<T>::value
+        #endif
+        , "only trivially copyable types are usable with this allocator");
+
+    typedef T Type; /**< Pointer type */
+
+    /**
+     * @brief Allocate an array of given capacity
+     *
+     * Maps enough pages of @p pageSize placed according to @p numaNode to
+     * fit @p capacity elements and space to store the mapping size
+     * *before* the front, returning it cast to @cpp T* @ce. Aborts the
+     * program if the mapping fails.
+     */
+    static T* allocate(std::size_t capacity) {
+        const std::size_t inBytes = mappingSize(capacity);
+        char* const memory = static_cast<char*>(Utility::Memory::mapPages(inBytes, pageSize, numaNode));
+        /* mapPages() already printed a message */
+        if(!memory) std::abort(); /* LCOV_EXCL_LINE */
+        #ifdef _CORRADE_CONTAINERS_SANITIZER_ENABLED
+        resetAnnotation(memory, inBytes);
+        #endif
+        reinterpret_cast<std::size_t*>(memory)[0] = inBytes;
+        return reinterpret_cast<T*>(memory + Offset);
+    }
+
+    /**
+     * @brief Reallocate an array to given capacity
+     *
+     * Remaps the pages backing @p array to fit @p newCapacity and updates
+     * the @p array reference to point to the new location, in case the
+     * remapping wasn't done in-place. The @p prevSize parameter is ignored,
+     * the whole mapping is always preserved. Aborts the program if the
+     * remapping fails.
+     */
+    static void reallocate(T*& array, std::size_t, std::size_t newCapacity) {
+        const std::size_t inBytes = mappingSize(newCapacity);
+        const std::size_t prevInBytes = *static_cast<std::size_t*>(base(array));
+        #ifdef _CORRADE_CONTAINERS_SANITIZER_ENABLED
+        resetAnnotation(base(array), prevInBytes);
+        #endif
+        char* const memory = static_cast<char*>(Utility::Memory::remapPages(base(array), prevInBytes, inBytes, pageSize, numaNode));
+        /* remapPages() already printed a message */
+        if(!memory) std::abort(); /* LCOV_EXCL_LINE */
+        #ifdef _CORRADE_CONTAINERS_SANITIZER_ENABLED
+        resetAnnotation(memory, inBytes);
+        #endif
+        reinterpret_cast<std::size_t*>(memory)[0] = inBytes;
+        array = reinterpret_cast<T*>(memory + Offset);
+    }
+
+    /**
+     * @brief Deallocate an array
+     *
+     * Unmaps the pages backing @p data.
+     */
+    static void deallocate(T* data) {
+        if(!data) return;
+        const std::size_t inBytes = *static_cast<std::size_t*>(base(data));
+        #ifdef _CORRADE_CONTAINERS_SANITIZER_ENABLED
+        resetAnnotation(base(data), inBytes);
+        #endif
+        Utility::Memory::unmapPages(base(data), inBytes);
+    }
+
+    /**
+     * @brief Grow the array
+     *
+     * Behaves the same as @ref ArrayNewAllocator::grow(). The mapping is
+     * then rounded up to whole pages, which is reflected in the capacity.
+     */
+    static std::size_t grow(T* array, std::size_t desired) {
+        return ArrayDefaultGrowth::grow(array ? capacity(array) : 0, desired, sizeof(T));
+    }
+
+    /**
+     * @brief Array capacity
+     *
+     * Calculated from the mapping size that's stored *before* the front of
+     * the @p array.
+     */
+    static std::size_t capacity(T* array) {
+        return (*static_cast<std::size_t*>(base(array)) - Offset)/sizeof(T);
+    }
+
+    /**
+     * @brief Array base address
+     *
+     * Returns the beginning of the mapping.
+     */
+    static void* base(T* array) {
+        return reinterpret_cast<char*>(array) - Offset;
+    }
+
+    /**
+     * @brief Array deleter
+     *
+     * Since the types have trivial destructors, directly delegates into
+     * @ref deallocate(). The @p size parameter is unused.
+     */
+    static void deleter(T* data, std::size_t size) {
+        static_cast<void>(size);
+        deallocate(data);
+    }
+
+    private:
+        /* Keeping the data aligned to 2*sizeof(std::size_t), which is 16
+           bytes on 64-bit and 8 bytes on 32-bit */
+        enum: std::size_t { Offset = 2*sizeof(std::size_t) };
+
+        #ifdef _CORRADE_CONTAINERS_SANITIZER_ENABLED
+        /* ASan doesn't reset the shadow memory on munmap() / mremap(), so
+           container annotations done by the growable array functions would
+           survive into a new mapping at the same address. Going from an empty
+           to a full container makes the whole range addressable regardless of
+           its previous state. */
+        static void resetAnnotation(void* memory, std::size_t size) {
+            char* const begin = static_cast<char*>(memory);
+            __sanitizer_annotate_contiguous_container(begin, begin + size, begin, begin + size);
+        }
+        #endif
+
+        static std::size_t mappingSize(std::size_t capacity) {
+            const std::size_t granularity = Utility::Memory::pageSize(pageSize);
+            return (capacity*sizeof(T) + Offset + granularity - 1)/granularity*granularity;
+        }
+};
+
+/**
+@brief Page-mapping allocator for large growable arrays
+@m_since_latest
+
+Alias to @ref BasicArrayMappedAllocator using regular pages and the default
+NUMA placement.
+*/
+template<class T> using ArrayMappedAllocator = BasicArrayMappedAllocator<T, Utility::Memory::PageSize::Default, Utility::Memory::NumaNodeLocal>;
+
+}}
+
+#ifdef _CORRADE_CONTAINERS_SANITIZER_ENABLED
+#undef _CORRADE_CONTAINERS_SANITIZER_ENABLED
+#endif
+
+#endif
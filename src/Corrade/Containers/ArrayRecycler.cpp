@@ -0,0 +1,146 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ArrayRecycler.h"
+
+#include <cstdlib>
+
+/* Same as in GrowableArray.h, which undefines it at the end. The
+   __sanitizer_annotate_contiguous_container() declaration is taken from
+   there. */
+#ifdef __has_feature
+#if __has_feature(address_sanitizer)
+#define _CORRADE_CONTAINERS_SANITIZER_ENABLED
+#endif
+#endif
+#ifdef __SANITIZE_ADDRESS__
+#define _CORRADE_CONTAINERS_SANITIZER_ENABLED
+#endif
+
+namespace Corrade { namespace Containers {
+
+namespace {
+
+/* Binary logarithm of the smallest power of two that's at least size.
+   Expects size to be larger than 1. */
+inline std::size_t sizeClass(const std::size_t size) {
+    #ifdef __GNUC__
+    return 64 - __builtin_clzll(size - 1);
+    #else
+    std::size_t sizeClass = 0;
+    while((std::size_t{1} << sizeClass) < size) ++sizeClass;
+    return sizeClass;
+    #endif
+}
+
+#ifdef _CORRADE_CONTAINERS_SANITIZER_ENABLED
+/* Blocks come back from growable arrays with container annotations over
+   the whole block, which would make writing the free list link or reusing
+   the block for another array fail. Going from an empty to a full container
+   makes the whole range addressable regardless of its previous state. */
+void resetAnnotation(void* const data, const std::size_t blockClass) {
+    char* const begin = static_cast<char*>(data) - ArrayRecycler::Alignment;
+    char* const end = static_cast<char*>(data) + (std::size_t{1} << blockClass);
+    __sanitizer_annotate_contiguous_container(begin, end, begin, end);
+}
+#endif
+
+}
+
+ArrayRecycler& ArrayRecycler::current() {
+    /* Not using CORRADE_THREAD_LOCAL, as the __thread fallback used on old
+       Apple Clang doesn't support non-trivial destructors, which are needed
+       to free the cache on thread exit */
+    #ifdef CORRADE_BUILD_MULTITHREADED
+    thread_local
+    #endif
+    static ArrayRecycler recycler;
+    return recycler;
+}
+
+ArrayRecycler::ArrayRecycler() noexcept: _free{}, _cachedSize{}, _cachedCount{}, _maxCachedSize{256*1024*1024} {}
+
+ArrayRecycler::~ArrayRecycler() { trim(); }
+
+ArrayRecycler& ArrayRecycler::setMaxCachedSize(const std::size_t size) {
+    _maxCachedSize = size;
+    if(_cachedSize > size) trim(size);
+    return *this;
+}
+
+void* ArrayRecycler::allocate(const std::size_t size) {
+    const std::size_t blockClass = sizeClass(size < MinBlockSize ? MinBlockSize : size);
+
+    /* Reuse a cached block if there's any */
+    if(void* const data = _free[blockClass]) {
+        _free[blockClass] = *static_cast<void**>(data);
+        _cachedSize -= std::size_t{1} << blockClass;
+        --_cachedCount;
+        #ifdef _CORRADE_CONTAINERS_SANITIZER_ENABLED
+        resetAnnotation(data, blockClass);
+        #endif
+        return data;
+    }
+
+    char* const memory = static_cast<char*>(std::malloc(Alignment + (std::size_t{1} << blockClass)));
+    if(!memory) std::abort(); /* LCOV_EXCL_LINE */
+    char* const data = memory + Alignment;
+    reinterpret_cast<std::size_t*>(data)[-1] = blockClass;
+    return data;
+}
+
+void ArrayRecycler::release(void* const data) {
+    if(!data) return;
+
+    const std::size_t blockClass = static_cast<std::size_t*>(data)[-1];
+    const std::size_t blockSize = std::size_t{1} << blockClass;
+    #ifdef _CORRADE_CONTAINERS_SANITIZER_ENABLED
+    resetAnnotation(data, blockClass);
+    #endif
+    if(_cachedSize + blockSize > _maxCachedSize) {
+        std::free(static_cast<char*>(data) - Alignment);
+        return;
+    }
+
+    *static_cast<void**>(data) = _free[blockClass];
+    _free[blockClass] = data;
+    _cachedSize += blockSize;
+    ++_cachedCount;
+}
+
+void ArrayRecycler::trim(const std::size_t size) {
+    for(std::size_t blockClass = Containers::arraySize(_free); blockClass != 0 && _cachedSize > size; --blockClass) {
+        void*& first = _free[blockClass - 1];
+        while(first && _cachedSize > size) {
+            void* const data = first;
+            first = *static_cast<void**>(data);
+            std::free(static_cast<char*>(data) - Alignment);
+            _cachedSize -= std::size_t{1} << (blockClass - 1);
+            --_cachedCount;
+        }
+    }
+}
+
+}}
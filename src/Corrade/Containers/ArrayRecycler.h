@@ -0,0 +1,326 @@
+#ifndef Corrade_Containers_ArrayRecycler_h
+#define Corrade_Containers_ArrayRecycler_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Containers::ArrayRecycler, @ref Corrade::Containers::ArrayRecyclingAllocator, function @ref Corrade::Containers::recycledArray()
+ * @m_since_latest
+ */
+
+#include <new>
+
+#include "Corrade/Containers/GrowableArray.h"
+#include "Corrade/Utility/visibility.h"
+
+namespace Corrade { namespace Containers {
+
+/**
+@brief Thread-local recycler of scratch memory blocks
+@m_since_latest
+
+Keeps released memory blocks in a cache instead of returning them to the
+system, handing them out again for subsequent allocations of a similar size.
+Meant for workloads that repeatedly allocate and free temporary buffers of a
+few common sizes, where the global allocator would otherwise go to the system
+for every large allocation and then return it again.
+
+Block sizes are rounded up to a power of two, with each power of two being a
+separate size class with its own list of cached blocks. Allocating a block
+first looks into the list for given size class and goes to the global heap
+only if it's empty. Blocks are usually not allocated directly but rather
+through @ref recycledArray(), which returns an @ref Array with a deleter that
+puts the block back into the cache of the thread that destroys it, or using
+the @ref ArrayRecyclingAllocator together with the @ref arrayAppend(),
+@ref arrayReserve(), ... family of functions:
+
+@snippet Containers.cpp ArrayRecycler
+
+@section Containers-ArrayRecycler-limits Memory limits
+
+To bound the amount of memory kept around, a block that would make the cache
+exceed @ref maxCachedSize() is freed instead of being cached. Apart from that,
+@ref trim() frees cached blocks down to given size, which can be used for
+example when a worker goes idle. The cache is freed completely when the
+thread exits.
+
+@section Containers-ArrayRecycler-threads Thread safety
+
+If Corrade is compiled with @ref CORRADE_BUILD_MULTITHREADED enabled (the
+default), each thread has its own instance, returned by @ref current(), and
+no synchronization is done. A block allocated by one thread can be released
+by another, it then ends up in the cache of the releasing thread. The
+instances themselves aren't thread-safe, it's not allowed to call
+@ref trim() or other functions on an instance belonging to a different
+thread. Arrays shouldn't be released from destructors of other thread-local
+objects, as the cache might be already gone at that point.
+*/
+class CORRADE_UTILITY_EXPORT ArrayRecycler {
+    public:
+        enum: std::size_t {
+            /**
+             * Smallest size class, in bytes. Smaller allocations are rounded
+             * up to it.
+             */
+            MinBlockSize = 64,
+
+            /**
+             * Alignment of allocated blocks, equal to what @ref std::malloc()
+             * guarantees on common platforms. The block size class is stored
+             * in the space of this size before each block.
+             */
+            Alignment = 2*sizeof(std::size_t)
+        };
+
+        /**
+         * @brief Recycler belonging to the calling thread
+         *
+         * Created on first use, all its cached blocks are freed on thread
+         * exit.
+         */
+        static ArrayRecycler& current();
+
+        /**
+         * @brief Block capacity
+         *
+         * Size of the block returned by @ref allocate(), in bytes. Always a
+         * power of two equal to or larger than the size that was requested
+         * and at least @ref MinBlockSize.
+         */
+        static std::size_t capacity(const void* data) {
+            return std::size_t{1} << reinterpret_cast<const std::size_t*>(data)[-1];
+        }
+
+        /** @brief Copying is not allowed */
+        ArrayRecycler(const ArrayRecycler&) = delete;
+
+        /** @brief Moving is not allowed */
+        ArrayRecycler(ArrayRecycler&&) = delete;
+
+        /** @brief Copying is not allowed */
+        ArrayRecycler& operator=(const ArrayRecycler&) = delete;
+
+        /** @brief Moving is not allowed */
+        ArrayRecycler& operator=(ArrayRecycler&&) = delete;
+
+        /**
+         * @brief Max size of cached blocks, in bytes
+         *
+         * Default is 256 MB.
+         */
+        std::size_t maxCachedSize() const { return _maxCachedSize; }
+
+        /**
+         * @brief Set max size of cached blocks
+         * @return Reference to self (for method chaining)
+         *
+         * If the currently cached size is larger, calls @ref trim() with
+         * @p size.
+         */
+        ArrayRecycler& setMaxCachedSize(std::size_t size);
+
+        /** @brief Size of all cached blocks, in bytes */
+        std::size_t cachedSize() const { return _cachedSize; }
+
+        /** @brief Count of cached blocks */
+        std::size_t cachedCount() const { return _cachedCount; }
+
+        /**
+         * @brief Allocate a block
+         *
+         * Returns a block of at least @p size bytes, aligned to
+         * @ref Alignment, either taken from the cache or newly allocated if
+         * there's no cached block of given size class. The memory is
+         * uninitialized. Use @ref capacity() to query the actual block size.
+         * If the allocation fails, the program is aborted.
+         */
+        void* allocate(std::size_t size);
+
+        /**
+         * @brief Release a block
+         *
+         * Puts the block into the cache, or frees it if that would exceed
+         * @ref maxCachedSize(). The block is expected to be allocated by
+         * @ref allocate() on any thread. If @p data is @cpp nullptr @ce, the
+         * function does nothing.
+         */
+        void release(void* data);
+
+        /**
+         * @brief Trim the cache
+         *
+         * Frees cached blocks, starting with the largest size class, until
+         * @ref cachedSize() is at most @p size. Passing @cpp 0 @ce frees all
+         * cached blocks.
+         */
+        void trim(std::size_t size = 0);
+
+    private:
+        explicit ArrayRecycler() noexcept;
+        ~ArrayRecycler();
+
+        /* Indexed by size class, i.e. a binary logarithm of the block size.
+           The first pointer-sized bytes of a cached block point to the next
+           block in the list. */
+        void* _free[sizeof(std::size_t)*8];
+        std::size_t _cachedSize, _cachedCount, _maxCachedSize;
+};
+
+/**
+@brief Recycling allocator for growable arrays
+@m_since_latest
+
+An @ref ArrayAllocator that allocates memory using @ref ArrayRecycler of the
+calling thread, storing the block size class *before* the data. Since the
+blocks are rounded up to a power of two, the capacity is usually larger than
+requested, which makes subsequent growing cheaper. Expects that @p T is
+nothrow move-constructible and its alignment is not larger than
+@ref ArrayRecycler::Alignment. Example usage:
+
+@snippet Containers.cpp ArrayRecyclingAllocator
+
+@see @ref recycledArray(), @ref Containers-Array-growable
+*/
+template<class T> struct ArrayRecyclingAllocator {
+    static_assert(alignof(T) <= ArrayRecycler::Alignment,
+        "overaligned types are not supported");
+
+    typedef T Type; /**< Pointer type */
+
+    /**
+     * @brief Allocate (but not construct) an array of given capacity
+     *
+     * Delegates to @ref ArrayRecycler::allocate() of the calling thread.
+     */
+    static T* allocate(std::size_t capacity) {
+        return static_cast<T*>(ArrayRecycler::current().allocate(capacity*sizeof(T)));
+    }
+
+    /**
+     * @brief Reallocate an array to given capacity
+     *
+     * If @p newCapacity fits into the existing block, does nothing.
+     * Otherwise calls @p allocate(), move-constructs @p prevSize elements
+     * from @p array into the new array, calls destructors on the original
+     * elements, calls @ref deallocate() and updates the @p array reference
+     * to point to the new array.
+     */
+    static void reallocate(T*& array, std::size_t prevSize, std::size_t newCapacity) {
+        if(newCapacity <= capacity(array)) return;
+
+        T* const newArray = allocate(newCapacity);
+        Implementation::arrayMoveConstruct<T>(array, newArray, prevSize);
+        Implementation::arrayDestruct<T>(array, array + prevSize);
+        deallocate(array);
+        array = newArray;
+    }
+
+    /**
+     * @brief Deallocate an array
+     *
+     * Delegates to @ref ArrayRecycler::release() of the calling thread.
+     */
+    static void deallocate(T* data) {
+        ArrayRecycler::current().release(data);
+    }
+
+    /**
+     * @brief Grow the array
+     *
+     * Behaves the same as @ref ArrayNewAllocator::grow().
+     */
+    static std::size_t grow(T* array, std::size_t desired) {
+        return ArrayDefaultGrowth::grow(array ? capacity(array) : 0, desired, sizeof(T));
+    }
+
+    /**
+     * @brief Array capacity
+     *
+     * Block size returned by @ref ArrayRecycler::capacity() divided by
+     * element size.
+     */
+    static std::size_t capacity(T* array) {
+        return ArrayRecycler::capacity(array)/sizeof(T);
+    }
+
+    /**
+     * @brief Array base address
+     *
+     * Returns the address of the allocation, which is *before* the stored
+     * size class.
+     */
+    static void* base(T* array) {
+        return reinterpret_cast<char*>(array) - ArrayRecycler::Alignment;
+    }
+
+    /**
+     * @brief Array deleter
+     *
+     * Calls a destructor on @p size elements and then delegates into
+     * @ref deallocate().
+     */
+    static void deleter(T* data, std::size_t size) {
+        Implementation::arrayDestruct<T>(data, data + size);
+        deallocate(data);
+    }
+};
+
+/**
+@brief Create an array with recycled memory
+@m_since_latest
+
+Allocates memory for @p size elements using @ref ArrayRecyclingAllocator and
+value-initializes them, i.e. trivial types are zero-initialized and default
+constructor is called otherwise. The returned array has the
+@ref ArrayRecyclingAllocator::deleter() "ArrayRecyclingAllocator<T>::deleter()"
+which puts the memory back into the @ref ArrayRecycler cache on destruction
+and it can be grown further with @ref arrayAppend() and friends, optionally
+with the @ref ArrayRecyclingAllocator explicitly specified.
+@see @ref recycledArray(NoInitT, std::size_t)
+*/
+template<class T> Array<T> recycledArray(std::size_t size) {
+    T* const data = ArrayRecyclingAllocator<T>::allocate(size);
+    for(T *it = data, *end = data + size; it != end; ++it)
+        new(it) T();
+    return Array<T>{data, size, ArrayRecyclingAllocator<T>::deleter};
+}
+
+/**
+@brief Create an array with recycled memory without initializing its contents
+@m_since_latest
+
+Compared to @ref recycledArray(std::size_t) the contents are left in an
+unspecified state, which is usually desired for scratch buffers. Similarly to
+@ref Array::Array(NoInitT, std::size_t), for non-trivial types the user is
+responsible for calling the constructor on each element, as the deleter
+calls destructors on all of them.
+*/
+template<class T> Array<T> recycledArray(NoInitT, std::size_t size) {
+    return Array<T>{ArrayRecyclingAllocator<T>::allocate(size), size, ArrayRecyclingAllocator<T>::deleter};
+}
+
+}}
+
+#endif
@@ -0,0 +1,395 @@
+#ifndef Corrade_Containers_ArrayTuple_h
+#define Corrade_Containers_ArrayTuple_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Containers::ArrayTuple
+ * @m_since_latest
+ */
+
+#include <cstdint>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "Corrade/Containers/ArrayView.h"
+#include "Corrade/Containers/Tags.h"
+#include "Corrade/Utility/Assert.h"
+
+namespace Corrade { namespace Containers {
+
+/**
+@brief Array tuple
+@m_since_latest
+
+Packs several arrays of possibly different types into a single allocation.
+Useful for example for a structure-of-arrays layout or for an index buffer
+together with the data it indexes, where allocating each array separately
+would mean several heap allocations, each with its own deleter and possibly
+far apart in memory.
+
+The arrays are described by a list of @ref Item instances, each consisting of
+an initialization tag, element count, optionally a custom alignment, and a
+reference to an @ref ArrayView that gets populated with the actual
+location once the memory is allocated:
+
+@snippet Containers.cpp ArrayTuple
+
+The views are valid for as long as the tuple instance is alive. On
+destruction, destructors of all array elements get called in reverse order
+of the items and the memory is freed.
+
+@section Containers-ArrayTuple-layout Memory layout
+
+The allocation starts with a header containing information needed to
+destroy the arrays, which means the tuple can be released into a plain
+@ref Array with the @ref deleter() --- the array then owns all items and
+destroys them correctly when it goes out of scope:
+
+@snippet Containers.cpp ArrayTuple-release
+
+The header is followed by the arrays in the order in which they were
+specified, each padded to satisfy its alignment. Items with a trivially
+destructible type don't take any space in the header, so a tuple containing
+only trivially destructible types has a header of just two pointers.
+*/
+class ArrayTuple {
+    public:
+        class Item;
+
+        /**
+         * @brief Deleter type
+         *
+         * Type returned by @ref deleter(), compatible with the deleter type
+         * of @cpp Array<char> @ce.
+         */
+        typedef void(*Deleter)(char*, std::size_t);
+
+        /**
+         * @brief Default constructor
+         *
+         * Creates a zero-sized tuple with no memory allocated.
+         */
+        /*implicit*/ ArrayTuple() noexcept: _data{}, _size{} {}
+
+        /**
+         * @brief Construct the tuple
+         *
+         * Calculates the total size of all items including alignment padding,
+         * allocates the memory, initializes the items as specified by their
+         * initialization tags and updates the output views to point to them.
+         * If @p items is empty, no memory is allocated.
+         */
+        explicit ArrayTuple(ArrayView<const Item> items);
+
+        /** @overload */
+        /*implicit*/ ArrayTuple(std::initializer_list<Item> items): ArrayTuple{ArrayView<const Item>{items.begin(), items.size()}} {}
+
+        /** @brief Copying is not allowed */
+        ArrayTuple(const ArrayTuple&) = delete;
+
+        /**
+         * @brief Move constructor
+         *
+         * The views populated by the original instance stay valid.
+         */
+        ArrayTuple(ArrayTuple&& other) noexcept: _data{other._data}, _size{other._size} {
+            other._data = nullptr;
+            other._size = 0;
+        }
+
+        /**
+         * @brief Destructor
+         *
+         * Calls destructors of all items in reverse order and frees the
+         * memory.
+         */
+        ~ArrayTuple() { deleterImplementation(_data, _size); }
+
+        /** @brief Copying is not allowed */
+        ArrayTuple& operator=(const ArrayTuple&) = delete;
+
+        /** @brief Move assignment */
+        ArrayTuple& operator=(ArrayTuple&& other) noexcept {
+            std::swap(_data, other._data);
+            std::swap(_size, other._size);
+            return *this;
+        }
+
+        /**
+         * @brief Tuple data
+         *
+         * Points to the start of the header, the items follow after. If the
+         * tuple is empty, returns @cpp nullptr @ce.
+         */
+        char* data() { return _data; }
+        const char* data() const { return _data; } /**< @overload */
+
+        /**
+         * @brief Tuple size
+         *
+         * Size of the header, all items and the padding between them, in
+         * bytes. Doesn't include the extra space that may have been
+         * allocated to satisfy item alignment larger than what the allocator
+         * provides.
+         */
+        std::size_t size() const { return _size; }
+
+        /**
+         * @brief Tuple deleter
+         *
+         * Can be used together with @ref release() to transfer ownership to
+         * an @ref Array. Calling the deleter on a @cpp nullptr @ce is a
+         * no-op.
+         */
+        static Deleter deleter() { return deleterImplementation; }
+
+        /**
+         * @brief Release data storage
+         *
+         * Returns the data pointer and resets data pointer and size to zero.
+         * Deleting the returned data is user responsibility --- pass it
+         * together with the original @ref size() to the @ref deleter(),
+         * which calls the destructors and frees the memory.
+         */
+        char* release() {
+            char* const data = _data;
+            _data = nullptr;
+            _size = 0;
+            return data;
+        }
+
+    private:
+        struct Header {
+            char* allocation;
+            std::size_t destructorCount;
+        };
+
+        struct DestructorEntry {
+            void(*destructor)(char*, std::size_t);
+            char* data;
+            std::size_t count;
+        };
+
+        static void deleterImplementation(char* data, std::size_t);
+
+        char* _data;
+        std::size_t _size;
+};
+
+/**
+@brief Array tuple item
+@m_since_latest
+
+Describes a single array in an @ref ArrayTuple. The @p outputView is
+populated when the tuple is constructed, which means the item has to be used
+while the view is still in scope.
+*/
+class ArrayTuple::Item {
+    public:
+        /**
+         * @brief Construct a value-initialized array
+         * @param size          Element count
+         * @param outputView    View that gets populated with the array
+         *
+         * Trivial types are zero-initialized, non-trivial types get their
+         * default constructor called. See @ref Array::Array(ValueInitT, std::size_t)
+         * for more information.
+         */
+        template<class T> /*implicit*/ Item(ValueInitT, std::size_t size, ArrayView<T>& outputView): Item{ValueInit, size, alignof(T), outputView} {}
+
+        /**
+         * @brief Construct a value-initialized array with custom alignment
+         *
+         * Expects that @p alignment is a power of two and not less than
+         * @cpp alignof(T) @ce.
+         */
+        template<class T> /*implicit*/ Item(ValueInitT, std::size_t size, std::size_t alignment, ArrayView<T>& outputView): Item{size, alignment, outputView, valueConstructor<T>()} {}
+
+        /**
+         * @brief Construct an array without initializing its contents
+         * @param size          Element count
+         * @param outputView    View that gets populated with the array
+         *
+         * Neither trivial nor non-trivial types are initialized, use
+         * placement new to construct the elements. The destructors are still
+         * called on tuple destruction. See @ref Array::Array(NoInitT, std::size_t)
+         * for more information.
+         */
+        template<class T> /*implicit*/ Item(NoInitT, std::size_t size, ArrayView<T>& outputView): Item{NoInit, size, alignof(T), outputView} {}
+
+        /**
+         * @brief Construct an array without initializing its contents, with custom alignment
+         *
+         * Expects that @p alignment is a power of two and not less than
+         * @cpp alignof(T) @ce.
+         */
+        template<class T> /*implicit*/ Item(NoInitT, std::size_t size, std::size_t alignment, ArrayView<T>& outputView): Item{size, alignment, outputView, nullptr} {}
+
+        /**
+         * @brief Construct a default-initialized array
+         * @param size          Element count
+         * @param outputView    View that gets populated with the array
+         *
+         * Trivial types are not initialized, non-trivial types get their
+         * default constructor called. See @ref Array::Array(DefaultInitT, std::size_t)
+         * for more information.
+         */
+        template<class T> /*implicit*/ Item(DefaultInitT, std::size_t size, ArrayView<T>& outputView): Item{DefaultInit, size, alignof(T), outputView} {}
+
+        /**
+         * @brief Construct a default-initialized array with custom alignment
+         *
+         * Expects that @p alignment is a power of two and not less than
+         * @cpp alignof(T) @ce.
+         */
+        template<class T> /*implicit*/ Item(DefaultInitT, std::size_t size, std::size_t alignment, ArrayView<T>& outputView): Item{size, alignment, outputView, defaultConstructor<T>()} {}
+
+        /**
+         * @brief Construct a value-initialized array
+         *
+         * Alias to @ref Item(ValueInitT, std::size_t, ArrayView<T>&).
+         */
+        template<class T> /*implicit*/ Item(std::size_t size, ArrayView<T>& outputView): Item{ValueInit, size, alignof(T), outputView} {}
+
+        /**
+         * @brief Construct a value-initialized array with custom alignment
+         *
+         * Alias to @ref Item(ValueInitT, std::size_t, std::size_t, ArrayView<T>&).
+         */
+        template<class T> /*implicit*/ Item(std::size_t size, std::size_t alignment, ArrayView<T>& outputView): Item{ValueInit, size, alignment, outputView} {}
+
+    private:
+        friend ArrayTuple;
+
+        template<class T> Item(std::size_t size, std::size_t alignment, ArrayView<T>& outputView, void(*constructor)(char*, std::size_t)): _elementSize{sizeof(T)}, _elementAlignment{alignment}, _elementCount{size}, _constructor{constructor}, _destructor{destructor<T>()}, _outputView{&outputView}, _setOutputView{[](void* outputView, char* data, std::size_t size) {
+            *static_cast<ArrayView<T>*>(outputView) = {reinterpret_cast<T*>(data), size};
+        }} {
+            CORRADE_ASSERT(alignment >= alignof(T) && !(alignment & (alignment - 1)),
+                "Containers::ArrayTuple::Item: expected alignment to be a power of two not less than" << alignof(T) << "but got" << alignment, );
+        }
+
+        template<class T> static void(*valueConstructor())(char*, std::size_t) {
+            return [](char* data, std::size_t size) {
+                T* const begin = reinterpret_cast<T*>(data);
+                for(T* it = begin, *end = begin + size; it != end; ++it)
+                    new(it) T();
+            };
+        }
+
+        template<class T> static typename std::enable_if<std::is_trivial<T>::value, void(*)(char*, std::size_t)>::type defaultConstructor() {
+            return nullptr;
+        }
+        template<class T> static typename std::enable_if<!std::is_trivial<T>::value, void(*)(char*, std::size_t)>::type defaultConstructor() {
+            return [](char* data, std::size_t size) {
+                T* const begin = reinterpret_cast<T*>(data);
+                for(T* it = begin, *end = begin + size; it != end; ++it)
+                    new(it) T;
+            };
+        }
+
+        template<class T> static typename std::enable_if<std::is_trivially_destructible<T>::value, void(*)(char*, std::size_t)>::type destructor() {
+            return nullptr;
+        }
+        template<class T> static typename std::enable_if<!std::is_trivially_destructible<T>::value, void(*)(char*, std::size_t)>::type destructor() {
+            return [](char* data, std::size_t size) {
+                T* const begin = reinterpret_cast<T*>(data);
+                for(T* it = begin + size; it != begin; ) (--it)->~T();
+            };
+        }
+
+        std::size_t _elementSize;
+        std::size_t _elementAlignment;
+        std::size_t _elementCount;
+        void(*_constructor)(char*, std::size_t);
+        void(*_destructor)(char*, std::size_t);
+        void* _outputView;
+        void(*_setOutputView)(void*, char*, std::size_t);
+};
+
+inline ArrayTuple::ArrayTuple(const ArrayView<const Item> items): _data{}, _size{} {
+    if(items.empty()) return;
+
+    /* Calculate the header size, maximal alignment and total size */
+    std::size_t destructorCount = 0;
+    std::size_t alignment = alignof(Header);
+    for(const Item& item: items) {
+        if(item._destructor) ++destructorCount;
+        if(item._elementAlignment > alignment)
+            alignment = item._elementAlignment;
+    }
+    std::size_t size = sizeof(Header) + destructorCount*sizeof(DestructorEntry);
+    for(const Item& item: items) {
+        size = (size + item._elementAlignment - 1) & ~(item._elementAlignment - 1);
+        size += item._elementSize*item._elementCount;
+    }
+
+    /* Allocate. If the alignment is larger than what new[] guarantees,
+       overallocate and align the start. */
+    constexpr std::size_t DefaultAlignment =
+        #ifdef __STDCPP_DEFAULT_NEW_ALIGNMENT__
+        __STDCPP_DEFAULT_NEW_ALIGNMENT__
+        #else
+        2*sizeof(std::size_t)
+        #endif
+        ;
+    char* const allocation = alignment > DefaultAlignment ?
+        new char[size + alignment - 1] : new char[size];
+    _data = reinterpret_cast<char*>((reinterpret_cast<std::uintptr_t>(allocation) + alignment - 1) & ~std::uintptr_t(alignment - 1));
+    _size = size;
+
+    /* Fill the header, the destructor entries get filled as the items are
+       constructed */
+    Header& header = *new(_data) Header{allocation, 0};
+    DestructorEntry* const destructors = reinterpret_cast<DestructorEntry*>(_data + sizeof(Header));
+
+    /* Construct the items and populate the output views */
+    std::size_t offset = sizeof(Header) + destructorCount*sizeof(DestructorEntry);
+    for(const Item& item: items) {
+        offset = (offset + item._elementAlignment - 1) & ~(item._elementAlignment - 1);
+        char* const data = _data + offset;
+        if(item._constructor) item._constructor(data, item._elementCount);
+        if(item._destructor)
+            new(destructors + header.destructorCount++) DestructorEntry{item._destructor, data, item._elementCount};
+        item._setOutputView(item._outputView, data, item._elementCount);
+        offset += item._elementSize*item._elementCount;
+    }
+}
+
+inline void ArrayTuple::deleterImplementation(char* const data, std::size_t) {
+    if(!data) return;
+
+    const Header& header = *reinterpret_cast<const Header*>(data);
+    const DestructorEntry* const destructors = reinterpret_cast<const DestructorEntry*>(data + sizeof(Header));
+    for(std::size_t i = header.destructorCount; i; --i)
+        destructors[i - 1].destructor(destructors[i - 1].data, destructors[i - 1].count);
+    delete[] header.allocation;
+}
+
+}}
+
+#endif
@@ -0,0 +1,365 @@
+#ifndef Corrade_Containers_BigEnumSet_h
+#define Corrade_Containers_BigEnumSet_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Containers::BigEnumSet
+ * @m_since_latest
+ * @see @ref Corrade/Containers/BigEnumSet.hpp
+ */
+
+#include <cstdint>
+#include <type_traits>
+
+#include "Corrade/configure.h"
+#include "Corrade/Containers/StaticArray.h"
+#include "Corrade/Utility/Assert.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#endif
+#ifdef CORRADE_TARGET_MSVC
+#include <intrin.h>
+#endif
+
+namespace Corrade { namespace Containers {
+
+namespace Implementation {
+    /* Not reusing the Sequence from StridedArrayView.h to avoid depending on
+       that header */
+    template<std::size_t ...> struct BigEnumSetSequence {};
+
+    /* E.g. GenerateBigEnumSetSequence<3>::Type is BigEnumSetSequence<0, 1, 2> */
+    template<std::size_t N, std::size_t ...sequence> struct GenerateBigEnumSetSequence:
+        GenerateBigEnumSetSequence<N-1, N-1, sequence...> {};
+
+    template<std::size_t ...sequence> struct GenerateBigEnumSetSequence<0, sequence...> {
+        typedef BigEnumSetSequence<sequence...> Type;
+    };
+
+    inline unsigned int bigEnumSetLowestSetBit(const std::uint64_t value) {
+        #ifdef CORRADE_TARGET_MSVC
+        unsigned long index;
+        #if defined(_M_X64) || defined(_M_ARM64)
+        _BitScanForward64(&index, value);
+        #else
+        if(std::uint32_t(value))
+            _BitScanForward(&index, std::uint32_t(value));
+        else {
+            _BitScanForward(&index, std::uint32_t(value >> 32));
+            index += 32;
+        }
+        #endif
+        return index;
+        #else
+        return __builtin_ctzll(value);
+        #endif
+    }
+
+    /* In-place word-wise operations for the compound assignment operators,
+       processing two words at a time if SSE2 or NEON is available. The
+       non-assigning operators have to stay constexpr and thus scalar, but
+       they're straight-line code the compiler vectorizes on its own. */
+    template<class Operation> inline void bigEnumSetApply(std::uint64_t* const a, const std::uint64_t* const b, const std::size_t size) {
+        std::size_t i = 0;
+        #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        for(; i + 2 <= size; i += 2)
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(a + i), Operation::apply(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i))));
+        #elif defined(__ARM_NEON) || defined(_M_ARM64)
+        for(; i + 2 <= size; i += 2)
+            vst1q_u64(a + i, Operation::apply(vld1q_u64(a + i), vld1q_u64(b + i)));
+        #endif
+        for(; i != size; ++i) a[i] = Operation::apply(a[i], b[i]);
+    }
+
+    struct BigEnumSetOr {
+        static std::uint64_t apply(std::uint64_t a, std::uint64_t b) { return a | b; }
+        #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        static __m128i apply(__m128i a, __m128i b) { return _mm_or_si128(a, b); }
+        #elif defined(__ARM_NEON) || defined(_M_ARM64)
+        static uint64x2_t apply(uint64x2_t a, uint64x2_t b) { return vorrq_u64(a, b); }
+        #endif
+    };
+
+    struct BigEnumSetAnd {
+        static std::uint64_t apply(std::uint64_t a, std::uint64_t b) { return a & b; }
+        #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        static __m128i apply(__m128i a, __m128i b) { return _mm_and_si128(a, b); }
+        #elif defined(__ARM_NEON) || defined(_M_ARM64)
+        static uint64x2_t apply(uint64x2_t a, uint64x2_t b) { return vandq_u64(a, b); }
+        #endif
+    };
+
+    struct BigEnumSetXor {
+        static std::uint64_t apply(std::uint64_t a, std::uint64_t b) { return a ^ b; }
+        #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        static __m128i apply(__m128i a, __m128i b) { return _mm_xor_si128(a, b); }
+        #elif defined(__ARM_NEON) || defined(_M_ARM64)
+        static uint64x2_t apply(uint64x2_t a, uint64x2_t b) { return veorq_u64(a, b); }
+        #endif
+    };
+}
+
+/**
+@brief Set of more than 64 enum values
+@tparam T       Enum type
+@tparam size    How many 64-bit integers to use to store the value. If not
+    specified, enough words to store all values of the underlying type are
+    used.
+@m_since_latest
+
+A variant of @ref EnumSet that is able to handle sets of more than 64 values
+(which is the largest standard integer type) by treating the enum values as
+indices of bits in a @ref StaticArray of @cpp std::uint64_t @ce words instead
+of the enum values being bit masks. The enum type is expected to have an
+unsigned underlying type and none of its values is expected to be larger than
+@cpp size*64 - 1 @ce:
+
+@snippet Containers.cpp BigEnumSet-usage
+
+Other than that, the API and the usage of @ref CORRADE_ENUMSET_OPERATORS()
+and @ref CORRADE_ENUMSET_FRIEND_OPERATORS() is the same as with @ref EnumSet.
+The set operations are @cpp constexpr @ce and operate on whole words. The
+compound assignment operators process two words at a time using SSE2 or NEON,
+if available, so for example matching against a set of a few hundred values
+is just a handful of vector instructions.
+
+@section Containers-BigEnumSet-iteration Iterating over set values
+
+The set is iterable, yielding set values in order from the lowest. Each
+iteration step finds the lowest set bit of the remaining word using a
+count-trailing-zeros instruction, skipping empty words, so the cost is
+proportional to the number of set values and words, not the number of bits.
+
+@see @ref bigEnumSetDebugOutput()
+*/
+#ifdef DOXYGEN_GENERATING_OUTPUT
+template<class T, std::size_t size = (1 << (sizeof(typename std::underlying_type<T>::type)*8))/64>
+#else
+template<class T, std::size_t size>
+#endif
+class BigEnumSet {
+    static_assert(std::is_enum<T>::value, "BigEnumSet type must be strongly typed enum");
+    static_assert(std::is_unsigned<typename std::underlying_type<T>::type>::value, "BigEnumSet enum type must be unsigned");
+    static_assert(size, "BigEnumSet size must be non-zero");
+
+    public:
+        typedef T Type; /**< @brief Enum type */
+
+        /** @brief Underlying type of the enum */
+        typedef typename std::underlying_type<T>::type UnderlyingType;
+
+        enum: std::size_t {
+            Size = size     /**< Count of 64-bit integers storing this set */
+        };
+
+        /**
+         * @brief Iterator over set values
+         *
+         * @see @ref begin(), @ref end()
+         */
+        class Iterator {
+            public:
+                /** @brief Equality comparison */
+                constexpr bool operator==(const Iterator& other) const {
+                    return _word == other._word && _value == other._value;
+                }
+
+                /** @brief Non-equality comparison */
+                constexpr bool operator!=(const Iterator& other) const {
+                    return !operator==(other);
+                }
+
+                /** @brief Lowest value of the remaining set */
+                T operator*() const {
+                    return T(_word*64 + Implementation::bigEnumSetLowestSetBit(_value));
+                }
+
+                /** @brief Advance to the next set value */
+                Iterator& operator++() {
+                    _value &= _value - 1;
+                    skipEmpty();
+                    return *this;
+                }
+
+            private:
+                friend BigEnumSet;
+
+                explicit Iterator(const std::uint64_t* data, std::size_t word) noexcept: _data{data}, _word{word}, _value{word == size ? 0 : data[word]} {
+                    skipEmpty();
+                }
+
+                void skipEmpty() {
+                    while(!_value && _word != size && ++_word != size)
+                        _value = _data[_word];
+                }
+
+                const std::uint64_t* _data;
+                std::size_t _word;
+                std::uint64_t _value;
+        };
+
+        /** @brief Create an empty set */
+        constexpr /*implicit*/ BigEnumSet() noexcept: _data{ValueInit} {}
+
+        /**
+         * @brief Create a set from one value
+         *
+         * Expects that the value is less than @cpp size*64 @ce.
+         */
+        constexpr /*implicit*/ BigEnumSet(T value) noexcept: BigEnumSet{(CORRADE_CONSTEXPR_ASSERT(std::size_t(value) < size*64,
+            "Containers::BigEnumSet: value" << std::size_t(value) << "too large for a" << size*64 << Utility::Debug::nospace << "-bit storage"), value), typename Implementation::GenerateBigEnumSetSequence<size>::Type{}} {}
+
+        /**
+         * @brief Create an uninitialized set
+         *
+         * The contents are left in undefined state.
+         */
+        explicit BigEnumSet(NoInitT) noexcept: _data{NoInit} {}
+
+        /** @brief Raw data */
+        constexpr const std::uint64_t* data() const { return _data.data(); }
+
+        /** @brief Equality comparison */
+        constexpr bool operator==(const BigEnumSet<T, size>& other) const {
+            return equals(other, 0);
+        }
+
+        /** @brief Non-equality comparison */
+        constexpr bool operator!=(const BigEnumSet<T, size>& other) const {
+            return !operator==(other);
+        }
+
+        /**
+         * @brief Whether @p other is a subset of this
+         *
+         * Equivalent to @cpp (a & other) == other @ce.
+         */
+        constexpr bool operator>=(const BigEnumSet<T, size>& other) const {
+            return (*this & other) == other;
+        }
+
+        /**
+         * @brief Whether @p other is a superset of this
+         *
+         * Equivalent to @cpp (a & other) == a @ce.
+         */
+        constexpr bool operator<=(const BigEnumSet<T, size>& other) const {
+            return (*this & other) == *this;
+        }
+
+        /** @brief Union of two sets */
+        constexpr BigEnumSet<T, size> operator|(const BigEnumSet<T, size>& other) const {
+            return orInternal(other, typename Implementation::GenerateBigEnumSetSequence<size>::Type{});
+        }
+
+        /** @brief Union two sets and assign */
+        BigEnumSet<T, size>& operator|=(const BigEnumSet<T, size>& other) {
+            Implementation::bigEnumSetApply<Implementation::BigEnumSetOr>(_data.data(), other._data.data(), size);
+            return *this;
+        }
+
+        /** @brief Intersection of two sets */
+        constexpr BigEnumSet<T, size> operator&(const BigEnumSet<T, size>& other) const {
+            return andInternal(other, typename Implementation::GenerateBigEnumSetSequence<size>::Type{});
+        }
+
+        /** @brief Intersect two sets and assign */
+        BigEnumSet<T, size>& operator&=(const BigEnumSet<T, size>& other) {
+            Implementation::bigEnumSetApply<Implementation::BigEnumSetAnd>(_data.data(), other._data.data(), size);
+            return *this;
+        }
+
+        /** @brief XOR of two sets */
+        constexpr BigEnumSet<T, size> operator^(const BigEnumSet<T, size>& other) const {
+            return xorInternal(other, typename Implementation::GenerateBigEnumSetSequence<size>::Type{});
+        }
+
+        /** @brief XOR two sets and assign */
+        BigEnumSet<T, size>& operator^=(const BigEnumSet<T, size>& other) {
+            Implementation::bigEnumSetApply<Implementation::BigEnumSetXor>(_data.data(), other._data.data(), size);
+            return *this;
+        }
+
+        /** @brief Set complement */
+        constexpr BigEnumSet<T, size> operator~() const {
+            return inverseInternal(typename Implementation::GenerateBigEnumSetSequence<size>::Type{});
+        }
+
+        /** @brief Boolean conversion */
+        constexpr explicit operator bool() const {
+            return nonZero(0);
+        }
+
+        /**
+         * @brief Iterator to the first set value
+         *
+         * See @ref Containers-BigEnumSet-iteration for more information.
+         */
+        Iterator begin() const { return Iterator{_data.data(), 0}; }
+
+        /** @brief Iterator to (one item after) the last set value */
+        Iterator end() const { return Iterator{_data.data(), size}; }
+
+    private:
+        template<class ...Args> constexpr explicit BigEnumSet(InPlaceInitT, Args... words) noexcept: _data{InPlaceInit, words...} {}
+
+        template<std::size_t ...sequence> constexpr explicit BigEnumSet(T value, Implementation::BigEnumSetSequence<sequence...>) noexcept: _data{InPlaceInit, (std::size_t(value)/64 == sequence ? std::uint64_t{1} << (std::size_t(value) % 64) : std::uint64_t{})...} {}
+
+        constexpr bool equals(const BigEnumSet<T, size>& other, std::size_t i) const {
+            return i == size || (_data[i] == other._data[i] && equals(other, i + 1));
+        }
+
+        constexpr bool nonZero(std::size_t i) const {
+            return i != size && (_data[i] || nonZero(i + 1));
+        }
+
+        template<std::size_t ...sequence> constexpr BigEnumSet<T, size> orInternal(const BigEnumSet<T, size>& other, Implementation::BigEnumSetSequence<sequence...>) const {
+            return BigEnumSet<T, size>{InPlaceInit, std::uint64_t(_data[sequence] | other._data[sequence])...};
+        }
+
+        template<std::size_t ...sequence> constexpr BigEnumSet<T, size> andInternal(const BigEnumSet<T, size>& other, Implementation::BigEnumSetSequence<sequence...>) const {
+            return BigEnumSet<T, size>{InPlaceInit, std::uint64_t(_data[sequence] & other._data[sequence])...};
+        }
+
+        template<std::size_t ...sequence> constexpr BigEnumSet<T, size> xorInternal(const BigEnumSet<T, size>& other, Implementation::BigEnumSetSequence<sequence...>) const {
+            return BigEnumSet<T, size>{InPlaceInit, std::uint64_t(_data[sequence] ^ other._data[sequence])...};
+        }
+
+        template<std::size_t ...sequence> constexpr BigEnumSet<T, size> inverseInternal(Implementation::BigEnumSetSequence<sequence...>) const {
+            return BigEnumSet<T, size>{InPlaceInit, std::uint64_t(~_data[sequence])...};
+        }
+
+        StaticArray<size, std::uint64_t> _data;
+};
+
+}}
+
+#endif
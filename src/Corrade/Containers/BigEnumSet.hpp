@@ -0,0 +1,69 @@
+#ifndef Corrade_Containers_BigEnumSet_hpp
+#define Corrade_Containers_BigEnumSet_hpp
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Corrade::Containers::bigEnumSetDebugOutput()
+ * @m_since_latest
+ */
+
+#include "Corrade/Containers/BigEnumSet.h"
+#include "Corrade/Utility/Debug.h"
+
+namespace Corrade { namespace Containers {
+
+/** @relatedalso BigEnumSet
+@brief Print a big enum set to debug output
+@param debug    Debug output
+@param value    Value to be printed
+@param empty    What to print in case of an empty enum set
+@m_since_latest
+
+Assuming underlying enum type has already implemented @cpp operator<< @ce for
+@ref Utility::Debug, this function is able to print value of given enum set.
+Unlike with @ref enumSetDebugOutput() the values are bit indices and thus
+there can't be any unknown leftover bits, so there's no need to list the
+recognized values. Example definition:
+
+@snippet Containers.cpp bigEnumSetDebugOutput
+*/
+template<class T, std::size_t size> Utility::Debug& bigEnumSetDebugOutput(Utility::Debug& debug, const BigEnumSet<T, size>& value, const char* empty) {
+    /* Print the empty value in case there is nothing */
+    if(!value) return debug << empty;
+
+    bool separate = false;
+    for(const T e: value) {
+        if(separate) debug << Utility::Debug::nospace << "|" << Utility::Debug::nospace;
+        else separate = true;
+        debug << e;
+    }
+
+    return debug;
+}
+
+}}
+
+#endif
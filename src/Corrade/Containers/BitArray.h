@@ -0,0 +1,182 @@
+#ifndef Corrade_Containers_BitArray_h
+#define Corrade_Containers_BitArray_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Containers::BitArray
+ * @m_since_latest
+ */
+
+#include "Corrade/Containers/BitArrayView.h"
+#include "Corrade/Containers/GrowableArray.h"
+
+namespace Corrade { namespace Containers {
+
+/**
+@brief Bit array
+@m_since_latest
+
+Owning counterpart to @ref BitArrayView, storing bits packed eight to a byte
+in an @ref Array. Individual bits are accessed with @ref operator[](),
+@ref set() and @ref reset(), bulk operations such as @ref BitArrayView::count()
+or @ref MutableBitArrayView::andWith() are available through the implicit
+conversion to a view. Compared to @cpp std::vector<bool> @ce, there's no proxy
+reference type and the storage is exposed directly.
+
+@snippet Containers.cpp BitArray
+
+@section Containers-BitArray-growable Growable bit arrays
+
+@ref append() and @ref reserve() grow the underlying byte array using
+@ref arrayAppend() and @ref arrayReserve(), so the array gets the same
+amortized growth as other growable arrays. The bits past @ref size() in the
+last byte are always kept at zero.
+*/
+class BitArray {
+    public:
+        /**
+         * @brief Default constructor
+         *
+         * Creates a zero-sized array. Doesn't allocate.
+         */
+        /*implicit*/ BitArray() noexcept: _size{} {}
+
+        /**
+         * @brief Construct a zero-initialized array
+         * @param size      Size in bits
+         */
+        explicit BitArray(ValueInitT, std::size_t size): _data{ValueInit, (size + 7) >> 3}, _size{size} {}
+
+        /**
+         * @brief Construct an array with all bits set to given value
+         * @param size      Size in bits
+         * @param value     Bit value
+         */
+        explicit BitArray(DirectInitT, std::size_t size, bool value): BitArray{ValueInit, size} {
+            if(value) MutableBitArrayView{*this}.setAll();
+        }
+
+        /**
+         * @brief Construct a zero-initialized array
+         *
+         * Alias to @ref BitArray(ValueInitT, std::size_t).
+         */
+        explicit BitArray(std::size_t size): BitArray{ValueInit, size} {}
+
+        /** @brief Copying is not allowed */
+        BitArray(const BitArray&) = delete;
+
+        /** @brief Move constructor */
+        BitArray(BitArray&& other) noexcept: _data{Utility::move(other._data)}, _size{other._size} {
+            other._size = 0;
+        }
+
+        /** @brief Copying is not allowed */
+        BitArray& operator=(const BitArray&) = delete;
+
+        /** @brief Move assignment */
+        BitArray& operator=(BitArray&& other) noexcept {
+            using Utility::swap;
+            swap(_data, other._data);
+            swap(_size, other._size);
+            return *this;
+        }
+
+        /** @brief Convert to a mutable view */
+        /*implicit*/ operator MutableBitArrayView() {
+            return {_data.data(), 0, _size};
+        }
+
+        /** @brief Convert to an immutable view */
+        /*implicit*/ operator BitArrayView() const {
+            return {_data.data(), 0, _size};
+        }
+
+        /**
+         * @brief Data
+         *
+         * Bits are packed eight to a byte, starting from the lowest bit of
+         * the first byte.
+         */
+        char* data() { return _data.data(); }
+        const char* data() const { return _data.data(); } /**< @overload */
+
+        /** @brief Size in bits */
+        std::size_t size() const { return _size; }
+
+        /** @brief Whether the array is empty */
+        bool isEmpty() const { return !_size; }
+
+        /** @brief Bit at given position */
+        bool operator[](std::size_t i) const {
+            return BitArrayView{*this}[i];
+        }
+
+        /** @brief Set a bit at given position */
+        void set(std::size_t i) {
+            MutableBitArrayView{*this}.set(i);
+        }
+
+        /** @brief Reset a bit at given position */
+        void reset(std::size_t i) {
+            MutableBitArrayView{*this}.reset(i);
+        }
+
+        /** @brief Set or reset a bit at given position */
+        void set(std::size_t i, bool value) {
+            MutableBitArrayView{*this}.set(i, value);
+        }
+
+        /**
+         * @brief Reserve capacity for given count of bits
+         *
+         * Calls @ref arrayReserve() on the underlying byte array. Returns
+         * the new capacity in bits.
+         */
+        std::size_t reserve(std::size_t capacity) {
+            return arrayReserve(_data, (capacity + 7) >> 3) << 3;
+        }
+
+        /**
+         * @brief Append a bit
+         *
+         * If the last byte is full, appends a new one using
+         * @ref arrayAppend().
+         */
+        void append(bool value) {
+            if(!(_size & 7)) arrayAppend(_data, char{});
+            if(value) _data[_size >> 3] |= char(1 << (_size & 7));
+            ++_size;
+        }
+
+    private:
+        Array<char> _data;
+        std::size_t _size;
+};
+
+}}
+
+#endif
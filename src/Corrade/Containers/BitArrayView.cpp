@@ -0,0 +1,210 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BitArrayView.h"
+
+#include <cstdint>
+#include <cstring>
+
+#include "Corrade/Utility/Cpu.h"
+
+#ifdef CORRADE_TARGET_X86
+#include <immintrin.h>
+#endif
+
+namespace Corrade { namespace Containers { namespace Implementation {
+
+namespace {
+
+inline bool bitAt(const char* const data, const std::size_t bit) {
+    return (data[bit >> 3] >> (bit & 7)) & 1;
+}
+
+inline void setBitAt(char* const data, const std::size_t bit, const bool value) {
+    data[bit >> 3] = char((data[bit >> 3] & ~(1 << (bit & 7))) | (int(value) << (bit & 7)));
+}
+
+/* Population count of whole bytes. The scalar variant is the classic SWAR
+   reduction, the POPCNT variant is picked at runtime on x86. */
+typedef std::size_t(*CountFunction)(const char*, std::size_t);
+
+std::size_t countBytesScalar(const char* data, std::size_t size) {
+    std::size_t count = 0;
+    for(; size >= 8; data += 8, size -= 8) {
+        std::uint64_t word;
+        std::memcpy(&word, data, 8);
+        word = word - ((word >> 1) & 0x5555555555555555ull);
+        word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+        word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0full;
+        count += std::size_t((word*0x0101010101010101ull) >> 56);
+    }
+    for(; size; ++data, --size)
+        for(unsigned int byte = static_cast<unsigned char>(*data); byte; byte &= byte - 1)
+            ++count;
+    return count;
+}
+
+#ifdef CORRADE_TARGET_X86
+CORRADE_ENABLE_POPCNT std::size_t countBytesPopcnt(const char* data, std::size_t size) {
+    std::size_t count = 0;
+    for(; size >= 8; data += 8, size -= 8) {
+        std::uint32_t words[2];
+        std::memcpy(words, data, 8);
+        count += _mm_popcnt_u32(words[0]) + _mm_popcnt_u32(words[1]);
+    }
+    for(; size; ++data, --size)
+        count += _mm_popcnt_u32(static_cast<unsigned char>(*data));
+    return count;
+}
+#endif
+
+CountFunction pickCountBytes() {
+    return Utility::Cpu::dispatch<CountFunction>({
+        #ifdef CORRADE_TARGET_X86
+        {Utility::Cpu::Feature::Popcnt, countBytesPopcnt},
+        #endif
+    }, countBytesScalar);
+}
+
+}
+
+std::size_t bitArrayCount(const char* const data, const std::size_t offset, const std::size_t size, const std::size_t stride) {
+    std::size_t count = 0;
+    std::size_t i = 0;
+    if(stride == 1) {
+        /* Bits until the first byte boundary, then whole bytes */
+        for(; i != size && (offset + i) & 7; ++i)
+            count += bitAt(data, offset + i);
+        const std::size_t byteCount = (size - i) >> 3;
+        static const CountFunction countBytes = pickCountBytes();
+        count += countBytes(data + ((offset + i) >> 3), byteCount);
+        i += byteCount << 3;
+    }
+    for(; i != size; ++i)
+        count += bitAt(data, offset + i*stride);
+    return count;
+}
+
+std::size_t bitArrayFindFirst(const char* const data, const std::size_t offset, const std::size_t size, const std::size_t stride, const bool value) {
+    std::size_t i = 0;
+    if(stride == 1) {
+        for(; i != size && (offset + i) & 7; ++i)
+            if(bitAt(data, offset + i) == value) return i;
+
+        /* Skip whole words that can't contain the bit, then let the per-bit
+           loop below find it in the remaining few bytes */
+        const std::uint64_t skip = value ? 0 : ~std::uint64_t{};
+        for(; size - i >= 64; i += 64) {
+            std::uint64_t word;
+            std::memcpy(&word, data + ((offset + i) >> 3), 8);
+            if(word != skip) break;
+        }
+    }
+    for(; i != size; ++i)
+        if(bitAt(data, offset + i*stride) == value) return i;
+    return size;
+}
+
+void bitArrayFill(char* const data, const std::size_t offset, const std::size_t size, const std::size_t stride, const bool value) {
+    std::size_t i = 0;
+    if(stride == 1) {
+        for(; i != size && (offset + i) & 7; ++i)
+            setBitAt(data, offset + i, value);
+        const std::size_t byteCount = (size - i) >> 3;
+        std::memset(data + ((offset + i) >> 3), value ? 0xff : 0, byteCount);
+        i += byteCount << 3;
+    }
+    for(; i != size; ++i)
+        setBitAt(data, offset + i*stride, value);
+}
+
+void bitArrayInvert(char* const data, const std::size_t offset, const std::size_t size, const std::size_t stride) {
+    std::size_t i = 0;
+    if(stride == 1) {
+        for(; i != size && (offset + i) & 7; ++i)
+            setBitAt(data, offset + i, !bitAt(data, offset + i));
+        char* bytes = data + ((offset + i) >> 3);
+        for(; size - i >= 64; i += 64, bytes += 8) {
+            std::uint64_t word;
+            std::memcpy(&word, bytes, 8);
+            word = ~word;
+            std::memcpy(bytes, &word, 8);
+        }
+    }
+    for(; i != size; ++i)
+        setBitAt(data, offset + i*stride, !bitAt(data, offset + i*stride));
+}
+
+namespace {
+
+template<BitArrayOperation operation> inline bool apply(const bool a, const bool b) {
+    return operation == BitArrayOperation::And ? a && b :
+           operation == BitArrayOperation::Or ? a || b : a != b;
+}
+
+template<BitArrayOperation operation> inline std::uint64_t apply(const std::uint64_t a, const std::uint64_t b) {
+    return operation == BitArrayOperation::And ? a & b :
+           operation == BitArrayOperation::Or ? a | b : a ^ b;
+}
+
+template<BitArrayOperation operation> void applyImplementation(char* const data, const std::size_t offset, const std::size_t stride, const char* const otherData, const std::size_t otherOffset, const std::size_t otherStride, const std::size_t size) {
+    std::size_t i = 0;
+
+    /* Word-at-a-time only if both views are contiguous and aligned the same
+       way, otherwise the words would need to be shifted */
+    if(stride == 1 && otherStride == 1 && offset == otherOffset) {
+        for(; i != size && (offset + i) & 7; ++i)
+            setBitAt(data, offset + i, apply<operation>(bitAt(data, offset + i), bitAt(otherData, otherOffset + i)));
+        char* bytes = data + ((offset + i) >> 3);
+        const char* otherBytes = otherData + ((otherOffset + i) >> 3);
+        for(; size - i >= 64; i += 64, bytes += 8, otherBytes += 8) {
+            std::uint64_t word, otherWord;
+            std::memcpy(&word, bytes, 8);
+            std::memcpy(&otherWord, otherBytes, 8);
+            word = apply<operation>(word, otherWord);
+            std::memcpy(bytes, &word, 8);
+        }
+    }
+
+    for(; i != size; ++i)
+        setBitAt(data, offset + i*stride, apply<operation>(bitAt(data, offset + i*stride), bitAt(otherData, otherOffset + i*otherStride)));
+}
+
+}
+
+void bitArrayApply(const BitArrayOperation operation, char* const data, const std::size_t offset, const std::size_t stride, const char* const otherData, const std::size_t otherOffset, const std::size_t otherStride, const std::size_t size) {
+    switch(operation) {
+        case BitArrayOperation::And:
+            return applyImplementation<BitArrayOperation::And>(data, offset, stride, otherData, otherOffset, otherStride, size);
+        case BitArrayOperation::Or:
+            return applyImplementation<BitArrayOperation::Or>(data, offset, stride, otherData, otherOffset, otherStride, size);
+        case BitArrayOperation::Xor:
+            return applyImplementation<BitArrayOperation::Xor>(data, offset, stride, otherData, otherOffset, otherStride, size);
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+}}}
@@ -0,0 +1,390 @@
+#ifndef Corrade_Containers_BitArrayView_h
+#define Corrade_Containers_BitArrayView_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Containers::BasicBitArrayView, typedef @ref Corrade::Containers::BitArrayView, @ref Corrade::Containers::MutableBitArrayView
+ * @m_since_latest
+ */
+
+#include <cstddef>
+#include <type_traits>
+
+#include "Corrade/Containers/Containers.h"
+#include "Corrade/Utility/Assert.h"
+#include "Corrade/Utility/visibility.h"
+
+namespace Corrade { namespace Containers {
+
+namespace Implementation {
+    /* Bulk operations on bits, shared by all view types. A bit at index i is
+       at position offset + i*stride, counted from the lowest bit of the
+       first byte. The contiguous case (stride of 1) is processed a 64-bit
+       word at a time. */
+    CORRADE_UTILITY_EXPORT std::size_t bitArrayCount(const char* data, std::size_t offset, std::size_t size, std::size_t stride);
+    CORRADE_UTILITY_EXPORT std::size_t bitArrayFindFirst(const char* data, std::size_t offset, std::size_t size, std::size_t stride, bool value);
+    CORRADE_UTILITY_EXPORT void bitArrayFill(char* data, std::size_t offset, std::size_t size, std::size_t stride, bool value);
+    CORRADE_UTILITY_EXPORT void bitArrayInvert(char* data, std::size_t offset, std::size_t size, std::size_t stride);
+
+    enum class BitArrayOperation { And, Or, Xor };
+    CORRADE_UTILITY_EXPORT void bitArrayApply(BitArrayOperation operation, char* data, std::size_t offset, std::size_t stride, const char* otherData, std::size_t otherOffset, std::size_t otherStride, std::size_t size);
+}
+
+/**
+@brief Bit array view
+@m_since_latest
+
+A view on a sequence of bits, packed eight to a byte starting from the lowest
+bit of the first byte. Unlike @ref ArrayView it can start at an arbitrary bit
+offset and similarly to @ref StridedArrayView it can skip bits using
+@ref every(). There are two variants --- a @ref BitArrayView on immutable data
+and a @ref MutableBitArrayView that additionally allows modifying the bits.
+The owning counterpart is @ref BitArray.
+
+@snippet Containers.cpp BitArrayView
+
+@section Containers-BasicBitArrayView-performance Performance characteristics
+
+@ref count(), @ref findFirstSet(), @ref findFirstUnset(), @ref setAll(),
+@ref resetAll(), @ref invert() as well as @ref andWith(), @ref orWith() and
+@ref xorWith() process contiguous views (i.e., with a stride of @cpp 1 @ce) a
+64-bit word at a time, with @ref count() using the POPCNT instruction on x86
+if @ref Utility::Cpu::runtimeFeatures() reports it. The bulk operations take
+the fast path only if both views start at the same bit offset inside a byte.
+Views with a stride larger than @cpp 1 @ce are processed one bit at a time.
+*/
+template<class T> class BasicBitArrayView {
+    static_assert(std::is_same<typename std::remove_const<T>::type, void>::value,
+        "only void and const void bit array views are supported");
+
+    typedef typename std::conditional<std::is_const<T>::value, const char, char>::type ErasedType;
+
+    public:
+        /**
+         * @brief Default constructor
+         *
+         * Creates an empty @cpp nullptr @ce view.
+         */
+        constexpr /*implicit*/ BasicBitArrayView() noexcept: _data{}, _offset{}, _size{}, _stride{1} {}
+
+        /** @brief Construct from a @cpp nullptr @ce */
+        constexpr /*implicit*/ BasicBitArrayView(std::nullptr_t) noexcept: _data{}, _offset{}, _size{}, _stride{1} {}
+
+        /**
+         * @brief Construct from a pointer, bit offset and size
+         * @param data      Data pointer
+         * @param offset    Offset of the first bit, in bits
+         * @param size      Size in bits
+         *
+         * The @p offset can be arbitrary, @ref data() and @ref offset() are
+         * then adjusted so the offset is less than 8.
+         */
+        /*implicit*/ BasicBitArrayView(T* data, std::size_t offset, std::size_t size) noexcept: _data{static_cast<ErasedType*>(data) + (offset >> 3)}, _offset{offset & 7}, _size{size}, _stride{1} {}
+
+        /** @brief Construct a @ref BitArrayView from a @ref MutableBitArrayView */
+        template<class U, class = typename std::enable_if<std::is_same<const U, T>::value && !std::is_same<U, T>::value>::type> /*implicit*/ BasicBitArrayView(BasicBitArrayView<U> view) noexcept: _data{view._data}, _offset{view._offset}, _size{view._size}, _stride{view._stride} {}
+
+        /** @brief Data pointer */
+        T* data() const { return _data; }
+
+        /**
+         * @brief Offset of the first bit in the first byte
+         *
+         * Always less than 8.
+         */
+        std::size_t offset() const { return _offset; }
+
+        /** @brief Size in bits */
+        std::size_t size() const { return _size; }
+
+        /**
+         * @brief Stride in bits
+         *
+         * Distance between two consecutive bits of the view. @cpp 1 @ce
+         * unless the view was created using @ref every().
+         */
+        std::size_t stride() const { return _stride; }
+
+        /** @brief Whether the view is empty */
+        bool isEmpty() const { return !_size; }
+
+        /** @brief Bit at given position */
+        bool operator[](std::size_t i) const {
+            CORRADE_ASSERT(i < _size, "Containers::BitArrayView::operator[](): index" << i << "out of range for" << _size << "bits", {});
+            const std::size_t bit = _offset + i*_stride;
+            return (_data[bit >> 3] >> (bit & 7)) & 1;
+        }
+
+        /**
+         * @brief Set a bit at given position
+         *
+         * Available only on a @ref MutableBitArrayView.
+         */
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        void set(std::size_t i) const;
+        #else
+        template<class U = T> typename std::enable_if<!std::is_const<U>::value>::type set(std::size_t i) const {
+            CORRADE_ASSERT(i < _size, "Containers::BitArrayView::set(): index" << i << "out of range for" << _size << "bits", );
+            const std::size_t bit = _offset + i*_stride;
+            _data[bit >> 3] |= char(1 << (bit & 7));
+        }
+        #endif
+
+        /**
+         * @brief Reset a bit at given position
+         *
+         * Available only on a @ref MutableBitArrayView.
+         */
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        void reset(std::size_t i) const;
+        #else
+        template<class U = T> typename std::enable_if<!std::is_const<U>::value>::type reset(std::size_t i) const {
+            CORRADE_ASSERT(i < _size, "Containers::BitArrayView::reset(): index" << i << "out of range for" << _size << "bits", );
+            const std::size_t bit = _offset + i*_stride;
+            _data[bit >> 3] &= ~char(1 << (bit & 7));
+        }
+        #endif
+
+        /**
+         * @brief Set or reset a bit at given position
+         *
+         * Available only on a @ref MutableBitArrayView.
+         */
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        void set(std::size_t i, bool value) const;
+        #else
+        template<class U = T> typename std::enable_if<!std::is_const<U>::value>::type set(std::size_t i, bool value) const {
+            CORRADE_ASSERT(i < _size, "Containers::BitArrayView::set(): index" << i << "out of range for" << _size << "bits", );
+            const std::size_t bit = _offset + i*_stride;
+            _data[bit >> 3] = char((_data[bit >> 3] & ~(1 << (bit & 7))) | (int(value) << (bit & 7)));
+        }
+        #endif
+
+        /**
+         * @brief View slice
+         *
+         * Expects that both @p begin and @p end are in range and
+         * @p begin is not larger than @p end.
+         */
+        BasicBitArrayView<T> slice(std::size_t begin, std::size_t end) const {
+            CORRADE_ASSERT(begin <= end && end <= _size,
+                "Containers::BitArrayView::slice(): slice [" << Utility::Debug::nospace << begin << Utility::Debug::nospace << ":" << Utility::Debug::nospace << end << Utility::Debug::nospace << "] out of range for" << _size << "bits", {});
+            BasicBitArrayView<T> out;
+            const std::size_t bit = _offset + begin*_stride;
+            out._data = _data + (bit >> 3);
+            out._offset = bit & 7;
+            out._size = end - begin;
+            out._stride = _stride;
+            return out;
+        }
+
+        /** @brief View on the first @p end bits */
+        BasicBitArrayView<T> prefix(std::size_t end) const {
+            return slice(0, end);
+        }
+
+        /** @brief View on the bits from @p begin to the end */
+        BasicBitArrayView<T> suffix(std::size_t begin) const {
+            return slice(begin, _size);
+        }
+
+        /** @brief View except the last @p count bits */
+        BasicBitArrayView<T> except(std::size_t count) const {
+            CORRADE_ASSERT(count <= _size, "Containers::BitArrayView::except(): can't except" << count << "bits from" << _size, {});
+            return slice(0, _size - count);
+        }
+
+        /**
+         * @brief Pick every Nth bit
+         *
+         * Multiplies the stride by @p step and adjusts the size accordingly.
+         * Expects that @p step is not zero.
+         */
+        BasicBitArrayView<T> every(std::size_t step) const {
+            CORRADE_ASSERT(step, "Containers::BitArrayView::every(): step can't be zero", {});
+            BasicBitArrayView<T> out{*this};
+            out._size = (_size + step - 1)/step;
+            out._stride = _stride*step;
+            return out;
+        }
+
+        /** @brief Count of set bits */
+        std::size_t count() const {
+            return Implementation::bitArrayCount(_data, _offset, _size, _stride);
+        }
+
+        /**
+         * @brief Find the first set bit
+         *
+         * Returns @ref size() if no bit is set.
+         */
+        std::size_t findFirstSet() const {
+            return Implementation::bitArrayFindFirst(_data, _offset, _size, _stride, true);
+        }
+
+        /**
+         * @brief Find the first unset bit
+         *
+         * Returns @ref size() if all bits are set.
+         */
+        std::size_t findFirstUnset() const {
+            return Implementation::bitArrayFindFirst(_data, _offset, _size, _stride, false);
+        }
+
+        /**
+         * @brief Call a function for each set bit
+         *
+         * The @p callback gets called with an index of each set bit, in
+         * increasing order. In contiguous views, bytes that have no bits set
+         * are skipped without looking at individual bits.
+         */
+        template<class F> void forEachSet(F&& callback) const {
+            std::size_t i = 0;
+            if(_stride == 1) {
+                for(; i != _size && (_offset + i) & 7; ++i)
+                    if((_data[(_offset + i) >> 3] >> ((_offset + i) & 7)) & 1)
+                        callback(i);
+                for(; _size - i >= 8; i += 8) {
+                    const unsigned int byte = static_cast<unsigned char>(_data[(_offset + i) >> 3]);
+                    if(!byte) continue;
+                    for(std::size_t j = 0; j != 8; ++j)
+                        if((byte >> j) & 1) callback(i + j);
+                }
+            }
+            for(; i != _size; ++i) {
+                const std::size_t bit = _offset + i*_stride;
+                if((_data[bit >> 3] >> (bit & 7)) & 1) callback(i);
+            }
+        }
+
+        /**
+         * @brief Set all bits
+         *
+         * Available only on a @ref MutableBitArrayView.
+         */
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        void setAll() const;
+        #else
+        template<class U = T> typename std::enable_if<!std::is_const<U>::value>::type setAll() const {
+            Implementation::bitArrayFill(_data, _offset, _size, _stride, true);
+        }
+        #endif
+
+        /**
+         * @brief Reset all bits
+         *
+         * Available only on a @ref MutableBitArrayView.
+         */
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        void resetAll() const;
+        #else
+        template<class U = T> typename std::enable_if<!std::is_const<U>::value>::type resetAll() const {
+            Implementation::bitArrayFill(_data, _offset, _size, _stride, false);
+        }
+        #endif
+
+        /**
+         * @brief Invert all bits
+         *
+         * Available only on a @ref MutableBitArrayView.
+         */
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        void invert() const;
+        #else
+        template<class U = T> typename std::enable_if<!std::is_const<U>::value>::type invert() const {
+            Implementation::bitArrayInvert(_data, _offset, _size, _stride);
+        }
+        #endif
+
+        /**
+         * @brief Bitwise AND with another view
+         *
+         * Expects that both views have the same size. Available only on a
+         * @ref MutableBitArrayView.
+         */
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        void andWith(BitArrayView other) const;
+        #else
+        template<class U = T> typename std::enable_if<!std::is_const<U>::value>::type andWith(BasicBitArrayView<const void> other) const {
+            CORRADE_ASSERT(other._size == _size, "Containers::BitArrayView::andWith(): expected a view of" << _size << "bits but got" << other._size, );
+            Implementation::bitArrayApply(Implementation::BitArrayOperation::And, _data, _offset, _stride, other._data, other._offset, other._stride, _size);
+        }
+        #endif
+
+        /**
+         * @brief Bitwise OR with another view
+         *
+         * Expects that both views have the same size. Available only on a
+         * @ref MutableBitArrayView.
+         */
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        void orWith(BitArrayView other) const;
+        #else
+        template<class U = T> typename std::enable_if<!std::is_const<U>::value>::type orWith(BasicBitArrayView<const void> other) const {
+            CORRADE_ASSERT(other._size == _size, "Containers::BitArrayView::orWith(): expected a view of" << _size << "bits but got" << other._size, );
+            Implementation::bitArrayApply(Implementation::BitArrayOperation::Or, _data, _offset, _stride, other._data, other._offset, other._stride, _size);
+        }
+        #endif
+
+        /**
+         * @brief Bitwise XOR with another view
+         *
+         * Expects that both views have the same size. Available only on a
+         * @ref MutableBitArrayView.
+         */
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        void xorWith(BitArrayView other) const;
+        #else
+        template<class U = T> typename std::enable_if<!std::is_const<U>::value>::type xorWith(BasicBitArrayView<const void> other) const {
+            CORRADE_ASSERT(other._size == _size, "Containers::BitArrayView::xorWith(): expected a view of" << _size << "bits but got" << other._size, );
+            Implementation::bitArrayApply(Implementation::BitArrayOperation::Xor, _data, _offset, _stride, other._data, other._offset, other._stride, _size);
+        }
+        #endif
+
+    private:
+        template<class> friend class BasicBitArrayView;
+
+        ErasedType* _data;
+        std::size_t _offset;
+        std::size_t _size;
+        std::size_t _stride;
+};
+
+/**
+@brief Immutable bit array view
+@m_since_latest
+*/
+typedef BasicBitArrayView<const void> BitArrayView;
+
+/**
+@brief Mutable bit array view
+@m_since_latest
+*/
+typedef BasicBitArrayView<void> MutableBitArrayView;
+
+}}
+
+#endif
@@ -0,0 +1,221 @@
+#ifndef Corrade_Containers_ConcurrentArrayAppender_h
+#define Corrade_Containers_ConcurrentArrayAppender_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+/** @file
+ * @brief Class @ref Corrade::Containers::ConcurrentArrayAppender
+ * @m_since_latest
+ */
+
+#include <atomic>
+#include <cstring>
+#include <mutex>
+
+#include "Corrade/Containers/GrowableArray.h"
+
+namespace Corrade { namespace Containers {
+
+namespace Implementation {
+    /* Same as ConcurrentQueueCacheLineSize, the bump position is kept on a
+       cache line of its own so the appending threads don't invalidate the
+       line with the (read-only) data pointer and capacity */
+    enum: std::size_t { ConcurrentArrayAppenderCacheLineSize = 64 };
+
+    template<class T> struct ConcurrentArrayAppenderOverflow {
+        Array<T> data;
+        std::size_t size;
+    };
+}
+
+/**
+@brief Concurrent appender to a growable array
+@m_since_latest
+
+Allows any number of threads to append to a single @ref Array without a
+per-thread intermediate array and a final merge copy. On construction the
+appender takes over the whole capacity of the array, as set up by
+@ref arrayReserve() beforehand, and then hands out disjoint, uninitialized
+chunks of it to @ref append() callers. Claiming a chunk is a single
+compare-and-swap on an atomic position, the threads then write their output
+in place:
+
+@snippet Containers.cpp ConcurrentArrayAppender
+
+Once the reserved capacity runs out, @ref append() falls back to a slow path
+that allocates overflow chunks under a lock. The array itself can't be
+reallocated at that point because other threads may still be writing to views
+they got earlier, so the overflow chunks get appended to the array only when
+the appender is destroyed, at which point the array is also shrunk to the
+actually appended size. Reserving a sufficient capacity upfront thus makes the
+whole operation zero-copy. If the array isn't growable, its capacity is equal
+to its size and all appends go through the slow path.
+
+Chunks claimed by a single @ref append() call are contiguous, but the order of
+chunks from different threads is unspecified. Memory written to the returned
+views is made visible to other threads only through external synchronization,
+such as joining the appending threads, which is needed before destroying the
+appender anyway. The array shouldn't be accessed while the appender exists.
+
+As the returned views point to uninitialized memory and the overflow chunks
+are copied with a plain @ref std::memcpy(), the type is required to be
+trivially copyable.
+@see @ref SpscQueue, @ref MpmcQueue
+*/
+template<class T> class ConcurrentArrayAppender {
+    #ifdef CORRADE_STD_IS_TRIVIALLY_TRAITS_SUPPORTED
+    static_assert(std::is_trivially_copyable<T>::value,
+        "only trivially copyable types can be appended concurrently");
+    #endif
+
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Takes over the capacity of @p array that's not used yet, its
+         * existing contents are kept. Use @ref arrayReserve() before to
+         * reserve space for the values to be appended.
+         */
+        explicit ConcurrentArrayAppender(Array<T>& array);
+
+        /** @brief Copying is not allowed */
+        ConcurrentArrayAppender(const ConcurrentArrayAppender<T>&) = delete;
+
+        /** @brief Moving is not allowed */
+        ConcurrentArrayAppender(ConcurrentArrayAppender<T>&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Shrinks the array to the size of values appended to the reserved
+         * capacity and appends the overflow chunks, if any. Expects that no
+         * other thread is calling @ref append() anymore.
+         */
+        ~ConcurrentArrayAppender();
+
+        /** @brief Copying is not allowed */
+        ConcurrentArrayAppender<T>& operator=(const ConcurrentArrayAppender<T>&) = delete;
+
+        /** @brief Moving is not allowed */
+        ConcurrentArrayAppender<T>& operator=(ConcurrentArrayAppender<T>&&) = delete;
+
+        /**
+         * @brief Reserved capacity
+         *
+         * Count of values that can be appended without going through the slow
+         * path, including the ones that were appended already.
+         */
+        std::size_t capacity() const { return _capacity - _begin; }
+
+        /**
+         * @brief Append values
+         *
+         * Returns a view on @p count uninitialized values the caller is
+         * expected to fill. If there's not enough reserved capacity left,
+         * the view points to an overflow chunk allocated under a lock. Can
+         * be called from any number of threads concurrently.
+         */
+        ArrayView<T> append(std::size_t count);
+
+        /**
+         * @brief Append a list of values
+         *
+         * Copies @p values to a view returned by @ref append(std::size_t)
+         * and returns it.
+         */
+        ArrayView<T> append(ArrayView<const T> values);
+
+    private:
+        ArrayView<T> appendOverflow(std::size_t count);
+
+        Array<T>& _array;
+        T* _data;
+        std::size_t _begin, _capacity;
+        char _padding0[Implementation::ConcurrentArrayAppenderCacheLineSize];
+        std::atomic<std::size_t> _position;
+        char _padding1[Implementation::ConcurrentArrayAppenderCacheLineSize];
+        /* Accessed only under the lock */
+        std::mutex _overflowMutex;
+        Array<Implementation::ConcurrentArrayAppenderOverflow<T>> _overflow;
+        std::size_t _overflowSize;
+};
+
+template<class T> ConcurrentArrayAppender<T>::ConcurrentArrayAppender(Array<T>& array): _array(array), _begin{array.size()}, _capacity{arrayCapacity(array)}, _position{_begin}, _overflowSize{0} {
+    /* Expose the whole capacity so the views handed out are inside the array
+       bounds. If the capacity is equal to the size, this is a no-op. */
+    arrayResize(array, NoInit, _capacity);
+    _data = array.data();
+}
+
+template<class T> ConcurrentArrayAppender<T>::~ConcurrentArrayAppender() {
+    /* Drop the reserved space that wasn't claimed. With the default growable
+       allocator this doesn't reallocate. */
+    arrayResize(_array, NoInit, _position.load(std::memory_order_acquire));
+    if(!_overflowSize) return;
+
+    /* Reallocate just once for all overflow chunks */
+    arrayReserve(_array, _array.size() + _overflowSize);
+    for(const Implementation::ConcurrentArrayAppenderOverflow<T>& overflow: _overflow)
+        arrayAppend(_array, ArrayView<const T>{overflow.data.data(), overflow.size});
+}
+
+template<class T> ArrayView<T> ConcurrentArrayAppender<T>::append(const std::size_t count) {
+    /* Not a fetch_add() as it would leave a hole in the array if the range
+       didn't fit and went to the overflow instead. On failure the position
+       gets updated to the current value. */
+    std::size_t position = _position.load(std::memory_order_relaxed);
+    do {
+        if(_capacity - position < count) return appendOverflow(count);
+    } while(!_position.compare_exchange_weak(position, position + count, std::memory_order_relaxed));
+
+    return {_data + position, count};
+}
+
+template<class T> ArrayView<T> ConcurrentArrayAppender<T>::append(const ArrayView<const T> values) {
+    const ArrayView<T> out = append(values.size());
+    if(!values.empty()) std::memcpy(out.data(), values.data(), values.size()*sizeof(T));
+    return out;
+}
+
+template<class T> ArrayView<T> ConcurrentArrayAppender<T>::appendOverflow(const std::size_t count) {
+    std::lock_guard<std::mutex> lock{_overflowMutex};
+
+    /* Allocate a new chunk if the last one doesn't have enough space. The
+       chunks double the total capacity, similarly to a growable array, to
+       keep the count of allocations logarithmic. */
+    if(_overflow.empty() || _overflow.back().data.size() - _overflow.back().size < count) {
+        const std::size_t total = _capacity + _overflowSize;
+        arrayAppend(_overflow, InPlaceInit, Array<T>{NoInit, count > total ? count : total}, std::size_t{});
+    }
+
+    Implementation::ConcurrentArrayAppenderOverflow<T>& overflow = _overflow.back();
+    const ArrayView<T> out{overflow.data.data() + overflow.size, count};
+    overflow.size += count;
+    _overflowSize += count;
+    return out;
+}
+
+}}
+
+#endif
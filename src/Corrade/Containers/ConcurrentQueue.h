@@ -0,0 +1,403 @@
+#ifndef Corrade_Containers_ConcurrentQueue_h
+#define Corrade_Containers_ConcurrentQueue_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Containers::SpscQueue, @ref Corrade::Containers::MpmcQueue
+ * @m_since_latest
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+#include "Corrade/Containers/RingBuffer.h"
+
+namespace Corrade { namespace Containers {
+
+namespace Implementation {
+    /* Indices written by different threads are kept this far apart so they
+       don't end up on the same cache line. Not using alignas() as
+       over-aligned types aren't guaranteed to be correctly allocated on the
+       heap before C++17. */
+    enum: std::size_t { ConcurrentQueueCacheLineSize = 64 };
+
+    template<class T> struct MpmcQueueSlot {
+        /* Equal to position if the slot is free for given position, equal to
+           position + 1 if it contains a value for given position */
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+}
+
+/**
+@brief Lock-free single-producer single-consumer queue
+@m_since_latest
+
+A bounded FIFO queue for passing values from one thread to another. Calling
+@ref push() concurrently from more than one thread or @ref pop() concurrently
+from more than one thread is undefined behavior, use @ref MpmcQueue in that
+case. The capacity is rounded up to a power of two, if the queue is full,
+@ref push() returns @cpp false @ce and it's up to the caller whether to retry
+or drop the value.
+
+The producer and consumer position are kept on separate cache lines together
+with a local copy of the other side's position, so in the common case where
+the queue is neither empty nor full a push or a pop doesn't touch any cache
+line written by the other thread. To amortize the atomic operations further,
+use the @ref push(ArrayView<const T>) and @ref pop(ArrayView<T>) overloads,
+which publish the whole batch with a single atomic store:
+
+@snippet Containers.cpp SpscQueue
+
+Same as with @ref RingBuffer, the type is required to be default-constructible
+and move-assignable.
+*/
+template<class T> class SpscQueue {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Expects that @p capacity is not zero, it's rounded up to the
+         * nearest power of two.
+         */
+        explicit SpscQueue(std::size_t capacity);
+
+        /** @brief Copying is not allowed */
+        SpscQueue(const SpscQueue<T>&) = delete;
+
+        /** @brief Moving is not allowed */
+        SpscQueue(SpscQueue<T>&&) = delete;
+
+        /** @brief Copying is not allowed */
+        SpscQueue<T>& operator=(const SpscQueue<T>&) = delete;
+
+        /** @brief Moving is not allowed */
+        SpscQueue<T>& operator=(SpscQueue<T>&&) = delete;
+
+        /** @brief Capacity */
+        std::size_t capacity() const { return _data.size(); }
+
+        /**
+         * @brief Count of values in the queue
+         *
+         * If called while other threads are pushing or popping, the value
+         * might be already outdated when returned.
+         */
+        std::size_t size() const {
+            /* Loading head first so the tail is never behind it */
+            const std::size_t head = _head.load(std::memory_order_acquire);
+            return _tail.load(std::memory_order_acquire) - head;
+        }
+
+        /**
+         * @brief Push a value
+         *
+         * Returns @cpp false @ce if the queue is full. Can be called only
+         * from the producer thread.
+         */
+        bool push(const T& value) { return pushInternal(value); }
+        bool push(T&& value) { return pushInternal(std::move(value)); } /**< @overload */
+
+        /**
+         * @brief Push multiple values
+         *
+         * Copies as many values from @p values as there's free space for and
+         * returns their count. Can be called only from the producer thread.
+         */
+        std::size_t push(ArrayView<const T> values);
+
+        /**
+         * @brief Pop a value
+         *
+         * Returns @cpp false @ce if the queue is empty, otherwise moves the
+         * value to @p value. Can be called only from the consumer thread.
+         */
+        bool pop(T& value);
+
+        /**
+         * @brief Pop multiple values
+         *
+         * Moves at most @cpp values.size() @ce values to @p values and
+         * returns their count. Can be called only from the consumer thread.
+         */
+        std::size_t pop(ArrayView<T> values);
+
+    private:
+        template<class U> bool pushInternal(U&& value);
+
+        Array<T> _data;
+        std::size_t _mask;
+        char _padding0[Implementation::ConcurrentQueueCacheLineSize];
+        /* Written by the producer */
+        std::atomic<std::size_t> _tail;
+        std::size_t _cachedHead;
+        char _padding1[Implementation::ConcurrentQueueCacheLineSize];
+        /* Written by the consumer */
+        std::atomic<std::size_t> _head;
+        std::size_t _cachedTail;
+        char _padding2[Implementation::ConcurrentQueueCacheLineSize];
+};
+
+/**
+@brief Lock-free multi-producer multi-consumer queue
+@m_since_latest
+
+A bounded FIFO queue that can be pushed to and popped from any number of
+threads concurrently. Each slot carries a sequence number telling whether it's
+free or full for given position, so producers and consumers synchronize only
+through the slots they're working on and a single compare-and-swap on a shared
+position. The queue is lock-free but not wait-free --- a producer or consumer
+suspended in the middle of an operation can delay the consumers or producers
+of the slots it has claimed.
+
+The batch @ref push(ArrayView<const T>) and @ref pop(ArrayView<T>) overloads
+claim a whole range of consecutive slots with a single compare-and-swap, which
+considerably reduces contention on the shared positions compared to pushing
+or popping the values one by one. Values in a batch are kept consecutive in
+the queue, but values from different producers can interleave between
+batches.
+
+Same as with @ref RingBuffer, the type is required to be default-constructible
+and move-assignable.
+@see @ref SpscQueue
+*/
+template<class T> class MpmcQueue {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Expects that @p capacity is not zero, it's rounded up to the
+         * nearest power of two.
+         */
+        explicit MpmcQueue(std::size_t capacity);
+
+        /** @brief Copying is not allowed */
+        MpmcQueue(const MpmcQueue<T>&) = delete;
+
+        /** @brief Moving is not allowed */
+        MpmcQueue(MpmcQueue<T>&&) = delete;
+
+        /** @brief Copying is not allowed */
+        MpmcQueue<T>& operator=(const MpmcQueue<T>&) = delete;
+
+        /** @brief Moving is not allowed */
+        MpmcQueue<T>& operator=(MpmcQueue<T>&&) = delete;
+
+        /** @brief Capacity */
+        std::size_t capacity() const { return _slots.size(); }
+
+        /**
+         * @brief Push a value
+         *
+         * Returns @cpp false @ce if the queue is full.
+         */
+        bool push(const T& value) { return pushInternal(value); }
+        bool push(T&& value) { return pushInternal(std::move(value)); } /**< @overload */
+
+        /**
+         * @brief Push multiple values
+         *
+         * Copies as many values from @p values as there are consecutive free
+         * slots for and returns their count.
+         */
+        std::size_t push(ArrayView<const T> values);
+
+        /**
+         * @brief Pop a value
+         *
+         * Returns @cpp false @ce if the queue is empty, otherwise moves the
+         * value to @p value.
+         */
+        bool pop(T& value);
+
+        /**
+         * @brief Pop multiple values
+         *
+         * Moves as many values to @p values as there are consecutive ready
+         * slots, up to @cpp values.size() @ce, and returns their count.
+         */
+        std::size_t pop(ArrayView<T> values);
+
+    private:
+        typedef Implementation::MpmcQueueSlot<T> Slot;
+
+        template<class U> bool pushInternal(U&& value);
+
+        /* Claims at most `count` consecutive slots starting at the shared
+           position whose sequence is equal to position + offset. Returns the
+           first claimed position and the count of claimed slots. */
+        std::pair<std::size_t, std::size_t> claim(std::atomic<std::size_t>& sharedPosition, std::size_t offset, std::size_t count);
+
+        Array<Slot> _slots;
+        std::size_t _mask;
+        char _padding0[Implementation::ConcurrentQueueCacheLineSize];
+        std::atomic<std::size_t> _enqueuePosition;
+        char _padding1[Implementation::ConcurrentQueueCacheLineSize];
+        std::atomic<std::size_t> _dequeuePosition;
+        char _padding2[Implementation::ConcurrentQueueCacheLineSize];
+};
+
+template<class T> SpscQueue<T>::SpscQueue(const std::size_t capacity): _data{ValueInit, Implementation::ringBufferCapacity(capacity)}, _mask{_data.size() - 1}, _tail{0}, _cachedHead{0}, _head{0}, _cachedTail{0} {
+    CORRADE_ASSERT(capacity,
+        "Containers::SpscQueue: capacity expected to be non-zero", );
+}
+
+template<class T> template<class U> bool SpscQueue<T>::pushInternal(U&& value) {
+    const std::size_t tail = _tail.load(std::memory_order_relaxed);
+    /* Refresh the cached head only if the queue looks full */
+    if(tail - _cachedHead == _data.size()) {
+        _cachedHead = _head.load(std::memory_order_acquire);
+        if(tail - _cachedHead == _data.size()) return false;
+    }
+
+    _data[tail & _mask] = std::forward<U>(value);
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+template<class T> std::size_t SpscQueue<T>::push(const ArrayView<const T> values) {
+    const std::size_t tail = _tail.load(std::memory_order_relaxed);
+    if(_data.size() - (tail - _cachedHead) < values.size())
+        _cachedHead = _head.load(std::memory_order_acquire);
+    const std::size_t free = _data.size() - (tail - _cachedHead);
+    const std::size_t count = values.size() < free ? values.size() : free;
+
+    for(std::size_t i = 0; i != count; ++i)
+        _data[(tail + i) & _mask] = values[i];
+    _tail.store(tail + count, std::memory_order_release);
+    return count;
+}
+
+template<class T> bool SpscQueue<T>::pop(T& value) {
+    const std::size_t head = _head.load(std::memory_order_relaxed);
+    /* Refresh the cached tail only if the queue looks empty */
+    if(head == _cachedTail) {
+        _cachedTail = _tail.load(std::memory_order_acquire);
+        if(head == _cachedTail) return false;
+    }
+
+    value = std::move(_data[head & _mask]);
+    _head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+template<class T> std::size_t SpscQueue<T>::pop(const ArrayView<T> values) {
+    const std::size_t head = _head.load(std::memory_order_relaxed);
+    if(_cachedTail - head < values.size())
+        _cachedTail = _tail.load(std::memory_order_acquire);
+    const std::size_t available = _cachedTail - head;
+    const std::size_t count = values.size() < available ? values.size() : available;
+
+    for(std::size_t i = 0; i != count; ++i)
+        values[i] = std::move(_data[(head + i) & _mask]);
+    _head.store(head + count, std::memory_order_release);
+    return count;
+}
+
+template<class T> MpmcQueue<T>::MpmcQueue(const std::size_t capacity): _slots{ValueInit, Implementation::ringBufferCapacity(capacity)}, _mask{_slots.size() - 1}, _enqueuePosition{0}, _dequeuePosition{0} {
+    CORRADE_ASSERT(capacity,
+        "Containers::MpmcQueue: capacity expected to be non-zero", );
+    for(std::size_t i = 0; i != _slots.size(); ++i)
+        _slots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+template<class T> std::pair<std::size_t, std::size_t> MpmcQueue<T>::claim(std::atomic<std::size_t>& sharedPosition, const std::size_t offset, const std::size_t count) {
+    std::size_t position = sharedPosition.load(std::memory_order_relaxed);
+    for(;;) {
+        const std::ptrdiff_t difference = std::ptrdiff_t(_slots[position & _mask].sequence.load(std::memory_order_acquire)) - std::ptrdiff_t(position + offset);
+
+        /* The first slot is not ready yet -- the queue is full for producers
+           or empty for consumers */
+        if(difference < 0) return {position, 0};
+
+        /* Someone else already claimed the position, try again with the
+           current one */
+        if(difference > 0) {
+            position = sharedPosition.load(std::memory_order_relaxed);
+            continue;
+        }
+
+        /* Find how many slots after the first one are ready as well. The
+           sequences can't change until the position is claimed, so it's
+           enough to check them once. */
+        std::size_t claimed = 1;
+        while(claimed < count && _slots[(position + claimed) & _mask].sequence.load(std::memory_order_acquire) == position + claimed + offset)
+            ++claimed;
+
+        /* On failure the position gets updated to the current value */
+        if(sharedPosition.compare_exchange_weak(position, position + claimed, std::memory_order_relaxed))
+            return {position, claimed};
+    }
+}
+
+template<class T> template<class U> bool MpmcQueue<T>::pushInternal(U&& value) {
+    const std::pair<std::size_t, std::size_t> claimed = claim(_enqueuePosition, 0, 1);
+    if(!claimed.second) return false;
+
+    Slot& slot = _slots[claimed.first & _mask];
+    slot.value = std::forward<U>(value);
+    slot.sequence.store(claimed.first + 1, std::memory_order_release);
+    return true;
+}
+
+template<class T> std::size_t MpmcQueue<T>::push(const ArrayView<const T> values) {
+    if(values.empty()) return 0;
+
+    const std::pair<std::size_t, std::size_t> claimed = claim(_enqueuePosition, 0, values.size());
+    for(std::size_t i = 0; i != claimed.second; ++i) {
+        Slot& slot = _slots[(claimed.first + i) & _mask];
+        slot.value = values[i];
+        slot.sequence.store(claimed.first + i + 1, std::memory_order_release);
+    }
+    return claimed.second;
+}
+
+template<class T> bool MpmcQueue<T>::pop(T& value) {
+    const std::pair<std::size_t, std::size_t> claimed = claim(_dequeuePosition, 1, 1);
+    if(!claimed.second) return false;
+
+    Slot& slot = _slots[claimed.first & _mask];
+    value = std::move(slot.value);
+    slot.sequence.store(claimed.first + _slots.size(), std::memory_order_release);
+    return true;
+}
+
+template<class T> std::size_t MpmcQueue<T>::pop(const ArrayView<T> values) {
+    if(values.empty()) return 0;
+
+    const std::pair<std::size_t, std::size_t> claimed = claim(_dequeuePosition, 1, values.size());
+    for(std::size_t i = 0; i != claimed.second; ++i) {
+        Slot& slot = _slots[(claimed.first + i) & _mask];
+        values[i] = std::move(slot.value);
+        slot.sequence.store(claimed.first + i + _slots.size(), std::memory_order_release);
+    }
+    return claimed.second;
+}
+
+}}
+
+#endif
@@ -39,24 +39,51 @@ namespace Corrade { namespace Containers {
 #ifndef DOXYGEN_GENERATING_OUTPUT
 template<class T, class = void(*)(T*, std::size_t)> class Array;
 template<class> class ArrayView;
+template<class> class BasicBitArrayView;
+typedef BasicBitArrayView<const void> BitArrayView;
+typedef BasicBitArrayView<void> MutableBitArrayView;
+class BitArray;
 template<std::size_t, class> class StaticArrayView;
 template<std::size_t, class> class StaticArray;
+template<std::ptrdiff_t, class> class StaticStridedArrayView;
+template<std::ptrdiff_t, class> class StaticStridedIterator;
 
 template<unsigned, class> class StridedDimensions;
 template<unsigned, class> class StridedArrayView;
+template<unsigned, class> class StridedElementIterator;
 template<unsigned, class> class StridedIterator;
 template<class T> using StridedArrayView1D = StridedArrayView<1, T>;
 template<class T> using StridedArrayView2D = StridedArrayView<2, T>;
 template<class T> using StridedArrayView3D = StridedArrayView<3, T>;
 template<class T> using StridedArrayView4D = StridedArrayView<4, T>;
 
+template<class T, std::size_t size = (1 << (sizeof(typename std::underlying_type<T>::type)*8))/64> class BigEnumSet;
+template<class> class ConcurrentArrayAppender;
 template<class T, typename std::underlying_type<T>::type fullValue = typename std::underlying_type<T>::type(~0)> class EnumSet;
+template<class, class = void> struct HashMapHash;
+template<class K, class V, class Hash = HashMapHash<K>> class HashMap;
+template<class, class> class HashMapEntry;
 template<class> class LinkedList;
 template<class Derived, class List = LinkedList<Derived>> class LinkedListItem;
+template<class> class MpmcQueue;
+template<class> class ObjectPool;
+struct ObjectPoolDeleter;
 
 template<class T> class Optional;
-template<class T> class Pointer;
+template<class T, class = void> class Pointer;
 template<class T> class Reference;
+template<class> class RingBuffer;
+template<class> class SharedArray;
+template<class> class SlotMap;
+class SlotMapHandle;
+template<class> class SpscQueue;
+
+template<class> class BasicStringView;
+typedef BasicStringView<const char> StringView;
+typedef BasicStringView<char> MutableStringView;
+template<class> class BasicStringSplitIterator;
+template<class> class BasicStringSplitIterable;
+class String;
 #endif
 
 }}
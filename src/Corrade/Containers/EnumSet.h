@@ -64,7 +64,20 @@ definitions. This macro works with templated classes as well.
 
 @snippet Containers.cpp EnumSet-friend
 
-@see @ref enumSetDebugOutput()
+@section Containers-EnumSet-iteration Iterating over set values
+
+The set is iterable, yielding every value that has its bits set, in order
+from the lowest bit. Each iteration step isolates the lowest set bit of the
+remaining value, so the cost is proportional to the number of set values,
+not the number of bits:
+
+@snippet Containers.cpp EnumSet-iteration
+
+Note that if some of the enum values have more than one bit set, they're
+yielded as separate single-bit values. For sets with more than 64 values see
+@ref BigEnumSet.
+
+@see @ref enumSetDebugOutput(), @ref BigEnumSet
 */
 #ifdef DOXYGEN_GENERATING_OUTPUT
 template<class T, typename std::underlying_type<T>::type fullValue = typename std::underlying_type<T>::type(~0)>
@@ -84,6 +97,47 @@ class EnumSet {
             FullValue = fullValue /**< All enum values together */
         };
 
+        /**
+         * @brief Iterator over set values
+         * @m_since_latest
+         *
+         * @see @ref begin(), @ref end()
+         */
+        class Iterator {
+            public:
+                /** @brief Equality comparison */
+                constexpr bool operator==(const Iterator& other) const {
+                    return _value == other._value;
+                }
+
+                /** @brief Non-equality comparison */
+                constexpr bool operator!=(const Iterator& other) const {
+                    return _value != other._value;
+                }
+
+                /** @brief Value with the lowest bit of the remaining set */
+                constexpr T operator*() const {
+                    /* Two's complement negation isolates the lowest set
+                       bit */
+                    return T(UnderlyingType(Unsigned(_value & Unsigned(~_value + 1))));
+                }
+
+                /** @brief Advance to the next set value */
+                Iterator& operator++() {
+                    _value = Unsigned(_value & Unsigned(_value - 1));
+                    return *this;
+                }
+
+            private:
+                typedef typename std::make_unsigned<UnderlyingType>::type Unsigned;
+
+                friend EnumSet;
+
+                constexpr explicit Iterator(Unsigned value) noexcept: _value{value} {}
+
+                Unsigned _value;
+        };
+
         /** @brief Create empty set */
         constexpr /*implicit*/ EnumSet(): value() {}
 
@@ -173,6 +227,24 @@ class EnumSet {
             return value;
         }
 
+        /**
+         * @brief Iterator to the first set value
+         * @m_since_latest
+         *
+         * See @ref Containers-EnumSet-iteration for more information.
+         */
+        constexpr Iterator begin() const {
+            return Iterator{typename std::make_unsigned<UnderlyingType>::type(value)};
+        }
+
+        /**
+         * @brief Iterator to (one item after) the last set value
+         * @m_since_latest
+         */
+        constexpr Iterator end() const {
+            return Iterator{0};
+        }
+
     private:
         constexpr explicit EnumSet(UnderlyingType type): value(type) {}
 
@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Class @ref Corrade::Containers::ArrayAllocator, @ref Corrade::Containers::ArrayNewAllocator, @ref Corrade::Containers::ArrayMallocAllocator, function @ref Corrade::Containers::arrayAllocatorCast(), @ref Corrade::Containers::arrayIsGrowable(), @ref Corrade::Containers::arrayCapacity(), @ref Corrade::Containers::arrayReserve(), @ref Corrade::Containers::arrayResize(), @ref Corrade::Containers::arrayAppend(), @ref Corrade::Containers::arrayRemoveSuffix(), @ref Corrade::Containers::arrayShrink()
+ * @brief Class @ref Corrade::Containers::ArrayAllocator, @ref Corrade::Containers::ArrayNewAllocator, @ref Corrade::Containers::ArrayMallocAllocator, @ref Corrade::Containers::ArrayAlignedAllocator, @ref Corrade::Containers::ArrayGrowthAllocator, @ref Corrade::Containers::ArrayDefaultGrowth, @ref Corrade::Containers::ArrayFactorGrowth, @ref Corrade::Containers::ArrayPageRoundedGrowth, @ref Corrade::Containers::ArraySizeClassGrowth, @ref Corrade::Containers::ArrayCappedLinearGrowth, function @ref Corrade::Containers::arrayAllocatorCast(), @ref Corrade::Containers::arrayIsGrowable(), @ref Corrade::Containers::arrayCapacity(), @ref Corrade::Containers::arrayReserve(), @ref Corrade::Containers::arrayResize(), @ref Corrade::Containers::arrayAppend(), @ref Corrade::Containers::arrayInsert(), @ref Corrade::Containers::arrayRemove(), @ref Corrade::Containers::arrayRemoveUnordered(), @ref Corrade::Containers::arrayRemoveIf(), @ref Corrade::Containers::arrayRemoveSuffix(), @ref Corrade::Containers::arrayShrink()
  * @m_since_latest
  */
 
@@ -34,6 +34,7 @@
 #include <cstring>
 
 #include "Corrade/Containers/Array.h"
+#include "Corrade/Utility/Move.h"
 #include "Corrade/Utility/TypeTraits.h"
 
 /* No __has_feature on GCC: https://gcc.gnu.org/bugzilla/show_bug.cgi?id=60512
@@ -82,6 +83,9 @@ template<class T> struct ArrayNewAllocator {
     static T* allocate(std::size_t capacity) {
         char* memory = new char[capacity*sizeof(T) + sizeof(std::size_t)];
         reinterpret_cast<std::size_t*>(memory)[0] = capacity;
+        #ifdef CORRADE_CONTAINERS_TRACK_ALLOCATIONS
+        Implementation::trackAllocation(AllocationEvent::Allocate, memory + sizeof(std::size_t), nullptr, capacity*sizeof(T));
+        #endif
         return reinterpret_cast<T*>(memory + sizeof(std::size_t));
     }
 
@@ -102,6 +106,9 @@ template<class T> struct ArrayNewAllocator {
      * store its capacity.
      */
     static void deallocate(T* data) {
+        #ifdef CORRADE_CONTAINERS_TRACK_ALLOCATIONS
+        if(data) Implementation::trackAllocation(AllocationEvent::Deallocate, data, nullptr, capacity(data)*sizeof(T));
+        #endif
         delete[] (reinterpret_cast<char*>(data) - sizeof(std::size_t));
     }
 
@@ -175,9 +182,10 @@ template<class T> struct IsTriviallyCopyableOnOldGcc: std::integral_constant<boo
 
 An @ref ArrayAllocator that allocates and deallocates memory using the C
 @ref std::malloc() / @ref std::free() constructs in order to be able to use
-@ref std::realloc() for fast reallocations. Expects that @p T is trivially
-copyable. Similarly to @ref ArrayNewAllocator it's reserving an extra space
-*before* to store array capacity.
+@ref std::realloc() for fast reallocations. Expects that @p T is
+@ref Utility::IsTriviallyRelocatable "trivially relocatable", which includes
+all trivially copyable types. Similarly to @ref ArrayNewAllocator it's
+reserving an extra space *before* to store array capacity.
 
 Compared to @ref ArrayNewAllocator, this allocator stores array capacity in
 bytes and, together with the fact that @ref std::free() doesn't care about the
@@ -186,13 +194,8 @@ different compatible types using @ref arrayAllocatorCast().
 @see @ref Containers-Array-growable
 */
 template<class T> struct ArrayMallocAllocator {
-    static_assert(
-        #ifdef CORRADE_STD_IS_TRIVIALLY_TRAITS_SUPPORTED
-        std::is_trivially_copyable<T>::value
-        #else
-        Implementation::IsTriviallyCopyableOnOldGcc<T>::value
-        #endif
-        , "only trivially copyable types are usable with this allocator");
+    static_assert(Utility::IsTriviallyRelocatable<T>::value,
+        "only trivially relocatable types are usable with this allocator");
 
     typedef T Type; /**< Pointer type */
 
@@ -209,6 +212,11 @@ template<class T> struct ArrayMallocAllocator {
         const std::size_t inBytes = capacity*sizeof(T) + sizeof(std::size_t);
         char* const memory = static_cast<char*>(std::malloc(inBytes));
         reinterpret_cast<std::size_t*>(memory)[0] = inBytes;
+        #ifdef CORRADE_CONTAINERS_TRACK_ALLOCATIONS
+        /* Going through an integer as otherwise GCC 11+ complains about
+           passing uninitialized malloc()'d memory to a const void* */
+        Implementation::trackAllocation(AllocationEvent::Allocate, reinterpret_cast<const void*>(reinterpret_cast<std::size_t>(memory) + sizeof(std::size_t)), nullptr, capacity*sizeof(T));
+        #endif
         return reinterpret_cast<T*>(memory + sizeof(std::size_t));
     }
 
@@ -230,6 +238,9 @@ template<class T> struct ArrayMallocAllocator {
      * store its capacity.
      */
     static void deallocate(T* data) {
+        #ifdef CORRADE_CONTAINERS_TRACK_ALLOCATIONS
+        if(data) Implementation::trackAllocation(AllocationEvent::Deallocate, data, nullptr, capacity(data)*sizeof(T));
+        #endif
         if(data) std::free(reinterpret_cast<char*>(data) - sizeof(std::size_t));
     }
 
@@ -261,13 +272,253 @@ template<class T> struct ArrayMallocAllocator {
     /**
      * @brief Array deleter
      *
-     * Since the types have trivial destructors, directly delegates into
-     * @ref deallocate(). The @p size parameter is unused.
+     * Calls a destructor on @p size elements and then delegates into
+     * @ref deallocate(). For trivially destructible types the @p size
+     * parameter is unused.
+     */
+    static void deleter(T* data, std::size_t size);
+};
+
+namespace Implementation {
+    /* Stored right before the front of arrays allocated with
+       ArrayAlignedAllocator */
+    struct ArrayAlignedHeader {
+        void* memory;
+        std::size_t capacity;
+    };
+}
+
+/**
+@brief Aligned allocator for growable arrays
+@m_since_latest
+
+An @ref ArrayAllocator that aligns the front of the array to @p alignment
+bytes, which is useful for example for buffers processed with AVX
+instructions or for data that should be isolated in its own cache line. The
+memory is allocated using @ref std::malloc() with enough space to align the
+front and to store the original pointer and array capacity *before* it, so it
+doesn't depend on C++17 aligned @cpp new @ce. Elements are move-constructed on
+reallocation, meaning @p T is expected to be nothrow move-constructible.
+
+The @p alignment defaults to @cpp alignof(T) @ce and can't be less than that.
+@ref ArrayAllocator is aliased to this allocator for types that require a
+larger alignment than @ref ArrayNewAllocator and @ref ArrayMallocAllocator
+can guarantee. To get an aligned array of a type with a lower alignment, pick
+the allocator explicitly:
+
+@snippet Containers.cpp ArrayAlignedAllocator
+
+@see @ref Containers-Array-growable
+*/
+template<class T, std::size_t alignment = alignof(T)> struct ArrayAlignedAllocator {
+    static_assert(alignment && !(alignment & (alignment - 1)), "alignment has to be a power of two");
+    static_assert(alignment >= alignof(T), "alignment can't be less than alignment of the type");
+
+    typedef T Type; /**< Pointer type */
+
+    /**
+     * @brief Allocate (but not construct) an array of given capacity
+     *
+     * @ref std::malloc()'s a @cpp char @ce array large enough to fit
+     * @p capacity elements aligned to @p alignment and the original pointer
+     * and @p capacity *before* the front, returning the aligned front cast
+     * to @cpp T* @ce.
+     */
+    static T* allocate(std::size_t capacity);
+
+    /**
+     * @brief Reallocate an array to given capacity
+     *
+     * Calls @p allocate(), move-constructs @p prevSize elements from @p array
+     * into the new array, calls destructors on the original elements, calls
+     * @ref deallocate() and updates the @p array reference to point to the new
+     * array. Unlike with @ref ArrayMallocAllocator, @ref std::realloc() can't
+     * be used as it doesn't preserve the alignment.
+     */
+    static void reallocate(T*& array, std::size_t prevSize, std::size_t newCapacity);
+
+    /**
+     * @brief Deallocate an array
+     *
+     * Calls @ref std::free() on the original pointer stored before the front.
+     */
+    static void deallocate(T* data) {
+        #ifdef CORRADE_CONTAINERS_TRACK_ALLOCATIONS
+        if(data) Implementation::trackAllocation(AllocationEvent::Deallocate, data, nullptr, capacity(data)*sizeof(T));
+        #endif
+        if(data) std::free(header(data).memory);
+    }
+
+    /**
+     * @brief Grow the array
+     *
+     * Behaves the same as @ref ArrayNewAllocator::grow().
+     */
+    static std::size_t grow(T* array, std::size_t desired);
+
+    /**
+     * @brief Array capacity
+     *
+     * Retrieves the capacity that's stored *before* the front of the @p array.
+     */
+    static std::size_t capacity(T* array) {
+        return header(array).capacity;
+    }
+
+    /**
+     * @brief Array base address
+     *
+     * Returns the original pointer stored before the front of the @p array.
+     */
+    static void* base(T* array) {
+        return header(array).memory;
+    }
+
+    /**
+     * @brief Array deleter
+     *
+     * Calls a destructor on @p size elements and then delegates into
+     * @ref deallocate().
      */
     static void deleter(T* data, std::size_t size) {
-        static_cast<void>(size);
+        for(T *it = data, *end = data + size; it != end; ++it) it->~T();
         deallocate(data);
     }
+
+    private:
+        /* The header has to be aligned as well, so align to at least that */
+        enum: std::size_t {
+            Alignment = alignment > alignof(Implementation::ArrayAlignedHeader) ? alignment : alignof(Implementation::ArrayAlignedHeader)
+        };
+
+        static Implementation::ArrayAlignedHeader& header(T* array) {
+            return reinterpret_cast<Implementation::ArrayAlignedHeader*>(array)[-1];
+        }
+
+        /* Used by both allocate() and reallocate() so the latter is tracked
+           as a single event */
+        static T* allocateUntracked(std::size_t capacity);
+};
+
+/**
+@brief Default growth strategy for growable arrays
+@m_since_latest
+
+The strategy used by @ref ArrayNewAllocator::grow() and
+@ref ArrayMallocAllocator::grow(). See @ref ArrayNewAllocator::grow() for
+details. Growth strategies are plugged into an existing allocator using
+@ref ArrayGrowthAllocator.
+*/
+struct ArrayDefaultGrowth {
+    /**
+     * @brief Calculate grown capacity
+     * @param currentCapacity   Current capacity in elements, @cpp 0 @ce if
+     *      the array isn't allocated yet
+     * @param desiredCapacity   Capacity needed to fit the new elements
+     * @param sizeOfT           Size of a single element in bytes
+     *
+     * Returns a value that's at least @p desiredCapacity.
+     */
+    static std::size_t grow(std::size_t currentCapacity, std::size_t desiredCapacity, std::size_t sizeOfT);
+};
+
+/**
+@brief Growth strategy multiplying the capacity by a constant factor
+@m_since_latest
+
+Multiplies current capacity by @cpp numerator/denominator @ce, growing by at
+least one element. For example @cpp ArrayFactorGrowth<3, 2> @ce grows the
+capacity to 1.5x for all array sizes, not just for arrays above 64 bytes like
+@ref ArrayDefaultGrowth. Expects that @p numerator is larger than
+@p denominator.
+@see @ref ArrayGrowthAllocator
+*/
+template<std::size_t numerator, std::size_t denominator = 1> struct ArrayFactorGrowth {
+    static_assert(numerator > denominator, "the growth factor has to be larger than 1");
+
+    /** @copydoc ArrayDefaultGrowth::grow() */
+    static std::size_t grow(std::size_t currentCapacity, std::size_t desiredCapacity, std::size_t sizeOfT);
+};
+
+/**
+@brief Growth strategy rounding to whole memory pages
+@m_since_latest
+
+Behaves like @ref ArrayDefaultGrowth, but once the allocation (including the
+space needed to store capacity) reaches @p pageSize bytes, it's rounded up to
+a multiple of @p pageSize. Allocators usually serve such large allocations
+directly from the OS in whole pages, so this makes the extra memory usable
+instead of being wasted. Expects that @p pageSize is a power of two.
+@see @ref ArrayGrowthAllocator
+*/
+template<std::size_t pageSize = 4096> struct ArrayPageRoundedGrowth {
+    static_assert(pageSize && !(pageSize & (pageSize - 1)), "page size has to be a power of two");
+
+    /** @copydoc ArrayDefaultGrowth::grow() */
+    static std::size_t grow(std::size_t currentCapacity, std::size_t desiredCapacity, std::size_t sizeOfT);
+};
+
+/**
+@brief Growth strategy rounding to allocator size classes
+@m_since_latest
+
+Behaves like @ref ArrayDefaultGrowth, but the allocation size (including the
+space needed to store capacity) is rounded up to the nearest size class of
+allocators such as jemalloc --- multiples of 16 bytes up to 128 bytes and
+then four classes per power of two (160, 192, 224, 256, 320, ...). Memory
+that the allocator would have reserved anyway is thus made available to the
+array.
+@see @ref ArrayGrowthAllocator
+*/
+struct ArraySizeClassGrowth {
+    /** @copydoc ArrayDefaultGrowth::grow() */
+    static std::size_t grow(std::size_t currentCapacity, std::size_t desiredCapacity, std::size_t sizeOfT);
+};
+
+/**
+@brief Growth strategy switching to linear growth above a threshold
+@m_since_latest
+
+Behaves like @ref ArrayDefaultGrowth until the allocation reaches
+@p threshold bytes, after that the allocation is grown by @p threshold bytes
+every time. This bounds the amount of memory wasted by overallocation for
+very large arrays, at the cost of the amortized complexity of
+@ref arrayAppend() no longer being @f$ \mathcal{O}(1) @f$.
+@see @ref ArrayGrowthAllocator
+*/
+template<std::size_t threshold> struct ArrayCappedLinearGrowth {
+    static_assert(threshold, "threshold can't be zero");
+
+    /** @copydoc ArrayDefaultGrowth::grow() */
+    static std::size_t grow(std::size_t currentCapacity, std::size_t desiredCapacity, std::size_t sizeOfT);
+};
+
+/**
+@brief Allocator with a custom growth strategy
+@m_since_latest
+
+Derives from @p Allocator, replacing only its @ref ArrayAllocator::grow()
+with @p Growth, which is one of @ref ArrayDefaultGrowth,
+@ref ArrayFactorGrowth, @ref ArrayPageRoundedGrowth, @ref ArraySizeClassGrowth,
+@ref ArrayCappedLinearGrowth or a custom class with the same interface. As the
+deleter is inherited from @p Allocator, arrays stay growable when switching
+between the original allocator and variants of it with different growth
+strategies, so the strategy can be picked at each call site without any
+reallocation:
+
+@snippet Containers.cpp ArrayGrowthAllocator
+
+@see @ref Containers-Array-growable
+*/
+template<class Allocator, class Growth> struct ArrayGrowthAllocator: Allocator {
+    /**
+     * @brief Grow the array
+     *
+     * Delegates to @p Growth with current capacity of @p array.
+     */
+    static std::size_t grow(typename Allocator::Type* array, std::size_t desired) {
+        return Growth::grow(array ? Allocator::capacity(array) : 0, desired, sizeof(typename Allocator::Type));
+    }
 };
 
 #ifdef DOXYGEN_GENERATING_OUTPUT
@@ -275,8 +526,11 @@ template<class T> struct ArrayMallocAllocator {
 @brief Allocator for growable arrays
 @m_since_latest
 
-Is either @ref ArrayMallocAllocator for trivially copyable @p T, or
-@ref ArrayNewAllocator otherwise. See @ref Containers-Array-growable for an
+Is either @ref ArrayMallocAllocator for trivially copyable and
+@ref Utility::IsTriviallyRelocatable "trivially relocatable" @p T, or
+@ref ArrayNewAllocator otherwise. Types with alignment larger than
+@cpp sizeof(std::size_t) @ce, which the above two can't guarantee, use
+@ref ArrayAlignedAllocator instead. See @ref Containers-Array-growable for an
 introduction to growable arrays. You can provide your own allocator by
 implementing a class that with @ref Type, @ref allocate(), @ref reallocate(),
 @ref deallocate(), @ref grow(), @ref capacity(), @ref base() and @ref deleter()
@@ -356,13 +610,14 @@ template<class T> struct ArrayAllocator {
     static void deleter(T* data, std::size_t size);
 };
 #else
+/* The allocation base of ArrayNewAllocator and ArrayMallocAllocator is offset
+   by sizeof(std::size_t), which is thus the largest alignment they
+   guarantee */
 template<class T> using ArrayAllocator = typename std::conditional<
-    #ifdef CORRADE_STD_IS_TRIVIALLY_TRAITS_SUPPORTED
-    std::is_trivially_copyable<T>::value
-    #else
-    Implementation::IsTriviallyCopyableOnOldGcc<T>::value
-    #endif
-    , ArrayMallocAllocator<T>, ArrayNewAllocator<T>>::type;
+    (alignof(T) > sizeof(std::size_t)),
+    ArrayAlignedAllocator<T>,
+    typename std::conditional<Utility::IsTriviallyRelocatable<T>::value,
+        ArrayMallocAllocator<T>, ArrayNewAllocator<T>>::type>::type;
 #endif
 
 /**
@@ -370,7 +625,8 @@ template<class T> using ArrayAllocator = typename std::conditional<
 @m_since_latest
 
 If the array is growable using @ref ArrayMallocAllocator (which is aliased to
-@ref ArrayAllocator for all trivially-copyable types), the deleter is a simple
+@ref ArrayAllocator for all trivially-copyable types that aren't
+over-aligned), the deleter is a simple
 call to a typeless @ref std::free(). This makes it possible to change the array
 type without having to use a different deleter, losing the growable property in
 the process. Example usage:
@@ -408,7 +664,7 @@ template<class U, template<class> class Allocator, class T> Array<U> arrayAlloca
 }
 
 template<class U, class T> Array<U> arrayAllocatorCast(Array<T>&& array) {
-    return arrayAllocatorCast<U, ArrayAllocator, T>(std::move(array));
+    return arrayAllocatorCast<U, ArrayAllocator, T>(Utility::move(array));
 }
 
 /**
@@ -606,7 +862,7 @@ Convenience overload allowing to specify just the allocator template, with
 array type being inferred.
 */
 template<template<class> class Allocator, class T, class... Args> inline void arrayResize(Array<T>& array, DirectInitT, std::size_t size, Args&&... args) {
-    arrayResize<T, Allocator<T>>(array, DirectInit, size, std::forward<Args>(args)...);
+    arrayResize<T, Allocator<T>>(array, DirectInit, size, Utility::forward<Args>(args)...);
 }
 
 /**
@@ -656,7 +912,7 @@ Convenience overload allowing to specify just the allocator template, with
 array type being inferred.
 */
 template<template<class> class Allocator, class T, class... Args> inline void arrayAppend(Array<T>& array, InPlaceInitT, Args&&... args) {
-    arrayAppend<T, Allocator<T>>(array, InPlaceInit, std::forward<Args>(args)...);
+    arrayAppend<T, Allocator<T>>(array, InPlaceInit, Utility::forward<Args>(args)...);
 }
 
 /**
@@ -666,7 +922,7 @@ template<template<class> class Allocator, class T, class... Args> inline void ar
 Calls @ref arrayAppend(Array<T>&, InPlaceInitT, Args&&... args) with @p value.
 */
 template<class T, class Allocator = ArrayAllocator<T>> inline void arrayAppend(Array<T>& array, T&& value) {
-    arrayAppend<T, Allocator>(array, InPlaceInit, std::move(value));
+    arrayAppend<T, Allocator>(array, InPlaceInit, Utility::move(value));
 }
 
 /**
@@ -677,7 +933,7 @@ Convenience overload allowing to specify just the allocator template, with
 array type being inferred.
 */
 template<template<class> class Allocator, class T> inline void arrayAppend(Array<T>& array, T&& value) {
-    arrayAppend<T, Allocator<T>>(array, InPlaceInit, std::move(value));
+    arrayAppend<T, Allocator<T>>(array, InPlaceInit, Utility::move(value));
 }
 
 /**
@@ -718,6 +974,260 @@ template<template<class> class Allocator, class T> inline void arrayAppend(Array
     arrayAppend<T, Allocator<T>>(array, values);
 }
 
+/**
+@brief Append given count of uninitialized items to an array
+@m_since_latest
+
+Like @ref arrayAppend(Array<T>&, Containers::ArrayView<const T>), but instead
+of copying the values, the new @p count items are left uninitialized and a
+view on them is returned. The caller is then expected to construct them, for
+example by directly reading data from a file or a decoder into the view ---
+compared to @ref arrayResize(Array<T>&, ValueInitT, std::size_t) followed by a
+copy, the memory is touched only once. For non-trivial types the items have to
+be constructed using placement-new, otherwise the behavior is undefined.
+
+The returned view is valid only until the array is modified again.
+@see @ref arrayResize(Array<T>&, NoInitT, std::size_t),
+    @ref arrayInsert(Array<T>&, std::size_t, NoInitT, std::size_t)
+*/
+template<class T, class Allocator = ArrayAllocator<T>> ArrayView<T> arrayAppend(Array<T>& array, NoInitT, std::size_t count);
+
+/**
+@overload
+@m_since_latest
+
+Convenience overload allowing to specify just the allocator template, with
+array type being inferred.
+*/
+template<template<class> class Allocator, class T> inline ArrayView<T> arrayAppend(Array<T>& array, NoInitT, std::size_t count) {
+    return arrayAppend<T, Allocator<T>>(array, NoInit, count);
+}
+
+/**
+@brief Insert an item into an array
+@m_since_latest
+
+Expects that @p index is not larger than @ref Array::size(). If the array is
+not growable or the capacity is not large enough, the array capacity is grown
+first. Then, items starting at @p index are shifted one item forward --- for
+trivially copyable types using a single @ref std::memmove(), otherwise
+move-constructed --- and @p value is copy-constructed at @p index. The
+@p value is expected to not be a reference to an item of @p array.
+
+Complexity is @f$ \mathcal{O}(n) @f$ in the count of items after @p index,
+inserting at the end has the same complexity as @ref arrayAppend().
+@see @ref arrayCapacity(), @ref arrayIsGrowable(),
+    @ref Containers-Array-growable
+*/
+template<class T, class Allocator = ArrayAllocator<T>> void arrayInsert(Array<T>& array, std::size_t index, const T& value);
+
+/**
+@overload
+@m_since_latest
+
+Convenience overload allowing to specify just the allocator template, with
+array type being inferred.
+*/
+template<template<class> class Allocator, class T> inline void arrayInsert(Array<T>& array, std::size_t index, const T& value) {
+    arrayInsert<T, Allocator<T>>(array, index, value);
+}
+
+/**
+@brief In-place insert an item into an array
+@m_since_latest
+
+Similar to @ref arrayInsert(Array<T>&, std::size_t, const T&) except that the
+new element is constructed using placement-new with provided @p args.
+*/
+template<class T, class... Args> void arrayInsert(Array<T>& array, std::size_t index, InPlaceInitT, Args&&... args);
+
+/**
+@overload
+@m_since_latest
+*/
+template<class T, class Allocator, class... Args> void arrayInsert(Array<T>& array, std::size_t index, InPlaceInitT, Args&&... args);
+
+/**
+@overload
+@m_since_latest
+
+Convenience overload allowing to specify just the allocator template, with
+array type being inferred.
+*/
+template<template<class> class Allocator, class T, class... Args> inline void arrayInsert(Array<T>& array, std::size_t index, InPlaceInitT, Args&&... args) {
+    arrayInsert<T, Allocator<T>>(array, index, InPlaceInit, Utility::forward<Args>(args)...);
+}
+
+/**
+@brief Move-insert an item into an array
+@m_since_latest
+
+Calls @ref arrayInsert(Array<T>&, std::size_t, InPlaceInitT, Args&&... args)
+with @p value.
+*/
+template<class T, class Allocator = ArrayAllocator<T>> inline void arrayInsert(Array<T>& array, std::size_t index, T&& value) {
+    arrayInsert<T, Allocator>(array, index, InPlaceInit, Utility::move(value));
+}
+
+/**
+@overload
+@m_since_latest
+
+Convenience overload allowing to specify just the allocator template, with
+array type being inferred.
+*/
+template<template<class> class Allocator, class T> inline void arrayInsert(Array<T>& array, std::size_t index, T&& value) {
+    arrayInsert<T, Allocator<T>>(array, index, InPlaceInit, Utility::move(value));
+}
+
+/**
+@brief Insert a list of items into an array
+@m_since_latest
+
+Like @ref arrayInsert(Array<T>&, std::size_t, const T&), but inserting
+multiple values at once. The @p values are expected to not be a view on
+@p array.
+*/
+template<class T, class Allocator = ArrayAllocator<T>> void arrayInsert(Array<T>& array, std::size_t index, Containers::ArrayView<const T> values);
+
+/**
+@overload
+@m_since_latest
+
+Convenience overload allowing to specify just the allocator template, with
+array type being inferred.
+*/
+template<template<class> class Allocator, class T> inline void arrayInsert(Array<T>& array, std::size_t index, Containers::ArrayView<const T> values) {
+    arrayInsert<T, Allocator<T>>(array, index, values);
+}
+
+/**
+@overload
+@m_since_latest
+*/
+template<class T, class Allocator = ArrayAllocator<T>> void arrayInsert(Array<T>& array, std::size_t index, std::initializer_list<T> values);
+
+/**
+@overload
+@m_since_latest
+
+Convenience overload allowing to specify just the allocator template, with
+array type being inferred.
+*/
+template<template<class> class Allocator, class T> inline void arrayInsert(Array<T>& array, std::size_t index, std::initializer_list<T> values) {
+    arrayInsert<T, Allocator<T>>(array, index, values);
+}
+
+/**
+@brief Insert given count of uninitialized items into an array
+@m_since_latest
+
+Like @ref arrayInsert(Array<T>&, std::size_t, Containers::ArrayView<const T>),
+but the new @p count items are left uninitialized and a view on them is
+returned. See @ref arrayAppend(Array<T>&, NoInitT, std::size_t) for more
+information.
+*/
+template<class T, class Allocator = ArrayAllocator<T>> ArrayView<T> arrayInsert(Array<T>& array, std::size_t index, NoInitT, std::size_t count);
+
+/**
+@overload
+@m_since_latest
+
+Convenience overload allowing to specify just the allocator template, with
+array type being inferred.
+*/
+template<template<class> class Allocator, class T> inline ArrayView<T> arrayInsert(Array<T>& array, std::size_t index, NoInitT, std::size_t count) {
+    return arrayInsert<T, Allocator<T>>(array, index, NoInit, count);
+}
+
+/**
+@brief Remove an element from an array
+@m_since_latest
+
+Expects that @cpp index + count @ce is not larger than @ref Array::size(). If
+the array is not growable, all its elements except the removed ones are first
+reallocated to a growable version. Otherwise, a destructor is called on the
+removed elements, the elements after are shifted backward and
+@ref Array::size() is decreased by @p count. If @p T is trivially copyable or
+@ref Utility::IsTriviallyRelocatable "trivially relocatable", the shift is a
+single @ref std::memmove().
+
+Complexity is @f$ \mathcal{O}(n) @f$ in the size of the container. If the
+order of the remaining elements doesn't matter, use
+@ref arrayRemoveUnordered() instead, which is @f$ \mathcal{O}(m) @f$ in the
+removed element count.
+@see @ref arrayIsGrowable(), @ref arrayRemoveIf(), @ref arrayRemoveSuffix()
+*/
+template<class T, class Allocator = ArrayAllocator<T>> void arrayRemove(Array<T>& array, std::size_t index, std::size_t count = 1);
+
+/**
+@overload
+@m_since_latest
+
+Convenience overload allowing to specify just the allocator template, with
+array type being inferred.
+*/
+template<template<class> class Allocator, class T> inline void arrayRemove(Array<T>& array, std::size_t index, std::size_t count = 1) {
+    arrayRemove<T, Allocator<T>>(array, index, count);
+}
+
+/**
+@brief Remove an element from an unordered array
+@m_since_latest
+
+A faster alternative to @ref arrayRemove() that doesn't preserve the order of
+the remaining elements --- instead of shifting everything after the removed
+range, the gap is filled with the last @p count elements. Expects that
+@cpp index + count @ce is not larger than @ref Array::size(). If the array is
+not growable, it behaves the same as @ref arrayRemove(), reallocating the
+remaining elements to a growable version.
+
+Complexity is @f$ \mathcal{O}(m) @f$ in the removed element count,
+@f$ \mathcal{O}(n) @f$ if the array is not growable.
+@see @ref arrayIsGrowable(), @ref arrayRemoveSuffix()
+*/
+template<class T, class Allocator = ArrayAllocator<T>> void arrayRemoveUnordered(Array<T>& array, std::size_t index, std::size_t count = 1);
+
+/**
+@overload
+@m_since_latest
+
+Convenience overload allowing to specify just the allocator template, with
+array type being inferred.
+*/
+template<template<class> class Allocator, class T> inline void arrayRemoveUnordered(Array<T>& array, std::size_t index, std::size_t count = 1) {
+    arrayRemoveUnordered<T, Allocator<T>>(array, index, count);
+}
+
+/**
+@brief Remove elements matching a predicate from an array
+@return Count of removed elements
+@m_since_latest
+
+Calls @p predicate with a reference to each element and removes the elements
+for which it returned @cpp true @ce, preserving the order of the rest. The
+elements are compacted in a single pass, each kept element is moved at most
+once and the predicate is called exactly once for each element in order. If
+the array is not growable, the kept elements are moved to a growable version.
+Otherwise a destructor is called on the removed elements and
+@ref Array::size() is decreased by their count.
+
+Complexity is @f$ \mathcal{O}(n) @f$ in the size of the container.
+@see @ref arrayIsGrowable(), @ref arrayRemove()
+*/
+template<class T, class Allocator = ArrayAllocator<T>, class F> std::size_t arrayRemoveIf(Array<T>& array, F&& predicate);
+
+/**
+@overload
+@m_since_latest
+
+Convenience overload allowing to specify just the allocator template, with
+array type being inferred.
+*/
+template<template<class> class Allocator, class T, class F> inline std::size_t arrayRemoveIf(Array<T>& array, F&& predicate) {
+    return arrayRemoveIf<T, Allocator<T>>(array, Utility::forward<F>(predicate));
+}
+
 /**
 @brief Remove a suffix from the array
 @m_since_latest
@@ -841,7 +1351,7 @@ template<class T> inline void arrayMoveConstruct(T* src, T* dst, const std::size
     static_assert(std::is_nothrow_move_constructible<T>::value,
         "noexcept move-constructible type is required");
     for(T* end = src + count; src != end; ++src, ++dst)
-        new(dst) T{std::move(*src)};
+        new(dst) T{Utility::move(*src)};
 }
 
 template<class T> inline void arrayCopyConstruct(const T* const src, T* const dst, const std::size_t count, typename std::enable_if<
@@ -874,6 +1384,60 @@ template<class T> inline void arrayDestruct(T* begin, T* const end, typename std
     for(; begin < end; ++begin) begin->~T();
 }
 
+/* Moves count items from src to dst and destructs the originals, leaving src
+   uninitialized. The ranges can't overlap. */
+template<class T> inline void arrayRelocate(T* const src, T* const dst, const std::size_t count, typename std::enable_if<Utility::IsTriviallyRelocatable<T>::value>::type* = nullptr) {
+    /* The source can be null if count is zero, which memcpy() doesn't like */
+    if(count) std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), count*sizeof(T));
+}
+
+template<class T> inline void arrayRelocate(T* src, T* dst, const std::size_t count, typename std::enable_if<!Utility::IsTriviallyRelocatable<T>::value>::type* = nullptr) {
+    static_assert(std::is_nothrow_move_constructible<T>::value,
+        "noexcept move-constructible type is required");
+    for(T* end = src + count; src != end; ++src, ++dst) {
+        new(dst) T{Utility::move(*src)};
+        src->~T();
+    }
+}
+
+/* Moves count items from src to dst, with dst being after src. The ranges can
+   overlap, the area between src and dst is left uninitialized. */
+template<class T> inline void arrayShiftForward(T* const src, T* const dst, const std::size_t count, typename std::enable_if<Utility::IsTriviallyRelocatable<T>::value>::type* = nullptr) {
+    std::memmove(static_cast<void*>(dst), static_cast<const void*>(src), count*sizeof(T));
+}
+
+template<class T> inline void arrayShiftForward(T* const src, T* const dst, const std::size_t count, typename std::enable_if<!Utility::IsTriviallyRelocatable<T>::value>::type* = nullptr) {
+    static_assert(std::is_nothrow_move_constructible<T>::value,
+        "noexcept move-constructible type is required");
+    /* Going backwards so each destination is either past the original end or
+       an item that was already moved away and destructed */
+    for(T *s = src + count, *d = dst + count; s != src; ) {
+        --s; --d;
+        new(d) T{Utility::move(*s)};
+        s->~T();
+    }
+}
+
+/* Moves count items from src to dst, with dst being before src. The ranges
+   can overlap, the area between dst + count and src + count is left
+   uninitialized. */
+template<class T> inline void arrayShiftBackward(T* const src, T* const dst, const std::size_t count, typename std::enable_if<Utility::IsTriviallyRelocatable<T>::value>::type* = nullptr) {
+    /* The source can be null if count is zero, which memmove() doesn't
+       like */
+    if(count) std::memmove(static_cast<void*>(dst), static_cast<const void*>(src), count*sizeof(T));
+}
+
+template<class T> inline void arrayShiftBackward(T* src, T* dst, const std::size_t count, typename std::enable_if<!Utility::IsTriviallyRelocatable<T>::value>::type* = nullptr) {
+    static_assert(std::is_nothrow_move_constructible<T>::value,
+        "noexcept move-constructible type is required");
+    /* Going forward so each destination is either before the original
+       begin or an item that was already moved away and destructed */
+    for(T* end = src + count; src != end; ++src, ++dst) {
+        new(dst) T{Utility::move(*src)};
+        src->~T();
+    }
+}
+
 inline std::size_t arrayGrowth(const std::size_t currentCapacity, const std::size_t desiredCapacity, const std::size_t sizeOfT) {
     /** @todo pick a nice value when current = 0 and desired > 1 */
     const std::size_t currentCapacityInBytes = sizeOfT*currentCapacity + sizeof(std::size_t);
@@ -906,14 +1470,55 @@ inline std::size_t arrayGrowth(const std::size_t currentCapacity, const std::siz
 
 }
 
+inline std::size_t ArrayDefaultGrowth::grow(const std::size_t currentCapacity, const std::size_t desiredCapacity, const std::size_t sizeOfT) {
+    return Implementation::arrayGrowth(currentCapacity, desiredCapacity, sizeOfT);
+}
+
+template<std::size_t numerator, std::size_t denominator> std::size_t ArrayFactorGrowth<numerator, denominator>::grow(const std::size_t currentCapacity, const std::size_t desiredCapacity, std::size_t) {
+    std::size_t candidate = currentCapacity*numerator/denominator;
+    if(candidate == currentCapacity) ++candidate;
+    return desiredCapacity > candidate ? desiredCapacity : candidate;
+}
+
+template<std::size_t pageSize> std::size_t ArrayPageRoundedGrowth<pageSize>::grow(const std::size_t currentCapacity, const std::size_t desiredCapacity, const std::size_t sizeOfT) {
+    const std::size_t inBytes = Implementation::arrayGrowth(currentCapacity, desiredCapacity, sizeOfT)*sizeOfT + sizeof(std::size_t);
+    if(inBytes < pageSize) return (inBytes - sizeof(std::size_t))/sizeOfT;
+    return (((inBytes + pageSize - 1) & ~(pageSize - 1)) - sizeof(std::size_t))/sizeOfT;
+}
+
+inline std::size_t ArraySizeClassGrowth::grow(const std::size_t currentCapacity, const std::size_t desiredCapacity, const std::size_t sizeOfT) {
+    const std::size_t inBytes = Implementation::arrayGrowth(currentCapacity, desiredCapacity, sizeOfT)*sizeOfT + sizeof(std::size_t);
+
+    /* Size classes in the (2^n, 2^(n + 1)] range are spaced by 2^(n - 2)
+       bytes, but at least 16 bytes */
+    std::size_t spacing = 16;
+    for(std::size_t power = 128; inBytes > power; power *= 2) {
+        spacing = power/4;
+        if(power > ~std::size_t{}/2) break;
+    }
+    return (((inBytes + spacing - 1)/spacing*spacing) - sizeof(std::size_t))/sizeOfT;
+}
+
+template<std::size_t threshold> std::size_t ArrayCappedLinearGrowth<threshold>::grow(const std::size_t currentCapacity, const std::size_t desiredCapacity, const std::size_t sizeOfT) {
+    const std::size_t currentCapacityInBytes = sizeOfT*currentCapacity + sizeof(std::size_t);
+    if(currentCapacityInBytes < threshold)
+        return Implementation::arrayGrowth(currentCapacity, desiredCapacity, sizeOfT);
+
+    const std::size_t candidate = (currentCapacityInBytes + threshold - sizeof(std::size_t))/sizeOfT;
+    return desiredCapacity > candidate ? desiredCapacity : candidate;
+}
+
 template<class T> void ArrayNewAllocator<T>::reallocate(T*& array, const std::size_t prevSize, const std::size_t newCapacity) {
-    T* newArray = allocate(newCapacity);
-    static_assert(std::is_nothrow_move_constructible<T>::value,
-        "noexcept move-constructibe type is required");
-    for(T *src = array, *end = src + prevSize, *dst = newArray; src != end; ++src, ++dst)
-        new(dst) T{std::move(*src)};
-    for(T *it = array, *end = array + prevSize; it < end; ++it) it->~T();
-    deallocate(array);
+    /* Not delegating to allocate() and deallocate() so the allocation
+       tracking sees a single reallocation instead of two events */
+    char* const memory = new char[newCapacity*sizeof(T) + sizeof(std::size_t)];
+    reinterpret_cast<std::size_t*>(memory)[0] = newCapacity;
+    T* newArray = reinterpret_cast<T*>(memory + sizeof(std::size_t));
+    Implementation::arrayRelocate<T>(array, newArray, prevSize);
+    #ifdef CORRADE_CONTAINERS_TRACK_ALLOCATIONS
+    Implementation::trackAllocation(AllocationEvent::Reallocate, newArray, array, newCapacity*sizeof(T));
+    #endif
+    delete[] (reinterpret_cast<char*>(array) - sizeof(std::size_t));
     array = newArray;
 }
 
@@ -921,15 +1526,54 @@ template<class T> void ArrayMallocAllocator<T>::reallocate(T*& array, std::size_
     const std::size_t inBytes = newCapacity*sizeof(T) + sizeof(std::size_t);
     char* const memory = static_cast<char*>(std::realloc(reinterpret_cast<char*>(array) - sizeof(std::size_t), inBytes));
     reinterpret_cast<std::size_t*>(memory)[0] = inBytes;
+    #ifdef CORRADE_CONTAINERS_TRACK_ALLOCATIONS
+    Implementation::trackAllocation(AllocationEvent::Reallocate, memory + sizeof(std::size_t), array, newCapacity*sizeof(T));
+    #endif
     array = reinterpret_cast<T*>(memory + sizeof(std::size_t));
 }
 
+template<class T> void ArrayMallocAllocator<T>::deleter(T* const data, const std::size_t size) {
+    Implementation::arrayDestruct<T>(data, data + size);
+    deallocate(data);
+}
+
 template<class T> std::size_t ArrayNewAllocator<T>::grow(T* const array, const std::size_t desiredCapacity) {
-    return Implementation::arrayGrowth(array ? capacity(array) : 0, desiredCapacity, sizeof(T));
+    return ArrayDefaultGrowth::grow(array ? capacity(array) : 0, desiredCapacity, sizeof(T));
 }
 
 template<class T> std::size_t ArrayMallocAllocator<T>::grow(T* const array, const std::size_t desiredCapacity) {
-    return Implementation::arrayGrowth(array ? capacity(array) : 0, desiredCapacity, sizeof(T));
+    return ArrayDefaultGrowth::grow(array ? capacity(array) : 0, desiredCapacity, sizeof(T));
+}
+
+template<class T, std::size_t alignment> T* ArrayAlignedAllocator<T, alignment>::allocate(const std::size_t capacity) {
+    T* const array = allocateUntracked(capacity);
+    #ifdef CORRADE_CONTAINERS_TRACK_ALLOCATIONS
+    Implementation::trackAllocation(AllocationEvent::Allocate, array, nullptr, capacity*sizeof(T));
+    #endif
+    return array;
+}
+
+template<class T, std::size_t alignment> T* ArrayAlignedAllocator<T, alignment>::allocateUntracked(const std::size_t capacity) {
+    /* Space for the header and for moving the front to the next aligned
+       address */
+    char* const memory = static_cast<char*>(std::malloc(capacity*sizeof(T) + sizeof(Implementation::ArrayAlignedHeader) + Alignment - 1));
+    T* const array = reinterpret_cast<T*>((reinterpret_cast<std::size_t>(memory) + sizeof(Implementation::ArrayAlignedHeader) + Alignment - 1) & ~std::size_t(Alignment - 1));
+    header(array) = Implementation::ArrayAlignedHeader{memory, capacity};
+    return array;
+}
+
+template<class T, std::size_t alignment> void ArrayAlignedAllocator<T, alignment>::reallocate(T*& array, const std::size_t prevSize, const std::size_t newCapacity) {
+    T* newArray = allocateUntracked(newCapacity);
+    Implementation::arrayRelocate<T>(array, newArray, prevSize);
+    #ifdef CORRADE_CONTAINERS_TRACK_ALLOCATIONS
+    Implementation::trackAllocation(AllocationEvent::Reallocate, newArray, array, newCapacity*sizeof(T));
+    #endif
+    std::free(header(array).memory);
+    array = newArray;
+}
+
+template<class T, std::size_t alignment> std::size_t ArrayAlignedAllocator<T, alignment>::grow(T* const array, const std::size_t desiredCapacity) {
+    return ArrayDefaultGrowth::grow(array ? capacity(array) : 0, desiredCapacity, sizeof(T));
 }
 
 template<class T, class Allocator> bool arrayIsGrowable(Array<T>& array) {
@@ -1060,11 +1704,11 @@ template<class T, class Allocator, class... Args> void arrayResize(Array<T>& arr
     /* In-place construct the new elements. No helper function for this as
        there's no way we could memcpy such a thing. */
     for(T* it = array + prevSize; it < array.end(); ++it)
-        new(it) T{std::forward<Args>(args)...};
+        new(it) T{Utility::forward<Args>(args)...};
 }
 
 template<class T, class... Args> inline void arrayResize(Array<T>& array, DirectInitT, const std::size_t size, Args&&... args) {
-    arrayResize<T, ArrayAllocator<T>, Args...>(array, DirectInit, size, std::forward<Args>(args)...);
+    arrayResize<T, ArrayAllocator<T>, Args...>(array, DirectInit, size, Utility::forward<Args>(args)...);
 }
 
 namespace Implementation {
@@ -1103,7 +1747,7 @@ template<class T, class Allocator> inline void arrayAppend(Array<T>& array, cons
 }
 
 template<class T, class Allocator> inline void arrayAppend(Array<T>& array, const std::initializer_list<T> values) {
-    arrayAppend(array, {values.begin(), values.size()});
+    arrayAppend<T, Allocator>(array, Containers::ArrayView<const T>{values.begin(), values.size()});
 }
 
 template<class T, class Allocator> inline void arrayAppend(Array<T>& array, const Containers::ArrayView<const T> values) {
@@ -1149,11 +1793,229 @@ template<class T, class Allocator, class... Args> void arrayAppend(Array<T>& arr
     #endif
     ++arrayGuts.size;
     /* No helper function as there's no way we could memcpy such a thing. */
-    new(it) T{std::forward<Args>(args)...};
+    new(it) T{Utility::forward<Args>(args)...};
 }
 
 template<class T, class... Args> inline void arrayAppend(Array<T>& array, InPlaceInitT, Args&&... args) {
-    return arrayAppend<T, ArrayAllocator<T>>(array, InPlaceInit, std::forward<Args>(args)...);
+    return arrayAppend<T, ArrayAllocator<T>>(array, InPlaceInit, Utility::forward<Args>(args)...);
+}
+
+template<class T, class Allocator> ArrayView<T> arrayAppend(Array<T>& array, NoInitT, const std::size_t count) {
+    /* Direct access to speed up debug builds */
+    auto& arrayGuts = reinterpret_cast<Implementation::ArrayGuts<T>&>(array);
+
+    /* If we don't have our own deleter or there's no space anymore,
+       reallocate */
+    if(arrayGuts.deleter != Allocator::deleter || arrayGuts.size + count > Allocator::capacity(arrayGuts.data))
+        Implementation::arrayGrow<T, Allocator>(array, arrayGuts.size + count);
+
+    /* Increase array size and return the non-initialized slice */
+    T* const it = arrayGuts.data + arrayGuts.size;
+    #ifdef _CORRADE_CONTAINERS_SANITIZER_ENABLED
+    __sanitizer_annotate_contiguous_container(
+        Allocator::base(arrayGuts.data),
+        arrayGuts.data + Allocator::capacity(arrayGuts.data),
+        arrayGuts.data + arrayGuts.size,
+        arrayGuts.data + arrayGuts.size + count);
+    #endif
+    arrayGuts.size += count;
+    return {it, count};
+}
+
+namespace Implementation {
+
+/* Grows the array by count items and shifts everything from index forward,
+   returning a pointer to the non-initialized gap */
+template<class T, class Allocator> T* arrayInsertGap(Array<T>& array, const std::size_t index, const std::size_t count) {
+    /* Direct access to speed up debug builds */
+    auto& arrayGuts = reinterpret_cast<Implementation::ArrayGuts<T>&>(array);
+
+    /* If we don't have our own deleter or there's no space anymore,
+       reallocate */
+    if(arrayGuts.deleter != Allocator::deleter || arrayGuts.size + count > Allocator::capacity(arrayGuts.data))
+        Implementation::arrayGrow<T, Allocator>(array, arrayGuts.size + count);
+
+    /* Make the new items accessible first so the shift doesn't trip the
+       sanitizer, then move the suffix forward */
+    T* const it = arrayGuts.data + index;
+    #ifdef _CORRADE_CONTAINERS_SANITIZER_ENABLED
+    __sanitizer_annotate_contiguous_container(
+        Allocator::base(arrayGuts.data),
+        arrayGuts.data + Allocator::capacity(arrayGuts.data),
+        arrayGuts.data + arrayGuts.size,
+        arrayGuts.data + arrayGuts.size + count);
+    #endif
+    Implementation::arrayShiftForward<T>(it, it + count, arrayGuts.size - index);
+    arrayGuts.size += count;
+    return it;
+}
+
+}
+
+template<class T, class Allocator> inline void arrayInsert(Array<T>& array, const std::size_t index, const T& value) {
+    arrayInsert<T, Allocator>(array, index, InPlaceInit, value);
+}
+
+template<class T, class Allocator, class... Args> void arrayInsert(Array<T>& array, const std::size_t index, InPlaceInitT, Args&&... args) {
+    CORRADE_ASSERT(index <= array.size(), "Containers::arrayInsert(): can't insert at index" << index << "into an array of size" << array.size(), );
+    T* const it = Implementation::arrayInsertGap<T, Allocator>(array, index, 1);
+    /* No helper function as there's no way we could memcpy such a thing. */
+    new(it) T{Utility::forward<Args>(args)...};
+}
+
+template<class T, class... Args> inline void arrayInsert(Array<T>& array, const std::size_t index, InPlaceInitT, Args&&... args) {
+    arrayInsert<T, ArrayAllocator<T>>(array, index, InPlaceInit, Utility::forward<Args>(args)...);
+}
+
+template<class T, class Allocator> void arrayInsert(Array<T>& array, const std::size_t index, const Containers::ArrayView<const T> values) {
+    CORRADE_ASSERT(index <= array.size(), "Containers::arrayInsert(): can't insert at index" << index << "into an array of size" << array.size(), );
+    T* const it = Implementation::arrayInsertGap<T, Allocator>(array, index, values.size());
+    Implementation::arrayCopyConstruct<T>(values.data(), it, values.size());
+}
+
+template<class T, class Allocator> inline void arrayInsert(Array<T>& array, const std::size_t index, const std::initializer_list<T> values) {
+    arrayInsert<T, Allocator>(array, index, Containers::ArrayView<const T>{values.begin(), values.size()});
+}
+
+template<class T, class Allocator> ArrayView<T> arrayInsert(Array<T>& array, const std::size_t index, NoInitT, const std::size_t count) {
+    CORRADE_ASSERT(index <= array.size(), "Containers::arrayInsert(): can't insert at index" << index << "into an array of size" << array.size(), {});
+    return {Implementation::arrayInsertGap<T, Allocator>(array, index, count), count};
+}
+
+namespace Implementation {
+
+/* Moves everything except count items at index to a new growable
+   allocation */
+template<class T, class Allocator> void arrayRemoveNonGrowable(Array<T>& array, const std::size_t index, const std::size_t count) {
+    auto& arrayGuts = reinterpret_cast<Implementation::ArrayGuts<T>&>(array);
+    const std::size_t newSize = arrayGuts.size - count;
+    T* const newArray = Allocator::allocate(newSize);
+    Implementation::arrayMoveConstruct<T>(arrayGuts.data, newArray, index);
+    Implementation::arrayMoveConstruct<T>(arrayGuts.data + index + count, newArray + index, newSize - index);
+    array = Array<T>{newArray, newSize, Allocator::deleter};
+
+    #ifdef _CORRADE_CONTAINERS_SANITIZER_ENABLED
+    std::size_t capacity = Allocator::capacity(arrayGuts.data);
+    __sanitizer_annotate_contiguous_container(
+        Allocator::base(arrayGuts.data),
+        arrayGuts.data + capacity,
+        arrayGuts.data + capacity, /* ASan assumes this for new allocations */
+        arrayGuts.data + arrayGuts.size);
+    #endif
+}
+
+/* Shrinks the size of a growable array by count, assuming the items past the
+   new end are already destructed */
+template<class T, class Allocator> inline void arrayShrinkSize(Array<T>& array, const std::size_t count) {
+    auto& arrayGuts = reinterpret_cast<Implementation::ArrayGuts<T>&>(array);
+    #ifdef _CORRADE_CONTAINERS_SANITIZER_ENABLED
+    __sanitizer_annotate_contiguous_container(
+        Allocator::base(arrayGuts.data),
+        arrayGuts.data + Allocator::capacity(arrayGuts.data),
+        arrayGuts.data + arrayGuts.size,
+        arrayGuts.data + arrayGuts.size - count);
+    #endif
+    arrayGuts.size -= count;
+}
+
+}
+
+template<class T, class Allocator> void arrayRemove(Array<T>& array, const std::size_t index, const std::size_t count) {
+    /* Direct access to speed up debug builds */
+    auto& arrayGuts = reinterpret_cast<Implementation::ArrayGuts<T>&>(array);
+    CORRADE_ASSERT(index + count <= arrayGuts.size, "Containers::arrayRemove(): can't remove" << count << "elements at index" << index << "from an array of size" << arrayGuts.size, );
+
+    /* Nothing to remove, yay! */
+    if(!count) return;
+
+    /* If we don't have our own deleter, we need to reallocate in order to
+       store the capacity. That'll also cause the removed elements to be
+       properly destructed, so nothing else needs to be done. */
+    if(arrayGuts.deleter != Allocator::deleter)
+        Implementation::arrayRemoveNonGrowable<T, Allocator>(array, index, count);
+
+    /* Otherwise call the destructor on the removed elements, shift the rest
+       backward and update the size */
+    else {
+        T* const it = arrayGuts.data + index;
+        Implementation::arrayDestruct<T>(it, it + count);
+        Implementation::arrayShiftBackward<T>(it + count, it, arrayGuts.size - index - count);
+        Implementation::arrayShrinkSize<T, Allocator>(array, count);
+    }
+}
+
+template<class T, class Allocator> void arrayRemoveUnordered(Array<T>& array, const std::size_t index, const std::size_t count) {
+    /* Direct access to speed up debug builds */
+    auto& arrayGuts = reinterpret_cast<Implementation::ArrayGuts<T>&>(array);
+    CORRADE_ASSERT(index + count <= arrayGuts.size, "Containers::arrayRemoveUnordered(): can't remove" << count << "elements at index" << index << "from an array of size" << arrayGuts.size, );
+
+    /* Nothing to remove, yay! */
+    if(!count) return;
+
+    /* If we don't have our own deleter, we need to reallocate in order to
+       store the capacity. That'll also cause the removed elements to be
+       properly destructed, so nothing else needs to be done. */
+    if(arrayGuts.deleter != Allocator::deleter)
+        Implementation::arrayRemoveNonGrowable<T, Allocator>(array, index, count);
+
+    /* Otherwise call the destructor on the removed elements, fill the gap
+       with elements from the end and update the size. If there's less
+       elements after the removed range than its size, only those get
+       moved. The ranges never overlap. */
+    else {
+        T* const it = arrayGuts.data + index;
+        const std::size_t after = arrayGuts.size - index - count;
+        const std::size_t moveCount = after < count ? after : count;
+        Implementation::arrayDestruct<T>(it, it + count);
+        Implementation::arrayRelocate<T>(arrayGuts.data + arrayGuts.size - moveCount, it, moveCount);
+        Implementation::arrayShrinkSize<T, Allocator>(array, count);
+    }
+}
+
+template<class T, class Allocator, class F> std::size_t arrayRemoveIf(Array<T>& array, F&& predicate) {
+    /* Direct access to speed up debug builds */
+    auto& arrayGuts = reinterpret_cast<Implementation::ArrayGuts<T>&>(array);
+
+    /* If we don't have our own deleter, move the kept elements to a new
+       growable allocation. The original array then destructs all its
+       elements, so nothing else needs to be done. Allocating the original
+       size to not need to call the predicate twice. */
+    if(arrayGuts.deleter != Allocator::deleter) {
+        T* const newArray = Allocator::allocate(arrayGuts.size);
+        std::size_t newSize = 0;
+        for(T *it = arrayGuts.data, *end = arrayGuts.data + arrayGuts.size; it != end; ++it)
+            if(!predicate(*it))
+                Implementation::arrayMoveConstruct<T>(it, newArray + newSize++, 1);
+        const std::size_t removed = arrayGuts.size - newSize;
+        array = Array<T>{newArray, newSize, Allocator::deleter};
+
+        #ifdef _CORRADE_CONTAINERS_SANITIZER_ENABLED
+        std::size_t capacity = Allocator::capacity(arrayGuts.data);
+        __sanitizer_annotate_contiguous_container(
+            Allocator::base(arrayGuts.data),
+            arrayGuts.data + capacity,
+            arrayGuts.data + capacity, /* ASan assumes this for new allocations */
+            arrayGuts.data + arrayGuts.size);
+        #endif
+
+        return removed;
+    }
+
+    /* Otherwise destruct the removed elements and compact the kept ones in
+       a single pass, moving each at most once */
+    T* out = arrayGuts.data;
+    for(T *it = arrayGuts.data, *end = arrayGuts.data + arrayGuts.size; it != end; ++it) {
+        if(predicate(*it)) {
+            Implementation::arrayDestruct<T>(it, it + 1);
+            continue;
+        }
+        if(out != it) Implementation::arrayRelocate<T>(it, out, 1);
+        ++out;
+    }
+
+    const std::size_t removed = arrayGuts.data + arrayGuts.size - out;
+    Implementation::arrayShrinkSize<T, Allocator>(array, removed);
+    return removed;
 }
 
 template<class T, class Allocator> void arrayRemoveSuffix(Array<T>& array, const std::size_t count) {
@@ -1211,7 +2073,7 @@ template<class T, class Allocator> void arrayShrink(Array<T>& array) {
        common deleters to avoid surprises */
     Array<T> newArray{NoInit, arrayGuts.size};
     Implementation::arrayMoveConstruct<T>(arrayGuts.data, newArray, arrayGuts.size);
-    array = std::move(newArray);
+    array = Utility::move(newArray);
 
     #ifdef _CORRADE_CONTAINERS_SANITIZER_ENABLED
     /* Nothing to do (not annotating the arrays with default deleter) */
@@ -0,0 +1,588 @@
+#ifndef Corrade_Containers_HashMap_h
+#define Corrade_Containers_HashMap_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Containers::HashMap, @ref Corrade::Containers::HashMapEntry, struct @ref Corrade::Containers::HashMapHash
+ * @m_since_latest
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "Corrade/Containers/GrowableArray.h"
+#include "Corrade/Containers/StringView.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
+#ifdef CORRADE_TARGET_MSVC
+#include <intrin.h>
+#endif
+
+namespace Corrade { namespace Containers {
+
+namespace Implementation {
+    /* Probing is done over groups of 16 control bytes, which is exactly one
+       SSE2 register. An empty slot has only the highest bit set, a deleted
+       slot (tombstone) has all bits except the lowest set and a full slot has
+       the highest bit cleared and lower 7 bits of the key hash in the rest. */
+    enum: std::size_t { HashMapGroupSize = 16 };
+    enum: std::uint8_t {
+        HashMapControlEmpty = 0x80,
+        HashMapControlDeleted = 0xfe
+    };
+
+    /* Finalizer from MurmurHash3, spreads all input bits over the output */
+    inline std::uint64_t hashMapMix(std::uint64_t value) {
+        value ^= value >> 33;
+        value *= 0xff51afd7ed558ccdull;
+        value ^= value >> 33;
+        value *= 0xc4ceb9fe1a85ec53ull;
+        value ^= value >> 33;
+        return value;
+    }
+
+    /* Processes eight bytes at a time, the tail is zero-padded. Not meant to
+       be cryptographically strong or stable across versions. */
+    inline std::size_t hashMapHashBytes(const char* data, std::size_t size) {
+        std::uint64_t hash = 0x9e3779b97f4a7c15ull ^ (size*0xc4ceb9fe1a85ec53ull);
+        for(; size >= 8; data += 8, size -= 8) {
+            std::uint64_t chunk;
+            std::memcpy(&chunk, data, 8);
+            hash = (hash ^ hashMapMix(chunk))*0x9e3779b97f4a7c15ull;
+        }
+        std::uint64_t tail = 0;
+        std::memcpy(&tail, data, size);
+        return std::size_t(hashMapMix(hash ^ tail));
+    }
+
+    /* Bitmask of bytes in a group that are equal to given value */
+    inline unsigned int hashMapGroupMatch(const std::uint8_t* const group, const std::uint8_t value) {
+        #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(group)),
+            _mm_set1_epi8(char(value))));
+        #else
+        unsigned int mask = 0;
+        for(std::size_t i = 0; i != HashMapGroupSize; ++i)
+            if(group[i] == value) mask |= 1u << i;
+        return mask;
+        #endif
+    }
+
+    /* Bitmask of bytes in a group that are empty or deleted, i.e. have the
+       highest bit set */
+    inline unsigned int hashMapGroupMatchFree(const std::uint8_t* const group) {
+        #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        return _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(group)));
+        #else
+        unsigned int mask = 0;
+        for(std::size_t i = 0; i != HashMapGroupSize; ++i)
+            if(group[i] & 0x80) mask |= 1u << i;
+        return mask;
+        #endif
+    }
+
+    inline unsigned int hashMapLowestSetBit(const unsigned int value) {
+        #ifdef CORRADE_TARGET_MSVC
+        unsigned long index;
+        _BitScanForward(&index, value);
+        return index;
+        #else
+        return __builtin_ctz(value);
+        #endif
+    }
+
+    /* Type used for looking up keys. Owning strings are looked up by a
+       view so the lookup doesn't need to allocate. */
+    template<class K> struct HashMapLookup { typedef const K& Type; };
+    template<> struct HashMapLookup<String> { typedef StringView Type; };
+}
+
+/**
+@brief Default hash function for @ref HashMap
+@m_since_latest
+
+Specialized for integer, enum and pointer types, for which it calculates a
+MurmurHash3 finalizer of the value, and for @ref String and @ref StringView,
+for which it hashes the string contents. Hashes of @ref String and
+@ref StringView are equal for equal contents, making it possible to look up
+@ref String keys by a @ref StringView. The hash isn't guaranteed to be stable
+across versions and shouldn't be serialized. For other key types, provide a
+specialization or pass a custom hash function to the @ref HashMap template.
+*/
+#ifdef DOXYGEN_GENERATING_OUTPUT
+template<class T> struct HashMapHash {
+    /** @brief Hash a value */
+    std::size_t operator()(const T& value) const;
+};
+#else
+template<class T> struct HashMapHash<T, typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type> {
+    std::size_t operator()(const T value) const {
+        return std::size_t(Implementation::hashMapMix(std::uint64_t(value)));
+    }
+};
+template<class T> struct HashMapHash<T*> {
+    std::size_t operator()(const T* const value) const {
+        return std::size_t(Implementation::hashMapMix(reinterpret_cast<std::uintptr_t>(value)));
+    }
+};
+template<> struct HashMapHash<StringView> {
+    std::size_t operator()(const StringView value) const {
+        return Implementation::hashMapHashBytes(value.data(), value.size());
+    }
+};
+template<> struct HashMapHash<String>: HashMapHash<StringView> {};
+#endif
+
+/**
+@brief Hash map entry
+@m_since_latest
+
+Key/value pair stored in a @ref HashMap, returned when iterating it. The key
+is immutable, the value can be modified.
+*/
+template<class K, class V> class HashMapEntry {
+    public:
+        /** @brief Key */
+        const K& key() const { return _key; }
+
+        /** @brief Value */
+        V& value() { return _value; }
+        const V& value() const { return _value; } /**< @overload */
+
+    private:
+        template<class, class, class> friend class HashMap;
+
+        template<class KK, class VV> explicit HashMapEntry(KK&& key, VV&& value): _key(std::forward<KK>(key)), _value(std::forward<VV>(value)) {}
+
+        K _key;
+        V _value;
+};
+
+/**
+@brief Hash map iterator
+@m_since_latest
+
+Iterates over full slots of a @ref HashMap, skipping empty and deleted ones.
+@see @ref HashMap::begin(), @ref HashMap::end()
+*/
+template<class T> class HashMapIterator {
+    public:
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        /*implicit*/ HashMapIterator(const std::uint8_t* control, T* entry, T* end) noexcept: _control{control}, _entry{entry}, _end{end} {
+            skip();
+        }
+        #endif
+
+        /** @brief Equality comparison */
+        bool operator==(const HashMapIterator<T>& other) const {
+            return _entry == other._entry;
+        }
+
+        /** @brief Non-equality comparison */
+        bool operator!=(const HashMapIterator<T>& other) const {
+            return _entry != other._entry;
+        }
+
+        /** @brief Advance to the next entry */
+        HashMapIterator<T>& operator++() {
+            ++_control;
+            ++_entry;
+            skip();
+            return *this;
+        }
+
+        /** @brief Dereference */
+        T& operator*() const { return *_entry; }
+
+        /** @brief Dereference */
+        T* operator->() const { return _entry; }
+
+    private:
+        void skip() {
+            while(_entry != _end && (*_control & 0x80)) {
+                ++_control;
+                ++_entry;
+            }
+        }
+
+        const std::uint8_t* _control;
+        T* _entry;
+        T* _end;
+};
+
+/**
+@brief Open-addressing hash map
+@m_since_latest
+
+@tparam K       Key type
+@tparam V       Value type
+@tparam Hash    Hash function. Defaults to @ref HashMapHash.
+
+An unordered associative container storing keys and values inline in a
+single contiguous allocation, as opposed to @ref std::unordered_map, which
+allocates each element separately. Lookup compares a vector of 16 one-byte
+control values at once --- on x86 with SSE2 a single instruction --- and only
+touches the actual keys whose seven lowest hash bits matched, so a lookup
+usually costs one hash calculation, one control group load and one key
+comparison.
+
+@snippet Containers.cpp HashMap
+
+@section Containers-HashMap-lookup Heterogeneous lookup
+
+Lookup functions take a @ref LookupType, which is @cpp const K& @ce for most
+types but a @ref StringView for @ref String keys. That means a map keyed by
+owning strings can be queried with a string literal, a @ref StringView or an
+@ref std::string (with @ref Corrade/Containers/StringStl.h included) without
+allocating a temporary key.
+
+@section Containers-HashMap-stability Pointer and iterator stability
+
+Entries are moved to a new allocation when the map grows, invalidating
+pointers returned from @ref find() and @ref insert() as well as all
+iterators. If a stable address is needed, store the values elsewhere and put
+an index or a pointer into the map. Removing an entry marks its slot as
+deleted but doesn't move any other entries, so it's possible to remove
+entries while iterating --- see @ref removeIf().
+
+Memory is allocated through @ref ArrayAllocator, the load factor is kept
+below 7/8 and the capacity is always a power-of-two multiple of 16. Unlike
+with @ref std::unordered_map, neither the key nor the value is required to be
+default-constructible, but both have to be nothrow move-constructible.
+*/
+template<class K, class V, class Hash> class HashMap {
+    public:
+        /** @brief Key type */
+        typedef K KeyType;
+
+        /** @brief Value type */
+        typedef V ValueType;
+
+        /** @brief Entry type */
+        typedef HashMapEntry<K, V> EntryType;
+
+        /**
+         * @brief Lookup type
+         *
+         * @ref StringView for @ref String keys, @cpp const K& @ce otherwise.
+         */
+        typedef typename Implementation::HashMapLookup<K>::Type LookupType;
+
+        /**
+         * @brief Default constructor
+         *
+         * Doesn't allocate.
+         */
+        /*implicit*/ HashMap() noexcept: _control{}, _entries{}, _capacity{}, _size{}, _deleted{} {}
+
+        /**
+         * @brief Construct with reserved capacity
+         *
+         * Equivalent to calling @ref reserve() on a default-constructed
+         * instance.
+         */
+        explicit HashMap(std::size_t capacity): HashMap{} {
+            reserve(capacity);
+        }
+
+        /** @brief Copying is not allowed */
+        HashMap(const HashMap<K, V, Hash>&) = delete;
+
+        /** @brief Move constructor */
+        HashMap(HashMap<K, V, Hash>&& other) noexcept: _control{other._control}, _entries{other._entries}, _capacity{other._capacity}, _size{other._size}, _deleted{other._deleted} {
+            other._control = nullptr;
+            other._entries = nullptr;
+            other._capacity = other._size = other._deleted = 0;
+        }
+
+        /** @brief Destructor */
+        ~HashMap() { destroy(); }
+
+        /** @brief Copying is not allowed */
+        HashMap<K, V, Hash>& operator=(const HashMap<K, V, Hash>&) = delete;
+
+        /** @brief Move assignment */
+        HashMap<K, V, Hash>& operator=(HashMap<K, V, Hash>&& other) noexcept {
+            using std::swap;
+            swap(_control, other._control);
+            swap(_entries, other._entries);
+            swap(_capacity, other._capacity);
+            swap(_size, other._size);
+            swap(_deleted, other._deleted);
+            return *this;
+        }
+
+        /** @brief Entry count */
+        std::size_t size() const { return _size; }
+
+        /** @brief Whether the map is empty */
+        bool isEmpty() const { return !_size; }
+
+        /**
+         * @brief Slot count
+         *
+         * Always either zero or a power-of-two multiple of 16. At most 7/8
+         * of the slots are used before the map grows.
+         */
+        std::size_t capacity() const { return _capacity; }
+
+        /**
+         * @brief Find a value
+         *
+         * Returns @cpp nullptr @ce if @p key is not in the map. The pointer
+         * is invalidated by any operation that inserts to the map.
+         */
+        V* find(LookupType key) {
+            const std::size_t slot = findSlot(key);
+            return slot == ~std::size_t{} ? nullptr : &_entries[slot]._value;
+        }
+        /** @overload */
+        const V* find(LookupType key) const {
+            const std::size_t slot = findSlot(key);
+            return slot == ~std::size_t{} ? nullptr : &_entries[slot]._value;
+        }
+
+        /** @brief Whether the map contains given key */
+        bool contains(LookupType key) const {
+            return findSlot(key) != ~std::size_t{};
+        }
+
+        /**
+         * @brief Insert a value
+         *
+         * If @p key is not in the map yet, moves @p key and @p value into it
+         * and returns a pointer to the inserted value together with
+         * @cpp true @ce. Otherwise leaves the map unchanged and returns a
+         * pointer to the existing value together with @cpp false @ce. The
+         * pointer is invalidated by any subsequent operation that inserts to
+         * the map.
+         */
+        std::pair<V*, bool> insert(K key, V value) {
+            if(V* const found = find(key)) return {found, false};
+
+            const std::size_t hash = Hash{}(key);
+            std::size_t slot = findFreeSlot(hash);
+
+            /* Reusing a tombstone doesn't change the load, otherwise grow
+               if the map would get too full. If there's many tombstones,
+               just clean them up instead of growing. */
+            if(_control && _control[slot] == Implementation::HashMapControlDeleted) {
+                --_deleted;
+            } else if(_size + _deleted + 1 > maxLoad(_capacity)) {
+                rehash(_size + 1 <= maxLoad(_capacity)/2 ? _capacity :
+                    _capacity ? _capacity*2 : std::size_t(Implementation::HashMapGroupSize));
+                slot = findFreeSlot(hash);
+            }
+
+            _control[slot] = std::uint8_t(hash & 0x7f);
+            new(&_entries[slot]) EntryType{std::move(key), std::move(value)};
+            ++_size;
+            return {&_entries[slot]._value, true};
+        }
+
+        /**
+         * @brief Remove a value
+         *
+         * Returns @cpp true @ce if @p key was found and removed,
+         * @cpp false @ce otherwise. Doesn't move any other entries and
+         * doesn't free any memory.
+         */
+        bool remove(LookupType key) {
+            const std::size_t slot = findSlot(key);
+            if(slot == ~std::size_t{}) return false;
+            removeSlot(slot);
+            return true;
+        }
+
+        /**
+         * @brief Remove all values matching a predicate
+         *
+         * The @p predicate is called with a @ref HashMapEntry reference and
+         * all entries for which it returns @cpp true @ce are removed. Returns
+         * count of removed entries.
+         */
+        template<class F> std::size_t removeIf(F predicate) {
+            std::size_t count = 0;
+            for(std::size_t i = 0; i != _capacity; ++i) {
+                if(_control[i] & 0x80 || !predicate(_entries[i])) continue;
+                removeSlot(i);
+                ++count;
+            }
+            return count;
+        }
+
+        /**
+         * @brief Remove all values
+         *
+         * Keeps the capacity.
+         */
+        void clear() {
+            for(std::size_t i = 0; i != _capacity; ++i) {
+                if(!(_control[i] & 0x80)) _entries[i].~EntryType();
+                _control[i] = Implementation::HashMapControlEmpty;
+            }
+            _size = _deleted = 0;
+        }
+
+        /**
+         * @brief Reserve capacity for given count of entries
+         *
+         * If @p size entries would fit without growing, does nothing.
+         * Otherwise reallocates and moves all entries to the new
+         * allocation.
+         */
+        void reserve(std::size_t size) {
+            std::size_t capacity = _capacity ? _capacity : std::size_t(Implementation::HashMapGroupSize);
+            while(maxLoad(capacity) < size) capacity *= 2;
+            if(capacity != _capacity) rehash(capacity);
+        }
+
+        /** @brief Iterator to the first entry */
+        HashMapIterator<EntryType> begin() {
+            return {_control, _entries, _entries + _capacity};
+        }
+        /** @overload */
+        HashMapIterator<const EntryType> begin() const {
+            return {_control, _entries, _entries + _capacity};
+        }
+        HashMapIterator<const EntryType> cbegin() const { return begin(); } /**< @overload */
+
+        /** @brief Iterator to (one item after) the last entry */
+        HashMapIterator<EntryType> end() {
+            return {_control + _capacity, _entries + _capacity, _entries + _capacity};
+        }
+        /** @overload */
+        HashMapIterator<const EntryType> end() const {
+            return {_control + _capacity, _entries + _capacity, _entries + _capacity};
+        }
+        HashMapIterator<const EntryType> cend() const { return end(); } /**< @overload */
+
+    private:
+        static std::size_t maxLoad(std::size_t capacity) {
+            return capacity - capacity/8;
+        }
+
+        /* Returns ~std::size_t{} if not found */
+        std::size_t findSlot(LookupType key) const {
+            if(!_size) return ~std::size_t{};
+
+            const std::size_t hash = Hash{}(key);
+            const std::uint8_t h2 = std::uint8_t(hash & 0x7f);
+            const std::size_t groupMask = _capacity/Implementation::HashMapGroupSize - 1;
+            /* Triangular probing visits every group exactly once for a
+               power-of-two group count */
+            for(std::size_t group = (hash >> 7) & groupMask, step = 0; ; group = (group + ++step) & groupMask) {
+                const std::uint8_t* const control = _control + group*Implementation::HashMapGroupSize;
+                for(unsigned int mask = Implementation::hashMapGroupMatch(control, h2); mask; mask &= mask - 1) {
+                    const std::size_t slot = group*Implementation::HashMapGroupSize + Implementation::hashMapLowestSetBit(mask);
+                    if(_entries[slot]._key == key) return slot;
+                }
+
+                /* An empty slot in the group means the key would have been
+                   put here. The load factor guarantees there's always at
+                   least one empty slot in the map. */
+                if(Implementation::hashMapGroupMatch(control, Implementation::HashMapControlEmpty))
+                    return ~std::size_t{};
+            }
+        }
+
+        /* Returns the first empty or deleted slot in the probe sequence, or
+           0 if there's no allocation yet */
+        std::size_t findFreeSlot(std::size_t hash) const {
+            if(!_capacity) return 0;
+
+            const std::size_t groupMask = _capacity/Implementation::HashMapGroupSize - 1;
+            for(std::size_t group = (hash >> 7) & groupMask, step = 0; ; group = (group + ++step) & groupMask) {
+                if(const unsigned int mask = Implementation::hashMapGroupMatchFree(_control + group*Implementation::HashMapGroupSize))
+                    return group*Implementation::HashMapGroupSize + Implementation::hashMapLowestSetBit(mask);
+            }
+        }
+
+        void removeSlot(std::size_t slot) {
+            _entries[slot].~EntryType();
+            /* If the group still has an empty slot, no probe sequence could
+               have continued past it, so the slot can be marked as empty
+               instead of leaving a tombstone */
+            const std::uint8_t* const group = _control + (slot & ~(std::size_t(Implementation::HashMapGroupSize) - 1));
+            if(Implementation::hashMapGroupMatch(group, Implementation::HashMapControlEmpty))
+                _control[slot] = Implementation::HashMapControlEmpty;
+            else {
+                _control[slot] = Implementation::HashMapControlDeleted;
+                ++_deleted;
+            }
+            --_size;
+        }
+
+        void rehash(std::size_t capacity) {
+            std::uint8_t* const control = ArrayAllocator<std::uint8_t>::allocate(capacity);
+            EntryType* const entries = ArrayAllocator<EntryType>::allocate(capacity);
+            std::memset(control, Implementation::HashMapControlEmpty, capacity);
+
+            std::uint8_t* const oldControl = _control;
+            EntryType* const oldEntries = _entries;
+            const std::size_t oldCapacity = _capacity;
+            _control = control;
+            _entries = entries;
+            _capacity = capacity;
+            _deleted = 0;
+
+            for(std::size_t i = 0; i != oldCapacity; ++i) {
+                if(oldControl[i] & 0x80) continue;
+                const std::size_t hash = Hash{}(oldEntries[i]._key);
+                const std::size_t slot = findFreeSlot(hash);
+                _control[slot] = std::uint8_t(hash & 0x7f);
+                new(&_entries[slot]) EntryType{std::move(oldEntries[i])};
+                oldEntries[i].~EntryType();
+            }
+
+            if(oldControl) {
+                ArrayAllocator<std::uint8_t>::deallocate(oldControl);
+                ArrayAllocator<EntryType>::deallocate(oldEntries);
+            }
+        }
+
+        void destroy() {
+            if(!_control) return;
+            for(std::size_t i = 0; i != _capacity; ++i)
+                if(!(_control[i] & 0x80)) _entries[i].~EntryType();
+            ArrayAllocator<std::uint8_t>::deallocate(_control);
+            ArrayAllocator<EntryType>::deallocate(_entries);
+        }
+
+        std::uint8_t* _control;
+        EntryType* _entries;
+        std::size_t _capacity, _size, _deleted;
+};
+
+}}
+
+#endif
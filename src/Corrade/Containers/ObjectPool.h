@@ -0,0 +1,380 @@
+#ifndef Corrade_Containers_ObjectPool_h
+#define Corrade_Containers_ObjectPool_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Containers::ObjectPool, @ref Corrade::Containers::ObjectPoolDeleter, function @ref Corrade::Containers::pointer(ObjectPool<T>&, Args&&... args)
+ * @m_since_latest
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "Corrade/Containers/Pointer.h"
+#include "Corrade/Utility/Macros.h"
+
+#ifdef CORRADE_BUILD_MULTITHREADED
+#include <atomic>
+#endif
+#ifdef CORRADE_TARGET_WINDOWS
+#include <malloc.h>
+#endif
+
+namespace Corrade { namespace Containers {
+
+namespace Implementation {
+    /* Slabs are aligned to their size so the slab header, and thus the pool,
+       can be found from any object pointer by masking the address. That
+       keeps ObjectPoolDeleter stateless and the Pointer the same size as a
+       plain pointer. */
+    enum: std::size_t { ObjectPoolSlabSize = 65536 };
+
+    /* Address unique for each thread */
+    inline const void* objectPoolThreadId() {
+        #ifdef CORRADE_BUILD_MULTITHREADED
+        CORRADE_THREAD_LOCAL
+        #endif
+        static char id;
+        return &id;
+    }
+
+    /* The type-independent part of ObjectPool */
+    class ObjectPoolBase {
+        public:
+            explicit ObjectPoolBase(std::size_t slotSize, std::size_t slotAlignment) noexcept:
+                /* The slot needs to be large enough to hold a pointer to the
+                   next free slot */
+                _slotSize{alignUp(slotSize < sizeof(FreeSlot) ? sizeof(FreeSlot) : slotSize, slotAlignment < alignof(FreeSlot) ? alignof(FreeSlot) : slotAlignment)},
+                _slotOffset{alignUp(sizeof(Slab), slotAlignment < alignof(FreeSlot) ? alignof(FreeSlot) : slotAlignment)},
+                #ifdef CORRADE_BUILD_MULTITHREADED
+                _owner{objectPoolThreadId()}, _remoteFree{},
+                #endif
+                _slabs{}, _free{}, _bump{}, _bumpEnd{}, _usedCount{} {}
+
+            ObjectPoolBase(const ObjectPoolBase&) = delete;
+            ObjectPoolBase(ObjectPoolBase&&) = delete;
+
+            ~ObjectPoolBase() {
+                collectRemote();
+                /* Freeing the slabs before checking for live objects so they
+                   don't leak if the assertion is graceful */
+                for(Slab* slab = _slabs; slab; ) {
+                    Slab* const next = slab->next;
+                    #ifdef CORRADE_TARGET_WINDOWS
+                    _aligned_free(slab);
+                    #else
+                    std::free(slab);
+                    #endif
+                    slab = next;
+                }
+                CORRADE_ASSERT(!_usedCount,
+                    "Containers::ObjectPool: destroyed with" << _usedCount << "objects still alive", );
+            }
+
+            ObjectPoolBase& operator=(const ObjectPoolBase&) = delete;
+            ObjectPoolBase& operator=(ObjectPoolBase&&) = delete;
+
+            std::size_t slotsPerSlab() const {
+                return (ObjectPoolSlabSize - _slotOffset)/_slotSize;
+            }
+
+            std::size_t slabCount() const {
+                std::size_t count = 0;
+                for(Slab* slab = _slabs; slab; slab = slab->next) ++count;
+                return count;
+            }
+
+            std::size_t usedCount() {
+                collectRemote();
+                return _usedCount;
+            }
+
+            void* allocate() {
+                CORRADE_ASSERT(isOwner(),
+                    "Containers::ObjectPool::create(): can be called only from the thread that created the pool", nullptr);
+
+                /* Reuse a free slot, first taking the ones released from
+                   other threads if there are no local ones */
+                if(!_free) collectRemote();
+                if(_free) {
+                    FreeSlot* const slot = _free;
+                    _free = slot->next;
+                    ++_usedCount;
+                    return slot;
+                }
+
+                /* Otherwise take a never-used slot from the last slab.
+                   Slots aren't put onto the free list upfront in order to not
+                   touch the whole slab on allocation. */
+                if(_bump == _bumpEnd) {
+                    char* const memory = allocateSlab();
+                    Slab* const slab = reinterpret_cast<Slab*>(memory);
+                    slab->pool = this;
+                    slab->next = _slabs;
+                    _slabs = slab;
+                    _bump = memory + _slotOffset;
+                    _bumpEnd = _bump + slotsPerSlab()*_slotSize;
+                }
+
+                void* const slot = _bump;
+                _bump += _slotSize;
+                ++_usedCount;
+                return slot;
+            }
+
+            void release(void* memory) {
+                FreeSlot* const slot = static_cast<FreeSlot*>(memory);
+
+                /* Slots released from other threads are put onto a lock-free
+                   stack that the owner takes at once. The owner always takes
+                   the whole stack, so there's no ABA problem. */
+                #ifdef CORRADE_BUILD_MULTITHREADED
+                if(!isOwner()) {
+                    FreeSlot* head = _remoteFree.load(std::memory_order_relaxed);
+                    do slot->next = head;
+                    while(!_remoteFree.compare_exchange_weak(head, slot, std::memory_order_release, std::memory_order_relaxed));
+                    return;
+                }
+                #endif
+
+                slot->next = _free;
+                _free = slot;
+                --_usedCount;
+            }
+
+            /* Slot containing given address, which can point to a base
+               subobject as well */
+            static void* slotFor(const void* object, ObjectPoolBase*& pool) {
+                const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(object);
+                char* const slab = reinterpret_cast<char*>(address & ~std::uintptr_t(ObjectPoolSlabSize - 1));
+                pool = reinterpret_cast<Slab*>(slab)->pool;
+                const std::size_t offset = address - reinterpret_cast<std::uintptr_t>(slab) - pool->_slotOffset;
+                return slab + pool->_slotOffset + offset/pool->_slotSize*pool->_slotSize;
+            }
+
+        private:
+            struct Slab {
+                ObjectPoolBase* pool;
+                Slab* next;
+            };
+
+            struct FreeSlot {
+                FreeSlot* next;
+            };
+
+            static std::size_t alignUp(std::size_t value, std::size_t alignment) {
+                return (value + alignment - 1)/alignment*alignment;
+            }
+
+            /* Aborts if the allocation fails */
+            static char* allocateSlab() {
+                #ifdef CORRADE_TARGET_WINDOWS
+                void* const memory = _aligned_malloc(ObjectPoolSlabSize, ObjectPoolSlabSize);
+                if(!memory) std::abort(); /* LCOV_EXCL_LINE */
+                #else
+                void* memory{};
+                if(posix_memalign(&memory, ObjectPoolSlabSize, ObjectPoolSlabSize) != 0)
+                    std::abort(); /* LCOV_EXCL_LINE */
+                #endif
+                return static_cast<char*>(memory);
+            }
+
+            bool isOwner() const {
+                #ifdef CORRADE_BUILD_MULTITHREADED
+                return objectPoolThreadId() == _owner;
+                #else
+                return true;
+                #endif
+            }
+
+            void collectRemote() {
+                #ifdef CORRADE_BUILD_MULTITHREADED
+                FreeSlot* slot = _remoteFree.exchange(nullptr, std::memory_order_acquire);
+                while(slot) {
+                    FreeSlot* const next = slot->next;
+                    slot->next = _free;
+                    _free = slot;
+                    --_usedCount;
+                    slot = next;
+                }
+                #endif
+            }
+
+            std::size_t _slotSize, _slotOffset;
+            #ifdef CORRADE_BUILD_MULTITHREADED
+            const void* _owner;
+            std::atomic<FreeSlot*> _remoteFree;
+            #endif
+            Slab* _slabs;
+            FreeSlot* _free;
+            char *_bump, *_bumpEnd;
+            std::size_t _usedCount;
+    };
+}
+
+/**
+@brief Deleter returning objects to an object pool
+@m_since_latest
+
+Used by @ref Pointer instances created with @ref ObjectPool::create(). The
+pool is found from the object address, so the deleter is stateless and the
+@ref Pointer stays the same size as a plain pointer. As the deleter is callable
+with any type, a pointer to a derived type can be converted to a pointer to
+its base. Deleting through a base pointer requires the base to have a virtual
+destructor, same as with @cpp delete @ce.
+*/
+struct ObjectPoolDeleter {
+    /**
+     * @brief Destroy an object and return its memory to the pool
+     *
+     * Can be called from any thread.
+     */
+    template<class T> void operator()(T* object) const {
+        Implementation::ObjectPoolBase* pool;
+        void* const slot = Implementation::ObjectPoolBase::slotFor(object, pool);
+        object->~T();
+        pool->release(slot);
+    }
+};
+
+/**
+@brief Object pool
+@m_since_latest
+
+Allocates objects of type @p T from 64 kB slabs instead of doing a separate
+@cpp new @ce and @cpp delete @ce for each of them. Objects are created with
+@ref create() and owned by a @ref Pointer with @ref ObjectPoolDeleter, which
+on destruction returns the memory to the pool. The memory is reused by
+subsequent allocations, so once the pool grows to the peak object count,
+creating and destroying objects doesn't touch the global heap at all. Slabs
+are freed only when the pool is destroyed.
+
+@snippet Containers.cpp ObjectPool
+
+Because the @ref ObjectPoolDeleter is callable with any type, a
+@ref Pointer to @p T can be converted to a @ref Pointer to its base, making it
+possible to keep objects of different types, each from a pool of its own,
+in a single container.
+
+@section Containers-ObjectPool-threads Thread safety
+
+Objects can be created only from the thread that created the pool, which keeps
+the free list used for allocation local to that thread, without any atomic
+operations or locks. If Corrade is compiled with
+@ref CORRADE_BUILD_MULTITHREADED enabled (the default), objects can be
+destroyed from any thread. Memory released from other threads is put onto a
+lock-free stack that's taken all at once by the next allocation that finds the
+local free list empty. Without @ref CORRADE_BUILD_MULTITHREADED, objects are
+expected to be destroyed from the same thread as well.
+
+All objects are expected to be destroyed before the pool is. The pool isn't
+copyable or movable, as the slabs reference it.
+@see @ref ArrayArena
+*/
+template<class T> class ObjectPool {
+    static_assert(sizeof(T) <= Implementation::ObjectPoolSlabSize/8 && alignof(T) <= Implementation::ObjectPoolSlabSize/8, "the type is too large for an object pool");
+
+    public:
+        /**
+         * @brief Constructor
+         *
+         * No memory is allocated upfront, the first slab gets allocated on
+         * the first call to @ref create().
+         */
+        explicit ObjectPool() noexcept: _base{sizeof(T), alignof(T)} {}
+
+        /** @brief Copying is not allowed */
+        ObjectPool(const ObjectPool<T>&) = delete;
+
+        /** @brief Moving is not allowed */
+        ObjectPool(ObjectPool<T>&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Frees all slabs. Expects that all objects created from the pool
+         * were destroyed.
+         */
+        ~ObjectPool() = default;
+
+        /** @brief Copying is not allowed */
+        ObjectPool<T>& operator=(const ObjectPool<T>&) = delete;
+
+        /** @brief Moving is not allowed */
+        ObjectPool<T>& operator=(ObjectPool<T>&&) = delete;
+
+        /**
+         * @brief Count of objects that fit into a single slab
+         *
+         * Each slab is 64 kB, including a small header.
+         */
+        std::size_t slabCapacity() const { return _base.slotsPerSlab(); }
+
+        /** @brief Count of allocated slabs */
+        std::size_t slabCount() const { return _base.slabCount(); }
+
+        /**
+         * @brief Count of live objects
+         *
+         * Objects destroyed from other threads are returned to the local
+         * free list first, so they aren't counted. Expected to be called only
+         * from the thread that created the pool.
+         */
+        std::size_t usedCount() { return _base.usedCount(); }
+
+        /**
+         * @brief Create an object
+         *
+         * Constructs the object by passing @p args to its constructor. Expects
+         * to be called only from the thread that created the pool.
+         * @see @ref pointer(ObjectPool<T>&, Args&&... args)
+         */
+        template<class ...Args> Pointer<T, ObjectPoolDeleter> create(Args&&... args) {
+            void* const memory = _base.allocate();
+            return Pointer<T, ObjectPoolDeleter>{new(memory) T{Utility::forward<Args>(args)...}};
+        }
+
+    private:
+        Implementation::ObjectPoolBase _base;
+};
+
+/** @relatesalso ObjectPool
+@brief Make a unique pointer from an object pool
+@m_since_latest
+
+Convenience alternative to @ref ObjectPool::create(). The following two
+lines are equivalent:
+
+@snippet Containers.cpp ObjectPool-pointer
+*/
+template<class T, class ...Args> inline Pointer<T, ObjectPoolDeleter> pointer(ObjectPool<T>& pool, Args&&... args) {
+    return pool.create(Utility::forward<Args>(args)...);
+}
+
+}}
+
+#endif
@@ -26,16 +26,17 @@
 */
 
 /** @file
- * @brief Class @ref Corrade::Containers::Optional, tag type @ref Corrade::Containers::NullOptT, tag @ref Corrade::Containers::NullOpt, function @ref Corrade::Containers::optional()
+ * @brief Class @ref Corrade::Containers::Optional, @ref Corrade::Containers::OptionalSentinel, tag type @ref Corrade::Containers::NullOptT, tag @ref Corrade::Containers::NullOpt, function @ref Corrade::Containers::optional()
  * @see @ref Corrade/Containers/OptionalStl.h
  */
 
 #include <new>
 #include <type_traits>
-#include <utility>
 
 #include "Corrade/Containers/Tags.h"
 #include "Corrade/Utility/Assert.h"
+#include "Corrade/Utility/Move.h"
+#include "Corrade/Utility/TypeTraits.h"
 #ifndef CORRADE_NO_DEBUG
 #include "Corrade/Utility/Debug.h"
 #endif
@@ -46,6 +47,131 @@ namespace Implementation {
     template<class, class> struct OptionalConverter;
 }
 
+/**
+@brief Sentinel value for an optional
+@m_since_latest
+
+Not defined by default. When specialized for a type, @ref Optional of that
+type uses given value of @p T to represent the empty state instead of storing
+a separate @cpp bool @ce, making the optional the same size as @p T. The
+specialization is expected to have a @cpp static T value() @ce function
+returning the sentinel value and a
+@cpp static bool isEmpty(const T&) @ce function checking for it. The type
+is expected to be trivially copyable and trivially destructible. Example for
+an index type where the maximal value is never a valid index:
+
+@snippet Containers.cpp OptionalSentinel
+
+Storing the sentinel value in the optional is an error, as it'd turn the
+optional empty. As the specialization affects all uses of @ref Optional with
+given type in the whole program, it's best done only for dedicated wrapper
+types and not for builtin types such as @cpp float @ce, where for example a
+NaN may be a legitimate value elsewhere.
+@see @ref Containers-Optional-layout
+*/
+template<class T> struct OptionalSentinel {};
+
+namespace Implementation {
+    template<class T> class HasOptionalSentinel {
+        template<class U> static char get(decltype(OptionalSentinel<U>::isEmpty(std::declval<const U&>()))*);
+        template<class> static short get(...);
+        public:
+            enum: bool { value = sizeof(get<T>(nullptr)) == sizeof(char) };
+    };
+
+    /* Types with const members are trivially copyable but not assignable,
+       for those the generic variant with placement new is used */
+    template<class T> struct IsOptionalTrivial: std::integral_constant<bool,
+        #ifdef CORRADE_STD_IS_TRIVIALLY_TRAITS_SUPPORTED
+        std::is_trivially_copyable<T>::value && std::is_trivially_destructible<T>::value
+        #else
+        __has_trivial_copy(T) && __has_trivial_assign(T) && __has_trivial_destructor(T)
+        #endif
+        && std::is_copy_constructible<T>::value && std::is_copy_assignable<T>::value
+    > {};
+
+    enum: unsigned {
+        OptionalStorageGeneric,
+        OptionalStorageTrivial,
+        OptionalStorageSentinel
+    };
+
+    template<class T, unsigned = HasOptionalSentinel<T>::value ? OptionalStorageSentinel : IsOptionalTrivial<T>::value ? OptionalStorageTrivial : OptionalStorageGeneric> struct OptionalData;
+
+    /* Value in an union with a separate flag, copy, move and destruction done
+       manually */
+    template<class T> struct OptionalData<T, OptionalStorageGeneric> {
+        explicit OptionalData() noexcept: _set{false} {}
+        template<class ...Args> explicit OptionalData(InPlaceInitT, Args&&... args) noexcept(std::is_nothrow_constructible<T, Args&&...>::value): _set{true} {
+            new(&_value) T{Utility::forward<Args>(args)...};
+        }
+
+        OptionalData(const OptionalData<T>& other) noexcept(std::is_nothrow_copy_constructible<T>::value);
+        OptionalData(OptionalData<T>&& other) noexcept(std::is_nothrow_move_constructible<T>::value);
+        ~OptionalData() { if(_set) _value.~T(); }
+        OptionalData<T>& operator=(const OptionalData<T>& other) noexcept(std::is_nothrow_copy_assignable<T>::value);
+        OptionalData<T>& operator=(OptionalData<T>&& other) noexcept(std::is_nothrow_move_assignable<T>::value);
+
+        bool isSet() const { return _set; }
+        void destroy() {
+            if(_set) _value.~T();
+            _set = false;
+        }
+        template<class ...Args> void construct(Args&&... args) {
+            new(&_value) T{Utility::forward<Args>(args)...};
+            _set = true;
+        }
+
+        union {
+            T _value;
+        };
+        bool _set;
+    };
+
+    /* Value in an union with a separate flag, everything defaulted so the
+       Optional is trivially copyable as well */
+    template<class T> struct OptionalData<T, OptionalStorageTrivial> {
+        explicit OptionalData() noexcept: _set{false} {}
+        template<class ...Args> explicit OptionalData(InPlaceInitT, Args&&... args) noexcept(std::is_nothrow_constructible<T, Args&&...>::value): _set{true} {
+            new(&_value) T{Utility::forward<Args>(args)...};
+        }
+
+        bool isSet() const { return _set; }
+        void destroy() { _set = false; }
+        template<class ...Args> void construct(Args&&... args) {
+            new(&_value) T{Utility::forward<Args>(args)...};
+            _set = true;
+        }
+
+        union {
+            T _value;
+        };
+        bool _set;
+    };
+
+    /* No flag, the empty state is denoted by a sentinel value */
+    template<class T> struct OptionalData<T, OptionalStorageSentinel> {
+        static_assert(IsOptionalTrivial<T>::value,
+            "Containers::Optional: types with a sentinel value are expected to be trivially copyable and destructible");
+
+        explicit OptionalData() noexcept: _value(OptionalSentinel<T>::value()) {}
+        template<class ...Args> explicit OptionalData(InPlaceInitT, Args&&... args) noexcept(std::is_nothrow_constructible<T, Args&&...>::value): _value{Utility::forward<Args>(args)...} {
+            CORRADE_ASSERT(!OptionalSentinel<T>::isEmpty(_value),
+                "Containers::Optional: can't store the sentinel value", );
+        }
+
+        bool isSet() const { return !OptionalSentinel<T>::isEmpty(_value); }
+        void destroy() { _value = OptionalSentinel<T>::value(); }
+        template<class ...Args> void construct(Args&&... args) {
+            new(&_value) T{Utility::forward<Args>(args)...};
+            CORRADE_ASSERT(!OptionalSentinel<T>::isEmpty(_value),
+                "Containers::Optional: can't store the sentinel value", );
+        }
+
+        T _value;
+    };
+}
+
 /**
 @brief Null optional initialization tag type
 
@@ -96,6 +222,18 @@ overload also allows for such a conversion. Example:
 
 @snippet Containers-stl17.cpp Optional
 
+@section Containers-Optional-layout Memory layout
+
+If @p T is trivially copyable and trivially destructible, so is the
+@ref Optional, which means for example that a growable array of optionals can
+be reallocated with a plain @ref std::realloc() and copied with
+@ref std::memcpy(). The empty state is by default stored in a separate
+@cpp bool @ce, which together with padding usually makes the optional larger
+than @p T. If there's a value of @p T that is never valid, such as an invalid
+index, @ref OptionalSentinel can be specialized to make the optional use it
+for the empty state instead, making @cpp sizeof(Optional<T>) @ce equal to
+@cpp sizeof(T) @ce.
+
 <b></b>
 
 @m_class{m-block m-success}
@@ -114,7 +252,11 @@ overload also allows for such a conversion. Example:
 @see @ref NullOpt, @ref optional(T&&), @ref optional(Args&&... args),
     @ref Reference
 */
-template<class T> class Optional {
+template<class T> class Optional
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    : Implementation::OptionalData<T>
+    #endif
+{
     public:
         /**
          * @brief Default constructor
@@ -122,7 +264,7 @@ template<class T> class Optional {
          * Creates an optional object in empty state.
          * @see @ref operator bool(), @ref emplace()
          */
-        /*implicit*/ Optional(NullOptT = NullOpt) noexcept: _set{false} {}
+        /*implicit*/ Optional(NullOptT = NullOpt) noexcept {}
 
         /**
          * @brief Construct optional object by copy
@@ -130,9 +272,7 @@ template<class T> class Optional {
          * Stores a copy of passed object.
          * @see @ref operator bool(), @ref operator->(), @ref operator*()
          */
-        /*implicit*/ Optional(const T& value) noexcept(std::is_nothrow_copy_assignable<T>::value): _set{true} {
-            new(&_value) T{value};
-        }
+        /*implicit*/ Optional(const T& value) noexcept(std::is_nothrow_copy_assignable<T>::value): Implementation::OptionalData<T>{InPlaceInit, value} {}
 
         /**
          * @brief Construct optional object by move
@@ -140,9 +280,7 @@ template<class T> class Optional {
          * Moves the passed object to internal storage.
          * @see @ref operator bool(), @ref operator->(), @ref operator*()
          */
-        /*implicit*/ Optional(T&& value) noexcept(std::is_nothrow_move_assignable<T>::value): _set{true} {
-            new(&_value) T{std::move(value)};
-        }
+        /*implicit*/ Optional(T&& value) noexcept(std::is_nothrow_move_assignable<T>::value): Implementation::OptionalData<T>{InPlaceInit, Utility::move(value)} {}
 
         /**
          * @brief Construct optional object in-place
@@ -151,9 +289,7 @@ template<class T> class Optional {
          * @see @ref operator bool(), @ref operator->(), @ref operator*(),
          *      @ref emplace()
          */
-        template<class ...Args> /*implicit*/ Optional(InPlaceInitT, Args&&... args) noexcept(std::is_nothrow_constructible<T, Args&&...>::value): _set{true} {
-            new(&_value) T{std::forward<Args>(args)...};
-        }
+        template<class ...Args> /*implicit*/ Optional(InPlaceInitT, Args&&... args) noexcept(std::is_nothrow_constructible<T, Args&&...>::value): Implementation::OptionalData<T>{InPlaceInit, Utility::forward<Args>(args)...} {}
 
         /**
          * @brief Copy-construct an optional from external representation
@@ -167,12 +303,23 @@ template<class T> class Optional {
          *
          * @see @ref Containers-Optional-stl, @ref optional(T&&)
          */
-        template<class U, class = decltype(Implementation::OptionalConverter<T, U>::from(std::declval<U&&>()))> explicit Optional(U&& other) noexcept(std::is_nothrow_move_constructible<T>::value): Optional{Implementation::OptionalConverter<T, U>::from(std::move(other))} {}
+        template<class U, class = decltype(Implementation::OptionalConverter<T, U>::from(std::declval<U&&>()))> explicit Optional(U&& other) noexcept(std::is_nothrow_move_constructible<T>::value): Optional{Implementation::OptionalConverter<T, U>::from(Utility::move(other))} {}
 
-        /** @brief Copy constructor */
+        /* Copy, move and destruction is implemented in the base, trivial
+           for trivially copyable types */
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        /**
+         * @brief Copy constructor
+         *
+         * Trivial if @p T is trivially copyable and trivially destructible.
+         */
         Optional(const Optional<T>& other) noexcept(std::is_nothrow_copy_constructible<T>::value);
 
-        /** @brief Move constructor */
+        /**
+         * @brief Move constructor
+         *
+         * Trivial if @p T is trivially copyable and trivially destructible.
+         */
         Optional(Optional<T>&& other) noexcept(std::is_nothrow_move_constructible<T>::value);
 
         /**
@@ -180,6 +327,7 @@ template<class T> class Optional {
          *
          * If the object already contains a value, calls its destructor.
          * Copy-constructs the value from @p other using placement-new.
+         * Trivial if @p T is trivially copyable and trivially destructible.
          */
         Optional<T>& operator=(const Optional<T>& other) noexcept(std::is_nothrow_copy_assignable<T>::value);
 
@@ -189,9 +337,11 @@ template<class T> class Optional {
          * If both objects contain a value, the value is swapped. Otherwise,
          * if the object contains a value, calls its destructor. If @p other
          * contains a value, move-constructs the value from it using placement
-         * new.
+         * new. Trivial if @p T is trivially copyable and trivially
+         * destructible.
          */
         Optional<T>& operator=(Optional<T>&& other) noexcept(std::is_nothrow_move_assignable<T>::value);
+        #endif
 
         /**
          * @brief Copy-convert the optional to external representation
@@ -208,7 +358,7 @@ template<class T> class Optional {
          * @see @ref Containers-Optional-stl
          */
         template<class U, class = decltype(Implementation::OptionalConverter<T, U>::to(std::declval<Optional<T>&&>()))> explicit operator U() && {
-            return Implementation::OptionalConverter<T, U>::to(std::move(*this));
+            return Implementation::OptionalConverter<T, U>::to(Utility::move(*this));
         }
 
         /**
@@ -220,13 +370,16 @@ template<class T> class Optional {
          */
         Optional<T>& operator=(NullOptT) noexcept;
 
+        #ifdef DOXYGEN_GENERATING_OUTPUT
         /**
          * @brief Destructor
          *
          * If the optional object is not empty, calls destructor on stored
-         * value.
+         * value. Trivial if @p T is trivially copyable and trivially
+         * destructible.
          */
-        ~Optional() { if(_set) _value.~T(); }
+        ~Optional();
+        #endif
 
         /**
          * @brief Whether the optional object has a value
@@ -234,7 +387,7 @@ template<class T> class Optional {
          * Returns @cpp true @ce if the optional object has a value,
          * @cpp false @ce otherwise.
          */
-        explicit operator bool() const { return _set; }
+        explicit operator bool() const { return this->isSet(); }
 
         /**
          * @brief Equality comparison to another optional
@@ -244,7 +397,9 @@ template<class T> class Optional {
          * otherwise.
          */
         bool operator==(const Optional<T>& other) const {
-            return (!_set && !other._set) || (_set && other._set && _value == other._value);
+            const bool set = this->isSet();
+            const bool otherSet = other.isSet();
+            return (!set && !otherSet) || (set && otherSet && this->_value == other._value);
         }
 
         /**
@@ -261,7 +416,7 @@ template<class T> class Optional {
          * otherwise.
          * @see @ref operator bool()
          */
-        bool operator==(NullOptT) const { return !_set; }
+        bool operator==(NullOptT) const { return !this->isSet(); }
 
         /**
          * @brief Non-equality comparison to a null optional
@@ -270,7 +425,7 @@ template<class T> class Optional {
          * otherwise.
          * @see @ref operator bool()
          */
-        bool operator!=(NullOptT) const { return _set; }
+        bool operator!=(NullOptT) const { return this->isSet(); }
 
         /**
          * @brief Equality comparison to a value
@@ -279,7 +434,7 @@ template<class T> class Optional {
          * equal to @p other, @cpp false @ce otherwise.
          */
         bool operator==(const T& other) const {
-            return _set ? _value == other : false;
+            return this->isSet() ? this->_value == other : false;
         }
 
         /**
@@ -296,14 +451,14 @@ template<class T> class Optional {
          * @see @ref operator bool(), @ref operator*()
          */
         T* operator->() {
-            CORRADE_ASSERT(_set, "Containers::Optional: the optional is empty", &_value);
-            return &_value;
+            CORRADE_ASSERT(this->isSet(), "Containers::Optional: the optional is empty", &this->_value);
+            return &this->_value;
         }
 
         /** @overload */
         const T* operator->() const {
-            CORRADE_ASSERT(_set, "Containers::Optional: the optional is empty", &_value);
-            return &_value;
+            CORRADE_ASSERT(this->isSet(), "Containers::Optional: the optional is empty", &this->_value);
+            return &this->_value;
         }
 
         /**
@@ -313,20 +468,20 @@ template<class T> class Optional {
          * @see @ref operator bool(), @ref operator->()
          */
         T& operator*() & {
-            CORRADE_ASSERT(_set, "Containers::Optional: the optional is empty", _value);
-            return _value;
+            CORRADE_ASSERT(this->isSet(), "Containers::Optional: the optional is empty", this->_value);
+            return this->_value;
         }
 
         /** @overload */
         T&& operator*() && {
-            CORRADE_ASSERT(_set, "Containers::Optional: the optional is empty", std::move(_value));
-            return std::move(_value);
+            CORRADE_ASSERT(this->isSet(), "Containers::Optional: the optional is empty", Utility::move(this->_value));
+            return Utility::move(this->_value);
         }
 
         /** @overload */
         const T& operator*() const & {
-            CORRADE_ASSERT(_set, "Containers::Optional: the optional is empty", _value);
-            return _value;
+            CORRADE_ASSERT(this->isSet(), "Containers::Optional: the optional is empty", this->_value);
+            return this->_value;
         }
 
         #if !defined(__GNUC__) || defined(__clang__) || __GNUC__ > 4
@@ -334,8 +489,8 @@ template<class T> class Optional {
         /* This causes ambiguous overload on GCC 4.8 (and I assume 4.9 as
            well), so disabling it there. See also the corresponding test. */
         const T&& operator*() const && {
-            CORRADE_ASSERT(_set, "Containers::Optional: the optional is empty", std::move(_value));
-            return std::move(_value);
+            CORRADE_ASSERT(this->isSet(), "Containers::Optional: the optional is empty", Utility::move(this->_value));
+            return Utility::move(this->_value);
         }
         #endif
 
@@ -347,12 +502,6 @@ template<class T> class Optional {
          * placement new.
          */
         template<class ...Args> T& emplace(Args&&... args);
-
-    private:
-        union {
-            T _value;
-        };
-        bool _set;
 };
 
 /** @relates Optional
@@ -413,7 +562,7 @@ Optional<typename std::decay<T>::type>
 Optional<typename Implementation::DeducedOptionalConverter<typename std::decay<T>::type>::Type>
 #endif
 optional(T&& value) {
-    return Optional<typename std::decay<T>::type>{std::forward<T>(value)};
+    return Optional<typename std::decay<T>::type>{Utility::forward<T>(value)};
 }
 
 /** @relatesalso Optional
@@ -433,7 +582,7 @@ The following two lines are equivalent:
 @see @ref optional(T&&), @ref pointer(Args&&... args)
 */
 template<class T, class ...Args> inline Optional<T> optional(Args&&... args) {
-    return Optional<T>{InPlaceInit, std::forward<Args>(args)...};
+    return Optional<T>{InPlaceInit, Utility::forward<Args>(args)...};
 }
 
 /** @relatesalso Optional
@@ -441,8 +590,8 @@ template<class T, class ...Args> inline Optional<T> optional(Args&&... args) {
 
 @see @ref Containers-Optional-stl
 */
-template<class T> inline auto optional(T&& other) -> decltype(Implementation::DeducedOptionalConverter<typename std::decay<T>::type>::from(std::forward<T>(other))) {
-    return Implementation::DeducedOptionalConverter<typename std::decay<T>::type>::from(std::forward<T>(other));
+template<class T> inline auto optional(T&& other) -> decltype(Implementation::DeducedOptionalConverter<typename std::decay<T>::type>::from(Utility::forward<T>(other))) {
+    return Implementation::DeducedOptionalConverter<typename std::decay<T>::type>::from(Utility::forward<T>(other));
 }
 
 #ifndef CORRADE_NO_DEBUG
@@ -458,44 +607,52 @@ template<class T> Utility::Debug& operator<<(Utility::Debug& debug, const Option
 }
 #endif
 
-template<class T> Optional<T>::Optional(const Optional<T>& other) noexcept(std::is_nothrow_copy_constructible<T>::value): _set(other._set) {
+namespace Implementation {
+
+template<class T> OptionalData<T, OptionalStorageGeneric>::OptionalData(const OptionalData<T>& other) noexcept(std::is_nothrow_copy_constructible<T>::value): _set(other._set) {
     if(_set) new(&_value) T{other._value};
 }
 
-template<class T> Optional<T>::Optional(Optional<T>&& other) noexcept(std::is_nothrow_move_constructible<T>::value): _set(other._set) {
-    if(_set) new(&_value) T{std::move(other._value)};
+template<class T> OptionalData<T, OptionalStorageGeneric>::OptionalData(OptionalData<T>&& other) noexcept(std::is_nothrow_move_constructible<T>::value): _set(other._set) {
+    if(_set) new(&_value) T{Utility::move(other._value)};
 }
 
-template<class T> Optional<T>& Optional<T>::operator=(const Optional<T>& other) noexcept(std::is_nothrow_copy_assignable<T>::value) {
+template<class T> OptionalData<T>& OptionalData<T, OptionalStorageGeneric>::operator=(const OptionalData<T>& other) noexcept(std::is_nothrow_copy_assignable<T>::value) {
     if(_set) _value.~T();
     if((_set = other._set)) new(&_value) T{other._value};
     return *this;
 }
 
-template<class T> Optional<T>& Optional<T>::operator=(Optional<T>&& other) noexcept(std::is_nothrow_move_assignable<T>::value) {
+template<class T> OptionalData<T>& OptionalData<T, OptionalStorageGeneric>::operator=(OptionalData<T>&& other) noexcept(std::is_nothrow_move_assignable<T>::value) {
     if(_set && other._set) {
-        using std::swap;
+        using Utility::swap;
         swap(other._value, _value);
     } else {
         if(_set) _value.~T();
-        if((_set = other._set)) new(&_value) T{std::move(other._value)};
+        if((_set = other._set)) new(&_value) T{Utility::move(other._value)};
     }
     return *this;
 }
 
+}
+
 template<class T> Optional<T>& Optional<T>::operator=(NullOptT) noexcept {
-    if(_set) _value.~T();
-    _set = false;
+    this->destroy();
     return *this;
 }
 
 template<class T> template<class ...Args> T& Optional<T>::emplace(Args&&... args) {
-    if(_set) _value.~T();
-    _set = true;
-    new(&_value) T{std::forward<Args>(args)...};
-    return _value;
+    this->destroy();
+    this->construct(Utility::forward<Args>(args)...);
+    return this->_value;
 }
 
+}
+
+namespace Utility {
+
+template<class T> struct IsTriviallyRelocatable<Containers::Optional<T>>: IsTriviallyRelocatable<T> {};
+
 }}
 
 #endif
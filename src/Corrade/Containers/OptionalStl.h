@@ -35,6 +35,7 @@ information.
 */
 
 #include <optional>
+#include <utility>
 
 #include "Corrade/Containers/Optional.h"
 
@@ -31,10 +31,15 @@
  */
 
 #include <type_traits>
-#include <utility> /* std::forward() */
 
+#include "Corrade/Containers/Containers.h"
 #include "Corrade/Containers/Tags.h"
+#ifdef CORRADE_CONTAINERS_TRACK_ALLOCATIONS
+#include "Corrade/Containers/AllocationTracking.h"
+#endif
 #include "Corrade/Utility/Assert.h"
+#include "Corrade/Utility/Move.h"
+#include "Corrade/Utility/TypeTraits.h"
 #ifndef CORRADE_NO_DEBUG
 #include "Corrade/Utility/Debug.h"
 #endif
@@ -43,6 +48,53 @@ namespace Corrade { namespace Containers {
 
 namespace Implementation {
     template<class, class> struct PointerConverter;
+
+    /* Stores a stateless deleter as an empty base to not make the pointer
+       larger */
+    template<class T, class D, bool = std::is_empty<D>::value> struct PointerStorage {
+        typedef D DeleterArgument;
+
+        /* GCC <=4.8 breaks on _deleter{} */
+        explicit PointerStorage(T* pointer, D deleter) noexcept: _pointer{pointer}, _deleter(deleter) {}
+
+        const D& deleterRef() const { return _deleter; }
+        void deletePointer() { if(_pointer) _deleter(_pointer); }
+
+        T* _pointer;
+        D _deleter;
+    };
+    template<class T, class D> struct PointerStorage<T, D, true>: D {
+        typedef D DeleterArgument;
+
+        explicit PointerStorage(T* pointer, D deleter) noexcept: D(deleter), _pointer{pointer} {}
+
+        const D& deleterRef() const { return *this; }
+        void deletePointer() { if(_pointer) static_cast<D&>(*this)(_pointer); }
+
+        T* _pointer;
+    };
+    template<class T> struct PointerStorage<T, void, false> {
+        typedef std::nullptr_t DeleterArgument;
+
+        explicit PointerStorage(T* pointer, std::nullptr_t) noexcept: _pointer{pointer} {}
+
+        void deletePointer() {
+            #ifdef CORRADE_CONTAINERS_TRACK_ALLOCATIONS
+            if(_pointer) Implementation::trackAllocation(AllocationEvent::Deallocate, _pointer, nullptr, sizeof(T));
+            #endif
+            delete _pointer;
+        }
+
+        T* _pointer;
+    };
+
+    /* Conversion from a pointer to a derived type is possible if the deleter
+       is callable with the base type as well */
+    template<class T, class D, class = void> struct IsPointerDeleterConvertible: std::false_type {};
+    template<class T> struct IsPointerDeleterConvertible<T, void, void>: std::true_type {};
+    template<class T, class D> struct IsPointerDeleterConvertible<T, D, decltype(std::declval<const D&>()(std::declval<T*>()), void())>: std::true_type {};
+    template<class T> std::nullptr_t pointerDeleterArgument(const Pointer<T, void>&) { return nullptr; }
+    template<class T, class D> const D& pointerDeleterArgument(const Pointer<T, D>& pointer) { return pointer.deleter(); }
 }
 
 /**
@@ -54,12 +106,28 @@ destruction. The @ref pointer() convenience function also provides an
 equivalent for C++14 @ref std::make_unique(), but on C++11 as well. Can be also
 thought of as a heap-allocated counterpart to @ref Optional.
 
-Unlike @ref std::unique_ptr, this class does not provide custom deleters,
-doesn't work with arrays and doesn't have a @cpp constexpr @ce API. On the
-other hand that makes it fairly simple and lightweight. If you need a custom
-deleter, use either @ref ScopeGuard or the standard @ref std::unique_ptr. For
-owning array wrappers use @ref Array, which maintains a size information and
-also supports custom deleters.
+Unlike @ref std::unique_ptr, this class doesn't work with arrays and doesn't
+have a @cpp constexpr @ce API. On the other hand that makes it fairly simple
+and lightweight. For owning array wrappers use @ref Array, which maintains a
+size information and also supports custom deleters.
+
+@section Containers-Pointer-deleter Custom deleters
+
+By default, the pointer is deleted using @cpp delete @ce. A custom deleter
+type callable with @cpp T* @ce can be supplied as the second template
+parameter, for example to manage handles from C APIs. If the deleter is an
+empty type, such as a non-capturing function object, it isn't stored at all
+and the @ref Pointer stays the same size as a plain pointer, with the call
+being direct and thus inlinable:
+
+@snippet Containers.cpp Pointer-deleter
+
+A pointer with a custom deleter can't be created with
+@ref Pointer(InPlaceInitT, Args&&... args) or @ref emplace(), as those
+allocate using @cpp new @ce, and isn't convertible to or from external pointer
+types. Conversion from a pointer to a derived type is possible if the deleter
+is callable with a pointer to the base type as well, such as with
+@ref ObjectPoolDeleter.
 
 @section Containers-Pointer-stl STL compatibility
 
@@ -89,9 +157,22 @@ Example:
 @see @ref pointer(T*), @ref pointer(Args&&... args), @ref pointerCast(),
     @ref Reference
 */
-template<class T> class Pointer {
+#ifdef DOXYGEN_GENERATING_OUTPUT
+template<class T, class Deleter = void>
+#else
+template<class T, class Deleter>
+#endif
+class Pointer
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    : Implementation::PointerStorage<T, Deleter>
+    #endif
+{
     static_assert(!std::is_array<T>::value, "use Containers::Array for arrays instead");
 
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    using Implementation::PointerStorage<T, Deleter>::_pointer;
+    #endif
+
     public:
         /**
          * @brief Default constructor
@@ -99,7 +180,7 @@ template<class T> class Pointer {
          * Creates a @cpp nullptr @ce unique pointer.
          * @see @ref operator bool(), @ref reset()
          */
-        /*implicit*/ Pointer(std::nullptr_t = nullptr) noexcept: _pointer{} {}
+        /*implicit*/ Pointer(std::nullptr_t = nullptr) noexcept: Implementation::PointerStorage<T, Deleter>{nullptr, typename Implementation::PointerStorage<T, Deleter>::DeleterArgument{}} {}
 
         /**
          * @brief Construct a unique pointer by value
@@ -107,7 +188,21 @@ template<class T> class Pointer {
          * Takes ownership of the passed pointer.
          * @see @ref operator bool(), @ref operator->()
          */
-        explicit Pointer(T* pointer) noexcept: _pointer{pointer} {}
+        explicit Pointer(T* pointer) noexcept: Implementation::PointerStorage<T, Deleter>{pointer, typename Implementation::PointerStorage<T, Deleter>::DeleterArgument{}} {}
+
+        /**
+         * @brief Construct a unique pointer with a custom deleter
+         * @m_since_latest
+         *
+         * Available only if @p Deleter is not @cpp void @ce. The
+         * @p deleter gets called with @p pointer on destruction if it's not
+         * @cpp nullptr @ce.
+         */
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        explicit Pointer(T* pointer, Deleter deleter) noexcept;
+        #else
+        template<class D = Deleter> explicit Pointer(T* pointer, typename std::enable_if<!std::is_void<D>::value, D>::type deleter) noexcept: Implementation::PointerStorage<T, Deleter>{pointer, deleter} {}
+        #endif
 
         /**
          * @brief Construct a unique pointer in-place
@@ -115,37 +210,49 @@ template<class T> class Pointer {
          * Allocates a new object by passing @p args to its constructor.
          * @see @ref operator bool(), @ref operator->()
          */
-        template<class ...Args> explicit Pointer(InPlaceInitT, Args&&... args): _pointer{new T{std::forward<Args>(args)...}} {}
+        template<class ...Args> explicit Pointer(InPlaceInitT, Args&&... args): Implementation::PointerStorage<T, Deleter>{new T{Utility::forward<Args>(args)...}, typename Implementation::PointerStorage<T, Deleter>::DeleterArgument{}} {
+            static_assert(std::is_void<Deleter>::value, "in-place construction is possible only with the default deleter");
+            #ifdef CORRADE_CONTAINERS_TRACK_ALLOCATIONS
+            Implementation::trackAllocation(AllocationEvent::Allocate, _pointer, nullptr, sizeof(T));
+            #endif
+        }
 
         /**
          * @brief Construct a unique pointer from another of a derived type
          *
          * Expects that @p T is a base of @p U. For downcasting (base to
          * derived) use @ref pointerCast(). Calls @ref release() on @p other.
+         * If @p Deleter is not @cpp void @ce, it's copied from @p other and
+         * the conversion is available only if it's callable with @p T as
+         * well.
          */
-        template<class U, class = typename std::enable_if<std::is_base_of<T, U>::value>::type> /*implicit*/ Pointer(Pointer<U>&& other) noexcept: _pointer{other.release()} {}
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        template<class U> /*implicit*/ Pointer(Pointer<U, Deleter>&& other) noexcept;
+        #else
+        template<class U, class = typename std::enable_if<std::is_base_of<T, U>::value && !std::is_same<T, U>::value && Implementation::IsPointerDeleterConvertible<T, Deleter>::value>::type> /*implicit*/ Pointer(Pointer<U, Deleter>&& other) noexcept: Implementation::PointerStorage<T, Deleter>{other.release(), Implementation::pointerDeleterArgument(other)} {}
+        #endif
 
         /**
          * @brief Construct a unique pointer from external representation
          *
          * @see @ref Containers-Pointer-stl, @ref pointer(T&&)
          */
-        template<class U, class = decltype(Implementation::PointerConverter<T, U>::from(std::declval<U&&>()))> /*implicit*/ Pointer(U&& other) noexcept: Pointer{Implementation::PointerConverter<T, U>::from(std::move(other))} {}
+        template<class U, class D = Deleter, class = typename std::enable_if<std::is_void<D>::value, decltype(Implementation::PointerConverter<T, U>::from(std::declval<U&&>()))>::type> /*implicit*/ Pointer(U&& other) noexcept: Pointer{Implementation::PointerConverter<T, U>::from(Utility::move(other))} {}
 
         /** @brief Copying is not allowed */
-        Pointer(const Pointer<T>&) = delete;
+        Pointer(const Pointer<T, Deleter>&) = delete;
 
         /** @brief Move constructor */
-        Pointer(Pointer<T>&& other) noexcept: _pointer{other._pointer} {
+        Pointer(Pointer<T, Deleter>&& other) noexcept: Implementation::PointerStorage<T, Deleter>{static_cast<Implementation::PointerStorage<T, Deleter>&>(other)} {
             other._pointer = nullptr;
         }
 
         /** @brief Copying is not allowed */
-        Pointer<T>& operator=(const Pointer<T>&) = delete;
+        Pointer<T, Deleter>& operator=(const Pointer<T, Deleter>&) = delete;
 
         /** @brief Move assignment */
-        Pointer<T>& operator=(Pointer<T>&& other) noexcept {
-            std::swap(_pointer, other._pointer);
+        Pointer<T, Deleter>& operator=(Pointer<T, Deleter>&& other) noexcept {
+            Utility::swap(static_cast<Implementation::PointerStorage<T, Deleter>&>(*this), static_cast<Implementation::PointerStorage<T, Deleter>&>(other));
             return *this;
         }
 
@@ -154,8 +261,8 @@ template<class T> class Pointer {
          *
          * @see @ref Containers-Pointer-stl
          */
-        template<class U, class = decltype(Implementation::PointerConverter<T, U>::to(std::declval<Pointer<T>&&>()))> /*implicit*/ operator U() && {
-            return Implementation::PointerConverter<T, U>::to(std::move(*this));
+        template<class U, class D = Deleter, class = typename std::enable_if<std::is_void<D>::value, decltype(Implementation::PointerConverter<T, U>::to(std::declval<Pointer<T>&&>()))>::type> /*implicit*/ operator U() && {
+            return Implementation::PointerConverter<T, U>::to(Utility::move(*this));
         }
 
         /**
@@ -179,9 +286,23 @@ template<class T> class Pointer {
         /**
          * @brief Destructor
          *
-         * Calls @cpp delete @ce on the stored pointer.
+         * Calls @cpp delete @ce or the custom deleter on the stored pointer.
+         */
+        ~Pointer() { this->deletePointer(); }
+
+        /**
+         * @brief Pointer deleter
+         * @m_since_latest
+         *
+         * Available only if @p Deleter is not @cpp void @ce.
          */
-        ~Pointer() { delete _pointer; }
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        const Deleter& deleter() const;
+        #else
+        template<class D = Deleter> const typename std::enable_if<!std::is_void<D>::value, D>::type& deleter() const {
+            return this->deleterRef();
+        }
+        #endif
 
         /**
          * @brief Whether the pointer is non-null
@@ -238,12 +359,12 @@ template<class T> class Pointer {
         /**
          * @brief Reset the pointer to a new value
          *
-         * Calls @cpp delete @ce on the previously stored pointer and replaces
-         * it with @p pointer.
+         * Calls @cpp delete @ce or the custom deleter on the previously stored
+         * pointer and replaces it with @p pointer.
          * @see @ref emplace(), @ref release()
          */
         void reset(T* pointer = nullptr) {
-            delete _pointer;
+            this->deletePointer();
             _pointer = pointer;
         }
 
@@ -251,11 +372,16 @@ template<class T> class Pointer {
          * @brief Emplace a new value
          *
          * Calls @cpp delete @ce on the previously stored pointer and allocates
-         * a new object by passing @p args to its constructor.
+         * a new object by passing @p args to its constructor. Available only
+         * if @p Deleter is @cpp void @ce.
          */
         template<class ...Args> T& emplace(Args&&... args) {
-            delete _pointer;
-            _pointer = new T{std::forward<Args>(args)...};
+            static_assert(std::is_void<Deleter>::value, "emplace is possible only with the default deleter");
+            this->deletePointer();
+            _pointer = new T{Utility::forward<Args>(args)...};
+            #ifdef CORRADE_CONTAINERS_TRACK_ALLOCATIONS
+            Implementation::trackAllocation(AllocationEvent::Allocate, _pointer, nullptr, sizeof(T));
+            #endif
             return *_pointer;
         }
 
@@ -271,9 +397,6 @@ template<class T> class Pointer {
             _pointer = nullptr;
             return out;
         }
-
-    private:
-        T* _pointer;
 };
 
 /** @relates Pointer
@@ -281,14 +404,14 @@ template<class T> class Pointer {
 
 See @ref Pointer::operator==(std::nullptr_t) const for more information.
 */
-template<class T> bool operator==(std::nullptr_t, const Pointer<T>& b) { return b == nullptr; }
+template<class T, class D> bool operator==(std::nullptr_t, const Pointer<T, D>& b) { return b == nullptr; }
 
 /** @relates Pointer
 @brief Non-euality comparison of a null pointer and an unique pointer
 
 See @ref Pointer::operator!=(std::nullptr_t) const for more information.
 */
-template<class T> bool operator!=(std::nullptr_t, const Pointer<T>& b) { return b != nullptr; }
+template<class T, class D> bool operator!=(std::nullptr_t, const Pointer<T, D>& b) { return b != nullptr; }
 
 /** @relatesalso Pointer
 @brief Make a unique pointer
@@ -320,8 +443,8 @@ namespace Implementation {
 
 @see @ref Containers-Pointer-stl
 */
-template<class T> inline auto pointer(T&& other) -> decltype(Implementation::DeducedPointerConverter<T>::from(std::move(other))) {
-    return Implementation::DeducedPointerConverter<T>::from(std::move(other));
+template<class T> inline auto pointer(T&& other) -> decltype(Implementation::DeducedPointerConverter<T>::from(Utility::move(other))) {
+    return Implementation::DeducedPointerConverter<T>::from(Utility::move(other));
 }
 
 /** @relatesalso Pointer
@@ -366,16 +489,25 @@ equivalent:
 */
 template<class T, class ...Args> inline Pointer<T> pointer(Args&&... args) {
     static_assert(!Implementation::IsFirstAPointer<T, Args...>::value || !std::is_constructible<T, T*>::value, "attempt to construct a type from its own pointer, which is ambiguous --  explicitly use the constructor instead");
-    return Pointer<T>{InPlaceInit, std::forward<Args>(args)...};
+    return Pointer<T>{InPlaceInit, Utility::forward<Args>(args)...};
 }
 
 #ifndef CORRADE_NO_DEBUG
 /** @debugoperator{Pointer} */
-template<class T> Utility::Debug& operator<<(Utility::Debug& debug, const Pointer<T>& value) {
+template<class T, class D> Utility::Debug& operator<<(Utility::Debug& debug, const Pointer<T, D>& value) {
     return debug << value.get();
 }
 #endif
 
+}
+
+namespace Utility {
+
+/* Pointer never references its own address, a custom deleter is relocatable
+   if its type is */
+template<class T, class D> struct IsTriviallyRelocatable<Containers::Pointer<T, D>>: IsTriviallyRelocatable<D> {};
+template<class T> struct IsTriviallyRelocatable<Containers::Pointer<T>>: std::true_type {};
+
 }}
 
 #endif
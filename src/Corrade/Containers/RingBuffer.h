@@ -0,0 +1,321 @@
+#ifndef Corrade_Containers_RingBuffer_h
+#define Corrade_Containers_RingBuffer_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Containers::RingBuffer
+ * @m_since_latest
+ */
+
+#include <utility>
+
+#include "Corrade/Containers/Array.h"
+
+namespace Corrade { namespace Containers {
+
+namespace Implementation {
+    inline std::size_t ringBufferCapacity(const std::size_t capacity) {
+        std::size_t rounded = 1;
+        while(rounded < capacity) rounded <<= 1;
+        return rounded;
+    }
+}
+
+/**
+@brief Ring buffer
+@m_since_latest
+
+A fixed-capacity FIFO queue stored in a single contiguous @ref Array. The
+capacity is always a power of two, so wrapping around is just a mask. The
+buffer is meant for single-threaded use, see @ref SpscQueue and
+@ref MpmcQueue for lock-free variants usable from multiple threads.
+
+Apart from pushing and popping single elements, the occupied and the free part
+of the buffer can be accessed as (at most) two contiguous
+@ref ArrayView "ArrayViews" through @ref readable() and @ref writable(), which
+makes it possible to pass the contents directly to functions operating on
+contiguous memory, such as file reads and writes, without any extra copies:
+
+@snippet Containers.cpp RingBuffer
+
+The type is required to be default-constructible and move-assignable. All
+slots are value-initialized on construction and a popped element is left in a
+moved-from state until overwritten by a subsequent push.
+*/
+template<class T> class RingBuffer {
+    public:
+        /**
+         * @brief Default constructor
+         *
+         * Creates a zero-capacity buffer. Doesn't allocate.
+         */
+        /*implicit*/ RingBuffer() noexcept: _head{}, _tail{} {}
+
+        /**
+         * @brief Constructor
+         *
+         * The @p capacity is rounded up to the nearest power of two.
+         */
+        explicit RingBuffer(std::size_t capacity): _data{ValueInit, Implementation::ringBufferCapacity(capacity)}, _head{}, _tail{} {}
+
+        /** @brief Copying is not allowed */
+        RingBuffer(const RingBuffer<T>&) = delete;
+
+        /** @brief Move constructor */
+        RingBuffer(RingBuffer<T>&& other) noexcept: _data{std::move(other._data)}, _head{other._head}, _tail{other._tail} {
+            other._head = other._tail = 0;
+        }
+
+        /** @brief Copying is not allowed */
+        RingBuffer<T>& operator=(const RingBuffer<T>&) = delete;
+
+        /** @brief Move assignment */
+        RingBuffer<T>& operator=(RingBuffer<T>&& other) noexcept {
+            using std::swap;
+            swap(_data, other._data);
+            swap(_head, other._head);
+            swap(_tail, other._tail);
+            return *this;
+        }
+
+        /** @brief Capacity */
+        std::size_t capacity() const { return _data.size(); }
+
+        /** @brief Count of elements in the buffer */
+        std::size_t size() const { return _tail - _head; }
+
+        /** @brief Whether the buffer is empty */
+        bool isEmpty() const { return _tail == _head; }
+
+        /** @brief Whether the buffer is full */
+        bool isFull() const { return _tail - _head == _data.size(); }
+
+        /**
+         * @brief Element at given position from the front
+         *
+         * Expects that @p i is less than @ref size().
+         */
+        T& operator[](std::size_t i);
+        const T& operator[](std::size_t i) const; /**< @overload */
+
+        /**
+         * @brief First element
+         *
+         * Expects that the buffer is not empty.
+         */
+        T& front();
+        const T& front() const; /**< @overload */
+
+        /**
+         * @brief Last element
+         *
+         * Expects that the buffer is not empty.
+         */
+        T& back();
+        const T& back() const; /**< @overload */
+
+        /**
+         * @brief Push an element to the back
+         *
+         * Expects that the buffer is not full.
+         */
+        void push(const T& value) { pushInternal(value); }
+        void push(T&& value) { pushInternal(std::move(value)); } /**< @overload */
+
+        /**
+         * @brief Push multiple elements to the back
+         *
+         * Copies as many elements from @p values as there's free space for
+         * and returns their count.
+         */
+        std::size_t push(ArrayView<const T> values);
+
+        /**
+         * @brief Pop an element from the front
+         *
+         * Expects that the buffer is not empty.
+         */
+        T pop();
+
+        /**
+         * @brief Pop multiple elements from the front
+         *
+         * Moves at most @cpp values.size() @ce elements to @p values and
+         * returns their count.
+         */
+        std::size_t pop(ArrayView<T> values);
+
+        /**
+         * @brief Occupied part of the buffer
+         *
+         * Returns the elements from the front to the back as two contiguous
+         * views, the second of which is non-empty only if the occupied part
+         * wraps around. Call @ref consume() after processing the elements to
+         * remove them from the buffer.
+         */
+        std::pair<ArrayView<T>, ArrayView<T>> readable() {
+            return spans(_head, size());
+        }
+
+        /**
+         * @brief Free part of the buffer
+         *
+         * Returns the free slots after the back as two contiguous views, the
+         * second of which is non-empty only if the free part wraps around.
+         * Call @ref produce() after filling the slots to make them part of
+         * the buffer.
+         */
+        std::pair<ArrayView<T>, ArrayView<T>> writable() {
+            return spans(_tail, _data.size() - size());
+        }
+
+        /**
+         * @brief Add given count of slots after the back to the buffer
+         *
+         * Expects that @p count is not larger than the free space.
+         * @see @ref writable()
+         */
+        void produce(std::size_t count);
+
+        /**
+         * @brief Remove given count of elements from the front
+         *
+         * Expects that @p count is not larger than @ref size().
+         * @see @ref readable()
+         */
+        void consume(std::size_t count);
+
+        /**
+         * @brief Clear the buffer
+         *
+         * Doesn't change the capacity and doesn't destruct the elements.
+         */
+        void clear() { _head = _tail = 0; }
+
+    private:
+        template<class U> void pushInternal(U&& value);
+
+        std::pair<ArrayView<T>, ArrayView<T>> spans(const std::size_t begin, const std::size_t count) {
+            const std::size_t first = begin & (_data.size() - 1);
+            const std::size_t firstCount = count < _data.size() - first ? count : _data.size() - first;
+            return {_data.slice(first, first + firstCount), _data.prefix(count - firstCount)};
+        }
+
+        Array<T> _data;
+        /* Both only ever increase, the slot index is the value masked by
+           capacity - 1. Unsigned overflow is fine as the capacity is a power
+           of two. */
+        std::size_t _head, _tail;
+};
+
+template<class T> T& RingBuffer<T>::operator[](const std::size_t i) {
+    CORRADE_ASSERT(i < size(),
+        "Containers::RingBuffer::operator[](): index" << i << "out of range for" << size() << "elements", _data[0]);
+    return _data[(_head + i) & (_data.size() - 1)];
+}
+
+template<class T> const T& RingBuffer<T>::operator[](const std::size_t i) const {
+    return const_cast<RingBuffer<T>&>(*this)[i];
+}
+
+template<class T> T& RingBuffer<T>::front() {
+    CORRADE_ASSERT(!isEmpty(),
+        "Containers::RingBuffer::front(): buffer is empty", _data[0]);
+    return _data[_head & (_data.size() - 1)];
+}
+
+template<class T> const T& RingBuffer<T>::front() const {
+    return const_cast<RingBuffer<T>&>(*this).front();
+}
+
+template<class T> T& RingBuffer<T>::back() {
+    CORRADE_ASSERT(!isEmpty(),
+        "Containers::RingBuffer::back(): buffer is empty", _data[0]);
+    return _data[(_tail - 1) & (_data.size() - 1)];
+}
+
+template<class T> const T& RingBuffer<T>::back() const {
+    return const_cast<RingBuffer<T>&>(*this).back();
+}
+
+template<class T> template<class U> void RingBuffer<T>::pushInternal(U&& value) {
+    CORRADE_ASSERT(!isFull(),
+        "Containers::RingBuffer::push(): buffer is full", );
+    _data[_tail & (_data.size() - 1)] = std::forward<U>(value);
+    ++_tail;
+}
+
+template<class T> std::size_t RingBuffer<T>::push(const ArrayView<const T> values) {
+    const std::pair<ArrayView<T>, ArrayView<T>> free = writable();
+    std::size_t count = 0;
+    for(T& i: free.first) {
+        if(count == values.size()) break;
+        i = values[count++];
+    }
+    for(T& i: free.second) {
+        if(count == values.size()) break;
+        i = values[count++];
+    }
+    _tail += count;
+    return count;
+}
+
+template<class T> T RingBuffer<T>::pop() {
+    CORRADE_ASSERT(!isEmpty(),
+        "Containers::RingBuffer::pop(): buffer is empty", {});
+    return std::move(_data[_head++ & (_data.size() - 1)]);
+}
+
+template<class T> std::size_t RingBuffer<T>::pop(const ArrayView<T> values) {
+    const std::pair<ArrayView<T>, ArrayView<T>> occupied = readable();
+    std::size_t count = 0;
+    for(T& i: occupied.first) {
+        if(count == values.size()) break;
+        values[count++] = std::move(i);
+    }
+    for(T& i: occupied.second) {
+        if(count == values.size()) break;
+        values[count++] = std::move(i);
+    }
+    _head += count;
+    return count;
+}
+
+template<class T> void RingBuffer<T>::produce(const std::size_t count) {
+    CORRADE_ASSERT(count <= _data.size() - size(),
+        "Containers::RingBuffer::produce(): can't produce" << count << "elements with only" << _data.size() - size() << "free", );
+    _tail += count;
+}
+
+template<class T> void RingBuffer<T>::consume(const std::size_t count) {
+    CORRADE_ASSERT(count <= size(),
+        "Containers::RingBuffer::consume(): can't consume" << count << "elements from a buffer of" << size(), );
+    _head += count;
+}
+
+}}
+
+#endif
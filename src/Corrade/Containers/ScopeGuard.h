@@ -26,9 +26,12 @@
 */
 
 /** @file
- * @brief Class @ref Corrade::Containers::ScopeGuard
+ * @brief Class @ref Corrade::Containers::ScopeGuard, @ref Corrade::Containers::ScopeExit, function @ref Corrade::Containers::scopeExit()
  */
 
+#include <type_traits>
+#include <utility>
+
 #include "Corrade/configure.h"
 
 namespace Corrade { namespace Containers {
@@ -77,6 +80,8 @@ just a parameter-less function or lambda:
     [CorradeScopeGuard.h](https://github.com/mosra/magnum-singles/tree/master/CorradeScopeGuard.h)
     library in the Magnum Singles repository for easier integration into your
     projects. See @ref corrade-singles for more information.
+
+@see @ref ScopeExit
 */
 class ScopeGuard {
     public:
@@ -174,6 +179,86 @@ template<class U> ScopeGuard::ScopeGuard(U(*deleter)()): _deleter{reinterpret_ca
 }
 #endif
 
+/**
+@brief Scope guard with a compile-time callable
+@m_since_latest
+
+Unlike @ref ScopeGuard, which type-erases the deleter into a function pointer
+and thus allows only non-capturing lambdas, this class stores the callable by
+value and calls it directly. The call is thus visible to the optimizer and can
+be inlined, which makes it suitable for cleanup in hot loops, and lambdas can
+capture any state they need. On the other hand the type depends on the
+callable, so it's mostly meant to be created via @ref scopeExit():
+
+@snippet Containers.cpp ScopeExit-usage
+
+The instance is movable in order to make @ref scopeExit() work without
+guaranteed copy elision, a moved-out instance doesn't call the callable.
+@see @ref ScopeGuard
+*/
+template<class F> class ScopeExit {
+    public:
+        /** @brief Constructor */
+        explicit ScopeExit(const F& callable): _callable(callable), _active{true} {}
+
+        /** @overload */
+        explicit ScopeExit(F&& callable): _callable(std::move(callable)), _active{true} {}
+
+        /** @brief Copying is not allowed */
+        ScopeExit(const ScopeExit<F>&) = delete;
+
+        /**
+         * @brief Move constructor
+         *
+         * The @p other instance is released, so the callable is called only
+         * once.
+         */
+        ScopeExit(ScopeExit<F>&& other) noexcept(std::is_nothrow_move_constructible<F>::value): _callable(std::move(other._callable)), _active{other._active} {
+            other._active = false;
+        }
+
+        /** @brief Copying is not allowed */
+        ScopeExit<F>& operator=(const ScopeExit<F>&) = delete;
+
+        /** @brief Move assignment is not allowed */
+        ScopeExit<F>& operator=(ScopeExit<F>&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Calls the callable passed in constructor. Does nothing if
+         * @ref release() has been called.
+         */
+        ~ScopeExit() {
+            if(_active) _callable();
+        }
+
+        /**
+         * @brief Release the callable
+         *
+         * Causes the callable passed in constructor to not get called on
+         * destruction.
+         */
+        void release() { _active = false; }
+
+    private:
+        F _callable;
+        bool _active;
+};
+
+/** @relatesalso ScopeExit
+@brief Make a scope guard with a compile-time callable
+@m_since_latest
+
+Convenience alternative to @ref ScopeExit::ScopeExit(F&&) that infers the
+callable type. The following two instances are equivalent:
+
+@snippet Containers.cpp scopeExit
+*/
+template<class F> inline ScopeExit<typename std::decay<F>::type> scopeExit(F&& callable) {
+    return ScopeExit<typename std::decay<F>::type>{std::forward<F>(callable)};
+}
+
 }}
 
 #endif
@@ -0,0 +1,417 @@
+#ifndef Corrade_Containers_SharedArray_h
+#define Corrade_Containers_SharedArray_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Containers::SharedArray
+ * @m_since_latest
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <new>
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Utility/Move.h"
+#include "Corrade/Utility/TypeTraits.h"
+
+namespace Corrade { namespace Containers {
+
+namespace Implementation {
+    struct SharedArrayControl {
+        std::atomic<std::size_t> references;
+        void(*destroy)(SharedArrayControl*);
+    };
+
+    /* Control block followed by the data in a single allocation */
+    template<class T> struct SharedArrayInlineControl: SharedArrayControl {
+        std::size_t size;
+
+        enum: std::size_t {
+            DataOffset = (sizeof(SharedArrayControl) + sizeof(std::size_t) + alignof(T) - 1)/alignof(T)*alignof(T)
+        };
+
+        T* data() {
+            return reinterpret_cast<T*>(reinterpret_cast<char*>(this) + DataOffset);
+        }
+
+        static SharedArrayInlineControl<T>* allocate(std::size_t size) {
+            static_assert(alignof(T) <= alignof(std::max_align_t),
+                "overaligned types are not supported");
+            auto* const control = new(::operator new(DataOffset + size*sizeof(T))) SharedArrayInlineControl<T>;
+            control->references.store(1, std::memory_order_relaxed);
+            control->destroy = destroyImplementation;
+            control->size = size;
+            #ifdef CORRADE_CONTAINERS_TRACK_ALLOCATIONS
+            trackAllocation(AllocationEvent::Allocate, control->data(), nullptr, size*sizeof(T));
+            #endif
+            return control;
+        }
+
+        static void destroyImplementation(SharedArrayControl* control) {
+            auto* const self = static_cast<SharedArrayInlineControl<T>*>(control);
+            for(T *it = self->data(), *end = it + self->size; it != end; ++it)
+                it->~T();
+            #ifdef CORRADE_CONTAINERS_TRACK_ALLOCATIONS
+            trackAllocation(AllocationEvent::Deallocate, self->data(), nullptr, self->size*sizeof(T));
+            #endif
+            self->~SharedArrayInlineControl<T>();
+            ::operator delete(self);
+        }
+    };
+
+    /* Control block owning an adopted array, which takes care of the
+       deletion */
+    template<class T, class D> struct SharedArrayAdoptedControl: SharedArrayControl {
+        explicit SharedArrayAdoptedControl(Array<T, D>&& array): array{Utility::move(array)} {
+            references.store(1, std::memory_order_relaxed);
+            destroy = destroyImplementation;
+        }
+
+        static void destroyImplementation(SharedArrayControl* control) {
+            delete static_cast<SharedArrayAdoptedControl<T, D>*>(control);
+        }
+
+        Array<T, D> array;
+    };
+}
+
+/**
+@brief Reference-counted shared array
+@m_since_latest
+
+An immutable array that can be cheaply copied, with all copies sharing the
+same data, which are freed once the last copy is destroyed. Useful for passing
+large blobs such as file contents through multiple consumers without either
+deep-copying or having to manage their lifetime manually. The reference count
+is atomic, so the copies can be passed to and destroyed on different threads.
+
+@snippet Containers.cpp SharedArray
+
+@section Containers-SharedArray-storage Storage
+
+When constructed directly, the reference count and the data are placed in a
+single allocation. When constructed from an @ref Array, the array data are
+adopted together with its deleter, and only a small block with the reference
+count and the original array is allocated, without copying the data.
+
+@section Containers-SharedArray-views Conversion to array views
+
+The class is implicitly convertible to @ref ArrayView "ArrayView<const U>"
+(and thus also to @ref StridedArrayView1D) if @cpp T* @ce is implicitly
+convertible to @cpp U* @ce, and @ref arrayView() as well as
+@ref stridedArrayView() work on it. The view stays valid for as long as any
+copy of the array exists.
+
+@section Containers-SharedArray-mutable Copy-on-write access
+
+The data are accessible as @cpp const @ce only. To modify them, call
+@ref mutableView(), which first makes a private copy of the data if they're
+shared with other instances. The copy expects that @p T is
+copy-constructible.
+@see @ref Array
+*/
+template<class T> class SharedArray {
+    public:
+        typedef T Type;     /**< @brief Element type */
+
+        /**
+         * @brief Default constructor
+         *
+         * Creates a zero-sized array. Doesn't allocate.
+         */
+        /*implicit*/ SharedArray(std::nullptr_t = nullptr) noexcept: _data{}, _size{}, _control{} {}
+
+        /**
+         * @brief Construct a value-initialized array
+         *
+         * If the size is zero, no allocation is done.
+         */
+        explicit SharedArray(ValueInitT, std::size_t size);
+
+        /**
+         * @brief Construct an array without initializing its contents
+         *
+         * The elements are expected to be initialized using placement new
+         * through @ref mutableView(). Destructors of *all* elements are
+         * called on destruction, regardless of whether they were properly
+         * constructed or not.
+         */
+        explicit SharedArray(NoInitT, std::size_t size);
+
+        /**
+         * @brief Construct a direct-initialized array
+         *
+         * Initializes each element with placement new using forwarded
+         * @p args.
+         */
+        template<class... Args> explicit SharedArray(DirectInitT, std::size_t size, Args&&... args);
+
+        /**
+         * @brief Construct a list-initialized array
+         *
+         * Copy-initializes each element with placement new using values from
+         * @p list.
+         */
+        explicit SharedArray(InPlaceInitT, std::initializer_list<T> list);
+
+        /**
+         * @brief Construct a value-initialized array
+         *
+         * Alias to @ref SharedArray(ValueInitT, std::size_t).
+         */
+        explicit SharedArray(std::size_t size): SharedArray{ValueInit, size} {}
+
+        /**
+         * @brief Adopt an array
+         *
+         * Takes over the data of @p array including its deleter, without
+         * copying the contents. If @p array is @cpp nullptr @ce, it's left
+         * untouched and no allocation is done.
+         */
+        template<class D> /*implicit*/ SharedArray(Array<T, D>&& array);
+
+        /**
+         * @brief Copy constructor
+         *
+         * Shares the data with @p other, incrementing the reference count.
+         */
+        SharedArray(const SharedArray<T>& other) noexcept: _data{other._data}, _size{other._size}, _control{other._control} {
+            if(_control) _control->references.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Move constructor
+         *
+         * Resets @p other to be equivalent to a default-constructed instance.
+         */
+        SharedArray(SharedArray<T>&& other) noexcept: _data{other._data}, _size{other._size}, _control{other._control} {
+            other._data = nullptr;
+            other._size = 0;
+            other._control = nullptr;
+        }
+
+        /**
+         * @brief Destructor
+         *
+         * Decrements the reference count, freeing the data if this was the
+         * last instance referencing them.
+         */
+        ~SharedArray() { release(); }
+
+        /** @brief Copy assignment */
+        SharedArray<T>& operator=(const SharedArray<T>& other) noexcept {
+            SharedArray<T> copy{other};
+            swap(copy);
+            return *this;
+        }
+
+        /**
+         * @brief Move assignment
+         *
+         * Swaps the contents of the two instances.
+         */
+        SharedArray<T>& operator=(SharedArray<T>&& other) noexcept {
+            swap(other);
+            return *this;
+        }
+
+        /** @brief Array data */
+        const T* data() const { return _data; }
+
+        /** @brief Array size */
+        std::size_t size() const { return _size; }
+
+        /** @brief Whether the array is empty */
+        bool empty() const { return !_size; }
+
+        /**
+         * @brief Count of instances sharing the data
+         *
+         * Returns @cpp 0 @ce for a default-constructed instance.
+         */
+        std::size_t useCount() const {
+            return _control ? _control->references.load(std::memory_order_acquire) : 0;
+        }
+
+        /**
+         * @brief Whether the data are not shared with any other instance
+         *
+         * @see @ref useCount()
+         */
+        bool isUnique() const { return useCount() <= 1; }
+
+        /**
+         * @brief Pointer to first element
+         *
+         * @see @ref front()
+         */
+        const T* begin() const { return _data; }
+        const T* cbegin() const { return _data; }       /**< @overload */
+
+        /**
+         * @brief Pointer to (one item after) last element
+         *
+         * @see @ref back()
+         */
+        const T* end() const { return _data + _size; }
+        const T* cend() const { return _data + _size; } /**< @overload */
+
+        /**
+         * @brief First element
+         *
+         * Expects there is at least one element.
+         */
+        const T& front() const;
+
+        /**
+         * @brief Last element
+         *
+         * Expects there is at least one element.
+         */
+        const T& back() const;
+
+        /**
+         * @brief Element access
+         *
+         * Expects that @p i is less than @ref size().
+         */
+        const T& operator[](std::size_t i) const;
+
+        /**
+         * @brief Mutable view on the data
+         *
+         * If the data are shared with other instances, copies them to a new
+         * allocation first, so the modifications aren't visible to other
+         * instances. Expects that @p T is copy-constructible in that case.
+         * The view is valid until the instance is destroyed or copied.
+         * @see @ref isUnique()
+         */
+        ArrayView<T> mutableView();
+
+    private:
+        void swap(SharedArray<T>& other) {
+            using Utility::swap;
+            swap(_data, other._data);
+            swap(_size, other._size);
+            swap(_control, other._control);
+        }
+
+        void release() {
+            if(_control && _control->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                _control->destroy(_control);
+        }
+
+        /* The data are const only through the public interface */
+        T* _data;
+        std::size_t _size;
+        Implementation::SharedArrayControl* _control;
+};
+
+template<class T> SharedArray<T>::SharedArray(ValueInitT, const std::size_t size): SharedArray{NoInit, size} {
+    for(T *it = _data, *end = _data + _size; it != end; ++it)
+        new(it) T();
+}
+
+template<class T> SharedArray<T>::SharedArray(NoInitT, const std::size_t size): SharedArray{} {
+    if(!size) return;
+    auto* const control = Implementation::SharedArrayInlineControl<T>::allocate(size);
+    _data = control->data();
+    _size = size;
+    _control = control;
+}
+
+template<class T> template<class ...Args> SharedArray<T>::SharedArray(DirectInitT, const std::size_t size, Args&&... args): SharedArray{NoInit, size} {
+    for(std::size_t i = 0; i != size; ++i)
+        new(_data + i) T{Utility::forward<Args>(args)...};
+}
+
+template<class T> SharedArray<T>::SharedArray(InPlaceInitT, const std::initializer_list<T> list): SharedArray{NoInit, list.size()} {
+    std::size_t i = 0;
+    for(const T& item: list) new(_data + i++) T{item};
+}
+
+template<class T> template<class D> SharedArray<T>::SharedArray(Array<T, D>&& array): SharedArray{} {
+    /* Nothing to adopt, the array gets destroyed by the caller */
+    if(!array.data()) return;
+    _data = array.data();
+    _size = array.size();
+    _control = new Implementation::SharedArrayAdoptedControl<T, D>{Utility::move(array)};
+}
+
+template<class T> const T& SharedArray<T>::front() const {
+    CORRADE_ASSERT(_size, "Containers::SharedArray::front(): array is empty", _data[0]);
+    return _data[0];
+}
+
+template<class T> const T& SharedArray<T>::back() const {
+    CORRADE_ASSERT(_size, "Containers::SharedArray::back(): array is empty", _data[_size - 1]);
+    return _data[_size - 1];
+}
+
+template<class T> const T& SharedArray<T>::operator[](const std::size_t i) const {
+    CORRADE_ASSERT(i < _size,
+        "Containers::SharedArray::operator[](): index" << i << "out of range for" << _size << "elements", _data[0]);
+    return _data[i];
+}
+
+template<class T> ArrayView<T> SharedArray<T>::mutableView() {
+    if(!isUnique()) {
+        SharedArray<T> copy{NoInit, _size};
+        for(std::size_t i = 0; i != _size; ++i)
+            new(copy._data + i) T(_data[i]);
+        swap(copy);
+    }
+    return {_data, _size};
+}
+
+namespace Implementation {
+
+/* SharedArray to ArrayView in order to have implicit conversion for
+   StridedArrayView without needing to introduce a header dependency */
+template<class U, class T> struct ArrayViewConverter<const U, SharedArray<T>> {
+    template<class V = U> static typename std::enable_if<std::is_convertible<T*, V*>::value, ArrayView<const U>>::type from(const SharedArray<T>& other) {
+        static_assert(sizeof(T) == sizeof(U), "types are not compatible");
+        return {other.data(), other.size()};
+    }
+};
+template<class T> struct ErasedArrayViewConverter<SharedArray<T>>: ArrayViewConverter<const T, SharedArray<T>> {};
+template<class T> struct ErasedArrayViewConverter<const SharedArray<T>>: ArrayViewConverter<const T, SharedArray<T>> {};
+
+}
+
+}
+
+namespace Utility {
+
+/* The reference count is in a separate allocation, so moving the instance
+   itself doesn't need to touch it */
+template<class T> struct IsTriviallyRelocatable<Containers::SharedArray<T>>: std::true_type {};
+
+}}
+
+#endif
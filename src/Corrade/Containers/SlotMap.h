@@ -0,0 +1,342 @@
+#ifndef Corrade_Containers_SlotMap_h
+#define Corrade_Containers_SlotMap_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Containers::SlotMap, @ref Corrade::Containers::SlotMapHandle
+ * @m_since_latest
+ */
+
+#include <cstdint>
+#include <utility>
+
+#include "Corrade/Containers/GrowableArray.h"
+
+namespace Corrade { namespace Containers {
+
+/**
+@brief Slot map handle
+@m_since_latest
+
+Refers to an element of a @ref SlotMap. Consists of a slot index and a
+generation, which changes every time the slot is reused, so a handle to an
+erased element never refers to a different element that was inserted in its
+place later. A default-constructed handle is invalid in every slot map.
+*/
+class SlotMapHandle {
+    public:
+        /**
+         * @brief Default constructor
+         *
+         * Creates a null handle.
+         */
+        constexpr /*implicit*/ SlotMapHandle() noexcept: _index{~std::uint32_t{}}, _generation{} {}
+
+        /** @brief Construct from a slot index and a generation */
+        constexpr explicit SlotMapHandle(std::uint32_t index, std::uint32_t generation) noexcept: _index{index}, _generation{generation} {}
+
+        /** @brief Whether the handle is not null */
+        constexpr explicit operator bool() const { return _index != ~std::uint32_t{}; }
+
+        /** @brief Slot index */
+        constexpr std::uint32_t index() const { return _index; }
+
+        /** @brief Slot generation */
+        constexpr std::uint32_t generation() const { return _generation; }
+
+        /** @brief Equality comparison */
+        constexpr bool operator==(const SlotMapHandle& other) const {
+            return _index == other._index && _generation == other._generation;
+        }
+
+        /** @brief Non-equality comparison */
+        constexpr bool operator!=(const SlotMapHandle& other) const {
+            return !operator==(other);
+        }
+
+    private:
+        std::uint32_t _index, _generation;
+};
+
+/**
+@brief Slot map
+@m_since_latest
+
+A cache-friendly alternative to @ref LinkedList for collections that need
+constant-time insertion and removal together with stable references to the
+elements. The elements are stored densely packed in a single growable
+@ref Array and can be iterated as a plain @ref ArrayView, while
+@ref SlotMapHandle instances returned from @ref insert() stay valid until
+given element is erased, regardless of other insertions and removals:
+
+@snippet Containers.cpp SlotMap
+
+@section Containers-SlotMap-storage Storage
+
+Apart from the dense element array, the map keeps an array of slots, each
+storing either the index of an element in the dense array or, if the slot is
+free, the index of the next free slot. Erasing an element moves the last
+element to its place, thus the order of the dense array is not preserved.
+Freed slots are reused by subsequent insertions in a LIFO order, with their
+generation incremented so stale handles are detected by @ref contains() and
+@ref find(). The generation is a 32-bit value, meaning a stale handle can
+alias a new element only after the same slot was reused over two billion
+times.
+
+The type is required to be move-constructible and move-assignable. Pointers
+and references to the elements are invalidated by insertions and removals,
+use the handles for long-term references.
+*/
+template<class T> class SlotMap {
+    public:
+        /**
+         * @brief Default constructor
+         *
+         * Doesn't allocate.
+         */
+        /*implicit*/ SlotMap() noexcept: _freeHead{~std::uint32_t{}} {}
+
+        /**
+         * @brief Construct with reserved capacity
+         *
+         * Reserves space for @p capacity elements so that many insertions
+         * don't need to reallocate.
+         */
+        explicit SlotMap(std::size_t capacity);
+
+        /** @brief Copying is not allowed */
+        SlotMap(const SlotMap<T>&) = delete;
+
+        /** @brief Move constructor */
+        SlotMap(SlotMap<T>&& other) noexcept: _values{std::move(other._values)}, _valueSlots{std::move(other._valueSlots)}, _slots{std::move(other._slots)}, _freeHead{other._freeHead} {
+            other._freeHead = ~std::uint32_t{};
+        }
+
+        /** @brief Copying is not allowed */
+        SlotMap<T>& operator=(const SlotMap<T>&) = delete;
+
+        /** @brief Move assignment */
+        SlotMap<T>& operator=(SlotMap<T>&& other) noexcept {
+            using std::swap;
+            swap(_values, other._values);
+            swap(_valueSlots, other._valueSlots);
+            swap(_slots, other._slots);
+            swap(_freeHead, other._freeHead);
+            return *this;
+        }
+
+        /** @brief Count of elements */
+        std::size_t size() const { return _values.size(); }
+
+        /** @brief Whether the map is empty */
+        bool isEmpty() const { return _values.empty(); }
+
+        /**
+         * @brief Dense element array
+         *
+         * The elements are in unspecified order. Use @ref handle() to get a
+         * handle to an element at given position.
+         */
+        ArrayView<T> values() { return _values; }
+        ArrayView<const T> values() const { return _values; } /**< @overload */
+
+        /** @brief Pointer to the first element */
+        T* begin() { return _values.begin(); }
+        const T* begin() const { return _values.begin(); } /**< @overload */
+        const T* cbegin() const { return _values.begin(); } /**< @overload */
+
+        /** @brief Pointer to (one item after) the last element */
+        T* end() { return _values.end(); }
+        const T* end() const { return _values.end(); } /**< @overload */
+        const T* cend() const { return _values.end(); } /**< @overload */
+
+        /**
+         * @brief Handle to an element at given position in the dense array
+         *
+         * Expects that @p i is less than @ref size().
+         */
+        SlotMapHandle handle(std::size_t i) const;
+
+        /**
+         * @brief Whether the map contains an element with given handle
+         *
+         * Returns @cpp false @ce for null handles and for handles of erased
+         * elements.
+         */
+        bool contains(SlotMapHandle handle) const {
+            return handle.index() < _slots.size() && _slots[handle.index()].generation == handle.generation() && (handle.generation() & 1);
+        }
+
+        /**
+         * @brief Find an element
+         *
+         * Returns @cpp nullptr @ce if the map doesn't contain an element with
+         * given handle.
+         * @see @ref contains()
+         */
+        T* find(SlotMapHandle handle) {
+            return contains(handle) ? &_values[_slots[handle.index()].value] : nullptr;
+        }
+        const T* find(SlotMapHandle handle) const { /**< @overload */
+            return contains(handle) ? &_values[_slots[handle.index()].value] : nullptr;
+        }
+
+        /**
+         * @brief Element with given handle
+         *
+         * Expects that the map contains an element with given handle.
+         * @see @ref contains(), @ref find()
+         */
+        T& operator[](SlotMapHandle handle);
+        const T& operator[](SlotMapHandle handle) const; /**< @overload */
+
+        /**
+         * @brief Insert an element
+         *
+         * Reuses a previously freed slot if there's any. Amortized
+         * @f$ \mathcal{O}(1) @f$.
+         */
+        SlotMapHandle insert(const T& value) { return emplace(value); }
+        SlotMapHandle insert(T&& value) { return emplace(std::move(value)); } /**< @overload */
+
+        /**
+         * @brief Construct an element in place
+         *
+         * Same as @ref insert(), but constructs the element from @p args.
+         */
+        template<class ...Args> SlotMapHandle emplace(Args&&... args);
+
+        /**
+         * @brief Erase an element
+         *
+         * Moves the last element of the dense array to the position of the
+         * erased one. Expects that the map contains an element with given
+         * handle. @f$ \mathcal{O}(1) @f$.
+         */
+        void erase(SlotMapHandle handle);
+
+        /**
+         * @brief Clear the map
+         *
+         * Destructs all elements and invalidates all handles. Keeps the
+         * allocated memory.
+         */
+        void clear();
+
+    private:
+        /* If the generation is odd, the slot is occupied and value is an
+           index into the dense array, otherwise it's the next free slot */
+        struct Slot {
+            std::uint32_t value;
+            std::uint32_t generation;
+        };
+
+        Array<T> _values;
+        /* Slot index for each element of the dense array */
+        Array<std::uint32_t> _valueSlots;
+        Array<Slot> _slots;
+        std::uint32_t _freeHead;
+};
+
+template<class T> SlotMap<T>::SlotMap(const std::size_t capacity): SlotMap{} {
+    arrayReserve(_values, capacity);
+    arrayReserve(_valueSlots, capacity);
+    arrayReserve(_slots, capacity);
+}
+
+template<class T> SlotMapHandle SlotMap<T>::handle(const std::size_t i) const {
+    CORRADE_ASSERT(i < _values.size(),
+        "Containers::SlotMap::handle(): index" << i << "out of range for" << _values.size() << "elements", {});
+    const std::uint32_t slot = _valueSlots[i];
+    return SlotMapHandle{slot, _slots[slot].generation};
+}
+
+template<class T> T& SlotMap<T>::operator[](const SlotMapHandle handle) {
+    CORRADE_ASSERT(contains(handle),
+        "Containers::SlotMap::operator[](): invalid handle" << handle.index() << handle.generation(), _values[0]);
+    return _values[_slots[handle.index()].value];
+}
+
+template<class T> const T& SlotMap<T>::operator[](const SlotMapHandle handle) const {
+    return const_cast<SlotMap<T>&>(*this)[handle];
+}
+
+template<class T> template<class ...Args> SlotMapHandle SlotMap<T>::emplace(Args&&... args) {
+    const std::uint32_t value = _values.size();
+    arrayAppend(_values, InPlaceInit, std::forward<Args>(args)...);
+
+    std::uint32_t index;
+    if(_freeHead != ~std::uint32_t{}) {
+        index = _freeHead;
+        Slot& slot = _slots[index];
+        _freeHead = slot.value;
+        slot.value = value;
+        ++slot.generation;
+    } else {
+        index = _slots.size();
+        arrayAppend(_slots, Slot{value, 1});
+    }
+
+    arrayAppend(_valueSlots, index);
+    return SlotMapHandle{index, _slots[index].generation};
+}
+
+template<class T> void SlotMap<T>::erase(const SlotMapHandle handle) {
+    CORRADE_ASSERT(contains(handle),
+        "Containers::SlotMap::erase(): invalid handle" << handle.index() << handle.generation(), );
+
+    /* Move the last element into the hole and redirect its slot */
+    Slot& slot = _slots[handle.index()];
+    const std::size_t last = _values.size() - 1;
+    if(slot.value != last) {
+        _values[slot.value] = std::move(_values[last]);
+        _valueSlots[slot.value] = _valueSlots[last];
+        _slots[_valueSlots[last]].value = slot.value;
+    }
+    arrayRemoveSuffix(_values);
+    arrayRemoveSuffix(_valueSlots);
+
+    /* Put the slot on the free list */
+    slot.value = _freeHead;
+    ++slot.generation;
+    _freeHead = handle.index();
+}
+
+template<class T> void SlotMap<T>::clear() {
+    /* Free all occupied slots, keeping the existing free list at the end */
+    for(const std::uint32_t index: _valueSlots) {
+        Slot& slot = _slots[index];
+        slot.value = _freeHead;
+        ++slot.generation;
+        _freeHead = index;
+    }
+    arrayRemoveSuffix(_values, _values.size());
+    arrayRemoveSuffix(_valueSlots, _valueSlots.size());
+}
+
+}}
+
+#endif
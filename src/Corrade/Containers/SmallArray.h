@@ -0,0 +1,382 @@
+#ifndef Corrade_Containers_SmallArray_h
+#define Corrade_Containers_SmallArray_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Containers::SmallArray
+ * @m_since_latest
+ */
+
+#include <initializer_list>
+
+#include "Corrade/Containers/GrowableArray.h"
+
+namespace Corrade { namespace Containers {
+
+/**
+@brief Growable array with inline storage
+@m_since_latest
+
+Stores up to @p inlineCapacity elements directly inside the object, avoiding
+any heap allocation. Once it outgrows that, the elements are moved to a
+growable @ref Array using the @ref ArrayAllocator machinery described in
+@ref Containers-Array-growable. Expects that @p T is nothrow
+move-constructible. Example usage:
+
+@snippet Containers.cpp SmallArray
+
+@section Containers-SmallArray-views Conversion to array views
+
+Similarly to @ref Array and @ref StaticArray, the class is implicitly
+convertible to @ref ArrayView "ArrayView<U>" and
+@ref ArrayView "ArrayView<const U>" (and thus also to
+@ref StridedArrayView1D) if @cpp T* @ce is implicitly convertible to
+@cpp U* @ce, and @ref arrayView() works on it as well. The view stays valid
+only until the array is modified, as growing the array might move its contents
+to a different location.
+@see @ref Array, @ref StaticArray
+*/
+template<std::size_t inlineCapacity, class T> class SmallArray {
+    static_assert(inlineCapacity, "inline capacity can't be zero");
+
+    public:
+        enum: std::size_t {
+            InlineCapacity = inlineCapacity    /**< Inline capacity */
+        };
+
+        typedef T Type;     /**< @brief Element type */
+
+        /** @brief Default constructor */
+        /*implicit*/ SmallArray() noexcept: _inlineSize{} {}
+
+        /**
+         * @brief Construct from an initializer list
+         *
+         * The elements are copied.
+         */
+        /*implicit*/ SmallArray(std::initializer_list<T> list): SmallArray{} {
+            append(list);
+        }
+
+        /** @brief Copying is not allowed */
+        SmallArray(const SmallArray<inlineCapacity, T>&) = delete;
+
+        /**
+         * @brief Move constructor
+         *
+         * If @p other is stored inline, its elements are move-constructed,
+         * otherwise just the heap allocation is taken over. The @p other
+         * instance is empty afterwards.
+         */
+        SmallArray(SmallArray<inlineCapacity, T>&& other) noexcept: _heap{Utility::move(other._heap)}, _inlineSize{other._inlineSize} {
+            Implementation::arrayMoveConstruct<T>(other.inlineData(), inlineData(), _inlineSize);
+            other.clear();
+        }
+
+        /** @brief Destructor */
+        ~SmallArray() { clearInline(); }
+
+        /** @brief Copying is not allowed */
+        SmallArray<inlineCapacity, T>& operator=(const SmallArray<inlineCapacity, T>&) = delete;
+
+        /**
+         * @brief Move assignment
+         *
+         * Destroys current contents and behaves the same as the move
+         * constructor.
+         */
+        SmallArray<inlineCapacity, T>& operator=(SmallArray<inlineCapacity, T>&& other) noexcept {
+            if(&other != this) {
+                clear();
+                _heap = Utility::move(other._heap);
+                _inlineSize = other._inlineSize;
+                Implementation::arrayMoveConstruct<T>(other.inlineData(), inlineData(), _inlineSize);
+                other.clear();
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Whether the elements are stored inline
+         *
+         * Initially @cpp true @ce, becomes @cpp false @ce once the array gets
+         * larger than @ref InlineCapacity.
+         */
+        bool isInline() const { return !_heap.data(); }
+
+        /** @brief Array data */
+        T* data() { return isInline() ? inlineData() : _heap.data(); }
+        const T* data() const { return isInline() ? inlineData() : _heap.data(); } /**< @overload */
+
+        /** @brief Array size */
+        std::size_t size() const { return isInline() ? _inlineSize : _heap.size(); }
+
+        /** @brief Whether the array is empty */
+        bool empty() const { return !size(); }
+
+        /**
+         * @brief Array capacity
+         *
+         * Returns @ref InlineCapacity for an inline array or
+         * @ref arrayCapacity() of the heap allocation otherwise.
+         */
+        std::size_t capacity() const {
+            return isInline() ? inlineCapacity : arrayCapacity(const_cast<Array<T>&>(_heap));
+        }
+
+        /** @brief Pointer to first element */
+        T* begin() { return data(); }
+        const T* begin() const { return data(); }       /**< @overload */
+        const T* cbegin() const { return data(); }      /**< @overload */
+
+        /** @brief Pointer to (one item after) last element */
+        T* end() { return data() + size(); }
+        const T* end() const { return data() + size(); }  /**< @overload */
+        const T* cend() const { return data() + size(); } /**< @overload */
+
+        /**
+         * @brief First element
+         *
+         * Expects there is at least one element.
+         */
+        T& front();
+        const T& front() const; /**< @overload */
+
+        /**
+         * @brief Last element
+         *
+         * Expects there is at least one element.
+         */
+        T& back();
+        const T& back() const; /**< @overload */
+
+        /** @brief Element access */
+        T& operator[](std::size_t i);
+        const T& operator[](std::size_t i) const; /**< @overload */
+
+        /**
+         * @brief Reserve given capacity
+         *
+         * If @p capacity is larger than current capacity, moves the elements
+         * to a heap allocation of given capacity. Otherwise does nothing.
+         */
+        void reserve(std::size_t capacity);
+
+        /**
+         * @brief Copy-append an item
+         *
+         * Moves the elements to a heap allocation if current capacity isn't
+         * large enough. The @p value is allowed to be a reference to an item
+         * of this array, in that case it's copied before the elements get
+         * moved.
+         * @see @ref arrayAppend()
+         */
+        void append(const T& value) { append(InPlaceInit, value); }
+
+        /**
+         * @brief Move-append an item
+         *
+         * Moves the elements to a heap allocation if current capacity isn't
+         * large enough.
+         */
+        void append(T&& value) { append(InPlaceInit, Utility::move(value)); }
+
+        /**
+         * @brief In-place append an item
+         *
+         * Moves the elements to a heap allocation if current capacity isn't
+         * large enough. If that's the case, the item is constructed from
+         * @p args before the elements get moved, so the @p args are allowed
+         * to reference items of this array.
+         */
+        template<class... Args> void append(InPlaceInitT, Args&&... args);
+
+        /**
+         * @brief Append a list of items
+         *
+         * Moves the elements to a heap allocation if current capacity isn't
+         * large enough. The @p values are expected to not be a view on this
+         * array.
+         */
+        void append(ArrayView<const T> values);
+
+        /** @overload */
+        void append(std::initializer_list<T> values) {
+            append(arrayView(values));
+        }
+
+        /**
+         * @brief Remove a suffix
+         *
+         * Expects that @p count is not larger than @ref size(). Doesn't move
+         * the elements back to inline storage.
+         */
+        void removeSuffix(std::size_t count = 1);
+
+        /**
+         * @brief Clear the array
+         *
+         * Destroys all elements and frees the heap allocation, if any,
+         * making the array inline again.
+         */
+        void clear() {
+            clearInline();
+            _heap = nullptr;
+        }
+
+    private:
+        T* inlineData() { return reinterpret_cast<T*>(_inline); }
+        const T* inlineData() const { return reinterpret_cast<const T*>(_inline); }
+
+        void clearInline() {
+            Implementation::arrayDestruct<T>(inlineData(), inlineData() + _inlineSize);
+            _inlineSize = 0;
+        }
+
+        /* Moves inline elements to a heap allocation */
+        void spill(std::size_t capacity);
+
+        Array<T> _heap;
+        std::size_t _inlineSize;
+        alignas(T) char _inline[inlineCapacity*sizeof(T)];
+};
+
+template<std::size_t inlineCapacity, class T> T& SmallArray<inlineCapacity, T>::front() {
+    CORRADE_ASSERT(size(), "Containers::SmallArray::front(): array is empty", *begin());
+    return *begin();
+}
+
+template<std::size_t inlineCapacity, class T> const T& SmallArray<inlineCapacity, T>::front() const {
+    CORRADE_ASSERT(size(), "Containers::SmallArray::front(): array is empty", *begin());
+    return *begin();
+}
+
+template<std::size_t inlineCapacity, class T> T& SmallArray<inlineCapacity, T>::back() {
+    CORRADE_ASSERT(size(), "Containers::SmallArray::back(): array is empty", *begin());
+    return *(end() - 1);
+}
+
+template<std::size_t inlineCapacity, class T> const T& SmallArray<inlineCapacity, T>::back() const {
+    CORRADE_ASSERT(size(), "Containers::SmallArray::back(): array is empty", *begin());
+    return *(end() - 1);
+}
+
+template<std::size_t inlineCapacity, class T> T& SmallArray<inlineCapacity, T>::operator[](const std::size_t i) {
+    CORRADE_ASSERT(i < size(), "Containers::SmallArray::operator[](): index" << i << "out of range for" << size() << "elements", *begin());
+    return data()[i];
+}
+
+template<std::size_t inlineCapacity, class T> const T& SmallArray<inlineCapacity, T>::operator[](const std::size_t i) const {
+    CORRADE_ASSERT(i < size(), "Containers::SmallArray::operator[](): index" << i << "out of range for" << size() << "elements", *begin());
+    return data()[i];
+}
+
+template<std::size_t inlineCapacity, class T> void SmallArray<inlineCapacity, T>::spill(const std::size_t capacity) {
+    arrayReserve(_heap, capacity);
+    for(T *it = inlineData(), *end = inlineData() + _inlineSize; it != end; ++it)
+        arrayAppend(_heap, InPlaceInit, Utility::move(*it));
+    clearInline();
+}
+
+template<std::size_t inlineCapacity, class T> void SmallArray<inlineCapacity, T>::reserve(const std::size_t capacity) {
+    if(isInline()) {
+        if(capacity > inlineCapacity) spill(capacity);
+    } else arrayReserve(_heap, capacity);
+}
+
+template<std::size_t inlineCapacity, class T> template<class... Args> void SmallArray<inlineCapacity, T>::append(InPlaceInitT, Args&&... args) {
+    if(isInline()) {
+        if(_inlineSize < inlineCapacity) {
+            new(inlineData() + _inlineSize) T{Utility::forward<Args>(args)...};
+            ++_inlineSize;
+            return;
+        }
+
+        /* The args may reference an inline item, which gets destroyed by the
+           spill, so construct the new item on the heap first */
+        arrayReserve(_heap, ArrayAllocator<T>::grow(nullptr, inlineCapacity + 1));
+        arrayResize(_heap, NoInit, _inlineSize + 1);
+        new(_heap.data() + _inlineSize) T{Utility::forward<Args>(args)...};
+        Implementation::arrayMoveConstruct<T>(inlineData(), _heap.data(), _inlineSize);
+        clearInline();
+        return;
+    }
+
+    /* Similarly, the args may reference a heap item, which gets moved away
+       if the allocation needs to grow. The new item can't be placed before
+       the reallocation there, so it goes through a temporary. */
+    if(_heap.size() == arrayCapacity(_heap)) {
+        T value{Utility::forward<Args>(args)...};
+        arrayAppend(_heap, InPlaceInit, Utility::move(value));
+    } else arrayAppend(_heap, InPlaceInit, Utility::forward<Args>(args)...);
+}
+
+template<std::size_t inlineCapacity, class T> void SmallArray<inlineCapacity, T>::append(const ArrayView<const T> values) {
+    if(isInline()) {
+        if(_inlineSize + values.size() <= inlineCapacity) {
+            Implementation::arrayCopyConstruct<T>(values.data(), inlineData() + _inlineSize, values.size());
+            _inlineSize += values.size();
+            return;
+        }
+
+        spill(ArrayAllocator<T>::grow(nullptr, _inlineSize + values.size()));
+    }
+
+    arrayAppend(_heap, values);
+}
+
+template<std::size_t inlineCapacity, class T> void SmallArray<inlineCapacity, T>::removeSuffix(const std::size_t count) {
+    CORRADE_ASSERT(count <= size(), "Containers::SmallArray::removeSuffix(): can't remove" << count << "elements from an array of size" << size(), );
+    if(isInline()) {
+        Implementation::arrayDestruct<T>(inlineData() + _inlineSize - count, inlineData() + _inlineSize);
+        _inlineSize -= count;
+    } else arrayRemoveSuffix(_heap, count);
+}
+
+namespace Implementation {
+
+/* SmallArray to ArrayView in order to have implicit conversion for
+   StridedArrayView without needing to introduce a header dependency */
+template<class U, std::size_t inlineCapacity, class T> struct ArrayViewConverter<U, SmallArray<inlineCapacity, T>> {
+    template<class V = U> static typename std::enable_if<std::is_convertible<T*, V*>::value, ArrayView<U>>::type from(SmallArray<inlineCapacity, T>& other) {
+        static_assert(sizeof(T) == sizeof(U), "types are not compatible");
+        return {other.data(), other.size()};
+    }
+};
+template<class U, std::size_t inlineCapacity, class T> struct ArrayViewConverter<const U, SmallArray<inlineCapacity, T>> {
+    template<class V = U> static typename std::enable_if<std::is_convertible<T*, V*>::value, ArrayView<const U>>::type from(const SmallArray<inlineCapacity, T>& other) {
+        static_assert(sizeof(T) == sizeof(U), "types are not compatible");
+        return {other.data(), other.size()};
+    }
+};
+template<std::size_t inlineCapacity, class T> struct ErasedArrayViewConverter<SmallArray<inlineCapacity, T>>: ArrayViewConverter<T, SmallArray<inlineCapacity, T>> {};
+template<std::size_t inlineCapacity, class T> struct ErasedArrayViewConverter<const SmallArray<inlineCapacity, T>>: ArrayViewConverter<const T, SmallArray<inlineCapacity, T>> {};
+
+}
+
+}}
+
+#endif
@@ -31,14 +31,56 @@
 
 #include <new>
 #include <type_traits>
-#include <utility>
 
 #include "Corrade/configure.h"
 #include "Corrade/Containers/ArrayView.h"
 #include "Corrade/Containers/Tags.h"
+#include "Corrade/Utility/Macros.h"
+#include "Corrade/Utility/Move.h"
+#include "Corrade/Utility/TypeTraits.h"
 
 namespace Corrade { namespace Containers {
 
+namespace Implementation {
+    /* Storage for trivial types has everything defaulted, which makes the
+       StaticArray trivially copyable and a literal type usable in constant
+       expressions */
+    template<std::size_t size_, class T, bool trivial = std::is_trivial<T>::value> struct StaticArrayData;
+    template<std::size_t size_, class T> struct StaticArrayData<size_, T, true> {
+        explicit StaticArrayData(NoInitT) noexcept {}
+        constexpr explicit StaticArrayData(ValueInitT) noexcept: _data{} {}
+        template<class ...Args> constexpr explicit StaticArrayData(InPlaceInitT, Args&&... args) noexcept: _data{Utility::forward<Args>(args)...} {}
+
+        union {
+            T _data[size_];
+        };
+    };
+    template<std::size_t size_, class T> struct StaticArrayData<size_, T, false> {
+        explicit StaticArrayData(NoInitT) noexcept {}
+        /* GCC 5.3 is not able to initialize non-movable types inside
+           constructor initializer list. Reported here:
+           https://gcc.gnu.org/bugzilla/show_bug.cgi?id=70395 */
+        #if !defined(__GNUC__) || defined(__clang__)
+        explicit StaticArrayData(ValueInitT): _data{} {}
+        #else
+        explicit StaticArrayData(ValueInitT) {
+            for(T& i: _data) new(&i) T{};
+        }
+        #endif
+        template<class ...Args> explicit StaticArrayData(InPlaceInitT, Args&&... args): _data{Utility::forward<Args>(args)...} {}
+
+        StaticArrayData(const StaticArrayData<size_, T>& other) noexcept(std::is_nothrow_copy_constructible<T>::value);
+        StaticArrayData(StaticArrayData<size_, T>&& other) noexcept(std::is_nothrow_move_constructible<T>::value);
+        ~StaticArrayData();
+        StaticArrayData<size_, T>& operator=(const StaticArrayData<size_, T>& other) noexcept(std::is_nothrow_copy_constructible<T>::value);
+        StaticArrayData<size_, T>& operator=(StaticArrayData<size_, T>&& other) noexcept(std::is_nothrow_move_constructible<T>::value);
+
+        union {
+            T _data[size_];
+        };
+    };
+}
+
 /**
 @brief Static array wrapper
 @tparam size_   Array size
@@ -78,6 +120,19 @@ Example:
 
 @snippet Containers.cpp StaticArray-initialization
 
+@section Containers-StaticArray-constexpr Usage in constant expressions
+
+If @p T is a trivial type, the array is trivially copyable and on C++14 and
+newer it's also usable in constant expressions --- the value-initializing and
+in-place-initializing constructors as well as element access are
+@cpp constexpr @ce. Together with the @cpp constexpr @ce
+@ref Utility::copy(const StaticArrayView<size, T>, const StaticArrayView<size, U>) "Utility::copy()",
+@ref Utility::fill() and @ref Utility::transform() helpers this allows lookup
+tables to be calculated at compile time instead of being hardcoded or filled
+on startup:
+
+@snippet Containers.cpp StaticArray-constexpr
+
 @section Containers-StaticArray-views Conversion to array views
 
 Arrays are implicitly convertible to @ref ArrayView / @ref StaticArrayView as
@@ -127,7 +182,11 @@ more information.
 */
 /* Underscore at the end to avoid conflict with member size(). It's ugly, but
    having count instead of size_ would make the naming horribly inconsistent. */
-template<std::size_t size_, class T> class StaticArray {
+template<std::size_t size_, class T> class StaticArray
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    : Implementation::StaticArrayData<size_, T>
+    #endif
+{
     /* Ideally this could be derived from StaticArrayView<size_, T>, avoiding a
        lot of redundant code, however I'm unable to find a way to add
        const/non-const overloads of all slicing functions and also prevent
@@ -160,7 +219,7 @@ template<std::size_t size_, class T> class StaticArray {
          * them to zero.
          * @see @ref ValueInit, @ref StaticArray(DefaultInitT)
          */
-        explicit StaticArray(ValueInitT): _data{} {}
+        constexpr explicit StaticArray(ValueInitT): Implementation::StaticArrayData<size_, T>{ValueInit} {}
 
         /**
          * @brief Construct an array without initializing its contents
@@ -174,7 +233,7 @@ template<std::size_t size_, class T> class StaticArray {
          *      of whether they were properly constructed or not.
          * @see @ref NoInit, @ref StaticArray(DirectInitT, Args&&... args)
          */
-        explicit StaticArray(NoInitT) {}
+        explicit StaticArray(NoInitT): Implementation::StaticArrayData<size_, T>{NoInit} {}
 
         /**
          * @brief Construct a direct-initialized array
@@ -193,7 +252,7 @@ template<std::size_t size_, class T> class StaticArray {
          * @ref StaticArray(Args&&... args).
          * @see @ref StaticArray(DirectInitT, Args&&... args)
          */
-        template<class ...Args> explicit StaticArray(InPlaceInitT, Args&&... args): _data{std::forward<Args>(args)...} {
+        template<class ...Args> constexpr explicit StaticArray(InPlaceInitT, Args&&... args): Implementation::StaticArrayData<size_, T>{InPlaceInit, Utility::forward<Args>(args)...} {
             static_assert(sizeof...(args) == size_, "Containers::StaticArray: wrong number of initializers");
         }
 
@@ -203,7 +262,7 @@ template<std::size_t size_, class T> class StaticArray {
          * Alias to @ref StaticArray(ValueInitT).
          * @see @ref StaticArray(DefaultInitT)
          */
-        explicit StaticArray(): StaticArray{ValueInit} {}
+        constexpr explicit StaticArray(): StaticArray{ValueInit} {}
 
         /**
          * @brief Construct an in-place-initialized array
@@ -214,22 +273,47 @@ template<std::size_t size_, class T> class StaticArray {
         #ifdef DOXYGEN_GENERATING_OUTPUT
         template<class ...Args> /*implicit*/ StaticArray(Args&&... args);
         #else
-        template<class First, class ...Next, class = typename std::enable_if<std::is_convertible<First&&, T>::value>::type> /*implicit*/ StaticArray(First&& first, Next&&... next): StaticArray{InPlaceInit, std::forward<First>(first), std::forward<Next>(next)...} {}
+        template<class First, class ...Next, class = typename std::enable_if<std::is_convertible<First&&, T>::value>::type> constexpr /*implicit*/ StaticArray(First&& first, Next&&... next): StaticArray{InPlaceInit, Utility::forward<First>(first), Utility::forward<Next>(next)...} {}
         #endif
 
-        /** @brief Copy constructor */
+        /* Copy, move and destruction is implemented in the base, trivial
+           for trivial types */
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        /**
+         * @brief Copy constructor
+         *
+         * Trivial if @p T is trivial.
+         */
         StaticArray(const StaticArray<size_, T>& other) noexcept(std::is_nothrow_copy_constructible<T>::value);
 
-        /** @brief Move constructor */
+        /**
+         * @brief Move constructor
+         *
+         * Trivial if @p T is trivial.
+         */
         StaticArray(StaticArray<size_, T>&& other) noexcept(std::is_nothrow_move_constructible<T>::value);
 
+        /**
+         * @brief Destructor
+         *
+         * Trivial if @p T is trivial.
+         */
         ~StaticArray();
 
-        /** @brief Copy assignment */
+        /**
+         * @brief Copy assignment
+         *
+         * Trivial if @p T is trivial.
+         */
         StaticArray<size_, T>& operator=(const StaticArray<size_, T>&) noexcept(std::is_nothrow_copy_constructible<T>::value);
 
-        /** @brief Move assignment */
+        /**
+         * @brief Move assignment
+         *
+         * Trivial if @p T is trivial.
+         */
         StaticArray<size_, T>& operator=(StaticArray<size_, T>&&) noexcept(std::is_nothrow_move_constructible<T>::value);
+        #endif
 
         /* The following view conversion is *not* restricted to this& because
            that would break uses like `consume(foo());`, where `consume()`
@@ -244,7 +328,7 @@ template<std::size_t size_, class T> class StaticArray {
            overload. Instead, the implementer is supposed to extend
            StaticArrayViewConverter specializations for the non-static arrays
            as well. */
-        template<class U, class = decltype(Implementation::StaticArrayViewConverter<size_, T, U>::to(std::declval<StaticArrayView<size_, T>>()))> /*implicit*/ operator U() {
+        template<class U, class = decltype(Implementation::StaticArrayViewConverter<size_, T, U>::to(std::declval<StaticArrayView<size_, T>>()))> CORRADE_CONSTEXPR14 /*implicit*/ operator U() {
             return Implementation::StaticArrayViewConverter<size_, T, U>::to(*this);
         }
 
@@ -257,15 +341,20 @@ template<std::size_t size_, class T> class StaticArray {
            in instant segfault, disallowing it in the following conversion
            operators */
 
-        /** @brief Conversion to array type */
-        /*implicit*/ operator T*() & { return _data; }
+        /**
+         * @brief Conversion to array type
+         *
+         * Together with the below overload usable in a constant expression
+         * if @p T is trivial, the non-const overload only on C++14.
+         */
+        CORRADE_CONSTEXPR14 /*implicit*/ operator T*() & { return this->_data; }
 
         /** @overload */
-        /*implicit*/ operator const T*() const & { return _data; }
+        constexpr /*implicit*/ operator const T*() const & { return this->_data; }
 
         /** @brief Array data */
-        T* data() { return _data; }
-        const T* data() const { return _data; }             /**< @overload */
+        CORRADE_CONSTEXPR14 T* data() { return this->_data; }
+        constexpr const T* data() const { return this->_data; } /**< @overload */
 
         /**
          * @brief Array size
@@ -286,34 +375,34 @@ template<std::size_t size_, class T> class StaticArray {
          *
          * @see @ref front()
          */
-        T* begin() { return _data; }
-        const T* begin() const { return _data; }            /**< @overload */
-        const T* cbegin() const { return _data; }           /**< @overload */
+        CORRADE_CONSTEXPR14 T* begin() { return this->_data; }
+        constexpr const T* begin() const { return this->_data; } /**< @overload */
+        constexpr const T* cbegin() const { return this->_data; } /**< @overload */
 
         /**
          * @brief Pointer to (one item after) last element
          *
          * @see @ref back()
          */
-        T* end() { return _data + size_; }
-        const T* end() const { return _data + size_; }      /**< @overload */
-        const T* cend() const { return _data + size_; }     /**< @overload */
+        CORRADE_CONSTEXPR14 T* end() { return this->_data + size_; }
+        constexpr const T* end() const { return this->_data + size_; } /**< @overload */
+        constexpr const T* cend() const { return this->_data + size_; } /**< @overload */
 
         /**
          * @brief First element
          *
          * @see @ref begin()
          */
-        T& front() { return _data[0]; }
-        const T& front() const { return _data[0]; }         /**< @overload */
+        CORRADE_CONSTEXPR14 T& front() { return this->_data[0]; }
+        constexpr const T& front() const { return this->_data[0]; } /**< @overload */
 
         /**
          * @brief Last element
          *
          * @see @ref end()
          */
-        T& back() { return _data[size_ - 1]; }
-        const T& back() const { return _data[size_ - 1]; }  /**< @overload */
+        CORRADE_CONSTEXPR14 T& back() { return this->_data[size_ - 1]; }
+        constexpr const T& back() const { return this->_data[size_ - 1]; } /**< @overload */
 
         /**
          * @brief Array slice
@@ -471,21 +560,8 @@ template<std::size_t size_, class T> class StaticArray {
         }
 
     private:
-        explicit StaticArray(DefaultInitT, std::true_type) {}
-        /* GCC 5.3 is not able to initialize non-movable types inside
-           constructor initializer list. Reported here:
-           https://gcc.gnu.org/bugzilla/show_bug.cgi?id=70395 */
-        #if !defined(__GNUC__) || defined(__clang__)
-        explicit StaticArray(DefaultInitT, std::false_type): _data{} {}
-        #else
-        explicit StaticArray(DefaultInitT, std::false_type) {
-            for(T& i: _data) new(&i) T{};
-        }
-        #endif
-
-        union {
-            T _data[size_];
-        };
+        explicit StaticArray(DefaultInitT, std::true_type): Implementation::StaticArrayData<size_, T>{NoInit} {}
+        explicit StaticArray(DefaultInitT, std::false_type): Implementation::StaticArrayData<size_, T>{ValueInit} {}
 };
 
 /** @relatesalso StaticArray
@@ -564,47 +640,51 @@ template<std::size_t size_, class T> constexpr std::size_t arraySize(const Stati
 }
 
 template<std::size_t size_, class T> template<class ...Args> StaticArray<size_, T>::StaticArray(DirectInitT, Args&&... args): StaticArray{NoInit} {
-    for(T& i: _data) {
+    for(T& i: this->_data) {
         /* MSVC 2015 needs the braces around */
-        new(&i) T{std::forward<Args>(args)...};
+        new(&i) T{Utility::forward<Args>(args)...};
     }
 }
 
-template<std::size_t size_, class T> StaticArray<size_, T>::StaticArray(const StaticArray<size_, T>& other) noexcept(std::is_nothrow_copy_constructible<T>::value): StaticArray{NoInit} {
-    for(std::size_t i = 0; i != other.size(); ++i)
+namespace Implementation {
+
+template<std::size_t size_, class T> StaticArrayData<size_, T, false>::StaticArrayData(const StaticArrayData<size_, T>& other) noexcept(std::is_nothrow_copy_constructible<T>::value) {
+    for(std::size_t i = 0; i != size_; ++i)
         new(&_data[i]) T{other._data[i]};
 }
 
-template<std::size_t size_, class T> StaticArray<size_, T>::StaticArray(StaticArray<size_, T>&& other) noexcept(std::is_nothrow_move_constructible<T>::value): StaticArray{NoInit} {
-    for(std::size_t i = 0; i != other.size(); ++i)
-        new(&_data[i]) T{std::move(other._data[i])};
+template<std::size_t size_, class T> StaticArrayData<size_, T, false>::StaticArrayData(StaticArrayData<size_, T>&& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+    for(std::size_t i = 0; i != size_; ++i)
+        new(&_data[i]) T{Utility::move(other._data[i])};
 }
 
-template<std::size_t size_, class T> StaticArray<size_, T>::~StaticArray() {
+template<std::size_t size_, class T> StaticArrayData<size_, T, false>::~StaticArrayData() {
     for(T& i: _data) i.~T();
 }
 
-template<std::size_t size_, class T> StaticArray<size_, T>& StaticArray<size_, T>::operator=(const StaticArray<size_, T>& other) noexcept(std::is_nothrow_copy_constructible<T>::value) {
-    for(std::size_t i = 0; i != other.size(); ++i)
+template<std::size_t size_, class T> StaticArrayData<size_, T>& StaticArrayData<size_, T, false>::operator=(const StaticArrayData<size_, T>& other) noexcept(std::is_nothrow_copy_constructible<T>::value) {
+    for(std::size_t i = 0; i != size_; ++i)
         _data[i] = other._data[i];
     return *this;
 }
 
-template<std::size_t size_, class T> StaticArray<size_, T>& StaticArray<size_, T>::operator=(StaticArray<size_, T>&& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
-    using std::swap;
-    for(std::size_t i = 0; i != other.size(); ++i)
+template<std::size_t size_, class T> StaticArrayData<size_, T>& StaticArrayData<size_, T, false>::operator=(StaticArrayData<size_, T>&& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+    using Utility::swap;
+    for(std::size_t i = 0; i != size_; ++i)
         swap(_data[i], other._data[i]);
     return *this;
 }
 
+}
+
 template<std::size_t size_, class T> template<std::size_t viewSize> StaticArrayView<viewSize, T> StaticArray<size_, T>::prefix() {
     static_assert(viewSize <= size_, "prefix size too large");
-    return StaticArrayView<viewSize, T>{_data};
+    return StaticArrayView<viewSize, T>{this->_data};
 }
 
 template<std::size_t size_, class T> template<std::size_t viewSize> StaticArrayView<viewSize, const T> StaticArray<size_, T>::prefix() const {
     static_assert(viewSize <= size_, "prefix size too large");
-    return StaticArrayView<viewSize, const T>{_data};
+    return StaticArrayView<viewSize, const T>{this->_data};
 }
 
 namespace Implementation {
@@ -661,6 +741,12 @@ template<std::size_t size, class T> struct ErasedStaticArrayViewConverter<const
 
 }
 
+}
+
+namespace Utility {
+
+template<std::size_t size, class T> struct IsTriviallyRelocatable<Containers::StaticArray<size, T>>: IsTriviallyRelocatable<T> {};
+
 }}
 
 #endif
@@ -0,0 +1,382 @@
+#ifndef Corrade_Containers_StaticStridedArrayView_h
+#define Corrade_Containers_StaticStridedArrayView_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Containers::StaticStridedArrayView, @ref Corrade::Containers::StaticStridedIterator
+ * @m_since_latest
+ */
+
+#include "Corrade/Containers/StridedArrayView.h"
+
+namespace Corrade { namespace Containers {
+
+/**
+@brief One-dimensional array view with a compile-time stride
+@m_since_latest
+
+Counterpart to @ref StridedArrayView1D with the stride being a template
+parameter instead of a runtime value. With the stride known at compile time,
+element access and iteration compile down to addressing with a constant
+offset, which is useful in tight loops over interleaved data with a layout
+that's known upfront, such as a vertex structure:
+
+@snippet Containers.cpp StaticStridedArrayView
+
+The view is implicitly convertible to a @ref StridedArrayView1D, the other
+direction is explicit and expects that the runtime stride matches. Positive,
+negative and zero strides are supported, though a contiguous view with the
+stride equal to @cpp sizeof(T) @ce is convertible from an @ref ArrayView as
+well. The @p stride_ is in bytes, same as with @ref StridedArrayView.
+
+Only one-dimensional views are provided, as static strides are mainly useful
+for the innermost loop. Multi-dimensional views can be iterated with
+@ref forEachRow() and the rows then converted to this type.
+@see @ref StaticStridedIterator
+*/
+/* All member functions are const because the view doesn't own the data */
+template<std::ptrdiff_t stride_, class T> class StaticStridedArrayView {
+    public:
+        /** @brief Underlying type */
+        typedef T Type;
+
+        /**
+         * @brief Erased type
+         *
+         * Either @cpp void @ce or @cpp const void @ce based on constness
+         * of @ref Type.
+         */
+        typedef typename std::conditional<std::is_const<T>::value, const void, void>::type ErasedType;
+
+        enum: std::ptrdiff_t {
+            Stride = stride_    /**< View stride */
+        };
+
+        /** @brief Conversion from `nullptr` */
+        constexpr /*implicit*/ StaticStridedArrayView(std::nullptr_t) noexcept: _data{}, _size{} {}
+
+        /**
+         * @brief Default constructor
+         *
+         * Creates an empty view.
+         */
+        constexpr /*implicit*/ StaticStridedArrayView() noexcept: _data{}, _size{} {}
+
+        /**
+         * @brief Construct a view with explicit size
+         * @param data      Continuous view on the data
+         * @param member    Pointer to the first member of the strided view
+         * @param size      Data size
+         *
+         * The @p data view is used only for a bounds check --- expects that
+         * @p data size is enough for @p size elements of @ref Stride. Same as
+         * with @ref StridedArrayView, zero strides can't be reliably checked
+         * for out-of-bounds conditions.
+         */
+        constexpr /*implicit*/ StaticStridedArrayView(ArrayView<ErasedType> data, T* member, std::size_t size) noexcept: _data{(
+            CORRADE_CONSTEXPR_ASSERT(!size || size*std::size_t(stride_ < 0 ? -stride_ : stride_) <= data.size(),
+                "Containers::StaticStridedArrayView: data size" << data.size() << "is not enough for" << size << "elements of stride" << stride_),
+            member)}, _size{size} {}
+
+        /**
+         * @brief Construct a view with explicit size
+         *
+         * Equivalent to calling @ref StaticStridedArrayView(ArrayView<ErasedType>, T*, std::size_t)
+         * with @p data as the first parameter and @cpp data.data() @ce as the
+         * second parameter.
+         */
+        constexpr /*implicit*/ StaticStridedArrayView(ArrayView<T> data, std::size_t size) noexcept: StaticStridedArrayView{data, data.data(), size} {}
+
+        /**
+         * @brief Construct a view on @ref ArrayView
+         *
+         * Enabled only if @cpp T* @ce is implicitly convertible to
+         * @cpp U* @ce. Expects that both types have the same size and that
+         * @ref Stride is equal to it.
+         */
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        template<class U>
+        #else
+        template<class U, class = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+        #endif
+        constexpr /*implicit*/ StaticStridedArrayView(ArrayView<U> view) noexcept: _data{view.data()}, _size{view.size()} {
+            static_assert(sizeof(T) == sizeof(U), "type sizes are not compatible");
+            static_assert(stride_ == sizeof(T), "the view is not contiguous");
+        }
+
+        /**
+         * @brief Construct a view on a view with a different type
+         *
+         * Enabled only if @cpp T* @ce is implicitly convertible to
+         * @cpp U* @ce. Expects that both types have the same size.
+         */
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        template<class U>
+        #else
+        template<class U, class = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+        #endif
+        constexpr /*implicit*/ StaticStridedArrayView(StaticStridedArrayView<stride_, U> view) noexcept: _data{view.data()}, _size{view.size()} {
+            static_assert(sizeof(T) == sizeof(U), "type sizes are not compatible");
+        }
+
+        /**
+         * @brief Construct a view on @ref StridedArrayView1D
+         *
+         * Enabled only if @cpp T* @ce is implicitly convertible to
+         * @cpp U* @ce. Expects that both types have the same size and that
+         * the stride of @p view is equal to @ref Stride.
+         */
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        template<class U>
+        #else
+        template<class U, class = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+        #endif
+        explicit StaticStridedArrayView(const StridedArrayView1D<U>& view) noexcept: _data{view.data()}, _size{view.size()} {
+            static_assert(sizeof(T) == sizeof(U), "type sizes are not compatible");
+            CORRADE_ASSERT(view.stride() == stride_,
+                "Containers::StaticStridedArrayView: expected stride" << stride_ << "but got" << view.stride(), );
+        }
+
+        /** @brief Convert to a @ref StridedArrayView1D */
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        template<class U>
+        #else
+        template<class U, class = typename std::enable_if<std::is_convertible<T*, U*>::value>::type>
+        #endif
+        /*implicit*/ operator StridedArrayView1D<U>() const {
+            /* The data view is only used for a bounds check, so give it
+               exactly the size that's needed */
+            return StridedArrayView1D<U>{
+                {_data, _size*std::size_t(stride_ < 0 ? -stride_ : stride_)},
+                static_cast<T*>(_data), _size, stride_};
+        }
+
+        /** @brief Whether the array is non-empty */
+        constexpr explicit operator bool() const { return _data; }
+
+        /** @brief Array data */
+        constexpr ErasedType* data() const { return _data; }
+
+        /** @brief Array size */
+        constexpr std::size_t size() const { return _size; }
+
+        /**
+         * @brief Array stride
+         *
+         * Equivalent to @ref Stride.
+         */
+        static constexpr std::ptrdiff_t stride() { return stride_; }
+
+        /** @brief Whether the array is empty */
+        constexpr bool empty() const { return !_size; }
+
+        /** @brief Element access */
+        T& operator[](std::size_t i) const {
+            CORRADE_ASSERT(i < _size, "Containers::StaticStridedArrayView::operator[](): index" << i << "out of range for" << _size << "elements", element(i));
+            return element(i);
+        }
+
+        /** @brief Iterator to first element */
+        StaticStridedIterator<stride_, T> begin() const { return {_data, 0}; }
+        /** @overload */
+        StaticStridedIterator<stride_, T> cbegin() const { return {_data, 0}; }
+
+        /** @brief Iterator to (one item after) last element */
+        StaticStridedIterator<stride_, T> end() const { return {_data, _size}; }
+        /** @overload */
+        StaticStridedIterator<stride_, T> cend() const { return {_data, _size}; }
+
+        /**
+         * @brief First element
+         *
+         * Expects there is at least one element.
+         */
+        T& front() const {
+            CORRADE_ASSERT(_size, "Containers::StaticStridedArrayView::front(): view is empty", element(0));
+            return element(0);
+        }
+
+        /**
+         * @brief Last element
+         *
+         * Expects there is at least one element.
+         */
+        T& back() const {
+            CORRADE_ASSERT(_size, "Containers::StaticStridedArrayView::back(): view is empty", element(_size - 1));
+            return element(_size - 1);
+        }
+
+        /**
+         * @brief View slice
+         *
+         * Both arguments are expected to be in range.
+         */
+        StaticStridedArrayView<stride_, T> slice(std::size_t begin, std::size_t end) const {
+            CORRADE_ASSERT(begin <= end && end <= _size,
+                "Containers::StaticStridedArrayView::slice(): slice [" << Utility::Debug::nospace
+                << begin << Utility::Debug::nospace << ":"
+                << Utility::Debug::nospace << end << Utility::Debug::nospace
+                << "] out of range for" << _size << "elements", {});
+            return StaticStridedArrayView<stride_, T>{&element(begin), end - begin};
+        }
+
+        /**
+         * @brief View on the first @p end items
+         *
+         * Equivalent to @cpp slice(0, end) @ce.
+         */
+        StaticStridedArrayView<stride_, T> prefix(std::size_t end) const {
+            return slice(0, end);
+        }
+
+        /**
+         * @brief View except the first @p begin items
+         *
+         * Equivalent to @cpp slice(begin, size()) @ce.
+         */
+        StaticStridedArrayView<stride_, T> suffix(std::size_t begin) const {
+            return slice(begin, _size);
+        }
+
+        /**
+         * @brief View except the last @p count items
+         *
+         * Equivalent to @cpp slice(0, size() - count) @ce.
+         */
+        StaticStridedArrayView<stride_, T> except(std::size_t count) const {
+            return slice(0, _size - count);
+        }
+
+    private:
+        /* Internal constructor without any checks for slice(). Argument order
+           is different to not get matched by accident. */
+        constexpr explicit StaticStridedArrayView(T* data, std::size_t size) noexcept: _data{data}, _size{size} {}
+
+        T& element(std::size_t i) const {
+            return *reinterpret_cast<T*>(static_cast<typename std::conditional<std::is_const<T>::value, const char, char>::type*>(_data) + std::ptrdiff_t(i)*stride_);
+        }
+
+        ErasedType* _data;
+        std::size_t _size;
+};
+
+/**
+@brief Iterator for @ref StaticStridedArrayView
+@m_since_latest
+
+Advances a pointer by a compile-time stride. Comparing iterators of
+different views is undefined.
+*/
+template<std::ptrdiff_t stride_, class T> class StaticStridedIterator {
+    public:
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        /*implicit*/ StaticStridedIterator(typename std::conditional<std::is_const<T>::value, const void, void>::type* data, std::size_t i) noexcept: _data{static_cast<typename std::conditional<std::is_const<T>::value, const char, char>::type*>(data) + std::ptrdiff_t(i)*stride_}, _i{i} {}
+        #endif
+
+        /** @brief Equality comparison */
+        bool operator==(StaticStridedIterator<stride_, T> other) const {
+            return _i == other._i;
+        }
+
+        /** @brief Non-equality comparison */
+        bool operator!=(StaticStridedIterator<stride_, T> other) const {
+            return _i != other._i;
+        }
+
+        /** @brief Less than comparison */
+        bool operator<(StaticStridedIterator<stride_, T> other) const {
+            return _i < other._i;
+        }
+
+        /** @brief Less than or equal comparison */
+        bool operator<=(StaticStridedIterator<stride_, T> other) const {
+            return _i <= other._i;
+        }
+
+        /** @brief Greater than comparison */
+        bool operator>(StaticStridedIterator<stride_, T> other) const {
+            return _i > other._i;
+        }
+
+        /** @brief Greater than or equal comparison */
+        bool operator>=(StaticStridedIterator<stride_, T> other) const {
+            return _i >= other._i;
+        }
+
+        /** @brief Add an offset */
+        StaticStridedIterator<stride_, T> operator+(std::ptrdiff_t i) const {
+            StaticStridedIterator<stride_, T> out{*this};
+            out._data += i*stride_;
+            out._i += i;
+            return out;
+        }
+
+        /** @brief Subtract an offset */
+        StaticStridedIterator<stride_, T> operator-(std::ptrdiff_t i) const {
+            return *this + -i;
+        }
+
+        /** @brief Iterator difference */
+        std::ptrdiff_t operator-(StaticStridedIterator<stride_, T> it) const {
+            return std::ptrdiff_t(_i) - std::ptrdiff_t(it._i);
+        }
+
+        /** @brief Go back to previous position */
+        StaticStridedIterator<stride_, T>& operator--() {
+            _data -= stride_;
+            --_i;
+            return *this;
+        }
+
+        /** @brief Advance to next position */
+        StaticStridedIterator<stride_, T>& operator++() {
+            _data += stride_;
+            ++_i;
+            return *this;
+        }
+
+        /** @brief Dereference */
+        T& operator*() const { return *reinterpret_cast<T*>(_data); }
+
+        /** @brief Dereference */
+        T* operator->() const { return reinterpret_cast<T*>(_data); }
+
+    private:
+        typename std::conditional<std::is_const<T>::value, const char, char>::type* _data;
+        std::size_t _i;
+};
+
+/** @relates StaticStridedIterator
+@brief Add static strided iterator to an offset
+@m_since_latest
+*/
+template<std::ptrdiff_t stride_, class T> inline StaticStridedIterator<stride_, T> operator+(std::ptrdiff_t i, StaticStridedIterator<stride_, T> it) {
+    return it + i;
+}
+
+}}
+
+#endif
@@ -26,11 +26,13 @@
 */
 
 /** @file
- * @brief Class @ref Corrade::Containers::StridedArrayView, @ref Corrade::Containers::StridedIterator, alias @ref Corrade::Containers::StridedArrayView1D, @ref Corrade::Containers::StridedArrayView2D, @ref Corrade::Containers::StridedArrayView3D, @ref Corrade::Containers::StridedArrayView4D
+ * @brief Class @ref Corrade::Containers::StridedArrayView, @ref Corrade::Containers::StridedIterator, alias @ref Corrade::Containers::StridedArrayView1D, @ref Corrade::Containers::StridedArrayView2D, @ref Corrade::Containers::StridedArrayView3D, @ref Corrade::Containers::StridedArrayView4D, function @ref Corrade::Containers::forEachElement(), @ref Corrade::Containers::forEachRow(), @ref Corrade::Containers::forEachZipped(), @ref Corrade::Containers::forEachTile(), @ref Corrade::Containers::forEachElementMorton()
  */
 
 #include "Corrade/Containers/ArrayView.h"
 #include "Corrade/Containers/Tags.h"
+#include "Corrade/Utility/Macros.h"
+#include "Corrade/Utility/Move.h"
 
 namespace Corrade { namespace Containers {
 
@@ -266,6 +268,41 @@ will repeat given dimension given number of times:
 
 @snippet Containers.cpp StridedArrayView-usage-broadcast
 
+@section Containers-StridedArrayView-fast-iteration Fast iteration
+
+Nested range-for loops over a multi-dimensional view create a new view for
+every row and calculate element addresses from an index and a stride, which
+the compiler often isn't able to vectorize. For tight loops over all elements
+there's @ref forEachElement(), which advances just a pointer and, if the last
+dimension is contiguous, iterates each row as a plain array with the stride
+known at compile time. A contiguous view is iterated in a single loop. If the
+last dimension is contiguous, @ref forEachRow() passes each row as an
+@ref ArrayView, allowing it to be passed to APIs operating on plain arrays:
+
+@snippet Containers.cpp StridedArrayView-usage-forEach
+
+Processing several parallel one-dimensional views by the same index, such as
+attributes in a structure-of-arrays layout, is done with
+@ref forEachZipped(). It walks all views in lockstep, telling the compiler
+that their memory doesn't alias and, if all views are contiguous, iterates
+plain arrays:
+
+@snippet Containers.cpp StridedArrayView-usage-forEachZipped
+
+Operations that touch a multi-dimensional view along more than one dimension,
+such as transpositions or filters accessing neighboring rows, are cache
+hostile when done row by row on large views. @ref forEachTile() splits the
+view into tiles of a configurable size that fit into a cache level, while
+@ref forEachElementMorton() visits the elements in a Z-order, keeping
+neighbors in all dimensions close in time without having to pick a tile size:
+
+@snippet Containers.cpp StridedArrayView-usage-forEachTile
+
+For use with STL algorithms, @ref elementsBegin() and @ref elementsEnd()
+return a @ref StridedElementIterator that goes over all elements of a
+multi-dimensional view in a row-major order, with the per-dimension carries
+precomputed.
+
 @section Containers-StridedArrayView-stl STL compatibility
 
 On compilers that support C++2a and @ref std::span, implicit conversion of it
@@ -483,7 +520,7 @@ template<unsigned dimensions, class T> class StridedArrayView {
            StaticArrayViewConverter overload as we wouldn't be able to infer
            the size parameter. Since ArrayViewConverter is supposed to handle
            conversion from statically sized arrays as well, this is okay. */
-        template<class U, unsigned d = dimensions, class = typename std::enable_if<d == 1, decltype(Implementation::ArrayViewConverter<T, typename std::decay<U&&>::type>::from(std::declval<U&&>()))>::type> constexpr /*implicit*/ StridedArrayView(U&& other) noexcept: StridedArrayView{Implementation::ArrayViewConverter<T, typename std::decay<U&&>::type>::from(std::forward<U>(other))} {}
+        template<class U, unsigned d = dimensions, class = typename std::enable_if<d == 1, decltype(Implementation::ArrayViewConverter<T, typename std::decay<U&&>::type>::from(std::declval<U&&>()))>::type> constexpr /*implicit*/ StridedArrayView(U&& other) noexcept: StridedArrayView{Implementation::ArrayViewConverter<T, typename std::decay<U&&>::type>::from(Utility::forward<U>(other))} {}
 
         /** @brief Whether the array is non-empty */
         constexpr explicit operator bool() const { return _data; }
@@ -568,6 +605,30 @@ template<unsigned dimensions, class T> class StridedArrayView {
             return {_data, _size, _stride, _size[0]};
         }
 
+        /**
+         * @brief Iterator to the first element in all dimensions
+         * @m_since_latest
+         *
+         * Goes over all elements of the view in a row-major order. See
+         * @ref StridedElementIterator and
+         * @ref Containers-StridedArrayView-fast-iteration for more
+         * information.
+         * @see @ref forEachElement()
+         */
+        StridedElementIterator<dimensions, T> elementsBegin() const {
+            return {_data, _size, _stride, false};
+        }
+
+        /**
+         * @brief Iterator to (one item after) the last element in all dimensions
+         * @m_since_latest
+         *
+         * @see @ref elementsBegin()
+         */
+        StridedElementIterator<dimensions, T> elementsEnd() const {
+            return {_data, _size, _stride, true};
+        }
+
         /**
          * @brief First element
          *
@@ -1334,7 +1395,7 @@ template<unsigned dimensions, class T> constexpr StridedArrayView<dimensions, T>
    e.g. std::vector<T>&& because that would break uses like `consume(foo());`,
    where `consume()` expects a view but `foo()` returns a std::vector. */
 template<class T, class U = decltype(stridedArrayView(Implementation::ErasedArrayViewConverter<typename std::remove_reference<T&&>::type>::from(std::declval<T&&>())))> constexpr U stridedArrayView(T&& other) {
-    return Implementation::ErasedArrayViewConverter<typename std::remove_reference<T&&>::type>::from(std::forward<T>(other));
+    return Implementation::ErasedArrayViewConverter<typename std::remove_reference<T&&>::type>::from(Utility::forward<T>(other));
 }
 
 /** @relatesalso StridedArrayView
@@ -1572,6 +1633,159 @@ template<unsigned dimensions, class T> inline StridedIterator<dimensions, T> ope
     return it + i;
 }
 
+/**
+@brief Strided array view element iterator
+@m_since_latest
+
+Goes over all elements of a multi-dimensional @ref StridedArrayView in a
+row-major order, as if it was flattened. Compared to nested
+@ref StridedIterator instances, which calculate the element address from an
+index and a stride on every access, this iterator advances a single pointer.
+The offsets for moving from the end of one row to the beginning of the next
+are precomputed, so crossing into the next row or slice is a pointer addition
+as well. Returned by @ref StridedArrayView::elementsBegin() and
+@ref StridedArrayView::elementsEnd(). Comparing iterators of different views
+is undefined.
+
+For tight loops prefer @ref forEachElement(), which additionally takes
+advantage of rows that are contiguous in memory.
+*/
+template<unsigned dimensions, class T> class StridedElementIterator {
+    public:
+        /** @brief Underlying type */
+        typedef T Type;
+
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        /*implicit*/ StridedElementIterator(typename std::conditional<std::is_const<T>::value, const void, void>::type* data, const StridedDimensions<dimensions, std::size_t>& size, const StridedDimensions<dimensions, std::ptrdiff_t>& stride, bool end) noexcept;
+        #endif
+
+        /** @brief Equality comparison */
+        bool operator==(const StridedElementIterator<dimensions, T>& other) const {
+            return _i == other._i;
+        }
+
+        /** @brief Non-equality comparison */
+        bool operator!=(const StridedElementIterator<dimensions, T>& other) const {
+            return _i != other._i;
+        }
+
+        /** @brief Advance to next position */
+        StridedElementIterator<dimensions, T>& operator++() {
+            ++_i;
+            std::size_t dimension = dimensions - 1;
+            _data += _carry[dimension];
+            while(++_counter[dimension] == _size[dimension] && dimension) {
+                _counter[dimension] = 0;
+                --dimension;
+                _data += _carry[dimension];
+            }
+            return *this;
+        }
+
+        /** @brief Dereference */
+        T& operator*() const { return *reinterpret_cast<T*>(_data); }
+
+        /** @brief Dereference */
+        T* operator->() const { return reinterpret_cast<T*>(_data); }
+
+    private:
+        typename std::conditional<std::is_const<T>::value, const char, char>::type* _data;
+        std::size_t _size[dimensions];
+        std::size_t _counter[dimensions];
+        /* Stride in the last dimension, in the others the offset from the
+           end of the next dimension to the next element in this one */
+        std::ptrdiff_t _carry[dimensions];
+        std::size_t _i;
+};
+
+template<unsigned dimensions, class T> StridedElementIterator<dimensions, T>::StridedElementIterator(typename std::conditional<std::is_const<T>::value, const void, void>::type* const data, const StridedDimensions<dimensions, std::size_t>& size, const StridedDimensions<dimensions, std::ptrdiff_t>& stride, const bool end) noexcept: _data{static_cast<typename std::conditional<std::is_const<T>::value, const char, char>::type*>(data)}, _i{0} {
+    std::size_t count = 1;
+    for(std::size_t i = 0; i != dimensions; ++i) {
+        _size[i] = size[i];
+        _counter[i] = 0;
+        _carry[i] = i == dimensions - 1 ? stride[i] : stride[i] - std::ptrdiff_t(size[i + 1])*stride[i + 1];
+        count *= size[i];
+    }
+    if(end) _i = count;
+}
+
+/**
+@brief Call a function for each element of a strided view
+@m_since_latest
+
+Calls @p f with a reference to each element of @p view in a row-major order.
+If the view is contiguous, it's iterated as a single plain array. Otherwise,
+if the last dimension is contiguous, each row is iterated as a plain array,
+advancing a @cpp T* @ce pointer, which the compiler can vectorize. In the
+remaining cases the element pointer is advanced by the stride. In all cases
+the outer dimensions are iterated by advancing a pointer as well, without
+creating any intermediate views. See
+@ref Containers-StridedArrayView-fast-iteration for an example.
+@see @ref forEachRow(), @ref StridedArrayView::elementsBegin()
+*/
+template<unsigned dimensions, class T, class F> void forEachElement(const StridedArrayView<dimensions, T>& view, F&& f);
+
+/**
+@brief Call a function for each contiguous row of a strided view
+@m_since_latest
+
+Calls @p f with an @ref ArrayView of each row of the last dimension of
+@p view, in a row-major order. Expects that the last dimension is contiguous,
+i.e. that @ref StridedArrayView::isContiguous() "StridedArrayView::isContiguous<dimensions - 1>()"
+is @cpp true @ce. See @ref Containers-StridedArrayView-fast-iteration for an
+example.
+@see @ref forEachElement(), @ref forEachZipped()
+*/
+template<unsigned dimensions, class T, class F> void forEachRow(const StridedArrayView<dimensions, T>& view, F&& f);
+
+/**
+@brief Call a function for each element of several one-dimensional views in lockstep
+@m_since_latest
+
+Calls @p f with a reference to the @f$ i @f$-th element of all views, in
+order, for all @f$ i @f$ from @cpp 0 @ce to the view size. Expects that all
+views have the same size. The data pointers are passed to the loop annotated
+with @ref CORRADE_RESTRICT, which allows the compiler to vectorize the loop
+body --- but it also means views that are written to are expected to not
+overlap with any other view, otherwise the behavior is undefined. If all views
+are contiguous, they're iterated as plain arrays, otherwise each element
+address is calculated from the index and a stride fetched from a local
+array. See @ref Containers-StridedArrayView-fast-iteration for an example.
+@see @ref forEachElement(), @ref StridedArrayView::isContiguous()
+*/
+template<class F, class T, class ...U> void forEachZipped(F&& f, const StridedArrayView1D<T>& first, const StridedArrayView1D<U>&... next);
+
+/**
+@brief Call a function for each tile of a strided view
+@m_since_latest
+
+Splits @p view into tiles of @p tileSize and calls @p f with the offset of
+each tile and a @ref StridedArrayView slice containing it, in a row-major
+order of the tiles. Tiles at the end of each dimension are smaller if the
+view size isn't divisible by the tile size. Expects that all tile sizes are
+non-zero. Useful for cache blocking --- pick the tile size so a tile of the
+source and the destination fits into a L1 or L2 cache. See
+@ref Containers-StridedArrayView-fast-iteration for an example.
+@see @ref forEachElementMorton()
+*/
+template<unsigned dimensions, class T, class F> void forEachTile(const StridedArrayView<dimensions, T>& view, const StridedDimensions<dimensions, std::size_t>& tileSize, F&& f);
+
+/**
+@brief Call a function for each element of a strided view in a Z-order
+@m_since_latest
+
+Calls @p f with the position of each element and a reference to it, visiting
+the elements in a Z-order (Morton order) --- the view is recursively split
+into halves in all dimensions at power-of-two boundaries and the parts are
+visited in a row-major order. Elements that are close in any dimension are
+thus visited close to each other in time, making this a cache-oblivious
+alternative to @ref forEachTile(). The recursion stops at blocks of
+@f$ 8^d @f$ elements, which are iterated in a row-major order. See
+@ref Containers-StridedArrayView-fast-iteration for an example.
+@see @ref forEachElement()
+*/
+template<unsigned dimensions, class T, class F> void forEachElementMorton(const StridedArrayView<dimensions, T>& view, F&& f);
+
 template<unsigned dimensions, class T> template<unsigned dimension> bool StridedArrayView<dimensions, T>::isContiguous() const {
     static_assert(dimension < dimensions, "dimension out of bounds");
     std::size_t nextDimensionSize = sizeof(T);
@@ -1591,6 +1805,22 @@ template<unsigned dimensions, class T> ArrayView<T> StridedArrayView<dimensions,
 }
 
 namespace Implementation {
+    /* Calls f with a pointer to the beginning of each row of the last
+       dimension, advancing a pointer in all others */
+    template<unsigned remaining> struct StridedRows {
+        template<unsigned dimensions, class Char, class F> static void call(Char* data, const StridedDimensions<dimensions, std::size_t>& size, const StridedDimensions<dimensions, std::ptrdiff_t>& stride, F& f) {
+            const std::size_t count = size[dimensions - remaining];
+            const std::ptrdiff_t step = stride[dimensions - remaining];
+            for(std::size_t i = 0; i != count; ++i, data += step)
+                StridedRows<remaining - 1>::call(data, size, stride, f);
+        }
+    };
+    template<> struct StridedRows<1> {
+        template<unsigned dimensions, class Char, class F> static void call(Char* data, const StridedDimensions<dimensions, std::size_t>&, const StridedDimensions<dimensions, std::ptrdiff_t>&, F& f) {
+            f(data);
+        }
+    };
+
     template<unsigned dimensions, class T> struct StridedElement {
         static StridedArrayView<dimensions - 1, T> get(typename std::conditional<std::is_const<T>::value, const void, void>::type* data, const StridedDimensions<dimensions, std::size_t>& size, const StridedDimensions<dimensions, std::ptrdiff_t>& stride, std::size_t i) {
             return StridedArrayView<dimensions - 1, T>{
@@ -1606,6 +1836,177 @@ namespace Implementation {
     };
 }
 
+template<unsigned dimensions, class T, class F> void forEachElement(const StridedArrayView<dimensions, T>& view, F&& f) {
+    typedef typename std::conditional<std::is_const<T>::value, const char, char>::type Char;
+
+    /* A contiguous view is a single loop */
+    if(view.isContiguous()) {
+        for(T& i: view.asContiguous()) f(i);
+        return;
+    }
+
+    const typename StridedArrayView<dimensions, T>::Size size = view.size();
+    const typename StridedArrayView<dimensions, T>::Stride stride = view.stride();
+    const std::size_t rowSize = size[dimensions - 1];
+    const std::ptrdiff_t rowStride = stride[dimensions - 1];
+
+    /* Contiguous rows are iterated with a compile-time stride */
+    if(rowStride == std::ptrdiff_t(sizeof(T))) {
+        auto row = [&f, rowSize](Char* data) {
+            for(T *i = reinterpret_cast<T*>(data), *end = i + rowSize; i != end; ++i)
+                f(*i);
+        };
+        Implementation::StridedRows<dimensions>::call(static_cast<Char*>(view.data()), size, stride, row);
+    } else {
+        auto row = [&f, rowSize, rowStride](Char* data) {
+            for(std::size_t i = 0; i != rowSize; ++i, data += rowStride)
+                f(*reinterpret_cast<T*>(data));
+        };
+        Implementation::StridedRows<dimensions>::call(static_cast<Char*>(view.data()), size, stride, row);
+    }
+}
+
+template<unsigned dimensions, class T, class F> void forEachRow(const StridedArrayView<dimensions, T>& view, F&& f) {
+    typedef typename std::conditional<std::is_const<T>::value, const char, char>::type Char;
+    CORRADE_ASSERT(view.template isContiguous<dimensions - 1>(),
+        "Containers::forEachRow(): the last dimension is not contiguous", );
+
+    const typename StridedArrayView<dimensions, T>::Size size = view.size();
+    const std::size_t rowSize = size[dimensions - 1];
+    auto row = [&f, rowSize](Char* data) {
+        f(ArrayView<T>{reinterpret_cast<T*>(data), rowSize});
+    };
+    Implementation::StridedRows<dimensions>::call(static_cast<Char*>(view.data()), size, typename StridedArrayView<dimensions, T>::Stride(view.stride()), row);
+}
+
+namespace Implementation {
+    template<class F, class ...T> void forEachZippedContiguous(F& f, const std::size_t size, T* CORRADE_RESTRICT... data) {
+        for(std::size_t i = 0; i != size; ++i) f(data[i]...);
+    }
+
+    template<class T> inline T& stridedElement(T* const data, const std::ptrdiff_t offset) {
+        return *reinterpret_cast<T*>(reinterpret_cast<typename std::conditional<std::is_const<T>::value, const char, char>::type*>(data) + offset);
+    }
+
+    template<class F, std::size_t ...sequence, class ...T> void forEachZippedStrided(F& f, Sequence<sequence...>, const std::size_t size, const std::ptrdiff_t* const strides, T* CORRADE_RESTRICT... data) {
+        for(std::size_t i = 0; i != size; ++i)
+            f(stridedElement(data, std::ptrdiff_t(i)*strides[sequence])...);
+    }
+}
+
+template<class F, class T, class ...U> void forEachZipped(F&& f, const StridedArrayView1D<T>& first, const StridedArrayView1D<U>&... next) {
+    const std::size_t size = first.size();
+    #ifndef CORRADE_NO_ASSERT
+    const std::size_t sizes[]{size, next.size()...};
+    for(std::size_t i = 1; i != sizeof...(U) + 1; ++i)
+        CORRADE_ASSERT(sizes[i] == size,
+            "Containers::forEachZipped(): expected view" << i << "to have" << size << "elements but got" << sizes[i], );
+    #endif
+
+    /* All contiguous, iterate plain arrays */
+    const std::ptrdiff_t strides[]{first.stride(), next.stride()...};
+    const std::size_t elementSizes[]{sizeof(T), sizeof(U)...};
+    bool contiguous = true;
+    for(std::size_t i = 0; i != sizeof...(U) + 1; ++i)
+        if(strides[i] != std::ptrdiff_t(elementSizes[i])) contiguous = false;
+    if(contiguous)
+        Implementation::forEachZippedContiguous(f, size, static_cast<T*>(first.data()), static_cast<U*>(next.data())...);
+    else
+        Implementation::forEachZippedStrided(f, typename Implementation::GenerateSequence<sizeof...(U) + 1>::Type{}, size, strides, static_cast<T*>(first.data()), static_cast<U*>(next.data())...);
+}
+
+namespace Implementation {
+    /* Calls f with each tile, iterating dimensions from the first */
+    template<unsigned remaining> struct StridedTiles {
+        template<unsigned dimensions, class T, class F> static void call(const StridedArrayView<dimensions, T>& view, const StridedDimensions<dimensions, std::size_t>& size, const StridedDimensions<dimensions, std::size_t>& tileSize, StridedDimensions<dimensions, std::size_t>& begin, StridedDimensions<dimensions, std::size_t>& end, F& f) {
+            constexpr unsigned dimension = dimensions - remaining;
+            for(std::size_t i = 0; i < size[dimension]; i += tileSize[dimension]) {
+                begin[dimension] = i;
+                end[dimension] = size[dimension] - i < tileSize[dimension] ?
+                    size[dimension] : i + tileSize[dimension];
+                StridedTiles<remaining - 1>::call(view, size, tileSize, begin, end, f);
+            }
+        }
+    };
+    template<> struct StridedTiles<0> {
+        template<unsigned dimensions, class T, class F> static void call(const StridedArrayView<dimensions, T>& view, const StridedDimensions<dimensions, std::size_t>&, const StridedDimensions<dimensions, std::size_t>&, StridedDimensions<dimensions, std::size_t>& begin, StridedDimensions<dimensions, std::size_t>& end, F& f) {
+            f(const_cast<const StridedDimensions<dimensions, std::size_t>&>(begin), view.slice(begin, end));
+        }
+    };
+
+    /* Blocks of this size in all dimensions are iterated in a row-major
+       order */
+    enum: std::size_t { MortonLeafSize = 8 };
+
+    template<unsigned dimensions, class T, class F> void forEachElementMortonInternal(typename std::conditional<std::is_const<T>::value, const char, char>::type* const data, const StridedDimensions<dimensions, std::ptrdiff_t>& stride, const StridedDimensions<dimensions, std::size_t>& offset, const StridedDimensions<dimensions, std::size_t>& size, const std::size_t level, F& f) {
+        /* Leaf block, iterate in a row-major order, advancing the position
+           like an odometer */
+        if(level <= MortonLeafSize) {
+            StridedDimensions<dimensions, std::size_t> position = offset;
+            for(;;) {
+                auto* element = data;
+                for(std::size_t i = 0; i != dimensions; ++i)
+                    element += std::ptrdiff_t(position[i])*stride[i];
+                f(const_cast<const StridedDimensions<dimensions, std::size_t>&>(position), *reinterpret_cast<T*>(element));
+
+                std::size_t dimension = dimensions;
+                for(; dimension; --dimension) {
+                    if(++position[dimension - 1] != offset[dimension - 1] + size[dimension - 1]) break;
+                    position[dimension - 1] = offset[dimension - 1];
+                }
+                if(!dimension) return;
+            }
+        }
+
+        /* Split all dimensions in half, with the last dimension being the
+           least significant bit of the Z-order index */
+        const std::size_t half = level/2;
+        for(std::size_t part = 0; part != (std::size_t{1} << dimensions); ++part) {
+            StridedDimensions<dimensions, std::size_t> partOffset = offset;
+            StridedDimensions<dimensions, std::size_t> partSize;
+            bool empty = false;
+            for(std::size_t i = 0; i != dimensions; ++i) {
+                const std::size_t begin = part & (std::size_t{1} << (dimensions - i - 1)) ? half : 0;
+                if(begin >= size[i]) {
+                    empty = true;
+                    break;
+                }
+                partOffset[i] += begin;
+                partSize[i] = size[i] - begin < half ? size[i] - begin : half;
+            }
+            if(!empty)
+                forEachElementMortonInternal<dimensions, T>(data, stride, partOffset, partSize, half, f);
+        }
+    }
+}
+
+template<unsigned dimensions, class T, class F> void forEachTile(const StridedArrayView<dimensions, T>& view, const StridedDimensions<dimensions, std::size_t>& tileSize, F&& f) {
+    #ifndef CORRADE_NO_ASSERT
+    for(std::size_t i = 0; i != dimensions; ++i)
+        CORRADE_ASSERT(tileSize[i],
+            "Containers::forEachTile(): expected a non-zero tile size but got" << tileSize, );
+    #endif
+
+    StridedDimensions<dimensions, std::size_t> begin;
+    StridedDimensions<dimensions, std::size_t> end;
+    Implementation::StridedTiles<dimensions>::call(view, typename StridedArrayView<dimensions, T>::Size(view.size()), tileSize, begin, end, f);
+}
+
+template<unsigned dimensions, class T, class F> void forEachElementMorton(const StridedArrayView<dimensions, T>& view, F&& f) {
+    const typename StridedArrayView<dimensions, T>::Size size = view.size();
+    std::size_t max = 0;
+    for(std::size_t i = 0; i != dimensions; ++i) {
+        if(!size[i]) return;
+        if(size[i] > max) max = size[i];
+    }
+
+    /* Smallest power of two containing the whole view */
+    std::size_t level = 1;
+    while(level < max) level *= 2;
+
+    Implementation::forEachElementMortonInternal<dimensions, T>(static_cast<typename std::conditional<std::is_const<T>::value, const char, char>::type*>(view.data()), typename StridedArrayView<dimensions, T>::Stride(view.stride()), {}, size, level, f);
+}
+
 template<unsigned dimensions, class T> auto StridedArrayView<dimensions, T>::operator[](const std::size_t i) const -> ElementType {
     CORRADE_ASSERT(i < _size._data[0], "Containers::StridedArrayView::operator[](): index" << i << "out of range for" << _size._data[0] << "elements", (Implementation::StridedElement<dimensions, T>::get(_data, _size, _stride, i)));
     return Implementation::StridedElement<dimensions, T>::get(_data, _size, _stride, i);
@@ -1709,8 +2110,8 @@ template<unsigned dimensions, class T> template<unsigned dimensionA, unsigned di
 
     Size size = _size;
     Stride stride = _stride;
-    std::swap(size._data[dimensionA], size._data[dimensionB]);
-    std::swap(stride._data[dimensionA], stride._data[dimensionB]);
+    Utility::swap(size._data[dimensionA], size._data[dimensionB]);
+    Utility::swap(stride._data[dimensionA], stride._data[dimensionB]);
     return StridedArrayView{size, stride, _data};
 }
 
@@ -0,0 +1,232 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "String.h"
+
+#include <cstring>
+
+namespace Corrade { namespace Containers {
+
+static_assert(sizeof(String) == 3*sizeof(std::size_t),
+    "unexpected String size");
+
+String::String() noexcept {
+    _small.data[0] = '\0';
+    _small.size = SmallFlag;
+}
+
+String::String(const StringView view): String{view.data(), view.size()} {}
+
+String::String(const MutableStringView view): String{view.data(), view.size()} {}
+
+String::String(const char* const data): String{StringView{data}} {}
+
+String::String(const char* const data, const std::size_t size) {
+    /* Make the instance valid even if the assertion below returns */
+    _small.data[0] = '\0';
+    _small.size = SmallFlag;
+    CORRADE_ASSERT(data || !size,
+        "Containers::String: received a null string of size" << size, );
+    construct(data, size);
+}
+
+String::String(char* const data, const std::size_t size, const Deleter deleter) noexcept {
+    _small.data[0] = '\0';
+    _small.size = SmallFlag;
+    CORRADE_ASSERT(data && data[size] == '\0',
+        "Containers::String: can only take ownership of a non-null null-terminated array", );
+    _large.data = data;
+    _large.size = size;
+    _large.deleter = deleter;
+}
+
+String::String(ValueInitT, const std::size_t size) {
+    construct(NoInit, size);
+    std::memset(data(), 0, this->size());
+}
+
+String::String(NoInitT, const std::size_t size) {
+    construct(NoInit, size);
+}
+
+String::String(const String& other) {
+    construct(other.data(), other.size());
+}
+
+String::String(String&& other) noexcept {
+    /* The union is trivially copyable, so just copy it whole and make the
+       other instance an empty inline string so it doesn't delete anything */
+    std::memcpy(reinterpret_cast<char*>(this), reinterpret_cast<const char*>(&other), sizeof(String));
+    other._small.data[0] = '\0';
+    other._small.size = SmallFlag;
+}
+
+String::~String() { destruct(); }
+
+String& String::operator=(const String& other) {
+    if(&other == this) return *this;
+    destruct();
+    construct(other.data(), other.size());
+    return *this;
+}
+
+String& String::operator=(String&& other) noexcept {
+    char storage[sizeof(String)];
+    std::memcpy(storage, reinterpret_cast<const char*>(this), sizeof(String));
+    std::memcpy(reinterpret_cast<char*>(this), reinterpret_cast<const char*>(&other), sizeof(String));
+    std::memcpy(reinterpret_cast<char*>(&other), storage, sizeof(String));
+    return *this;
+}
+
+void String::construct(const char* const data, const std::size_t size) {
+    construct(NoInit, size);
+    /* memcpy() with a null pointer is UB even for zero size. Using size()
+       and not size in case construct() above failed an assertion. */
+    if(size) std::memcpy(this->data(), data, this->size());
+}
+
+void String::construct(NoInitT, const std::size_t size) {
+    if(size < SmallSize) {
+        _small.data[size] = '\0';
+        _small.size = std::uint8_t(size | SmallFlag);
+    } else {
+        _small.data[0] = '\0';
+        _small.size = SmallFlag;
+        CORRADE_ASSERT(!(size >> (sizeof(std::size_t)*8 - 1)),
+            "Containers::String: string expected to be smaller than 2^" << Utility::Debug::nospace << sizeof(std::size_t)*8 - 1 << "bytes, got" << size, );
+        _large.data = new char[size + 1];
+        _large.data[size] = '\0';
+        _large.size = size;
+        _large.deleter = nullptr;
+    }
+}
+
+void String::destruct() {
+    if(isSmall()) return;
+    if(_large.deleter) _large.deleter(_large.data, _large.size);
+    else delete[] _large.data;
+}
+
+String::operator StringView() const noexcept {
+    return {data(), size()};
+}
+
+String::operator MutableStringView() noexcept {
+    return {data(), size()};
+}
+
+String::operator ArrayView<const char>() const noexcept {
+    return {data(), size()};
+}
+
+String::operator ArrayView<char>() noexcept {
+    return {data(), size()};
+}
+
+char& String::front() {
+    CORRADE_ASSERT(size(), "Containers::String::front(): string is empty", data()[0]);
+    return data()[0];
+}
+
+char String::front() const {
+    return const_cast<String&>(*this).front();
+}
+
+char& String::back() {
+    const std::size_t size = this->size();
+    CORRADE_ASSERT(size, "Containers::String::back(): string is empty", data()[size - 1]);
+    return data()[size - 1];
+}
+
+char String::back() const {
+    return const_cast<String&>(*this).back();
+}
+
+MutableStringView String::slice(char* const begin, char* const end) {
+    return MutableStringView{*this}.slice(begin, end);
+}
+
+StringView String::slice(const char* const begin, const char* const end) const {
+    return StringView{*this}.slice(begin, end);
+}
+
+MutableStringView String::slice(const std::size_t begin, const std::size_t end) {
+    return MutableStringView{*this}.slice(begin, end);
+}
+
+StringView String::slice(const std::size_t begin, const std::size_t end) const {
+    return StringView{*this}.slice(begin, end);
+}
+
+MutableStringView String::prefix(char* const end) {
+    return MutableStringView{*this}.prefix(end);
+}
+
+StringView String::prefix(const char* const end) const {
+    return StringView{*this}.prefix(end);
+}
+
+MutableStringView String::prefix(const std::size_t end) {
+    return MutableStringView{*this}.prefix(end);
+}
+
+StringView String::prefix(const std::size_t end) const {
+    return StringView{*this}.prefix(end);
+}
+
+MutableStringView String::suffix(char* const begin) {
+    return MutableStringView{*this}.suffix(begin);
+}
+
+StringView String::suffix(const char* const begin) const {
+    return StringView{*this}.suffix(begin);
+}
+
+MutableStringView String::suffix(const std::size_t begin) {
+    return MutableStringView{*this}.suffix(begin);
+}
+
+StringView String::suffix(const std::size_t begin) const {
+    return StringView{*this}.suffix(begin);
+}
+
+MutableStringView String::except(const std::size_t count) {
+    return MutableStringView{*this}.except(count);
+}
+
+StringView String::except(const std::size_t count) const {
+    return StringView{*this}.except(count);
+}
+
+char* String::release() {
+    CORRADE_ASSERT(!isSmall(),
+        "Containers::String::release(): cannot call on a SSO instance", {});
+    char* const data = _large.data;
+    _small.data[0] = '\0';
+    _small.size = SmallFlag;
+    return data;
+}
+
+}}
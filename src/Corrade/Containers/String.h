@@ -0,0 +1,361 @@
+#ifndef Corrade_Containers_String_h
+#define Corrade_Containers_String_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Containers::String
+ */
+
+#include <cstdint>
+#include <type_traits>
+
+#include "Corrade/Containers/StringView.h"
+#include "Corrade/Containers/Tags.h"
+#include "Corrade/Utility/Move.h"
+
+namespace Corrade { namespace Containers {
+
+namespace Implementation {
+    template<class> struct StringConverter;
+}
+
+/**
+@brief String
+
+An owning, always null-terminated counterpart to @ref StringView with a
+small string optimization. Strings up to @cpp sizeof(String) - 2 @ce bytes
+(so 22 on 64-bit and 10 on 32-bit platforms) are stored inline instead of
+being allocated, which makes creating and copying short strings
+allocation-free. The class is always
+three pointers large.
+
+@snippet Containers.cpp String
+
+@section Containers-String-usage Usage
+
+A string can be constructed from a @ref StringView, a C string or a pointer
+and a size, in which case the data are copied. The
+@ref String(char*, std::size_t, Deleter) constructor takes ownership of an
+existing allocation instead, similarly to @ref Array. The
+@ref String(ValueInitT, std::size_t) and @ref String(NoInitT, std::size_t)
+constructors allocate a string of given size to be filled later.
+
+The string is implicitly convertible to @ref StringView,
+@ref MutableStringView and @ref ArrayView. All string algorithms are provided
+by @ref BasicStringView, the @ref slice(), @ref prefix(), @ref suffix() and
+@ref except() functions return views as well:
+
+@snippet Containers.cpp String-algorithms
+
+@section Containers-String-stl STL compatibility
+
+Instances of @ref String are implicitly convertible from and to
+@ref std::string if you include @ref Corrade/Containers/StringStl.h. The
+conversion involves copying the data.
+*/
+class CORRADE_UTILITY_EXPORT String {
+    public:
+        /**
+         * @brief Deleter type
+         *
+         * Called with the data pointer and size on destruction. The size
+         * doesn't include the null terminator.
+         */
+        typedef void(*Deleter)(char*, std::size_t);
+
+        /**
+         * @brief Default constructor
+         *
+         * Creates an empty string, stored inline.
+         */
+        /*implicit*/ String() noexcept;
+
+        /**
+         * @brief Construct from a string view
+         *
+         * Copies the data. If the view size fits, the data are stored inline,
+         * otherwise allocated.
+         */
+        /*implicit*/ String(StringView view);
+
+        /** @overload */
+        /*implicit*/ String(MutableStringView view);
+
+        /**
+         * @brief Construct from a null-terminated C string
+         *
+         * Equivalent to @ref String(StringView). A @cpp nullptr @ce creates
+         * an empty string.
+         */
+        /*implicit*/ String(const char* data);
+
+        /**
+         * @brief Construct from a pointer and size
+         *
+         * Equivalent to @ref String(StringView).
+         */
+        /*implicit*/ String(const char* data, std::size_t size);
+
+        /**
+         * @brief Take ownership of an external data array
+         * @param data      String data
+         * @param size      Size of the string, excluding the null terminator
+         * @param deleter   Deleter, used on destruction. Use
+         *      @cpp nullptr @ce for data allocated with @cpp new[] @ce.
+         *
+         * Expects that @p data is not @cpp nullptr @ce and is
+         * null-terminated, i.e. @cpp data[size] == '\0' @ce. The data are
+         * not copied and not stored inline even if they'd fit.
+         */
+        explicit String(char* data, std::size_t size, Deleter deleter) noexcept;
+
+        /**
+         * @brief Create a zero-initialized string of given size
+         *
+         * The string is stored inline if it fits, allocated otherwise. A
+         * null terminator is put after the @p size bytes.
+         */
+        explicit String(ValueInitT, std::size_t size);
+
+        /**
+         * @brief Create an uninitialized string of given size
+         *
+         * Same as @ref String(ValueInitT, std::size_t) except for the
+         * contents being left uninitialized. The null terminator is still
+         * written.
+         */
+        explicit String(NoInitT, std::size_t size);
+
+        /**
+         * @brief Construct from an external type
+         *
+         * @see @ref Containers-String-stl
+         */
+        template<class U, class = decltype(Implementation::StringConverter<typename std::decay<U&&>::type>::from(std::declval<U&&>()))> /*implicit*/ String(U&& other): String{Implementation::StringConverter<typename std::decay<U&&>::type>::from(Utility::forward<U>(other))} {}
+
+        /** @brief Copy constructor */
+        String(const String& other);
+
+        /** @brief Move constructor */
+        String(String&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Calls the deleter on allocated data.
+         */
+        ~String();
+
+        /** @brief Copy assignment */
+        String& operator=(const String& other);
+
+        /** @brief Move assignment */
+        String& operator=(String&& other) noexcept;
+
+        /**
+         * @brief Convert to an external type
+         *
+         * @see @ref Containers-String-stl
+         */
+        template<class U, class = decltype(Implementation::StringConverter<U>::to(std::declval<const String&>()))> /*implicit*/ operator U() const {
+            return Implementation::StringConverter<U>::to(*this);
+        }
+
+        /** @brief Convert to a @ref StringView */
+        /*implicit*/ operator StringView() const noexcept;
+
+        /** @brief Convert to a @ref MutableStringView */
+        /*implicit*/ operator MutableStringView() noexcept;
+
+        /** @brief Convert to a const @ref ArrayView */
+        /*implicit*/ operator ArrayView<const char>() const noexcept;
+
+        /** @brief Convert to an @ref ArrayView */
+        /*implicit*/ operator ArrayView<char>() noexcept;
+
+        /**
+         * @brief Whether the string is stored inline
+         *
+         * @see @ref Containers-String-usage
+         */
+        bool isSmall() const {
+            return _small.size & SmallFlag;
+        }
+
+        /**
+         * @brief String data
+         *
+         * The pointer is never @cpp nullptr @ce and the data are always
+         * null-terminated.
+         */
+        char* data() {
+            return isSmall() ? _small.data : _large.data;
+        }
+
+        /** @overload */
+        const char* data() const {
+            return isSmall() ? _small.data : _large.data;
+        }
+
+        /** @brief String size, excluding the null terminator */
+        std::size_t size() const {
+            return isSmall() ? std::size_t(_small.size & ~SmallFlag) : _large.size;
+        }
+
+        /** @brief Whether the string is empty */
+        bool empty() const { return !size(); }
+
+        /**
+         * @brief String deleter
+         *
+         * If the string is stored inline or allocated with
+         * @cpp new[] @ce, returns @cpp nullptr @ce.
+         */
+        Deleter deleter() const {
+            return isSmall() ? nullptr : _large.deleter;
+        }
+
+        /** @brief Pointer to the first byte */
+        char* begin() { return data(); }
+        const char* begin() const { return data(); } /**< @overload */
+        const char* cbegin() const { return data(); } /**< @overload */
+
+        /** @brief Pointer to (one item after) the last byte */
+        char* end() { return data() + size(); }
+        const char* end() const { return data() + size(); } /**< @overload */
+        const char* cend() const { return data() + size(); } /**< @overload */
+
+        /**
+         * @brief First byte
+         *
+         * Expects there is at least one byte.
+         */
+        char& front();
+        char front() const; /**< @overload */
+
+        /**
+         * @brief Last byte
+         *
+         * Expects there is at least one byte.
+         */
+        char& back();
+        char back() const; /**< @overload */
+
+        /** @brief Element access */
+        char& operator[](std::size_t i) { return data()[i]; }
+        char operator[](std::size_t i) const { return data()[i]; } /**< @overload */
+
+        /**
+         * @brief String slice
+         *
+         * Equivalent to @ref BasicStringView::slice().
+         */
+        MutableStringView slice(char* begin, char* end);
+        StringView slice(const char* begin, const char* end) const; /**< @overload */
+        MutableStringView slice(std::size_t begin, std::size_t end); /**< @overload */
+        StringView slice(std::size_t begin, std::size_t end) const; /**< @overload */
+
+        /**
+         * @brief String prefix
+         *
+         * Equivalent to @ref BasicStringView::prefix().
+         */
+        MutableStringView prefix(char* end);
+        StringView prefix(const char* end) const; /**< @overload */
+        MutableStringView prefix(std::size_t end); /**< @overload */
+        StringView prefix(std::size_t end) const; /**< @overload */
+
+        /**
+         * @brief String suffix
+         *
+         * Equivalent to @ref BasicStringView::suffix().
+         */
+        MutableStringView suffix(char* begin);
+        StringView suffix(const char* begin) const; /**< @overload */
+        MutableStringView suffix(std::size_t begin); /**< @overload */
+        StringView suffix(std::size_t begin) const; /**< @overload */
+
+        /**
+         * @brief String prefix except the last @p count bytes
+         *
+         * Equivalent to @ref BasicStringView::except().
+         */
+        MutableStringView except(std::size_t count);
+        StringView except(std::size_t count) const; /**< @overload */
+
+        /**
+         * @brief Release data storage
+         *
+         * Returns the data pointer and resets the string to an empty inline
+         * state. The deleter is then the user responsibility. Expects that
+         * the string is not stored inline, as there would be nothing to
+         * release.
+         * @see @ref deleter(), @ref isSmall()
+         */
+        char* release();
+
+    private:
+        CORRADE_UTILITY_LOCAL void construct(const char* data, std::size_t size);
+        CORRADE_UTILITY_LOCAL void construct(NoInitT, std::size_t size);
+        CORRADE_UTILITY_LOCAL void destruct();
+
+        /* The last byte of the inline storage overlaps with the most
+           significant byte of the allocated size, which means allocated
+           strings can't be larger than 2^(n-1) in order to keep the flag
+           unambiguous. */
+        enum: std::size_t { SmallSize = sizeof(std::size_t)*3 - 1 };
+        enum: std::uint8_t { SmallFlag = 0x80 };
+
+        #ifndef CORRADE_TARGET_BIG_ENDIAN
+        struct Small {
+            char data[SmallSize];
+            std::uint8_t size;
+        };
+        struct Large {
+            char* data;
+            Deleter deleter;
+            std::size_t size;
+        };
+        #else
+        struct Small {
+            std::uint8_t size;
+            char data[SmallSize];
+        };
+        struct Large {
+            std::size_t size;
+            char* data;
+            Deleter deleter;
+        };
+        #endif
+        union {
+            Small _small;
+            Large _large;
+        };
+};
+
+}}
+
+#endif
@@ -0,0 +1,625 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "StringView.h"
+
+#include <cstdint>
+#include <cstring>
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Containers/GrowableArray.h"
+#include "Corrade/Containers/StaticArray.h"
+#include "Corrade/Containers/String.h"
+#include "Corrade/Utility/Cpu.h"
+
+#ifdef CORRADE_TARGET_X86
+#include <immintrin.h>
+#endif
+#ifdef __ARM_NEON
+#include <arm_neon.h>
+#endif
+#ifdef CORRADE_TARGET_MSVC
+#include <intrin.h>
+#endif
+
+namespace Corrade { namespace Containers {
+
+namespace {
+
+constexpr StringView Whitespace{" \t\f\v\r\n", 6};
+
+/* A 256-bit set of characters, so checking whether a character is one of
+   the delimiters is a constant-time lookup instead of a loop over the
+   delimiter string for every character */
+struct CharacterSet {
+    explicit CharacterSet(const StringView characters): bits{} {
+        for(const char c: characters)
+            bits[std::uint8_t(c) >> 5] |= 1u << (std::uint8_t(c) & 31);
+    }
+
+    bool contains(const char c) const {
+        return bits[std::uint8_t(c) >> 5] & (1u << (std::uint8_t(c) & 31));
+    }
+
+    std::uint32_t bits[8];
+};
+
+/* Finding the first or last byte that is or isn't in given set. Sets of up
+   to 16 characters are matched by comparing each of them against a whole
+   vector of input bytes at once, which for the common case of a few
+   whitespace characters is several times faster than a byte-by-byte lookup.
+   Larger sets go through the scalar CharacterSet lookup. All variants take
+   a [begin, end) range and return nullptr if nothing is found. */
+typedef const char*(*FindFunction)(const char*, const char*, const char*, std::size_t);
+
+enum: std::size_t { MaxVectorCharacters = 16 };
+
+inline bool isOneOf(const char c, const char* const characters, const std::size_t characterCount) {
+    return characterCount && std::memchr(characters, c, characterCount);
+}
+
+template<bool in> const char* findFirstScalar(const char* i, const char* const end, const char* const characters, const std::size_t characterCount) {
+    const CharacterSet set{{characters, characterCount}};
+    for(; i != end; ++i) if(set.contains(*i) == in) return i;
+    return nullptr;
+}
+
+template<bool in> const char* findLastScalar(const char* const begin, const char* i, const char* const characters, const std::size_t characterCount) {
+    const CharacterSet set{{characters, characterCount}};
+    for(; i != begin; --i) if(set.contains(*(i - 1)) == in) return i - 1;
+    return nullptr;
+}
+
+/* Used for the remaining bytes that don't fill a whole vector. The set is
+   small, so memchr() on it is faster than building the lookup table. */
+template<bool in> const char* findFirstRemaining(const char* i, const char* const end, const char* const characters, const std::size_t characterCount) {
+    for(; i != end; ++i) if(isOneOf(*i, characters, characterCount) == in) return i;
+    return nullptr;
+}
+
+template<bool in> const char* findLastRemaining(const char* const begin, const char* i, const char* const characters, const std::size_t characterCount) {
+    for(; i != begin; --i) if(isOneOf(*(i - 1), characters, characterCount) == in) return i - 1;
+    return nullptr;
+}
+
+#if defined(CORRADE_TARGET_X86) || defined(__ARM_NEON)
+inline unsigned int lowestSetBit(const std::uint32_t value) {
+    #ifdef CORRADE_TARGET_MSVC
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return index;
+    #else
+    return __builtin_ctz(value);
+    #endif
+}
+
+inline unsigned int highestSetBit(const std::uint32_t value) {
+    #ifdef CORRADE_TARGET_MSVC
+    unsigned long index;
+    _BitScanReverse(&index, value);
+    return index;
+    #else
+    return 31 - __builtin_clz(value);
+    #endif
+}
+#endif
+
+#ifdef CORRADE_TARGET_X86
+template<bool in> CORRADE_ENABLE_SSE2 const char* findFirstSse2(const char* i, const char* const end, const char* const characters, const std::size_t characterCount) {
+    __m128i set[MaxVectorCharacters];
+    for(std::size_t c = 0; c != characterCount; ++c)
+        set[c] = _mm_set1_epi8(characters[c]);
+
+    for(; end - i >= 16; i += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(i));
+        __m128i found = _mm_setzero_si128();
+        for(std::size_t c = 0; c != characterCount; ++c)
+            found = _mm_or_si128(found, _mm_cmpeq_epi8(chunk, set[c]));
+        std::uint32_t mask = _mm_movemask_epi8(found);
+        if(!in) mask ^= 0xffff;
+        if(mask) return i + lowestSetBit(mask);
+    }
+
+    return findFirstRemaining<in>(i, end, characters, characterCount);
+}
+
+template<bool in> CORRADE_ENABLE_SSE2 const char* findLastSse2(const char* const begin, const char* i, const char* const characters, const std::size_t characterCount) {
+    __m128i set[MaxVectorCharacters];
+    for(std::size_t c = 0; c != characterCount; ++c)
+        set[c] = _mm_set1_epi8(characters[c]);
+
+    for(; i - begin >= 16; i -= 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(i - 16));
+        __m128i found = _mm_setzero_si128();
+        for(std::size_t c = 0; c != characterCount; ++c)
+            found = _mm_or_si128(found, _mm_cmpeq_epi8(chunk, set[c]));
+        std::uint32_t mask = _mm_movemask_epi8(found);
+        if(!in) mask ^= 0xffff;
+        if(mask) return i - 16 + highestSetBit(mask);
+    }
+
+    return findLastRemaining<in>(begin, i, characters, characterCount);
+}
+
+template<bool in> CORRADE_ENABLE_AVX2 const char* findFirstAvx2(const char* i, const char* const end, const char* const characters, const std::size_t characterCount) {
+    __m256i set[MaxVectorCharacters];
+    for(std::size_t c = 0; c != characterCount; ++c)
+        set[c] = _mm256_set1_epi8(characters[c]);
+
+    for(; end - i >= 32; i += 32) {
+        const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(i));
+        __m256i found = _mm256_setzero_si256();
+        for(std::size_t c = 0; c != characterCount; ++c)
+            found = _mm256_or_si256(found, _mm256_cmpeq_epi8(chunk, set[c]));
+        std::uint32_t mask = _mm256_movemask_epi8(found);
+        if(!in) mask = ~mask;
+        if(mask) return i + lowestSetBit(mask);
+    }
+
+    return findFirstRemaining<in>(i, end, characters, characterCount);
+}
+
+template<bool in> CORRADE_ENABLE_AVX2 const char* findLastAvx2(const char* const begin, const char* i, const char* const characters, const std::size_t characterCount) {
+    __m256i set[MaxVectorCharacters];
+    for(std::size_t c = 0; c != characterCount; ++c)
+        set[c] = _mm256_set1_epi8(characters[c]);
+
+    for(; i - begin >= 32; i -= 32) {
+        const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(i - 32));
+        __m256i found = _mm256_setzero_si256();
+        for(std::size_t c = 0; c != characterCount; ++c)
+            found = _mm256_or_si256(found, _mm256_cmpeq_epi8(chunk, set[c]));
+        std::uint32_t mask = _mm256_movemask_epi8(found);
+        if(!in) mask = ~mask;
+        if(mask) return i - 32 + highestSetBit(mask);
+    }
+
+    return findLastRemaining<in>(begin, i, characters, characterCount);
+}
+#endif
+
+#ifdef __ARM_NEON
+/* NEON has no movemask, so narrow each byte of the comparison result to a
+   nibble instead, giving a 64-bit mask with four bits per byte */
+inline std::uint64_t neonMask(const uint8x16_t found) {
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(found), 4)), 0);
+}
+
+template<bool in> const char* findFirstNeon(const char* i, const char* const end, const char* const characters, const std::size_t characterCount) {
+    uint8x16_t set[MaxVectorCharacters];
+    for(std::size_t c = 0; c != characterCount; ++c)
+        set[c] = vdupq_n_u8(std::uint8_t(characters[c]));
+
+    for(; end - i >= 16; i += 16) {
+        const uint8x16_t chunk = vld1q_u8(reinterpret_cast<const std::uint8_t*>(i));
+        uint8x16_t found = vdupq_n_u8(0);
+        for(std::size_t c = 0; c != characterCount; ++c)
+            found = vorrq_u8(found, vceqq_u8(chunk, set[c]));
+        if(!in) found = vmvnq_u8(found);
+        const std::uint64_t mask = neonMask(found);
+        if(mask) {
+            const std::uint32_t low = std::uint32_t(mask);
+            return i + (low ? lowestSetBit(low) : 32 + lowestSetBit(std::uint32_t(mask >> 32)))/4;
+        }
+    }
+
+    return findFirstRemaining<in>(i, end, characters, characterCount);
+}
+
+template<bool in> const char* findLastNeon(const char* const begin, const char* i, const char* const characters, const std::size_t characterCount) {
+    uint8x16_t set[MaxVectorCharacters];
+    for(std::size_t c = 0; c != characterCount; ++c)
+        set[c] = vdupq_n_u8(std::uint8_t(characters[c]));
+
+    for(; i - begin >= 16; i -= 16) {
+        const uint8x16_t chunk = vld1q_u8(reinterpret_cast<const std::uint8_t*>(i - 16));
+        uint8x16_t found = vdupq_n_u8(0);
+        for(std::size_t c = 0; c != characterCount; ++c)
+            found = vorrq_u8(found, vceqq_u8(chunk, set[c]));
+        if(!in) found = vmvnq_u8(found);
+        const std::uint64_t mask = neonMask(found);
+        if(mask) {
+            const std::uint32_t high = std::uint32_t(mask >> 32);
+            return i - 16 + (high ? 32 + highestSetBit(high) : highestSetBit(std::uint32_t(mask)))/4;
+        }
+    }
+
+    return findLastRemaining<in>(begin, i, characters, characterCount);
+}
+#endif
+
+template<bool in> FindFunction pickFindFirst() {
+    return Utility::Cpu::dispatch<FindFunction>({
+        #ifdef CORRADE_TARGET_X86
+        {Utility::Cpu::Feature::Avx2, findFirstAvx2<in>},
+        {Utility::Cpu::Feature::Sse2, findFirstSse2<in>},
+        #endif
+    },
+        #ifdef __ARM_NEON
+        findFirstNeon<in>
+        #else
+        findFirstRemaining<in>
+        #endif
+    );
+}
+
+template<bool in> FindFunction pickFindLast() {
+    return Utility::Cpu::dispatch<FindFunction>({
+        #ifdef CORRADE_TARGET_X86
+        {Utility::Cpu::Feature::Avx2, findLastAvx2<in>},
+        {Utility::Cpu::Feature::Sse2, findLastSse2<in>},
+        #endif
+    },
+        #ifdef __ARM_NEON
+        findLastNeon<in>
+        #else
+        findLastRemaining<in>
+        #endif
+    );
+}
+
+template<bool in> const char* findFirst(const char* const begin, const char* const end, const StringView characters) {
+    if(characters.size() > MaxVectorCharacters)
+        return findFirstScalar<in>(begin, end, characters.data(), characters.size());
+
+    static const FindFunction function = pickFindFirst<in>();
+    return function(begin, end, characters.data(), characters.size());
+}
+
+template<bool in> const char* findLast(const char* const begin, const char* const end, const StringView characters) {
+    if(characters.size() > MaxVectorCharacters)
+        return findLastScalar<in>(begin, end, characters.data(), characters.size());
+
+    static const FindFunction function = pickFindLast<in>();
+    return function(begin, end, characters.data(), characters.size());
+}
+
+const char* findString(const char* const data, const std::size_t size, const char* const substring, const std::size_t substringSize) {
+    /* An empty substring is found right at the beginning, which is consistent
+       with std::string::find() */
+    if(!substringSize) return data;
+    if(substringSize > size) return nullptr;
+
+    /* Look for the first character with memchr(), which is vectorized in
+       every sane libc, and compare the rest only on a match */
+    const char* const last = data + size - substringSize;
+    for(const char* i = data; i <= last; ++i) {
+        i = static_cast<const char*>(std::memchr(i, substring[0], last - i + 1));
+        if(!i) return nullptr;
+        if(std::memcmp(i + 1, substring + 1, substringSize - 1) == 0) return i;
+    }
+
+    return nullptr;
+}
+
+const char* findLastString(const char* const data, const std::size_t size, const char* const substring, const std::size_t substringSize) {
+    if(!substringSize) return data + size;
+    if(substringSize > size) return nullptr;
+
+    for(const char* i = data + size - substringSize; ; --i) {
+        if(std::memcmp(i, substring, substringSize) == 0) return i;
+        if(i == data) break;
+    }
+
+    return nullptr;
+}
+
+}
+
+template<class T> BasicStringView<T>::BasicStringView(T* const data) noexcept: _data{data}, _size{data ? std::strlen(data) : 0} {}
+
+template<class T> Array<BasicStringView<T>> BasicStringView<T>::split(const char delimiter) const {
+    Array<BasicStringView<T>> parts;
+    T* const end = this->end();
+    T* oldpos = _data;
+    T* pos;
+    while(oldpos < end && (pos = static_cast<T*>(std::memchr(oldpos, delimiter, end - oldpos)))) {
+        arrayAppend(parts, slice(oldpos, pos));
+        oldpos = pos + 1;
+    }
+
+    if(!empty())
+        arrayAppend(parts, suffix(oldpos));
+
+    return parts;
+}
+
+template<class T> Array<BasicStringView<T>> BasicStringView<T>::splitWithoutEmptyParts(const char delimiter) const {
+    Array<BasicStringView<T>> parts;
+    T* const end = this->end();
+    T* oldpos = _data;
+
+    while(oldpos < end) {
+        T* const pos = static_cast<T*>(std::memchr(oldpos, delimiter, end - oldpos));
+        if(!pos) {
+            arrayAppend(parts, suffix(oldpos));
+            break;
+        }
+
+        if(pos != oldpos)
+            arrayAppend(parts, slice(oldpos, pos));
+        oldpos = pos + 1;
+    }
+
+    return parts;
+}
+
+template<class T> Array<BasicStringView<T>> BasicStringView<T>::splitWithoutEmptyParts(const StringView delimiters) const {
+    Array<BasicStringView<T>> parts;
+    T* const end = this->end();
+    T* i = _data;
+
+    /* Skip a run of delimiters to get to the beginning of a part, then find
+       its end. The const_casts are fine, the pointers are from the view
+       itself. */
+    while(T* const begin = const_cast<T*>(findFirst<false>(i, end, delimiters))) {
+        i = const_cast<T*>(findFirst<true>(begin, end, delimiters));
+        if(!i) i = end;
+        arrayAppend(parts, slice(begin, i));
+    }
+
+    return parts;
+}
+
+template<class T> Array<BasicStringView<T>> BasicStringView<T>::splitWithoutEmptyParts() const {
+    return splitWithoutEmptyParts(Whitespace);
+}
+
+template<class T> BasicStringSplitIterable<T> BasicStringView<T>::lazySplit(const char delimiter) const {
+    return BasicStringSplitIterable<T>{BasicStringSplitIterator<T>{*this, {}, delimiter, false, false}};
+}
+
+template<class T> BasicStringSplitIterable<T> BasicStringView<T>::lazySplitWithoutEmptyParts(const char delimiter) const {
+    return BasicStringSplitIterable<T>{BasicStringSplitIterator<T>{*this, {}, delimiter, false, true}};
+}
+
+template<class T> BasicStringSplitIterable<T> BasicStringView<T>::lazySplitWithoutEmptyParts(const StringView delimiters) const {
+    return BasicStringSplitIterable<T>{BasicStringSplitIterator<T>{*this, delimiters, '\0', true, true}};
+}
+
+template<class T> BasicStringSplitIterable<T> BasicStringView<T>::lazySplitWithoutEmptyParts() const {
+    return lazySplitWithoutEmptyParts(Whitespace);
+}
+
+template<class T> StaticArray<3, BasicStringView<T>> BasicStringView<T>::partition(const char separator) const {
+    return partition(StringView{&separator, 1});
+}
+
+template<class T> StaticArray<3, BasicStringView<T>> BasicStringView<T>::partition(const StringView separator) const {
+    /* The const_cast is fine, the pointer is from the view itself */
+    T* const pos = const_cast<T*>(findString(_data, _size, separator.data(), separator.size()));
+    T* const end = this->end();
+    return {
+        pos ? prefix(pos) : *this,
+        pos ? slice(pos, pos + separator.size()) : suffix(end),
+        pos ? suffix(pos + separator.size()) : suffix(end)
+    };
+}
+
+template<class T> StaticArray<3, BasicStringView<T>> BasicStringView<T>::rpartition(const char separator) const {
+    return rpartition(StringView{&separator, 1});
+}
+
+template<class T> StaticArray<3, BasicStringView<T>> BasicStringView<T>::rpartition(const StringView separator) const {
+    T* const pos = const_cast<T*>(findLastString(_data, _size, separator.data(), separator.size()));
+    return {
+        pos ? prefix(pos) : prefix(_data),
+        pos ? slice(pos, pos + separator.size()) : prefix(_data),
+        pos ? suffix(pos + separator.size()) : *this
+    };
+}
+
+namespace {
+
+String joinInternal(const StringView delimiter, const ArrayView<const StringView> strings, const bool skipEmpty) {
+    /* Calculate the total size first so there's just one allocation */
+    std::size_t size = 0;
+    std::size_t count = 0;
+    for(const StringView& s: strings) {
+        if(skipEmpty && s.empty()) continue;
+        size += s.size();
+        ++count;
+    }
+    if(count) size += delimiter.size()*(count - 1);
+
+    String out{NoInit, size};
+    char* o = out.data();
+    bool first = true;
+    for(const StringView& s: strings) {
+        if(skipEmpty && s.empty()) continue;
+
+        if(!first) {
+            if(delimiter.size()) std::memcpy(o, delimiter.data(), delimiter.size());
+            o += delimiter.size();
+        }
+        first = false;
+
+        /* memcpy() with a null pointer is UB even for zero size */
+        if(s.size()) std::memcpy(o, s.data(), s.size());
+        o += s.size();
+    }
+
+    return out;
+}
+
+}
+
+template<class T> String BasicStringView<T>::join(const ArrayView<const StringView> strings) const {
+    return joinInternal(*this, strings, false);
+}
+
+template<class T> String BasicStringView<T>::join(const std::initializer_list<StringView> strings) const {
+    return join(arrayView(strings));
+}
+
+template<class T> String BasicStringView<T>::joinWithoutEmptyParts(const ArrayView<const StringView> strings) const {
+    return joinInternal(*this, strings, true);
+}
+
+template<class T> String BasicStringView<T>::joinWithoutEmptyParts(const std::initializer_list<StringView> strings) const {
+    return joinWithoutEmptyParts(arrayView(strings));
+}
+
+template<class T> bool BasicStringView<T>::hasPrefix(const StringView prefix) const {
+    return _size >= prefix.size() && (prefix.empty() || std::memcmp(_data, prefix.data(), prefix.size()) == 0);
+}
+
+template<class T> bool BasicStringView<T>::hasPrefix(const char prefix) const {
+    return _size && _data[0] == prefix;
+}
+
+template<class T> bool BasicStringView<T>::hasSuffix(const StringView suffix) const {
+    return _size >= suffix.size() && (suffix.empty() || std::memcmp(_data + _size - suffix.size(), suffix.data(), suffix.size()) == 0);
+}
+
+template<class T> bool BasicStringView<T>::hasSuffix(const char suffix) const {
+    return _size && _data[_size - 1] == suffix;
+}
+
+template<class T> BasicStringView<T> BasicStringView<T>::exceptPrefix(const StringView prefix) const {
+    CORRADE_ASSERT(hasPrefix(prefix),
+        "Containers::StringView::exceptPrefix(): string doesn't begin with" << prefix, {});
+    return suffix(prefix.size());
+}
+
+template<class T> BasicStringView<T> BasicStringView<T>::exceptSuffix(const StringView suffix) const {
+    CORRADE_ASSERT(hasSuffix(suffix),
+        "Containers::StringView::exceptSuffix(): string doesn't end with" << suffix, {});
+    return except(suffix.size());
+}
+
+template<class T> BasicStringView<T> BasicStringView<T>::trimmed(const StringView characters) const {
+    return trimmedPrefix(characters).trimmedSuffix(characters);
+}
+
+template<class T> BasicStringView<T> BasicStringView<T>::trimmed() const {
+    return trimmed(Whitespace);
+}
+
+template<class T> BasicStringView<T> BasicStringView<T>::trimmedPrefix(const StringView characters) const {
+    /* The const_cast is fine, the pointer is from the view itself */
+    T* const found = const_cast<T*>(findFirst<false>(_data, _data + _size, characters));
+    return found ? suffix(found) : suffix(end());
+}
+
+template<class T> BasicStringView<T> BasicStringView<T>::trimmedPrefix() const {
+    return trimmedPrefix(Whitespace);
+}
+
+template<class T> BasicStringView<T> BasicStringView<T>::trimmedSuffix(const StringView characters) const {
+    T* const found = const_cast<T*>(findLast<false>(_data, _data + _size, characters));
+    return found ? prefix(found + 1) : prefix(_data);
+}
+
+template<class T> BasicStringView<T> BasicStringView<T>::trimmedSuffix() const {
+    return trimmedSuffix(Whitespace);
+}
+
+template<class T> BasicStringView<T> BasicStringView<T>::find(const StringView substring) const {
+    /* The const_cast is fine, the pointer is from the view itself */
+    T* const found = const_cast<T*>(findString(_data, _size, substring.data(), substring.size()));
+    return found ? slice(found, found + substring.size()) : nullptr;
+}
+
+template<class T> BasicStringView<T> BasicStringView<T>::find(const char character) const {
+    T* const found = _size ? static_cast<T*>(std::memchr(_data, character, _size)) : nullptr;
+    return found ? slice(found, found + 1) : nullptr;
+}
+
+template<class T> bool BasicStringView<T>::contains(const StringView substring) const {
+    return substring.empty() || findString(_data, _size, substring.data(), substring.size());
+}
+
+template<class T> bool BasicStringView<T>::contains(const char character) const {
+    return _size && std::memchr(_data, character, _size);
+}
+
+template<class T> BasicStringSplitIterator<T>::BasicStringSplitIterator(const BasicStringView<T> string, const StringView delimiters, const char delimiter, const bool multiple, const bool skipEmpty): _end{string.end()}, _next{string.empty() ? nullptr : string.data()}, _delimiters{delimiters}, _delimiter{delimiter}, _multiple{multiple}, _skipEmpty{skipEmpty} {
+    advance();
+}
+
+template<class T> void BasicStringSplitIterator<T>::advance() {
+    /* Loop only in case empty parts are skipped for a single-character
+       delimiter, for a character set the empty parts are skipped directly */
+    do {
+        if(!_next) {
+            _current = {};
+            return;
+        }
+
+        /* The const_casts are fine, the pointers are from the view itself */
+        T* const begin = _multiple && _skipEmpty ?
+            const_cast<T*>(findFirst<false>(_next, _end, _delimiters)) : _next;
+        if(!begin) {
+            _current = {};
+            _next = nullptr;
+            return;
+        }
+
+        T* const found = _multiple ?
+            const_cast<T*>(findFirst<true>(begin, _end, _delimiters)) :
+            static_cast<T*>(begin == _end ? nullptr : std::memchr(begin, _delimiter, _end - begin));
+        if(found) {
+            _current = BasicStringView<T>{begin, std::size_t(found - begin)};
+            _next = found + 1;
+        } else {
+            _current = BasicStringView<T>{begin, std::size_t(_end - begin)};
+            _next = nullptr;
+        }
+    } while(_skipEmpty && _current.empty());
+}
+
+template class BasicStringView<char>;
+template class BasicStringView<const char>;
+template class BasicStringSplitIterator<char>;
+template class BasicStringSplitIterator<const char>;
+
+bool operator==(const StringView a, const StringView b) {
+    return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size()) == 0);
+}
+
+bool operator!=(const StringView a, const StringView b) {
+    return !operator==(a, b);
+}
+
+bool operator<(const StringView a, const StringView b) {
+    const std::size_t size = a.size() < b.size() ? a.size() : b.size();
+    const int result = size ? std::memcmp(a.data(), b.data(), size) : 0;
+    return result < 0 || (result == 0 && a.size() < b.size());
+}
+
+bool operator<=(const StringView a, const StringView b) {
+    return !operator<(b, a);
+}
+
+bool operator>(const StringView a, const StringView b) {
+    return operator<(b, a);
+}
+
+bool operator>=(const StringView a, const StringView b) {
+    return !operator<(a, b);
+}
+
+}}
@@ -0,0 +1,733 @@
+#ifndef Corrade_Containers_StringView_h
+#define Corrade_Containers_StringView_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Containers::BasicStringView, typedef @ref Corrade::Containers::StringView, @ref Corrade::Containers::MutableStringView, literal @link Corrade::Containers::Literals::operator""_s() @endlink
+ */
+
+#include <cstddef>
+#include <initializer_list>
+#include <type_traits>
+
+#include "Corrade/Containers/ArrayView.h"
+#include "Corrade/Utility/Move.h"
+#include "Corrade/Utility/Utility.h"
+#include "Corrade/Utility/visibility.h"
+
+namespace Corrade { namespace Containers {
+
+namespace Implementation {
+    template<class, class> struct StringViewConverter;
+}
+
+/**
+@brief String view
+
+A lighter alternative to C++17 @ref std::string_view that's just a pointer and
+a size. Unlike @ref ArrayView it's specialized for character data and provides
+a set of string algorithms. The algorithms don't allocate and return views
+pointing into the original data, making it possible to tokenize large files
+without copying each part into a new string:
+
+@snippet Containers.cpp StringView
+
+Available in two variants, the @ref StringView typedef for a @cpp const char @ce
+view and @ref MutableStringView for a @cpp char @ce view. A mutable view is
+implicitly convertible to the immutable one.
+
+The view isn't expected to be null-terminated. Use @ref String to store an
+owned copy, which is always null-terminated.
+
+@section Containers-BasicStringView-usage Usage
+
+A view can be constructed from a pointer and a size, from a null-terminated
+C string (in which case the size is calculated using @ref std::strlen()) or
+from an @ref ArrayView of characters. For string literals, there's the
+@link Literals::operator""_s() @endlink literal that's usable in
+@cpp constexpr @ce context and doesn't need to calculate the size at runtime.
+Views are implicitly convertible to @ref ArrayView. Views can be compared with
+@ref operator==(StringView, StringView) and other operators, the comparison
+is done on the contents.
+
+Functions @ref split(), @ref splitWithoutEmptyParts(), @ref partition() and
+@ref rpartition() return @ref Array and @ref StaticArray, and @ref join() and
+@ref joinWithoutEmptyParts() return a @ref String. Include
+@ref Corrade/Containers/Array.h, @ref Corrade/Containers/StaticArray.h or
+@ref Corrade/Containers/String.h to use them.
+
+Searching for a set of characters in @ref splitWithoutEmptyParts(StringView) const,
+@ref trimmedPrefix() and @ref trimmedSuffix() is vectorized using SSE2 or AVX2
+on x86, picked at runtime based on @ref Utility::Cpu::runtimeFeatures(), and
+NEON on ARM if enabled at compile time, for sets of up to 16 characters.
+Larger sets fall back to a scalar lookup table.
+
+@section Containers-BasicStringView-stl STL compatibility
+
+Instances of @ref StringView and @ref MutableStringView are implicitly
+convertible from and to @ref std::string if you include
+@ref Corrade/Containers/StringStl.h. The conversion involves copying the data
+when converting to a @ref std::string.
+@see @ref String, @ref Literals::operator""_s()
+*/
+template<class T> class CORRADE_UTILITY_EXPORT BasicStringView {
+    static_assert(std::is_same<typename std::remove_const<T>::type, char>::value,
+        "only char and const char string views are supported");
+
+    public:
+        /**
+         * @brief Default constructor
+         *
+         * Creates an empty @cpp nullptr @ce view.
+         */
+        constexpr /*implicit*/ BasicStringView() noexcept: _data{}, _size{} {}
+
+        /** @brief Construct from a @cpp nullptr @ce */
+        constexpr /*implicit*/ BasicStringView(std::nullptr_t) noexcept: _data{}, _size{} {}
+
+        /**
+         * @brief Construct from a pointer and size
+         *
+         * The data is not expected to be null-terminated.
+         */
+        constexpr /*implicit*/ BasicStringView(T* data, std::size_t size) noexcept: _data{data}, _size{size} {}
+
+        /**
+         * @brief Construct from a null-terminated C string
+         *
+         * The size is calculated using @ref std::strlen(). If @p data is
+         * @cpp nullptr @ce, creates an empty @cpp nullptr @ce view. For string
+         * literals prefer to use @link Literals::operator""_s() @endlink,
+         * which calculates the size at compile time.
+         */
+        /*implicit*/ BasicStringView(T* data) noexcept;
+
+        /**
+         * @brief Construct from an @ref ArrayView
+         *
+         * A @ref StringView can be constructed from both a mutable and an
+         * immutable @ref ArrayView.
+         */
+        /* A template so it doesn't take part in implicit conversions from
+           types that are convertible to both ArrayView and StringView */
+        template<class U, class = typename std::enable_if<std::is_same<T, U>::value || std::is_same<T, const U>::value>::type> constexpr /*implicit*/ BasicStringView(ArrayView<U> view) noexcept: _data{view.data()}, _size{view.size()} {}
+
+        /** @brief Construct a @ref StringView from a @ref MutableStringView */
+        template<class U, class = typename std::enable_if<std::is_same<const U, T>::value && !std::is_same<U, T>::value>::type> constexpr /*implicit*/ BasicStringView(BasicStringView<U> view) noexcept: _data{view.data()}, _size{view.size()} {}
+
+        /**
+         * @brief Construct a view on an external type
+         *
+         * @see @ref Containers-BasicStringView-stl
+         */
+        template<class U, class = decltype(Implementation::StringViewConverter<T, typename std::decay<U&&>::type>::from(std::declval<U&&>()))> constexpr /*implicit*/ BasicStringView(U&& other) noexcept: BasicStringView{Implementation::StringViewConverter<T, typename std::decay<U&&>::type>::from(Utility::forward<U>(other))} {}
+
+        /**
+         * @brief Convert the view to external representation
+         *
+         * @see @ref Containers-BasicStringView-stl
+         */
+        template<class U, class = decltype(Implementation::StringViewConverter<T, U>::to(std::declval<BasicStringView<T>>()))> constexpr /*implicit*/ operator U() const {
+            return Implementation::StringViewConverter<T, U>::to(*this);
+        }
+
+        /**
+         * @brief Convert to an @ref ArrayView
+         *
+         * A @ref MutableStringView is convertible to both a mutable and an
+         * immutable @ref ArrayView.
+         */
+        template<class U, class = typename std::enable_if<std::is_same<T, U>::value || std::is_same<const T, U>::value>::type> constexpr /*implicit*/ operator ArrayView<U>() const noexcept {
+            return {_data, _size};
+        }
+
+        /** @brief String data */
+        constexpr T* data() const { return _data; }
+
+        /** @brief String size */
+        constexpr std::size_t size() const { return _size; }
+
+        /** @brief Whether the string is empty */
+        constexpr bool empty() const { return !_size; }
+
+        /**
+         * @brief Pointer to the first byte
+         *
+         * @see @ref front()
+         */
+        constexpr T* begin() const { return _data; }
+        constexpr T* cbegin() const { return _data; } /**< @overload */
+
+        /**
+         * @brief Pointer to (one item after) the last byte
+         *
+         * @see @ref back()
+         */
+        constexpr T* end() const { return _data + _size; }
+        constexpr T* cend() const { return _data + _size; } /**< @overload */
+
+        /**
+         * @brief First byte
+         *
+         * Expects there is at least one byte.
+         * @see @ref begin()
+         */
+        T& front() const;
+
+        /**
+         * @brief Last byte
+         *
+         * Expects there is at least one byte.
+         * @see @ref end()
+         */
+        T& back() const;
+
+        /** @brief Element access */
+        constexpr T& operator[](std::size_t i) const { return _data[i]; }
+
+        /**
+         * @brief String slice
+         *
+         * Both arguments are expected to be in range.
+         */
+        constexpr BasicStringView<T> slice(T* begin, T* end) const;
+
+        /** @overload */
+        constexpr BasicStringView<T> slice(std::size_t begin, std::size_t end) const;
+
+        /**
+         * @brief String prefix
+         *
+         * Equivalent to @cpp string.slice(string.begin(), end) @ce. If @p end
+         * is @cpp nullptr @ce, returns zero-sized @cpp nullptr @ce view.
+         */
+        constexpr BasicStringView<T> prefix(T* end) const {
+            return end ? slice(_data, end) : nullptr;
+        }
+
+        /**
+         * @brief String prefix
+         *
+         * Equivalent to @cpp string.slice(0, end) @ce.
+         */
+        constexpr BasicStringView<T> prefix(std::size_t end) const {
+            return slice(0, end);
+        }
+
+        /**
+         * @brief String suffix
+         *
+         * Equivalent to @cpp string.slice(begin, string.end()) @ce. If
+         * @p begin is @cpp nullptr @ce and the original view isn't, returns
+         * zero-sized @cpp nullptr @ce view.
+         */
+        constexpr BasicStringView<T> suffix(T* begin) const {
+            return _data && !begin ? nullptr : slice(begin, _data + _size);
+        }
+
+        /**
+         * @brief String suffix
+         *
+         * Equivalent to @cpp string.slice(begin, string.size()) @ce.
+         */
+        constexpr BasicStringView<T> suffix(std::size_t begin) const {
+            return slice(begin, _size);
+        }
+
+        /**
+         * @brief String prefix except the last @p count bytes
+         *
+         * Equivalent to @cpp string.slice(0, string.size() - count) @ce.
+         */
+        constexpr BasicStringView<T> except(std::size_t count) const {
+            return slice(0, _size - count);
+        }
+
+        /**
+         * @brief Split on given character
+         *
+         * If no delimiters are found, the result has a single entry
+         * containing the whole string. If the view is empty, the result is
+         * empty as well. The returned views point into this view.
+         * @see @ref splitWithoutEmptyParts(), @ref Utility::String::split()
+         */
+        Array<BasicStringView<T>> split(char delimiter) const;
+
+        /**
+         * @brief Split on given character, removing empty parts
+         *
+         * @see @ref split(), @ref Utility::String::splitWithoutEmptyParts()
+         */
+        Array<BasicStringView<T>> splitWithoutEmptyParts(char delimiter) const;
+
+        /**
+         * @brief Split on any character from given set, removing empty parts
+         *
+         * @see @ref Utility::String::splitWithoutEmptyParts()
+         */
+        Array<BasicStringView<T>> splitWithoutEmptyParts(StringView delimiters) const;
+
+        /**
+         * @brief Split on whitespace, removing empty parts
+         *
+         * Equivalent to calling @ref splitWithoutEmptyParts(StringView) const
+         * with @cpp " \t\f\v\r\n" @ce passed to @p delimiters.
+         */
+        Array<BasicStringView<T>> splitWithoutEmptyParts() const;
+
+        /**
+         * @brief Lazily split on given character
+         *
+         * Same as @ref split(), but instead of allocating an @ref Array
+         * returns a range that finds the next part only when its iterator is
+         * incremented. Useful when only first few parts are needed or when
+         * streaming through large amounts of data:
+         *
+         * @snippet Containers.cpp StringView-lazySplit
+         *
+         * The returned views point into this view.
+         */
+        BasicStringSplitIterable<T> lazySplit(char delimiter) const;
+
+        /**
+         * @brief Lazily split on given character, removing empty parts
+         *
+         * Same as @ref splitWithoutEmptyParts(char) const, but without
+         * allocating. See @ref lazySplit() for more information.
+         */
+        BasicStringSplitIterable<T> lazySplitWithoutEmptyParts(char delimiter) const;
+
+        /**
+         * @brief Lazily split on any character from given set, removing empty parts
+         *
+         * Same as @ref splitWithoutEmptyParts(StringView) const, but without
+         * allocating. See @ref lazySplit() for more information. The
+         * @p delimiters view is referenced by the returned range, so it has
+         * to stay in scope for as long as the range is used.
+         */
+        BasicStringSplitIterable<T> lazySplitWithoutEmptyParts(StringView delimiters) const;
+
+        /**
+         * @brief Lazily split on whitespace, removing empty parts
+         *
+         * Equivalent to calling @ref lazySplitWithoutEmptyParts(StringView) const
+         * with @cpp " \t\f\v\r\n" @ce passed to @p delimiters.
+         */
+        BasicStringSplitIterable<T> lazySplitWithoutEmptyParts() const;
+
+        /**
+         * @brief Partition
+         *
+         * Equivalent to Python's @m_class{m-doc-external} [str.partition()](https://docs.python.org/3/library/stdtypes.html#str.partition).
+         * Splits the string at the first occurence of @p separator. First
+         * returned value is the part before the separator, second the
+         * separator, third a part after the separator. If the separator is
+         * not found, returns this view followed by two empty views.
+         * @see @ref rpartition(), @ref Utility::String::partition()
+         */
+        StaticArray<3, BasicStringView<T>> partition(char separator) const;
+
+        /** @overload */
+        StaticArray<3, BasicStringView<T>> partition(StringView separator) const;
+
+        /**
+         * @brief Right partition
+         *
+         * Equivalent to Python's @m_class{m-doc-external} [str.rpartition()](https://docs.python.org/3/library/stdtypes.html#str.rpartition).
+         * Splits the string at the last occurence of @p separator. First
+         * returned value is the part before the separator, second the
+         * separator, third a part after the separator. If the separator is
+         * not found, returns two empty views followed by this view.
+         * @see @ref partition(), @ref Utility::String::rpartition()
+         */
+        StaticArray<3, BasicStringView<T>> rpartition(char separator) const;
+
+        /** @overload */
+        StaticArray<3, BasicStringView<T>> rpartition(StringView separator) const;
+
+        /**
+         * @brief Join strings with this view as the delimiter
+         *
+         * Similar in usage to Python's @m_class{m-doc-external} [str.join()](https://docs.python.org/3/library/stdtypes.html#str.join).
+         * The output size is calculated upfront, so there's just a single
+         * allocation.
+         * @see @ref joinWithoutEmptyParts(), @ref Utility::String::join()
+         */
+        String join(ArrayView<const StringView> strings) const;
+
+        /** @overload */
+        String join(std::initializer_list<StringView> strings) const;
+
+        /**
+         * @brief Join strings with this view as the delimiter, skipping empty parts
+         *
+         * @see @ref join(), @ref Utility::String::joinWithoutEmptyParts()
+         */
+        String joinWithoutEmptyParts(ArrayView<const StringView> strings) const;
+
+        /** @overload */
+        String joinWithoutEmptyParts(std::initializer_list<StringView> strings) const;
+
+        /**
+         * @brief Whether the string begins with given prefix
+         *
+         * For an empty string returns @cpp true @ce only if @p prefix is
+         * empty as well.
+         * @see @ref exceptPrefix(), @ref Utility::String::beginsWith()
+         */
+        bool hasPrefix(StringView prefix) const;
+
+        /** @overload */
+        bool hasPrefix(char prefix) const;
+
+        /**
+         * @brief Whether the string ends with given suffix
+         *
+         * For an empty string returns @cpp true @ce only if @p suffix is
+         * empty as well.
+         * @see @ref exceptSuffix(), @ref Utility::String::endsWith()
+         */
+        bool hasSuffix(StringView suffix) const;
+
+        /** @overload */
+        bool hasSuffix(char suffix) const;
+
+        /**
+         * @brief View with given prefix stripped
+         *
+         * Expects that the string actually begins with given prefix.
+         * @see @ref hasPrefix(), @ref Utility::String::stripPrefix()
+         */
+        BasicStringView<T> exceptPrefix(StringView prefix) const;
+
+        /**
+         * @brief View with given suffix stripped
+         *
+         * Expects that the string actually ends with given suffix.
+         * @see @ref hasSuffix(), @ref Utility::String::stripSuffix()
+         */
+        BasicStringView<T> exceptSuffix(StringView suffix) const;
+
+        /**
+         * @brief View with given characters trimmed from prefix and suffix
+         *
+         * @see @ref trimmedPrefix(), @ref trimmedSuffix(),
+         *      @ref Utility::String::trim()
+         */
+        BasicStringView<T> trimmed(StringView characters) const;
+
+        /**
+         * @brief View with whitespace trimmed from prefix and suffix
+         *
+         * Equivalent to calling @ref trimmed(StringView) const with
+         * @cpp " \t\f\v\r\n" @ce passed to @p characters.
+         */
+        BasicStringView<T> trimmed() const;
+
+        /**
+         * @brief View with given characters trimmed from prefix
+         *
+         * @see @ref trimmed(), @ref trimmedSuffix(),
+         *      @ref Utility::String::ltrim()
+         */
+        BasicStringView<T> trimmedPrefix(StringView characters) const;
+
+        /**
+         * @brief View with whitespace trimmed from prefix
+         *
+         * Equivalent to calling @ref trimmedPrefix(StringView) const with
+         * @cpp " \t\f\v\r\n" @ce passed to @p characters.
+         */
+        BasicStringView<T> trimmedPrefix() const;
+
+        /**
+         * @brief View with given characters trimmed from suffix
+         *
+         * @see @ref trimmed(), @ref trimmedPrefix(),
+         *      @ref Utility::String::rtrim()
+         */
+        BasicStringView<T> trimmedSuffix(StringView characters) const;
+
+        /**
+         * @brief View with whitespace trimmed from suffix
+         *
+         * Equivalent to calling @ref trimmedSuffix(StringView) const with
+         * @cpp " \t\f\v\r\n" @ce passed to @p characters.
+         */
+        BasicStringView<T> trimmedSuffix() const;
+
+        /**
+         * @brief Find a substring
+         *
+         * Returns a view pointing to the first occurence of @p substring in
+         * the string or an empty @cpp nullptr @ce view if not found. The
+         * returned view can be then passed to @ref prefix(T*) const or
+         * @ref suffix(T*) const to get the parts before or after.
+         * @see @ref contains()
+         */
+        BasicStringView<T> find(StringView substring) const;
+
+        /** @overload */
+        BasicStringView<T> find(char character) const;
+
+        /**
+         * @brief Whether the string contains a substring
+         *
+         * @see @ref find()
+         */
+        bool contains(StringView substring) const;
+
+        /** @overload */
+        bool contains(char character) const;
+
+    private:
+        T* _data;
+        std::size_t _size;
+};
+
+/**
+@brief String view
+
+Immutable, use @ref MutableStringView for mutable access.
+*/
+typedef BasicStringView<const char> StringView;
+
+/**
+@brief Mutable string view
+
+@see @ref StringView
+*/
+typedef BasicStringView<char> MutableStringView;
+
+/**
+@brief String split iterator
+
+Forward iterator over parts of a string, returned from
+@ref BasicStringSplitIterable::begin(). Each increment finds the next part,
+no allocation is done. A default-constructed instance is equal to the end
+iterator.
+@see @ref StringSplitIterator, @ref MutableStringSplitIterator
+*/
+template<class T> class CORRADE_UTILITY_EXPORT BasicStringSplitIterator {
+    public:
+        /**
+         * @brief Default constructor
+         *
+         * Creates an end iterator.
+         */
+        constexpr /*implicit*/ BasicStringSplitIterator() noexcept: _end{}, _next{}, _delimiters{}, _delimiter{}, _multiple{}, _skipEmpty{} {}
+
+        /** @brief Current part */
+        BasicStringView<T> operator*() const { return _current; }
+
+        /** @brief Access the current part */
+        const BasicStringView<T>* operator->() const { return &_current; }
+
+        /** @brief Advance to the next part */
+        BasicStringSplitIterator<T>& operator++() {
+            advance();
+            return *this;
+        }
+
+        /** @brief Advance to the next part, returning the previous state */
+        BasicStringSplitIterator<T> operator++(int) {
+            BasicStringSplitIterator<T> copy{*this};
+            advance();
+            return copy;
+        }
+
+        /**
+         * @brief Equality comparison
+         *
+         * Two iterators are equal if they point to the same part or if both
+         * are at the end.
+         */
+        bool operator==(const BasicStringSplitIterator<T>& other) const {
+            return _current.data() == other._current.data();
+        }
+
+        /** @brief Non-equality comparison */
+        bool operator!=(const BasicStringSplitIterator<T>& other) const {
+            return _current.data() != other._current.data();
+        }
+
+    private:
+        friend BasicStringView<T>;
+
+        explicit BasicStringSplitIterator(BasicStringView<T> string, StringView delimiters, char delimiter, bool multiple, bool skipEmpty);
+
+        void advance();
+
+        /* Current part is null at the end, the next search starts at _next
+           which is null if the current part is the last one */
+        T* _end;
+        T* _next;
+        BasicStringView<T> _current;
+        StringView _delimiters;
+        char _delimiter;
+        bool _multiple, _skipEmpty;
+};
+
+/**
+@brief String split iterator
+
+@see @ref MutableStringSplitIterator
+*/
+typedef BasicStringSplitIterator<const char> StringSplitIterator;
+
+/**
+@brief Mutable string split iterator
+
+@see @ref StringSplitIterator
+*/
+typedef BasicStringSplitIterator<char> MutableStringSplitIterator;
+
+/**
+@brief Lazy string split range
+
+Returned from @ref BasicStringView::lazySplit() and
+@ref BasicStringView::lazySplitWithoutEmptyParts(), meant to be used in a
+range-for loop.
+@see @ref StringSplitIterable, @ref MutableStringSplitIterable
+*/
+template<class T> class BasicStringSplitIterable {
+    public:
+        /** @brief Iterator to the first part */
+        BasicStringSplitIterator<T> begin() const { return _begin; }
+
+        /** @brief Iterator to the first part */
+        BasicStringSplitIterator<T> cbegin() const { return _begin; }
+
+        /** @brief End iterator */
+        constexpr BasicStringSplitIterator<T> end() const { return {}; }
+
+        /** @brief End iterator */
+        constexpr BasicStringSplitIterator<T> cend() const { return {}; }
+
+    private:
+        friend BasicStringView<T>;
+
+        explicit BasicStringSplitIterable(const BasicStringSplitIterator<T>& begin): _begin{begin} {}
+
+        BasicStringSplitIterator<T> _begin;
+};
+
+/**
+@brief Lazy string split range
+
+@see @ref MutableStringSplitIterable
+*/
+typedef BasicStringSplitIterable<const char> StringSplitIterable;
+
+/**
+@brief Lazy mutable string split range
+
+@see @ref StringSplitIterable
+*/
+typedef BasicStringSplitIterable<char> MutableStringSplitIterable;
+
+/**
+@brief String view equality comparison
+
+Compares the contents, not the pointers. As it takes @ref StringView, it's
+usable also with @ref MutableStringView, @ref String and C string literals.
+*/
+CORRADE_UTILITY_EXPORT bool operator==(StringView a, StringView b);
+
+/** @brief String view non-equality comparison */
+CORRADE_UTILITY_EXPORT bool operator!=(StringView a, StringView b);
+
+/**
+@brief String view less-than comparison
+
+Lexicographical comparison of the contents, with a shorter prefix ordered
+before the longer string, same as @ref std::string.
+*/
+CORRADE_UTILITY_EXPORT bool operator<(StringView a, StringView b);
+
+/** @brief String view less-than-or-equal comparison */
+CORRADE_UTILITY_EXPORT bool operator<=(StringView a, StringView b);
+
+/** @brief String view greater-than comparison */
+CORRADE_UTILITY_EXPORT bool operator>(StringView a, StringView b);
+
+/** @brief String view greater-than-or-equal comparison */
+CORRADE_UTILITY_EXPORT bool operator>=(StringView a, StringView b);
+
+/** @debugoperator{BasicStringView} */
+CORRADE_UTILITY_EXPORT Utility::Debug& operator<<(Utility::Debug& debug, StringView value);
+
+namespace Literals {
+
+/** @relatesalso Corrade::Containers::BasicStringView
+@brief String view literal
+
+Creates a @ref StringView with the size known at compile time, so it can be
+used in a @cpp constexpr @ce context:
+
+@snippet Containers.cpp StringView-literal
+*/
+constexpr StringView operator"" _s(const char* data, std::size_t size) {
+    return StringView{data, size};
+}
+
+}
+
+template<class T> T& BasicStringView<T>::front() const {
+    CORRADE_ASSERT(_size, "Containers::StringView::front(): view is empty", _data[0]);
+    return _data[0];
+}
+
+template<class T> T& BasicStringView<T>::back() const {
+    CORRADE_ASSERT(_size, "Containers::StringView::back(): view is empty", _data[_size - 1]);
+    return _data[_size - 1];
+}
+
+template<class T> constexpr BasicStringView<T> BasicStringView<T>::slice(T* const begin, T* const end) const {
+    return CORRADE_CONSTEXPR_ASSERT(_data <= begin && begin <= end && end <= _data + _size,
+            "Containers::StringView::slice(): slice ["
+            << Utility::Debug::nospace << begin - _data
+            << Utility::Debug::nospace << ":"
+            << Utility::Debug::nospace << end - _data
+            << Utility::Debug::nospace << "] out of range for" << _size
+            << "elements"),
+        BasicStringView<T>{begin, std::size_t(end - begin)};
+}
+
+template<class T> constexpr BasicStringView<T> BasicStringView<T>::slice(const std::size_t begin, const std::size_t end) const {
+    return CORRADE_CONSTEXPR_ASSERT(begin <= end && end <= _size,
+            "Containers::StringView::slice(): slice ["
+            << Utility::Debug::nospace << begin
+            << Utility::Debug::nospace << ":"
+            << Utility::Debug::nospace << end
+            << Utility::Debug::nospace << "] out of range for" << _size
+            << "elements"),
+        BasicStringView<T>{_data + begin, end - begin};
+}
+
+}}
+
+#endif
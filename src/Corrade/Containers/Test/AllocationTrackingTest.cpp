@@ -0,0 +1,351 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#define CORRADE_CONTAINERS_TRACK_ALLOCATIONS
+
+#include <sstream>
+
+#include "Corrade/Containers/AllocationTracking.h"
+#include "Corrade/Containers/GrowableArray.h"
+#include "Corrade/Containers/Pointer.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/Utility/DebugStl.h"
+
+namespace Corrade { namespace Containers { namespace Test { namespace {
+
+struct AllocationTrackingTest: TestSuite::Tester {
+    explicit AllocationTrackingTest();
+
+    void setup();
+    void teardown();
+
+    void debugEvent();
+
+    void array();
+    void arrayNoInit();
+    void arrayNoInitNonTrivial();
+    void arrayCustomDeleter();
+    template<class Allocator> void growable();
+    void growableMalloc();
+    void pointer();
+
+    void noTracker();
+    void tag();
+    void sampling();
+    void samplingZero();
+};
+
+/* Types local to this file so the templates instantiated here don't get
+   merged with instances compiled without the tracking enabled */
+struct Int {
+    int a;
+};
+
+struct NonTrivial {
+    NonTrivial() noexcept {}
+    NonTrivial(NonTrivial&& other) noexcept: a{other.a} {}
+    int a{};
+};
+
+struct Event {
+    AllocationEvent event;
+    const void* pointer;
+    const void* previousPointer;
+    std::size_t size;
+    const char* tag;
+};
+
+/* Fixed-size so recording the events doesn't allocate */
+struct Events {
+    Event events[64];
+    std::size_t count;
+} events;
+
+void record(void* state, AllocationEvent event, const void* pointer, const void* previousPointer, std::size_t size, const char* tag) {
+    Events& events = *static_cast<Events*>(state);
+    if(events.count < Containers::arraySize(events.events))
+        events.events[events.count] = Event{event, pointer, previousPointer, size, tag};
+    ++events.count;
+}
+
+AllocationTrackingTest::AllocationTrackingTest() {
+    addTests({&AllocationTrackingTest::debugEvent});
+
+    addTests({&AllocationTrackingTest::array,
+              &AllocationTrackingTest::arrayNoInit,
+              &AllocationTrackingTest::arrayNoInitNonTrivial,
+              &AllocationTrackingTest::arrayCustomDeleter,
+              &AllocationTrackingTest::growable<ArrayNewAllocator<Int>>,
+              &AllocationTrackingTest::growable<ArrayMallocAllocator<Int>>,
+              &AllocationTrackingTest::growable<ArrayAlignedAllocator<Int, 64>>,
+              &AllocationTrackingTest::growableMalloc,
+              &AllocationTrackingTest::pointer,
+
+              &AllocationTrackingTest::noTracker,
+              &AllocationTrackingTest::tag,
+              &AllocationTrackingTest::sampling,
+              &AllocationTrackingTest::samplingZero},
+        &AllocationTrackingTest::setup,
+        &AllocationTrackingTest::teardown);
+}
+
+template<class> struct AllocatorName;
+template<> struct AllocatorName<ArrayNewAllocator<Int>> {
+    static const char* name() { return "ArrayNewAllocator"; }
+};
+template<> struct AllocatorName<ArrayMallocAllocator<Int>> {
+    static const char* name() { return "ArrayMallocAllocator"; }
+};
+template<> struct AllocatorName<ArrayAlignedAllocator<Int, 64>> {
+    static const char* name() { return "ArrayAlignedAllocator"; }
+};
+
+void AllocationTrackingTest::setup() {
+    events.count = 0;
+    setAllocationTracker(record, &events);
+}
+
+void AllocationTrackingTest::teardown() {
+    setAllocationTracker(nullptr);
+}
+
+void AllocationTrackingTest::debugEvent() {
+    std::ostringstream out;
+    Utility::Debug{&out} << AllocationEvent::Reallocate << AllocationEvent(0xfe);
+    CORRADE_COMPARE(out.str(), "Containers::AllocationEvent::Reallocate Containers::AllocationEvent(0xfe)\n");
+}
+
+void AllocationTrackingTest::array() {
+    const void* a;
+    const void* b;
+    {
+        Array<Int> defaultInit{DefaultInit, 3};
+        Array<Int> valueInit{ValueInit, 5};
+        Array<Int> empty{ValueInit, 0};
+        a = defaultInit.data();
+        b = valueInit.data();
+    }
+
+    CORRADE_COMPARE(events.count, 4);
+    CORRADE_COMPARE(events.events[0].event, AllocationEvent::Allocate);
+    CORRADE_COMPARE(events.events[0].pointer, a);
+    CORRADE_VERIFY(!events.events[0].previousPointer);
+    CORRADE_COMPARE(events.events[0].size, 3*sizeof(Int));
+    CORRADE_COMPARE(events.events[1].event, AllocationEvent::Allocate);
+    CORRADE_COMPARE(events.events[1].pointer, b);
+    CORRADE_COMPARE(events.events[1].size, 5*sizeof(Int));
+    /* Destructed in reverse order, the empty array isn't reported */
+    CORRADE_COMPARE(events.events[2].event, AllocationEvent::Deallocate);
+    CORRADE_COMPARE(events.events[2].pointer, b);
+    CORRADE_COMPARE(events.events[2].size, 5*sizeof(Int));
+    CORRADE_COMPARE(events.events[3].event, AllocationEvent::Deallocate);
+    CORRADE_COMPARE(events.events[3].pointer, a);
+    CORRADE_COMPARE(events.events[3].size, 3*sizeof(Int));
+}
+
+void AllocationTrackingTest::arrayNoInit() {
+    const void* a;
+    {
+        Array<Int> noInit{NoInit, 7};
+        a = noInit.data();
+    }
+
+    CORRADE_COMPARE(events.count, 2);
+    CORRADE_COMPARE(events.events[0].event, AllocationEvent::Allocate);
+    CORRADE_COMPARE(events.events[0].pointer, a);
+    CORRADE_COMPARE(events.events[0].size, 7*sizeof(Int));
+    CORRADE_COMPARE(events.events[1].event, AllocationEvent::Deallocate);
+    CORRADE_COMPARE(events.events[1].pointer, a);
+    CORRADE_COMPARE(events.events[1].size, 7*sizeof(Int));
+}
+
+void AllocationTrackingTest::arrayNoInitNonTrivial() {
+    const void* a;
+    {
+        /* Goes through NoInit and the custom deleter */
+        Array<NonTrivial> direct{DirectInit, 4};
+        a = direct.data();
+    }
+
+    CORRADE_COMPARE(events.count, 2);
+    CORRADE_COMPARE(events.events[0].event, AllocationEvent::Allocate);
+    CORRADE_COMPARE(events.events[0].pointer, a);
+    CORRADE_COMPARE(events.events[0].size, 4*sizeof(NonTrivial));
+    CORRADE_COMPARE(events.events[1].event, AllocationEvent::Deallocate);
+    CORRADE_COMPARE(events.events[1].pointer, a);
+    CORRADE_COMPARE(events.events[1].size, 4*sizeof(NonTrivial));
+}
+
+void AllocationTrackingTest::arrayCustomDeleter() {
+    Int data[3]{};
+    {
+        Array<Int> a{data, 3, [](Int*, std::size_t) {}};
+    }
+
+    /* Memory not owned by the containers isn't reported */
+    CORRADE_COMPARE(events.count, 0);
+}
+
+template<class Allocator> void AllocationTrackingTest::growable() {
+    setTestCaseTemplateName(AllocatorName<Allocator>::name());
+
+    const void* a;
+    const void* b;
+    std::size_t capacity;
+    {
+        Array<Int> array;
+        arrayReserve<Int, Allocator>(array, 4);
+        a = array.data();
+        arrayResize<Int, Allocator>(array, 100);
+        b = array.data();
+        capacity = arrayCapacity<Int, Allocator>(array);
+    }
+
+    CORRADE_COMPARE(events.count, 3);
+    CORRADE_COMPARE(events.events[0].event, AllocationEvent::Allocate);
+    CORRADE_COMPARE(events.events[0].pointer, a);
+    CORRADE_VERIFY(!events.events[0].previousPointer);
+    CORRADE_COMPARE(events.events[0].size, 4*sizeof(Int));
+    CORRADE_COMPARE(events.events[1].event, AllocationEvent::Reallocate);
+    CORRADE_COMPARE(events.events[1].pointer, b);
+    CORRADE_COMPARE(events.events[1].previousPointer, a);
+    CORRADE_COMPARE(events.events[1].size, capacity*sizeof(Int));
+    CORRADE_COMPARE(events.events[2].event, AllocationEvent::Deallocate);
+    CORRADE_COMPARE(events.events[2].pointer, b);
+    CORRADE_COMPARE(events.events[2].size, capacity*sizeof(Int));
+}
+
+void AllocationTrackingTest::growableMalloc() {
+    /* The default allocator for trivial types goes through malloc */
+    const void* a;
+    {
+        Array<Int> array;
+        arrayAppend(array, Int{3});
+        a = array.data();
+    }
+
+    CORRADE_COMPARE(events.count, 2);
+    CORRADE_COMPARE(events.events[0].event, AllocationEvent::Allocate);
+    CORRADE_COMPARE(events.events[0].pointer, a);
+    CORRADE_COMPARE(events.events[1].event, AllocationEvent::Deallocate);
+    CORRADE_COMPARE(events.events[1].pointer, a);
+    CORRADE_COMPARE(events.events[1].size, events.events[0].size);
+}
+
+void AllocationTrackingTest::pointer() {
+    const void* a;
+    const void* b;
+    {
+        Pointer<Int> p{InPlaceInit, 3};
+        a = p.get();
+        p.emplace(5);
+        b = p.get();
+    }
+
+    CORRADE_COMPARE(events.count, 4);
+    CORRADE_COMPARE(events.events[0].event, AllocationEvent::Allocate);
+    CORRADE_COMPARE(events.events[0].pointer, a);
+    CORRADE_COMPARE(events.events[0].size, sizeof(Int));
+    CORRADE_COMPARE(events.events[1].event, AllocationEvent::Deallocate);
+    CORRADE_COMPARE(events.events[1].pointer, a);
+    CORRADE_COMPARE(events.events[1].size, sizeof(Int));
+    CORRADE_COMPARE(events.events[2].event, AllocationEvent::Allocate);
+    CORRADE_COMPARE(events.events[2].pointer, b);
+    CORRADE_COMPARE(events.events[3].event, AllocationEvent::Deallocate);
+    CORRADE_COMPARE(events.events[3].pointer, b);
+}
+
+void AllocationTrackingTest::noTracker() {
+    setAllocationTracker(nullptr);
+
+    {
+        Array<Int> a{ValueInit, 3};
+        Pointer<Int> b{InPlaceInit};
+    }
+
+    CORRADE_COMPARE(events.count, 0);
+}
+
+void AllocationTrackingTest::tag() {
+    const char* const outerTag = "outer";
+    const char* const innerTag = "inner";
+
+    CORRADE_VERIFY(!allocationTag());
+
+    {
+        ScopedAllocationTag outer{outerTag};
+        Array<Int> a{ValueInit, 3};
+        {
+            ScopedAllocationTag inner{innerTag};
+            CORRADE_COMPARE(static_cast<const void*>(allocationTag()), innerTag);
+            Array<Int> b{ValueInit, 3};
+        }
+        CORRADE_COMPARE(static_cast<const void*>(allocationTag()), outerTag);
+    }
+
+    CORRADE_VERIFY(!allocationTag());
+
+    Array<Int> c{ValueInit, 3};
+
+    CORRADE_COMPARE(events.count, 5);
+    CORRADE_COMPARE(static_cast<const void*>(events.events[0].tag), outerTag);
+    CORRADE_COMPARE(static_cast<const void*>(events.events[1].tag), innerTag);
+    CORRADE_COMPARE(static_cast<const void*>(events.events[2].tag), innerTag);
+    CORRADE_COMPARE(static_cast<const void*>(events.events[3].tag), outerTag);
+    CORRADE_VERIFY(!events.events[4].tag);
+}
+
+void AllocationTrackingTest::sampling() {
+    setAllocationTracker(record, &events, 8);
+
+    /* Keep all allocations alive so they get distinct addresses */
+    Pointer<Int> pointers[256];
+    for(Pointer<Int>& p: pointers) p.emplace();
+
+    const std::size_t allocated = events.count;
+    CORRADE_VERIFY(allocated > 0);
+    CORRADE_VERIFY(allocated < 128);
+    for(std::size_t i = 0; i != allocated && i != Containers::arraySize(events.events); ++i)
+        CORRADE_COMPARE(events.events[i].event, AllocationEvent::Allocate);
+
+    /* Exactly the sampled allocations get their deallocations reported */
+    for(Pointer<Int>& p: pointers) p.reset();
+    CORRADE_COMPARE(events.count, allocated*2);
+}
+
+void AllocationTrackingTest::samplingZero() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Utility::Error redirectError{&out};
+    setAllocationTracker(record, &events, 0);
+    CORRADE_COMPARE(out.str(), "Containers::setAllocationTracker(): sample rate can't be zero\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::AllocationTrackingTest)
@@ -0,0 +1,325 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+
+#include "Corrade/Containers/ArrayArena.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/Utility/DebugStl.h"
+
+namespace Corrade { namespace Containers { namespace Test { namespace {
+
+struct ArrayArenaTest: TestSuite::Tester {
+    explicit ArrayArenaTest();
+
+    void construct();
+    void allocate();
+    void allocateAligned();
+    void allocateLarge();
+    void growInPlace();
+    void release();
+    void reset();
+
+    void scope();
+    void scopeNested();
+
+    void allocatorAppend();
+    void allocatorAppendNonTrivial();
+    void allocatorGrowInPlace();
+    void allocatorNoArena();
+
+    void benchmarkShortLivedMalloc();
+    void benchmarkShortLivedArena();
+};
+
+struct Movable {
+    static int constructed;
+    static int destructed;
+
+    /*implicit*/ Movable(int a = 0) noexcept: a{a} { ++constructed; }
+    Movable(const Movable&) = delete;
+    Movable(Movable&& other) noexcept: a(other.a) { ++constructed; }
+    ~Movable() { ++destructed; }
+    Movable& operator=(const Movable&) = delete;
+    Movable& operator=(Movable&&) = delete;
+
+    int a;
+};
+
+int Movable::constructed = 0;
+int Movable::destructed = 0;
+
+ArrayArenaTest::ArrayArenaTest() {
+    addTests({&ArrayArenaTest::construct,
+              &ArrayArenaTest::allocate,
+              &ArrayArenaTest::allocateAligned,
+              &ArrayArenaTest::allocateLarge,
+              &ArrayArenaTest::growInPlace,
+              &ArrayArenaTest::release,
+              &ArrayArenaTest::reset,
+
+              &ArrayArenaTest::scope,
+              &ArrayArenaTest::scopeNested,
+
+              &ArrayArenaTest::allocatorAppend,
+              &ArrayArenaTest::allocatorAppendNonTrivial,
+              &ArrayArenaTest::allocatorGrowInPlace,
+              &ArrayArenaTest::allocatorNoArena});
+
+    addBenchmarks({&ArrayArenaTest::benchmarkShortLivedMalloc,
+                   &ArrayArenaTest::benchmarkShortLivedArena}, 10);
+}
+
+void ArrayArenaTest::construct() {
+    ArrayArena arena{1024};
+    CORRADE_COMPARE(arena.blockSize(), 1024);
+    CORRADE_COMPARE(arena.blockCount(), 0);
+    CORRADE_COMPARE(arena.usedSize(), 0);
+
+    CORRADE_VERIFY(!std::is_copy_constructible<ArrayArena>::value);
+    CORRADE_VERIFY(!std::is_copy_assignable<ArrayArena>::value);
+}
+
+void ArrayArenaTest::allocate() {
+    ArrayArena arena{1024};
+    char* a = static_cast<char*>(arena.allocate(16, 1));
+    char* b = static_cast<char*>(arena.allocate(16, 1));
+    CORRADE_VERIFY(a);
+    CORRADE_COMPARE(b, a + 16);
+    CORRADE_COMPARE(arena.blockCount(), 1);
+    CORRADE_COMPARE(arena.usedSize(), 32);
+
+    /* Not enough space in the first block, a new one gets allocated */
+    arena.allocate(1000, 1);
+    CORRADE_COMPARE(arena.blockCount(), 2);
+    CORRADE_COMPARE(arena.usedSize(), 1024 + 1000);
+}
+
+void ArrayArenaTest::allocateAligned() {
+    ArrayArena arena{1024};
+    arena.allocate(3, 1);
+    void* a = arena.allocate(8, 16);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(a) % 16, 0);
+    void* b = arena.allocate(1, 64);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(b) % 64, 0);
+}
+
+void ArrayArenaTest::allocateLarge() {
+    ArrayArena arena{64};
+    arena.allocate(16, 1);
+
+    /* Larger than block size, gets a dedicated block */
+    char* a = static_cast<char*>(arena.allocate(1000, 1));
+    CORRADE_COMPARE(arena.blockCount(), 2);
+    a[999] = 'a'; /* ASan would complain if this was wrong */
+    CORRADE_COMPARE(a[999], 'a');
+}
+
+void ArrayArenaTest::growInPlace() {
+    ArrayArena arena{1024};
+    void* a = arena.allocate(16, 1);
+    CORRADE_VERIFY(arena.growInPlace(a, 32));
+    CORRADE_COMPARE(arena.usedSize(), 32);
+
+    /* Too large */
+    CORRADE_VERIFY(!arena.growInPlace(a, 2048));
+    CORRADE_COMPARE(arena.usedSize(), 32);
+
+    /* Not the last allocation anymore */
+    void* b = arena.allocate(16, 1);
+    CORRADE_VERIFY(!arena.growInPlace(a, 64));
+    CORRADE_VERIFY(arena.growInPlace(b, 64));
+    CORRADE_COMPARE(arena.usedSize(), 32 + 64);
+}
+
+void ArrayArenaTest::release() {
+    ArrayArena arena{1024};
+    void* a = arena.allocate(16, 1);
+    void* b = arena.allocate(16, 1);
+
+    /* Not the last allocation, nothing happens */
+    arena.release(a);
+    CORRADE_COMPARE(arena.usedSize(), 32);
+
+    /* The last allocation gets rewound and reused */
+    arena.release(b);
+    CORRADE_COMPARE(arena.usedSize(), 16);
+    CORRADE_COMPARE(arena.allocate(16, 1), b);
+}
+
+void ArrayArenaTest::reset() {
+    ArrayArena arena{1024};
+    void* a = arena.allocate(1000, 1);
+    arena.allocate(1000, 1);
+    arena.allocate(1000, 1);
+    CORRADE_COMPARE(arena.blockCount(), 3);
+
+    /* The blocks are kept and reused in the same order */
+    arena.reset();
+    CORRADE_COMPARE(arena.usedSize(), 0);
+    CORRADE_COMPARE(arena.blockCount(), 3);
+    CORRADE_COMPARE(arena.allocate(1000, 1), a);
+    arena.allocate(1000, 1);
+    arena.allocate(1000, 1);
+    CORRADE_COMPARE(arena.blockCount(), 3);
+}
+
+void ArrayArenaTest::scope() {
+    CORRADE_VERIFY(!ArrayArena::current());
+
+    ArrayArena arena;
+    {
+        ArrayArenaScope scope{arena};
+        CORRADE_COMPARE(ArrayArena::current(), &arena);
+    }
+
+    CORRADE_VERIFY(!ArrayArena::current());
+}
+
+void ArrayArenaTest::scopeNested() {
+    ArrayArena a, b;
+    {
+        ArrayArenaScope scopeA{a};
+        CORRADE_COMPARE(ArrayArena::current(), &a);
+        {
+            ArrayArenaScope scopeB{b};
+            CORRADE_COMPARE(ArrayArena::current(), &b);
+        }
+        CORRADE_COMPARE(ArrayArena::current(), &a);
+    }
+
+    CORRADE_VERIFY(!ArrayArena::current());
+}
+
+void ArrayArenaTest::allocatorAppend() {
+    ArrayArena arena;
+    ArrayArenaScope scope{arena};
+
+    Array<int> a;
+    for(int i = 0; i != 100; ++i)
+        arrayAppend<ArrayArenaAllocator>(a, i);
+    CORRADE_VERIFY(arrayIsGrowable<ArrayArenaAllocator>(a));
+    CORRADE_COMPARE(a.size(), 100);
+    CORRADE_COMPARE(a[0], 0);
+    CORRADE_COMPARE(a[99], 99);
+    CORRADE_COMPARE(arena.blockCount(), 1);
+
+    /* Shrinking turns it into a regular heap array */
+    arrayShrink<ArrayArenaAllocator>(a);
+    CORRADE_VERIFY(!arrayIsGrowable<ArrayArenaAllocator>(a));
+    CORRADE_COMPARE(a.size(), 100);
+    CORRADE_COMPARE(a[99], 99);
+}
+
+void ArrayArenaTest::allocatorAppendNonTrivial() {
+    Movable::constructed = Movable::destructed = 0;
+
+    {
+        ArrayArena arena;
+        ArrayArenaScope scope{arena};
+
+        Array<Movable> a;
+        Array<Movable> b;
+        for(int i = 0; i != 10; ++i) {
+            /* Interleaving the two so they can't be grown in-place */
+            arrayAppend<ArrayArenaAllocator>(a, InPlaceInit, i);
+            arrayAppend<ArrayArenaAllocator>(b, InPlaceInit, i*10);
+        }
+        CORRADE_COMPARE(a.size(), 10);
+        CORRADE_COMPARE(a[9].a, 9);
+        CORRADE_COMPARE(b[9].a, 90);
+    }
+
+    CORRADE_VERIFY(Movable::constructed > 20);
+    CORRADE_COMPARE(Movable::constructed, Movable::destructed);
+}
+
+void ArrayArenaTest::allocatorGrowInPlace() {
+    ArrayArena arena;
+    ArrayArenaScope scope{arena};
+
+    Array<int> a;
+    arrayAppend<ArrayArenaAllocator>(a, 1);
+    const int* prev = a.data();
+    arrayReserve<ArrayArenaAllocator>(a, 1000);
+    CORRADE_COMPARE(a.data(), prev);
+    CORRADE_COMPARE(arrayCapacity<ArrayArenaAllocator>(a), 1000);
+    CORRADE_COMPARE(a[0], 1);
+
+    /* Freeing the last allocation rewinds the arena */
+    const std::size_t used = arena.usedSize();
+    Array<int> b;
+    arrayResize<ArrayArenaAllocator>(b, 10);
+    CORRADE_VERIFY(arena.usedSize() > used);
+    b = nullptr;
+    CORRADE_COMPARE(arena.usedSize(), used);
+}
+
+void ArrayArenaTest::allocatorNoArena() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    ArrayArenaAllocator<int>::allocate(10);
+    CORRADE_COMPARE(out.str(), "Containers::ArrayArenaAllocator: no arena is current\n");
+}
+
+void ArrayArenaTest::benchmarkShortLivedMalloc() {
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != 1000; ++i) {
+            Array<int> a;
+            for(int j = 0; j != 100; ++j)
+                arrayAppend<ArrayMallocAllocator>(a, j);
+            size += a.size();
+        }
+    }
+
+    CORRADE_COMPARE(size, 1000*100);
+}
+
+void ArrayArenaTest::benchmarkShortLivedArena() {
+    ArrayArena arena;
+    ArrayArenaScope scope{arena};
+
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != 1000; ++i) {
+            Array<int> a;
+            for(int j = 0; j != 100; ++j)
+                arrayAppend<ArrayArenaAllocator>(a, j);
+            size += a.size();
+        }
+        arena.reset();
+    }
+
+    CORRADE_COMPARE(size, 1000*100);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::ArrayArenaTest)
@@ -0,0 +1,233 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+
+#include "Corrade/Containers/ArrayFileAllocator.h"
+#include "Corrade/Containers/StringStl.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Container.h"
+#include "Corrade/TestSuite/Compare/Numeric.h"
+#include "Corrade/Utility/DebugStl.h"
+#include "Corrade/Utility/Directory.h"
+#include "Corrade/Utility/Memory.h"
+
+namespace Corrade { namespace Containers { namespace Test { namespace {
+
+struct ArrayFileAllocatorTest: TestSuite::Tester {
+    explicit ArrayFileAllocatorTest();
+
+    void setup();
+    void teardown();
+
+    void mapNew();
+    void mapExisting();
+    void appendPersist();
+    void appendLarge();
+    void reserveDeallocate();
+    void shrink();
+    void anonymous();
+    void mapInvalidSize();
+    void mapNonexistentDirectory();
+
+    private:
+        std::string _filename;
+};
+
+struct Record {
+    int id;
+    float value;
+};
+
+ArrayFileAllocatorTest::ArrayFileAllocatorTest() {
+    addTests({&ArrayFileAllocatorTest::mapNew,
+              &ArrayFileAllocatorTest::mapExisting,
+              &ArrayFileAllocatorTest::appendPersist,
+              &ArrayFileAllocatorTest::appendLarge,
+              &ArrayFileAllocatorTest::reserveDeallocate,
+              &ArrayFileAllocatorTest::shrink},
+        &ArrayFileAllocatorTest::setup,
+        &ArrayFileAllocatorTest::teardown);
+
+    addTests({&ArrayFileAllocatorTest::anonymous});
+
+    addTests({&ArrayFileAllocatorTest::mapInvalidSize},
+        &ArrayFileAllocatorTest::setup,
+        &ArrayFileAllocatorTest::teardown);
+
+    addTests({&ArrayFileAllocatorTest::mapNonexistentDirectory});
+
+    _filename = Utility::Directory::join(Utility::Directory::tmp(), "corrade-ArrayFileAllocatorTest.bin");
+}
+
+void ArrayFileAllocatorTest::setup() {
+    if(Utility::Directory::exists(_filename))
+        Utility::Directory::rm(_filename);
+}
+
+void ArrayFileAllocatorTest::teardown() {
+    if(Utility::Directory::exists(_filename))
+        Utility::Directory::rm(_filename);
+}
+
+void ArrayFileAllocatorTest::mapNew() {
+    {
+        Array<Record> a = arrayMapFile<Record>(_filename);
+        CORRADE_VERIFY(a.data());
+        CORRADE_COMPARE(a.size(), 0);
+        CORRADE_VERIFY(arrayIsGrowable<ArrayFileAllocator>(a));
+
+        /* The capacity is a whole page, the bookkeeping is not in it */
+        CORRADE_COMPARE(arrayCapacity<ArrayFileAllocator>(a), Utility::Memory::pageSize()/sizeof(Record));
+        CORRADE_COMPARE(ArrayFileAllocator<Record>::base(a.data()), reinterpret_cast<char*>(a.data()) - Utility::Memory::pageSize());
+    }
+
+    /* The file is created and is empty after destruction */
+    CORRADE_VERIFY(Utility::Directory::exists(_filename));
+    CORRADE_COMPARE(Utility::Directory::read(_filename).size(), 0);
+}
+
+void ArrayFileAllocatorTest::mapExisting() {
+    const Record data[]{{1, 1.5f}, {2, 2.5f}, {3, 3.5f}};
+    CORRADE_VERIFY(Utility::Directory::write(_filename, arrayView(data)));
+
+    {
+        Array<Record> a = arrayMapFile<Record>(_filename);
+        CORRADE_COMPARE(a.size(), 3);
+        CORRADE_COMPARE(a[0].id, 1);
+        CORRADE_COMPARE(a[2].value, 3.5f);
+
+        /* Modifying the data in-place */
+        a[1].value = 7.5f;
+    }
+
+    Array<char> file = Utility::Directory::read(_filename);
+    CORRADE_COMPARE(file.size(), 3*sizeof(Record));
+    CORRADE_COMPARE(reinterpret_cast<const Record*>(file.data())[1].value, 7.5f);
+}
+
+void ArrayFileAllocatorTest::appendPersist() {
+    {
+        Array<Record> a = arrayMapFile<Record>(_filename);
+        arrayAppend<ArrayFileAllocator>(a, Record{1, 1.5f});
+        arrayAppend<ArrayFileAllocator>(a, Record{2, 2.5f});
+    }
+
+    /* Only the used size is persisted */
+    CORRADE_COMPARE(Utility::Directory::read(_filename).size(), 2*sizeof(Record));
+
+    /* Reopening and appending more */
+    {
+        Array<Record> a = arrayMapFile<Record>(_filename);
+        CORRADE_COMPARE(a.size(), 2);
+        arrayAppend<ArrayFileAllocator>(a, Record{3, 3.5f});
+        CORRADE_COMPARE(a.size(), 3);
+    }
+
+    Array<char> file = Utility::Directory::read(_filename);
+    CORRADE_COMPARE(file.size(), 3*sizeof(Record));
+    const Record* records = reinterpret_cast<const Record*>(file.data());
+    CORRADE_COMPARE(records[0].id, 1);
+    CORRADE_COMPARE(records[1].value, 2.5f);
+    CORRADE_COMPARE(records[2].id, 3);
+}
+
+void ArrayFileAllocatorTest::appendLarge() {
+    /* Enough to go through several reallocations */
+    {
+        Array<int> a = arrayMapFile<int>(_filename);
+        for(int i = 0; i != 1000000; ++i)
+            arrayAppend<ArrayFileAllocator>(a, i);
+        CORRADE_VERIFY(arrayIsGrowable<ArrayFileAllocator>(a));
+        CORRADE_COMPARE(a.size(), 1000000);
+        CORRADE_COMPARE(a[0], 0);
+        CORRADE_COMPARE(a[500000], 500000);
+        CORRADE_COMPARE(a[999999], 999999);
+    }
+
+    Array<char> file = Utility::Directory::read(_filename);
+    CORRADE_COMPARE(file.size(), 1000000*sizeof(int));
+    CORRADE_COMPARE(reinterpret_cast<const int*>(file.data())[999999], 999999);
+}
+
+void ArrayFileAllocatorTest::reserveDeallocate() {
+    {
+        Array<int> a = arrayMapFile<int>(_filename);
+        arrayReserve<ArrayFileAllocator>(a, 100000);
+        CORRADE_COMPARE(a.size(), 0);
+        CORRADE_COMPARE_AS(arrayCapacity<ArrayFileAllocator>(a), 100000,
+            TestSuite::Compare::GreaterOrEqual);
+
+        /* Deallocating keeps the file at full capacity */
+        const std::size_t capacity = arrayCapacity<ArrayFileAllocator>(a);
+        ArrayFileAllocator<int>::deallocate(a.release());
+        CORRADE_COMPARE(Utility::Directory::read(_filename).size(), capacity*sizeof(int));
+    }
+}
+
+void ArrayFileAllocatorTest::shrink() {
+    Array<int> a = arrayMapFile<int>(_filename);
+    arrayAppend<ArrayFileAllocator>(a, {1, 2, 3});
+    arrayShrink<ArrayFileAllocator>(a);
+    CORRADE_VERIFY(!arrayIsGrowable<ArrayFileAllocator>(a));
+    CORRADE_COMPARE_AS(a, arrayView({1, 2, 3}), TestSuite::Compare::Container);
+
+    /* The file got truncated and closed in the process */
+    CORRADE_COMPARE(Utility::Directory::read(_filename).size(), 3*sizeof(int));
+}
+
+void ArrayFileAllocatorTest::anonymous() {
+    /* Not file-backed, behaves like ArrayMappedAllocator */
+    Array<int> a;
+    for(int i = 0; i != 100000; ++i)
+        arrayAppend<ArrayFileAllocator>(a, i);
+    CORRADE_VERIFY(arrayIsGrowable<ArrayFileAllocator>(a));
+    CORRADE_COMPARE(a.size(), 100000);
+    CORRADE_COMPARE(a[0], 0);
+    CORRADE_COMPARE(a[99999], 99999);
+}
+
+void ArrayFileAllocatorTest::mapInvalidSize() {
+    CORRADE_VERIFY(Utility::Directory::write(_filename, arrayView("hello")));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!arrayMapFile<Record>(_filename));
+    CORRADE_COMPARE(out.str(), "Containers::arrayMapFile(): size 6 of " + _filename + " is not a multiple of 8 bytes\n");
+
+    /* The file is left untouched */
+    CORRADE_COMPARE(Utility::Directory::read(_filename).size(), 6);
+}
+
+void ArrayFileAllocatorTest::mapNonexistentDirectory() {
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!arrayMapFile<Record>("/nonexistent/file.bin"));
+    CORRADE_COMPARE(out.str(), "Containers::arrayMapFile(): can't open /nonexistent/file.bin: No such file or directory\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::ArrayFileAllocatorTest)
@@ -0,0 +1,144 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Corrade/Containers/ArrayMappedAllocator.h"
+#include "Corrade/TestSuite/Tester.h"
+
+namespace Corrade { namespace Containers { namespace Test { namespace {
+
+struct ArrayMappedAllocatorTest: TestSuite::Tester {
+    explicit ArrayMappedAllocatorTest();
+
+    void reserve();
+    void append();
+    void resizeLarge();
+    void shrink();
+    void placement();
+
+    void benchmarkResizeMalloc();
+    void benchmarkResizeMapped();
+};
+
+ArrayMappedAllocatorTest::ArrayMappedAllocatorTest() {
+    addTests({&ArrayMappedAllocatorTest::reserve,
+              &ArrayMappedAllocatorTest::append,
+              &ArrayMappedAllocatorTest::resizeLarge,
+              &ArrayMappedAllocatorTest::shrink,
+              &ArrayMappedAllocatorTest::placement});
+
+    addBenchmarks({&ArrayMappedAllocatorTest::benchmarkResizeMalloc,
+                   &ArrayMappedAllocatorTest::benchmarkResizeMapped}, 5);
+}
+
+void ArrayMappedAllocatorTest::reserve() {
+    Array<int> a;
+    arrayReserve<ArrayMappedAllocator>(a, 1);
+    CORRADE_VERIFY(arrayIsGrowable<ArrayMappedAllocator>(a));
+    CORRADE_COMPARE(a.size(), 0);
+
+    /* The capacity is rounded to whole pages */
+    const std::size_t pageSize = Utility::Memory::pageSize();
+    CORRADE_COMPARE(arrayCapacity<ArrayMappedAllocator>(a), (pageSize - 2*sizeof(std::size_t))/sizeof(int));
+
+    /* The data are aligned to 16 bytes on 64-bit, 8 bytes on 32-bit */
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(a.data()) % (2*sizeof(std::size_t)), 0);
+}
+
+void ArrayMappedAllocatorTest::append() {
+    Array<int> a;
+    for(int i = 0; i != 10000; ++i)
+        arrayAppend<ArrayMappedAllocator>(a, i);
+    CORRADE_VERIFY(arrayIsGrowable<ArrayMappedAllocator>(a));
+    CORRADE_COMPARE(a.size(), 10000);
+    CORRADE_COMPARE(a[0], 0);
+    CORRADE_COMPARE(a[5000], 5000);
+    CORRADE_COMPARE(a[9999], 9999);
+}
+
+void ArrayMappedAllocatorTest::resizeLarge() {
+    Array<char> a;
+    arrayResize<ArrayMappedAllocator>(a, NoInit, 1024*1024);
+    a[0] = 'a';
+    a[1024*1024 - 1] = 'z';
+
+    arrayResize<ArrayMappedAllocator>(a, ValueInit, 64*1024*1024);
+    CORRADE_COMPARE(a.size(), 64*1024*1024);
+    CORRADE_COMPARE(a[0], 'a');
+    CORRADE_COMPARE(a[1024*1024 - 1], 'z');
+    CORRADE_COMPARE(a[64*1024*1024 - 1], 0);
+}
+
+void ArrayMappedAllocatorTest::shrink() {
+    Array<int> a;
+    arrayAppend<ArrayMappedAllocator>(a, {1, 2, 3});
+    arrayShrink<ArrayMappedAllocator>(a);
+    CORRADE_VERIFY(!arrayIsGrowable<ArrayMappedAllocator>(a));
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_COMPARE(a[2], 3);
+}
+
+template<class T> using HugeInterleavedAllocator = BasicArrayMappedAllocator<T, Utility::Memory::PageSize::TransparentHuge, Utility::Memory::NumaNodeInterleaved>;
+
+void ArrayMappedAllocatorTest::placement() {
+    Array<int> a;
+    arrayReserve<HugeInterleavedAllocator>(a, 1);
+    CORRADE_VERIFY(arrayIsGrowable<HugeInterleavedAllocator>(a));
+    /* A different variant has a different deleter */
+    CORRADE_VERIFY(!arrayIsGrowable<ArrayMappedAllocator>(a));
+
+    /* The capacity is rounded to whole (huge) pages */
+    const std::size_t pageSize = Utility::Memory::pageSize(Utility::Memory::PageSize::TransparentHuge);
+    CORRADE_COMPARE(arrayCapacity<HugeInterleavedAllocator>(a), (pageSize - 2*sizeof(std::size_t))/sizeof(int));
+
+    for(int i = 0; i != 1000000; ++i)
+        arrayAppend<HugeInterleavedAllocator>(a, i);
+    CORRADE_VERIFY(arrayIsGrowable<HugeInterleavedAllocator>(a));
+    CORRADE_COMPARE(a.size(), 1000000);
+    CORRADE_COMPARE(a[0], 0);
+    CORRADE_COMPARE(a[500000], 500000);
+    CORRADE_COMPARE(a[999999], 999999);
+}
+
+void ArrayMappedAllocatorTest::benchmarkResizeMalloc() {
+    Array<char> a;
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 1; i <= 256; ++i)
+            arrayResize<ArrayMallocAllocator>(a, NoInit, i*1024*1024);
+        a = nullptr;
+    }
+}
+
+void ArrayMappedAllocatorTest::benchmarkResizeMapped() {
+    Array<char> a;
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 1; i <= 256; ++i)
+            arrayResize<ArrayMappedAllocator>(a, NoInit, i*1024*1024);
+        a = nullptr;
+    }
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::ArrayMappedAllocatorTest)
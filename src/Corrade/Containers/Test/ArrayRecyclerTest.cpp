@@ -0,0 +1,445 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+
+#include "Corrade/Containers/ArrayRecycler.h"
+#include "Corrade/TestSuite/Tester.h"
+
+namespace Corrade { namespace Containers { namespace Test { namespace {
+
+struct ArrayRecyclerTest: TestSuite::Tester {
+    explicit ArrayRecyclerTest();
+
+    void resetCache();
+
+    void construct();
+    void allocate();
+    void allocateZero();
+    void reuse();
+    void reuseDifferentSizeClass();
+    void releaseNull();
+    void maxCachedSize();
+    void trim();
+    void threadLocal();
+
+    void recycledArray();
+    void recycledArrayNoInit();
+    void recycledArrayNonTrivial();
+
+    void allocatorAppend();
+    void allocatorAppendNonTrivial();
+    void allocatorReserveWithinCapacity();
+    void allocatorShrinkToZeroReuse();
+
+    void benchmarkScratchMalloc();
+    void benchmarkScratchRecycled();
+};
+
+struct Movable {
+    static int constructed;
+    static int destructed;
+
+    /*implicit*/ Movable(int a = 0) noexcept: a{a} { ++constructed; }
+    Movable(const Movable&) = delete;
+    Movable(Movable&& other) noexcept: a(other.a) { ++constructed; }
+    ~Movable() { ++destructed; }
+    Movable& operator=(const Movable&) = delete;
+    Movable& operator=(Movable&&) = delete;
+
+    int a;
+};
+
+int Movable::constructed = 0;
+int Movable::destructed = 0;
+
+ArrayRecyclerTest::ArrayRecyclerTest() {
+    addTests({&ArrayRecyclerTest::construct,
+              &ArrayRecyclerTest::allocate,
+              &ArrayRecyclerTest::allocateZero,
+              &ArrayRecyclerTest::reuse,
+              &ArrayRecyclerTest::reuseDifferentSizeClass,
+              &ArrayRecyclerTest::releaseNull,
+              &ArrayRecyclerTest::maxCachedSize,
+              &ArrayRecyclerTest::trim,
+              &ArrayRecyclerTest::threadLocal,
+
+              &ArrayRecyclerTest::recycledArray,
+              &ArrayRecyclerTest::recycledArrayNoInit,
+              &ArrayRecyclerTest::recycledArrayNonTrivial,
+
+              &ArrayRecyclerTest::allocatorAppend,
+              &ArrayRecyclerTest::allocatorAppendNonTrivial,
+              &ArrayRecyclerTest::allocatorReserveWithinCapacity,
+              &ArrayRecyclerTest::allocatorShrinkToZeroReuse},
+        &ArrayRecyclerTest::resetCache,
+        &ArrayRecyclerTest::resetCache);
+
+    addBenchmarks({&ArrayRecyclerTest::benchmarkScratchMalloc,
+                   &ArrayRecyclerTest::benchmarkScratchRecycled}, 10,
+        &ArrayRecyclerTest::resetCache,
+        &ArrayRecyclerTest::resetCache);
+}
+
+/* The recycler is a global thread-local state, so make sure each test case
+   starts with an empty cache and the default limit */
+void ArrayRecyclerTest::resetCache() {
+    ArrayRecycler::current()
+        .setMaxCachedSize(256*1024*1024)
+        .trim();
+}
+
+void ArrayRecyclerTest::construct() {
+    ArrayRecycler& recycler = ArrayRecycler::current();
+    CORRADE_COMPARE(&ArrayRecycler::current(), &recycler);
+    CORRADE_COMPARE(recycler.maxCachedSize(), 256*1024*1024);
+    CORRADE_COMPARE(recycler.cachedSize(), 0);
+    CORRADE_COMPARE(recycler.cachedCount(), 0);
+
+    CORRADE_VERIFY(!std::is_copy_constructible<ArrayRecycler>::value);
+    CORRADE_VERIFY(!std::is_copy_assignable<ArrayRecycler>::value);
+}
+
+void ArrayRecyclerTest::allocate() {
+    ArrayRecycler& recycler = ArrayRecycler::current();
+
+    char* a = static_cast<char*>(recycler.allocate(1000));
+    CORRADE_VERIFY(a);
+    CORRADE_COMPARE(ArrayRecycler::capacity(a), 1024);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(a) % ArrayRecycler::Alignment, 0);
+    a[1023] = 'a'; /* ASan would complain if this was wrong */
+    CORRADE_COMPARE(a[1023], 'a');
+
+    /* Exact power of two isn't rounded further */
+    void* b = recycler.allocate(65536);
+    CORRADE_COMPARE(ArrayRecycler::capacity(b), 65536);
+
+    /* Nothing cached until released */
+    CORRADE_COMPARE(recycler.cachedCount(), 0);
+    recycler.release(a);
+    recycler.release(b);
+    CORRADE_COMPARE(recycler.cachedCount(), 2);
+    CORRADE_COMPARE(recycler.cachedSize(), 1024 + 65536);
+}
+
+void ArrayRecyclerTest::allocateZero() {
+    ArrayRecycler& recycler = ArrayRecycler::current();
+
+    /* Rounded up to the smallest size class */
+    void* a = recycler.allocate(0);
+    void* b = recycler.allocate(3);
+    CORRADE_COMPARE(ArrayRecycler::capacity(a), ArrayRecycler::MinBlockSize);
+    CORRADE_COMPARE(ArrayRecycler::capacity(b), ArrayRecycler::MinBlockSize);
+    recycler.release(a);
+    recycler.release(b);
+}
+
+void ArrayRecyclerTest::reuse() {
+    ArrayRecycler& recycler = ArrayRecycler::current();
+
+    void* a = recycler.allocate(1024*1024);
+    recycler.release(a);
+    CORRADE_COMPARE(recycler.cachedCount(), 1);
+    CORRADE_COMPARE(recycler.cachedSize(), 1024*1024);
+
+    /* A smaller allocation in the same size class gets the same block */
+    void* b = recycler.allocate(1024*1024 - 100);
+    CORRADE_COMPARE(b, a);
+    CORRADE_COMPARE(recycler.cachedCount(), 0);
+    CORRADE_COMPARE(recycler.cachedSize(), 0);
+
+    /* The most recently released block is reused first */
+    void* c = recycler.allocate(1024*1024);
+    recycler.release(b);
+    recycler.release(c);
+    CORRADE_COMPARE(recycler.allocate(1024*1024), c);
+    CORRADE_COMPARE(recycler.allocate(1024*1024), b);
+    recycler.release(b);
+    recycler.release(c);
+}
+
+void ArrayRecyclerTest::reuseDifferentSizeClass() {
+    ArrayRecycler& recycler = ArrayRecycler::current();
+
+    void* a = recycler.allocate(64*1024);
+    recycler.release(a);
+
+    /* Different size class, gets a new block */
+    void* b = recycler.allocate(64*1024 + 1);
+    CORRADE_VERIFY(b != a);
+    CORRADE_COMPARE(ArrayRecycler::capacity(b), 128*1024);
+    CORRADE_COMPARE(recycler.cachedCount(), 1);
+    recycler.release(b);
+}
+
+void ArrayRecyclerTest::releaseNull() {
+    ArrayRecycler& recycler = ArrayRecycler::current();
+    recycler.release(nullptr);
+    CORRADE_COMPARE(recycler.cachedCount(), 0);
+}
+
+void ArrayRecyclerTest::maxCachedSize() {
+    ArrayRecycler& recycler = ArrayRecycler::current();
+    recycler.setMaxCachedSize(3*1024*1024);
+    CORRADE_COMPARE(recycler.maxCachedSize(), 3*1024*1024);
+
+    void* a = recycler.allocate(1024*1024);
+    void* b = recycler.allocate(1024*1024);
+    void* c = recycler.allocate(2*1024*1024);
+    recycler.release(a);
+    recycler.release(b);
+    CORRADE_COMPARE(recycler.cachedSize(), 2*1024*1024);
+
+    /* This one would exceed the limit, so it's freed instead */
+    recycler.release(c);
+    CORRADE_COMPARE(recycler.cachedCount(), 2);
+    CORRADE_COMPARE(recycler.cachedSize(), 2*1024*1024);
+
+    /* Lowering the limit trims the cache */
+    recycler.setMaxCachedSize(1024*1024);
+    CORRADE_COMPARE(recycler.cachedCount(), 1);
+    CORRADE_COMPARE(recycler.cachedSize(), 1024*1024);
+}
+
+void ArrayRecyclerTest::trim() {
+    ArrayRecycler& recycler = ArrayRecycler::current();
+
+    void* a = recycler.allocate(64*1024);
+    void* b = recycler.allocate(1024*1024);
+    void* c = recycler.allocate(16*1024*1024);
+    recycler.release(a);
+    recycler.release(b);
+    recycler.release(c);
+    CORRADE_COMPARE(recycler.cachedCount(), 3);
+    CORRADE_COMPARE(recycler.cachedSize(), 64*1024 + 1024*1024 + 16*1024*1024);
+
+    /* The largest blocks are freed first */
+    recycler.trim(2*1024*1024);
+    CORRADE_COMPARE(recycler.cachedCount(), 2);
+    CORRADE_COMPARE(recycler.cachedSize(), 64*1024 + 1024*1024);
+    CORRADE_COMPARE(recycler.allocate(64*1024), a);
+    recycler.release(a);
+
+    /* Nothing to do */
+    recycler.trim(2*1024*1024);
+    CORRADE_COMPARE(recycler.cachedCount(), 2);
+
+    recycler.trim();
+    CORRADE_COMPARE(recycler.cachedCount(), 0);
+    CORRADE_COMPARE(recycler.cachedSize(), 0);
+}
+
+void ArrayRecyclerTest::threadLocal() {
+    #ifndef CORRADE_BUILD_MULTITHREADED
+    CORRADE_SKIP("CORRADE_BUILD_MULTITHREADED is not enabled.");
+    #elif defined(CORRADE_TARGET_EMSCRIPTEN) && !defined(__EMSCRIPTEN_PTHREADS__)
+    CORRADE_SKIP("Threads are not available.");
+    #else
+    ArrayRecycler& recycler = ArrayRecycler::current();
+    void* a = recycler.allocate(1024*1024);
+
+    ArrayRecycler* otherRecycler{};
+    std::size_t otherCachedCount{};
+    void* b{};
+    std::thread{[&]{
+        otherRecycler = &ArrayRecycler::current();
+
+        /* Released into the cache of the releasing thread */
+        ArrayRecycler::current().release(a);
+        otherCachedCount = ArrayRecycler::current().cachedCount();
+
+        /* The block allocated here outlives the thread, reusing the cached
+           block from above */
+        b = ArrayRecycler::current().allocate(1024*1024);
+
+        /* This one stays in the cache and gets freed on thread exit, ASan
+           would complain if it leaked */
+        ArrayRecycler::current().release(ArrayRecycler::current().allocate(64*1024));
+    }}.join();
+
+    CORRADE_VERIFY(otherRecycler != &recycler);
+    CORRADE_COMPARE(otherCachedCount, 1);
+    CORRADE_COMPARE(b, a);
+    CORRADE_COMPARE(recycler.cachedCount(), 0);
+
+    recycler.release(b);
+    CORRADE_COMPARE(recycler.cachedCount(), 1);
+    #endif
+}
+
+void ArrayRecyclerTest::recycledArray() {
+    Array<int> a = Containers::recycledArray<int>(1000);
+    CORRADE_COMPARE(a.size(), 1000);
+    CORRADE_VERIFY(a.deleter() == ArrayRecyclingAllocator<int>::deleter);
+    CORRADE_COMPARE(a[0], 0);
+    CORRADE_COMPARE(a[999], 0);
+
+    /* The memory gets back into the cache on destruction and reused */
+    const int* data = a.data();
+    a = nullptr;
+    CORRADE_COMPARE(ArrayRecycler::current().cachedCount(), 1);
+    CORRADE_COMPARE(ArrayRecycler::current().cachedSize(), 4096);
+
+    Array<char> b = Containers::recycledArray<char>(4000);
+    CORRADE_COMPARE(static_cast<const void*>(b.data()), static_cast<const void*>(data));
+    CORRADE_COMPARE(ArrayRecycler::current().cachedCount(), 0);
+}
+
+void ArrayRecyclerTest::recycledArrayNoInit() {
+    /* Put a known value into the block to verify it's not overwritten */
+    {
+        Array<char> a = Containers::recycledArray<char>(NoInit, 1000);
+        a[999] = 'a';
+    }
+
+    Array<char> a = Containers::recycledArray<char>(NoInit, 1000);
+    CORRADE_COMPARE(a.size(), 1000);
+    CORRADE_VERIFY(a.deleter() == ArrayRecyclingAllocator<char>::deleter);
+    CORRADE_COMPARE(a[999], 'a');
+}
+
+void ArrayRecyclerTest::recycledArrayNonTrivial() {
+    Movable::constructed = Movable::destructed = 0;
+
+    {
+        Array<Movable> a = Containers::recycledArray<Movable>(10);
+        CORRADE_COMPARE(a.size(), 10);
+        CORRADE_COMPARE(Movable::constructed, 10);
+    }
+
+    CORRADE_COMPARE(Movable::destructed, 10);
+}
+
+void ArrayRecyclerTest::allocatorAppend() {
+    Array<int> a;
+    for(int i = 0; i != 100; ++i)
+        arrayAppend<ArrayRecyclingAllocator>(a, i);
+    CORRADE_VERIFY(arrayIsGrowable<ArrayRecyclingAllocator>(a));
+    CORRADE_COMPARE(a.size(), 100);
+    CORRADE_COMPARE(a[0], 0);
+    CORRADE_COMPARE(a[99], 99);
+    /* The capacity is the whole power-of-two block */
+    CORRADE_COMPARE(arrayCapacity<ArrayRecyclingAllocator>(a), 128);
+
+    /* The intermediate blocks went back to the cache */
+    CORRADE_VERIFY(ArrayRecycler::current().cachedCount() > 0);
+
+    /* An array created with recycledArray() is growable with the allocator
+       as well */
+    Array<int> b = Containers::recycledArray<int>(3);
+    CORRADE_VERIFY(arrayIsGrowable<ArrayRecyclingAllocator>(b));
+    arrayAppend<ArrayRecyclingAllocator>(b, 7);
+    CORRADE_COMPARE(b.size(), 4);
+    CORRADE_COMPARE(b[2], 0);
+    CORRADE_COMPARE(b[3], 7);
+}
+
+void ArrayRecyclerTest::allocatorAppendNonTrivial() {
+    Movable::constructed = Movable::destructed = 0;
+
+    {
+        Array<Movable> a;
+        for(int i = 0; i != 100; ++i)
+            arrayAppend<ArrayRecyclingAllocator>(a, InPlaceInit, i);
+        CORRADE_COMPARE(a.size(), 100);
+        CORRADE_COMPARE(a[99].a, 99);
+    }
+
+    CORRADE_VERIFY(Movable::constructed > 100);
+    CORRADE_COMPARE(Movable::constructed, Movable::destructed);
+}
+
+void ArrayRecyclerTest::allocatorReserveWithinCapacity() {
+    Array<int> a;
+    arrayReserve<ArrayRecyclingAllocator>(a, 100);
+    const int* prev = a.data();
+    CORRADE_COMPARE(arrayCapacity<ArrayRecyclingAllocator>(a), 128);
+
+    /* Fits into the existing block, no reallocation */
+    for(int i = 0; i != 128; ++i)
+        arrayAppend<ArrayRecyclingAllocator>(a, i);
+    CORRADE_COMPARE(a.data(), prev);
+    CORRADE_COMPARE(a[127], 127);
+}
+
+void ArrayRecyclerTest::allocatorShrinkToZeroReuse() {
+    /* Under ASan, the container annotation of a shrunk array covers the
+       whole block. Releasing it (which writes a free list link at the front)
+       and reusing it for another array shouldn't trigger a container-overflow
+       report. */
+    const void* prev;
+    {
+        Array<char> a;
+        arrayResize<ArrayRecyclingAllocator>(a, 100);
+        prev = a.data();
+        arrayResize<ArrayRecyclingAllocator>(a, 0);
+    }
+    CORRADE_COMPARE(ArrayRecycler::current().cachedCount(), 1);
+
+    Array<char> b;
+    arrayResize<ArrayRecyclingAllocator>(b, 100);
+    CORRADE_COMPARE(static_cast<const void*>(b.data()), prev);
+    CORRADE_COMPARE(ArrayRecycler::current().cachedCount(), 0);
+    for(std::size_t i = 0; i != b.size(); ++i) b[i] = char(i);
+    CORRADE_COMPARE(b[99], 99);
+}
+
+/* Simulating a worker that repeatedly needs scratch buffers of a few common
+   sizes */
+constexpr std::size_t ScratchSizes[]{64*1024, 1024*1024, 16*1024*1024};
+
+void ArrayRecyclerTest::benchmarkScratchMalloc() {
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t scratchSize: ScratchSizes) {
+            char* a = static_cast<char*>(std::malloc(scratchSize));
+            a[scratchSize - 1] = 1;
+            size += a[scratchSize - 1];
+            std::free(a);
+        }
+    }
+
+    CORRADE_COMPARE(size, 10*3);
+}
+
+void ArrayRecyclerTest::benchmarkScratchRecycled() {
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t scratchSize: ScratchSizes) {
+            Array<char> a = Containers::recycledArray<char>(NoInit, scratchSize);
+            a[scratchSize - 1] = 1;
+            size += a[scratchSize - 1];
+        }
+    }
+
+    CORRADE_COMPARE(size, 10*3);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::ArrayRecyclerTest)
@@ -75,6 +75,9 @@ struct ArrayTest: TestSuite::Tester {
     void construct();
     void constructDefaultInit();
     void constructValueInit();
+    void constructValueInitLarge();
+    void constructCalloc();
+    void constructCallocEmpty();
     void constructNoInitNonTrivial();
     void constructNoInitTrivial();
     void constructDirectInit();
@@ -111,6 +114,10 @@ struct ArrayTest: TestSuite::Tester {
     void customDeleter();
     void customDeleterType();
     void customDeleterTypeConstruct();
+    void statelessDeleter();
+    void statelessDeleterConstruct();
+    void statelessDeleterMove();
+    void statelessDeleterConvert();
 
     void cast();
     void size();
@@ -128,6 +135,9 @@ ArrayTest::ArrayTest() {
               &ArrayTest::construct,
               &ArrayTest::constructDefaultInit,
               &ArrayTest::constructValueInit,
+              &ArrayTest::constructValueInitLarge,
+              &ArrayTest::constructCalloc,
+              &ArrayTest::constructCallocEmpty,
               &ArrayTest::constructNoInitNonTrivial,
               &ArrayTest::constructNoInitTrivial,
               &ArrayTest::constructDirectInit,
@@ -164,6 +174,10 @@ ArrayTest::ArrayTest() {
               &ArrayTest::customDeleter,
               &ArrayTest::customDeleterType,
               &ArrayTest::customDeleterTypeConstruct,
+              &ArrayTest::statelessDeleter,
+              &ArrayTest::statelessDeleterConstruct,
+              &ArrayTest::statelessDeleterMove,
+              &ArrayTest::statelessDeleterConvert,
 
               &ArrayTest::cast,
               &ArrayTest::size});
@@ -234,6 +248,44 @@ void ArrayTest::constructValueInit() {
     CORRADE_COMPARE(a[4], 0);
 }
 
+void ArrayTest::constructValueInitLarge() {
+    /* Large arrays use the default deleter as well, so release() can be
+       rewrapped with delete[] regardless of the size */
+    Array a{ValueInit, 1024*1024};
+    CORRADE_VERIFY(!a.deleter());
+    CORRADE_COMPARE(a[1024*1024 - 1], 0);
+
+    const Array b(1024*1024);
+    CORRADE_VERIFY(!b.deleter());
+    CORRADE_COMPARE(b[1024*1024 - 1], 0);
+
+    const Array c{a.release(), 1024*1024};
+    CORRADE_COMPARE(c[0], 0);
+}
+
+void ArrayTest::constructCalloc() {
+    const Array a = arrayCalloc<int>(1024*1024);
+    CORRADE_VERIFY(a);
+    CORRADE_COMPARE(a.size(), 1024*1024);
+    CORRADE_VERIFY(a.deleter());
+    CORRADE_COMPARE(a[0], 0);
+    CORRADE_COMPARE(a[512*1024], 0);
+    CORRADE_COMPARE(a[1024*1024 - 1], 0);
+
+    /* Small arrays are calloc()'d too, so the deleter is always the same */
+    const Array b = arrayCalloc<int>(5);
+    CORRADE_COMPARE(b.size(), 5);
+    CORRADE_VERIFY(b.deleter() == a.deleter());
+    CORRADE_COMPARE(b[4], 0);
+}
+
+void ArrayTest::constructCallocEmpty() {
+    const Array a = arrayCalloc<int>(0);
+    CORRADE_VERIFY(!a);
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_VERIFY(!a.deleter());
+}
+
 void ArrayTest::constructNoInitTrivial() {
     const Array a{NoInit, 5};
     CORRADE_VERIFY(a);
@@ -788,6 +840,106 @@ void ArrayTest::customDeleterTypeConstruct() {
     CORRADE_VERIFY(true);
 }
 
+int StatelessDeleterDeletedCount = 0;
+
+struct StatelessDeleter {
+    void operator()(int*, std::size_t size) { StatelessDeleterDeletedCount += size; }
+};
+
+void ArrayTest::statelessDeleter() {
+    /* The deleter isn't stored */
+    CORRADE_COMPARE(sizeof(Containers::Array<int, StatelessDeleter>), 2*sizeof(void*));
+    CORRADE_COMPARE(sizeof(Containers::Array<int, ArrayNewDeleter<int>>), 2*sizeof(void*));
+    CORRADE_COMPARE(sizeof(Containers::Array<int>), 3*sizeof(void*));
+
+    int data[25]{};
+    StatelessDeleterDeletedCount = 0;
+
+    {
+        Containers::Array<int, StatelessDeleter> a{data, 25};
+        CORRADE_VERIFY(a == data);
+        CORRADE_COMPARE(a.size(), 25);
+        CORRADE_COMPARE(StatelessDeleterDeletedCount, 0);
+    }
+
+    CORRADE_COMPARE(StatelessDeleterDeletedCount, 25);
+}
+
+void ArrayTest::statelessDeleterConstruct() {
+    Containers::Array<int, ArrayNewDeleter<int>> a;
+    CORRADE_VERIFY(!a);
+    CORRADE_COMPARE(a.size(), 0);
+
+    Containers::Array<int, ArrayNewDeleter<int>> b{5};
+    CORRADE_VERIFY(b);
+    CORRADE_COMPARE(b.size(), 5);
+
+    Containers::Array<int, ArrayNewDeleter<int>> c{ValueInit, 3};
+    CORRADE_COMPARE(c.size(), 3);
+    CORRADE_COMPARE(c[0], 0);
+    CORRADE_COMPARE(c[2], 0);
+
+    Containers::Array<int, ArrayNewDeleter<int>> d{NoInit, 4};
+    CORRADE_VERIFY(d);
+    CORRADE_COMPARE(d.size(), 4);
+
+    Containers::Array<int, ArrayNewDeleter<int>> e{DirectInit, 2, 7};
+    CORRADE_COMPARE(e.size(), 2);
+    CORRADE_COMPARE(e[0], 7);
+    CORRADE_COMPARE(e[1], 7);
+
+    Containers::Array<int, ArrayNewDeleter<int>> f{InPlaceInit, {1, 2, 3}};
+    CORRADE_COMPARE(f.size(), 3);
+    CORRADE_COMPARE(f[0], 1);
+    CORRADE_COMPARE(f[2], 3);
+
+    /* Wrapping memory allocated externally */
+    Containers::Array<int, ArrayNewDeleter<int>> g{new int[6]{}, 6};
+    CORRADE_COMPARE(g.size(), 6);
+}
+
+void ArrayTest::statelessDeleterMove() {
+    Containers::Array<int, ArrayNewDeleter<int>> a{InPlaceInit, {1, 2, 3}};
+    int* const data = a.data();
+
+    Containers::Array<int, ArrayNewDeleter<int>> b = std::move(a);
+    CORRADE_VERIFY(!a);
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_VERIFY(b.data() == data);
+    CORRADE_COMPARE(b.size(), 3);
+
+    Containers::Array<int, ArrayNewDeleter<int>> c{5};
+    c = std::move(b);
+    CORRADE_VERIFY(c.data() == data);
+    CORRADE_COMPARE(c.size(), 3);
+    CORRADE_COMPARE(b.size(), 5);
+
+    int* released = c.release();
+    CORRADE_VERIFY(released == data);
+    CORRADE_VERIFY(!c);
+    CORRADE_COMPARE(c.size(), 0);
+    delete[] released;
+}
+
+void ArrayTest::statelessDeleterConvert() {
+    Containers::Array<int, ArrayNewDeleter<int>> a{InPlaceInit, {1, 2, 3}};
+    int* const data = a.data();
+
+    /* Deleted with delete[] through the nullptr default deleter */
+    Containers::Array<int> b = std::move(a);
+    CORRADE_VERIFY(!a);
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_VERIFY(b.data() == data);
+    CORRADE_COMPARE(b.size(), 3);
+    CORRADE_VERIFY(b.deleter() == nullptr);
+    CORRADE_COMPARE(b[1], 2);
+
+    /* Only arrays with the default deleter are convertible */
+    CORRADE_VERIFY((std::is_convertible<Containers::Array<int, ArrayNewDeleter<int>>&&, Containers::Array<int>>::value));
+    CORRADE_VERIFY(!(std::is_convertible<Containers::Array<int, StatelessDeleter>&&, Containers::Array<int>>::value));
+    CORRADE_VERIFY(!(std::is_convertible<Containers::Array<int>&&, Containers::Array<int, ArrayNewDeleter<int>>>::value));
+}
+
 void ArrayTest::cast() {
     Containers::Array<std::uint32_t> a{6};
     const Containers::Array<std::uint32_t> ca{6};
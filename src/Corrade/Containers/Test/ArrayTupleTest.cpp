@@ -0,0 +1,358 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Containers/ArrayTuple.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/Utility/DebugStl.h"
+
+namespace Corrade { namespace Containers { namespace Test { namespace {
+
+struct ArrayTupleTest: TestSuite::Tester {
+    explicit ArrayTupleTest();
+
+    void constructDefault();
+    void constructNoItems();
+    void constructEmptyItems();
+    void constructValueInit();
+    void constructNoInit();
+    void constructDefaultInit();
+    void constructNonTrivial();
+    void constructAligned();
+    void constructAlignedLarge();
+    void constructInvalidAlignment();
+
+    void constructCopy();
+    void constructMove();
+
+    void release();
+};
+
+struct NonTrivial {
+    static int constructed;
+    static int destructed;
+    static int order[4];
+    static int orderCount;
+
+    explicit NonTrivial(): value{1337} { ++constructed; }
+    ~NonTrivial() {
+        if(orderCount < 4) order[orderCount++] = value;
+        ++destructed;
+    }
+
+    int value;
+};
+
+int NonTrivial::constructed = 0;
+int NonTrivial::destructed = 0;
+int NonTrivial::order[4]{};
+int NonTrivial::orderCount = 0;
+
+ArrayTupleTest::ArrayTupleTest() {
+    addTests({&ArrayTupleTest::constructDefault,
+              &ArrayTupleTest::constructNoItems,
+              &ArrayTupleTest::constructEmptyItems,
+              &ArrayTupleTest::constructValueInit,
+              &ArrayTupleTest::constructNoInit,
+              &ArrayTupleTest::constructDefaultInit,
+              &ArrayTupleTest::constructNonTrivial,
+              &ArrayTupleTest::constructAligned,
+              &ArrayTupleTest::constructAlignedLarge,
+              &ArrayTupleTest::constructInvalidAlignment,
+
+              &ArrayTupleTest::constructCopy,
+              &ArrayTupleTest::constructMove,
+
+              &ArrayTupleTest::release});
+}
+
+void ArrayTupleTest::constructDefault() {
+    ArrayTuple a;
+    CORRADE_VERIFY(!a.data());
+    CORRADE_COMPARE(a.size(), 0);
+}
+
+void ArrayTupleTest::constructNoItems() {
+    ArrayTuple a{ArrayView<const ArrayTuple::Item>{}};
+    CORRADE_VERIFY(!a.data());
+    CORRADE_COMPARE(a.size(), 0);
+}
+
+void ArrayTupleTest::constructEmptyItems() {
+    ArrayView<int> a;
+    ArrayView<NonTrivial> b;
+    NonTrivial::constructed = NonTrivial::destructed = 0;
+    {
+        ArrayTuple data{
+            {0, a},
+            {0, b}
+        };
+
+        /* The header is still allocated, containing a destructor for the
+           empty non-trivial array */
+        CORRADE_VERIFY(data.data());
+        CORRADE_VERIFY(a.data());
+        CORRADE_VERIFY(b.data());
+        CORRADE_COMPARE(a.size(), 0);
+        CORRADE_COMPARE(b.size(), 0);
+    }
+
+    CORRADE_COMPARE(NonTrivial::constructed, 0);
+    CORRADE_COMPARE(NonTrivial::destructed, 0);
+}
+
+void ArrayTupleTest::constructValueInit() {
+    ArrayView<char> a;
+    ArrayView<double> b;
+    ArrayView<short> c;
+    ArrayTuple data{
+        {ValueInit, 3, a},
+        {ValueInit, 5, b},
+        {7, c}
+    };
+
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_COMPARE(b.size(), 5);
+    CORRADE_COMPARE(c.size(), 7);
+
+    /* The items are following each other in a single allocation, with
+       padding before the double array. Trivial types have no destructor
+       entries, so the items start right after the two-pointer header. */
+    char* const begin = data.data();
+    CORRADE_COMPARE(static_cast<void*>(a.data()), begin + 2*sizeof(void*));
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(b.data()) % alignof(double), 0);
+    CORRADE_VERIFY(reinterpret_cast<char*>(b.data()) >= a.end());
+    CORRADE_VERIFY(reinterpret_cast<char*>(b.data()) < a.end() + alignof(double));
+    CORRADE_COMPARE(static_cast<void*>(c.data()), static_cast<void*>(b.end()));
+    CORRADE_COMPARE(static_cast<void*>(c.end()), begin + data.size());
+
+    for(char i: a) CORRADE_COMPARE(i, '\0');
+    for(double i: b) CORRADE_COMPARE(i, 0.0);
+    for(short i: c) CORRADE_COMPARE(i, 0);
+}
+
+void ArrayTupleTest::constructNoInit() {
+    ArrayView<int> a;
+    ArrayView<NonTrivial> b;
+    NonTrivial::constructed = NonTrivial::destructed = 0;
+    {
+        ArrayTuple data{
+            {NoInit, 3, a},
+            {NoInit, 2, b}
+        };
+        CORRADE_COMPARE(a.size(), 3);
+        CORRADE_COMPARE(b.size(), 2);
+
+        /* Nothing is constructed, so construct the non-trivial items
+           manually, the destructor should be called for them */
+        CORRADE_COMPARE(NonTrivial::constructed, 0);
+        for(NonTrivial& i: b) new(&i) NonTrivial;
+    }
+
+    CORRADE_COMPARE(NonTrivial::constructed, 2);
+    CORRADE_COMPARE(NonTrivial::destructed, 2);
+}
+
+void ArrayTupleTest::constructDefaultInit() {
+    ArrayView<int> a;
+    ArrayView<NonTrivial> b;
+    NonTrivial::constructed = NonTrivial::destructed = 0;
+    {
+        ArrayTuple data{
+            {DefaultInit, 3, a},
+            {DefaultInit, 2, b}
+        };
+        CORRADE_COMPARE(a.size(), 3);
+        CORRADE_COMPARE(b.size(), 2);
+
+        /* Trivial types are left uninitialized, non-trivial constructed */
+        CORRADE_COMPARE(NonTrivial::constructed, 2);
+        CORRADE_COMPARE(b[0].value, 1337);
+        CORRADE_COMPARE(b[1].value, 1337);
+    }
+
+    CORRADE_COMPARE(NonTrivial::destructed, 2);
+}
+
+void ArrayTupleTest::constructNonTrivial() {
+    ArrayView<NonTrivial> a;
+    ArrayView<int> b;
+    ArrayView<NonTrivial> c;
+    NonTrivial::constructed = NonTrivial::destructed = 0;
+    NonTrivial::orderCount = 0;
+    {
+        ArrayTuple data{
+            {ValueInit, 2, a},
+            {ValueInit, 4, b},
+            {ValueInit, 2, c}
+        };
+        CORRADE_COMPARE(NonTrivial::constructed, 4);
+        CORRADE_COMPARE(a[1].value, 1337);
+        CORRADE_COMPARE(c[0].value, 1337);
+
+        /* Two destructor entries, each three pointers large, after the
+           two-pointer header */
+        CORRADE_COMPARE(static_cast<void*>(a.data()), data.data() + 8*sizeof(void*));
+
+        a[0].value = 0;
+        a[1].value = 1;
+        c[0].value = 2;
+        c[1].value = 3;
+    }
+
+    /* Destructed in reverse order */
+    CORRADE_COMPARE(NonTrivial::destructed, 4);
+    CORRADE_COMPARE(NonTrivial::orderCount, 4);
+    CORRADE_COMPARE(NonTrivial::order[0], 3);
+    CORRADE_COMPARE(NonTrivial::order[1], 2);
+    CORRADE_COMPARE(NonTrivial::order[2], 1);
+    CORRADE_COMPARE(NonTrivial::order[3], 0);
+}
+
+void ArrayTupleTest::constructAligned() {
+    ArrayView<char> a;
+    ArrayView<float> b;
+    ArrayView<char> c;
+    ArrayTuple data{
+        {NoInit, 3, a},
+        {ValueInit, 5, 16, b},
+        {DefaultInit, 1, 8, c}
+    };
+
+    CORRADE_COMPARE(b.size(), 5);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(b.data()) % 16, 0);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(c.data()) % 8, 0);
+    for(float i: b) CORRADE_COMPARE(i, 0.0f);
+}
+
+void ArrayTupleTest::constructAlignedLarge() {
+    /* Alignment larger than what new[] guarantees, run several times to not
+       pass just by accident */
+    for(std::size_t i = 0; i != 16; ++i) {
+        ArrayView<char> a;
+        ArrayView<int> b;
+        ArrayTuple data{
+            {NoInit, i + 1, a},
+            {ValueInit, 10, 256, b}
+        };
+
+        CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(b.data()) % 256, 0);
+        CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(data.data()) % 256, 0);
+        for(int j: b) CORRADE_COMPARE(j, 0);
+    }
+}
+
+void ArrayTupleTest::constructInvalidAlignment() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    ArrayView<int> a;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    ArrayTuple::Item{ValueInit, 3, 2, a};
+    ArrayTuple::Item{NoInit, 3, 24, a};
+    CORRADE_COMPARE(out.str(),
+        "Containers::ArrayTuple::Item: expected alignment to be a power of two not less than 4 but got 2\n"
+        "Containers::ArrayTuple::Item: expected alignment to be a power of two not less than 4 but got 24\n");
+}
+
+void ArrayTupleTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<ArrayTuple>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<ArrayTuple>{});
+}
+
+void ArrayTupleTest::constructMove() {
+    ArrayView<NonTrivial> a;
+    ArrayView<int> b;
+    NonTrivial::constructed = NonTrivial::destructed = 0;
+    {
+        ArrayTuple data{
+            {ValueInit, 2, a},
+            {ValueInit, 3, b}
+        };
+        char* const pointer = data.data();
+        const std::size_t size = data.size();
+
+        ArrayTuple moved{std::move(data)};
+        CORRADE_VERIFY(!data.data());
+        CORRADE_COMPARE(data.size(), 0);
+        CORRADE_COMPARE(static_cast<void*>(moved.data()), static_cast<void*>(pointer));
+        CORRADE_COMPARE(moved.size(), size);
+
+        ArrayView<int> c;
+        ArrayTuple another{{ValueInit, 1, c}};
+        another = std::move(moved);
+        CORRADE_COMPARE(static_cast<void*>(another.data()), static_cast<void*>(pointer));
+        CORRADE_COMPARE(another.size(), size);
+        CORRADE_VERIFY(moved.data());
+
+        /* Views stay valid */
+        CORRADE_COMPARE(a[1].value, 1337);
+        CORRADE_COMPARE(NonTrivial::destructed, 0);
+    }
+
+    CORRADE_COMPARE(NonTrivial::constructed, 2);
+    CORRADE_COMPARE(NonTrivial::destructed, 2);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<ArrayTuple>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<ArrayTuple>::value);
+}
+
+void ArrayTupleTest::release() {
+    ArrayView<NonTrivial> a;
+    ArrayView<int> b;
+    NonTrivial::constructed = NonTrivial::destructed = 0;
+    {
+        Array<char> array;
+        {
+            ArrayTuple data{
+                {ValueInit, 2, a},
+                {ValueInit, 3, 64, b}
+            };
+            const std::size_t size = data.size();
+            char* const pointer = data.data();
+            array = Array<char>{data.release(), size, ArrayTuple::deleter()};
+            CORRADE_VERIFY(!data.data());
+            CORRADE_COMPARE(data.size(), 0);
+            CORRADE_COMPARE(static_cast<void*>(array.data()), static_cast<void*>(pointer));
+        }
+
+        /* The tuple is gone but the array owns the data now */
+        CORRADE_COMPARE(NonTrivial::destructed, 0);
+        CORRADE_COMPARE(a[0].value, 1337);
+        CORRADE_COMPARE(b[2], 0);
+    }
+
+    CORRADE_COMPARE(NonTrivial::constructed, 2);
+    CORRADE_COMPARE(NonTrivial::destructed, 2);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::ArrayTupleTest)
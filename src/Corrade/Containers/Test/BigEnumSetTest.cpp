@@ -0,0 +1,320 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <sstream>
+#include <vector>
+
+#include "Corrade/Containers/BigEnumSet.hpp"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Container.h"
+#include "Corrade/Utility/DebugStl.h"
+
+namespace Corrade { namespace Containers { namespace Test { namespace {
+
+struct BigEnumSetTest: TestSuite::Tester {
+    explicit BigEnumSetTest();
+
+    void construct();
+    void constructDefault();
+    void constructNoInit();
+    void constructOutOfRange();
+
+    void operatorOr();
+    void operatorAnd();
+    void operatorXor();
+    void operatorBool();
+    void operatorInverse();
+    void compare();
+
+    void iterate();
+    void iterateEmpty();
+    void iterateFull();
+
+    void templateFriendOperators();
+
+    void debug();
+};
+
+enum class Feature: unsigned char {
+    Fast = 0,
+    Cheap = 63,
+    Tested = 64,
+    Popular = 200
+};
+
+Utility::Debug& operator<<(Utility::Debug& debug, Feature value) {
+    switch(value) {
+        #define _c(value) case Feature::value: return debug << "Feature::" #value;
+        _c(Fast)
+        _c(Cheap)
+        _c(Tested)
+        _c(Popular)
+        #undef _c
+    }
+
+    return debug << "Feature(" << Utility::Debug::nospace << reinterpret_cast<void*>(std::size_t(value)) << Utility::Debug::nospace << ")";
+}
+
+/* An odd word count so both the SIMD and the scalar path is exercised */
+typedef BigEnumSet<Feature, 3> Features;
+
+CORRADE_ENUMSET_OPERATORS(Features)
+
+Utility::Debug& operator<<(Utility::Debug& debug, const Features& value) {
+    return bigEnumSetDebugOutput(debug, value, "Features{}");
+}
+
+BigEnumSetTest::BigEnumSetTest() {
+    addTests({&BigEnumSetTest::construct,
+              &BigEnumSetTest::constructDefault,
+              &BigEnumSetTest::constructNoInit,
+              &BigEnumSetTest::constructOutOfRange,
+
+              &BigEnumSetTest::operatorOr,
+              &BigEnumSetTest::operatorAnd,
+              &BigEnumSetTest::operatorXor,
+              &BigEnumSetTest::operatorBool,
+              &BigEnumSetTest::operatorInverse,
+              &BigEnumSetTest::compare,
+
+              &BigEnumSetTest::iterate,
+              &BigEnumSetTest::iterateEmpty,
+              &BigEnumSetTest::iterateFull,
+
+              &BigEnumSetTest::templateFriendOperators,
+
+              &BigEnumSetTest::debug});
+}
+
+void BigEnumSetTest::construct() {
+    constexpr Features noFeatures;
+    CORRADE_COMPARE(noFeatures.data()[0], 0);
+    CORRADE_COMPARE(noFeatures.data()[1], 0);
+    CORRADE_COMPARE(noFeatures.data()[2], 0);
+
+    constexpr Features features = Feature::Cheap;
+    CORRADE_COMPARE(features.data()[0], 0x8000000000000000ull);
+    CORRADE_COMPARE(features.data()[1], 0);
+    CORRADE_COMPARE(features.data()[2], 0);
+
+    constexpr Features features2 = Feature::Tested;
+    CORRADE_COMPARE(features2.data()[0], 0);
+    CORRADE_COMPARE(features2.data()[1], 1);
+    CORRADE_COMPARE(features2.data()[2], 0);
+
+    CORRADE_COMPARE(Features::Size, 3);
+    CORRADE_COMPARE(sizeof(Features), 3*8);
+}
+
+void BigEnumSetTest::constructDefault() {
+    /* Default size for an 8-bit underlying type is 256 bits */
+    CORRADE_COMPARE(BigEnumSet<Feature>::Size, 4);
+    CORRADE_COMPARE(sizeof(BigEnumSet<Feature>), 32);
+
+    BigEnumSet<Feature> features = Feature::Popular;
+    CORRADE_COMPARE(features.data()[3], 1 << 8);
+}
+
+void BigEnumSetTest::constructNoInit() {
+    Features features{Feature(150)};
+    new(&features) Features{NoInit};
+    {
+        #if defined(__GNUC__) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #pragma GCC diagnostic push
+        #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+        #endif
+        CORRADE_VERIFY(features == Feature(150));
+        #if defined(__GNUC__) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        #pragma GCC diagnostic pop
+        #endif
+    }
+}
+
+void BigEnumSetTest::constructOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Utility::Error redirectError{&out};
+    Features{Feature(192)};
+    CORRADE_COMPARE(out.str(), "Containers::BigEnumSet: value 192 too large for a 192-bit storage\n");
+}
+
+void BigEnumSetTest::operatorOr() {
+    Features features = Feature::Cheap|Feature::Fast;
+    CORRADE_COMPARE(features.data()[0], 0x8000000000000001ull);
+
+    CORRADE_VERIFY((features|Feature::Tested) >= Feature::Tested);
+    CORRADE_VERIFY((Feature::Tested|features) >= features);
+
+    features |= Feature::Tested;
+    CORRADE_COMPARE(features.data()[0], 0x8000000000000001ull);
+    CORRADE_COMPARE(features.data()[1], 1);
+    CORRADE_COMPARE(features.data()[2], 0);
+
+    /* The third word goes through the scalar path */
+    features |= Features{Feature(130)};
+    CORRADE_COMPARE(features.data()[2], 4);
+
+    constexpr Features cfeatures = Feature::Fast|Feature::Tested;
+    CORRADE_COMPARE(cfeatures.data()[0], 1);
+    CORRADE_COMPARE(cfeatures.data()[1], 1);
+}
+
+void BigEnumSetTest::operatorAnd() {
+    CORRADE_VERIFY(!(Feature::Cheap & Feature::Fast));
+
+    Features features = Feature::Tested|Feature::Fast|Feature::Cheap|Feature(130);
+    CORRADE_VERIFY((features & Feature::Tested) == Feature::Tested);
+    CORRADE_VERIFY((Feature::Tested & features) == Feature::Tested);
+    CORRADE_VERIFY(!(features & Feature(131)));
+
+    Features features2 = Feature::Tested|Feature::Fast|Feature(130);
+    CORRADE_VERIFY((features & features2) == (Feature::Tested|Feature::Fast|Feature(130)));
+
+    features &= features2;
+    CORRADE_VERIFY(features == (Feature::Tested|Feature::Fast|Feature(130)));
+}
+
+void BigEnumSetTest::operatorXor() {
+    CORRADE_VERIFY(!(Feature::Cheap ^ Feature::Cheap));
+    CORRADE_VERIFY((Feature::Cheap ^ Feature::Fast) == (Feature::Cheap|Feature::Fast));
+
+    Features features = Feature::Tested|Feature::Fast|Feature(130);
+    Features features2 = Feature::Tested|Feature::Cheap|Feature(130);
+    CORRADE_VERIFY((features ^ features2) == (Feature::Fast|Feature::Cheap));
+
+    features ^= features2;
+    CORRADE_VERIFY(features == (Feature::Fast|Feature::Cheap));
+}
+
+void BigEnumSetTest::operatorBool() {
+    CORRADE_VERIFY(!Features{});
+    CORRADE_VERIFY(Features{Feature::Fast});
+    CORRADE_VERIFY(Features{Feature::Tested});
+    CORRADE_VERIFY(Features{Feature(191)});
+
+    constexpr bool value = !!Features{Feature::Tested};
+    CORRADE_VERIFY(value);
+}
+
+void BigEnumSetTest::operatorInverse() {
+    Features inverse = ~Features{};
+    CORRADE_COMPARE(inverse.data()[0], 0xffffffffffffffffull);
+    CORRADE_COMPARE(inverse.data()[1], 0xffffffffffffffffull);
+    CORRADE_COMPARE(inverse.data()[2], 0xffffffffffffffffull);
+
+    Features inverse2 = ~(Feature::Tested|Feature::Fast);
+    CORRADE_COMPARE(inverse2.data()[0], 0xfffffffffffffffeull);
+    CORRADE_COMPARE(inverse2.data()[1], 0xfffffffffffffffeull);
+    CORRADE_COMPARE(inverse2.data()[2], 0xffffffffffffffffull);
+}
+
+void BigEnumSetTest::compare() {
+    Features features = Feature::Tested|Feature::Fast|Feature::Cheap;
+    CORRADE_VERIFY(features == features);
+    CORRADE_VERIFY(!(features != features));
+    CORRADE_VERIFY(Feature::Cheap == Features(Feature::Cheap));
+    CORRADE_VERIFY(Feature::Cheap != Features(Feature::Tested));
+
+    CORRADE_VERIFY(Features() <= Feature::Tested);
+    CORRADE_VERIFY(Feature::Tested >= Features());
+    CORRADE_VERIFY(Feature::Tested <= Feature::Tested);
+    CORRADE_VERIFY(Feature::Tested >= Feature::Tested);
+    CORRADE_VERIFY(Feature::Tested <= features);
+    CORRADE_VERIFY(features >= Feature::Tested);
+    CORRADE_VERIFY(features <= features);
+    CORRADE_VERIFY(features >= features);
+
+    CORRADE_VERIFY(features <= (Feature::Tested|Feature::Fast|Feature::Cheap|Feature(130)));
+    CORRADE_VERIFY(!(features >= (Feature::Tested|Feature::Fast|Feature::Cheap|Feature(130))));
+
+    constexpr bool subset = (Feature::Tested|Feature::Fast) >= Feature::Fast;
+    CORRADE_VERIFY(subset);
+}
+
+void BigEnumSetTest::iterate() {
+    Features features = Feature(191)|Feature::Cheap|Feature::Tested|Feature::Fast|Feature(65);
+
+    std::vector<Feature> values;
+    for(Feature i: features) values.push_back(i);
+    CORRADE_COMPARE_AS(values,
+        (std::vector<Feature>{Feature::Fast, Feature::Cheap, Feature::Tested, Feature(65), Feature(191)}),
+        TestSuite::Compare::Container);
+
+    /* Empty words in the middle are skipped */
+    Features features2 = Feature::Fast|Feature(130);
+    values.clear();
+    for(Feature i: features2) values.push_back(i);
+    CORRADE_COMPARE_AS(values,
+        (std::vector<Feature>{Feature::Fast, Feature(130)}),
+        TestSuite::Compare::Container);
+}
+
+void BigEnumSetTest::iterateEmpty() {
+    Features features;
+    CORRADE_VERIFY(features.begin() == features.end());
+    CORRADE_VERIFY(!(features.begin() != features.end()));
+}
+
+void BigEnumSetTest::iterateFull() {
+    Features features = ~Features{};
+
+    std::size_t count = 0;
+    for(Feature i: features) {
+        CORRADE_COMPARE(std::size_t(i), count);
+        ++count;
+    }
+    CORRADE_COMPARE(count, 192);
+}
+
+template<class T> struct Foo {
+    enum class Flag: unsigned short {
+        A = 0,
+        B = 100
+    };
+
+    typedef BigEnumSet<Flag, 2> Flags;
+    CORRADE_ENUMSET_FRIEND_OPERATORS(Flags)
+};
+
+void BigEnumSetTest::templateFriendOperators() {
+    Foo<int>::Flags a = Foo<int>::Flag::A & ~Foo<int>::Flag::B;
+    CORRADE_VERIFY(a == Foo<int>::Flag::A);
+}
+
+void BigEnumSetTest::debug() {
+    std::stringstream out;
+
+    Utility::Debug{&out} << Features{} << (Feature(150)|Feature::Fast|Feature::Tested);
+    CORRADE_COMPARE(out.str(), "Features{} Feature::Fast|Feature::Tested|Feature(0x96)\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::BigEnumSetTest)
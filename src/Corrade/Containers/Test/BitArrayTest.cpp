@@ -0,0 +1,178 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Corrade/Containers/BitArray.h"
+#include "Corrade/TestSuite/Tester.h"
+
+namespace Corrade { namespace Containers { namespace Test { namespace {
+
+struct BitArrayTest: TestSuite::Tester {
+    explicit BitArrayTest();
+
+    void constructDefault();
+    void constructValueInit();
+    void constructDirectInit();
+    void constructMove();
+
+    void convertView();
+    void access();
+
+    void append();
+    void appendAfterConstruct();
+    void reserve();
+};
+
+BitArrayTest::BitArrayTest() {
+    addTests({&BitArrayTest::constructDefault,
+              &BitArrayTest::constructValueInit,
+              &BitArrayTest::constructDirectInit,
+              &BitArrayTest::constructMove,
+
+              &BitArrayTest::convertView,
+              &BitArrayTest::access,
+
+              &BitArrayTest::append,
+              &BitArrayTest::appendAfterConstruct,
+              &BitArrayTest::reserve});
+}
+
+void BitArrayTest::constructDefault() {
+    BitArray a;
+    CORRADE_VERIFY(a.isEmpty());
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_VERIFY(!a.data());
+}
+
+void BitArrayTest::constructValueInit() {
+    BitArray a{ValueInit, 19};
+    BitArray b{19};
+    CORRADE_VERIFY(!a.isEmpty());
+    CORRADE_COMPARE(a.size(), 19);
+    CORRADE_COMPARE(b.size(), 19);
+    CORRADE_COMPARE(BitArrayView{a}.count(), 0);
+    CORRADE_COMPARE(BitArrayView{b}.count(), 0);
+}
+
+void BitArrayTest::constructDirectInit() {
+    BitArray a{DirectInit, 19, true};
+    CORRADE_COMPARE(a.size(), 19);
+    CORRADE_COMPARE(BitArrayView{a}.count(), 19);
+    /* Bits past the size stay zero */
+    CORRADE_COMPARE(a.data()[2], '\x07');
+
+    BitArray b{DirectInit, 19, false};
+    CORRADE_COMPARE(BitArrayView{b}.count(), 0);
+}
+
+void BitArrayTest::constructMove() {
+    BitArray a{DirectInit, 19, true};
+    const char* data = a.data();
+
+    BitArray b = std::move(a);
+    CORRADE_COMPARE(b.data(), data);
+    CORRADE_COMPARE(b.size(), 19);
+    CORRADE_VERIFY(a.isEmpty());
+
+    BitArray c{5};
+    c = std::move(b);
+    CORRADE_COMPARE(c.data(), data);
+    CORRADE_COMPARE(c.size(), 19);
+    CORRADE_COMPARE(b.size(), 5);
+
+    CORRADE_VERIFY(!std::is_copy_constructible<BitArray>::value);
+    CORRADE_VERIFY(!std::is_copy_assignable<BitArray>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<BitArray>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<BitArray>::value);
+}
+
+void BitArrayTest::convertView() {
+    BitArray a{19};
+    MutableBitArrayView b = a;
+    CORRADE_COMPARE(b.data(), a.data());
+    CORRADE_COMPARE(b.offset(), 0);
+    CORRADE_COMPARE(b.size(), 19);
+
+    const BitArray& ca = a;
+    BitArrayView cb = ca;
+    CORRADE_COMPARE(cb.data(), a.data());
+    CORRADE_COMPARE(cb.size(), 19);
+
+    b.set(17);
+    CORRADE_VERIFY(a[17]);
+}
+
+void BitArrayTest::access() {
+    BitArray a{19};
+    a.set(3);
+    a.set(12, true);
+    a.set(18);
+    CORRADE_VERIFY(a[3]);
+    CORRADE_VERIFY(a[12]);
+    CORRADE_VERIFY(!a[13]);
+    CORRADE_COMPARE(a.data()[0], '\x08');
+    CORRADE_COMPARE(a.data()[1], '\x10');
+    CORRADE_COMPARE(a.data()[2], '\x04');
+
+    a.reset(3);
+    a.set(12, false);
+    CORRADE_VERIFY(!a[3]);
+    CORRADE_VERIFY(!a[12]);
+    CORRADE_COMPARE(BitArrayView{a}.count(), 1);
+}
+
+void BitArrayTest::append() {
+    BitArray a;
+    for(std::size_t i = 0; i != 100; ++i)
+        a.append(i % 3 == 0);
+    CORRADE_COMPARE(a.size(), 100);
+    CORRADE_COMPARE(BitArrayView{a}.count(), 34);
+    for(std::size_t i = 0; i != 100; ++i)
+        CORRADE_COMPARE(a[i], i % 3 == 0);
+}
+
+void BitArrayTest::appendAfterConstruct() {
+    BitArray a{DirectInit, 5, true};
+    a.append(false);
+    a.append(true);
+    a.append(true);
+    a.append(false);
+    CORRADE_COMPARE(a.size(), 9);
+    CORRADE_COMPARE(a.data()[0], '\xdf');
+    CORRADE_COMPARE(a.data()[1], '\x00');
+}
+
+void BitArrayTest::reserve() {
+    BitArray a;
+    CORRADE_COMPARE(a.reserve(100), 104);
+    const char* data = a.data();
+    for(std::size_t i = 0; i != 100; ++i) a.append(true);
+    /* No reallocation happened */
+    CORRADE_COMPARE(a.data(), data);
+    CORRADE_COMPARE(BitArrayView{a}.count(), 100);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::BitArrayTest)
@@ -0,0 +1,478 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+#include "Corrade/Containers/ArrayView.h"
+#include "Corrade/Containers/BitArrayView.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Container.h"
+#include "Corrade/Utility/DebugStl.h"
+
+namespace Corrade { namespace Containers { namespace Test { namespace {
+
+struct BitArrayViewTest: TestSuite::Tester {
+    explicit BitArrayViewTest();
+
+    void constructDefault();
+    void construct();
+    void constructOffset();
+    void constructConstFromMutable();
+
+    void access();
+    void accessMutable();
+    void accessInvalid();
+
+    void slice();
+    void sliceInvalid();
+    void every();
+
+    void count();
+    void findFirst();
+    void forEachSet();
+    void fill();
+    void invert();
+    void operations();
+    void operationsInvalid();
+
+    void benchmarkCountStl();
+    void benchmarkCount();
+};
+
+/* Sizes and offsets for testing the head, word and tail handling of the
+   contiguous fast paths against a reference implementation */
+const struct {
+    const char* name;
+    std::size_t offset, size;
+} FastPathData[]{
+    {"empty", 0, 0},
+    {"less than a byte", 0, 5},
+    {"less than a byte, offset", 3, 4},
+    {"three bytes", 0, 24},
+    {"unaligned", 5, 200},
+    {"many words", 0, 1024},
+    {"many words, offset", 7, 1000}
+};
+
+BitArrayViewTest::BitArrayViewTest() {
+    addTests({&BitArrayViewTest::constructDefault,
+              &BitArrayViewTest::construct,
+              &BitArrayViewTest::constructOffset,
+              &BitArrayViewTest::constructConstFromMutable,
+
+              &BitArrayViewTest::access,
+              &BitArrayViewTest::accessMutable,
+              &BitArrayViewTest::accessInvalid,
+
+              &BitArrayViewTest::slice,
+              &BitArrayViewTest::sliceInvalid,
+              &BitArrayViewTest::every});
+
+    addInstancedTests({&BitArrayViewTest::count,
+                       &BitArrayViewTest::findFirst,
+                       &BitArrayViewTest::forEachSet,
+                       &BitArrayViewTest::fill,
+                       &BitArrayViewTest::invert,
+                       &BitArrayViewTest::operations},
+        Containers::arraySize(FastPathData));
+
+    addTests({&BitArrayViewTest::operationsInvalid});
+
+    addBenchmarks({&BitArrayViewTest::benchmarkCountStl,
+                   &BitArrayViewTest::benchmarkCount}, 10);
+}
+
+/* Deterministic pseudo-random bytes */
+void fillPattern(char* data, std::size_t size, unsigned int seed) {
+    for(std::size_t i = 0; i != size; ++i) {
+        seed = seed*1103515245 + 12345;
+        data[i] = char(seed >> 16);
+    }
+}
+
+bool referenceBit(const char* data, std::size_t bit) {
+    return (data[bit/8] >> (bit % 8)) & 1;
+}
+
+void BitArrayViewTest::constructDefault() {
+    BitArrayView a;
+    BitArrayView b = nullptr;
+    CORRADE_VERIFY(!a.data());
+    CORRADE_VERIFY(!b.data());
+    CORRADE_VERIFY(a.isEmpty());
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_COMPARE(a.offset(), 0);
+    CORRADE_COMPARE(a.stride(), 1);
+}
+
+void BitArrayViewTest::construct() {
+    const std::uint32_t data = 0xf0f0f00f;
+    BitArrayView a{&data, 0, 32};
+    CORRADE_COMPARE(a.data(), &data);
+    CORRADE_COMPARE(a.offset(), 0);
+    CORRADE_COMPARE(a.size(), 32);
+    CORRADE_VERIFY(!a.isEmpty());
+}
+
+void BitArrayViewTest::constructOffset() {
+    const char data[4]{};
+    BitArrayView a{data, 19, 5};
+    CORRADE_COMPARE(a.data(), data + 2);
+    CORRADE_COMPARE(a.offset(), 3);
+    CORRADE_COMPARE(a.size(), 5);
+}
+
+void BitArrayViewTest::constructConstFromMutable() {
+    char data[4]{};
+    MutableBitArrayView a{data, 3, 17};
+    BitArrayView b = a;
+    CORRADE_COMPARE(b.data(), data);
+    CORRADE_COMPARE(b.offset(), 3);
+    CORRADE_COMPARE(b.size(), 17);
+
+    CORRADE_VERIFY((std::is_nothrow_constructible<BitArrayView, MutableBitArrayView>::value));
+    CORRADE_VERIFY(!(std::is_constructible<MutableBitArrayView, BitArrayView>::value));
+}
+
+void BitArrayViewTest::access() {
+    /* 0b0101'1010, 0b1000'0001 */
+    const char data[]{'\x5a', '\x81'};
+    BitArrayView a{data, 1, 15};
+    CORRADE_VERIFY(a[0]);
+    CORRADE_VERIFY(!a[1]);
+    CORRADE_VERIFY(a[2]);
+    CORRADE_VERIFY(a[3]);
+    CORRADE_VERIFY(!a[4]);
+    CORRADE_VERIFY(a[5]);
+    CORRADE_VERIFY(!a[6]);
+    CORRADE_VERIFY(a[7]);
+    CORRADE_VERIFY(!a[8]);
+    CORRADE_VERIFY(a[14]);
+}
+
+void BitArrayViewTest::accessMutable() {
+    char data[2]{};
+    MutableBitArrayView a{data, 3, 10};
+    a.set(0);
+    a.set(6);
+    a.set(9, true);
+    CORRADE_COMPARE(data[0], '\x08');
+    CORRADE_COMPARE(data[1], '\x12');
+
+    a.reset(6);
+    a.set(0, false);
+    a.set(1, true);
+    CORRADE_COMPARE(data[0], '\x10');
+    CORRADE_COMPARE(data[1], '\x10');
+    CORRADE_VERIFY(a[1]);
+    CORRADE_VERIFY(!a[0]);
+}
+
+void BitArrayViewTest::accessInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    char data[2]{};
+    MutableBitArrayView a{data, 3, 10};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    a[10];
+    a.set(10);
+    a.reset(11);
+    a.set(12, true);
+    CORRADE_COMPARE(out.str(),
+        "Containers::BitArrayView::operator[](): index 10 out of range for 10 bits\n"
+        "Containers::BitArrayView::set(): index 10 out of range for 10 bits\n"
+        "Containers::BitArrayView::reset(): index 11 out of range for 10 bits\n"
+        "Containers::BitArrayView::set(): index 12 out of range for 10 bits\n");
+}
+
+void BitArrayViewTest::slice() {
+    const char data[4]{};
+    BitArrayView a{data, 5, 27};
+
+    BitArrayView b = a.slice(4, 20);
+    CORRADE_COMPARE(b.data(), data + 1);
+    CORRADE_COMPARE(b.offset(), 1);
+    CORRADE_COMPARE(b.size(), 16);
+
+    BitArrayView c = a.prefix(10);
+    CORRADE_COMPARE(c.data(), data);
+    CORRADE_COMPARE(c.offset(), 5);
+    CORRADE_COMPARE(c.size(), 10);
+
+    BitArrayView d = a.suffix(11);
+    CORRADE_COMPARE(d.data(), data + 2);
+    CORRADE_COMPARE(d.offset(), 0);
+    CORRADE_COMPARE(d.size(), 16);
+
+    BitArrayView e = a.except(7);
+    CORRADE_COMPARE(e.data(), data);
+    CORRADE_COMPARE(e.offset(), 5);
+    CORRADE_COMPARE(e.size(), 20);
+}
+
+void BitArrayViewTest::sliceInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const char data[4]{};
+    BitArrayView a{data, 5, 27};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    a.slice(5, 4);
+    a.slice(3, 28);
+    a.except(28);
+    a.every(0);
+    CORRADE_COMPARE(out.str(),
+        "Containers::BitArrayView::slice(): slice [5:4] out of range for 27 bits\n"
+        "Containers::BitArrayView::slice(): slice [3:28] out of range for 27 bits\n"
+        "Containers::BitArrayView::except(): can't except 28 bits from 27\n"
+        "Containers::BitArrayView::every(): step can't be zero\n");
+}
+
+void BitArrayViewTest::every() {
+    /* 0b0101'0101, 0b0000'1111 */
+    char data[]{'\x55', '\x0f'};
+    MutableBitArrayView a{data, 0, 16};
+
+    BitArrayView b = a.every(2);
+    CORRADE_COMPARE(b.size(), 8);
+    CORRADE_COMPARE(b.stride(), 2);
+    CORRADE_COMPARE(b.count(), 6);
+    CORRADE_COMPARE(b.findFirstUnset(), 6);
+
+    /* Every third of every other is every sixth: bits 0, 6, 12 */
+    BitArrayView c = a.every(2).every(3);
+    CORRADE_COMPARE(c.size(), 3);
+    CORRADE_COMPARE(c.stride(), 6);
+    CORRADE_VERIFY(c[0]);
+    CORRADE_VERIFY(c[1]);
+    CORRADE_VERIFY(!c[2]);
+
+    /* Slicing a strided view keeps the stride */
+    BitArrayView d = b.suffix(5);
+    CORRADE_COMPARE(d.size(), 3);
+    CORRADE_COMPARE(d.stride(), 2);
+    CORRADE_VERIFY(d[0]);
+    CORRADE_VERIFY(!d[1]);
+
+    a.every(2).invert();
+    CORRADE_COMPARE(data[0], '\x00');
+    CORRADE_COMPARE(data[1], '\x5a');
+}
+
+void BitArrayViewTest::count() {
+    auto&& data = FastPathData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    char bytes[140];
+    fillPattern(bytes, sizeof(bytes), 17);
+
+    std::size_t expected = 0;
+    for(std::size_t i = 0; i != data.size; ++i)
+        expected += referenceBit(bytes, data.offset + i);
+
+    CORRADE_COMPARE(BitArrayView(bytes, data.offset, data.size).count(), expected);
+
+    /* The strided variant goes through the generic path */
+    std::size_t expectedStrided = 0;
+    for(std::size_t i = 0; i < data.size; i += 3)
+        expectedStrided += referenceBit(bytes, data.offset + i);
+    CORRADE_COMPARE(BitArrayView(bytes, data.offset, data.size).every(3).count(), expectedStrided);
+}
+
+void BitArrayViewTest::findFirst() {
+    auto&& data = FastPathData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Everything zero except for the last bit, so the search has to go
+       through the whole array */
+    char zeros[140]{};
+    char ones[140];
+    for(char& i: ones) i = '\xff';
+    if(data.size) {
+        const std::size_t last = data.offset + data.size - 1;
+        zeros[last/8] |= char(1 << last % 8);
+        ones[last/8] &= char(~(1 << last % 8));
+    }
+
+    const std::size_t expected = data.size ? data.size - 1 : 0;
+    CORRADE_COMPARE(BitArrayView(zeros, data.offset, data.size).findFirstSet(), expected);
+    CORRADE_COMPARE(BitArrayView(ones, data.offset, data.size).findFirstUnset(), expected);
+
+    /* Nothing found returns the size */
+    CORRADE_COMPARE(BitArrayView(zeros, data.offset, data.size).findFirstUnset(), data.size > 1 ? 0 : data.size);
+    CORRADE_COMPARE(BitArrayView(zeros, data.offset, data.size).except(data.size ? 1 : 0).findFirstSet(), expected);
+}
+
+void BitArrayViewTest::forEachSet() {
+    auto&& data = FastPathData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    char bytes[140]{};
+    fillPattern(bytes, 20, 23);
+
+    std::vector<std::size_t> expected;
+    for(std::size_t i = 0; i != data.size; ++i)
+        if(referenceBit(bytes, data.offset + i)) expected.push_back(i);
+
+    std::vector<std::size_t> actual;
+    BitArrayView{bytes, data.offset, data.size}.forEachSet([&](std::size_t i) {
+        actual.push_back(i);
+    });
+    CORRADE_COMPARE_AS(actual, expected, TestSuite::Compare::Container);
+}
+
+void BitArrayViewTest::fill() {
+    auto&& data = FastPathData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    char bytes[140];
+    fillPattern(bytes, sizeof(bytes), 31);
+    char original[140];
+    std::memcpy(original, bytes, sizeof(bytes));
+
+    MutableBitArrayView view{bytes, data.offset, data.size};
+    view.setAll();
+    CORRADE_COMPARE(view.count(), data.size);
+    view.resetAll();
+    CORRADE_COMPARE(view.count(), 0);
+
+    /* Bits outside of the view are untouched */
+    for(std::size_t i = 0; i != sizeof(bytes)*8; ++i) {
+        if(i >= data.offset && i < data.offset + data.size) continue;
+        CORRADE_COMPARE(referenceBit(bytes, i), referenceBit(original, i));
+    }
+}
+
+void BitArrayViewTest::invert() {
+    auto&& data = FastPathData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    char bytes[140];
+    fillPattern(bytes, sizeof(bytes), 37);
+    char original[140];
+    std::memcpy(original, bytes, sizeof(bytes));
+
+    MutableBitArrayView{bytes, data.offset, data.size}.invert();
+    for(std::size_t i = 0; i != sizeof(bytes)*8; ++i) {
+        const bool inside = i >= data.offset && i < data.offset + data.size;
+        CORRADE_COMPARE(referenceBit(bytes, i), referenceBit(original, i) != inside);
+    }
+}
+
+void BitArrayViewTest::operations() {
+    auto&& data = FastPathData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    char a[140], b[140];
+    fillPattern(a, sizeof(a), 41);
+    fillPattern(b, sizeof(b), 43);
+
+    /* Same offset goes through the fast path, a different one through the
+       generic path */
+    for(const std::size_t otherOffset: {data.offset, data.offset + 3}) {
+        char andResult[140], orResult[140], xorResult[140];
+        std::memcpy(andResult, a, sizeof(a));
+        std::memcpy(orResult, a, sizeof(a));
+        std::memcpy(xorResult, a, sizeof(a));
+
+        const BitArrayView other{b, otherOffset, data.size};
+        MutableBitArrayView{andResult, data.offset, data.size}.andWith(other);
+        MutableBitArrayView{orResult, data.offset, data.size}.orWith(other);
+        MutableBitArrayView{xorResult, data.offset, data.size}.xorWith(other);
+
+        for(std::size_t i = 0; i != data.size; ++i) {
+            const bool x = referenceBit(a, data.offset + i);
+            const bool y = referenceBit(b, otherOffset + i);
+            CORRADE_COMPARE(referenceBit(andResult, data.offset + i), x && y);
+            CORRADE_COMPARE(referenceBit(orResult, data.offset + i), x || y);
+            CORRADE_COMPARE(referenceBit(xorResult, data.offset + i), x != y);
+        }
+
+        /* Bits outside of the view are untouched */
+        for(std::size_t i = 0; i != sizeof(a)*8; ++i) {
+            if(i >= data.offset && i < data.offset + data.size) continue;
+            CORRADE_COMPARE(referenceBit(andResult, i), referenceBit(a, i));
+            CORRADE_COMPARE(referenceBit(orResult, i), referenceBit(a, i));
+            CORRADE_COMPARE(referenceBit(xorResult, i), referenceBit(a, i));
+        }
+    }
+}
+
+void BitArrayViewTest::operationsInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    char a[2]{};
+    const char b[2]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MutableBitArrayView{a, 0, 10}.andWith({b, 0, 9});
+    MutableBitArrayView{a, 0, 10}.orWith({b, 0, 11});
+    MutableBitArrayView{a, 0, 10}.xorWith({b, 0, 8});
+    CORRADE_COMPARE(out.str(),
+        "Containers::BitArrayView::andWith(): expected a view of 10 bits but got 9\n"
+        "Containers::BitArrayView::orWith(): expected a view of 10 bits but got 11\n"
+        "Containers::BitArrayView::xorWith(): expected a view of 10 bits but got 8\n");
+}
+
+constexpr std::size_t BenchmarkSize = 1 << 20;
+
+void BitArrayViewTest::benchmarkCountStl() {
+    std::vector<bool> a(BenchmarkSize);
+    for(std::size_t i = 0; i < BenchmarkSize; i += 3) a[i] = true;
+
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(10)
+        for(const bool i: a) count += i;
+
+    CORRADE_COMPARE(count, 10*((BenchmarkSize + 2)/3));
+}
+
+void BitArrayViewTest::benchmarkCount() {
+    std::vector<char> data(BenchmarkSize/8);
+    MutableBitArrayView a{data.data(), 0, BenchmarkSize};
+    a.every(3).setAll();
+
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(10)
+        count += a.count();
+
+    CORRADE_COMPARE(count, 10*((BenchmarkSize + 2)/3));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::BitArrayViewTest)
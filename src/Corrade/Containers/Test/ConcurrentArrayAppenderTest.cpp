@@ -0,0 +1,270 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <vector>
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
+
+#include "Corrade/Containers/ConcurrentArrayAppender.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Container.h"
+
+namespace Corrade { namespace Containers { namespace Test { namespace {
+
+struct ConcurrentArrayAppenderTest: TestSuite::Tester {
+    explicit ConcurrentArrayAppenderTest();
+
+    void construct();
+    void appendNothing();
+    void append();
+    void appendList();
+    void appendOverflow();
+    void appendNotGrowable();
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    void threaded();
+    void threadedOverflow();
+    #endif
+};
+
+ConcurrentArrayAppenderTest::ConcurrentArrayAppenderTest() {
+    addTests({&ConcurrentArrayAppenderTest::construct,
+              &ConcurrentArrayAppenderTest::appendNothing,
+              &ConcurrentArrayAppenderTest::append,
+              &ConcurrentArrayAppenderTest::appendList,
+              &ConcurrentArrayAppenderTest::appendOverflow,
+              &ConcurrentArrayAppenderTest::appendNotGrowable});
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    addTests({&ConcurrentArrayAppenderTest::threaded,
+              &ConcurrentArrayAppenderTest::threadedOverflow});
+    #endif
+}
+
+void ConcurrentArrayAppenderTest::construct() {
+    Array<int> a;
+    arrayAppend(a, {1, 2, 3});
+    arrayReserve(a, 10);
+    {
+        ConcurrentArrayAppender<int> appender{a};
+        CORRADE_COMPARE(appender.capacity(), 7);
+    }
+
+    CORRADE_VERIFY(!std::is_copy_constructible<ConcurrentArrayAppender<int>>::value);
+    CORRADE_VERIFY(!std::is_move_constructible<ConcurrentArrayAppender<int>>::value);
+    CORRADE_VERIFY(!std::is_copy_assignable<ConcurrentArrayAppender<int>>::value);
+    CORRADE_VERIFY(!std::is_move_assignable<ConcurrentArrayAppender<int>>::value);
+
+    /* The bump position should be on a cache line of its own */
+    CORRADE_VERIFY(sizeof(ConcurrentArrayAppender<int>) >= 2*Implementation::ConcurrentArrayAppenderCacheLineSize);
+}
+
+void ConcurrentArrayAppenderTest::appendNothing() {
+    Array<int> a;
+    arrayAppend(a, {1, 2, 3});
+    arrayReserve(a, 10);
+    const int* data = a.data();
+
+    {
+        ConcurrentArrayAppender<int> appender{a};
+    }
+
+    /* The array is left as it was */
+    CORRADE_COMPARE(a.data(), data);
+    CORRADE_COMPARE(arrayCapacity(a), 10);
+    CORRADE_COMPARE_AS(a, arrayView({1, 2, 3}),
+        TestSuite::Compare::Container);
+}
+
+void ConcurrentArrayAppenderTest::append() {
+    Array<int> a;
+    arrayAppend(a, {1, 2});
+    arrayReserve(a, 10);
+    const int* data = a.data();
+
+    {
+        ConcurrentArrayAppender<int> appender{a};
+
+        ArrayView<int> first = appender.append(3);
+        CORRADE_COMPARE(first.data(), data + 2);
+        CORRADE_COMPARE(first.size(), 3);
+        first[0] = 3;
+        first[1] = 4;
+        first[2] = 5;
+
+        ArrayView<int> second = appender.append(1);
+        CORRADE_COMPARE(second.data(), data + 5);
+        second[0] = 6;
+
+        /* Appending nothing is fine too */
+        CORRADE_COMPARE(appender.append(0).size(), 0);
+    }
+
+    /* Everything fit into the reserved capacity, so no reallocation
+       happened */
+    CORRADE_COMPARE(a.data(), data);
+    CORRADE_COMPARE(arrayCapacity(a), 10);
+    CORRADE_COMPARE_AS(a, arrayView({1, 2, 3, 4, 5, 6}),
+        TestSuite::Compare::Container);
+}
+
+void ConcurrentArrayAppenderTest::appendList() {
+    Array<int> a;
+    arrayReserve(a, 4);
+
+    {
+        ConcurrentArrayAppender<int> appender{a};
+        ArrayView<int> out = appender.append(arrayView({7, 8, 9}));
+        CORRADE_COMPARE(out.data(), a.data());
+        CORRADE_COMPARE_AS(out, arrayView({7, 8, 9}),
+            TestSuite::Compare::Container);
+
+        /* This one goes to the overflow */
+        appender.append(arrayView({10, 11}));
+    }
+
+    CORRADE_COMPARE_AS(a, arrayView({7, 8, 9, 10, 11}),
+        TestSuite::Compare::Container);
+}
+
+void ConcurrentArrayAppenderTest::appendOverflow() {
+    Array<int> a;
+    arrayAppend(a, 1);
+    arrayReserve(a, 4);
+
+    {
+        ConcurrentArrayAppender<int> appender{a};
+        CORRADE_COMPARE(appender.capacity(), 3);
+
+        /* Fits into the reserved capacity */
+        ArrayView<int> first = appender.append(2);
+        CORRADE_COMPARE(first.data(), a.data() + 1);
+        first[0] = 2;
+        first[1] = 3;
+
+        /* Doesn't fit, goes to an overflow chunk */
+        ArrayView<int> second = appender.append(2);
+        CORRADE_COMPARE(second.size(), 2);
+        CORRADE_VERIFY(second.data() < a.data() || second.data() >= a.data() + 4);
+        second[0] = 5;
+        second[1] = 6;
+
+        /* A smaller chunk still fits into the reserved capacity. The views
+           stay valid, no reallocation happens until the destruction. */
+        ArrayView<int> third = appender.append(1);
+        CORRADE_COMPARE(third.data(), a.data() + 3);
+        third[0] = 4;
+
+        /* Fits into the remaining space of the previous overflow chunk */
+        ArrayView<int> fourth = appender.append(1);
+        CORRADE_COMPARE(fourth.data(), second.data() + 2);
+        fourth[0] = 7;
+
+        /* Needs a new overflow chunk */
+        ArrayView<int> fifth = appender.append(8);
+        for(std::size_t i = 0; i != fifth.size(); ++i) fifth[i] = 8 + i;
+    }
+
+    /* Reserved capacity first, overflow chunks after in order they were
+       allocated */
+    CORRADE_COMPARE_AS(a, arrayView({
+        1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+    }), TestSuite::Compare::Container);
+}
+
+void ConcurrentArrayAppenderTest::appendNotGrowable() {
+    Array<int> a{InPlaceInit, {1, 2}};
+    CORRADE_VERIFY(!arrayIsGrowable(a));
+
+    {
+        ConcurrentArrayAppender<int> appender{a};
+        CORRADE_COMPARE(appender.capacity(), 0);
+
+        appender.append(arrayView({3, 4}));
+        appender.append(arrayView({5}));
+    }
+
+    CORRADE_VERIFY(arrayIsGrowable(a));
+    CORRADE_COMPARE_AS(a, arrayView({1, 2, 3, 4, 5}),
+        TestSuite::Compare::Container);
+}
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+constexpr std::size_t ThreadCount = 4;
+constexpr std::size_t ThreadedCount = 10000;
+
+/* Each thread appends its values in chunks of varying size, afterwards every
+   value should be present exactly once */
+std::vector<std::size_t> threadedImplementation(const std::size_t capacity) {
+    Array<std::size_t> a;
+    arrayReserve(a, capacity);
+
+    {
+        ConcurrentArrayAppender<std::size_t> appender{a};
+        std::vector<std::thread> threads;
+        for(std::size_t thread = 0; thread != ThreadCount; ++thread)
+            threads.emplace_back([&appender, thread]{
+                for(std::size_t i = 0; i < ThreadedCount; ) {
+                    std::size_t count = 1 + (i + thread)%7;
+                    if(count > ThreadedCount - i) count = ThreadedCount - i;
+                    ArrayView<std::size_t> out = appender.append(count);
+                    for(std::size_t j = 0; j != count; ++j)
+                        out[j] = thread*ThreadedCount + i + j;
+                    i += count;
+                }
+            });
+        for(std::thread& thread: threads) thread.join();
+    }
+
+    std::vector<std::size_t> values{a.begin(), a.end()};
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+std::vector<std::size_t> expected() {
+    std::vector<std::size_t> out(ThreadCount*ThreadedCount);
+    for(std::size_t i = 0; i != out.size(); ++i) out[i] = i;
+    return out;
+}
+
+void ConcurrentArrayAppenderTest::threaded() {
+    CORRADE_COMPARE_AS(threadedImplementation(ThreadCount*ThreadedCount),
+        expected(),
+        TestSuite::Compare::Container);
+}
+
+void ConcurrentArrayAppenderTest::threadedOverflow() {
+    CORRADE_COMPARE_AS(threadedImplementation(ThreadCount*ThreadedCount/3),
+        expected(),
+        TestSuite::Compare::Container);
+}
+#endif
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::ConcurrentArrayAppenderTest)
@@ -0,0 +1,366 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <vector>
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
+
+#include "Corrade/Containers/ConcurrentQueue.h"
+#include "Corrade/Containers/Pointer.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Container.h"
+#include "Corrade/Utility/DebugStl.h"
+
+namespace Corrade { namespace Containers { namespace Test { namespace {
+
+struct ConcurrentQueueTest: TestSuite::Tester {
+    explicit ConcurrentQueueTest();
+
+    template<class Queue> void construct();
+    void constructZeroCapacity();
+    template<class Queue> void pushPop();
+    template<class Queue> void pushPopMoveOnly();
+    template<class Queue> void pushPopMultiple();
+    void spscSize();
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    void spscThreaded();
+    void spscThreadedMultiple();
+    void mpmcThreaded();
+    void mpmcThreadedMultiple();
+    #endif
+};
+
+template<class> struct QueueName;
+template<class T> struct QueueName<SpscQueue<T>> {
+    static const char* name() { return "SpscQueue"; }
+};
+template<class T> struct QueueName<MpmcQueue<T>> {
+    static const char* name() { return "MpmcQueue"; }
+};
+
+template<class> struct Rebind;
+template<class T> struct Rebind<SpscQueue<T>> {
+    template<class U> using Type = SpscQueue<U>;
+};
+template<class T> struct Rebind<MpmcQueue<T>> {
+    template<class U> using Type = MpmcQueue<U>;
+};
+
+ConcurrentQueueTest::ConcurrentQueueTest() {
+    addTests({&ConcurrentQueueTest::construct<SpscQueue<int>>,
+              &ConcurrentQueueTest::construct<MpmcQueue<int>>,
+              &ConcurrentQueueTest::constructZeroCapacity,
+              &ConcurrentQueueTest::pushPop<SpscQueue<int>>,
+              &ConcurrentQueueTest::pushPop<MpmcQueue<int>>,
+              &ConcurrentQueueTest::pushPopMoveOnly<SpscQueue<int>>,
+              &ConcurrentQueueTest::pushPopMoveOnly<MpmcQueue<int>>,
+              &ConcurrentQueueTest::pushPopMultiple<SpscQueue<int>>,
+              &ConcurrentQueueTest::pushPopMultiple<MpmcQueue<int>>,
+              &ConcurrentQueueTest::spscSize});
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    addTests({&ConcurrentQueueTest::spscThreaded,
+              &ConcurrentQueueTest::spscThreadedMultiple,
+              &ConcurrentQueueTest::mpmcThreaded,
+              &ConcurrentQueueTest::mpmcThreadedMultiple});
+    #endif
+}
+
+template<class Queue> void ConcurrentQueueTest::construct() {
+    setTestCaseTemplateName(QueueName<Queue>::name());
+
+    Queue a{5};
+    CORRADE_COMPARE(a.capacity(), 8);
+
+    Queue b{1};
+    CORRADE_COMPARE(b.capacity(), 1);
+
+    CORRADE_VERIFY(!std::is_copy_constructible<Queue>::value);
+    CORRADE_VERIFY(!std::is_move_constructible<Queue>::value);
+    CORRADE_VERIFY(!std::is_copy_assignable<Queue>::value);
+    CORRADE_VERIFY(!std::is_move_assignable<Queue>::value);
+
+    /* The producer and consumer positions should be far enough apart */
+    CORRADE_VERIFY(sizeof(Queue) >= 3*Implementation::ConcurrentQueueCacheLineSize);
+}
+
+void ConcurrentQueueTest::constructZeroCapacity() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    SpscQueue<int> a{0};
+    MpmcQueue<int> b{0};
+    CORRADE_COMPARE(out.str(),
+        "Containers::SpscQueue: capacity expected to be non-zero\n"
+        "Containers::MpmcQueue: capacity expected to be non-zero\n");
+}
+
+template<class Queue> void ConcurrentQueueTest::pushPop() {
+    setTestCaseTemplateName(QueueName<Queue>::name());
+
+    Queue a{4};
+    int value = 0;
+    CORRADE_VERIFY(!a.pop(value));
+
+    /* Go around the queue several times */
+    for(int i = 0; i != 3; ++i) {
+        CORRADE_VERIFY(a.push(i*10 + 1));
+        CORRADE_VERIFY(a.push(i*10 + 2));
+        CORRADE_VERIFY(a.push(i*10 + 3));
+        CORRADE_VERIFY(a.push(i*10 + 4));
+        CORRADE_VERIFY(!a.push(i*10 + 5));
+
+        CORRADE_VERIFY(a.pop(value));
+        CORRADE_COMPARE(value, i*10 + 1);
+        CORRADE_VERIFY(a.pop(value));
+        CORRADE_COMPARE(value, i*10 + 2);
+        CORRADE_VERIFY(a.push(i*10 + 6));
+        CORRADE_VERIFY(a.pop(value));
+        CORRADE_COMPARE(value, i*10 + 3);
+        CORRADE_VERIFY(a.pop(value));
+        CORRADE_COMPARE(value, i*10 + 4);
+        CORRADE_VERIFY(a.pop(value));
+        CORRADE_COMPARE(value, i*10 + 6);
+        CORRADE_VERIFY(!a.pop(value));
+    }
+}
+
+template<class Queue> void ConcurrentQueueTest::pushPopMoveOnly() {
+    setTestCaseTemplateName(QueueName<Queue>::name());
+
+    typename Rebind<Queue>::template Type<Pointer<int>> a{2};
+    CORRADE_VERIFY(a.push(Pointer<int>{new int{3}}));
+
+    Pointer<int> value;
+    CORRADE_VERIFY(a.pop(value));
+    CORRADE_VERIFY(value);
+    CORRADE_COMPARE(*value, 3);
+}
+
+template<class Queue> void ConcurrentQueueTest::pushPopMultiple() {
+    setTestCaseTemplateName(QueueName<Queue>::name());
+
+    Queue a{8};
+    int value;
+    for(int i = 0; i != 5; ++i) a.push(0);
+    for(int i = 0; i != 5; ++i) a.pop(value);
+
+    /* Only 8 fit, wrapping around after 3 */
+    const int in[]{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    CORRADE_COMPARE(a.push(in), 8);
+    CORRADE_COMPARE(a.push(in), 0);
+    CORRADE_VERIFY(!a.push(0));
+
+    int out[5];
+    CORRADE_COMPARE(a.pop(out), 5);
+    CORRADE_COMPARE_AS(arrayView(out),
+        arrayView({1, 2, 3, 4, 5}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(a.push(arrayView(in).suffix(8)), 2);
+    CORRADE_COMPARE(a.pop(out), 5);
+    CORRADE_COMPARE_AS(arrayView(out),
+        arrayView({6, 7, 8, 9, 10}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(a.pop(out), 0);
+
+    /* Empty batches are a no-op */
+    CORRADE_COMPARE(a.push(nullptr), 0);
+    CORRADE_COMPARE(a.pop(nullptr), 0);
+}
+
+void ConcurrentQueueTest::spscSize() {
+    SpscQueue<int> a{4};
+    CORRADE_COMPARE(a.size(), 0);
+    a.push(1);
+    a.push(2);
+    CORRADE_COMPARE(a.size(), 2);
+    int value;
+    a.pop(value);
+    CORRADE_COMPARE(a.size(), 1);
+}
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+constexpr std::size_t ThreadedCount = 100000;
+
+void ConcurrentQueueTest::spscThreaded() {
+    SpscQueue<std::size_t> a{64};
+
+    std::thread producer{[&a]{
+        for(std::size_t i = 0; i != ThreadedCount; ++i)
+            while(!a.push(i)) std::this_thread::yield();
+    }};
+
+    /* Values have to arrive in order */
+    std::size_t expected = 0;
+    bool ordered = true;
+    while(expected != ThreadedCount) {
+        std::size_t value;
+        if(!a.pop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        ordered = ordered && value == expected;
+        ++expected;
+    }
+
+    producer.join();
+    CORRADE_VERIFY(ordered);
+    CORRADE_COMPARE(a.size(), 0);
+}
+
+void ConcurrentQueueTest::spscThreadedMultiple() {
+    SpscQueue<std::size_t> a{64};
+
+    std::thread producer{[&a]{
+        std::size_t batch[7];
+        for(std::size_t i = 0; i < ThreadedCount; ) {
+            const std::size_t count = ThreadedCount - i < 7 ? ThreadedCount - i : 7;
+            for(std::size_t j = 0; j != count; ++j) batch[j] = i + j;
+            const std::size_t pushed = a.push(arrayView(batch).prefix(count));
+            if(!pushed) std::this_thread::yield();
+            i += pushed;
+        }
+    }};
+
+    std::size_t expected = 0;
+    bool ordered = true;
+    std::size_t batch[5];
+    while(expected != ThreadedCount) {
+        const std::size_t popped = a.pop(batch);
+        if(!popped) std::this_thread::yield();
+        for(std::size_t i = 0; i != popped; ++i)
+            ordered = ordered && batch[i] == expected + i;
+        expected += popped;
+    }
+
+    producer.join();
+    CORRADE_VERIFY(ordered);
+}
+
+/* Each producer pushes values with its ID in the upper bits, consumers check
+   that values from a single producer arrive in order and that nothing got
+   lost or duplicated */
+constexpr std::size_t ThreadCount = 4;
+
+struct MpmcResult {
+    bool ordered;
+    std::vector<std::size_t> counts;
+};
+
+template<class Push, class Pop> MpmcResult mpmcThreadedImplementation(Push push, Pop pop) {
+    MpmcQueue<std::size_t> a{64};
+    std::atomic<std::size_t> poppedCount{0};
+    std::vector<std::vector<std::size_t>> received(ThreadCount);
+
+    std::vector<std::thread> threads;
+    for(std::size_t producer = 0; producer != ThreadCount; ++producer)
+        threads.emplace_back([&a, producer, push]{
+            push(a, producer);
+        });
+    for(std::size_t consumer = 0; consumer != ThreadCount; ++consumer)
+        threads.emplace_back([&a, &received, &poppedCount, consumer, pop]{
+            pop(a, received[consumer], poppedCount);
+        });
+    for(std::thread& thread: threads) thread.join();
+
+    /* Every consumer should see values of each producer in order */
+    MpmcResult result{true, std::vector<std::size_t>(ThreadCount)};
+    for(const std::vector<std::size_t>& consumer: received) {
+        std::vector<std::size_t> last(ThreadCount, ~std::size_t{});
+        for(std::size_t value: consumer) {
+            const std::size_t producer = value / ThreadedCount;
+            const std::size_t index = value % ThreadedCount;
+            result.ordered = result.ordered && (last[producer] == ~std::size_t{} || last[producer] < index);
+            last[producer] = index;
+            ++result.counts[producer];
+        }
+    }
+
+    return result;
+}
+
+void ConcurrentQueueTest::mpmcThreaded() {
+    MpmcResult result = mpmcThreadedImplementation([](MpmcQueue<std::size_t>& a, std::size_t producer) {
+        for(std::size_t i = 0; i != ThreadedCount; ++i)
+            while(!a.push(producer*ThreadedCount + i)) std::this_thread::yield();
+    }, [](MpmcQueue<std::size_t>& a, std::vector<std::size_t>& received, std::atomic<std::size_t>& poppedCount) {
+        while(poppedCount.load() != ThreadCount*ThreadedCount) {
+            std::size_t value;
+            if(!a.pop(value)) {
+                std::this_thread::yield();
+                continue;
+            }
+            received.push_back(value);
+            ++poppedCount;
+        }
+    });
+
+    CORRADE_VERIFY(result.ordered);
+    CORRADE_COMPARE_AS(result.counts,
+        std::vector<std::size_t>(ThreadCount, ThreadedCount),
+        TestSuite::Compare::Container);
+}
+
+void ConcurrentQueueTest::mpmcThreadedMultiple() {
+    MpmcResult result = mpmcThreadedImplementation([](MpmcQueue<std::size_t>& a, std::size_t producer) {
+        std::size_t batch[7];
+        for(std::size_t i = 0; i < ThreadedCount; ) {
+            const std::size_t count = ThreadedCount - i < 7 ? ThreadedCount - i : 7;
+            for(std::size_t j = 0; j != count; ++j)
+                batch[j] = producer*ThreadedCount + i + j;
+            const std::size_t pushed = a.push(arrayView(batch).prefix(count));
+            if(!pushed) std::this_thread::yield();
+            i += pushed;
+        }
+    }, [](MpmcQueue<std::size_t>& a, std::vector<std::size_t>& received, std::atomic<std::size_t>& poppedCount) {
+        std::size_t batch[5];
+        while(poppedCount.load() != ThreadCount*ThreadedCount) {
+            const std::size_t popped = a.pop(batch);
+            if(!popped) {
+                std::this_thread::yield();
+                continue;
+            }
+            received.insert(received.end(), batch, batch + popped);
+            poppedCount += popped;
+        }
+    });
+
+    CORRADE_VERIFY(result.ordered);
+    CORRADE_COMPARE_AS(result.counts,
+        std::vector<std::size_t>(ThreadCount, ThreadedCount),
+        TestSuite::Compare::Container);
+}
+#endif
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::ConcurrentQueueTest)
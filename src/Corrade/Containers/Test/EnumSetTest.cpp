@@ -24,9 +24,11 @@
 */
 
 #include <sstream>
+#include <vector>
 
 #include "Corrade/Containers/EnumSet.hpp"
 #include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Container.h"
 #include "Corrade/Utility/DebugStl.h" /** @todo remove when <sstream> is gone */
 
 namespace Corrade { namespace Containers { namespace Test { namespace {
@@ -44,6 +46,10 @@ struct EnumSetTest: TestSuite::Tester {
     void operatorInverse();
     void compare();
 
+    void iterate();
+    void iterateEmpty();
+    void iterateSignedUnderlyingType();
+
     void templateFriendOperators();
 
     void debug();
@@ -92,6 +98,10 @@ EnumSetTest::EnumSetTest() {
               &EnumSetTest::operatorInverse,
               &EnumSetTest::compare,
 
+              &EnumSetTest::iterate,
+              &EnumSetTest::iterateEmpty,
+              &EnumSetTest::iterateSignedUnderlyingType,
+
               &EnumSetTest::templateFriendOperators,
 
               &EnumSetTest::debug});
@@ -203,6 +213,44 @@ void EnumSetTest::compare() {
     CORRADE_VERIFY(!(features >= (Feature::Popular|Feature::Fast|Feature::Cheap|Feature::Tested)));
 }
 
+void EnumSetTest::iterate() {
+    Features features = Feature::Popular|Feature::Fast|Feature::Tested;
+
+    std::vector<Feature> values;
+    for(Feature i: features) values.push_back(i);
+    CORRADE_COMPARE_AS(values,
+        (std::vector<Feature>{Feature::Fast, Feature::Tested, Feature::Popular}),
+        TestSuite::Compare::Container);
+}
+
+void EnumSetTest::iterateEmpty() {
+    Features features;
+    CORRADE_VERIFY(features.begin() == features.end());
+    CORRADE_VERIFY(!(features.begin() != features.end()));
+}
+
+enum class Bit: signed char {
+    Low = 1 << 0,
+    Middle = 1 << 3,
+    /* The sign bit */
+    High = -128
+};
+
+typedef EnumSet<Bit> Bits;
+
+CORRADE_ENUMSET_OPERATORS(Bits)
+
+void EnumSetTest::iterateSignedUnderlyingType() {
+    Bits bits = Bit::High|Bit::Low|Bit::Middle;
+
+    std::vector<Bit> values;
+    for(Bit i: bits) values.push_back(i);
+    CORRADE_COMPARE(values.size(), 3);
+    CORRADE_VERIFY(values[0] == Bit::Low);
+    CORRADE_VERIFY(values[1] == Bit::Middle);
+    CORRADE_VERIFY(values[2] == Bit::High);
+}
+
 template<class T> struct Foo {
     enum class Flag {
         A = 1 << 0,
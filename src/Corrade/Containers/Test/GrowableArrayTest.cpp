@@ -28,7 +28,9 @@
 #include <vector>
 
 #include "Corrade/Containers/GrowableArray.h"
+#include "Corrade/Containers/Pointer.h"
 #include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Numeric.h"
 #include "Corrade/Utility/DebugStl.h"
 
 /* No __has_feature on GCC: https://gcc.gnu.org/bugzilla/show_bug.cgi?id=60512
@@ -60,6 +62,37 @@ extern "C" const void *__sanitizer_contiguous_container_find_bad_address(
 #define VERIFY_SANITIZED_PROPERLY(array, Allocator) do {} while(false)
 #endif
 
+namespace {
+
+struct Relocatable {
+    static int constructed;
+    static int destructed;
+    static int moved;
+
+    /*implicit*/ Relocatable(int a = 0) noexcept: a{a} { ++constructed; }
+    Relocatable(const Relocatable&) = delete;
+    Relocatable(Relocatable&& other) noexcept: a(other.a) {
+        ++constructed;
+        ++moved;
+    }
+    ~Relocatable() { ++destructed; }
+    Relocatable& operator=(const Relocatable&) = delete;
+
+    int a;
+};
+
+int Relocatable::constructed = 0;
+int Relocatable::destructed = 0;
+int Relocatable::moved = 0;
+
+}
+
+namespace Corrade { namespace Utility {
+
+template<> struct IsTriviallyRelocatable<Relocatable>: std::true_type {};
+
+}}
+
 namespace Corrade { namespace Containers { namespace Test { namespace {
 
 struct GrowableArrayTest: TestSuite::Tester {
@@ -97,9 +130,41 @@ struct GrowableArrayTest: TestSuite::Tester {
     void appendCopy();
     void appendMove();
     void appendList();
+    template<class T> void appendNoInit();
 
     void appendGrowRatio();
 
+    template<class T> void insertFromEmpty();
+    template<class T> void insertFromNonGrowable();
+    template<class T> void insertFromGrowableNoRealloc();
+    void insertCopy();
+    void insertList();
+    template<class T> void insertNoInit();
+    void insertInvalid();
+
+    void growthFactor();
+    void growthPageRounded();
+    void growthSizeClass();
+    void growthCappedLinear();
+    void growthAllocator();
+
+    void alignedAllocator();
+    void alignedAllocatorNonTrivial();
+    void alignedAllocatorOverAlignedType();
+
+    void relocatable();
+    void relocatableNewAllocator();
+    void relocatablePointer();
+
+    template<class T> void removeZero();
+    template<class T> void removeNonGrowable();
+    template<class T> void removeGrowable();
+    template<class T> void removeUnorderedNonGrowable();
+    template<class T> void removeUnorderedGrowable();
+    template<class T> void removeIfNonGrowable();
+    template<class T> void removeIfGrowable();
+    void removeInvalid();
+
     template<class T> void removeSuffixZero();
     template<class T> void removeSuffixNonGrowable();
     template<class T> void removeSuffixGrowable();
@@ -254,9 +319,39 @@ GrowableArrayTest::GrowableArrayTest() {
               &GrowableArrayTest::appendCopy,
               &GrowableArrayTest::appendMove,
               &GrowableArrayTest::appendList,
+              &GrowableArrayTest::appendNoInit<int>,
+              &GrowableArrayTest::appendNoInit<Movable>,
 
               &GrowableArrayTest::appendGrowRatio,
 
+              &GrowableArrayTest::insertFromEmpty<int>,
+              &GrowableArrayTest::insertFromEmpty<Movable>,
+              &GrowableArrayTest::insertFromNonGrowable<int>,
+              &GrowableArrayTest::insertFromNonGrowable<Movable>,
+              &GrowableArrayTest::insertFromGrowableNoRealloc<int>,
+              &GrowableArrayTest::insertFromGrowableNoRealloc<Movable>,
+              &GrowableArrayTest::insertCopy,
+              &GrowableArrayTest::insertList,
+              &GrowableArrayTest::insertNoInit<int>,
+              &GrowableArrayTest::insertNoInit<Movable>,
+              &GrowableArrayTest::insertInvalid,
+
+              &GrowableArrayTest::removeZero<int>,
+              &GrowableArrayTest::removeZero<Movable>,
+              &GrowableArrayTest::removeNonGrowable<int>,
+              &GrowableArrayTest::removeNonGrowable<Movable>,
+              &GrowableArrayTest::removeGrowable<int>,
+              &GrowableArrayTest::removeGrowable<Movable>,
+              &GrowableArrayTest::removeUnorderedNonGrowable<int>,
+              &GrowableArrayTest::removeUnorderedNonGrowable<Movable>,
+              &GrowableArrayTest::removeUnorderedGrowable<int>,
+              &GrowableArrayTest::removeUnorderedGrowable<Movable>,
+              &GrowableArrayTest::removeIfNonGrowable<int>,
+              &GrowableArrayTest::removeIfNonGrowable<Movable>,
+              &GrowableArrayTest::removeIfGrowable<int>,
+              &GrowableArrayTest::removeIfGrowable<Movable>,
+              &GrowableArrayTest::removeInvalid,
+
               &GrowableArrayTest::removeSuffixZero<int>,
               &GrowableArrayTest::removeSuffixZero<Movable>,
               &GrowableArrayTest::removeSuffixNonGrowable<int>,
@@ -281,7 +376,21 @@ GrowableArrayTest::GrowableArrayTest() {
               &GrowableArrayTest::castNonGrowable,
               &GrowableArrayTest::castInvalid,
 
-              &GrowableArrayTest::explicitAllocatorParameter});
+              &GrowableArrayTest::explicitAllocatorParameter,
+
+              &GrowableArrayTest::growthFactor,
+              &GrowableArrayTest::growthPageRounded,
+              &GrowableArrayTest::growthSizeClass,
+              &GrowableArrayTest::growthCappedLinear,
+              &GrowableArrayTest::growthAllocator,
+
+              &GrowableArrayTest::alignedAllocator,
+              &GrowableArrayTest::alignedAllocatorNonTrivial,
+              &GrowableArrayTest::alignedAllocatorOverAlignedType,
+
+              &GrowableArrayTest::relocatable,
+              &GrowableArrayTest::relocatableNewAllocator,
+              &GrowableArrayTest::relocatablePointer});
 
     addBenchmarks({
         &GrowableArrayTest::benchmarkAppendVector,
@@ -1077,6 +1186,53 @@ void GrowableArrayTest::appendList() {
     CORRADE_COMPARE(a[2], 65);
     CORRADE_COMPARE(a[3], 2786541);
     VERIFY_SANITIZED_PROPERLY(a, ArrayAllocator<int>);
+
+    /* The allocator should be propagated */
+    Array<int> b;
+    arrayAppend<ArrayNewAllocator>(b, {17, -22});
+    CORRADE_VERIFY(arrayIsGrowable<ArrayNewAllocator>(b));
+    CORRADE_COMPARE(b.size(), 2);
+    CORRADE_COMPARE(b[1], -22);
+}
+
+template<class T> void GrowableArrayTest::appendNoInit() {
+    setTestCaseTemplateName(TypeName<T>::name());
+
+    {
+        Array<T> a;
+        arrayAppend(a, T{28});
+
+        ArrayView<T> view = arrayAppend(a, NoInit, 3);
+        CORRADE_COMPARE(a.size(), 4);
+        CORRADE_VERIFY(arrayCapacity(a) >= 4);
+        CORRADE_COMPARE(view.data(), a + 1);
+        CORRADE_COMPARE(view.size(), 3);
+        VERIFY_SANITIZED_PROPERLY(a, ArrayAllocator<T>);
+
+        /* The items are not initialized, so placement-new them */
+        for(std::size_t i = 0; i != view.size(); ++i)
+            new(&view[i]) T{int(i) + 1};
+
+        CORRADE_COMPARE(int(a[0]), 28);
+        CORRADE_COMPARE(int(a[1]), 1);
+        CORRADE_COMPARE(int(a[2]), 2);
+        CORRADE_COMPARE(int(a[3]), 3);
+
+        /* Appending zero items gives back an empty view at the end */
+        ArrayView<T> empty = arrayAppend(a, NoInit, 0);
+        CORRADE_COMPARE(empty.data(), a + 4);
+        CORRADE_COMPARE(empty.size(), 0);
+        CORRADE_COMPARE(a.size(), 4);
+    }
+
+    /* The first item is constructed & moved, then moved again on the
+       reallocation. No other construction happens except for the three
+       explicit ones. */
+    if(std::is_same<T, Movable>::value) {
+        CORRADE_COMPARE(Movable::constructed, 6);
+        CORRADE_COMPARE(Movable::moved, 2);
+        CORRADE_COMPARE(Movable::destructed, 6);
+    }
 }
 
 void GrowableArrayTest::appendGrowRatio() {
@@ -1159,6 +1315,516 @@ void GrowableArrayTest::appendGrowRatio() {
     }
 }
 
+template<class T> void GrowableArrayTest::insertFromEmpty() {
+    setTestCaseTemplateName(TypeName<T>::name());
+
+    {
+        Array<T> a;
+        arrayInsert(a, 0, T{37});
+        CORRADE_VERIFY(arrayIsGrowable(a));
+        CORRADE_COMPARE(a.size(), 1);
+        CORRADE_COMPARE(int(a[0]), 37);
+        VERIFY_SANITIZED_PROPERLY(a, ArrayAllocator<T>);
+    }
+
+    /* The item is move-constructed into the new place */
+    if(std::is_same<T, Movable>::value) {
+        CORRADE_COMPARE(Movable::constructed, 2);
+        CORRADE_COMPARE(Movable::moved, 1);
+        CORRADE_COMPARE(Movable::destructed, 2);
+    }
+}
+
+template<class T> void GrowableArrayTest::insertFromNonGrowable() {
+    setTestCaseTemplateName(TypeName<T>::name());
+
+    {
+        Array<T> a{2};
+        T* prev = a;
+        a[0] = 28;
+        a[1] = 26;
+
+        arrayInsert(a, 1, T{37});
+        CORRADE_VERIFY(a != prev);
+        CORRADE_VERIFY(arrayIsGrowable(a));
+        CORRADE_COMPARE(a.size(), 3);
+        CORRADE_COMPARE(int(a[0]), 28);
+        CORRADE_COMPARE(int(a[1]), 37);
+        CORRADE_COMPARE(int(a[2]), 26);
+        VERIFY_SANITIZED_PROPERLY(a, ArrayAllocator<T>);
+    }
+
+    /* The two items are constructed in-place, then move-constructed into
+       growable memory. The last one is then shifted one item forward (another
+       move) and the inserted one is constructed & moved into the gap. */
+    if(std::is_same<T, Movable>::value) {
+        CORRADE_COMPARE(Movable::constructed, 7);
+        CORRADE_COMPARE(Movable::moved, 4);
+        CORRADE_COMPARE(Movable::destructed, 7);
+    }
+}
+
+template<class T> void GrowableArrayTest::insertFromGrowableNoRealloc() {
+    setTestCaseTemplateName(TypeName<T>::name());
+
+    {
+        Array<T> a;
+        arrayReserve(a, 4);
+        T* prev = a;
+        arrayResize(a, 3);
+        a[0] = 28;
+        a[1] = 37;
+        a[2] = 26;
+
+        /* Insert at the front, shifting everything */
+        arrayInsert(a, 0, T{-1});
+        CORRADE_VERIFY(a == prev);
+        CORRADE_COMPARE(a.size(), 4);
+        CORRADE_COMPARE(arrayCapacity(a), 4);
+        CORRADE_COMPARE(int(a[0]), -1);
+        CORRADE_COMPARE(int(a[1]), 28);
+        CORRADE_COMPARE(int(a[2]), 37);
+        CORRADE_COMPARE(int(a[3]), 26);
+        VERIFY_SANITIZED_PROPERLY(a, ArrayAllocator<T>);
+    }
+
+    /* Three items value-constructed, then three shifted and the inserted one
+       constructed & moved into the gap */
+    if(std::is_same<T, Movable>::value) {
+        CORRADE_COMPARE(Movable::constructed, 8);
+        CORRADE_COMPARE(Movable::moved, 4);
+        CORRADE_COMPARE(Movable::destructed, 8);
+    }
+}
+
+void GrowableArrayTest::insertCopy() {
+    Array<int> a;
+    arrayAppend(a, {1, 2});
+
+    /* Inserting at the end is like an append */
+    const int value = 2786541;
+    arrayInsert(a, 2, value);
+    arrayInsert(a, 1, InPlaceInit, 17);
+    CORRADE_COMPARE(a.size(), 4);
+    CORRADE_COMPARE(a[0], 1);
+    CORRADE_COMPARE(a[1], 17);
+    CORRADE_COMPARE(a[2], 2);
+    CORRADE_COMPARE(a[3], 2786541);
+    VERIFY_SANITIZED_PROPERLY(a, ArrayAllocator<int>);
+}
+
+void GrowableArrayTest::insertList() {
+    Array<int> a;
+    arrayAppend(a, {1, 2, 3});
+    arrayInsert(a, 1, {17, -22, 65});
+    CORRADE_COMPARE(a.size(), 6);
+    CORRADE_COMPARE(a[0], 1);
+    CORRADE_COMPARE(a[1], 17);
+    CORRADE_COMPARE(a[2], -22);
+    CORRADE_COMPARE(a[3], 65);
+    CORRADE_COMPARE(a[4], 2);
+    CORRADE_COMPARE(a[5], 3);
+    VERIFY_SANITIZED_PROPERLY(a, ArrayAllocator<int>);
+
+    /* Empty insert is a no-op */
+    arrayInsert(a, 6, ArrayView<const int>{});
+    CORRADE_COMPARE(a.size(), 6);
+}
+
+template<class T> void GrowableArrayTest::insertNoInit() {
+    setTestCaseTemplateName(TypeName<T>::name());
+
+    {
+        Array<T> a;
+        arrayAppend(a, InPlaceInit, 28);
+        arrayAppend(a, InPlaceInit, 26);
+
+        ArrayView<T> view = arrayInsert(a, 1, NoInit, 2);
+        CORRADE_COMPARE(a.size(), 4);
+        CORRADE_COMPARE(view.data(), a + 1);
+        CORRADE_COMPARE(view.size(), 2);
+        VERIFY_SANITIZED_PROPERLY(a, ArrayAllocator<T>);
+
+        new(&view[0]) T{1};
+        new(&view[1]) T{2};
+        CORRADE_COMPARE(int(a[0]), 28);
+        CORRADE_COMPARE(int(a[1]), 1);
+        CORRADE_COMPARE(int(a[2]), 2);
+        CORRADE_COMPARE(int(a[3]), 26);
+    }
+
+    /* Items could get moved on reallocation, but the constructions match the
+       destructions in any case */
+    if(std::is_same<T, Movable>::value)
+        CORRADE_COMPARE(Movable::constructed, Movable::destructed);
+}
+
+void GrowableArrayTest::insertInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Array<int> a{4};
+
+    std::ostringstream out;
+    Error redirectOutput{&out};
+
+    arrayInsert(a, 5, 3);
+    arrayInsert(a, 5, {1, 2});
+    arrayInsert(a, 5, NoInit, 2);
+    CORRADE_COMPARE(out.str(),
+        "Containers::arrayInsert(): can't insert at index 5 into an array of size 4\n"
+        "Containers::arrayInsert(): can't insert at index 5 into an array of size 4\n"
+        "Containers::arrayInsert(): can't insert at index 5 into an array of size 4\n");
+}
+
+template<class T> void GrowableArrayTest::removeZero() {
+    setTestCaseTemplateName(TypeName<T>::name());
+
+    {
+        Array<T> a{3};
+        T* prev = a.data();
+        a[0] = 2;
+        a[1] = 7;
+        a[2] = -1;
+
+        /* Should do no nuthin' */
+        arrayRemove(a, 1, 0);
+        arrayRemoveUnordered(a, 3, 0);
+        CORRADE_VERIFY(!arrayIsGrowable(a));
+        CORRADE_COMPARE(a.size(), 3);
+        CORRADE_VERIFY(a.data() == prev);
+        CORRADE_COMPARE(int(a[0]), 2);
+        CORRADE_COMPARE(int(a[1]), 7);
+        CORRADE_COMPARE(int(a[2]), -1);
+        /* Not growable, no ASan annotation check */
+    }
+
+    if(std::is_same<T, Movable>::value) {
+        CORRADE_COMPARE(Movable::constructed, 3);
+        CORRADE_COMPARE(Movable::moved, 0);
+        CORRADE_COMPARE(Movable::destructed, 3);
+    }
+}
+
+template<class T> void GrowableArrayTest::removeNonGrowable() {
+    setTestCaseTemplateName(TypeName<T>::name());
+
+    {
+        Array<T> a{5};
+        T* prev = a.data();
+        a[0] = 2;
+        a[1] = 7;
+        a[2] = -1;
+        a[3] = 3578;
+        a[4] = 15;
+
+        /* Gets converted to growable as otherwise we can't ensure the
+           destructors won't be called on removed elements */
+        arrayRemove(a, 1, 2);
+        CORRADE_VERIFY(arrayIsGrowable(a));
+        CORRADE_COMPARE(a.size(), 3);
+        CORRADE_COMPARE(arrayCapacity(a), 3);
+        CORRADE_VERIFY(a.data() != prev);
+        CORRADE_COMPARE(int(a[0]), 2);
+        CORRADE_COMPARE(int(a[1]), 3578);
+        CORRADE_COMPARE(int(a[2]), 15);
+        VERIFY_SANITIZED_PROPERLY(a, ArrayAllocator<T>);
+
+        /* Three move-constructed to the new array */
+        if(std::is_same<T, Movable>::value) {
+            CORRADE_COMPARE(Movable::constructed, 8);
+            CORRADE_COMPARE(Movable::moved, 3);
+            CORRADE_COMPARE(Movable::destructed, 5);
+        }
+    }
+
+    if(std::is_same<T, Movable>::value) {
+        CORRADE_COMPARE(Movable::constructed, 8);
+        CORRADE_COMPARE(Movable::moved, 3);
+        CORRADE_COMPARE(Movable::destructed, 8);
+    }
+}
+
+template<class T> void GrowableArrayTest::removeGrowable() {
+    setTestCaseTemplateName(TypeName<T>::name());
+
+    {
+        Array<T> a;
+        arrayReserve(a, 10);
+        T* prev = a.data();
+        arrayAppend(a, InPlaceInit, 2);
+        arrayAppend(a, InPlaceInit, 7);
+        arrayAppend(a, InPlaceInit, -1);
+        arrayAppend(a, InPlaceInit, 3578);
+        arrayAppend(a, InPlaceInit, 15);
+        arrayAppend(a, InPlaceInit, 3);
+        VERIFY_SANITIZED_PROPERLY(a, ArrayAllocator<T>);
+
+        arrayRemove(a, 1, 2);
+        CORRADE_VERIFY(arrayIsGrowable(a));
+        CORRADE_COMPARE(a.size(), 4);
+        CORRADE_COMPARE(arrayCapacity(a), 10);
+        CORRADE_VERIFY(a.data() == prev);
+        CORRADE_COMPARE(int(a[0]), 2);
+        CORRADE_COMPARE(int(a[1]), 3578);
+        CORRADE_COMPARE(int(a[2]), 15);
+        CORRADE_COMPARE(int(a[3]), 3);
+        VERIFY_SANITIZED_PROPERLY(a, ArrayAllocator<T>);
+
+        /* Two destructed, three after shifted backward */
+        if(std::is_same<T, Movable>::value) {
+            CORRADE_COMPARE(Movable::constructed, 9);
+            CORRADE_COMPARE(Movable::moved, 3);
+            CORRADE_COMPARE(Movable::destructed, 5);
+        }
+
+        /* Removing the last element is just a destruction */
+        arrayRemove(a, 3);
+        CORRADE_COMPARE(a.size(), 3);
+        CORRADE_COMPARE(int(a[2]), 15);
+        if(std::is_same<T, Movable>::value) {
+            CORRADE_COMPARE(Movable::constructed, 9);
+            CORRADE_COMPARE(Movable::moved, 3);
+            CORRADE_COMPARE(Movable::destructed, 6);
+        }
+        VERIFY_SANITIZED_PROPERLY(a, ArrayAllocator<T>);
+    }
+
+    if(std::is_same<T, Movable>::value) {
+        CORRADE_COMPARE(Movable::constructed, 9);
+        CORRADE_COMPARE(Movable::moved, 3);
+        CORRADE_COMPARE(Movable::destructed, 9);
+    }
+}
+
+template<class T> void GrowableArrayTest::removeUnorderedNonGrowable() {
+    setTestCaseTemplateName(TypeName<T>::name());
+
+    {
+        Array<T> a{4};
+        T* prev = a.data();
+        a[0] = 2;
+        a[1] = 7;
+        a[2] = -1;
+        a[3] = 3578;
+
+        /* Same as arrayRemove(), as everything needs to be moved anyway */
+        arrayRemoveUnordered(a, 1);
+        CORRADE_VERIFY(arrayIsGrowable(a));
+        CORRADE_COMPARE(a.size(), 3);
+        CORRADE_COMPARE(arrayCapacity(a), 3);
+        CORRADE_VERIFY(a.data() != prev);
+        CORRADE_COMPARE(int(a[0]), 2);
+        CORRADE_COMPARE(int(a[1]), -1);
+        CORRADE_COMPARE(int(a[2]), 3578);
+        VERIFY_SANITIZED_PROPERLY(a, ArrayAllocator<T>);
+
+        if(std::is_same<T, Movable>::value) {
+            CORRADE_COMPARE(Movable::constructed, 7);
+            CORRADE_COMPARE(Movable::moved, 3);
+            CORRADE_COMPARE(Movable::destructed, 4);
+        }
+    }
+
+    if(std::is_same<T, Movable>::value) {
+        CORRADE_COMPARE(Movable::constructed, 7);
+        CORRADE_COMPARE(Movable::moved, 3);
+        CORRADE_COMPARE(Movable::destructed, 7);
+    }
+}
+
+template<class T> void GrowableArrayTest::removeUnorderedGrowable() {
+    setTestCaseTemplateName(TypeName<T>::name());
+
+    {
+        Array<T> a;
+        arrayReserve(a, 10);
+        T* prev = a.data();
+        arrayAppend(a, InPlaceInit, 2);
+        arrayAppend(a, InPlaceInit, 7);
+        arrayAppend(a, InPlaceInit, -1);
+        arrayAppend(a, InPlaceInit, 3578);
+        arrayAppend(a, InPlaceInit, 15);
+        arrayAppend(a, InPlaceInit, 3);
+        VERIFY_SANITIZED_PROPERLY(a, ArrayAllocator<T>);
+
+        /* The last two elements get moved into the gap */
+        arrayRemoveUnordered(a, 1, 2);
+        CORRADE_VERIFY(arrayIsGrowable(a));
+        CORRADE_COMPARE(a.size(), 4);
+        CORRADE_COMPARE(arrayCapacity(a), 10);
+        CORRADE_VERIFY(a.data() == prev);
+        CORRADE_COMPARE(int(a[0]), 2);
+        CORRADE_COMPARE(int(a[1]), 15);
+        CORRADE_COMPARE(int(a[2]), 3);
+        CORRADE_COMPARE(int(a[3]), 3578);
+        VERIFY_SANITIZED_PROPERLY(a, ArrayAllocator<T>);
+
+        if(std::is_same<T, Movable>::value) {
+            CORRADE_COMPARE(Movable::constructed, 8);
+            CORRADE_COMPARE(Movable::moved, 2);
+            CORRADE_COMPARE(Movable::destructed, 4);
+        }
+
+        /* Less elements after the range than removed, only those get
+           moved */
+        arrayRemoveUnordered(a, 1, 2);
+        CORRADE_COMPARE(a.size(), 2);
+        CORRADE_COMPARE(int(a[0]), 2);
+        CORRADE_COMPARE(int(a[1]), 3578);
+        VERIFY_SANITIZED_PROPERLY(a, ArrayAllocator<T>);
+
+        if(std::is_same<T, Movable>::value) {
+            CORRADE_COMPARE(Movable::constructed, 9);
+            CORRADE_COMPARE(Movable::moved, 3);
+            CORRADE_COMPARE(Movable::destructed, 7);
+        }
+
+        /* Removing the last element doesn't move anything */
+        arrayRemoveUnordered(a, 1);
+        CORRADE_COMPARE(a.size(), 1);
+        CORRADE_COMPARE(int(a[0]), 2);
+        VERIFY_SANITIZED_PROPERLY(a, ArrayAllocator<T>);
+
+        if(std::is_same<T, Movable>::value) {
+            CORRADE_COMPARE(Movable::constructed, 9);
+            CORRADE_COMPARE(Movable::moved, 3);
+            CORRADE_COMPARE(Movable::destructed, 8);
+        }
+    }
+
+    if(std::is_same<T, Movable>::value) {
+        CORRADE_COMPARE(Movable::constructed, 9);
+        CORRADE_COMPARE(Movable::moved, 3);
+        CORRADE_COMPARE(Movable::destructed, 9);
+    }
+}
+
+template<class T> void GrowableArrayTest::removeIfNonGrowable() {
+    setTestCaseTemplateName(TypeName<T>::name());
+
+    {
+        Array<T> a{6};
+        T* prev = a.data();
+        a[0] = 2;
+        a[1] = 7;
+        a[2] = -1;
+        a[3] = 3578;
+        a[4] = 15;
+        a[5] = 4;
+
+        int called = 0;
+        CORRADE_COMPARE(arrayRemoveIf(a, [&called](const T& value) {
+            ++called;
+            return int(value) % 2 != 0;
+        }), 3);
+        CORRADE_COMPARE(called, 6);
+        CORRADE_VERIFY(arrayIsGrowable(a));
+        CORRADE_COMPARE(a.size(), 3);
+        /* The original size is allocated to not need to call the predicate
+           twice */
+        CORRADE_COMPARE(arrayCapacity(a), 6);
+        CORRADE_VERIFY(a.data() != prev);
+        CORRADE_COMPARE(int(a[0]), 2);
+        CORRADE_COMPARE(int(a[1]), 3578);
+        CORRADE_COMPARE(int(a[2]), 4);
+        VERIFY_SANITIZED_PROPERLY(a, ArrayAllocator<T>);
+
+        /* Three move-constructed to the new array */
+        if(std::is_same<T, Movable>::value) {
+            CORRADE_COMPARE(Movable::constructed, 9);
+            CORRADE_COMPARE(Movable::moved, 3);
+            CORRADE_COMPARE(Movable::destructed, 6);
+        }
+    }
+
+    if(std::is_same<T, Movable>::value) {
+        CORRADE_COMPARE(Movable::constructed, 9);
+        CORRADE_COMPARE(Movable::moved, 3);
+        CORRADE_COMPARE(Movable::destructed, 9);
+    }
+}
+
+template<class T> void GrowableArrayTest::removeIfGrowable() {
+    setTestCaseTemplateName(TypeName<T>::name());
+
+    {
+        Array<T> a;
+        arrayReserve(a, 10);
+        T* prev = a.data();
+        arrayAppend(a, InPlaceInit, 2);
+        arrayAppend(a, InPlaceInit, 7);
+        arrayAppend(a, InPlaceInit, -1);
+        arrayAppend(a, InPlaceInit, 3578);
+        arrayAppend(a, InPlaceInit, 15);
+        arrayAppend(a, InPlaceInit, 4);
+        VERIFY_SANITIZED_PROPERLY(a, ArrayAllocator<T>);
+
+        int called = 0;
+        CORRADE_COMPARE(arrayRemoveIf(a, [&called](const T& value) {
+            ++called;
+            return int(value) % 2 != 0;
+        }), 3);
+        CORRADE_COMPARE(called, 6);
+        CORRADE_VERIFY(arrayIsGrowable(a));
+        CORRADE_COMPARE(a.size(), 3);
+        CORRADE_COMPARE(arrayCapacity(a), 10);
+        CORRADE_VERIFY(a.data() == prev);
+        CORRADE_COMPARE(int(a[0]), 2);
+        CORRADE_COMPARE(int(a[1]), 3578);
+        CORRADE_COMPARE(int(a[2]), 4);
+        VERIFY_SANITIZED_PROPERLY(a, ArrayAllocator<T>);
+
+        /* The first element stays in place, the other two kept ones are
+           moved once */
+        if(std::is_same<T, Movable>::value) {
+            CORRADE_COMPARE(Movable::constructed, 8);
+            CORRADE_COMPARE(Movable::moved, 2);
+            CORRADE_COMPARE(Movable::destructed, 5);
+        }
+
+        /* Nothing matching, nothing done */
+        CORRADE_COMPARE(arrayRemoveIf(a, [](const T&) { return false; }), 0);
+        CORRADE_COMPARE(a.size(), 3);
+        if(std::is_same<T, Movable>::value) {
+            CORRADE_COMPARE(Movable::constructed, 8);
+            CORRADE_COMPARE(Movable::moved, 2);
+            CORRADE_COMPARE(Movable::destructed, 5);
+        }
+        VERIFY_SANITIZED_PROPERLY(a, ArrayAllocator<T>);
+    }
+
+    if(std::is_same<T, Movable>::value) {
+        CORRADE_COMPARE(Movable::constructed, 8);
+        CORRADE_COMPARE(Movable::moved, 2);
+        CORRADE_COMPARE(Movable::destructed, 8);
+    }
+}
+
+void GrowableArrayTest::removeInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Array<int> a{4};
+    Array<int> b;
+    arrayResize(b, 4);
+
+    std::ostringstream out;
+    Error redirectOutput{&out};
+
+    arrayRemove(a, 3, 2);
+    arrayRemove(b, 5, 0);
+    arrayRemoveUnordered(a, 2, 3);
+    arrayRemoveUnordered(b, 5);
+    CORRADE_COMPARE(out.str(),
+        "Containers::arrayRemove(): can't remove 2 elements at index 3 from an array of size 4\n"
+        "Containers::arrayRemove(): can't remove 0 elements at index 5 from an array of size 4\n"
+        "Containers::arrayRemoveUnordered(): can't remove 3 elements at index 2 from an array of size 4\n"
+        "Containers::arrayRemoveUnordered(): can't remove 1 elements at index 5 from an array of size 4\n");
+}
+
 template<class T> void GrowableArrayTest::removeSuffixZero() {
     setTestCaseTemplateName(TypeName<T>::name());
 
@@ -1447,6 +2113,82 @@ void GrowableArrayTest::castInvalid() {
         "Containers::arrayAllocatorCast(): can't reinterpret 10 1-byte items into a 4-byte type\n");
 }
 
+void GrowableArrayTest::relocatable() {
+    /* Trivially relocatable types use the malloc allocator by default */
+    CORRADE_VERIFY((std::is_same<ArrayAllocator<Relocatable>, ArrayMallocAllocator<Relocatable>>::value));
+    CORRADE_VERIFY((std::is_same<ArrayAllocator<Pointer<int>>, ArrayMallocAllocator<Pointer<int>>>::value));
+    CORRADE_VERIFY((std::is_same<ArrayAllocator<Array<int>>, ArrayMallocAllocator<Array<int>>>::value));
+
+    Relocatable::constructed = Relocatable::destructed = Relocatable::moved = 0;
+    {
+        Array<Relocatable> a;
+        for(int i = 0; i != 10; ++i)
+            arrayAppend(a, InPlaceInit, i);
+        CORRADE_VERIFY(arrayIsGrowable(a));
+        CORRADE_COMPARE(a.size(), 10);
+        CORRADE_COMPARE(a[0].a, 0);
+        CORRADE_COMPARE(a[9].a, 9);
+
+        /* Nothing moved or destructed on the reallocations */
+        CORRADE_COMPARE(Relocatable::moved, 0);
+        CORRADE_COMPARE(Relocatable::constructed, 10);
+        CORRADE_COMPARE(Relocatable::destructed, 0);
+
+        /* Nothing moved or destructed on shifting the items either */
+        arrayInsert(a, 0, InPlaceInit, 100);
+        CORRADE_COMPARE(a.size(), 11);
+        CORRADE_COMPARE(a[0].a, 100);
+        CORRADE_COMPARE(a[1].a, 0);
+        CORRADE_COMPARE(a[10].a, 9);
+        CORRADE_COMPARE(Relocatable::moved, 0);
+        CORRADE_COMPARE(Relocatable::constructed, 11);
+        CORRADE_COMPARE(Relocatable::destructed, 0);
+
+        arrayRemoveSuffix(a);
+        CORRADE_COMPARE(Relocatable::destructed, 1);
+    }
+
+    /* The deleter calls the destructors on the remaining items */
+    CORRADE_COMPARE(Relocatable::constructed, 11);
+    CORRADE_COMPARE(Relocatable::destructed, 11);
+}
+
+void GrowableArrayTest::relocatableNewAllocator() {
+    typedef ArrayNewAllocator<Relocatable> Allocator;
+
+    Relocatable::constructed = Relocatable::destructed = Relocatable::moved = 0;
+    {
+        Array<Relocatable> a;
+        for(int i = 0; i != 10; ++i)
+            arrayAppend<Relocatable, Allocator>(a, InPlaceInit, i);
+        CORRADE_VERIFY((arrayIsGrowable<Relocatable, Allocator>(a)));
+        CORRADE_COMPARE(a[0].a, 0);
+        CORRADE_COMPARE(a[9].a, 9);
+
+        /* The reallocations are a plain copy here as well */
+        CORRADE_COMPARE(Relocatable::moved, 0);
+        CORRADE_COMPARE(Relocatable::constructed, 10);
+        CORRADE_COMPARE(Relocatable::destructed, 0);
+    }
+
+    CORRADE_COMPARE(Relocatable::constructed, 10);
+    CORRADE_COMPARE(Relocatable::destructed, 10);
+}
+
+void GrowableArrayTest::relocatablePointer() {
+    Array<Pointer<int>> a;
+    for(int i = 0; i != 100; ++i)
+        arrayAppend(a, InPlaceInit, new int{i});
+    arrayInsert(a, 50, InPlaceInit, new int{1337});
+
+    CORRADE_COMPARE(a.size(), 101);
+    CORRADE_COMPARE(*a[0], 0);
+    CORRADE_COMPARE(*a[49], 49);
+    CORRADE_COMPARE(*a[50], 1337);
+    CORRADE_COMPARE(*a[51], 50);
+    CORRADE_COMPARE(*a[100], 99);
+}
+
 void GrowableArrayTest::explicitAllocatorParameter() {
     Array<int> a;
     arrayReserve<ArrayNewAllocator>(a, 10);
@@ -1482,6 +2224,161 @@ void GrowableArrayTest::explicitAllocatorParameter() {
     CORRADE_COMPARE(b.size(), 7);
 }
 
+void GrowableArrayTest::growthFactor() {
+    /* Grows by at least one element */
+    CORRADE_COMPARE((ArrayFactorGrowth<3, 2>::grow(0, 1, 4)), 1);
+    CORRADE_COMPARE((ArrayFactorGrowth<3, 2>::grow(1, 2, 4)), 2);
+    CORRADE_COMPARE((ArrayFactorGrowth<3, 2>::grow(10, 11, 4)), 15);
+    CORRADE_COMPARE((ArrayFactorGrowth<2>::grow(10, 11, 4)), 20);
+
+    /* Desired capacity wins if larger */
+    CORRADE_COMPARE((ArrayFactorGrowth<3, 2>::grow(10, 100, 4)), 100);
+}
+
+void GrowableArrayTest::growthPageRounded() {
+    /* Small allocations are the same as the default */
+    CORRADE_COMPARE(ArrayPageRoundedGrowth<>::grow(14, 15, 4),
+        ArrayDefaultGrowth::grow(14, 15, 4));
+
+    /* Large ones get rounded up to whole pages including the capacity */
+    CORRADE_COMPARE(ArrayPageRoundedGrowth<>::grow(2000, 2001, 4),
+        (3*4096 - sizeof(std::size_t))/4);
+    CORRADE_COMPARE(ArrayPageRoundedGrowth<1024>::grow(0, 300, 4),
+        (2*1024 - sizeof(std::size_t))/4);
+}
+
+void GrowableArrayTest::growthSizeClass() {
+    /* Multiples of 16 up to 128 bytes */
+    CORRADE_COMPARE(ArraySizeClassGrowth::grow(0, 3, 1),
+        16 - sizeof(std::size_t));
+    CORRADE_COMPARE(ArraySizeClassGrowth::grow(0, 41, 1),
+        64 - sizeof(std::size_t));
+
+    /* Then four classes per power of two */
+    CORRADE_COMPARE(ArraySizeClassGrowth::grow(0, 130, 1),
+        160 - sizeof(std::size_t));
+    CORRADE_COMPARE(ArraySizeClassGrowth::grow(0, 248, 1),
+        256 - sizeof(std::size_t));
+    CORRADE_COMPARE(ArraySizeClassGrowth::grow(0, 260, 1),
+        320 - sizeof(std::size_t));
+    CORRADE_COMPARE(ArraySizeClassGrowth::grow(0, 5000, 1),
+        5120 - sizeof(std::size_t));
+}
+
+void GrowableArrayTest::growthCappedLinear() {
+    /* Below the threshold it's the same as the default */
+    CORRADE_COMPARE(ArrayCappedLinearGrowth<1024>::grow(14, 15, 4),
+        ArrayDefaultGrowth::grow(14, 15, 4));
+
+    /* Above it grows linearly */
+    CORRADE_COMPARE(ArrayCappedLinearGrowth<1024>::grow(1000, 1001, 4),
+        1000 + 1024/4);
+    CORRADE_COMPARE(ArrayCappedLinearGrowth<1024>::grow(1256, 1257, 4),
+        1256 + 1024/4);
+
+    /* Desired capacity wins if larger */
+    CORRADE_COMPARE(ArrayCappedLinearGrowth<1024>::grow(1000, 5000, 4), 5000);
+}
+
+template<class T> using ArrayFactor2Allocator = ArrayGrowthAllocator<ArrayMallocAllocator<T>, ArrayFactorGrowth<2>>;
+
+void GrowableArrayTest::growthAllocator() {
+    Array<int> a;
+    arrayAppend<ArrayFactor2Allocator>(a, {1, 2, 3, 4, 5, 6, 7, 8, 9, 10});
+    CORRADE_COMPARE(arrayCapacity<ArrayFactor2Allocator>(a), 10);
+    VERIFY_SANITIZED_PROPERLY(a, ArrayFactor2Allocator<int>);
+
+    arrayAppend<ArrayFactor2Allocator>(a, 11);
+    CORRADE_COMPARE(arrayCapacity<ArrayFactor2Allocator>(a), 20);
+    VERIFY_SANITIZED_PROPERLY(a, ArrayFactor2Allocator<int>);
+
+    /* The deleter is shared with the original allocator, so it's possible to
+       switch between the two without reallocating */
+    CORRADE_VERIFY(arrayIsGrowable<ArrayMallocAllocator>(a));
+    int* prev = a.data();
+    arrayAppend<ArrayMallocAllocator>(a, 12);
+    CORRADE_COMPARE(a.data(), prev);
+    CORRADE_COMPARE(a.size(), 12);
+    CORRADE_COMPARE(a[11], 12);
+}
+
+void GrowableArrayTest::alignedAllocator() {
+    typedef ArrayAlignedAllocator<int, 64> Allocator;
+
+    Array<int> a;
+    for(int i = 0; i != 100; ++i) {
+        arrayAppend<int, Allocator>(a, i);
+        CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(a.data()) % 64, 0);
+    }
+    CORRADE_VERIFY((arrayIsGrowable<int, Allocator>(a)));
+    CORRADE_COMPARE_AS((arrayCapacity<int, Allocator>(a)), 100,
+        TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE(a.size(), 100);
+    CORRADE_COMPARE(a[0], 0);
+    CORRADE_COMPARE(a[57], 57);
+    CORRADE_COMPARE(a[99], 99);
+    VERIFY_SANITIZED_PROPERLY(a, Allocator);
+
+    /* The deleter is different from the default allocator, so appending
+       with it would reallocate */
+    CORRADE_VERIFY(!arrayIsGrowable(a));
+
+    /* Shrinking makes the array non-growable again */
+    arrayShrink<int, Allocator>(a);
+    CORRADE_VERIFY(!(arrayIsGrowable<int, Allocator>(a)));
+    CORRADE_COMPARE(a.size(), 100);
+    CORRADE_COMPARE(a[99], 99);
+}
+
+void GrowableArrayTest::alignedAllocatorNonTrivial() {
+    typedef ArrayAlignedAllocator<Movable, 32> Allocator;
+
+    Movable::constructed = Movable::destructed = Movable::moved = 0;
+    {
+        Array<Movable> a;
+        arrayReserve<Movable, Allocator>(a, 2);
+        CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(a.data()) % 32, 0);
+        for(int i = 0; i != 3; ++i)
+            arrayAppend<Movable, Allocator>(a, InPlaceInit, i + 10);
+        CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(a.data()) % 32, 0);
+        CORRADE_COMPARE(a.size(), 3);
+        CORRADE_COMPARE(int(a[0]), 10);
+        CORRADE_COMPARE(int(a[2]), 12);
+
+        /* Two elements moved on the reallocation */
+        CORRADE_COMPARE(Movable::moved, 2);
+        CORRADE_COMPARE(Movable::constructed, 5);
+        CORRADE_COMPARE(Movable::destructed, 2);
+
+        arrayRemoveSuffix<Movable, Allocator>(a);
+        CORRADE_COMPARE(Movable::destructed, 3);
+    }
+
+    CORRADE_COMPARE(Movable::constructed, 5);
+    CORRADE_COMPARE(Movable::destructed, 5);
+}
+
+void GrowableArrayTest::alignedAllocatorOverAlignedType() {
+    struct alignas(32) Aligned {
+        float data[3];
+    };
+
+    /* The default allocator is picked based on the type alignment */
+    CORRADE_VERIFY((std::is_same<ArrayAllocator<Aligned>, ArrayAlignedAllocator<Aligned>>::value));
+    CORRADE_VERIFY((std::is_same<ArrayAllocator<int>, ArrayMallocAllocator<int>>::value));
+    CORRADE_VERIFY((std::is_same<ArrayAllocator<Movable>, ArrayNewAllocator<Movable>>::value));
+
+    Array<Aligned> a;
+    for(int i = 0; i != 10; ++i) {
+        arrayAppend(a, Aligned{{float(i), 0.0f, 0.0f}});
+        CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(a.data()) % 32, 0);
+    }
+    CORRADE_VERIFY(arrayIsGrowable(a));
+    CORRADE_COMPARE(a.size(), 10);
+    CORRADE_COMPARE(a[9].data[0], 9.0f);
+    VERIFY_SANITIZED_PROPERLY(a, ArrayAlignedAllocator<Aligned>);
+}
+
 void GrowableArrayTest::benchmarkAppendVector() {
     std::vector<Movable> vector;
     CORRADE_BENCHMARK(1) {
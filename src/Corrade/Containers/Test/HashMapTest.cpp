@@ -0,0 +1,440 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string>
+#include <unordered_map>
+
+#include "Corrade/Containers/HashMap.h"
+#include "Corrade/Containers/String.h"
+#include "Corrade/Containers/StringStl.h"
+#include "Corrade/TestSuite/Tester.h"
+
+namespace Corrade { namespace Containers { namespace Test { namespace {
+
+struct HashMapTest: TestSuite::Tester {
+    explicit HashMapTest();
+
+    void construct();
+    void constructReserve();
+    void constructMove();
+
+    void insert();
+    void insertExisting();
+    void insertGrow();
+    void find();
+    void findString();
+    void findEnumPointer();
+    void remove();
+    void removeReuseSlot();
+    void removeIf();
+    void clear();
+    void reserve();
+    void iterate();
+    void nonTrivial();
+    void collisions();
+
+    void benchmarkFindStl();
+    void benchmarkFind();
+};
+
+struct Movable {
+    static int constructed;
+    static int destructed;
+
+    /*implicit*/ Movable(int a = 0) noexcept: a{a} { ++constructed; }
+    Movable(const Movable&) = delete;
+    Movable(Movable&& other) noexcept: a(other.a) { ++constructed; }
+    ~Movable() { ++destructed; }
+    Movable& operator=(const Movable&) = delete;
+    Movable& operator=(Movable&&) = delete;
+
+    int a;
+};
+
+int Movable::constructed = 0;
+int Movable::destructed = 0;
+
+/* Puts everything into a single group to test probing into next groups */
+struct BadHash {
+    std::size_t operator()(int value) const { return value & 1; }
+};
+
+enum class Enum: unsigned char { A = 3, B = 255 };
+
+HashMapTest::HashMapTest() {
+    addTests({&HashMapTest::construct,
+              &HashMapTest::constructReserve,
+              &HashMapTest::constructMove,
+
+              &HashMapTest::insert,
+              &HashMapTest::insertExisting,
+              &HashMapTest::insertGrow,
+              &HashMapTest::find,
+              &HashMapTest::findString,
+              &HashMapTest::findEnumPointer,
+              &HashMapTest::remove,
+              &HashMapTest::removeReuseSlot,
+              &HashMapTest::removeIf,
+              &HashMapTest::clear,
+              &HashMapTest::reserve,
+              &HashMapTest::iterate,
+              &HashMapTest::nonTrivial,
+              &HashMapTest::collisions});
+
+    addBenchmarks({&HashMapTest::benchmarkFindStl,
+                   &HashMapTest::benchmarkFind}, 10);
+}
+
+void HashMapTest::construct() {
+    HashMap<int, float> a;
+    CORRADE_VERIFY(a.isEmpty());
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_COMPARE(a.capacity(), 0);
+    CORRADE_VERIFY(!a.find(3));
+    CORRADE_VERIFY(!a.contains(3));
+    CORRADE_VERIFY(!a.remove(3));
+    CORRADE_VERIFY(a.begin() == a.end());
+
+    CORRADE_VERIFY(!(std::is_copy_constructible<HashMap<int, float>>::value));
+    CORRADE_VERIFY(!(std::is_copy_assignable<HashMap<int, float>>::value));
+}
+
+void HashMapTest::constructReserve() {
+    HashMap<int, float> a{100};
+    CORRADE_VERIFY(a.isEmpty());
+    /* 7/8 of 128 is 112 */
+    CORRADE_COMPARE(a.capacity(), 128);
+}
+
+void HashMapTest::constructMove() {
+    HashMap<int, float> a;
+    a.insert(3, 1.5f);
+
+    HashMap<int, float> b = std::move(a);
+    CORRADE_VERIFY(a.isEmpty());
+    CORRADE_COMPARE(a.capacity(), 0);
+    CORRADE_COMPARE(b.size(), 1);
+    CORRADE_VERIFY(b.find(3));
+    CORRADE_COMPARE(*b.find(3), 1.5f);
+
+    HashMap<int, float> c;
+    c.insert(5, 2.0f);
+    c = std::move(b);
+    CORRADE_COMPARE(c.size(), 1);
+    CORRADE_VERIFY(c.find(3));
+    CORRADE_VERIFY(!c.find(5));
+    CORRADE_COMPARE(b.size(), 1);
+    CORRADE_VERIFY(b.find(5));
+
+    CORRADE_VERIFY((std::is_nothrow_move_constructible<HashMap<int, float>>::value));
+    CORRADE_VERIFY((std::is_nothrow_move_assignable<HashMap<int, float>>::value));
+}
+
+void HashMapTest::insert() {
+    HashMap<int, float> a;
+    std::pair<float*, bool> inserted = a.insert(3, 1.5f);
+    CORRADE_VERIFY(inserted.second);
+    CORRADE_VERIFY(inserted.first);
+    CORRADE_COMPARE(*inserted.first, 1.5f);
+    CORRADE_COMPARE(a.size(), 1);
+    CORRADE_COMPARE(a.capacity(), 16);
+    CORRADE_VERIFY(!a.isEmpty());
+}
+
+void HashMapTest::insertExisting() {
+    HashMap<int, float> a;
+    float* first = a.insert(3, 1.5f).first;
+
+    std::pair<float*, bool> inserted = a.insert(3, 7.0f);
+    CORRADE_VERIFY(!inserted.second);
+    CORRADE_COMPARE(inserted.first, first);
+    CORRADE_COMPARE(*inserted.first, 1.5f);
+    CORRADE_COMPARE(a.size(), 1);
+}
+
+void HashMapTest::insertGrow() {
+    HashMap<int, int> a;
+    for(int i = 0; i != 14; ++i) a.insert(i, i*10);
+    CORRADE_COMPARE(a.capacity(), 16);
+
+    /* 7/8 of 16 is 14, the next insert grows */
+    a.insert(14, 140);
+    CORRADE_COMPARE(a.capacity(), 32);
+    CORRADE_COMPARE(a.size(), 15);
+
+    for(int i = 15; i != 1000; ++i) a.insert(i, i*10);
+    CORRADE_COMPARE(a.size(), 1000);
+    CORRADE_COMPARE(a.capacity(), 2048);
+    for(int i = 0; i != 1000; ++i) {
+        CORRADE_VERIFY(a.find(i));
+        CORRADE_COMPARE(*a.find(i), i*10);
+    }
+    CORRADE_VERIFY(!a.find(1000));
+    CORRADE_VERIFY(!a.find(-1));
+}
+
+void HashMapTest::find() {
+    HashMap<int, float> a;
+    a.insert(3, 1.5f);
+    a.insert(-7, 2.5f);
+
+    CORRADE_VERIFY(a.find(3));
+    CORRADE_COMPARE(*a.find(3), 1.5f);
+    CORRADE_VERIFY(a.contains(-7));
+    CORRADE_VERIFY(!a.contains(7));
+
+    /* Mutable access */
+    *a.find(-7) = 3.5f;
+
+    const HashMap<int, float>& ca = a;
+    CORRADE_VERIFY(ca.find(-7));
+    CORRADE_COMPARE(*ca.find(-7), 3.5f);
+    CORRADE_VERIFY(!ca.find(4));
+}
+
+void HashMapTest::findString() {
+    HashMap<String, int> a;
+    a.insert("hello", 1);
+    a.insert(String{"a string that's long enough to be allocated"}, 2);
+    a.insert("", 3);
+
+    /* Lookup by a literal, a view, an owning string and a std::string */
+    CORRADE_VERIFY(a.find("hello"));
+    CORRADE_COMPARE(*a.find("hello"), 1);
+    CORRADE_VERIFY(a.find(StringView{"a string that's long enough to be allocated!"}.except(1)));
+    CORRADE_COMPARE(*a.find(StringView{"a string that's long enough to be allocated!"}.except(1)), 2);
+    CORRADE_VERIFY(a.find(String{""}));
+    CORRADE_COMPARE(*a.find(String{""}), 3);
+    CORRADE_VERIFY(a.find(std::string{"hello"}));
+    CORRADE_VERIFY(!a.find("hell"));
+    CORRADE_VERIFY(!a.find("hello!"));
+
+    /* Removing by a view */
+    CORRADE_VERIFY(a.remove(StringView{"hello"}));
+    CORRADE_VERIFY(!a.find("hello"));
+    CORRADE_COMPARE(a.size(), 2);
+}
+
+void HashMapTest::findEnumPointer() {
+    HashMap<Enum, int> a;
+    a.insert(Enum::A, 1);
+    a.insert(Enum::B, 2);
+    CORRADE_VERIFY(a.find(Enum::B));
+    CORRADE_COMPARE(*a.find(Enum::B), 2);
+
+    int data[3];
+    HashMap<const int*, int> b;
+    b.insert(data + 1, 1);
+    b.insert(data + 2, 2);
+    CORRADE_VERIFY(b.find(data + 2));
+    CORRADE_COMPARE(*b.find(data + 2), 2);
+    CORRADE_VERIFY(!b.find(data));
+}
+
+void HashMapTest::remove() {
+    HashMap<int, float> a;
+    a.insert(3, 1.5f);
+    a.insert(4, 2.5f);
+
+    CORRADE_VERIFY(a.remove(3));
+    CORRADE_COMPARE(a.size(), 1);
+    CORRADE_VERIFY(!a.find(3));
+    CORRADE_VERIFY(a.find(4));
+    CORRADE_VERIFY(!a.remove(3));
+
+    /* Inserting again works */
+    a.insert(3, 7.0f);
+    CORRADE_VERIFY(a.find(3));
+    CORRADE_COMPARE(*a.find(3), 7.0f);
+}
+
+void HashMapTest::removeReuseSlot() {
+    /* With a bad hash everything ends up in a single probe sequence, filling
+       the first group completely, so removals from it leave tombstones */
+    HashMap<int, int, BadHash> a;
+    for(int i = 0; i != 40; i += 2) a.insert(i, i);
+    CORRADE_COMPARE(a.size(), 20);
+    const std::size_t capacity = a.capacity();
+
+    /* Repeatedly removing and inserting doesn't grow the map as the
+       tombstones either get reused or cleaned up */
+    for(int j = 0; j != 1000; ++j) {
+        CORRADE_VERIFY(a.remove(j*2 % 40));
+        a.insert(j*2 % 40, j);
+    }
+    CORRADE_COMPARE(a.size(), 20);
+    CORRADE_COMPARE(a.capacity(), capacity);
+    for(int i = 0; i != 40; i += 2) {
+        CORRADE_VERIFY(a.find(i));
+    }
+}
+
+void HashMapTest::removeIf() {
+    HashMap<int, int> a;
+    for(int i = 0; i != 100; ++i) a.insert(i, i);
+
+    CORRADE_COMPARE(a.removeIf([](const HashMapEntry<int, int>& entry) {
+        return entry.value() % 3 == 0;
+    }), 34);
+    CORRADE_COMPARE(a.size(), 66);
+    for(int i = 0; i != 100; ++i) {
+        CORRADE_COMPARE(a.contains(i), i % 3 != 0);
+    }
+}
+
+void HashMapTest::clear() {
+    HashMap<int, float> a;
+    for(int i = 0; i != 20; ++i) a.insert(i, float(i));
+    const std::size_t capacity = a.capacity();
+
+    a.clear();
+    CORRADE_VERIFY(a.isEmpty());
+    CORRADE_COMPARE(a.capacity(), capacity);
+    CORRADE_VERIFY(!a.find(3));
+    CORRADE_VERIFY(a.begin() == a.end());
+}
+
+void HashMapTest::reserve() {
+    HashMap<int, int> a;
+    a.reserve(14);
+    CORRADE_COMPARE(a.capacity(), 16);
+    a.reserve(15);
+    CORRADE_COMPARE(a.capacity(), 32);
+
+    for(int i = 0; i != 20; ++i) a.insert(i, i);
+
+    /* Reserving less does nothing */
+    a.reserve(5);
+    CORRADE_COMPARE(a.capacity(), 32);
+
+    /* Reserving more keeps the contents */
+    a.reserve(1000);
+    CORRADE_COMPARE(a.capacity(), 2048);
+    CORRADE_COMPARE(a.size(), 20);
+    for(int i = 0; i != 20; ++i) {
+        CORRADE_VERIFY(a.find(i));
+        CORRADE_COMPARE(*a.find(i), i);
+    }
+}
+
+void HashMapTest::iterate() {
+    HashMap<int, int> a;
+    for(int i = 0; i != 50; ++i) a.insert(i, i);
+    a.remove(7);
+    a.remove(33);
+
+    int keySum = 0;
+    std::size_t count = 0;
+    for(HashMapEntry<int, int>& entry: a) {
+        keySum += entry.key();
+        entry.value() *= 2;
+        ++count;
+    }
+    CORRADE_COMPARE(count, 48);
+    CORRADE_COMPARE(keySum, 49*50/2 - 7 - 33);
+
+    int valueSum = 0;
+    const HashMap<int, int>& ca = a;
+    for(const HashMapEntry<int, int>& entry: ca)
+        valueSum += entry.value();
+    CORRADE_COMPARE(valueSum, 2*keySum);
+}
+
+void HashMapTest::nonTrivial() {
+    Movable::constructed = Movable::destructed = 0;
+    {
+        HashMap<String, Movable> a;
+        for(int i = 0; i != 100; ++i)
+            a.insert(std::to_string(i), Movable{i});
+        CORRADE_VERIFY(a.find("57"));
+        CORRADE_COMPARE(a.find("57")->a, 57);
+
+        a.remove("57");
+        CORRADE_VERIFY(!a.find("57"));
+        CORRADE_COMPARE(Movable::constructed - Movable::destructed, 99);
+
+        a.clear();
+        CORRADE_COMPARE(Movable::constructed, Movable::destructed);
+
+        a.insert("a", Movable{1});
+        a.insert("b", Movable{2});
+    }
+    CORRADE_COMPARE(Movable::constructed, Movable::destructed);
+}
+
+void HashMapTest::collisions() {
+    /* All keys have just two distinct hashes, so lookups have to probe
+       through many groups */
+    HashMap<int, int, BadHash> a;
+    for(int i = 0; i != 200; ++i) a.insert(i, i*3);
+    CORRADE_COMPARE(a.size(), 200);
+    for(int i = 0; i != 200; ++i) {
+        CORRADE_VERIFY(a.find(i));
+        CORRADE_COMPARE(*a.find(i), i*3);
+    }
+    CORRADE_VERIFY(!a.find(200));
+    CORRADE_VERIFY(!a.find(201));
+
+    for(int i = 0; i != 200; i += 2) CORRADE_VERIFY(a.remove(i));
+    for(int i = 0; i != 200; ++i) {
+        CORRADE_COMPARE(a.contains(i), i % 2 == 1);
+    }
+}
+
+constexpr std::size_t BenchmarkSize = 1000;
+
+void HashMapTest::benchmarkFindStl() {
+    std::unordered_map<std::string, int> a;
+    std::string keys[BenchmarkSize];
+    for(std::size_t i = 0; i != BenchmarkSize; ++i) {
+        keys[i] = "a/path/to/a/file" + std::to_string(i) + ".cpp";
+        a.emplace(keys[i], int(i));
+    }
+
+    int sum = 0;
+    CORRADE_BENCHMARK(100)
+        for(const std::string& key: keys) sum += a.find(key)->second;
+
+    CORRADE_COMPARE(sum, 100*int(BenchmarkSize*(BenchmarkSize - 1)/2));
+}
+
+void HashMapTest::benchmarkFind() {
+    HashMap<String, int> a;
+    std::string keys[BenchmarkSize];
+    for(std::size_t i = 0; i != BenchmarkSize; ++i) {
+        keys[i] = "a/path/to/a/file" + std::to_string(i) + ".cpp";
+        a.insert(keys[i], int(i));
+    }
+
+    int sum = 0;
+    CORRADE_BENCHMARK(100)
+        for(const std::string& key: keys) sum += *a.find(key);
+
+    CORRADE_COMPARE(sum, 100*int(BenchmarkSize*(BenchmarkSize - 1)/2));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::HashMapTest)
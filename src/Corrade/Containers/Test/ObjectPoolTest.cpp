@@ -0,0 +1,350 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+#include <sstream>
+#include <vector>
+
+#include "Corrade/Containers/ObjectPool.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Numeric.h"
+#include "Corrade/Utility/DebugStl.h"
+
+#if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+#include <thread>
+#endif
+
+namespace Corrade { namespace Containers { namespace Test { namespace {
+
+struct ObjectPoolTest: TestSuite::Tester {
+    explicit ObjectPoolTest();
+
+    void construct();
+    void create();
+    void createPointer();
+    void reuse();
+    void slabs();
+    void aligned();
+    void smallerThanPointer();
+    void convertToBase();
+    void convertToBaseMultipleInheritance();
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    void releaseFromAnotherThread();
+    #endif
+    void destroyWithLiveObjects();
+
+    void benchmarkNewDelete();
+    void benchmarkPool();
+};
+
+struct Base {
+    static int destructed;
+
+    explicit Base(int a): a{a} {}
+    virtual ~Base() { ++destructed; }
+
+    virtual int value() const { return a; }
+
+    int a;
+};
+
+int Base::destructed = 0;
+
+struct Derived: Base {
+    static int destructed;
+
+    explicit Derived(int a, int b): Base{a}, b{b} {}
+    ~Derived() { ++destructed; }
+
+    int value() const override { return a + b; }
+
+    int b;
+};
+
+int Derived::destructed = 0;
+
+ObjectPoolTest::ObjectPoolTest() {
+    addTests({&ObjectPoolTest::construct,
+              &ObjectPoolTest::create,
+              &ObjectPoolTest::createPointer,
+              &ObjectPoolTest::reuse,
+              &ObjectPoolTest::slabs,
+              &ObjectPoolTest::aligned,
+              &ObjectPoolTest::smallerThanPointer,
+              &ObjectPoolTest::convertToBase,
+              &ObjectPoolTest::convertToBaseMultipleInheritance,
+              #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+              &ObjectPoolTest::releaseFromAnotherThread,
+              #endif
+              &ObjectPoolTest::destroyWithLiveObjects});
+
+    addBenchmarks({&ObjectPoolTest::benchmarkNewDelete,
+                   &ObjectPoolTest::benchmarkPool}, 10);
+}
+
+void ObjectPoolTest::construct() {
+    ObjectPool<Derived> pool;
+    CORRADE_COMPARE(pool.slabCount(), 0);
+    CORRADE_COMPARE(pool.usedCount(), 0);
+    /* 64 kB minus the header, divided by the slot size */
+    CORRADE_COMPARE_AS(pool.slabCapacity(), 65536/sizeof(Derived) - 1,
+        TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(pool.slabCapacity(), 65536/sizeof(Derived),
+        TestSuite::Compare::Less);
+
+    CORRADE_VERIFY(!std::is_copy_constructible<ObjectPool<Derived>>::value);
+    CORRADE_VERIFY(!std::is_copy_assignable<ObjectPool<Derived>>::value);
+}
+
+void ObjectPoolTest::create() {
+    Base::destructed = Derived::destructed = 0;
+
+    ObjectPool<Derived> pool;
+    {
+        Pointer<Derived, ObjectPoolDeleter> a = pool.create(3, 4);
+        Pointer<Derived, ObjectPoolDeleter> b = pool.create(5, 6);
+        CORRADE_COMPARE(a->value(), 7);
+        CORRADE_COMPARE(b->value(), 11);
+        CORRADE_COMPARE(pool.slabCount(), 1);
+        CORRADE_COMPARE(pool.usedCount(), 2);
+
+        /* The deleter isn't stored */
+        CORRADE_COMPARE(sizeof(a), sizeof(void*));
+    }
+
+    CORRADE_COMPARE(Derived::destructed, 2);
+    CORRADE_COMPARE(Base::destructed, 2);
+    CORRADE_COMPARE(pool.usedCount(), 0);
+    CORRADE_COMPARE(pool.slabCount(), 1);
+}
+
+void ObjectPoolTest::createPointer() {
+    ObjectPool<Derived> pool;
+    {
+        Pointer<Derived, ObjectPoolDeleter> a = pointer(pool, 3, 4);
+        CORRADE_COMPARE(a->value(), 7);
+        CORRADE_COMPARE(pool.usedCount(), 1);
+    }
+    CORRADE_COMPARE(pool.usedCount(), 0);
+}
+
+void ObjectPoolTest::reuse() {
+    ObjectPool<Derived> pool;
+
+    Pointer<Derived, ObjectPoolDeleter> a = pool.create(1, 2);
+    Pointer<Derived, ObjectPoolDeleter> b = pool.create(3, 4);
+    Derived* const aAddress = a.get();
+    Derived* const bAddress = b.get();
+
+    /* The most recently released slot gets reused first */
+    a = nullptr;
+    b = nullptr;
+    Pointer<Derived, ObjectPoolDeleter> c = pool.create(5, 6);
+    Pointer<Derived, ObjectPoolDeleter> d = pool.create(7, 8);
+    CORRADE_COMPARE(c.get(), bAddress);
+    CORRADE_COMPARE(d.get(), aAddress);
+    CORRADE_COMPARE(c->value(), 11);
+    CORRADE_COMPARE(d->value(), 15);
+    CORRADE_COMPARE(pool.usedCount(), 2);
+}
+
+void ObjectPoolTest::slabs() {
+    ObjectPool<Derived> pool;
+    const std::size_t capacity = pool.slabCapacity();
+
+    std::vector<Pointer<Derived, ObjectPoolDeleter>> objects;
+    for(std::size_t i = 0; i != capacity; ++i)
+        objects.push_back(pool.create(int(i), 0));
+    CORRADE_COMPARE(pool.slabCount(), 1);
+
+    /* Another slab gets allocated when the first is full */
+    objects.push_back(pool.create(0, 0));
+    CORRADE_COMPARE(pool.slabCount(), 2);
+    CORRADE_COMPARE(pool.usedCount(), capacity + 1);
+
+    for(std::size_t i = 0; i != capacity; ++i)
+        CORRADE_COMPARE(objects[i]->value(), int(i));
+
+    /* Releasing and creating the objects again doesn't allocate any new
+       slab */
+    objects.clear();
+    CORRADE_COMPARE(pool.usedCount(), 0);
+    for(std::size_t i = 0; i != capacity + 1; ++i)
+        objects.push_back(pool.create(0, 0));
+    CORRADE_COMPARE(pool.slabCount(), 2);
+}
+
+void ObjectPoolTest::aligned() {
+    struct CORRADE_ALIGNAS(64) Aligned {
+        char a;
+    };
+
+    ObjectPool<Aligned> pool;
+    Pointer<Aligned, ObjectPoolDeleter> a = pool.create();
+    Pointer<Aligned, ObjectPoolDeleter> b = pool.create();
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(a.get()) % 64, 0);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(b.get()) % 64, 0);
+    CORRADE_COMPARE(reinterpret_cast<char*>(b.get()) - reinterpret_cast<char*>(a.get()), 64);
+}
+
+void ObjectPoolTest::smallerThanPointer() {
+    ObjectPool<char> pool;
+    {
+        Pointer<char, ObjectPoolDeleter> a = pool.create('a');
+        Pointer<char, ObjectPoolDeleter> b = pool.create('b');
+        /* Slots are large enough to hold the free list pointer */
+        CORRADE_COMPARE(std::size_t(b.get() - a.get()), sizeof(void*));
+        CORRADE_COMPARE(*a, 'a');
+        CORRADE_COMPARE(*b, 'b');
+    }
+    CORRADE_COMPARE(pool.usedCount(), 0);
+}
+
+void ObjectPoolTest::convertToBase() {
+    Base::destructed = Derived::destructed = 0;
+
+    ObjectPool<Derived> pool;
+    {
+        Pointer<Base, ObjectPoolDeleter> a = pool.create(3, 4);
+        CORRADE_COMPARE(a->value(), 7);
+        CORRADE_COMPARE(pool.usedCount(), 1);
+    }
+
+    /* Destroyed through the virtual destructor and returned to the right
+       pool */
+    CORRADE_COMPARE(Derived::destructed, 1);
+    CORRADE_COMPARE(Base::destructed, 1);
+    CORRADE_COMPARE(pool.usedCount(), 0);
+}
+
+void ObjectPoolTest::convertToBaseMultipleInheritance() {
+    struct Other {
+        virtual ~Other() = default;
+        int c = 1337;
+    };
+
+    struct Multiple: Other, Derived {
+        explicit Multiple(int a, int b): Derived{a, b} {}
+    };
+
+    Base::destructed = Derived::destructed = 0;
+
+    ObjectPool<Multiple> pool;
+    {
+        Pointer<Multiple, ObjectPoolDeleter> a = pool.create(3, 4);
+        Multiple* const address = a.get();
+
+        /* The base is not at the start of the slot, which is handled */
+        Pointer<Base, ObjectPoolDeleter> b = std::move(a);
+        CORRADE_VERIFY(static_cast<void*>(b.get()) != static_cast<void*>(address));
+        CORRADE_COMPARE(b->value(), 7);
+    }
+    CORRADE_COMPARE(Derived::destructed, 1);
+    CORRADE_COMPARE(pool.usedCount(), 0);
+
+    /* The slot is reused */
+    Pointer<Multiple, ObjectPoolDeleter> c = pool.create(1, 2);
+    CORRADE_COMPARE(c->c, 1337);
+    CORRADE_COMPARE(pool.slabCount(), 1);
+}
+
+#if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+void ObjectPoolTest::releaseFromAnotherThread() {
+    Base::destructed = Derived::destructed = 0;
+
+    ObjectPool<Derived> pool;
+    std::vector<Pointer<Derived, ObjectPoolDeleter>> objects;
+    for(int i = 0; i != 1000; ++i) objects.push_back(pool.create(i, 0));
+    Derived* const first = objects.front().get();
+
+    std::thread thread{[&objects]{
+        objects.clear();
+    }};
+    thread.join();
+
+    /* The objects are destroyed right away, their slots are returned to the
+       local free list once the owner thread asks */
+    CORRADE_COMPARE(Derived::destructed, 1000);
+    CORRADE_COMPARE(pool.usedCount(), 0);
+
+    /* The slots get reused. The remote stack is reversed when moved to the
+       local free list, so the first released is the first taken. */
+    Pointer<Derived, ObjectPoolDeleter> a = pool.create(0, 0);
+    CORRADE_COMPARE(a.get(), first);
+    CORRADE_COMPARE(pool.slabCount(), 1);
+}
+#endif
+
+void ObjectPoolTest::destroyWithLiveObjects() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Pointer<Derived, ObjectPoolDeleter> a;
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        ObjectPool<Derived> pool;
+        a = pool.create(1, 2);
+    }
+    /* The memory is gone, so don't let the pointer destruct it */
+    a.release();
+    CORRADE_COMPARE(out.str(), "Containers::ObjectPool: destroyed with 1 objects still alive\n");
+}
+
+void ObjectPoolTest::benchmarkNewDelete() {
+    std::vector<Pointer<Base>> objects(1000);
+
+    int sum = 0;
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != objects.size(); ++i)
+            objects[i] = Pointer<Base>{new Derived{int(i), 1}};
+        for(std::size_t i = 0; i != objects.size(); i += 2)
+            sum += objects[i]->value();
+        for(Pointer<Base>& object: objects)
+            object = nullptr;
+    }
+
+    CORRADE_COMPARE(sum, 10*500*500);
+}
+
+void ObjectPoolTest::benchmarkPool() {
+    ObjectPool<Derived> pool;
+    std::vector<Pointer<Base, ObjectPoolDeleter>> objects(1000);
+
+    int sum = 0;
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != objects.size(); ++i)
+            objects[i] = pool.create(int(i), 1);
+        for(std::size_t i = 0; i != objects.size(); i += 2)
+            sum += objects[i]->value();
+        for(Pointer<Base, ObjectPoolDeleter>& object: objects)
+            object = nullptr;
+    }
+
+    CORRADE_COMPARE(sum, 10*500*500);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::ObjectPoolTest)
@@ -56,6 +56,12 @@ struct MaybePtr {
     int* a;
 };
 
+struct Index {
+    unsigned int value;
+};
+
+bool operator==(const Index& a, const Index& b) { return a.value == b.value; }
+
 }
 
 namespace Corrade { namespace Containers {
@@ -92,6 +98,11 @@ template<> struct DeducedOptionalConverter<MaybePtr>: OptionalConverter<int*, Ma
 
 }
 
+template<> struct OptionalSentinel<Index> {
+    static Index value() { return Index{~0u}; }
+    static bool isEmpty(const Index& value) { return value.value == ~0u; }
+};
+
 namespace Test { namespace {
 
 struct OptionalTest: TestSuite::Tester {
@@ -149,6 +160,10 @@ struct OptionalTest: TestSuite::Tester {
     void debug();
 
     void vectorOfMovableOptional();
+
+    void trivial();
+    void sentinel();
+    void sentinelInvalid();
 };
 
 OptionalTest::OptionalTest() {
@@ -202,7 +217,11 @@ OptionalTest::OptionalTest() {
 
               &OptionalTest::debug,
 
-              &OptionalTest::vectorOfMovableOptional});
+              &OptionalTest::vectorOfMovableOptional,
+
+              &OptionalTest::trivial,
+              &OptionalTest::sentinel,
+              &OptionalTest::sentinelInvalid});
 }
 
 void OptionalTest::nullOptNoDefaultConstructor() {
@@ -968,6 +987,75 @@ void OptionalTest::vectorOfMovableOptional() {
     CORRADE_COMPARE(vec[3]->a, 67);
 }
 
+void OptionalTest::trivial() {
+    #ifdef CORRADE_STD_IS_TRIVIALLY_TRAITS_SUPPORTED
+    CORRADE_VERIFY(std::is_trivially_copyable<Optional<int>>::value);
+    CORRADE_VERIFY(std::is_trivially_destructible<Optional<int>>::value);
+    CORRADE_VERIFY(!std::is_trivially_copyable<Optional<Copyable>>::value);
+    CORRADE_VERIFY(!std::is_trivially_destructible<Optional<Copyable>>::value);
+    #endif
+
+    Optional<int> a{5};
+    Optional<int> b{a};
+    Optional<int> c;
+    CORRADE_COMPARE(b, 5);
+    b = c;
+    CORRADE_VERIFY(!b);
+    c = a;
+    CORRADE_COMPARE(c, 5);
+    c = NullOpt;
+    CORRADE_VERIFY(!c);
+    CORRADE_COMPARE(c.emplace(7), 7);
+    CORRADE_COMPARE(c, 7);
+}
+
+void OptionalTest::sentinel() {
+    CORRADE_COMPARE(sizeof(Optional<Index>), sizeof(Index));
+    #ifdef CORRADE_STD_IS_TRIVIALLY_TRAITS_SUPPORTED
+    CORRADE_VERIFY(std::is_trivially_copyable<Optional<Index>>::value);
+    #endif
+
+    Optional<Index> a;
+    CORRADE_VERIFY(!a);
+    CORRADE_VERIFY(a == NullOpt);
+
+    Optional<Index> b{Index{3}};
+    CORRADE_VERIFY(b);
+    CORRADE_COMPARE(b->value, 3);
+
+    Optional<Index> c{InPlaceInit, 5u};
+    CORRADE_COMPARE(c->value, 5);
+
+    a = b;
+    CORRADE_VERIFY(a);
+    CORRADE_COMPARE(a->value, 3);
+
+    a = NullOpt;
+    CORRADE_VERIFY(!a);
+    CORRADE_VERIFY(a != b);
+
+    a.emplace(Index{7});
+    CORRADE_COMPARE(a->value, 7);
+
+    Optional<Index> d{std::move(a)};
+    CORRADE_COMPARE(d->value, 7);
+}
+
+void OptionalTest::sentinelInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Optional<Index> a{Index{~0u}};
+    Optional<Index> b;
+    b.emplace(Index{~0u});
+    CORRADE_COMPARE(out.str(),
+        "Containers::Optional: can't store the sentinel value\n"
+        "Containers::Optional: can't store the sentinel value\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Corrade::Containers::Test::OptionalTest)
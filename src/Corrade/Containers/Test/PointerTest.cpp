@@ -77,6 +77,7 @@ struct PointerTest: TestSuite::Tester {
     explicit PointerTest();
 
     void resetCounters();
+    void resetDeleterCounters();
 
     void construct();
     void constructDefault();
@@ -100,6 +101,11 @@ struct PointerTest: TestSuite::Tester {
     void emplace();
     void release();
 
+    void customDeleter();
+    void customDeleterStateless();
+    void customDeleterMove();
+    void customDeleterRelease();
+
     void cast();
 
     void debug();
@@ -132,6 +138,11 @@ PointerTest::PointerTest() {
               &PointerTest::emplace,
               &PointerTest::release}, &PointerTest::resetCounters, &PointerTest::resetCounters);
 
+    addTests({&PointerTest::customDeleter,
+              &PointerTest::customDeleterStateless,
+              &PointerTest::customDeleterMove,
+              &PointerTest::customDeleterRelease}, &PointerTest::resetDeleterCounters, &PointerTest::resetDeleterCounters);
+
     addTests({&PointerTest::cast,
               &PointerTest::debug});
 }
@@ -491,6 +502,94 @@ void PointerTest::release() {
     CORRADE_COMPARE(Immovable::destructed, 1);
 }
 
+int DeletedCount = 0;
+int DeletedValue = 0;
+
+void deleteInt(int* pointer) {
+    ++DeletedCount;
+    DeletedValue = *pointer;
+    delete pointer;
+}
+
+struct StatelessDeleter {
+    void operator()(int* pointer) const { deleteInt(pointer); }
+};
+
+void PointerTest::resetDeleterCounters() {
+    DeletedCount = DeletedValue = 0;
+}
+
+void PointerTest::customDeleter() {
+    {
+        Pointer<int, void(*)(int*)> a{new int{42}, deleteInt};
+        CORRADE_VERIFY(a);
+        CORRADE_COMPARE(*a, 42);
+        CORRADE_VERIFY(a.deleter() == deleteInt);
+        CORRADE_COMPARE(DeletedCount, 0);
+
+        /* The deleter isn't called for a null pointer */
+        Pointer<int, void(*)(int*)> b{nullptr, deleteInt};
+        CORRADE_VERIFY(!b);
+    }
+
+    CORRADE_COMPARE(DeletedCount, 1);
+    CORRADE_COMPARE(DeletedValue, 42);
+}
+
+void PointerTest::customDeleterStateless() {
+    /* The deleter isn't stored */
+    CORRADE_COMPARE(sizeof(Pointer<int, StatelessDeleter>), sizeof(void*));
+    CORRADE_COMPARE(sizeof(Pointer<int, void(*)(int*)>), 2*sizeof(void*));
+
+    {
+        Pointer<int, StatelessDeleter> a{new int{13}};
+        CORRADE_COMPARE(*a, 13);
+
+        Pointer<int, StatelessDeleter> b;
+        CORRADE_VERIFY(!b);
+
+        a.reset(new int{27});
+        CORRADE_COMPARE(DeletedCount, 1);
+        CORRADE_COMPARE(DeletedValue, 13);
+        CORRADE_COMPARE(*a, 27);
+    }
+
+    CORRADE_COMPARE(DeletedCount, 2);
+    CORRADE_COMPARE(DeletedValue, 27);
+}
+
+void PointerTest::customDeleterMove() {
+    {
+        Pointer<int, StatelessDeleter> a{new int{1}};
+        Pointer<int, StatelessDeleter> b = std::move(a);
+        CORRADE_VERIFY(!a);
+        CORRADE_COMPARE(*b, 1);
+
+        Pointer<int, void(*)(int*)> c{new int{2}, deleteInt};
+        Pointer<int, void(*)(int*)> d{new int{3}, deleteInt};
+        d = std::move(c);
+        CORRADE_COMPARE(*d, 2);
+        CORRADE_COMPARE(*c, 3);
+        CORRADE_VERIFY(c.deleter() == deleteInt);
+        CORRADE_COMPARE(DeletedCount, 0);
+    }
+
+    CORRADE_COMPARE(DeletedCount, 3);
+}
+
+void PointerTest::customDeleterRelease() {
+    int* released;
+    {
+        Pointer<int, StatelessDeleter> a{new int{5}};
+        released = a.release();
+        CORRADE_VERIFY(!a);
+    }
+
+    CORRADE_COMPARE(DeletedCount, 0);
+    CORRADE_COMPARE(*released, 5);
+    delete released;
+}
+
 void PointerTest::cast() {
     struct Base {};
     struct Derived: Base {
@@ -0,0 +1,314 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+
+#include "Corrade/Containers/Pointer.h"
+#include "Corrade/Containers/RingBuffer.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Container.h"
+#include "Corrade/Utility/DebugStl.h"
+
+namespace Corrade { namespace Containers { namespace Test { namespace {
+
+struct RingBufferTest: TestSuite::Tester {
+    explicit RingBufferTest();
+
+    void constructDefault();
+    void construct();
+    void constructMove();
+
+    void pushPop();
+    void pushPopMoveOnly();
+    void wrapAround();
+    void access();
+    void accessInvalid();
+
+    void pushPopMultiple();
+    void readableWritable();
+    void produceConsumeInvalid();
+    void clear();
+};
+
+RingBufferTest::RingBufferTest() {
+    addTests({&RingBufferTest::constructDefault,
+              &RingBufferTest::construct,
+              &RingBufferTest::constructMove,
+
+              &RingBufferTest::pushPop,
+              &RingBufferTest::pushPopMoveOnly,
+              &RingBufferTest::wrapAround,
+              &RingBufferTest::access,
+              &RingBufferTest::accessInvalid,
+
+              &RingBufferTest::pushPopMultiple,
+              &RingBufferTest::readableWritable,
+              &RingBufferTest::produceConsumeInvalid,
+              &RingBufferTest::clear});
+}
+
+void RingBufferTest::constructDefault() {
+    RingBuffer<int> a;
+    CORRADE_COMPARE(a.capacity(), 0);
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_VERIFY(a.isEmpty());
+    CORRADE_VERIFY(a.isFull());
+
+    /* Batch operations should be no-ops */
+    int values[]{1, 2};
+    CORRADE_COMPARE(a.push(values), 0);
+    CORRADE_COMPARE(a.pop(values), 0);
+    CORRADE_VERIFY(a.readable().first.empty());
+    CORRADE_VERIFY(a.writable().first.empty());
+}
+
+void RingBufferTest::construct() {
+    RingBuffer<int> a{5};
+    CORRADE_COMPARE(a.capacity(), 8);
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_VERIFY(a.isEmpty());
+    CORRADE_VERIFY(!a.isFull());
+
+    RingBuffer<int> b{16};
+    CORRADE_COMPARE(b.capacity(), 16);
+}
+
+void RingBufferTest::constructMove() {
+    RingBuffer<int> a{4};
+    a.push(3);
+    a.push(7);
+
+    RingBuffer<int> b = std::move(a);
+    CORRADE_COMPARE(b.capacity(), 4);
+    CORRADE_COMPARE(b.size(), 2);
+    CORRADE_COMPARE(a.capacity(), 0);
+    CORRADE_COMPARE(a.size(), 0);
+
+    RingBuffer<int> c{16};
+    c = std::move(b);
+    CORRADE_COMPARE(c.capacity(), 4);
+    CORRADE_COMPARE(c.pop(), 3);
+    CORRADE_COMPARE(c.pop(), 7);
+    CORRADE_COMPARE(b.capacity(), 16);
+
+    CORRADE_VERIFY(!std::is_copy_constructible<RingBuffer<int>>::value);
+    CORRADE_VERIFY(!std::is_copy_assignable<RingBuffer<int>>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<RingBuffer<int>>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<RingBuffer<int>>::value);
+}
+
+void RingBufferTest::pushPop() {
+    RingBuffer<int> a{4};
+    a.push(1);
+    a.push(2);
+    a.push(3);
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_COMPARE(a.front(), 1);
+    CORRADE_COMPARE(a.back(), 3);
+
+    CORRADE_COMPARE(a.pop(), 1);
+    CORRADE_COMPARE(a.pop(), 2);
+    a.push(4);
+    a.push(5);
+    a.push(6);
+    CORRADE_VERIFY(a.isFull());
+    CORRADE_COMPARE(a.front(), 3);
+    CORRADE_COMPARE(a.back(), 6);
+
+    CORRADE_COMPARE(a.pop(), 3);
+    CORRADE_COMPARE(a.pop(), 4);
+    CORRADE_COMPARE(a.pop(), 5);
+    CORRADE_COMPARE(a.pop(), 6);
+    CORRADE_VERIFY(a.isEmpty());
+}
+
+void RingBufferTest::pushPopMoveOnly() {
+    RingBuffer<Pointer<int>> a{2};
+    a.push(Pointer<int>{new int{3}});
+    a.push(Pointer<int>{new int{5}});
+
+    Pointer<int> first = a.pop();
+    Pointer<int> second = a.pop();
+    CORRADE_VERIFY(first);
+    CORRADE_VERIFY(second);
+    CORRADE_COMPARE(*first, 3);
+    CORRADE_COMPARE(*second, 5);
+}
+
+void RingBufferTest::wrapAround() {
+    RingBuffer<int> a{4};
+    int expected = 0;
+    int next = 0;
+    /* Go around the buffer several times with varying fill levels */
+    for(int i = 0; i != 20; ++i) {
+        for(int j = 0; j != 1 + i % 3 && !a.isFull(); ++j)
+            a.push(next++);
+        for(int j = 0; j != 1 + i % 2 && !a.isEmpty(); ++j)
+            CORRADE_COMPARE(a.pop(), expected++);
+    }
+    while(!a.isEmpty())
+        CORRADE_COMPARE(a.pop(), expected++);
+    CORRADE_COMPARE(expected, next);
+}
+
+void RingBufferTest::access() {
+    RingBuffer<int> a{4};
+    a.push(1);
+    a.push(2);
+    a.push(3);
+    a.pop();
+    a.pop();
+    a.push(4);
+    a.push(5);
+
+    /* The contents wrap around here */
+    CORRADE_COMPARE(a[0], 3);
+    CORRADE_COMPARE(a[1], 4);
+    CORRADE_COMPARE(a[2], 5);
+
+    a[1] = 17;
+    a.front() = 2;
+    const RingBuffer<int>& ca = a;
+    CORRADE_COMPARE(ca[1], 17);
+    CORRADE_COMPARE(ca.front(), 2);
+    CORRADE_COMPARE(ca.back(), 5);
+}
+
+void RingBufferTest::accessInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    RingBuffer<int> a{2};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    a[0];
+    a.front();
+    a.back();
+    a.pop();
+    a.push(1);
+    a.push(2);
+    a.push(3);
+    a[2];
+    CORRADE_COMPARE(out.str(),
+        "Containers::RingBuffer::operator[](): index 0 out of range for 0 elements\n"
+        "Containers::RingBuffer::front(): buffer is empty\n"
+        "Containers::RingBuffer::back(): buffer is empty\n"
+        "Containers::RingBuffer::pop(): buffer is empty\n"
+        "Containers::RingBuffer::push(): buffer is full\n"
+        "Containers::RingBuffer::operator[](): index 2 out of range for 2 elements\n");
+}
+
+void RingBufferTest::pushPopMultiple() {
+    RingBuffer<int> a{8};
+    a.push(0);
+    a.push(0);
+    a.push(0);
+    a.push(0);
+    a.push(0);
+    a.consume(5);
+
+    /* Only 8 fit, wrapping around after 3 */
+    const int in[]{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    CORRADE_COMPARE(a.push(in), 8);
+    CORRADE_VERIFY(a.isFull());
+
+    int out[5];
+    CORRADE_COMPARE(a.pop(out), 5);
+    CORRADE_COMPARE_AS(arrayView(out),
+        arrayView({1, 2, 3, 4, 5}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(a.pop(out), 3);
+    CORRADE_COMPARE_AS(arrayView(out).prefix(3),
+        arrayView({6, 7, 8}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(a.pop(out), 0);
+}
+
+void RingBufferTest::readableWritable() {
+    RingBuffer<int> a{8};
+    for(int i = 0; i != 6; ++i) a.push(i);
+    a.consume(4);
+
+    /* Occupied part is contiguous, the free part wraps */
+    std::pair<ArrayView<int>, ArrayView<int>> readable = a.readable();
+    CORRADE_COMPARE_AS(readable.first,
+        arrayView({4, 5}),
+        TestSuite::Compare::Container);
+    CORRADE_VERIFY(readable.second.empty());
+
+    std::pair<ArrayView<int>, ArrayView<int>> writable = a.writable();
+    CORRADE_COMPARE(writable.first.size(), 2);
+    CORRADE_COMPARE(writable.second.size(), 4);
+    writable.first[0] = 6;
+    writable.first[1] = 7;
+    writable.second[0] = 8;
+    a.produce(3);
+    CORRADE_COMPARE(a.size(), 5);
+
+    /* Now the occupied part wraps */
+    readable = a.readable();
+    CORRADE_COMPARE_AS(readable.first,
+        arrayView({4, 5, 6, 7}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(readable.second,
+        arrayView({8}),
+        TestSuite::Compare::Container);
+    writable = a.writable();
+    CORRADE_COMPARE(writable.first.size(), 3);
+    CORRADE_VERIFY(writable.second.empty());
+    CORRADE_COMPARE(writable.first.data(), readable.second.data() + 1);
+}
+
+void RingBufferTest::produceConsumeInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    RingBuffer<int> a{4};
+    a.push(1);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    a.produce(4);
+    a.consume(2);
+    CORRADE_COMPARE(out.str(),
+        "Containers::RingBuffer::produce(): can't produce 4 elements with only 3 free\n"
+        "Containers::RingBuffer::consume(): can't consume 2 elements from a buffer of 1\n");
+}
+
+void RingBufferTest::clear() {
+    RingBuffer<int> a{4};
+    a.push(1);
+    a.push(2);
+    a.clear();
+    CORRADE_VERIFY(a.isEmpty());
+    CORRADE_COMPARE(a.capacity(), 4);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::RingBufferTest)
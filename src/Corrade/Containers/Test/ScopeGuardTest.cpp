@@ -37,6 +37,12 @@ struct ScopeGuardTest: TestSuite::Tester {
     void returningLambda();
     void noHandle();
     void release();
+
+    void scopeExit();
+    void scopeExitCapturingLambda();
+    void scopeExitFunction();
+    void scopeExitMove();
+    void scopeExitRelease();
 };
 
 ScopeGuardTest::ScopeGuardTest() {
@@ -45,7 +51,13 @@ ScopeGuardTest::ScopeGuardTest() {
               &ScopeGuardTest::lambda,
               &ScopeGuardTest::returningLambda,
               &ScopeGuardTest::noHandle,
-              &ScopeGuardTest::release});
+              &ScopeGuardTest::release,
+
+              &ScopeGuardTest::scopeExit,
+              &ScopeGuardTest::scopeExitCapturingLambda,
+              &ScopeGuardTest::scopeExitFunction,
+              &ScopeGuardTest::scopeExitMove,
+              &ScopeGuardTest::scopeExitRelease});
 }
 
 int fd;
@@ -94,6 +106,7 @@ void ScopeGuardTest::returningLambda() {
 }
 
 int globalThingy;
+void setGlobalThingy() { globalThingy = 3; }
 
 void ScopeGuardTest::noHandle() {
     globalThingy = 42;
@@ -114,6 +127,71 @@ void ScopeGuardTest::release() {
     CORRADE_COMPARE(v, 1.234f);
 }
 
+void ScopeGuardTest::scopeExit() {
+    globalThingy = 42;
+    {
+        auto callable = []() { globalThingy = 1337; };
+        ScopeExit<decltype(callable)> e{callable};
+        CORRADE_COMPARE(globalThingy, 42);
+    }
+    CORRADE_COMPARE(globalThingy, 1337);
+}
+
+void ScopeGuardTest::scopeExitCapturingLambda() {
+    int calls = 0;
+    float v = 0.0f;
+    {
+        /* Capturing state by reference and by value, which ScopeGuard can't
+           do */
+        const float value = 3.5f;
+        auto e = Containers::scopeExit([&calls, &v, value]() {
+            ++calls;
+            v = value;
+        });
+        CORRADE_COMPARE(calls, 0);
+    }
+    CORRADE_COMPARE(calls, 1);
+    CORRADE_COMPARE(v, 3.5f);
+}
+
+void ScopeGuardTest::scopeExitFunction() {
+    fd = 1337;
+    {
+        auto e = Containers::scopeExit([]() { closeInt(fd); });
+    }
+    CORRADE_COMPARE(fd, 42);
+
+    globalThingy = 0;
+    {
+        /* A plain function gets decayed to a function pointer */
+        auto e = Containers::scopeExit(setGlobalThingy);
+    }
+    CORRADE_COMPARE(globalThingy, 3);
+}
+
+void ScopeGuardTest::scopeExitMove() {
+    int calls = 0;
+    {
+        auto a = Containers::scopeExit([&calls]() { ++calls; });
+        {
+            auto b = std::move(a);
+            CORRADE_COMPARE(calls, 0);
+        }
+        /* Called by the moved-to instance only */
+        CORRADE_COMPARE(calls, 1);
+    }
+    CORRADE_COMPARE(calls, 1);
+}
+
+void ScopeGuardTest::scopeExitRelease() {
+    int calls = 0;
+    {
+        auto e = Containers::scopeExit([&calls]() { ++calls; });
+        e.release();
+    }
+    CORRADE_COMPARE(calls, 0);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Corrade::Containers::Test::ScopeGuardTest)
@@ -0,0 +1,362 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+
+#include "Corrade/Containers/SharedArray.h"
+#include "Corrade/Containers/StridedArrayView.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Container.h"
+#include "Corrade/Utility/DebugStl.h"
+
+namespace Corrade { namespace Containers { namespace Test { namespace {
+
+struct SharedArrayTest: TestSuite::Tester {
+    explicit SharedArrayTest();
+
+    void constructDefault();
+    void constructValueInit();
+    void constructNoInit();
+    void constructDirectInit();
+    void constructInPlaceInit();
+    void constructNonTrivial();
+    void constructArray();
+    void constructArrayCustomDeleter();
+    void constructArrayNull();
+
+    void copy();
+    void move();
+
+    void convertView();
+    void convertStridedView();
+
+    void access();
+    void accessInvalid();
+
+    void mutableViewUnique();
+    void mutableViewShared();
+    void mutableViewAdopted();
+};
+
+struct Counted {
+    static int constructed;
+    static int destructed;
+
+    /*implicit*/ Counted(int a = 0) noexcept: a{a} { ++constructed; }
+    Counted(const Counted& other) noexcept: a{other.a} { ++constructed; }
+    ~Counted() { ++destructed; }
+
+    int a;
+};
+
+int Counted::constructed = 0;
+int Counted::destructed = 0;
+
+SharedArrayTest::SharedArrayTest() {
+    addTests({&SharedArrayTest::constructDefault,
+              &SharedArrayTest::constructValueInit,
+              &SharedArrayTest::constructNoInit,
+              &SharedArrayTest::constructDirectInit,
+              &SharedArrayTest::constructInPlaceInit,
+              &SharedArrayTest::constructNonTrivial,
+              &SharedArrayTest::constructArray,
+              &SharedArrayTest::constructArrayCustomDeleter,
+              &SharedArrayTest::constructArrayNull,
+
+              &SharedArrayTest::copy,
+              &SharedArrayTest::move,
+
+              &SharedArrayTest::convertView,
+              &SharedArrayTest::convertStridedView,
+
+              &SharedArrayTest::access,
+              &SharedArrayTest::accessInvalid,
+
+              &SharedArrayTest::mutableViewUnique,
+              &SharedArrayTest::mutableViewShared,
+              &SharedArrayTest::mutableViewAdopted});
+}
+
+void SharedArrayTest::constructDefault() {
+    SharedArray<int> a;
+    SharedArray<int> b = nullptr;
+    CORRADE_VERIFY(!a.data());
+    CORRADE_VERIFY(a.empty());
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_COMPARE(a.useCount(), 0);
+    CORRADE_VERIFY(a.isUnique());
+    CORRADE_VERIFY(!b.data());
+}
+
+void SharedArrayTest::constructValueInit() {
+    SharedArray<int> a{ValueInit, 3};
+    SharedArray<int> b{3};
+    CORRADE_VERIFY(a.data());
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_COMPARE(a.useCount(), 1);
+    CORRADE_COMPARE_AS(a, arrayView({0, 0, 0}), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(b, arrayView({0, 0, 0}), TestSuite::Compare::Container);
+
+    /* Empty doesn't allocate */
+    SharedArray<int> c{ValueInit, 0};
+    CORRADE_VERIFY(!c.data());
+    CORRADE_COMPARE(c.useCount(), 0);
+}
+
+void SharedArrayTest::constructNoInit() {
+    SharedArray<int> a{NoInit, 3};
+    CORRADE_VERIFY(a.data());
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_COMPARE(a.useCount(), 1);
+}
+
+void SharedArrayTest::constructDirectInit() {
+    SharedArray<int> a{DirectInit, 3, 7};
+    CORRADE_COMPARE_AS(a, arrayView({7, 7, 7}), TestSuite::Compare::Container);
+}
+
+void SharedArrayTest::constructInPlaceInit() {
+    SharedArray<int> a{InPlaceInit, {1, 2, 3}};
+    CORRADE_COMPARE_AS(a, arrayView({1, 2, 3}), TestSuite::Compare::Container);
+}
+
+void SharedArrayTest::constructNonTrivial() {
+    Counted::constructed = Counted::destructed = 0;
+    {
+        SharedArray<Counted> a{InPlaceInit, {1, 2, 3}};
+        /* Three temporaries in the list, three copies */
+        CORRADE_COMPARE(Counted::constructed, 6);
+        CORRADE_COMPARE(Counted::destructed, 3);
+        CORRADE_COMPARE(a[2].a, 3);
+
+        SharedArray<Counted> b = a;
+        CORRADE_COMPARE(Counted::constructed, 6);
+        CORRADE_COMPARE(Counted::destructed, 3);
+    }
+
+    /* Destructed just once, with the last reference */
+    CORRADE_COMPARE(Counted::constructed, 6);
+    CORRADE_COMPARE(Counted::destructed, 6);
+}
+
+void SharedArrayTest::constructArray() {
+    Array<int> array{InPlaceInit, {3, 4, 5}};
+    const int* data = array.data();
+
+    SharedArray<int> a = std::move(array);
+    CORRADE_VERIFY(!array.data());
+    CORRADE_COMPARE(a.data(), data);
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_COMPARE(a.useCount(), 1);
+    CORRADE_COMPARE_AS(a, arrayView({3, 4, 5}), TestSuite::Compare::Container);
+}
+
+int deleterCalls = 0;
+
+void SharedArrayTest::constructArrayCustomDeleter() {
+    int data[]{1, 2};
+    deleterCalls = 0;
+    {
+        SharedArray<int> a = Array<int>{data, 2, [](int*, std::size_t size) {
+            deleterCalls += size;
+        }};
+        SharedArray<int> b = a;
+        CORRADE_COMPARE(a.data(), data);
+        CORRADE_COMPARE(b.data(), data);
+        CORRADE_COMPARE(a.useCount(), 2);
+        CORRADE_COMPARE(deleterCalls, 0);
+    }
+
+    /* Called exactly once, with the original size */
+    CORRADE_COMPARE(deleterCalls, 2);
+}
+
+void SharedArrayTest::constructArrayNull() {
+    SharedArray<int> a = Array<int>{};
+    CORRADE_VERIFY(!a.data());
+    CORRADE_COMPARE(a.useCount(), 0);
+}
+
+void SharedArrayTest::copy() {
+    SharedArray<int> a{InPlaceInit, {1, 2, 3}};
+
+    SharedArray<int> b = a;
+    CORRADE_COMPARE(b.data(), a.data());
+    CORRADE_COMPARE(b.size(), 3);
+    CORRADE_COMPARE(a.useCount(), 2);
+    CORRADE_VERIFY(!a.isUnique());
+
+    SharedArray<int> c{InPlaceInit, {5}};
+    c = b;
+    CORRADE_COMPARE(c.data(), a.data());
+    CORRADE_COMPARE(c.size(), 3);
+    CORRADE_COMPARE(a.useCount(), 3);
+
+    /* Self-assignment doesn't break anything */
+    SharedArray<int>& cRef = c;
+    c = cRef;
+    CORRADE_COMPARE(a.useCount(), 3);
+
+    {
+        SharedArray<int> d = a;
+        CORRADE_COMPARE(a.useCount(), 4);
+    }
+    CORRADE_COMPARE(a.useCount(), 3);
+}
+
+void SharedArrayTest::move() {
+    SharedArray<int> a{InPlaceInit, {1, 2, 3}};
+    const int* data = a.data();
+
+    SharedArray<int> b = std::move(a);
+    CORRADE_VERIFY(!a.data());
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_COMPARE(b.data(), data);
+    CORRADE_COMPARE(b.useCount(), 1);
+
+    SharedArray<int> c{InPlaceInit, {5}};
+    const int* cData = c.data();
+    c = std::move(b);
+    CORRADE_COMPARE(c.data(), data);
+    CORRADE_COMPARE(b.data(), cData);
+    CORRADE_COMPARE(c.useCount(), 1);
+}
+
+void SharedArrayTest::convertView() {
+    SharedArray<int> a{InPlaceInit, {1, 2, 3}};
+    const SharedArray<int> ca = a;
+
+    ArrayView<const int> view = a;
+    ArrayView<const int> cview = ca;
+    CORRADE_COMPARE(view.data(), a.data());
+    CORRADE_COMPARE(view.size(), 3);
+    CORRADE_COMPARE(cview.data(), a.data());
+
+    auto erased = arrayView(a);
+    auto cerased = arrayView(ca);
+    CORRADE_VERIFY((std::is_same<decltype(erased), ArrayView<const int>>::value));
+    CORRADE_VERIFY((std::is_same<decltype(cerased), ArrayView<const int>>::value));
+    CORRADE_COMPARE(erased.data(), a.data());
+    CORRADE_COMPARE(cerased.size(), 3);
+
+    /* Mutable views shouldn't be possible */
+    CORRADE_VERIFY((std::is_convertible<SharedArray<int>&, ArrayView<const int>>::value));
+    CORRADE_VERIFY(!(std::is_convertible<SharedArray<int>&, ArrayView<int>>::value));
+}
+
+void SharedArrayTest::convertStridedView() {
+    SharedArray<int> a{InPlaceInit, {1, 2, 3}};
+
+    StridedArrayView1D<const int> view = a;
+    CORRADE_COMPARE(view.data(), a.data());
+    CORRADE_COMPARE(view.size(), 3);
+    CORRADE_COMPARE(view.stride(), 4);
+
+    auto erased = stridedArrayView(a);
+    CORRADE_VERIFY((std::is_same<decltype(erased), StridedArrayView1D<const int>>::value));
+    CORRADE_COMPARE(erased[2], 3);
+}
+
+void SharedArrayTest::access() {
+    const SharedArray<int> a{InPlaceInit, {1, 2, 3}};
+    CORRADE_COMPARE(a.begin(), a.data());
+    CORRADE_COMPARE(a.cbegin(), a.data());
+    CORRADE_COMPARE(a.end(), a.data() + 3);
+    CORRADE_COMPARE(a.cend(), a.data() + 3);
+    CORRADE_COMPARE(a.front(), 1);
+    CORRADE_COMPARE(a.back(), 3);
+    CORRADE_COMPARE(a[1], 2);
+
+    int sum = 0;
+    for(int i: a) sum += i;
+    CORRADE_COMPARE(sum, 6);
+}
+
+void SharedArrayTest::accessInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    SharedArray<int> a{InPlaceInit, {1, 2}};
+    SharedArray<int> b{InPlaceInit, {}};
+    a[2];
+    b.front();
+    b.back();
+    CORRADE_COMPARE(out.str(),
+        "Containers::SharedArray::operator[](): index 2 out of range for 2 elements\n"
+        "Containers::SharedArray::front(): array is empty\n"
+        "Containers::SharedArray::back(): array is empty\n");
+}
+
+void SharedArrayTest::mutableViewUnique() {
+    SharedArray<int> a{InPlaceInit, {1, 2, 3}};
+    const int* data = a.data();
+
+    /* No copy is made if there's just one reference */
+    ArrayView<int> view = a.mutableView();
+    CORRADE_COMPARE(view.data(), data);
+    view[1] = 7;
+    CORRADE_COMPARE_AS(a, arrayView({1, 7, 3}), TestSuite::Compare::Container);
+}
+
+void SharedArrayTest::mutableViewShared() {
+    Counted::constructed = Counted::destructed = 0;
+    {
+        SharedArray<Counted> a{DirectInit, 3, 5};
+        SharedArray<Counted> b = a;
+        CORRADE_COMPARE(Counted::constructed, 3);
+
+        ArrayView<Counted> view = b.mutableView();
+        CORRADE_VERIFY(view.data() != a.data());
+        CORRADE_COMPARE(view.data(), b.data());
+        CORRADE_COMPARE(view.size(), 3);
+        CORRADE_COMPARE(Counted::constructed, 6);
+        CORRADE_COMPARE(a.useCount(), 1);
+        CORRADE_COMPARE(b.useCount(), 1);
+
+        view[0].a = 1;
+        CORRADE_COMPARE(a[0].a, 5);
+        CORRADE_COMPARE(b[0].a, 1);
+    }
+
+    CORRADE_COMPARE(Counted::destructed, 6);
+}
+
+void SharedArrayTest::mutableViewAdopted() {
+    Array<int> array{InPlaceInit, {3, 4, 5}};
+    const int* data = array.data();
+
+    SharedArray<int> a = std::move(array);
+    a.mutableView()[2] = 6;
+    CORRADE_COMPARE(a.data(), data);
+    CORRADE_COMPARE_AS(a, arrayView({3, 4, 6}), TestSuite::Compare::Container);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::SharedArrayTest)
@@ -0,0 +1,330 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+
+#include "Corrade/Containers/Pointer.h"
+#include "Corrade/Containers/SlotMap.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Container.h"
+#include "Corrade/Utility/DebugStl.h"
+
+namespace Corrade { namespace Containers { namespace Test { namespace {
+
+struct SlotMapTest: TestSuite::Tester {
+    explicit SlotMapTest();
+
+    void handle();
+
+    void constructDefault();
+    void constructCapacity();
+    void constructMove();
+
+    void insert();
+    void insertMoveOnly();
+    void emplace();
+    void erase();
+    void eraseLast();
+    void reuseSlot();
+    void handleFromIndex();
+    void clear();
+
+    void accessInvalid();
+};
+
+SlotMapTest::SlotMapTest() {
+    addTests({&SlotMapTest::handle,
+
+              &SlotMapTest::constructDefault,
+              &SlotMapTest::constructCapacity,
+              &SlotMapTest::constructMove,
+
+              &SlotMapTest::insert,
+              &SlotMapTest::insertMoveOnly,
+              &SlotMapTest::emplace,
+              &SlotMapTest::erase,
+              &SlotMapTest::eraseLast,
+              &SlotMapTest::reuseSlot,
+              &SlotMapTest::handleFromIndex,
+              &SlotMapTest::clear,
+
+              &SlotMapTest::accessInvalid});
+}
+
+void SlotMapTest::handle() {
+    constexpr SlotMapHandle a;
+    constexpr SlotMapHandle b{3, 7};
+    constexpr bool aValid = !!a;
+    constexpr bool bValid = !!b;
+    constexpr std::uint32_t index = b.index();
+    constexpr std::uint32_t generation = b.generation();
+    CORRADE_VERIFY(!aValid);
+    CORRADE_VERIFY(bValid);
+    CORRADE_COMPARE(index, 3);
+    CORRADE_COMPARE(generation, 7);
+
+    CORRADE_VERIFY(b == (SlotMapHandle{3, 7}));
+    CORRADE_VERIFY(b != (SlotMapHandle{3, 9}));
+    CORRADE_VERIFY(b != (SlotMapHandle{4, 7}));
+    CORRADE_VERIFY(a != b);
+}
+
+void SlotMapTest::constructDefault() {
+    SlotMap<int> a;
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_VERIFY(a.isEmpty());
+    CORRADE_VERIFY(!a.values().data());
+    CORRADE_VERIFY(!a.contains({}));
+    CORRADE_VERIFY(!a.contains(SlotMapHandle{0, 1}));
+    CORRADE_VERIFY(!a.find({}));
+}
+
+void SlotMapTest::constructCapacity() {
+    SlotMap<int> a{16};
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_VERIFY(a.isEmpty());
+
+    /* The memory is reserved upfront */
+    a.insert(1);
+    const int* data = a.values().data();
+    for(int i = 0; i != 15; ++i) a.insert(i);
+    CORRADE_COMPARE(a.values().data(), data);
+}
+
+void SlotMapTest::constructMove() {
+    SlotMap<int> a;
+    SlotMapHandle handle = a.insert(42);
+    a.erase(a.insert(3));
+
+    SlotMap<int> b{std::move(a)};
+    CORRADE_VERIFY(a.isEmpty());
+    CORRADE_VERIFY(!a.contains(handle));
+    CORRADE_COMPARE(b.size(), 1);
+    CORRADE_VERIFY(b.contains(handle));
+    CORRADE_COMPARE(b[handle], 42);
+
+    /* The free list got transferred as well */
+    SlotMapHandle reused = b.insert(5);
+    CORRADE_COMPARE(reused.index(), 1);
+
+    SlotMap<int> c;
+    c.insert(1337);
+    c = std::move(b);
+    CORRADE_COMPARE(c.size(), 2);
+    CORRADE_COMPARE(c[handle], 42);
+    CORRADE_COMPARE(c[reused], 5);
+    CORRADE_COMPARE(b.size(), 1);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<SlotMap<int>>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<SlotMap<int>>::value);
+    CORRADE_VERIFY(!std::is_copy_constructible<SlotMap<int>>::value);
+    CORRADE_VERIFY(!std::is_copy_assignable<SlotMap<int>>::value);
+}
+
+void SlotMapTest::insert() {
+    SlotMap<int> a;
+    SlotMapHandle h1 = a.insert(10);
+    SlotMapHandle h2 = a.insert(20);
+    const int value = 30;
+    SlotMapHandle h3 = a.insert(value);
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_VERIFY(!a.isEmpty());
+    CORRADE_VERIFY(h1 != h2);
+    CORRADE_VERIFY(h2 != h3);
+
+    CORRADE_VERIFY(a.contains(h1));
+    CORRADE_VERIFY(a.contains(h2));
+    CORRADE_VERIFY(a.contains(h3));
+    CORRADE_COMPARE(a[h1], 10);
+    CORRADE_COMPARE(a[h2], 20);
+    CORRADE_COMPARE(a[h3], 30);
+    CORRADE_VERIFY(a.find(h2));
+    CORRADE_COMPARE(*a.find(h2), 20);
+
+    const SlotMap<int>& ca = a;
+    CORRADE_COMPARE(ca[h3], 30);
+    CORRADE_COMPARE(*ca.find(h1), 10);
+
+    /* The values are dense, in insertion order if nothing got erased */
+    CORRADE_COMPARE_AS(a.values(), Containers::arrayView({10, 20, 30}),
+        TestSuite::Compare::Container);
+
+    int sum = 0;
+    for(int& i: a) sum += i;
+    CORRADE_COMPARE(sum, 60);
+}
+
+void SlotMapTest::insertMoveOnly() {
+    SlotMap<Pointer<int>> a;
+    SlotMapHandle h1 = a.insert(Pointer<int>{new int{1}});
+    SlotMapHandle h2 = a.emplace(new int{2});
+    SlotMapHandle h3 = a.insert(Pointer<int>{new int{3}});
+
+    /* Erasing moves the last element into the hole */
+    a.erase(h1);
+    CORRADE_COMPARE(a.size(), 2);
+    CORRADE_COMPARE(*a[h2], 2);
+    CORRADE_COMPARE(*a[h3], 3);
+    CORRADE_COMPARE(*a.values()[0], 3);
+}
+
+void SlotMapTest::emplace() {
+    struct Foo {
+        explicit Foo(int a, int b): a{a}, b{b} {}
+        int a, b;
+    };
+
+    SlotMap<Foo> a;
+    SlotMapHandle handle = a.emplace(3, 4);
+    CORRADE_COMPARE(a[handle].a, 3);
+    CORRADE_COMPARE(a[handle].b, 4);
+}
+
+void SlotMapTest::erase() {
+    SlotMap<int> a;
+    SlotMapHandle h1 = a.insert(10);
+    SlotMapHandle h2 = a.insert(20);
+    SlotMapHandle h3 = a.insert(30);
+    SlotMapHandle h4 = a.insert(40);
+
+    a.erase(h2);
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_VERIFY(!a.contains(h2));
+    CORRADE_VERIFY(!a.find(h2));
+
+    /* The last element got moved into the hole, other handles still work */
+    CORRADE_COMPARE_AS(a.values(), Containers::arrayView({10, 40, 30}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(a[h1], 10);
+    CORRADE_COMPARE(a[h3], 30);
+    CORRADE_COMPARE(a[h4], 40);
+
+    a.erase(h1);
+    a.erase(h4);
+    CORRADE_COMPARE(a.size(), 1);
+    CORRADE_COMPARE(a[h3], 30);
+    CORRADE_COMPARE_AS(a.values(), Containers::arrayView({30}),
+        TestSuite::Compare::Container);
+
+    a.erase(h3);
+    CORRADE_VERIFY(a.isEmpty());
+}
+
+void SlotMapTest::eraseLast() {
+    SlotMap<int> a;
+    SlotMapHandle h1 = a.insert(10);
+    SlotMapHandle h2 = a.insert(20);
+
+    /* Nothing to move in this case */
+    a.erase(h2);
+    CORRADE_COMPARE(a.size(), 1);
+    CORRADE_COMPARE(a[h1], 10);
+    CORRADE_VERIFY(!a.contains(h2));
+}
+
+void SlotMapTest::reuseSlot() {
+    SlotMap<int> a;
+    SlotMapHandle h1 = a.insert(10);
+    SlotMapHandle h2 = a.insert(20);
+    a.erase(h1);
+    a.erase(h2);
+
+    /* The slots are reused in LIFO order with a new generation, the stale
+       handles don't alias the new elements */
+    SlotMapHandle h3 = a.insert(30);
+    SlotMapHandle h4 = a.insert(40);
+    SlotMapHandle h5 = a.insert(50);
+    CORRADE_COMPARE(h3.index(), h2.index());
+    CORRADE_COMPARE(h4.index(), h1.index());
+    CORRADE_COMPARE(h5.index(), 2);
+    CORRADE_VERIFY(h3 != h2);
+    CORRADE_VERIFY(h4 != h1);
+    CORRADE_VERIFY(!a.contains(h1));
+    CORRADE_VERIFY(!a.contains(h2));
+    CORRADE_COMPARE(a[h3], 30);
+    CORRADE_COMPARE(a[h4], 40);
+    CORRADE_COMPARE(a[h5], 50);
+}
+
+void SlotMapTest::handleFromIndex() {
+    SlotMap<int> a;
+    SlotMapHandle h1 = a.insert(10);
+    SlotMapHandle h2 = a.insert(20);
+    SlotMapHandle h3 = a.insert(30);
+    a.erase(h1);
+
+    /* Going through the dense array and back */
+    CORRADE_COMPARE(a.values()[0], 30);
+    CORRADE_VERIFY(a.handle(0) == h3);
+    CORRADE_VERIFY(a.handle(1) == h2);
+}
+
+void SlotMapTest::clear() {
+    SlotMap<int> a;
+    SlotMapHandle h1 = a.insert(10);
+    SlotMapHandle h2 = a.insert(20);
+    a.erase(a.insert(30));
+    const int* data = a.values().data();
+
+    a.clear();
+    CORRADE_VERIFY(a.isEmpty());
+    CORRADE_VERIFY(!a.contains(h1));
+    CORRADE_VERIFY(!a.contains(h2));
+
+    /* Memory and all three slots get reused */
+    SlotMapHandle h3 = a.insert(40);
+    a.insert(50);
+    a.insert(60);
+    SlotMapHandle h4 = a.insert(70);
+    CORRADE_COMPARE(a.values().data(), data);
+    CORRADE_VERIFY(h3.index() < 3);
+    CORRADE_COMPARE(h4.index(), 3);
+    CORRADE_COMPARE(a[h3], 40);
+}
+
+void SlotMapTest::accessInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    SlotMap<int> a;
+    SlotMapHandle handle = a.insert(3);
+    a.erase(handle);
+    a.insert(5);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    a[handle];
+    a.erase(handle);
+    a.handle(1);
+    CORRADE_COMPARE(out.str(),
+        "Containers::SlotMap::operator[](): invalid handle 0 1\n"
+        "Containers::SlotMap::erase(): invalid handle 0 1\n"
+        "Containers::SlotMap::handle(): index 1 out of range for 1 elements\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::SlotMapTest)
@@ -0,0 +1,451 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <string>
+
+#include "Corrade/Containers/SmallArray.h"
+#include "Corrade/Containers/StridedArrayView.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/Utility/DebugStl.h"
+
+namespace Corrade { namespace Containers { namespace Test { namespace {
+
+struct SmallArrayTest: TestSuite::Tester {
+    explicit SmallArrayTest();
+
+    void constructDefault();
+    void constructInitializerList();
+    void constructInitializerListSpill();
+    void constructMoveInline();
+    void constructMoveHeap();
+    void moveAssign();
+
+    void convertView();
+    void convertViewConst();
+    void convertStridedView();
+
+    void appendInline();
+    void appendSpill();
+    void appendListInline();
+    void appendListSpill();
+    void appendNonTrivial();
+    void appendItself();
+
+    void reserve();
+    void removeSuffix();
+    void clear();
+
+    void access();
+    void accessInvalid();
+    void removeSuffixInvalid();
+};
+
+struct Movable {
+    static int constructed;
+    static int destructed;
+
+    /*implicit*/ Movable(int a = 0) noexcept: a{a} { ++constructed; }
+    Movable(const Movable&) = delete;
+    Movable(Movable&& other) noexcept: a(other.a) { ++constructed; }
+    ~Movable() { ++destructed; }
+    Movable& operator=(const Movable&) = delete;
+    Movable& operator=(Movable&&) = delete;
+
+    int a;
+};
+
+int Movable::constructed = 0;
+int Movable::destructed = 0;
+
+SmallArrayTest::SmallArrayTest() {
+    addTests({&SmallArrayTest::constructDefault,
+              &SmallArrayTest::constructInitializerList,
+              &SmallArrayTest::constructInitializerListSpill,
+              &SmallArrayTest::constructMoveInline,
+              &SmallArrayTest::constructMoveHeap,
+              &SmallArrayTest::moveAssign,
+
+              &SmallArrayTest::convertView,
+              &SmallArrayTest::convertViewConst,
+              &SmallArrayTest::convertStridedView,
+
+              &SmallArrayTest::appendInline,
+              &SmallArrayTest::appendSpill,
+              &SmallArrayTest::appendListInline,
+              &SmallArrayTest::appendListSpill,
+              &SmallArrayTest::appendNonTrivial,
+              &SmallArrayTest::appendItself,
+
+              &SmallArrayTest::reserve,
+              &SmallArrayTest::removeSuffix,
+              &SmallArrayTest::clear,
+
+              &SmallArrayTest::access,
+              &SmallArrayTest::accessInvalid,
+              &SmallArrayTest::removeSuffixInvalid});
+}
+
+void SmallArrayTest::constructDefault() {
+    SmallArray<4, int> a;
+    CORRADE_VERIFY(a.isInline());
+    CORRADE_VERIFY(a.empty());
+    CORRADE_VERIFY(a.data());
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_COMPARE(a.capacity(), 4);
+    CORRADE_COMPARE(a.begin(), a.end());
+    CORRADE_COMPARE(std::size_t(SmallArray<4, int>::InlineCapacity), 4);
+
+    CORRADE_VERIFY((std::is_nothrow_default_constructible<SmallArray<4, int>>::value));
+    CORRADE_VERIFY(!(std::is_copy_constructible<SmallArray<4, int>>::value));
+    CORRADE_VERIFY(!(std::is_copy_assignable<SmallArray<4, int>>::value));
+}
+
+void SmallArrayTest::constructInitializerList() {
+    SmallArray<4, int> a{1, 2, 3};
+    CORRADE_VERIFY(a.isInline());
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_COMPARE(a[0], 1);
+    CORRADE_COMPARE(a[1], 2);
+    CORRADE_COMPARE(a[2], 3);
+}
+
+void SmallArrayTest::constructInitializerListSpill() {
+    SmallArray<2, int> a{1, 2, 3};
+    CORRADE_VERIFY(!a.isInline());
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_VERIFY(a.capacity() >= 3);
+    CORRADE_COMPARE(a[0], 1);
+    CORRADE_COMPARE(a[1], 2);
+    CORRADE_COMPARE(a[2], 3);
+}
+
+void SmallArrayTest::constructMoveInline() {
+    Movable::constructed = Movable::destructed = 0;
+
+    {
+        SmallArray<4, Movable> a;
+        a.append(Movable{1});
+        a.append(InPlaceInit, 2);
+
+        SmallArray<4, Movable> b{std::move(a)};
+        CORRADE_VERIFY(a.isInline());
+        CORRADE_VERIFY(a.empty());
+        CORRADE_VERIFY(b.isInline());
+        CORRADE_COMPARE(b.size(), 2);
+        CORRADE_COMPARE(b[0].a, 1);
+        CORRADE_COMPARE(b[1].a, 2);
+
+        /* The moved-from elements got destroyed */
+        CORRADE_COMPARE(Movable::constructed, 5);
+        CORRADE_COMPARE(Movable::destructed, 3);
+    }
+
+    CORRADE_COMPARE(Movable::constructed, 5);
+    CORRADE_COMPARE(Movable::destructed, 5);
+
+    CORRADE_VERIFY((std::is_nothrow_move_constructible<SmallArray<4, int>>::value));
+    CORRADE_VERIFY((std::is_nothrow_move_assignable<SmallArray<4, int>>::value));
+}
+
+void SmallArrayTest::constructMoveHeap() {
+    SmallArray<2, int> a{1, 2, 3};
+    const int* data = a.data();
+
+    /* The heap allocation is just taken over */
+    SmallArray<2, int> b{std::move(a)};
+    CORRADE_VERIFY(a.isInline());
+    CORRADE_VERIFY(a.empty());
+    CORRADE_VERIFY(!b.isInline());
+    CORRADE_COMPARE(b.data(), data);
+    CORRADE_COMPARE(b.size(), 3);
+    CORRADE_COMPARE(b[2], 3);
+}
+
+void SmallArrayTest::moveAssign() {
+    SmallArray<2, int> a{1, 2, 3};
+    SmallArray<2, int> b{4};
+    b = std::move(a);
+    CORRADE_VERIFY(a.empty());
+    CORRADE_VERIFY(!b.isInline());
+    CORRADE_COMPARE(b.size(), 3);
+    CORRADE_COMPARE(b[0], 1);
+
+    SmallArray<2, int> c{5, 6};
+    b = std::move(c);
+    CORRADE_VERIFY(c.empty());
+    CORRADE_VERIFY(b.isInline());
+    CORRADE_COMPARE(b.size(), 2);
+    CORRADE_COMPARE(b[0], 5);
+    CORRADE_COMPARE(b[1], 6);
+}
+
+void SmallArrayTest::convertView() {
+    SmallArray<4, int> a{1, 2};
+    ArrayView<int> b = a;
+    CORRADE_COMPARE(b.data(), a.data());
+    CORRADE_COMPARE(b.size(), 2);
+
+    auto c = arrayView(a);
+    CORRADE_VERIFY((std::is_same<decltype(c), ArrayView<int>>::value));
+    CORRADE_COMPARE(c.data(), a.data());
+    CORRADE_COMPARE(c.size(), 2);
+
+    /* After spilling to the heap the view points elsewhere */
+    a.append({3, 4, 5});
+    ArrayView<int> d = a;
+    CORRADE_VERIFY(!a.isInline());
+    CORRADE_COMPARE(d.data(), a.data());
+    CORRADE_COMPARE(d.size(), 5);
+}
+
+void SmallArrayTest::convertViewConst() {
+    const SmallArray<4, int> a{1, 2};
+    ArrayView<const int> b = a;
+    CORRADE_COMPARE(b.data(), a.data());
+    CORRADE_COMPARE(b.size(), 2);
+
+    auto c = arrayView(a);
+    CORRADE_VERIFY((std::is_same<decltype(c), ArrayView<const int>>::value));
+    CORRADE_COMPARE(c.size(), 2);
+
+    /* Mutable view from a const array shouldn't be possible */
+    CORRADE_VERIFY(!(std::is_convertible<const SmallArray<4, int>&, ArrayView<int>>::value));
+}
+
+void SmallArrayTest::convertStridedView() {
+    SmallArray<4, int> a{1, 2, 3};
+    StridedArrayView1D<int> b = a;
+    CORRADE_COMPARE(b.data(), a.data());
+    CORRADE_COMPARE(b.size(), 3);
+    CORRADE_COMPARE(b[2], 3);
+}
+
+void SmallArrayTest::appendInline() {
+    SmallArray<3, int> a;
+    a.append(1);
+    int two = 2;
+    a.append(two);
+    a.append(InPlaceInit, 3);
+    CORRADE_VERIFY(a.isInline());
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_COMPARE(a.capacity(), 3);
+    CORRADE_COMPARE(a[0], 1);
+    CORRADE_COMPARE(a[1], 2);
+    CORRADE_COMPARE(a[2], 3);
+}
+
+void SmallArrayTest::appendSpill() {
+    SmallArray<2, int> a;
+    a.append(1);
+    a.append(2);
+    CORRADE_VERIFY(a.isInline());
+
+    a.append(3);
+    CORRADE_VERIFY(!a.isInline());
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_VERIFY(a.capacity() >= 3);
+    CORRADE_COMPARE(a[0], 1);
+    CORRADE_COMPARE(a[1], 2);
+    CORRADE_COMPARE(a[2], 3);
+
+    /* Further appends go to the heap allocation */
+    for(int i = 4; i != 100; ++i) a.append(i);
+    CORRADE_COMPARE(a.size(), 99);
+    CORRADE_COMPARE(a.back(), 99);
+}
+
+void SmallArrayTest::appendListInline() {
+    SmallArray<4, int> a{1};
+    a.append({2, 3, 4});
+    CORRADE_VERIFY(a.isInline());
+    CORRADE_COMPARE(a.size(), 4);
+    CORRADE_COMPARE(a.back(), 4);
+}
+
+void SmallArrayTest::appendListSpill() {
+    SmallArray<4, int> a{1, 2};
+    const int data[]{3, 4, 5};
+    a.append(data);
+    CORRADE_VERIFY(!a.isInline());
+    CORRADE_COMPARE(a.size(), 5);
+    CORRADE_COMPARE(a[0], 1);
+    CORRADE_COMPARE(a[1], 2);
+    CORRADE_COMPARE(a[4], 5);
+}
+
+void SmallArrayTest::appendNonTrivial() {
+    Movable::constructed = Movable::destructed = 0;
+
+    {
+        SmallArray<2, Movable> a;
+        a.append(InPlaceInit, 1);
+        a.append(InPlaceInit, 2);
+        CORRADE_COMPARE(Movable::constructed, 2);
+        CORRADE_COMPARE(Movable::destructed, 0);
+
+        /* Spilling moves the two to the heap and destroys the originals */
+        a.append(InPlaceInit, 3);
+        CORRADE_VERIFY(!a.isInline());
+        CORRADE_COMPARE(a.size(), 3);
+        CORRADE_COMPARE(a[0].a, 1);
+        CORRADE_COMPARE(a[1].a, 2);
+        CORRADE_COMPARE(a[2].a, 3);
+        CORRADE_COMPARE(Movable::constructed, 5);
+        CORRADE_COMPARE(Movable::destructed, 2);
+    }
+
+    CORRADE_COMPARE(Movable::constructed, 5);
+    CORRADE_COMPARE(Movable::destructed, 5);
+}
+
+void SmallArrayTest::appendItself() {
+    SmallArray<2, std::string> a{"hello", "world"};
+
+    /* Spilling destroys the inline items, the new one should be copied from
+       a[0] before */
+    a.append(a[0]);
+    CORRADE_VERIFY(!a.isInline());
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_COMPARE(a[0], "hello");
+    CORRADE_COMPARE(a[1], "world");
+    CORRADE_COMPARE(a[2], "hello");
+
+    /* Growing the heap allocation moves the items away, the new one should
+       be copied from a[1] before */
+    while(a.size() < a.capacity()) a.append("!");
+    const std::size_t size = a.size();
+    a.append(a[1]);
+    CORRADE_COMPARE(a.size(), size + 1);
+    CORRADE_COMPARE(a[1], "world");
+    CORRADE_COMPARE(a.back(), "world");
+}
+
+void SmallArrayTest::reserve() {
+    SmallArray<4, int> a{1, 2};
+
+    /* Reserving less than inline capacity does nothing */
+    a.reserve(3);
+    CORRADE_VERIFY(a.isInline());
+    CORRADE_COMPARE(a.capacity(), 4);
+
+    a.reserve(10);
+    CORRADE_VERIFY(!a.isInline());
+    CORRADE_COMPARE(a.capacity(), 10);
+    CORRADE_COMPARE(a.size(), 2);
+    CORRADE_COMPARE(a[0], 1);
+    CORRADE_COMPARE(a[1], 2);
+
+    a.reserve(20);
+    CORRADE_COMPARE(a.capacity(), 20);
+}
+
+void SmallArrayTest::removeSuffix() {
+    Movable::constructed = Movable::destructed = 0;
+
+    {
+        SmallArray<4, Movable> a;
+        a.append(InPlaceInit, 1);
+        a.append(InPlaceInit, 2);
+        a.append(InPlaceInit, 3);
+        a.removeSuffix(2);
+        CORRADE_COMPARE(a.size(), 1);
+        CORRADE_COMPARE(Movable::destructed, 2);
+    }
+
+    CORRADE_COMPARE(Movable::constructed, 3);
+    CORRADE_COMPARE(Movable::destructed, 3);
+
+    SmallArray<2, int> b{1, 2, 3};
+    b.removeSuffix();
+    CORRADE_COMPARE(b.size(), 2);
+    /* It doesn't move back to the inline storage */
+    CORRADE_VERIFY(!b.isInline());
+}
+
+void SmallArrayTest::clear() {
+    SmallArray<2, int> a{1, 2, 3};
+    CORRADE_VERIFY(!a.isInline());
+
+    a.clear();
+    CORRADE_VERIFY(a.isInline());
+    CORRADE_VERIFY(a.empty());
+    CORRADE_COMPARE(a.capacity(), 2);
+}
+
+void SmallArrayTest::access() {
+    SmallArray<4, int> a{1, 2, 3};
+    CORRADE_COMPARE(a.front(), 1);
+    CORRADE_COMPARE(a.back(), 3);
+    a[1] = 5;
+    CORRADE_COMPARE(a.data()[1], 5);
+
+    const SmallArray<4, int>& ca = a;
+    CORRADE_COMPARE(ca.front(), 1);
+    CORRADE_COMPARE(ca.back(), 3);
+    CORRADE_COMPARE(ca[1], 5);
+    CORRADE_COMPARE(ca.cend() - ca.cbegin(), 3);
+
+    int sum = 0;
+    for(int i: a) sum += i;
+    CORRADE_COMPARE(sum, 9);
+}
+
+void SmallArrayTest::accessInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    SmallArray<4, int> a{1, 2};
+    const SmallArray<4, int> b;
+    a[2];
+    b.front();
+    b.back();
+    CORRADE_COMPARE(out.str(),
+        "Containers::SmallArray::operator[](): index 2 out of range for 2 elements\n"
+        "Containers::SmallArray::front(): array is empty\n"
+        "Containers::SmallArray::back(): array is empty\n");
+}
+
+void SmallArrayTest::removeSuffixInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    SmallArray<4, int> a{1, 2};
+    a.removeSuffix(3);
+    CORRADE_COMPARE(out.str(),
+        "Containers::SmallArray::removeSuffix(): can't remove 3 elements from an array of size 2\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::SmallArrayTest)
@@ -0,0 +1,116 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Corrade/Containers/StaticArray.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Container.h"
+#include "Corrade/Utility/Algorithms.h"
+
+namespace Corrade { namespace Containers { namespace Test { namespace {
+
+struct StaticArrayCpp14Test: TestSuite::Tester {
+    explicit StaticArrayCpp14Test();
+
+    void access();
+    void copy();
+    void fill();
+    void transform();
+};
+
+StaticArrayCpp14Test::StaticArrayCpp14Test() {
+    addTests({&StaticArrayCpp14Test::access,
+              &StaticArrayCpp14Test::copy,
+              &StaticArrayCpp14Test::fill,
+              &StaticArrayCpp14Test::transform});
+}
+
+constexpr StaticArray<5, int> squares() {
+    StaticArray<5, int> out{ValueInit};
+    for(std::size_t i = 0; i != out.size(); ++i)
+        out[i] = int(i*i);
+    out.front() += 100;
+    *(out.end() - 2) += 200;
+    out.back() += 300;
+    return out;
+}
+
+void StaticArrayCpp14Test::access() {
+    constexpr StaticArray<5, int> a = squares();
+    CORRADE_COMPARE_AS(arrayView(a),
+        arrayView({100, 1, 4, 209, 316}),
+        TestSuite::Compare::Container);
+
+    /* Copying a constexpr array is constexpr as well */
+    constexpr StaticArray<5, int> b = a;
+    constexpr int second = b[1];
+    CORRADE_COMPARE(second, 1);
+}
+
+constexpr StaticArray<4, int> copied() {
+    StaticArray<4, int> a{Containers::InPlaceInit, 3, 7, -1, 8};
+    StaticArray<4, int> out{ValueInit};
+    Utility::copy(staticArrayView(a), staticArrayView(out));
+    return out;
+}
+
+void StaticArrayCpp14Test::copy() {
+    constexpr StaticArray<4, int> a = copied();
+    CORRADE_COMPARE_AS(arrayView(a),
+        arrayView({3, 7, -1, 8}),
+        TestSuite::Compare::Container);
+}
+
+constexpr StaticArray<4, float> filled() {
+    StaticArray<4, float> out{ValueInit};
+    Utility::fill(staticArrayView(out).suffix<2>(), 0.5f);
+    return out;
+}
+
+void StaticArrayCpp14Test::fill() {
+    constexpr StaticArray<4, float> a = filled();
+    CORRADE_COMPARE_AS(arrayView(a),
+        arrayView({0.0f, 0.0f, 0.5f, 0.5f}),
+        TestSuite::Compare::Container);
+}
+
+constexpr int doubled(int value) { return value*2; }
+
+constexpr StaticArray<4, int> transformed() {
+    StaticArray<4, int> out{Containers::InPlaceInit, 1, 2, 3, 4};
+    Utility::transform(staticArrayView(out), staticArrayView(out), doubled);
+    return out;
+}
+
+void StaticArrayCpp14Test::transform() {
+    constexpr StaticArray<4, int> a = transformed();
+    CORRADE_COMPARE_AS(arrayView(a),
+        arrayView({2, 4, 6, 8}),
+        TestSuite::Compare::Container);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::StaticArrayCpp14Test)
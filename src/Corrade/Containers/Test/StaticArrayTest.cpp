@@ -25,6 +25,7 @@
 
 #include "Corrade/Containers/StaticArray.h"
 #include "Corrade/TestSuite/Tester.h"
+#include "Corrade/Utility/TypeTraits.h"
 
 namespace {
 
@@ -77,8 +78,10 @@ struct StaticArrayTest: TestSuite::Tester {
     void constructNonCopyable();
     void constructNoImplicitConstructor();
     void constructDirectReferences();
+    void constructConstexpr();
 
     void copy();
+    void copyTrivial();
     void move();
 
     void convertBool();
@@ -132,10 +135,15 @@ StaticArrayTest::StaticArrayTest() {
         &StaticArrayTest::resetCounters, &StaticArrayTest::resetCounters);
 
     addTests({&StaticArrayTest::constructNoImplicitConstructor,
-              &StaticArrayTest::constructDirectReferences});
+              &StaticArrayTest::constructDirectReferences,
+              &StaticArrayTest::constructConstexpr});
 
-    addTests({&StaticArrayTest::copy,
-              &StaticArrayTest::move},
+    addTests({&StaticArrayTest::copy},
+        &StaticArrayTest::resetCounters, &StaticArrayTest::resetCounters);
+
+    addTests({&StaticArrayTest::copyTrivial});
+
+    addTests({&StaticArrayTest::move},
         &StaticArrayTest::resetCounters, &StaticArrayTest::resetCounters);
 
     addTests({&StaticArrayTest::convertBool,
@@ -386,6 +394,25 @@ void StaticArrayTest::constructDirectReferences() {
     CORRADE_VERIFY(b);
 }
 
+void StaticArrayTest::constructConstexpr() {
+    constexpr Containers::StaticArray<3, int> a{Containers::InPlaceInit, 1, 2, 3};
+    constexpr Containers::StaticArray<3, int> b{ValueInit};
+    constexpr Containers::StaticArray<3, int> c{4, 5, 6};
+
+    constexpr int first = a.front();
+    constexpr int second = a[1];
+    constexpr int last = c.back();
+    constexpr int zero = b[2];
+    constexpr int third = a.data()[2];
+    constexpr std::size_t size = c.size();
+    CORRADE_COMPARE(first, 1);
+    CORRADE_COMPARE(second, 2);
+    CORRADE_COMPARE(last, 6);
+    CORRADE_COMPARE(zero, 0);
+    CORRADE_COMPARE(third, 3);
+    CORRADE_COMPARE(size, 3);
+}
+
 void StaticArrayTest::copy() {
     {
         Containers::StaticArray<3, Copyable> a{Containers::InPlaceInit, 1, 2, 3};
@@ -421,6 +448,31 @@ void StaticArrayTest::copy() {
 }
 
 
+void StaticArrayTest::copyTrivial() {
+    Containers::StaticArray<3, int> a{Containers::InPlaceInit, 1, 2, 3};
+
+    Containers::StaticArray<3, int> b{a};
+    CORRADE_COMPARE(b[0], 1);
+    CORRADE_COMPARE(b[1], 2);
+    CORRADE_COMPARE(b[2], 3);
+
+    Containers::StaticArray<3, int> c;
+    c = b;
+    CORRADE_COMPARE(c[0], 1);
+    CORRADE_COMPARE(c[1], 2);
+    CORRADE_COMPARE(c[2], 3);
+
+    /* Trivial types make the whole array trivial as well */
+    #ifdef CORRADE_STD_IS_TRIVIALLY_TRAITS_SUPPORTED
+    CORRADE_VERIFY((std::is_trivially_copyable<Containers::StaticArray<3, int>>::value));
+    CORRADE_VERIFY((std::is_trivially_destructible<Containers::StaticArray<3, int>>::value));
+    CORRADE_VERIFY(!(std::is_trivially_copyable<Containers::StaticArray<3, Copyable>>::value));
+    CORRADE_VERIFY(!(std::is_trivially_destructible<Containers::StaticArray<3, Copyable>>::value));
+    #endif
+    CORRADE_VERIFY((std::is_nothrow_copy_constructible<Containers::StaticArray<3, int>>::value));
+    CORRADE_VERIFY((std::is_nothrow_move_assignable<Containers::StaticArray<3, int>>::value));
+}
+
 void StaticArrayTest::move() {
     {
         Containers::StaticArray<3, Movable> a{Containers::InPlaceInit, 1, 2, 3};
@@ -0,0 +1,410 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Containers/StaticStridedArrayView.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Container.h"
+#include "Corrade/Utility/DebugStl.h"
+
+namespace Corrade { namespace Containers { namespace Test { namespace {
+
+struct StaticStridedArrayViewTest: TestSuite::Tester {
+    explicit StaticStridedArrayViewTest();
+
+    void constructDefault();
+    void constructNullptr();
+    void construct();
+    void constructNegativeStride();
+    void constructZeroStride();
+    void constructInvalid();
+    void constructArrayView();
+    void constructConst();
+
+    void convertStrided();
+    void convertStridedInvalid();
+    void convertToStrided();
+    void convertToStridedNegative();
+
+    void access();
+    void accessInvalid();
+    void iterator();
+    void iteratorNegativeStride();
+    void rangeBasedFor();
+
+    void slice();
+    void sliceInvalid();
+
+    void benchmarkRuntimeStride();
+    void benchmarkStaticStride();
+};
+
+struct Vertex {
+    float position[3];
+    int id;
+    float weights[4];
+};
+
+static_assert(sizeof(Vertex) == 32, "unexpected vertex size");
+
+typedef StaticStridedArrayView<32, int> IdView;
+typedef StaticStridedArrayView<32, const int> ConstIdView;
+
+StaticStridedArrayViewTest::StaticStridedArrayViewTest() {
+    addTests({&StaticStridedArrayViewTest::constructDefault,
+              &StaticStridedArrayViewTest::constructNullptr,
+              &StaticStridedArrayViewTest::construct,
+              &StaticStridedArrayViewTest::constructNegativeStride,
+              &StaticStridedArrayViewTest::constructZeroStride,
+              &StaticStridedArrayViewTest::constructInvalid,
+              &StaticStridedArrayViewTest::constructArrayView,
+              &StaticStridedArrayViewTest::constructConst,
+
+              &StaticStridedArrayViewTest::convertStrided,
+              &StaticStridedArrayViewTest::convertStridedInvalid,
+              &StaticStridedArrayViewTest::convertToStrided,
+              &StaticStridedArrayViewTest::convertToStridedNegative,
+
+              &StaticStridedArrayViewTest::access,
+              &StaticStridedArrayViewTest::accessInvalid,
+              &StaticStridedArrayViewTest::iterator,
+              &StaticStridedArrayViewTest::iteratorNegativeStride,
+              &StaticStridedArrayViewTest::rangeBasedFor,
+
+              &StaticStridedArrayViewTest::slice,
+              &StaticStridedArrayViewTest::sliceInvalid});
+
+    addBenchmarks({&StaticStridedArrayViewTest::benchmarkRuntimeStride,
+                   &StaticStridedArrayViewTest::benchmarkStaticStride}, 100);
+}
+
+void StaticStridedArrayViewTest::constructDefault() {
+    IdView a;
+    CORRADE_VERIFY(!a);
+    CORRADE_VERIFY(!a.data());
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_VERIFY(a.empty());
+    CORRADE_COMPARE(a.stride(), 32);
+    CORRADE_COMPARE(IdView::Stride, 32);
+
+    constexpr IdView ca;
+    constexpr bool empty = ca.empty();
+    constexpr std::ptrdiff_t stride = ca.stride();
+    CORRADE_VERIFY(empty);
+    CORRADE_COMPARE(stride, 32);
+}
+
+void StaticStridedArrayViewTest::constructNullptr() {
+    IdView a = nullptr;
+    CORRADE_VERIFY(!a);
+    CORRADE_COMPARE(a.size(), 0);
+}
+
+void StaticStridedArrayViewTest::construct() {
+    Vertex vertices[5]{};
+    IdView a{vertices, &vertices[0].id, 5};
+    CORRADE_VERIFY(a);
+    CORRADE_COMPARE(a.data(), static_cast<const void*>(&vertices[0].id));
+    CORRADE_COMPARE(a.size(), 5);
+    CORRADE_VERIFY(!a.empty());
+}
+
+void StaticStridedArrayViewTest::constructNegativeStride() {
+    Vertex vertices[3]{};
+    vertices[0].id = 1;
+    vertices[1].id = 2;
+    vertices[2].id = 3;
+    StaticStridedArrayView<-32, int> a{vertices, &vertices[2].id, 3};
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_COMPARE(a[0], 3);
+    CORRADE_COMPARE(a[1], 2);
+    CORRADE_COMPARE(a[2], 1);
+}
+
+void StaticStridedArrayViewTest::constructZeroStride() {
+    int value = 1337;
+    StaticStridedArrayView<0, int> a{{&value, 1}, 5};
+    CORRADE_COMPARE(a.size(), 5);
+    CORRADE_COMPARE(a[0], 1337);
+    CORRADE_COMPARE(a[4], 1337);
+}
+
+void StaticStridedArrayViewTest::constructInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Vertex vertices[3]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    IdView{vertices, &vertices[0].id, 4};
+    StaticStridedArrayView<-32, int>{vertices, &vertices[2].id, 4};
+    CORRADE_COMPARE(out.str(),
+        "Containers::StaticStridedArrayView: data size 96 is not enough for 4 elements of stride 32\n"
+        "Containers::StaticStridedArrayView: data size 96 is not enough for 4 elements of stride -32\n");
+}
+
+void StaticStridedArrayViewTest::constructArrayView() {
+    int data[]{1, 2, 3};
+    StaticStridedArrayView<4, int> a = arrayView(data);
+    CORRADE_COMPARE(a.data(), static_cast<const void*>(data));
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_COMPARE(a[2], 3);
+
+    /* Not convertible from a view of a different type */
+    CORRADE_VERIFY(!(std::is_convertible<ArrayView<float>, StaticStridedArrayView<4, int>>::value));
+}
+
+void StaticStridedArrayViewTest::constructConst() {
+    Vertex vertices[2]{};
+    vertices[1].id = 5;
+    IdView a{vertices, &vertices[0].id, 2};
+    ConstIdView b = a;
+    CORRADE_COMPARE(b.data(), static_cast<const void*>(&vertices[0].id));
+    CORRADE_COMPARE(b.size(), 2);
+    CORRADE_COMPARE(b[1], 5);
+
+    CORRADE_VERIFY((std::is_convertible<IdView, ConstIdView>::value));
+    CORRADE_VERIFY(!(std::is_convertible<ConstIdView, IdView>::value));
+}
+
+void StaticStridedArrayViewTest::convertStrided() {
+    Vertex vertices[3]{};
+    vertices[2].id = 7;
+    StridedArrayView1D<int> a{vertices, &vertices[0].id, 3, sizeof(Vertex)};
+
+    IdView b{a};
+    CORRADE_COMPARE(b.data(), static_cast<const void*>(&vertices[0].id));
+    CORRADE_COMPARE(b.size(), 3);
+    CORRADE_COMPARE(b[2], 7);
+
+    ConstIdView c{a};
+    CORRADE_COMPARE(c[2], 7);
+
+    /* Only explicit */
+    CORRADE_VERIFY((std::is_constructible<IdView, StridedArrayView1D<int>>::value));
+    CORRADE_VERIFY(!(std::is_convertible<StridedArrayView1D<int>, IdView>::value));
+    CORRADE_VERIFY(!(std::is_constructible<IdView, StridedArrayView1D<const int>>::value));
+}
+
+void StaticStridedArrayViewTest::convertStridedInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Vertex vertices[3]{};
+    StridedArrayView1D<int> a{vertices, &vertices[0].id, 3, sizeof(Vertex)};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    StaticStridedArrayView<16, int>{a};
+    StaticStridedArrayView<-32, int>{a};
+    CORRADE_COMPARE(out.str(),
+        "Containers::StaticStridedArrayView: expected stride 16 but got 32\n"
+        "Containers::StaticStridedArrayView: expected stride -32 but got 32\n");
+}
+
+void StaticStridedArrayViewTest::convertToStrided() {
+    Vertex vertices[3]{};
+    IdView a{vertices, &vertices[0].id, 3};
+
+    StridedArrayView1D<int> b = a;
+    CORRADE_COMPARE(b.data(), static_cast<const void*>(&vertices[0].id));
+    CORRADE_COMPARE(b.size(), 3);
+    CORRADE_COMPARE(b.stride(), 32);
+
+    StridedArrayView1D<const int> c = a;
+    CORRADE_COMPARE(c.data(), static_cast<const void*>(&vertices[0].id));
+
+    CORRADE_VERIFY((std::is_convertible<IdView, StridedArrayView1D<const int>>::value));
+    CORRADE_VERIFY(!(std::is_convertible<ConstIdView, StridedArrayView1D<int>>::value));
+}
+
+void StaticStridedArrayViewTest::convertToStridedNegative() {
+    Vertex vertices[3]{};
+    vertices[0].id = 1;
+    vertices[2].id = 3;
+    StaticStridedArrayView<-32, int> a{vertices, &vertices[2].id, 3};
+
+    StridedArrayView1D<int> b = a;
+    CORRADE_COMPARE(b.stride(), -32);
+    CORRADE_COMPARE(b[0], 3);
+    CORRADE_COMPARE(b[2], 1);
+}
+
+void StaticStridedArrayViewTest::access() {
+    Vertex vertices[4]{};
+    IdView a{vertices, &vertices[0].id, 4};
+    for(std::size_t i = 0; i != a.size(); ++i)
+        a[i] = int(i)*10;
+
+    CORRADE_COMPARE(vertices[0].id, 0);
+    CORRADE_COMPARE(vertices[3].id, 30);
+    CORRADE_COMPARE(a.front(), 0);
+    CORRADE_COMPARE(a.back(), 30);
+    CORRADE_COMPARE(&a.back(), &vertices[3].id);
+}
+
+void StaticStridedArrayViewTest::accessInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Vertex vertices[2]{};
+    IdView a{vertices, &vertices[0].id, 2};
+    IdView b;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    a[2];
+    b.front();
+    b.back();
+    CORRADE_COMPARE(out.str(),
+        "Containers::StaticStridedArrayView::operator[](): index 2 out of range for 2 elements\n"
+        "Containers::StaticStridedArrayView::front(): view is empty\n"
+        "Containers::StaticStridedArrayView::back(): view is empty\n");
+}
+
+void StaticStridedArrayViewTest::iterator() {
+    Vertex vertices[5]{};
+    for(std::size_t i = 0; i != 5; ++i) vertices[i].id = int(i) + 1;
+    IdView a{vertices, &vertices[0].id, 5};
+
+    StaticStridedIterator<32, int> begin = a.begin();
+    StaticStridedIterator<32, int> end = a.end();
+    CORRADE_COMPARE(end - begin, 5);
+    CORRADE_VERIFY(begin < end);
+    CORRADE_VERIFY(begin <= begin);
+    CORRADE_VERIFY(end > begin);
+    CORRADE_VERIFY(end >= end);
+    CORRADE_VERIFY(a.cbegin() == begin);
+    CORRADE_VERIFY(a.cend() == end);
+    CORRADE_COMPARE(*begin, 1);
+    CORRADE_COMPARE(*(begin + 2), 3);
+    CORRADE_COMPARE(*(2 + begin), 3);
+    CORRADE_COMPARE(*(end - 1), 5);
+    CORRADE_COMPARE(*++begin, 2);
+    CORRADE_COMPARE(*--end, 5);
+    CORRADE_COMPARE(end.operator->(), &vertices[4].id);
+}
+
+void StaticStridedArrayViewTest::iteratorNegativeStride() {
+    Vertex vertices[3]{};
+    for(std::size_t i = 0; i != 3; ++i) vertices[i].id = int(i) + 1;
+    StaticStridedArrayView<-32, int> a{vertices, &vertices[2].id, 3};
+
+    int sum = 0;
+    int first = 0;
+    for(int i: a) {
+        if(!first) first = i;
+        sum += i;
+    }
+    CORRADE_COMPARE(first, 3);
+    CORRADE_COMPARE(sum, 6);
+}
+
+void StaticStridedArrayViewTest::rangeBasedFor() {
+    Vertex vertices[3]{};
+    IdView a{vertices, &vertices[0].id, 3};
+    int i = 0;
+    for(int& id: a) id = ++i;
+
+    CORRADE_COMPARE(vertices[0].id, 1);
+    CORRADE_COMPARE(vertices[1].id, 2);
+    CORRADE_COMPARE(vertices[2].id, 3);
+}
+
+void StaticStridedArrayViewTest::slice() {
+    Vertex vertices[5]{};
+    for(std::size_t i = 0; i != 5; ++i) vertices[i].id = int(i) + 1;
+    IdView a{vertices, &vertices[0].id, 5};
+
+    IdView b = a.slice(1, 4);
+    CORRADE_COMPARE(b.size(), 3);
+    CORRADE_COMPARE(b[0], 2);
+    CORRADE_COMPARE(b[2], 4);
+
+    IdView c = a.prefix(2);
+    CORRADE_COMPARE(c.size(), 2);
+    CORRADE_COMPARE(c[1], 2);
+
+    IdView d = a.suffix(3);
+    CORRADE_COMPARE(d.size(), 2);
+    CORRADE_COMPARE(d[0], 4);
+
+    IdView e = a.except(1);
+    CORRADE_COMPARE(e.size(), 4);
+    CORRADE_COMPARE(e.back(), 4);
+}
+
+void StaticStridedArrayViewTest::sliceInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Vertex vertices[5]{};
+    IdView a{vertices, &vertices[0].id, 5};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    a.slice(5, 6);
+    a.slice(2, 1);
+    CORRADE_COMPARE(out.str(),
+        "Containers::StaticStridedArrayView::slice(): slice [5:6] out of range for 5 elements\n"
+        "Containers::StaticStridedArrayView::slice(): slice [2:1] out of range for 5 elements\n");
+}
+
+constexpr std::size_t BenchmarkSize = 10000;
+
+void StaticStridedArrayViewTest::benchmarkRuntimeStride() {
+    Array<Vertex> vertices{ValueInit, BenchmarkSize};
+    for(std::size_t i = 0; i != BenchmarkSize; ++i) vertices[i].id = int(i);
+    StridedArrayView1D<const int> ids{vertices, &vertices[0].id, BenchmarkSize, sizeof(Vertex)};
+
+    int sum = 0;
+    CORRADE_BENCHMARK(10)
+        for(std::size_t i = 0; i != ids.size(); ++i) sum += ids[i];
+
+    CORRADE_COMPARE(sum, 10*int(BenchmarkSize*(BenchmarkSize - 1)/2));
+}
+
+void StaticStridedArrayViewTest::benchmarkStaticStride() {
+    Array<Vertex> vertices{ValueInit, BenchmarkSize};
+    for(std::size_t i = 0; i != BenchmarkSize; ++i) vertices[i].id = int(i);
+    StaticStridedArrayView<sizeof(Vertex), const int> ids{vertices, &vertices[0].id, BenchmarkSize};
+
+    int sum = 0;
+    CORRADE_BENCHMARK(10)
+        for(std::size_t i = 0; i != ids.size(); ++i) sum += ids[i];
+
+    CORRADE_COMPARE(sum, 10*int(BenchmarkSize*(BenchmarkSize - 1)/2));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::StaticStridedArrayViewTest)
@@ -25,6 +25,7 @@
 
 #include <sstream>
 
+#include "Corrade/Containers/Array.h"
 #include "Corrade/Containers/StridedArrayView.h"
 #include "Corrade/TestSuite/Tester.h"
 #include "Corrade/TestSuite/Compare/Container.h"
@@ -208,6 +209,26 @@ struct StridedArrayViewTest: TestSuite::Tester {
     void rangeBasedForNegativeStride();
     void rangeBasedForNegativeStride3D();
 
+    void elementIterator();
+    void elementIteratorNegativeZeroStride();
+    void elementIteratorEmpty();
+    void forEachElement();
+    void forEachElementNonContiguousRows();
+    void forEachElementTransposed();
+    void forEachRow();
+    void forEachRowNotContiguous();
+    void forEachZipped();
+    void forEachZippedStrided();
+    void forEachZippedSingle();
+    void forEachZippedEmpty();
+    void forEachZippedSizeMismatch();
+    void forEachTile();
+    void forEachTile3D();
+    void forEachTileZeroSize();
+    void forEachElementMorton();
+    void forEachElementMortonNonPowerOfTwo();
+    void forEachElementMortonEmpty();
+
     void slice();
     void sliceInvalid();
     void slice3D();
@@ -242,6 +263,12 @@ struct StridedArrayViewTest: TestSuite::Tester {
     void castInflateFlatten();
     void castInflateFlattenArrayView();
     void castInflateFlattenInvalid();
+
+    void benchmarkIterateIndex();
+    void benchmarkIterateRangeFor();
+    void benchmarkIterate2D();
+    void benchmarkSlice();
+    void benchmarkEvery();
 };
 
 typedef StridedDimensions<1, std::size_t> Size1D;
@@ -401,6 +428,26 @@ StridedArrayViewTest::StridedArrayViewTest() {
               &StridedArrayViewTest::rangeBasedForNegativeStride,
               &StridedArrayViewTest::rangeBasedForNegativeStride3D,
 
+              &StridedArrayViewTest::elementIterator,
+              &StridedArrayViewTest::elementIteratorNegativeZeroStride,
+              &StridedArrayViewTest::elementIteratorEmpty,
+              &StridedArrayViewTest::forEachElement,
+              &StridedArrayViewTest::forEachElementNonContiguousRows,
+              &StridedArrayViewTest::forEachElementTransposed,
+              &StridedArrayViewTest::forEachRow,
+              &StridedArrayViewTest::forEachRowNotContiguous,
+              &StridedArrayViewTest::forEachZipped,
+              &StridedArrayViewTest::forEachZippedStrided,
+              &StridedArrayViewTest::forEachZippedSingle,
+              &StridedArrayViewTest::forEachZippedEmpty,
+              &StridedArrayViewTest::forEachZippedSizeMismatch,
+              &StridedArrayViewTest::forEachTile,
+              &StridedArrayViewTest::forEachTile3D,
+              &StridedArrayViewTest::forEachTileZeroSize,
+              &StridedArrayViewTest::forEachElementMorton,
+              &StridedArrayViewTest::forEachElementMortonNonPowerOfTwo,
+              &StridedArrayViewTest::forEachElementMortonEmpty,
+
               &StridedArrayViewTest::slice,
               &StridedArrayViewTest::sliceInvalid,
               &StridedArrayViewTest::slice3D,
@@ -435,6 +482,12 @@ StridedArrayViewTest::StridedArrayViewTest() {
               &StridedArrayViewTest::castInflateFlatten,
               &StridedArrayViewTest::castInflateFlattenArrayView,
               &StridedArrayViewTest::castInflateFlattenInvalid});
+
+    addBenchmarks({&StridedArrayViewTest::benchmarkIterateIndex,
+                   &StridedArrayViewTest::benchmarkIterateRangeFor,
+                   &StridedArrayViewTest::benchmarkIterate2D,
+                   &StridedArrayViewTest::benchmarkSlice,
+                   &StridedArrayViewTest::benchmarkEvery}, 10);
 }
 
 void StridedArrayViewTest::dimensionsConstructDefault() {
@@ -2495,6 +2548,346 @@ void StridedArrayViewTest::rangeBasedForNegativeStride3D() {
     CORRADE_COMPARE(data[11].value, 1);
 }
 
+void StridedArrayViewTest::elementIterator() {
+    struct {
+        int value;
+        int:32;
+    } data[12];
+    StridedArrayView3Di a{data, &data[0].value, {2, 2, 3}, {48, 24, 8}};
+
+    int i = 0;
+    for(auto it = a.elementsBegin(); it != a.elementsEnd(); ++it)
+        *it = ++i;
+    CORRADE_COMPARE(i, 12);
+
+    CORRADE_COMPARE(data[0].value, 1);
+    CORRADE_COMPARE(data[2].value, 3);
+    CORRADE_COMPARE(data[3].value, 4);
+    CORRADE_COMPARE(data[6].value, 7);
+    CORRADE_COMPARE(data[11].value, 12);
+
+    /* Slicing away the last element in each row, the carries have to skip
+       it */
+    StridedArrayView3Di b = a.slice({0, 0, 0}, {2, 2, 2});
+    int values[8];
+    std::size_t count = 0;
+    for(auto it = b.elementsBegin(); it != b.elementsEnd(); ++it)
+        values[count++] = *it;
+    CORRADE_COMPARE_AS(arrayView(values, count), arrayView<int>({
+        1, 2, 4, 5, 7, 8, 10, 11
+    }), TestSuite::Compare::Container);
+}
+
+void StridedArrayViewTest::elementIteratorNegativeZeroStride() {
+    int data[6]{0, 1, 2, 3, 4, 5};
+
+    /* Rows in reverse order, the middle dimension repeated twice */
+    StridedArrayView3Di a = StridedArrayView3Di{data, {2, 1, 3}, {12, 0, 4}}.flipped<0>().broadcasted<1>(2);
+
+    int values[12];
+    std::size_t count = 0;
+    for(auto it = a.elementsBegin(); it != a.elementsEnd(); ++it)
+        values[count++] = *it;
+    CORRADE_COMPARE_AS(arrayView(values, count), arrayView<int>({
+        3, 4, 5, 3, 4, 5, 0, 1, 2, 0, 1, 2
+    }), TestSuite::Compare::Container);
+}
+
+void StridedArrayViewTest::elementIteratorEmpty() {
+    int data[6]{};
+    StridedArrayView2Di a = StridedArrayView2Di{data, {2, 3}}.slice({0, 0}, {2, 0});
+    CORRADE_VERIFY(a.elementsBegin() == a.elementsEnd());
+
+    StridedArrayView2Di b;
+    CORRADE_VERIFY(b.elementsBegin() == b.elementsEnd());
+}
+
+void StridedArrayViewTest::forEachElement() {
+    int data[6]{0, 1, 2, 3, 4, 5};
+    StridedArrayView2Di a{data, {2, 3}};
+    CORRADE_VERIFY(a.isContiguous());
+
+    int values[6];
+    std::size_t count = 0;
+    Containers::forEachElement(a, [&](int& value) {
+        values[count++] = value;
+        value *= 10;
+    });
+    CORRADE_COMPARE_AS(arrayView(values, count), arrayView<int>({
+        0, 1, 2, 3, 4, 5
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(data[5], 50);
+
+    /* Contiguous rows but not the whole view */
+    StridedArrayView2D<const int> b = StridedArrayView2D<const int>{data, {2, 3}}.slice({0, 1}, {2, 3});
+    CORRADE_VERIFY(!b.isContiguous());
+    CORRADE_VERIFY(b.isContiguous<1>());
+    count = 0;
+    Containers::forEachElement(b, [&](const int& value) {
+        values[count++] = value;
+    });
+    CORRADE_COMPARE_AS(arrayView(values, count), arrayView<int>({
+        10, 20, 40, 50
+    }), TestSuite::Compare::Container);
+}
+
+void StridedArrayViewTest::forEachElementNonContiguousRows() {
+    struct {
+        int value;
+        int:32;
+    } data[12];
+    StridedArrayView3Di a{data, &data[0].value, {2, 2, 3}, {48, 24, 8}};
+    CORRADE_VERIFY(!a.isContiguous<2>());
+
+    int i = 0;
+    Containers::forEachElement(a, [&](int& value) {
+        value = ++i;
+    });
+    CORRADE_COMPARE(i, 12);
+    CORRADE_COMPARE(data[0].value, 1);
+    CORRADE_COMPARE(data[4].value, 5);
+    CORRADE_COMPARE(data[11].value, 12);
+}
+
+void StridedArrayViewTest::forEachElementTransposed() {
+    int data[6]{0, 1, 2, 3, 4, 5};
+    StridedArrayView2Di a = StridedArrayView2Di{data, {2, 3}}.transposed<0, 1>();
+
+    int values[6];
+    std::size_t count = 0;
+    Containers::forEachElement(a, [&](int value) {
+        values[count++] = value;
+    });
+    CORRADE_COMPARE_AS(arrayView(values, count), arrayView<int>({
+        0, 3, 1, 4, 2, 5
+    }), TestSuite::Compare::Container);
+}
+
+void StridedArrayViewTest::forEachRow() {
+    int data[12]{0, 1, 2, 3,
+                 4, 5, 6, 7,
+                 8, 9, 10, 11};
+
+    /* The middle two columns, rows in reverse order */
+    StridedArrayView2Di a = StridedArrayView2Di{data, {3, 4}}.slice({0, 1}, {3, 3}).flipped<0>();
+
+    int values[6];
+    std::size_t rows = 0, count = 0;
+    Containers::forEachRow(a, [&](ArrayView<int> row) {
+        ++rows;
+        for(int value: row) values[count++] = value;
+    });
+    CORRADE_COMPARE(rows, 3);
+    CORRADE_COMPARE_AS(arrayView(values, count), arrayView<int>({
+        9, 10, 5, 6, 1, 2
+    }), TestSuite::Compare::Container);
+}
+
+void StridedArrayViewTest::forEachRowNotContiguous() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    int data[6]{};
+    StridedArrayView2Di a = StridedArrayView2Di{data, {2, 3}}.transposed<0, 1>();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Containers::forEachRow(a, [](ArrayView<int>) {});
+    CORRADE_COMPARE(out.str(), "Containers::forEachRow(): the last dimension is not contiguous\n");
+}
+
+void StridedArrayViewTest::forEachZipped() {
+    const int a[]{1, 2, 3, 4};
+    const float b[]{0.5f, 1.5f, 2.5f, 3.5f};
+    float out[4]{};
+
+    /* All contiguous */
+    Containers::forEachZipped([](const int& a, const float& b, float& out) {
+        out = a*b;
+    }, StridedArrayView1D<const int>{a}, StridedArrayView1D<const float>{b}, StridedArrayView1D<float>{out});
+    CORRADE_COMPARE_AS(arrayView(out), arrayView<float>({
+        0.5f, 3.0f, 7.5f, 14.0f
+    }), TestSuite::Compare::Container);
+}
+
+void StridedArrayViewTest::forEachZippedStrided() {
+    struct Vertex {
+        float position;
+        short id;
+    } vertices[]{{1.0f, 3}, {2.0f, 5}, {3.0f, 7}};
+    int out[6]{};
+
+    /* One contiguous view with a stride that's element size of another one,
+       one interleaved and one with a negative stride */
+    StridedArrayView1D<float> positions{vertices, &vertices[0].position, 3, sizeof(Vertex)};
+    StridedArrayView1D<short> ids{vertices, &vertices[0].id, 3, sizeof(Vertex)};
+    StridedArrayView1D<int> result = StridedArrayView1D<int>{out}.every(2).flipped<0>();
+    std::size_t count = 0;
+    Containers::forEachZipped([&count](float& position, const short& id, int& out) {
+        out = int(position)*id;
+        position = 0.0f;
+        ++count;
+    }, positions, ids, result);
+    CORRADE_COMPARE(count, 3);
+    CORRADE_COMPARE_AS(arrayView(out), arrayView<int>({
+        21, 0, 10, 0, 3, 0
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(vertices[1].position, 0.0f);
+    CORRADE_COMPARE(vertices[2].id, 7);
+}
+
+void StridedArrayViewTest::forEachZippedSingle() {
+    int data[]{1, 2, 3};
+    Containers::forEachZipped([](int& a) { a *= 10; }, StridedArrayView1Di{data});
+    CORRADE_COMPARE_AS(arrayView(data), arrayView<int>({
+        10, 20, 30
+    }), TestSuite::Compare::Container);
+}
+
+void StridedArrayViewTest::forEachZippedEmpty() {
+    std::size_t count = 0;
+    Containers::forEachZipped([&count](int&, float&) { ++count; },
+        StridedArrayView1Di{}, StridedArrayView1D<float>{});
+    CORRADE_COMPARE(count, 0);
+}
+
+void StridedArrayViewTest::forEachZippedSizeMismatch() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    int a[3]{};
+    float b[3]{};
+    short c[2]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Containers::forEachZipped([](int&, float&, short&) {},
+        StridedArrayView1Di{a}, StridedArrayView1D<float>{b}, StridedArrayView1D<short>{c});
+    CORRADE_COMPARE(out.str(), "Containers::forEachZipped(): expected view 2 to have 3 elements but got 2\n");
+}
+
+void StridedArrayViewTest::forEachTile() {
+    int data[5*7];
+    for(std::size_t i = 0; i != Containers::arraySize(data); ++i)
+        data[i] = i;
+    StridedArrayView2Di view{data, {5, 7}};
+
+    Size2D offsets[6];
+    Size2D sizes[6];
+    std::size_t count = 0;
+    int visited[5*7]{};
+    Containers::forEachTile(view, {3, 4}, [&](const Size2D& offset, StridedArrayView2Di tile) {
+        if(count < 6) {
+            offsets[count] = offset;
+            sizes[count] = tile.size();
+        }
+        ++count;
+        for(std::size_t i = 0; i != tile.size()[0]; ++i)
+            for(std::size_t j = 0; j != tile.size()[1]; ++j) {
+                /* The tile is a slice of the original view at given offset */
+                CORRADE_COMPARE(tile[i][j], int((offset[0] + i)*7 + offset[1] + j));
+                ++visited[tile[i][j]];
+            }
+    });
+
+    /* Row-major order of the tiles, the last tile in each dimension is
+       smaller */
+    CORRADE_COMPARE(count, 4);
+    CORRADE_COMPARE(offsets[0], (Size2D{0, 0}));
+    CORRADE_COMPARE(offsets[1], (Size2D{0, 4}));
+    CORRADE_COMPARE(offsets[2], (Size2D{3, 0}));
+    CORRADE_COMPARE(offsets[3], (Size2D{3, 4}));
+    CORRADE_COMPARE(sizes[0], (Size2D{3, 4}));
+    CORRADE_COMPARE(sizes[1], (Size2D{3, 3}));
+    CORRADE_COMPARE(sizes[2], (Size2D{2, 4}));
+    CORRADE_COMPARE(sizes[3], (Size2D{2, 3}));
+    for(int i: visited) CORRADE_COMPARE(i, 1);
+}
+
+void StridedArrayViewTest::forEachTile3D() {
+    int data[4*6*5]{};
+    /* Negative strides, tile larger than the view in the last dimension */
+    StridedArrayView3Di view = StridedArrayView3Di{data, {4, 6, 5}}.flipped<1>();
+
+    std::size_t count = 0;
+    Containers::forEachTile(view, {2, 4, 8}, [&](const Size3D& offset, StridedArrayView3Di tile) {
+        CORRADE_COMPARE(tile.size()[2], 5);
+        CORRADE_COMPARE(offset[2], 0);
+        CORRADE_COMPARE(tile.data(), &view[offset[0]][offset[1]][0]);
+        for(StridedArrayView2Di i: tile)
+            for(StridedArrayView1Di j: i)
+                for(int& k: j) ++k;
+        ++count;
+    });
+
+    CORRADE_COMPARE(count, 2*2);
+    for(int i: data) CORRADE_COMPARE(i, 1);
+}
+
+void StridedArrayViewTest::forEachTileZeroSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    int data[4]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Containers::forEachTile(StridedArrayView2Di{data, {2, 2}}, {2, 0}, [](const Size2D&, StridedArrayView2Di) {});
+    CORRADE_COMPARE(out.str(), "Containers::forEachTile(): expected a non-zero tile size but got {2, 0}\n");
+}
+
+void StridedArrayViewTest::forEachElementMorton() {
+    int data[16*16];
+    for(std::size_t i = 0; i != Containers::arraySize(data); ++i)
+        data[i] = i;
+    const StridedArrayView2D<const int> view{data, {16, 16}};
+
+    Size2D positions[16*16];
+    std::size_t count = 0;
+    Containers::forEachElementMorton(view, [&](const Size2D& position, const int& value) {
+        CORRADE_COMPARE(value, int(position[0]*16 + position[1]));
+        positions[count++] = position;
+    });
+
+    /* The view is split into 8x8 quadrants, visited in a row-major order,
+       each iterated row-major */
+    CORRADE_COMPARE(count, 16*16);
+    CORRADE_COMPARE(positions[0], (Size2D{0, 0}));
+    CORRADE_COMPARE(positions[1], (Size2D{0, 1}));
+    CORRADE_COMPARE(positions[8], (Size2D{1, 0}));
+    CORRADE_COMPARE(positions[63], (Size2D{7, 7}));
+    CORRADE_COMPARE(positions[64], (Size2D{0, 8}));
+    CORRADE_COMPARE(positions[128], (Size2D{8, 0}));
+    CORRADE_COMPARE(positions[192], (Size2D{8, 8}));
+    CORRADE_COMPARE(positions[255], (Size2D{15, 15}));
+}
+
+void StridedArrayViewTest::forEachElementMortonNonPowerOfTwo() {
+    int data[5*19*11]{};
+    StridedArrayView3Di view = StridedArrayView3Di{data, {5, 19, 11}}.flipped<2>();
+
+    Containers::forEachElementMorton(view, [&](const Size3D& position, int& value) {
+        CORRADE_COMPARE(&value, &view[position[0]][position[1]][position[2]]);
+        ++value;
+    });
+
+    /* Each element visited exactly once */
+    for(int i: data) CORRADE_COMPARE(i, 1);
+}
+
+void StridedArrayViewTest::forEachElementMortonEmpty() {
+    int data[4]{};
+
+    std::size_t count = 0;
+    Containers::forEachElementMorton(StridedArrayView2Di{data, {4, 0}}, [&](const Size2D&, int&) {
+        ++count;
+    });
+    CORRADE_COMPARE(count, 0);
+}
+
 void StridedArrayViewTest::slice() {
     struct {
         int value;
@@ -3237,6 +3630,82 @@ void StridedArrayViewTest::castInflateFlattenInvalid() {
         "Containers::arrayCast(): last dimension needs to be tightly packed in order to be flattened, expected stride 2 but got -2\n");
 }
 
+constexpr std::size_t BenchmarkSize = 10000;
+
+struct BenchmarkVertex {
+    float position[3];
+    int id;
+};
+
+void StridedArrayViewTest::benchmarkIterateIndex() {
+    Array<BenchmarkVertex> vertices{ValueInit, BenchmarkSize};
+    for(std::size_t i = 0; i != BenchmarkSize; ++i) vertices[i].id = int(i);
+    StridedArrayView1D<const int> ids{vertices, &vertices[0].id, BenchmarkSize, sizeof(BenchmarkVertex)};
+
+    int sum = 0;
+    CORRADE_BENCHMARK(10)
+        for(std::size_t i = 0; i != ids.size(); ++i) sum += ids[i];
+
+    CORRADE_COMPARE(sum, 10*int(BenchmarkSize*(BenchmarkSize - 1)/2));
+}
+
+void StridedArrayViewTest::benchmarkIterateRangeFor() {
+    Array<BenchmarkVertex> vertices{ValueInit, BenchmarkSize};
+    for(std::size_t i = 0; i != BenchmarkSize; ++i) vertices[i].id = int(i);
+    StridedArrayView1D<const int> ids{vertices, &vertices[0].id, BenchmarkSize, sizeof(BenchmarkVertex)};
+
+    int sum = 0;
+    CORRADE_BENCHMARK(10)
+        for(int id: ids) sum += id;
+
+    CORRADE_COMPARE(sum, 10*int(BenchmarkSize*(BenchmarkSize - 1)/2));
+}
+
+void StridedArrayViewTest::benchmarkIterate2D() {
+    Array<int> data{NoInit, BenchmarkSize};
+    for(std::size_t i = 0; i != BenchmarkSize; ++i) data[i] = int(i);
+    /* Iterating a transposed view to not have the inner dimension
+       contiguous */
+    StridedArrayView2D<const int> view = StridedArrayView2D<const int>{data, {100, 100}}.transposed<0, 1>();
+
+    int sum = 0;
+    CORRADE_BENCHMARK(10)
+        for(StridedArrayView1D<const int> row: view)
+            for(int i: row) sum += i;
+
+    CORRADE_COMPARE(sum, 10*int(BenchmarkSize*(BenchmarkSize - 1)/2));
+}
+
+void StridedArrayViewTest::benchmarkSlice() {
+    Array<BenchmarkVertex> vertices{ValueInit, BenchmarkSize};
+    for(std::size_t i = 0; i != BenchmarkSize; ++i) vertices[i].id = int(i);
+    StridedArrayView1D<const int> ids{vertices, &vertices[0].id, BenchmarkSize, sizeof(BenchmarkVertex)};
+
+    /* Slicing is cheap compared to the iteration above, so do it on every
+       element to have the cost measurable */
+    int sum = 0;
+    CORRADE_BENCHMARK(10)
+        for(std::size_t i = 0; i != ids.size(); ++i)
+            sum += ids.slice(i, ids.size()).front();
+
+    CORRADE_COMPARE(sum, 10*int(BenchmarkSize*(BenchmarkSize - 1)/2));
+}
+
+void StridedArrayViewTest::benchmarkEvery() {
+    Array<BenchmarkVertex> vertices{ValueInit, BenchmarkSize};
+    for(std::size_t i = 0; i != BenchmarkSize; ++i) vertices[i].id = int(i);
+    StridedArrayView1D<const int> ids{vertices, &vertices[0].id, BenchmarkSize, sizeof(BenchmarkVertex)};
+
+    /* Sum of the even and odd elements is the same as the sum of all */
+    int sum = 0;
+    CORRADE_BENCHMARK(10) {
+        for(int id: ids.every(2)) sum += id;
+        for(int id: ids.suffix(1).every(2)) sum += id;
+    }
+
+    CORRADE_COMPARE(sum, 10*int(BenchmarkSize*(BenchmarkSize - 1)/2));
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Corrade::Containers::Test::StridedArrayViewTest)
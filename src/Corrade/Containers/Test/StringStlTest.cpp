@@ -0,0 +1,91 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Corrade/Containers/StringStl.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/Utility/DebugStl.h"
+
+namespace Corrade { namespace Containers { namespace Test { namespace {
+
+struct StringStlTest: TestSuite::Tester {
+    explicit StringStlTest();
+
+    void convertToStlString();
+    void convertFromStlString();
+    void convertViewToStlString();
+    void convertViewFromStlString();
+    void convertMutableViewFromStlString();
+};
+
+StringStlTest::StringStlTest() {
+    addTests({&StringStlTest::convertToStlString,
+              &StringStlTest::convertFromStlString,
+              &StringStlTest::convertViewToStlString,
+              &StringStlTest::convertViewFromStlString,
+              &StringStlTest::convertMutableViewFromStlString});
+}
+
+void StringStlTest::convertToStlString() {
+    const String a = "hello\0world";
+    const std::string b = a;
+    CORRADE_COMPARE(b, "hello");
+}
+
+void StringStlTest::convertFromStlString() {
+    const std::string a{"hello\0world", 11};
+    const String b = a;
+    CORRADE_COMPARE(b.size(), 11);
+    CORRADE_COMPARE(b, (StringView{"hello\0world", 11}));
+}
+
+void StringStlTest::convertViewToStlString() {
+    const StringView a{"hello\0world", 11};
+    const std::string b = a;
+    CORRADE_COMPARE(b, (std::string{"hello\0world", 11}));
+
+    const std::string c = StringView{};
+    CORRADE_VERIFY(c.empty());
+}
+
+void StringStlTest::convertViewFromStlString() {
+    const std::string a = "hello";
+    const StringView b = a;
+    CORRADE_COMPARE(static_cast<const void*>(b.data()), a.data());
+    CORRADE_COMPARE(b.size(), 5);
+}
+
+void StringStlTest::convertMutableViewFromStlString() {
+    std::string a = "hello";
+    const MutableStringView b = a;
+    b[0] = 'H';
+    CORRADE_COMPARE(a, "Hello");
+
+    /* A const std::string can't be converted to a mutable view */
+    CORRADE_VERIFY(!(std::is_convertible<const std::string&, MutableStringView>::value));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::StringStlTest)
@@ -0,0 +1,410 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+
+#include "Corrade/Containers/String.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/Utility/DebugStl.h"
+
+namespace Corrade { namespace Containers { namespace Test { namespace {
+
+struct StringTest: TestSuite::Tester {
+    explicit StringTest();
+
+    void constructDefault();
+    void constructSmall();
+    void constructLarge();
+    void constructNullTerminated();
+    void constructNullTerminatedNull();
+    void constructView();
+    void constructNullWithSize();
+    void constructTakeOwnership();
+    void constructTakeOwnershipDefaultDeleter();
+    void constructTakeOwnershipNotNullTerminated();
+    void constructValueInit();
+    void constructNoInit();
+
+    void convertView();
+    void convertArrayView();
+
+    void copySmall();
+    void copyLarge();
+    void moveSmall();
+    void moveLarge();
+
+    void access();
+    void accessInvalid();
+    void slice();
+
+    void release();
+    void releaseSmall();
+};
+
+StringTest::StringTest() {
+    addTests({&StringTest::constructDefault,
+              &StringTest::constructSmall,
+              &StringTest::constructLarge,
+              &StringTest::constructNullTerminated,
+              &StringTest::constructNullTerminatedNull,
+              &StringTest::constructView,
+              &StringTest::constructNullWithSize,
+              &StringTest::constructTakeOwnership,
+              &StringTest::constructTakeOwnershipDefaultDeleter,
+              &StringTest::constructTakeOwnershipNotNullTerminated,
+              &StringTest::constructValueInit,
+              &StringTest::constructNoInit,
+
+              &StringTest::convertView,
+              &StringTest::convertArrayView,
+
+              &StringTest::copySmall,
+              &StringTest::copyLarge,
+              &StringTest::moveSmall,
+              &StringTest::moveLarge,
+
+              &StringTest::access,
+              &StringTest::accessInvalid,
+              &StringTest::slice,
+
+              &StringTest::release,
+              &StringTest::releaseSmall});
+}
+
+using namespace Literals;
+
+constexpr const char Small[] = "this fits into SSO";
+constexpr const char Large[] = "this is a string way too long to fit into SSO";
+
+void StringTest::constructDefault() {
+    const String a;
+    CORRADE_VERIFY(a.isSmall());
+    CORRADE_VERIFY(a.empty());
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_VERIFY(a.data());
+    CORRADE_COMPARE(a.data()[0], '\0');
+    CORRADE_VERIFY(!a.deleter());
+}
+
+void StringTest::constructSmall() {
+    const String a{Small, sizeof(Small) - 1};
+    CORRADE_VERIFY(a.isSmall());
+    CORRADE_COMPARE(a.size(), sizeof(Small) - 1);
+    CORRADE_COMPARE(a, Small);
+    CORRADE_VERIFY(static_cast<const void*>(a.data()) != Small);
+    CORRADE_COMPARE(a.data()[a.size()], '\0');
+
+    /* The largest size that fits */
+    const String b{Large, sizeof(String) - 2};
+    CORRADE_VERIFY(b.isSmall());
+    CORRADE_COMPARE(b.size(), sizeof(String) - 2);
+    CORRADE_COMPARE(b.data()[b.size()], '\0');
+
+    /* One more doesn't */
+    const String c{Large, sizeof(String) - 1};
+    CORRADE_VERIFY(!c.isSmall());
+    CORRADE_COMPARE(c.size(), sizeof(String) - 1);
+    CORRADE_COMPARE(c.data()[c.size()], '\0');
+}
+
+void StringTest::constructLarge() {
+    const String a{Large, sizeof(Large) - 1};
+    CORRADE_VERIFY(!a.isSmall());
+    CORRADE_COMPARE(a.size(), sizeof(Large) - 1);
+    CORRADE_COMPARE(a, Large);
+    CORRADE_VERIFY(static_cast<const void*>(a.data()) != Large);
+    CORRADE_COMPARE(a.data()[a.size()], '\0');
+    CORRADE_VERIFY(!a.deleter());
+}
+
+void StringTest::constructNullTerminated() {
+    const String a = "hello\0world";
+    CORRADE_VERIFY(a.isSmall());
+    CORRADE_COMPARE(a.size(), 5);
+    CORRADE_COMPARE(a, "hello");
+}
+
+void StringTest::constructNullTerminatedNull() {
+    const String a = static_cast<const char*>(nullptr);
+    CORRADE_VERIFY(a.isSmall());
+    CORRADE_VERIFY(a.empty());
+    CORRADE_COMPARE(a.data()[0], '\0');
+}
+
+void StringTest::constructView() {
+    /* Not null-terminated, the string has to add the terminator */
+    const StringView view = "hello world"_s.prefix(5);
+    const String a = view;
+    CORRADE_COMPARE(a, "hello");
+    CORRADE_COMPARE(a.data()[5], '\0');
+
+    char data[] = "hello";
+    const String b = MutableStringView{data};
+    CORRADE_COMPARE(b, "hello");
+}
+
+void StringTest::constructNullWithSize() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const String a{nullptr, 5};
+    CORRADE_VERIFY(a.empty());
+    CORRADE_COMPARE(out.str(), "Containers::String: received a null string of size 5\n");
+}
+
+int deletedSize = 0;
+
+void StringTest::constructTakeOwnership() {
+    deletedSize = 0;
+
+    char* data = new char[6]{'h', 'e', 'l', 'l', 'o', '\0'};
+    {
+        String a{data, 5, [](char* data, std::size_t size) {
+            deletedSize = int(size);
+            delete[] data;
+        }};
+        /* Even though it'd fit, it's not copied to the inline storage */
+        CORRADE_VERIFY(!a.isSmall());
+        CORRADE_COMPARE(static_cast<void*>(a.data()), static_cast<void*>(data));
+        CORRADE_COMPARE(a.size(), 5);
+        CORRADE_VERIFY(a.deleter());
+    }
+
+    CORRADE_COMPARE(deletedSize, 5);
+}
+
+void StringTest::constructTakeOwnershipDefaultDeleter() {
+    char* data = new char[6]{'h', 'e', 'l', 'l', 'o', '\0'};
+    String a{data, 5, nullptr};
+    CORRADE_VERIFY(!a.isSmall());
+    CORRADE_COMPARE(a, "hello");
+    CORRADE_VERIFY(!a.deleter());
+}
+
+void StringTest::constructTakeOwnershipNotNullTerminated() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    char data[] = "hello";
+    String a{data, 4, [](char*, std::size_t) {}};
+    String b{nullptr, 0, [](char*, std::size_t) {}};
+    CORRADE_VERIFY(a.isSmall());
+    CORRADE_VERIFY(b.isSmall());
+    CORRADE_COMPARE(out.str(),
+        "Containers::String: can only take ownership of a non-null null-terminated array\n"
+        "Containers::String: can only take ownership of a non-null null-terminated array\n");
+}
+
+void StringTest::constructValueInit() {
+    const String a{ValueInit, 3};
+    CORRADE_VERIFY(a.isSmall());
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_COMPARE(a.data()[0], '\0');
+    CORRADE_COMPARE(a.data()[2], '\0');
+    CORRADE_COMPARE(a.data()[3], '\0');
+
+    const String b{ValueInit, 100};
+    CORRADE_VERIFY(!b.isSmall());
+    CORRADE_COMPARE(b.size(), 100);
+    CORRADE_COMPARE(b.data()[0], '\0');
+    CORRADE_COMPARE(b.data()[99], '\0');
+    CORRADE_COMPARE(b.data()[100], '\0');
+}
+
+void StringTest::constructNoInit() {
+    const String a{NoInit, 3};
+    CORRADE_VERIFY(a.isSmall());
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_COMPARE(a.data()[3], '\0');
+
+    const String b{NoInit, 100};
+    CORRADE_VERIFY(!b.isSmall());
+    CORRADE_COMPARE(b.size(), 100);
+    CORRADE_COMPARE(b.data()[100], '\0');
+}
+
+void StringTest::convertView() {
+    String a = "hello";
+
+    const StringView b = a;
+    CORRADE_COMPARE(static_cast<const void*>(b.data()), a.data());
+    CORRADE_COMPARE(b.size(), 5);
+
+    const MutableStringView c = a;
+    c[0] = 'H';
+    CORRADE_COMPARE(a, "Hello");
+
+    /* Usable directly in algorithms taking a view */
+    CORRADE_VERIFY(StringView{a}.hasPrefix("He"));
+    CORRADE_VERIFY(StringView{"Hello world"}.hasPrefix(a));
+}
+
+void StringTest::convertArrayView() {
+    String a = "hello";
+
+    const ArrayView<char> b = a;
+    CORRADE_COMPARE(static_cast<void*>(b.data()), a.data());
+    CORRADE_COMPARE(b.size(), 5);
+
+    const String& ca = a;
+    const ArrayView<const char> c = ca;
+    CORRADE_COMPARE(static_cast<const void*>(c.data()), a.data());
+    CORRADE_COMPARE(c.size(), 5);
+}
+
+void StringTest::copySmall() {
+    String a = Small;
+    String b = a;
+    CORRADE_VERIFY(b.isSmall());
+    CORRADE_COMPARE(b, Small);
+
+    String c = "short";
+    c = b;
+    CORRADE_COMPARE(c, Small);
+    CORRADE_COMPARE(b, Small);
+}
+
+void StringTest::copyLarge() {
+    String a = Large;
+    String b = a;
+    CORRADE_VERIFY(!b.isSmall());
+    CORRADE_VERIFY(b.data() != a.data());
+    CORRADE_COMPARE(b, Large);
+
+    String c = Small;
+    c = b;
+    CORRADE_VERIFY(!c.isSmall());
+    CORRADE_COMPARE(c, Large);
+
+    /* Self-assignment */
+    String& cref = c;
+    c = cref;
+    CORRADE_COMPARE(c, Large);
+}
+
+void StringTest::moveSmall() {
+    String a = Small;
+    String b = std::move(a);
+    CORRADE_VERIFY(b.isSmall());
+    CORRADE_COMPARE(b, Small);
+    CORRADE_VERIFY(a.isSmall());
+    CORRADE_VERIFY(a.empty());
+
+    String c = Large;
+    c = std::move(b);
+    CORRADE_COMPARE(c, Small);
+    CORRADE_COMPARE(b, Large);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<String>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<String>::value);
+}
+
+void StringTest::moveLarge() {
+    String a = Large;
+    const char* data = a.data();
+    String b = std::move(a);
+    CORRADE_VERIFY(!b.isSmall());
+    CORRADE_COMPARE(static_cast<const void*>(b.data()), data);
+    CORRADE_COMPARE(b, Large);
+    CORRADE_VERIFY(a.isSmall());
+    CORRADE_VERIFY(a.empty());
+
+    String c = Small;
+    c = std::move(b);
+    CORRADE_COMPARE(static_cast<const void*>(c.data()), data);
+    CORRADE_COMPARE(b, Small);
+}
+
+void StringTest::access() {
+    String a = "hello";
+    a.front() = 'H';
+    a.back() = 'O';
+    a[2] = 'L';
+    CORRADE_COMPARE(a, "HeLlO");
+
+    const String& ca = a;
+    CORRADE_COMPARE(ca.front(), 'H');
+    CORRADE_COMPARE(ca.back(), 'O');
+    CORRADE_COMPARE(ca[1], 'e');
+    CORRADE_COMPARE(static_cast<const void*>(ca.begin()), ca.data());
+    CORRADE_COMPARE(static_cast<const void*>(ca.end()), ca.data() + 5);
+    CORRADE_COMPARE(static_cast<const void*>(a.cend()), a.data() + 5);
+}
+
+void StringTest::accessInvalid() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    String a;
+    a.front();
+    a.back();
+    CORRADE_COMPARE(out.str(),
+        "Containers::String::front(): string is empty\n"
+        "Containers::String::back(): string is empty\n");
+}
+
+void StringTest::slice() {
+    String a = "hello world";
+    CORRADE_COMPARE(StringView{a.slice(2, 7)}, "llo w");
+    CORRADE_COMPARE(StringView{a.prefix(5)}, "hello");
+    CORRADE_COMPARE(StringView{a.suffix(6)}, "world");
+    CORRADE_COMPARE(StringView{a.except(6)}, "hello");
+    CORRADE_COMPARE(StringView{a.prefix(a.data() + 5)}, "hello");
+    CORRADE_COMPARE(StringView{a.suffix(a.data() + 6)}, "world");
+
+    const String& ca = a;
+    CORRADE_COMPARE(ca.slice(2, 7), "llo w");
+    CORRADE_COMPARE(ca.prefix(5), "hello");
+    CORRADE_COMPARE(ca.suffix(6), "world");
+    CORRADE_COMPARE(ca.except(6), "hello");
+
+    MutableStringView b = a.suffix(6);
+    b[0] = 'W';
+    CORRADE_COMPARE(a, "hello World");
+    CORRADE_COMPARE(ca.slice(ca.data() + 2, ca.data() + 7), "llo W");
+}
+
+void StringTest::release() {
+    String a = Large;
+    const char* data = a.data();
+    char* released = a.release();
+    CORRADE_COMPARE(static_cast<const void*>(released), data);
+    CORRADE_VERIFY(a.isSmall());
+    CORRADE_VERIFY(a.empty());
+    delete[] released;
+}
+
+void StringTest::releaseSmall() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    String a = Small;
+    a.release();
+    CORRADE_COMPARE(out.str(), "Containers::String::release(): cannot call on a SSO instance\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::StringTest)
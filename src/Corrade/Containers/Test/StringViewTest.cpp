@@ -0,0 +1,860 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <vector>
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Containers/GrowableArray.h"
+#include "Corrade/Containers/StaticArray.h"
+#include "Corrade/Containers/String.h"
+#include "Corrade/Containers/StringView.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Container.h"
+#include "Corrade/Utility/DebugStl.h"
+
+namespace Corrade { namespace Containers { namespace Test { namespace {
+
+struct StringViewTest: TestSuite::Tester {
+    explicit StringViewTest();
+
+    void constructDefault();
+    void construct();
+    void constructConstexpr();
+    void constructPointer();
+    void constructPointerNull();
+    void constructFromMutable();
+    void constructLiteral();
+
+    void convertArrayView();
+    void convertArrayViewConst();
+    void convertFromArrayView();
+
+    void compareEquality();
+    void compareOrder();
+
+    void access();
+    void accessMutable();
+    void accessInvalid();
+
+    void slice();
+    void sliceInvalid();
+    void slicePointer();
+
+    void split();
+    void splitWithoutEmptyParts();
+    void splitWithoutEmptyPartsMultipleCharacters();
+    void splitMutable();
+    void splitWithoutEmptyPartsLong();
+    void lazySplit();
+    void lazySplitWithoutEmptyParts();
+    void lazySplitWithoutEmptyPartsMultipleCharacters();
+    void lazySplitMutable();
+    void lazySplitIterator();
+
+    void partition();
+    void partitionMultipleCharacters();
+    void rpartition();
+    void rpartitionMultipleCharacters();
+
+    void join();
+    void joinWithoutEmptyParts();
+
+    void hasPrefix();
+    void hasSuffix();
+    void exceptPrefix();
+    void exceptPrefixInvalid();
+    void exceptSuffix();
+    void exceptSuffixInvalid();
+
+    void trimmed();
+    void trimmedPrefix();
+    void trimmedSuffix();
+    void trimmedLong();
+    void trimmedLargeCharacterSet();
+
+    void find();
+    void findCharacter();
+    void contains();
+
+    void debug();
+
+    void benchmarkTrimmed();
+    void benchmarkTrimmedLargeCharacterSet();
+    void benchmarkSplitWithoutEmptyParts();
+    void benchmarkLazySplitWithoutEmptyParts();
+};
+
+StringViewTest::StringViewTest() {
+    addTests({&StringViewTest::constructDefault,
+              &StringViewTest::construct,
+              &StringViewTest::constructConstexpr,
+              &StringViewTest::constructPointer,
+              &StringViewTest::constructPointerNull,
+              &StringViewTest::constructFromMutable,
+              &StringViewTest::constructLiteral,
+
+              &StringViewTest::convertArrayView,
+              &StringViewTest::convertArrayViewConst,
+              &StringViewTest::convertFromArrayView,
+
+              &StringViewTest::compareEquality,
+              &StringViewTest::compareOrder,
+
+              &StringViewTest::access,
+              &StringViewTest::accessMutable,
+              &StringViewTest::accessInvalid,
+
+              &StringViewTest::slice,
+              &StringViewTest::sliceInvalid,
+              &StringViewTest::slicePointer,
+
+              &StringViewTest::split,
+              &StringViewTest::splitWithoutEmptyParts,
+              &StringViewTest::splitWithoutEmptyPartsMultipleCharacters,
+              &StringViewTest::splitMutable,
+              &StringViewTest::splitWithoutEmptyPartsLong,
+              &StringViewTest::lazySplit,
+              &StringViewTest::lazySplitWithoutEmptyParts,
+              &StringViewTest::lazySplitWithoutEmptyPartsMultipleCharacters,
+              &StringViewTest::lazySplitMutable,
+              &StringViewTest::lazySplitIterator,
+
+              &StringViewTest::partition,
+              &StringViewTest::partitionMultipleCharacters,
+              &StringViewTest::rpartition,
+              &StringViewTest::rpartitionMultipleCharacters,
+
+              &StringViewTest::join,
+              &StringViewTest::joinWithoutEmptyParts,
+
+              &StringViewTest::hasPrefix,
+              &StringViewTest::hasSuffix,
+              &StringViewTest::exceptPrefix,
+              &StringViewTest::exceptPrefixInvalid,
+              &StringViewTest::exceptSuffix,
+              &StringViewTest::exceptSuffixInvalid,
+
+              &StringViewTest::trimmed,
+              &StringViewTest::trimmedPrefix,
+              &StringViewTest::trimmedSuffix,
+              &StringViewTest::trimmedLong,
+              &StringViewTest::trimmedLargeCharacterSet,
+
+              &StringViewTest::find,
+              &StringViewTest::findCharacter,
+              &StringViewTest::contains,
+
+              &StringViewTest::debug});
+
+    addBenchmarks({&StringViewTest::benchmarkTrimmed,
+                   &StringViewTest::benchmarkTrimmedLargeCharacterSet,
+                   &StringViewTest::benchmarkSplitWithoutEmptyParts,
+                   &StringViewTest::benchmarkLazySplitWithoutEmptyParts}, 50);
+}
+
+using namespace Literals;
+
+void StringViewTest::constructDefault() {
+    const StringView view;
+    CORRADE_VERIFY(!view.data());
+    CORRADE_COMPARE(view.size(), 0);
+    CORRADE_VERIFY(view.empty());
+
+    const StringView null = nullptr;
+    CORRADE_VERIFY(!null.data());
+    CORRADE_VERIFY(null.empty());
+
+    constexpr StringView cview;
+    constexpr const char* data = cview.data();
+    CORRADE_VERIFY(!data);
+}
+
+void StringViewTest::construct() {
+    const char* string = "hello\0world";
+    const StringView view{string, 11};
+    CORRADE_COMPARE(static_cast<const void*>(view.data()), string);
+    CORRADE_COMPARE(view.size(), 11);
+    CORRADE_VERIFY(!view.empty());
+}
+
+constexpr const char Hello[] = "hello";
+
+void StringViewTest::constructConstexpr() {
+    constexpr StringView view{Hello, 5};
+    constexpr const char* data = view.data();
+    constexpr std::size_t size = view.size();
+    constexpr bool empty = view.empty();
+    constexpr char e = view[1];
+    CORRADE_COMPARE(static_cast<const void*>(data), Hello);
+    CORRADE_COMPARE(size, 5);
+    CORRADE_VERIFY(!empty);
+    CORRADE_COMPARE(e, 'e');
+}
+
+void StringViewTest::constructPointer() {
+    const char* string = "hello\0world";
+    const StringView view = string;
+    CORRADE_COMPARE(static_cast<const void*>(view.data()), string);
+    CORRADE_COMPARE(view.size(), 5);
+}
+
+void StringViewTest::constructPointerNull() {
+    const StringView view = static_cast<const char*>(nullptr);
+    CORRADE_VERIFY(!view.data());
+    CORRADE_COMPARE(view.size(), 0);
+}
+
+void StringViewTest::constructFromMutable() {
+    char data[] = "hello";
+    const MutableStringView a = data;
+    const StringView b = a;
+    CORRADE_COMPARE(static_cast<const void*>(b.data()), data);
+    CORRADE_COMPARE(b.size(), 5);
+
+    CORRADE_VERIFY((std::is_convertible<MutableStringView, StringView>::value));
+    CORRADE_VERIFY(!(std::is_convertible<StringView, MutableStringView>::value));
+}
+
+void StringViewTest::constructLiteral() {
+    constexpr StringView view = "hello\0world"_s;
+    constexpr std::size_t size = view.size();
+    CORRADE_COMPARE(size, 11);
+    CORRADE_COMPARE(view[6], 'w');
+}
+
+void StringViewTest::convertArrayView() {
+    char data[] = "hello";
+    const MutableStringView view = data;
+
+    const ArrayView<char> array = view;
+    CORRADE_COMPARE(static_cast<void*>(array.data()), static_cast<void*>(data));
+    CORRADE_COMPARE(array.size(), 5);
+
+    const ArrayView<const char> carray = view;
+    CORRADE_COMPARE(static_cast<const void*>(carray.data()), data);
+    CORRADE_COMPARE(carray.size(), 5);
+}
+
+void StringViewTest::convertArrayViewConst() {
+    const StringView view = "hello";
+    const ArrayView<const char> array = view;
+    CORRADE_COMPARE(static_cast<const void*>(array.data()), view.data());
+    CORRADE_COMPARE(array.size(), 5);
+
+    CORRADE_VERIFY(!(std::is_convertible<StringView, ArrayView<char>>::value));
+}
+
+void StringViewTest::convertFromArrayView() {
+    char data[] = "hello";
+    const ArrayView<char> array{data, 5};
+
+    const MutableStringView a = array;
+    CORRADE_COMPARE(static_cast<void*>(a.data()), static_cast<void*>(data));
+    CORRADE_COMPARE(a.size(), 5);
+
+    const StringView b = array;
+    CORRADE_COMPARE(static_cast<const void*>(b.data()), data);
+    CORRADE_COMPARE(b.size(), 5);
+
+    CORRADE_VERIFY(!(std::is_convertible<ArrayView<const char>, MutableStringView>::value));
+}
+
+void StringViewTest::compareEquality() {
+    CORRADE_VERIFY("hello"_s == "hello"_s);
+    CORRADE_VERIFY("hello"_s != "hell"_s);
+    CORRADE_VERIFY("hello"_s != "hellO"_s);
+    CORRADE_VERIFY(StringView{} == ""_s);
+    CORRADE_VERIFY("hello\0world"_s != "hello");
+
+    /* Mutable views and C strings on either side */
+    char data[] = "hello";
+    const MutableStringView mutableView = data;
+    CORRADE_VERIFY(mutableView == "hello");
+    CORRADE_VERIFY("hello" == mutableView);
+}
+
+void StringViewTest::compareOrder() {
+    CORRADE_VERIFY("hell"_s < "hello"_s);
+    CORRADE_VERIFY("hello"_s < "help"_s);
+    CORRADE_VERIFY(!("hello"_s < "hello"_s));
+    CORRADE_VERIFY("hello"_s <= "hello"_s);
+    CORRADE_VERIFY("help"_s > "hello"_s);
+    CORRADE_VERIFY("help"_s >= "help"_s);
+    CORRADE_VERIFY(StringView{} < "a"_s);
+    CORRADE_VERIFY(!("a"_s < StringView{}));
+}
+
+void StringViewTest::access() {
+    const StringView view = "hello";
+    CORRADE_COMPARE(view.front(), 'h');
+    CORRADE_COMPARE(view.back(), 'o');
+    CORRADE_COMPARE(view[2], 'l');
+    CORRADE_COMPARE(static_cast<const void*>(view.begin()), view.data());
+    CORRADE_COMPARE(static_cast<const void*>(view.cbegin()), view.data());
+    CORRADE_COMPARE(static_cast<const void*>(view.end()), view.data() + 5);
+    CORRADE_COMPARE(static_cast<const void*>(view.cend()), view.data() + 5);
+
+    std::size_t count = 0;
+    for(char c: view) if(c == 'l') ++count;
+    CORRADE_COMPARE(count, 2);
+}
+
+void StringViewTest::accessMutable() {
+    char data[] = "hello";
+    const MutableStringView view = data;
+    view.front() = 'H';
+    view.back() = 'O';
+    view[2] = 'L';
+    CORRADE_COMPARE(StringView{view}, "HeLlO");
+}
+
+void StringViewTest::accessInvalid() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const StringView view;
+    view.front();
+    view.back();
+    CORRADE_COMPARE(out.str(),
+        "Containers::StringView::front(): view is empty\n"
+        "Containers::StringView::back(): view is empty\n");
+}
+
+void StringViewTest::slice() {
+    const StringView view = "hello world";
+    CORRADE_COMPARE(view.slice(2, 7), "llo w");
+    CORRADE_COMPARE(view.prefix(5), "hello");
+    CORRADE_COMPARE(view.suffix(6), "world");
+    CORRADE_COMPARE(view.except(6), "hello");
+
+    constexpr StringView cview = "hello world"_s;
+    constexpr StringView cprefix = cview.prefix(5);
+    constexpr StringView csuffix = cview.suffix(6);
+    CORRADE_COMPARE(cprefix, "hello");
+    CORRADE_COMPARE(csuffix, "world");
+}
+
+void StringViewTest::sliceInvalid() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const StringView view = "hello";
+    view.slice(3, 2);
+    view.slice(2, 6);
+    view.slice(view.data() - 1, view.data());
+    CORRADE_COMPARE(out.str(),
+        "Containers::StringView::slice(): slice [3:2] out of range for 5 elements\n"
+        "Containers::StringView::slice(): slice [2:6] out of range for 5 elements\n"
+        "Containers::StringView::slice(): slice [-1:0] out of range for 5 elements\n");
+}
+
+void StringViewTest::slicePointer() {
+    const StringView view = "hello world";
+    CORRADE_COMPARE(view.slice(view.data() + 2, view.data() + 7), "llo w");
+    CORRADE_COMPARE(view.prefix(view.data() + 5), "hello");
+    CORRADE_COMPARE(view.suffix(view.data() + 6), "world");
+
+    /* Null pointers give back null views */
+    CORRADE_VERIFY(!view.prefix(static_cast<const char*>(nullptr)).data());
+    CORRADE_VERIFY(!view.suffix(static_cast<const char*>(nullptr)).data());
+}
+
+void StringViewTest::split() {
+    CORRADE_COMPARE_AS(""_s.split('/'),
+        arrayView<StringView>({}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS("abcdef"_s.split('/'),
+        arrayView({"abcdef"_s}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS("ab/c/def"_s.split('/'),
+        arrayView({"ab"_s, "c"_s, "def"_s}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS("/ab//c/def/"_s.split('/'),
+        arrayView({""_s, "ab"_s, ""_s, "c"_s, "def"_s, ""_s}),
+        TestSuite::Compare::Container);
+
+    /* The parts point into the original data */
+    const StringView view = "ab/c";
+    Array<StringView> parts = view.split('/');
+    CORRADE_COMPARE(static_cast<const void*>(parts[1].data()), view.data() + 3);
+}
+
+void StringViewTest::splitWithoutEmptyParts() {
+    CORRADE_COMPARE_AS(""_s.splitWithoutEmptyParts('/'),
+        arrayView<StringView>({}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS("abcdef"_s.splitWithoutEmptyParts('/'),
+        arrayView({"abcdef"_s}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS("//ab//c/def//"_s.splitWithoutEmptyParts('/'),
+        arrayView({"ab"_s, "c"_s, "def"_s}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS("///"_s.splitWithoutEmptyParts('/'),
+        arrayView<StringView>({}),
+        TestSuite::Compare::Container);
+}
+
+void StringViewTest::splitWithoutEmptyPartsMultipleCharacters() {
+    CORRADE_COMPARE_AS("ab.:c:.def."_s.splitWithoutEmptyParts(".:"),
+        arrayView({"ab"_s, "c"_s, "def"_s}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS("\t ab\n\n c  def \r"_s.splitWithoutEmptyParts(),
+        arrayView({"ab"_s, "c"_s, "def"_s}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(" \t\n"_s.splitWithoutEmptyParts(),
+        arrayView<StringView>({}),
+        TestSuite::Compare::Container);
+}
+
+void StringViewTest::splitMutable() {
+    char data[] = "ab/c";
+    const MutableStringView view = data;
+    Array<MutableStringView> parts = view.split('/');
+    CORRADE_COMPARE(parts.size(), 2);
+    parts[1][0] = 'C';
+    CORRADE_COMPARE(StringView{view}, "ab/C");
+}
+
+void StringViewTest::splitWithoutEmptyPartsLong() {
+    /* Parts of varying length separated by runs of delimiters of varying
+       length, to make the boundaries fall both into vectors and scalar
+       remainders */
+    std::string string;
+    std::vector<std::string> expected;
+    for(std::size_t i = 0; i != 40; ++i) {
+        string.append(i % 19 + 1, i % 2 ? ' ' : '\n');
+        expected.emplace_back(i % 23 + 1, char('a' + i % 26));
+        string += expected.back();
+    }
+    string.append(37, '\t');
+
+    const Array<StringView> parts = StringView{string.data(), string.size()}.splitWithoutEmptyParts();
+    CORRADE_COMPARE(parts.size(), expected.size());
+    for(std::size_t i = 0; i != parts.size(); ++i)
+        CORRADE_COMPARE(parts[i], (StringView{expected[i].data(), expected[i].size()}));
+}
+
+template<class T> Array<BasicStringView<T>> collect(const BasicStringSplitIterable<T>& iterable) {
+    Array<BasicStringView<T>> out;
+    for(BasicStringView<T> part: iterable) arrayAppend(out, part);
+    return out;
+}
+
+void StringViewTest::lazySplit() {
+    /* Should give the same results as split() */
+    for(StringView string: {""_s, "abcdef"_s, "ab/c/def"_s, "/ab//c/def/"_s, "/"_s}) {
+        Array<StringView> expected = string.split('/');
+        CORRADE_COMPARE_AS(collect(string.lazySplit('/')),
+            expected, TestSuite::Compare::Container);
+    }
+
+    /* The views point into the original */
+    const StringView view = "ab/c";
+    StringSplitIterator it = view.lazySplit('/').begin();
+    CORRADE_COMPARE(static_cast<const void*>(it->data()), view.data());
+    ++it;
+    CORRADE_COMPARE(static_cast<const void*>(it->data()), view.data() + 3);
+}
+
+void StringViewTest::lazySplitWithoutEmptyParts() {
+    for(StringView string: {""_s, "abcdef"_s, "//ab//c/def//"_s, "///"_s}) {
+        Array<StringView> expected = string.splitWithoutEmptyParts('/');
+        CORRADE_COMPARE_AS(collect(string.lazySplitWithoutEmptyParts('/')),
+            expected, TestSuite::Compare::Container);
+    }
+}
+
+void StringViewTest::lazySplitWithoutEmptyPartsMultipleCharacters() {
+    CORRADE_COMPARE_AS(collect("ab.:c:.def."_s.lazySplitWithoutEmptyParts(".:")),
+        (Array<StringView>{InPlaceInit, {"ab", "c", "def"}}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(collect("\t ab\n\n c  def \r"_s.lazySplitWithoutEmptyParts()),
+        (Array<StringView>{InPlaceInit, {"ab", "c", "def"}}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(collect(" \t\n"_s.lazySplitWithoutEmptyParts()),
+        arrayView<StringView>({}),
+        TestSuite::Compare::Container);
+
+    /* Long input crossing vector boundaries */
+    std::string string;
+    for(std::size_t i = 0; i != 30; ++i) {
+        string.append(i % 7 + 1, ' ');
+        string.append(i % 37 + 1, 'x');
+    }
+    const StringView view{string.data(), string.size()};
+    Array<StringView> expected = view.splitWithoutEmptyParts();
+    CORRADE_COMPARE_AS(collect(view.lazySplitWithoutEmptyParts()),
+        expected, TestSuite::Compare::Container);
+}
+
+void StringViewTest::lazySplitMutable() {
+    char data[] = "ab/c/def";
+    MutableStringView view = data;
+    for(MutableStringView part: view.lazySplit('/'))
+        part[0] = 'X';
+    CORRADE_COMPARE(StringView{view}, "Xb/X/Xef");
+}
+
+void StringViewTest::lazySplitIterator() {
+    const StringSplitIterable parts = "a b  c"_s.lazySplitWithoutEmptyParts(' ');
+    StringSplitIterator a = parts.begin();
+    CORRADE_VERIFY(a == parts.cbegin());
+    CORRADE_VERIFY(a != parts.end());
+    CORRADE_COMPARE(*a, "a");
+
+    StringSplitIterator b = a++;
+    CORRADE_COMPARE(*b, "a");
+    CORRADE_COMPARE(*a, "b");
+    CORRADE_COMPARE(*++a, "c");
+    CORRADE_VERIFY(++a == parts.end());
+    CORRADE_VERIFY(a == StringSplitIterator{});
+
+    /* Stopping early doesn't need to look at the rest */
+    std::size_t count = 0;
+    for(StringView part: "one two three four"_s.lazySplit(' ')) {
+        if(++count == 2) {
+            CORRADE_COMPARE(part, "two");
+            break;
+        }
+    }
+    CORRADE_COMPARE(count, 2);
+}
+
+void StringViewTest::partition() {
+    const StringView view = "ab=c=d";
+    StaticArray<3, StringView> a = view.partition('=');
+    CORRADE_COMPARE(a[0], "ab");
+    CORRADE_COMPARE(a[1], "=");
+    CORRADE_COMPARE(a[2], "c=d");
+    CORRADE_COMPARE(static_cast<const void*>(a[2].data()), view.data() + 3);
+
+    StaticArray<3, StringView> b = view.partition('/');
+    CORRADE_COMPARE(b[0], "ab=c=d");
+    CORRADE_COMPARE(b[1], "");
+    CORRADE_COMPARE(b[2], "");
+    /* The empty parts point to the end */
+    CORRADE_COMPARE(static_cast<const void*>(b[1].data()), view.end());
+    CORRADE_COMPARE(static_cast<const void*>(b[2].data()), view.end());
+
+    StaticArray<3, StringView> c = StringView{}.partition('=');
+    CORRADE_VERIFY(c[0].empty());
+    CORRADE_VERIFY(c[1].empty());
+    CORRADE_VERIFY(c[2].empty());
+}
+
+void StringViewTest::partitionMultipleCharacters() {
+    StaticArray<3, StringView> a = "ab::c::d"_s.partition("::");
+    CORRADE_COMPARE(a[0], "ab");
+    CORRADE_COMPARE(a[1], "::");
+    CORRADE_COMPARE(a[2], "c::d");
+
+    StaticArray<3, StringView> b = "ab:c"_s.partition("::");
+    CORRADE_COMPARE(b[0], "ab:c");
+    CORRADE_COMPARE(b[1], "");
+    CORRADE_COMPARE(b[2], "");
+}
+
+void StringViewTest::rpartition() {
+    const StringView view = "ab=c=d";
+    StaticArray<3, StringView> a = view.rpartition('=');
+    CORRADE_COMPARE(a[0], "ab=c");
+    CORRADE_COMPARE(a[1], "=");
+    CORRADE_COMPARE(a[2], "d");
+
+    StaticArray<3, StringView> b = view.rpartition('/');
+    CORRADE_COMPARE(b[0], "");
+    CORRADE_COMPARE(b[1], "");
+    CORRADE_COMPARE(b[2], "ab=c=d");
+    /* The empty parts point to the beginning */
+    CORRADE_COMPARE(static_cast<const void*>(b[0].data()), view.data());
+    CORRADE_COMPARE(static_cast<const void*>(b[1].data()), view.data());
+}
+
+void StringViewTest::rpartitionMultipleCharacters() {
+    StaticArray<3, StringView> a = "ab::c::d"_s.rpartition("::");
+    CORRADE_COMPARE(a[0], "ab::c");
+    CORRADE_COMPARE(a[1], "::");
+    CORRADE_COMPARE(a[2], "d");
+
+    StaticArray<3, StringView> b = "ab:c"_s.rpartition("::");
+    CORRADE_COMPARE(b[0], "");
+    CORRADE_COMPARE(b[1], "");
+    CORRADE_COMPARE(b[2], "ab:c");
+}
+
+void StringViewTest::join() {
+    CORRADE_COMPARE(", "_s.join({"ab", "", "c", "def"}), "ab, , c, def");
+    CORRADE_COMPARE(", "_s.join({"abc"}), "abc");
+    CORRADE_COMPARE(", "_s.join({}), "");
+    CORRADE_COMPARE(""_s.join({"ab", "c"}), "abc");
+
+    /* Joining into a long string allocates */
+    String long_ = "/"_s.join({"a string that's long enough", "to not fit into SSO"});
+    CORRADE_VERIFY(!long_.isSmall());
+    CORRADE_COMPARE(long_, "a string that's long enough/to not fit into SSO");
+}
+
+void StringViewTest::joinWithoutEmptyParts() {
+    CORRADE_COMPARE(", "_s.joinWithoutEmptyParts({"ab", "", "c", "", "def", ""}), "ab, c, def");
+    CORRADE_COMPARE(", "_s.joinWithoutEmptyParts({"", ""}), "");
+}
+
+void StringViewTest::hasPrefix() {
+    CORRADE_VERIFY("overcomplicated"_s.hasPrefix("over"));
+    CORRADE_VERIFY(!"overcomplicated"_s.hasPrefix("oven"));
+    CORRADE_VERIFY(!"over"_s.hasPrefix("overcomplicated"));
+    CORRADE_VERIFY("overcomplicated"_s.hasPrefix(""));
+    CORRADE_VERIFY(StringView{}.hasPrefix(""));
+    CORRADE_VERIFY(!StringView{}.hasPrefix("a"));
+
+    CORRADE_VERIFY("overcomplicated"_s.hasPrefix('o'));
+    CORRADE_VERIFY(!"overcomplicated"_s.hasPrefix('v'));
+    CORRADE_VERIFY(!StringView{}.hasPrefix('o'));
+}
+
+void StringViewTest::hasSuffix() {
+    CORRADE_VERIFY("overcomplicated"_s.hasSuffix("complicated"));
+    CORRADE_VERIFY(!"overcomplicated"_s.hasSuffix("somplicated"));
+    CORRADE_VERIFY(!"ted"_s.hasSuffix("overcomplicated"));
+    CORRADE_VERIFY("overcomplicated"_s.hasSuffix(""));
+    CORRADE_VERIFY(StringView{}.hasSuffix(""));
+
+    CORRADE_VERIFY("overcomplicated"_s.hasSuffix('d'));
+    CORRADE_VERIFY(!"overcomplicated"_s.hasSuffix('e'));
+    CORRADE_VERIFY(!StringView{}.hasSuffix('d'));
+}
+
+void StringViewTest::exceptPrefix() {
+    const StringView view = "overcomplicated";
+    CORRADE_COMPARE(view.exceptPrefix("over"), "complicated");
+    CORRADE_COMPARE(static_cast<const void*>(view.exceptPrefix("over").data()), view.data() + 4);
+    CORRADE_COMPARE(view.exceptPrefix(""), view);
+}
+
+void StringViewTest::exceptPrefixInvalid() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    "overcomplicated"_s.exceptPrefix("complicated");
+    CORRADE_COMPARE(out.str(), "Containers::StringView::exceptPrefix(): string doesn't begin with complicated\n");
+}
+
+void StringViewTest::exceptSuffix() {
+    const StringView view = "overcomplicated";
+    CORRADE_COMPARE(view.exceptSuffix("complicated"), "over");
+    CORRADE_COMPARE(view.exceptSuffix(""), view);
+}
+
+void StringViewTest::exceptSuffixInvalid() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    "overcomplicated"_s.exceptSuffix("over");
+    CORRADE_COMPARE(out.str(), "Containers::StringView::exceptSuffix(): string doesn't end with over\n");
+}
+
+void StringViewTest::trimmed() {
+    CORRADE_COMPARE(" \t\n abc def \r\v"_s.trimmed(), "abc def");
+    CORRADE_COMPARE("xxabcyy"_s.trimmed("xy"), "abc");
+    CORRADE_COMPARE("  \n"_s.trimmed(), "");
+    CORRADE_COMPARE(StringView{}.trimmed(), "");
+
+    /* Non-ASCII characters, testing the upper bits of the lookup table */
+    CORRADE_COMPARE("\xff\xfe" "abc" "\xfe"_s.trimmed("\xfe\xff"), "abc");
+}
+
+void StringViewTest::trimmedPrefix() {
+    const StringView view = "  abc  ";
+    CORRADE_COMPARE(view.trimmedPrefix(), "abc  ");
+    CORRADE_COMPARE(static_cast<const void*>(view.trimmedPrefix().data()), view.data() + 2);
+    CORRADE_COMPARE("xxabcxx"_s.trimmedPrefix("x"), "abcxx");
+}
+
+void StringViewTest::trimmedSuffix() {
+    const StringView view = "  abc  ";
+    CORRADE_COMPARE(view.trimmedSuffix(), "  abc");
+    CORRADE_COMPARE(static_cast<const void*>(view.trimmedSuffix().data()), view.data());
+    CORRADE_COMPARE("xxabcxx"_s.trimmedSuffix("x"), "xxabc");
+}
+
+void StringViewTest::trimmedLong() {
+    /* Put a non-whitespace character at every position of strings that span
+       several 16- and 32-byte vectors, so all code paths including the
+       remaining scalar bytes get tested */
+    for(std::size_t size: {1, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100}) {
+        for(std::size_t i = 0; i != size; ++i) {
+            std::string string(size, ' ');
+            string[i] = '\xfe';
+            const StringView view{string.data(), string.size()};
+
+            const StringView prefix = view.trimmedPrefix();
+            CORRADE_COMPARE(static_cast<const void*>(prefix.data()), string.data() + i);
+            CORRADE_COMPARE(prefix.size(), size - i);
+
+            const StringView suffix = view.trimmedSuffix();
+            CORRADE_COMPARE(static_cast<const void*>(suffix.data()), string.data());
+            CORRADE_COMPARE(suffix.size(), i + 1);
+        }
+
+        /* All whitespace, with all whitespace characters and also a
+           non-ASCII one that should be trimmed */
+        std::string string(size, '\t');
+        string[size/2] = '\xff';
+        const StringView view{string.data(), string.size()};
+        CORRADE_COMPARE(view.trimmed(" \t\f\v\r\n\xff"), "");
+        CORRADE_COMPARE(static_cast<const void*>(view.trimmedPrefix(" \t\xff").data()), string.data() + size);
+        CORRADE_COMPARE(static_cast<const void*>(view.trimmedSuffix(" \t\xff").data()), string.data());
+    }
+}
+
+void StringViewTest::trimmedLargeCharacterSet() {
+    /* More than 16 characters goes through the scalar path */
+    const StringView characters = " \t\f\v\r\nabcdefghijklm\xff";
+    CORRADE_COMPARE(characters.size(), 20);
+
+    const StringView view = "\xff  abc\tdef  hello world  jam\n\n\xff";
+    CORRADE_COMPARE(view.trimmedPrefix(characters), "o world  jam\n\n\xff");
+    CORRADE_COMPARE(view.trimmedSuffix(characters), "\xff  abc\tdef  hello wor");
+    CORRADE_COMPARE(view.trimmed(characters), "o wor");
+    CORRADE_COMPARE("abc"_s.trimmed(characters), "");
+}
+
+void StringViewTest::find() {
+    const StringView view = "hello world, hello";
+
+    const StringView a = view.find("hello");
+    CORRADE_COMPARE(a, "hello");
+    CORRADE_COMPARE(static_cast<const void*>(a.data()), view.data());
+
+    const StringView b = view.find("lo");
+    CORRADE_COMPARE(static_cast<const void*>(b.data()), view.data() + 3);
+    CORRADE_COMPARE(view.prefix(b.begin()), "hel");
+    CORRADE_COMPARE(view.suffix(b.end()), " world, hello");
+
+    /* Match right at the end */
+    const StringView c = view.find("llo");
+    CORRADE_COMPARE(static_cast<const void*>(c.data()), view.data() + 2);
+    const StringView d = view.find(", hello");
+    CORRADE_COMPARE(static_cast<const void*>(d.data()), view.data() + 11);
+
+    /* Not found, or longer than the string */
+    CORRADE_VERIFY(!view.find("hellO").data());
+    CORRADE_VERIFY(!"hell"_s.find("hello").data());
+    CORRADE_VERIFY(!StringView{}.find("a").data());
+
+    /* Empty substring is found at the beginning */
+    const StringView e = view.find("");
+    CORRADE_COMPARE(static_cast<const void*>(e.data()), view.data());
+    CORRADE_VERIFY(e.empty());
+}
+
+void StringViewTest::findCharacter() {
+    const StringView view = "hello";
+    const StringView a = view.find('l');
+    CORRADE_COMPARE(a, "l");
+    CORRADE_COMPARE(static_cast<const void*>(a.data()), view.data() + 2);
+    CORRADE_VERIFY(!view.find('x').data());
+    CORRADE_VERIFY(!StringView{}.find('x').data());
+}
+
+void StringViewTest::contains() {
+    CORRADE_VERIFY("hello world"_s.contains("o w"));
+    CORRADE_VERIFY(!"hello world"_s.contains("ow"));
+    CORRADE_VERIFY("hello world"_s.contains(""));
+    CORRADE_VERIFY(StringView{}.contains(""));
+    CORRADE_VERIFY("hello world"_s.contains('w'));
+    CORRADE_VERIFY(!"hello world"_s.contains('x'));
+}
+
+void StringViewTest::debug() {
+    std::ostringstream out;
+    Debug{&out} << "hello\0world"_s.prefix(8) << StringView{};
+    CORRADE_COMPARE(out.str(), (std::string{"hello\0wo \n", 10}));
+}
+
+std::string whitespaceHeavyText() {
+    std::string out;
+    for(std::size_t i = 0; i != 1000; ++i) {
+        out.append(i % 37, ' ');
+        out += "key = value";
+        out.append(i % 13, '\t');
+        out += '\n';
+    }
+    return out;
+}
+
+void StringViewTest::benchmarkTrimmed() {
+    std::string string(4096, ' ');
+    string[2048] = 'x';
+    const StringView view{string.data(), string.size()};
+
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(100)
+        size += view.trimmed().size();
+
+    CORRADE_COMPARE(size, 100);
+}
+
+void StringViewTest::benchmarkTrimmedLargeCharacterSet() {
+    std::string string(4096, ' ');
+    string[2048] = 'x';
+    const StringView view{string.data(), string.size()};
+
+    /* Same as above, but with more than 16 characters so it goes through the
+       scalar path */
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(100)
+        size += view.trimmed(" \t\f\v\r\n0123456789AB").size();
+
+    CORRADE_COMPARE(size, 100);
+}
+
+void StringViewTest::benchmarkSplitWithoutEmptyParts() {
+    const std::string string = whitespaceHeavyText();
+    const StringView view{string.data(), string.size()};
+
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(10)
+        count += view.splitWithoutEmptyParts().size();
+
+    CORRADE_COMPARE(count, 30000);
+}
+
+void StringViewTest::benchmarkLazySplitWithoutEmptyParts() {
+    const std::string string = whitespaceHeavyText();
+    const StringView view{string.data(), string.size()};
+
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(10)
+        for(StringView part: view.lazySplitWithoutEmptyParts())
+            count += !part.empty();
+
+    CORRADE_COMPARE(count, 30000);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::StringViewTest)
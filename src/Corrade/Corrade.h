@@ -428,6 +428,20 @@ exposed in CMake because the detection is non-trivial.
 #define CORRADE_TARGET_DINKUMWARE
 #undef CORRADE_TARGET_DINKUMWARE
 
+/**
+@brief Record signal emission statistics in Interconnect
+@m_since_latest
+
+Defined if the @ref Corrade::Interconnect "Interconnect" library records
+per-signal emission statistics, queryable through
+@ref Corrade::Interconnect::Emitter::signalProfile() "Interconnect::Emitter::signalProfile()".
+Enabled using the `INTERCONNECT_PROFILE` CMake option when building Corrade,
+disabled by default.
+@see @ref building-corrade, @ref corrade-cmake
+*/
+#define CORRADE_INTERCONNECT_PROFILE
+#undef CORRADE_INTERCONNECT_PROFILE
+
 /**
 @brief PluginManager doesn't have dynamic plugin support on this platform
 
@@ -38,8 +38,6 @@
 namespace Corrade { namespace Interconnect {
 
 namespace Implementation {
-    struct SignalDataHash;
-
     enum: std::size_t { FunctionPointerSize =
         #ifndef CORRADE_TARGET_WINDOWS
         2*sizeof(void*)/sizeof(std::size_t)
@@ -91,7 +89,6 @@ namespace Implementation {
             /* https://bugzilla.gnome.org/show_bug.cgi?id=776986 */
             #ifndef DOXYGEN_GENERATING_OUTPUT
             friend Interconnect::Emitter;
-            friend SignalDataHash;
             #endif
 
             #ifdef CORRADE_MSVC2019_COMPATIBILITY
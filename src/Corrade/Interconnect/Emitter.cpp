@@ -25,9 +25,25 @@
 
 #include "Emitter.h"
 
+#include <new>
+#ifdef CORRADE_INTERCONNECT_PROFILE
+#include <chrono>
+#endif
+
 #include "Corrade/Interconnect/Receiver.h"
 #include "Corrade/Interconnect/Implementation/ReceiverConnection.h"
 #include "Corrade/Utility/Assert.h"
+#ifdef CORRADE_INTERCONNECT_PROFILE
+#include "Corrade/Utility/Debug.h"
+#endif
+
+/* The pool needs a destructor to free the cached memory on thread exit, which
+   isn't possible with the pre-standard __thread used on old Apple Clang */
+#if defined(CORRADE_BUILD_MULTITHREADED) && defined(__has_feature)
+#if !__has_feature(cxx_thread_local)
+#define CORRADE_INTERCONNECT_NO_CONNECTION_POOL
+#endif
+#endif
 
 namespace Corrade { namespace Interconnect {
 
@@ -37,7 +53,10 @@ ConnectionData::ConnectionData(ConnectionData&& other) noexcept:
     storage(other.storage), /* GCC 4.8 needs () */
     call{other.call},
     lastHandledSignal{other.lastHandledSignal},
-    type{other.type}
+    emitterIndex{other.emitterIndex},
+    receiverIndex{other.receiverIndex},
+    type{other.type},
+    batch{other.batch}
 {
     if(type == ConnectionType::FunctorWithDestructor)
         other.type = ConnectionType::Functor;
@@ -48,7 +67,10 @@ ConnectionData& ConnectionData::operator=(ConnectionData&& other) noexcept {
     swap(storage, other.storage);
     swap(call, other.call);
     swap(lastHandledSignal, other.lastHandledSignal);
+    swap(emitterIndex, other.emitterIndex);
+    swap(receiverIndex, other.receiverIndex);
     swap(type, other.type);
+    swap(batch, other.batch);
     return *this;
 }
 
@@ -57,80 +79,275 @@ ConnectionData::~ConnectionData() {
         storage.functor.destruct(storage);
 }
 
+namespace {
+
+#ifndef CORRADE_INTERCONNECT_NO_CONNECTION_POOL
+/* Free list of memory for ConnectionData, making connect() and disconnect()
+   allocation-free once the pool is warmed up. Each block is a separate heap
+   allocation so it can be freed by a different thread than the one that
+   allocated it. */
+struct ConnectionPool {
+    /* Bounds the amount of memory kept around after a burst of connections
+       gets removed */
+    enum: std::size_t { MaxCount = 4096 };
+
+    struct Block {
+        Block* next;
+    };
+
+    ~ConnectionPool() {
+        while(first) {
+            Block* const next = first->next;
+            ::operator delete(first);
+            first = next;
+        }
+
+        /* A global emitter may get destroyed only after the pool. Deallocate
+           directly from that point on. */
+        count = MaxCount;
+    }
+
+    Block* first;
+    std::size_t count;
+};
+
+static_assert(sizeof(ConnectionData) >= sizeof(ConnectionPool::Block), "connection data too small to be pooled");
+
+#ifdef CORRADE_BUILD_MULTITHREADED
+CORRADE_THREAD_LOCAL
+#endif
+ConnectionPool connectionPool{};
+#endif
+
+ConnectionData* createConnection(ConnectionData&& data) {
+    void* memory;
+    #ifndef CORRADE_INTERCONNECT_NO_CONNECTION_POOL
+    if(connectionPool.first) {
+        memory = connectionPool.first;
+        connectionPool.first = connectionPool.first->next;
+        --connectionPool.count;
+    } else
+    #endif
+    {
+        memory = ::operator new(sizeof(ConnectionData));
+    }
+
+    return new(memory) ConnectionData{std::move(data)};
+}
+
+void destroyConnection(ConnectionData* const data) {
+    data->~ConnectionData();
+
+    #ifndef CORRADE_INTERCONNECT_NO_CONNECTION_POOL
+    if(connectionPool.count < ConnectionPool::MaxCount) {
+        ConnectionPool::Block* const block = reinterpret_cast<ConnectionPool::Block*>(data);
+        block->next = connectionPool.first;
+        connectionPool.first = block;
+        ++connectionPool.count;
+    } else
+    #endif
+    {
+        ::operator delete(data);
+    }
 }
 
+}
+
+}
+
+#ifdef CORRADE_INTERCONNECT_PROFILE
+Utility::Debug& operator<<(Utility::Debug& debug, const SignalProfile& value) {
+    return debug << "Interconnect::SignalProfile(emits:" << value.emitCount
+        << Utility::Debug::nospace << ", connections:" << value.connectionCount
+        << Utility::Debug::nospace << ", slot calls:" << value.slotCallCount
+        << Utility::Debug::nospace << ", total:" << value.totalSlotDuration
+        << "ns, max:" << value.maxSlotDuration << "ns)";
+}
+
+namespace Implementation {
+
+std::uint64_t profileTimestamp() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}
+#endif
+
 Emitter::Emitter(): _lastHandledSignal{0}, _connectionsChanged{false} {}
 
 Emitter::~Emitter() {
-    for(auto& connection: _connections) disconnectFromReceiver(connection.second);
+    for(Implementation::SignalConnections& signal: _signals) {
+        for(Implementation::ConnectionData* connection: signal.connections) {
+            if(!connection) continue;
+            disconnectFromReceiver(*connection);
+            Implementation::destroyConnection(connection);
+        }
+    }
+}
+
+bool Emitter::hasSignalConnections() const {
+    for(const Implementation::SignalConnections& signal: _signals)
+        if(signal.count()) return true;
+    return false;
 }
 
+std::size_t Emitter::signalConnectionCount() const {
+    std::size_t count = 0;
+    for(const Implementation::SignalConnections& signal: _signals)
+        count += signal.count();
+    return count;
+}
+
+#ifdef CORRADE_INTERCONNECT_PROFILE
+void Emitter::resetSignalProfiles() {
+    for(Implementation::SignalConnections& signal: _signals)
+        signal.profile = {};
+}
+#endif
+
 bool Emitter::isConnected(const Connection& connection) const {
-    auto range = _connections.equal_range(connection._signal);
-    for(auto it = range.first; it != range.second; ++it)
-        if(&it->second == &*connection._data) return true;
+    return hasConnection(connection._signal, connection._data);
+}
+
+bool Emitter::hasConnection(const Implementation::SignalData& signal, const Implementation::ConnectionData* const data) const {
+    const Implementation::SignalConnections* found = findSignal(signal);
+    if(!found) return false;
+
+    /* The data pointer might be dangling, so it can't be dereferenced to
+       query its index */
+    for(const Implementation::ConnectionData* i: found->connections)
+        if(i == data) return true;
 
     return false;
 }
 
 Implementation::ConnectionData& Emitter::connectInternal(const Implementation::SignalData& signal, Implementation::ConnectionData&& data) {
-    /* Add connection to emitter */
-    Implementation::ConnectionData& out =
-    _connections.emplace(signal, std::move(data))->second;
+    /* Add connection to emitter, creating a new signal entry if this signal
+       wasn't connected yet. The signal entries are never removed except for
+       destruction so their memory can be reused for new connections. */
+    Implementation::SignalConnections* found = findSignal(signal);
+    if(!found) {
+        _signals.emplace_back(signal);
+        found = &_signals.back();
+    }
+    Implementation::ConnectionData& out = *Implementation::createConnection(std::move(data));
+    out.emitterIndex = found->connections.size();
+    found->connections.append(&out);
     _connectionsChanged = true;
 
     /* Add connection to receiver, if this is member function connection */
-    if(data.type == Implementation::ConnectionType::Member)
-        out.storage.member.receiver->_connections.emplace_back(*this, signal, out);
+    if(out.type == Implementation::ConnectionType::Member || out.type == Implementation::ConnectionType::QueuedMember) {
+        auto& receiverConnections = out.storage.member.receiver->_connections;
+        out.receiverIndex = receiverConnections.size();
+        receiverConnections.emplace_back(*this, std::size_t(found - _signals.data()), out);
+    }
 
     /* Return reference to the final position */
     return out;
 }
 
+namespace {
+
+void clearConnections(Implementation::SignalConnections& signal) {
+    /* Doesn't free the memory, so it can be reused by new connections */
+    signal.connections.removeSuffix(signal.connections.size());
+    signal.removedCount = 0;
+}
+
+void removeConnectionAt(Implementation::SignalConnections& signal, const std::size_t index) {
+    Implementation::ConnectionData** const connections = signal.connections.data();
+    const std::size_t size = signal.connections.size();
+
+    Implementation::destroyConnection(connections[index]);
+    connections[index] = nullptr;
+    ++signal.removedCount;
+
+    /* If everything is removed, clear the array. If more than half is
+       removed, compact it, preserving the order in which the slots are
+       called. That makes the removal O(1) amortized. */
+    if(signal.removedCount == size) clearConnections(signal);
+    else if(2*signal.removedCount > size) {
+        std::size_t j = 0;
+        for(std::size_t i = 0; i != size; ++i) {
+            if(!connections[i]) continue;
+            connections[i]->emitterIndex = j;
+            connections[j++] = connections[i];
+        }
+        signal.connections.removeSuffix(size - j);
+        signal.removedCount = 0;
+    }
+}
+
+}
+
 void Emitter::disconnectInternal(const Implementation::SignalData& signal) {
-    auto range = _connections.equal_range(signal);
-    for(auto it = range.first; it != range.second; ++it)
-        disconnectFromReceiver(it->second);
+    Implementation::SignalConnections* found = findSignal(signal);
+    if(!found) return;
+
+    for(Implementation::ConnectionData* connection: found->connections) {
+        if(!connection) continue;
+        disconnectFromReceiver(*connection);
+        Implementation::destroyConnection(connection);
+    }
 
-    _connections.erase(range.first, range.second);
+    clearConnections(*found);
     _connectionsChanged = true;
 }
 
 void Emitter::disconnectAllSignals() {
-    for(auto it = _connections.begin(); it != _connections.end(); ++it)
-        disconnectFromReceiver(it->second);
+    for(Implementation::SignalConnections& signal: _signals) {
+        for(Implementation::ConnectionData* connection: signal.connections) {
+            if(!connection) continue;
+            disconnectFromReceiver(*connection);
+            Implementation::destroyConnection(connection);
+        }
+
+        clearConnections(signal);
+    }
 
-    _connections.clear();
     _connectionsChanged = true;
 }
 
 void Emitter::disconnectFromReceiver(const Implementation::ConnectionData& data) {
-    if(data.type != Implementation::ConnectionType::Member) return;
+    if(data.type != Implementation::ConnectionType::Member && data.type != Implementation::ConnectionType::QueuedMember) return;
 
+    /* The connection must be found at the recorded index. Order of receiver
+       connections doesn't matter, so move the last one in its place. */
     auto& receiverConnections = data.storage.member.receiver->_connections;
-    for(auto end = receiverConnections.end(), rit = receiverConnections.begin(); rit != end; ++rit) {
-        if(&*rit->data != &data) continue;
-
-        receiverConnections.erase(rit);
-        return;
+    const std::size_t index = data.receiverIndex;
+    CORRADE_INTERNAL_ASSERT(index < receiverConnections.size() && &*receiverConnections[index].data == &data);
+    if(index + 1 != receiverConnections.size()) {
+        receiverConnections[index] = receiverConnections.back();
+        receiverConnections[index].data->receiverIndex = index;
     }
+    receiverConnections.pop_back();
+}
 
-    /* The connection must be found */
-    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+bool Emitter::removeConnection(const Implementation::SignalData& signal, const Implementation::ConnectionData& data) {
+    Implementation::SignalConnections* found = findSignal(signal);
+    if(!found) return false;
+
+    const std::size_t index = data.emitterIndex;
+    if(index >= found->connections.size() || found->connections[index] != &data) return false;
+
+    removeConnectionAt(*found, index);
+    _connectionsChanged = true;
+    return true;
+}
+
+void Emitter::removeConnection(const std::size_t signalIndex, const Implementation::ConnectionData& data) {
+    /* No lookup needed, the receiver knows where the signal is and the
+       connection data are alive so their index can be trusted */
+    CORRADE_INTERNAL_ASSERT(signalIndex < _signals.size() && data.emitterIndex < _signals[signalIndex].connections.size() && _signals[signalIndex].connections[data.emitterIndex] == &data);
+    removeConnectionAt(_signals[signalIndex], data.emitterIndex);
+    _connectionsChanged = true;
 }
 
 bool disconnect(Emitter& emitter, const Connection& connection) {
-    auto range = emitter._connections.equal_range(connection._signal);
-    for(auto it = range.first; it != range.second; ++it) {
-        if(&it->second != &*connection._data) continue;
-
-        emitter.disconnectFromReceiver(it->second);
-        emitter._connections.erase(it);
-        emitter._connectionsChanged = true;
-        return true;
-    }
+    if(!emitter.isConnected(connection)) return false;
 
-    return false;
+    emitter.disconnectFromReceiver(*connection._data);
+    return emitter.removeConnection(connection._signal, *connection._data);
 }
 
 }}
@@ -26,20 +26,66 @@
 */
 
 /** @file
- * @brief Class @ref Corrade::Interconnect::Emitter
+ * @brief Class @ref Corrade::Interconnect::Emitter, struct @ref Corrade::Interconnect::SignalProfile
  */
 
 #include <cstddef>
 #include <cstdint>
 #include <type_traits>
-#include <unordered_map>
 #include <utility>
+#include <vector>
 
+#include "Corrade/Containers/SmallArray.h"
+#include "Corrade/Containers/StridedArrayView.h"
 #include "Corrade/Interconnect/Connection.h"
 #include "Corrade/Utility/Assert.h"
+#include "Corrade/Utility/Utility.h"
 
 namespace Corrade { namespace Interconnect {
 
+#if defined(CORRADE_INTERCONNECT_PROFILE) || defined(DOXYGEN_GENERATING_OUTPUT)
+/**
+@brief Signal emission statistics
+@m_since_latest
+
+Returned by @ref Emitter::signalProfile(). Available only if Corrade is built
+with @ref CORRADE_INTERCONNECT_PROFILE enabled, see
+@ref Interconnect-Emitter-profiling for more information.
+*/
+struct SignalProfile {
+    /**
+     * @brief Emission count
+     *
+     * Each item of a batch passed to @ref Emitter::emitBatch() counts as a
+     * separate emission.
+     */
+    std::uint64_t emitCount{};
+
+    /** @brief Count of slot calls */
+    std::uint64_t slotCallCount{};
+
+    /**
+     * @brief Total time spent in slots in nanoseconds
+     *
+     * For @ref Emitter::emitBatch() the time of calling a slot for the whole
+     * batch is counted as a single slot call.
+     */
+    std::uint64_t totalSlotDuration{};
+
+    /** @brief Longest single slot call in nanoseconds */
+    std::uint64_t maxSlotDuration{};
+
+    /** @brief Count of slots currently connected to the signal */
+    std::size_t connectionCount{};
+};
+
+/**
+@debugoperator{SignalProfile}
+@m_since_latest
+*/
+CORRADE_INTERCONNECT_EXPORT Utility::Debug& operator<<(Utility::Debug& debug, const SignalProfile& value);
+#endif
+
 namespace Implementation {
 
 /* Previously I used std::common_type<T>::type, but that decays inside so
@@ -49,22 +95,49 @@ template<class T> struct Identity {
     typedef T Type;
 };
 
-struct SignalDataHash {
-    std::size_t operator()(const SignalData& data) const {
-        std::size_t hash = 0;
-        for(std::size_t i = 0; i != FunctionPointerSize; ++i)
-            hash ^= data.data[i];
-        return hash;
-    }
+/* View type a batch slot receives for a signal argument of type T */
+template<class T> using BatchView = Containers::StridedArrayView1D<const typename std::decay<T>::type>;
+
+/* Passes a batch element to a slot expecting T. Arguments taken by value get
+   a copy so the slot can't move out of the (const) batch data, arguments
+   taken by a const reference are passed through. */
+template<class T> struct BatchArgument {
+    static_assert(!std::is_reference<T>::value, "batch emission is possible only for signals taking arguments by value or a const reference");
+    static T get(const T& value) { return value; }
+};
+template<class T> struct BatchArgument<const T&> {
+    static const T& get(const T& value) { return value; }
 };
 
 enum class ConnectionType: std::uint8_t {
     Free,
     Member,
+    QueuedMember,
     Functor,
     FunctorWithDestructor
 };
 
+/* A slot call waiting in a receiver mailbox. The process function either
+   calls the slot or just discards the event and then deletes it. */
+struct QueuedEvent {
+    QueuedEvent* next;
+    void(*process)(QueuedEvent*, bool call);
+};
+
+template<class F> struct QueuedEventImpl: QueuedEvent {
+    explicit QueuedEventImpl(F&& f): f{std::move(f)} {
+        process = [](QueuedEvent* event, bool call) {
+            if(call) static_cast<QueuedEventImpl<F>*>(event)->f();
+            delete static_cast<QueuedEventImpl<F>*>(event);
+        };
+    }
+
+    F f;
+};
+
+/* Pushes the event into the receiver mailbox, callable from any thread */
+CORRADE_INTERCONNECT_EXPORT void postQueuedEvent(Receiver& receiver, QueuedEvent* event);
+
 /* Thestd::has_trivial_copy_constructor is deprecated in GCC 5+ but we can't
    detect libstdc++ version when using Clang. The builtins aren't deprecated
    but for those GCC commits suicide with
@@ -100,6 +173,25 @@ struct CORRADE_INTERCONNECT_EXPORT ConnectionData {
         return out;
     }
 
+    /* Construct a queued member function connection. Instead of calling the
+       slot directly, the arguments are copied into an event that's put into
+       the receiver mailbox and the slot is called from
+       Receiver::processEvents(). */
+    template<class Receiver, class ReceiverObject, class ...Args> static ConnectionData createQueuedMember(ReceiverObject& receiver, void(Receiver::*slot)(Args...)) {
+        ConnectionData out{ConnectionType::QueuedMember};
+        reinterpret_cast<void(Receiver::*&)(Args...)>(out.storage.member.data) = slot;
+        out.storage.member.receiver = &receiver;
+        out.call = reinterpret_cast<void(*)()>(static_cast<void(*)(Storage&, Args&&...)>([](Storage& storage, Args&&... args) {
+            ReceiverObject* receiver = static_cast<ReceiverObject*>(storage.member.receiver);
+            void(Receiver::*slot)(Args...) = reinterpret_cast<void(Receiver::*&)(Args...)>(storage.member.data);
+            auto f = [receiver, slot, args...]() mutable {
+                (receiver->*slot)(std::forward<Args>(args)...);
+            };
+            postQueuedEvent(*receiver, new QueuedEventImpl<decltype(f)>{std::move(f)});
+        }));
+        return out;
+    }
+
     /* Construct a free function connection */
     template<class ...Args, class F> static ConnectionData createFunctor(F&& f, typename std::enable_if<std::is_convertible<typename std::decay<F>::type, void(*)(Args...)>::value>::type* = nullptr) {
         ConnectionData out{ConnectionType::Free};
@@ -166,9 +258,48 @@ struct CORRADE_INTERCONNECT_EXPORT ConnectionData {
     Storage storage;
     void(*call)();
     std::uint32_t lastHandledSignal{};
+    /* Position in SignalConnections::connections and
+       Receiver::_connections, for O(1) removal */
+    std::uint32_t emitterIndex{};
+    std::uint32_t receiverIndex{};
     ConnectionType type;
+    /* If set, call takes BatchView<Args>... instead of Args&&... */
+    bool batch{};
+};
+
+/* All connections of a single signal. The connection data are allocated
+   separately from a per-thread pool so their address stays stable for
+   Connection and Receiver, the array of pointers to them is contiguous and
+   for the common case of one or two slots stored inline. Removed connections
+   are set to null and the array is compacted once more than half of it is
+   null. */
+struct SignalConnections {
+    explicit SignalConnections(const SignalData& signal) noexcept: signal{signal} {}
+
+    std::size_t count() const { return connections.size() - removedCount; }
+
+    SignalData signal;
+    Containers::SmallArray<2, ConnectionData*> connections;
+    std::size_t removedCount{};
+    #ifdef CORRADE_INTERCONNECT_PROFILE
+    /* The connectionCount is filled only when queried */
+    SignalProfile profile;
+
+    void recordSlotCall(std::uint64_t duration) {
+        ++profile.slotCallCount;
+        profile.totalSlotDuration += duration;
+        if(duration > profile.maxSlotDuration)
+            profile.maxSlotDuration = duration;
+    }
+    #endif
 };
 
+#ifdef CORRADE_INTERCONNECT_PROFILE
+/* Monotonic time in nanoseconds. Not inline to avoid including <chrono> in
+   the header. */
+CORRADE_INTERCONNECT_EXPORT std::uint64_t profileTimestamp();
+#endif
+
 }
 
 /**
@@ -343,6 +474,46 @@ Convoluted example:
 
 @snippet Interconnect.cpp Emitter-connect-receiver-multiple-inheritance
 
+@section Interconnect-Emitter-profiling Profiling signal emission
+
+If Corrade is built with the `INTERCONNECT_PROFILE` CMake option enabled, the
+@ref CORRADE_INTERCONNECT_PROFILE macro is defined and every emitter records
+how many times each signal was emitted, how many slots it called and how long
+the slots took. The statistics can be queried with @ref signalProfile() and
+printed with @ref Utility::Debug, which helps with deciding which signals are
+worth converting to @ref emitBatch() or to a direct function call:
+
+@snippet Interconnect.cpp Emitter-signalProfile
+
+@code{.shell-session}
+Interconnect::SignalProfile(emits: 240, connections: 3, slot calls: 720, total: 1052310 ns, max: 48120 ns)
+@endcode
+
+Only signals that have or had a slot connected are tracked, emitting a signal
+that was never connected isn't recorded. For slots connected with
+@ref connectQueued() the time spent in @ref Receiver::processEvents() isn't
+included, only the time needed to post the event. The timing is done using a
+monotonic clock around each slot call, which makes the emission noticeably
+slower --- the option is thus meant to be enabled only for profiling builds.
+
+@section Interconnect-Emitter-queued Queued connections across threads
+
+By default, slots are called synchronously from @ref emit(), on the thread
+that emitted the signal. Member function slots can be connected with
+@ref connectQueued() instead, in which case emitting the signal only copies
+the arguments into a lock-free mailbox of the receiver. The slot is called
+later, on whatever thread calls @ref Receiver::processEvents(), usually a main
+loop. Slots are called in the order the signals were emitted in, events coming
+from different threads are interleaved.
+
+@snippet Interconnect.cpp Emitter-connectQueued
+
+Only the delivery is thread-safe --- connecting and disconnecting isn't. Set
+up the connections before the emitting thread starts and remove them after it
+stops emitting. Events already in the mailbox are still delivered after the
+connection is removed, destroying the receiver discards them. Destroying the
+receiver from within a queued slot is not allowed.
+
 @see @ref Receiver, @ref Connection
 @todo Allow move
 */
@@ -380,9 +551,7 @@ class CORRADE_INTERCONNECT_EXPORT Emitter {
          * @see @ref Receiver::hasSlotConnections(), @ref isConnected(),
          *      @ref signalConnectionCount()
          */
-        bool hasSignalConnections() const {
-            return !_connections.empty();
-        }
+        bool hasSignalConnections() const;
 
         /**
          * @brief Whether given signal is connected to any slot
@@ -391,13 +560,14 @@ class CORRADE_INTERCONNECT_EXPORT Emitter {
          *      @ref signalConnectionCount()
          */
         template<class Emitter, class ...Args> bool hasSignalConnections(Signal(Emitter::*signal)(Args...)) const {
-            return _connections.count(
+            const Implementation::SignalConnections* found = findSignal(
                 #ifndef CORRADE_MSVC2019_COMPATIBILITY
                 Implementation::SignalData(signal)
                 #else
                 Implementation::SignalData::create<Emitter, Args...>(signal)
                 #endif
-                ) != 0;
+                );
+            return found && found->count();
         }
 
         /**
@@ -406,7 +576,9 @@ class CORRADE_INTERCONNECT_EXPORT Emitter {
          * Checks if the @ref Connection object returned by @ref connect()
          * still refers to an existing connection. It's the user responsibility
          * to ensure that the @p connection corresponds to proper @ref Emitter
-         * instance.
+         * instance. Memory of removed connections gets reused for new ones,
+         * so a handle of a removed connection may also alias a connection
+         * that was created later.
          * @see @ref hasSignalConnections(),
          *      @ref Receiver::hasSlotConnections(), @ref disconnect()
          */
@@ -418,7 +590,7 @@ class CORRADE_INTERCONNECT_EXPORT Emitter {
          * @see @ref Receiver::slotConnectionCount(),
          *      @ref hasSignalConnections()
          */
-        std::size_t signalConnectionCount() const { return _connections.size(); }
+        std::size_t signalConnectionCount() const;
 
         /**
          * @brief Count of slots connected to given signal
@@ -427,15 +599,52 @@ class CORRADE_INTERCONNECT_EXPORT Emitter {
          *      @ref hasSignalConnections()
          */
         template<class Emitter, class ...Args> std::size_t signalConnectionCount(Signal(Emitter::*signal)(Args...)) const {
-            return _connections.count(
+            const Implementation::SignalConnections* found = findSignal(
+                #ifndef CORRADE_MSVC2019_COMPATIBILITY
+                Implementation::SignalData(signal)
+                #else
+                Implementation::SignalData::create<Emitter, Args...>(signal)
+                #endif
+                );
+            return found ? found->count() : 0;
+        }
+
+        #if defined(CORRADE_INTERCONNECT_PROFILE) || defined(DOXYGEN_GENERATING_OUTPUT)
+        /**
+         * @brief Emission statistics of given signal
+         * @m_since_latest
+         *
+         * If the signal was never connected, returns a zero-initialized
+         * instance. Available only if Corrade is built with
+         * @ref CORRADE_INTERCONNECT_PROFILE enabled, see
+         * @ref Interconnect-Emitter-profiling for more information.
+         * @see @ref resetSignalProfiles()
+         */
+        template<class Emitter, class ...Args> SignalProfile signalProfile(Signal(Emitter::*signal)(Args...)) const {
+            const Implementation::SignalConnections* found = findSignal(
                 #ifndef CORRADE_MSVC2019_COMPATIBILITY
                 Implementation::SignalData(signal)
                 #else
                 Implementation::SignalData::create<Emitter, Args...>(signal)
                 #endif
                 );
+            if(!found) return {};
+            SignalProfile out = found->profile;
+            out.connectionCount = found->count();
+            return out;
         }
 
+        /**
+         * @brief Reset emission statistics of all signals
+         * @m_since_latest
+         *
+         * Available only if Corrade is built with
+         * @ref CORRADE_INTERCONNECT_PROFILE enabled.
+         * @see @ref signalProfile()
+         */
+        void resetSignalProfiles();
+        #endif
+
         /**
          * @brief Disconnect signal
          *
@@ -481,6 +690,27 @@ class CORRADE_INTERCONNECT_EXPORT Emitter {
          */
         template<class Emitter, class ...Args> Signal emit(Signal(Emitter::*signal)(Args...), typename Implementation::Identity<Args>::Type... args);
 
+        /**
+         * @brief Emit signal for a whole batch of arguments
+         * @param signal        Signal
+         * @param batches       Argument batches
+         * @m_since_latest
+         *
+         * Equivalent to calling @ref emit() for each item of @p batches, but
+         * the connected slots are looked up just once and each slot is then
+         * called for all items before proceeding to the next. Slots connected
+         * with @ref connectBatch() get the whole batch in a single call.
+         * Expects that all @p batches have the same size and that the signal
+         * takes at least one argument, all by value or by a
+         * @cpp const @ce reference.
+         *
+         * Use a @ref Containers::StridedArrayView to emit for a member of a
+         * struct array:
+         *
+         * @snippet Interconnect.cpp Emitter-emitBatch
+         */
+        template<class Emitter, class ...Args> Signal emitBatch(Signal(Emitter::*signal)(Args...), const Implementation::BatchView<Args>&... batches);
+
     private:
         /* https://bugzilla.gnome.org/show_bug.cgi?id=776986. Also the class
            docs link to this connect() instead of Interconnect::connect(). Ugh. */
@@ -489,17 +719,43 @@ class CORRADE_INTERCONNECT_EXPORT Emitter {
         friend Receiver;
 
         template<class EmitterObject, class Emitter, class Receiver, class ReceiverObject, class ...Args> friend Connection connect(EmitterObject&, Signal(Emitter::*)(Args...), ReceiverObject&, void(Receiver::*)(Args...));
+        template<class EmitterObject, class Emitter, class Receiver, class ReceiverObject, class ...Args> friend Connection connectQueued(EmitterObject&, Signal(Emitter::*)(Args...), ReceiverObject&, void(Receiver::*)(Args...));
+        template<class EmitterObject, class Emitter, class Functor, class ...Args> friend Connection connectBatch(EmitterObject&, Signal(Emitter::*)(Args...), Functor&&);
+        template<class EmitterObject, class Emitter, class Receiver, class ReceiverObject, class ...Args> friend Connection connectBatch(EmitterObject&, Signal(Emitter::*)(Args...), ReceiverObject&, void(Receiver::*)(Implementation::BatchView<Args>...));
         template<class EmitterObject, class Emitter, class Functor, class ...Args> friend Connection connect(EmitterObject&, Signal(Emitter::*)(Args...), Functor&&);
         friend CORRADE_INTERCONNECT_EXPORT bool disconnect(Emitter&, const Connection&);
+        /* Needs _lastHandledSignal to skip the emission it got connected
+           from */
+        template<class, class, class...> friend class SignalAwaiter;
         #endif
 
-        /* Returns the actual location of the connection in the hashmap */
+        /* Linear search, as there's usually just a handful of distinct
+           signals connected on a single emitter and comparing two pointers
+           is cheaper than hashing */
+        Implementation::SignalConnections* findSignal(const Implementation::SignalData& signal) {
+            for(Implementation::SignalConnections& i: _signals)
+                if(i.signal == signal) return &i;
+            return nullptr;
+        }
+        const Implementation::SignalConnections* findSignal(const Implementation::SignalData& signal) const {
+            return const_cast<Emitter&>(*this).findSignal(signal);
+        }
+
+        /* Returns the actual location of the connection */
         Implementation::ConnectionData& connectInternal(const Implementation::SignalData& signal, Implementation::ConnectionData&& data);
         CORRADE_INTERCONNECT_LOCAL void disconnectFromReceiver(const Implementation::ConnectionData& data);
+        /* Removes and destroys the connection without touching the
+           receiver, returns false if it's not found. The data is expected to
+           be alive, i.e. not coming from a potentially dangling Connection. */
+        CORRADE_INTERCONNECT_LOCAL bool removeConnection(const Implementation::SignalData& signal, const Implementation::ConnectionData& data);
+        /* Same as above but for a connection known to be alive, with the
+           signal entry at given position in _signals. O(1) amortized. */
+        CORRADE_INTERCONNECT_LOCAL void removeConnection(std::size_t signalIndex, const Implementation::ConnectionData& data);
+        bool hasConnection(const Implementation::SignalData& signal, const Implementation::ConnectionData* data) const;
 
         void disconnectInternal(const Implementation::SignalData& signal);
 
-        std::unordered_multimap<Implementation::SignalData, Implementation::ConnectionData, Implementation::SignalDataHash> _connections;
+        std::vector<Implementation::SignalConnections> _signals;
         std::uint32_t _lastHandledSignal;
         bool _connectionsChanged;
 };
@@ -585,6 +841,119 @@ template<class EmitterObject, class Emitter, class Receiver, class ReceiverObjec
         signalData, emitter.connectInternal(signalData, Implementation::ConnectionData::createMember<Receiver, ReceiverObject, Args...>(receiver, slot))};
 }
 
+/** @relatesalso Emitter
+@brief Connect signal to member function slot with queued delivery
+@param emitter       Emitter
+@param signal        Signal
+@param receiver      Receiver
+@param slot          Slot
+@m_since_latest
+
+Same as @ref connect(EmitterObject&, Interconnect::Emitter::Signal(Emitter::*)(Args...), ReceiverObject&, void(Receiver::*)(Args...)),
+but instead of calling @p slot directly, emitting the signal copies the
+arguments into the @p receiver mailbox and the slot gets called by
+@ref Receiver::processEvents(). Argument types thus need to be copyable.
+Emitting the signal and processing the events can happen in different threads
+without any additional synchronization. See
+@ref Interconnect-Emitter-queued "Emitter class documentation" for more
+information.
+@see @ref Emitter::hasSignalConnections(), @ref Connection::isConnected(),
+     @ref Emitter::signalConnectionCount()
+*/
+template<class EmitterObject, class Emitter, class Receiver, class ReceiverObject, class ...Args> Connection connectQueued(EmitterObject& emitter, Interconnect::Emitter::Signal(Emitter::*signal)(Args...), ReceiverObject& receiver, void(Receiver::*slot)(Args...)) {
+    static_assert(sizeof(Interconnect::Emitter::Signal(Emitter::*)(Args...)) <= sizeof(Implementation::SignalData),
+        "Size of member function pointer is incorrectly assumed to be smaller");
+    static_assert(std::is_base_of<Emitter, EmitterObject>::value,
+        "Emitter object doesn't have given signal");
+    static_assert(std::is_base_of<Receiver, ReceiverObject>::value,
+        "Receiver object doesn't have given slot");
+
+    #ifndef CORRADE_MSVC2019_COMPATIBILITY
+    Implementation::SignalData signalData(signal);
+    #else
+    auto signalData = Implementation::SignalData::create<Emitter, Args...>(signal);
+    #endif
+    return Connection{
+        #ifdef CORRADE_BUILD_DEPRECATED
+        emitter,
+        #endif
+        signalData, emitter.connectInternal(signalData, Implementation::ConnectionData::createQueuedMember<Receiver, ReceiverObject, Args...>(receiver, slot))};
+}
+
+/** @relatesalso Emitter
+@brief Connect signal to a function slot accepting a whole batch
+@param emitter       Emitter
+@param signal        Signal
+@param slot          Slot
+@m_since_latest
+
+Similar to @ref connect(EmitterObject&, Interconnect::Emitter::Signal(Emitter::*)(Args...), Functor&&),
+but the @p slot gets a @ref Containers::StridedArrayView1D
+@cpp const @ce view for each signal argument instead. When the signal is
+emitted using @ref Emitter::emitBatch(), the slot is called just once with
+the whole batch, which allows it to process the data in bulk. When the signal
+is emitted using @ref Emitter::emit(), the views have just one item. Expects
+that the signal takes at least one argument.
+
+@snippet Interconnect.cpp connectBatch
+*/
+template<class EmitterObject, class Emitter, class Functor, class ...Args> Connection connectBatch(EmitterObject& emitter, Interconnect::Emitter::Signal(Emitter::*signal)(Args...), Functor&& slot) {
+    static_assert(sizeof(Interconnect::Emitter::Signal(Emitter::*)(Args...)) <= sizeof(Implementation::SignalData),
+        "size of member function pointer is incorrectly assumed to be smaller");
+    static_assert(std::is_base_of<Emitter, EmitterObject>::value,
+        "Emitter object doesn't have given signal");
+    static_assert(sizeof...(Args), "batch slots can be connected only to signals with arguments");
+
+    #ifndef CORRADE_MSVC2019_COMPATIBILITY
+    Implementation::SignalData signalData(signal);
+    #else
+    auto signalData = Implementation::SignalData::create<Emitter, Args...>(signal);
+    #endif
+    Implementation::ConnectionData data = Implementation::ConnectionData::createFunctor<Implementation::BatchView<Args>...>(std::move(slot));
+    data.batch = true;
+    return Connection{
+        #ifdef CORRADE_BUILD_DEPRECATED
+        emitter,
+        #endif
+        signalData, emitter.connectInternal(signalData, std::move(data))};
+}
+
+/** @relatesalso Emitter
+@brief Connect signal to a member function slot accepting a whole batch
+@param emitter       Emitter
+@param signal        Signal
+@param receiver      Receiver
+@param slot          Slot
+@m_since_latest
+
+Similar to @ref connect(EmitterObject&, Interconnect::Emitter::Signal(Emitter::*)(Args...), ReceiverObject&, void(Receiver::*)(Args...)),
+but with the slot receiving @ref Containers::StridedArrayView1D views
+instead of the arguments. See @ref connectBatch(EmitterObject&, Interconnect::Emitter::Signal(Emitter::*)(Args...), Functor&&)
+for more information.
+*/
+template<class EmitterObject, class Emitter, class Receiver, class ReceiverObject, class ...Args> Connection connectBatch(EmitterObject& emitter, Interconnect::Emitter::Signal(Emitter::*signal)(Args...), ReceiverObject& receiver, void(Receiver::*slot)(Implementation::BatchView<Args>...)) {
+    static_assert(sizeof(Interconnect::Emitter::Signal(Emitter::*)(Args...)) <= sizeof(Implementation::SignalData),
+        "Size of member function pointer is incorrectly assumed to be smaller");
+    static_assert(std::is_base_of<Emitter, EmitterObject>::value,
+        "Emitter object doesn't have given signal");
+    static_assert(std::is_base_of<Receiver, ReceiverObject>::value,
+        "Receiver object doesn't have given slot");
+    static_assert(sizeof...(Args), "batch slots can be connected only to signals with arguments");
+
+    #ifndef CORRADE_MSVC2019_COMPATIBILITY
+    Implementation::SignalData signalData(signal);
+    #else
+    auto signalData = Implementation::SignalData::create<Emitter, Args...>(signal);
+    #endif
+    Implementation::ConnectionData data = Implementation::ConnectionData::createMember<Receiver, ReceiverObject, Implementation::BatchView<Args>...>(receiver, slot);
+    data.batch = true;
+    return Connection{
+        #ifdef CORRADE_BUILD_DEPRECATED
+        emitter,
+        #endif
+        signalData, emitter.connectInternal(signalData, std::move(data))};
+}
+
 /** @relatesalso Emitter
 @brief Disconnect a signal/slot connection
 @param emitter      Emitter
@@ -600,41 +969,129 @@ CORRADE_INTERCONNECT_EXPORT bool disconnect(Emitter& emitter, const Connection&
 template<class Emitter_, class ...Args> Emitter::Signal Emitter::emit(Signal(Emitter_::*signal)(Args...), typename Implementation::Identity<Args>::Type... args) {
     _connectionsChanged = false;
     ++_lastHandledSignal;
-    auto range = _connections.equal_range(
-        #ifndef CORRADE_MSVC2019_COMPATIBILITY
-        Implementation::SignalData(signal)
-        #else
-        Implementation::SignalData::create<Emitter_, Args...>(signal)
-        #endif
-        );
-    auto it = range.first;
-    while(it != range.second) {
-        /* Caching this actually helps *immensely* with debug runtime perf */
-        Implementation::ConnectionData& data = it->second;
-
-        /* If not already handled, proceed and mark as such */
-        if(data.lastHandledSignal != _lastHandledSignal) {
+    #ifndef CORRADE_MSVC2019_COMPATIBILITY
+    const Implementation::SignalData signalData(signal);
+    #else
+    const auto signalData = Implementation::SignalData::create<Emitter_, Args...>(signal);
+    #endif
+    Implementation::SignalConnections* found = findSignal(signalData);
+    #ifdef CORRADE_INTERCONNECT_PROFILE
+    if(found) ++found->profile.emitCount;
+    #endif
+    std::size_t i = 0;
+    while(found && i != found->connections.size()) {
+        Implementation::ConnectionData* const connection = found->connections.data()[i];
+
+        /* If not removed and not already handled, proceed and mark as such */
+        if(connection && connection->lastHandledSignal != _lastHandledSignal) {
+            /* Caching this actually helps *immensely* with debug runtime
+               perf */
+            Implementation::ConnectionData& data = *connection;
             data.lastHandledSignal = _lastHandledSignal;
 
-            reinterpret_cast<void(*)(Implementation::ConnectionData::Storage&, Args&&...)>(data.call)(data.storage, std::forward<Args>(args)...);
+            #ifdef CORRADE_INTERCONNECT_PROFILE
+            const std::uint64_t begin = Implementation::profileTimestamp();
+            #endif
 
-            /* Connections changed by the slot, go through again */
+            /* Batch slots get a view on the single item */
+            if(data.batch)
+                reinterpret_cast<void(*)(Implementation::ConnectionData::Storage&, Implementation::BatchView<Args>&&...)>(data.call)(data.storage, Implementation::BatchView<Args>{Containers::ArrayView<const typename std::decay<Args>::type>{&args, 1}}...);
+            else
+                reinterpret_cast<void(*)(Implementation::ConnectionData::Storage&, Args&&...)>(data.call)(data.storage, std::forward<Args>(args)...);
+
+            /* If the slot changed the connections, the signal storage might
+               have been moved. The entry itself is never removed. */
+            #ifdef CORRADE_INTERCONNECT_PROFILE
+            (_connectionsChanged ? findSignal(signalData) : found)->recordSlotCall(Implementation::profileTimestamp() - begin);
+            #endif
+
+            /* Connections changed by the slot, the signal storage might have
+               been moved or removed altogether. Go through again. */
             if(_connectionsChanged) {
-                range = _connections.equal_range(
-                    #ifndef CORRADE_MSVC2019_COMPATIBILITY
-                    Implementation::SignalData(signal)
-                    #else
-                    Implementation::SignalData::create<Emitter_, Args...>(signal)
-                    #endif
-                    );
-                it = range.first;
+                found = findSignal(signalData);
+                i = 0;
+                _connectionsChanged = false;
+                continue;
+            }
+        }
+
+        /* Nothing called or changed, next connection */
+        ++i;
+    }
+
+    return Signal();
+}
+
+template<class Emitter_, class ...Args> Emitter::Signal Emitter::emitBatch(Signal(Emitter_::*signal)(Args...), const Implementation::BatchView<Args>&... batches) {
+    static_assert(sizeof...(Args), "batch emission is possible only for signals with arguments");
+    const std::size_t sizes[]{batches.size()...};
+    const std::size_t size = sizes[0];
+    #ifndef CORRADE_NO_ASSERT
+    for(std::size_t i: sizes)
+        CORRADE_ASSERT(i == size, "Interconnect::Emitter::emitBatch(): expected all batches to have" << size << "items but got" << i, Signal());
+    #endif
+
+    _connectionsChanged = false;
+    ++_lastHandledSignal;
+    #ifndef CORRADE_MSVC2019_COMPATIBILITY
+    const Implementation::SignalData signalData(signal);
+    #else
+    const auto signalData = Implementation::SignalData::create<Emitter_, Args...>(signal);
+    #endif
+    Implementation::SignalConnections* found = findSignal(signalData);
+    #ifdef CORRADE_INTERCONNECT_PROFILE
+    if(found) found->profile.emitCount += size;
+    #endif
+    std::size_t i = 0;
+    while(found && i != found->connections.size()) {
+        Implementation::ConnectionData* const connection = found->connections.data()[i];
+
+        /* If not removed and not already handled, proceed and mark as such */
+        if(connection && connection->lastHandledSignal != _lastHandledSignal) {
+            Implementation::ConnectionData& data = *connection;
+            data.lastHandledSignal = _lastHandledSignal;
+
+            #ifdef CORRADE_INTERCONNECT_PROFILE
+            const std::uint64_t begin = Implementation::profileTimestamp();
+            #endif
+
+            bool changed = false;
+            if(data.batch) {
+                reinterpret_cast<void(*)(Implementation::ConnectionData::Storage&, Implementation::BatchView<Args>&&...)>(data.call)(data.storage, Implementation::BatchView<Args>{batches}...);
+                changed = _connectionsChanged;
+            } else {
+                /* Caching the function pointer for the whole batch */
+                auto call = reinterpret_cast<void(*)(Implementation::ConnectionData::Storage&, Args&&...)>(data.call);
+                for(std::size_t j = 0; j != size; ++j) {
+                    call(data.storage, Implementation::BatchArgument<Args>::get(batches[j])...);
+
+                    /* If the slot disconnected itself, it can't be called
+                       anymore. Its memory might have been reused by a new
+                       connection, so fetch the function pointer again. */
+                    if(_connectionsChanged) {
+                        changed = true;
+                        _connectionsChanged = false;
+                        if(!hasConnection(signalData, &data) || data.batch) break;
+                        call = reinterpret_cast<void(*)(Implementation::ConnectionData::Storage&, Args&&...)>(data.call);
+                    }
+                }
+            }
+
+            #ifdef CORRADE_INTERCONNECT_PROFILE
+            (changed ? findSignal(signalData) : found)->recordSlotCall(Implementation::profileTimestamp() - begin);
+            #endif
+
+            /* Connections changed by the slot, go through again */
+            if(changed) {
+                found = findSignal(signalData);
+                i = 0;
                 _connectionsChanged = false;
                 continue;
             }
         }
 
         /* Nothing called or changed, next connection */
-        ++it;
+        ++i;
     }
 
     return Signal();
@@ -30,11 +30,14 @@
 
 namespace Corrade { namespace Interconnect { namespace Implementation {
 
+/* Position of the signal entry in Emitter::_signals is stored instead of the
+   signal itself, as the entries are never removed and so the receiver can
+   remove the connection without searching for the signal */
 struct ReceiverConnection {
-    explicit ReceiverConnection(Emitter& emitter, Implementation::SignalData signal, Implementation::ConnectionData& data) noexcept: emitter{emitter}, signal{signal}, data{data} {}
+    explicit ReceiverConnection(Emitter& emitter, std::size_t signalIndex, Implementation::ConnectionData& data) noexcept: emitter{emitter}, signalIndex{signalIndex}, data{data} {}
 
     Containers::Reference<Emitter> emitter;
-    Implementation::SignalData signal;
+    std::size_t signalIndex;
     Containers::Reference<Implementation::ConnectionData> data;
 };
 
@@ -38,6 +38,7 @@ namespace Corrade { namespace Interconnect {
 class Connection;
 class Emitter;
 class Receiver;
+template<class, class, class...> class SignalAwaiter;
 
 namespace Implementation {
     struct ConnectionData;
@@ -45,6 +46,9 @@ namespace Implementation {
 }
 
 template<std::size_t, std::size_t, class, class> class StateMachine;
+template<std::size_t, std::size_t, class, class> class StateMachinePool;
+template<class> struct StateMachinePoolChange;
+template<std::size_t, std::size_t, class, class, class...> class StaticStateMachine;
 
 }}
 
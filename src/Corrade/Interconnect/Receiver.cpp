@@ -32,26 +32,66 @@
 
 namespace Corrade { namespace Interconnect {
 
-Receiver::Receiver() = default;
+namespace Implementation {
 
-Receiver::~Receiver() { disconnectAllSlots(); }
+void postQueuedEvent(Receiver& receiver, QueuedEvent* const event) {
+    event->next = receiver._mailbox.load(std::memory_order_relaxed);
+    while(!receiver._mailbox.compare_exchange_weak(event->next, event, std::memory_order_release, std::memory_order_relaxed));
+}
+
+}
+
+Receiver::Receiver(): _mailbox{nullptr} {}
+
+Receiver::~Receiver() {
+    disconnectAllSlots();
+
+    /* Discard events that weren't processed */
+    Implementation::QueuedEvent* event = _mailbox.exchange(nullptr, std::memory_order_acquire);
+    while(event) {
+        Implementation::QueuedEvent* const next = event->next;
+        event->process(event, false);
+        event = next;
+    }
+}
 
 bool Receiver::hasSlotConnections() const { return !_connections.empty(); }
 
 std::size_t Receiver::slotConnectionCount() const { return _connections.size(); }
 
-void Receiver::disconnectAllSlots() {
-    for(Implementation::ReceiverConnection& connection: _connections) {
-        auto range = connection.emitter->_connections.equal_range(connection.signal);
-        for(auto it = range.first; it != range.second; ++it) {
-            if(&it->second != &*connection.data) continue;
-
-            connection.emitter->_connections.erase(it);
-            connection.emitter->_connectionsChanged = true;
-            break;
-        }
+bool Receiver::hasPendingEvents() const {
+    return _mailbox.load(std::memory_order_relaxed);
+}
+
+std::size_t Receiver::processEvents() {
+    /* Take all events at once, so the emitters aren't blocked by this
+       function at all */
+    Implementation::QueuedEvent* event = _mailbox.exchange(nullptr, std::memory_order_acquire);
+
+    /* The mailbox is a stack, reverse it to get the emission order */
+    Implementation::QueuedEvent* reversed = nullptr;
+    std::size_t count = 0;
+    while(event) {
+        Implementation::QueuedEvent* const next = event->next;
+        event->next = reversed;
+        reversed = event;
+        event = next;
+        ++count;
+    }
+
+    while(reversed) {
+        Implementation::QueuedEvent* const next = reversed->next;
+        reversed->process(reversed, true);
+        reversed = next;
     }
 
+    return count;
+}
+
+void Receiver::disconnectAllSlots() {
+    for(Implementation::ReceiverConnection& connection: _connections)
+        connection.emitter->removeConnection(connection.signalIndex, *connection.data);
+
     _connections.clear();
 }
 
@@ -29,6 +29,7 @@
  * @brief Class @ref Corrade::Interconnect::Receiver
  */
 
+#include <atomic>
 #include <cstddef>
 #include <vector>
 
@@ -37,12 +38,22 @@
 
 namespace Corrade { namespace Interconnect {
 
-namespace Implementation { struct ReceiverConnection; }
+namespace Implementation {
+    struct ReceiverConnection;
+    struct QueuedEvent;
+
+    CORRADE_INTERCONNECT_EXPORT void postQueuedEvent(Receiver&, QueuedEvent*);
+}
 
 /**
 @brief Receiver object
 
 Contains member function slots. See @ref interconnect for introduction.
+
+Slots connected using @ref connectQueued() are not called directly when the
+signal is emitted, but only once @ref processEvents() is called. See
+@ref Interconnect-Emitter-queued "Emitter class documentation" for more
+information.
 @see @ref Emitter, @ref Connection
 @todo Allow move
 */
@@ -87,6 +98,30 @@ class CORRADE_INTERCONNECT_EXPORT Receiver {
          */
         void disconnectAllSlots();
 
+        /**
+         * @brief Whether there are any queued events waiting
+         * @m_since_latest
+         *
+         * Returns @cpp true @ce if a signal connected with
+         * @ref connectQueued() was emitted since the last
+         * @ref processEvents() call. Can be called from any thread, the
+         * result is only a snapshot if signals are emitted concurrently.
+         */
+        bool hasPendingEvents() const;
+
+        /**
+         * @brief Process queued events
+         * @m_since_latest
+         *
+         * Calls slots of all signals connected with @ref connectQueued()
+         * that were emitted since the last call, in the order they were
+         * emitted. Events posted by the slots themselves are processed on
+         * the next call. Returns count of processed events. Expected to be
+         * called only from a single thread at a time, signals can be
+         * emitted from other threads concurrently.
+         */
+        std::size_t processEvents();
+
     protected:
         /* Nobody will need to have (and delete) Receiver*, thus this is faster
            than public pure virtual destructor */
@@ -97,9 +132,12 @@ class CORRADE_INTERCONNECT_EXPORT Receiver {
         #ifndef DOXYGEN_GENERATING_OUTPUT
         friend Implementation::ConnectionData;
         friend Emitter;
+        friend void Implementation::postQueuedEvent(Receiver&, Implementation::QueuedEvent*);
         #endif
 
         std::vector<Implementation::ReceiverConnection> _connections;
+        /* Lock-free stack of queued events, most recent first */
+        std::atomic<Implementation::QueuedEvent*> _mailbox;
 };
 
 }}
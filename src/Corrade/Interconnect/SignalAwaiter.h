@@ -0,0 +1,148 @@
+#ifndef Corrade_Interconnect_SignalAwaiter_h
+#define Corrade_Interconnect_SignalAwaiter_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Interconnect::SignalAwaiter, function @ref Corrade::Interconnect::awaitSignal()
+ * @m_since_latest
+ *
+ * Requires C++20 coroutine support.
+ */
+
+#include "Corrade/configure.h"
+
+#if !defined(__cpp_impl_coroutine) && !defined(DOXYGEN_GENERATING_OUTPUT)
+#error this header requires C++20 coroutine support
+#endif
+
+#include <coroutine>
+#include <tuple>
+#include <type_traits>
+
+#include "Corrade/Containers/Optional.h"
+#include "Corrade/Interconnect/Emitter.h"
+
+namespace Corrade { namespace Interconnect {
+
+/**
+@brief Awaitable signal
+@m_since_latest
+
+Returned by @ref awaitSignal(), see its documentation for more information.
+*/
+template<class EmitterObject, class Emitter_, class ...Args> class SignalAwaiter {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Nothing is connected until the awaiter is @cpp co_await @ce'ed.
+         */
+        explicit SignalAwaiter(EmitterObject& emitter, Emitter::Signal(Emitter_::*signal)(Args...)) noexcept: _emitter{emitter}, _signal{signal} {}
+
+        /** @brief Copying is not allowed */
+        SignalAwaiter(const SignalAwaiter&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * If the coroutine is destroyed while waiting for the signal, the
+         * connection is removed.
+         */
+        ~SignalAwaiter() {
+            if(_connection) disconnect(_emitter, *_connection);
+        }
+
+        /** @brief Copying is not allowed */
+        SignalAwaiter& operator=(const SignalAwaiter&) = delete;
+
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        bool await_ready() const noexcept { return false; }
+
+        void await_suspend(const std::coroutine_handle<> handle) {
+            _handle = handle;
+            /* If this is called from a slot (such as when the coroutine was
+               resumed by the same signal and awaits it again), the new
+               connection would get called in the same emission as well.
+               Remember which emission it is to skip it. */
+            _emission = static_cast<Emitter&>(_emitter)._lastHandledSignal;
+            SignalAwaiter* const self = this;
+            _connection = connect(_emitter, _signal, [self](Args... args) {
+                /* Disconnecting destroys this functor, so nothing captured
+                   can be accessed afterwards. The awaiter itself stays alive
+                   until the coroutine is resumed. */
+                SignalAwaiter& awaiter = *self;
+                if(static_cast<Emitter&>(awaiter._emitter)._lastHandledSignal == awaiter._emission)
+                    return;
+                awaiter._arguments.emplace(args...);
+                disconnect(awaiter._emitter, *awaiter._connection);
+                awaiter._connection = Containers::NullOpt;
+                awaiter._handle.resume();
+            });
+        }
+
+        std::tuple<typename std::decay<Args>::type...> await_resume() {
+            return std::move(*_arguments);
+        }
+        #endif
+
+    private:
+        EmitterObject& _emitter;
+        Emitter::Signal(Emitter_::*_signal)(Args...);
+        std::coroutine_handle<> _handle;
+        std::uint32_t _emission;
+        Containers::Optional<Connection> _connection;
+        Containers::Optional<std::tuple<typename std::decay<Args>::type...>> _arguments;
+};
+
+/**
+@brief Await a signal emission
+@param emitter      Emitter
+@param signal       Signal
+@m_since_latest
+
+Returns an awaitable that, when @cpp co_await @ce'ed from a C++20 coroutine,
+connects to @p signal and suspends the coroutine. When the signal is emitted
+next time, the connection is removed and the coroutine is resumed with copies
+of the signal arguments as a @ref std::tuple, which is convenient to use with
+structured bindings:
+
+@snippet Interconnect-cpp20.cpp awaitSignal
+
+The coroutine is resumed from inside @ref Emitter::emit(), i.e. on the thread
+that emitted the signal and before slots connected after the awaiting
+coroutine get called. If the coroutine awaits the same signal again right
+after being resumed, it's resumed only by the next emission, not the one
+that's currently in progress. If the coroutine is destroyed while waiting, the
+connection is removed. The @p emitter is expected to stay alive for as long as
+the coroutine is waiting for the signal.
+*/
+template<class EmitterObject, class Emitter_, class ...Args> SignalAwaiter<EmitterObject, Emitter_, Args...> awaitSignal(EmitterObject& emitter, Emitter::Signal(Emitter_::*signal)(Args...)) {
+    return SignalAwaiter<EmitterObject, Emitter_, Args...>{emitter, signal};
+}
+
+}}
+
+#endif
@@ -26,9 +26,11 @@
 */
 
 /** @file
- * @brief Class @ref Corrade::Interconnect::StateMachine, @ref Corrade::Interconnect::StateTransition
+ * @brief Class @ref Corrade::Interconnect::StateMachine, @ref Corrade::Interconnect::StateTransition, @ref Corrade::Interconnect::StateMachinePool, @ref Corrade::Interconnect::StaticStateMachine, struct @ref Corrade::Interconnect::StateMachinePoolChange, @ref Corrade::Interconnect::StaticStateTransition
  */
 
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Containers/StridedArrayView.h" /* for GenerateSequence */
 #include "Corrade/Interconnect/Emitter.h"
 
 namespace Corrade { namespace Interconnect {
@@ -40,6 +42,7 @@ See @ref StateMachine for more information.
 */
 template<class State, class Input> class StateTransition {
     template<std::size_t, std::size_t, class, class> friend class StateMachine;
+    template<std::size_t, std::size_t, class, class> friend class StateMachinePool;
 
     public:
         /** @brief Constructor */
@@ -254,6 +257,321 @@ template<std::size_t states, std::size_t inputs, class State, class Input> State
     return *this;
 }
 
+/**
+@brief State change in a state machine pool
+@m_since_latest
+
+See @ref StateMachinePool::step() for more information.
+*/
+template<class State> struct StateMachinePoolChange {
+    std::uint32_t index;    /**< Index of the machine in the pool */
+    State from;             /**< State which was exited */
+    State to;               /**< State which was entered */
+};
+
+/**
+@brief Pool of state machines
+@m_since_latest
+
+Stores the current state of many machines sharing the same transitions
+contiguously and steps all of them at once. Compared to having a
+@ref StateMachine for each, there's no @ref Emitter involved --- instead of
+emitting signals, each @ref step() returns a compact list of machines that
+changed their state.
+
+@section Interconnect-StateMachinePool-usage Basic usage
+
+States, inputs and transitions are specified the same way as with
+@ref StateMachine, the only difference is that the constructor takes the
+count of machines in the pool. The states are expected to fit into
+@cpp std::uint8_t @ce.
+
+@snippet Interconnect.cpp StateMachinePool
+
+All machines are stepped with one input per machine, the loop over them has
+no branches and no function calls. State changes are written to a
+preallocated array and the returned view lists them ordered by the machine
+index:
+
+@snippet Interconnect.cpp StateMachinePool-step
+*/
+template<std::size_t states, std::size_t inputs, class State, class Input> class StateMachinePool {
+    static_assert(states <= 256, "states have to fit into a std::uint8_t");
+
+    public:
+        enum: std::size_t {
+            StateCount = states, /**< Count of states in the machines */
+            InputCount = inputs  /**< Count of inputs for the machines */
+        };
+
+        /**
+         * @brief Constructor
+         * @param count     Count of machines in the pool
+         * @param initial   Initial state of all machines
+         *
+         * All states are initially no-op (i.e., given state will not be
+         * changed to anything else for any input).
+         */
+        explicit StateMachinePool(std::size_t count, State initial = State{});
+
+        /** @brief Count of machines in the pool */
+        std::size_t size() const { return _states.size(); }
+
+        /**
+         * @brief Current states of all machines
+         *
+         * Raw values of the @p State enum.
+         */
+        Containers::ArrayView<const std::uint8_t> current() const { return _states; }
+
+        /**
+         * @brief Current state of given machine
+         *
+         * Expects that @p index is less than @ref size().
+         */
+        State current(std::size_t index) const;
+
+        /**
+         * @brief Set current state of given machine
+         *
+         * Expects that @p index is less than @ref size() and @p state is in
+         * bounds. Doesn't cause any state change to be recorded.
+         */
+        void setCurrent(std::size_t index, State state);
+
+        /**
+         * @brief Add transitions to the list
+         *
+         * Expects that all states and inputs are in bounds.
+         */
+        void addTransitions(std::initializer_list<StateTransition<State, Input>> transitions);
+
+        /**
+         * @brief Step all machines
+         * @param input     Input for each machine
+         * @return List of machines that changed their state
+         *
+         * Expects that @p input has the same size as the pool and all inputs
+         * are in bounds. Out-of-bounds inputs are not checked in order to
+         * keep the loop tight and the behavior is undefined in that case. The
+         * returned view is valid until the next @ref step() call.
+         */
+        Containers::ArrayView<const StateMachinePoolChange<State>> step(Containers::ArrayView<const Input> input);
+
+        /**
+         * @brief State changes from the last step
+         *
+         * Same as the view returned from @ref step(). Empty if
+         * @ref step() wasn't called yet.
+         */
+        Containers::ArrayView<const StateMachinePoolChange<State>> changes() const {
+            return _changes.prefix(_changeCount);
+        }
+
+    private:
+        std::uint8_t _transitions[states*inputs];
+        Containers::Array<std::uint8_t> _states;
+        Containers::Array<StateMachinePoolChange<State>> _changes;
+        std::size_t _changeCount;
+};
+
+template<std::size_t states, std::size_t inputs, class State, class Input> StateMachinePool<states, inputs, State, Input>::StateMachinePool(const std::size_t count, const State initial): _transitions{}, _states{Containers::NoInit, count}, _changes{Containers::NoInit, count}, _changeCount{} {
+    CORRADE_ASSERT(static_cast<unsigned long long>(count) <= 0xffffffffull,
+        "Interconnect::StateMachinePool: expected at most 4294967295 machines, got" << count, );
+    CORRADE_ASSERT(std::size_t(initial) < states,
+        "Interconnect::StateMachinePool: out-of-bounds initial state" << std::size_t(initial), );
+
+    /* Make input in all states a no-op */
+    for(std::size_t i = 0; i != states; ++i)
+        for(std::size_t j = 0; j != inputs; ++j)
+            _transitions[i*inputs + j] = std::uint8_t(i);
+
+    for(std::uint8_t& state: _states) state = std::uint8_t(initial);
+}
+
+template<std::size_t states, std::size_t inputs, class State, class Input> State StateMachinePool<states, inputs, State, Input>::current(const std::size_t index) const {
+    CORRADE_ASSERT(index < _states.size(),
+        "Interconnect::StateMachinePool::current(): index" << index << "out of range for" << _states.size() << "machines", {});
+    return State(_states[index]);
+}
+
+template<std::size_t states, std::size_t inputs, class State, class Input> void StateMachinePool<states, inputs, State, Input>::setCurrent(const std::size_t index, const State state) {
+    CORRADE_ASSERT(index < _states.size(),
+        "Interconnect::StateMachinePool::setCurrent(): index" << index << "out of range for" << _states.size() << "machines", );
+    CORRADE_ASSERT(std::size_t(state) < states,
+        "Interconnect::StateMachinePool::setCurrent(): out-of-bounds state" << std::size_t(state), );
+    _states[index] = std::uint8_t(state);
+}
+
+template<std::size_t states, std::size_t inputs, class State, class Input> void StateMachinePool<states, inputs, State, Input>::addTransitions(const std::initializer_list<StateTransition<State, Input>> transitions) {
+    for(const auto transition: transitions) {
+        CORRADE_ASSERT(std::size_t(transition.from) < states && std::size_t(transition.input) < inputs && std::size_t(transition.to) < states, "Interconnect::StateMachinePool: out-of-bounds state, from:" << std::size_t(transition.from) << "input:" << std::size_t(transition.input) << "to:" << std::size_t(transition.to), );
+        _transitions[std::size_t(transition.from)*inputs + std::size_t(transition.input)] = std::uint8_t(transition.to);
+    }
+}
+
+template<std::size_t states, std::size_t inputs, class State, class Input> Containers::ArrayView<const StateMachinePoolChange<State>> StateMachinePool<states, inputs, State, Input>::step(const Containers::ArrayView<const Input> input) {
+    CORRADE_ASSERT(input.size() == _states.size(),
+        "Interconnect::StateMachinePool::step(): expected" << _states.size() << "inputs but got" << input.size(), {});
+
+    /* The change is written unconditionally and the count incremented only if
+       the state differs, so there's no branch in the loop */
+    const std::size_t count = _states.size();
+    std::uint8_t* const current = _states.data();
+    StateMachinePoolChange<State>* const out = _changes.data();
+    const Input* const in = input.data();
+    std::size_t changeCount = 0;
+    for(std::size_t i = 0; i != count; ++i) {
+        const std::uint8_t previous = current[i];
+        const std::uint8_t next = _transitions[std::size_t(previous)*inputs + std::size_t(in[i])];
+        current[i] = next;
+        out[changeCount] = {std::uint32_t(i), State(previous), State(next)};
+        changeCount += previous != next;
+    }
+
+    _changeCount = changeCount;
+    return _changes.prefix(changeCount);
+}
+
+/**
+@brief Compile-time transition between states
+@m_since_latest
+
+See @ref StaticStateMachine for more information.
+*/
+template<class State, class Input, State from, Input input, State to> struct StaticStateTransition {
+    static constexpr State From = from;     /**< Original state */
+    static constexpr Input On = input;      /**< Input */
+    static constexpr State To = to;         /**< State after the transition */
+};
+
+namespace Implementation {
+
+/* No transition matched, the input is a no-op */
+template<class State, class Input> constexpr State staticStateTransition(State current, Input) {
+    return current;
+}
+
+template<class State, class Input, class First, class ...Next> constexpr State staticStateTransition(State current, Input input) {
+    return First::From == current && First::On == input ? First::To :
+        staticStateTransition<State, Input, Next...>(current, input);
+}
+
+template<std::size_t states, std::size_t inputs> constexpr bool staticStateTransitionsInRange() {
+    return true;
+}
+
+template<std::size_t states, std::size_t inputs, class First, class ...Next> constexpr bool staticStateTransitionsInRange() {
+    return std::size_t(First::From) < states && std::size_t(First::On) < inputs && std::size_t(First::To) < states && staticStateTransitionsInRange<states, inputs, Next...>();
+}
+
+template<class State, class Input, std::size_t inputs, class Sequence, class ...Transitions> struct StaticStateTable;
+template<class State, class Input, std::size_t inputs, std::size_t ...sequence, class ...Transitions> struct StaticStateTable<State, Input, inputs, Containers::Implementation::Sequence<sequence...>, Transitions...> {
+    static constexpr State Data[]{staticStateTransition<State, Input, Transitions...>(State(sequence/inputs), Input(sequence%inputs))...};
+};
+
+template<class State, class Input, std::size_t inputs, std::size_t ...sequence, class ...Transitions> constexpr State StaticStateTable<State, Input, inputs, Containers::Implementation::Sequence<sequence...>, Transitions...>::Data[];
+
+}
+
+/**
+@brief Compile-time state machine
+@m_since_latest
+
+A variant of @ref StateMachine where the transitions are template parameters.
+The whole transition table is calculated at compile time and @ref step() is
+just a single lookup into it. Instead of emitting signals, the state changes
+are reported to a handler passed to @ref step(), calls to which get bound
+statically. The instance itself stores just the current state, making it
+suitable for cases where there's a lot of small machines.
+
+@section Interconnect-StaticStateMachine-usage Basic usage
+
+Similarly to @ref StateMachine, define two enums for states and inputs, with
+consecutive values starting from @cpp 0 @ce. Then @cpp typedef @ce the
+machine, listing all transitions as @ref StaticStateTransition types. A
+transition not listed is implicitly a no-op. An alias template makes the list
+more readable:
+
+@snippet Interconnect.cpp StaticStateMachine-typedef
+
+A handler is any object with @cpp exited(State state, State next) @ce,
+@cpp stepped(State previous, State next) @ce and
+@cpp entered(State state, State previous) @ce functions, called in this order
+when the machine switches to a different state. Stepping the machine with it
+then produces the same output as in the @ref StateMachine example:
+
+@snippet Interconnect.cpp StaticStateMachine-step
+
+If there's nothing to react to, the @ref step(Input) overload without a
+handler just switches the state. The transition table is also available at
+compile time through @ref next().
+*/
+template<std::size_t states, std::size_t inputs, class State, class Input, class ...Transitions> class StaticStateMachine {
+    static_assert(Implementation::staticStateTransitionsInRange<states, inputs, Transitions...>(), "out-of-bounds state or input in transitions");
+
+    public:
+        enum: std::size_t {
+            StateCount = states, /**< Count of states in the machine */
+            InputCount = inputs  /**< Count of inputs for the machine */
+        };
+
+        /**
+         * @brief State after given input
+         *
+         * If @p current is out of bounds, the behavior is undefined.
+         */
+        static constexpr State next(State current, Input input) {
+            return Implementation::StaticStateTable<State, Input, inputs, typename Containers::Implementation::GenerateSequence<states*inputs>::Type, Transitions...>::Data[std::size_t(current)*inputs + std::size_t(input)];
+        }
+
+        /**
+         * @brief Constructor
+         *
+         * Default initial state is the one corresponding to @cpp 0 @ce
+         * (i.e., usually the first).
+         */
+        constexpr explicit StaticStateMachine(State initial = State{}) noexcept: _current{initial} {}
+
+        /** @brief Current state */
+        constexpr State current() const { return _current; }
+
+        /**
+         * @brief Step the machine
+         * @return Reference to self (for method chaining)
+         *
+         * Switches current state based on the @p input.
+         */
+        StaticStateMachine<states, inputs, State, Input, Transitions...>& step(Input input) {
+            _current = next(_current, input);
+            return *this;
+        }
+
+        /**
+         * @brief Step the machine and notify a handler
+         * @return Reference to self (for method chaining)
+         *
+         * Switches current state based on the @p input. If the new state is
+         * different from previous one, calls @cpp handler.exited(previous, next) @ce,
+         * @cpp handler.stepped(previous, next) @ce and
+         * @cpp handler.entered(next, previous) @ce, in this order.
+         */
+        template<class Handler> StaticStateMachine<states, inputs, State, Input, Transitions...>& step(Input input, Handler&& handler) {
+            const State previous = _current;
+            const State next = this->next(previous, input);
+            if(next != previous) {
+                handler.exited(previous, next);
+                handler.stepped(previous, next);
+                _current = next;
+                handler.entered(next, previous);
+            }
+            return *this;
+        }
+
+    private:
+        State _current;
+};
+
 }}
 
 #endif
@@ -28,6 +28,7 @@
 #include "Corrade/Containers/Optional.h"
 #include "Corrade/Interconnect/Emitter.h"
 #include "Corrade/Interconnect/Receiver.h"
+#include "Corrade/Interconnect/StateMachine.h"
 #include "Corrade/TestSuite/Tester.h"
 
 namespace Corrade { namespace Interconnect { namespace Test { namespace {
@@ -50,10 +51,16 @@ struct Benchmark: TestSuite::Tester {
     void call1kLambdaHeapConnectionData();
     void call1kMemberConnectionData();
     void callSlotFunction1000x();
+    void callSlotFunctionBatch1000x();
+    void callBatchSlotFunctionBatch1000x();
     void call1kSlotFunctions();
     void call1kSlotLambdas();
     void call1kSlotLambdasHeap();
     void call1kSlotMembers();
+
+    void step1kStateMachine();
+    void step1kStaticStateMachine();
+    void step1kStateMachinePool();
 };
 
 Benchmark::Benchmark() {
@@ -62,11 +69,8 @@ Benchmark::Benchmark() {
 
     addBenchmarks({&Benchmark::destructBaseline,
                    &Benchmark::destruct1kFunctions,
-                   &Benchmark::destruct1kMembersEmitterFirst}, 100);
-
-    /* Takes like two hours on libstdc++:
-       https://gcc.gnu.org/bugzilla/show_bug.cgi?id=41975 */
-    addBenchmarks({&Benchmark::destruct1kMembersReceiverFirst}, 10);
+                   &Benchmark::destruct1kMembersEmitterFirst,
+                   &Benchmark::destruct1kMembersReceiverFirst}, 100);
 
     addBenchmarks({&Benchmark::call1kFunctions,
                    &Benchmark::call1kStdFunctions,
@@ -75,10 +79,16 @@ Benchmark::Benchmark() {
                    &Benchmark::call1kLambdaHeapConnectionData,
                    &Benchmark::call1kMemberConnectionData,
                    &Benchmark::callSlotFunction1000x,
+                   &Benchmark::callSlotFunctionBatch1000x,
+                   &Benchmark::callBatchSlotFunctionBatch1000x,
                    &Benchmark::call1kSlotFunctions,
                    &Benchmark::call1kSlotLambdas,
                    &Benchmark::call1kSlotLambdasHeap,
                    &Benchmark::call1kSlotMembers}, 25);
+
+    addBenchmarks({&Benchmark::step1kStateMachine,
+                   &Benchmark::step1kStaticStateMachine,
+                   &Benchmark::step1kStateMachinePool}, 25);
 }
 
 int gloablOutput;
@@ -302,6 +312,54 @@ void Benchmark::callSlotFunction1000x() {
     CORRADE_COMPARE(gloablOutput, 1000*100);
 }
 
+CORRADE_NEVER_INLINE void freeFunctionSlotValue(int value) {
+    gloablOutput += value;
+}
+
+CORRADE_NEVER_INLINE void freeFunctionSlotValues(Containers::StridedArrayView1D<const int> values) {
+    for(int value: values) gloablOutput += value;
+}
+
+struct BatchEmitter: Emitter {
+    Signal fire(int value) {
+        return emit(&BatchEmitter::fire, value);
+    }
+
+    Signal fireBatch(Containers::StridedArrayView1D<const int> values) {
+        return emitBatch(&BatchEmitter::fire, values);
+    }
+};
+
+void Benchmark::callSlotFunctionBatch1000x() {
+    gloablOutput = 0;
+
+    BatchEmitter emitter;
+    connect(emitter, &BatchEmitter::fire, freeFunctionSlotValue);
+
+    int values[1000];
+    for(int& i: values) i = 1;
+
+    CORRADE_BENCHMARK(100)
+        emitter.fireBatch(values);
+
+    CORRADE_COMPARE(gloablOutput, 1000*100);
+}
+
+void Benchmark::callBatchSlotFunctionBatch1000x() {
+    gloablOutput = 0;
+
+    BatchEmitter emitter;
+    connectBatch(emitter, &BatchEmitter::fire, freeFunctionSlotValues);
+
+    int values[1000];
+    for(int& i: values) i = 1;
+
+    CORRADE_BENCHMARK(100)
+        emitter.fireBatch(values);
+
+    CORRADE_COMPARE(gloablOutput, 1000*100);
+}
+
 void Benchmark::call1kSlotFunctions() {
     gloablOutput = 0;
 
@@ -383,6 +441,90 @@ void Benchmark::call1kSlotMembers() {
     CORRADE_COMPARE(receiver.output, 1000*100);
 }
 
+enum class State: std::uint8_t {
+    Idle,
+    Walking,
+    Running
+};
+
+enum class Input: std::uint8_t {
+    Faster,
+    Slower
+};
+
+void Benchmark::step1kStateMachine() {
+    typedef Interconnect::StateMachine<3, 2, State, Input> Agent;
+    Agent agent;
+    agent.addTransitions({
+        {State::Idle, Input::Faster, State::Walking},
+        {State::Walking, Input::Faster, State::Running},
+        {State::Walking, Input::Slower, State::Idle},
+        {State::Running, Input::Slower, State::Walking}
+    });
+
+    int entered = 0;
+    connect(agent, &Agent::entered<State::Running>, [&entered](State) {
+        ++entered;
+    });
+
+    CORRADE_BENCHMARK(100) {
+        for(std::size_t i = 0; i != 1000; ++i)
+            agent.step(i % 4 < 2 ? Input::Faster : Input::Slower);
+    }
+
+    CORRADE_COMPARE(entered, 250*100);
+}
+
+void Benchmark::step1kStaticStateMachine() {
+    typedef Interconnect::StaticStateMachine<3, 2, State, Input,
+        Interconnect::StaticStateTransition<State, Input, State::Idle, Input::Faster, State::Walking>,
+        Interconnect::StaticStateTransition<State, Input, State::Walking, Input::Faster, State::Running>,
+        Interconnect::StaticStateTransition<State, Input, State::Walking, Input::Slower, State::Idle>,
+        Interconnect::StaticStateTransition<State, Input, State::Running, Input::Slower, State::Walking>> Agent;
+    Agent agent;
+
+    struct Handler {
+        void exited(State, State) {}
+        void stepped(State, State) {}
+        void entered(State state, State) {
+            if(state == State::Running) ++count;
+        }
+
+        int count;
+    } handler{0};
+
+    CORRADE_BENCHMARK(100) {
+        for(std::size_t i = 0; i != 1000; ++i)
+            agent.step(i % 4 < 2 ? Input::Faster : Input::Slower, handler);
+    }
+
+    CORRADE_COMPARE(handler.count, 250*100);
+}
+
+void Benchmark::step1kStateMachinePool() {
+    Interconnect::StateMachinePool<3, 2, State, Input> agents{1000};
+    agents.addTransitions({
+        {State::Idle, Input::Faster, State::Walking},
+        {State::Walking, Input::Faster, State::Running},
+        {State::Walking, Input::Slower, State::Idle},
+        {State::Running, Input::Slower, State::Walking}
+    });
+
+    Containers::Array<Input> faster{Containers::DirectInit, 1000, Input::Faster};
+    Containers::Array<Input> slower{Containers::DirectInit, 1000, Input::Slower};
+
+    /* Same input sequence as above, applied to all machines at once, thus
+       entering the running state once every four steps in all of them */
+    int entered = 0;
+    std::size_t i = 0;
+    CORRADE_BENCHMARK(100) {
+        for(const Interconnect::StateMachinePoolChange<State>& change: agents.step(i++ % 4 < 2 ? faster : slower))
+            if(change.to == State::Running) ++entered;
+    }
+
+    CORRADE_COMPARE(entered, 1000*100/4);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Corrade::Interconnect::Test::Benchmark)
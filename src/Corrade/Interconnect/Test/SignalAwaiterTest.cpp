@@ -0,0 +1,152 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Corrade/Corrade.h"
+
+#include <string>
+
+#include "Corrade/Interconnect/Emitter.h"
+#include "Corrade/Interconnect/SignalAwaiter.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/Utility/DebugStl.h"
+#include "Corrade/Utility/Task.h"
+
+namespace Corrade { namespace Interconnect { namespace Test { namespace {
+
+struct SignalAwaiterTest: TestSuite::Tester {
+    explicit SignalAwaiterTest();
+
+    void await();
+    void awaitNoArguments();
+    void awaitRepeatedly();
+    void destroyWaiting();
+};
+
+SignalAwaiterTest::SignalAwaiterTest() {
+    addTests({&SignalAwaiterTest::await,
+              &SignalAwaiterTest::awaitNoArguments,
+              &SignalAwaiterTest::awaitRepeatedly,
+              &SignalAwaiterTest::destroyWaiting});
+}
+
+class Postman: public Emitter {
+    public:
+        Signal newMessage(int price, const std::string& message) {
+            return emit(&Postman::newMessage, price, message);
+        }
+
+        Signal paymentRequested() {
+            return emit(&Postman::paymentRequested);
+        }
+};
+
+void SignalAwaiterTest::await() {
+    Postman postman;
+    std::string received;
+    Utility::Task<int> task = [](Postman& postman, std::string& received) -> Utility::Task<int> {
+        auto [price, message] = co_await awaitSignal(postman, &Postman::newMessage);
+        received = message;
+        co_return price;
+    }(postman, received);
+
+    task.start();
+    CORRADE_VERIFY(!task.isDone());
+    CORRADE_VERIFY(postman.hasSignalConnections(&Postman::newMessage));
+
+    postman.newMessage(3, "hello");
+    CORRADE_VERIFY(task.isDone());
+    CORRADE_COMPARE(task.result(), 3);
+    CORRADE_COMPARE(received, "hello");
+
+    /* The connection is removed after the signal is received */
+    CORRADE_VERIFY(!postman.hasSignalConnections());
+}
+
+void SignalAwaiterTest::awaitNoArguments() {
+    Postman postman;
+    Utility::Task<void> task = [](Postman& postman) -> Utility::Task<void> {
+        co_await awaitSignal(postman, &Postman::paymentRequested);
+    }(postman);
+
+    task.start();
+    CORRADE_VERIFY(!task.isDone());
+
+    /* Unrelated signal doesn't resume the coroutine */
+    postman.newMessage(7, "hi");
+    CORRADE_VERIFY(!task.isDone());
+
+    postman.paymentRequested();
+    CORRADE_VERIFY(task.isDone());
+    CORRADE_VERIFY(!postman.hasSignalConnections());
+}
+
+void SignalAwaiterTest::awaitRepeatedly() {
+    Postman postman;
+    std::string received;
+    Utility::Task<void> task = [](Postman& postman, std::string& received) -> Utility::Task<void> {
+        for(;;) {
+            auto [price, message] = co_await awaitSignal(postman, &Postman::newMessage);
+            if(!price) break;
+            received += message;
+        }
+    }(postman, received);
+
+    task.start();
+    CORRADE_VERIFY(!task.isDone());
+
+    /* Awaiting the signal again from inside the emission shouldn't cause the
+       coroutine to be resumed again by the same emission */
+    postman.newMessage(1, "hello");
+    CORRADE_COMPARE(received, "hello");
+    CORRADE_VERIFY(!task.isDone());
+    CORRADE_COMPARE(postman.signalConnectionCount(&Postman::newMessage), 1);
+
+    postman.newMessage(2, " world");
+    CORRADE_COMPARE(received, "hello world");
+
+    postman.newMessage(0, "");
+    CORRADE_VERIFY(task.isDone());
+    CORRADE_VERIFY(!postman.hasSignalConnections());
+}
+
+void SignalAwaiterTest::destroyWaiting() {
+    Postman postman;
+    {
+        Utility::Task<void> task = [](Postman& postman) -> Utility::Task<void> {
+            co_await awaitSignal(postman, &Postman::paymentRequested);
+        }(postman);
+
+        task.start();
+        CORRADE_VERIFY(postman.hasSignalConnections());
+    }
+
+    /* Destroying the waiting coroutine removed the connection */
+    CORRADE_VERIFY(!postman.hasSignalConnections());
+    postman.paymentRequested();
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Interconnect::Test::SignalAwaiterTest)
@@ -27,6 +27,7 @@
 
 #include "Corrade/Interconnect/StateMachine.h"
 #include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Container.h"
 #include "Corrade/Utility/DebugStl.h" /** @todo remove when <sstream> is gone */
 
 namespace Corrade { namespace Interconnect { namespace Test { namespace {
@@ -36,11 +37,31 @@ struct StateMachineTest: TestSuite::Tester {
 
     void signalData();
     void test();
+
+    void staticNext();
+    void staticStep();
+    void staticStepHandler();
+    void staticNoTransitions();
+
+    void pool();
+    void poolSetCurrent();
+    void poolStepWrongInputCount();
+    void poolOutOfBounds();
 };
 
 StateMachineTest::StateMachineTest() {
     addTests({&StateMachineTest::signalData,
-              &StateMachineTest::test});
+              &StateMachineTest::test,
+
+              &StateMachineTest::staticNext,
+              &StateMachineTest::staticStep,
+              &StateMachineTest::staticStepHandler,
+              &StateMachineTest::staticNoTransitions,
+
+              &StateMachineTest::pool,
+              &StateMachineTest::poolSetCurrent,
+              &StateMachineTest::poolStepWrongInputCount,
+              &StateMachineTest::poolOutOfBounds});
 }
 
 enum class State: std::uint8_t {
@@ -55,6 +76,19 @@ enum class Input: std::uint8_t {
 
 typedef Interconnect::StateMachine<2, 2, State, Input> StateMachine;
 
+enum class StaticState: std::uint8_t {
+    Start,
+    Middle,
+    End
+};
+
+typedef Interconnect::StaticStateMachine<3, 2, StaticState, Input,
+    Interconnect::StaticStateTransition<StaticState, Input, StaticState::Start, Input::KeyA, StaticState::Middle>,
+    Interconnect::StaticStateTransition<StaticState, Input, StaticState::Middle, Input::KeyA, StaticState::End>,
+    Interconnect::StaticStateTransition<StaticState, Input, StaticState::Middle, Input::KeyB, StaticState::Start>,
+    Interconnect::StaticStateTransition<StaticState, Input, StaticState::End, Input::KeyB, StaticState::Start>
+> StaticStateMachine;
+
 void StateMachineTest::signalData() {
     #ifndef CORRADE_MSVC2019_COMPATIBILITY
     Implementation::SignalData data1{&StateMachine::entered<State::Start>};
@@ -112,6 +146,193 @@ void StateMachineTest::test() {
                                "start entered, previous 1\n");
 }
 
+void StateMachineTest::staticNext() {
+    CORRADE_COMPARE(StaticStateMachine::StateCount, 3);
+    CORRADE_COMPARE(StaticStateMachine::InputCount, 2);
+
+    constexpr StaticState a = StaticStateMachine::next(StaticState::Start, Input::KeyA);
+    constexpr StaticState b = StaticStateMachine::next(StaticState::Start, Input::KeyB);
+    constexpr StaticState c = StaticStateMachine::next(StaticState::Middle, Input::KeyA);
+    constexpr StaticState d = StaticStateMachine::next(StaticState::Middle, Input::KeyB);
+    constexpr StaticState e = StaticStateMachine::next(StaticState::End, Input::KeyA);
+    constexpr StaticState f = StaticStateMachine::next(StaticState::End, Input::KeyB);
+    CORRADE_COMPARE(std::size_t(a), std::size_t(StaticState::Middle));
+    CORRADE_COMPARE(std::size_t(b), std::size_t(StaticState::Start));
+    CORRADE_COMPARE(std::size_t(c), std::size_t(StaticState::End));
+    CORRADE_COMPARE(std::size_t(d), std::size_t(StaticState::Start));
+    CORRADE_COMPARE(std::size_t(e), std::size_t(StaticState::End));
+    CORRADE_COMPARE(std::size_t(f), std::size_t(StaticState::Start));
+}
+
+void StateMachineTest::staticStep() {
+    constexpr StaticStateMachine cm{StaticState::End};
+    constexpr StaticState current = cm.current();
+    CORRADE_COMPARE(std::size_t(current), std::size_t(StaticState::End));
+
+    StaticStateMachine m;
+    CORRADE_COMPARE(std::size_t(m.current()), std::size_t(StaticState::Start));
+    CORRADE_VERIFY(sizeof(m) == sizeof(StaticState));
+
+    m.step(Input::KeyB);
+    CORRADE_COMPARE(std::size_t(m.current()), std::size_t(StaticState::Start));
+    m.step(Input::KeyA)
+     .step(Input::KeyA);
+    CORRADE_COMPARE(std::size_t(m.current()), std::size_t(StaticState::End));
+    m.step(Input::KeyB);
+    CORRADE_COMPARE(std::size_t(m.current()), std::size_t(StaticState::Start));
+}
+
+void StateMachineTest::staticStepHandler() {
+    struct Handler {
+        void exited(StaticState s, StaticState next) {
+            Debug() << "exited" << std::uint8_t(s) << "next" << std::uint8_t(next);
+        }
+        void stepped(StaticState previous, StaticState next) {
+            Debug() << "going from" << std::uint8_t(previous) << "to" << std::uint8_t(next);
+        }
+        void entered(StaticState s, StaticState previous) {
+            Debug() << "entered" << std::uint8_t(s) << "previous" << std::uint8_t(previous) << "current" << std::uint8_t(m->current());
+        }
+
+        StaticStateMachine* m;
+    };
+
+    StaticStateMachine m;
+    Handler handler{&m};
+
+    std::ostringstream out;
+    Debug redirectDebug{&out};
+
+    /* The first input is a no-op, so nothing gets called */
+    m.step(Input::KeyB, handler)
+     .step(Input::KeyA, handler)
+     .step(Input::KeyB, handler);
+    CORRADE_COMPARE(out.str(), "exited 0 next 1\n"
+                               "going from 0 to 1\n"
+                               "entered 1 previous 0 current 1\n"
+                               "exited 1 next 0\n"
+                               "going from 1 to 0\n"
+                               "entered 0 previous 1 current 0\n");
+}
+
+void StateMachineTest::staticNoTransitions() {
+    typedef Interconnect::StaticStateMachine<3, 2, StaticState, Input> NoTransitions;
+
+    NoTransitions m{StaticState::Middle};
+    m.step(Input::KeyA)
+     .step(Input::KeyB);
+    CORRADE_COMPARE(std::size_t(m.current()), std::size_t(StaticState::Middle));
+}
+
+typedef Interconnect::StateMachinePool<3, 2, StaticState, Input> StateMachinePool;
+
+void StateMachineTest::pool() {
+    StateMachinePool pool{4};
+    pool.addTransitions({
+        {StaticState::Start,    Input::KeyA,    StaticState::Middle},
+        {StaticState::Middle,   Input::KeyA,    StaticState::End},
+        {StaticState::Middle,   Input::KeyB,    StaticState::Start},
+        {StaticState::End,      Input::KeyB,    StaticState::Start}
+    });
+    CORRADE_COMPARE(StateMachinePool::StateCount, 3);
+    CORRADE_COMPARE(StateMachinePool::InputCount, 2);
+    CORRADE_COMPARE(pool.size(), 4);
+    CORRADE_COMPARE(pool.changes().size(), 0);
+    CORRADE_COMPARE_AS(pool.current(),
+        Containers::arrayView<std::uint8_t>({0, 0, 0, 0}),
+        TestSuite::Compare::Container);
+
+    {
+        const Input input[]{Input::KeyA, Input::KeyB, Input::KeyA, Input::KeyB};
+        Containers::ArrayView<const Interconnect::StateMachinePoolChange<StaticState>> changes = pool.step(input);
+        CORRADE_COMPARE_AS(pool.current(),
+            Containers::arrayView<std::uint8_t>({1, 0, 1, 0}),
+            TestSuite::Compare::Container);
+        CORRADE_COMPARE(changes.size(), 2);
+        CORRADE_COMPARE(changes.data(), pool.changes().data());
+        CORRADE_COMPARE(changes.size(), pool.changes().size());
+        CORRADE_COMPARE(changes[0].index, 0);
+        CORRADE_COMPARE(std::size_t(changes[0].from), std::size_t(StaticState::Start));
+        CORRADE_COMPARE(std::size_t(changes[0].to), std::size_t(StaticState::Middle));
+        CORRADE_COMPARE(changes[1].index, 2);
+        CORRADE_COMPARE(std::size_t(changes[1].from), std::size_t(StaticState::Start));
+        CORRADE_COMPARE(std::size_t(changes[1].to), std::size_t(StaticState::Middle));
+    } {
+        const Input input[]{Input::KeyA, Input::KeyB, Input::KeyB, Input::KeyA};
+        Containers::ArrayView<const Interconnect::StateMachinePoolChange<StaticState>> changes = pool.step(input);
+        CORRADE_COMPARE_AS(pool.current(),
+            Containers::arrayView<std::uint8_t>({2, 0, 0, 1}),
+            TestSuite::Compare::Container);
+        CORRADE_COMPARE(changes.size(), 3);
+        CORRADE_COMPARE(changes[0].index, 0);
+        CORRADE_COMPARE(std::size_t(changes[0].from), std::size_t(StaticState::Middle));
+        CORRADE_COMPARE(std::size_t(changes[0].to), std::size_t(StaticState::End));
+        CORRADE_COMPARE(changes[1].index, 2);
+        CORRADE_COMPARE(std::size_t(changes[1].from), std::size_t(StaticState::Middle));
+        CORRADE_COMPARE(std::size_t(changes[1].to), std::size_t(StaticState::Start));
+        CORRADE_COMPARE(changes[2].index, 3);
+        CORRADE_COMPARE(std::size_t(changes[2].from), std::size_t(StaticState::Start));
+        CORRADE_COMPARE(std::size_t(changes[2].to), std::size_t(StaticState::Middle));
+    } {
+        /* Only the last machine has a transition for given input */
+        const Input input[]{Input::KeyA, Input::KeyB, Input::KeyB, Input::KeyB};
+        CORRADE_COMPARE(pool.step(input).size(), 1);
+        CORRADE_COMPARE(pool.changes()[0].index, 3);
+        pool.step(Containers::arrayView({Input::KeyB, Input::KeyB, Input::KeyB, Input::KeyB}));
+        CORRADE_COMPARE_AS(pool.current(),
+            Containers::arrayView<std::uint8_t>({0, 0, 0, 0}),
+            TestSuite::Compare::Container);
+        CORRADE_COMPARE(pool.changes().size(), 1);
+        CORRADE_COMPARE(pool.changes()[0].index, 0);
+        CORRADE_COMPARE(std::size_t(pool.changes()[0].from), std::size_t(StaticState::End));
+        CORRADE_COMPARE(std::size_t(pool.changes()[0].to), std::size_t(StaticState::Start));
+    }
+}
+
+void StateMachineTest::poolSetCurrent() {
+    StateMachinePool pool{3, StaticState::Middle};
+    CORRADE_COMPARE_AS(pool.current(),
+        Containers::arrayView<std::uint8_t>({1, 1, 1}),
+        TestSuite::Compare::Container);
+
+    pool.setCurrent(2, StaticState::End);
+    CORRADE_COMPARE(std::size_t(pool.current(1)), std::size_t(StaticState::Middle));
+    CORRADE_COMPARE(std::size_t(pool.current(2)), std::size_t(StaticState::End));
+
+    /* Without any transitions everything is a no-op */
+    const Input input[]{Input::KeyA, Input::KeyB, Input::KeyA};
+    CORRADE_COMPARE(pool.step(input).size(), 0);
+    CORRADE_COMPARE_AS(pool.current(),
+        Containers::arrayView<std::uint8_t>({1, 1, 2}),
+        TestSuite::Compare::Container);
+}
+
+void StateMachineTest::poolStepWrongInputCount() {
+    StateMachinePool pool{3};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    const Input input[]{Input::KeyA, Input::KeyB};
+    pool.step(input);
+    CORRADE_COMPARE(out.str(), "Interconnect::StateMachinePool::step(): expected 3 inputs but got 2\n");
+}
+
+void StateMachineTest::poolOutOfBounds() {
+    StateMachinePool pool{3};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    pool.current(3);
+    pool.setCurrent(3, StaticState::Start);
+    pool.setCurrent(0, StaticState(3));
+    pool.addTransitions({{StaticState::Start, Input(2), StaticState::End}});
+    CORRADE_COMPARE(out.str(),
+        "Interconnect::StateMachinePool::current(): index 3 out of range for 3 machines\n"
+        "Interconnect::StateMachinePool::setCurrent(): index 3 out of range for 3 machines\n"
+        "Interconnect::StateMachinePool::setCurrent(): out-of-bounds state 3\n"
+        "Interconnect::StateMachinePool: out-of-bounds state, from: 0 input: 2 to: 2\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Corrade::Interconnect::Test::StateMachineTest)
@@ -25,13 +25,20 @@
 
 #include <functional>
 #include <sstream>
+#include <string>
 
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
+
+#include "Corrade/Containers/Optional.h"
 #include "Corrade/Interconnect/Emitter.h"
 #include "Corrade/Interconnect/Receiver.h"
 #include "Corrade/TestSuite/Tester.h"
 #include "Corrade/TestSuite/Compare/SortedContainer.h"
 #include "Corrade/TestSuite/Compare/Numeric.h"
 #include "Corrade/Utility/DebugStl.h"
+#include "Corrade/Utility/System.h"
 
 namespace Corrade { namespace Interconnect { namespace Test { namespace {
 
@@ -53,6 +60,8 @@ struct Test: TestSuite::Tester {
     void disconnectSignal();
     void disconnectEmitter();
     void disconnectReceiver();
+    void disconnectMany();
+    void disconnectReceiverMany();
 
     void destroyEmitter();
     void destroyReceiver();
@@ -62,6 +71,7 @@ struct Test: TestSuite::Tester {
     void emitterMultipleInheritance();
     void emitterMultipleInheritanceVirtual();
     void emitterIdenticalSignals();
+    void emitOrder();
 
     void receiverSubclass();
     void slotInReceiverBase();
@@ -69,6 +79,7 @@ struct Test: TestSuite::Tester {
     void templatedSignal();
 
     void changeConnectionsInSlot();
+    void disconnectInSlot();
     void deleteReceiverInSlot();
 
     void function();
@@ -76,6 +87,27 @@ struct Test: TestSuite::Tester {
     void stdFunction();
 
     void nonCopyableParameter();
+
+    void emitBatch();
+    void emitBatchStruct();
+    void emitBatchSlot();
+    void emitBatchSizeMismatch();
+    void emitBatchDisconnectInSlot();
+
+    void queued();
+    void queuedDisconnected();
+    void queuedDestroyReceiver();
+    void queuedInSlot();
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    void queuedMultithreaded();
+    #endif
+
+    #ifdef CORRADE_INTERCONNECT_PROFILE
+    void profile();
+    void profileBatch();
+    void profileConnectInSlot();
+    void debugSignalProfile();
+    #endif
 };
 
 class Postman: public Interconnect::Emitter {
@@ -150,6 +182,8 @@ Test::Test() {
               &Test::disconnectSignal,
               &Test::disconnectEmitter,
               &Test::disconnectReceiver,
+              &Test::disconnectMany,
+              &Test::disconnectReceiverMany,
 
               &Test::destroyEmitter,
               &Test::destroyReceiver,
@@ -159,6 +193,7 @@ Test::Test() {
               &Test::emitterMultipleInheritance,
               &Test::emitterMultipleInheritanceVirtual,
               &Test::emitterIdenticalSignals,
+              &Test::emitOrder,
 
               &Test::receiverSubclass,
               &Test::slotInReceiverBase,
@@ -166,13 +201,36 @@ Test::Test() {
               &Test::templatedSignal,
 
               &Test::changeConnectionsInSlot,
+              &Test::disconnectInSlot,
               &Test::deleteReceiverInSlot,
 
               &Test::function,
               &Test::capturingLambda,
               &Test::stdFunction,
 
-              &Test::nonCopyableParameter});
+              &Test::nonCopyableParameter,
+
+              &Test::emitBatch,
+              &Test::emitBatchStruct,
+              &Test::emitBatchSlot,
+              &Test::emitBatchSizeMismatch,
+              &Test::emitBatchDisconnectInSlot,
+
+              &Test::queued,
+              &Test::queuedDisconnected,
+              &Test::queuedDestroyReceiver,
+              &Test::queuedInSlot,
+              #ifndef CORRADE_TARGET_EMSCRIPTEN
+              &Test::queuedMultithreaded,
+              #endif
+
+              #ifdef CORRADE_INTERCONNECT_PROFILE
+              &Test::profile,
+              &Test::profileBatch,
+              &Test::profileConnectInSlot,
+              &Test::debugSignalProfile
+              #endif
+              });
 }
 
 void Test::signalData() {
@@ -192,10 +250,6 @@ void Test::signalData() {
     CORRADE_VERIFY(data1 == data2);
     CORRADE_VERIFY(data1 != data3);
     CORRADE_VERIFY(data2 != data3);
-
-    CORRADE_VERIFY(Implementation::SignalDataHash()(data1) == Implementation::SignalDataHash()(data1));
-    CORRADE_VERIFY(Implementation::SignalDataHash()(data1) == Implementation::SignalDataHash()(data2));
-    CORRADE_VERIFY(Implementation::SignalDataHash()(data1) != Implementation::SignalDataHash()(data3));
 }
 
 void Test::templatedSignalData() {
@@ -491,6 +545,101 @@ void Test::disconnectReceiver() {
     CORRADE_COMPARE(mailbox2.slotConnectionCount(), 1);
 }
 
+void Test::disconnectMany() {
+    Postman postman;
+    Mailbox mailbox1, mailbox2;
+    std::vector<int> called;
+
+    /* Interleave receiver and lambda connections */
+    std::vector<Connection> connections;
+    for(int i = 0; i != 10; ++i) {
+        connections.push_back(Interconnect::connect(postman, &Postman::paymentRequested, [&called, i](int) {
+            called.push_back(i);
+        }));
+        Interconnect::connect(postman, &Postman::paymentRequested, i % 2 ? mailbox1 : mailbox2, &Mailbox::pay);
+    }
+    CORRADE_COMPARE(postman.signalConnectionCount(), 20);
+    CORRADE_COMPARE(mailbox1.slotConnectionCount(), 5);
+    CORRADE_COMPARE(mailbox2.slotConnectionCount(), 5);
+
+    /* Removing a few, the rest is still called in order */
+    CORRADE_VERIFY(Interconnect::disconnect(postman, connections[0]));
+    CORRADE_VERIFY(Interconnect::disconnect(postman, connections[3]));
+    CORRADE_VERIFY(Interconnect::disconnect(postman, connections[4]));
+    CORRADE_COMPARE(postman.signalConnectionCount(&Postman::paymentRequested), 17);
+    postman.paymentRequested(1);
+    CORRADE_COMPARE(called, (std::vector<int>{1, 2, 5, 6, 7, 8, 9}));
+    CORRADE_COMPARE(mailbox1.money, -5);
+    CORRADE_COMPARE(mailbox2.money, -5);
+
+    /* Removing more than half, which compacts the storage */
+    mailbox1.disconnectAllSlots();
+    CORRADE_VERIFY(Interconnect::disconnect(postman, connections[6]));
+    CORRADE_VERIFY(Interconnect::disconnect(postman, connections[9]));
+    CORRADE_COMPARE(postman.signalConnectionCount(), 10);
+    CORRADE_VERIFY(postman.isConnected(connections[1]));
+    CORRADE_VERIFY(postman.isConnected(connections[8]));
+    called.clear();
+    postman.paymentRequested(1);
+    CORRADE_COMPARE(called, (std::vector<int>{1, 2, 5, 7, 8}));
+    CORRADE_COMPARE(mailbox1.money, -5);
+    CORRADE_COMPARE(mailbox2.money, -10);
+
+    /* Removing a receiver connection that got moved in the compaction still
+       works */
+    mailbox2.disconnectAllSlots();
+    CORRADE_COMPARE(postman.signalConnectionCount(), 5);
+    CORRADE_VERIFY(Interconnect::disconnect(postman, connections[5]));
+
+    /* Removing everything and connecting again */
+    for(std::size_t i: {1, 2, 7, 8})
+        CORRADE_VERIFY(Interconnect::disconnect(postman, connections[i]));
+    CORRADE_VERIFY(!postman.hasSignalConnections());
+    CORRADE_VERIFY(!postman.hasSignalConnections(&Postman::paymentRequested));
+    CORRADE_COMPARE(postman.signalConnectionCount(), 0);
+
+    Interconnect::connect(postman, &Postman::paymentRequested, mailbox1, &Mailbox::pay);
+    CORRADE_VERIFY(postman.hasSignalConnections());
+    CORRADE_COMPARE(postman.signalConnectionCount(), 1);
+    postman.paymentRequested(1);
+    CORRADE_COMPARE(mailbox1.money, -6);
+}
+
+void Test::disconnectReceiverMany() {
+    Postman postman;
+    Mailbox mailbox1, mailbox2;
+
+    /* The receiver connections are on the second signal entry and
+       interleaved with other connections so removing them compacts the
+       emitter storage in the middle of the receiver teardown */
+    Connection c = Interconnect::connect(postman, &Postman::newMessage, mailbox2, &Mailbox::addMessage);
+    for(std::size_t i = 0; i != 10; ++i) {
+        Interconnect::connect(postman, &Postman::paymentRequested, mailbox1, &Mailbox::pay);
+        Interconnect::connect(postman, &Postman::paymentRequested, i % 3 ? mailbox1 : mailbox2, &Mailbox::pay);
+        Interconnect::connect(postman, &Postman::newMessage, mailbox1, &Mailbox::addMessage);
+    }
+    CORRADE_COMPARE(postman.signalConnectionCount(), 31);
+    CORRADE_COMPARE(mailbox1.slotConnectionCount(), 26);
+    CORRADE_COMPARE(mailbox2.slotConnectionCount(), 5);
+
+    mailbox1.disconnectAllSlots();
+    CORRADE_VERIFY(!mailbox1.hasSlotConnections());
+    CORRADE_COMPARE(mailbox2.slotConnectionCount(), 5);
+    CORRADE_COMPARE(postman.signalConnectionCount(&Postman::newMessage), 1);
+    CORRADE_COMPARE(postman.signalConnectionCount(&Postman::paymentRequested), 4);
+    CORRADE_VERIFY(postman.isConnected(c));
+
+    postman.newMessage(3, "hello");
+    postman.paymentRequested(1);
+    CORRADE_COMPARE(mailbox1.money, 0);
+    CORRADE_COMPARE(mailbox2.money, -1);
+    CORRADE_COMPARE(mailbox2.messages, std::vector<std::string>{"hello"});
+
+    /* The emitter storage is still consistent for the remaining receiver */
+    mailbox2.disconnectAllSlots();
+    CORRADE_VERIFY(!postman.hasSignalConnections());
+}
+
 void Test::destroyEmitter() {
     Postman *postman1 = new Postman;
     Postman postman2;
@@ -683,6 +832,29 @@ void Test::emitterIdenticalSignals() {
         "b tapped!\n");
 }
 
+void Test::emitOrder() {
+    Postman postman;
+    std::vector<int> called;
+
+    /* More than what's stored inline */
+    Containers::Optional<Connection> c;
+    for(int i = 0; i != 5; ++i) {
+        Connection connection = Interconnect::connect(postman, &Postman::paymentRequested, [&called, i](int) {
+            called.push_back(i);
+        });
+        if(i == 1) c = connection;
+    }
+
+    postman.paymentRequested(10);
+    CORRADE_COMPARE(called, (std::vector<int>{0, 1, 2, 3, 4}));
+
+    /* Disconnecting preserves the order of the others */
+    CORRADE_VERIFY(Interconnect::disconnect(postman, *c));
+    called.clear();
+    postman.paymentRequested(10);
+    CORRADE_COMPARE(called, (std::vector<int>{0, 2, 3, 4}));
+}
+
 void Test::receiverSubclass() {
     class BlueMailbox: public Mailbox {
         public:
@@ -818,6 +990,33 @@ void Test::changeConnectionsInSlot() {
     CORRADE_COMPARE(mailbox.money, 19);
 }
 
+void Test::disconnectInSlot() {
+    Postman postman;
+    std::vector<int> called;
+
+    /* The first slot disconnects the second and third one, the fourth should
+       still get called exactly once */
+    Containers::Optional<Connection> c2, c3;
+    Interconnect::connect(postman, &Postman::paymentRequested, [&](int) {
+        called.push_back(1);
+        Interconnect::disconnect(postman, *c2);
+        Interconnect::disconnect(postman, *c3);
+    });
+    c2 = Interconnect::connect(postman, &Postman::paymentRequested, [&called](int) {
+        called.push_back(2);
+    });
+    c3 = Interconnect::connect(postman, &Postman::paymentRequested, [&called](int) {
+        called.push_back(3);
+    });
+    Interconnect::connect(postman, &Postman::paymentRequested, [&called](int) {
+        called.push_back(4);
+    });
+
+    postman.paymentRequested(10);
+    CORRADE_COMPARE(called, (std::vector<int>{1, 4}));
+    CORRADE_COMPARE(postman.signalConnectionCount(), 2);
+}
+
 void Test::deleteReceiverInSlot() {
     class SuicideMailbox: public Interconnect::Receiver {
         public:
@@ -913,6 +1112,452 @@ void Test::nonCopyableParameter() {
     CORRADE_COMPARE(receiver.received, 42);
 }
 
+struct BatchPostman: Interconnect::Emitter {
+    Signal newMessage(int price, const std::string& message) {
+        return emit(&BatchPostman::newMessage, price, message);
+    }
+
+    Signal newMessages(Containers::StridedArrayView1D<const int> prices, Containers::StridedArrayView1D<const std::string> messages) {
+        return emitBatch(&BatchPostman::newMessage, prices, messages);
+    }
+};
+
+void Test::emitBatch() {
+    BatchPostman postman;
+    Mailbox mailbox1, mailbox2;
+    Interconnect::connect(postman, &BatchPostman::newMessage, mailbox1, &Mailbox::addMessage);
+    Interconnect::connect(postman, &BatchPostman::newMessage, mailbox2, &Mailbox::addMessage);
+
+    std::vector<std::string> messages;
+    Interconnect::connect(postman, &BatchPostman::newMessage, [&messages](int, const std::string& message) {
+        messages.push_back(message);
+    });
+
+    const int prices[]{10, 20, 30};
+    const std::string strings[]{"hello", "ahoy", "hi"};
+    postman.newMessages(prices, strings);
+
+    CORRADE_COMPARE(mailbox1.money, 60);
+    CORRADE_COMPARE(mailbox1.messages, (std::vector<std::string>{"hello", "ahoy", "hi"}));
+    CORRADE_COMPARE(mailbox2.money, 60);
+    CORRADE_COMPARE(mailbox2.messages, (std::vector<std::string>{"hello", "ahoy", "hi"}));
+    CORRADE_COMPARE(messages, (std::vector<std::string>{"hello", "ahoy", "hi"}));
+
+    /* Empty batch does nothing */
+    postman.newMessages(nullptr, nullptr);
+    CORRADE_COMPARE(mailbox1.money, 60);
+}
+
+void Test::emitBatchStruct() {
+    struct E: Emitter {
+        Signal updated(std::size_t id, float value) {
+            return emit(&E::updated, id, value);
+        }
+
+        Signal updatedBatch(Containers::StridedArrayView1D<const std::size_t> ids, Containers::StridedArrayView1D<const float> values) {
+            return emitBatch(&E::updated, ids, values);
+        }
+    } emitter;
+
+    struct Entity {
+        std::size_t id;
+        float value;
+        int unused;
+    } entities[]{
+        {3, 1.5f, 0},
+        {7, 2.5f, 0}
+    };
+
+    float sum = 0.0f;
+    std::size_t ids = 0;
+    Interconnect::connect(emitter, &E::updated, [&sum, &ids](std::size_t id, float value) {
+        ids += id;
+        sum += value;
+    });
+
+    Containers::StridedArrayView1D<Entity> view = entities;
+    emitter.updatedBatch(
+        Containers::StridedArrayView1D<const std::size_t>{Containers::arrayView(entities), &entities[0].id, view.size(), view.stride()},
+        Containers::StridedArrayView1D<const float>{Containers::arrayView(entities), &entities[0].value, view.size(), view.stride()});
+    CORRADE_COMPARE(ids, 10);
+    CORRADE_COMPARE(sum, 4.0f);
+}
+
+void Test::emitBatchSlot() {
+    BatchPostman postman;
+
+    struct R: Receiver {
+        void addMessages(Containers::StridedArrayView1D<const int> prices, Containers::StridedArrayView1D<const std::string> messages) {
+            ++calls;
+            for(std::size_t i = 0; i != prices.size(); ++i) {
+                money += prices[i];
+                this->messages.push_back(messages[i]);
+            }
+        }
+
+        int calls{};
+        int money{};
+        std::vector<std::string> messages;
+    } receiver;
+    Interconnect::connectBatch(postman, &BatchPostman::newMessage, receiver, &R::addMessages);
+    CORRADE_COMPARE(receiver.slotConnectionCount(), 1);
+
+    int lambdaCalls = 0;
+    std::size_t lambdaCount = 0;
+    Interconnect::connectBatch(postman, &BatchPostman::newMessage, [&](Containers::StridedArrayView1D<const int> prices, Containers::StridedArrayView1D<const std::string>) {
+        ++lambdaCalls;
+        lambdaCount += prices.size();
+    });
+
+    /* The slot gets the whole batch at once */
+    const int prices[]{10, 20, 30};
+    const std::string strings[]{"hello", "ahoy", "hi"};
+    postman.newMessages(prices, strings);
+    CORRADE_COMPARE(receiver.calls, 1);
+    CORRADE_COMPARE(receiver.money, 60);
+    CORRADE_COMPARE(receiver.messages, (std::vector<std::string>{"hello", "ahoy", "hi"}));
+    CORRADE_COMPARE(lambdaCalls, 1);
+    CORRADE_COMPARE(lambdaCount, 3);
+
+    /* Regular emission gets a single-item batch */
+    postman.newMessage(5, "bye");
+    CORRADE_COMPARE(receiver.calls, 2);
+    CORRADE_COMPARE(receiver.money, 65);
+    CORRADE_COMPARE(receiver.messages, (std::vector<std::string>{"hello", "ahoy", "hi", "bye"}));
+    CORRADE_COMPARE(lambdaCalls, 2);
+    CORRADE_COMPARE(lambdaCount, 4);
+}
+
+void Test::emitBatchSizeMismatch() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    BatchPostman postman;
+    Mailbox mailbox;
+    Interconnect::connect(postman, &BatchPostman::newMessage, mailbox, &Mailbox::addMessage);
+
+    const int prices[]{10, 20, 30};
+    const std::string strings[]{"hello", "ahoy"};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    postman.newMessages(prices, strings);
+    CORRADE_COMPARE(mailbox.money, 0);
+    CORRADE_COMPARE(out.str(), "Interconnect::Emitter::emitBatch(): expected all batches to have 3 items but got 2\n");
+}
+
+void Test::emitBatchDisconnectInSlot() {
+    struct E: Emitter {
+        Signal send(int a) {
+            return emit(&E::send, a);
+        }
+
+        Signal sendBatch(Containers::StridedArrayView1D<const int> a) {
+            return emitBatch(&E::send, a);
+        }
+    } emitter;
+
+    /* The first slot disconnects itself after the second item, the second
+       slot should still get the whole batch */
+    Containers::Optional<Connection> c;
+    std::vector<int> called1, called2;
+    c = Interconnect::connect(emitter, &E::send, [&](int a) {
+        called1.push_back(a);
+        if(a == 2) Interconnect::disconnect(emitter, *c);
+    });
+    Interconnect::connect(emitter, &E::send, [&called2](int a) {
+        called2.push_back(a);
+    });
+
+    const int values[]{1, 2, 3, 4};
+    emitter.sendBatch(values);
+    CORRADE_COMPARE(called1, (std::vector<int>{1, 2}));
+    CORRADE_COMPARE(called2, (std::vector<int>{1, 2, 3, 4}));
+}
+
+void Test::queued() {
+    Postman postman;
+    Mailbox mailbox;
+
+    Connection connection = Interconnect::connectQueued(postman, &Postman::newMessage, mailbox, &Mailbox::addMessage);
+    Interconnect::connectQueued(postman, &Postman::paymentRequested, mailbox, &Mailbox::pay);
+    CORRADE_VERIFY(postman.isConnected(connection));
+    CORRADE_COMPARE(postman.signalConnectionCount(), 2);
+    CORRADE_COMPARE(mailbox.slotConnectionCount(), 2);
+    CORRADE_VERIFY(!mailbox.hasPendingEvents());
+
+    /* The message is copied, so it doesn't matter if it goes out of scope */
+    {
+        std::string message = "hello";
+        postman.newMessage(60, message);
+    }
+    postman.paymentRequested(50);
+    postman.newMessage(40, "ahoy");
+
+    /* Nothing delivered until the events are processed */
+    CORRADE_VERIFY(mailbox.hasPendingEvents());
+    CORRADE_COMPARE(mailbox.money, 0);
+    CORRADE_COMPARE(mailbox.messages, std::vector<std::string>{});
+
+    CORRADE_COMPARE(mailbox.processEvents(), 3);
+    CORRADE_VERIFY(!mailbox.hasPendingEvents());
+    CORRADE_COMPARE(mailbox.money, 50);
+    CORRADE_COMPARE(mailbox.messages, (std::vector<std::string>{"hello", "ahoy"}));
+
+    /* Processing again does nothing */
+    CORRADE_COMPARE(mailbox.processEvents(), 0);
+    CORRADE_COMPARE(mailbox.money, 50);
+}
+
+void Test::queuedDisconnected() {
+    Postman postman;
+    Mailbox mailbox;
+
+    Connection connection = Interconnect::connectQueued(postman, &Postman::paymentRequested, mailbox, &Mailbox::pay);
+    postman.paymentRequested(50);
+
+    /* Disconnecting prevents further events from being queued, but the
+       already queued ones are still delivered */
+    CORRADE_VERIFY(Interconnect::disconnect(postman, connection));
+    CORRADE_COMPARE(mailbox.slotConnectionCount(), 0);
+    postman.paymentRequested(30);
+
+    CORRADE_COMPARE(mailbox.processEvents(), 1);
+    CORRADE_COMPARE(mailbox.money, -50);
+}
+
+void Test::queuedDestroyReceiver() {
+    struct Counted {
+        Counted(int& instances): instances(instances) { ++instances; }
+        Counted(const Counted& other): instances(other.instances) { ++instances; }
+        ~Counted() { --instances; }
+
+        int& instances;
+    };
+
+    struct E: Emitter {
+        Signal send(const Counted& a) {
+            return emit(&E::send, a);
+        }
+    } emitter;
+
+    struct R: Receiver {
+        void receive(const Counted&) {
+            ++received;
+        }
+
+        int received{};
+    };
+
+    int instances = 0;
+    {
+        R receiver;
+        Interconnect::connectQueued(emitter, &E::send, receiver, &R::receive);
+
+        Counted a{instances};
+        emitter.send(a);
+        emitter.send(a);
+        CORRADE_COMPARE(instances, 3);
+    }
+
+    /* The receiver discarded the pending events, destroying the copies, and
+       got disconnected */
+    CORRADE_COMPARE(instances, 0);
+    CORRADE_VERIFY(!emitter.hasSignalConnections());
+}
+
+void Test::queuedInSlot() {
+    struct E: Emitter {
+        Signal send(int a) {
+            return emit(&E::send, a);
+        }
+    } emitter;
+
+    struct R: Receiver {
+        void receive(int a) {
+            received.push_back(a);
+            if(a < 3) emitter->send(a + 1);
+        }
+
+        E* emitter;
+        std::vector<int> received;
+    } receiver;
+    receiver.emitter = &emitter;
+
+    Interconnect::connectQueued(emitter, &E::send, receiver, &R::receive);
+    emitter.send(1);
+
+    /* Events emitted from the slot are delivered only on the next call */
+    CORRADE_COMPARE(receiver.processEvents(), 1);
+    CORRADE_COMPARE(receiver.received, std::vector<int>{1});
+    CORRADE_COMPARE(receiver.processEvents(), 1);
+    CORRADE_COMPARE(receiver.processEvents(), 1);
+    CORRADE_COMPARE(receiver.processEvents(), 0);
+    CORRADE_COMPARE(receiver.received, (std::vector<int>{1, 2, 3}));
+}
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+void Test::queuedMultithreaded() {
+    struct E: Emitter {
+        Signal send(int thread, int value) {
+            return emit(&E::send, thread, value);
+        }
+    } emitters[4];
+
+    struct R: Receiver {
+        void receive(int thread, int value) {
+            /* Events from a single thread arrive in order */
+            if(value != last[thread] + 1) ++outOfOrder;
+            last[thread] = value;
+            ++received;
+        }
+
+        int last[4]{-1, -1, -1, -1};
+        int outOfOrder{};
+        int received{};
+    } receiver;
+
+    /* Emitting isn't thread-safe, so each thread has its own emitter, but
+       all of them deliver to the same receiver mailbox */
+    for(E& emitter: emitters)
+        Interconnect::connectQueued(emitter, &E::send, receiver, &R::receive);
+
+    /* Emit from four threads in parallel while processing the events on
+       this one */
+    std::thread threads[4];
+    for(int t = 0; t != 4; ++t) threads[t] = std::thread{[&emitters, t]() {
+        for(int i = 0; i != 10000; ++i) emitters[t].send(t, i);
+    }};
+
+    while(receiver.received != 40000) receiver.processEvents();
+
+    for(std::thread& thread: threads) thread.join();
+
+    CORRADE_COMPARE(receiver.received, 40000);
+    CORRADE_COMPARE(receiver.outOfOrder, 0);
+    CORRADE_COMPARE(receiver.processEvents(), 0);
+}
+#endif
+
+#ifdef CORRADE_INTERCONNECT_PROFILE
+void Test::profile() {
+    Postman postman;
+    Mailbox mailbox1, mailbox2;
+
+    /* Signal that was never connected isn't tracked */
+    postman.newMessage(10, "hello");
+    SignalProfile empty = postman.signalProfile(&Postman::newMessage);
+    CORRADE_COMPARE(empty.emitCount, 0);
+    CORRADE_COMPARE(empty.slotCallCount, 0);
+    CORRADE_COMPARE(empty.connectionCount, 0);
+
+    Interconnect::connect(postman, &Postman::newMessage, mailbox1, &Mailbox::addMessage);
+    Interconnect::connect(postman, &Postman::newMessage, mailbox2, &Mailbox::addMessage);
+    Interconnect::connect(postman, &Postman::paymentRequested, [](int) {
+        Utility::System::sleep(2);
+    });
+
+    postman.newMessage(10, "hello");
+    postman.newMessage(20, "ahoy");
+    postman.newMessage(30, "bye");
+    postman.paymentRequested(5);
+
+    SignalProfile message = postman.signalProfile(&Postman::newMessage);
+    CORRADE_COMPARE(message.emitCount, 3);
+    CORRADE_COMPARE(message.slotCallCount, 6);
+    CORRADE_COMPARE(message.connectionCount, 2);
+    CORRADE_COMPARE_AS(message.totalSlotDuration, message.maxSlotDuration,
+        TestSuite::Compare::GreaterOrEqual);
+
+    SignalProfile payment = postman.signalProfile(&Postman::paymentRequested);
+    CORRADE_COMPARE(payment.emitCount, 1);
+    CORRADE_COMPARE(payment.slotCallCount, 1);
+    CORRADE_COMPARE(payment.connectionCount, 1);
+    CORRADE_COMPARE_AS(payment.maxSlotDuration, std::uint64_t(2000000),
+        TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE(payment.totalSlotDuration, payment.maxSlotDuration);
+
+    /* Disconnecting keeps the statistics */
+    mailbox1.disconnectAllSlots();
+    message = postman.signalProfile(&Postman::newMessage);
+    CORRADE_COMPARE(message.emitCount, 3);
+    CORRADE_COMPARE(message.connectionCount, 1);
+
+    postman.resetSignalProfiles();
+    message = postman.signalProfile(&Postman::newMessage);
+    CORRADE_COMPARE(message.emitCount, 0);
+    CORRADE_COMPARE(message.slotCallCount, 0);
+    CORRADE_COMPARE(message.totalSlotDuration, 0);
+    CORRADE_COMPARE(message.maxSlotDuration, 0);
+    CORRADE_COMPARE(message.connectionCount, 1);
+}
+
+void Test::profileBatch() {
+    BatchPostman postman;
+    Mailbox mailbox;
+    Interconnect::connect(postman, &BatchPostman::newMessage, mailbox, &Mailbox::addMessage);
+    Interconnect::connectBatch(postman, &BatchPostman::newMessage, [](Containers::StridedArrayView1D<const int>, Containers::StridedArrayView1D<const std::string>) {});
+
+    const int prices[]{10, 20, 30};
+    const std::string strings[]{"hello", "ahoy", "bye"};
+    postman.newMessages(prices, strings);
+    postman.newMessage(40, "hey");
+
+    /* Each item is an emission, but each slot is called just once for the
+       whole batch */
+    SignalProfile profile = postman.signalProfile(&BatchPostman::newMessage);
+    CORRADE_COMPARE(profile.emitCount, 4);
+    CORRADE_COMPARE(profile.slotCallCount, 4);
+    CORRADE_COMPARE(profile.connectionCount, 2);
+    CORRADE_COMPARE(mailbox.money, 100);
+}
+
+void Test::profileConnectInSlot() {
+    struct E: Emitter {
+        Signal send(int a) {
+            return emit(&E::send, a);
+        }
+
+        Signal other() {
+            return emit(&E::other);
+        }
+    } emitter;
+
+    /* Connecting new signals in the slot may reallocate the signal storage,
+       the statistics should be recorded to the right place regardless */
+    int calls = 0;
+    Interconnect::connect(emitter, &E::send, [&](int) {
+        ++calls;
+        Interconnect::connect(emitter, &E::other, [](){});
+        emitter.disconnectSignal(&E::other);
+    });
+
+    emitter.send(1);
+    emitter.send(2);
+    CORRADE_COMPARE(calls, 2);
+
+    SignalProfile profile = emitter.signalProfile(&E::send);
+    CORRADE_COMPARE(profile.emitCount, 2);
+    CORRADE_COMPARE(profile.slotCallCount, 2);
+    CORRADE_COMPARE(emitter.signalProfile(&E::other).emitCount, 0);
+    CORRADE_COMPARE(emitter.signalProfile(&E::other).slotCallCount, 0);
+}
+
+void Test::debugSignalProfile() {
+    SignalProfile profile;
+    profile.emitCount = 3;
+    profile.slotCallCount = 6;
+    profile.totalSlotDuration = 1500;
+    profile.maxSlotDuration = 400;
+    profile.connectionCount = 2;
+
+    std::ostringstream out;
+    Debug{&out} << profile;
+    CORRADE_COMPARE(out.str(), "Interconnect::SignalProfile(emits: 3, connections: 2, slot calls: 6, total: 1500 ns, max: 400 ns)\n");
+}
+#endif
+
 }}}}
 
 CORRADE_TEST_MAIN(Corrade::Interconnect::Test::Test)
@@ -27,25 +27,36 @@
 
 #include <cstring>
 #include <algorithm>
+#include <chrono>
 #include <functional>
 #include <map>
 #include <sstream>
 #include <utility>
 
+#if !defined(CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT) && defined(CORRADE_BUILD_MULTITHREADED)
+#include <atomic>
+#include <thread>
+#endif
+
 #include "Corrade/Containers/EnumSet.hpp"
+#include "Corrade/Containers/HashMap.h"
 #include "Corrade/Containers/Optional.h"
-#include "Corrade/Containers/Reference.h"
+#include "Corrade/Containers/StringStl.h"
 #include "Corrade/Containers/Implementation/RawForwardList.h"
 #include "Corrade/PluginManager/AbstractPlugin.h"
 #include "Corrade/PluginManager/PluginMetadata.h"
+#include "Corrade/PluginManager/Registry.h"
 #include "Corrade/Utility/Assert.h"
 #include "Corrade/Utility/DebugStl.h"
 #include "Corrade/Utility/Configuration.h"
+#include "Corrade/Utility/FormatStl.h"
+#include "Corrade/Utility/Profiler.h"
 #include "Corrade/Utility/Resource.h"
 #include "Corrade/Utility/String.h"
 
 #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
 #include "Corrade/Utility/Directory.h"
+#include "Corrade/Utility/FileWatcherSet.h"
 
 #ifndef CORRADE_TARGET_WINDOWS
 #include <dlfcn.h>
@@ -62,6 +73,7 @@ using Corrade::Utility::Unicode::widen;
 #endif
 
 #include "Corrade/PluginManager/configure.h"
+#include "Corrade/PluginManager/Implementation/embeddedMetadata.h"
 #endif
 
 #if defined(CORRADE_TARGET_WINDOWS) && defined(CORRADE_BUILD_STATIC) && !defined(CORRADE_TARGET_WINDOWS_RT)
@@ -89,6 +101,8 @@ struct AbstractManager::Plugin {
     Instancer instancer;
     void(*finalizer)();
 
+    LoadStatistics statistics{};
+
     #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
     union {
         /* For static plugins */
@@ -101,6 +115,13 @@ struct AbstractManager::Plugin {
         HMODULE module;
         #endif
     };
+
+    /* Set for dynamic plugins loaded with LoadFlag::Lazy that weren't opened
+       yet. The plugin is LoadState::Loaded but module is nullptr. */
+    bool deferred = false;
+
+    /* File the dynamic plugin was last loaded from, used by reload() */
+    std::string filename;
     #else
     const Implementation::StaticPlugin* staticPlugin;
     #endif
@@ -108,6 +129,10 @@ struct AbstractManager::Plugin {
     #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
     /* Constructor for dynamic plugins */
     explicit Plugin(std::string name, const std::string& metadata, AbstractManager* manager);
+
+    /* Constructor for dynamic plugins with metadata already read into memory,
+       used by the metadata cache */
+    explicit Plugin(std::string name, std::istream& metadata, AbstractManager* manager);
     #endif
 
     /* Constructor for static plugins */
@@ -120,19 +145,132 @@ struct AbstractManager::Plugin {
     Plugin& operator=(Plugin&&) = delete;
 
     ~Plugin() = default;
+
+    #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+    /* Creates a dynamic plugin, recording the time spent parsing the metadata
+       into its statistics and into the trace of the manager */
+    template<class T> static Plugin* create(const std::string& name, T&& metadata, AbstractManager& manager);
+
+    /* Creates a dynamic plugin with metadata from given file or, if it
+       doesn't exist, from metadata embedded in the plugin binary */
+    static Plugin* createDynamic(const std::string& name, const std::string& binary, const std::string& metadata, AbstractManager& manager);
+    #endif
+
+    /* Calls the instancer, recording the time into statistics and into the
+       trace of given manager */
+    void* instantiate(AbstractManager& manager, const std::string& plugin);
+};
+
+namespace {
+
+std::uint64_t timestamp() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct TraceEvent {
+    std::string plugin;
+    const char* phase;
+    std::uint64_t begin;
+    std::uint64_t end;
+    std::size_t thread;
 };
 
+}
+
 struct AbstractManager::State {
     explicit State(std::string&& pluginInterface): pluginInterface{std::move(pluginInterface)} {}
 
     #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
     std::string pluginDirectory;
+    std::string metadataCache;
+    Registry* registry{};
+    LoadFlags loadFlags;
+    ReloadCallback reloadCallback{};
+    void* reloadCallbackState{};
+    /* Created on first reloadChanged(). The plugin names are indexed by
+       the watcher file ID, the map goes from a filename to the ID. */
+    Containers::Pointer<Utility::FileWatcherSet> watcher;
+    std::vector<std::string> watchedPlugins;
+    std::map<std::string, std::size_t> watchedFiles;
     #endif
     std::string pluginInterface;
-    std::map<std::string, Plugin&> aliases;
+    /* Hashed as name and alias resolution is on the hot path of load(),
+       metadata() and instantiate(). Sorted on demand in aliasList(). */
+    Containers::HashMap<Containers::String, Plugin*> aliases;
+    /* Built on demand in pluginsForKey(), for each queried key a map from
+       values to sorted plugin names. Cleared when the plugin list changes. */
+    mutable std::map<std::string, Containers::HashMap<Containers::String, std::vector<std::string>>> dataIndex;
     std::map<std::string, std::vector<AbstractPlugin*>> instances;
+
+    std::uint64_t traceBegin = timestamp();
+    std::vector<TraceEvent> trace;
+
+    /* Records an event and returns its duration */
+    std::uint64_t record(const std::string& plugin, const char* phase, std::uint64_t begin, std::uint64_t end, std::size_t thread = 0) {
+        trace.push_back({plugin, phase, begin, end, thread});
+        return end - begin;
+    }
 };
 
+#ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+template<class T> AbstractManager::Plugin* AbstractManager::Plugin::create(const std::string& name, T&& metadata, AbstractManager& manager) {
+    const std::uint64_t begin = timestamp();
+    Plugin* const plugin = new Plugin{name, metadata, &manager};
+    plugin->statistics.metadataDuration = manager._state->record(name, "metadata", begin, timestamp());
+    return plugin;
+}
+
+namespace {
+
+/* Reads metadata embedded in given plugin binary, returns false if the
+   binary doesn't exist or there are no embedded metadata */
+bool readEmbeddedMetadata(const std::string& binary, Containers::Array<char>& out) {
+    if(!Utility::Directory::exists(binary)) return false;
+    const Containers::Array<const char, Utility::Directory::MapDeleter> data = Utility::Directory::mapRead(binary);
+    const Containers::ArrayView<const char> metadata = Implementation::embeddedMetadata(data);
+    if(metadata.empty()) return false;
+
+    out = Containers::Array<char>{Containers::NoInit, metadata.size()};
+    std::memcpy(out.data(), metadata.data(), metadata.size());
+    return true;
+}
+
+/* Reads contents of given metadata file or, if it doesn't exist, metadata
+   embedded in the plugin binary, returns false if there's neither */
+bool readMetadata(const std::string& binary, const std::string& metadata, Containers::Array<char>& out) {
+    return Utility::Directory::exists(metadata) ?
+        Utility::Directory::read(metadata, out) : readEmbeddedMetadata(binary, out);
+}
+
+}
+
+AbstractManager::Plugin* AbstractManager::Plugin::createDynamic(const std::string& name, const std::string& binary, const std::string& metadata, AbstractManager& manager) {
+    /* A metadata file next to the binary has a precedence, so embedded
+       metadata can be overriden. If there's neither, let the plugin fail the
+       usual way. */
+    Containers::Array<char> embedded;
+    if(!Utility::Directory::exists(metadata) && readEmbeddedMetadata(binary, embedded)) {
+        std::istringstream in{std::string{embedded.data(), embedded.size()}};
+        return create(name, in, manager);
+    }
+
+    return create(name, metadata, manager);
+}
+#endif
+
+void* AbstractManager::Plugin::instantiate(AbstractManager& manager, const std::string& plugin) {
+    const std::uint64_t begin = timestamp();
+    void* const instance = instancer(manager, plugin);
+    const std::uint64_t end = timestamp();
+
+    /* Only the first instantiation goes into the trace */
+    if(!statistics.instantiationCount)
+        manager._state->record(metadata->_name, "instantiation", begin, end);
+    statistics.instantiationDuration += end - begin;
+    ++statistics.instantiationCount;
+    return instance;
+}
+
 const int AbstractManager::Version = CORRADE_PLUGIN_VERSION;
 
 #if !defined(CORRADE_BUILD_STATIC) || defined(CORRADE_TARGET_WINDOWS)
@@ -266,12 +404,21 @@ void AbstractManager::ejectStaticPlugin(int version, Implementation::StaticPlugi
 }
 
 #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
-AbstractManager::AbstractManager(std::string pluginInterface, const std::vector<std::string>& pluginSearchPaths, std::string pluginDirectory):
+AbstractManager::AbstractManager(std::string pluginInterface, const std::vector<std::string>& pluginSearchPaths, std::string pluginDirectory): AbstractManager{std::move(pluginInterface), pluginSearchPaths, std::move(pluginDirectory), {}} {}
+
+AbstractManager::AbstractManager(std::string pluginInterface, const std::vector<std::string>& pluginSearchPaths, std::string pluginDirectory, std::string metadataCache): AbstractManager{std::move(pluginInterface), pluginSearchPaths, std::move(pluginDirectory), std::move(metadataCache), nullptr} {}
+
+AbstractManager::AbstractManager(std::string pluginInterface, const std::vector<std::string>& pluginSearchPaths, std::string pluginDirectory, std::string metadataCache, Registry* const registry):
 #else
 AbstractManager::AbstractManager(std::string pluginInterface):
 #endif
     _state{Containers::InPlaceInit, std::move(pluginInterface)}
 {
+    #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+    _state->metadataCache = std::move(metadataCache);
+    _state->registry = registry;
+    #endif
+
     /* If the global storage doesn't exist yet, allocate it. This gets deleted
        when it's fully empty again on manager destruction. */
     if(!globalPlugins) globalPlugins = new std::map<std::string, AbstractManager::Plugin*>;
@@ -292,35 +439,33 @@ AbstractManager::AbstractManager(std::string pluginInterface):
 
         /* Assign the plugin to this manager, parse its metadata and
            initialize it */
+        const std::uint64_t metadataBegin = timestamp();
         Resource r("CorradeStaticPlugin_" + inserted.first->first);
         std::istringstream metadata(r.get(inserted.first->first + ".conf"));
         p.configuration = Utility::Configuration{metadata, Utility::Configuration::Flag::ReadOnly};
         p.metadata.emplace(inserted.first->first, p.configuration);
         p.manager = this;
+        const std::uint64_t initializerBegin = timestamp();
+        p.statistics.metadataDuration = _state->record(inserted.first->first, "metadata", metadataBegin, initializerBegin);
         p.staticPlugin->initializer();
+        p.statistics.initializerDuration += _state->record(inserted.first->first, "initializer", initializerBegin, timestamp());
 
         /* The plugin is the best version of itself. If there was already
            an alias for this name, replace it. */
         {
-            const auto alias = _state->aliases.find(inserted.first->first);
-            if(alias != _state->aliases.end()) _state->aliases.erase(alias);
-            CORRADE_INTERNAL_ASSERT_OUTPUT(_state->aliases.insert({inserted.first->first, p}).second);
+            _state->aliases.remove(inserted.first->first);
+            CORRADE_INTERNAL_ASSERT_OUTPUT(_state->aliases.insert(inserted.first->first, &p).second);
         }
 
         /* Add aliases to the list (only the ones that aren't already there
            are added) */
-        for(const std::string& alias: p.metadata->_provides) {
-            /* Libc++ frees the passed Plugin& reference when using
-               emplace(), causing double-free memory corruption later.
-               Everything is okay with insert(). */
-            /** @todo put back emplace() here when libc++ is fixed */
-            _state->aliases.insert({alias, p});
-        }
+        for(const std::string& alias: p.metadata->_provides)
+            _state->aliases.insert(alias, &p);
     }
 
     #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
     /* If plugin directory is set, use it, otherwise loop through */
-    if(!pluginDirectory.empty()) setPluginDirectory(std::move(pluginDirectory));
+    if(!pluginDirectory.empty()) setPluginDirectoryInternal(std::move(pluginDirectory), true);
     else {
         CORRADE_ASSERT(!pluginSearchPaths.empty(),
             "PluginManager::Manager::Manager(): either pluginDirectory has to be set or T::pluginSearchPaths() is expected to have at least one entry", );
@@ -330,7 +475,7 @@ AbstractManager::AbstractManager(std::string pluginInterface):
             std::string fullPath = Utility::Directory::join(executableDir, path);
             if(!Utility::Directory::exists(fullPath)) continue;
 
-            setPluginDirectory(std::move(fullPath));
+            setPluginDirectoryInternal(std::move(fullPath), true);
             break;
         }
 
@@ -340,7 +485,7 @@ AbstractManager::AbstractManager(std::string pluginInterface):
            CorradeUtility.dll as a plugin. Don't print the warning in case
            we have static plugins (the aliases are non-empty) -- in that case
            assume the user might want to only use static plugins. */
-        if(_state->pluginDirectory.empty() && _state->aliases.empty())
+        if(_state->pluginDirectory.empty() && _state->aliases.isEmpty())
             Warning{} << "PluginManager::Manager::Manager(): none of the plugin search paths in" << pluginSearchPaths << "exists and pluginDirectory was not set, skipping plugin discovery";
     }
     #endif
@@ -363,7 +508,11 @@ AbstractManager::~AbstractManager() {
         #endif
 
         /* Finalize static plugins before they get removed from the list */
-        if(it->second->loadState == LoadState::Static)
+        if(it->second->loadState == LoadState::Static
+            #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+            && !(_state->loadFlags & LoadFlag::FastShutdown && it->second->metadata->isFinalizerOptional())
+            #endif
+        )
             it->second->staticPlugin->finalizer();
 
         /* Fully erase the plugin from the container, both static and dynamic
@@ -402,8 +551,9 @@ LoadState AbstractManager::unloadRecursiveInternal(Plugin& plugin) {
         CORRADE_ASSERT_OUTPUT(unloadRecursive(plugin.metadata->_usedBy.front()) != LoadState::NotFound,
             "PluginManager::Manager: wrong destruction order, cannot unload" << plugin.metadata->_name << "that depends on" << plugin.metadata->_usedBy.front() << "from a different manager instance", {});
 
-    /* Unload the plugin */
-    const LoadState after = unloadInternal(plugin);
+    /* Unload the plugin. This is called only on manager destruction, so
+       it's the place to honor the fast shutdown. */
+    const LoadState after = unloadInternal(plugin, !!(_state->loadFlags & LoadFlag::FastShutdown));
     CORRADE_ASSERT(after & (LoadState::Static|LoadState::NotLoaded|LoadState::WrongMetadataFile),
         "PluginManager::Manager: cannot unload plugin" << plugin.metadata->_name << "on manager destruction:" << after, {});
 
@@ -418,17 +568,94 @@ std::string AbstractManager::pluginDirectory() const {
     return _state->pluginDirectory;
 }
 
+std::string AbstractManager::metadataCache() const {
+    return _state->metadataCache;
+}
+
+LoadFlags AbstractManager::loadFlags() const {
+    return _state->loadFlags;
+}
+
+void AbstractManager::setLoadFlags(const LoadFlags flags) {
+    _state->loadFlags = flags;
+}
+
+void AbstractManager::setReloadCallback(const ReloadCallback callback, void* const state) {
+    _state->reloadCallback = callback;
+    _state->reloadCallbackState = state;
+}
+
+namespace {
+
+/* The metadata cache is a magic header followed by a sequence of entries,
+   each having a 64-bit size and modification time of the metadata file, a
+   32-bit path and contents size, and then the path and the contents, not
+   null-terminated. Everything is in native byte order, as the cache isn't
+   meant to be shared across machines. */
+constexpr const char MetadataCacheMagic[]{'C', 'P', 'M', 'C', 'A', 'C', 'H', '1'};
+constexpr std::size_t MetadataCacheEntryHeaderSize = 2*8 + 2*4;
+
+struct CachedMetadata {
+    std::uint64_t size;
+    std::uint64_t modificationTime;
+    Containers::ArrayView<const char> contents;
+};
+
+/* Returns an empty map if the cache is invalid */
+std::map<std::string, CachedMetadata> parseMetadataCache(const Containers::ArrayView<const char> data) {
+    if(data.size() < sizeof(MetadataCacheMagic) || std::memcmp(data.data(), MetadataCacheMagic, sizeof(MetadataCacheMagic)) != 0)
+        return {};
+
+    std::map<std::string, CachedMetadata> out;
+    std::size_t pos = sizeof(MetadataCacheMagic);
+    while(pos != data.size()) {
+        if(data.size() - pos < MetadataCacheEntryHeaderSize) return {};
+
+        CachedMetadata entry;
+        std::uint32_t pathSize, contentsSize;
+        std::memcpy(&entry.size, data + pos, 8);
+        std::memcpy(&entry.modificationTime, data + pos + 8, 8);
+        std::memcpy(&pathSize, data + pos + 16, 4);
+        std::memcpy(&contentsSize, data + pos + 20, 4);
+        pos += MetadataCacheEntryHeaderSize;
+
+        if(data.size() - pos < std::size_t(pathSize) + contentsSize) return {};
+        entry.contents = data.slice(pos + pathSize, pos + pathSize + contentsSize);
+        out.emplace(std::string{data + pos, pathSize}, entry);
+        pos += pathSize + contentsSize;
+    }
+
+    return out;
+}
+
+void appendMetadataCacheEntry(std::string& out, const std::string& path, const std::uint64_t size, const std::uint64_t modificationTime, const Containers::ArrayView<const char> contents) {
+    const std::uint32_t pathSize = path.size();
+    const std::uint32_t contentsSize = contents.size();
+    char header[MetadataCacheEntryHeaderSize];
+    std::memcpy(header, &size, 8);
+    std::memcpy(header + 8, &modificationTime, 8);
+    std::memcpy(header + 16, &pathSize, 4);
+    std::memcpy(header + 20, &contentsSize, 4);
+    out.append(header, MetadataCacheEntryHeaderSize);
+    out.append(path);
+    out.append(contents.data(), contents.size());
+}
+
+}
+
 void AbstractManager::setPluginDirectory(std::string directory) {
+    setPluginDirectoryInternal(std::move(directory), false);
+}
+
+void AbstractManager::setPluginDirectoryInternal(std::string directory, const bool useRegistry) {
     _state->pluginDirectory = std::move(directory);
+    _state->dataIndex.clear();
 
     /* Remove aliases for unloaded plugins from the container. They need to be
        removed before plugins themselves */
-    auto ait = _state->aliases.cbegin();
-    while(ait != _state->aliases.cend()) {
-        if(ait->second.loadState & (LoadState::NotLoaded|LoadState::WrongMetadataFile))
-            ait = _state->aliases.erase(ait);
-        else ++ait;
-    }
+    _state->aliases.removeIf([](const Containers::HashMapEntry<Containers::String, Plugin*>& alias) {
+        return !!(alias.value()->loadState & (LoadState::NotLoaded|LoadState::WrongMetadataFile));
+    });
 
     /* Remove all unloaded plugins from the container */
     auto it = globalPlugins->cbegin();
@@ -439,26 +666,164 @@ void AbstractManager::setPluginDirectory(std::string directory) {
         } else ++it;
     }
 
+    /* On construction, if the directory was already scanned by another
+       manager sharing the same registry, take the plugin list and metadata
+       from there without touching the filesystem. Explicit directory changes
+       and reloads always rescan. */
+    std::vector<Registry::DirectoryEntry> registryEntries;
+    const bool fromRegistry = useRegistry && _state->registry && _state->registry->directory(_state->pluginDirectory, registryEntries);
+    if(fromRegistry) {
+        for(const Registry::DirectoryEntry& entry: registryEntries) {
+            /* Skip the plugin if it is among loaded */
+            if(globalPlugins->find(entry.name) != globalPlugins->end()) continue;
+
+            /* Let plugins without metadata fail the usual way */
+            if(!entry.valid) {
+                registerDynamicPlugin(entry.name, Plugin::create(entry.name, Directory::join(_state->pluginDirectory, entry.name + ".conf"), *this));
+                continue;
+            }
+
+            std::istringstream in{entry.metadata};
+            registerDynamicPlugin(entry.name, Plugin::create(entry.name, in, *this));
+        }
+
     /* Find plugin files in the directory. Sort the list so we have predictable
        plugin preference behavior for aliases on systems that have random
        directory listing order. */
-    const std::vector<std::string> d = Directory::list(_state->pluginDirectory,
-        Directory::Flag::SkipDirectories|Directory::Flag::SkipDotAndDotDot|
-        Directory::Flag::SortAscending);
-    for(const std::string& filename: d) {
-        /* File doesn't have module suffix, continue to next */
-        if(!Utility::String::endsWith(filename, PLUGIN_FILENAME_SUFFIX))
-            continue;
+    } else if(_state->metadataCache.empty()) {
+        const std::vector<std::string> d = Directory::list(_state->pluginDirectory,
+            Directory::Flag::SkipDirectories|Directory::Flag::SkipDotAndDotDot|
+            Directory::Flag::SortAscending);
+        for(const std::string& filename: d) {
+            /* File doesn't have module suffix, continue to next */
+            if(!Utility::String::endsWith(filename, PLUGIN_FILENAME_SUFFIX))
+                continue;
+
+            /* Dig plugin name from filename */
+            const std::string name = filename.substr(0, filename.length() - sizeof(PLUGIN_FILENAME_SUFFIX) + 1);
+            const std::string binaryFilename = Directory::join(_state->pluginDirectory, filename);
+            const std::string metadataFilename = Directory::join(_state->pluginDirectory, name + ".conf");
+            const bool loaded = globalPlugins->find(name) != globalPlugins->end();
+
+            /* Without a registry, the metadata don't need to be remembered */
+            if(!_state->registry) {
+                /* Skip the plugin if it is among loaded */
+                if(loaded) continue;
+
+                registerDynamicPlugin(name, Plugin::createDynamic(name, binaryFilename, metadataFilename, *this));
+                continue;
+            }
 
-        /* Dig plugin name from filename */
-        const std::string name = filename.substr(0, filename.length() - sizeof(PLUGIN_FILENAME_SUFFIX) + 1);
+            /* Otherwise read them into memory, including already loaded
+               plugins so the registry has the full list. If there are none,
+               let the plugin fail the usual way. */
+            Containers::Array<char> contents;
+            if(!readMetadata(binaryFilename, metadataFilename, contents)) {
+                registryEntries.push_back({name, {}, false});
+                if(!loaded) registerDynamicPlugin(name, Plugin::create(name, metadataFilename, *this));
+                continue;
+            }
+
+            registryEntries.push_back({name, std::string{contents.data(), contents.size()}, true});
+            if(loaded) continue;
 
-        /* Skip the plugin if it is among loaded */
-        if(globalPlugins->find(name) != globalPlugins->end()) continue;
+            std::istringstream in{registryEntries.back().metadata};
+            registerDynamicPlugin(name, Plugin::create(name, in, *this));
+        }
+
+    /* With a metadata cache, get sizes and modification times of all metadata
+       files in a single pass and open only those that don't match the cache */
+    } else {
+        const std::vector<Directory::Entry> d = Directory::listEntries(_state->pluginDirectory,
+            Directory::Flag::SkipDirectories|Directory::Flag::SkipDotAndDotDot|
+            Directory::Flag::SortAscending);
+        std::map<std::string, const Directory::Entry*> metadataFiles;
+        for(const Directory::Entry& entry: d)
+            if(Utility::String::endsWith(entry.name, ".conf"))
+                metadataFiles.emplace(entry.name, &entry);
+
+        Containers::Array<const char, Directory::MapDeleter> cacheData;
+        if(Directory::exists(_state->metadataCache))
+            cacheData = Directory::mapRead(_state->metadataCache);
+        const std::map<std::string, CachedMetadata> cache = parseMetadataCache(cacheData);
+
+        /* The cache gets rewritten if any metadata file had to be opened or if
+           any entry for this directory is no longer used */
+        std::string updatedCache{MetadataCacheMagic, sizeof(MetadataCacheMagic)};
+        const std::string directory = Directory::path(Directory::join(_state->pluginDirectory, {}));
+        std::size_t reusedCount = 0;
+        std::size_t directoryCount = 0;
+        bool changed = false;
+        for(const auto& entry: cache) {
+            if(Directory::path(entry.first) != directory) {
+                appendMetadataCacheEntry(updatedCache, entry.first, entry.second.size, entry.second.modificationTime, entry.second.contents);
+            } else ++directoryCount;
+        }
 
-        registerDynamicPlugin(name, new Plugin{name, Directory::join(_state->pluginDirectory, name + ".conf"), this});
+        for(const Directory::Entry& entry: d) {
+            /* File doesn't have module suffix, continue to next */
+            if(!Utility::String::endsWith(entry.name, PLUGIN_FILENAME_SUFFIX))
+                continue;
+
+            /* Dig plugin name from filename */
+            const std::string name = entry.name.substr(0, entry.name.length() - sizeof(PLUGIN_FILENAME_SUFFIX) + 1);
+            const std::string metadataFilename = Directory::join(_state->pluginDirectory, name + ".conf");
+            const bool loaded = globalPlugins->find(name) != globalPlugins->end();
+
+            /* If the metadata file is not there, the metadata may be embedded
+               in the binary. Those are cached under the binary filename and
+               its size and modification time. */
+            const auto foundMetadata = metadataFiles.find(name + ".conf");
+            const bool embedded = foundMetadata == metadataFiles.end();
+            const std::string metadataSource = embedded ? Directory::join(_state->pluginDirectory, entry.name) : metadataFilename;
+            const Directory::Entry& metadata = embedded ? entry : *foundMetadata->second;
+            const auto foundCached = cache.find(metadataSource);
+            Containers::ArrayView<const char> contents;
+            Containers::Array<char> readContents;
+            if(foundCached != cache.end() &&
+               foundCached->second.size == metadata.size &&
+               foundCached->second.modificationTime == metadata.modificationTime) {
+                contents = foundCached->second.contents;
+                ++reusedCount;
+            } else {
+                /* Not updating the cache for already loaded plugins, unless
+                   the registry needs to have the full list */
+                if(loaded && !_state->registry) continue;
+
+                /* If the file can't be read or there are no embedded
+                   metadata, let the plugin fail the usual way and don't put
+                   it into the cache */
+                if(!(embedded ? readEmbeddedMetadata(metadataSource, readContents) : Directory::read(metadataFilename, readContents))) {
+                    if(_state->registry) registryEntries.push_back({name, {}, false});
+                    if(!loaded) registerDynamicPlugin(name, Plugin::create(name, metadataFilename, *this));
+                    continue;
+                }
+                contents = readContents;
+                changed = true;
+            }
+
+            appendMetadataCacheEntry(updatedCache, metadataSource, metadata.size, metadata.modificationTime, contents);
+            if(_state->registry)
+                registryEntries.push_back({name, std::string{contents.data(), contents.size()}, true});
+
+            /* Skip the plugin if it is among loaded */
+            if(loaded) continue;
+
+            std::istringstream in{std::string{contents.data(), contents.size()}};
+            registerDynamicPlugin(name, Plugin::create(name, in, *this));
+        }
+
+        /* Unmap the cache first so it can be overwritten */
+        if(changed || reusedCount != directoryCount) {
+            cacheData = nullptr;
+            Directory::write(_state->metadataCache, Containers::arrayView(updatedCache.data(), updatedCache.size()));
+        }
     }
 
+    /* Save the scan for other managers sharing the registry */
+    if(_state->registry && !fromRegistry)
+        _state->registry->setDirectory(_state->pluginDirectory, std::move(registryEntries));
+
     /* If some of the currently loaded plugins aliased plugins that werre in
        the old plugin directory, these are no longer there. Refresh the alias
        list with the new plugins. */
@@ -467,13 +832,8 @@ void AbstractManager::setPluginDirectory(std::string directory) {
 
         /* Add aliases to the list (only the ones that aren't already there are
            added, calling insert() won't overwrite the existing value) */
-        for(const std::string& alias: p.second->metadata->_provides) {
-            /* Libc++ frees the passed Plugin& reference when using emplace(),
-               causing double-free memory corruption later. Everything is okay
-               with insert(). */
-            /** @todo put back emplace() here when libc++ is fixed */
-            _state->aliases.insert({alias, *p.second});
-        }
+        for(const std::string& alias: p.second->metadata->_provides)
+            _state->aliases.insert(alias, p.second);
     }
 }
 
@@ -483,8 +843,8 @@ void AbstractManager::reloadPluginDirectory() {
 #endif
 
 void AbstractManager::setPreferredPlugins(const std::string& alias, const std::initializer_list<std::string> plugins) {
-    auto foundAlias = _state->aliases.find(alias);
-    CORRADE_ASSERT(foundAlias != _state->aliases.end(),
+    Plugin** const foundAlias = _state->aliases.find(alias);
+    CORRADE_ASSERT(foundAlias,
         "PluginManager::Manager::setPreferredPlugins():" << alias << "is not a known alias", );
 
     /* Replace the alias with the first candidate that exists */
@@ -495,8 +855,7 @@ void AbstractManager::setPreferredPlugins(const std::string& alias, const std::i
 
         CORRADE_ASSERT(std::find(foundPlugin->second->metadata->provides().begin(), foundPlugin->second->metadata->provides().end(), alias) != foundPlugin->second->metadata->provides().end(),
             "PluginManager::Manager::setPreferredPlugins():" << plugin << "does not provide" << alias, );
-        _state->aliases.erase(foundAlias);
-        _state->aliases.insert({alias, *foundPlugin->second});
+        *foundAlias = foundPlugin->second;
         break;
     }
 }
@@ -514,32 +873,96 @@ std::vector<std::string> AbstractManager::pluginList() const {
 
 std::vector<std::string> AbstractManager::aliasList() const {
     std::vector<std::string> names;
-    for(const auto& alias: _state->aliases) names.push_back(alias.first);
+    names.reserve(_state->aliases.size());
+    for(const Containers::HashMapEntry<Containers::String, Plugin*>& alias: _state->aliases)
+        names.push_back(alias.key());
+    std::sort(names.begin(), names.end());
     return names;
 }
 
+std::vector<std::string> AbstractManager::pluginsForKey(const std::string& key, const std::string& value) const {
+    auto foundKey = _state->dataIndex.find(key);
+    if(foundKey == _state->dataIndex.end()) {
+        /* Going through the sorted global map, so the plugin names for each
+           value are sorted as well */
+        Containers::HashMap<Containers::String, std::vector<std::string>> index;
+        for(const std::pair<const std::string, Plugin*>& plugin: *globalPlugins) {
+            /* Plugin doesn't belong to this manager */
+            if(plugin.second->manager != this) continue;
+
+            for(const std::string& pluginValue: plugin.second->metadata->data().values(key)) {
+                std::vector<std::string>& names = *index.insert(pluginValue, {}).first;
+                /* The same value can be listed more than once */
+                if(names.empty() || names.back() != plugin.first)
+                    names.push_back(plugin.first);
+            }
+        }
+
+        foundKey = _state->dataIndex.emplace(key, std::move(index)).first;
+    }
+
+    if(const std::vector<std::string>* const found = foundKey->second.find(value))
+        return *found;
+    return {};
+}
+
 const PluginMetadata* AbstractManager::metadata(const std::string& plugin) const {
-    auto found = _state->aliases.find(plugin);
-    if(found != _state->aliases.end()) return &*found->second.metadata;
+    if(Plugin* const* const found = _state->aliases.find(plugin))
+        return &*(*found)->metadata;
 
     return nullptr;
 }
 
 PluginMetadata* AbstractManager::metadata(const std::string& plugin) {
-    auto found = _state->aliases.find(plugin);
-    if(found != _state->aliases.end()) return &*found->second.metadata;
+    if(Plugin* const* const found = _state->aliases.find(plugin))
+        return &*(*found)->metadata;
+
+    return nullptr;
+}
+
+const LoadStatistics* AbstractManager::loadStatistics(const std::string& plugin) const {
+    if(Plugin* const* const found = _state->aliases.find(plugin))
+        return &(*found)->statistics;
 
     return nullptr;
 }
 
+std::string AbstractManager::loadTrace() const {
+    std::string out = "{\"traceEvents\":[";
+    for(std::size_t i = 0; i != _state->trace.size(); ++i) {
+        const TraceEvent& event = _state->trace[i];
+
+        /* Plugin names come from filenames, escape the few characters that
+           would break the JSON */
+        std::string name;
+        name.reserve(event.plugin.size());
+        for(const char c: event.plugin) {
+            if(c == '"' || c == '\\') name += '\\';
+            name += c;
+        }
+
+        /* Timestamps are in microseconds, printing the nanoseconds as a
+           fractional part */
+        const std::uint64_t begin = event.begin - _state->traceBegin;
+        const std::uint64_t duration = event.end - event.begin;
+        Utility::formatInto(out, out.size(), "{}\n{{\"name\":\"{}\",\"cat\":\"{}\",\"ph\":\"X\",\"ts\":{}.{:.3},\"dur\":{}.{:.3},\"pid\":0,\"tid\":{}}}",
+            i ? "," : "", name, event.phase,
+            begin/1000, begin%1000, duration/1000, duration%1000, event.thread);
+    }
+    out += "\n]}\n";
+    return out;
+}
+
 LoadState AbstractManager::loadState(const std::string& plugin) const {
-    auto found = _state->aliases.find(plugin);
-    if(found != _state->aliases.end()) return found->second.loadState;
+    if(Plugin* const* const found = _state->aliases.find(plugin))
+        return (*found)->loadState;
 
     return LoadState::NotFound;
 }
 
 LoadState AbstractManager::load(const std::string& plugin) {
+    CORRADE_PROFILE_SCOPE("PluginManager::AbstractManager::load()");
+
     #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
     /* File path passed, load directly */
     if(Utility::String::endsWith(plugin, PLUGIN_FILENAME_SUFFIX)) {
@@ -555,20 +978,18 @@ LoadState AbstractManager::load(const std::string& plugin) {
         /* Load the plugin and register it only if loading succeeded so we
            don't crap the alias state. If there's already a registered
            plugin of this name, replace it. */
-        Containers::Pointer<Plugin> data{new Plugin{name, Directory::join(Utility::Directory::path(plugin), name + ".conf"), this}};
-        const LoadState state = loadInternal(*data, plugin);
+        Containers::Pointer<Plugin> data{Plugin::createDynamic(name, plugin, Directory::join(Utility::Directory::path(plugin), name + ".conf"), *this)};
+        const LoadState state = loadInternal(*data, plugin, false);
         if(state & LoadState::Loaded) {
             /* Remove the potential plugin with the same name (we already
                checked above that it's *not* loaded) */
             if(found != globalPlugins->end()) {
                 /* Erase all aliases that reference this plugin, as they would
                    be dangling now. */
-                auto ait = _state->aliases.cbegin();
-                while(ait != _state->aliases.cend()) {
-                    if(&ait->second == found->second)
-                        ait = _state->aliases.erase(ait);
-                    else ++ait;
-                }
+                Plugin* const replaced = found->second;
+                _state->aliases.removeIf([replaced](const Containers::HashMapEntry<Containers::String, Plugin*>& alias) {
+                    return alias.value() == replaced;
+                });
 
                 /* Erase the plugin from the plugin map. It could happen that
                    the original plugin was not owned by this plugin manager --
@@ -584,12 +1005,11 @@ LoadState AbstractManager::load(const std::string& plugin) {
     }
     #endif
 
-    auto found = _state->aliases.find(plugin);
-    if(found != _state->aliases.end()) {
+    if(Plugin* const* const found = _state->aliases.find(plugin)) {
         #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
-        return loadInternal(found->second);
+        return loadInternal(**found);
         #else
-        return found->second.loadState;
+        return (*found)->loadState;
         #endif
     }
 
@@ -602,12 +1022,229 @@ LoadState AbstractManager::load(const std::string& plugin) {
     return LoadState::NotFound;
 }
 
-#ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+std::vector<LoadState> AbstractManager::load(const std::initializer_list<std::string> plugins) {
+    return load(std::vector<std::string>{plugins});
+}
+
+#ifdef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+std::vector<LoadState> AbstractManager::load(const std::vector<std::string>& plugins) {
+    std::vector<LoadState> out;
+    out.reserve(plugins.size());
+    for(const std::string& plugin: plugins)
+        out.push_back(load(plugin));
+    return out;
+}
+#else
+namespace {
+
+/* A plugin binary to be opened from a worker thread. The error message has
+   to be saved as dlerror() is thread-local. The open time and worker index
+   are saved for the load trace. */
+struct PluginToOpen {
+    AbstractManager::Plugin* plugin;
+    std::string filename;
+    #ifndef CORRADE_TARGET_WINDOWS
+    void* module;
+    std::string error;
+    #else
+    HMODULE module;
+    DWORD error;
+    #endif
+    std::uint64_t begin;
+    std::uint64_t end;
+    std::size_t thread;
+};
+
+void openPlugin(PluginToOpen& plugin, const std::size_t thread) {
+    plugin.thread = thread;
+    plugin.begin = timestamp();
+    #ifndef CORRADE_TARGET_WINDOWS
+    plugin.module = dlopen(plugin.filename.data(), RTLD_NOW|RTLD_GLOBAL);
+    if(!plugin.module) plugin.error = dlerror();
+    #else
+    plugin.module = LoadLibraryW(widen(plugin.filename).data());
+    if(!plugin.module) plugin.error = GetLastError();
+    #endif
+    plugin.end = timestamp();
+}
+
+void openPlugins(std::vector<PluginToOpen>& plugins) {
+    #ifdef CORRADE_BUILD_MULTITHREADED
+    /* Not worth spawning any threads for a single plugin */
+    const std::size_t threadCount = std::min<std::size_t>(plugins.size(), std::thread::hardware_concurrency());
+    if(threadCount > 1) {
+        std::atomic<std::size_t> next{0};
+        auto worker = [&plugins, &next](const std::size_t thread) {
+            for(std::size_t i; (i = next++) < plugins.size(); )
+                openPlugin(plugins[i], thread);
+        };
+
+        /* The calling thread is one of the workers as well */
+        std::vector<std::thread> threads;
+        threads.reserve(threadCount - 1);
+        for(std::size_t i = 1; i != threadCount; ++i)
+            threads.emplace_back(worker, i);
+        worker(0);
+        for(std::thread& thread: threads) thread.join();
+        return;
+    }
+    #endif
+
+    for(PluginToOpen& plugin: plugins) openPlugin(plugin, 0);
+}
+
+}
+
+std::vector<LoadState> AbstractManager::load(const std::vector<std::string>& plugins) {
+    CORRADE_PROFILE_SCOPE("PluginManager::AbstractManager::load()");
+
+    /* With deferred loading there's nothing to parallelize */
+    if(_state->loadFlags & LoadFlag::Lazy) {
+        std::vector<LoadState> out;
+        out.reserve(plugins.size());
+        for(const std::string& plugin: plugins)
+            out.push_back(load(plugin));
+        return out;
+    }
+
+    /* Collect all requested plugins and their dependencies that are not
+       loaded yet, in the order they were requested. Plugin file paths and
+       unknown names are left for the serial load() at the end. */
+    std::vector<Plugin*> pending;
+    {
+        std::vector<Plugin*> stack;
+        for(const std::string& name: plugins) {
+            if(Utility::String::endsWith(name, PLUGIN_FILENAME_SUFFIX))
+                continue;
+            Plugin* const* const found = _state->aliases.find(name);
+            if(!found) continue;
+
+            stack.push_back(*found);
+            while(!stack.empty()) {
+                Plugin* const plugin = stack.back();
+                stack.pop_back();
+                if(plugin->loadState != LoadState::NotLoaded || !plugin->manager ||
+                   std::find(pending.begin(), pending.end(), plugin) != pending.end())
+                    continue;
+
+                pending.push_back(plugin);
+                for(auto it = plugin->metadata->_depends.rbegin(); it != plugin->metadata->_depends.rend(); ++it) {
+                    const auto foundDependency = globalPlugins->find(*it);
+                    if(foundDependency != globalPlugins->end())
+                        stack.push_back(foundDependency->second);
+                }
+            }
+        }
+    }
+
+    /* Failures from the waves, so they're not retried (and reported twice)
+       for the requested plugins at the end */
+    std::map<Plugin*, LoadState> failed;
+
+    /* Process the plugins in waves consisting of plugins with all
+       dependencies loaded. A plugin with a dependency that's missing or
+       failed to load never gets into a wave and the serial load() at the end
+       prints a diagnostic for it. */
+    for(;;) {
+        std::vector<PluginToOpen> wave;
+        for(auto it = pending.begin(); it != pending.end(); ) {
+            Plugin& plugin = **it;
+            bool ready = true;
+            for(const std::string& dependency: plugin.metadata->_depends) {
+                /* Plugins with deferred dependencies (loaded by another
+                   manager with LoadFlag::Lazy) are left for the serial load()
+                   at the end, which opens the dependencies first */
+                const auto found = globalPlugins->find(dependency);
+                if(found == globalPlugins->end() || !(found->second->loadState & (LoadState::Loaded|LoadState::Static)) || found->second->deferred) {
+                    ready = false;
+                    break;
+                }
+            }
+
+            if(ready) {
+                wave.push_back({&plugin, Directory::join(plugin.manager->_state->pluginDirectory, plugin.metadata->_name + PLUGIN_FILENAME_SUFFIX), {}, {}, {}, {}, {}});
+                it = pending.erase(it);
+            } else ++it;
+        }
+
+        if(wave.empty()) break;
+
+        openPlugins(wave);
+
+        /* Initialize the plugins on this thread, in the order they were
+           scheduled */
+        for(PluginToOpen& opened: wave) {
+            Plugin& plugin = *opened.plugin;
+            plugin.statistics.openDuration += _state->record(plugin.metadata->_name, "open", opened.begin, opened.end, opened.thread);
+            LoadState state;
+            if(!opened.module) {
+                Error{} << "PluginManager::Manager::load(): cannot load plugin"
+                        << plugin.metadata->_name << "from \"" << Debug::nospace
+                        << opened.filename << Debug::nospace << "\":" << opened.error;
+                state = LoadState::LoadFailed;
+            } else {
+                plugin.module = opened.module;
+                plugin.filename = opened.filename;
+                state = plugin.manager->loadOpenedInternal(plugin);
+            }
+
+            if(!(state & LoadState::Loaded)) failed.emplace(&plugin, state);
+        }
+    }
+
+    /* Plugins depending on a plugin that failed in the waves fail as well,
+       report that directly instead of trying to load the dependency again
+       below */
+    for(bool changed = true; changed; ) {
+        changed = false;
+        for(auto it = pending.begin(); it != pending.end(); ) {
+            Plugin& plugin = **it;
+            const std::string* failedDependency = nullptr;
+            for(const std::string& dependency: plugin.metadata->_depends) {
+                const auto found = globalPlugins->find(dependency);
+                if(found != globalPlugins->end() && failed.find(found->second) != failed.end()) {
+                    failedDependency = &dependency;
+                    break;
+                }
+            }
+
+            if(failedDependency) {
+                Error() << "PluginManager::Manager::load(): unresolved dependency" << *failedDependency << "of plugin" << plugin.metadata->_name;
+                failed.emplace(&plugin, LoadState::UnresolvedDependency);
+                it = pending.erase(it);
+                changed = true;
+            } else ++it;
+        }
+    }
+
+    std::vector<LoadState> out;
+    out.reserve(plugins.size());
+    for(const std::string& name: plugins) {
+        const auto found = _state->aliases.find(name);
+        if(found) {
+            const auto foundFailed = failed.find(*found);
+            if(foundFailed != failed.end()) {
+                out.push_back(foundFailed->second);
+                continue;
+            }
+        }
+
+        out.push_back(load(name));
+    }
+
+    return out;
+}
+
 LoadState AbstractManager::loadInternal(Plugin& plugin) {
-    return loadInternal(plugin, Directory::join(_state->pluginDirectory, plugin.metadata->_name + PLUGIN_FILENAME_SUFFIX));
+    /* Don't assemble the filename if the plugin is already loaded, which is
+       the common case when the same alias is resolved over and over */
+    if(plugin.loadState != LoadState::NotLoaded)
+        return loadInternal(plugin, {}, false);
+
+    return loadInternal(plugin, Directory::join(_state->pluginDirectory, plugin.metadata->_name + PLUGIN_FILENAME_SUFFIX), !!(_state->loadFlags & LoadFlag::Lazy));
 }
 
-LoadState AbstractManager::loadInternal(Plugin& plugin, const std::string& filename) {
+LoadState AbstractManager::loadInternal(Plugin& plugin, const std::string& filename, const bool defer) {
     /* Plugin is not ready to load */
     if(plugin.loadState != LoadState::NotLoaded) {
         if(!(plugin.loadState & (LoadState::Static|LoadState::Loaded)))
@@ -615,32 +1252,52 @@ LoadState AbstractManager::loadInternal(Plugin& plugin, const std::string& filen
         return plugin.loadState;
     }
 
-    /* Load dependencies and remember their names for later. Their names will
-       be added to usedBy list only if everything goes well. */
-    std::vector<Containers::Reference<Plugin>> dependencies;
-    dependencies.reserve(plugin.metadata->_depends.size());
+    plugin.filename = filename;
+
+    /* Load dependencies. Their usedBy list gets updated only if everything
+       goes well. */
+    const std::uint64_t dependencyBegin = timestamp();
     for(const std::string& dependency: plugin.metadata->_depends) {
         /* Find manager which is associated to this plugin and load the plugin
            with it */
         const auto foundDependency = globalPlugins->find(dependency);
 
+        /* If this plugin isn't deferred, deferred dependencies have to be
+           opened now so this one can use their symbols */
         if(foundDependency == globalPlugins->end() || !foundDependency->second->manager ||
-           !(foundDependency->second->manager->loadInternal(*foundDependency->second) & LoadState::Loaded))
+           !(foundDependency->second->manager->loadInternal(*foundDependency->second) & LoadState::Loaded) ||
+           (!defer && foundDependency->second->deferred && !(foundDependency->second->manager->loadDeferredInternal(*foundDependency->second) & LoadState::Loaded)))
         {
             Error() << "PluginManager::Manager::load(): unresolved dependency" << dependency << "of plugin" << plugin.metadata->_name;
             return LoadState::UnresolvedDependency;
         }
-
-        dependencies.emplace_back(*foundDependency->second);
+    }
+    if(!plugin.metadata->_depends.empty())
+        plugin.statistics.dependencyDuration += _state->record(plugin.metadata->_name, "dependencies", dependencyBegin, timestamp());
+
+    /* Deferred load, the binary gets opened by loadDeferredInternal() on
+       first instantiation */
+    if(defer) {
+        for(const std::string& dependency: plugin.metadata->_depends)
+            globalPlugins->find(dependency)->second->metadata->_usedBy.push_back(plugin.metadata->_name);
+
+        plugin.loadState = LoadState::Loaded;
+        plugin.deferred = true;
+        plugin.module = nullptr;
+        plugin.instancer = nullptr;
+        plugin.finalizer = nullptr;
+        return LoadState::Loaded;
     }
 
     /* Open plugin file, make symbols globally available for next libs (which
        may depend on this) */
+    const std::uint64_t openBegin = timestamp();
     #ifndef CORRADE_TARGET_WINDOWS
     void* module = dlopen(filename.data(), RTLD_NOW|RTLD_GLOBAL);
     #else
     HMODULE module = LoadLibraryW(widen(filename).data());
     #endif
+    plugin.statistics.openDuration += _state->record(plugin.metadata->_name, "open", openBegin, timestamp());
     if(!module) {
         Error{} << "PluginManager::Manager::load(): cannot load plugin"
                 << plugin.metadata->_name << "from \"" << Debug::nospace
@@ -648,6 +1305,16 @@ LoadState AbstractManager::loadInternal(Plugin& plugin, const std::string& filen
         return LoadState::LoadFailed;
     }
 
+    plugin.module = module;
+    return loadOpenedInternal(plugin);
+}
+
+LoadState AbstractManager::loadOpenedInternal(Plugin& plugin) {
+    /* Expects that plugin.module is already opened and all dependencies are
+       loaded, either by loadInternal() above, by load() of a plugin list or
+       by loadDeferredInternal() below */
+    const auto module = plugin.module;
+
     /* Check plugin version */
     #ifdef __GNUC__ /* http://www.mr-edd.co.uk/blog/supressing_gcc_warnings */
     __extension__
@@ -721,28 +1388,75 @@ LoadState AbstractManager::loadInternal(Plugin& plugin, const std::string& filen
     }
 
     /* Initialize plugin */
-    initializer();
-
-    /* Everything is okay, add this plugin to usedBy list of each dependency */
-    for(Plugin& dependency: dependencies)
-        dependency.metadata->_usedBy.push_back(plugin.metadata->_name);
+    const std::uint64_t initializerBegin = timestamp();
+    /* With a registry, the plugin is initialized only if no other manager
+       has it loaded already */
+    if(_state->registry) _state->registry->initializeModule(module, initializer);
+    else initializer();
+    plugin.statistics.initializerDuration += _state->record(plugin.metadata->_name, "initializer", initializerBegin, timestamp());
+
+    /* Everything is okay, add this plugin to usedBy list of each dependency.
+       All of them are guaranteed to be loaded at this point. For deferred
+       plugins this was done already in loadInternal(). */
+    if(!plugin.deferred) for(const std::string& dependency: plugin.metadata->_depends)
+        globalPlugins->find(dependency)->second->metadata->_usedBy.push_back(plugin.metadata->_name);
 
     /* Update plugin object, set state to loaded */
     plugin.loadState = LoadState::Loaded;
+    plugin.deferred = false;
     plugin.module = module;
     plugin.instancer = instancer;
     plugin.finalizer = finalizer;
     return LoadState::Loaded;
 }
+
+LoadState AbstractManager::loadDeferredInternal(Plugin& plugin) {
+    CORRADE_INTERNAL_ASSERT(plugin.deferred);
+
+    /* Open deferred dependencies first so their symbols are available and
+       their initializers are called before this one. The dependencies are
+       guaranteed to be loaded at this point. */
+    for(const std::string& dependency: plugin.metadata->_depends) {
+        Plugin& dependencyPlugin = *globalPlugins->find(dependency)->second;
+        if(!dependencyPlugin.deferred) continue;
+
+        const LoadState state = dependencyPlugin.manager->loadDeferredInternal(dependencyPlugin);
+        if(!(state & LoadState::Loaded)) return state;
+    }
+
+    /* Resolve symbols lazily. Make them globally available only if some
+       other plugin depends on this one or if not requested otherwise. */
+    const std::string filename = Directory::join(_state->pluginDirectory, plugin.metadata->_name + PLUGIN_FILENAME_SUFFIX);
+    const std::uint64_t openBegin = timestamp();
+    #ifndef CORRADE_TARGET_WINDOWS
+    const int flags = RTLD_LAZY|(_state->loadFlags & LoadFlag::Local && plugin.metadata->_usedBy.empty() ? RTLD_LOCAL : RTLD_GLOBAL);
+    void* module = dlopen(filename.data(), flags);
+    #else
+    HMODULE module = LoadLibraryW(widen(filename).data());
+    #endif
+    plugin.statistics.openDuration += _state->record(plugin.metadata->_name, "open", openBegin, timestamp());
+    if(!module) {
+        Error{} << "PluginManager::Manager::load(): cannot load plugin"
+                << plugin.metadata->_name << "from \"" << Debug::nospace
+                << filename << Debug::nospace << "\":" << dlerror();
+        return LoadState::LoadFailed;
+    }
+
+    plugin.module = module;
+    const LoadState state = loadOpenedInternal(plugin);
+    /* On failure the module got closed, the plugin stays deferred */
+    if(!(state & LoadState::Loaded)) plugin.module = nullptr;
+    return state;
+}
 #endif
 
 LoadState AbstractManager::unload(const std::string& plugin) {
     auto found = _state->aliases.find(plugin);
-    if(found != _state->aliases.end()) {
+    if(found) {
         #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
-        return unloadInternal(found->second);
+        return unloadInternal(**found);
         #else
-        return found->second.loadState;
+        return (*found)->loadState;
         #endif
     }
 
@@ -751,7 +1465,7 @@ LoadState AbstractManager::unload(const std::string& plugin) {
 }
 
 #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
-LoadState AbstractManager::unloadInternal(Plugin& plugin) {
+LoadState AbstractManager::unloadInternal(Plugin& plugin, const bool fastShutdown) {
     /* Plugin is not ready to unload, nothing to do. The only thing this can
        happen is when the plugin is static or not loaded (which is fine, so we
        just return that load state) or when its metadata file is broken (which
@@ -801,14 +1515,27 @@ LoadState AbstractManager::unloadInternal(Plugin& plugin) {
         }
     }
 
-    /* Finalize plugin */
-    plugin.finalizer();
+    /* Deferred plugin that was never opened, nothing to finalize or close */
+    if(plugin.deferred) {
+        plugin.loadState = LoadState::NotLoaded;
+        plugin.deferred = false;
+        return LoadState::NotLoaded;
+    }
+
+    /* Finalize plugin. With a registry, only if no other manager has it
+       loaded anymore, the registry has to be told about the module going
+       away even if the finalizer is skipped on a fast shutdown. */
+    void(*const finalizer)() = fastShutdown && plugin.metadata->isFinalizerOptional() ? [] {} : plugin.finalizer;
+    if(_state->registry) _state->registry->finalizeModule(plugin.module, finalizer);
+    else finalizer();
 
-    /* Close the module */
+    /* Close the module. On fast shutdown it's left for the OS to unmap at
+       process exit, which avoids running library destructors and paging in
+       code that was never used. */
     #ifndef CORRADE_TARGET_WINDOWS
-    if(dlclose(plugin.module) != 0) {
+    if(!fastShutdown && dlclose(plugin.module) != 0) {
     #else
-    if(!FreeLibrary(plugin.module)) {
+    if(!fastShutdown && !FreeLibrary(plugin.module)) {
     #endif
         /* This is hard to test, the only possibility I can think of is
            dlclose() when a symbol is still needed (by another plugin, e.g.),
@@ -828,55 +1555,156 @@ LoadState AbstractManager::unloadInternal(Plugin& plugin) {
     plugin.finalizer = nullptr;
     return LoadState::NotLoaded;
 }
+
+LoadState AbstractManager::reload(const std::string& plugin) {
+    Plugin* const* const found = _state->aliases.find(plugin);
+    if(!found) {
+        Error{} << "PluginManager::Manager::reload(): plugin" << plugin << "was not found";
+        return LoadState::NotFound;
+    }
+
+    /* Static and not loaded plugins have nothing to reload */
+    if((*found)->loadState != LoadState::Loaded)
+        return (*found)->loadState;
+
+    /* Collect the plugin and everything that depends on it, possibly from
+       other managers, each plugin after all its dependents. That's the order
+       in which they get unloaded, loading is done in reverse. */
+    std::vector<Plugin*> plugins;
+    {
+        std::vector<std::pair<Plugin*, std::size_t>> stack{{*found, 0}};
+        while(!stack.empty()) {
+            Plugin& current = *stack.back().first;
+            const std::size_t next = stack.back().second++;
+            if(next < current.metadata->_usedBy.size()) {
+                const auto foundDependent = globalPlugins->find(current.metadata->_usedBy[next]);
+                if(foundDependent != globalPlugins->end() && std::find(plugins.begin(), plugins.end(), foundDependent->second) == plugins.end())
+                    stack.emplace_back(foundDependent->second, 0);
+                continue;
+            }
+
+            stack.pop_back();
+            if(std::find(plugins.begin(), plugins.end(), &current) == plugins.end())
+                plugins.push_back(&current);
+        }
+    }
+
+    /* Remember which of them were deferred so they're deferred again */
+    std::vector<bool> deferred;
+    deferred.reserve(plugins.size());
+    for(Plugin* const p: plugins) deferred.push_back(p->deferred);
+
+    /* Unload everything, stop on first failure */
+    LoadState failure{};
+    std::size_t unloaded = 0;
+    for(; unloaded != plugins.size(); ++unloaded) {
+        Plugin& p = *plugins[unloaded];
+        AbstractManager& manager = *p.manager;
+        if(manager._state->reloadCallback)
+            manager._state->reloadCallback(manager, p.metadata->_name, ReloadEvent::Unload, manager._state->reloadCallbackState);
+
+        const LoadState state = manager.unloadInternal(p);
+        if(state != LoadState::NotLoaded) {
+            failure = state;
+            break;
+        }
+    }
+
+    /* Load everything back in reverse order. On failure only the plugins
+       that were unloaded, including the one that failed, as the callback was
+       already called for it. */
+    for(std::size_t i = failure == LoadState{} ? plugins.size() : unloaded + 1; i != 0; --i) {
+        Plugin& p = *plugins[i - 1];
+        AbstractManager& manager = *p.manager;
+        if(p.loadState == LoadState::NotLoaded) {
+            const LoadState state = manager.loadInternal(p, p.filename, deferred[i - 1]);
+            if(!(state & LoadState::Loaded)) {
+                if(failure == LoadState{}) failure = state;
+                continue;
+            }
+        }
+
+        if(manager._state->reloadCallback)
+            manager._state->reloadCallback(manager, p.metadata->_name, ReloadEvent::Reload, manager._state->reloadCallbackState);
+    }
+
+    return failure == LoadState{} ? LoadState::Loaded : failure;
+}
+
+std::vector<std::string> AbstractManager::reloadChanged() {
+    /* Binaries are replaced by the linker as a whole, ignore the short time
+       where they're missing or empty */
+    if(!_state->watcher) _state->watcher.emplace(Utility::FileWatcher::Flag::IgnoreErrors|Utility::FileWatcher::Flag::IgnoreChangeIfEmpty);
+
+    /* Start watching plugins that got loaded since the last time. Deferred
+       plugins have a binary as well, a change in it is picked up once it's
+       opened. */
+    for(const std::pair<const std::string, Plugin*>& plugin: *globalPlugins) {
+        if(plugin.second->manager != this || plugin.second->loadState != LoadState::Loaded || plugin.second->filename.empty() || _state->watchedFiles.find(plugin.second->filename) != _state->watchedFiles.end())
+            continue;
+
+        _state->watchedFiles.emplace(plugin.second->filename, _state->watcher->add(plugin.second->filename));
+        _state->watchedPlugins.push_back(plugin.first);
+    }
+
+    std::vector<std::string> out;
+    for(const std::size_t id: _state->watcher->changed()) {
+        /* Skip plugins that got unloaded or replaced with a different file
+           since */
+        const std::string& name = _state->watchedPlugins[id];
+        const auto found = globalPlugins->find(name);
+        if(found == globalPlugins->end() || found->second->manager != this || found->second->loadState != LoadState::Loaded || found->second->filename != _state->watcher->filename(id))
+            continue;
+
+        if(reload(name) == LoadState::Loaded) out.push_back(name);
+    }
+
+    return out;
+}
 #endif
 
 void AbstractManager::registerDynamicPlugin(const std::string& name, Plugin* const plugin) {
     /* Insert plugin to list */
     const auto result = globalPlugins->insert({name, plugin});
     CORRADE_INTERNAL_ASSERT(result.second);
+    _state->dataIndex.clear();
 
     /* The plugin is the best version of itself. If there was already an
        alias for this name, replace it. */
     {
-        const auto alias = _state->aliases.find(name);
-        if(alias != _state->aliases.end()) _state->aliases.erase(alias);
-        CORRADE_INTERNAL_ASSERT_OUTPUT(_state->aliases.insert({name, *result.first->second}).second);
+        _state->aliases.remove(name);
+        CORRADE_INTERNAL_ASSERT_OUTPUT(_state->aliases.insert(name, result.first->second).second);
     }
 
     /* Add aliases to the list. Calling insert() won't overwrite the
        existing value, which ensures that the above note is still held. */
-    for(const std::string& alias: result.first->second->metadata->_provides) {
-        /* Libc++ frees the passed Plugin& reference when using emplace(),
-           causing double-free memory corruption later. Everything is okay
-           with insert(). */
-        /** @todo put back emplace() here when libc++ is fixed */
-        _state->aliases.insert({alias, *result.first->second});
-    }
+    for(const std::string& alias: result.first->second->metadata->_provides)
+        _state->aliases.insert(alias, result.first->second);
 }
 
 void AbstractManager::registerInstance(const std::string& plugin, AbstractPlugin& instance, const PluginMetadata*& metadata) {
     /** @todo assert proper interface */
     auto found = _state->aliases.find(plugin);
 
-    CORRADE_ASSERT(found != _state->aliases.end() && found->second.manager == this,
+    CORRADE_ASSERT(found && (*found)->manager == this,
         "PluginManager::AbstractPlugin::AbstractPlugin(): attempt to register instance of plugin not known to given manager", );
 
     auto foundInstance = _state->instances.find(plugin);
 
     if(foundInstance == _state->instances.end())
-        foundInstance = _state->instances.insert({found->second.metadata->name(), {}}).first;
+        foundInstance = _state->instances.insert({(*found)->metadata->name(), {}}).first;
 
     foundInstance->second.push_back(&instance);
 
-    metadata = &*found->second.metadata;
+    metadata = &*(*found)->metadata;
 }
 
 void AbstractManager::reregisterInstance(const std::string& plugin, AbstractPlugin& oldInstance, AbstractPlugin* const newInstance) {
     auto found = _state->aliases.find(plugin);
 
-    CORRADE_INTERNAL_ASSERT(found != _state->aliases.end() && found->second.manager == this);
+    CORRADE_INTERNAL_ASSERT(found && (*found)->manager == this);
 
-    auto foundInstance = _state->instances.find(found->second.metadata->name());
+    auto foundInstance = _state->instances.find((*found)->metadata->name());
     CORRADE_INTERNAL_ASSERT(foundInstance != _state->instances.end());
     std::vector<AbstractPlugin*>& instancesForPlugin = foundInstance->second;
 
@@ -895,10 +1723,15 @@ void AbstractManager::reregisterInstance(const std::string& plugin, AbstractPlug
 Containers::Pointer<AbstractPlugin> AbstractManager::instantiateInternal(const std::string& plugin) {
     auto found = _state->aliases.find(plugin);
 
-    CORRADE_ASSERT(found != _state->aliases.end() && (found->second.loadState & LoadState::Loaded),
+    CORRADE_ASSERT(found && ((*found)->loadState & LoadState::Loaded),
         "PluginManager::Manager::instantiate(): plugin" << plugin << "is not loaded", nullptr);
 
-    return Containers::pointer(static_cast<AbstractPlugin*>(found->second.instancer(*this, plugin)));
+    #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+    if((*found)->deferred && !((*found)->manager->loadDeferredInternal(**found) & LoadState::Loaded))
+        return nullptr;
+    #endif
+
+    return Containers::pointer(static_cast<AbstractPlugin*>((*found)->instantiate(*this, plugin)));
 }
 
 Containers::Pointer<AbstractPlugin> AbstractManager::loadAndInstantiateInternal(const std::string& plugin) {
@@ -910,14 +1743,18 @@ Containers::Pointer<AbstractPlugin> AbstractManager::loadAndInstantiateInternal(
         const std::string filename = Utility::Directory::filename(plugin);
         const std::string name = filename.substr(0, filename.length() - sizeof(PLUGIN_FILENAME_SUFFIX) + 1);
         auto found = _state->aliases.find(name);
-        CORRADE_INTERNAL_ASSERT(found != _state->aliases.end());
-        return Containers::pointer(static_cast<AbstractPlugin*>(found->second.instancer(*this, name)));
+        CORRADE_INTERNAL_ASSERT(found);
+        return Containers::pointer(static_cast<AbstractPlugin*>((*found)->instantiate(*this, name)));
     }
     #endif
 
     auto found = _state->aliases.find(plugin);
-    CORRADE_INTERNAL_ASSERT(found != _state->aliases.end());
-    return Containers::pointer(static_cast<AbstractPlugin*>(found->second.instancer(*this, plugin)));
+    CORRADE_INTERNAL_ASSERT(found);
+    #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+    if((*found)->deferred && !((*found)->manager->loadDeferredInternal(**found) & LoadState::Loaded))
+        return nullptr;
+    #endif
+    return Containers::pointer(static_cast<AbstractPlugin*>((*found)->instantiate(*this, plugin)));
 }
 
 #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
@@ -933,6 +1770,10 @@ AbstractManager::Plugin::Plugin(std::string name, const std::string& metadata, A
 
     loadState = LoadState::WrongMetadataFile;
 }
+
+AbstractManager::Plugin::Plugin(std::string name, std::istream& metadata, AbstractManager* manager): configuration{metadata, Utility::Configuration::Flag::ReadOnly}, metadata{Containers::InPlaceInit, std::move(name), configuration}, manager{manager}, instancer{nullptr}, module{nullptr} {
+    loadState = configuration.isValid() ? LoadState::NotLoaded : LoadState::WrongMetadataFile;
+}
 #endif
 
 AbstractManager::Plugin::Plugin(const Implementation::StaticPlugin& staticPlugin): loadState{LoadState::Static}, manager{nullptr}, instancer{staticPlugin.instancer}, staticPlugin{&staticPlugin} {}
@@ -986,6 +1827,42 @@ Utility::Debug& operator<<(Utility::Debug& debug, const LoadStates value) {
         });
 }
 
+#ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+Utility::Debug& operator<<(Utility::Debug& debug, const LoadFlag value) {
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case LoadFlag::value: return debug << "PluginManager::LoadFlag::" #value;
+        _c(Lazy)
+        _c(Local)
+        _c(FastShutdown)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "PluginManager::LoadFlag(" << Debug::nospace << reinterpret_cast<void*>(std::uint8_t(value)) << Debug::nospace << ")";
+}
+
+Utility::Debug& operator<<(Utility::Debug& debug, const LoadFlags value) {
+    return Containers::enumSetDebugOutput(debug, value, "PluginManager::LoadFlags{}", {
+        LoadFlag::Lazy,
+        LoadFlag::Local,
+        LoadFlag::FastShutdown});
+}
+
+Utility::Debug& operator<<(Utility::Debug& debug, const ReloadEvent value) {
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case ReloadEvent::value: return debug << "PluginManager::ReloadEvent::" #value;
+        _c(Unload)
+        _c(Reload)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "PluginManager::ReloadEvent(" << Debug::nospace << reinterpret_cast<void*>(std::uint8_t(value)) << Debug::nospace << ")";
+}
+#endif
+
 #endif
 
 }}
@@ -26,9 +26,11 @@
 */
 
 /** @file
- * @brief Class @ref Corrade::PluginManager::AbstractManager, macro @ref CORRADE_PLUGIN_VERSION, @ref CORRADE_PLUGIN_REGISTER()
+ * @brief Class @ref Corrade::PluginManager::AbstractManager, struct @ref Corrade::PluginManager::LoadStatistics, macro @ref CORRADE_PLUGIN_VERSION, @ref CORRADE_PLUGIN_REGISTER()
  */
 
+#include <cstdint>
+
 #include "Corrade/Containers/EnumSet.h"
 #include "Corrade/Containers/Pointer.h"
 #include "Corrade/PluginManager/PluginManager.h"
@@ -189,6 +191,161 @@ CORRADE_ENUMSET_OPERATORS(LoadStates)
 /** @debugoperatorenum{LoadStates} */
 CORRADE_PLUGINMANAGER_EXPORT Utility::Debug& operator<<(Utility::Debug& debug, PluginManager::LoadStates value);
 
+/**
+@brief Plugin load statistics
+@m_since_latest
+
+Time spent in particular phases of loading and instantiating a plugin, in
+nanoseconds. The durations are accumulated over all loads and instantiations
+of the plugin, except for @ref metadataDuration, which is set each time the
+metadata get parsed. Phases that didn't happen are zero. Retrieved using
+@ref AbstractManager::loadStatistics(), see also
+@ref AbstractManager::loadTrace() for a timeline of all phases.
+*/
+struct LoadStatistics {
+    /** @brief Time spent parsing the metadata file */
+    std::uint64_t metadataDuration;
+
+    /**
+     * @brief Time spent opening the plugin binary
+     *
+     * Includes resolution of the binary's own library dependencies done by
+     * the dynamic linker. Always zero for static plugins.
+     */
+    std::uint64_t openDuration;
+
+    /**
+     * @brief Time spent loading plugin dependencies
+     *
+     * Includes all phases of the dependencies that weren't loaded yet.
+     */
+    std::uint64_t dependencyDuration;
+
+    /** @brief Time spent in the plugin initializer */
+    std::uint64_t initializerDuration;
+
+    /** @brief Time spent in the plugin constructor */
+    std::uint64_t instantiationDuration;
+
+    /** @brief Count of instantiations */
+    std::size_t instantiationCount;
+};
+
+#ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+/**
+@brief Plugin load flag
+@m_since_latest
+
+@see @ref LoadFlags, @ref AbstractManager::setLoadFlags()
+@partialsupport Not available on platforms without
+    @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support".
+*/
+enum class LoadFlag: unsigned char {
+    /**
+     * Defer opening the plugin binary. @ref AbstractManager::load() only
+     * resolves dependencies and marks the plugin as @ref LoadState::Loaded,
+     * the binary is opened with lazy symbol resolution on first
+     * @ref Manager::instantiate(). Because of that, plugin version and
+     * interface mismatches are reported only at that point. Plugins loaded
+     * from a file path are always opened immediately.
+     * @partialsupport On @ref CORRADE_TARGET_WINDOWS "Windows" the
+     *      binary opening is deferred, but the symbols are always resolved
+     *      immediately.
+     */
+    Lazy = 1 << 0,
+
+    /**
+     * Don't make symbols of deferred plugins that no other plugin currently
+     * depends on globally available. Has an effect only together with
+     * @ref LoadFlag::Lazy. Note that a plugin opened this way can't provide
+     * symbols to plugins that start depending on it later.
+     * @partialsupport Has no effect on @ref CORRADE_TARGET_WINDOWS "Windows",
+     *      where symbols of libraries are never globally available.
+     */
+    Local = 1 << 1,
+
+    /**
+     * Make the manager destruction fast, meant for destroying managers right
+     * before the application exits. Plugin instances are deleted as usual,
+     * but dynamic plugin binaries are left open for the operating system to
+     * unmap on process exit and finalizers of plugins that mark them as
+     * optional with @ref PluginMetadata::isFinalizerOptional() are not
+     * called. Because the binaries stay open, loading the same plugins again
+     * in another manager afterwards calls their initializers again without
+     * them being finalized.
+     */
+    FastShutdown = 1 << 2
+};
+
+/**
+@debugoperatorenum{LoadFlag}
+@m_since_latest
+*/
+CORRADE_PLUGINMANAGER_EXPORT Utility::Debug& operator<<(Utility::Debug& debug, PluginManager::LoadFlag value);
+
+/**
+@brief Plugin load flags
+@m_since_latest
+
+@see @ref AbstractManager::setLoadFlags()
+@partialsupport Not available on platforms without
+    @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support".
+*/
+typedef Containers::EnumSet<LoadFlag> LoadFlags;
+
+CORRADE_ENUMSET_OPERATORS(LoadFlags)
+
+/**
+@debugoperatorenum{LoadFlags}
+@m_since_latest
+*/
+CORRADE_PLUGINMANAGER_EXPORT Utility::Debug& operator<<(Utility::Debug& debug, PluginManager::LoadFlags value);
+
+/**
+@brief Plugin reload event
+@m_since_latest
+
+@see @ref ReloadCallback, @ref AbstractManager::setReloadCallback(),
+    @ref AbstractManager::reload()
+@partialsupport Not available on platforms without
+    @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support".
+*/
+enum class ReloadEvent: unsigned char {
+    /**
+     * The plugin is about to be unloaded. All its instances should be
+     * destroyed at this point, remaining instances are deleted by the manager
+     * if @ref AbstractPlugin::canBeDeleted() returns @cpp true @ce for them
+     * and the reload fails with @ref LoadState::Used otherwise.
+     */
+    Unload = 1,
+
+    /**
+     * The plugin was loaded again and its instances can be recreated. Also
+     * emitted if the reload failed and the plugin stayed loaded or was loaded
+     * back.
+     */
+    Reload
+};
+
+/**
+@debugoperatorenum{ReloadEvent}
+@m_since_latest
+*/
+CORRADE_PLUGINMANAGER_EXPORT Utility::Debug& operator<<(Utility::Debug& debug, PluginManager::ReloadEvent value);
+
+/**
+@brief Plugin reload callback
+@m_since_latest
+
+Called by @ref AbstractManager::reload() with the manager the plugin belongs
+to, the plugin name, the event and the state pointer passed to
+@ref AbstractManager::setReloadCallback().
+@partialsupport Not available on platforms without
+    @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support".
+*/
+typedef void(*ReloadCallback)(AbstractManager& manager, const std::string& plugin, ReloadEvent event, void* state);
+#endif
+
 namespace Implementation {
     struct StaticPlugin;
 }
@@ -199,6 +356,7 @@ namespace Implementation {
 See @ref Manager and @ref plugin-management for more information.
  */
 class CORRADE_PLUGINMANAGER_EXPORT AbstractManager {
+    friend AbstractInstancePool;
     friend AbstractPlugin;
 
     public:
@@ -239,7 +397,9 @@ class CORRADE_PLUGINMANAGER_EXPORT AbstractManager {
          *
          * Keeps loaded plugins untouched, removes unloaded plugins which are
          * not existing anymore and adds newly found plugins. The directory is
-         * expected to be in UTF-8.
+         * expected to be in UTF-8. If the manager was constructed with a
+         * @ref Registry, the directory is always rescanned and the result is
+         * saved into the registry for other managers.
          * @partialsupport Not available on platforms without
          *      @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support".
          */
@@ -253,6 +413,111 @@ class CORRADE_PLUGINMANAGER_EXPORT AbstractManager {
          *      @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support".
          */
         void reloadPluginDirectory();
+
+        /**
+         * @brief Metadata cache file
+         * @m_since_latest
+         *
+         * If set via @ref Manager::Manager(std::string, std::string), the
+         * file stores contents of metadata files of all dynamic plugins found
+         * during the last directory scan, together with their size and
+         * modification time. On construction,
+         * @ref setPluginDirectory() and @ref reloadPluginDirectory(), the size
+         * and modification time of all metadata files is retrieved in a
+         * single pass over the plugin directory using
+         * @ref Utility::Directory::listEntries() and metadata of plugins
+         * with matching entries are parsed directly from the memory-mapped
+         * cache. Only the remaining metadata files are opened, and the cache
+         * is rewritten in that case. Entries for other plugin directories are
+         * preserved, so one cache file can be shared across managers.
+         *
+         * If the cache file doesn't exist or is invalid, all metadata files
+         * are read as usual. If empty, no cache is used.
+         * @partialsupport Not available on platforms without
+         *      @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support".
+         */
+        std::string metadataCache() const;
+
+        /**
+         * @brief Plugin load flags
+         * @m_since_latest
+         *
+         * @partialsupport Not available on platforms without
+         *      @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support".
+         */
+        LoadFlags loadFlags() const;
+
+        /**
+         * @brief Set plugin load flags
+         * @m_since_latest
+         *
+         * Affects subsequent @ref load() calls, plugins that are already
+         * loaded are kept untouched. @ref LoadFlag::FastShutdown affects only
+         * the manager destruction. With @ref LoadFlag::Lazy, a typical
+         * workflow that registers all plugins from their metadata and then
+         * uses only a few of them opens just the binaries that actually get
+         * instantiated. By default no flags are set.
+         * @partialsupport Not available on platforms without
+         *      @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support".
+         */
+        void setLoadFlags(LoadFlags flags);
+
+        /**
+         * @brief Set a plugin reload callback
+         * @m_since_latest
+         *
+         * The @p callback is called by @ref reload() and @ref reloadChanged()
+         * for every plugin of this manager that gets unloaded and loaded
+         * again, with @p state passed to it. Use it to destroy and recreate
+         * live plugin instances. Pass @cpp nullptr @ce to reset it. See
+         * @ref PluginManager-Manager-hot-reload for more information.
+         * @partialsupport Not available on platforms without
+         *      @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support".
+         */
+        void setReloadCallback(ReloadCallback callback, void* state = nullptr);
+
+        /**
+         * @brief Reload a plugin
+         * @m_since_latest
+         *
+         * Unloads a dynamic plugin together with all plugins that depend on
+         * it and loads them again from the same files, leaving all other
+         * plugins untouched. Before each plugin is unloaded and after it's
+         * loaded again, the callback set with @ref setReloadCallback() of its
+         * manager is called with @ref ReloadEvent::Unload and
+         * @ref ReloadEvent::Reload.
+         *
+         * Returns @ref LoadState::Loaded on success. If the plugin is not
+         * loaded or is static, returns its load state without doing
+         * anything. If any of the plugins can't be unloaded, the already
+         * unloaded ones are loaded back and @ref LoadState::Used,
+         * @ref LoadState::UnloadFailed or @ref LoadState::NotFound is
+         * returned. If loading any of the plugins again fails, its failure
+         * state is returned and the plugin and its dependents stay unloaded.
+         * If the plugin is not found, prints a message to
+         * @ref Utility::Error and returns @ref LoadState::NotFound.
+         * @partialsupport Not available on platforms without
+         *      @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support".
+         */
+        LoadState reload(const std::string& plugin);
+
+        /**
+         * @brief Reload plugins with changed binaries
+         * @m_since_latest
+         *
+         * Watches binaries of all currently loaded dynamic plugins of this
+         * manager using @ref Utility::FileWatcherSet and calls @ref reload()
+         * on the ones that changed since the previous call. Plugins loaded
+         * since the previous call start to be watched at this point. Returns
+         * names of successfully reloaded plugins, the dependents that were
+         * reloaded together with them are not included. Calling this
+         * function often is cheap, as on Linux it's just a single
+         * non-blocking read if nothing changed. See
+         * @ref PluginManager-Manager-hot-reload for more information.
+         * @partialsupport Not available on platforms without
+         *      @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support".
+         */
+        std::vector<std::string> reloadChanged();
         #endif
 
         /**
@@ -288,6 +553,33 @@ class CORRADE_PLUGINMANAGER_EXPORT AbstractManager {
          */
         std::vector<std::string> aliasList() const;
 
+        /**
+         * @brief Plugins having given value in their metadata data section
+         * @m_since_latest
+         *
+         * Returns names of all plugins from @ref pluginList() that have
+         * @p value among values of @p key in @ref PluginMetadata::data(),
+         * sorted by name. For example, with plugin metadata containing
+         *
+         * @code{.ini}
+         * [data]
+         * extension=png
+         * extension=apng
+         * @endcode
+         *
+         * the plugin is returned for both @cpp pluginsForKey("extension", "png") @ce
+         * and @cpp pluginsForKey("extension", "apng") @ce. Values are compared
+         * exactly, so for example case-insensitive matching has to be done by
+         * normalizing both the metadata and the queried value.
+         *
+         * An index of all values of @p key is built on the first query for
+         * given key, so subsequent queries are just a hash map lookup
+         * instead of a pass through metadata of all plugins. The index is
+         * rebuilt after the plugin list changes, such as after
+         * @ref setPluginDirectory() or after @ref load() with a file path.
+         */
+        std::vector<std::string> pluginsForKey(const std::string& key, const std::string& value) const;
+
         /**
          * @brief Plugin metadata
          *
@@ -298,6 +590,39 @@ class CORRADE_PLUGINMANAGER_EXPORT AbstractManager {
         PluginMetadata* metadata(const std::string& plugin);
         const PluginMetadata* metadata(const std::string& plugin) const; /**< @overload */
 
+        /**
+         * @brief Plugin load statistics
+         * @m_since_latest
+         *
+         * Returns pointer to load statistics of given plugin or
+         * @cpp nullptr @ce, if given plugin is not found. The timings are
+         * collected always, the overhead is a few clock queries per plugin
+         * load and instantiation.
+         * @see @ref loadTrace()
+         */
+        const LoadStatistics* loadStatistics(const std::string& plugin) const;
+
+        /**
+         * @brief Plugin load trace
+         * @m_since_latest
+         *
+         * Returns a JSON in the Chrome
+         * [Trace Event Format](https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nwsKchNAySU/preview)
+         * with a complete event for every phase described in
+         * @ref LoadStatistics, done by this manager since its construction.
+         * The event name is the plugin name and the category is one of
+         * @cb{.json} "metadata" @ce, @cb{.json} "open" @ce,
+         * @cb{.json} "dependencies" @ce, @cb{.json} "initializer" @ce and
+         * @cb{.json} "instantiation" @ce. Timestamps are relative to
+         * construction of the manager. Plugin binaries opened in parallel by
+         * @ref load(const std::vector<std::string>&) are put on separate
+         * threads. Only the first instantiation of each plugin is included to
+         * keep the trace size bounded. The output can be opened in
+         * @m_class{m-doc-external} [Perfetto](https://ui.perfetto.dev) or
+         * `chrome://tracing`.
+         */
+        std::string loadTrace() const;
+
         /**
          * @brief Load state of a plugin
          *
@@ -344,6 +669,42 @@ class CORRADE_PLUGINMANAGER_EXPORT AbstractManager {
          */
         LoadState load(const std::string& plugin);
 
+        /**
+         * @brief Load a list of plugins
+         * @m_since_latest
+         *
+         * Equivalent to calling @ref load(const std::string&) on each item of
+         * @p plugins and returning the results in the same order, but plugins
+         * that don't depend on each other are opened in parallel. The
+         * diagnostic output is the same, but may be printed in a different
+         * order. The plugins and their not yet loaded
+         * dependencies are processed in waves --- first all plugins that have
+         * no unloaded dependencies, then all plugins that depend only on
+         * those, and so on. In each wave, plugin binaries are opened from
+         * multiple threads, and version checks and initializers of the
+         * plugins are then executed on the calling thread in the same order
+         * as with @ref load(const std::string&), i.e. always only after all
+         * dependencies of given plugin are initialized. Plugins that can't be
+         * scheduled this way, such as those with missing dependencies or
+         * plugin file paths, are loaded serially afterwards.
+         *
+         * Note that global constructors of the plugin binaries may be
+         * executed from a different thread than the calling one. If Corrade
+         * is built without @ref CORRADE_BUILD_MULTITHREADED, the binaries are
+         * opened serially.
+         * @partialsupport On platforms without
+         *      @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support"
+         *      is equivalent to calling @ref load(const std::string&) on each
+         *      item.
+         */
+        std::vector<LoadState> load(const std::vector<std::string>& plugins);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        std::vector<LoadState> load(std::initializer_list<std::string> plugins);
+
         /**
          * @brief Unload a plugin
          *
@@ -388,6 +749,8 @@ class CORRADE_PLUGINMANAGER_EXPORT AbstractManager {
     #endif
         #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
         explicit AbstractManager(std::string pluginInterface, const std::vector<std::string>& pluginSearchPaths, std::string pluginDirectory);
+        explicit AbstractManager(std::string pluginInterface, const std::vector<std::string>& pluginSearchPaths, std::string pluginDirectory, std::string metadataCache);
+        explicit AbstractManager(std::string pluginInterface, const std::vector<std::string>& pluginSearchPaths, std::string pluginDirectory, std::string metadataCache, Registry* registry);
         #else
         explicit AbstractManager(std::string pluginInterface);
         #endif
@@ -404,9 +767,12 @@ class CORRADE_PLUGINMANAGER_EXPORT AbstractManager {
         CORRADE_PLUGINMANAGER_LOCAL void reregisterInstance(const std::string& plugin, AbstractPlugin& oldInstance, AbstractPlugin* newInstance);
 
         #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+        CORRADE_PLUGINMANAGER_LOCAL void setPluginDirectoryInternal(std::string directory, bool useRegistry);
         CORRADE_PLUGINMANAGER_LOCAL LoadState loadInternal(Plugin& plugin);
-        CORRADE_PLUGINMANAGER_LOCAL LoadState loadInternal(Plugin& plugin, const std::string& filename);
-        CORRADE_PLUGINMANAGER_LOCAL LoadState unloadInternal(Plugin& plugin);
+        CORRADE_PLUGINMANAGER_LOCAL LoadState loadInternal(Plugin& plugin, const std::string& filename, bool defer);
+        CORRADE_PLUGINMANAGER_LOCAL LoadState loadOpenedInternal(Plugin& plugin);
+        CORRADE_PLUGINMANAGER_LOCAL LoadState loadDeferredInternal(Plugin& plugin);
+        CORRADE_PLUGINMANAGER_LOCAL LoadState unloadInternal(Plugin& plugin, bool fastShutdown = false);
         CORRADE_PLUGINMANAGER_LOCAL LoadState unloadRecursive(const std::string& plugin);
         CORRADE_PLUGINMANAGER_LOCAL LoadState unloadRecursiveInternal(Plugin& plugin);
         #endif
@@ -416,6 +782,9 @@ class CORRADE_PLUGINMANAGER_EXPORT AbstractManager {
 
 namespace Implementation {
 
+/* Filled by CORRADE_PLUGIN_REGISTER() with constant expressions, so the
+   compiler puts it directly into the data section and no code needs to run
+   to populate it. Importing a plugin is then just a linked list insertion. */
 struct StaticPlugin {
     /* Assuming both plugin and interface are static strings produced by the
        CORRADE_PLUGIN_REGISTER() macro, so there's no need to make an allocated
@@ -529,18 +898,15 @@ See @ref plugin-management for more information about plugin compilation.
 #ifdef CORRADE_STATIC_PLUGIN
 #define CORRADE_PLUGIN_REGISTER(name, className, interface_)                \
     namespace {                                                             \
-        Corrade::PluginManager::Implementation::StaticPlugin staticPlugin_##name; \
+        void* pluginInstancer_##name(Corrade::PluginManager::AbstractManager& manager, const std::string& plugin) { \
+            return new className(manager, plugin);                          \
+        }                                                                   \
+        Corrade::PluginManager::Implementation::StaticPlugin staticPlugin_##name{ \
+            #name, interface_, pluginInstancer_##name,                      \
+            className::initialize, className::finalize, nullptr};           \
     }                                                                       \
     int pluginImporter_##name();                                            \
     int pluginImporter_##name() {                                           \
-        staticPlugin_##name.plugin = #name;                                 \
-        staticPlugin_##name.interface = interface_;                         \
-        staticPlugin_##name.instancer =                                     \
-            [](Corrade::PluginManager::AbstractManager& manager, const std::string& plugin) -> void* { \
-                return new className(manager, plugin);                      \
-            };                                                              \
-        staticPlugin_##name.initializer = className::initialize;            \
-        staticPlugin_##name.finalizer = className::finalize;                \
         Corrade::PluginManager::AbstractManager::importStaticPlugin(CORRADE_PLUGIN_VERSION, staticPlugin_##name); \
         return 1;                                                           \
     }                                                                       \
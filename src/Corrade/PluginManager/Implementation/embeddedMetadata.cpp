@@ -0,0 +1,208 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "embeddedMetadata.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace Corrade { namespace PluginManager { namespace Implementation {
+
+namespace {
+
+/* Returns given range of the data or an empty view if it's out of bounds */
+Containers::ArrayView<const char> range(const Containers::ArrayView<const char> data, const std::uint64_t offset, const std::uint64_t size) {
+    if(offset > data.size() || data.size() - offset < size) return {};
+    return data.slice(std::size_t(offset), std::size_t(offset + size));
+}
+
+/* Reads an unsigned integer of given size and endianness, returns false if
+   it's out of bounds */
+bool read(const Containers::ArrayView<const char> data, const std::uint64_t offset, const std::size_t size, const bool bigEndian, std::uint64_t& out) {
+    const Containers::ArrayView<const char> bytes = range(data, offset, size);
+    if(bytes.size() != size) return false;
+    out = 0;
+    for(std::size_t i = 0; i != size; ++i)
+        out = out << 8 | std::uint8_t(bytes[bigEndian ? i : size - 1 - i]);
+    return true;
+}
+
+/* Whether a name in a fixed-size zero-padded field or at the start of a
+   string table matches given name */
+bool nameMatches(const Containers::ArrayView<const char> field, const char* const name) {
+    const std::size_t size = std::strlen(name);
+    return field.size() >= size && std::memcmp(field, name, size) == 0 &&
+        (field.size() == size || field[size] == '\0');
+}
+
+Containers::ArrayView<const char> elfSection(const Containers::ArrayView<const char> data) {
+    if(data.size() < 6 || (data[4] != 1 && data[4] != 2) || (data[5] != 1 && data[5] != 2))
+        return {};
+    const bool is64 = data[4] == 2;
+    const bool bigEndian = data[5] == 2;
+    const std::size_t wordSize = is64 ? 8 : 4;
+
+    std::uint64_t sectionHeaderOffset, sectionHeaderSize, sectionCount, nameSectionIndex;
+    if(!read(data, is64 ? 0x28 : 0x20, wordSize, bigEndian, sectionHeaderOffset) ||
+       !read(data, is64 ? 0x3a : 0x2e, 2, bigEndian, sectionHeaderSize) ||
+       !read(data, is64 ? 0x3c : 0x30, 2, bigEndian, sectionCount) ||
+       !read(data, is64 ? 0x3e : 0x32, 2, bigEndian, nameSectionIndex))
+        return {};
+    /* Both the size and the count are 16-bit, so with the offset checked
+       nothing below can overflow */
+    if(sectionHeaderOffset > data.size() || sectionHeaderSize < (is64 ? 0x28 : 0x18) || nameSectionIndex >= sectionCount)
+        return {};
+
+    auto section = [&](const std::uint64_t i, std::uint64_t& name, std::uint64_t& type, std::uint64_t& offset, std::uint64_t& size) {
+        const std::uint64_t header = sectionHeaderOffset + i*sectionHeaderSize;
+        return read(data, header, 4, bigEndian, name) &&
+            read(data, header + 4, 4, bigEndian, type) &&
+            read(data, header + (is64 ? 0x18 : 0x10), wordSize, bigEndian, offset) &&
+            read(data, header + (is64 ? 0x20 : 0x14), wordSize, bigEndian, size);
+    };
+
+    std::uint64_t name, type, offset, size;
+    if(!section(nameSectionIndex, name, type, offset, size)) return {};
+    const Containers::ArrayView<const char> names = range(data, offset, size);
+
+    for(std::uint64_t i = 0; i != sectionCount; ++i) {
+        /* Skip SHT_NOBITS sections, which have no data in the file */
+        if(!section(i, name, type, offset, size) || type == 8 || name >= names.size())
+            continue;
+        if(nameMatches(names.suffix(std::size_t(name)), ".corrade"))
+            return range(data, offset, size);
+    }
+
+    return {};
+}
+
+Containers::ArrayView<const char> peSection(const Containers::ArrayView<const char> data) {
+    std::uint64_t peOffset, sectionCount, optionalHeaderSize;
+    if(!read(data, 0x3c, 4, false, peOffset)) return {};
+    const Containers::ArrayView<const char> signature = range(data, peOffset, 4);
+    if(signature.size() != 4 || std::memcmp(signature, "PE\0\0", 4) != 0 ||
+       !read(data, peOffset + 6, 2, false, sectionCount) ||
+       !read(data, peOffset + 20, 2, false, optionalHeaderSize))
+        return {};
+
+    /* Section names longer than 8 characters are truncated in images, the
+       name is chosen to fit exactly */
+    const std::uint64_t sectionTable = peOffset + 24 + optionalHeaderSize;
+    for(std::uint64_t i = 0; i != sectionCount; ++i) {
+        const std::uint64_t header = sectionTable + i*40;
+        std::uint64_t virtualSize, rawSize, rawOffset;
+        if(!nameMatches(range(data, header, 8), ".corrade") ||
+           !read(data, header + 8, 4, false, virtualSize) ||
+           !read(data, header + 16, 4, false, rawSize) ||
+           !read(data, header + 20, 4, false, rawOffset))
+            continue;
+
+        /* The raw size is rounded up to the file alignment, the virtual
+           size is the actual one */
+        return range(data, rawOffset, virtualSize && virtualSize < rawSize ? virtualSize : rawSize);
+    }
+
+    return {};
+}
+
+Containers::ArrayView<const char> machOSection(const Containers::ArrayView<const char> data) {
+    std::uint64_t magic;
+    if(!read(data, 0, 4, false, magic)) return {};
+
+    /* Universal binary, big-endian. Go through all architectures. */
+    if(magic == 0xbebafeca) {
+        std::uint64_t archCount;
+        if(!read(data, 4, 4, true, archCount)) return {};
+        for(std::uint64_t i = 0; i != archCount; ++i) {
+            std::uint64_t offset, size;
+            if(!read(data, 8 + i*20 + 8, 4, true, offset) ||
+               !read(data, 8 + i*20 + 12, 4, true, size))
+                return {};
+            const Containers::ArrayView<const char> arch = range(data, offset, size);
+            /* Don't recurse into nested universal binaries */
+            std::uint64_t archMagic;
+            if(!read(arch, 0, 4, false, archMagic) || archMagic == 0xbebafeca)
+                continue;
+            const Containers::ArrayView<const char> section = machOSection(arch);
+            if(!section.empty()) return section;
+        }
+        return {};
+    }
+
+    if(magic != 0xfeedface && magic != 0xfeedfacf) return {};
+    const bool is64 = magic == 0xfeedfacf;
+    const std::size_t wordSize = is64 ? 8 : 4;
+
+    std::uint64_t commandCount;
+    if(!read(data, 16, 4, false, commandCount)) return {};
+
+    std::uint64_t command = is64 ? 32 : 28;
+    for(std::uint64_t i = 0; i != commandCount; ++i) {
+        std::uint64_t type, commandSize;
+        if(!read(data, command, 4, false, type) ||
+           !read(data, command + 4, 4, false, commandSize) || commandSize < 8)
+            return {};
+
+        /* LC_SEGMENT or LC_SEGMENT_64 */
+        if(type == (is64 ? 0x19u : 0x1u) && nameMatches(range(data, command + 8, 16), "__TEXT")) {
+            std::uint64_t sectionCount;
+            if(!read(data, command + (is64 ? 64 : 48), 4, false, sectionCount))
+                return {};
+            for(std::uint64_t j = 0; j != sectionCount; ++j) {
+                const std::uint64_t header = command + (is64 ? 72 : 56) + j*(is64 ? 80 : 68);
+                std::uint64_t size, offset;
+                if(!nameMatches(range(data, header, 16), "__corrade") ||
+                   !read(data, header + (is64 ? 40 : 36), wordSize, false, size) ||
+                   !read(data, header + (is64 ? 48 : 40), 4, false, offset))
+                    continue;
+                return range(data, offset, size);
+            }
+        }
+
+        command += commandSize;
+    }
+
+    return {};
+}
+
+}
+
+Containers::ArrayView<const char> embeddedMetadata(const Containers::ArrayView<const char> binary) {
+    Containers::ArrayView<const char> section;
+    if(binary.size() >= 4 && std::memcmp(binary, "\x7f" "ELF", 4) == 0)
+        section = elfSection(binary);
+    else if(binary.size() >= 2 && std::memcmp(binary, "MZ", 2) == 0)
+        section = peSection(binary);
+    else
+        section = machOSection(binary);
+
+    /* The section can be padded by the linker, cut it at the terminating
+       zero */
+    for(std::size_t i = 0; i != section.size(); ++i)
+        if(!section[i]) return section.prefix(i);
+    return section;
+}
+
+}}}
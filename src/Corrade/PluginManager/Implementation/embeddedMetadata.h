@@ -0,0 +1,44 @@
+#ifndef Corrade_PluginManager_Implementation_embeddedMetadata_h
+#define Corrade_PluginManager_Implementation_embeddedMetadata_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Corrade/Containers/ArrayView.h"
+#include "Corrade/PluginManager/visibility.h"
+
+namespace Corrade { namespace PluginManager { namespace Implementation {
+
+/* Finds plugin metadata embedded by corrade_add_plugin(... EMBED_METADATA)
+   in given ELF, PE or Mach-O binary, without loading it. The metadata are in
+   a .corrade section on ELF and PE and in a __TEXT,__corrade section on
+   Mach-O. For Mach-O universal binaries the first architecture containing
+   the section is used. Returns the section contents up to the first zero
+   byte, or an empty view if the binary isn't recognized, is malformed or
+   doesn't contain the section. */
+CORRADE_PLUGINMANAGER_EXPORT Containers::ArrayView<const char> embeddedMetadata(Containers::ArrayView<const char> binary);
+
+}}}
+
+#endif
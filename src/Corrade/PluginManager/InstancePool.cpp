@@ -0,0 +1,110 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "InstancePool.h"
+
+#include <vector>
+#ifdef CORRADE_BUILD_MULTITHREADED
+#include <mutex>
+#endif
+
+#include "Corrade/PluginManager/AbstractPlugin.h"
+
+namespace Corrade { namespace PluginManager {
+
+struct AbstractInstancePool::State {
+    explicit State(AbstractManager& manager, std::string plugin, std::size_t capacity): manager(manager), plugin{std::move(plugin)}, capacity{capacity} {
+        idle.reserve(capacity);
+    }
+
+    AbstractManager& manager;
+    std::string plugin;
+    std::size_t capacity;
+    std::vector<Containers::Pointer<AbstractPlugin>> idle;
+    #ifdef CORRADE_BUILD_MULTITHREADED
+    mutable std::mutex mutex;
+    #endif
+};
+
+AbstractInstancePool::AbstractInstancePool(AbstractManager& manager, std::string plugin, const std::size_t capacity): _state{Containers::InPlaceInit, manager, std::move(plugin), capacity} {}
+
+AbstractInstancePool::~AbstractInstancePool() = default;
+
+std::string AbstractInstancePool::plugin() const { return _state->plugin; }
+
+std::size_t AbstractInstancePool::capacity() const { return _state->capacity; }
+
+std::size_t AbstractInstancePool::idleCount() const {
+    #ifdef CORRADE_BUILD_MULTITHREADED
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    #endif
+    return _state->idle.size();
+}
+
+std::size_t AbstractInstancePool::prewarm(const std::size_t count) {
+    #ifdef CORRADE_BUILD_MULTITHREADED
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    #endif
+    const std::size_t target = count < _state->capacity ? count : _state->capacity;
+    while(_state->idle.size() < target) {
+        Containers::Pointer<AbstractPlugin> instance = _state->manager.loadAndInstantiateInternal(_state->plugin);
+        if(!instance) break;
+        _state->idle.push_back(std::move(instance));
+    }
+    return _state->idle.size();
+}
+
+void AbstractInstancePool::clear() {
+    #ifdef CORRADE_BUILD_MULTITHREADED
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    #endif
+    _state->idle.clear();
+}
+
+AbstractPlugin* AbstractInstancePool::acquireInternal() {
+    #ifdef CORRADE_BUILD_MULTITHREADED
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    #endif
+    if(!_state->idle.empty()) {
+        AbstractPlugin* const instance = _state->idle.back().release();
+        _state->idle.pop_back();
+        return instance;
+    }
+
+    return _state->manager.loadAndInstantiateInternal(_state->plugin).release();
+}
+
+void AbstractInstancePool::recycleInternal(AbstractPlugin* const instance) {
+    Containers::Pointer<AbstractPlugin> pointer{instance};
+    #ifdef CORRADE_BUILD_MULTITHREADED
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    #endif
+    /* If the pool is full, the instance gets deleted at the end of the scope,
+       still under the lock */
+    if(_state->idle.size() < _state->capacity)
+        _state->idle.push_back(std::move(pointer));
+}
+
+}}
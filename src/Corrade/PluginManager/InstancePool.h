@@ -0,0 +1,298 @@
+#ifndef Corrade_PluginManager_InstancePool_h
+#define Corrade_PluginManager_InstancePool_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::PluginManager::AbstractInstancePool, @ref Corrade::PluginManager::InstancePool, @ref Corrade::PluginManager::PooledInstance
+ * @m_since_latest
+ */
+
+#include <string>
+#include <utility>
+
+#include "Corrade/Containers/Pointer.h"
+#include "Corrade/PluginManager/Manager.h"
+#include "Corrade/Utility/Assert.h"
+
+namespace Corrade { namespace PluginManager {
+
+/**
+@brief Base for plugin instance pools
+@m_since_latest
+
+See @ref InstancePool for more information.
+*/
+class CORRADE_PLUGINMANAGER_EXPORT AbstractInstancePool {
+    template<class> friend class PooledInstance;
+
+    public:
+        /** @brief Copying is not allowed */
+        AbstractInstancePool(const AbstractInstancePool&) = delete;
+
+        /** @brief Moving is not allowed */
+        AbstractInstancePool(AbstractInstancePool&&) = delete;
+
+        /** @brief Copying is not allowed */
+        AbstractInstancePool& operator=(const AbstractInstancePool&) = delete;
+
+        /** @brief Moving is not allowed */
+        AbstractInstancePool& operator=(AbstractInstancePool&&) = delete;
+
+        /** @brief Plugin name */
+        std::string plugin() const;
+
+        /**
+         * @brief Capacity
+         *
+         * Max count of idle instances kept in the pool.
+         */
+        std::size_t capacity() const;
+
+        /**
+         * @brief Count of idle instances
+         *
+         * Never larger than @ref capacity().
+         */
+        std::size_t idleCount() const;
+
+        /**
+         * @brief Prewarm the pool
+         * @return Count of idle instances after the operation
+         *
+         * Instantiates new instances until there's at least @p count of them
+         * idle, but at most @ref capacity(). If the plugin isn't loaded yet,
+         * it's loaded first, similarly to @ref Manager::loadAndInstantiate().
+         * If loading or instantiation fails, the function stops and returns
+         * the count of instances that were created so far.
+         */
+        std::size_t prewarm(std::size_t count);
+
+        /**
+         * @brief Destroy all idle instances
+         *
+         * As long as the pool holds any idle instances, the plugin is
+         * considered to be used and can't be unloaded. Call this function (or
+         * destroy the pool) before unloading the plugin.
+         */
+        void clear();
+
+    protected:
+        /**
+         * @brief Constructor
+         * @param manager   Plugin manager
+         * @param plugin    Plugin name or alias
+         * @param capacity  Max count of idle instances kept in the pool
+         */
+        explicit AbstractInstancePool(AbstractManager& manager, std::string plugin, std::size_t capacity);
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys all idle instances.
+         */
+        ~AbstractInstancePool();
+
+        /**
+         * @brief Acquire an instance
+         *
+         * Takes an idle instance or, if there's none, loads and instantiates
+         * a new one. Returns @cpp nullptr @ce if loading or instantiation
+         * fails.
+         */
+        AbstractPlugin* acquireInternal();
+
+    private:
+        struct State;
+
+        void recycleInternal(AbstractPlugin* instance);
+
+        Containers::Pointer<State> _state;
+};
+
+/**
+@brief Plugin instance pool
+@m_since_latest
+
+Keeps up to a given count of idle instances of a single plugin and hands them
+out through a @ref PooledInstance. When the @ref PooledInstance is destroyed,
+the instance is put back into the pool instead of being deleted, so the next
+@ref acquire() doesn't need to construct a new one. Useful for plugins with an
+expensive constructor that are instantiated repeatedly, such as in a thread
+pool:
+
+@snippet PluginManager.cpp InstancePool
+
+The pool doesn't reset the instance state in any way --- a recycled instance
+is handed out as it was left by its previous user, so the plugin is expected
+to not carry any per-use state between uses or to be able to reset it on its
+own.
+
+@section PluginManager-InstancePool-multithreading Thread safety
+
+If Corrade is built with @ref CORRADE_BUILD_MULTITHREADED, @ref acquire(),
+@ref prewarm(), @ref clear() and destruction of @ref PooledInstance are
+guarded by a mutex, including the instantiation and deletion of plugin
+instances themselves. This makes it possible to use a single pool from
+multiple threads, as long as the associated manager isn't used from other
+threads at the same time.
+
+The pool is expected to outlive all @ref PooledInstance objects that were
+acquired from it, use @ref PooledInstance::release() to take an instance
+out of the pool completely.
+*/
+template<class T> class InstancePool: public AbstractInstancePool {
+    public:
+        /**
+         * @brief Constructor
+         * @param manager   Plugin manager
+         * @param plugin    Plugin name or alias
+         * @param capacity  Max count of idle instances kept in the pool
+         *
+         * The pool is initially empty, use @ref prewarm() to fill it.
+         */
+        explicit InstancePool(Manager<T>& manager, std::string plugin, std::size_t capacity): AbstractInstancePool{manager, std::move(plugin), capacity} {}
+
+        /**
+         * @brief Acquire an instance
+         *
+         * Takes an idle instance or, if there's none, loads and instantiates
+         * a new one. If loading or instantiation fails, returns an empty
+         * @ref PooledInstance.
+         */
+        PooledInstance<T> acquire() {
+            return PooledInstance<T>{static_cast<T*>(acquireInternal()), *this};
+        }
+};
+
+/**
+@brief Pooled plugin instance
+@m_since_latest
+
+Move-only owning wrapper over a plugin instance acquired from an
+@ref InstancePool. On destruction, puts the instance back into the pool, or
+deletes it if the pool is already at its capacity.
+*/
+template<class T> class PooledInstance {
+    public:
+        /**
+         * @brief Default constructor
+         *
+         * Creates an empty instance.
+         */
+        /*implicit*/ PooledInstance() noexcept: _instance{}, _pool{} {}
+
+        /** @brief Copying is not allowed */
+        PooledInstance(const PooledInstance<T>&) = delete;
+
+        /** @brief Move constructor */
+        PooledInstance(PooledInstance<T>&& other) noexcept: _instance{other._instance}, _pool{other._pool} {
+            other._instance = nullptr;
+        }
+
+        /**
+         * @brief Destructor
+         *
+         * Puts the instance back into the pool.
+         */
+        ~PooledInstance() {
+            if(_instance) _pool->recycleInternal(_instance);
+        }
+
+        /** @brief Copying is not allowed */
+        PooledInstance<T>& operator=(const PooledInstance<T>&) = delete;
+
+        /** @brief Move assignment */
+        PooledInstance<T>& operator=(PooledInstance<T>&& other) noexcept {
+            std::swap(_instance, other._instance);
+            std::swap(_pool, other._pool);
+            return *this;
+        }
+
+        /** @brief Whether the instance is non-empty */
+        explicit operator bool() const { return _instance; }
+
+        /** @brief Underlying instance */
+        T* get() { return _instance; }
+        const T* get() const { return _instance; } /**< @overload */
+
+        /**
+         * @brief Access an instance member
+         *
+         * Expects that the instance is not empty.
+         */
+        T* operator->() {
+            CORRADE_ASSERT(_instance, "PluginManager::PooledInstance::operator->(): the instance is empty", nullptr);
+            return _instance;
+        }
+
+        /** @overload */
+        const T* operator->() const {
+            CORRADE_ASSERT(_instance, "PluginManager::PooledInstance::operator->(): the instance is empty", nullptr);
+            return _instance;
+        }
+
+        /**
+         * @brief Dereference the instance
+         *
+         * Expects that the instance is not empty.
+         */
+        T& operator*() {
+            CORRADE_ASSERT(_instance, "PluginManager::PooledInstance::operator*(): the instance is empty", *_instance);
+            return *_instance;
+        }
+
+        /** @overload */
+        const T& operator*() const {
+            CORRADE_ASSERT(_instance, "PluginManager::PooledInstance::operator*(): the instance is empty", *_instance);
+            return *_instance;
+        }
+
+        /**
+         * @brief Release the instance from the pool
+         *
+         * The instance is no longer put back into the pool and the returned
+         * pointer becomes responsible for its deletion. Equivalent to
+         * instantiating the plugin through @ref Manager::instantiate()
+         * directly. The wrapper is empty afterwards.
+         */
+        Containers::Pointer<T> release() {
+            T* const instance = _instance;
+            _instance = nullptr;
+            return Containers::Pointer<T>{instance};
+        }
+
+    private:
+        friend InstancePool<T>;
+
+        explicit PooledInstance(T* instance, AbstractInstancePool& pool) noexcept: _instance{instance}, _pool{&pool} {}
+
+        T* _instance;
+        AbstractInstancePool* _pool;
+};
+
+}}
+
+#endif
@@ -30,6 +30,7 @@
  */
 
 #include <string>
+#include <utility>
 
 #include "Corrade/Containers/Pointer.h"
 #include "Corrade/PluginManager/AbstractManager.h"
@@ -70,6 +71,13 @@ and no plugin with the same name is expected to be loaded at the same time. If
 loading succeeds, the module is exposed through the API under its basename
 (excluding extension).
 
+If a plugin has no `*.conf` file next to it, the metadata are looked for in a
+`.corrade` section of the plugin binary (`__TEXT,__corrade` on Apple
+platforms), where they get embedded with the `EMBED_METADATA` option of the
+@ref corrade-cmake-add-plugin "corrade_add_plugin()" CMake macro. The section
+is read without loading the binary and the result is cached the same way as
+regular metadata files, see @ref metadataCache().
+
 @section PluginManager-Manager-reload Plugin loading, instantiation and unloading
 
 A plugin is loaded by calling @ref load() with given plugin name or alias.
@@ -87,6 +95,23 @@ order to avoid double-free issues, you have to call
 instances returned from @ref Manager::instantiate() or
 @ref Manager::loadAndInstantiate().
 
+@section PluginManager-Manager-hot-reload Hot reload
+
+During development it's possible to replace a dynamic plugin binary with a
+rebuilt one without restarting the application. Calling @ref reloadChanged()
+periodically checks binaries of all loaded plugins for changes and calls
+@ref reload() on those that changed, which unloads and loads again only the
+changed plugin and plugins that depend on it. Live instances are destroyed and
+recreated in a callback set with @ref setReloadCallback():
+
+@snippet PluginManager.cpp hot-reload
+
+Note that on Linux, a plugin binary containing symbols marked as
+@cb{.sh} STB_GNU_UNIQUE @ce, such as static variables in inline functions or
+templates, is never actually unloaded by the dynamic linker and a reload would
+pick up the old code again. Build the plugins with @cb{.sh} -fno-gnu-unique @ce
+with GCC to avoid that. The plugin metadata file is not reloaded.
+
 @section PluginManager-Manager-data Plugin-specific data and configuration
 
 Besides the API provided by a particular plugin interface after given plugin is
@@ -147,12 +172,67 @@ template<class T> class Manager: public AbstractManager {
             AbstractManager{T::pluginInterface()} { static_cast<void>(pluginDirectory); }
             #endif
 
+        /**
+         * @brief Construct with a metadata cache
+         * @param pluginDirectory   Directory where plugins will be searched.
+         *      If empty, behaves the same as in @ref Manager(std::string).
+         * @param metadataCache     File where to cache plugin metadata
+         * @m_since_latest
+         *
+         * Same as @ref Manager(std::string), but metadata of dynamic plugins
+         * are taken from @p metadataCache if their metadata files didn't
+         * change since the cache was written, without opening the metadata
+         * files at all. The cache is created or updated if needed. See
+         * @ref AbstractManager::metadataCache() for more information.
+         * @partialsupport Both parameters have no effect on platforms
+         *      without @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support".
+         */
+        explicit Manager(std::string pluginDirectory, std::string metadataCache):
+            #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+            AbstractManager{T::pluginInterface(), T::pluginSearchPaths(), std::move(pluginDirectory), std::move(metadataCache)} {}
+            #else
+            AbstractManager{T::pluginInterface()} {
+                static_cast<void>(pluginDirectory);
+                static_cast<void>(metadataCache);
+            }
+            #endif
+
+        /**
+         * @brief Construct with a shared registry
+         * @param registry          Registry shared with other managers
+         * @param pluginDirectory   Optional directory where plugins will be
+         *      searched. If empty, behaves the same as in
+         *      @ref Manager(std::string).
+         * @m_since_latest
+         *
+         * Same as @ref Manager(std::string), but if the plugin directory was
+         * already scanned by another manager using the same @p registry, the
+         * plugin list and metadata are taken from there. Plugin binaries
+         * opened by managers sharing the registry are reference-counted. See
+         * @ref Registry for more information. The registry is expected to
+         * outlive the manager.
+         * @partialsupport Both parameters have no effect on platforms
+         *      without @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support".
+         */
+        explicit Manager(Registry& registry, std::string pluginDirectory = {}):
+            #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+            AbstractManager{T::pluginInterface(), T::pluginSearchPaths(), std::move(pluginDirectory), {}, &registry} {}
+            #else
+            AbstractManager{T::pluginInterface()} {
+                static_cast<void>(registry);
+                static_cast<void>(pluginDirectory);
+            }
+            #endif
+
         /**
          * @brief Instantiate a plugin
          *
          * Returns new instance of given plugin. The plugin must be already
          * successfully loaded by this manager. The returned value is never
-         * @cpp nullptr @ce.
+         * @cpp nullptr @ce, except when the plugin was loaded with
+         * @ref LoadFlag::Lazy and opening its binary on this first
+         * instantiation fails --- in that case a diagnostic is printed and
+         * @cpp nullptr @ce is returned.
          * @see @ref loadAndInstantiate(),
          *      @ref AbstractManager::loadState() "loadState()",
          *      @ref AbstractManager::load() "load()"
@@ -166,6 +246,8 @@ template<class T> class Manager: public AbstractManager {
          *
          * Convenience alternative to calling both @ref load() and
          * @ref instantiate(). If loading fails, @cpp nullptr @ce is returned.
+         * With @ref LoadFlag::Lazy, @cpp nullptr @ce is returned also if
+         * opening the plugin binary fails.
          *
          * As with @ref load(), it's possible to pass a file path to @p plugin.
          * See its documentation for more information. The resulting plugin
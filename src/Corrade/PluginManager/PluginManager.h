@@ -36,11 +36,15 @@ namespace Corrade { namespace PluginManager {
 enum class LoadState: unsigned short;
 /* LoadStates won't be used without LoadState definition */
 
+class AbstractInstancePool;
 class AbstractManager;
 template<class> class AbstractManagingPlugin;
 class AbstractPlugin;
+template<class> class InstancePool;
 template<class> class Manager;
 class PluginMetadata;
+template<class> class PooledInstance;
+class Registry;
 
 }}
 
@@ -36,6 +36,7 @@ PluginMetadata::PluginMetadata(std::string name, Utility::ConfigurationGroup& co
     /* Dependencies, aliases */
     _depends = conf.values("depends");
     _provides = conf.values("provides");
+    _optionalFinalizer = conf.value<bool>("optionalFinalizer");
 
     /* Plugin data, configuration */
     _data = conf.group("data");
@@ -47,6 +48,4 @@ PluginMetadata::PluginMetadata(std::string name, Utility::ConfigurationGroup& co
 
 std::string PluginMetadata::name() const { return _name; }
 
-std::vector<std::string> PluginMetadata::usedBy() const { return _usedBy; }
-
 }}
@@ -63,6 +63,9 @@ depends=SkyNetPlugin
 provides=RealWorld
 provides=RealButSlightlyTwistedWorld
 
+# The finalizer only releases memory, can be skipped on fast shutdown
+optionalFinalizer=true
+
 # Optional plugin-specific data
 [data]
 description=My first matrix without bugs
@@ -77,6 +80,10 @@ According to the configuration file, the `Matrix` plugin can be loaded only if
 be loaded. It will be also loaded when requesting `RealWorld` plugin, but only
 if this is the first plugin providing it.
 
+The @cb{.ini} optionalFinalizer @ce option marks the plugin finalizer as
+safe to skip when the manager is destroyed with
+@ref LoadFlag::FastShutdown, see @ref isFinalizerOptional() for details.
+
 The @cb{.ini} [data] @ce section can contain read-only data that can be used
 for example to provide additional info about the plugin in a user interface and
 is accessible through @ref data().
@@ -119,9 +126,10 @@ class CORRADE_PLUGINMANAGER_EXPORT PluginMetadata {
          * List of plugins which uses this plugin. This plugin cannot be
          * unloaded when any of these plugins are loaded.
          * @note This list is automatically created by plugin manager and can
-         *      be changed in plugin lifetime.
+         *      be changed in plugin lifetime. The returned reference is
+         *      invalidated when that happens.
          */
-        std::vector<std::string> usedBy() const;
+        const std::vector<std::string>& usedBy() const { return _usedBy; }
 
         /**
          * @brief Plugins which are provided by this plugin
@@ -163,6 +171,19 @@ class CORRADE_PLUGINMANAGER_EXPORT PluginMetadata {
         Utility::ConfigurationGroup& configuration() { return *_configuration; }
         const Utility::ConfigurationGroup& configuration() const { return *_configuration; } /**< @overload */
 
+        /**
+         * @brief Whether the plugin finalizer is optional
+         * @m_since_latest
+         *
+         * Set by the @cb{.ini} optionalFinalizer @ce option in the metadata
+         * file. If @cpp true @ce, the finalizer does nothing that needs to
+         * happen before the process exits (such as just releasing memory)
+         * and it's not called when the manager is destroyed with
+         * @ref LoadFlag::FastShutdown. Default is @cpp false @ce.
+         * @note Thus field is constant during whole plugin lifetime.
+         */
+        bool isFinalizerOptional() const { return _optionalFinalizer; }
+
         #ifndef DOXYGEN_GENERATING_OUTPUT
         explicit PluginMetadata(std::string name, Utility::ConfigurationGroup& conf);
         #endif
@@ -178,6 +199,7 @@ class CORRADE_PLUGINMANAGER_EXPORT PluginMetadata {
 
         const Utility::ConfigurationGroup* _data;
         Utility::ConfigurationGroup*_configuration;
+        bool _optionalFinalizer;
 };
 
 }}
@@ -0,0 +1,114 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Registry.h"
+
+#include <map>
+#include <vector>
+#ifdef CORRADE_BUILD_MULTITHREADED
+#include <mutex>
+#endif
+
+namespace Corrade { namespace PluginManager {
+
+struct Registry::State {
+    std::map<std::string, std::vector<DirectoryEntry>> directories;
+    /* Use count of each opened module */
+    std::map<void*, std::size_t> modules;
+    #ifdef CORRADE_BUILD_MULTITHREADED
+    mutable std::mutex mutex;
+    #endif
+};
+
+Registry::Registry(): _state{Containers::InPlaceInit} {}
+
+Registry::~Registry() = default;
+
+std::size_t Registry::directoryCount() const {
+    #ifdef CORRADE_BUILD_MULTITHREADED
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    #endif
+    return _state->directories.size();
+}
+
+std::size_t Registry::moduleCount() const {
+    #ifdef CORRADE_BUILD_MULTITHREADED
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    #endif
+    return _state->modules.size();
+}
+
+void Registry::clear() {
+    #ifdef CORRADE_BUILD_MULTITHREADED
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    #endif
+    _state->directories.clear();
+}
+
+bool Registry::directory(const std::string& path, std::vector<DirectoryEntry>& out) const {
+    #ifdef CORRADE_BUILD_MULTITHREADED
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    #endif
+    const auto found = _state->directories.find(path);
+    if(found == _state->directories.end()) return false;
+
+    /* Copying so the lock doesn't need to be held while the manager parses
+       the metadata */
+    out = found->second;
+    return true;
+}
+
+void Registry::setDirectory(const std::string& path, std::vector<DirectoryEntry>&& entries) {
+    #ifdef CORRADE_BUILD_MULTITHREADED
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    #endif
+    _state->directories[path] = std::move(entries);
+}
+
+bool Registry::initializeModule(void* const module, void(*const initializer)()) {
+    /* The lock is held during the initializer call so another manager
+       doesn't start using the plugin before it's initialized */
+    #ifdef CORRADE_BUILD_MULTITHREADED
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    #endif
+    if(_state->modules[module]++) return false;
+
+    initializer();
+    return true;
+}
+
+bool Registry::finalizeModule(void* const module, void(*const finalizer)()) {
+    #ifdef CORRADE_BUILD_MULTITHREADED
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    #endif
+    const auto found = _state->modules.find(module);
+    if(found != _state->modules.end() && --found->second) return false;
+
+    if(found != _state->modules.end()) _state->modules.erase(found);
+    finalizer();
+    return true;
+}
+
+}}
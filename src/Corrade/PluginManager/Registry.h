@@ -0,0 +1,150 @@
+#ifndef Corrade_PluginManager_Registry_h
+#define Corrade_PluginManager_Registry_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::PluginManager::Registry
+ * @m_since_latest
+ */
+
+#include <cstddef>
+#include <string>
+
+#include "Corrade/Containers/Pointer.h"
+#include "Corrade/PluginManager/PluginManager.h"
+#include "Corrade/PluginManager/visibility.h"
+#include "Corrade/Utility/StlForwardVector.h"
+
+namespace Corrade { namespace PluginManager {
+
+/**
+@brief Plugin registry shared across managers
+@m_since_latest
+
+Each @ref Manager lists its plugin directory and parses all plugin metadata on
+construction. When many managers are created for the same directory --- for
+example one per thread or one per subsystem --- a registry passed to the
+@ref Manager::Manager(Registry&, std::string) constructor makes the repeated
+construction cheap:
+
+@snippet PluginManager.cpp Registry
+
+@section PluginManager-Registry-directories Directory scans
+
+The first manager that scans a particular plugin directory saves the list of
+plugins found there together with contents of their metadata files into the
+registry. All subsequent managers constructed with the same registry and
+directory take the metadata from there without touching the filesystem at all.
+Explicitly calling @ref AbstractManager::setPluginDirectory() or
+@ref AbstractManager::reloadPluginDirectory() always rescans the directory and
+updates the registry. Only scans that saw all plugins in the directory are
+saved --- plugins that the manager skipped because they were already loaded by
+another manager in the same thread cause the registry to not be updated.
+
+@section PluginManager-Registry-modules Shared plugin binaries
+
+Plugin binaries opened by managers that use the same registry are
+reference-counted. The operating system gives all managers loading the same
+file the same module already, the registry additionally ensures that the
+plugin initializer is called only when the first manager loads it and the
+finalizer only when the last manager unloads it, instead of on every load and
+unload.
+
+@section PluginManager-Registry-multithreading Thread safety
+
+If Corrade is built with @ref CORRADE_BUILD_MULTITHREADED, all access to the
+registry is guarded by a mutex, which makes it possible to share a single
+registry among managers living in different threads. The registry is expected
+to outlive all managers that use it.
+@partialsupport The registry has no effect on platforms without
+    @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support".
+*/
+class CORRADE_PLUGINMANAGER_EXPORT Registry {
+    public:
+        /** @brief Constructor */
+        explicit Registry();
+
+        /** @brief Copying is not allowed */
+        Registry(const Registry&) = delete;
+
+        /** @brief Moving is not allowed */
+        Registry(Registry&&) = delete;
+
+        ~Registry();
+
+        /** @brief Copying is not allowed */
+        Registry& operator=(const Registry&) = delete;
+
+        /** @brief Moving is not allowed */
+        Registry& operator=(Registry&&) = delete;
+
+        /**
+         * @brief Count of saved directory scans
+         *
+         * @see @ref clear()
+         */
+        std::size_t directoryCount() const;
+
+        /**
+         * @brief Count of plugin binaries currently opened through the registry
+         *
+         * A binary opened by more than one manager is counted just once.
+         */
+        std::size_t moduleCount() const;
+
+        /**
+         * @brief Clear saved directory scans
+         *
+         * Managers constructed afterwards will scan their plugin directories
+         * again. Opened plugin binaries are not affected.
+         */
+        void clear();
+
+    private:
+        friend AbstractManager;
+
+        struct State;
+
+        /* Used by AbstractManager. If valid is false, the plugin didn't
+           have a readable metadata file and the contents are empty. */
+        struct DirectoryEntry {
+            std::string name;
+            std::string metadata;
+            bool valid;
+        };
+        bool directory(const std::string& path, std::vector<DirectoryEntry>& out) const;
+        void setDirectory(const std::string& path, std::vector<DirectoryEntry>&& entries);
+        /* Call the initializer / finalizer if this is the first / last use of
+           given module, return whether it got called */
+        bool initializeModule(void* module, void(*initializer)());
+        bool finalizeModule(void* module, void(*finalizer)());
+
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
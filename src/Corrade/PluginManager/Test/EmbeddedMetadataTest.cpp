@@ -0,0 +1,222 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string>
+
+#include "Corrade/PluginManager/Implementation/embeddedMetadata.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/Utility/DebugStl.h"
+
+namespace Corrade { namespace PluginManager { namespace Test { namespace {
+
+struct EmbeddedMetadataTest: TestSuite::Tester {
+    explicit EmbeddedMetadataTest();
+
+    void elf64();
+    void elf32BigEndian();
+    void elfPadded();
+    void elfNotFound();
+    void elfOutOfBounds();
+    void elfTruncated();
+    void pe();
+    void machO64();
+    void machOUniversal();
+    void unknown();
+};
+
+constexpr const char Metadata[] = "depends=Dog\nprovides=JustSomeMammal\n";
+
+/* Writes an unsigned integer of given size and endianness */
+void put(std::string& data, const std::size_t offset, const std::size_t size, const bool bigEndian, std::uint64_t value) {
+    if(data.size() < offset + size) data.resize(offset + size);
+    for(std::size_t i = 0; i != size; ++i, value >>= 8)
+        data[offset + (bigEndian ? size - 1 - i : i)] = char(value & 0xff);
+}
+
+void putName(std::string& data, const std::size_t offset, const std::string& name) {
+    if(data.size() < offset + name.size()) data.resize(offset + name.size());
+    data.replace(offset, name.size(), name);
+}
+
+/* ELF with a null section, a section name table and given section */
+std::string elf(const bool is64, const bool bigEndian, const std::string& sectionName, const std::string& contents) {
+    const std::size_t headerSize = is64 ? 64 : 52;
+    const std::size_t sectionHeaderSize = is64 ? 64 : 40;
+    const std::size_t wordSize = is64 ? 8 : 4;
+    const std::string names = std::string{"\0.shstrtab\0", 11} + sectionName + '\0';
+    const std::size_t namesOffset = headerSize;
+    const std::size_t contentsOffset = namesOffset + names.size();
+    const std::size_t sectionHeaderOffset = contentsOffset + contents.size();
+
+    std::string out = "\x7f" "ELF";
+    out += char(is64 ? 2 : 1);
+    out += char(bigEndian ? 2 : 1);
+    put(out, is64 ? 0x28 : 0x20, wordSize, bigEndian, sectionHeaderOffset);
+    put(out, is64 ? 0x3a : 0x2e, 2, bigEndian, sectionHeaderSize);
+    put(out, is64 ? 0x3c : 0x30, 2, bigEndian, 3);
+    put(out, is64 ? 0x3e : 0x32, 2, bigEndian, 1);
+    putName(out, namesOffset, names);
+    putName(out, contentsOffset, contents);
+
+    auto section = [&](const std::size_t i, const std::size_t name, const std::size_t type, const std::size_t offset, const std::size_t size) {
+        const std::size_t header = sectionHeaderOffset + i*sectionHeaderSize;
+        put(out, header, 4, bigEndian, name);
+        put(out, header + 4, 4, bigEndian, type);
+        put(out, header + (is64 ? 0x18 : 0x10), wordSize, bigEndian, offset);
+        put(out, header + (is64 ? 0x20 : 0x14), wordSize, bigEndian, size);
+        out.resize(header + sectionHeaderSize);
+    };
+    section(0, 0, 0, 0, 0);
+    section(1, 1, 3, namesOffset, names.size());
+    section(2, 11, 1, contentsOffset, contents.size());
+    return out;
+}
+
+/* Mach-O with a __TEXT segment containing a __text and given section */
+std::string machO64(const std::string& sectionName, const std::string& contents) {
+    const std::size_t commandSize = 72 + 2*80;
+    const std::size_t contentsOffset = 32 + commandSize;
+
+    std::string out;
+    put(out, 0, 4, false, 0xfeedfacf);
+    put(out, 16, 4, false, 1);
+    put(out, 20, 4, false, commandSize);
+    put(out, 32, 4, false, 0x19);
+    put(out, 36, 4, false, commandSize);
+    putName(out, 40, "__TEXT");
+    put(out, 32 + 64, 4, false, 2);
+    putName(out, 32 + 72, "__text");
+    putName(out, 32 + 72 + 16, "__TEXT");
+    putName(out, 32 + 72 + 80, sectionName);
+    putName(out, 32 + 72 + 80 + 16, "__TEXT");
+    put(out, 32 + 72 + 80 + 40, 8, false, contents.size());
+    put(out, 32 + 72 + 80 + 48, 4, false, contentsOffset);
+    out.resize(contentsOffset);
+    return out + contents;
+}
+
+EmbeddedMetadataTest::EmbeddedMetadataTest() {
+    addTests({&EmbeddedMetadataTest::elf64,
+              &EmbeddedMetadataTest::elf32BigEndian,
+              &EmbeddedMetadataTest::elfPadded,
+              &EmbeddedMetadataTest::elfNotFound,
+              &EmbeddedMetadataTest::elfOutOfBounds,
+              &EmbeddedMetadataTest::elfTruncated,
+              &EmbeddedMetadataTest::pe,
+              &EmbeddedMetadataTest::machO64,
+              &EmbeddedMetadataTest::machOUniversal,
+              &EmbeddedMetadataTest::unknown});
+}
+
+std::string metadata(const std::string& binary) {
+    const Containers::ArrayView<const char> out = Implementation::embeddedMetadata({binary.data(), binary.size()});
+    return {out.data(), out.size()};
+}
+
+void EmbeddedMetadataTest::elf64() {
+    CORRADE_COMPARE(metadata(elf(true, false, ".corrade", Metadata)), Metadata);
+}
+
+void EmbeddedMetadataTest::elf32BigEndian() {
+    CORRADE_COMPARE(metadata(elf(false, true, ".corrade", Metadata)), Metadata);
+}
+
+void EmbeddedMetadataTest::elfPadded() {
+    /* The terminating zero and the padding after are cut away */
+    CORRADE_COMPARE(metadata(elf(true, false, ".corrade", std::string{Metadata} + std::string(13, '\0'))), Metadata);
+}
+
+void EmbeddedMetadataTest::elfNotFound() {
+    /* The name has to match exactly */
+    CORRADE_COMPARE(metadata(elf(true, false, ".corrade.other", Metadata)), "");
+    CORRADE_COMPARE(metadata(elf(true, false, ".corrad", Metadata)), "");
+}
+
+void EmbeddedMetadataTest::elfOutOfBounds() {
+    /* Section size pointing after the end of the file */
+    std::string binary = elf(true, false, ".corrade", Metadata);
+    put(binary, binary.size() - 64 + 0x20, 8, false, 0xffffffffffffull);
+    CORRADE_COMPARE(metadata(binary), "");
+}
+
+void EmbeddedMetadataTest::elfTruncated() {
+    const std::string binary = elf(true, false, ".corrade", Metadata);
+    for(std::size_t size: {std::size_t{4}, std::size_t{6}, std::size_t{0x3c}, std::size_t{100}, binary.size() - 64 + 0x20})
+        CORRADE_COMPARE(metadata(binary.substr(0, size)), "");
+}
+
+void EmbeddedMetadataTest::pe() {
+    std::string binary = "MZ";
+    put(binary, 0x3c, 4, false, 0x40);
+    putName(binary, 0x40, std::string{"PE\0\0", 4});
+    put(binary, 0x46, 2, false, 2);
+    put(binary, 0x54, 2, false, 0);
+    /* Two sections, .text and .corrade, the latter with the raw data size
+       rounded up to 16 bytes */
+    putName(binary, 0x58, ".text");
+    putName(binary, 0x58 + 40, ".corrade");
+    put(binary, 0x58 + 40 + 8, 4, false, sizeof(Metadata) - 1);
+    put(binary, 0x58 + 40 + 16, 4, false, (sizeof(Metadata) - 1 + 15) & ~15);
+    put(binary, 0x58 + 40 + 20, 4, false, 0x58 + 80);
+    binary.resize(0x58 + 80);
+    binary += Metadata;
+    binary.resize(0x58 + 80 + ((sizeof(Metadata) - 1 + 15) & ~15), '\xcc');
+
+    CORRADE_COMPARE(metadata(binary), Metadata);
+}
+
+void EmbeddedMetadataTest::machO64() {
+    CORRADE_COMPARE(metadata(Test::machO64("__corrade", Metadata)), Metadata);
+    CORRADE_COMPARE(metadata(Test::machO64("__corrade_other", Metadata)), "");
+}
+
+void EmbeddedMetadataTest::machOUniversal() {
+    /* The first architecture doesn't have the section, the second does */
+    const std::string first = Test::machO64("__const", "hello");
+    const std::string second = Test::machO64("__corrade", Metadata);
+
+    std::string binary;
+    put(binary, 0, 4, true, 0xcafebabe);
+    put(binary, 4, 4, true, 2);
+    put(binary, 8 + 8, 4, true, 48);
+    put(binary, 8 + 12, 4, true, first.size());
+    put(binary, 8 + 20 + 8, 4, true, 48 + first.size());
+    put(binary, 8 + 20 + 12, 4, true, second.size());
+    binary.resize(48);
+    binary += first;
+    binary += second;
+
+    CORRADE_COMPARE(metadata(binary), Metadata);
+}
+
+void EmbeddedMetadataTest::unknown() {
+    CORRADE_COMPARE(metadata(""), "");
+    CORRADE_COMPARE(metadata("this is not a binary"), "");
+    CORRADE_COMPARE(metadata("MZ"), "");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::PluginManager::Test::EmbeddedMetadataTest)
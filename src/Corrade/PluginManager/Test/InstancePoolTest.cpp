@@ -0,0 +1,283 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+
+#include "Corrade/PluginManager/InstancePool.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/Utility/DebugStl.h"
+
+#include "AbstractAnimal.h"
+#include "animals/Canary.h"
+
+#include "configure.h"
+
+static void importPlugin() {
+    CORRADE_PLUGIN_IMPORT(Canary)
+}
+
+namespace Corrade { namespace PluginManager { namespace Test { namespace {
+
+struct InstancePoolTest: TestSuite::Tester {
+    explicit InstancePoolTest();
+
+    void construct();
+    void constructCopy();
+
+    void acquire();
+    void acquireFailed();
+    void capacity();
+    void prewarm();
+    void prewarmFailed();
+    void release();
+    void move();
+    void accessEmpty();
+
+    #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+    void clearUnload();
+    #endif
+};
+
+InstancePoolTest::InstancePoolTest() {
+    addTests({&InstancePoolTest::construct,
+              &InstancePoolTest::constructCopy,
+
+              &InstancePoolTest::acquire,
+              &InstancePoolTest::acquireFailed,
+              &InstancePoolTest::capacity,
+              &InstancePoolTest::prewarm,
+              &InstancePoolTest::prewarmFailed,
+              &InstancePoolTest::release,
+              &InstancePoolTest::move,
+              &InstancePoolTest::accessEmpty,
+
+              #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+              &InstancePoolTest::clearUnload
+              #endif
+              });
+
+    importPlugin();
+}
+
+void InstancePoolTest::construct() {
+    PluginManager::Manager<AbstractAnimal> manager;
+    InstancePool<AbstractAnimal> pool{manager, "Canary", 3};
+    CORRADE_COMPARE(pool.plugin(), "Canary");
+    CORRADE_COMPARE(pool.capacity(), 3);
+    CORRADE_COMPARE(pool.idleCount(), 0);
+}
+
+void InstancePoolTest::constructCopy() {
+    CORRADE_VERIFY(!(std::is_constructible<InstancePool<AbstractAnimal>, const InstancePool<AbstractAnimal>&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<InstancePool<AbstractAnimal>, const InstancePool<AbstractAnimal>&>{}));
+
+    CORRADE_VERIFY(!(std::is_constructible<PooledInstance<AbstractAnimal>, const PooledInstance<AbstractAnimal>&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<PooledInstance<AbstractAnimal>, const PooledInstance<AbstractAnimal>&>{}));
+}
+
+void InstancePoolTest::acquire() {
+    PluginManager::Manager<AbstractAnimal> manager;
+    InstancePool<AbstractAnimal> pool{manager, "Canary", 3};
+
+    AbstractAnimal* pointer;
+    {
+        PooledInstance<AbstractAnimal> animal = pool.acquire();
+        CORRADE_VERIFY(animal);
+        CORRADE_COMPARE(animal->name(), "Achoo");
+        CORRADE_COMPARE((*animal).legCount(), 2);
+        CORRADE_COMPARE(pool.idleCount(), 0);
+        pointer = animal.get();
+    }
+
+    /* The instance got recycled */
+    CORRADE_COMPARE(pool.idleCount(), 1);
+
+    /* And is given back on next acquire */
+    PooledInstance<AbstractAnimal> animal = pool.acquire();
+    CORRADE_COMPARE(animal.get(), pointer);
+    CORRADE_COMPARE(pool.idleCount(), 0);
+}
+
+void InstancePoolTest::acquireFailed() {
+    PluginManager::Manager<AbstractAnimal> manager;
+    InstancePool<AbstractAnimal> pool{manager, "Nonexistent", 3};
+
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        PooledInstance<AbstractAnimal> animal = pool.acquire();
+        CORRADE_VERIFY(!animal);
+        CORRADE_VERIFY(!animal.get());
+    }
+    CORRADE_VERIFY(!out.str().empty());
+
+    /* Nothing gets recycled */
+    CORRADE_COMPARE(pool.idleCount(), 0);
+}
+
+void InstancePoolTest::capacity() {
+    PluginManager::Manager<AbstractAnimal> manager;
+    InstancePool<AbstractAnimal> pool{manager, "Canary", 2};
+
+    {
+        PooledInstance<AbstractAnimal> a = pool.acquire();
+        PooledInstance<AbstractAnimal> b = pool.acquire();
+        PooledInstance<AbstractAnimal> c = pool.acquire();
+        CORRADE_VERIFY(a);
+        CORRADE_VERIFY(b);
+        CORRADE_VERIFY(c);
+        CORRADE_VERIFY(a.get() != b.get());
+        CORRADE_VERIFY(b.get() != c.get());
+    }
+
+    /* The third instance got deleted */
+    CORRADE_COMPARE(pool.idleCount(), 2);
+}
+
+void InstancePoolTest::prewarm() {
+    PluginManager::Manager<AbstractAnimal> manager;
+    InstancePool<AbstractAnimal> pool{manager, "Canary", 3};
+
+    CORRADE_COMPARE(pool.prewarm(2), 2);
+    CORRADE_COMPARE(pool.idleCount(), 2);
+
+    /* Already prewarmed enough, nothing is created */
+    CORRADE_COMPARE(pool.prewarm(1), 2);
+
+    /* Can't go over capacity */
+    CORRADE_COMPARE(pool.prewarm(5), 3);
+    CORRADE_COMPARE(pool.idleCount(), 3);
+
+    {
+        PooledInstance<AbstractAnimal> animal = pool.acquire();
+        CORRADE_VERIFY(animal);
+        CORRADE_COMPARE(animal->name(), "Achoo");
+        CORRADE_COMPARE(pool.idleCount(), 2);
+    }
+
+    pool.clear();
+    CORRADE_COMPARE(pool.idleCount(), 0);
+}
+
+void InstancePoolTest::prewarmFailed() {
+    PluginManager::Manager<AbstractAnimal> manager;
+    InstancePool<AbstractAnimal> pool{manager, "Nonexistent", 3};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_COMPARE(pool.prewarm(2), 0);
+    #if defined(CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT) || defined(CORRADE_TARGET_EMSCRIPTEN) || defined(CORRADE_TARGET_WINDOWS_RT) || defined(CORRADE_TARGET_IOS) || defined(CORRADE_TARGET_ANDROID)
+    CORRADE_COMPARE(out.str(), "PluginManager::Manager::load(): plugin Nonexistent was not found\n");
+    #else
+    CORRADE_COMPARE(out.str(), "PluginManager::Manager::load(): plugin Nonexistent is not static and was not found in " PLUGINS_DIR "/animals\n");
+    #endif
+}
+
+void InstancePoolTest::release() {
+    PluginManager::Manager<AbstractAnimal> manager;
+    InstancePool<AbstractAnimal> pool{manager, "Canary", 3};
+
+    {
+        PooledInstance<AbstractAnimal> animal = pool.acquire();
+        Containers::Pointer<AbstractAnimal> released = animal.release();
+        CORRADE_VERIFY(!animal);
+        CORRADE_VERIFY(released);
+        CORRADE_COMPARE(released->name(), "Achoo");
+    }
+
+    /* The released instance was deleted, not recycled */
+    CORRADE_COMPARE(pool.idleCount(), 0);
+}
+
+void InstancePoolTest::move() {
+    PluginManager::Manager<AbstractAnimal> manager;
+    InstancePool<AbstractAnimal> pool{manager, "Canary", 3};
+
+    {
+        PooledInstance<AbstractAnimal> a = pool.acquire();
+        AbstractAnimal* pointer = a.get();
+
+        PooledInstance<AbstractAnimal> b{std::move(a)};
+        CORRADE_VERIFY(!a);
+        CORRADE_COMPARE(b.get(), pointer);
+
+        PooledInstance<AbstractAnimal> c = pool.acquire();
+        AbstractAnimal* another = c.get();
+        c = std::move(b);
+        CORRADE_COMPARE(c.get(), pointer);
+        CORRADE_COMPARE(b.get(), another);
+    }
+
+    /* Both instances got recycled exactly once */
+    CORRADE_COMPARE(pool.idleCount(), 2);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<PooledInstance<AbstractAnimal>>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<PooledInstance<AbstractAnimal>>::value);
+}
+
+void InstancePoolTest::accessEmpty() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    PooledInstance<AbstractAnimal> animal;
+    const PooledInstance<AbstractAnimal>& canimal = animal;
+    CORRADE_VERIFY(!animal);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    animal.operator->();
+    canimal.operator->();
+    CORRADE_COMPARE(out.str(),
+        "PluginManager::PooledInstance::operator->(): the instance is empty\n"
+        "PluginManager::PooledInstance::operator->(): the instance is empty\n");
+}
+
+#ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+void InstancePoolTest::clearUnload() {
+    PluginManager::Manager<AbstractAnimal> manager;
+    InstancePool<AbstractAnimal> pool{manager, "Dog", 3};
+
+    /* Prewarming loads the plugin */
+    CORRADE_COMPARE(manager.loadState("Dog"), LoadState::NotLoaded);
+    CORRADE_COMPARE(pool.prewarm(1), 1);
+    CORRADE_COMPARE(manager.loadState("Dog"), LoadState::Loaded);
+
+    /* Idle instances keep the plugin in use */
+    {
+        std::ostringstream out;
+        Error redirectError{&out};
+        CORRADE_COMPARE(manager.unload("Dog"), LoadState::Used);
+        CORRADE_COMPARE(out.str(), "PluginManager::Manager::unload(): plugin Dog is currently used and cannot be deleted\n");
+    }
+
+    pool.clear();
+    CORRADE_COMPARE(manager.unload("Dog"), LoadState::NotLoaded);
+}
+#endif
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::PluginManager::Test::InstancePoolTest)
@@ -26,11 +26,17 @@
 #include <sstream>
 
 #include "Corrade/PluginManager/Manager.h"
+#include "Corrade/PluginManager/Registry.h"
 #include "Corrade/TestSuite/Tester.h"
 #include "Corrade/Utility/DebugStl.h" /** @todo remove when <sstream> is gone */
 
 #include "init-fini/InitFini.h"
 
+#if !defined(CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT) && defined(CORRADE_BUILD_MULTITHREADED)
+#include <future>
+#include <thread>
+#endif
+
 static void importPlugin() {
     CORRADE_PLUGIN_IMPORT(InitFiniStatic)
 }
@@ -43,6 +49,8 @@ struct ManagerInitFiniTest: TestSuite::Tester {
     void staticPlugin();
     #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
     void dynamicPlugin();
+    void dynamicPluginRegistry();
+    void dynamicPluginFastShutdown();
     #endif
 };
 
@@ -50,6 +58,9 @@ ManagerInitFiniTest::ManagerInitFiniTest() {
     addTests({&ManagerInitFiniTest::staticPlugin,
               #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
               &ManagerInitFiniTest::dynamicPlugin,
+              &ManagerInitFiniTest::dynamicPluginRegistry,
+              /* Keeps the plugin modules loaded, so has to be last */
+              &ManagerInitFiniTest::dynamicPluginFastShutdown,
               #endif
               });
 
@@ -100,6 +111,89 @@ void ManagerInitFiniTest::dynamicPlugin() {
        destruction */
     CORRADE_COMPARE(out.str(), "Static plugin finalized\n");
 }
+
+void ManagerInitFiniTest::dynamicPluginRegistry() {
+    #ifndef CORRADE_BUILD_MULTITHREADED
+    CORRADE_SKIP("CORRADE_BUILD_MULTITHREADED not enabled.");
+    #else
+    PluginManager::Registry registry;
+
+    /* Plugin state is thread-local, so the other manager has to live in
+       another thread. It keeps the plugin loaded until told to unload it. */
+    std::promise<void> loaded, unload;
+    std::ostringstream threadOut;
+    LoadState threadLoadState{}, threadUnloadState{};
+    std::thread thread{[&] {
+        Debug redirectDebug{&threadOut};
+        PluginManager::Manager<InitFini> manager{registry};
+        threadLoadState = manager.load("InitFiniDynamic");
+        loaded.set_value();
+        unload.get_future().wait();
+        threadUnloadState = manager.unload("InitFiniDynamic");
+    }};
+    loaded.get_future().wait();
+    CORRADE_COMPARE(threadLoadState, LoadState::Loaded);
+    CORRADE_COMPARE(registry.moduleCount(), 1);
+
+    std::ostringstream out;
+    Debug redirectDebug{&out};
+
+    {
+        PluginManager::Manager<InitFini> manager{registry};
+        CORRADE_COMPARE(out.str(), "Static plugin initialized\n");
+
+        /* The plugin was already initialized by the other manager, so it
+           isn't initialized again and the binary is shared */
+        out.str({});
+        CORRADE_COMPARE(manager.load("InitFiniDynamic"), LoadState::Loaded);
+        CORRADE_COMPARE(out.str(), "");
+        CORRADE_COMPARE(registry.moduleCount(), 1);
+
+        /* Unloading in the other manager doesn't finalize it as it's still
+           used here */
+        unload.set_value();
+        thread.join();
+        CORRADE_COMPARE(threadUnloadState, LoadState::NotLoaded);
+        CORRADE_COMPARE(threadOut.str(),
+            "Static plugin initialized\n"
+            "Dynamic plugin initialized\n"
+            "Static plugin finalized\n");
+        CORRADE_COMPARE(registry.moduleCount(), 1);
+
+        /* The last unload finalizes it */
+        CORRADE_COMPARE(manager.unload("InitFiniDynamic"), LoadState::NotLoaded);
+        CORRADE_COMPARE(out.str(), "Dynamic plugin finalized\n");
+        CORRADE_COMPARE(registry.moduleCount(), 0);
+    }
+    #endif
+}
+
+void ManagerInitFiniTest::dynamicPluginFastShutdown() {
+    std::ostringstream out;
+    Debug redirectDebug{&out};
+
+    {
+        PluginManager::Manager<InitFini> manager;
+        manager.setLoadFlags(LoadFlag::FastShutdown);
+        CORRADE_COMPARE(manager.load("InitFiniDynamic"), LoadState::Loaded);
+        CORRADE_COMPARE(manager.load("InitFiniOptional"), LoadState::Loaded);
+        CORRADE_COMPARE(out.str(),
+            "Static plugin initialized\n"
+            "Dynamic plugin initialized\n"
+            "Optional plugin initialized\n");
+
+        /* Explicit unload isn't affected by the flag */
+        out.str({});
+        CORRADE_COMPARE(manager.unload("InitFiniDynamic"), LoadState::NotLoaded);
+        CORRADE_COMPARE(out.str(), "Dynamic plugin finalized\n");
+
+        out.str({});
+    }
+
+    /* The optional finalizer is skipped on destruction, the static one (which
+       doesn't have it marked as optional) is called as usual */
+    CORRADE_COMPARE(out.str(), "Static plugin finalized\n");
+}
 #endif
 
 }}}}
@@ -28,12 +28,14 @@
 #include "Corrade/Containers/Array.h"
 #include "Corrade/PluginManager/Manager.h"
 #include "Corrade/PluginManager/PluginMetadata.h"
+#include "Corrade/PluginManager/Registry.h"
 #include "Corrade/TestSuite/Tester.h"
 #include "Corrade/TestSuite/Compare/Container.h"
 #include "Corrade/Utility/DebugStl.h" /** @todo remove when <sstream> is gone */
 #include "Corrade/Utility/Directory.h"
 #include "Corrade/Utility/FormatStl.h"
 #include "Corrade/Utility/Configuration.h"
+#include "Corrade/Utility/String.h"
 #include "Corrade/Utility/System.h"
 
 #include "AbstractAnimal.h"
@@ -105,10 +107,42 @@ struct ManagerTest: TestSuite::Tester {
     void destructionHierarchy();
     void crossManagerDependencies();
     void unresolvedDependencies();
+    #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+    void loadList();
+    void loadListFailed();
+    void metadataCache();
+    void metadataCacheInvalid();
+    void metadataCacheMissingMetadataFile();
+    void embeddedMetadata();
+    void embeddedMetadataCache();
+    void embeddedMetadataOverriden();
+
+    void registry();
+
+    void pluginsForKey();
+    void lazy();
+    void lazyFailed();
+    void lazyUnload();
+    void lazyDependencyOfEager();
+    void lazyLocal();
+    void reload();
+    void reloadNotLoaded();
+    void reloadNonexistent();
+    void reloadUsed();
+    void reloadChanged();
+    #endif
 
     void reloadPluginDirectory();
     void restoreAliasesAfterPluginDirectoryChange();
 
+    void loadStatisticsStatic();
+    #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+    void loadStatisticsDynamic();
+    void loadStatisticsList();
+    #endif
+    void loadStatisticsNonexistent();
+    void loadTrace();
+
     void staticProvides();
     #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
     void dynamicProvides();
@@ -125,6 +159,11 @@ struct ManagerTest: TestSuite::Tester {
 
     void debugLoadState();
     void debugLoadStates();
+    #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+    void debugLoadFlag();
+    void debugLoadFlags();
+    void debugReloadEvent();
+    #endif
 
     #ifndef CORRADE_TARGET_EMSCRIPTEN
     void multithreadedStatic();
@@ -132,6 +171,13 @@ struct ManagerTest: TestSuite::Tester {
     void multithreadedDynamic();
     #endif
     #endif
+
+    void benchmarkLoadUnloadStatic();
+    void benchmarkInstantiateStatic();
+    #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+    void benchmarkLoadUnloadDynamic();
+    void benchmarkInstantiateDynamic();
+    #endif
 };
 
 ManagerTest::ManagerTest() {
@@ -180,10 +226,42 @@ ManagerTest::ManagerTest() {
               &ManagerTest::destructionHierarchy,
               &ManagerTest::crossManagerDependencies,
               &ManagerTest::unresolvedDependencies,
+              #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+              &ManagerTest::loadList,
+              &ManagerTest::loadListFailed,
+              &ManagerTest::metadataCache,
+              &ManagerTest::metadataCacheInvalid,
+              &ManagerTest::metadataCacheMissingMetadataFile,
+              &ManagerTest::embeddedMetadata,
+              &ManagerTest::embeddedMetadataCache,
+              &ManagerTest::embeddedMetadataOverriden,
+
+              &ManagerTest::registry,
+
+              &ManagerTest::pluginsForKey,
+              &ManagerTest::lazy,
+              &ManagerTest::lazyFailed,
+              &ManagerTest::lazyUnload,
+              &ManagerTest::lazyDependencyOfEager,
+              &ManagerTest::lazyLocal,
+              &ManagerTest::reload,
+              &ManagerTest::reloadNotLoaded,
+              &ManagerTest::reloadNonexistent,
+              &ManagerTest::reloadUsed,
+              &ManagerTest::reloadChanged,
+              #endif
 
               &ManagerTest::reloadPluginDirectory,
               &ManagerTest::restoreAliasesAfterPluginDirectoryChange,
 
+              &ManagerTest::loadStatisticsStatic,
+              #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+              &ManagerTest::loadStatisticsDynamic,
+              &ManagerTest::loadStatisticsList,
+              #endif
+              &ManagerTest::loadStatisticsNonexistent,
+              &ManagerTest::loadTrace,
+
               &ManagerTest::staticProvides,
               #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
               &ManagerTest::dynamicProvides,
@@ -199,7 +277,13 @@ ManagerTest::ManagerTest() {
               #endif
 
               &ManagerTest::debugLoadState,
-              &ManagerTest::debugLoadStates});
+              &ManagerTest::debugLoadStates,
+              #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+              &ManagerTest::debugLoadFlag,
+              &ManagerTest::debugLoadFlags,
+              &ManagerTest::debugReloadEvent,
+              #endif
+              });
 
     #ifndef CORRADE_TARGET_EMSCRIPTEN
     addRepeatedTests({
@@ -210,6 +294,14 @@ ManagerTest::ManagerTest() {
         }, 25);
     #endif
 
+    addBenchmarks({&ManagerTest::benchmarkLoadUnloadStatic,
+                   &ManagerTest::benchmarkInstantiateStatic,
+                   #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+                   &ManagerTest::benchmarkLoadUnloadDynamic,
+                   &ManagerTest::benchmarkInstantiateDynamic
+                   #endif
+                   }, 10);
+
     importPlugin();
 }
 
@@ -689,6 +781,9 @@ void ManagerTest::hierarchy() {
         std::vector<std::string>{"Dog"});
     CORRADE_COMPARE(manager.metadata("Dog")->usedBy(),
         std::vector<std::string>{"PitBull"});
+    /* The list is returned by reference, without a copy */
+    CORRADE_COMPARE(&manager.metadata("Dog")->usedBy(),
+        &manager.metadata("Dog")->usedBy());
 
     {
         Containers::Pointer<AbstractAnimal> animal = manager.instantiate("PitBull");
@@ -794,6 +889,567 @@ void ManagerTest::unresolvedDependencies() {
     #endif
 }
 
+#ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+void ManagerTest::loadList() {
+    PluginManager::Manager<AbstractAnimal> manager;
+    PluginManager::Manager<AbstractFood> foodManager;
+
+    /* Dog gets loaded first as a dependency of PitBull, Canary is static */
+    CORRADE_COMPARE(manager.load({"PitBull", "Canary", "Dog"}),
+        (std::vector<LoadState>{LoadState::Loaded, LoadState::Static, LoadState::Loaded}));
+    CORRADE_COMPARE(manager.loadState("Dog"), LoadState::Loaded);
+    CORRADE_COMPARE(manager.metadata("Dog")->usedBy(),
+        std::vector<std::string>{"PitBull"});
+
+    /* Already loaded dependency from another manager */
+    CORRADE_COMPARE(foodManager.load({"HotDog"}),
+        std::vector<LoadState>{LoadState::Loaded});
+    CORRADE_COMPARE(manager.metadata("Dog")->usedBy(),
+        (std::vector<std::string>{"PitBull", "HotDog"}));
+
+    {
+        Containers::Pointer<AbstractAnimal> animal = manager.instantiate("PitBull");
+        CORRADE_COMPARE(animal->name(), "Rodriguez");
+        Containers::Pointer<AbstractFood> hotdog = foodManager.instantiate("HotDog");
+        CORRADE_COMPARE(hotdog->weight(), 6800);
+    }
+
+    CORRADE_COMPARE(foodManager.unload("HotDog"), LoadState::NotLoaded);
+    CORRADE_COMPARE(manager.unload("PitBull"), LoadState::NotLoaded);
+    CORRADE_COMPARE(manager.unload("Dog"), LoadState::NotLoaded);
+}
+
+void ManagerTest::loadListFailed() {
+    PluginManager::Manager<AbstractAnimal> manager;
+    PluginManager::Manager<AbstractFood> foodManager;
+
+    /* Failures of plugins opened in parallel are reported first, the rest
+       gets reported from the serial load() after */
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_COMPARE(foodManager.load({"HotDogWithSnail", "OldBread", "Nonexistent", "HotDog", "RottenTomato"}),
+        (std::vector<LoadState>{
+            LoadState::UnresolvedDependency,
+            LoadState::WrongPluginVersion,
+            LoadState::NotFound,
+            LoadState::Loaded,
+            LoadState::WrongInterfaceVersion}));
+    CORRADE_COMPARE(out.str(),
+        "PluginManager::Manager::load(): wrong version of plugin OldBread, expected 6 but got 0\n"
+        "PluginManager::Manager::load(): wrong interface string of plugin RottenTomato, expected cz.mosra.corrade.PluginManager.Test.AbstractFood/1.0 but got cz.mosra.corrade.PluginManager.Test.AbstractFood/0.1\n"
+        "PluginManager::Manager::load(): unresolved dependency SomethingThatDoesNotExist of plugin Snail\n"
+        "PluginManager::Manager::load(): unresolved dependency Snail of plugin HotDogWithSnail\n"
+        "PluginManager::Manager::load(): plugin Nonexistent is not static and was not found in " PLUGINS_DIR "/food\n");
+    CORRADE_COMPARE(foodManager.loadState("OldBread"), LoadState::NotLoaded);
+    CORRADE_COMPARE(foodManager.loadState("HotDogWithSnail"), LoadState::NotLoaded);
+    CORRADE_COMPARE(manager.metadata("Dog")->usedBy(),
+        std::vector<std::string>{"HotDog"});
+}
+#endif
+
+void ManagerTest::metadataCache() {
+    const std::string cache = Utility::Directory::join(PLUGINS_DIR, "metadata.cache");
+    if(Utility::Directory::exists(cache))
+        CORRADE_VERIFY(Utility::Directory::rm(cache));
+
+    /* The cache gets created */
+    {
+        PluginManager::Manager<AbstractAnimal> manager{{}, cache};
+        CORRADE_COMPARE(manager.metadataCache(), cache);
+        CORRADE_COMPARE(manager.metadata("Dog")->data().value("description"), "A simple dog plugin.");
+    }
+    CORRADE_VERIFY(Utility::Directory::exists(cache));
+
+    /* Entries for another plugin directory get added, the original ones
+       preserved */
+    {
+        PluginManager::Manager<AbstractFood> foodManager{{}, cache};
+        CORRADE_COMPARE(foodManager.metadata("HotDog")->depends(),
+            std::vector<std::string>{"Dog"});
+    }
+    std::string contents = Utility::Directory::readString(cache);
+    CORRADE_VERIFY(contents.find("A simple dog plugin.") != std::string::npos);
+    CORRADE_VERIFY(contents.find("depends=Dog") != std::string::npos);
+
+    /* Modify the cached contents to verify the metadata files are not opened
+       again. Keeping the same size for simplicity. */
+    const std::size_t pos = contents.find("A simple dog plugin.");
+    contents.replace(pos, 20, "A cached dog plugin.");
+    CORRADE_VERIFY(Utility::Directory::writeString(cache, contents));
+    {
+        PluginManager::Manager<AbstractAnimal> manager{{}, cache};
+        CORRADE_COMPARE(manager.metadata("Dog")->data().value("description"), "A cached dog plugin.");
+        CORRADE_COMPARE(manager.metadata("PitBull")->depends(),
+            std::vector<std::string>{"Dog"});
+
+        /* Loading works the same */
+        CORRADE_COMPARE(manager.load("PitBull"), LoadState::Loaded);
+        CORRADE_COMPARE(manager.metadata("Dog")->usedBy(),
+            std::vector<std::string>{"PitBull"});
+        CORRADE_COMPARE(manager.instantiate("PitBull")->name(), "Rodriguez");
+
+        /* Reloading the directory with loaded plugins still doesn't need to
+           open anything */
+        manager.reloadPluginDirectory();
+        CORRADE_COMPARE(manager.loadState("PitBull"), LoadState::Loaded);
+        CORRADE_COMPARE(manager.loadState("Bulldog"), LoadState::NotLoaded);
+    }
+
+    /* Nothing changed, so the cache wasn't rewritten */
+    CORRADE_COMPARE(Utility::Directory::readString(cache), contents);
+}
+
+void ManagerTest::metadataCacheInvalid() {
+    const std::string cache = Utility::Directory::join(PLUGINS_DIR, "metadata.cache");
+    CORRADE_VERIFY(Utility::Directory::writeString(cache, "this is not a cache"));
+
+    /* The invalid cache is ignored and rewritten */
+    {
+        PluginManager::Manager<AbstractAnimal> manager{{}, cache};
+        CORRADE_COMPARE(manager.metadata("Dog")->data().value("description"), "A simple dog plugin.");
+    }
+    const std::string contents = Utility::Directory::readString(cache);
+    CORRADE_VERIFY(contents.find("A simple dog plugin.") != std::string::npos);
+
+    /* Truncated cache as well */
+    CORRADE_VERIFY(Utility::Directory::writeString(cache, contents.substr(0, contents.size() - 1)));
+    {
+        PluginManager::Manager<AbstractAnimal> manager{{}, cache};
+        CORRADE_COMPARE(manager.metadata("Dog")->data().value("description"), "A simple dog plugin.");
+    }
+    CORRADE_COMPARE(Utility::Directory::readString(cache), contents);
+}
+
+void ManagerTest::metadataCacheMissingMetadataFile() {
+    std::string dir = Utility::Directory::join(PLUGINS_DIR, "missing-metadata");
+    CORRADE_VERIFY(Utility::Directory::mkpath(dir));
+    CORRADE_VERIFY(Utility::Directory::writeString(Utility::Directory::join(dir, "MissingMetadata" PLUGIN_FILENAME_SUFFIX), "this is not a binary"));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    PluginManager::Manager<WrongMetadata> manager{dir, Utility::Directory::join(PLUGINS_DIR, "metadata.cache")};
+    CORRADE_COMPARE(manager.loadState("MissingMetadata"), LoadState::WrongMetadataFile);
+    CORRADE_COMPARE(out.str(), Utility::formatString(
+        "PluginManager::Manager: {} was not found\n",
+        Utility::Directory::join(dir, "MissingMetadata.conf")));
+}
+
+void ManagerTest::embeddedMetadata() {
+    /* The Bulldog plugin is built with EMBED_METADATA, so there's no file
+       next to it */
+    CORRADE_VERIFY(Utility::Directory::exists(BULLDOG_PLUGIN_FILENAME));
+    CORRADE_VERIFY(!Utility::Directory::exists(Utility::Directory::join(Utility::Directory::path(BULLDOG_PLUGIN_FILENAME), "Bulldog.conf")));
+
+    PluginManager::Manager<AbstractAnimal> manager;
+    CORRADE_COMPARE(manager.loadState("Bulldog"), LoadState::NotLoaded);
+    CORRADE_COMPARE(manager.metadata("Bulldog")->depends(),
+        std::vector<std::string>{"JustSomeMammal"});
+
+    /* Loading the plugin by filename reads the embedded metadata as well --
+       it gets to dependency resolution instead of failing on a missing
+       metadata file */
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_COMPARE(manager.load(BULLDOG_PLUGIN_FILENAME), LoadState::UnresolvedDependency);
+    CORRADE_COMPARE(out.str(), "PluginManager::Manager::load(): unresolved dependency JustSomeMammal of plugin Bulldog\n");
+}
+
+void ManagerTest::embeddedMetadataCache() {
+    const std::string cache = Utility::Directory::join(PLUGINS_DIR, "metadata.cache");
+    if(Utility::Directory::exists(cache))
+        CORRADE_VERIFY(Utility::Directory::rm(cache));
+
+    /* The embedded metadata get cached under the binary filename */
+    {
+        PluginManager::Manager<AbstractAnimal> manager{{}, cache};
+        CORRADE_COMPARE(manager.metadata("Bulldog")->depends(),
+            std::vector<std::string>{"JustSomeMammal"});
+    }
+    const std::string contents = Utility::Directory::readString(cache);
+    CORRADE_VERIFY(contents.find("Bulldog" PLUGIN_FILENAME_SUFFIX) != std::string::npos);
+    CORRADE_VERIFY(contents.find("depends=JustSomeMammal") != std::string::npos);
+
+    /* Second time they're taken from the cache, which doesn't get
+       rewritten */
+    {
+        PluginManager::Manager<AbstractAnimal> manager{{}, cache};
+        CORRADE_COMPARE(manager.metadata("Bulldog")->depends(),
+            std::vector<std::string>{"JustSomeMammal"});
+    }
+    CORRADE_COMPARE(Utility::Directory::readString(cache), contents);
+}
+
+void ManagerTest::embeddedMetadataOverriden() {
+    /* A metadata file next to the binary takes precedence over the embedded
+       metadata */
+    const std::string dir = Utility::Directory::join(PLUGINS_DIR, "embedded-overriden");
+    CORRADE_VERIFY(Utility::Directory::mkpath(dir));
+    CORRADE_VERIFY(Utility::Directory::copy(BULLDOG_PLUGIN_FILENAME, Utility::Directory::join(dir, "Bulldog" PLUGIN_FILENAME_SUFFIX)));
+    CORRADE_VERIFY(Utility::Directory::writeString(Utility::Directory::join(dir, "Bulldog.conf"), "depends=Dog\n"));
+
+    PluginManager::Manager<AbstractAnimal> manager{dir};
+    CORRADE_COMPARE(manager.metadata("Bulldog")->depends(),
+        std::vector<std::string>{"Dog"});
+}
+
+void ManagerTest::registry() {
+    const std::string dir = Utility::Directory::join(PLUGINS_DIR, "registry");
+    CORRADE_VERIFY(Utility::Directory::mkpath(dir));
+    for(const char* file: {"Second" PLUGIN_FILENAME_SUFFIX, "Second.conf"}) {
+        const std::string filename = Utility::Directory::join(dir, file);
+        if(Utility::Directory::exists(filename))
+            CORRADE_VERIFY(Utility::Directory::rm(filename));
+    }
+    CORRADE_VERIFY(Utility::Directory::writeString(Utility::Directory::join(dir, "First" PLUGIN_FILENAME_SUFFIX), "this is not a binary"));
+    CORRADE_VERIFY(Utility::Directory::writeString(Utility::Directory::join(dir, "First.conf"), "provides=Primary\n"));
+
+    PluginManager::Registry registry;
+    CORRADE_COMPARE(registry.directoryCount(), 0);
+    {
+        PluginManager::Manager<AbstractAnimal> manager{registry, dir};
+        CORRADE_VERIFY(manager.metadata("First"));
+        CORRADE_VERIFY(!manager.metadata("Second"));
+    }
+    CORRADE_COMPARE(registry.directoryCount(), 1);
+
+    /* A plugin added after the first scan isn't seen by subsequent managers,
+       as the directory isn't listed again */
+    CORRADE_VERIFY(Utility::Directory::writeString(Utility::Directory::join(dir, "Second" PLUGIN_FILENAME_SUFFIX), "this is not a binary"));
+    CORRADE_VERIFY(Utility::Directory::writeString(Utility::Directory::join(dir, "Second.conf"), "provides=Secondary\n"));
+    {
+        PluginManager::Manager<AbstractAnimal> manager{registry, dir};
+        CORRADE_VERIFY(manager.metadata("First"));
+        CORRADE_COMPARE(manager.metadata("Primary")->name(), "First");
+        CORRADE_VERIFY(!manager.metadata("Second"));
+
+        /* An explicit reload rescans the directory and updates the
+           registry */
+        manager.reloadPluginDirectory();
+        CORRADE_VERIFY(manager.metadata("Second"));
+        CORRADE_COMPARE(manager.metadata("Secondary")->name(), "Second");
+    } {
+        PluginManager::Manager<AbstractAnimal> manager{registry, dir};
+        CORRADE_VERIFY(manager.metadata("First"));
+        CORRADE_VERIFY(manager.metadata("Second"));
+    }
+    CORRADE_COMPARE(registry.directoryCount(), 1);
+
+    /* A manager without the registry isn't affected by it */
+    CORRADE_VERIFY(Utility::Directory::rm(Utility::Directory::join(dir, "Second" PLUGIN_FILENAME_SUFFIX)));
+    {
+        PluginManager::Manager<AbstractAnimal> manager{dir};
+        CORRADE_VERIFY(!manager.metadata("Second"));
+    }
+
+    /* After clearing, the next manager scans the directory again */
+    registry.clear();
+    CORRADE_COMPARE(registry.directoryCount(), 0);
+    {
+        PluginManager::Manager<AbstractAnimal> manager{registry, dir};
+        CORRADE_VERIFY(manager.metadata("First"));
+        CORRADE_VERIFY(!manager.metadata("Second"));
+    }
+    CORRADE_COMPARE(registry.directoryCount(), 1);
+}
+
+void ManagerTest::pluginsForKey() {
+    const std::string dir = Utility::Directory::join(PLUGINS_DIR, "plugins-for-key");
+    CORRADE_VERIFY(Utility::Directory::mkpath(dir));
+    const std::string late = Utility::Directory::join(dir, "Late" PLUGIN_FILENAME_SUFFIX);
+    if(Utility::Directory::exists(late))
+        CORRADE_VERIFY(Utility::Directory::rm(late));
+    for(const char* name: {"Png", "PngJpeg", "Nothing"})
+        CORRADE_VERIFY(Utility::Directory::writeString(Utility::Directory::join(dir, name + std::string{PLUGIN_FILENAME_SUFFIX}), "this is not a binary"));
+    CORRADE_VERIFY(Utility::Directory::writeString(Utility::Directory::join(dir, "Png.conf"),
+        "[data]\nextension=png\n"));
+    CORRADE_VERIFY(Utility::Directory::writeString(Utility::Directory::join(dir, "PngJpeg.conf"),
+        "[data]\nextension=jpeg\nextension=png\nextension=png\n"));
+    CORRADE_VERIFY(Utility::Directory::writeString(Utility::Directory::join(dir, "Nothing.conf"), ""));
+    CORRADE_VERIFY(Utility::Directory::writeString(Utility::Directory::join(dir, "Late.conf"),
+        "[data]\nextension=png\n"));
+
+    PluginManager::Manager<AbstractAnimal> manager{dir};
+    CORRADE_COMPARE_AS(manager.pluginsForKey("extension", "png"),
+        (std::vector<std::string>{"Png", "PngJpeg"}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(manager.pluginsForKey("extension", "jpeg"),
+        std::vector<std::string>{"PngJpeg"},
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(manager.pluginsForKey("extension", "gif"),
+        std::vector<std::string>{},
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(manager.pluginsForKey("mimeType", "image/png"),
+        std::vector<std::string>{},
+        TestSuite::Compare::Container);
+
+    /* Static plugins are included as well */
+    CORRADE_COMPARE_AS(manager.pluginsForKey("description", "I'm allergic to canaries!"),
+        std::vector<std::string>{"Canary"},
+        TestSuite::Compare::Container);
+
+    /* The index gets rebuilt after the plugin list changes */
+    CORRADE_VERIFY(Utility::Directory::writeString(late, "this is not a binary"));
+    manager.reloadPluginDirectory();
+    CORRADE_COMPARE_AS(manager.pluginsForKey("extension", "png"),
+        (std::vector<std::string>{"Late", "Png", "PngJpeg"}),
+        TestSuite::Compare::Container);
+}
+
+void ManagerTest::lazy() {
+    PluginManager::Manager<AbstractAnimal> manager;
+    CORRADE_COMPARE(manager.loadFlags(), LoadFlags{});
+
+    manager.setLoadFlags(LoadFlag::Lazy);
+    CORRADE_COMPARE(manager.loadFlags(), LoadFlag::Lazy);
+
+    /* Dependencies are resolved right away */
+    CORRADE_COMPARE(manager.load("PitBull"), LoadState::Loaded);
+    CORRADE_COMPARE(manager.loadState("PitBull"), LoadState::Loaded);
+    CORRADE_COMPARE(manager.loadState("Dog"), LoadState::Loaded);
+    CORRADE_COMPARE(manager.metadata("Dog")->usedBy(),
+        std::vector<std::string>{"PitBull"});
+
+    /* The binaries get opened on first instantiation, including the
+       dependency */
+    {
+        Containers::Pointer<AbstractAnimal> animal = manager.instantiate("PitBull");
+        CORRADE_VERIFY(animal);
+        CORRADE_COMPARE(animal->name(), "Rodriguez");
+        CORRADE_COMPARE(animal->legCount(), 4);
+        Containers::Pointer<AbstractAnimal> dog = manager.instantiate("Dog");
+        CORRADE_VERIFY(dog);
+        CORRADE_COMPARE(dog->name(), "Doug");
+    }
+
+    /* The usedBy list isn't updated twice */
+    CORRADE_COMPARE(manager.metadata("Dog")->usedBy(),
+        std::vector<std::string>{"PitBull"});
+
+    CORRADE_COMPARE(manager.unload("PitBull"), LoadState::NotLoaded);
+    CORRADE_COMPARE(manager.unload("Dog"), LoadState::NotLoaded);
+
+    /* Load and instantiate works as well */
+    Containers::Pointer<AbstractAnimal> animal = manager.loadAndInstantiate("Dog");
+    CORRADE_VERIFY(animal);
+    CORRADE_COMPARE(animal->name(), "Doug");
+}
+
+void ManagerTest::lazyFailed() {
+    PluginManager::Manager<AbstractFood> foodManager;
+    foodManager.setLoadFlags(LoadFlag::Lazy);
+
+    /* The binary isn't opened, so the version mismatch isn't detected yet */
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_COMPARE(foodManager.load("OldBread"), LoadState::Loaded);
+    CORRADE_COMPARE(out.str(), "");
+
+    CORRADE_VERIFY(!foodManager.instantiate("OldBread"));
+    CORRADE_COMPARE(out.str(), "PluginManager::Manager::load(): wrong version of plugin OldBread, expected 6 but got 0\n");
+
+    /* The plugin stays loaded and can be unloaded */
+    CORRADE_COMPARE(foodManager.loadState("OldBread"), LoadState::Loaded);
+    CORRADE_COMPARE(foodManager.unload("OldBread"), LoadState::NotLoaded);
+}
+
+void ManagerTest::lazyUnload() {
+    PluginManager::Manager<AbstractAnimal> manager;
+    manager.setLoadFlags(LoadFlag::Lazy);
+
+    CORRADE_COMPARE(manager.load("PitBull"), LoadState::Loaded);
+
+    /* Unloading a plugin that was never opened still respects
+       dependencies */
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_COMPARE(manager.unload("Dog"), LoadState::Required);
+    CORRADE_COMPARE(out.str(), "PluginManager::Manager::unload(): plugin Dog is required by other plugins: {PitBull}\n");
+
+    CORRADE_COMPARE(manager.unload("PitBull"), LoadState::NotLoaded);
+    CORRADE_VERIFY(manager.metadata("Dog")->usedBy().empty());
+    CORRADE_COMPARE(manager.unload("Dog"), LoadState::NotLoaded);
+    CORRADE_COMPARE(manager.loadState("Dog"), LoadState::NotLoaded);
+}
+
+void ManagerTest::lazyDependencyOfEager() {
+    PluginManager::Manager<AbstractAnimal> manager;
+    PluginManager::Manager<AbstractFood> foodManager;
+    manager.setLoadFlags(LoadFlag::Lazy);
+
+    /* HotDog is loaded eagerly, so the deferred Dog has to be opened */
+    CORRADE_COMPARE(manager.load("Dog"), LoadState::Loaded);
+    CORRADE_COMPARE(foodManager.load("HotDog"), LoadState::Loaded);
+    CORRADE_COMPARE(manager.metadata("Dog")->usedBy(),
+        std::vector<std::string>{"HotDog"});
+    {
+        Containers::Pointer<AbstractFood> hotdog = foodManager.instantiate("HotDog");
+        CORRADE_VERIFY(hotdog);
+        CORRADE_COMPARE(hotdog->weight(), 6800);
+    }
+
+    CORRADE_COMPARE(foodManager.unload("HotDog"), LoadState::NotLoaded);
+    CORRADE_COMPARE(manager.unload("Dog"), LoadState::NotLoaded);
+}
+
+void ManagerTest::lazyLocal() {
+    PluginManager::Manager<AbstractAnimal> manager;
+    manager.setLoadFlags(LoadFlag::Lazy|LoadFlag::Local);
+
+    /* Dog is opened with global symbols because PitBull depends on it,
+       PitBull then with local */
+    CORRADE_COMPARE(manager.load("PitBull"), LoadState::Loaded);
+    Containers::Pointer<AbstractAnimal> animal = manager.instantiate("PitBull");
+    CORRADE_VERIFY(animal);
+    CORRADE_COMPARE(animal->name(), "Rodriguez");
+}
+
+struct ReloadState {
+    std::vector<std::string> events;
+    Containers::Pointer<AbstractAnimal> animal;
+};
+
+void recordReload(AbstractManager& manager, const std::string& plugin, ReloadEvent event, void* state) {
+    ReloadState& s = *static_cast<ReloadState*>(state);
+    s.events.push_back(Utility::formatString("{} {}", plugin, event == ReloadEvent::Unload ? "unload" : "reload"));
+
+    /* Destroy the live PitBull instance and create a new one after */
+    if(plugin != "PitBull") return;
+    if(event == ReloadEvent::Unload)
+        s.animal = nullptr;
+    else
+        s.animal = static_cast<PluginManager::Manager<AbstractAnimal>&>(manager).instantiate(plugin);
+}
+
+void ManagerTest::reload() {
+    PluginManager::Manager<AbstractAnimal> manager;
+    PluginManager::Manager<AbstractFood> foodManager;
+
+    ReloadState state;
+    manager.setReloadCallback(recordReload, &state);
+    foodManager.setReloadCallback(recordReload, &state);
+
+    CORRADE_COMPARE(manager.load("PitBull"), LoadState::Loaded);
+    CORRADE_COMPARE(foodManager.load("HotDog"), LoadState::Loaded);
+    state.animal = manager.instantiate("PitBull");
+
+    /* Dependents get reloaded as well, including ones from other
+       managers */
+    CORRADE_COMPARE(manager.reload("Dog"), LoadState::Loaded);
+    CORRADE_COMPARE_AS(state.events, (std::vector<std::string>{
+        "PitBull unload", "HotDog unload", "Dog unload",
+        "Dog reload", "HotDog reload", "PitBull reload"
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(manager.loadState("Dog"), LoadState::Loaded);
+    CORRADE_COMPARE(manager.loadState("PitBull"), LoadState::Loaded);
+    CORRADE_COMPARE(foodManager.loadState("HotDog"), LoadState::Loaded);
+    CORRADE_COMPARE_AS(manager.metadata("Dog")->usedBy(), (std::vector<std::string>{"HotDog", "PitBull"}), TestSuite::Compare::Container);
+
+    /* The instance got recreated */
+    CORRADE_VERIFY(state.animal);
+    CORRADE_COMPARE(state.animal->name(), "Rodriguez");
+
+    /* Reloading a leaf plugin touches just that one, not its dependencies */
+    state.events.clear();
+    CORRADE_COMPARE(manager.reload("PitBull"), LoadState::Loaded);
+    CORRADE_COMPARE_AS(state.events, (std::vector<std::string>{
+        "PitBull unload", "PitBull reload"
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(state.animal->name(), "Rodriguez");
+
+    /* Destroy the instance before the manager */
+    state.animal = nullptr;
+}
+
+void ManagerTest::reloadNotLoaded() {
+    PluginManager::Manager<AbstractAnimal> manager;
+
+    ReloadState state;
+    manager.setReloadCallback(recordReload, &state);
+
+    CORRADE_COMPARE(manager.reload("Dog"), LoadState::NotLoaded);
+    CORRADE_COMPARE(manager.reload("Canary"), LoadState::Static);
+    CORRADE_COMPARE(manager.loadState("Dog"), LoadState::NotLoaded);
+    CORRADE_VERIFY(state.events.empty());
+}
+
+void ManagerTest::reloadNonexistent() {
+    PluginManager::Manager<AbstractAnimal> manager;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_COMPARE(manager.reload("Chihuahua"), LoadState::NotFound);
+    CORRADE_COMPARE(out.str(), "PluginManager::Manager::reload(): plugin Chihuahua was not found\n");
+}
+
+void ManagerTest::reloadUsed() {
+    PluginManager::Manager<AbstractAnimal> manager;
+
+    ReloadState state;
+    manager.setReloadCallback(recordReload, &state);
+
+    CORRADE_COMPARE(manager.load("PitBull"), LoadState::Loaded);
+    /* Not destroyed by the callback */
+    Containers::Pointer<AbstractAnimal> dog = manager.instantiate("Dog");
+
+    /* PitBull gets unloaded first, then Dog fails, PitBull gets loaded
+       back */
+    {
+        std::ostringstream out;
+        Error redirectError{&out};
+        CORRADE_COMPARE(manager.reload("Dog"), LoadState::Used);
+        CORRADE_COMPARE(out.str(), "PluginManager::Manager::unload(): plugin Dog is currently used and cannot be deleted\n");
+    }
+    CORRADE_COMPARE_AS(state.events, (std::vector<std::string>{
+        "PitBull unload", "Dog unload", "Dog reload", "PitBull reload"
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(manager.loadState("Dog"), LoadState::Loaded);
+    CORRADE_COMPARE(manager.loadState("PitBull"), LoadState::Loaded);
+    CORRADE_COMPARE(manager.metadata("Dog")->usedBy(), std::vector<std::string>{"PitBull"});
+    CORRADE_COMPARE(dog->name(), "Doug");
+}
+
+void ManagerTest::reloadChanged() {
+    /* Work on a copy of the plugin so it can be replaced */
+    const std::string path = Utility::Directory::join(PLUGINS_DIR, "reload");
+    const std::string filename = Utility::Directory::join(path, std::string{"Dog"} + PLUGIN_FILENAME_SUFFIX);
+    const std::string temporary = Utility::Directory::join(path, "Dog.tmp");
+    CORRADE_VERIFY(Utility::Directory::mkpath(path));
+    CORRADE_VERIFY(Utility::Directory::copy(DOG_PLUGIN_FILENAME, filename));
+    CORRADE_VERIFY(Utility::Directory::copy(Utility::Directory::join(Utility::Directory::path(DOG_PLUGIN_FILENAME), "Dog.conf"), Utility::Directory::join(path, "Dog.conf")));
+
+    PluginManager::Manager<AbstractAnimal> manager{"nonexistent"};
+    ReloadState state;
+    manager.setReloadCallback(recordReload, &state);
+
+    /* Nothing is watched yet, so nothing changed */
+    CORRADE_COMPARE(manager.load(filename), LoadState::Loaded);
+    CORRADE_COMPARE_AS(manager.reloadChanged(), std::vector<std::string>{}, TestSuite::Compare::Container);
+
+    /* Replace the binary the same way a linker would. Sleep so the
+       modification time is different. */
+    #if defined(CORRADE_TARGET_APPLE) || defined(CORRADE_TARGET_WINDOWS)
+    Utility::System::sleep(1100);
+    #else
+    Utility::System::sleep(10);
+    #endif
+    CORRADE_VERIFY(Utility::Directory::copy(DOG_PLUGIN_FILENAME, temporary));
+    CORRADE_VERIFY(Utility::Directory::move(temporary, filename));
+
+    CORRADE_COMPARE_AS(manager.reloadChanged(), std::vector<std::string>{"Dog"}, TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(state.events, (std::vector<std::string>{
+        "Dog unload", "Dog reload"
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(manager.loadState("Dog"), LoadState::Loaded);
+
+    Containers::Pointer<AbstractAnimal> animal = manager.instantiate("Dog");
+    CORRADE_VERIFY(animal);
+    CORRADE_COMPARE(animal->name(), "Doug");
+
+    /* Nothing changed since */
+    CORRADE_COMPARE_AS(manager.reloadChanged(), std::vector<std::string>{}, TestSuite::Compare::Container);
+}
+
 void ManagerTest::reloadPluginDirectory() {
     #ifdef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
     CORRADE_SKIP("Plugin directory is irrelevant for static plugins");
@@ -881,6 +1537,104 @@ void ManagerTest::restoreAliasesAfterPluginDirectoryChange() {
     #endif
 }
 
+void ManagerTest::loadStatisticsStatic() {
+    PluginManager::Manager<AbstractAnimal> manager;
+
+    /* Static plugins get their metadata parsed and initializer called on
+       manager construction */
+    const LoadStatistics* statistics = manager.loadStatistics("Canary");
+    CORRADE_VERIFY(statistics);
+    CORRADE_VERIFY(statistics->metadataDuration > 0);
+    CORRADE_COMPARE(statistics->openDuration, 0);
+    CORRADE_COMPARE(statistics->dependencyDuration, 0);
+    CORRADE_COMPARE(statistics->instantiationCount, 0);
+    CORRADE_COMPARE(statistics->instantiationDuration, 0);
+
+    Containers::Pointer<AbstractAnimal> animal = manager.instantiate("Canary");
+    Containers::Pointer<AbstractAnimal> animal2 = manager.instantiate("Canary");
+    CORRADE_COMPARE(statistics->instantiationCount, 2);
+    CORRADE_VERIFY(statistics->instantiationDuration > 0);
+}
+
+#ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+void ManagerTest::loadStatisticsDynamic() {
+    PluginManager::Manager<AbstractAnimal> manager;
+
+    /* Metadata are parsed for all plugins in the directory, nothing else is
+       done until load */
+    const LoadStatistics* dog = manager.loadStatistics("Dog");
+    const LoadStatistics* pitBull = manager.loadStatistics("PitBull");
+    CORRADE_VERIFY(dog);
+    CORRADE_VERIFY(pitBull);
+    CORRADE_VERIFY(dog->metadataDuration > 0);
+    CORRADE_COMPARE(dog->openDuration, 0);
+    CORRADE_COMPARE(dog->initializerDuration, 0);
+
+    /* Loading PitBull loads Dog as a dependency, which is accounted for in
+       both */
+    CORRADE_COMPARE(manager.load("PitBull"), LoadState::Loaded);
+    CORRADE_VERIFY(dog->openDuration > 0);
+    CORRADE_COMPARE(dog->dependencyDuration, 0);
+    CORRADE_VERIFY(pitBull->openDuration > 0);
+    CORRADE_VERIFY(pitBull->dependencyDuration >= dog->openDuration);
+
+    /* Querying by an alias gives the same */
+    CORRADE_COMPARE(manager.loadStatistics("AGoodBoy"), dog);
+
+    Containers::Pointer<AbstractAnimal> animal = manager.instantiate("PitBull");
+    CORRADE_COMPARE(pitBull->instantiationCount, 1);
+    CORRADE_COMPARE(dog->instantiationCount, 0);
+
+    /* Durations are accumulated over repeated loads */
+    animal = nullptr;
+    const std::uint64_t openDuration = pitBull->openDuration;
+    CORRADE_COMPARE(manager.unload("PitBull"), LoadState::NotLoaded);
+    CORRADE_COMPARE(manager.load("PitBull"), LoadState::Loaded);
+    CORRADE_VERIFY(pitBull->openDuration > openDuration);
+}
+
+void ManagerTest::loadStatisticsList() {
+    PluginManager::Manager<AbstractAnimal> manager;
+
+    /* Binaries opened in waves are accounted for as well */
+    CORRADE_COMPARE(manager.load({"PitBull", "Dog"}), (std::vector<LoadState>{LoadState::Loaded, LoadState::Loaded}));
+    CORRADE_VERIFY(manager.loadStatistics("Dog")->openDuration > 0);
+    CORRADE_VERIFY(manager.loadStatistics("PitBull")->openDuration > 0);
+    CORRADE_VERIFY(manager.loadStatistics("PitBull")->initializerDuration > 0);
+}
+#endif
+
+void ManagerTest::loadStatisticsNonexistent() {
+    PluginManager::Manager<AbstractAnimal> manager;
+    CORRADE_VERIFY(!manager.loadStatistics("Chihuahua"));
+}
+
+void ManagerTest::loadTrace() {
+    PluginManager::Manager<AbstractAnimal> manager;
+    Containers::Pointer<AbstractAnimal> canary = manager.instantiate("Canary");
+    Containers::Pointer<AbstractAnimal> canary2 = manager.instantiate("Canary");
+    #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+    CORRADE_COMPARE(manager.load("PitBull"), LoadState::Loaded);
+    #endif
+
+    const std::string trace = manager.loadTrace();
+    CORRADE_VERIFY(Utility::String::beginsWith(trace, "{\"traceEvents\":[\n{\"name\":"));
+    CORRADE_VERIFY(Utility::String::endsWith(trace, "}\n]}\n"));
+    CORRADE_VERIFY(trace.find("{\"name\":\"Canary\",\"cat\":\"metadata\",\"ph\":\"X\",\"ts\":") != std::string::npos);
+    CORRADE_VERIFY(trace.find("{\"name\":\"Canary\",\"cat\":\"initializer\",") != std::string::npos);
+
+    /* Only the first instantiation is recorded */
+    CORRADE_VERIFY(trace.find("{\"name\":\"Canary\",\"cat\":\"instantiation\",") != std::string::npos);
+    const std::size_t instantiation = trace.find("\"cat\":\"instantiation\"");
+    CORRADE_COMPARE(trace.find("\"cat\":\"instantiation\"", instantiation + 1), std::string::npos);
+
+    #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+    CORRADE_VERIFY(trace.find("{\"name\":\"PitBull\",\"cat\":\"dependencies\",") != std::string::npos);
+    CORRADE_VERIFY(trace.find("{\"name\":\"Dog\",\"cat\":\"open\",") != std::string::npos);
+    CORRADE_VERIFY(trace.find("{\"name\":\"PitBull\",\"cat\":\"initializer\",") != std::string::npos);
+    #endif
+}
+
 void ManagerTest::staticProvides() {
     PluginManager::Manager<AbstractAnimal> manager;
 
@@ -1033,6 +1787,29 @@ void ManagerTest::debugLoadStates() {
     CORRADE_COMPARE(out.str(), "PluginManager::LoadState::NotFound|PluginManager::LoadState::Static PluginManager::LoadStates{}\n");
 }
 
+#ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+void ManagerTest::debugLoadFlag() {
+    std::ostringstream out;
+
+    Debug{&out} << LoadFlag::Local << LoadFlag(0xf0);
+    CORRADE_COMPARE(out.str(), "PluginManager::LoadFlag::Local PluginManager::LoadFlag(0xf0)\n");
+}
+
+void ManagerTest::debugLoadFlags() {
+    std::ostringstream out;
+
+    Debug{&out} << (LoadFlag::Lazy|LoadFlag::Local) << LoadFlags{};
+    CORRADE_COMPARE(out.str(), "PluginManager::LoadFlag::Lazy|PluginManager::LoadFlag::Local PluginManager::LoadFlags{}\n");
+}
+
+void ManagerTest::debugReloadEvent() {
+    std::ostringstream out;
+
+    Debug{&out} << ReloadEvent::Reload << ReloadEvent(0xf0);
+    CORRADE_COMPARE(out.str(), "PluginManager::ReloadEvent::Reload PluginManager::ReloadEvent(0xf0)\n");
+}
+#endif
+
 #ifndef CORRADE_TARGET_EMSCRIPTEN
 void ManagerTest::multithreadedStatic() {
     #ifndef CORRADE_BUILD_MULTITHREADED
@@ -1115,6 +1892,56 @@ void ManagerTest::multithreadedDynamic() {
 #endif
 #endif
 
+void ManagerTest::benchmarkLoadUnloadStatic() {
+    PluginManager::Manager<AbstractAnimal> manager;
+
+    int result = 0;
+    CORRADE_BENCHMARK(100) {
+        result += int(manager.load("Canary") == LoadState::Static);
+        result += int(manager.unload("Canary") == LoadState::Static);
+    }
+
+    CORRADE_COMPARE(result, 200);
+}
+
+void ManagerTest::benchmarkInstantiateStatic() {
+    PluginManager::Manager<AbstractAnimal> manager;
+    CORRADE_COMPARE(manager.load("Canary"), LoadState::Static);
+
+    int legCount = 0;
+    CORRADE_BENCHMARK(100)
+        legCount += manager.instantiate("Canary")->legCount();
+
+    CORRADE_COMPARE(legCount, 200);
+}
+
+#ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+void ManagerTest::benchmarkLoadUnloadDynamic() {
+    PluginManager::Manager<AbstractAnimal> manager;
+
+    /* Includes the dlopen() and dlclose() calls, so this is mostly measuring
+       the system dynamic linker */
+    int result = 0;
+    CORRADE_BENCHMARK(10) {
+        result += int(manager.load("Dog") == LoadState::Loaded);
+        result += int(manager.unload("Dog") == LoadState::NotLoaded);
+    }
+
+    CORRADE_COMPARE(result, 20);
+}
+
+void ManagerTest::benchmarkInstantiateDynamic() {
+    PluginManager::Manager<AbstractAnimal> manager;
+    CORRADE_COMPARE(manager.load("Dog"), LoadState::Loaded);
+
+    int legCount = 0;
+    CORRADE_BENCHMARK(100)
+        legCount += manager.instantiate("Dog")->legCount();
+
+    CORRADE_COMPARE(legCount, 400);
+}
+#endif
+
 }}}}
 
 CORRADE_TEST_MAIN(Corrade::PluginManager::Test::ManagerTest)
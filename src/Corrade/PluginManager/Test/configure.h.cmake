@@ -24,6 +24,7 @@
 */
 
 #cmakedefine PLUGINS_DIR "${PLUGINS_DIR}"
+#cmakedefine BULLDOG_PLUGIN_FILENAME "${BULLDOG_PLUGIN_FILENAME}"
 #cmakedefine DOG_PLUGIN_FILENAME "${DOG_PLUGIN_FILENAME}"
 #cmakedefine DOGGO_PLUGIN_FILENAME "${DOGGO_PLUGIN_FILENAME}"
 #cmakedefine PITBULL_PLUGIN_FILENAME "${PITBULL_PLUGIN_FILENAME}"
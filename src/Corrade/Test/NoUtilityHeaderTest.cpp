@@ -0,0 +1,57 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* A compile-only test verifying that the core container and debug headers
+   don't drag in the heavy <utility> header. Can't use TestSuite::Tester here
+   as that one includes <utility> on its own, so the check is done with the
+   preprocessor and a failure means a build error. */
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Containers/ArrayView.h"
+#include "Corrade/Containers/Optional.h"
+#include "Corrade/Containers/Pointer.h"
+#include "Corrade/Containers/StaticArray.h"
+#include "Corrade/Containers/StridedArrayView.h"
+#include "Corrade/Containers/String.h"
+#include "Corrade/Containers/StringView.h"
+#include "Corrade/Utility/Debug.h"
+#include "Corrade/Utility/Move.h"
+
+#if defined(_GLIBCXX_UTILITY) || defined(_LIBCPP_UTILITY) || defined(_UTILITY_)
+#error the core headers should not include <utility>
+#endif
+
+namespace Corrade { namespace Test { namespace {
+
+/* Just to have something to compile and to check the replacements work */
+CORRADE_UNUSED int noUtilityHeaderTest() {
+    Containers::Array<int> a{3};
+    Containers::Array<int> b = Utility::move(a);
+    Containers::Optional<int> c = 5;
+    Utility::swap(a, b);
+    return int(a.size()) + *c;
+}
+
+}}}
@@ -3,13 +3,34 @@ set -e
 
 # Usage:
 #  ./AdbRunner.sh /path/to/test/binary/dir executable-name-and-args additional files...
-binary_dir=$1
-filename_and_args=$2
-filename=${filename_and_args%% *}
-# So the additional files are available in $@
-shift && shift
+#  ./AdbRunner.sh --batch /path/to/manifest/dir [jobs]
+#
+# The first form runs a single test, as done by CTest. The second form runs
+# all tests described by manifest files generated by corrade_add_test() in
+# given directory at once, pushing everything in a single sync per device,
+# running given number of tests concurrently on each device (4 by default) and
+# pulling the results back in a single step.
+batch=
+if [ "$1" = "--batch" ]; then
+    batch=1
+    manifest_dir=$2
+    jobs=${3:-4}
+else
+    binary_dir=$1
+    filename_and_args=$2
+    filename=${filename_and_args%% *}
+    # So the additional files are available in $@
+    shift && shift
+fi
 
-if [ "$(adb get-state | tr -d '\r\n')" != "device" ]; then
+# Use all connected devices / emulators, or just the one specified in
+# ANDROID_SERIAL, which adb itself uses to choose a device as well
+if [ ! -z "$ANDROID_SERIAL" ]; then
+    devices=($ANDROID_SERIAL)
+else
+    devices=($(adb devices | sed -n 's/^\([^[:space:]]*\)[[:space:]]*device$/\1/p'))
+fi
+if [ ${#devices[@]} -eq 0 ] || [ "$(ANDROID_SERIAL=${devices[0]} adb get-state | tr -d '\r\n')" != "device" ]; then
     echo "ERROR: no device connected"
     exit 1
 fi
@@ -79,6 +100,36 @@ if [ ! -z ${MAGNUM_LOG+x} ]; then
     test_env="$test_env MAGNUM_LOG=$MAGNUM_LOG"
 fi
 
+# Copy given executable and files, specified as input@output pairs, to a
+# local staging directory, preserving directory structure, so they can be then
+# pushed in a single adb invocation instead of one round-trip per file
+stage() {
+    local target=$1
+    local executable=$2
+    shift && shift
+    mkdir -p "$target"
+    cp "$executable" "$target/"
+    for file in "$@"; do
+        # TODO: this will probably break horribly when the filenames contain
+        # spaces and/or multiple @ characters (only the last should be
+        # taken). Sorry about that, if you fix it and provide a patch, I'll be
+        # *very* happy.
+        file_pair=(${file//@/ })
+        mkdir -p "$target/$(dirname ${file_pair[1]})"
+        cp -R "${file_pair[0]}" "$target/${file_pair[1]}"
+    done
+}
+
+if [ -z "$batch" ]; then
+
+# With multiple devices connected, spread the tests across them. CTest runs
+# each test in a separate process, so the device is chosen based on a hash of
+# the executable name to not need any shared state.
+if [ ${#devices[@]} -gt 1 ]; then
+    hash=$(echo "$filename" | cksum | cut -d' ' -f1)
+    export ANDROID_SERIAL=${devices[$((hash % ${#devices[@]}))]}
+fi
+
 # Create a local temporary directory. Android doesn't have mktemp, so we have
 # to assume that there is ever only one computer connected to a device /
 # emulator and so mktemp always returns unique value.
@@ -91,17 +142,9 @@ remote_tmpdir=/data/local$tmpdir
 adb shell 'rm -rf '$remote_tmpdir'; mkdir '$remote_tmpdir
 
 # Push the test executable and also all required files to the remote temporary
-# directory, preserving directory structure
-adb push "$binary_dir/$filename" $remote_tmpdir | tail -n 1
-for file in "$@"; do
-    # TODO: this will probably break horribly when the filenames contain spaces
-    # and/or multiple @ characters (only the last should be taken). Sorry about
-    # that, if you fix it and provide a patch, I'll be *very* happy.
-    file_pair=(${file//@/ })
-    dir=$(dirname ${file_pair[1]})
-    adb shell "mkdir -p $remote_tmpdir/$dir"
-    adb push "${file_pair[0]}" "$remote_tmpdir/${file_pair[1]}" | tail -n 1
-done
+# directory in one go
+stage $tmpdir/push "$binary_dir/$filename" "$@"
+adb push $tmpdir/push/. $remote_tmpdir | tail -n 1
 
 # No comment. http://web.archive.org/web/20160806094132/https://code.google.com/p/android/issues/detail?id=3254
 adb shell 'cd '$remote_tmpdir' && '$test_env' ./'$filename_and_args' 2>&1; echo -n ADB_IS_SHIT:$?' | tee $tmpdir/adb.retval | grep -v ADB_IS_SHIT
@@ -117,3 +160,98 @@ rm -r $tmpdir
 
 # Propagate the return code
 exit $returncode
+
+fi
+
+# Batch mode. Each manifest file contains the binary directory on the first
+# line, the executable name and arguments on the second line and the
+# input@output file pairs on the remaining lines.
+tmpdir=$(mktemp -d /tmp/corrade-testsuite-batch-XXXXX)
+remote_tmpdir=/data/local$tmpdir
+
+# Stage the tests, distributing them round-robin across the devices and then
+# across the concurrently running jobs on each device. Each job is a sequence
+# of tests run one after another, recording the output and the return code
+# into a results directory that gets pulled back at the end.
+tests=()
+for manifest in "$manifest_dir"/*.txt; do
+    test_name=$(basename "$manifest" .txt)
+    i=${#tests[@]}
+    tests+=($test_name)
+    device=$((i % ${#devices[@]}))
+    job=$((i / ${#devices[@]} % jobs))
+
+    files=()
+    line=0
+    while IFS= read -r entry || [ -n "$entry" ]; do
+        if [ $line -eq 0 ]; then
+            test_binary_dir=$entry
+        elif [ $line -eq 1 ]; then
+            test_filename_and_args=$entry
+        elif [ ! -z "$entry" ]; then
+            files+=("$entry")
+        fi
+        line=$((line + 1))
+    done < "$manifest"
+    test_filename=${test_filename_and_args%% *}
+
+    stage "$tmpdir/device-$device/$test_name" "$test_binary_dir/$test_filename" "${files[@]}"
+    echo $test_name >> "$tmpdir/tests-$device"
+    echo "cd $remote_tmpdir/$test_name && $test_env ./$test_filename_and_args > $remote_tmpdir/results/$test_name.log 2>&1; echo \$? > $remote_tmpdir/results/$test_name.retval" >> "$tmpdir/device-$device/job-$job.sh"
+done
+
+if [ ${#tests[@]} -eq 0 ]; then
+    echo "ERROR: no test manifests found in $manifest_dir"
+    rm -r $tmpdir
+    exit 1
+fi
+
+# Push, run all jobs in parallel and pull the results, for all devices in
+# parallel as well. The same cleanup logic as above applies here, the remote
+# directory is kept only if some test on given device failed.
+for device in $(seq 0 $((${#devices[@]} - 1))); do
+    [ -d "$tmpdir/device-$device" ] || continue
+    (
+        export ANDROID_SERIAL=${devices[$device]}
+        run="mkdir -p $remote_tmpdir/results;"
+        for job in "$tmpdir/device-$device"/job-*.sh; do
+            run="$run sh $remote_tmpdir/$(basename $job) &"
+        done
+        run="$run wait"
+
+        adb shell 'rm -rf '$remote_tmpdir'; mkdir '$remote_tmpdir
+        adb push "$tmpdir/device-$device/." $remote_tmpdir | tail -n 1
+        adb shell "$run"
+        adb pull $remote_tmpdir/results "$tmpdir/results-$device" | tail -n 1
+        passed=1
+        for test_name in $(cat "$tmpdir/tests-$device"); do
+            if [ "$(cat "$tmpdir/results-$device/$test_name.retval" 2>/dev/null | tr -d '\r\n')" != "0" ]; then
+                passed=
+            fi
+        done
+        if [ ! -z "$passed" ]; then
+            adb shell 'rm -r '$remote_tmpdir
+        fi
+    ) &
+done
+wait
+
+# Print the output in the order the tests were found and summarize
+failed=()
+for test_name in "${tests[@]}"; do
+    log=$(ls "$tmpdir"/results-*/$test_name.log 2>/dev/null | head -n 1)
+    retval=$(cat "${log%.log}.retval" 2>/dev/null | tr -d '\r\n')
+    [ -z "$log" ] || cat "$log"
+    if [ "$retval" != "0" ]; then
+        failed+=($test_name)
+    fi
+done
+rm -r $tmpdir
+
+echo
+if [ ${#failed[@]} -eq 0 ]; then
+    echo "All ${#tests[@]} tests passed."
+else
+    echo "${#failed[@]} out of ${#tests[@]} tests failed: ${failed[*]}"
+    exit 1
+fi
@@ -0,0 +1,148 @@
+#ifndef Corrade_TestSuite_AllocationCounter_h
+#define Corrade_TestSuite_AllocationCounter_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Allocation counting for @ref Corrade::TestSuite::Tester::BenchmarkType::AllocationCount "Tester::BenchmarkType::AllocationCount" and @ref Corrade::TestSuite::Tester::BenchmarkType::AllocatedBytes "AllocatedBytes" benchmarks
+ * @m_since_latest
+ *
+ * Replaces the global allocation functions in order to count allocations
+ * done inside @ref CORRADE_BENCHMARK() loops. Because the replacement
+ * consists of non-inline definitions, this file has to be included in
+ * *exactly one* source file of a test executable, usually the one containing
+ * @ref CORRADE_TEST_MAIN():
+ *
+ * @snippet testsuite-allocation-counter.cpp 0
+ *
+ * When compiled against glibc, @cpp std::malloc() @ce, @cpp std::calloc() @ce
+ * and @cpp std::realloc() @ce are replaced, which catches also all
+ * @cpp new @ce allocations as these go through @cpp std::malloc() @ce. On
+ * other platforms only the non-aligned variants of @cpp operator new @ce and
+ * @cpp operator new[] @ce are replaced. Aligned allocations are not counted
+ * anywhere. Allocations from all threads are counted.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "Corrade/TestSuite/Tester.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+namespace Corrade { namespace TestSuite { namespace Implementation { namespace {
+
+/* Zero-initialized before any dynamic initialization happens, which is
+   important as allocations can happen before main() */
+std::atomic<bool> allocationCounterEnabled;
+std::atomic<std::uint64_t> allocationCount;
+std::atomic<std::uint64_t> allocatedBytes;
+
+inline void countAllocation(const std::size_t size) {
+    if(!allocationCounterEnabled.load(std::memory_order_relaxed)) return;
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+void allocationCounterBegin() {
+    allocationCount.store(0, std::memory_order_relaxed);
+    allocatedBytes.store(0, std::memory_order_relaxed);
+    allocationCounterEnabled.store(true, std::memory_order_relaxed);
+}
+
+void allocationCounterEnd(std::uint64_t& count, std::uint64_t& bytes) {
+    allocationCounterEnabled.store(false, std::memory_order_relaxed);
+    count = allocationCount.load(std::memory_order_relaxed);
+    bytes = allocatedBytes.load(std::memory_order_relaxed);
+}
+
+int allocationCounterInitializer() {
+    registerAllocationCounter(allocationCounterBegin, allocationCounterEnd);
+    return 1;
+}
+
+CORRADE_AUTOMATIC_INITIALIZER(allocationCounterInitializer)
+
+}}}}
+
+#ifdef __GLIBC__
+/* The executable interposes the allocation functions of libc, forwarding to
+   the glibc-specific aliases of the originals */
+extern "C" {
+    void* __libc_malloc(std::size_t);
+    void* __libc_calloc(std::size_t, std::size_t);
+    void* __libc_realloc(void*, std::size_t);
+
+    void* malloc(std::size_t size) noexcept {
+        Corrade::TestSuite::Implementation::countAllocation(size);
+        return __libc_malloc(size);
+    }
+
+    void* calloc(std::size_t count, std::size_t size) noexcept {
+        Corrade::TestSuite::Implementation::countAllocation(count*size);
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* pointer, std::size_t size) noexcept {
+        Corrade::TestSuite::Implementation::countAllocation(size);
+        return __libc_realloc(pointer, size);
+    }
+}
+#else
+void* operator new(std::size_t size) {
+    Corrade::TestSuite::Implementation::countAllocation(size);
+    if(void* const pointer = std::malloc(size ? size : 1)) return pointer;
+    throw std::bad_alloc{};
+}
+
+void* operator new[](std::size_t size) {
+    Corrade::TestSuite::Implementation::countAllocation(size);
+    if(void* const pointer = std::malloc(size ? size : 1)) return pointer;
+    throw std::bad_alloc{};
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    Corrade::TestSuite::Implementation::countAllocation(size);
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    Corrade::TestSuite::Implementation::countAllocation(size);
+    return std::malloc(size ? size : 1);
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+#ifdef __cpp_sized_deallocation
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { std::free(pointer); }
+#endif
+#endif
+#endif
+
+#endif
@@ -29,6 +29,9 @@
  * @brief Class @ref Corrade::TestSuite::Compare::Container
  */
 
+#include <cstring>
+#include <type_traits>
+
 #include "Corrade/TestSuite/Comparator.h"
 
 namespace Corrade { namespace TestSuite {
@@ -50,7 +53,12 @@ It is also possible to sort the containers before comparison using
 
 Comparison of containers of floating-point types is by default done as a
 fuzzy-compare, see @ref Comparator<float> and @ref Comparator<double> for
-details.
+details. Contiguous containers of integer, enum and pointer types, such as
+@ref std::vector<int> or @ref Containers::ArrayView<const char>, are compared
+using a single @cpp std::memcmp() @ce and the elements are compared one by one
+only to find the first difference. Contents of containers with more than 256
+elements are not printed in the failure message, only the first different
+item is.
 
 See @ref TestSuite-Comparator-pseudo-types for more information.
 */
@@ -61,6 +69,45 @@ template<class> class Container {};
 namespace Implementation {
     /* Copied from Magnum/Math/Vector.h, to avoid #include <algorithm> */
     inline std::size_t max(std::size_t a, std::size_t b) { return a < b ? b : a; }
+    inline std::size_t min(std::size_t a, std::size_t b) { return a < b ? a : b; }
+
+    /* Containers larger than this don't have their contents printed */
+    enum: std::size_t { ContainerPrintLimit = 256 };
+
+    /* Whether the container has its elements stored contiguously and they can
+       be compared bitwise. Floating-point types are compared with an epsilon
+       and types with user-defined comparison may have padding or multiple
+       representations of the same value, so only integers, enums and
+       pointers qualify. */
+    template<class T, class = void> struct ContainerMemoryComparable: std::false_type {};
+    template<class T> struct ContainerMemoryComparable<T, typename std::enable_if<std::is_same<
+        typename std::remove_cv<typename std::remove_reference<decltype(*std::declval<const T&>().data())>::type>::type,
+        typename std::decay<decltype(std::declval<const T&>()[0])>::type>::value>::type>: std::integral_constant<bool,
+            std::is_integral<typename std::decay<decltype(std::declval<const T&>()[0])>::type>::value ||
+            std::is_enum<typename std::decay<decltype(std::declval<const T&>()[0])>::type>::value ||
+            std::is_pointer<typename std::decay<decltype(std::declval<const T&>()[0])>::type>::value> {};
+
+    /* Index of the first different item in the common prefix or its size if
+       there's none */
+    template<class T> std::size_t containerFirstDifferent(const T& actual, const T& expected, std::true_type) {
+        const std::size_t size = min(actual.size(), expected.size());
+        if(!size || std::memcmp(actual.data(), expected.data(), size*sizeof(*actual.data())) == 0)
+            return size;
+
+        for(std::size_t i = 0; i != size; ++i)
+            if(actual.data()[i] != expected.data()[i]) return i;
+
+        CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    }
+    template<class T> std::size_t containerFirstDifferent(const T& actual, const T& expected, std::false_type) {
+        /* Recursively use comparator on the values */
+        Comparator<typename std::decay<decltype(actual[0])>::type> comparator;
+        const std::size_t size = min(actual.size(), expected.size());
+        for(std::size_t i = 0; i != size; ++i)
+            if(comparator(actual[i], expected[i]) & ComparisonStatusFlag::Failed)
+                return i;
+        return size;
+    }
 }
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
@@ -73,48 +120,48 @@ template<class T> class Comparator<Compare::Container<T>> {
     private:
         const T* _actualContents;
         const T* _expectedContents;
+        std::size_t _firstDifferent;
 };
 
 template<class T> ComparisonStatusFlags Comparator<Compare::Container<T>>::operator()(const T& actual, const T& expected) {
     _actualContents = &actual;
     _expectedContents = &expected;
+    _firstDifferent = Implementation::containerFirstDifferent(actual, expected, Implementation::ContainerMemoryComparable<T>{});
 
-    if(_actualContents->size() != _expectedContents->size())
+    if(_actualContents->size() != _expectedContents->size() || _firstDifferent != _actualContents->size())
         return ComparisonStatusFlag::Failed;
 
-    /* Recursively use comparator on the values */
-    Comparator<typename std::decay<decltype((*_actualContents)[0])>::type> comparator;
-    for(std::size_t i = 0; i != _actualContents->size(); ++i)
-        if(comparator((*_actualContents)[i], (*_expectedContents)[i]) & ComparisonStatusFlag::Failed)
-            return ComparisonStatusFlag::Failed;
-
     return {};
 }
 
 template<class T> void Comparator<Compare::Container<T>>::printMessage(ComparisonStatusFlags, Utility::Debug& out, const char* actual, const char* expected) const {
+    const bool printContents = Implementation::max(_actualContents->size(), _expectedContents->size()) <= Implementation::ContainerPrintLimit;
+
     out << "Containers" << actual << "and" << expected << "have different";
-    if(_actualContents->size() != _expectedContents->size())
-        out << "size, actual" << _actualContents->size() << "but" << _expectedContents->size() << "expected. Actual contents:\n       ";
-    else
+    if(_actualContents->size() != _expectedContents->size()) {
+        out << "size, actual" << _actualContents->size() << "but" << _expectedContents->size() << "expected.";
+        if(printContents) out << "Actual contents:\n       ";
+    } else if(printContents)
         out << "contents, actual:\n       ";
+    else
+        out << "contents.";
 
-    out << *_actualContents << Utility::Debug::newline << "        but expected\n       " << *_expectedContents << Utility::Debug::newline << "       ";
+    if(printContents)
+        out << *_actualContents << Utility::Debug::newline << "        but expected\n       " << *_expectedContents;
 
-    Comparator<typename std::decay<decltype((*_actualContents)[0])>::type> comparator;
-    for(std::size_t i = 0, end = Implementation::max(_actualContents->size(), _expectedContents->size()); i != end; ++i) {
-        if(_actualContents->size() > i && _expectedContents->size() > i &&
-            !(comparator((*_actualContents)[i], (*_expectedContents)[i]) & ComparisonStatusFlag::Failed)) continue;
+    out << Utility::Debug::newline << "       ";
 
-        if(_actualContents->size() <= i)
-            out << "Expected has" << (*_expectedContents)[i];
-        else if(_expectedContents->size() <= i)
-            out << "Actual has" << (*_actualContents)[i];
-        else
-            out << "Actual" << (*_actualContents)[i] << "but" << (*_expectedContents)[i] << "expected";
+    /* The first difference is either in the common prefix or right after
+       it, in the larger container */
+    const std::size_t i = _firstDifferent;
+    if(_actualContents->size() <= i)
+        out << "Expected has" << (*_expectedContents)[i];
+    else if(_expectedContents->size() <= i)
+        out << "Actual has" << (*_actualContents)[i];
+    else
+        out << "Actual" << (*_actualContents)[i] << "but" << (*_expectedContents)[i] << "expected";
 
-        out << "on position" << i << Utility::Debug::nospace << ".";
-        break;
-    }
+    out << "on position" << i << Utility::Debug::nospace << ".";
 }
 #endif
 
@@ -25,42 +25,48 @@
 
 #include "File.h"
 
-#include <cstddef>
 #include <utility>
-#ifdef _MSC_VER
-#include <algorithm> /* std::max() */
-#endif
 
 #include "Corrade/TestSuite/Comparator.h"
+#include "Corrade/TestSuite/Implementation/FileContents.h"
 #include "Corrade/Utility/DebugStl.h"
 #include "Corrade/Utility/Directory.h"
 
 namespace Corrade { namespace TestSuite {
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
-Comparator<Compare::File>::Comparator(std::string pathPrefix): _actualState{State::ReadError}, _expectedState{State::ReadError}, _pathPrefix{std::move(pathPrefix)} {}
+Comparator<Compare::File>::Comparator(std::string pathPrefix): _actualState{State::ReadError}, _expectedState{State::ReadError}, _pathPrefix{std::move(pathPrefix)}, _firstDifference{} {}
+
+Comparator<Compare::File>::~Comparator() = default;
 
 ComparisonStatusFlags Comparator<Compare::File>::operator()(const std::string& actualFilename, const std::string& expectedFilename) {
     _actualFilename = Utility::Directory::join(_pathPrefix, actualFilename);
     _expectedFilename = Utility::Directory::join(_pathPrefix, expectedFilename);
+    _actualState = _expectedState = State::ReadError;
 
     if(!Utility::Directory::exists(_actualFilename))
         return ComparisonStatusFlag::Failed;
 
+    /* Open the actual file before the expected so if the expected file can't
+       be read, we can still save actual file contents */
+    _actualContents.emplace();
+    if(!_actualContents->open(_actualFilename))
+        return ComparisonStatusFlag::Failed;
     _actualState = State::Success;
 
-    /* Read the actual file contents before the expected so if the expected
-       file can't be read, we can still save actual file contents */
-    _actualContents = Utility::Directory::readString(_actualFilename);
-
     /* If this fails, we already have the actual contents so we can save them */
     if(!Utility::Directory::exists(_expectedFilename))
         return ComparisonStatusFlag::Diagnostic|ComparisonStatusFlag::Failed;
 
-    _expectedContents = Utility::Directory::readString(_expectedFilename);
+    _expectedContents.emplace();
+    if(!_expectedContents->open(_expectedFilename))
+        return ComparisonStatusFlag::Diagnostic|ComparisonStatusFlag::Failed;
     _expectedState = State::Success;
 
-    return _actualContents == _expectedContents ? ComparisonStatusFlags{} :
+    const Containers::ArrayView<const char> actualData = _actualContents->data();
+    const Containers::ArrayView<const char> expectedData = _expectedContents->data();
+    _firstDifference = Implementation::firstDifference(actualData, expectedData);
+    return actualData.size() == expectedData.size() && _firstDifference == actualData.size() ? ComparisonStatusFlags{} :
         ComparisonStatusFlag::Diagnostic|ComparisonStatusFlag::Failed;
 }
 
@@ -75,31 +81,15 @@ void Comparator<Compare::File>::printMessage(ComparisonStatusFlags, Utility::Deb
         return;
     }
 
-    out << "Files" << actual << "and" << expected << "have different";
-    if(_actualContents.size() != _expectedContents.size())
-        out << "size, actual" << _actualContents.size() << "but" << _expectedContents.size() << "expected.";
-    else
-        out << "contents.";
-
-    for(std::size_t i = 0, end = std::max(_actualContents.size(), _expectedContents.size()); i != end; ++i) {
-        if(_actualContents.size() > i && _expectedContents.size() > i && _actualContents[i] == _expectedContents[i]) continue;
-
-        /** @todo do this without std::string */
-        if(_actualContents.size() <= i)
-            out << "Expected has character" << std::string() + _expectedContents[i];
-        else if(_expectedContents.size() <= i)
-            out << "Actual has character" << std::string() + _actualContents[i];
-        else
-            out << "Actual character" << std::string() + _actualContents[i] << "but" << std::string() + _expectedContents[i] << "expected";
-
-        out << "on position" << i << Utility::Debug::nospace << ".";
-        break;
-    }
+    Implementation::printFileDifference(out, actual, expected, _actualContents->data(), _expectedContents->data(), _firstDifference);
 }
 
 void Comparator<Compare::File>::saveDiagnostic(ComparisonStatusFlags, Utility::Debug& out, const std::string& path) {
+    /* Writing the already mapped contents instead of copying the file. The
+       write is atomic so it's fine even if the destination is the actual
+       file itself, which is mapped. */
     std::string filename = Utility::Directory::join(path, Utility::Directory::filename(_expectedFilename));
-    if(Utility::Directory::writeString(filename, _actualContents))
+    if(Utility::Directory::write(filename, _actualContents->data(), Utility::Directory::WriteFlag::Atomic))
         out << "->" << filename;
 }
 #endif
@@ -109,7 +99,7 @@ namespace Compare {
 File::File(const std::string& pathPrefix): _c{pathPrefix} {}
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
-Comparator<File> File::comparator() { return _c; }
+Comparator<File>& File::comparator() { return _c; }
 #endif
 
 }
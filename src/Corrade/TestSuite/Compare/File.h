@@ -31,12 +31,15 @@
 
 #include <string>
 
+#include "Corrade/Containers/Pointer.h"
 #include "Corrade/TestSuite/TestSuite.h"
 #include "Corrade/TestSuite/visibility.h"
 #include "Corrade/Utility/Utility.h"
 
 namespace Corrade { namespace TestSuite {
 
+namespace Implementation { class FileContents; }
+
 namespace Compare { class File; }
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
@@ -44,6 +47,8 @@ template<> class CORRADE_TESTSUITE_EXPORT Comparator<Compare::File> {
     public:
         explicit Comparator(std::string pathPrefix = {});
 
+        ~Comparator();
+
         ComparisonStatusFlags operator()(const std::string& actualFilename, const std::string& expectedFilename);
 
         void printMessage(ComparisonStatusFlags flags, Utility::Debug& out, const char* actual, const char* expected) const;
@@ -57,8 +62,10 @@ template<> class CORRADE_TESTSUITE_EXPORT Comparator<Compare::File> {
         };
 
         State _actualState, _expectedState;
-        std::string _pathPrefix, _actualFilename, _expectedFilename,
-            _actualContents, _expectedContents;
+        std::string _pathPrefix, _actualFilename, _expectedFilename;
+        Containers::Pointer<Implementation::FileContents> _actualContents,
+            _expectedContents;
+        std::size_t _firstDifference;
 };
 #endif
 
@@ -69,7 +76,9 @@ namespace Compare {
 
 Prints the length of both files (if they are different) and prints the value
 and position of the first different character in both files. Filenames are
-expected to be in UTF-8. Example usage:
+expected to be in UTF-8. The files are memory-mapped where the platform
+supports it instead of being read into memory, so comparing even very large
+files is cheap. Example usage:
 
 @snippet TestSuite.cpp Compare-File
 
@@ -104,7 +113,7 @@ class CORRADE_TESTSUITE_EXPORT File {
         explicit File(const std::string& pathPrefix = {});
 
         #ifndef DOXYGEN_GENERATING_OUTPUT
-        Comparator<Compare::File> comparator();
+        Comparator<Compare::File>& comparator();
         #endif
 
     private:
@@ -25,30 +25,33 @@
 
 #include "FileToString.h"
 
-#include <cstddef>
-#ifdef _MSC_VER
-#include <algorithm> /* std::max() */
-#endif
-
 #include "Corrade/TestSuite/Comparator.h"
+#include "Corrade/TestSuite/Implementation/FileContents.h"
 #include "Corrade/Utility/DebugStl.h"
 #include "Corrade/Utility/Directory.h"
 
 namespace Corrade { namespace TestSuite {
 
-Comparator<Compare::FileToString>::Comparator(): _state(State::ReadError) {}
+Comparator<Compare::FileToString>::Comparator(): _state(State::ReadError), _firstDifference{} {}
+
+Comparator<Compare::FileToString>::~Comparator() = default;
 
 ComparisonStatusFlags Comparator<Compare::FileToString>::operator()(const std::string& filename, const std::string& expectedContents) {
     _filename = filename;
+    _state = State::ReadError;
 
     if(!Utility::Directory::exists(filename))
         return ComparisonStatusFlag::Failed;
 
-    _actualContents = Utility::Directory::readString(filename);
+    _actualContents.emplace();
+    if(!_actualContents->open(filename))
+        return ComparisonStatusFlag::Failed;
     _expectedContents = expectedContents;
     _state = State::Success;
 
-    return _actualContents == expectedContents ? ComparisonStatusFlags{} :
+    const Containers::ArrayView<const char> actualData = _actualContents->data();
+    _firstDifference = Implementation::firstDifference(actualData, {_expectedContents.data(), _expectedContents.size()});
+    return actualData.size() == _expectedContents.size() && _firstDifference == actualData.size() ? ComparisonStatusFlags{} :
         ComparisonStatusFlag::Failed;
 }
 
@@ -58,27 +61,7 @@ void Comparator<Compare::FileToString>::printMessage(ComparisonStatusFlags, Util
         return;
     }
 
-    out << "Files" << actual << "and" << expected << "have different";
-    if(_actualContents.size() != _expectedContents.size())
-        out << "size, actual" << _actualContents.size() << "but" << _expectedContents.size() << "expected.";
-    else
-        out << "contents.";
-
-    for(std::size_t i = 0, end = std::max(_actualContents.size(), _expectedContents.size()); i != end; ++i) {
-        if(_actualContents.size() > i && _expectedContents.size() > i && _actualContents[i] == _expectedContents[i]) continue;
-
-        /** @todo do this without std::string */
-        if(_actualContents.size() <= i)
-            out << "Expected has character" << std::string() + _expectedContents[i];
-        else if(_expectedContents.size() <= i)
-            out << "Actual has character" << std::string() + _actualContents[i];
-        else
-            out << "Actual character" << std::string() + _actualContents[i] << "but" << std::string() + _expectedContents[i] << "expected";
-
-        out << "on position" << i << Utility::Debug::nospace << ".";
-        break;
-    }
-
+    Implementation::printFileDifference(out, actual, expected, _actualContents->data(), {_expectedContents.data(), _expectedContents.size()}, _firstDifference);
 }
 
 }}
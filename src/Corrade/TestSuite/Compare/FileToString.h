@@ -31,12 +31,15 @@
 
 #include <string>
 
+#include "Corrade/Containers/Pointer.h"
 #include "Corrade/TestSuite/TestSuite.h"
 #include "Corrade/TestSuite/visibility.h"
 #include "Corrade/Utility/Utility.h"
 
 namespace Corrade { namespace TestSuite {
 
+namespace Implementation { class FileContents; }
+
 namespace Compare {
 
 /**
@@ -44,7 +47,8 @@ namespace Compare {
 
 Prints the length of both files (if they are different) and prints the value
 and position of the first different character in both files. Filename is
-expected to be in UTF-8. Example usage:
+expected to be in UTF-8. The file is memory-mapped where the platform supports
+it instead of being read into memory. Example usage:
 
 @snippet TestSuite.cpp Compare-FileToString
 
@@ -66,6 +70,8 @@ template<> class CORRADE_TESTSUITE_EXPORT Comparator<Compare::FileToString> {
     public:
         Comparator();
 
+        ~Comparator();
+
         ComparisonStatusFlags operator()(const std::string& filename, const std::string& expectedContents);
 
         void printMessage(ComparisonStatusFlags flags, Utility::Debug& out, const char* actual, const char* expected) const;
@@ -77,8 +83,9 @@ template<> class CORRADE_TESTSUITE_EXPORT Comparator<Compare::FileToString> {
         };
 
         State _state;
-        std::string _filename,
-            _actualContents, _expectedContents;
+        std::string _filename, _expectedContents;
+        Containers::Pointer<Implementation::FileContents> _actualContents;
+        std::size_t _firstDifference;
 };
 #endif
 
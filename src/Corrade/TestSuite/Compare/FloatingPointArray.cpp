@@ -0,0 +1,189 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FloatingPointArray.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "Corrade/TestSuite/Comparator.h"
+#include "Corrade/Utility/Debug.h"
+#include "Corrade/Utility/StlMath.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CORRADE_TESTSUITE_FLOATINGPOINTARRAY_SSE2
+#endif
+
+namespace Corrade { namespace TestSuite {
+
+namespace {
+
+template<class> struct FloatingPointTraits;
+template<> struct FloatingPointTraits<float> {
+    typedef std::int32_t Integer;
+};
+template<> struct FloatingPointTraits<double> {
+    typedef std::int64_t Integer;
+};
+
+/* Maps the bit representation to integers that are ordered the same way as
+   the floating-point values, with both zeros mapping to 0, so the count of
+   representable values between the two is a plain difference. Expects
+   neither value is a NaN. */
+template<class T> std::uint64_t ulpDistance(const T a, const T b) {
+    typedef typename FloatingPointTraits<T>::Integer Integer;
+    Integer ia, ib;
+    std::memcpy(&ia, &a, sizeof(T));
+    std::memcpy(&ib, &b, sizeof(T));
+    if(ia < 0) ia = std::numeric_limits<Integer>::min() - ia;
+    if(ib < 0) ib = std::numeric_limits<Integer>::min() - ib;
+    /* The difference may not fit into a signed 64-bit type, unsigned
+       wraparound makes it correct */
+    return ia >= ib ? std::uint64_t(ia) - std::uint64_t(ib) :
+                      std::uint64_t(ib) - std::uint64_t(ia);
+}
+
+#ifdef CORRADE_TESTSUITE_FLOATINGPOINTARRAY_SSE2
+/* Returns a bitmask of lanes that fail the tolerance comparison or, if
+   tolerance is false, of lanes that aren't exactly equal. The latter are then
+   checked for ULP distance in the scalar code. */
+template<class> struct Sse2;
+template<> struct Sse2<float> {
+    enum: std::size_t { Lanes = 4 };
+
+    static int differentMask(const float* const a, const float* const b, const float absolute, const float relative, const bool tolerance) {
+        const __m128 va = _mm_loadu_ps(a);
+        const __m128 vb = _mm_loadu_ps(b);
+        __m128 same = _mm_or_ps(_mm_cmpeq_ps(va, vb),
+            _mm_and_ps(_mm_cmpunord_ps(va, va), _mm_cmpunord_ps(vb, vb)));
+        if(tolerance) {
+            const __m128 signMask = _mm_set1_ps(-0.0f);
+            const __m128 difference = _mm_andnot_ps(signMask, _mm_sub_ps(va, vb));
+            const __m128 magnitude = _mm_max_ps(_mm_andnot_ps(signMask, va), _mm_andnot_ps(signMask, vb));
+            const __m128 bound = _mm_max_ps(_mm_set1_ps(absolute), _mm_mul_ps(_mm_set1_ps(relative), magnitude));
+            same = _mm_or_ps(same, _mm_and_ps(_mm_cmple_ps(difference, bound),
+                _mm_cmplt_ps(difference, _mm_set1_ps(std::numeric_limits<float>::infinity()))));
+        }
+        return ~_mm_movemask_ps(same) & 0xf;
+    }
+};
+template<> struct Sse2<double> {
+    enum: std::size_t { Lanes = 2 };
+
+    static int differentMask(const double* const a, const double* const b, const double absolute, const double relative, const bool tolerance) {
+        const __m128d va = _mm_loadu_pd(a);
+        const __m128d vb = _mm_loadu_pd(b);
+        __m128d same = _mm_or_pd(_mm_cmpeq_pd(va, vb),
+            _mm_and_pd(_mm_cmpunord_pd(va, va), _mm_cmpunord_pd(vb, vb)));
+        if(tolerance) {
+            const __m128d signMask = _mm_set1_pd(-0.0);
+            const __m128d difference = _mm_andnot_pd(signMask, _mm_sub_pd(va, vb));
+            const __m128d magnitude = _mm_max_pd(_mm_andnot_pd(signMask, va), _mm_andnot_pd(signMask, vb));
+            const __m128d bound = _mm_max_pd(_mm_set1_pd(absolute), _mm_mul_pd(_mm_set1_pd(relative), magnitude));
+            same = _mm_or_pd(same, _mm_and_pd(_mm_cmple_pd(difference, bound),
+                _mm_cmplt_pd(difference, _mm_set1_pd(std::numeric_limits<double>::infinity()))));
+        }
+        return ~_mm_movemask_pd(same) & 0x3;
+    }
+};
+#endif
+
+}
+
+template<class T> ComparisonStatusFlags Comparator<Compare::FloatingPointArray<T>>::operator()(const Containers::StridedArrayView1D<const T>& actual, const Containers::StridedArrayView1D<const T>& expected) {
+    _actualSize = actual.size();
+    _expectedSize = expected.size();
+    if(_actualSize != _expectedSize) return ComparisonStatusFlag::Failed;
+
+    _differentCount = 0;
+    std::size_t i = 0;
+
+    /* Process contiguous data in batches, falling back to the scalar code
+       only for the lanes that differ and for the remaining elements */
+    #ifdef CORRADE_TESTSUITE_FLOATINGPOINTARRAY_SSE2
+    if(actual.isContiguous() && expected.isContiguous()) {
+        const T* const a = static_cast<const T*>(actual.data());
+        const T* const b = static_cast<const T*>(expected.data());
+        for(; i + Sse2<T>::Lanes <= _actualSize; i += Sse2<T>::Lanes) {
+            const int mask = Sse2<T>::differentMask(a + i, b + i, _absolute, _relative, !_ulpMode);
+            if(!mask) continue;
+            for(std::size_t j = 0; j != Sse2<T>::Lanes; ++j)
+                if(mask & (1 << j)) compare(i + j, a[i + j], b[i + j]);
+        }
+    }
+    #endif
+
+    for(; i != _actualSize; ++i) compare(i, actual[i], expected[i]);
+
+    return _differentCount ? ComparisonStatusFlag::Failed : ComparisonStatusFlags{};
+}
+
+template<class T> void Comparator<Compare::FloatingPointArray<T>>::compare(const std::size_t i, const T actual, const T expected) {
+    /* Shortcut for binary equality, infinities and NaN */
+    if(actual == expected || (actual != actual && expected != expected))
+        return;
+
+    const T difference = std::abs(actual - expected);
+    const bool isNan = actual != actual || expected != expected;
+    std::uint64_t ulps{};
+    if(_ulpMode) {
+        ulps = isNan ? ~std::uint64_t{} : ulpDistance(actual, expected);
+        if(ulps <= _ulps) return;
+    } else if(difference <= std::max(_absolute, _relative*std::max(std::abs(actual), std::abs(expected))) && difference < std::numeric_limits<T>::infinity())
+        return;
+
+    /* A NaN difference is worse than anything else, otherwise the first
+       largest one wins */
+    if(!_differentCount || (_ulpMode ? ulps > _worstUlps :
+        (difference > _worstDifference || (difference != difference && _worstDifference == _worstDifference))))
+    {
+        _worstIndex = i;
+        _worstActual = actual;
+        _worstExpected = expected;
+        _worstDifference = difference;
+        _worstUlps = ulps;
+    }
+
+    ++_differentCount;
+}
+
+template<class T> void Comparator<Compare::FloatingPointArray<T>>::printMessage(ComparisonStatusFlags, Utility::Debug& out, const char* actual, const char* expected) const {
+    if(_actualSize != _expectedSize) {
+        out << "Floating-point arrays" << actual << "and" << expected << "have different size, actual" << _actualSize << "but" << _expectedSize << "expected.";
+        return;
+    }
+
+    out << "Floating-point arrays" << actual << "and" << expected << "have" << _differentCount << "different values out of" << _actualSize << Utility::Debug::nospace << ", the worst at index" << _worstIndex << Utility::Debug::nospace << ": actual" << _worstActual << "but" << _worstExpected << "expected (delta" << _worstActual - _worstExpected;
+    if(_ulpMode && _worstUlps != ~std::uint64_t{})
+        out << Utility::Debug::nospace << "," << _worstUlps << "ULPs";
+    out << Utility::Debug::nospace << ").";
+}
+
+template class Comparator<Compare::FloatingPointArray<float>>;
+template class Comparator<Compare::FloatingPointArray<double>>;
+
+}}
@@ -0,0 +1,140 @@
+#ifndef Corrade_TestSuite_Compare_FloatingPointArray_h
+#define Corrade_TestSuite_Compare_FloatingPointArray_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::TestSuite::Compare::FloatingPointArray
+ * @m_since_latest
+ */
+
+#include <cstdint>
+
+#include "Corrade/Containers/StridedArrayView.h"
+#include "Corrade/TestSuite/Compare/FloatingPoint.h"
+
+namespace Corrade { namespace TestSuite {
+
+namespace Compare {
+
+/**
+@brief Pseudo-type for fuzzy comparison of floating-point arrays
+@m_since_latest
+
+Compares two @ref Containers::StridedArrayView1D "Containers::StridedArrayView1D"
+of @cpp float @ce or @cpp double @ce values element-wise, which makes it
+usable also with @ref Containers::Array, plain C arrays or
+@ref Containers::ArrayView. Unlike comparing the arrays with
+@ref Compare::Container, which goes through the scalar
+@ref Comparator<float> for each element and stops at the first difference,
+the comparison is done in batches with SSE2 on contiguous data, and on failure
+it reports the count of differing elements together with the worst one and
+its index:
+
+@snippet TestSuite.cpp Compare-FloatingPointArray
+
+Two modes are supported:
+
+-   With @ref FloatingPointArray(T, T), a pair of values is considered equal
+    if their absolute difference is not larger than either the absolute
+    tolerance or the relative tolerance multiplied by the larger of the two
+    magnitudes. The default constructor uses the same epsilon as
+    @ref Comparator<float> and @ref Comparator<double> for both.
+-   With @ref ulps(), a pair of values is considered equal if there's at most
+    given count of representable values between them. This scales with the
+    magnitude automatically but doesn't work well around zero, where the
+    values are densest.
+
+In both cases, two NaNs are considered equal and a NaN is never equal to
+anything else, consistently with @ref Comparator<float>. An infinity is equal
+only to an infinity of the same sign. The worst value is the one with the
+largest absolute difference or the largest ULP distance, with a NaN being
+worse than anything else. If there's more of them, the first one is reported.
+*/
+template<class T> class FloatingPointArray {
+    public:
+        /**
+         * @brief Make an ULP-distance comparison
+         * @param distance  Max count of representable values between the
+         *      actual and the expected value
+         */
+        static FloatingPointArray<T> ulps(std::uint64_t distance) {
+            return FloatingPointArray<T>{T{}, T{}, distance, true};
+        }
+
+        /**
+         * @brief Constructor
+         *
+         * Equivalent to calling @ref FloatingPointArray(T, T) with both
+         * tolerances set to @cpp 1.0e-6f @ce for @cpp float @ce and
+         * @cpp 1.0e-12 @ce for @cpp double @ce.
+         */
+        explicit FloatingPointArray(): FloatingPointArray{Implementation::FloatComparatorEpsilon<T>::epsilon(), Implementation::FloatComparatorEpsilon<T>::epsilon()} {}
+
+        /**
+         * @brief Construct a tolerance comparison
+         * @param absolute  Absolute tolerance
+         * @param relative  Relative tolerance
+         */
+        explicit FloatingPointArray(T absolute, T relative): FloatingPointArray{absolute, relative, 0, false} {}
+
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        Comparator<Compare::FloatingPointArray<T>>& comparator() { return _c; }
+        #endif
+
+    private:
+        explicit FloatingPointArray(T absolute, T relative, std::uint64_t ulps, bool ulpMode): _c{absolute, relative, ulps, ulpMode} {}
+
+        Comparator<Compare::FloatingPointArray<T>> _c;
+};
+
+}
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+template<class T> class CORRADE_TESTSUITE_EXPORT Comparator<Compare::FloatingPointArray<T>> {
+    public:
+        explicit Comparator(T absolute, T relative, std::uint64_t ulps, bool ulpMode): _absolute{absolute}, _relative{relative}, _ulps{ulps}, _ulpMode{ulpMode} {}
+
+        ComparisonStatusFlags operator()(const Containers::StridedArrayView1D<const T>& actual, const Containers::StridedArrayView1D<const T>& expected);
+
+        void printMessage(ComparisonStatusFlags, Utility::Debug& out, const char* actual, const char* expected) const;
+
+    private:
+        void compare(std::size_t i, T actual, T expected);
+
+        T _absolute, _relative;
+        std::uint64_t _ulps;
+        bool _ulpMode;
+
+        std::size_t _actualSize, _expectedSize;
+        std::size_t _differentCount, _worstIndex;
+        T _worstActual, _worstExpected, _worstDifference;
+        std::uint64_t _worstUlps;
+};
+#endif
+
+}}
+
+#endif
@@ -57,6 +57,11 @@ template<class T> class Comparator<Compare::SortedContainer<T>>: public Comparat
 };
 
 template<class T> ComparisonStatusFlags Comparator<Compare::SortedContainer<T>>::operator()(const T& actual, const T& expected) {
+    /* If the contents are the same already, there's no need to copy and sort
+       them. Otherwise the sorted copies are needed for the diagnostic. */
+    if(actual.size() == expected.size() && !(Comparator<Compare::Container<T>>::operator()(actual, expected) & ComparisonStatusFlag::Failed))
+        return {};
+
     _actualSorted = actual;
     _expectedSorted = expected;
 
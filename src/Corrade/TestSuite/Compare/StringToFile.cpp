@@ -25,11 +25,7 @@
 
 #include "StringToFile.h"
 
-#include <cstddef>
-#ifdef _MSC_VER
-#include <algorithm> /* std::max() */
-#endif
-
+#include "Corrade/TestSuite/Implementation/FileContents.h"
 #include "Corrade/Utility/DebugStl.h"
 #include "Corrade/Utility/Directory.h"
 #include "Corrade/TestSuite/Tester.h"
@@ -37,10 +33,13 @@
 namespace Corrade { namespace TestSuite {
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
-Comparator<Compare::StringToFile>::Comparator(): _state(State::ReadError) {}
+Comparator<Compare::StringToFile>::Comparator(): _state(State::ReadError), _firstDifference{} {}
+
+Comparator<Compare::StringToFile>::~Comparator() = default;
 
 ComparisonStatusFlags Comparator<Compare::StringToFile>::operator()(const std::string& actualContents, const std::string& filename) {
     _filename = filename;
+    _state = State::ReadError;
 
     /* Save the actual file contents before the expected so if the expected
        file can't be read, we can still save actual file contents */
@@ -50,10 +49,14 @@ ComparisonStatusFlags Comparator<Compare::StringToFile>::operator()(const std::s
     if(!Utility::Directory::exists(filename))
         return ComparisonStatusFlag::Diagnostic|ComparisonStatusFlag::Failed;
 
-    _expectedContents = Utility::Directory::readString(filename);
+    _expectedContents.emplace();
+    if(!_expectedContents->open(filename))
+        return ComparisonStatusFlag::Diagnostic|ComparisonStatusFlag::Failed;
     _state = State::Success;
 
-    return _actualContents == _expectedContents ? ComparisonStatusFlags{} :
+    const Containers::ArrayView<const char> expectedData = _expectedContents->data();
+    _firstDifference = Implementation::firstDifference({_actualContents.data(), _actualContents.size()}, expectedData);
+    return _actualContents.size() == expectedData.size() && _firstDifference == expectedData.size() ? ComparisonStatusFlags{} :
         ComparisonStatusFlag::Diagnostic|ComparisonStatusFlag::Failed;
 }
 
@@ -63,31 +66,14 @@ void Comparator<Compare::StringToFile>::printMessage(ComparisonStatusFlags, Util
         return;
     }
 
-    out << "Files" << actual << "and" << expected << "have different";
-    if(_actualContents.size() != _expectedContents.size())
-        out << "size, actual" << _actualContents.size() << "but" << _expectedContents.size() << "expected.";
-    else
-        out << "contents.";
-
-    for(std::size_t i = 0, end = std::max(_actualContents.size(), _expectedContents.size()); i != end; ++i) {
-        if(_actualContents.size() > i && _expectedContents.size() > i && _actualContents[i] == _expectedContents[i]) continue;
-
-        /** @todo do this without std::string */
-        if(_actualContents.size() <= i)
-            out << "Expected has character" << std::string() + _expectedContents[i];
-        else if(_expectedContents.size() <= i)
-            out << "Actual has character" << std::string() + _actualContents[i];
-        else
-            out << "Actual character" << std::string() + _actualContents[i] << "but" << std::string() + _expectedContents[i] << "expected";
-
-        out << "on position" << i << Utility::Debug::nospace << ".";
-        break;
-    }
+    Implementation::printFileDifference(out, actual, expected, {_actualContents.data(), _actualContents.size()}, _expectedContents->data(), _firstDifference);
 }
 
 void Comparator<Compare::StringToFile>::saveDiagnostic(ComparisonStatusFlags, Utility::Debug& out, const std::string& path) {
+    /* The destination might be the expected file, which is mapped, so write
+       atomically to not pull the rug from under the mapping */
     std::string filename = Utility::Directory::join(path, Utility::Directory::filename(_filename));
-    if(Utility::Directory::writeString(filename, _actualContents))
+    if(Utility::Directory::write(filename, Containers::ArrayView<const void>{_actualContents.data(), _actualContents.size()}, Utility::Directory::WriteFlag::Atomic))
         out << "->" << filename;
 }
 #endif
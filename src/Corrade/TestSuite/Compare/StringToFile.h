@@ -31,12 +31,15 @@
 
 #include <string>
 
+#include "Corrade/Containers/Pointer.h"
 #include "Corrade/TestSuite/TestSuite.h"
 #include "Corrade/TestSuite/visibility.h"
 #include "Corrade/Utility/Utility.h"
 
 namespace Corrade { namespace TestSuite {
 
+namespace Implementation { class FileContents; }
+
 namespace Compare {
 
 /**
@@ -44,7 +47,8 @@ namespace Compare {
 
 Prints the length of both files (if they are different) and prints the value
 and position of the first different character in both files. Filename is
-expected to be in UTF-8. Example usage:
+expected to be in UTF-8. The file is memory-mapped where the platform supports
+it instead of being read into memory. Example usage:
 
 @snippet TestSuite.cpp Compare-StringToFile
 
@@ -71,6 +75,8 @@ template<> class CORRADE_TESTSUITE_EXPORT Comparator<Compare::StringToFile> {
     public:
         Comparator();
 
+        ~Comparator();
+
         ComparisonStatusFlags operator()(const std::string& actualContents, const std::string& filename);
 
         void printMessage(ComparisonStatusFlags flags, Utility::Debug& out, const char* actual, const char* expected) const;
@@ -84,8 +90,9 @@ template<> class CORRADE_TESTSUITE_EXPORT Comparator<Compare::StringToFile> {
         };
 
         State _state;
-        std::string _filename,
-            _actualContents, _expectedContents;
+        std::string _filename, _actualContents;
+        Containers::Pointer<Implementation::FileContents> _expectedContents;
+        std::size_t _firstDifference;
 };
 #endif
 
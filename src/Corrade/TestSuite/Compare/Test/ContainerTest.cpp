@@ -24,6 +24,7 @@
 */
 
 #include <sstream>
+#include <string>
 #include <vector>
 
 #include "Corrade/Containers/Array.h"
@@ -41,6 +42,9 @@ struct ContainerTest: Tester {
     void outputExpectedSmaller();
     void output();
     void floatingPoint();
+    void outputLarge();
+    void outputLargeActualSmaller();
+    void memoryComparable();
 
     void nonCopyableArray();
 };
@@ -51,6 +55,9 @@ ContainerTest::ContainerTest() {
               &ContainerTest::outputExpectedSmaller,
               &ContainerTest::output,
               &ContainerTest::floatingPoint,
+              &ContainerTest::outputLarge,
+              &ContainerTest::outputLargeActualSmaller,
+              &ContainerTest::memoryComparable,
 
               &ContainerTest::nonCopyableArray});
 }
@@ -153,6 +160,67 @@ void ContainerTest::floatingPoint() {
         "        Actual 3.20212 but 3.20213 expected on position 1.\n");
 }
 
+void ContainerTest::outputLarge() {
+    std::stringstream out;
+
+    std::vector<int> a(1000);
+    std::vector<int> b(1000);
+    b[567] = 1;
+    b[789] = 2;
+
+    CORRADE_COMPARE(Comparator<Compare::Container<std::vector<int>>>{}(a, a), ComparisonStatusFlags{});
+
+    {
+        Error e(&out);
+        Comparator<Compare::Container<std::vector<int>>> compare;
+        ComparisonStatusFlags flags = compare(a, b);
+        CORRADE_COMPARE(flags, ComparisonStatusFlag::Failed);
+        compare.printMessage(flags, e, "a", "b");
+    }
+
+    /* The contents are not printed, only the first difference */
+    CORRADE_COMPARE(out.str(), "Containers a and b have different contents.\n"
+        "        Actual 0 but 1 expected on position 567.\n");
+}
+
+void ContainerTest::outputLargeActualSmaller() {
+    std::stringstream out;
+
+    std::vector<int> a(999);
+    std::vector<int> b(1000, 3);
+    for(std::size_t i = 0; i != a.size(); ++i) a[i] = 3;
+
+    {
+        Error e(&out);
+        Comparator<Compare::Container<std::vector<int>>> compare;
+        ComparisonStatusFlags flags = compare(a, b);
+        CORRADE_COMPARE(flags, ComparisonStatusFlag::Failed);
+        compare.printMessage(flags, e, "a", "b");
+    }
+
+    CORRADE_COMPARE(out.str(), "Containers a and b have different size, actual 999 but 1000 expected.\n"
+        "        Expected has 3 on position 999.\n");
+}
+
+void ContainerTest::memoryComparable() {
+    enum class Enum: unsigned char {};
+
+    /* Contiguous containers of integers, enums and pointers are compared
+       bitwise */
+    CORRADE_VERIFY(Implementation::ContainerMemoryComparable<std::vector<int>>::value);
+    CORRADE_VERIFY(Implementation::ContainerMemoryComparable<std::vector<Enum>>::value);
+    CORRADE_VERIFY(Implementation::ContainerMemoryComparable<std::vector<const void*>>::value);
+    CORRADE_VERIFY(Implementation::ContainerMemoryComparable<std::string>::value);
+    CORRADE_VERIFY(Implementation::ContainerMemoryComparable<Containers::Array<int>>::value);
+    CORRADE_VERIFY(Implementation::ContainerMemoryComparable<Containers::ArrayView<const char>>::value);
+
+    /* Floats are compared fuzzily, other types with their own comparators,
+       std::vector<bool> has no data() */
+    CORRADE_VERIFY(!Implementation::ContainerMemoryComparable<std::vector<float>>::value);
+    CORRADE_VERIFY(!Implementation::ContainerMemoryComparable<std::vector<std::string>>::value);
+    CORRADE_VERIFY(!Implementation::ContainerMemoryComparable<std::vector<bool>>::value);
+}
+
 void ContainerTest::nonCopyableArray() {
     Containers::Array<int> a{Containers::InPlaceInit, {1, 2, 3, 4, 5}};
     Containers::Array<int> b{Containers::InPlaceInit, {1, 2, 3, 4, 5}};
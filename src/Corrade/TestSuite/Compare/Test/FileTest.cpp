@@ -48,6 +48,9 @@ struct FileTest: Tester {
     void differentContents();
     void actualSmaller();
     void expectedSmaller();
+
+    void differentContentsLarge();
+    void sameLarge();
 };
 
 FileTest::FileTest() {
@@ -60,7 +63,10 @@ FileTest::FileTest() {
 
               &FileTest::differentContents,
               &FileTest::actualSmaller,
-              &FileTest::expectedSmaller});
+              &FileTest::expectedSmaller,
+
+              &FileTest::differentContentsLarge,
+              &FileTest::sameLarge});
 }
 
 void FileTest::same() {
@@ -196,6 +202,41 @@ void FileTest::expectedSmaller() {
     CORRADE_COMPARE(out.str(), "Files a and b have different size, actual 12 but 7 expected. Actual has character o on position 7.\n");
 }
 
+void FileTest::differentContentsLarge() {
+    /* Large enough to span many blocks, with the difference in the middle of
+       one of them */
+    std::string data(1024*1024, 'a');
+    CORRADE_VERIFY(Utility::Directory::mkpath(FILETEST_SAVE_DIR));
+    const std::string expected = Utility::Directory::join(FILETEST_SAVE_DIR, "large-expected.txt");
+    CORRADE_VERIFY(Utility::Directory::writeString(expected, data));
+    data[500001] = 'b';
+    const std::string actual = Utility::Directory::join(FILETEST_SAVE_DIR, "large-actual.txt");
+    CORRADE_VERIFY(Utility::Directory::writeString(actual, data));
+
+    std::stringstream out;
+
+    {
+        Error e(&out);
+        Comparator<Compare::File> compare;
+        ComparisonStatusFlags flags = compare(actual, expected);
+        CORRADE_COMPARE(flags, ComparisonStatusFlag::Failed|ComparisonStatusFlag::Diagnostic);
+        compare.printMessage(flags, e, "a", "b");
+    }
+
+    CORRADE_COMPARE(out.str(), "Files a and b have different contents. Actual character b but a expected on position 500001.\n");
+}
+
+void FileTest::sameLarge() {
+    const std::string data(1024*1024 + 17, 'a');
+    CORRADE_VERIFY(Utility::Directory::mkpath(FILETEST_SAVE_DIR));
+    const std::string a = Utility::Directory::join(FILETEST_SAVE_DIR, "large-a.txt");
+    const std::string b = Utility::Directory::join(FILETEST_SAVE_DIR, "large-b.txt");
+    CORRADE_VERIFY(Utility::Directory::writeString(a, data));
+    CORRADE_VERIFY(Utility::Directory::writeString(b, data));
+
+    CORRADE_COMPARE(Comparator<Compare::File>{}(a, b), ComparisonStatusFlags{});
+}
+
 }}}}}
 
 CORRADE_TEST_MAIN(Corrade::TestSuite::Compare::Test::FileTest)
@@ -0,0 +1,292 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/FloatingPointArray.h"
+#include "Corrade/Utility/DebugStl.h" /** @todo remove when <sstream> is gone */
+
+namespace Corrade { namespace TestSuite { namespace Test { namespace {
+
+struct FloatingPointArrayTest: Tester {
+    explicit FloatingPointArrayTest();
+
+    template<class T> void same();
+    template<class T> void different();
+    template<class T> void differentWorst();
+    void nan();
+    void infinity();
+    void strided();
+    void ulps();
+    void ulpsAcrossZero();
+    void ulpsDouble();
+    void relative();
+    void differentSize();
+
+    void output();
+    void outputUlps();
+    void outputDifferentSize();
+};
+
+FloatingPointArrayTest::FloatingPointArrayTest() {
+    addTests({&FloatingPointArrayTest::same<float>,
+              &FloatingPointArrayTest::same<double>,
+              &FloatingPointArrayTest::different<float>,
+              &FloatingPointArrayTest::different<double>,
+              &FloatingPointArrayTest::differentWorst<float>,
+              &FloatingPointArrayTest::differentWorst<double>,
+              &FloatingPointArrayTest::nan,
+              &FloatingPointArrayTest::infinity,
+              &FloatingPointArrayTest::strided,
+              &FloatingPointArrayTest::ulps,
+              &FloatingPointArrayTest::ulpsAcrossZero,
+              &FloatingPointArrayTest::ulpsDouble,
+              &FloatingPointArrayTest::relative,
+              &FloatingPointArrayTest::differentSize,
+
+              &FloatingPointArrayTest::output,
+              &FloatingPointArrayTest::outputUlps,
+              &FloatingPointArrayTest::outputDifferentSize});
+}
+
+template<class> struct TypeName;
+template<> struct TypeName<float> {
+    static const char* name() { return "float"; }
+    static float epsilon() { return 1.0e-7f; }
+};
+template<> struct TypeName<double> {
+    static const char* name() { return "double"; }
+    static double epsilon() { return 1.0e-13; }
+};
+
+/* 11 elements to test both the batched code and the remainder */
+template<class T> void FloatingPointArrayTest::same() {
+    setTestCaseTemplateName(TypeName<T>::name());
+
+    const T a[]{T(0.0), T(1.0), T(-2.5), T(3.2), T(4.0), T(5.0), T(6.0), T(7.0), T(8.0), T(9.0), T(10.0)};
+    T b[11];
+    for(std::size_t i = 0; i != 11; ++i) b[i] = a[i] + TypeName<T>::epsilon();
+
+    Compare::FloatingPointArray<T> compare;
+    CORRADE_COMPARE(compare.comparator()(a, a), ComparisonStatusFlags{});
+    CORRADE_COMPARE(compare.comparator()(a, b), ComparisonStatusFlags{});
+    CORRADE_COMPARE(compare.comparator()(nullptr, nullptr), ComparisonStatusFlags{});
+}
+
+template<class T> void FloatingPointArrayTest::different() {
+    setTestCaseTemplateName(TypeName<T>::name());
+
+    const T a[]{T(0.0), T(1.0), T(-2.5), T(3.2), T(4.0), T(5.0), T(6.0), T(7.0), T(8.0), T(9.0), T(10.0)};
+
+    /* Difference in the batched part and in the remainder */
+    for(std::size_t i: {std::size_t{2}, std::size_t{10}}) {
+        T b[11];
+        for(std::size_t j = 0; j != 11; ++j) b[j] = a[j];
+        b[i] += T(0.001);
+        Compare::FloatingPointArray<T> compare;
+        CORRADE_COMPARE(compare.comparator()(a, b), ComparisonStatusFlag::Failed);
+    }
+}
+
+template<class T> void FloatingPointArrayTest::differentWorst() {
+    setTestCaseTemplateName(TypeName<T>::name());
+
+    const T a[]{T(0.0), T(1.0), T(-2.5), T(3.2), T(4.0), T(5.0), T(6.0), T(7.0), T(8.0), T(9.0), T(10.0)};
+    const T b[]{T(0.0), T(1.5), T(-2.5), T(3.2), T(4.0), T(5.0), T(6.0), T(9.0), T(8.0), T(9.0), T(11.0)};
+
+    std::stringstream out;
+    {
+        Debug d{&out, Debug::Flag::NoNewlineAtTheEnd};
+        Compare::FloatingPointArray<T> compare;
+        ComparisonStatusFlags flags = compare.comparator()(a, b);
+        CORRADE_COMPARE(flags, ComparisonStatusFlag::Failed);
+        compare.comparator().printMessage(flags, d, "a", "b");
+    }
+    CORRADE_COMPARE(out.str(), "Floating-point arrays a and b have 3 different values out of 11, the worst at index 7: actual 7 but 9 expected (delta -2).");
+}
+
+void FloatingPointArrayTest::nan() {
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const float a[]{1.0f, nan, 3.0f, 4.0f, nan};
+    const float b[]{1.0f, nan, 3.0f, 4.0f, nan};
+    const float c[]{1.0f, nan, 3.0f, 4.0f, 5.0f};
+    const float d[]{1.0f, 2.0f, 3.0f, 4.0f, nan};
+
+    Compare::FloatingPointArray<float> compare;
+    CORRADE_COMPARE(compare.comparator()(a, b), ComparisonStatusFlags{});
+    CORRADE_COMPARE(compare.comparator()(a, c), ComparisonStatusFlag::Failed);
+    CORRADE_COMPARE(compare.comparator()(a, d), ComparisonStatusFlag::Failed);
+    CORRADE_COMPARE(Compare::FloatingPointArray<float>::ulps(1000).comparator()(a, c), ComparisonStatusFlag::Failed);
+
+    /* A NaN is the worst even if it's after a large difference */
+    const float e[]{1000.0f, nan, 3.0f, 4.0f, 5.0f};
+    std::stringstream out;
+    {
+        Debug dbg{&out, Debug::Flag::NoNewlineAtTheEnd};
+        ComparisonStatusFlags flags = compare.comparator()(e, d);
+        CORRADE_COMPARE(flags, ComparisonStatusFlag::Failed);
+        compare.comparator().printMessage(flags, dbg, "e", "d");
+    }
+    CORRADE_COMPARE(out.str(), "Floating-point arrays e and d have 3 different values out of 5, the worst at index 1: actual nan but 2 expected (delta nan).");
+}
+
+void FloatingPointArrayTest::infinity() {
+    const float inf = std::numeric_limits<float>::infinity();
+    const float a[]{1.0f, inf, -inf, 4.0f, 5.0f};
+    const float b[]{1.0f, inf, -inf, 4.0f, 5.0f};
+    const float c[]{1.0f, inf, inf, 4.0f, 5.0f};
+    const float d[]{1.0f, 1.0e38f, -inf, 4.0f, 5.0f};
+
+    /* Even a huge relative tolerance shouldn't make infinity equal to a
+       finite value */
+    Compare::FloatingPointArray<float> compare{0.0f, 10.0f};
+    CORRADE_COMPARE(compare.comparator()(a, b), ComparisonStatusFlags{});
+    CORRADE_COMPARE(compare.comparator()(a, c), ComparisonStatusFlag::Failed);
+    CORRADE_COMPARE(compare.comparator()(a, d), ComparisonStatusFlag::Failed);
+}
+
+void FloatingPointArrayTest::strided() {
+    struct Vertex {
+        float position;
+        int other;
+    } a[]{{1.0f, 0}, {2.0f, 1}, {3.0f, 2}, {4.0f, 3}, {5.0f, 4}, {6.0f, 5}};
+    const float b[]{1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+    const float c[]{1.0f, 2.0f, 3.0f, 4.5f, 5.0f, 6.0f};
+
+    Containers::StridedArrayView1D<const float> positions{a, &a[0].position, 6, sizeof(Vertex)};
+
+    Compare::FloatingPointArray<float> compare;
+    CORRADE_COMPARE(compare.comparator()(positions, b), ComparisonStatusFlags{});
+    CORRADE_COMPARE(compare.comparator()(positions, c), ComparisonStatusFlag::Failed);
+    CORRADE_COMPARE(compare.comparator()(positions.flipped<0>(), b), ComparisonStatusFlag::Failed);
+}
+
+void FloatingPointArrayTest::ulps() {
+    const float a[]{1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
+    float b[]{1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
+    b[1] = std::nextafter(std::nextafter(b[1], 3.0f), 3.0f);
+    b[4] = std::nextafter(b[4], 0.0f);
+
+    CORRADE_COMPARE(Compare::FloatingPointArray<float>::ulps(2).comparator()(a, b), ComparisonStatusFlags{});
+    CORRADE_COMPARE(Compare::FloatingPointArray<float>::ulps(1).comparator()(a, b), ComparisonStatusFlag::Failed);
+    CORRADE_COMPARE(Compare::FloatingPointArray<float>::ulps(0).comparator()(a, a), ComparisonStatusFlags{});
+}
+
+void FloatingPointArrayTest::ulpsAcrossZero() {
+    const float denormal = std::numeric_limits<float>::denorm_min();
+    const float a[]{0.0f, -0.0f, denormal, -denormal};
+    const float b[]{-0.0f, 0.0f, -denormal, denormal};
+
+    /* Both zeros are the same value, the smallest denormals on both sides
+       are two representable values apart */
+    CORRADE_COMPARE(Compare::FloatingPointArray<float>::ulps(2).comparator()(a, b), ComparisonStatusFlags{});
+    CORRADE_COMPARE(Compare::FloatingPointArray<float>::ulps(1).comparator()(a, b), ComparisonStatusFlag::Failed);
+}
+
+void FloatingPointArrayTest::ulpsDouble() {
+    const double max = std::numeric_limits<double>::max();
+    const double a[]{1.0, -max, 3.0};
+    double b[]{1.0, max, std::nextafter(3.0, 4.0)};
+
+    /* The distance between the two extremes doesn't fit into a signed 64-bit
+       integer, verify it doesn't wrap around */
+    CORRADE_COMPARE(Compare::FloatingPointArray<double>::ulps(~std::uint64_t{} - 1).comparator()(a, b), ComparisonStatusFlags{});
+    CORRADE_COMPARE(Compare::FloatingPointArray<double>::ulps(std::uint64_t(1) << 63).comparator()(a, b), ComparisonStatusFlag::Failed);
+    b[1] = -max;
+    CORRADE_COMPARE(Compare::FloatingPointArray<double>::ulps(1).comparator()(a, b), ComparisonStatusFlags{});
+}
+
+void FloatingPointArrayTest::relative() {
+    const float a[]{1000.0f, 0.001f, 0.0f, 1.0e6f};
+    const float b[]{1000.5f, 0.0015f, 0.0005f, 1.0e6f + 200.0f};
+
+    CORRADE_COMPARE((Compare::FloatingPointArray<float>{0.001f, 0.001f}.comparator()(a, b)), ComparisonStatusFlags{});
+    CORRADE_COMPARE((Compare::FloatingPointArray<float>{0.001f, 0.0001f}.comparator()(a, b)), ComparisonStatusFlag::Failed);
+    CORRADE_COMPARE((Compare::FloatingPointArray<float>{0.0001f, 0.001f}.comparator()(a, b)), ComparisonStatusFlag::Failed);
+}
+
+void FloatingPointArrayTest::differentSize() {
+    const float a[]{1.0f, 2.0f, 3.0f};
+    const float b[]{1.0f, 2.0f, 3.0f, 4.0f};
+
+    Compare::FloatingPointArray<float> compare;
+    CORRADE_COMPARE(compare.comparator()(a, b), ComparisonStatusFlag::Failed);
+}
+
+void FloatingPointArrayTest::output() {
+    const float a[]{1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
+    const float b[]{1.0f, 2.5f, 3.0f, 4.0f, 5.1f};
+
+    std::stringstream out;
+    {
+        Error e(&out);
+        Compare::FloatingPointArray<float> compare;
+        ComparisonStatusFlags flags = compare.comparator()(a, b);
+        CORRADE_COMPARE(flags, ComparisonStatusFlag::Failed);
+        compare.comparator().printMessage(flags, e, "a", "b");
+    }
+
+    CORRADE_COMPARE(out.str(), "Floating-point arrays a and b have 2 different values out of 5, the worst at index 1: actual 2 but 2.5 expected (delta -0.5).\n");
+}
+
+void FloatingPointArrayTest::outputUlps() {
+    const float a[]{1.0f, 2.0f, 3.0f};
+    float b[]{1.0f, 2.0f, 3.0f};
+    b[2] = std::nextafter(std::nextafter(std::nextafter(b[2], 4.0f), 4.0f), 4.0f);
+
+    std::stringstream out;
+    {
+        Error e(&out);
+        Compare::FloatingPointArray<float> compare = Compare::FloatingPointArray<float>::ulps(2);
+        ComparisonStatusFlags flags = compare.comparator()(a, b);
+        CORRADE_COMPARE(flags, ComparisonStatusFlag::Failed);
+        compare.comparator().printMessage(flags, e, "a", "b");
+    }
+
+    CORRADE_COMPARE(out.str(), "Floating-point arrays a and b have 1 different values out of 3, the worst at index 2: actual 3 but 3 expected (delta -7.15256e-07, 3 ULPs).\n");
+}
+
+void FloatingPointArrayTest::outputDifferentSize() {
+    const float a[]{1.0f, 2.0f, 3.0f};
+    const float b[]{1.0f, 2.0f, 3.0f, 4.0f};
+
+    std::stringstream out;
+    {
+        Error e(&out);
+        Compare::FloatingPointArray<float> compare;
+        ComparisonStatusFlags flags = compare.comparator()(a, b);
+        CORRADE_COMPARE(flags, ComparisonStatusFlag::Failed);
+        compare.comparator().printMessage(flags, e, "a", "b");
+    }
+
+    CORRADE_COMPARE(out.str(), "Floating-point arrays a and b have different size, actual 3 but 4 expected.\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::TestSuite::Test::FloatingPointArrayTest)
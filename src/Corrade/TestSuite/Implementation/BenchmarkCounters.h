@@ -27,8 +27,14 @@
 
 #include <cstdint>
 
+#include "Corrade/configure.h"
+
 /* For wall clock */
+#ifndef CORRADE_TARGET_EMSCRIPTEN
 #include <chrono>
+#else
+#include <emscripten.h>
+#endif
 
 /* For CPU clock */
 #ifndef CORRADE_TARGET_WINDOWS
@@ -46,14 +52,49 @@
 #endif
 #endif
 
-#include "Corrade/configure.h"
+/* For hardware counters and resident memory */
+#ifdef __linux__
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 namespace Corrade { namespace TestSuite { namespace Implementation {
 
-/* Wall time in nanoseconds */
+/* Wall time in nanoseconds. On Emscripten std::chrono goes through
+   Date.now() in some versions, which has only millisecond precision, so use
+   performance.now() directly. That one is still clamped to somewhere between
+   5 µs and 1 ms by the browsers to mitigate Spectre, see
+   wallTimeResolution() below. */
 inline std::uint64_t wallTime() {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
     /* OH GOD WHY SO COMPLICATED */
     return  std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+    #else
+    return std::uint64_t(emscripten_get_now()*1000000.0);
+    #endif
+}
+
+/* Smallest observed nonzero wall time difference in nanoseconds, i.e. the
+   effective clock resolution. Waits for a few clock ticks, which is at most a
+   few milliseconds even with the coarsest clamping. The first tick is only
+   used to synchronize with the clock, as it started at an arbitrary point. */
+inline std::uint64_t wallTimeResolution() {
+    std::uint64_t resolution = ~std::uint64_t{};
+    std::uint64_t previous = wallTime();
+    for(int ticks = 0; ticks != 6; ) {
+        const std::uint64_t current = wallTime();
+        if(current == previous) continue;
+        if(ticks && current - previous < resolution)
+            resolution = current - previous;
+        previous = current;
+        ++ticks;
+    }
+    return resolution;
 }
 
 /* CPU time in nanoseconds */
@@ -80,6 +121,147 @@ inline std::uint64_t rdtsc() {
     #endif
 }
 
+/* Hardware performance counter. On Linux uses perf_event_open(), counting
+   only user space so it works with the default perf_event_paranoid setting.
+   Elsewhere open() always fails and end() returns zero. */
+class HardwareCounter {
+    public:
+        /* Order matches the hardware counter benchmark types in Tester */
+        enum class Event {
+            Instructions,
+            CoreCycles,
+            L1DataCacheMisses,
+            LastLevelCacheMisses,
+            BranchMisses,
+            DataTlbMisses
+        };
+
+        explicit HardwareCounter() = default;
+
+        HardwareCounter(const HardwareCounter&) = delete;
+        HardwareCounter& operator=(const HardwareCounter&) = delete;
+
+        ~HardwareCounter() { close(); }
+
+        /* Opens a counter for given event, reusing the existing one if it's
+           for the same event. Returns false if it can't be opened. */
+        bool open(Event event) {
+            #ifdef __linux__
+            if(_fd != -1 && _event == event) return true;
+            close();
+
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(perf_event_attr));
+            attr.size = sizeof(perf_event_attr);
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            switch(event) {
+                case Event::Instructions:
+                    attr.type = PERF_TYPE_HARDWARE;
+                    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+                    break;
+                case Event::CoreCycles:
+                    attr.type = PERF_TYPE_HARDWARE;
+                    attr.config = PERF_COUNT_HW_CPU_CYCLES;
+                    break;
+                case Event::L1DataCacheMisses:
+                    attr.type = PERF_TYPE_HW_CACHE;
+                    attr.config = PERF_COUNT_HW_CACHE_L1D|(PERF_COUNT_HW_CACHE_OP_READ << 8)|(PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+                    break;
+                case Event::LastLevelCacheMisses:
+                    attr.type = PERF_TYPE_HARDWARE;
+                    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+                    break;
+                case Event::BranchMisses:
+                    attr.type = PERF_TYPE_HARDWARE;
+                    attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+                    break;
+                case Event::DataTlbMisses:
+                    attr.type = PERF_TYPE_HW_CACHE;
+                    attr.config = PERF_COUNT_HW_CACHE_DTLB|(PERF_COUNT_HW_CACHE_OP_READ << 8)|(PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+                    break;
+            }
+
+            _fd = int(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+            _event = event;
+            return _fd != -1;
+            #else
+            static_cast<void>(event);
+            return false;
+            #endif
+        }
+
+        void begin() {
+            #ifdef __linux__
+            if(_fd == -1) return;
+            ioctl(_fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(_fd, PERF_EVENT_IOC_ENABLE, 0);
+            #endif
+        }
+
+        std::uint64_t end() {
+            #ifdef __linux__
+            if(_fd == -1) return 0;
+            ioctl(_fd, PERF_EVENT_IOC_DISABLE, 0);
+            std::uint64_t value;
+            if(read(_fd, &value, sizeof(std::uint64_t)) != sizeof(std::uint64_t))
+                return 0; /* LCOV_EXCL_LINE */
+            return value;
+            #else
+            return 0;
+            #endif
+        }
+
+    private:
+        void close() {
+            #ifdef __linux__
+            if(_fd != -1) ::close(_fd);
+            _fd = -1;
+            #endif
+        }
+
+        #ifdef __linux__
+        int _fd{-1};
+        Event _event{};
+        #endif
+};
+
+/* Resets the peak resident set size of the process to the current value. On
+   Linux done through /proc/self/clear_refs, which is supported since 4.0.
+   Returns false if it can't be done, in which case peakResidentMemory()
+   returns the peak over the whole process lifetime. */
+inline bool resetPeakResidentMemory() {
+    #ifdef __linux__
+    std::FILE* const f = std::fopen("/proc/self/clear_refs", "w");
+    if(!f) return false;
+    const bool written = std::fputs("5", f) >= 0;
+    /* The write is buffered, errors are reported only on close */
+    return std::fclose(f) == 0 && written;
+    #else
+    return false;
+    #endif
+}
+
+/* Peak resident set size of the process in bytes, zero if unknown */
+inline std::uint64_t peakResidentMemory() {
+    #ifdef __linux__
+    std::FILE* const f = std::fopen("/proc/self/status", "r");
+    if(!f) return 0; /* LCOV_EXCL_LINE */
+    std::uint64_t value = 0;
+    char line[256];
+    while(std::fgets(line, sizeof(line), f)) {
+        if(std::strncmp(line, "VmHWM:", 6) != 0) continue;
+        value = std::strtoull(line + 6, nullptr, 10)*1024;
+        break;
+    }
+    std::fclose(f);
+    return value;
+    #else
+    return 0;
+    #endif
+}
+
 }}}
 
 #endif
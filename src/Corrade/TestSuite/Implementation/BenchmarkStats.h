@@ -26,14 +26,17 @@
 */
 
 #include <cstdint>
+#include <algorithm>
 #include <iomanip>
 #include <limits>
 #include <sstream>
-#ifdef _MSC_VER
-#include <algorithm> /* std::max() */
-#endif
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 #include "Corrade/Containers/ArrayView.h"
+#include "Corrade/Utility/Assert.h"
 #include "Corrade/Utility/DebugStl.h"
 #include "Corrade/Utility/StlMath.h"
 
@@ -72,6 +75,219 @@ inline std::tuple<double, double, Utility::Debug::Color> calculateStats(const Co
     return std::make_tuple(mean, stddev, color);
 }
 
+/* Two-sided Mann-Whitney U test, returning the p-value of the hypothesis
+   that both sample sets come from the same distribution. Uses the normal
+   approximation with tie and continuity correction, which is reasonably
+   accurate already for sample counts above ~8. */
+inline double mannWhitneyU(const Containers::ArrayView<const double> a, const Containers::ArrayView<const double> b) {
+    if(a.empty() || b.empty()) return 1.0;
+
+    /* Sort all samples together, remembering where they came from */
+    std::vector<std::pair<double, bool>> samples;
+    samples.reserve(a.size() + b.size());
+    for(double v: a) samples.emplace_back(v, true);
+    for(double v: b) samples.emplace_back(v, false);
+    std::sort(samples.begin(), samples.end());
+
+    /* Sum ranks of the first set, ties get an average rank */
+    double rankSumA{}, tieSum{};
+    for(std::size_t i = 0; i != samples.size(); ) {
+        std::size_t j = i + 1;
+        while(j != samples.size() && samples[j].first == samples[i].first) ++j;
+
+        const double rank = 0.5*double(i + j + 1);
+        for(std::size_t k = i; k != j; ++k)
+            if(samples[k].second) rankSumA += rank;
+
+        const double t = double(j - i);
+        tieSum += t*t*t - t;
+        i = j;
+    }
+
+    const double n1 = double(a.size()), n2 = double(b.size()), n = n1 + n2;
+    const double u = rankSumA - n1*(n1 + 1.0)*0.5;
+    const double mean = n1*n2*0.5;
+    const double variance = n1*n2/12.0*((n + 1.0) - tieSum/(n*(n - 1.0)));
+
+    /* All samples are equal, no difference */
+    if(variance <= 0.0) return 1.0;
+
+    const double z = std::max(std::abs(u - mean) - 0.5, 0.0)/std::sqrt(variance);
+    return std::erfc(z/std::sqrt(2.0));
+}
+
+/* Percentile of given samples, linearly interpolated between closest ranks.
+   The percentile is expected to be in the [0, 1] range. */
+inline double percentile(std::vector<double> values, const double percentile) {
+    if(values.empty()) return std::numeric_limits<double>::quiet_NaN();
+
+    std::sort(values.begin(), values.end());
+    const double position = percentile*double(values.size() - 1);
+    const std::size_t index = std::size_t(position);
+    if(index + 1 >= values.size()) return values.back();
+    return values[index] + (values[index + 1] - values[index])*(position - double(index));
+}
+
+/* Median of given samples */
+inline double median(std::vector<double> values) {
+    return percentile(std::move(values), 0.5);
+}
+
+/* Returns measurements that are not further than given threshold from the
+   median, with the threshold being a multiple of median absolute deviation
+   scaled to be comparable with standard deviation of normally distributed
+   data. If the threshold is zero or the deviation is zero (i.e., more than
+   half of the samples is the same), nothing is rejected. */
+inline std::vector<std::uint64_t> rejectOutliers(const Containers::ArrayView<const std::uint64_t> measurements, const double threshold) {
+    std::vector<std::uint64_t> out{measurements.begin(), measurements.end()};
+    if(threshold <= 0.0 || measurements.size() < 3) return out;
+
+    std::vector<double> values{measurements.begin(), measurements.end()};
+    const double center = median(values);
+    for(double& v: values) v = std::abs(v - center);
+    const double deviation = 1.4826*median(values);
+    if(deviation == 0.0) return out;
+
+    out.erase(std::remove_if(out.begin(), out.end(), [&](const std::uint64_t v) {
+        return std::abs(double(v) - center) > threshold*deviation;
+    }), out.end());
+    return out;
+}
+
+/* Ratio of the mean of b to the mean of a, with a and b being paired
+   measurements of the same count, and a half-width of its 95% confidence
+   interval. Calculated from differences of the pairs, with pairs whose
+   difference is further than given threshold from the median rejected the
+   same way as in rejectOutliers(). Returns also the count of pairs used, the
+   interval is NaN if there's less than two. */
+inline std::tuple<double, double, std::size_t> pairedRatio(const Containers::ArrayView<const std::uint64_t> a, const std::size_t batchSizeA, const Containers::ArrayView<const std::uint64_t> b, const std::size_t batchSizeB, const double threshold) {
+    CORRADE_INTERNAL_ASSERT(a.size() == b.size());
+    if(a.empty() || !batchSizeA || !batchSizeB)
+        return std::make_tuple(std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), std::size_t{});
+
+    std::vector<double> differences;
+    differences.reserve(a.size());
+    for(std::size_t i = 0; i != a.size(); ++i)
+        differences.push_back(double(b[i])/double(batchSizeB) - double(a[i])/double(batchSizeA));
+
+    /* Reject outliers */
+    double center{}, deviation{};
+    if(threshold > 0.0 && differences.size() >= 3) {
+        center = median(differences);
+        std::vector<double> deviations{differences};
+        for(double& v: deviations) v = std::abs(v - center);
+        deviation = 1.4826*median(deviations);
+    }
+
+    double meanA{}, meanDifference{};
+    std::size_t count{};
+    for(std::size_t i = 0; i != a.size(); ++i) {
+        if(deviation != 0.0 && std::abs(differences[i] - center) > threshold*deviation) continue;
+        meanA += double(a[i])/double(batchSizeA);
+        meanDifference += differences[i];
+        ++count;
+    }
+    meanA /= double(count);
+    meanDifference /= double(count);
+
+    double variance{};
+    for(std::size_t i = 0; i != a.size(); ++i) {
+        if(deviation != 0.0 && std::abs(differences[i] - center) > threshold*deviation) continue;
+        const double dev = differences[i] - meanDifference;
+        variance += dev*dev/double(count - 1);
+    }
+
+    const double interval = count < 2 ? std::numeric_limits<double>::quiet_NaN() : 1.96*std::sqrt(variance/double(count))/std::abs(meanA);
+    return std::make_tuple((meanA + meanDifference)/meanA, interval, count);
+}
+
+/* Complexity classes considered by fitComplexity(), ordered from the
+   slowest-growing */
+enum class Complexity {
+    Constant, Logarithmic, Linear, Linearithmic, Quadratic, Cubic
+};
+
+inline const char* complexityName(const Complexity complexity) {
+    switch(complexity) {
+        case Complexity::Constant: return "O(1)";
+        case Complexity::Logarithmic: return "O(log n)";
+        case Complexity::Linear: return "O(n)";
+        case Complexity::Linearithmic: return "O(n log n)";
+        case Complexity::Quadratic: return "O(n^2)";
+        case Complexity::Cubic: return "O(n^3)";
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+inline double complexityFunction(const Complexity complexity, const double n) {
+    switch(complexity) {
+        case Complexity::Constant: return 1.0;
+        case Complexity::Logarithmic: return std::log2(n);
+        case Complexity::Linear: return n;
+        case Complexity::Linearithmic: return n*std::log2(n);
+        case Complexity::Quadratic: return n*n;
+        case Complexity::Cubic: return n*n*n;
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+/* Fits values measured for given sizes with c*f(n) for each complexity class
+   using least squares, returning the class with the lowest RMS error and the
+   error relative to the mean of the values. If two classes fit equally well,
+   the slower-growing one is picked. Expects at least one size and values to
+   have the same size as sizes. */
+inline std::pair<Complexity, double> fitComplexity(const Containers::ArrayView<const std::size_t> sizes, const Containers::ArrayView<const double> values) {
+    CORRADE_INTERNAL_ASSERT(!sizes.empty() && sizes.size() == values.size());
+
+    double mean = 0.0;
+    for(const double v: values) mean += v;
+    mean /= double(values.size());
+
+    std::pair<Complexity, double> best{Complexity::Constant, std::numeric_limits<double>::infinity()};
+    for(const Complexity complexity: {Complexity::Constant, Complexity::Logarithmic, Complexity::Linear, Complexity::Linearithmic, Complexity::Quadratic, Complexity::Cubic}) {
+        /* For a single coefficient the least-squares solution is
+           sum(v*f)/sum(f*f) */
+        double sumVF = 0.0, sumFF = 0.0;
+        for(std::size_t i = 0; i != sizes.size(); ++i) {
+            const double f = complexityFunction(complexity, double(sizes[i]));
+            sumVF += values[i]*f;
+            sumFF += f*f;
+        }
+        if(sumFF == 0.0) continue;
+        const double coefficient = sumVF/sumFF;
+
+        double sumError = 0.0;
+        for(std::size_t i = 0; i != sizes.size(); ++i) {
+            const double error = values[i] - coefficient*complexityFunction(complexity, double(sizes[i]));
+            sumError += error*error;
+        }
+        const double rms = std::sqrt(sumError/double(sizes.size()));
+        if(rms < best.second) best = {complexity, rms};
+    }
+
+    best.second = mean != 0.0 ? best.second/std::abs(mean) : 0.0;
+    return best;
+}
+
+/* Indices i of consecutive sizes i - 1 and i where the value per c*f(n),
+   with f given by the complexity class, grows by given factor or more. Used
+   to detect a working set no longer fitting into a cache. */
+inline std::vector<std::size_t> complexityKnees(const Containers::ArrayView<const std::size_t> sizes, const Containers::ArrayView<const double> values, const Complexity complexity, const double factor) {
+    CORRADE_INTERNAL_ASSERT(sizes.size() == values.size());
+
+    std::vector<std::size_t> out;
+    for(std::size_t i = 1; i < sizes.size(); ++i) {
+        const double previous = values[i - 1]/complexityFunction(complexity, double(sizes[i - 1]));
+        const double current = values[i]/complexityFunction(complexity, double(sizes[i]));
+        /* Size 1 makes O(log n) and O(n log n) zero, skip those */
+        if(!(previous > 0.0) || !std::isfinite(previous) || !std::isfinite(current)) continue;
+        if(current >= factor*previous) out.push_back(i);
+    }
+    return out;
+}
+
 inline void printValue(Utility::Debug& out, const double mean, const double stddev, const Utility::Debug::Color color, const double divisor, const char* const unitPrefix, const char* const unit) {
     std::ostringstream meanFormatter, stddevFormatter;
     meanFormatter << std::right << std::fixed << std::setprecision(2) << std::setw(6) << mean/divisor;
@@ -97,52 +313,83 @@ inline void printValue(Utility::Debug& out, const double mean, const double stdd
     }
 }
 
-inline void printTime(Utility::Debug& out, const double mean, const double stddev, const Utility::Debug::Color color) {
-    const double max = std::max(mean, stddev);
-
-    if(max >= 1000000000.0)
-        printValue(out, mean, stddev, color, 1000000000.0, " ", "s");
-    else if(max >= 1000000.0)
-        printValue(out, mean, stddev, color, 1000000.0, "m", "s");
-    else if(max >= 1000.0)
-        printValue(out, mean, stddev, color, 1000.0, "µ", "s");
-    else
-        printValue(out, mean, stddev, color, 1.0, "n", "s");
-}
-
-inline void printCount(Utility::Debug& out, const double mean, const double stddev, const Utility::Debug::Color color, double multiplier, const char* const unit) {
-    double max = std::max(mean, stddev);
-
-    if(max >= multiplier*multiplier*multiplier)
-        printValue(out, mean, stddev, color, multiplier*multiplier*multiplier, "G", unit);
-    else if(max >= multiplier*multiplier)
-        printValue(out, mean, stddev, color, multiplier*multiplier, "M", unit);
-    else if(max >= multiplier)
-        printValue(out, mean, stddev, color, multiplier, "k", unit);
-    else
-        printValue(out, mean, stddev, color, 1.0, " ", unit);
-}
+/* Returns a divisor, unit prefix and unit for given value magnitude */
+inline std::tuple<double, const char*, const char*> unitScale(const double max, const Tester::BenchmarkUnits unit) {
+    if(unit == Tester::BenchmarkUnits::Nanoseconds) {
+        if(max >= 1000000000.0)
+            return std::make_tuple(1000000000.0, " ", "s");
+        if(max >= 1000000.0)
+            return std::make_tuple(1000000.0, "m", "s");
+        if(max >= 1000.0)
+            return std::make_tuple(1000.0, "µ", "s");
+        return std::make_tuple(1.0, "n", "s");
+    }
 
-inline void printStats(Utility::Debug& out, const double mean, const double stddev, const Utility::Debug::Color color, const Tester::BenchmarkUnits unit) {
+    double multiplier = 1000.0;
+    const char* unitName{};
     switch(unit) {
-        case Tester::BenchmarkUnits::Nanoseconds:
-            printTime(out, mean, stddev, color);
-            return;
         case Tester::BenchmarkUnits::Cycles:
-            printCount(out, mean, stddev, color, 1000.0, "C");
-            return;
+            unitName = "C";
+            break;
         case Tester::BenchmarkUnits::Instructions:
-            printCount(out, mean, stddev, color, 1000.0, "I");
-            return;
+            unitName = "I";
+            break;
         case Tester::BenchmarkUnits::Bytes:
-            printCount(out, mean, stddev, color, 1024.0, "B");
-            return;
+            multiplier = 1024.0;
+            unitName = "B";
+            break;
         case Tester::BenchmarkUnits::Count:
-            printCount(out, mean, stddev, color, 1000.0, " ");
-            return;
+            unitName = " ";
+            break;
+        /* LCOV_EXCL_START */
+        case Tester::BenchmarkUnits::Nanoseconds:
+            CORRADE_ASSERT_UNREACHABLE();
+        /* LCOV_EXCL_STOP */
     }
 
-    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    if(max >= multiplier*multiplier*multiplier)
+        return std::make_tuple(multiplier*multiplier*multiplier, "G", unitName);
+    if(max >= multiplier*multiplier)
+        return std::make_tuple(multiplier*multiplier, "M", unitName);
+    if(max >= multiplier)
+        return std::make_tuple(multiplier, "k", unitName);
+    return std::make_tuple(1.0, " ", unitName);
+}
+
+inline void printStats(Utility::Debug& out, const double mean, const double stddev, const Utility::Debug::Color color, const Tester::BenchmarkUnits unit) {
+    double divisor;
+    const char* unitPrefix;
+    const char* unitName;
+    std::tie(divisor, unitPrefix, unitName) = unitScale(std::max(mean, stddev), unit);
+    printValue(out, mean, stddev, color, divisor, unitPrefix, unitName);
+}
+
+/* Compact formatting of a single value, such as "15.27 µs" or "3.00" */
+inline std::string formatValue(const double value, const Tester::BenchmarkUnits unit) {
+    double divisor;
+    const char* unitPrefix;
+    const char* unitName;
+    std::tie(divisor, unitPrefix, unitName) = unitScale(value, unit);
+
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(2) << value/divisor;
+    std::string suffix = std::string{unitPrefix} + unitName;
+    suffix.erase(std::remove(suffix.begin(), suffix.end(), ' '), suffix.end());
+    if(!suffix.empty()) out << ' ' << suffix;
+    return out.str();
+}
+
+/* Throughput per second, such as "1.86 GB/s" or "3.00 Mitems/s" */
+inline std::string formatThroughput(const double value, const Tester::BenchmarkUnits unit) {
+    double divisor;
+    const char* unitPrefix;
+    std::tie(divisor, unitPrefix, std::ignore) = unitScale(value, unit);
+
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(2) << value/divisor << ' ';
+    if(unitPrefix[0] != ' ') out << unitPrefix;
+    out << (unit == Tester::BenchmarkUnits::Bytes ? "B/s" : "items/s");
+    return out.str();
 }
 
 }}}
@@ -0,0 +1,107 @@
+#ifndef Corrade_TestSuite_Implementation_FileContents_h
+#define Corrade_TestSuite_Implementation_FileContents_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <string>
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Utility/DebugStl.h"
+#include "Corrade/Utility/Directory.h"
+
+namespace Corrade { namespace TestSuite { namespace Implementation {
+
+/* File contents for the file comparators. Memory-mapped where possible so
+   even huge files don't need to be read into memory first, falling back to
+   reading the file for empty files, which can't be mapped, and on platforms
+   without memory mapping. */
+class FileContents {
+    public:
+        bool open(const std::string& filename) {
+            #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+            {
+                Utility::Error silenceError{nullptr};
+                _mapped = Utility::Directory::mapRead(filename, Utility::Directory::MapFlag::Sequential);
+            }
+            if(_mapped) {
+                _data = _mapped;
+                return true;
+            }
+            #endif
+
+            if(!Utility::Directory::read(filename, _read)) return false;
+            _data = _read;
+            return true;
+        }
+
+        Containers::ArrayView<const char> data() const { return _data; }
+
+    private:
+        #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+        Containers::Array<const char, Utility::Directory::MapDeleter> _mapped;
+        #endif
+        Containers::Array<char> _read;
+        Containers::ArrayView<const char> _data;
+};
+
+/* Position of the first differing byte, or size of the smaller of the two if
+   one is a prefix of the other. The memcmp() is vectorized in all common
+   standard libraries, so it's used to find the first differing block and only
+   that is then checked byte by byte. */
+inline std::size_t firstDifference(const Containers::ArrayView<const char> a, const Containers::ArrayView<const char> b) {
+    enum: std::size_t { BlockSize = 4096 };
+    const std::size_t size = a.size() < b.size() ? a.size() : b.size();
+    std::size_t i = 0;
+    for(; i + BlockSize <= size; i += BlockSize)
+        if(std::memcmp(a.data() + i, b.data() + i, BlockSize) != 0) break;
+    for(; i != size; ++i)
+        if(a[i] != b[i]) break;
+    return i;
+}
+
+/* Prints only the size difference and the first differing byte, which is
+   the only thing that makes sense for arbitrarily large files */
+inline void printFileDifference(Utility::Debug& out, const char* const actual, const char* const expected, const Containers::ArrayView<const char> actualContents, const Containers::ArrayView<const char> expectedContents, const std::size_t position) {
+    out << "Files" << actual << "and" << expected << "have different";
+    if(actualContents.size() != expectedContents.size())
+        out << "size, actual" << actualContents.size() << "but" << expectedContents.size() << "expected.";
+    else
+        out << "contents.";
+
+    /** @todo do this without std::string */
+    if(actualContents.size() <= position)
+        out << "Expected has character" << std::string() + expectedContents[position];
+    else if(expectedContents.size() <= position)
+        out << "Actual has character" << std::string() + actualContents[position];
+    else
+        out << "Actual character" << std::string() + actualContents[position] << "but" << std::string() + expectedContents[position] << "expected";
+
+    out << "on position" << position << Utility::Debug::nospace << ".";
+}
+
+}}}
+
+#endif
@@ -0,0 +1,224 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstdlib>
+#include <sstream>
+
+#include "Corrade/Containers/ArrayView.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/AllocationCounter.h"
+#include "Corrade/Utility/DebugStl.h"
+
+namespace Corrade { namespace TestSuite { namespace Test { namespace {
+
+void* volatile mallocSink;
+std::int32_t* volatile newSink;
+
+struct Test: Tester {
+    explicit Test(const TesterConfiguration& configuration);
+
+    void allocate();
+    void noAllocation();
+};
+
+Test::Test(const TesterConfiguration& configuration): Tester{configuration} {
+    addBenchmarks({&Test::allocate,
+                   &Test::noAllocation}, 3, BenchmarkType::AllocationCount);
+    addBenchmarks({&Test::allocate}, 3, BenchmarkType::AllocatedBytes);
+    addBenchmarks({&Test::allocate}, 3);
+}
+
+void Test::allocate() {
+    CORRADE_BENCHMARK(10) {
+        mallocSink = std::malloc(100);
+        std::free(mallocSink);
+        newSink = new std::int32_t{};
+        delete newSink;
+    }
+}
+
+void Test::noAllocation() {
+    int* volatile a = nullptr;
+    CORRADE_BENCHMARK(10) {
+        a = a + 1;
+    }
+}
+
+struct BudgetTest: Tester {
+    explicit BudgetTest();
+
+    void withinBudget();
+    void exceeded();
+    void expectFail();
+    void unexpectedPass();
+    void failInside();
+};
+
+BudgetTest::BudgetTest() {
+    addTests({&BudgetTest::withinBudget,
+              &BudgetTest::exceeded,
+              &BudgetTest::expectFail,
+              &BudgetTest::unexpectedPass,
+              &BudgetTest::failInside,
+              &BudgetTest::withinBudget});
+}
+
+void BudgetTest::withinBudget() {
+    CORRADE_EXPECT_MAX_ALLOCATIONS(2) {
+        mallocSink = std::malloc(100);
+        std::free(mallocSink);
+        newSink = new std::int32_t{};
+        delete newSink;
+    }
+}
+
+void BudgetTest::exceeded() {
+    CORRADE_EXPECT_MAX_ALLOCATIONS(1) {
+        mallocSink = std::malloc(100);
+        std::free(mallocSink);
+        newSink = new std::int32_t{};
+        delete newSink;
+    }
+}
+
+void BudgetTest::expectFail() {
+    CORRADE_EXPECT_FAIL("Not optimized yet.");
+    CORRADE_EXPECT_MAX_ALLOCATIONS(0) {
+        mallocSink = std::malloc(100);
+        std::free(mallocSink);
+    }
+}
+
+void BudgetTest::unexpectedPass() {
+    CORRADE_EXPECT_FAIL("Not optimized yet.");
+    CORRADE_EXPECT_MAX_ALLOCATIONS(0) {}
+}
+
+void BudgetTest::failInside() {
+    CORRADE_EXPECT_MAX_ALLOCATIONS(10) {
+        mallocSink = std::malloc(100);
+        std::free(mallocSink);
+        CORRADE_VERIFY(false);
+    }
+}
+
+struct AllocationCounterTest: Tester {
+    explicit AllocationCounterTest();
+
+    void countAndBytes();
+    void defaultBenchmark();
+    void budget();
+};
+
+AllocationCounterTest::AllocationCounterTest() {
+    addTests({&AllocationCounterTest::countAndBytes,
+              &AllocationCounterTest::defaultBenchmark,
+              &AllocationCounterTest::budget});
+}
+
+void AllocationCounterTest::countAndBytes() {
+    std::stringstream out;
+
+    const char* argv[] = { "", "--color", "off", "--only", "1 2 3" };
+    int argc = Containers::arraySize(argv);
+    Tester::registerArguments(argc, argv);
+
+    Test t{TesterConfiguration{}
+        #ifdef __linux__
+        .setCpuScalingGovernorFile("")
+        .setCpuBoostFile("")
+        .setCpuNoTurboFile("")
+        .setCpuInfoFile("")
+        #endif
+    };
+    t.registerTest("here.cpp", "AllocationCounterTest::Test");
+    int result = t.exec(&out, &out);
+
+    CORRADE_COMPARE(result, 0);
+    CORRADE_COMPARE(out.str(),
+        "Starting AllocationCounterTest::Test with 3 test cases...\n"
+        " BENCH [1]   2.00 ± 0.00      allocate()@2x10 (allocations)\n"
+        " BENCH [2]   0.00 ± 0.00      noAllocation()@2x10 (allocations)\n"
+        " BENCH [3] 104.00 ± 0.00    B allocate()@2x10 (allocated bytes)\n"
+        "Finished AllocationCounterTest::Test with 0 errors out of 0 checks.\n");
+}
+
+void AllocationCounterTest::defaultBenchmark() {
+    std::stringstream out;
+
+    const char* argv[] = { "", "--color", "off", "--only", "4", "--benchmark", "allocation-count" };
+    int argc = Containers::arraySize(argv);
+    Tester::registerArguments(argc, argv);
+
+    Test t{TesterConfiguration{}
+        #ifdef __linux__
+        .setCpuScalingGovernorFile("")
+        .setCpuBoostFile("")
+        .setCpuNoTurboFile("")
+        .setCpuInfoFile("")
+        #endif
+    };
+    t.registerTest("here.cpp", "AllocationCounterTest::Test");
+    int result = t.exec(&out, &out);
+
+    CORRADE_COMPARE(result, 0);
+    CORRADE_COMPARE(out.str(),
+        "Starting AllocationCounterTest::Test with 1 test cases...\n"
+        " BENCH [4]   2.00 ± 0.00      allocate()@2x10 (allocations)\n"
+        "Finished AllocationCounterTest::Test with 0 errors out of 0 checks.\n");
+}
+
+void AllocationCounterTest::budget() {
+    std::stringstream out;
+
+    const char* argv[] = { "", "--color", "off" };
+    int argc = Containers::arraySize(argv);
+    Tester::registerArguments(argc, argv);
+
+    BudgetTest t;
+    t.registerTest("here.cpp", "AllocationCounterTest::BudgetTest");
+    int result = t.exec(&out, &out);
+
+    /* The last test case verifies that the counter isn't left in a broken
+       state by the failure inside the block */
+    CORRADE_COMPARE(result, 1);
+    CORRADE_COMPARE(out.str(),
+        "Starting AllocationCounterTest::BudgetTest with 6 test cases...\n"
+        "    OK [1] withinBudget()\n"
+        "  FAIL [2] exceeded() at here.cpp on line 98\n"
+        "        Allocation count 2 exceeded the budget of 1.\n"
+        " XFAIL [3] expectFail() at here.cpp on line 108\n"
+        "        Not optimized yet. Allocation count 1 exceeded the budget of 0.\n"
+        " XPASS [4] unexpectedPass() at here.cpp on line 116\n"
+        "        Allocation count 0 was expected to exceed the budget of 0.\n"
+        "  FAIL [5] failInside() at here.cpp on line 123\n"
+        "        Expression false failed.\n"
+        "    OK [6] withinBudget()\n"
+        "Finished AllocationCounterTest::BudgetTest with 3 errors out of 6 checks.\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::TestSuite::Test::AllocationCounterTest)
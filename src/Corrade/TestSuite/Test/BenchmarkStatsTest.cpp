@@ -26,6 +26,8 @@
 #include <limits>
 
 #include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Container.h"
+#include "Corrade/TestSuite/Compare/Numeric.h"
 
 #include "Corrade/TestSuite/Implementation/BenchmarkStats.h"
 
@@ -42,6 +44,29 @@ struct BenchmarkStatsTest: Tester {
     void calculateSingleValue();
 
     void print();
+
+    void percentile();
+    void median();
+    void rejectOutliers();
+    void rejectOutliersZeroDeviation();
+    void rejectOutliersDisabled();
+    void formatValue();
+    void formatThroughput();
+    void mannWhitneyU();
+    void mannWhitneyUTies();
+    void mannWhitneyUSwapped();
+    void mannWhitneyUAllEqual();
+    void mannWhitneyUEmpty();
+    void pairedRatio();
+    void pairedRatioBatchSize();
+    void pairedRatioOutliers();
+    void pairedRatioSinglePair();
+    void pairedRatioEmpty();
+
+    void fitComplexity();
+    void fitComplexityNoise();
+    void fitComplexityConstant();
+    void complexityKnees();
 };
 
 enum: std::size_t { MultiplierDataCount = 14 };
@@ -94,6 +119,29 @@ BenchmarkStatsTest::BenchmarkStatsTest() {
               &BenchmarkStatsTest::calculateSingleValue});
 
     addInstancedTests({&BenchmarkStatsTest::print}, MultiplierDataCount);
+
+    addTests({&BenchmarkStatsTest::percentile,
+              &BenchmarkStatsTest::median,
+              &BenchmarkStatsTest::rejectOutliers,
+              &BenchmarkStatsTest::rejectOutliersZeroDeviation,
+              &BenchmarkStatsTest::rejectOutliersDisabled,
+              &BenchmarkStatsTest::formatValue,
+              &BenchmarkStatsTest::formatThroughput,
+              &BenchmarkStatsTest::mannWhitneyU,
+              &BenchmarkStatsTest::mannWhitneyUTies,
+              &BenchmarkStatsTest::mannWhitneyUSwapped,
+              &BenchmarkStatsTest::mannWhitneyUAllEqual,
+              &BenchmarkStatsTest::mannWhitneyUEmpty,
+              &BenchmarkStatsTest::pairedRatio,
+              &BenchmarkStatsTest::pairedRatioBatchSize,
+              &BenchmarkStatsTest::pairedRatioOutliers,
+              &BenchmarkStatsTest::pairedRatioSinglePair,
+              &BenchmarkStatsTest::pairedRatioEmpty,
+
+              &BenchmarkStatsTest::fitComplexity,
+              &BenchmarkStatsTest::fitComplexityNoise,
+              &BenchmarkStatsTest::fitComplexityConstant,
+              &BenchmarkStatsTest::complexityKnees});
 }
 
 /* Stolen from https://en.wikipedia.org/wiki/Standard_deviation */
@@ -173,6 +221,212 @@ void BenchmarkStatsTest::print() {
         MultiplierData[testCaseInstanceId()].expected);
 }
 
+void BenchmarkStatsTest::percentile() {
+    const std::vector<double> values{40.0, 10.0, 30.0, 20.0, 50.0};
+    CORRADE_COMPARE(Implementation::percentile(values, 0.0), 10.0);
+    CORRADE_COMPARE(Implementation::percentile(values, 0.5), 30.0);
+    CORRADE_COMPARE(Implementation::percentile(values, 0.9), 46.0);
+    CORRADE_COMPARE(Implementation::percentile(values, 0.99), 49.6);
+    CORRADE_COMPARE(Implementation::percentile(values, 1.0), 50.0);
+    CORRADE_COMPARE(Implementation::percentile({7.0}, 0.9), 7.0);
+    CORRADE_COMPARE(Implementation::percentile({}, 0.9), std::numeric_limits<double>::quiet_NaN());
+}
+
+void BenchmarkStatsTest::median() {
+    CORRADE_COMPARE(Implementation::median({5.0, 1.0, 3.0}), 3.0);
+    CORRADE_COMPARE(Implementation::median({5.0, 1.0, 3.0, 2.0}), 2.5);
+    CORRADE_COMPARE(Implementation::median({}), std::numeric_limits<double>::quiet_NaN());
+}
+
+void BenchmarkStatsTest::rejectOutliers() {
+    /* Median is 45, MAD is 5, scaled 7.413. The 20 is 25 from the median
+       and stays with threshold 4, 90 is 45 from the median and gets
+       rejected. */
+    const std::vector<std::uint64_t> out = Implementation::rejectOutliers(Measurements, 4.0);
+    CORRADE_COMPARE(out.size(), 7);
+    CORRADE_COMPARE(out.front(), 20);
+    CORRADE_COMPARE(out.back(), 70);
+
+    /* With a lower threshold also the 20 and 70 get rejected */
+    CORRADE_COMPARE(Implementation::rejectOutliers(Measurements, 2.0).size(), 5);
+}
+
+void BenchmarkStatsTest::rejectOutliersZeroDeviation() {
+    /* More than half of the values is the same, nothing is rejected */
+    const std::uint64_t measurements[]{ 10, 10, 10, 10, 7000 };
+    CORRADE_COMPARE(Implementation::rejectOutliers(measurements, 3.0).size(), 5);
+}
+
+void BenchmarkStatsTest::rejectOutliersDisabled() {
+    CORRADE_COMPARE(Implementation::rejectOutliers(Measurements, 0.0).size(), 8);
+    /* Not enough values to decide */
+    CORRADE_COMPARE(Implementation::rejectOutliers(Containers::ArrayView<const std::uint64_t>{Measurements}.prefix(2), 0.1).size(), 2);
+}
+
+void BenchmarkStatsTest::formatValue() {
+    CORRADE_COMPARE(Implementation::formatValue(15270.0, Tester::BenchmarkUnits::Nanoseconds), "15.27 µs");
+    CORRADE_COMPARE(Implementation::formatValue(2500000000.0, Tester::BenchmarkUnits::Nanoseconds), "2.50 s");
+    CORRADE_COMPARE(Implementation::formatValue(2048.0, Tester::BenchmarkUnits::Bytes), "2.00 kB");
+    CORRADE_COMPARE(Implementation::formatValue(3.0, Tester::BenchmarkUnits::Count), "3.00");
+    CORRADE_COMPARE(Implementation::formatValue(3000.0, Tester::BenchmarkUnits::Count), "3.00 k");
+}
+
+void BenchmarkStatsTest::formatThroughput() {
+    CORRADE_COMPARE(Implementation::formatThroughput(2147483648.0, Tester::BenchmarkUnits::Bytes), "2.00 GB/s");
+    CORRADE_COMPARE(Implementation::formatThroughput(512.0, Tester::BenchmarkUnits::Bytes), "512.00 B/s");
+    CORRADE_COMPARE(Implementation::formatThroughput(3000000.0, Tester::BenchmarkUnits::Count), "3.00 Mitems/s");
+    CORRADE_COMPARE(Implementation::formatThroughput(3.0, Tester::BenchmarkUnits::Count), "3.00 items/s");
+}
+
+void BenchmarkStatsTest::mannWhitneyU() {
+    /* Verified against scipy.stats.mannwhitneyu() with
+       method="asymptotic" */
+    const double a[]{1.0, 2.0, 3.0, 4.0, 5.0};
+    const double b[]{6.0, 7.0, 8.0, 9.0, 10.0};
+    CORRADE_COMPARE(Implementation::mannWhitneyU(a, b), 0.012185780355344818);
+}
+
+void BenchmarkStatsTest::mannWhitneyUTies() {
+    const double a[]{1.0, 2.0, 2.0, 3.0};
+    const double b[]{2.0, 3.0, 4.0, 5.0};
+    CORRADE_COMPARE(Implementation::mannWhitneyU(a, b), 0.13665824773814753);
+}
+
+void BenchmarkStatsTest::mannWhitneyUSwapped() {
+    /* The test is two-sided, so the order shouldn't matter */
+    const double a[]{1.0, 2.0, 3.0, 4.0, 5.0};
+    const double b[]{6.0, 7.0, 8.0, 9.0, 10.0};
+    CORRADE_COMPARE(Implementation::mannWhitneyU(b, a), 0.012185780355344818);
+}
+
+void BenchmarkStatsTest::mannWhitneyUAllEqual() {
+    const double a[]{3.0, 3.0, 3.0};
+    CORRADE_COMPARE(Implementation::mannWhitneyU(a, a), 1.0);
+}
+
+void BenchmarkStatsTest::mannWhitneyUEmpty() {
+    const double a[]{3.0, 3.0, 3.0};
+    CORRADE_COMPARE(Implementation::mannWhitneyU(a, {}), 1.0);
+    CORRADE_COMPARE(Implementation::mannWhitneyU({}, a), 1.0);
+}
+
+void BenchmarkStatsTest::pairedRatio() {
+    /* Differences are 50, 55, 45, 50, with a mean of 50 and sample variance
+       of 50/3 */
+    const std::uint64_t a[]{100, 110, 90, 100};
+    const std::uint64_t b[]{150, 165, 135, 150};
+    double ratio, interval;
+    std::size_t count;
+    std::tie(ratio, interval, count) = Implementation::pairedRatio(a, 1, b, 1, 0.0);
+    CORRADE_COMPARE(ratio, 1.5);
+    CORRADE_COMPARE(interval, 1.96*std::sqrt(50.0/3.0/4.0)/100.0);
+    CORRADE_COMPARE(count, 4);
+}
+
+void BenchmarkStatsTest::pairedRatioBatchSize() {
+    /* Same as above, with the first batch being twice as large */
+    const std::uint64_t a[]{200, 220, 180, 200};
+    const std::uint64_t b[]{150, 165, 135, 150};
+    double ratio, interval;
+    std::size_t count;
+    std::tie(ratio, interval, count) = Implementation::pairedRatio(a, 2, b, 1, 0.0);
+    CORRADE_COMPARE(ratio, 1.5);
+    CORRADE_COMPARE(interval, 1.96*std::sqrt(50.0/3.0/4.0)/100.0);
+    CORRADE_COMPARE(count, 4);
+}
+
+void BenchmarkStatsTest::pairedRatioOutliers() {
+    /* Differences are 50, 52, 48, 50, 900, median is 50, MAD is 2, the last
+       pair gets rejected */
+    const std::uint64_t a[]{100, 100, 100, 100, 100};
+    const std::uint64_t b[]{150, 152, 148, 150, 1000};
+    double ratio, interval;
+    std::size_t count;
+    std::tie(ratio, interval, count) = Implementation::pairedRatio(a, 1, b, 1, 3.0);
+    CORRADE_COMPARE(ratio, 1.5);
+    CORRADE_COMPARE(interval, 1.96*std::sqrt(8.0/3.0/4.0)/100.0);
+    CORRADE_COMPARE(count, 4);
+
+    /* Without outlier rejection it's used as well */
+    std::tie(ratio, std::ignore, count) = Implementation::pairedRatio(a, 1, b, 1, 0.0);
+    CORRADE_COMPARE(ratio, 3.2);
+    CORRADE_COMPARE(count, 5);
+}
+
+void BenchmarkStatsTest::pairedRatioSinglePair() {
+    const std::uint64_t a[]{100};
+    const std::uint64_t b[]{50};
+    double ratio, interval;
+    std::size_t count;
+    std::tie(ratio, interval, count) = Implementation::pairedRatio(a, 1, b, 1, 3.0);
+    CORRADE_COMPARE(ratio, 0.5);
+    CORRADE_VERIFY(interval != interval);
+    CORRADE_COMPARE(count, 1);
+}
+
+void BenchmarkStatsTest::pairedRatioEmpty() {
+    double ratio, interval;
+    std::size_t count;
+    std::tie(ratio, interval, count) = Implementation::pairedRatio({}, 1, {}, 1, 3.0);
+    CORRADE_VERIFY(ratio != ratio);
+    CORRADE_VERIFY(interval != interval);
+    CORRADE_COMPARE(count, 0);
+}
+
+void BenchmarkStatsTest::fitComplexity() {
+    const std::size_t sizes[]{1024, 2048, 4096, 8192, 16384};
+
+    for(const Implementation::Complexity complexity: {
+        Implementation::Complexity::Logarithmic,
+        Implementation::Complexity::Linear,
+        Implementation::Complexity::Linearithmic,
+        Implementation::Complexity::Quadratic,
+        Implementation::Complexity::Cubic
+    }) {
+        double values[Containers::arraySize(sizes)];
+        for(std::size_t i = 0; i != Containers::arraySize(sizes); ++i)
+            values[i] = 2.5*Implementation::complexityFunction(complexity, double(sizes[i]));
+
+        const std::pair<Implementation::Complexity, double> fit = Implementation::fitComplexity(sizes, values);
+        CORRADE_COMPARE(std::string{Implementation::complexityName(fit.first)}, Implementation::complexityName(complexity));
+        CORRADE_COMPARE_AS(fit.second, 1.0e-9, Compare::Less);
+    }
+}
+
+void BenchmarkStatsTest::fitComplexityNoise() {
+    /* Linear with up to 10% deviations and a constant overhead still fits
+       linear the best */
+    const std::size_t sizes[]{1024, 2048, 4096, 8192, 16384, 32768};
+    const double values[]{1100.0, 1900.0, 4300.0, 7800.0, 16900.0, 32200.0};
+
+    const std::pair<Implementation::Complexity, double> fit = Implementation::fitComplexity(sizes, values);
+    CORRADE_COMPARE(int(fit.first), int(Implementation::Complexity::Linear));
+    CORRADE_COMPARE_AS(fit.second, 0.1, Compare::Less);
+}
+
+void BenchmarkStatsTest::fitComplexityConstant() {
+    const std::size_t sizes[]{16, 32, 64};
+    const double values[]{7.0, 7.0, 7.0};
+
+    const std::pair<Implementation::Complexity, double> fit = Implementation::fitComplexity(sizes, values);
+    CORRADE_COMPARE(int(fit.first), int(Implementation::Complexity::Constant));
+    CORRADE_COMPARE(fit.second, 0.0);
+}
+
+void BenchmarkStatsTest::complexityKnees() {
+    /* Linear, with the cost per item doubling between 4096 and 8192 and then
+       growing by 25% which is under the threshold */
+    const std::size_t sizes[]{1024, 2048, 4096, 8192, 16384};
+    const double values[]{1024.0, 2048.0, 4096.0, 16384.0, 40960.0};
+
+    const std::vector<std::size_t> knees = Implementation::complexityKnees(sizes, values, Implementation::Complexity::Linear, 1.5);
+    CORRADE_COMPARE_AS(knees, (std::vector<std::size_t>{3}), Compare::Container);
+
+    /* Nothing for a perfect fit */
+    const double linear[]{1024.0, 2048.0, 4096.0, 8192.0, 16384.0};
+    CORRADE_VERIFY(Implementation::complexityKnees(sizes, linear, Implementation::Complexity::Linear, 1.5).empty());
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Corrade::TestSuite::Test::BenchmarkStatsTest)
@@ -0,0 +1,195 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <algorithm>
+#include <random>
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/Utility/Algorithms.h"
+
+namespace Corrade { namespace TestSuite { namespace Test { namespace {
+
+/* Measures latency and bandwidth of the memory hierarchy, giving context for
+   interpreting other benchmarks on given machine. The sweeps go from a
+   working set that fits into L1 to one that's larger than a typical L3, the
+   knees in the output then show where the cache levels end. */
+struct MemoryBenchmark: Tester {
+    explicit MemoryBenchmark();
+
+    /* These are idempotent and passed also as teardown, as there's nothing
+       to tear down */
+    void setupChase();
+    void setupBuffer();
+    void setupThreaded();
+
+    void latency();
+    void read();
+    void write();
+    void copy();
+    void readThreaded();
+
+    /* Each node occupies a whole cache line so every access in the chase
+       touches a different one */
+    struct Node {
+        Node* next;
+        char padding[64 - sizeof(Node*)];
+    };
+
+    Containers::Array<Node> _nodes;
+    Containers::Array<char> _a, _b;
+    Containers::Array<Containers::Array<char>> _threadData;
+};
+
+constexpr std::size_t MinSize = 4*1024;
+constexpr std::size_t MaxSize = 32*1024*1024;
+constexpr std::size_t ThreadSize = 8*1024*1024;
+
+/* Each iteration of the bandwidth benchmarks goes through the whole buffer,
+   scale the iteration count so each sample processes roughly the same amount
+   of memory regardless of the size */
+std::size_t iterationCount(std::size_t size) {
+    return std::max(std::size_t{64*1024*1024}/size, std::size_t{1});
+}
+
+MemoryBenchmark::MemoryBenchmark() {
+    addSweepBenchmarks({&MemoryBenchmark::latency}, 5, MinSize, MaxSize,
+        &MemoryBenchmark::setupChase,
+        &MemoryBenchmark::setupChase);
+
+    addSweepBenchmarks({&MemoryBenchmark::read,
+                        &MemoryBenchmark::write,
+                        &MemoryBenchmark::copy}, 5, MinSize, MaxSize,
+        &MemoryBenchmark::setupBuffer,
+        &MemoryBenchmark::setupBuffer);
+
+    addThreadedBenchmarks({&MemoryBenchmark::readThreaded}, 5, 0,
+        &MemoryBenchmark::setupThreaded,
+        &MemoryBenchmark::setupThreaded);
+}
+
+void MemoryBenchmark::setupChase() {
+    /* The setup is called for every sample, build the chain only once for
+       each size */
+    const std::size_t count = testCaseSweepSize()/sizeof(Node);
+    if(_nodes.size() == count) return;
+
+    /* Link the nodes into a single cycle in a random order to defeat the
+       prefetcher. Default-seeded so the order is the same every run. */
+    _nodes = Containers::Array<Node>{Containers::ValueInit, count};
+    Containers::Array<std::size_t> order{Containers::NoInit, count};
+    for(std::size_t i = 0; i != count; ++i) order[i] = i;
+    std::shuffle(order.begin() + 1, order.end(), std::minstd_rand{});
+    for(std::size_t i = 0; i != count; ++i)
+        _nodes[order[i]].next = &_nodes[order[(i + 1) % count]];
+}
+
+void MemoryBenchmark::setupBuffer() {
+    const std::size_t size = testCaseSweepSize();
+    if(_a.size() == size) return;
+
+    _a = Containers::Array<char>{Containers::ValueInit, size};
+    _b = Containers::Array<char>{Containers::ValueInit, size};
+    for(std::size_t i = 0; i != size; ++i) _a[i] = char(i);
+}
+
+void MemoryBenchmark::setupThreaded() {
+    /* Each thread works on its own buffer. Called only in the first thread,
+       before the others start. */
+    const std::size_t count = testCaseThreadCount();
+    if(_threadData.size() == count) return;
+
+    _threadData = Containers::Array<Containers::Array<char>>{count};
+    for(Containers::Array<char>& data: _threadData)
+        data = Containers::Array<char>{Containers::DirectInit, ThreadSize, '\x01'};
+}
+
+void MemoryBenchmark::latency() {
+    /* Each iteration is one dependent load, so the time per iteration is the
+       load latency at given working set size */
+    const Node* node = &_nodes[0];
+    CORRADE_BENCHMARK(1000000)
+        node = node->next;
+
+    CORRADE_VERIFY(node);
+}
+
+CORRADE_NEVER_INLINE std::size_t sum(const Containers::ArrayView<const char> data) {
+    /* Summing whole words to not be bound by the arithmetic */
+    const std::size_t* const words = reinterpret_cast<const std::size_t*>(data.data());
+    const std::size_t count = data.size()/sizeof(std::size_t);
+    std::size_t out = 0;
+    for(std::size_t i = 0; i != count; ++i) out += words[i];
+    return out;
+}
+
+void MemoryBenchmark::read() {
+    setBenchmarkThroughput(_a.size(), BenchmarkUnits::Bytes);
+
+    std::size_t out = 0;
+    CORRADE_BENCHMARK(iterationCount(_a.size()))
+        out += sum(_a);
+
+    CORRADE_VERIFY(out);
+}
+
+void MemoryBenchmark::write() {
+    setBenchmarkThroughput(_b.size(), BenchmarkUnits::Bytes);
+
+    int value = 0;
+    CORRADE_BENCHMARK(iterationCount(_b.size()))
+        std::memset(_b.data(), ++value, _b.size());
+
+    CORRADE_COMPARE(_b.back(), char(value));
+}
+
+void MemoryBenchmark::copy() {
+    /* The throughput is the amount copied, the memory traffic is twice
+       that */
+    setBenchmarkThroughput(_a.size(), BenchmarkUnits::Bytes);
+
+    CORRADE_BENCHMARK(iterationCount(_a.size()))
+        Utility::copy(_a, _b);
+
+    CORRADE_COMPARE(_b.back(), _a.back());
+}
+
+void MemoryBenchmark::readThreaded() {
+    /* Only the first thread is allowed to set the throughput and verify */
+    const std::size_t threadId = testCaseThreadId();
+    if(!threadId) setBenchmarkThroughput(ThreadSize, BenchmarkUnits::Bytes);
+
+    const Containers::ArrayView<const char> data = _threadData[threadId];
+    std::size_t out = 0;
+    CORRADE_BENCHMARK(8)
+        out += sum(data);
+
+    if(!threadId) CORRADE_COMPARE(out, 8*ThreadSize/sizeof(std::size_t)*sum({"\x01\x01\x01\x01\x01\x01\x01\x01", sizeof(std::size_t)}));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::TestSuite::Test::MemoryBenchmark)
@@ -36,6 +36,11 @@
 
 #include "configure.h"
 
+#ifdef __linux__
+#include <sched.h>
+#include <sys/resource.h>
+#endif
+
 namespace Corrade { namespace TestSuite {
 
 class StringLength;
@@ -486,6 +491,269 @@ void Test::benchmarkSkip() {
     CORRADE_SKIP("Can't verify the measurements anyway.");
 }
 
+struct ThreadedTest: Tester {
+    explicit ThreadedTest(const TesterConfiguration& configuration = TesterConfiguration{});
+
+    void benchmark();
+    void setup();
+    void teardown();
+
+    std::size_t counts[4];
+    std::string log;
+};
+
+ThreadedTest::ThreadedTest(const TesterConfiguration& configuration): Tester{configuration} {
+    addThreadedBenchmarks({&ThreadedTest::benchmark}, 2, 3,
+        &ThreadedTest::setup,
+        &ThreadedTest::teardown);
+}
+
+void ThreadedTest::benchmark() {
+    std::size_t& count = counts[testCaseThreadId()];
+    CORRADE_BENCHMARK(5) ++count;
+}
+
+void ThreadedTest::setup() {
+    for(std::size_t& count: counts) count = 0;
+}
+
+void ThreadedTest::teardown() {
+    /* Called after all threads finish, so it can look at all counts */
+    log += std::to_string(testCaseThreadCount()) + ":";
+    for(std::size_t i = 0; i != testCaseThreadCount(); ++i)
+        log += " " + std::to_string(counts[i]);
+    log += "\n";
+}
+
+struct ThroughputTest: Tester {
+    explicit ThroughputTest(const TesterConfiguration& configuration = TesterConfiguration{});
+
+    void benchmarkBytes();
+    void benchmarkItems();
+    void benchmarkCycles();
+
+    void benchmarkBegin() {}
+    std::uint64_t benchmarkEnd() { return 2000; }
+};
+
+ThroughputTest::ThroughputTest(const TesterConfiguration& configuration): Tester{configuration} {
+    addCustomBenchmarks({&ThroughputTest::benchmarkBytes,
+                         &ThroughputTest::benchmarkItems}, 2,
+        &ThroughputTest::benchmarkBegin,
+        &ThroughputTest::benchmarkEnd,
+        BenchmarkUnits::Nanoseconds);
+
+    addCustomBenchmarks({&ThroughputTest::benchmarkCycles}, 2,
+        &ThroughputTest::benchmarkBegin,
+        &ThroughputTest::benchmarkEnd,
+        BenchmarkUnits::Cycles);
+}
+
+void ThroughputTest::benchmarkBytes() {
+    setBenchmarkThroughput(1048576, BenchmarkUnits::Bytes);
+    CORRADE_BENCHMARK(2) {}
+}
+
+void ThroughputTest::benchmarkItems() {
+    setBenchmarkThroughput(3, BenchmarkUnits::Count);
+    CORRADE_BENCHMARK(2) {}
+}
+
+void ThroughputTest::benchmarkCycles() {
+    setBenchmarkThroughput(3, BenchmarkUnits::Count);
+    CORRADE_BENCHMARK(2) {}
+}
+
+struct ResourceBudgetTest: Tester {
+    explicit ResourceBudgetTest();
+
+    void allocationsNotAvailable();
+    void time();
+    void timeExceeded();
+    void peakMemory();
+    void peakMemoryExceeded();
+};
+
+ResourceBudgetTest::ResourceBudgetTest() {
+    addTests({&ResourceBudgetTest::allocationsNotAvailable,
+              &ResourceBudgetTest::time,
+              &ResourceBudgetTest::timeExceeded,
+              &ResourceBudgetTest::peakMemory,
+              &ResourceBudgetTest::peakMemoryExceeded});
+}
+
+void ResourceBudgetTest::allocationsNotAvailable() {
+    CORRADE_EXPECT_MAX_ALLOCATIONS(100) {}
+}
+
+void ResourceBudgetTest::time() {
+    CORRADE_EXPECT_MAX_TIME(10000.0) {}
+}
+
+void ResourceBudgetTest::timeExceeded() {
+    /* Nothing takes zero time */
+    CORRADE_EXPECT_MAX_TIME(0.0) {
+        int volatile a = 0;
+        for(int i = 0; i != 1000; ++i) a = a + 1;
+    }
+}
+
+void ResourceBudgetTest::peakMemory() {
+    CORRADE_EXPECT_MAX_PEAK_MEMORY(1024*1024*1024) {}
+}
+
+void ResourceBudgetTest::peakMemoryExceeded() {
+    CORRADE_EXPECT_MAX_PEAK_MEMORY(1024*1024) {
+        /* Touch every page so the memory is actually resident */
+        char* volatile data = static_cast<char*>(std::malloc(16*1024*1024));
+        for(std::size_t i = 0; i < 16*1024*1024; i += 1024) data[i] = 1;
+        std::free(data);
+    }
+}
+
+struct CrashTest: Tester {
+    explicit CrashTest();
+
+    void pass();
+    void crash();
+    void passAfterCrash();
+
+    int value = 0;
+};
+
+CrashTest::CrashTest() {
+    /* Stands for some expensive setup that shouldn't be repeated */
+    value = 42;
+
+    addTests({&CrashTest::pass,
+              &CrashTest::crash,
+              &CrashTest::passAfterCrash});
+}
+
+void CrashTest::pass() {
+    CORRADE_COMPARE(value, 42);
+    value = 1337;
+}
+
+void CrashTest::crash() {
+    CORRADE_COMPARE(value, 42);
+    std::_Exit(3);
+}
+
+void CrashTest::passAfterCrash() {
+    /* Not affected by what the previous test cases did */
+    CORRADE_COMPARE(value, 42);
+}
+
+struct ComparisonTest: Tester {
+    explicit ComparisonTest(const TesterConfiguration& configuration = TesterConfiguration{});
+
+    void baseline();
+    void slower();
+    void faster();
+
+    void benchmarkBegin() {}
+    std::uint64_t benchmarkEnd() { return cost; }
+
+    std::uint64_t cost;
+};
+
+ComparisonTest::ComparisonTest(const TesterConfiguration& configuration): Tester{configuration} {
+    addCustomComparisonBenchmarks({&ComparisonTest::baseline,
+                                   &ComparisonTest::slower,
+                                   &ComparisonTest::faster}, 4,
+        &ComparisonTest::benchmarkBegin,
+        &ComparisonTest::benchmarkEnd,
+        BenchmarkUnits::Nanoseconds);
+}
+
+void ComparisonTest::baseline() {
+    cost = 2000;
+    CORRADE_BENCHMARK(2) {}
+}
+
+void ComparisonTest::slower() {
+    cost = 3000;
+    CORRADE_BENCHMARK(2) {}
+}
+
+void ComparisonTest::faster() {
+    /* Different batch size, the ratio is still per iteration */
+    cost = 1000;
+    CORRADE_BENCHMARK(4) {}
+}
+
+struct SweepTest: Tester {
+    explicit SweepTest(const TesterConfiguration& configuration = TesterConfiguration{});
+
+    void linear();
+    void constant();
+
+    void benchmarkBegin() {}
+    std::uint64_t benchmarkEnd() { return cost; }
+
+    std::uint64_t cost;
+};
+
+SweepTest::SweepTest(const TesterConfiguration& configuration): Tester{configuration} {
+    addCustomSweepBenchmarks({&SweepTest::linear}, 4, 1000, 64000,
+        &SweepTest::benchmarkBegin,
+        &SweepTest::benchmarkEnd,
+        BenchmarkUnits::Nanoseconds);
+
+    /* The max size is not a power of two multiple of the min size, gets
+       added at the end */
+    addCustomSweepBenchmarks({&SweepTest::constant}, 4, 1, 3,
+        &SweepTest::benchmarkBegin,
+        &SweepTest::benchmarkEnd,
+        BenchmarkUnits::Nanoseconds);
+
+    /* Two sizes are not enough for a fit */
+    addCustomSweepBenchmarks({&SweepTest::constant}, 4, 5, 6,
+        &SweepTest::benchmarkBegin,
+        &SweepTest::benchmarkEnd,
+        BenchmarkUnits::Nanoseconds);
+}
+
+void SweepTest::linear() {
+    /* The cost per item doubles starting with 4000 items */
+    const std::size_t size = testCaseSweepSize();
+    cost = size < 4000 ? size : 2*size;
+    CORRADE_BENCHMARK(1) {}
+}
+
+void SweepTest::constant() {
+    cost = 500;
+    CORRADE_BENCHMARK(1) {}
+}
+
+struct TimingTest: Tester {
+    explicit TimingTest();
+
+    void setup() {}
+    void teardown() {}
+
+    void fast();
+    void slow();
+};
+
+TimingTest::TimingTest() {
+    addTests({&TimingTest::fast});
+    addTests({&TimingTest::slow},
+        &TimingTest::setup,
+        &TimingTest::teardown);
+}
+
+void TimingTest::fast() {
+    CORRADE_VERIFY(true);
+}
+
+void TimingTest::slow() {
+    volatile std::size_t counter = 0;
+    for(std::size_t i = 0; i != 10000000; ++i) counter = counter + 1;
+    CORRADE_COMPARE(counter, 10000000);
+}
+
 struct TesterTest: Tester {
     explicit TesterTest();
 
@@ -510,6 +778,12 @@ struct TesterTest: Tester {
     void abortOnFail();
     void abortOnFailSkip();
     void noXfail();
+    void jobs();
+    void jobsAbortOnFail();
+    void isolate();
+    void isolateCrash();
+    void timing();
+    void timingJobs();
 
     /* warning and message verified in test() already */
     void compareMessageVerboseDisabled();
@@ -532,14 +806,39 @@ struct TesterTest: Tester {
     void benchmarkWallClock();
     void benchmarkCpuClock();
     void benchmarkCpuCycles();
+    void benchmarkHardwareCounter();
     void benchmarkDiscardAll();
+    void benchmarkOutput();
+    void benchmarkBaselineRegression();
+    void benchmarkBaselineImprovement();
+    void benchmarkBaselineNoChange();
+    void benchmarkPercentiles();
+    void benchmarkMinTime();
+    void benchmarkPrecision();
+    void benchmarkTimeBudget();
+    void benchmarkWarmup();
+    void benchmarkPinCpuInvalid();
+    void benchmarkThreaded();
+    void benchmarkThroughput();
+    void benchmarkComparison();
+    void benchmarkSweep();
+    void benchmarkResultCallback();
+    void benchmarkProfile();
+    void benchmarkProfileNotBenchmark();
     void benchmarkDebugBuildNote();
     #ifdef __linux__
     void benchmarkCpuScalingNoWarning();
     void benchmarkCpuScalingWarning();
     void benchmarkCpuScalingWarningVerbose();
+    void benchmarkCpuBoostWarning();
+    void benchmarkCpuNoTurboWarningVerbose();
+    void benchmarkMachineFingerprint();
+    void benchmarkPinCpu();
+    void benchmarkPriority();
     #endif
 
+    void resourceBudget();
+
     void testName();
 
     void compareNoCommonType();
@@ -575,6 +874,12 @@ TesterTest::TesterTest() {
               &TesterTest::abortOnFail,
               &TesterTest::abortOnFailSkip,
               &TesterTest::noXfail,
+              &TesterTest::jobs,
+              &TesterTest::jobsAbortOnFail,
+              &TesterTest::isolate,
+              &TesterTest::isolateCrash,
+              &TesterTest::timing,
+              &TesterTest::timingJobs,
 
               &TesterTest::compareMessageVerboseDisabled,
               &TesterTest::compareMessageVerboseEnabled,
@@ -596,14 +901,39 @@ TesterTest::TesterTest() {
               &TesterTest::benchmarkWallClock,
               &TesterTest::benchmarkCpuClock,
               &TesterTest::benchmarkCpuCycles,
+              &TesterTest::benchmarkHardwareCounter,
               &TesterTest::benchmarkDiscardAll,
+              &TesterTest::benchmarkOutput,
+              &TesterTest::benchmarkBaselineRegression,
+              &TesterTest::benchmarkBaselineImprovement,
+              &TesterTest::benchmarkBaselineNoChange,
+              &TesterTest::benchmarkPercentiles,
+              &TesterTest::benchmarkMinTime,
+              &TesterTest::benchmarkPrecision,
+              &TesterTest::benchmarkTimeBudget,
+              &TesterTest::benchmarkWarmup,
+              &TesterTest::benchmarkPinCpuInvalid,
+              &TesterTest::benchmarkThreaded,
+              &TesterTest::benchmarkThroughput,
+              &TesterTest::benchmarkComparison,
+              &TesterTest::benchmarkSweep,
+              &TesterTest::benchmarkResultCallback,
+              &TesterTest::benchmarkProfile,
+              &TesterTest::benchmarkProfileNotBenchmark,
               &TesterTest::benchmarkDebugBuildNote,
               #ifdef __linux__
               &TesterTest::benchmarkCpuScalingNoWarning,
               &TesterTest::benchmarkCpuScalingWarning,
               &TesterTest::benchmarkCpuScalingWarningVerbose,
+              &TesterTest::benchmarkCpuBoostWarning,
+              &TesterTest::benchmarkCpuNoTurboWarningVerbose,
+              &TesterTest::benchmarkMachineFingerprint,
+              &TesterTest::benchmarkPinCpu,
+              &TesterTest::benchmarkPriority,
               #endif
 
+              &TesterTest::resourceBudget,
+
               &TesterTest::testName,
 
               &TesterTest::compareNoCommonType,
@@ -616,10 +946,16 @@ TesterTest::TesterTest() {
 }
 
 void TesterTest::configurationCopy() {
+    int userData;
+    auto callback = [](const BenchmarkResult&, void*) {};
+
     TesterConfiguration a;
-    a.setSkippedArgumentPrefixes({"eyy", "bla"});
+    a.setSkippedArgumentPrefixes({"eyy", "bla"})
+     .setBenchmarkResultCallback(callback, &userData);
 
     TesterConfiguration b{a};
+    CORRADE_VERIFY(b.benchmarkResultCallback() == callback);
+    CORRADE_COMPARE(b.benchmarkResultCallbackUserData(), &userData);
     CORRADE_COMPARE(a.skippedArgumentPrefixes().size(), 2);
     CORRADE_COMPARE(b.skippedArgumentPrefixes().size(), 2);
     CORRADE_COMPARE(a.skippedArgumentPrefixes()[1], "bla");
@@ -666,6 +1002,9 @@ void TesterTest::test() {
         Test t{&std::cout, TesterConfiguration{}
             #ifdef __linux__
             .setCpuScalingGovernorFile("")
+            .setCpuBoostFile("")
+            .setCpuNoTurboFile("")
+            .setCpuInfoFile("")
             #endif
         };
         t.registerTest("here.cpp", "TesterTest::Test");
@@ -684,6 +1023,9 @@ void TesterTest::test() {
     Test t{&out, TesterConfiguration{}
         #ifdef __linux__
         .setCpuScalingGovernorFile("")
+        .setCpuBoostFile("")
+        .setCpuNoTurboFile("")
+        .setCpuInfoFile("")
         #endif
     };
     t.registerTest("here.cpp", "TesterTest::Test");
@@ -752,6 +1094,9 @@ void TesterTest::skipTests() {
     Test t{&out, TesterConfiguration{}
         #ifdef __linux__
         .setCpuScalingGovernorFile("")
+        .setCpuBoostFile("")
+        .setCpuNoTurboFile("")
+        .setCpuInfoFile("")
         #endif
     };
     t.registerTest("here.cpp", "TesterTest::Test");
@@ -929,6 +1274,179 @@ void TesterTest::noXfail() {
         Compare::StringToFile);
 }
 
+void TesterTest::jobs() {
+    #if !defined(CORRADE_TARGET_UNIX) || defined(CORRADE_TARGET_EMSCRIPTEN) || defined(CORRADE_TARGET_IOS)
+    CORRADE_SKIP("Parallel test execution is not supported on this platform.");
+    #else
+    /* Test cases that print to the custom output stream or depend on state
+       from previous test cases can't be run in isolation, omitting them */
+    const char* only = "1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 27 28 29 30";
+
+    std::stringstream expected;
+    {
+        const char* argv[] = { "", "--color", "off", "--only", only };
+        int argc = Containers::arraySize(argv);
+        Tester::registerArguments(argc, argv);
+
+        Test t{&expected};
+        t.registerTest("here.cpp", "TesterTest::Test");
+        CORRADE_VERIFY(t.exec(&expected, &expected) == 1);
+    }
+
+    std::stringstream out;
+    {
+        const char* argv[] = { "", "--color", "off", "--only", only, "--jobs", "3" };
+        int argc = Containers::arraySize(argv);
+        Tester::registerArguments(argc, argv);
+
+        Test t{&out};
+        t.registerTest("here.cpp", "TesterTest::Test");
+        CORRADE_VERIFY(t.exec(&out, &out) == 1);
+    }
+
+    /* Same as the serial output */
+    CORRADE_COMPARE(out.str(), expected.str());
+    #endif
+}
+
+void TesterTest::timing() {
+    std::stringstream out;
+
+    const char* argv[] = { "", "--color", "off", "--timing", "--timing-slowest", "1" };
+    int argc = Containers::arraySize(argv);
+    Tester::registerArguments(argc, argv);
+
+    TimingTest t;
+    t.registerTest("here.cpp", "TesterTest::TimingTest");
+    CORRADE_COMPARE(t.exec(&out, &out), 0);
+
+    /* The times depend on the system, check just the deterministic parts.
+       Only the second test case has setup and teardown. */
+    const std::string output = out.str();
+    const std::size_t fast = output.find("    OK [1] fast()\n       [1] took ");
+    const std::size_t slow = output.find("    OK [2] slow()\n       [2] took ");
+    CORRADE_VERIFY(fast != std::string::npos);
+    CORRADE_VERIFY(slow != std::string::npos);
+    CORRADE_VERIFY(output.find(',', fast) > output.find('\n', output.find("took ", fast)));
+    CORRADE_VERIFY(output.find(" of which in setup and teardown\n", slow) != std::string::npos);
+    CORRADE_VERIFY(output.find("Slowest 1 test case:\n       [2] slow() ") != std::string::npos);
+    CORRADE_VERIFY(output.find("       [1] fast() ") == std::string::npos);
+    CORRADE_VERIFY(output.find("Total time ") != std::string::npos);
+    CORRADE_VERIFY(output.find(" of which in setup and teardown.\nFinished TesterTest::TimingTest with 0 errors out of 2 checks.\n") != std::string::npos);
+}
+
+void TesterTest::timingJobs() {
+    #if !defined(CORRADE_TARGET_UNIX) || defined(CORRADE_TARGET_EMSCRIPTEN) || defined(CORRADE_TARGET_IOS)
+    CORRADE_SKIP("Parallel test execution is not supported on this platform.");
+    #else
+    std::stringstream out;
+
+    const char* argv[] = { "", "--color", "off", "--timing", "--jobs", "2" };
+    int argc = Containers::arraySize(argv);
+    Tester::registerArguments(argc, argv);
+
+    TimingTest t;
+    t.registerTest("here.cpp", "TesterTest::TimingTest");
+    CORRADE_COMPARE(t.exec(&out, &out), 0);
+
+    /* The timing is passed from the workers together with the output, the
+       slowest test case is listed first */
+    const std::string output = out.str();
+    CORRADE_VERIFY(output.find("    OK [1] fast()\n       [1] took ") != std::string::npos);
+    CORRADE_VERIFY(output.find("    OK [2] slow()\n       [2] took ") != std::string::npos);
+    CORRADE_VERIFY(output.find("Slowest 2 test cases:\n       [2] slow() ") != std::string::npos);
+    CORRADE_VERIFY(output.find("\n       [1] fast() ") != std::string::npos);
+    CORRADE_VERIFY(output.find("Finished TesterTest::TimingTest with 0 errors out of 2 checks.\n") != std::string::npos);
+    #endif
+}
+
+void TesterTest::jobsAbortOnFail() {
+    #if !defined(CORRADE_TARGET_UNIX) || defined(CORRADE_TARGET_EMSCRIPTEN) || defined(CORRADE_TARGET_IOS)
+    CORRADE_SKIP("Parallel test execution is not supported on this platform.");
+    #else
+    std::stringstream out;
+
+    const char* argv[] = { "", "--color", "off", "--only", "1 2 3 4", "--abort-on-fail", "--jobs", "2" };
+    int argc = Containers::arraySize(argv);
+    Tester::registerArguments(argc, argv);
+
+    Test t{&out};
+    t.registerTest("here.cpp", "TesterTest::Test");
+    int result = t.exec(&out, &out);
+
+    /* Same as the serial output, even though the case after the failure
+       was run by a worker as well */
+    CORRADE_VERIFY(result == 1);
+    CORRADE_COMPARE_AS(out.str(),
+        Utility::Directory::join(TESTER_TEST_DIR, "abortOnFail.txt"),
+        Compare::StringToFile);
+    #endif
+}
+
+void TesterTest::isolate() {
+    #if !defined(CORRADE_TARGET_UNIX) || defined(CORRADE_TARGET_EMSCRIPTEN) || defined(CORRADE_TARGET_IOS)
+    CORRADE_SKIP("Test case isolation is not supported on this platform.");
+    #else
+    /* Same test cases as in jobs() */
+    const char* only = "1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 27 28 29 30";
+
+    std::stringstream expected;
+    {
+        const char* argv[] = { "", "--color", "off", "--only", only };
+        int argc = Containers::arraySize(argv);
+        Tester::registerArguments(argc, argv);
+
+        Test t{&expected};
+        t.registerTest("here.cpp", "TesterTest::Test");
+        CORRADE_VERIFY(t.exec(&expected, &expected) == 1);
+    }
+
+    /* Both with one and multiple processes at once */
+    for(const char* jobs: {"1", "3"}) {
+        std::stringstream out;
+        {
+            const char* argv[] = { "", "--color", "off", "--only", only, "--isolate", "--jobs", jobs };
+            int argc = Containers::arraySize(argv);
+            Tester::registerArguments(argc, argv);
+
+            Test t{&out};
+            t.registerTest("here.cpp", "TesterTest::Test");
+            CORRADE_VERIFY(t.exec(&out, &out) == 1);
+        }
+
+        /* Same as the serial output */
+        CORRADE_COMPARE(out.str(), expected.str());
+    }
+    #endif
+}
+
+void TesterTest::isolateCrash() {
+    #if !defined(CORRADE_TARGET_UNIX) || defined(CORRADE_TARGET_EMSCRIPTEN) || defined(CORRADE_TARGET_IOS)
+    CORRADE_SKIP("Test case isolation is not supported on this platform.");
+    #else
+    std::stringstream out;
+
+    const char* argv[] = { "", "--color", "off", "--isolate" };
+    int argc = Containers::arraySize(argv);
+    Tester::registerArguments(argc, argv);
+
+    CrashTest t;
+    t.registerTest("here.cpp", "TesterTest::CrashTest");
+    int result = t.exec(&out, &out);
+
+    /* The crash affects only the test case that crashed, and the test cases
+       don't see state modified by the test cases before. The name of the
+       crashed test case isn't known to the main process. */
+    CORRADE_COMPARE(result, 1);
+    CORRADE_COMPARE(out.str(),
+        "Starting TesterTest::CrashTest with 3 test cases...\n"
+        "    OK [1] pass()\n"
+        "  FAIL [2] <unknown>() worker process exited unexpectedly\n"
+        "    OK [3] passAfterCrash()\n"
+        "Finished TesterTest::CrashTest with 1 errors out of 2 checks.\n");
+    #endif
+}
+
 void TesterTest::compareMessageVerboseDisabled() {
     std::stringstream out;
 
@@ -1242,6 +1760,9 @@ void TesterTest::benchmarkWallClock() {
     Test t{&out, TesterConfiguration{}
         #ifdef __linux__
         .setCpuScalingGovernorFile("")
+        .setCpuBoostFile("")
+        .setCpuNoTurboFile("")
+        .setCpuInfoFile("")
         #endif
     };
     t.registerTest("here.cpp", "TesterTest::Test");
@@ -1263,6 +1784,9 @@ void TesterTest::benchmarkCpuClock() {
     Test t{&out, TesterConfiguration{}
         #ifdef __linux__
         .setCpuScalingGovernorFile("")
+        .setCpuBoostFile("")
+        .setCpuNoTurboFile("")
+        .setCpuInfoFile("")
         #endif
     };
     t.registerTest("here.cpp", "TesterTest::Test");
@@ -1284,6 +1808,9 @@ void TesterTest::benchmarkCpuCycles() {
     Test t{&out, TesterConfiguration{}
         #ifdef __linux__
         .setCpuScalingGovernorFile("")
+        .setCpuBoostFile("")
+        .setCpuNoTurboFile("")
+        .setCpuInfoFile("")
         #endif
     };
     t.registerTest("here.cpp", "TesterTest::Test");
@@ -1295,6 +1822,33 @@ void TesterTest::benchmarkCpuCycles() {
         Compare::StringToFile);
 }
 
+void TesterTest::benchmarkHardwareCounter() {
+    std::stringstream out;
+
+    const char* argv[] = { "", "--color", "off", "--only", "40", "--benchmark", "instructions" };
+    int argc = Containers::arraySize(argv);
+    Tester::registerArguments(argc, argv);
+
+    Test t{&out, TesterConfiguration{}
+        #ifdef __linux__
+        .setCpuScalingGovernorFile("")
+        .setCpuBoostFile("")
+        .setCpuNoTurboFile("")
+        .setCpuInfoFile("")
+        #endif
+    };
+    t.registerTest("here.cpp", "TesterTest::Test");
+    int result = t.exec(&out, &out);
+
+    CORRADE_COMPARE(result, 0);
+
+    /* The measured value depends on the hardware and whether the counters
+       are available at all (if not, a warning is printed), so check just the
+       label */
+    const std::string output = out.str();
+    CORRADE_VERIFY(output.find(" benchmarkDefault()@9x1000000000 (instructions)\n") != std::string::npos);
+}
+
 void TesterTest::benchmarkDiscardAll() {
     std::stringstream out;
 
@@ -1305,6 +1859,9 @@ void TesterTest::benchmarkDiscardAll() {
     Test t{&out, TesterConfiguration{}
         #ifdef __linux__
         .setCpuScalingGovernorFile("")
+        .setCpuBoostFile("")
+        .setCpuNoTurboFile("")
+        .setCpuInfoFile("")
         #endif
     };
     t.registerTest("here.cpp", "TesterTest::Test");
@@ -1316,88 +1873,783 @@ void TesterTest::benchmarkDiscardAll() {
         Compare::StringToFile);
 }
 
-void TesterTest::benchmarkDebugBuildNote() {
+void TesterTest::benchmarkOutput() {
+    const std::string filename = Utility::Directory::join(TESTER_WRITE_TEST_DIR, "benchmarkOutput.csv");
+    CORRADE_VERIFY(Utility::Directory::mkpath(TESTER_WRITE_TEST_DIR));
+    if(Utility::Directory::exists(filename))
+        CORRADE_VERIFY(Utility::Directory::rm(filename));
+
     std::stringstream out;
 
-    const char* argv[] = { "", "--color", "off", "--only", "40 42", "-v" };
+    const char* argv[] = { "", "--color", "off", "--only", "42 42", "--repeat-every", "3", "--benchmark-output", filename.data() };
     int argc = Containers::arraySize(argv);
     Tester::registerArguments(argc, argv);
 
     Test t{&out, TesterConfiguration{}
         #ifdef __linux__
         .setCpuScalingGovernorFile("")
+        .setCpuBoostFile("")
+        .setCpuNoTurboFile("")
+        .setCpuInfoFile("")
         #endif
     };
-    t.registerTest("here.cpp", "TesterTest::Test", /*isDebugBuild=*/true);
+    t.registerTest("here.cpp", "TesterTest::Test");
     int result = t.exec(&out, &out);
 
+    /* Both runs of the same test case are saved, with the first measurement
+       of each discarded */
     CORRADE_COMPARE(result, 0);
-    /* Same as wall clock output */
+    CORRADE_COMPARE_AS(Utility::Directory::readString(filename),
+        Utility::Directory::join(TESTER_TEST_DIR, "benchmarkOutput.csv"),
+        Compare::StringToFile);
+}
+
+void TesterTest::benchmarkBaselineRegression() {
+    std::stringstream out;
+
+    const std::string baseline = Utility::Directory::join(TESTER_TEST_DIR, "benchmarkBaselineRegression.csv");
+    const char* argv[] = { "", "--color", "off", "--only", "42", "--repeat-every", "10", "--benchmark-baseline", baseline.data() };
+    int argc = Containers::arraySize(argv);
+    Tester::registerArguments(argc, argv);
+
+    Test t{&out, TesterConfiguration{}
+        #ifdef __linux__
+        .setCpuScalingGovernorFile("")
+        .setCpuBoostFile("")
+        .setCpuNoTurboFile("")
+        .setCpuInfoFile("")
+        #endif
+    };
+    t.registerTest("here.cpp", "TesterTest::Test");
+    int result = t.exec(&out, &out);
+
+    CORRADE_COMPARE(result, 1);
     CORRADE_COMPARE_AS(out.str(),
-        Utility::Directory::join(TESTER_TEST_DIR, "benchmarkDebugBuildNote.txt"),
+        Utility::Directory::join(TESTER_TEST_DIR, "benchmarkBaselineRegression.txt"),
         Compare::StringToFile);
 }
 
-#ifdef __linux__
-void TesterTest::benchmarkCpuScalingNoWarning() {
+void TesterTest::benchmarkBaselineImprovement() {
     std::stringstream out;
 
-    const char* argv[] = { "", "--color", "off", "--only", "40 42" };
+    const std::string baseline = Utility::Directory::join(TESTER_TEST_DIR, "benchmarkBaselineImprovement.csv");
+    const char* argv[] = { "", "--color", "off", "--only", "42", "--repeat-every", "10", "--benchmark-baseline", baseline.data() };
     int argc = Containers::arraySize(argv);
     Tester::registerArguments(argc, argv);
 
     Test t{&out, TesterConfiguration{}
-        .setCpuScalingGovernorFile(Utility::Directory::join(TESTER_TEST_DIR, "cpu-governor-performance.txt"))
+        #ifdef __linux__
+        .setCpuScalingGovernorFile("")
+        .setCpuBoostFile("")
+        .setCpuNoTurboFile("")
+        .setCpuInfoFile("")
+        #endif
     };
     t.registerTest("here.cpp", "TesterTest::Test");
     int result = t.exec(&out, &out);
 
     CORRADE_COMPARE(result, 0);
-    /* Same as wall clock output */
     CORRADE_COMPARE_AS(out.str(),
-        Utility::Directory::join(TESTER_TEST_DIR, "benchmarkWallClock.txt"),
+        Utility::Directory::join(TESTER_TEST_DIR, "benchmarkBaselineImprovement.txt"),
         Compare::StringToFile);
 }
 
-void TesterTest::benchmarkCpuScalingWarning() {
+void TesterTest::benchmarkBaselineNoChange() {
     std::stringstream out;
 
-    const char* argv[] = { "", "--color", "off", "--only", "40 42" };
+    const std::string baseline = Utility::Directory::join(TESTER_TEST_DIR, "benchmarkBaselineNoChange.csv");
+    const char* argv[] = { "", "--color", "off", "--only", "42", "--repeat-every", "10", "--benchmark-baseline", baseline.data() };
     int argc = Containers::arraySize(argv);
     Tester::registerArguments(argc, argv);
 
     Test t{&out, TesterConfiguration{}
-        .setCpuScalingGovernorFile(Utility::Directory::join(TESTER_TEST_DIR, "cpu-governor-powersave.txt"))
+        #ifdef __linux__
+        .setCpuScalingGovernorFile("")
+        .setCpuBoostFile("")
+        .setCpuNoTurboFile("")
+        .setCpuInfoFile("")
+        #endif
     };
     t.registerTest("here.cpp", "TesterTest::Test");
     int result = t.exec(&out, &out);
 
     CORRADE_COMPARE(result, 0);
-    /* Same as wall clock output */
     CORRADE_COMPARE_AS(out.str(),
-        Utility::Directory::join(TESTER_TEST_DIR, "benchmarkCpuScalingWarning.txt"),
+        Utility::Directory::join(TESTER_TEST_DIR, "benchmarkBaselineNoChange.txt"),
         Compare::StringToFile);
 }
 
-void TesterTest::benchmarkCpuScalingWarningVerbose() {
+void TesterTest::benchmarkPercentiles() {
     std::stringstream out;
 
-    const char* argv[] = { "", "--color", "off", "--only", "40 42", "-v" };
+    const char* argv[] = { "", "--color", "off", "--only", "41", "--benchmark-percentiles" };
     int argc = Containers::arraySize(argv);
     Tester::registerArguments(argc, argv);
 
     Test t{&out, TesterConfiguration{}
-        .setCpuScalingGovernorFile(Utility::Directory::join(TESTER_TEST_DIR, "cpu-governor-powersave.txt"))
+        #ifdef __linux__
+        .setCpuScalingGovernorFile("")
+        .setCpuBoostFile("")
+        .setCpuNoTurboFile("")
+        .setCpuInfoFile("")
+        #endif
     };
     t.registerTest("here.cpp", "TesterTest::Test");
     int result = t.exec(&out, &out);
 
     CORRADE_COMPARE(result, 0);
-    /* Same as wall clock output */
     CORRADE_COMPARE_AS(out.str(),
-        Utility::Directory::join(TESTER_TEST_DIR, "benchmarkCpuScalingWarningVerbose.txt"),
+        Utility::Directory::join(TESTER_TEST_DIR, "benchmarkPercentiles.txt"),
         Compare::StringToFile);
 }
+
+void TesterTest::benchmarkMinTime() {
+    std::stringstream out;
+
+    const char* argv[] = { "", "--color", "off", "--only", "40", "--benchmark-min-time", "100" };
+    int argc = Containers::arraySize(argv);
+    Tester::registerArguments(argc, argv);
+
+    Test t{&out, TesterConfiguration{}
+        #ifdef __linux__
+        .setCpuScalingGovernorFile("")
+        .setCpuBoostFile("")
+        .setCpuNoTurboFile("")
+        .setCpuInfoFile("")
+        #endif
+    };
+    t.registerTest("here.cpp", "TesterTest::Test");
+    int result = t.exec(&out, &out);
+
+    CORRADE_COMPARE(result, 0);
+
+    /* The benchmark loop breaks right away, so the calibration gives up after
+       ten rounds of increasing the batch size tenfold */
+    CORRADE_VERIFY(out.str().find(" benchmarkDefault()@9x10000000000000000000 (wall time)\n") != std::string::npos);
+}
+
+void TesterTest::benchmarkPrecision() {
+    std::stringstream out;
+
+    const char* argv[] = { "", "--color", "off", "--only", "42", "--benchmark-precision", "0.01" };
+    int argc = Containers::arraySize(argv);
+    Tester::registerArguments(argc, argv);
+
+    Test t{&out, TesterConfiguration{}
+        #ifdef __linux__
+        .setCpuScalingGovernorFile("")
+        .setCpuBoostFile("")
+        .setCpuNoTurboFile("")
+        .setCpuInfoFile("")
+        #endif
+    };
+    t.registerTest("here.cpp", "TesterTest::Test");
+    int result = t.exec(&out, &out);
+
+    CORRADE_COMPARE(result, 0);
+
+    /* Only one sample is requested by default, but it's discarded and a
+       confidence interval needs at least two more */
+    CORRADE_COMPARE_AS(out.str(),
+        Utility::Directory::join(TESTER_TEST_DIR, "benchmarkPrecision.txt"),
+        Compare::StringToFile);
+}
+
+void TesterTest::benchmarkTimeBudget() {
+    std::stringstream out;
+
+    const char* argv[] = { "", "--color", "off", "--only", "41", "--benchmark-precision", "0.0001", "--benchmark-time-budget", "0" };
+    int argc = Containers::arraySize(argv);
+    Tester::registerArguments(argc, argv);
+
+    Test t{&out, TesterConfiguration{}
+        #ifdef __linux__
+        .setCpuScalingGovernorFile("")
+        .setCpuBoostFile("")
+        .setCpuNoTurboFile("")
+        .setCpuInfoFile("")
+        #endif
+    };
+    t.registerTest("here.cpp", "TesterTest::Test");
+    int result = t.exec(&out, &out);
+
+    CORRADE_COMPARE(result, 0);
+
+    /* The confidence interval would never get small enough but the time
+       budget doesn't allow any further samples */
+    CORRADE_COMPARE_AS(out.str(),
+        Utility::Directory::join(TESTER_TEST_DIR, "benchmarkTimeBudget.txt"),
+        Compare::StringToFile);
+}
+
+void TesterTest::benchmarkWarmup() {
+    std::stringstream out;
+
+    const char* argv[] = { "", "--color", "off", "--only", "42", "--benchmark-warmup", "1" };
+    int argc = Containers::arraySize(argv);
+    Tester::registerArguments(argc, argv);
+
+    Test t{&out, TesterConfiguration{}
+        #ifdef __linux__
+        .setCpuScalingGovernorFile("")
+        .setCpuBoostFile("")
+        .setCpuNoTurboFile("")
+        .setCpuInfoFile("")
+        #endif
+    };
+    t.registerTest("here.cpp", "TesterTest::Test");
+    int result = t.exec(&out, &out);
+
+    CORRADE_COMPARE(result, 0);
+
+    /* Samples taken during the warmup are not counted in */
+    CORRADE_COMPARE_AS(out.str(),
+        Utility::Directory::join(TESTER_TEST_DIR, "benchmarkWarmup.txt"),
+        Compare::StringToFile);
+}
+
+void TesterTest::benchmarkPinCpuInvalid() {
+    std::stringstream out;
+
+    /* Assuming there's no machine with this many cores */
+    const char* argv[] = { "", "--color", "off", "--only", "42", "--benchmark-cpu", "100000" };
+    int argc = Containers::arraySize(argv);
+    Tester::registerArguments(argc, argv);
+
+    Test t{&out, TesterConfiguration{}
+        #ifdef __linux__
+        .setCpuScalingGovernorFile("")
+        .setCpuBoostFile("")
+        .setCpuNoTurboFile("")
+        .setCpuInfoFile("")
+        #endif
+    };
+    t.registerTest("here.cpp", "TesterTest::Test");
+    int result = t.exec(&out, &out);
+
+    CORRADE_COMPARE(result, 0);
+    CORRADE_COMPARE_AS(out.str(),
+        Utility::Directory::join(TESTER_TEST_DIR, "benchmarkPinCpuInvalid.txt"),
+        Compare::StringToFile);
+}
+
+void TesterTest::benchmarkThreaded() {
+    std::stringstream out;
+
+    const char* argv[] = { "", "--color", "off" };
+    int argc = Containers::arraySize(argv);
+    Tester::registerArguments(argc, argv);
+
+    ThreadedTest t{TesterConfiguration{}
+        #ifdef __linux__
+        .setCpuScalingGovernorFile("")
+        .setCpuBoostFile("")
+        .setCpuNoTurboFile("")
+        .setCpuInfoFile("")
+        #endif
+    };
+    t.registerTest("here.cpp", "TesterTest::ThreadedTest");
+    int result = t.exec(&out, &out);
+
+    CORRADE_COMPARE(result, 0);
+    CORRADE_VERIFY(out.str().find(" benchmark(1 thread)@1x5 (wall time)\n") != std::string::npos);
+
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    /* Each thread did the full batch */
+    CORRADE_COMPARE(t.log,
+        "1: 5\n1: 5\n"
+        "2: 5 5\n2: 5 5\n"
+        "3: 5 5 5\n3: 5 5 5\n");
+    CORRADE_VERIFY(out.str().find(" benchmark(2 threads)@1x5 (wall time)\n") != std::string::npos);
+    CORRADE_VERIFY(out.str().find(" benchmark(3 threads)@1x5 (wall time)\n") != std::string::npos);
+    CORRADE_VERIFY(out.str().find("x speedup\n") != std::string::npos);
+    #else
+    CORRADE_COMPARE(t.log, "1: 5\n1: 5\n");
+    #endif
+}
+
+void TesterTest::benchmarkThroughput() {
+    const std::string filename = Utility::Directory::join(TESTER_WRITE_TEST_DIR, "benchmarkThroughput.csv");
+    CORRADE_VERIFY(Utility::Directory::mkpath(TESTER_WRITE_TEST_DIR));
+    if(Utility::Directory::exists(filename))
+        CORRADE_VERIFY(Utility::Directory::rm(filename));
+
+    std::stringstream out;
+
+    const char* argv[] = { "", "--color", "off", "--benchmark-output", filename.data() };
+    int argc = Containers::arraySize(argv);
+    Tester::registerArguments(argc, argv);
+
+    ThroughputTest t{TesterConfiguration{}
+        #ifdef __linux__
+        .setCpuScalingGovernorFile("")
+        .setCpuBoostFile("")
+        .setCpuNoTurboFile("")
+        .setCpuInfoFile("")
+        #endif
+    };
+    t.registerTest("here.cpp", "TesterTest::ThroughputTest");
+    int result = t.exec(&out, &out);
+
+    /* 1000 ns per iteration. Bytes use 1024-based prefixes, throughput for
+       non-time benchmarks is ignored */
+    CORRADE_COMPARE(result, 0);
+    CORRADE_COMPARE(out.str(),
+        "Starting TesterTest::ThroughputTest with 3 test cases...\n"
+        " BENCH [1]   1.00          µs benchmarkBytes()@1x2\n"
+        "       [1] throughput 976.56 GB/s\n"
+        " BENCH [2]   1.00          µs benchmarkItems()@1x2\n"
+        "       [2] throughput 3.00 Mitems/s\n"
+        " BENCH [3]   1.00          kC benchmarkCycles()@1x2\n"
+        "Finished TesterTest::ThroughputTest with 0 errors out of 0 checks.\n");
+    CORRADE_COMPARE(Utility::Directory::readString(filename),
+        "test,case,units,batch size,value,throughput units,throughput\n"
+        "\"TesterTest::ThroughputTest\",\"benchmarkBytes()\",ns,2,2000,bytes/s,1048576000000.00\n"
+        "\"TesterTest::ThroughputTest\",\"benchmarkItems()\",ns,2,2000,items/s,3000000.00\n"
+        "\"TesterTest::ThroughputTest\",\"benchmarkCycles()\",cycles,2,2000,,\n");
+}
+
+void TesterTest::benchmarkComparison() {
+    std::stringstream out;
+
+    const char* argv[] = { "", "--color", "off" };
+    int argc = Containers::arraySize(argv);
+    Tester::registerArguments(argc, argv);
+
+    ComparisonTest t{TesterConfiguration{}
+        #ifdef __linux__
+        .setCpuScalingGovernorFile("")
+        .setCpuBoostFile("")
+        .setCpuNoTurboFile("")
+        .setCpuInfoFile("")
+        #endif
+    };
+    t.registerTest("here.cpp", "TesterTest::ComparisonTest");
+    int result = t.exec(&out, &out);
+
+    /* The baseline is run and printed for each compared benchmark again. The
+       first pair is discarded by default, the same as with other
+       benchmarks. */
+    CORRADE_COMPARE(result, 0);
+    CORRADE_COMPARE(out.str(),
+        "Starting TesterTest::ComparisonTest with 2 test cases...\n"
+        " BENCH [1]   1.00 ± 0.00   µs baseline()@3x2\n"
+        " BENCH [1]   1.50 ± 0.00   µs slower()@3x2\n"
+        "       [1] ratio 1.50 ± 0.00 slower()/baseline() over 3 pairs\n"
+        " BENCH [2]   1.00 ± 0.00   µs baseline()@3x2\n"
+        " BENCH [2] 250.00 ± 0.00   ns faster()@3x4\n"
+        "       [2] ratio 0.25 ± 0.00 faster()/baseline() over 3 pairs\n"
+        "Finished TesterTest::ComparisonTest with 0 errors out of 0 checks.\n");
+}
+
+void TesterTest::benchmarkSweep() {
+    std::stringstream out;
+
+    const char* argv[] = { "", "--color", "off" };
+    int argc = Containers::arraySize(argv);
+    Tester::registerArguments(argc, argv);
+
+    SweepTest t{TesterConfiguration{}
+        #ifdef __linux__
+        .setCpuScalingGovernorFile("")
+        .setCpuBoostFile("")
+        .setCpuNoTurboFile("")
+        .setCpuInfoFile("")
+        #endif
+    };
+    t.registerTest("here.cpp", "TesterTest::SweepTest");
+    int result = t.exec(&out, &out);
+
+    CORRADE_COMPARE(result, 0);
+    CORRADE_COMPARE(out.str(),
+        "Starting TesterTest::SweepTest with 12 test cases...\n"
+        " BENCH [01]   1.00 ± 0.00   µs linear(n=1000)@3x1\n"
+        " BENCH [02]   2.00 ± 0.00   µs linear(n=2000)@3x1\n"
+        " BENCH [03]   8.00 ± 0.00   µs linear(n=4000)@3x1\n"
+        " BENCH [04]  16.00 ± 0.00   µs linear(n=8000)@3x1\n"
+        " BENCH [05]  32.00 ± 0.00   µs linear(n=16000)@3x1\n"
+        " BENCH [06]  64.00 ± 0.00   µs linear(n=32000)@3x1\n"
+        " BENCH [07] 128.00 ± 0.00   µs linear(n=64000)@3x1\n"
+        "       [07] complexity O(n), 2.36% rms error\n"
+        "       [07] knee between n=2000 and n=4000, 2.00x cost per item\n"
+        " BENCH [08] 500.00 ± 0.00   ns constant(n=1)@3x1\n"
+        " BENCH [09] 500.00 ± 0.00   ns constant(n=2)@3x1\n"
+        " BENCH [10] 500.00 ± 0.00   ns constant(n=3)@3x1\n"
+        "       [10] complexity O(1), 0.00% rms error\n"
+        " BENCH [11] 500.00 ± 0.00   ns constant(n=5)@3x1\n"
+        " BENCH [12] 500.00 ± 0.00   ns constant(n=6)@3x1\n"
+        "       [12] too few sizes to fit complexity\n"
+        "Finished TesterTest::SweepTest with 0 errors out of 0 checks.\n");
+}
+
+void TesterTest::benchmarkResultCallback() {
+    std::stringstream out;
+
+    const char* argv[] = { "", "--color", "off" };
+    int argc = Containers::arraySize(argv);
+    Tester::registerArguments(argc, argv);
+
+    struct Result {
+        std::string testName, testCaseName;
+        BenchmarkUnits units;
+        std::size_t batchSize;
+        std::vector<std::uint64_t> measurements;
+        std::size_t keptCount;
+        double mean, stddev;
+    };
+    std::vector<Result> results;
+
+    ComparisonTest t{TesterConfiguration{}
+        #ifdef __linux__
+        .setCpuScalingGovernorFile("")
+        .setCpuBoostFile("")
+        .setCpuNoTurboFile("")
+        .setCpuInfoFile("")
+        #endif
+        .setBenchmarkResultCallback([](const BenchmarkResult& result, void* userData) {
+            static_cast<std::vector<Result>*>(userData)->push_back({{result.testName.data(), result.testName.size()}, {result.testCaseName.data(), result.testCaseName.size()}, result.units, result.batchSize, std::vector<std::uint64_t>{result.measurements.begin(), result.measurements.end()}, result.keptCount, result.mean, result.stddev});
+        }, &results)
+    };
+    t.registerTest("here.cpp", "TesterTest::ComparisonTest");
+    int result = t.exec(&out, &out);
+    CORRADE_COMPARE(result, 0);
+
+    /* Each side of each comparison reported separately, with the first
+       measurement discarded */
+    CORRADE_COMPARE(results.size(), 4);
+    CORRADE_COMPARE(results[0].testName, "TesterTest::ComparisonTest");
+    CORRADE_COMPARE(results[0].testCaseName, "baseline()");
+    CORRADE_VERIFY(results[0].units == BenchmarkUnits::Nanoseconds);
+    CORRADE_COMPARE(results[0].batchSize, 2);
+    CORRADE_COMPARE(results[0].measurements.size(), 3);
+    CORRADE_COMPARE(results[0].measurements[0], 2000);
+    CORRADE_COMPARE(results[0].keptCount, 3);
+    CORRADE_COMPARE(results[0].mean, 1000.0);
+    CORRADE_COMPARE(results[0].stddev, 0.0);
+
+    CORRADE_COMPARE(results[1].testCaseName, "slower()");
+    CORRADE_COMPARE(results[1].batchSize, 2);
+    CORRADE_COMPARE(results[1].mean, 1500.0);
+
+    CORRADE_COMPARE(results[2].testCaseName, "baseline()");
+    CORRADE_COMPARE(results[3].testCaseName, "faster()");
+    CORRADE_COMPARE(results[3].batchSize, 4);
+    CORRADE_COMPARE(results[3].measurements.size(), 3);
+    CORRADE_COMPARE(results[3].measurements[0], 1000);
+    CORRADE_COMPARE(results[3].mean, 250.0);
+}
+
+void TesterTest::resourceBudget() {
+    std::stringstream out;
+
+    const char* argv[] = { "", "--color", "off" };
+    int argc = Containers::arraySize(argv);
+    Tester::registerArguments(argc, argv);
+
+    ResourceBudgetTest t;
+    t.registerTest("here.cpp", "TesterTest::ResourceBudgetTest");
+    int result = t.exec(&out, &out);
+    CORRADE_COMPARE(result, 1);
+
+    /* The measured values depend on the system, check just the
+       deterministic parts */
+    const std::string output = out.str();
+    CORRADE_VERIFY(output.find(
+        "  FAIL [1] allocationsNotAvailable() at here.cpp on line 586\n"
+        "        Allocation counting is not available, include\n"
+        "         Corrade/TestSuite/AllocationCounter.h\n"
+        "       in the test executable to enable it.\n") != std::string::npos);
+    CORRADE_VERIFY(output.find("    OK [2] time()\n") != std::string::npos);
+    CORRADE_VERIFY(output.find(
+        "  FAIL [3] timeExceeded() at here.cpp on line 595\n"
+        "        Wall time ") != std::string::npos);
+    CORRADE_VERIFY(output.find(" ms exceeded the budget of 0.00 ms.\n") != std::string::npos);
+    #ifdef __linux__
+    CORRADE_VERIFY(output.find("    OK [4] peakMemory()\n") != std::string::npos);
+    CORRADE_VERIFY(output.find(
+        "  FAIL [5] peakMemoryExceeded() at here.cpp on line 606\n"
+        "        Peak memory growth ") != std::string::npos);
+    CORRADE_VERIFY(output.find(" B exceeded the budget of 1048576 B.\n") != std::string::npos);
+    CORRADE_VERIFY(output.find("Finished TesterTest::ResourceBudgetTest with 3 errors out of 5 checks.\n") != std::string::npos);
+    #else
+    CORRADE_VERIFY(output.find(
+        "  WARN [4] peakMemory() at here.cpp on line 602\n"
+        "        Peak memory can't be measured on this system, not checking the budget.\n") != std::string::npos);
+    #endif
+}
+
+void TesterTest::benchmarkProfile() {
+    const std::string control = Utility::Directory::join(TESTER_WRITE_TEST_DIR, "profile-control.txt");
+    const std::string ack = Utility::Directory::join(TESTER_WRITE_TEST_DIR, "profile-ack.txt");
+    CORRADE_VERIFY(Utility::Directory::mkpath(TESTER_WRITE_TEST_DIR));
+    CORRADE_VERIFY(Utility::Directory::writeString(ack, "ack\nack\n"));
+
+    std::stringstream out;
+
+    const char* argv[] = { "", "--color", "off", "--only", "11 42", "--profile", "42", "--profile-duration", "20", "--profile-control", control.data(), "--profile-ack", ack.data() };
+    int argc = Containers::arraySize(argv);
+    Tester::registerArguments(argc, argv);
+
+    Test t{&out, TesterConfiguration{}
+        #ifdef __linux__
+        .setCpuScalingGovernorFile("")
+        .setCpuBoostFile("")
+        .setCpuNoTurboFile("")
+        .setCpuInfoFile("")
+        #endif
+    };
+    t.registerTest("here.cpp", "TesterTest::Test");
+    int result = t.exec(&out, &out);
+
+    /* Only the profiled benchmark is run, more times than requested. Running
+       out of the acknowledgements isn't an error. */
+    CORRADE_COMPARE(result, 0);
+    CORRADE_VERIFY(out.str().find("Starting TesterTest::Test with 1 test cases...\n") == 0);
+    CORRADE_VERIFY(out.str().find(" benchmarkOnce()@") != std::string::npos);
+    CORRADE_VERIFY(out.str().find("benchmarkOnce()@1x1\n") == std::string::npos);
+
+    /* The profiler is enabled and disabled for each sample */
+    const std::string commands = Utility::Directory::readString(control);
+    CORRADE_VERIFY(commands.size() >= 2*15);
+    CORRADE_VERIFY(commands.find("enable\ndisable\nenable\ndisable\n") == 0);
+    CORRADE_COMPARE(commands.size() % 15, 0);
+}
+
+void TesterTest::benchmarkProfileNotBenchmark() {
+    std::stringstream out;
+
+    const char* argv[] = { "", "--color", "off", "--profile", "11" };
+    int argc = Containers::arraySize(argv);
+    Tester::registerArguments(argc, argv);
+
+    Test t{&out};
+    t.registerTest("here.cpp", "TesterTest::Test");
+    int result = t.exec(&out, &out);
+
+    CORRADE_COMPARE(result, 2);
+    CORRADE_COMPARE(out.str(), "No benchmark 11 to profile in TesterTest::Test!\n");
+}
+
+void TesterTest::benchmarkDebugBuildNote() {
+    std::stringstream out;
+
+    const char* argv[] = { "", "--color", "off", "--only", "40 42", "-v" };
+    int argc = Containers::arraySize(argv);
+    Tester::registerArguments(argc, argv);
+
+    Test t{&out, TesterConfiguration{}
+        #ifdef __linux__
+        .setCpuScalingGovernorFile("")
+        .setCpuBoostFile("")
+        .setCpuNoTurboFile("")
+        .setCpuInfoFile("")
+        #endif
+    };
+    t.registerTest("here.cpp", "TesterTest::Test", /*isDebugBuild=*/true);
+    int result = t.exec(&out, &out);
+
+    CORRADE_COMPARE(result, 0);
+    /* Same as wall clock output */
+    CORRADE_COMPARE_AS(out.str(),
+        Utility::Directory::join(TESTER_TEST_DIR, "benchmarkDebugBuildNote.txt"),
+        Compare::StringToFile);
+}
+
+#ifdef __linux__
+void TesterTest::benchmarkCpuScalingNoWarning() {
+    std::stringstream out;
+
+    const char* argv[] = { "", "--color", "off", "--only", "40 42" };
+    int argc = Containers::arraySize(argv);
+    Tester::registerArguments(argc, argv);
+
+    Test t{&out, TesterConfiguration{}
+        .setCpuScalingGovernorFile(Utility::Directory::join(TESTER_TEST_DIR, "cpu-governor-performance.txt"))
+        .setCpuBoostFile("")
+        .setCpuNoTurboFile("")
+        .setCpuInfoFile("")
+    };
+    t.registerTest("here.cpp", "TesterTest::Test");
+    int result = t.exec(&out, &out);
+
+    CORRADE_COMPARE(result, 0);
+    /* Same as wall clock output */
+    CORRADE_COMPARE_AS(out.str(),
+        Utility::Directory::join(TESTER_TEST_DIR, "benchmarkWallClock.txt"),
+        Compare::StringToFile);
+}
+
+void TesterTest::benchmarkCpuScalingWarning() {
+    std::stringstream out;
+
+    const char* argv[] = { "", "--color", "off", "--only", "40 42" };
+    int argc = Containers::arraySize(argv);
+    Tester::registerArguments(argc, argv);
+
+    Test t{&out, TesterConfiguration{}
+        .setCpuScalingGovernorFile(Utility::Directory::join(TESTER_TEST_DIR, "cpu-governor-powersave.txt"))
+        .setCpuBoostFile("")
+        .setCpuNoTurboFile("")
+        .setCpuInfoFile("")
+    };
+    t.registerTest("here.cpp", "TesterTest::Test");
+    int result = t.exec(&out, &out);
+
+    CORRADE_COMPARE(result, 0);
+    /* Same as wall clock output */
+    CORRADE_COMPARE_AS(out.str(),
+        Utility::Directory::join(TESTER_TEST_DIR, "benchmarkCpuScalingWarning.txt"),
+        Compare::StringToFile);
+}
+
+void TesterTest::benchmarkCpuScalingWarningVerbose() {
+    std::stringstream out;
+
+    const char* argv[] = { "", "--color", "off", "--only", "40 42", "-v" };
+    int argc = Containers::arraySize(argv);
+    Tester::registerArguments(argc, argv);
+
+    Test t{&out, TesterConfiguration{}
+        .setCpuScalingGovernorFile(Utility::Directory::join(TESTER_TEST_DIR, "cpu-governor-powersave.txt"))
+        .setCpuBoostFile("")
+        .setCpuNoTurboFile("")
+        .setCpuInfoFile("")
+    };
+    t.registerTest("here.cpp", "TesterTest::Test");
+    int result = t.exec(&out, &out);
+
+    CORRADE_COMPARE(result, 0);
+    /* Same as wall clock output */
+    CORRADE_COMPARE_AS(out.str(),
+        Utility::Directory::join(TESTER_TEST_DIR, "benchmarkCpuScalingWarningVerbose.txt"),
+        Compare::StringToFile);
+}
+
+void TesterTest::benchmarkCpuBoostWarning() {
+    std::stringstream out;
+
+    const char* argv[] = { "", "--color", "off", "--only", "40 42" };
+    int argc = Containers::arraySize(argv);
+    Tester::registerArguments(argc, argv);
+
+    Test t{&out, TesterConfiguration{}
+        .setCpuScalingGovernorFile("")
+        .setCpuBoostFile(Utility::Directory::join(TESTER_TEST_DIR, "cpu-boost-enabled.txt"))
+        .setCpuNoTurboFile("")
+        .setCpuInfoFile("")
+    };
+    t.registerTest("here.cpp", "TesterTest::Test");
+    int result = t.exec(&out, &out);
+
+    CORRADE_COMPARE(result, 0);
+    CORRADE_COMPARE_AS(out.str(),
+        Utility::Directory::join(TESTER_TEST_DIR, "benchmarkCpuBoostWarning.txt"),
+        Compare::StringToFile);
+}
+
+void TesterTest::benchmarkCpuNoTurboWarningVerbose() {
+    std::stringstream out;
+
+    const char* argv[] = { "", "--color", "off", "--only", "40 42", "-v" };
+    int argc = Containers::arraySize(argv);
+    Tester::registerArguments(argc, argv);
+
+    Test t{&out, TesterConfiguration{}
+        .setCpuScalingGovernorFile("")
+        .setCpuBoostFile("")
+        .setCpuNoTurboFile(Utility::Directory::join(TESTER_TEST_DIR, "cpu-no-turbo-disabled.txt"))
+        .setCpuInfoFile("")
+    };
+    t.registerTest("here.cpp", "TesterTest::Test");
+    int result = t.exec(&out, &out);
+
+    CORRADE_COMPARE(result, 0);
+    CORRADE_COMPARE_AS(out.str(),
+        Utility::Directory::join(TESTER_TEST_DIR, "benchmarkCpuNoTurboWarningVerbose.txt"),
+        Compare::StringToFile);
+}
+
+void TesterTest::benchmarkMachineFingerprint() {
+    std::stringstream out;
+
+    const char* argv[] = { "", "--color", "off", "--only", "40 42", "-v" };
+    int argc = Containers::arraySize(argv);
+    Tester::registerArguments(argc, argv);
+
+    Test t{&out, TesterConfiguration{}
+        .setCpuScalingGovernorFile("")
+        .setCpuBoostFile("")
+        .setCpuNoTurboFile("")
+        .setCpuInfoFile(Utility::Directory::join(TESTER_TEST_DIR, "cpuinfo.txt"))
+    };
+    t.registerTest("here.cpp", "TesterTest::Test");
+    int result = t.exec(&out, &out);
+
+    CORRADE_COMPARE(result, 0);
+
+    /* CPU count and kernel version depend on the machine, so check just the
+       beginning */
+    CORRADE_COMPARE(out.str().find("Starting TesterTest::Test with 2 test cases...\n  INFO Benchmarking on Corrade(R) Test(TM) CPU @ 3.00GHz, "), 0);
+}
+
+void TesterTest::benchmarkPinCpu() {
+    std::stringstream out;
+
+    const char* argv[] = { "", "--color", "off", "--only", "40 42", "--benchmark-cpu", "0" };
+    int argc = Containers::arraySize(argv);
+    Tester::registerArguments(argc, argv);
+
+    Test t{&out, TesterConfiguration{}
+        .setCpuScalingGovernorFile("")
+        .setCpuBoostFile("")
+        .setCpuNoTurboFile("")
+        .setCpuInfoFile("")
+    };
+    t.registerTest("here.cpp", "TesterTest::Test");
+
+    cpu_set_t before;
+    CORRADE_COMPARE(sched_getaffinity(0, sizeof(cpu_set_t), &before), 0);
+    if(!CPU_ISSET(0, &before))
+        CORRADE_SKIP("CPU 0 is not allowed for this process.");
+
+    int result = t.exec(&out, &out);
+    CORRADE_COMPARE(result, 0);
+
+    /* No warning is printed, same as wall clock output */
+    CORRADE_COMPARE_AS(out.str(),
+        Utility::Directory::join(TESTER_TEST_DIR, "benchmarkWallClock.txt"),
+        Compare::StringToFile);
+
+    /* The affinity is restored after */
+    cpu_set_t after;
+    CORRADE_COMPARE(sched_getaffinity(0, sizeof(cpu_set_t), &after), 0);
+    CORRADE_VERIFY(CPU_EQUAL(&before, &after));
+}
+
+void TesterTest::benchmarkPriority() {
+    std::stringstream out;
+
+    const char* argv[] = { "", "--color", "off", "--only", "40 42", "--benchmark-priority" };
+    int argc = Containers::arraySize(argv);
+    Tester::registerArguments(argc, argv);
+
+    Test t{&out, TesterConfiguration{}
+        .setCpuScalingGovernorFile("")
+        .setCpuBoostFile("")
+        .setCpuNoTurboFile("")
+        .setCpuInfoFile("")
+    };
+    t.registerTest("here.cpp", "TesterTest::Test");
+
+    const int before = getpriority(PRIO_PROCESS, 0);
+    int result = t.exec(&out, &out);
+    CORRADE_COMPARE(result, 0);
+
+    /* Depending on privileges this either succeeds or prints a warning, but
+       the priority is the same as before in any case */
+    CORRADE_VERIFY(out.str().find(" BENCH [42] 348.36          kB benchmarkOnce()@1x1\n") != std::string::npos);
+    CORRADE_COMPARE(getpriority(PRIO_PROCESS, 0), before);
+}
 #endif
 
 void TesterTest::testName() {
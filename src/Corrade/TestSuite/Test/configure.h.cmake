@@ -26,3 +26,4 @@
 #define RELATIVE_TEST_DIR "${RELATIVE_TEST_DIR}"
 #define ABSOLUTE_TEST_DIR "${ABSOLUTE_TEST_DIR}"
 #define TESTER_TEST_DIR "${TESTER_TEST_DIR}"
+#define TESTER_WRITE_TEST_DIR "${TESTER_WRITE_TEST_DIR}"
@@ -25,14 +25,20 @@
 
 #include "Tester.h"
 
+#include <cstdio>
 #include <cstdlib>
 #include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <map>
 #include <random>
+#include <sstream>
 #include <utility>
+#include <vector>
 
-#include "Corrade/Containers/Array.h"
+#include "Corrade/Containers/GrowableArray.h"
 #include "Corrade/Containers/ScopeGuard.h"
+#include "Corrade/Containers/StringStl.h"
 #include "Corrade/TestSuite/Implementation/BenchmarkCounters.h"
 #include "Corrade/TestSuite/Implementation/BenchmarkStats.h"
 #include "Corrade/Utility/Arguments.h"
@@ -40,8 +46,28 @@
 #include "Corrade/Utility/FormatStl.h"
 #include "Corrade/Utility/String.h"
 
-#ifdef __linux__ /* for getting processor count */
+/* On Emscripten threads are available only if the whole project is built
+   with -pthread */
+#if defined(CORRADE_BUILD_MULTITHREADED) && (!defined(CORRADE_TARGET_EMSCRIPTEN) || defined(__EMSCRIPTEN_PTHREADS__))
+#define CORRADE_TESTER_THREADED_BENCHMARKS
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+#if defined(CORRADE_TARGET_UNIX) && !defined(CORRADE_TARGET_EMSCRIPTEN) && !defined(CORRADE_TARGET_IOS)
+#define CORRADE_TESTER_PARALLEL_JOBS
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__ /* for getting processor count, CPU pinning and priority */
+#include <cerrno>
+#include <sched.h>
 #include <unistd.h>
+#include <sys/resource.h>
+#include <sys/utsname.h>
 #endif
 
 namespace Corrade { namespace TestSuite {
@@ -55,15 +81,140 @@ namespace {
 
     constexpr const char PaddingString[] = "0000000000";
 
+    /* Set by AllocationCounter.h, if included in the test executable */
+    void(*allocationCounterBegin)(){};
+    void(*allocationCounterEnd)(std::uint64_t&, std::uint64_t&){};
+
+    const char* benchmarkUnitsName(const Tester::BenchmarkUnits units) {
+        switch(units) {
+            case Tester::BenchmarkUnits::Nanoseconds: return "ns";
+            case Tester::BenchmarkUnits::Cycles: return "cycles";
+            case Tester::BenchmarkUnits::Instructions: return "instructions";
+            case Tester::BenchmarkUnits::Bytes: return "bytes";
+            case Tester::BenchmarkUnits::Count: return "count";
+        }
+
+        CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    }
+
+    std::string csvQuote(const std::string& value) {
+        std::string out;
+        out.reserve(value.size() + 2);
+        out += '"';
+        for(const char c: value) {
+            if(c == '"') out += '"';
+            out += c;
+        }
+        out += '"';
+        return out;
+    }
+
+    /* Splits a CSV line to fields, handling quotes and doubled quotes
+       inside */
+    std::vector<std::string> csvSplit(const std::string& line) {
+        std::vector<std::string> fields(1);
+        bool quoted = false;
+        for(std::size_t i = 0; i != line.size(); ++i) {
+            const char c = line[i];
+            if(quoted) {
+                if(c != '"') fields.back() += c;
+                else if(i + 1 != line.size() && line[i + 1] == '"') {
+                    fields.back() += '"';
+                    ++i;
+                } else quoted = false;
+            } else if(c == '"') quoted = true;
+            else if(c == ',') fields.emplace_back();
+            else if(c != '\r') fields.back() += c;
+        }
+        return fields;
+    }
+
+    struct BenchmarkBaseline {
+        std::string units;
+        /* Per-iteration values */
+        std::vector<double> values;
+    };
+
+    /* ID of the thread running a threaded benchmark. Zero on the main
+       thread. */
+    #ifdef CORRADE_TESTER_THREADED_BENCHMARKS
+    CORRADE_THREAD_LOCAL std::size_t benchmarkThreadId{};
+    #else
+    constexpr std::size_t benchmarkThreadId{};
+    #endif
+
+    #ifdef CORRADE_TESTER_THREADED_BENCHMARKS
+    /* Makes all threads of a threaded benchmark start and end the
+       measurement together. A thread that exits the test case leaves the
+       barrier so the remaining threads don't wait for it forever, for
+       example when a check fails before reaching the benchmark loop. */
+    class ThreadBarrier {
+        public:
+            explicit ThreadBarrier(std::size_t count): _count{count} {}
+
+            void wait() {
+                std::unique_lock<std::mutex> lock{_mutex};
+                const std::size_t generation = _generation;
+                if(++_arrived >= _count) {
+                    next();
+                    return;
+                }
+                _condition.wait(lock, [&]{ return generation != _generation; });
+            }
+
+            void leave() {
+                std::unique_lock<std::mutex> lock{_mutex};
+                --_count;
+                if(_arrived && _arrived >= _count) next();
+            }
+
+        private:
+            void next() {
+                _arrived = 0;
+                ++_generation;
+                _condition.notify_all();
+            }
+
+            std::mutex _mutex;
+            std::condition_variable _condition;
+            std::size_t _count, _arrived{}, _generation{};
+    };
+    #endif
+
+    /* Sends a command to a profiler control file such as the one passed to
+       perf record --control fifo:ctl,ack and waits for an acknowledgement, if
+       there's an acknowledgement file */
+    void profilerCommand(std::FILE* const control, std::FILE* const ack, const char* const command) {
+        std::fputs(command, control);
+        std::fflush(control);
+        if(ack) {
+            char buffer[16];
+            CORRADE_UNUSED const char* const result = std::fgets(buffer, sizeof(buffer), ack);
+        }
+    }
+
     #ifdef __linux__
     constexpr const char DefaultCpuScalingGovernorFile[] = "/sys/devices/system/cpu/cpu{}/cpufreq/scaling_governor";
+    constexpr const char DefaultCpuBoostFile[] = "/sys/devices/system/cpu/cpufreq/boost";
+    constexpr const char DefaultCpuNoTurboFile[] = "/sys/devices/system/cpu/intel_pstate/no_turbo";
+    constexpr const char DefaultCpuInfoFile[] = "/proc/cpuinfo";
     #endif
 }
 
+void Implementation::registerAllocationCounter(void(*const begin)(), void(*const end)(std::uint64_t&, std::uint64_t&)) {
+    allocationCounterBegin = begin;
+    allocationCounterEnd = end;
+}
+
 struct Tester::TesterConfiguration::Data {
     std::vector<std::string> skippedArgumentPrefixes;
+    BenchmarkResultCallback benchmarkResultCallback{};
+    void* benchmarkResultCallbackUserData{};
     #ifdef __linux__
     std::string cpuScalingGovernorFile = DefaultCpuScalingGovernorFile;
+    std::string cpuBoostFile = DefaultCpuBoostFile;
+    std::string cpuNoTurboFile = DefaultCpuNoTurboFile;
+    std::string cpuInfoFile = DefaultCpuInfoFile;
     #endif
 };
 
@@ -95,6 +246,21 @@ Tester::TesterConfiguration& Tester::TesterConfiguration::setSkippedArgumentPref
     return *this;
 }
 
+Tester::BenchmarkResultCallback Tester::TesterConfiguration::benchmarkResultCallback() const {
+    return _data ? _data->benchmarkResultCallback : nullptr;
+}
+
+void* Tester::TesterConfiguration::benchmarkResultCallbackUserData() const {
+    return _data ? _data->benchmarkResultCallbackUserData : nullptr;
+}
+
+Tester::TesterConfiguration& Tester::TesterConfiguration::setBenchmarkResultCallback(const BenchmarkResultCallback callback, void* const userData) {
+    if(!_data) _data.reset(new Data);
+    _data->benchmarkResultCallback = callback;
+    _data->benchmarkResultCallbackUserData = userData;
+    return *this;
+}
+
 #ifdef __linux__
 std::string Tester::TesterConfiguration::cpuScalingGovernorFile() const {
     return _data ? _data->cpuScalingGovernorFile : DefaultCpuScalingGovernorFile;
@@ -105,6 +271,36 @@ Tester::TesterConfiguration& Tester::TesterConfiguration::setCpuScalingGovernorF
     _data->cpuScalingGovernorFile = filename;
     return *this;
 }
+
+std::string Tester::TesterConfiguration::cpuBoostFile() const {
+    return _data ? _data->cpuBoostFile : DefaultCpuBoostFile;
+}
+
+Tester::TesterConfiguration& Tester::TesterConfiguration::setCpuBoostFile(const std::string& filename) {
+    if(!_data) _data.reset(new Data);
+    _data->cpuBoostFile = filename;
+    return *this;
+}
+
+std::string Tester::TesterConfiguration::cpuNoTurboFile() const {
+    return _data ? _data->cpuNoTurboFile : DefaultCpuNoTurboFile;
+}
+
+Tester::TesterConfiguration& Tester::TesterConfiguration::setCpuNoTurboFile(const std::string& filename) {
+    if(!_data) _data.reset(new Data);
+    _data->cpuNoTurboFile = filename;
+    return *this;
+}
+
+std::string Tester::TesterConfiguration::cpuInfoFile() const {
+    return _data ? _data->cpuInfoFile : DefaultCpuInfoFile;
+}
+
+Tester::TesterConfiguration& Tester::TesterConfiguration::setCpuInfoFile(const std::string& filename) {
+    if(!_data) _data.reset(new Data);
+    _data->cpuInfoFile = filename;
+    return *this;
+}
 #endif
 
 struct Tester::TesterState {
@@ -122,11 +318,21 @@ struct Tester::TesterState {
     std::string testFilename, testName, testCaseName, testCaseTemplateName,
         testCaseDescription, benchmarkName;
     std::size_t testCaseId{~std::size_t{}}, testCaseInstanceId{~std::size_t{}},
-        testCaseRepeatId{~std::size_t{}}, benchmarkBatchSize{}, testCaseLine{},
-        checkCount{}, diagnosticCount{};
+        testCaseRepeatId{~std::size_t{}}, benchmarkBatchSize{},
+        benchmarkCalibratedBatchSize{}, testCaseLine{}, checkCount{},
+        diagnosticCount{};
 
     std::uint64_t benchmarkBegin{};
     std::uint64_t benchmarkResult{};
+    std::uint64_t benchmarkThroughput{};
+    std::FILE *profileControl{}, *profileAck{};
+    BenchmarkUnits benchmarkThroughputUnits{};
+    std::size_t benchmarkThreadCount{1};
+    std::size_t testCaseSweepSize{};
+    #ifdef CORRADE_TESTER_THREADED_BENCHMARKS
+    ThreadBarrier* benchmarkThreadBarrier{};
+    #endif
+    Implementation::HardwareCounter hardwareCounter;
     TestCase* testCase{};
     /* When there's one more bool, this should become flags instead. Right now
        this only fill all holes in the struct layout. */
@@ -134,6 +340,15 @@ struct Tester::TesterState {
     bool verbose{};
     bool testCaseLabelPrinted{};
     bool isDebugBuild{};
+
+    #ifdef __linux__
+    /* Restored after all test cases finish with --benchmark-cpu and
+       --benchmark-priority */
+    cpu_set_t originalCpuAffinity;
+    int originalPriority{};
+    bool cpuAffinityChanged{}, priorityChanged{};
+    #endif
+
     ExpectedFailure* expectedFailure{};
     std::string expectedFailureMessage;
     TesterConfiguration configuration;
@@ -187,6 +402,14 @@ int Tester::exec(std::ostream* const logOutput, std::ostream* const errorOutput)
             .setFromEnvironment("save-diagnostic", "CORRADE_TEST_SAVE_DIAGNOSTIC")
         .addBooleanOption('v', "verbose").setHelp("verbose", "enable verbose output")
             .setFromEnvironment("verbose", "CORRADE_TEST_VERBOSE")
+        .addOption("jobs", "1").setHelp("jobs", "run tests in N parallel worker processes, 0 for one per CPU core", "N")
+            .setFromEnvironment("jobs", "CORRADE_TEST_JOBS")
+        .addBooleanOption("isolate").setHelp("isolate", "run each test case in a separate forked process")
+            .setFromEnvironment("isolate", "CORRADE_TEST_ISOLATE")
+        .addBooleanOption("timing").setHelp("timing", "print wall time of each test case and a summary of the slowest ones")
+            .setFromEnvironment("timing", "CORRADE_TEST_TIMING")
+        .addOption("timing-slowest", "5").setHelp("timing-slowest", "how many slowest test cases to list with --timing", "N")
+            .setFromEnvironment("timing-slowest", "CORRADE_TEST_TIMING_SLOWEST")
         .addOption("benchmark", "wall-time").setHelp("benchmark", "default benchmark type", "TYPE")
             .setFromEnvironment("benchmark", "CORRADE_TEST_BENCHMARK")
         .addOption("benchmark-discard", "1").setHelp("benchmark-discard", "discard first N measurements of each benchmark", "N")
@@ -195,12 +418,56 @@ int Tester::exec(std::ostream* const logOutput, std::ostream* const errorOutput)
             .setFromEnvironment("benchmark-yellow", "CORRADE_TEST_BENCHMARK_YELLOW")
         .addOption("benchmark-red", "0.25").setHelp("benchmark-red", "deviation threshold for marking benchmark red", "N")
             .setFromEnvironment("benchmark-red", "CORRADE_TEST_BENCHMARK_RED")
+        .addOption("benchmark-outliers", "0").setHelp("benchmark-outliers", "reject samples further than N median absolute deviations from the median", "N")
+            .setFromEnvironment("benchmark-outliers", "CORRADE_TEST_BENCHMARK_OUTLIERS")
+        .addBooleanOption("benchmark-percentiles").setHelp("benchmark-percentiles", "print also minimum, median and 90th and 99th percentile")
+            .setFromEnvironment("benchmark-percentiles", "CORRADE_TEST_BENCHMARK_PERCENTILES")
+        .addOption("benchmark-min-time", "0").setHelp("benchmark-min-time", "calibrate batch size of time benchmarks to take at least MS milliseconds per sample", "MS")
+            .setFromEnvironment("benchmark-min-time", "CORRADE_TEST_BENCHMARK_MIN_TIME")
+        .addOption("benchmark-precision", "0").setHelp("benchmark-precision", "keep sampling until the 95% confidence interval is within N of the mean", "N")
+            .setFromEnvironment("benchmark-precision", "CORRADE_TEST_BENCHMARK_PRECISION")
+        .addOption("benchmark-time-budget", "10000").setHelp("benchmark-time-budget", "time budget for each benchmark with --benchmark-min-time or --benchmark-precision", "MS")
+            .setFromEnvironment("benchmark-time-budget", "CORRADE_TEST_BENCHMARK_TIME_BUDGET")
+        .addOption("benchmark-warmup", "0").setHelp("benchmark-warmup", "run each benchmark for MS milliseconds before taking measurements", "MS")
+            .setFromEnvironment("benchmark-warmup", "CORRADE_TEST_BENCHMARK_WARMUP")
+        .addOption("benchmark-cpu", "").setHelp("benchmark-cpu", "pin benchmarks to given CPU core", "N")
+            .setFromEnvironment("benchmark-cpu", "CORRADE_TEST_BENCHMARK_CPU")
+        .addBooleanOption("benchmark-priority").setHelp("benchmark-priority", "raise process priority while benchmarking")
+            .setFromEnvironment("benchmark-priority", "CORRADE_TEST_BENCHMARK_PRIORITY")
+        .addOption("profile", "").setHelp("profile", "repeat only given benchmark for --profile-duration", "N")
+        .addOption("profile-duration", "5000").setHelp("profile-duration", "how long to repeat the profiled benchmark", "MS")
+            .setFromEnvironment("profile-duration", "CORRADE_TEST_PROFILE_DURATION")
+        .addOption("profile-control", "").setHelp("profile-control", "profiler control file to write enable and disable commands to", "FILE")
+        .addOption("profile-ack", "").setHelp("profile-ack", "profiler acknowledgement file to wait on after each command", "FILE")
+        .addOption("benchmark-output", "").setHelp("benchmark-output", "save raw benchmark measurements to a CSV file", "FILE")
+            .setFromEnvironment("benchmark-output", "CORRADE_TEST_BENCHMARK_OUTPUT")
+        .addOption("benchmark-baseline", "").setHelp("benchmark-baseline", "compare benchmarks against measurements saved with --benchmark-output", "FILE")
+            .setFromEnvironment("benchmark-baseline", "CORRADE_TEST_BENCHMARK_BASELINE")
+        .addOption("benchmark-baseline-alpha", "0.01").setHelp("benchmark-baseline-alpha", "significance level for baseline comparison", "N")
+            .setFromEnvironment("benchmark-baseline-alpha", "CORRADE_TEST_BENCHMARK_BASELINE_ALPHA")
         .setGlobalHelp(R"(Corrade TestSuite executable. By default runs test cases in order in which they
 were added and exits with non-zero code if any of them failed. Supported
 benchmark types:
   wall-time     wall time spent
   cpu-time      CPU time spent
-  cpu-cycles    CPU cycles spent (x86 only, gives zero result elsewhere))")
+  cpu-cycles    CPU cycles spent (x86 only, gives zero result elsewhere)
+  instructions  retired instructions
+  core-cycles   actual core cycles spent
+  l1d-misses    L1 data cache read misses
+  llc-misses    last level cache misses
+  branch-misses mispredicted branches
+  dtlb-misses   data TLB read misses
+  allocation-count  memory allocations made
+  allocated-bytes   bytes of memory allocated
+Hardware counters used by instructions to dtlb-misses are available on Linux
+only, giving zero result elsewhere. Allocation counting needs
+Corrade/TestSuite/AllocationCounter.h included in the test. Benchmarks that
+regress significantly compared to --benchmark-baseline are treated as
+failures. Pinning to a CPU core and raising priority is available on Linux
+only. Parallel test execution with --jobs and test case isolation with
+--isolate are available on Unix systems only, benchmarks are always run
+serially afterwards. The --profile-control and
+--profile-ack files are meant to be used with perf record --control.)")
         .parse(*_argc, _argv);
 
     _state->logOutput = logOutput;
@@ -224,9 +491,25 @@ benchmark types:
         defaultBenchmarkType = TestCaseType::CpuTimeBenchmark;
     else if(args.value("benchmark") == "cpu-cycles")
         defaultBenchmarkType = TestCaseType::CpuCyclesBenchmark;
+    else if(args.value("benchmark") == "instructions")
+        defaultBenchmarkType = TestCaseType::InstructionsBenchmark;
+    else if(args.value("benchmark") == "core-cycles")
+        defaultBenchmarkType = TestCaseType::CoreCyclesBenchmark;
+    else if(args.value("benchmark") == "l1d-misses")
+        defaultBenchmarkType = TestCaseType::L1DataCacheMissesBenchmark;
+    else if(args.value("benchmark") == "llc-misses")
+        defaultBenchmarkType = TestCaseType::LastLevelCacheMissesBenchmark;
+    else if(args.value("benchmark") == "branch-misses")
+        defaultBenchmarkType = TestCaseType::BranchMissesBenchmark;
+    else if(args.value("benchmark") == "dtlb-misses")
+        defaultBenchmarkType = TestCaseType::DataTlbMissesBenchmark;
+    else if(args.value("benchmark") == "allocation-count")
+        defaultBenchmarkType = TestCaseType::AllocationCountBenchmark;
+    else if(args.value("benchmark") == "allocated-bytes")
+        defaultBenchmarkType = TestCaseType::AllocatedBytesBenchmark;
     /* LCOV_EXCL_START */ /* Can't test stuff that aborts the app */
     else Utility::Fatal{} << "Unknown benchmark type" << args.value("benchmark")
-        << Utility::Debug::nospace << ", use one of wall-time, cpu-time or cpu-cycles";
+        << Utility::Debug::nospace << ", use one of wall-time, cpu-time, cpu-cycles, instructions, core-cycles, l1d-misses, llc-misses, branch-misses, dtlb-misses, allocation-count or allocated-bytes";
     /* LCOV_EXCL_STOP */
 
     std::vector<std::pair<int, TestCase>> usedTestCases;
@@ -277,6 +560,35 @@ benchmark types:
         usedTestCases.emplace_back(i + 1, _state->testCases[i]);
     }
 
+    /* Run only the profiled benchmark, if requested. This overrides --only
+       and --skip. */
+    std::chrono::steady_clock::duration profileDuration{};
+    if(!args.value("profile").empty()) {
+        const std::size_t index = args.value<std::size_t>("profile");
+        if(index - 1 >= _state->testCases.size() || _state->testCases[index - 1].type == TestCaseType::Test) {
+            Error(errorOutput, _state->useColor) << Debug::boldColor(Debug::Color::Red) << "No benchmark" << index << "to profile in" << _state->testName << Debug::nospace << "!";
+            return 2;
+        }
+
+        usedTestCases.clear();
+        usedTestCases.emplace_back(index, _state->testCases[index - 1]);
+        profileDuration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::milli>{args.value<double>("profile-duration")});
+    }
+
+    /* Open profiler control files. Opening a FIFO blocks until the other
+       side opens it as well. */
+    /* LCOV_EXCL_START */ /* Can't test stuff that aborts the app */
+    if(!args.value("profile-control").empty() && !(_state->profileControl = std::fopen(args.value("profile-control").data(), "w")))
+        Utility::Fatal{} << "Cannot open profiler control file" << args.value("profile-control");
+    if(!args.value("profile-ack").empty() && !(_state->profileAck = std::fopen(args.value("profile-ack").data(), "r")))
+        Utility::Fatal{} << "Cannot open profiler acknowledgement file" << args.value("profile-ack");
+    /* LCOV_EXCL_STOP */
+    Containers::ScopeGuard profileClose{&*_state, [](TesterState* state) {
+        if(state->profileControl) std::fclose(state->profileControl);
+        if(state->profileAck) std::fclose(state->profileAck);
+        state->profileControl = state->profileAck = nullptr;
+    }};
+
     const std::size_t repeatAllCount = args.value<std::size_t>("repeat-all");
     const std::size_t repeatEveryCount = args.value<std::size_t>("repeat-every");
     /* LCOV_EXCL_START */ /* Can't test stuff that aborts the app */
@@ -294,6 +606,65 @@ benchmark types:
     if(args.isSet("shuffle"))
         std::shuffle(usedTestCases.begin(), usedTestCases.end(), std::minstd_rand{std::random_device{}()});
 
+    /* Load benchmark baseline, if requested. Header lines are skipped
+       wherever they are so it's possible to simply concatenate output of
+       multiple test executables into one file. */
+    std::map<std::pair<std::string, std::string>, BenchmarkBaseline> benchmarkBaseline;
+    if(!args.value("benchmark-baseline").empty()) {
+        const std::string& filename = args.value("benchmark-baseline");
+        /* LCOV_EXCL_START */ /* Can't test stuff that aborts the app */
+        if(!Utility::Directory::exists(filename))
+            Utility::Fatal{} << "Cannot open benchmark baseline file" << filename;
+        /* LCOV_EXCL_STOP */
+
+        for(const std::string& line: Utility::String::splitWithoutEmptyParts(Utility::Directory::readString(filename), '\n')) {
+            const std::vector<std::string> fields = csvSplit(line);
+            if(fields.size() < 5 || fields[4] == "value") continue;
+
+            const std::uint64_t batchSize = std::strtoull(fields[3].data(), nullptr, 10);
+            if(!batchSize) continue;
+
+            BenchmarkBaseline& baseline = benchmarkBaseline[{fields[0], fields[1]}];
+            baseline.units = fields[2];
+            baseline.values.push_back(double(std::strtoull(fields[4].data(), nullptr, 10))/double(batchSize));
+        }
+    }
+    const double benchmarkBaselineAlpha = args.value<double>("benchmark-baseline-alpha");
+
+    /* Robust statistics, batch size calibration and adaptive sampling */
+    const std::size_t benchmarkDiscardCount = args.value<std::size_t>("benchmark-discard");
+    const double benchmarkOutliers = args.value<double>("benchmark-outliers");
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    const std::uint64_t benchmarkMinTime = std::uint64_t(args.value<double>("benchmark-min-time")*1000000.0);
+    #else
+    /* Browsers clamp the clock resolution to mitigate Spectre, which makes
+       short samples useless. Unless specified explicitly, calibrate the batch
+       size so each sample spans at least a hundred clock ticks, keeping the
+       rounding error around 1%. */
+    std::uint64_t benchmarkMinTime = std::uint64_t(args.value<double>("benchmark-min-time")*1000000.0);
+    if(!benchmarkMinTime && !args.isSet("skip-benchmarks"))
+        benchmarkMinTime = 100*Implementation::wallTimeResolution();
+    #endif
+    const double benchmarkPrecision = args.value<double>("benchmark-precision");
+    const std::chrono::steady_clock::duration benchmarkTimeBudget = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::milli>{args.value<double>("benchmark-time-budget")});
+    const std::chrono::steady_clock::duration benchmarkWarmup = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::milli>{args.value<double>("benchmark-warmup")});
+
+    /* Mean time of single-threaded runs of threaded benchmarks, used for
+       calculating the speedup on more threads */
+    std::map<std::string, double> benchmarkSingleThreadMeans;
+
+    /* Sizes and mean times of sweep benchmarks, fitted with a complexity
+       curve after the last size */
+    std::map<std::string, std::pair<std::vector<std::size_t>, std::vector<double>>> benchmarkSweepMeans;
+
+    /* Decides the order of the two sides in each sample of comparison
+       benchmarks. Default-seeded so the order is reproducible. */
+    std::minstd_rand comparisonOrder;
+
+    /* Raw benchmark measurements for --benchmark-output, the file is written
+       after everything finishes */
+    std::string benchmarkOutput = "test,case,units,batch size,value,throughput units,throughput\n";
+
     /* Save the path for diagnostic files, if set; remember verbosity */
     _state->saveDiagnosticPath = args.value("save-diagnostic");
     _state->verbose = args.isSet("verbose");
@@ -336,6 +707,29 @@ benchmark types:
             Debug(logOutput, _state->useColor) << Debug::boldColor(Debug::Color::White) << "  INFO" << Debug::resetColor << "Benchmarking a debug build.";
         }
         #ifdef __linux__
+        /* Print a fingerprint of the machine so it's possible to tell apart
+           results coming from different systems */
+        const std::string cpuInfoFile = _state->configuration.cpuInfoFile();
+        if(_state->verbose && Utility::Directory::exists(cpuInfoFile)) {
+            std::string model;
+            for(const std::string& line: Utility::String::splitWithoutEmptyParts(Utility::Directory::readString(cpuInfoFile), '\n')) {
+                if(!Utility::String::beginsWith(line, "model name")) continue;
+                const std::size_t colon = line.find(':');
+                if(colon != std::string::npos)
+                    model = Utility::String::trim(line.substr(colon + 1));
+                break;
+            }
+
+            utsname system;
+            if(!model.empty() && uname(&system) == 0)
+                Debug(logOutput, _state->useColor)
+                    << Debug::boldColor(Debug::Color::White) << "  INFO"
+                    << Debug::resetColor << "Benchmarking on" << model
+                    << Debug::nospace << "," << sysconf(_SC_NPROCESSORS_ONLN)
+                    << "CPUs," << system.sysname << system.release
+                    << system.machine << Debug::nospace << ".";
+        }
+
         for(std::size_t i = 0, count = sysconf(_SC_NPROCESSORS_ONLN); i != count; ++i) {
             const std::string file = Utility::formatString(_state->configuration.cpuScalingGovernorFile().data(), i);
             if(!Utility::Directory::exists(file)) break;
@@ -350,10 +744,121 @@ benchmark types:
                 break;
             }
         }
+
+        /* Frequency boost makes the results depend on thermals and load of
+           other cores. There are two different knobs depending on the
+           driver. */
+        const std::string boostFile = _state->configuration.cpuBoostFile();
+        const std::string noTurboFile = _state->configuration.cpuNoTurboFile();
+        const char* boostHint = nullptr;
+        if(Utility::Directory::exists(boostFile) && Utility::String::trim(Utility::Directory::readString(boostFile)) == "1")
+            boostHint = "echo 0 | sudo tee /sys/devices/system/cpu/cpufreq/boost";
+        else if(Utility::Directory::exists(noTurboFile) && Utility::String::trim(Utility::Directory::readString(noTurboFile)) == "0")
+            boostHint = "echo 1 | sudo tee /sys/devices/system/cpu/intel_pstate/no_turbo";
+        if(boostHint) {
+            Warning out{errorOutput, _state->useColor};
+
+            out << Debug::boldColor(Debug::Color::Yellow) << "  WARN"
+                << Debug::resetColor << "CPU frequency boost detected, benchmark measurements may be noisy.";
+            if(_state->verbose) out << Utility::formatString("Use\n         {}\n       to disable it.", boostHint);
+        }
         #endif
         break;
     }
 
+    /* Pin benchmarks to a single core and raise their priority, if requested.
+       Both get restored once all test cases finish. */
+    const bool hasBenchmarks = std::find_if(usedTestCases.begin(), usedTestCases.end(), [](const std::pair<int, TestCase>& testCase) {
+        return testCase.second.type != TestCaseType::Test;
+    }) != usedTestCases.end();
+    if(hasBenchmarks && !args.value("benchmark-cpu").empty()) {
+        const std::size_t cpu = args.value<std::size_t>("benchmark-cpu");
+        bool pinned = false;
+        #ifdef __linux__
+        if(cpu < CPU_SETSIZE && sched_getaffinity(0, sizeof(cpu_set_t), &_state->originalCpuAffinity) == 0) {
+            cpu_set_t affinity;
+            CPU_ZERO(&affinity);
+            CPU_SET(cpu, &affinity);
+            pinned = _state->cpuAffinityChanged = sched_setaffinity(0, sizeof(cpu_set_t), &affinity) == 0;
+        }
+        #endif
+
+        if(!pinned) {
+            Warning out{errorOutput, _state->useColor};
+
+            out << Debug::boldColor(Debug::Color::Yellow) << "  WARN"
+                << Debug::resetColor << "Can't pin benchmarks to CPU" << cpu
+                << Debug::nospace << ", benchmark measurements may be noisy.";
+            #ifdef __linux__
+            if(_state->verbose) out << "Check that the CPU is online and\n       allowed for this process.";
+            #else
+            if(_state->verbose) out << "Pinning is supported only on Linux.";
+            #endif
+        }
+    }
+    if(hasBenchmarks && args.isSet("benchmark-priority")) {
+        bool raised = false;
+        #ifdef __linux__
+        /* -1 is a valid priority, so errno has to be checked instead */
+        errno = 0;
+        const int priority = getpriority(PRIO_PROCESS, 0);
+        if(errno == 0 && setpriority(PRIO_PROCESS, 0, -20) == 0) {
+            _state->originalPriority = priority;
+            raised = _state->priorityChanged = true;
+        }
+        #endif
+
+        if(!raised) {
+            Warning out{errorOutput, _state->useColor};
+
+            out << Debug::boldColor(Debug::Color::Yellow) << "  WARN"
+                << Debug::resetColor << "Can't raise process priority, benchmark measurements may be noisy.";
+            #ifdef __linux__
+            if(_state->verbose) out << "Run the test as root or with the\n       CAP_SYS_NICE capability.";
+            #else
+            if(_state->verbose) out << "Raising priority is supported only on Linux.";
+            #endif
+        }
+    }
+    #ifdef __linux__
+    Containers::ScopeGuard environmentReset{&*_state, [](TesterState* state) {
+        if(state->cpuAffinityChanged)
+            sched_setaffinity(0, sizeof(cpu_set_t), &state->originalCpuAffinity);
+        if(state->priorityChanged)
+            setpriority(PRIO_PROCESS, 0, state->originalPriority);
+        state->cpuAffinityChanged = state->priorityChanged = false;
+    }};
+    #endif
+
+    /* If hardware counters are used, check that they can be opened to not
+       silently report zeros */
+    for(std::pair<int, TestCase> testCase: usedTestCases) {
+        const TestCaseType type = testCase.second.type == TestCaseType::DefaultBenchmark ? defaultBenchmarkType : testCase.second.type;
+        if(int(type) < int(TestCaseType::InstructionsBenchmark) || int(type) > int(TestCaseType::DataTlbMissesBenchmark)) continue;
+
+        if(!_state->hardwareCounter.open(Implementation::HardwareCounter::Event(int(type) - int(TestCaseType::InstructionsBenchmark)))) {
+            Warning out{errorOutput, _state->useColor};
+
+            out << Debug::boldColor(Debug::Color::Yellow) << "  WARN"
+                << Debug::resetColor << "Hardware performance counters are not available, benchmark measurements will be zero.";
+            if(_state->verbose) out << "Check that\n         /proc/sys/kernel/perf_event_paranoid\n       is 2 or less and the system provides a performance monitoring unit.";
+        }
+        break;
+    }
+
+    /* Same for allocation counting, which needs AllocationCounter.h included
+       in the executable */
+    if(!allocationCounterBegin) for(std::pair<int, TestCase> testCase: usedTestCases) {
+        const TestCaseType type = testCase.second.type == TestCaseType::DefaultBenchmark ? defaultBenchmarkType : testCase.second.type;
+        if(type != TestCaseType::AllocationCountBenchmark && type != TestCaseType::AllocatedBytesBenchmark) continue;
+
+        Warning out{errorOutput, _state->useColor};
+        out << Debug::boldColor(Debug::Color::Yellow) << "  WARN"
+            << Debug::resetColor << "Allocation counting is not available, benchmark measurements will be zero.";
+        if(_state->verbose) out << "Include\n         Corrade/TestSuite/AllocationCounter.h\n       in the test executable to enable it.";
+        break;
+    }
+
     /* Ensure the test case IDs are valid only during the test run */
     Containers::ScopeGuard testCaseIdReset{&*_state, [](TesterState* state) {
         state->testCaseId = ~std::size_t{};
@@ -361,14 +866,145 @@ benchmark types:
         state->testCaseInstanceId = ~std::size_t{};
     }};
 
+    /* Run tests in parallel worker processes, if requested. Test case I is
+       run by worker I % jobCount + 1, which saves its output and check counts
+       into a file in a temporary directory. The main process waits for all
+       workers to finish and then goes through the test cases in the
+       original order, printing the saved output for tests and running
+       benchmarks itself, so these aren't disturbed by the workers.
+
+       With --isolate, each test case gets its own worker instead, with at
+       most jobCount of them running at once. Test case I is then run by
+       worker I + 1. In both cases the workers are forked after the tester
+       was constructed, so expensive setup done in the constructor is not
+       repeated. */
+    const bool isolate = args.isSet("isolate");
+    std::size_t jobCount = args.value<std::size_t>("jobs");
+    std::size_t jobId = 0;
+    std::string jobDirectory;
+    std::vector<bool> jobForked;
+    bool useWorkers = false;
+    #ifdef CORRADE_TESTER_PARALLEL_JOBS
+    if(!jobCount) jobCount = std::max(sysconf(_SC_NPROCESSORS_ONLN), 1l);
+    if(jobCount > 1 || isolate) {
+        const std::size_t testCount = std::count_if(usedTestCases.begin(), usedTestCases.end(), [](const std::pair<int, TestCase>& testCase) {
+            return testCase.second.type == TestCaseType::Test;
+        });
+        jobCount = std::max(std::min(jobCount, testCount), std::size_t{1});
+        useWorkers = testCount && (jobCount > 1 || isolate);
+
+        jobDirectory = Utility::Directory::join(Utility::Directory::tmp(), "corrade-tester-XXXXXX");
+        /* LCOV_EXCL_START */
+        if(useWorkers && !mkdtemp(&jobDirectory[0])) {
+            Warning out{errorOutput, _state->useColor};
+            out << Debug::boldColor(Debug::Color::Yellow) << "  WARN"
+                << Debug::resetColor << "Cannot create a temporary directory"
+                << jobDirectory << Debug::nospace << ", running tests serially.";
+            jobCount = 1;
+            useWorkers = false;
+        }
+        /* LCOV_EXCL_STOP */
+    }
+
+    if(useWorkers) {
+        /* Flush everything so the workers don't print anything that was
+           buffered before the fork again */
+        std::fflush(stdout);
+        std::fflush(stderr);
+        std::cout.flush();
+        std::cerr.flush();
+        logOutput->flush();
+        errorOutput->flush();
+
+        if(isolate) {
+            jobForked.resize(usedTestCases.size());
+            std::size_t running = 0;
+            for(std::size_t i = 0; i != usedTestCases.size(); ++i) {
+                if(usedTestCases[i].second.type != TestCaseType::Test) continue;
+
+                /* Wait for any worker to finish if too many are running */
+                if(running == jobCount) {
+                    waitpid(-1, nullptr, 0);
+                    --running;
+                }
+
+                const pid_t pid = fork();
+                if(pid == 0) {
+                    jobId = i + 1;
+                    break;
+                }
+
+                /* If the fork fails, the main process runs the test itself */
+                if(pid > 0) ++running;
+                jobForked[i] = pid > 0;
+            }
+
+            if(!jobId) for(; running; --running)
+                waitpid(-1, nullptr, 0);
+
+        } else {
+            std::vector<pid_t> workers;
+            for(std::size_t i = 1; i <= jobCount; ++i) {
+                const pid_t pid = fork();
+                if(pid == 0) {
+                    jobId = i;
+                    break;
+                }
+
+                /* If the fork fails, the main process runs the tests
+                   itself */
+                if(pid > 0) workers.push_back(pid);
+                jobForked.push_back(pid > 0);
+            }
+
+            if(!jobId) for(const pid_t pid: workers)
+                waitpid(pid, nullptr, 0);
+        }
+    }
+    #else
+    if(jobCount != 1) {
+        Warning out{errorOutput, _state->useColor};
+        out << Debug::boldColor(Debug::Color::Yellow) << "  WARN"
+            << Debug::resetColor << "Parallel test execution is not supported on this platform, running tests serially.";
+        jobCount = 1;
+    }
+    if(isolate) {
+        Warning out{errorOutput, _state->useColor};
+        out << Debug::boldColor(Debug::Color::Yellow) << "  WARN"
+            << Debug::resetColor << "Test case isolation is not supported on this platform, running tests in-process.";
+    }
+    #endif
+
+    /* Per-test-case timing for --timing, including test cases run by
+       workers, which pass it in the file together with the output */
+    const bool timing = args.isSet("timing");
+    struct Timing {
+        int testCaseId;
+        std::string label;
+        std::uint64_t nanoseconds, setupTeardownNanoseconds;
+    };
+    std::vector<Timing> timings;
+
     bool abortedOnFail = false;
-    for(std::pair<int, TestCase> testCase: usedTestCases) {
+    for(std::size_t caseIndex = 0; caseIndex != usedTestCases.size(); ++caseIndex) {
+        std::pair<int, TestCase> testCase = usedTestCases[caseIndex];
+
+        /* Output of a test case run in a worker process is buffered. If the
+           log output goes to the standard output as well, it's buffered
+           together with the debug output to preserve the order. */
+        std::ostringstream jobLogOutput, jobErrorOutput, jobStandardOutput,
+            jobStandardError;
+        std::ostream* const debugOutput = !jobId ? &std::cout :
+            logOutput == &std::cout ? &jobLogOutput : &jobStandardOutput;
+        std::ostream* const warningOutput = !jobId ? &std::cerr :
+            errorOutput == &std::cerr ? &jobErrorOutput : &jobStandardError;
+
         /* Reset output to stdout for each test case to prevent debug
            output segfaults */
         /** @todo Drop this when Debug::setOutput() is removed */
-        Debug resetDebugRedirect{&std::cout};
-        Error resetErrorRedirect{&std::cerr};
-        Utility::Warning resetWarningRedirect{&std::cerr};
+        Debug resetDebugRedirect{debugOutput};
+        Error resetErrorRedirect{warningOutput};
+        Utility::Warning resetWarningRedirect{warningOutput};
 
         /* Select default benchmark */
         if(testCase.second.type == TestCaseType::DefaultBenchmark)
@@ -403,6 +1039,34 @@ benchmark types:
                 benchmarkUnits = BenchmarkUnits::Cycles;
                 break;
 
+            case TestCaseType::InstructionsBenchmark:
+            case TestCaseType::CoreCyclesBenchmark:
+            case TestCaseType::L1DataCacheMissesBenchmark:
+            case TestCaseType::LastLevelCacheMissesBenchmark:
+            case TestCaseType::BranchMissesBenchmark:
+            case TestCaseType::DataTlbMissesBenchmark:
+                testCase.second.benchmarkBegin = &Tester::hardwareCounterBenchmarkBegin;
+                testCase.second.benchmarkEnd = &Tester::hardwareCounterBenchmarkEnd;
+                if(testCase.second.type == TestCaseType::InstructionsBenchmark)
+                    benchmarkUnits = BenchmarkUnits::Instructions;
+                else if(testCase.second.type == TestCaseType::CoreCyclesBenchmark)
+                    benchmarkUnits = BenchmarkUnits::Cycles;
+                else
+                    benchmarkUnits = BenchmarkUnits::Count;
+                break;
+
+            case TestCaseType::AllocationCountBenchmark:
+                testCase.second.benchmarkBegin = &Tester::allocationBenchmarkBegin;
+                testCase.second.benchmarkEnd = &Tester::allocationCountBenchmarkEnd;
+                benchmarkUnits = BenchmarkUnits::Count;
+                break;
+
+            case TestCaseType::AllocatedBytesBenchmark:
+                testCase.second.benchmarkBegin = &Tester::allocationBenchmarkBegin;
+                testCase.second.benchmarkEnd = &Tester::allocatedBytesBenchmarkEnd;
+                benchmarkUnits = BenchmarkUnits::Bytes;
+                break;
+
             /* These have begin/end provided by the user */
             case TestCaseType::CustomTimeBenchmark:
             case TestCaseType::CustomCycleBenchmark:
@@ -417,24 +1081,139 @@ benchmark types:
         _state->testCaseId = testCase.first;
         _state->testCaseInstanceId = testCase.second.instanceId;
         _state->testCaseLabelPrinted = false;
-        if(testCase.second.instanceId == ~std::size_t{})
+        if(testCase.second.threadCount)
+            _state->testCaseDescription = Utility::formatString(testCase.second.threadCount == 1 ? "{} thread" : "{} threads", testCase.second.threadCount);
+        else if(testCase.second.sweepSize)
+            _state->testCaseDescription = Utility::formatString("n={}", testCase.second.sweepSize);
+        else if(testCase.second.instanceId == ~std::size_t{})
             _state->testCaseDescription = {};
         else
             _state->testCaseDescription = std::to_string(testCase.second.instanceId);
+        _state->benchmarkThreadCount = testCase.second.threadCount ? testCase.second.threadCount : 1;
+        _state->testCaseSweepSize = testCase.second.sweepSize;
+
+        /* Tests are run by the workers if --jobs is used, benchmarks by the
+           main process */
+        std::size_t caseJobId = 0;
+        if(testCase.second.type == TestCaseType::Test && useWorkers)
+            caseJobId = isolate ? caseIndex + 1 : caseIndex % jobCount + 1;
+        if(jobId) {
+            if(caseJobId != jobId) continue;
+
+            /* Only counts for this test case are saved */
+            errorCount = noCheckCount = 0;
+            _state->checkCount = _state->diagnosticCount = 0;
+            _state->logOutput = &jobLogOutput;
+            _state->errorOutput = &jobErrorOutput;
+
+        /* The main process prints output of the test case run by the worker.
+           If the file isn't there, the worker crashed. */
+        } else if(caseJobId && jobForked[caseJobId - 1]) {
+            const std::string filename = Utility::Directory::join(jobDirectory, std::to_string(caseIndex));
+            const std::string data = Utility::Directory::exists(filename) ?
+                Utility::Directory::readString(filename) : std::string{};
+            const std::size_t headerEnd = data.find('\n');
+            const std::vector<std::string> header = Utility::String::split(data.substr(0, headerEnd), ' ');
+            bool failed;
+            if(header.size() == 11) {
+                const unsigned int caseErrorCount = std::stoul(header[0]);
+                errorCount += caseErrorCount;
+                noCheckCount += std::stoul(header[1]);
+                _state->checkCount += std::stoul(header[2]);
+                _state->diagnosticCount += std::stoul(header[3]);
+                failed = caseErrorCount != 0;
+
+                std::size_t offset = headerEnd + 1;
+                std::ostream* const outputs[]{logOutput, errorOutput, &std::cout, &std::cerr};
+                for(std::size_t i = 0; i != 4; ++i) {
+                    const std::size_t size = std::min(std::size_t(std::stoull(header[6 + i])), data.size() - offset);
+                    outputs[i]->write(data.data() + offset, size);
+                    offset += size;
+                }
+
+                /* The timing line was already printed by the worker as a
+                   part of the log output, only remember it for the summary */
+                if(timing)
+                    timings.push_back({testCase.first, data.substr(offset, std::stoull(header[10])), std::stoull(header[4]), std::stoull(header[5])});
+            } else {
+                _state->testCaseRepeatId = ~std::size_t{};
+                _state->testCaseName.clear();
+                _state->testCaseTemplateName.clear();
+                Error out{errorOutput, _state->useColor};
+                printTestCaseLabel(out, "  FAIL", Debug::Color::Red, Debug::Color::Default);
+                out << "worker process exited unexpectedly";
+                ++errorCount;
+                failed = true;
+            }
+
+            /* Abort on first failure */
+            if(failed && args.isSet("abort-on-fail")) {
+                abortedOnFail = true;
+                break;
+            }
+
+            continue;
+        }
 
         /* Final combined repeat count */
         const std::size_t repeatCount = testCase.second.repeatCount*repeatEveryCount;
 
-        /* Array with benchmark measurements */
-        Containers::Array<std::uint64_t> measurements{testCase.second.type != TestCaseType::Test ? repeatCount : 0};
+        /* Array with benchmark measurements. For comparison benchmarks the
+           measurements of the compared test are stored separately, and for
+           each side also the state that differs between the two. */
+        Containers::Array<std::uint64_t> measurements, comparedMeasurements;
+        struct ComparisonSide {
+            std::uint64_t result;
+            std::size_t batchSize, line;
+            std::string name, templateName;
+            std::uint64_t throughput;
+            BenchmarkUnits throughputUnits;
+        } comparisonSides[2]{};
+
+        /* Batch size calibration and adaptive sampling is done only for time
+           benchmarks. A nonzero calibrated batch size makes
+           createBenchmarkRunner() use it instead of the requested one. */
+        const bool isTimeBenchmark = testCase.second.type != TestCaseType::Test && benchmarkUnits == BenchmarkUnits::Nanoseconds;
+        std::uint64_t minTime = isTimeBenchmark ? benchmarkMinTime : 0;
+        const bool adaptive = testCase.second.type != TestCaseType::Test && !testCase.second.comparedTest && benchmarkPrecision > 0.0;
+        _state->benchmarkCalibratedBatchSize = minTime ? 1 : 0;
+        std::size_t calibrationCount = 0, warmupCount = 0;
+        bool warmup = testCase.second.type != TestCaseType::Test && benchmarkWarmup != std::chrono::steady_clock::duration::zero();
+        std::chrono::steady_clock::time_point benchmarkStart = std::chrono::steady_clock::now();
+        _state->benchmarkThroughput = 0;
+
+        /* Wall time spent in the test case for --timing, and the part of it
+           spent in setup and teardown functions */
+        std::chrono::steady_clock::duration caseTime{}, caseSetupTeardownTime{};
 
         bool aborted = false, skipped = false;
-        for(std::size_t i = 0; i != repeatCount && !aborted; ++i) {
+        for(std::size_t i = 0; !aborted; ++i) {
+            /* Take at least the requested sample count. If adaptive sampling
+               is enabled, continue until the confidence interval of the mean
+               is small enough or the time budget is exhausted. */
+            const std::size_t sampleId = i - calibrationCount - warmupCount;
+            if(profileDuration != std::chrono::steady_clock::duration::zero()) {
+                /* When profiling, take samples until the duration passes */
+                if(sampleId && std::chrono::steady_clock::now() - benchmarkStart >= profileDuration) break;
+            } else if(sampleId >= repeatCount) {
+                if(!adaptive || std::chrono::steady_clock::now() - benchmarkStart >= benchmarkTimeBudget) break;
+
+                const std::size_t discard = measurements.empty() ? 0 :
+                    std::min(measurements.size() - 1, benchmarkDiscardCount);
+                const std::vector<std::uint64_t> kept = Implementation::rejectOutliers(measurements.suffix(discard), benchmarkOutliers);
+                double mean, stddev;
+                std::tie(mean, stddev, std::ignore) = Implementation::calculateStats({kept.data(), kept.size()}, _state->benchmarkBatchSize, 0.0, 0.0);
+                if(kept.size() >= 2 && 1.96*stddev/std::sqrt(double(kept.size())) <= benchmarkPrecision*std::abs(mean))
+                    break;
+            }
+
+            const std::chrono::steady_clock::time_point sampleStart = std::chrono::steady_clock::now();
             if(testCase.second.setup)
                 (this->*testCase.second.setup)();
+            const std::chrono::steady_clock::time_point setupEnd = std::chrono::steady_clock::now();
 
             /* Print the repeat ID only if we are repeating */
-            _state->testCaseRepeatId = repeatCount == 1 ? ~std::size_t{} : i;
+            _state->testCaseRepeatId = repeatCount == 1 ? ~std::size_t{} : sampleId;
             _state->testCaseLine = 0;
             _state->testCaseName.clear();
             _state->testCaseTemplateName.clear();
@@ -442,8 +1221,57 @@ benchmark types:
             _state->benchmarkBatchSize = 0;
             _state->benchmarkResult = 0;
 
+            /* For threaded benchmarks run the test case on additional
+               threads as well. Those only wait for each other and for the
+               main thread at the beginning and end of the benchmark loop,
+               everything else including failure reporting is done by the
+               main thread. */
+            #ifdef CORRADE_TESTER_THREADED_BENCHMARKS
+            ThreadBarrier barrier{_state->benchmarkThreadCount};
+            std::vector<std::thread> threads;
+            if(_state->benchmarkThreadCount > 1) {
+                _state->benchmarkThreadBarrier = &barrier;
+                threads.reserve(_state->benchmarkThreadCount - 1);
+                for(std::size_t threadId = 1; threadId != _state->benchmarkThreadCount; ++threadId)
+                    threads.emplace_back([this, &testCase, &barrier, threadId]() {
+                        benchmarkThreadId = threadId;
+                        try {
+                            (this->*testCase.second.test)();
+                        } catch(const Exception&) {
+                        } catch(const SkipException&) {}
+                        barrier.leave();
+                    });
+            }
+            #endif
+
             try {
-                (this->*testCase.second.test)();
+                /* Comparison benchmarks run both tests in a random order,
+                   with the setup and teardown around each. The rest of the
+                   loop then works with the result of the baseline. */
+                if(testCase.second.comparedTest) {
+                    const std::size_t first = comparisonOrder() & 1;
+                    for(const std::size_t side: {first, 1 - first}) {
+                        if(side != first) {
+                            if(testCase.second.teardown)
+                                (this->*testCase.second.teardown)();
+                            if(testCase.second.setup)
+                                (this->*testCase.second.setup)();
+                        }
+
+                        _state->testCaseLine = 0;
+                        _state->testCaseName.clear();
+                        _state->testCaseTemplateName.clear();
+                        _state->benchmarkBatchSize = 0;
+                        _state->benchmarkResult = 0;
+                        _state->benchmarkThroughput = 0;
+                        (this->*(side ? testCase.second.comparedTest : testCase.second.test))();
+                        comparisonSides[side] = {_state->benchmarkResult, _state->benchmarkBatchSize, _state->testCaseLine, _state->testCaseName, _state->testCaseTemplateName, _state->benchmarkThroughput, _state->benchmarkThroughputUnits};
+                    }
+
+                    _state->benchmarkResult = comparisonSides[0].result;
+                    _state->benchmarkBatchSize = comparisonSides[0].batchSize;
+                    _state->testCaseLine = comparisonSides[0].line;
+                } else (this->*testCase.second.test)();
             } catch(const Exception&) {
                 ++errorCount;
                 aborted = true;
@@ -452,13 +1280,59 @@ benchmark types:
                 skipped = true;
             }
 
+            #ifdef CORRADE_TESTER_THREADED_BENCHMARKS
+            if(!threads.empty()) {
+                barrier.leave();
+                for(std::thread& thread: threads) thread.join();
+                _state->benchmarkThreadBarrier = nullptr;
+            }
+            #endif
+
             _state->testCase = nullptr;
 
+            const std::chrono::steady_clock::time_point teardownStart = std::chrono::steady_clock::now();
             if(testCase.second.teardown)
                 (this->*testCase.second.teardown)();
+            const std::chrono::steady_clock::time_point sampleEnd = std::chrono::steady_clock::now();
+            caseTime += sampleEnd - sampleStart;
+            caseSetupTeardownTime += (setupEnd - sampleStart) + (sampleEnd - teardownStart);
+
+            /* Throw away all samples until the --benchmark-warmup time
+               passes. The time budget starts only after. */
+            if(testCase.second.benchmarkEnd && warmup && !aborted) {
+                const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+                if(now - benchmarkStart < benchmarkWarmup) {
+                    ++warmupCount;
+                    CORRADE_INTERNAL_ASSERT(!_state->expectedFailure);
+                    continue;
+                }
+
+                warmup = false;
+                benchmarkStart = now;
+            }
+
+            /* If the sample took less than --benchmark-min-time, increase the
+               batch size and throw the sample away. Give up after a few
+               rounds or when the batch size would overflow. */
+            if(testCase.second.benchmarkEnd && minTime && !aborted) {
+                const std::size_t batchSize = _state->benchmarkBatchSize;
+                if(batchSize && _state->benchmarkResult < minTime && calibrationCount < 10 && batchSize <= ~std::size_t{}/10 && std::chrono::steady_clock::now() - benchmarkStart < benchmarkTimeBudget) {
+                    const double factor = _state->benchmarkResult ? std::min(10.0, 1.2*double(minTime)/double(_state->benchmarkResult)) : 10.0;
+                    _state->benchmarkCalibratedBatchSize = std::max(batchSize + 1, std::size_t(double(batchSize)*factor));
+                    ++calibrationCount;
+                    CORRADE_INTERNAL_ASSERT(!_state->expectedFailure);
+                    continue;
+                }
+
+                /* Calibrated, keep the batch size for the remaining samples */
+                minTime = 0;
+            }
 
-            if(testCase.second.benchmarkEnd)
-                measurements[i] = _state->benchmarkResult;
+            if(testCase.second.benchmarkEnd) {
+                arrayAppend(measurements, _state->benchmarkResult);
+                if(testCase.second.comparedTest)
+                    arrayAppend(comparedMeasurements, comparisonSides[1].result);
+            }
 
             /* There shouldn't be any stale expected failure after the test
                case exists. If this fires for user code, they did something
@@ -470,7 +1344,7 @@ benchmark types:
         if(!aborted) {
             /* No testing/benchmark macros called */
             if(!_state->testCaseLine) {
-                Debug out{logOutput, _state->useColor};
+                Debug out{_state->logOutput, _state->useColor};
                 printTestCaseLabel(out, "     ?", Debug::Color::Yellow, Debug::Color::Yellow);
                 ++noCheckCount;
 
@@ -479,7 +1353,7 @@ benchmark types:
                otherwise make the output confusing ("is it OK or WARN?!") */
             } else if(testCase.second.type == TestCaseType::Test) {
                 if(!_state->testCaseLabelPrinted) {
-                    Debug out{logOutput, _state->useColor};
+                    Debug out{_state->logOutput, _state->useColor};
                     printTestCaseLabel(out, "    OK", Debug::Color::Default, Debug::Color::Default);
                 }
 
@@ -488,53 +1362,386 @@ benchmark types:
                 /* All other types are benchmarks */
                 CORRADE_INTERNAL_ASSERT(testCase.second.type != TestCaseType::Test);
 
-                Debug out{logOutput, _state->useColor};
-
-                const char* padding = PaddingString + sizeof(PaddingString) - digitCount(_state->testCases.size()) + digitCount(_state->testCaseId) - 1;
-
-                out << Debug::boldColor(Debug::Color::Default) << " BENCH"
-                    << Debug::color(Debug::Color::Blue) << "[" << Debug::nospace
-                    << Debug::boldColor(Debug::Color::Cyan) << padding
-                    << Debug::nospace << _state->testCaseId << Debug::nospace
-                    << Debug::color(Debug::Color::Blue) << "]";
-
-                /* Gather measurements. There needs to be at least one
-                   measurememnt left even if the discard count says otherwise. */
-                const std::size_t discardMeasurements = measurements.empty() ? 0 :
-                        std::min(measurements.size() - 1, args.value<std::size_t>("benchmark-discard"));
+                /* Comparison benchmarks print both sides, each with its own
+                   name, batch size and throughput */
+                for(std::size_t side = 0; side != (testCase.second.comparedTest ? 2 : 1); ++side) {
+                    if(testCase.second.comparedTest) {
+                        _state->testCaseName = comparisonSides[side].name;
+                        _state->testCaseTemplateName = comparisonSides[side].templateName;
+                        _state->benchmarkBatchSize = comparisonSides[side].batchSize;
+                        _state->benchmarkThroughput = comparisonSides[side].throughput;
+                        _state->benchmarkThroughputUnits = comparisonSides[side].throughputUnits;
+                    }
+                    const Containers::ArrayView<const std::uint64_t> sideMeasurements = side ? comparedMeasurements : measurements;
+
+                    /* Gather measurements. There needs to be at least one
+                       measurememnt left even if the discard count says otherwise.
+                       Then reject outliers, if requested. */
+                    const std::size_t discardMeasurements = sideMeasurements.empty() ? 0 :
+                            std::min(sideMeasurements.size() - 1, benchmarkDiscardCount);
+                    const std::vector<std::uint64_t> keptMeasurements = Implementation::rejectOutliers(sideMeasurements.suffix(discardMeasurements), benchmarkOutliers);
+
+                    {
+                        Debug out{_state->logOutput, _state->useColor};
+
+                        const char* padding = PaddingString + sizeof(PaddingString) - digitCount(_state->testCases.size()) + digitCount(_state->testCaseId) - 1;
+
+                        out << Debug::boldColor(Debug::Color::Default) << " BENCH"
+                            << Debug::color(Debug::Color::Blue) << "[" << Debug::nospace
+                            << Debug::boldColor(Debug::Color::Cyan) << padding
+                            << Debug::nospace << _state->testCaseId << Debug::nospace
+                            << Debug::color(Debug::Color::Blue) << "]";
+
+                        double mean, stddev;
+                        Utility::Debug::Color color;
+                        std::tie(mean, stddev, color) = Implementation::calculateStats({keptMeasurements.data(), keptMeasurements.size()}, _state->benchmarkBatchSize, args.value<double>("benchmark-yellow"), args.value<double>("benchmark-red"));
+
+                        Implementation::printStats(out, mean, stddev, color, benchmarkUnits);
+
+                        out << Debug::boldColor(Debug::Color::Default)
+                            << _state->formattedTestCaseName() << Debug::nospace;
+
+                        /* Optional test case description */
+                        if(!_state->testCaseDescription.empty()) {
+                            out << "("
+                                << Debug::nospace
+                                << Debug::resetColor << _state->testCaseDescription
+                                << Debug::nospace << Debug::boldColor(Debug::Color::Default)
+                                << ")";
+                        } else out << "()";
+
+                        out << Debug::nospace << "@" << Debug::nospace
+                            << keptMeasurements.size()
+                            << Debug::nospace << "x" << Debug::nospace << _state->benchmarkBatchSize
+                            << Debug::resetColor;
+                        if(!_state->benchmarkName.empty())
+                            out << "(" << Utility::Debug::nospace << _state->benchmarkName
+                                << Utility::Debug::nospace << ")";
+                    }
+
+                    /* Print throughput, if the benchmark specified how much
+                       data it processes */
+                    if(_state->benchmarkThroughput && benchmarkUnits == BenchmarkUnits::Nanoseconds && _state->benchmarkBatchSize && !keptMeasurements.empty()) {
+                        double mean;
+                        std::tie(mean, std::ignore, std::ignore) = Implementation::calculateStats({keptMeasurements.data(), keptMeasurements.size()}, _state->benchmarkBatchSize, 0.0, 0.0);
+
+                        const char* padding = PaddingString + sizeof(PaddingString) - digitCount(_state->testCases.size()) + digitCount(_state->testCaseId) - 1;
+
+                        Debug out{_state->logOutput, _state->useColor};
+                        out << "      " << Debug::color(Debug::Color::Blue) << "["
+                            << Debug::nospace << Debug::boldColor(Debug::Color::Cyan)
+                            << padding << Debug::nospace << _state->testCaseId
+                            << Debug::nospace << Debug::color(Debug::Color::Blue)
+                            << "]" << Debug::resetColor << "throughput";
+                        if(mean > 0.0)
+                            out << Implementation::formatThroughput(1000000000.0*double(_state->benchmarkThroughput)/mean, _state->benchmarkThroughputUnits);
+                        else out << "too fast to calculate";
+                    }
+
+                    /* Print also percentiles, if requested */
+                    if(args.isSet("benchmark-percentiles") && _state->benchmarkBatchSize && !keptMeasurements.empty()) {
+                        std::vector<double> values;
+                        values.reserve(keptMeasurements.size());
+                        for(const std::uint64_t v: keptMeasurements)
+                            values.push_back(double(v)/double(_state->benchmarkBatchSize));
+
+                        const char* padding = PaddingString + sizeof(PaddingString) - digitCount(_state->testCases.size()) + digitCount(_state->testCaseId) - 1;
+
+                        Debug{_state->logOutput, _state->useColor}
+                            << "      " << Debug::color(Debug::Color::Blue) << "["
+                            << Debug::nospace << Debug::boldColor(Debug::Color::Cyan)
+                            << padding << Debug::nospace << _state->testCaseId
+                            << Debug::nospace << Debug::color(Debug::Color::Blue)
+                            << "]" << Debug::resetColor << "min"
+                            << Implementation::formatValue(*std::min_element(values.begin(), values.end()), benchmarkUnits)
+                            << Debug::nospace << ", median"
+                            << Implementation::formatValue(Implementation::percentile(values, 0.5), benchmarkUnits)
+                            << Debug::nospace << ", p90"
+                            << Implementation::formatValue(Implementation::percentile(values, 0.9), benchmarkUnits)
+                            << Debug::nospace << ", p99"
+                            << Implementation::formatValue(Implementation::percentile(values, 0.99), benchmarkUnits);
+                    }
+
+                    /* Print aggregate and per-thread throughput for threaded
+                       benchmarks, and speedup compared to a single-threaded run of
+                       the same benchmark if there was one */
+                    if(testCase.second.threadCount && _state->benchmarkBatchSize && !keptMeasurements.empty()) {
+                        double mean;
+                        std::tie(mean, std::ignore, std::ignore) = Implementation::calculateStats({keptMeasurements.data(), keptMeasurements.size()}, _state->benchmarkBatchSize, 0.0, 0.0);
+
+                        const std::string name = _state->formattedTestCaseName();
+                        if(testCase.second.threadCount == 1)
+                            benchmarkSingleThreadMeans[name] = mean;
+
+                        const char* padding = PaddingString + sizeof(PaddingString) - digitCount(_state->testCases.size()) + digitCount(_state->testCaseId) - 1;
+
+                        Debug out{_state->logOutput, _state->useColor};
+                        out << "      " << Debug::color(Debug::Color::Blue) << "["
+                            << Debug::nospace << Debug::boldColor(Debug::Color::Cyan)
+                            << padding << Debug::nospace << _state->testCaseId
+                            << Debug::nospace << Debug::color(Debug::Color::Blue)
+                            << "]" << Debug::resetColor;
+                        if(mean > 0.0) {
+                            out << Implementation::formatValue(1000000000.0*double(testCase.second.threadCount)/mean, BenchmarkUnits::Count) + "/s"
+                                << "aggregate," << Implementation::formatValue(1000000000.0/mean, BenchmarkUnits::Count) + "/s"
+                                << "per thread";
+                            auto found = benchmarkSingleThreadMeans.find(name);
+                            if(testCase.second.threadCount != 1 && found != benchmarkSingleThreadMeans.end())
+                                out << Debug::nospace << "," << Utility::formatString("{:.2f}x", found->second*double(testCase.second.threadCount)/mean)
+                                    << "speedup";
+                        } else out << "too fast to calculate throughput";
+                    }
+
+                    /* Remember means of sweep benchmarks and after the last
+                       size print the fitted complexity and sizes where the
+                       cost per item jumps */
+                    if(testCase.second.sweepSize) {
+                        const std::string name = _state->formattedTestCaseName();
+                        std::pair<std::vector<std::size_t>, std::vector<double>>& points = benchmarkSweepMeans[name];
+                        if(_state->benchmarkBatchSize && !keptMeasurements.empty()) {
+                            double mean;
+                            std::tie(mean, std::ignore, std::ignore) = Implementation::calculateStats({keptMeasurements.data(), keptMeasurements.size()}, _state->benchmarkBatchSize, 0.0, 0.0);
+                            points.first.push_back(testCase.second.sweepSize);
+                            points.second.push_back(mean);
+                        }
+
+                        if(testCase.second.lastInSweep) {
+                            const char* padding = PaddingString + sizeof(PaddingString) - digitCount(_state->testCases.size()) + digitCount(_state->testCaseId) - 1;
+                            auto printPrefix = [&](Debug& out) {
+                                out << "      " << Debug::color(Debug::Color::Blue) << "["
+                                    << Debug::nospace << Debug::boldColor(Debug::Color::Cyan)
+                                    << padding << Debug::nospace << _state->testCaseId
+                                    << Debug::nospace << Debug::color(Debug::Color::Blue)
+                                    << "]" << Debug::resetColor;
+                            };
+
+                            if(points.first.size() < 3) {
+                                Debug out{_state->logOutput, _state->useColor};
+                                printPrefix(out);
+                                out << "too few sizes to fit complexity";
+                            } else {
+                                const std::pair<Implementation::Complexity, double> fit = Implementation::fitComplexity({points.first.data(), points.first.size()}, {points.second.data(), points.second.size()});
+                                {
+                                    Debug out{_state->logOutput, _state->useColor};
+                                    printPrefix(out);
+                                    out << "complexity" << Implementation::complexityName(fit.first) << Debug::nospace << ","
+                                        << Utility::formatString("{:.2f}%", fit.second*100.0) << "rms error";
+                                }
+
+                                for(const std::size_t i: Implementation::complexityKnees({points.first.data(), points.first.size()}, {points.second.data(), points.second.size()}, fit.first, 1.5)) {
+                                    const double factor = (points.second[i]/Implementation::complexityFunction(fit.first, double(points.first[i])))/(points.second[i - 1]/Implementation::complexityFunction(fit.first, double(points.first[i - 1])));
+                                    Debug out{_state->logOutput, _state->useColor};
+                                    printPrefix(out);
+                                    out << "knee between n=" << Debug::nospace << points.first[i - 1] << "and n=" << Debug::nospace << points.first[i] << Debug::nospace << ","
+                                        << Utility::formatString("{:.2f}x", factor) << "cost per item";
+                                }
+                            }
+
+                            benchmarkSweepMeans.erase(name);
+                        }
+                    }
+
+                    const std::string caseName = _state->formattedTestCaseName() + "(" + _state->testCaseDescription + ")";
+                    const char* const unitsName = benchmarkUnitsName(benchmarkUnits);
+
+                    /* Save raw measurements, if requested */
+                    if(!args.value("benchmark-output").empty()) {
+                        const std::string prefix = csvQuote(_state->testName) + "," + csvQuote(caseName) + "," + unitsName + "," + std::to_string(_state->benchmarkBatchSize) + ",";
+                        const bool hasThroughput = _state->benchmarkThroughput && benchmarkUnits == BenchmarkUnits::Nanoseconds;
+                        const char* const throughputUnitsName = _state->benchmarkThroughputUnits == BenchmarkUnits::Bytes ? "bytes/s" : "items/s";
+                        for(const std::uint64_t v: sideMeasurements.suffix(discardMeasurements)) {
+                            benchmarkOutput += prefix + std::to_string(v) + ",";
+                            if(hasThroughput && v)
+                                benchmarkOutput += Utility::formatString("{},{:.2f}", throughputUnitsName, 1000000000.0*double(_state->benchmarkThroughput)*double(_state->benchmarkBatchSize)/double(v));
+                            else benchmarkOutput += ",";
+                            benchmarkOutput += "\n";
+                        }
+                    }
+
+                    /* Pass the result to the user, if requested */
+                    if(const BenchmarkResultCallback callback = _state->configuration.benchmarkResultCallback()) {
+                        BenchmarkResult result;
+                        result.testName = _state->testName;
+                        result.testCaseName = caseName;
+                        result.benchmarkName = _state->benchmarkName;
+                        result.units = benchmarkUnits;
+                        result.batchSize = _state->benchmarkBatchSize;
+                        result.measurements = sideMeasurements.suffix(discardMeasurements);
+                        result.keptCount = keptMeasurements.size();
+                        std::tie(result.mean, result.stddev, std::ignore) = Implementation::calculateStats({keptMeasurements.data(), keptMeasurements.size()}, _state->benchmarkBatchSize, 0.0, 0.0);
+                        result.throughput = _state->benchmarkThroughput;
+                        result.throughputUnits = _state->benchmarkThroughputUnits;
+                        callback(result, _state->configuration.benchmarkResultCallbackUserData());
+                    }
+
+                    /* Compare to the baseline, if there's one with the same
+                       units. Print the label without the repeat ID as it's about
+                       all repeats together. */
+                    auto found = benchmarkBaseline.find({_state->testName, caseName});
+                    if(found != benchmarkBaseline.end() && found->second.units == unitsName && _state->benchmarkBatchSize) {
+                        std::vector<double> current;
+                        current.reserve(sideMeasurements.size() - discardMeasurements);
+                        for(const std::uint64_t v: sideMeasurements.suffix(discardMeasurements))
+                            current.push_back(double(v)/double(_state->benchmarkBatchSize));
+
+                        const double p = Implementation::mannWhitneyU({current.data(), current.size()}, {found->second.values.data(), found->second.values.size()});
+                        if(p < benchmarkBaselineAlpha) {
+                            const double currentMedian = Implementation::median(current);
+                            const double baselineMedian = Implementation::median(found->second.values);
+                            const double change = baselineMedian == 0.0 ? 0.0 :
+                                std::abs(currentMedian - baselineMedian)/baselineMedian*100.0;
+
+                            _state->testCaseRepeatId = ~std::size_t{};
+                            Debug out{_state->logOutput, _state->useColor};
+                            if(currentMedian > baselineMedian) {
+                                printTestCaseLabel(out, "  FAIL", Debug::Color::Red, Debug::Color::Default);
+                                out << "regressed by";
+                                ++errorCount;
+                            } else {
+                                printTestCaseLabel(out, "  INFO", Debug::Color::Default, Debug::Color::Default);
+                                out << "improved by";
+                            }
+                            out << Utility::formatString("{:.2f}%", change)
+                                << "compared to baseline (p ="
+                                << Utility::formatString("{:.4f})", p);
+                        }
+                    }
+                }
 
-                double mean, stddev;
-                Utility::Debug::Color color;
-                std::tie(mean, stddev, color) = Implementation::calculateStats(measurements.suffix(discardMeasurements), _state->benchmarkBatchSize, args.value<double>("benchmark-yellow"), args.value<double>("benchmark-red"));
-
-                Implementation::printStats(out, mean, stddev, color, benchmarkUnits);
-
-                out << Debug::boldColor(Debug::Color::Default)
-                    << _state->formattedTestCaseName() << Debug::nospace;
-
-                /* Optional test case description */
-                if(!_state->testCaseDescription.empty()) {
-                    out << "("
-                        << Debug::nospace
-                        << Debug::resetColor << _state->testCaseDescription
-                        << Debug::nospace << Debug::boldColor(Debug::Color::Default)
-                        << ")";
-                } else out << "()";
-
-                out << Debug::nospace << "@" << Debug::nospace
-                    << measurements.size() - discardMeasurements
-                    << Debug::nospace << "x" << Debug::nospace << _state->benchmarkBatchSize
-                    << Debug::resetColor;
-                if(!_state->benchmarkName.empty())
-                    out << "(" << Utility::Debug::nospace << _state->benchmarkName
-                        << Utility::Debug::nospace << ")";
+                /* Print the ratio of the compared test to the baseline */
+                if(testCase.second.comparedTest) {
+                    const std::size_t discardMeasurements = measurements.empty() ? 0 :
+                        std::min(measurements.size() - 1, benchmarkDiscardCount);
+                    double ratio, interval;
+                    std::size_t count;
+                    std::tie(ratio, interval, count) = Implementation::pairedRatio(measurements.suffix(discardMeasurements), comparisonSides[0].batchSize, comparedMeasurements.suffix(discardMeasurements), comparisonSides[1].batchSize, benchmarkOutliers);
+
+                    const char* padding = PaddingString + sizeof(PaddingString) - digitCount(_state->testCases.size()) + digitCount(_state->testCaseId) - 1;
+
+                    _state->testCaseName = comparisonSides[1].name;
+                    _state->testCaseTemplateName = comparisonSides[1].templateName;
+                    const std::string comparedName = _state->formattedTestCaseName();
+                    _state->testCaseName = comparisonSides[0].name;
+                    _state->testCaseTemplateName = comparisonSides[0].templateName;
+
+                    Debug out{_state->logOutput, _state->useColor};
+                    out << "      " << Debug::color(Debug::Color::Blue) << "["
+                        << Debug::nospace << Debug::boldColor(Debug::Color::Cyan)
+                        << padding << Debug::nospace << _state->testCaseId
+                        << Debug::nospace << Debug::color(Debug::Color::Blue)
+                        << "]" << Debug::resetColor << "ratio";
+                    if(ratio == ratio) {
+                        out << Utility::formatString("{:.2f}", ratio);
+                        if(interval == interval)
+                            out << "±" << Utility::formatString("{:.2f}", interval);
+                    } else out << "(no data)";
+                    out << comparedName + "()/" + _state->formattedTestCaseName() + "()"
+                        << "over" << count << (count == 1 ? "pair" : "pairs");
+                }
             }
 
-        /* Abort on first failure */
-        } else if(args.isSet("abort-on-fail") && !skipped) {
+        /* Abort on first failure. Workers run all their tests, the main
+           process decides. */
+        } else if(args.isSet("abort-on-fail") && !skipped && !jobId) {
             abortedOnFail = true;
             break;
         }
+
+        /* Print and remember how long the test case took, if requested */
+        const std::uint64_t caseNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(caseTime).count();
+        const std::uint64_t caseSetupTeardownNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(caseSetupTeardownTime).count();
+        std::string caseLabel;
+        if(timing) {
+            caseLabel = _state->formattedTestCaseName() + "(" + _state->testCaseDescription + ")";
+            timings.push_back({testCase.first, caseLabel, caseNanoseconds, caseSetupTeardownNanoseconds});
+
+            const char* padding = PaddingString + sizeof(PaddingString) - digitCount(_state->testCases.size()) + digitCount(_state->testCaseId) - 1;
+            Debug out{_state->logOutput, _state->useColor};
+            out << "      " << Debug::color(Debug::Color::Blue) << "["
+                << Debug::nospace << Debug::boldColor(Debug::Color::Cyan)
+                << padding << Debug::nospace << _state->testCaseId
+                << Debug::nospace << Debug::color(Debug::Color::Blue)
+                << "]" << Debug::resetColor << "took"
+                << Implementation::formatValue(double(caseNanoseconds), BenchmarkUnits::Nanoseconds);
+            if(testCase.second.setup || testCase.second.teardown)
+                out << Debug::nospace << ","
+                    << Implementation::formatValue(double(caseSetupTeardownNanoseconds), BenchmarkUnits::Nanoseconds)
+                    << "of which in setup and teardown";
+        }
+
+        /* Save the output, check counts and timing of a test case run in a
+           worker */
+        if(jobId) {
+            const std::string log = jobLogOutput.str(),
+                error = jobErrorOutput.str(),
+                standardOutput = jobStandardOutput.str(),
+                standardError = jobStandardError.str();
+            Utility::Directory::writeString(
+                Utility::Directory::join(jobDirectory, std::to_string(caseIndex)),
+                Utility::formatString("{} {} {} {} {} {} {} {} {} {} {}\n", errorCount, noCheckCount, _state->checkCount, _state->diagnosticCount, caseNanoseconds, caseSetupTeardownNanoseconds, log.size(), error.size(), standardOutput.size(), standardError.size(), caseLabel.size()) + log + error + standardOutput + standardError + caseLabel);
+        }
+    }
+
+    #ifdef CORRADE_TESTER_PARALLEL_JOBS
+    /* The worker is done, exit without running any destructors or atexit
+       handlers of the parent process */
+    if(jobId) {
+        std::fflush(stdout);
+        std::fflush(stderr);
+        std::_Exit(0);
+    }
+
+    /* Remove the files saved by workers */
+    if(useWorkers) {
+        for(std::size_t i = 0; i != usedTestCases.size(); ++i)
+            Utility::Directory::rm(Utility::Directory::join(jobDirectory, std::to_string(i)));
+        Utility::Directory::rm(jobDirectory);
+    }
+    #endif
+
+    /* Save raw benchmark measurements, if requested */
+    /* LCOV_EXCL_START */ /* Can't test stuff that aborts the app */
+    if(!args.value("benchmark-output").empty() && !Utility::Directory::writeString(args.value("benchmark-output"), benchmarkOutput))
+        Utility::Fatal{} << "Cannot write benchmark output file" << args.value("benchmark-output");
+    /* LCOV_EXCL_STOP */
+
+    /* Print the slowest test cases and the total time, if requested */
+    if(timing && !timings.empty()) {
+        std::uint64_t total = 0, totalSetupTeardown = 0;
+        for(const Timing& i: timings) {
+            total += i.nanoseconds;
+            totalSetupTeardown += i.setupTeardownNanoseconds;
+        }
+
+        std::stable_sort(timings.begin(), timings.end(), [](const Timing& a, const Timing& b) {
+            return a.nanoseconds > b.nanoseconds;
+        });
+
+        const std::size_t slowestCount = std::min(args.value<std::size_t>("timing-slowest"), timings.size());
+        if(slowestCount) {
+            Debug{logOutput, _state->useColor}
+                << Debug::boldColor(Debug::Color::Default) << "Slowest"
+                << slowestCount << (slowestCount == 1 ? "test case:" : "test cases:");
+            for(std::size_t i = 0; i != slowestCount; ++i) {
+                const char* padding = PaddingString + sizeof(PaddingString) - digitCount(_state->testCases.size()) + digitCount(timings[i].testCaseId) - 1;
+                Debug{logOutput, _state->useColor}
+                    << "      " << Debug::color(Debug::Color::Blue) << "["
+                    << Debug::nospace << Debug::boldColor(Debug::Color::Cyan)
+                    << padding << Debug::nospace << timings[i].testCaseId
+                    << Debug::nospace << Debug::color(Debug::Color::Blue)
+                    << "]" << Debug::boldColor(Debug::Color::Default)
+                    << timings[i].label << Debug::resetColor
+                    << Implementation::formatValue(double(timings[i].nanoseconds), BenchmarkUnits::Nanoseconds);
+            }
+        }
+
+        Debug{logOutput, _state->useColor}
+            << Debug::boldColor(Debug::Color::Default) << "Total time"
+            << Debug::resetColor
+            << Implementation::formatValue(double(total), BenchmarkUnits::Nanoseconds)
+            << Debug::nospace << ","
+            << Implementation::formatValue(double(totalSetupTeardown), BenchmarkUnits::Nanoseconds)
+            << "of which in setup and teardown.";
     }
 
     /* Print the final wrap-up */
@@ -625,6 +1832,33 @@ void Tester::verifyInternal(const char* expression, bool expressionValue) {
     throw Exception();
 }
 
+void Tester::resourceBudgetInternal(const int line, const char* const what, const std::string& value, const std::string& budget, const bool exceeded) {
+    ++_state->checkCount;
+    _state->testCaseLine = line;
+
+    /* If the budget is not exceeded or the failure is expected, done */
+    if(!_state->expectedFailure) {
+        if(!exceeded) return;
+    } else if(exceeded) {
+        Debug out{_state->logOutput, _state->useColor};
+        printTestCaseLabel(out, " XFAIL", Debug::Color::Yellow, Debug::Color::Default);
+        out << "at" << _state->testFilename << "on line" << line
+            << Debug::newline << "       " << _state->expectedFailureMessage
+            << what << value << "exceeded the budget of" << budget << Debug::nospace << ".";
+        return;
+    }
+
+    /* Otherwise print message to error output and throw exception */
+    Error out{_state->errorOutput, _state->useColor};
+    printTestCaseLabel(out, _state->expectedFailure ? " XPASS" : "  FAIL", Debug::Color::Red, Debug::Color::Default);
+    out << "at" << _state->testFilename << "on line" << line
+        << Debug::newline << "       " << what << value;
+    if(!_state->expectedFailure) out << "exceeded the budget of";
+    else out << "was expected to exceed the budget of";
+    out << budget << Debug::nospace << ".";
+    throw Exception();
+}
+
 void Tester::printComparisonMessageInternal(ComparisonStatusFlags flags, const char* actual, const char* expected, void(*printer)(void*, ComparisonStatusFlags, Debug&, const char*, const char*), void(*saver)(void*, ComparisonStatusFlags, Debug&, const std::string&), void* comparator) {
     ++_state->checkCount;
 
@@ -725,6 +1959,22 @@ std::size_t Tester::testCaseRepeatId() const {
     return _state->testCaseRepeatId;
 }
 
+std::size_t Tester::testCaseThreadId() const {
+    return benchmarkThreadId;
+}
+
+std::size_t Tester::testCaseThreadCount() const {
+    CORRADE_ASSERT(_state->testCaseId != ~std::size_t{},
+        "TestSuite::Tester::testCaseThreadCount(): can be called only from within a test case", {});
+    return _state->benchmarkThreadCount;
+}
+
+std::size_t Tester::testCaseSweepSize() const {
+    CORRADE_ASSERT(_state->testCaseSweepSize,
+        "TestSuite::Tester::testCaseSweepSize(): can be called only from within a sweep benchmark", {});
+    return _state->testCaseSweepSize;
+}
+
 void Tester::setTestName(const std::string& name) {
     _state->testName = name;
 }
@@ -785,7 +2035,21 @@ void Tester::setBenchmarkName(const char* name) {
     _state->benchmarkName = name;
 }
 
+void Tester::setBenchmarkThroughput(const std::uint64_t count, const BenchmarkUnits units) {
+    CORRADE_ASSERT(units == BenchmarkUnits::Bytes || units == BenchmarkUnits::Count,
+        "TestSuite::Tester::setBenchmarkThroughput(): expected bytes or count units", );
+
+    /* Additional threads of threaded benchmarks don't report anything */
+    if(benchmarkThreadId) return;
+
+    _state->benchmarkThroughput = count;
+    _state->benchmarkThroughputUnits = units;
+}
+
 void Tester::registerTestCase(const char* name, int line) {
+    /* Additional threads of threaded benchmarks don't report anything */
+    if(benchmarkThreadId) return;
+
     CORRADE_ASSERT(_state->testCase,
         "TestSuite::Tester: using verification macros outside of test cases is not allowed", );
 
@@ -794,14 +2058,39 @@ void Tester::registerTestCase(const char* name, int line) {
 }
 
 Tester::BenchmarkRunner Tester::createBenchmarkRunner(const std::size_t batchSize) {
+    /* Additional threads of threaded benchmarks only wait for the main thread
+       to set up the batch size and then run the loop without measuring
+       anything */
+    #ifdef CORRADE_TESTER_THREADED_BENCHMARKS
+    if(benchmarkThreadId) {
+        _state->benchmarkThreadBarrier->wait();
+        return BenchmarkRunner{*this, &Tester::threadedBenchmarkWorkerBegin, nullptr};
+    }
+    #endif
+
     CORRADE_ASSERT(_state->testCase,
         "TestSuite::Tester: using benchmark macros outside of test cases is not allowed",
         (BenchmarkRunner{*this, nullptr, nullptr}));
 
-    _state->benchmarkBatchSize = batchSize;
+    /* Use a larger batch size if calibrating for --benchmark-min-time */
+    if(_state->benchmarkCalibratedBatchSize && batchSize)
+        _state->benchmarkCalibratedBatchSize = _state->benchmarkBatchSize = std::max(batchSize, _state->benchmarkCalibratedBatchSize);
+    else _state->benchmarkBatchSize = batchSize;
+
+    #ifdef CORRADE_TESTER_THREADED_BENCHMARKS
+    if(_state->benchmarkThreadBarrier) _state->benchmarkThreadBarrier->wait();
+    #endif
+
+    /* Enable the profiler only for the benchmark loop itself. Done before
+       the benchmark begin function so the latency isn't measured. */
+    if(_state->profileControl)
+        profilerCommand(_state->profileControl, _state->profileAck, "enable\n");
+
     return BenchmarkRunner{*this, _state->testCase->benchmarkBegin, _state->testCase->benchmarkEnd};
 }
 
+void Tester::threadedBenchmarkWorkerBegin() {}
+
 void Tester::wallTimeBenchmarkBegin() {
     _state->benchmarkName = "wall time";
     _state->benchmarkBegin = Implementation::wallTime();
@@ -829,10 +2118,87 @@ std::uint64_t Tester::cpuCyclesBenchmarkEnd() {
     return Implementation::rdtsc() - _state->benchmarkBegin;
 }
 
+void Tester::hardwareCounterBenchmarkBegin() {
+    constexpr const char* Names[]{
+        "instructions",
+        "core cycles",
+        "L1D misses",
+        "LLC misses",
+        "branch misses",
+        "dTLB misses"
+    };
+    const std::size_t index = int(_state->testCase->type) - int(TestCaseType::InstructionsBenchmark);
+    _state->benchmarkName = Names[index];
+    _state->hardwareCounter.open(Implementation::HardwareCounter::Event(index));
+    _state->hardwareCounter.begin();
+}
+
+std::uint64_t Tester::hardwareCounterBenchmarkEnd() {
+    return _state->hardwareCounter.end();
+}
+
+void Tester::allocationBenchmarkBegin() {
+    _state->benchmarkName = _state->testCase->type == TestCaseType::AllocationCountBenchmark ? "allocations" : "allocated bytes";
+    if(allocationCounterBegin) allocationCounterBegin();
+}
+
+std::uint64_t Tester::allocationCountBenchmarkEnd() {
+    std::uint64_t count = 0, bytes = 0;
+    if(allocationCounterEnd) allocationCounterEnd(count, bytes);
+    return count;
+}
+
+std::uint64_t Tester::allocatedBytesBenchmarkEnd() {
+    std::uint64_t count = 0, bytes = 0;
+    if(allocationCounterEnd) allocationCounterEnd(count, bytes);
+    return bytes;
+}
+
 void Tester::addTestCaseInternal(const TestCase& testCase) {
     _state->testCases.push_back(testCase);
 }
 
+void Tester::addComparisonTestCaseInternal(const TestCase& testCase, const TestCase::Function comparedTest) {
+    CORRADE_ASSERT(comparedTest,
+        "TestSuite::Tester::addComparisonBenchmarks(): expected at least two benchmarks", );
+
+    TestCase comparisonTestCase = testCase;
+    comparisonTestCase.comparedTest = comparedTest;
+    _state->testCases.push_back(comparisonTestCase);
+}
+
+void Tester::addSweepTestCaseInternal(const TestCase& testCase, const std::size_t minSize, const std::size_t maxSize) {
+    CORRADE_ASSERT(minSize && minSize <= maxSize,
+        "TestSuite::Tester::addSweepBenchmarks(): expected a non-zero minimal size not larger than" << maxSize << Debug::nospace << ", got" << minSize, );
+
+    /* Powers of two times the min size and the max size at the end, if it's
+       not reached exactly */
+    TestCase sweepTestCase = testCase;
+    for(std::size_t size = minSize; ; size *= 2) {
+        sweepTestCase.sweepSize = std::min(size, maxSize);
+        sweepTestCase.lastInSweep = size >= maxSize;
+        _state->testCases.push_back(sweepTestCase);
+        if(size >= maxSize) break;
+    }
+}
+
+void Tester::addThreadedTestCaseInternal(const TestCase& testCase, std::size_t maxThreadCount) {
+    #ifdef CORRADE_TESTER_THREADED_BENCHMARKS
+    if(!maxThreadCount) maxThreadCount = std::max(1u, std::thread::hardware_concurrency());
+    #else
+    maxThreadCount = 1;
+    #endif
+
+    /* Powers of two and the max count at the end, if it's not a power of
+       two already */
+    TestCase threadedTestCase = testCase;
+    for(std::size_t threadCount = 1; ; threadCount *= 2) {
+        threadedTestCase.threadCount = std::min(threadCount, maxThreadCount);
+        _state->testCases.push_back(threadedTestCase);
+        if(threadCount >= maxThreadCount) break;
+    }
+}
+
 Tester::ExpectedFailure::ExpectedFailure(Tester& instance, std::string&& message, const bool enabled): _instance(instance) {
     if(!enabled || instance._state->expectedFailuresDisabled) return;
     instance._state->expectedFailureMessage = message;
@@ -847,8 +2213,85 @@ Tester::ExpectedFailure::~ExpectedFailure() {
     _instance._state->expectedFailure = nullptr;
 }
 
+Tester::ResourceBudget::~ResourceBudget() {
+    /* The block was left with an exception, stop counting allocations so the
+       counter is in a clean state for the next measurement */
+    if(_running && _type == Type::Allocations && allocationCounterEnd) {
+        std::uint64_t count, bytes;
+        allocationCounterEnd(count, bytes);
+    }
+}
+
+bool Tester::ResourceBudget::next() {
+    /* Start the measurement, after which the block gets executed */
+    if(!_running) {
+        _running = true;
+        switch(_type) {
+            case Type::Allocations:
+                if(allocationCounterBegin) allocationCounterBegin();
+                break;
+            case Type::WallTime:
+                _begin = Implementation::wallTime();
+                break;
+            case Type::PeakMemory:
+                _begin = Implementation::resetPeakResidentMemory() ?
+                    Implementation::peakResidentMemory() : ~std::uint64_t{};
+                break;
+        }
+        return true;
+    }
+
+    /* The block finished, end the measurement and check the budget */
+    _running = false;
+    switch(_type) {
+        case Type::Allocations: {
+            if(!allocationCounterEnd) {
+                ++_instance._state->checkCount;
+                _instance._state->testCaseLine = _line;
+                Error out{_instance._state->errorOutput, _instance._state->useColor};
+                _instance.printTestCaseLabel(out, "  FAIL", Debug::Color::Red, Debug::Color::Default);
+                out << "at" << _instance._state->testFilename << "on line" << _line << Debug::newline << "        Allocation counting is not available, include\n         Corrade/TestSuite/AllocationCounter.h\n       in the test executable to enable it.";
+                throw Exception();
+            }
+
+            std::uint64_t count, bytes;
+            allocationCounterEnd(count, bytes);
+            _instance.resourceBudgetInternal(_line, "Allocation count", std::to_string(count), std::to_string(_budget), count > _budget);
+        } break;
+        case Type::WallTime: {
+            const std::uint64_t time = Implementation::wallTime() - _begin;
+            _instance.resourceBudgetInternal(_line, "Wall time", Utility::formatString("{:.2f} ms", time/1.0e6), Utility::formatString("{:.2f} ms", _budget/1.0e6), time > _budget);
+        } break;
+        case Type::PeakMemory: {
+            if(_begin == ~std::uint64_t{}) {
+                Debug out{_instance._state->logOutput, _instance._state->useColor};
+                _instance.printTestCaseLabel(out, "  WARN", Debug::Color::Yellow, Debug::Color::Default);
+                out << "at" << _instance._state->testFilename << "on line" << _line << Debug::newline << "        Peak memory can't be measured on this system, not checking the budget.";
+                break;
+            }
+
+            const std::uint64_t peak = Implementation::peakResidentMemory();
+            const std::uint64_t growth = peak > _begin ? peak - _begin : 0;
+            _instance.resourceBudgetInternal(_line, "Peak memory growth", Utility::formatString("{} B", growth), Utility::formatString("{} B", _budget), growth > _budget);
+        } break;
+    }
+
+    return false;
+}
+
 Tester::BenchmarkRunner::~BenchmarkRunner() {
+    /* For threaded benchmarks the measurement ends once all threads are
+       done */
+    #ifdef CORRADE_TESTER_THREADED_BENCHMARKS
+    if(_instance._state->benchmarkThreadBarrier)
+        _instance._state->benchmarkThreadBarrier->wait();
+    #endif
+    if(benchmarkThreadId) return;
+
     _instance._state->benchmarkResult = (_instance.*_end)();
+
+    if(_instance._state->profileControl)
+        profilerCommand(_instance._state->profileControl, _instance._state->profileAck, "disable\n");
 }
 
 const char* Tester::BenchmarkRunner::end() const {
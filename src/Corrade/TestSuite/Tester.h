@@ -30,8 +30,11 @@
  */
 
 #include <initializer_list>
+#include <utility>
 
+#include "Corrade/Containers/ArrayView.h"
 #include "Corrade/Containers/Pointer.h"
+#include "Corrade/Containers/StringView.h"
 #include "Corrade/TestSuite/Comparator.h"
 #include "Corrade/TestSuite/Compare/FloatingPoint.h"
 #include "Corrade/TestSuite/visibility.h"
@@ -54,6 +57,10 @@ namespace Implementation {
     template<class Actual, class Expected> struct CommonType<Actual, Expected, false> {
         typedef typename std::common_type<Actual, Expected>::type Type;
     };
+
+    /* Called from AllocationCounter.h to hook into the allocation counting
+       benchmarks */
+    CORRADE_TESTSUITE_EXPORT void registerAllocationCounter(void(*begin)(), void(*end)(std::uint64_t&, std::uint64_t&));
 }
 
 /**
@@ -287,6 +294,112 @@ via `--benchmark-yellow` and `--benchmark-red`.
 It's possible to have instanced benchmarks as well, see
 @ref addInstancedBenchmarks().
 
+@section TestSuite-Tester-benchmark-throughput Benchmark throughput
+
+For benchmarks processing some amount of data it's often more useful to know
+the throughput than the time spent on a single iteration. Calling
+@ref setBenchmarkThroughput() with the amount of bytes or items processed in
+one iteration of the @ref CORRADE_BENCHMARK() loop makes time benchmarks print
+also the throughput derived from the mean time:
+
+@snippet TestSuite.cpp Tester-setBenchmarkThroughput
+
+@code{.shell-session}
+ BENCH [1]  22.35 ± 0.61   µs parse()@9x100 (wall time)
+       [1] throughput 1.71 GB/s
+@endcode
+
+Bytes are shown with prefixes being multiples of 1024, items with multiples
+of 1000, for example `Mitems/s`. With `--benchmark-output`, the throughput of
+each sample is saved as well, see @ref TestSuite-Tester-benchmark-baseline.
+
+@section TestSuite-Tester-benchmark-threaded Multi-threaded benchmarks
+
+To measure how concurrent code scales, @ref addThreadedBenchmarks() runs the
+same benchmark function on one or more threads at once. The test case is
+added once for each thread count, going in powers of two up to given maximum.
+All threads start the @ref CORRADE_BENCHMARK() loop at the same time and the
+wall time is measured until the slowest of them finishes. Use
+@ref testCaseThreadId() to partition the work or the data between threads:
+
+@snippet TestSuite.cpp Tester-addThreadedBenchmarks
+
+Besides the usual per-iteration time, an additional line shows aggregate and
+per-thread throughput of all threads together and speedup compared to the
+single-threaded run, forming a scaling curve:
+
+@code{.shell-session}
+ BENCH [1]  21.03 ± 0.47   ns push(1 thread)@9x100000 (wall time)
+       [1] 47.55 M/s aggregate, 47.55 M/s per thread
+ BENCH [2]  29.75 ± 1.12   ns push(2 threads)@9x100000 (wall time)
+       [2] 67.23 M/s aggregate, 33.61 M/s per thread, 1.41x speedup
+ BENCH [3]  52.88 ± 3.60   ns push(4 threads)@9x100000 (wall time)
+       [3] 75.64 M/s aggregate, 18.91 M/s per thread, 1.59x speedup
+@endcode
+
+Threaded benchmarks always measure wall time. The setup and teardown functions
+are executed only in the first thread and verification macros can be used only
+there as well, other threads are expected to only run the benchmark loop. Keep in mind that `--benchmark-cpu`
+pins all threads to the same core. On builds without
+@ref CORRADE_BUILD_MULTITHREADED enabled and on Emscripten builds without
+threads, only the single-threaded variant is added. See
+@ref TestSuite-Tester-running-emscripten-threads for building Emscripten tests
+with threads.
+
+@section TestSuite-Tester-benchmark-sweep Sweep benchmarks
+
+To see how a benchmark scales with the input size, @ref addSweepBenchmarks()
+adds it once for each power of two in given range of sizes. The benchmark
+queries the size using @ref testCaseSweepSize() and prepares the input
+accordingly:
+
+@snippet TestSuite.cpp Tester-addSweepBenchmarks
+
+After the largest size, the per-iteration means of all sizes are fitted with
+@f$ \mathcal{O}(1) @f$, @f$ \mathcal{O}(\log n) @f$, @f$ \mathcal{O}(n) @f$,
+@f$ \mathcal{O}(n \log n) @f$, @f$ \mathcal{O}(n^2) @f$ and
+@f$ \mathcal{O}(n^3) @f$ using least squares and the best fit is printed
+together with its relative RMS error. If the cost per item relative to the
+fitted complexity increases by 50% or more between two consecutive sizes,
+which is usually caused by the data no longer fitting into a cache, it's
+reported as a knee:
+
+@code{.shell-session}
+ BENCH [1]   2.41 ± 0.05   µs find(n=1024)@9x100 (wall time)
+ BENCH [2]   4.79 ± 0.08   µs find(n=2048)@9x100 (wall time)
+...
+ BENCH [9] 821.30 ± 9.11   µs find(n=262144)@9x100 (wall time)
+       [9] complexity O(n), 6.18% rms error
+       [9] knee between n=65536 and n=131072, 1.62x cost per item
+@endcode
+
+At least three sizes are needed for the fit. Make sure the batch size is
+large enough even for the smallest inputs, or use `--benchmark-min-time` to
+calibrate it automatically.
+
+@section TestSuite-Tester-benchmark-comparison Comparison benchmarks
+
+When comparing two implementations with @ref addBenchmarks(), each benchmark
+is sampled in its own time window and frequency scaling or thermal throttling
+in between can easily skew the result. The @ref addComparisonBenchmarks()
+function instead compares each of the listed benchmarks to the first one,
+alternating samples of both in a random order. Both get reported the usual
+way, followed by a ratio of the means together with a 95% confidence interval
+calculated from differences of the paired samples, with outliers rejected
+based on `--benchmark-outliers`:
+
+@snippet TestSuite.cpp Tester-addComparisonBenchmarks
+
+@code{.shell-session}
+ BENCH [1]   1.21 ± 0.03   µs findLinear()@9x100 (wall time)
+ BENCH [1]  52.35 ± 1.61   ns findBinary()@9x100 (wall time)
+       [1] ratio 0.04 ± 0.00 findBinary()/findLinear() over 9 pairs
+@endcode
+
+The batch size calibrated with `--benchmark-min-time` is shared by both sides
+and `--benchmark-precision` doesn't apply to comparison benchmarks, the
+requested batch count is always used.
+
 @section TestSuite-Tester-benchmark-custom Custom benchmarks
 
 It's possible to specify a custom pair of functions for intiating the benchmark
@@ -304,6 +417,29 @@ thousand times:
 
 @include testsuite-benchmark-custom.ansi
 
+@section TestSuite-Tester-resource-budget Resource budgets
+
+Benchmark results are only printed and not verified, but some performance
+properties are invariants that should hold on every run --- such as a parser
+not allocating for each token or a cache lookup not touching the heap at all.
+For those, @ref CORRADE_EXPECT_MAX_ALLOCATIONS(), @ref CORRADE_EXPECT_MAX_TIME()
+and @ref CORRADE_EXPECT_MAX_PEAK_MEMORY() measure the following block and fail
+the test case if it exceeds given budget, making it possible to have these
+checks in the regular test suite:
+
+@snippet TestSuite.cpp CORRADE_EXPECT_MAX_ALLOCATIONS
+
+@code{.shell-session}
+  FAIL [1] tokenize() at …/TokenizerTest.cpp on line 47
+        Allocation count 1024 exceeded the budget of 2.
+@endcode
+
+Each budget counts as a single check and works with @ref CORRADE_EXPECT_FAIL()
+the same way as other checks. The measurement ends at the end of the block, so
+leaving it with @cpp break @ce or @cpp return @ce skips the check. Allocation
+counting needs @ref Corrade/TestSuite/AllocationCounter.h included in the
+test executable, similarly to @ref BenchmarkType::AllocationCount.
+
 @section TestSuite-Tester-setup-teardown Specifying setup/teardown routines
 
 While the common practice in C++ is to use RAII for resource lifetime
@@ -328,8 +464,16 @@ Usage:
 ./my-test [-h|--help] [-c|--color on|off|auto] [--skip "N1 N2..."]
     [--skip-tests] [--skip-benchmarks] [--only "N1 N2..."] [--shuffle]
     [--repeat-every N] [--repeat-all N] [--abort-on-fail] [--no-xfail]
-    [--save-diagnostic PATH] [--verbose] [--benchmark TYPE]
+    [--jobs N] [--isolate] [--save-diagnostic PATH] [--verbose]
+    [--benchmark TYPE]
     [--benchmark-discard N] [--benchmark-yellow N] [--benchmark-red N]
+    [--benchmark-outliers N] [--benchmark-percentiles]
+    [--benchmark-min-time MS] [--benchmark-precision N]
+    [--benchmark-time-budget MS] [--benchmark-warmup MS]
+    [--benchmark-cpu N] [--benchmark-priority] [--profile N]
+    [--profile-duration MS] [--profile-control FILE] [--profile-ack FILE]
+    [--benchmark-output FILE] [--benchmark-baseline FILE]
+    [--benchmark-baseline-alpha N]
 @endcode
 
 Arguments:
@@ -356,6 +500,17 @@ Arguments:
     `CORRADE_TEST_ABORT_ON_FAIL=ON|OFF`)
 -   `--no-xfail` --- disallow expected failures (environment:
     `CORRADE_TEST_NO_XFAIL=ON|OFF`)
+-   `--jobs N` --- run tests in N parallel worker processes, `0` for one per
+    CPU core (environment: `CORRADE_TEST_JOBS`, default: `1`). Supported on
+    Unix systems only. See @ref TestSuite-Tester-running-parallel for details.
+-   `--isolate` --- run each test case in a separate forked process
+    (environment: `CORRADE_TEST_ISOLATE=ON|OFF`). Supported on Unix systems
+    only. See @ref TestSuite-Tester-running-parallel for details.
+-   `--timing` --- print wall time of each test case and a summary of the
+    slowest ones (environment: `CORRADE_TEST_TIMING=ON|OFF`). See
+    @ref TestSuite-Tester-running-timing for details.
+-   `--timing-slowest N` --- how many slowest test cases to list with
+    `--timing` (environment: `CORRADE_TEST_TIMING_SLOWEST`, default: `5`)
 -   `--save-diagnostic PATH` --- save diagnostic files to given path
     (environment: `CORRADE_TEST_SAVE_DIAGNOSTIC`)
 -   `-v`, `--verbose` --- enable verbose output (environment:
@@ -366,12 +521,214 @@ Arguments:
     -   `cpu-time` --- CPU time spent
     -   `cpu-cycles` --- CPU cycles spent (x86 only, gives zero result
         elsewhere)
+    -   `instructions` --- retired instructions
+    -   `core-cycles` --- actual core cycles spent
+    -   `l1d-misses` --- L1 data cache read misses
+    -   `llc-misses` --- last level cache misses
+    -   `branch-misses` --- mispredicted branches
+    -   `dtlb-misses` --- data TLB read misses
+
+    -   `allocation-count` --- memory allocations made
+    -   `allocated-bytes` --- bytes of memory allocated
+
+    The `instructions` to `dtlb-misses` types are measured using hardware
+    performance counters, which are supported on Linux only, see
+    @ref BenchmarkType::Instructions for details. The last two need
+    @ref Corrade/TestSuite/AllocationCounter.h to be included in the test,
+    see @ref BenchmarkType::AllocationCount.
 -   `--benchmark-discard N` --- discard first N measurements of each benchmark
     (environment: `CORRADE_TEST_BENCHMARK_DISCARD`, default: `1`)
 -   `--benchmark-yellow N` --- deviation threshold for marking benchmark yellow
     (environment: `CORRADE_TEST_BENCHMARK_YELLOW`, default: `0.05`)
 -   `--benchmark-red N` --- deviation threshold for marking benchmark red
     (environment: `CORRADE_TEST_BENCHMARK_RED`, default: `0.25`)
+-   `--benchmark-outliers N` --- reject samples further than N median absolute
+    deviations from the median (environment:
+    `CORRADE_TEST_BENCHMARK_OUTLIERS`, default: `0`, which disables the
+    rejection). See @ref TestSuite-Tester-benchmark-robust for details.
+-   `--benchmark-percentiles` --- print also minimum, median and 90th and 99th
+    percentile (environment: `CORRADE_TEST_BENCHMARK_PERCENTILES=ON|OFF`)
+-   `--benchmark-min-time MS` --- calibrate batch size of time benchmarks to
+    take at least MS milliseconds per sample (environment:
+    `CORRADE_TEST_BENCHMARK_MIN_TIME`, default: `0`, which disables the
+    calibration on all platforms except Emscripten)
+-   `--benchmark-precision N` --- keep sampling until the 95% confidence
+    interval is within N of the mean (environment:
+    `CORRADE_TEST_BENCHMARK_PRECISION`, default: `0`, which disables adaptive
+    sampling)
+-   `--benchmark-time-budget MS` --- time budget for each benchmark with
+    `--benchmark-min-time` or `--benchmark-precision` (environment:
+    `CORRADE_TEST_BENCHMARK_TIME_BUDGET`, default: `10000`)
+-   `--benchmark-warmup MS` --- run each benchmark for MS milliseconds before
+    taking measurements (environment: `CORRADE_TEST_BENCHMARK_WARMUP`,
+    default: `0`)
+-   `--benchmark-cpu N` --- pin benchmarks to given CPU core (environment:
+    `CORRADE_TEST_BENCHMARK_CPU`). Supported on Linux only. See
+    @ref TestSuite-Tester-benchmark-environment for details.
+-   `--benchmark-priority` --- raise process priority while benchmarking
+    (environment: `CORRADE_TEST_BENCHMARK_PRIORITY=ON|OFF`). Supported on
+    Linux only.
+-   `--profile N` --- repeat only given benchmark for `--profile-duration`.
+    See @ref TestSuite-Tester-benchmark-profile for details.
+-   `--profile-duration MS` --- how long to repeat the profiled benchmark
+    (environment: `CORRADE_TEST_PROFILE_DURATION`, default: `5000`)
+-   `--profile-control FILE` --- profiler control file to write `enable` and
+    `disable` commands to
+-   `--profile-ack FILE` --- profiler acknowledgement file to wait on after
+    each command
+-   `--benchmark-output FILE` --- save raw benchmark measurements to a CSV
+    file (environment: `CORRADE_TEST_BENCHMARK_OUTPUT`). See
+    @ref TestSuite-Tester-benchmark-baseline for details.
+-   `--benchmark-baseline FILE` --- compare benchmarks against measurements
+    previously saved with `--benchmark-output` (environment:
+    `CORRADE_TEST_BENCHMARK_BASELINE`)
+-   `--benchmark-baseline-alpha N` --- significance level for baseline
+    comparison (environment: `CORRADE_TEST_BENCHMARK_BASELINE_ALPHA`,
+    default: `0.01`)
+
+@subsection TestSuite-Tester-benchmark-baseline Saving and comparing benchmark results
+
+The `--benchmark-output` option saves all measurements that weren't discarded
+via `--benchmark-discard` into a CSV file, one sample per row, for example:
+
+@code{.csv}
+test,case,units,batch size,value,throughput units,throughput
+"MyTest","benchmarkCopy()",ns,100,48211,,
+"MyTest","benchmarkCopy()",ns,100,47340,,
+"MyTest","benchmarkParse()",ns,100,2235012,bytes/s,1834952312.56
+…
+@endcode
+
+The `units` column is one of `ns`, `cycles`, `instructions`, `bytes` or
+`count`, the `value` is a total for the whole batch. If the benchmark called
+@ref setBenchmarkThroughput(), the last two columns contain either `bytes/s`
+or `items/s` and the throughput calculated from given sample, otherwise
+they're empty. The file is written after
+all test cases finish and is overwritten if it exists already.
+
+Passing such file to `--benchmark-baseline` compares the new measurements of
+each benchmark against the baseline samples with the same test name, test case
+name and units using a two-sided Mann–Whitney U test. If the difference is
+significant at the level given by `--benchmark-baseline-alpha`, the benchmark
+is reported as a regression (which makes the test fail) or an improvement,
+depending on the direction in which the median moved:
+
+@code{.shell-session}
+ BENCH [3]  55.62 ± 0.71   ns benchmarkCopy()@9x100 (wall time)
+  FAIL [3] benchmarkCopy() regressed by 15.39% compared to baseline (p = 0.0001)
+@endcode
+
+Unlike the `--benchmark-yellow` and `--benchmark-red` thresholds, which only
+look at the deviation of a single run, this takes the sample distribution of
+both runs into account and is thus suitable for gating merges in a CI. The
+test needs enough samples for a meaningful result, so use `--repeat-every` to
+run each benchmark at least around ten times. Benchmarks not present in the
+baseline are not compared.
+
+To process the results in-process instead, for example to aggregate them
+across several test executables or upload them somewhere, pass a callback to
+@ref TesterConfiguration::setBenchmarkResultCallback(). It gets called with a
+@ref BenchmarkResult containing the same measurements that would be saved to
+the CSV file, together with the calculated statistics:
+
+@snippet TestSuite.cpp Tester-setBenchmarkResultCallback
+
+@subsection TestSuite-Tester-benchmark-robust Robust benchmark statistics
+
+On a noisy machine a single preempted sample can skew the mean and standard
+deviation considerably. With `--benchmark-outliers N`, samples that are further
+than N median absolute deviations (scaled to be comparable to a standard
+deviation of normally distributed data) from the median are rejected before
+the statistics are calculated, a value of `3` is a good start. The rejection is
+skipped if more than half of the samples are the same. The sample count
+printed after the `@` then reflects only the samples that were kept. The
+`--benchmark-percentiles` option additionally prints a line with the minimum,
+median and the 90th and 99th percentile of per-iteration values:
+
+@code{.shell-session}
+ BENCH [3]  55.62 ± 0.71   ns benchmarkCopy()@9x100 (wall time)
+       [3] min 54.90 ns, median 55.48 ns, p90 56.51 ns, p99 57.02 ns
+@endcode
+
+Instead of tuning the batch size passed to @ref CORRADE_BENCHMARK() for every
+machine, `--benchmark-min-time MS` makes time benchmarks increase it until a
+single sample takes at least given amount of milliseconds. The samples taken
+during the calibration are thrown away. With `--benchmark-precision N`, more
+samples than requested via `--repeat-every` are taken until the 95% confidence
+interval of the mean is within the N fraction of the mean, for example `0.01`
+for 1%. Both the calibration and adaptive sampling stop once
+`--benchmark-time-budget` is exhausted.
+
+On Emscripten, wall time is measured using @cb{.js} performance.now() @ce,
+which browsers clamp to a resolution between 5 µs and 1 ms to mitigate
+Spectre. Because a sample shorter than that would be useless, if
+`--benchmark-min-time` isn't specified, it's set to a hundred times the clock
+resolution measured at startup, so the batch size gets scaled up until the
+clamping error is around 1%.
+
+@subsection TestSuite-Tester-benchmark-environment Benchmark environment
+
+Apart from `--benchmark-discard`, which throws away a fixed number of initial
+samples, `--benchmark-warmup MS` runs each benchmark repeatedly for given time
+and throws away all samples taken meanwhile, giving the CPU caches, branch
+predictors and frequency governors a chance to settle.
+
+Migration of the benchmark thread between cores and preemption by other
+processes are common sources of noise. On Linux, `--benchmark-cpu N` pins the
+process to given core and `--benchmark-priority` raises its priority to the
+highest possible. The latter needs root privileges or the `CAP_SYS_NICE`
+capability. If either operation fails, a warning is printed and the benchmarks
+are run regardless. Original affinity and priority are restored after all test
+cases finish.
+
+When running benchmarks on Linux, the tester also warns if a CPU scaling
+governor other than `performance` is active or if CPU frequency boost is
+enabled, as both make the measurements depend on current load and thermals.
+See @ref TesterConfiguration::setCpuScalingGovernorFile(),
+@ref TesterConfiguration::setCpuBoostFile() and
+@ref TesterConfiguration::setCpuNoTurboFile() for details. With `--verbose`,
+CPU model, core count and OS version are printed before the first benchmark as
+well, to make it possible to tell apart results coming from different
+machines:
+
+@code{.shell-session}
+Starting MyTest with 3 test cases...
+  INFO Benchmarking on Intel(R) Core(TM) i7-8550U CPU @ 1.80GHz, 8 CPUs, Linux 5.3.7 x86_64.
+ BENCH [1]  55.62 ± 0.71   ns benchmarkCopy()@9x100 (wall time)
+@endcode
+
+For a closer look at the machine, the `TestSuiteMemoryBenchmark` executable
+built with Corrade tests measures load latency using a pointer chase and read,
+write and @ref Utility::copy() bandwidth for working sets from 4 kB to 32 MB,
+showing where the individual cache levels end, and read bandwidth on an
+increasing number of threads. Saving its output with `--benchmark-output`
+next to the output of other benchmarks gives a reference for comparing the
+results across machines.
+
+@subsection TestSuite-Tester-benchmark-profile Profiling a benchmark
+
+To find out why a benchmark got slower, it's useful to look at it in a
+sampling profiler. With `--profile N`, only the benchmark with given number is
+run, taking samples over and over until `--profile-duration` passes, which
+gives the profiler enough data to work with. Setup and teardown functions as
+well as the code outside of the @ref CORRADE_BENCHMARK() loop are still
+executed for every sample, so to not have them pollute the profile, the
+tester can tell the profiler to record only while the benchmark loop is
+running. For every loop it writes `enable` to the file passed via
+`--profile-control` and `disable` after, and if `--profile-ack` is specified,
+waits for a line to be read from there after each command. That's exactly the
+protocol of the `--control` option of
+[perf record](https://man7.org/linux/man-pages/man1/perf-record.1.html):
+
+@code{.sh}
+mkfifo ctl.fifo ack.fifo
+perf record --delay=-1 --control fifo:ctl.fifo,ack.fifo -g -- \
+    ./MyBenchmark --profile 3 --profile-control ctl.fifo --profile-ack ack.fifo
+@endcode
+
+The files can be used without `--profile` as well, in which case the profiler
+records all benchmark loops. On platforms without such profiler, simply
+attach the profiler of choice to the process running with `--profile`.
 
 @section TestSuite-Tester-running Compiling and running tests
 
@@ -380,6 +737,74 @@ library is enough, no further setup is needed. When running, the test produces
 output to standard output / standard error and exits with non-zero code in case
 of a test failure.
 
+@subsection TestSuite-Tester-running-parallel Running tests in parallel
+
+With `--jobs N`, N worker processes are forked from the test executable and
+test cases are distributed among them in a round-robin fashion --- the first
+worker runs the first, (N+1)-th, (2N+1)-th ... test case, the second worker
+the second, (N+2)-th ... test case and so on. Each worker runs its test cases
+one after another, including
+@ref addTests() "setup and teardown functions", and saves their output, which
+is then printed by the main process in the original order after all workers
+finish, so the output is the same as when running serially. With
+`--abort-on-fail` the output ends with the first failed test case as usual,
+although the workers might have run some test cases after it already.
+Benchmarks are never run in the workers --- they're run afterwards by the main
+process, one after another, to not be affected by other test cases running in
+parallel.
+
+As the test cases of one worker run in the same process, they share its
+state, and state left behind by one test case is visible to the test cases
+that run after it in the same worker, but not to the ones in other workers.
+The tests thus shouldn't depend on state left behind by test cases before
+them, nor on it being absent. A test case crashing doesn't bring down the
+whole test executable, but it takes its worker down with it --- the test case
+and all test cases that were assigned to the same worker after it are
+reported as failed with a message that the worker process exited
+unexpectedly. Use `--isolate` described below if the test cases should run in
+separate processes.
+
+Output printed via @ref Utility::Debug, @ref Utility::Warning and
+@ref Utility::Error is captured, output written directly to
+@cpp std::cout @ce or elsewhere may appear out of order. The option is
+available on Unix systems only, elsewhere a warning is printed and the tests
+are run serially.
+
+With `--isolate`, each test case is run in its own process instead, forked
+from the main process right before the test case is executed, with at most
+as many of them running at once as specified with `--jobs`. A crash then
+affects only the test case that caused it, not the ones that would run after
+it in the same worker. As the processes are forked from the fully constructed
+test instance, expensive setup done in the test constructor --- such as
+loading plugins or parsing configuration files --- is done just once and all
+test cases get a copy of its result. On platforms without @cpp fork() @ce, a
+warning is printed and the test cases run in the main process.
+
+@subsection TestSuite-Tester-running-timing Finding slow test cases
+
+With `--timing`, the wall time of each test case, summed over all its repeats,
+is printed after it. For test cases that have
+@ref addTests() "setup and teardown functions", the time spent in those is
+printed as well. After all test cases finish, the slowest ones are listed,
+together with the total time and the total setup and teardown overhead:
+
+@code{.shell-session}
+    OK [1] parse()
+       [1] took 12.41 ms
+    OK [2] parseLarge()
+       [2] took 410.07 ms, 0.81 ms of which in setup and teardown
+...
+Slowest 5 test cases:
+       [2] parseLarge() 410.07 ms
+       [7] serialize() 35.12 ms
+...
+Total time 502.33 ms, 1.04 ms of which in setup and teardown.
+@endcode
+
+The time is measured in the process that ran the test case, so it's
+reported correctly with `--jobs` and `--isolate` as well. Use
+`--timing-slowest` to list a different count of test cases, `0` lists none.
+
 @subsection TestSuite-Tester-running-cmake Using CMake
 
 If you are using CMake, there's a convenience @ref corrade-cmake-add-test "corrade_add_test()"
@@ -444,6 +869,23 @@ are supported.
     for possible workarounds. The @ref corrade-cmake-add-test "corrade_add_test()"
     CMake macro also works around this issue.
 
+With CTest, every test is pushed and run separately, which means several `adb`
+round-trips for each test. To avoid that, @ref corrade-cmake-add-test "corrade_add_test()"
+also saves a manifest for each test into the `CorradeAdbTests/` directory in
+the top-level build directory, which can be then used to run all tests at
+once. The following pushes all executables and their files to each device in
+a single sync, runs four tests concurrently on each device and pulls all
+results back in a single step, printing the output in a deterministic order
+followed by a list of failed tests:
+
+@code{.sh}
+<corrade-data-dir>/TestSuite/AdbRunner.sh --batch <build-dir>/CorradeAdbTests 4
+@endcode
+
+If more than one device or emulator is connected, the tests are distributed
+across all of them, both with CTest and in the batch mode. Set the
+`ANDROID_SERIAL` environment variable to restrict them to a single device.
+
 @subsection TestSuite-Tester-running-emscripten Manually running the tests on Emscripten
 
 When not using CMake CTest, Emscripten tests can be run directly using Node.js.
@@ -475,9 +917,48 @@ The webserver is then available at http://localhost:8000. It supports directory
 listing, so you can navigate to each test case runner HTML file (look for e.g.
 `MyTest.html`). Unfortunately it's at the moment not possible to run all
 browser tests in a batch or automate the process in any other way.
+
+@subsection TestSuite-Tester-running-emscripten-threads Emscripten tests with threads
+
+By default, Emscripten tests run single-threaded and threaded benchmarks added
+with @ref addThreadedBenchmarks() have only the single-threaded variant. If the
+whole project, including Corrade itself, is built with `-pthread` in
+`CMAKE_CXX_FLAGS` and @ref CORRADE_BUILD_MULTITHREADED is enabled,
+@ref corrade-cmake-add-test "corrade_add_test()" detects that and links the
+tests with `-s PROXY_TO_PTHREAD=1`, running @cpp main() @ce in a worker so the
+test can spawn threads while it's running. In Node.js, threads are supported
+out of the box since version 16.
+
+In a browser, threads need @cb{.js} SharedArrayBuffer @ce, which is available
+only on pages served with the `Cross-Origin-Opener-Policy: same-origin` and
+`Cross-Origin-Embedder-Policy: require-corp` headers. The runner HTML file
+shows a message if they're missing. The Python webserver mentioned above
+doesn't set them, a minimal wrapper that does can look like this:
+
+@code{.py}
+from http.server import HTTPServer, SimpleHTTPRequestHandler
+
+class Handler(SimpleHTTPRequestHandler):
+    def end_headers(self):
+        self.send_header('Cross-Origin-Opener-Policy', 'same-origin')
+        self.send_header('Cross-Origin-Embedder-Policy', 'require-corp')
+        super().end_headers()
+
+HTTPServer(('', 8000), Handler).serve_forever()
+@endcode
 */
 class CORRADE_TESTSUITE_EXPORT Tester {
     public:
+        struct BenchmarkResult;
+
+        /**
+         * @brief Benchmark result callback
+         * @m_since_latest
+         *
+         * @see @ref TesterConfiguration::setBenchmarkResultCallback()
+         */
+        typedef void(*BenchmarkResultCallback)(const BenchmarkResult&, void*);
+
         /**
          * @brief Tester configuration
          *
@@ -513,6 +994,31 @@ class CORRADE_TESTSUITE_EXPORT Tester {
                  */
                 TesterConfiguration& setSkippedArgumentPrefixes(std::initializer_list<std::string> prefixes);
 
+                /**
+                 * @brief Benchmark result callback
+                 * @m_since_latest
+                 */
+                BenchmarkResultCallback benchmarkResultCallback() const;
+
+                /**
+                 * @brief Benchmark result callback user data
+                 * @m_since_latest
+                 */
+                void* benchmarkResultCallbackUserData() const;
+
+                /**
+                 * @brief Set benchmark result callback
+                 * @m_since_latest
+                 *
+                 * The @p callback is called with @p userData after each
+                 * finished benchmark, or twice for comparison benchmarks,
+                 * once for each side. The views in the @ref BenchmarkResult
+                 * are valid only during the call. Default is @cpp nullptr @ce.
+                 * See @ref TestSuite-Tester-benchmark-baseline for an
+                 * example.
+                 */
+                TesterConfiguration& setBenchmarkResultCallback(BenchmarkResultCallback callback, void* userData = nullptr);
+
                 #if defined(__linux__) || defined(DOXYGEN_GENERATING_OUTPUT)
                 /** @brief Where to check for active CPU scaling governor */
                 std::string cpuScalingGovernorFile() const;
@@ -529,6 +1035,52 @@ class CORRADE_TESTSUITE_EXPORT Tester {
                  * @partialsupport Available only on Linux.
                  */
                 TesterConfiguration& setCpuScalingGovernorFile(const std::string& filename);
+
+                /** @brief Where to check for enabled CPU frequency boost */
+                std::string cpuBoostFile() const;
+
+                /**
+                 * @brief Set where to check for enabled CPU frequency boost
+                 *
+                 * Similarly to CPU scaling, frequency boost (or turbo) makes
+                 * the measurements depend on temperature and load of other
+                 * cores. If the file contains `1`, a warning is printed on
+                 * output. Defaults to `/sys/devices/system/cpu/cpufreq/boost`,
+                 * which is provided by the `acpi-cpufreq` and `amd-pstate`
+                 * drivers; if the file doesn't exist, no check is done.
+                 * @partialsupport Available only on Linux.
+                 * @see @ref setCpuNoTurboFile()
+                 */
+                TesterConfiguration& setCpuBoostFile(const std::string& filename);
+
+                /** @brief Where to check for disabled CPU turbo */
+                std::string cpuNoTurboFile() const;
+
+                /**
+                 * @brief Set where to check for disabled CPU turbo
+                 *
+                 * Counterpart to @ref setCpuBoostFile() for the
+                 * `intel_pstate` driver. If the file contains `0`, a warning
+                 * is printed on output. Defaults to
+                 * `/sys/devices/system/cpu/intel_pstate/no_turbo`; if the
+                 * file doesn't exist, no check is done.
+                 * @partialsupport Available only on Linux.
+                 */
+                TesterConfiguration& setCpuNoTurboFile(const std::string& filename);
+
+                /** @brief Where to read CPU information from */
+                std::string cpuInfoFile() const;
+
+                /**
+                 * @brief Set where to read CPU information from
+                 *
+                 * With `--verbose`, the CPU model name is printed together
+                 * with other machine information before running benchmarks.
+                 * Defaults to `/proc/cpuinfo`; if the file doesn't exist,
+                 * nothing is printed.
+                 * @partialsupport Available only on Linux.
+                 */
+                TesterConfiguration& setCpuInfoFile(const std::string& filename);
                 #endif
 
             private:
@@ -615,7 +1167,84 @@ class CORRADE_TESTSUITE_EXPORT Tester {
              *      and GCC/Clang or MSVC (using RDTSC), on other platforms
              *      gives zero result.
              */
-            CpuCycles = 4
+            CpuCycles = 4,
+
+            /**
+             * Retired instruction count, measured with a hardware performance
+             * counter in user space only. Unlike time or cycle measurements
+             * it's independent on CPU frequency and nearly free of noise,
+             * suitable for measuring even very small events.
+             * @partialsupport Supported only on Linux (using
+             *      @cpp perf_event_open() @ce). If the counter can't be
+             *      opened, for example in a virtual machine without access to
+             *      the performance monitoring unit or if disallowed by
+             *      `/proc/sys/kernel/perf_event_paranoid`, a warning is
+             *      printed and the benchmark gives zero result. The same
+             *      applies to all other hardware counter benchmark types.
+             * @m_since_latest
+             */
+            Instructions = 5,
+
+            /**
+             * Core cycle count, measured with a hardware performance counter.
+             * Unlike @ref BenchmarkType::CpuCycles counts actual cycles spent
+             * by the core and not a constant-rate timestamp counter.
+             * @partialsupport See @ref BenchmarkType::Instructions.
+             * @m_since_latest
+             */
+            CoreCycles = 6,
+
+            /**
+             * L1 data cache read miss count, measured with a hardware
+             * performance counter.
+             * @partialsupport See @ref BenchmarkType::Instructions.
+             * @m_since_latest
+             */
+            L1DataCacheMisses = 7,
+
+            /**
+             * Last level cache miss count, measured with a hardware
+             * performance counter.
+             * @partialsupport See @ref BenchmarkType::Instructions.
+             * @m_since_latest
+             */
+            LastLevelCacheMisses = 8,
+
+            /**
+             * Mispredicted branch count, measured with a hardware performance
+             * counter.
+             * @partialsupport See @ref BenchmarkType::Instructions.
+             * @m_since_latest
+             */
+            BranchMisses = 9,
+
+            /**
+             * Data TLB read miss count, measured with a hardware performance
+             * counter.
+             * @partialsupport See @ref BenchmarkType::Instructions.
+             * @m_since_latest
+             */
+            DataTlbMisses = 10,
+
+            /**
+             * Count of memory allocations. Useful for catching regressions in
+             * code that's meant to not allocate.
+             * @partialsupport Requires
+             *      @ref Corrade/TestSuite/AllocationCounter.h to be included
+             *      in the test executable, otherwise a warning is printed and
+             *      the benchmark gives zero result. See its documentation for
+             *      what allocations are counted on which platforms.
+             * @m_since_latest
+             */
+            AllocationCount = 11,
+
+            /**
+             * Amount of allocated memory in bytes. Deallocations aren't
+             * subtracted.
+             * @partialsupport See @ref BenchmarkType::AllocationCount.
+             * @m_since_latest
+             */
+            AllocatedBytes = 12
         };
 
         /**
@@ -634,6 +1263,81 @@ class CORRADE_TESTSUITE_EXPORT Tester {
             Count = 104             /**< Generic count */
         };
 
+        /**
+         * @brief Benchmark result
+         * @m_since_latest
+         *
+         * Passed to a callback set via
+         * @ref TesterConfiguration::setBenchmarkResultCallback(). All views
+         * are valid only during the callback.
+         */
+        struct BenchmarkResult {
+            /** @brief Test name, same as @ref testName() */
+            Containers::StringView testName;
+
+            /**
+             * @brief Test case name
+             *
+             * Including template parameters and the description in
+             * parentheses, such as `find(n=1024)`. Together with
+             * @ref testName it's the same as what's saved with
+             * `--benchmark-output`.
+             */
+            Containers::StringView testCaseName;
+
+            /**
+             * @brief Benchmark name
+             *
+             * Such as `wall time`, can be empty for custom benchmarks.
+             */
+            Containers::StringView benchmarkName;
+
+            /** @brief Units of the measurements */
+            BenchmarkUnits units;
+
+            /** @brief Count of iterations in each batch */
+            std::size_t batchSize;
+
+            /**
+             * @brief Measurements
+             *
+             * Total for each batch, with the first `--benchmark-discard`
+             * measurements dropped. Outliers are not rejected here.
+             */
+            Containers::ArrayView<const std::uint64_t> measurements;
+
+            /**
+             * @brief Count of measurements used for statistics
+             *
+             * Less than size of @ref measurements if `--benchmark-outliers`
+             * rejected some.
+             */
+            std::size_t keptCount;
+
+            /** @brief Mean value per iteration */
+            double mean;
+
+            /** @brief Standard deviation per iteration */
+            double stddev;
+
+            /**
+             * @brief Bytes or items processed per iteration
+             *
+             * Zero if the benchmark didn't call
+             * @ref setBenchmarkThroughput().
+             */
+            std::uint64_t throughput;
+
+            /**
+             * @brief Throughput units
+             *
+             * Either @ref BenchmarkUnits::Bytes or
+             * @ref BenchmarkUnits::Count. Unspecified if @ref throughput is
+             * zero.
+             */
+            BenchmarkUnits throughputUnits;
+        };
+
         /**
          * @brief Constructor
          * @param configuration     Optional configuration
@@ -865,6 +1569,212 @@ class CORRADE_TESTSUITE_EXPORT Tester {
                 addTestCaseInternal({~std::size_t{}, batchCount, static_cast<TestCase::Function>(benchmark), static_cast<TestCase::Function>(setup), static_cast<TestCase::Function>(teardown), static_cast<TestCase::BenchmarkBegin>(benchmarkBegin), static_cast<TestCase::BenchmarkEnd>(benchmarkEnd), TestCaseType(int(benchmarkUnits))});
         }
 
+        /**
+         * @brief Add multi-threaded benchmarks
+         * @param benchmarks        List of benchmarks to run
+         * @param batchCount        Batch count
+         * @param maxThreadCount    Max thread count. If @cpp 0 @ce,
+         *      @ref std::thread::hardware_concurrency() is used.
+         *
+         * Each of the benchmarks is added once for 1, 2, 4, ... threads up to
+         * @p maxThreadCount, which is added as well if it's not a power of
+         * two. The body of @ref CORRADE_BENCHMARK() is run on all threads at
+         * the same time and the wall time spent until all threads finish is
+         * measured. See @ref TestSuite-Tester-benchmark-threaded for more
+         * information. It's not an error to call this function multiple times
+         * or add one benchmark more than once.
+         * @see @ref testCaseThreadId(), @ref testCaseThreadCount()
+         */
+        template<class Derived> void addThreadedBenchmarks(std::initializer_list<void(Derived::*)()> benchmarks, std::size_t batchCount, std::size_t maxThreadCount) {
+            addThreadedBenchmarks<Derived>(benchmarks, batchCount, maxThreadCount, nullptr, nullptr);
+        }
+
+        /**
+         * @brief Add multi-threaded benchmarks with explicit setup and teardown functions
+         * @param benchmarks        List of benchmarks to run
+         * @param batchCount        Batch count
+         * @param maxThreadCount    Max thread count
+         * @param setup             Setup function
+         * @param teardown          Teardown function
+         *
+         * In addition to the behavior of @ref addThreadedBenchmarks() above,
+         * the @p setup function is called on the first thread before every
+         * batch of every benchmark in the list and the @p teardown function
+         * is called on the first thread after every batch of every benchmark
+         * in the list, after all other threads finished. Using verification
+         * macros in @p setup or @p teardown function is not allowed.
+         */
+        template<class Derived> void addThreadedBenchmarks(std::initializer_list<void(Derived::*)()> benchmarks, std::size_t batchCount, std::size_t maxThreadCount, void(Derived::*setup)(), void(Derived::*teardown)()) {
+            for(auto benchmark: benchmarks)
+                addThreadedTestCaseInternal({~std::size_t{}, batchCount, static_cast<TestCase::Function>(benchmark), static_cast<TestCase::Function>(setup), static_cast<TestCase::Function>(teardown), nullptr, nullptr, TestCaseType::WallTimeBenchmark}, maxThreadCount);
+        }
+
+        /**
+         * @brief Add sweep benchmarks
+         * @param benchmarks        List of benchmarks to run
+         * @param batchCount        Batch count
+         * @param minSize           Smallest input size
+         * @param maxSize           Largest input size
+         * @param benchmarkType     Benchmark type
+         * @m_since_latest
+         *
+         * Each of the benchmarks is added once for @p minSize, twice that,
+         * four times that, ... up to @p maxSize, which is added as well if
+         * it's not reached exactly. The size is available through
+         * @ref testCaseSweepSize(). After the largest size, the empirical
+         * complexity and cache knees are printed, see
+         * @ref TestSuite-Tester-benchmark-sweep for more information.
+         * Expects that @p minSize is not zero and not larger than
+         * @p maxSize. It's not an error to call this function multiple times
+         * or add one benchmark more than once.
+         * @see @ref addCustomSweepBenchmarks()
+         */
+        template<class Derived> void addSweepBenchmarks(std::initializer_list<void(Derived::*)()> benchmarks, std::size_t batchCount, std::size_t minSize, std::size_t maxSize, BenchmarkType benchmarkType = BenchmarkType::Default) {
+            addSweepBenchmarks<Derived>(benchmarks, batchCount, minSize, maxSize, nullptr, nullptr, benchmarkType);
+        }
+
+        /**
+         * @brief Add sweep benchmarks with explicit setup and teardown functions
+         * @param benchmarks        List of benchmarks to run
+         * @param batchCount        Batch count
+         * @param minSize           Smallest input size
+         * @param maxSize           Largest input size
+         * @param setup             Setup function
+         * @param teardown          Teardown function
+         * @param benchmarkType     Benchmark type
+         * @m_since_latest
+         *
+         * In addition to the behavior of @ref addSweepBenchmarks() above, the
+         * @p setup function is called before every batch of every benchmark
+         * and the @p teardown function after. The @ref testCaseSweepSize() is
+         * available in both.
+         */
+        template<class Derived> void addSweepBenchmarks(std::initializer_list<void(Derived::*)()> benchmarks, std::size_t batchCount, std::size_t minSize, std::size_t maxSize, void(Derived::*setup)(), void(Derived::*teardown)(), BenchmarkType benchmarkType = BenchmarkType::Default) {
+            addCustomSweepBenchmarks<Derived>(benchmarks, batchCount, minSize, maxSize, setup, teardown, nullptr, nullptr, BenchmarkUnits(int(benchmarkType)));
+        }
+
+        /**
+         * @brief Add custom sweep benchmarks
+         * @param benchmarks        List of benchmarks to run
+         * @param batchCount        Batch count
+         * @param minSize           Smallest input size
+         * @param maxSize           Largest input size
+         * @param benchmarkBegin    Benchmark begin function
+         * @param benchmarkEnd      Benchmark end function
+         * @param benchmarkUnits    Benchmark units
+         * @m_since_latest
+         *
+         * Like @ref addSweepBenchmarks(), but with user-supplied measurement
+         * functions. See @ref addCustomBenchmarks() for more information.
+         */
+        template<class Derived> void addCustomSweepBenchmarks(std::initializer_list<void(Derived::*)()> benchmarks, std::size_t batchCount, std::size_t minSize, std::size_t maxSize, void(Derived::*benchmarkBegin)(), std::uint64_t(Derived::*benchmarkEnd)(), BenchmarkUnits benchmarkUnits) {
+            addCustomSweepBenchmarks<Derived>(benchmarks, batchCount, minSize, maxSize, nullptr, nullptr, static_cast<TestCase::BenchmarkBegin>(benchmarkBegin), static_cast<TestCase::BenchmarkEnd>(benchmarkEnd), benchmarkUnits);
+        }
+
+        /**
+         * @brief Add custom sweep benchmarks with explicit setup and teardown functions
+         * @param benchmarks        List of benchmarks to run
+         * @param batchCount        Batch count
+         * @param minSize           Smallest input size
+         * @param maxSize           Largest input size
+         * @param setup             Setup function
+         * @param teardown          Teardown function
+         * @param benchmarkBegin    Benchmark begin function
+         * @param benchmarkEnd      Benchmark end function
+         * @param benchmarkUnits    Benchmark units
+         * @m_since_latest
+         *
+         * In addition to the behavior of @ref addCustomSweepBenchmarks()
+         * above, the @p setup function is called before every batch of every
+         * benchmark and the @p teardown function after.
+         */
+        template<class Derived> void addCustomSweepBenchmarks(std::initializer_list<void(Derived::*)()> benchmarks, std::size_t batchCount, std::size_t minSize, std::size_t maxSize, void(Derived::*setup)(), void(Derived::*teardown)(), void(Derived::*benchmarkBegin)(), std::uint64_t(Derived::*benchmarkEnd)(), BenchmarkUnits benchmarkUnits) {
+            for(auto benchmark: benchmarks)
+                addSweepTestCaseInternal({~std::size_t{}, batchCount, static_cast<TestCase::Function>(benchmark), static_cast<TestCase::Function>(setup), static_cast<TestCase::Function>(teardown), static_cast<TestCase::BenchmarkBegin>(benchmarkBegin), static_cast<TestCase::BenchmarkEnd>(benchmarkEnd), TestCaseType(int(benchmarkUnits))}, minSize, maxSize);
+        }
+
+        /**
+         * @brief Add comparison benchmarks
+         * @param benchmarks        List of benchmarks to run, the first one
+         *      being the baseline
+         * @param batchCount        Batch count
+         * @param benchmarkType     Benchmark type
+         * @m_since_latest
+         *
+         * Adds one test case for each benchmark except the first, which
+         * alternates samples of the first benchmark and the compared one in
+         * a random order and prints the ratio of the compared benchmark to
+         * the first one in addition to the usual output. Expects that at
+         * least two benchmarks are passed. See
+         * @ref TestSuite-Tester-benchmark-comparison for more information.
+         * @see @ref addCustomComparisonBenchmarks()
+         */
+        template<class Derived> void addComparisonBenchmarks(std::initializer_list<void(Derived::*)()> benchmarks, std::size_t batchCount, BenchmarkType benchmarkType = BenchmarkType::Default) {
+            addComparisonBenchmarks<Derived>(benchmarks, batchCount, nullptr, nullptr, benchmarkType);
+        }
+
+        /**
+         * @brief Add comparison benchmarks with explicit setup and teardown functions
+         * @param benchmarks        List of benchmarks to run, the first one
+         *      being the baseline
+         * @param batchCount        Batch count
+         * @param setup             Setup function
+         * @param teardown          Teardown function
+         * @param benchmarkType     Benchmark type
+         * @m_since_latest
+         *
+         * In addition to the behavior of @ref addComparisonBenchmarks()
+         * above, the @p setup function is called before every batch of both
+         * benchmarks and the @p teardown function after.
+         */
+        template<class Derived> void addComparisonBenchmarks(std::initializer_list<void(Derived::*)()> benchmarks, std::size_t batchCount, void(Derived::*setup)(), void(Derived::*teardown)(), BenchmarkType benchmarkType = BenchmarkType::Default) {
+            addCustomComparisonBenchmarks<Derived>(benchmarks, batchCount, setup, teardown, nullptr, nullptr, BenchmarkUnits(int(benchmarkType)));
+        }
+
+        /**
+         * @brief Add custom comparison benchmarks
+         * @param benchmarks        List of benchmarks to run, the first one
+         *      being the baseline
+         * @param batchCount        Batch count
+         * @param benchmarkBegin    Benchmark begin function
+         * @param benchmarkEnd      Benchmark end function
+         * @param benchmarkUnits    Benchmark units
+         * @m_since_latest
+         *
+         * Like @ref addComparisonBenchmarks(), but with user-supplied
+         * measurement functions. See @ref addCustomBenchmarks() for more
+         * information.
+         */
+        template<class Derived> void addCustomComparisonBenchmarks(std::initializer_list<void(Derived::*)()> benchmarks, std::size_t batchCount, void(Derived::*benchmarkBegin)(), std::uint64_t(Derived::*benchmarkEnd)(), BenchmarkUnits benchmarkUnits) {
+            addCustomComparisonBenchmarks<Derived>(benchmarks, batchCount, nullptr, nullptr, static_cast<TestCase::BenchmarkBegin>(benchmarkBegin), static_cast<TestCase::BenchmarkEnd>(benchmarkEnd), benchmarkUnits);
+        }
+
+        /**
+         * @brief Add custom comparison benchmarks with explicit setup and teardown functions
+         * @param benchmarks        List of benchmarks to run, the first one
+         *      being the baseline
+         * @param batchCount        Batch count
+         * @param setup             Setup function
+         * @param teardown          Teardown function
+         * @param benchmarkBegin    Benchmark begin function
+         * @param benchmarkEnd      Benchmark end function
+         * @param benchmarkUnits    Benchmark units
+         * @m_since_latest
+         *
+         * In addition to the behavior of @ref addCustomComparisonBenchmarks()
+         * above, the @p setup function is called before every batch of both
+         * benchmarks and the @p teardown function after.
+         */
+        template<class Derived> void addCustomComparisonBenchmarks(std::initializer_list<void(Derived::*)()> benchmarks, std::size_t batchCount, void(Derived::*setup)(), void(Derived::*teardown)(), void(Derived::*benchmarkBegin)(), std::uint64_t(Derived::*benchmarkEnd)(), BenchmarkUnits benchmarkUnits) {
+            TestCase testCase{~std::size_t{}, batchCount, nullptr, static_cast<TestCase::Function>(setup), static_cast<TestCase::Function>(teardown), static_cast<TestCase::BenchmarkBegin>(benchmarkBegin), static_cast<TestCase::BenchmarkEnd>(benchmarkEnd), TestCaseType(int(benchmarkUnits))};
+            for(auto benchmark: benchmarks) {
+                if(!testCase.test) testCase.test = static_cast<TestCase::Function>(benchmark);
+                else addComparisonTestCaseInternal(testCase, static_cast<TestCase::Function>(benchmark));
+            }
+            /* Triggers an assertion */
+            if(benchmarks.size() < 2) addComparisonTestCaseInternal(testCase, nullptr);
+        }
+
         /**
          * @brief Add instanced benchmarks
          * @param benchmarks        List of benchmarks to run
@@ -983,6 +1893,39 @@ class CORRADE_TESTSUITE_EXPORT Tester {
          */
         std::size_t testCaseRepeatId() const;
 
+        /**
+         * @brief Test case thread ID
+         *
+         * Returns ID of the thread executing the multi-threaded benchmark,
+         * starting from `0`, which is the thread that runs also setup and
+         * teardown functions and can use verification macros. Returns `0`
+         * in all other test cases.
+         * @see @ref addThreadedBenchmarks(), @ref testCaseThreadCount()
+         */
+        std::size_t testCaseThreadId() const;
+
+        /**
+         * @brief Test case thread count
+         *
+         * Returns count of threads executing the multi-threaded benchmark.
+         * Returns `1` in all other test cases. Expects that this function is
+         * called from within a test case or its corresponding setup/teardown
+         * function.
+         * @see @ref addThreadedBenchmarks(), @ref testCaseThreadId()
+         */
+        std::size_t testCaseThreadCount() const;
+
+        /**
+         * @brief Test case sweep size
+         * @m_since_latest
+         *
+         * Returns the input size of the sweep benchmark that is currently
+         * executing. Expects that this function is called from within a
+         * sweep benchmark or its corresponding setup/teardown function.
+         * @see @ref addSweepBenchmarks()
+         */
+        std::size_t testCaseSweepSize() const;
+
         /**
          * @brief Set custom test name
          *
@@ -1061,6 +2004,22 @@ class CORRADE_TESTSUITE_EXPORT Tester {
         void setBenchmarkName(std::string&& name); /**< @overload */
         void setBenchmarkName(const char* name); /**< @overload */
 
+        /**
+         * @brief Set benchmark throughput
+         * @param count     Amount of data processed in a single iteration of
+         *      the @ref CORRADE_BENCHMARK() loop
+         * @param units     Either @ref BenchmarkUnits::Bytes or
+         *      @ref BenchmarkUnits::Count
+         * @m_since_latest
+         *
+         * If called inside a benchmark measuring time, the throughput in
+         * bytes or items per second is printed and saved with
+         * `--benchmark-output` in addition to the time per iteration. Ignored
+         * for other benchmark types. See
+         * @ref TestSuite-Tester-benchmark-throughput for more information.
+         */
+        void setBenchmarkThroughput(std::uint64_t count, BenchmarkUnits units);
+
     protected:
         ~Tester();
 
@@ -1158,6 +2117,14 @@ class CORRADE_TESTSUITE_EXPORT Tester {
             WallTimeBenchmark = int(BenchmarkType::WallTime),
             CpuTimeBenchmark = int(BenchmarkType::CpuTime),
             CpuCyclesBenchmark = int(BenchmarkType::CpuCycles),
+            InstructionsBenchmark = int(BenchmarkType::Instructions),
+            CoreCyclesBenchmark = int(BenchmarkType::CoreCycles),
+            L1DataCacheMissesBenchmark = int(BenchmarkType::L1DataCacheMisses),
+            LastLevelCacheMissesBenchmark = int(BenchmarkType::LastLevelCacheMisses),
+            BranchMissesBenchmark = int(BenchmarkType::BranchMisses),
+            DataTlbMissesBenchmark = int(BenchmarkType::DataTlbMisses),
+            AllocationCountBenchmark = int(BenchmarkType::AllocationCount),
+            AllocatedBytesBenchmark = int(BenchmarkType::AllocatedBytes),
             CustomTimeBenchmark = int(BenchmarkUnits::Nanoseconds),
             CustomCycleBenchmark = int(BenchmarkUnits::Cycles),
             CustomInstructionBenchmark = int(BenchmarkUnits::Instructions),
@@ -1170,15 +2137,21 @@ class CORRADE_TESTSUITE_EXPORT Tester {
             typedef void (Tester::*BenchmarkBegin)();
             typedef std::uint64_t (Tester::*BenchmarkEnd)();
 
-            /*implicit*/ TestCase(std::size_t instanceId, std::size_t repeatCount, Function test, Function setup, Function teardown): instanceId{instanceId}, repeatCount{repeatCount}, test{test}, setup{setup}, teardown{teardown}, benchmarkBegin{}, benchmarkEnd{}, type{TestCaseType::Test} {}
+            /*implicit*/ TestCase(std::size_t instanceId, std::size_t repeatCount, Function test, Function setup, Function teardown): instanceId{instanceId}, repeatCount{repeatCount}, threadCount{}, sweepSize{}, test{test}, comparedTest{}, setup{setup}, teardown{teardown}, benchmarkBegin{}, benchmarkEnd{}, type{TestCaseType::Test}, lastInSweep{} {}
 
-            /*implicit*/ TestCase(std::size_t instanceId, std::size_t repeatCount, Function test, Function setup, Function teardown, BenchmarkBegin benchmarkBegin, BenchmarkEnd benchmarkEnd, TestCaseType type): instanceId{instanceId}, repeatCount{repeatCount}, test{test}, setup{setup}, teardown{teardown}, benchmarkBegin{benchmarkBegin}, benchmarkEnd{benchmarkEnd}, type{type} {}
+            /*implicit*/ TestCase(std::size_t instanceId, std::size_t repeatCount, Function test, Function setup, Function teardown, BenchmarkBegin benchmarkBegin, BenchmarkEnd benchmarkEnd, TestCaseType type): instanceId{instanceId}, repeatCount{repeatCount}, threadCount{}, sweepSize{}, test{test}, comparedTest{}, setup{setup}, teardown{teardown}, benchmarkBegin{benchmarkBegin}, benchmarkEnd{benchmarkEnd}, type{type}, lastInSweep{} {}
 
-            std::size_t instanceId, repeatCount;
-            Function test, setup, teardown;
+            /* Thread count is zero for test cases that aren't threaded, sweep
+               size is zero for test cases that aren't sweeps */
+            std::size_t instanceId, repeatCount, threadCount, sweepSize;
+            /* Compared test is non-null only for comparison benchmarks, with
+               test being the baseline */
+            Function test, comparedTest, setup, teardown;
             BenchmarkBegin benchmarkBegin;
             BenchmarkEnd benchmarkEnd;
             TestCaseType type;
+            /* Complexity is printed after the last size of a sweep */
+            bool lastInSweep;
         };
 
     #ifndef DOXYGEN_GENERATING_OUTPUT
@@ -1203,6 +2176,35 @@ class CORRADE_TESTSUITE_EXPORT Tester {
         /* Called from CORRADE_BENCHMARK() */
         BenchmarkRunner createBenchmarkRunner(std::size_t batchSize);
 
+        /* Created by CORRADE_EXPECT_MAX_ALLOCATIONS() and friends. The first
+           next() call starts the measurement, the second ends it and checks
+           the budget. If the block is left through an exception, the
+           destructor only ends the measurement. */
+        class CORRADE_TESTSUITE_EXPORT ResourceBudget {
+            public:
+                enum class Type: unsigned char {
+                    Allocations,    /* count of allocations */
+                    WallTime,       /* nanoseconds */
+                    PeakMemory      /* bytes */
+                };
+
+                explicit ResourceBudget(Tester& instance, Type type, std::uint64_t budget, int line): _instance(instance), _type{type}, _running{}, _line{line}, _budget{budget}, _begin{} {}
+
+                ResourceBudget(const ResourceBudget&) = delete;
+                ResourceBudget& operator=(const ResourceBudget&) = delete;
+
+                ~ResourceBudget();
+
+                bool next();
+
+            private:
+                Tester& _instance;
+                Type _type;
+                bool _running;
+                int _line;
+                std::uint64_t _budget, _begin;
+        };
+
     private:
         /* Need to preserve as much unique name as possible here, just `State`
            would cause conflicts with user-defined State types */
@@ -1213,6 +2215,7 @@ class CORRADE_TESTSUITE_EXPORT Tester {
 
         CORRADE_TESTSUITE_LOCAL void printTestCaseLabel(Debug& out, const char* status, Debug::Color statusColor, Debug::Color labelColor);
         void verifyInternal(const char* expression, bool value);
+        void resourceBudgetInternal(int line, const char* what, const std::string& value, const std::string& budget, bool exceeded);
         void printComparisonMessageInternal(ComparisonStatusFlags flags, const char* actual, const char* expected, void(*printer)(void*, ComparisonStatusFlags, Debug&, const char*, const char*), void(*saver)(void*, ComparisonStatusFlags, Debug&, const std::string&), void* comparator);
 
         void wallTimeBenchmarkBegin();
@@ -1224,7 +2227,19 @@ class CORRADE_TESTSUITE_EXPORT Tester {
         void cpuCyclesBenchmarkBegin();
         std::uint64_t cpuCyclesBenchmarkEnd();
 
+        void hardwareCounterBenchmarkBegin();
+        std::uint64_t hardwareCounterBenchmarkEnd();
+
+        void allocationBenchmarkBegin();
+        std::uint64_t allocationCountBenchmarkEnd();
+        std::uint64_t allocatedBytesBenchmarkEnd();
+
+        void threadedBenchmarkWorkerBegin();
+
         void addTestCaseInternal(const TestCase& testCase);
+        void addThreadedTestCaseInternal(const TestCase& testCase, std::size_t maxThreadCount);
+        void addSweepTestCaseInternal(const TestCase& testCase, std::size_t minSize, std::size_t maxSize);
+        void addComparisonTestCaseInternal(const TestCase& testCase, TestCase::Function comparedTest);
 
         Containers::Pointer<TesterState> _state;
 };
@@ -1452,6 +2467,60 @@ one iteration.
     )
 #endif
 
+/** @hideinitializer
+@brief Expect a block to do at most given count of allocations
+@m_since_latest
+
+Counts allocations done by the following block and fails the test case if
+there's more than @p count of them. Requires
+@ref Corrade/TestSuite/AllocationCounter.h to be included in the test
+executable, otherwise the check always fails. Allocations are counted the
+same way as with @ref Corrade::TestSuite::Tester::BenchmarkType::AllocationCount "TestSuite::Tester::BenchmarkType::AllocationCount",
+which means the block can't be nested in another allocation budget or be
+inside an allocation-counting benchmark. See
+@ref TestSuite-Tester-resource-budget for more information.
+@see @ref CORRADE_EXPECT_MAX_TIME(), @ref CORRADE_EXPECT_MAX_PEAK_MEMORY()
+*/
+#define CORRADE_EXPECT_MAX_ALLOCATIONS(count)                               \
+    Tester::registerTestCase(CORRADE_FUNCTION, __LINE__);                   \
+    for(Tester::ResourceBudget _CORRADE_HELPER_PASTE(resourceBudget, __LINE__){*this, Tester::ResourceBudget::Type::Allocations, std::uint64_t(count), __LINE__}; _CORRADE_HELPER_PASTE(resourceBudget, __LINE__).next(); )
+
+/** @hideinitializer
+@brief Expect a block to take at most given wall time
+@m_since_latest
+
+Measures wall time spent in the following block and fails the test case if
+it's more than @p milliseconds. As the time depends heavily on the machine and
+its load, the budget should be set with a large enough margin to not make the
+test flaky. See @ref TestSuite-Tester-resource-budget for more information.
+@see @ref CORRADE_EXPECT_MAX_ALLOCATIONS(),
+    @ref CORRADE_EXPECT_MAX_PEAK_MEMORY()
+*/
+#define CORRADE_EXPECT_MAX_TIME(milliseconds)                               \
+    Tester::registerTestCase(CORRADE_FUNCTION, __LINE__);                   \
+    for(Tester::ResourceBudget _CORRADE_HELPER_PASTE(resourceBudget, __LINE__){*this, Tester::ResourceBudget::Type::WallTime, std::uint64_t((milliseconds)*1000000.0), __LINE__}; _CORRADE_HELPER_PASTE(resourceBudget, __LINE__).next(); )
+
+/** @hideinitializer
+@brief Expect a block to increase peak resident memory by at most given size
+@m_since_latest
+
+Resets the peak resident memory of the process at the beginning of the
+following block and fails the test case if the peak at the end of it is more
+than @p bytes larger than the resident memory at the beginning. The memory is
+measured for the whole process, including other threads, and with page
+granularity.
+
+@partialsupport Available only on Linux 4.0 and newer, where the peak can be
+    reset. Elsewhere the block is executed but a warning is printed instead
+    of checking the budget.
+
+See @ref TestSuite-Tester-resource-budget for more information.
+@see @ref CORRADE_EXPECT_MAX_ALLOCATIONS(), @ref CORRADE_EXPECT_MAX_TIME()
+*/
+#define CORRADE_EXPECT_MAX_PEAK_MEMORY(bytes)                               \
+    Tester::registerTestCase(CORRADE_FUNCTION, __LINE__);                   \
+    for(Tester::ResourceBudget _CORRADE_HELPER_PASTE(resourceBudget, __LINE__){*this, Tester::ResourceBudget::Type::PeakMemory, std::uint64_t(bytes), __LINE__}; _CORRADE_HELPER_PASTE(resourceBudget, __LINE__).next(); )
+
 template<class T, class U, class V> void Tester::compareWith(Comparator<T>& comparator, const char* actual, const U& actualValue, const char* expected, const V& expectedValue) {
     /* Store (references to) possibly implicitly-converted values,
        otherwise the implicit conversion would when passing them to operator(),
@@ -31,7 +31,9 @@
 
 #include <string>
 
+#include "Corrade/Containers/StringStl.h"
 #include "Corrade/Utility/Debug.h"
+#include "Corrade/Utility/Encoding.h"
 
 namespace Corrade { namespace Utility {
 
@@ -43,9 +45,10 @@ template<std::size_t size> class HashDigest {
          *
          * If the digest has invalid length or contains invalid
          * characters (other than `0-9, a-f, A-F`), returns zero
-         * digest.
+         * digest. Accepts also a @ref std::string, the input is not copied.
+         * @see @ref Encoding::hexDecode()
          */
-        static HashDigest<size> fromHexString(std::string digest);
+        static HashDigest<size> fromHexString(Containers::StringView digest);
 
         /**
          * @brief Digest from given byte array
@@ -86,9 +89,23 @@ template<std::size_t size> class HashDigest {
 
         /**
          * @brief Convert the digest to lowercase hexadecimal string representation
+         *
+         * @see @ref hexStringInto()
          */
         std::string hexString() const;
 
+        /**
+         * @brief Write lowercase hexadecimal string representation to a view
+         * @m_since_latest
+         *
+         * Expects that @p out is exactly twice the digest size. Unlike
+         * @ref hexString() doesn't allocate. No null terminator is written.
+         * @see @ref Encoding::hexEncode()
+         */
+        void hexStringInto(Containers::ArrayView<char> out) const {
+            Encoding::hexEncode(Containers::arrayView(_digest), out);
+        }
+
         /** @brief Raw digest byte array */
         constexpr const char* byteArray() const { return _digest; }
 
@@ -117,33 +134,22 @@ template<std::size_t digestSize> class AbstractHash {
 
 /** @debugoperator{HashDigest} */
 template<std::size_t size> inline Debug& operator<<(Debug& debug, const HashDigest<size>& value) {
-    return debug << value.hexString().data();
+    char out[size*2 + 1];
+    value.hexStringInto({out, size*2});
+    out[size*2] = '\0';
+    return debug << out;
 }
 
-template<std::size_t size> HashDigest<size> HashDigest<size>::fromHexString(std::string digest) {
+template<std::size_t size> HashDigest<size> HashDigest<size>::fromHexString(const Containers::StringView digest) {
     HashDigest<size> d;
-    if(digest.size() != size*2) return d;
-
-    for(int i = 0; i != size*2; ++i) {
-        if(digest[i] >= '0' && digest[i] <= '9')
-            digest[i] -= '0';
-        else if(digest[i] >= 'a' && digest[i] <= 'f')
-            digest[i] -= 'a'-0xa;
-        else if(digest[i] >= 'A' && digest[i] <= 'F')
-            digest[i] -= 'A'-0xa;
-        else return HashDigest<size>();
-
-        d._digest[i/2] |= (digest[i]) << (i%2 == 0 ? 4 : 0);
-    }
+    if(digest.size() != size*2 || !Encoding::hexDecode({digest.data(), digest.size()}, d._digest))
+        return HashDigest<size>();
     return d;
 }
 
 template<std::size_t size> std::string HashDigest<size>::hexString() const {
-    std::string d(size*2, '0');
-    for(int i = 0; i != size*2; ++i) {
-        d[i] = (_digest[i/2] >> (i%2 == 0 ? 4 : 0)) & 0xF;
-        d[i] += d[i] >= 0xa ? 'a'-0xa : '0';
-    }
+    std::string d(size*2, '\0');
+    hexStringInto({&d[0], size*2});
     return d;
 }
 
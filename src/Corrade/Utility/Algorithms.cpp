@@ -25,8 +25,16 @@
 
 #include "Algorithms.h"
 
+#include <cstdint>
 #include <cstring>
 
+#include "Corrade/Utility/Cpu.h"
+#include "Corrade/Utility/Implementation/algorithmKernels.h"
+
+#ifdef CORRADE_TARGET_X86
+#include <immintrin.h>
+#endif
+
 namespace Corrade { namespace Utility {
 
 /* I might be going a bit overboard with the avoidance of inline function calls
@@ -112,6 +120,62 @@ void copy(const Containers::StridedArrayView3D<const char>& src, const Container
             {dstStride[0], dstStride[0], dstStride[1], dstStride[2]}});
 }
 
+namespace {
+
+/* Copy for a contiguous last dimension of a fixed size. The constant size
+   makes the compiler turn the memcpy() into a single (or two, in case of 12
+   bytes) scalar or SSE2 / NEON load+store pair, which is significantly faster
+   than both a memcpy() call and a byte-by-byte loop for small types. */
+template<std::size_t size> void copyFixed(const char* const srcPtr, char* const dstPtr, const std::size_t* const sizes, const std::ptrdiff_t* const srcStride, const std::ptrdiff_t* const dstStride) {
+    for(std::size_t i0 = 0; i0 != sizes[0]; ++i0) {
+        const char* srcPtr0 = srcPtr + i0*srcStride[0];
+        char* dstPtr0 = dstPtr + i0*dstStride[0];
+        for(std::size_t i1 = 0; i1 != sizes[1]; ++i1) {
+            const char* srcPtr1 = srcPtr0 + i1*srcStride[1];
+            char* dstPtr1 = dstPtr0 + i1*dstStride[1];
+            for(std::size_t i2 = 0; i2 != sizes[2]; ++i2) {
+                std::memcpy(dstPtr1, srcPtr1, size);
+                srcPtr1 += srcStride[2];
+                dstPtr1 += dstStride[2];
+            }
+        }
+    }
+}
+
+/* Cache-blocked copy for the case where the source and destination traverse
+   the second and third dimension in a different order, such as when copying
+   to a transposed view. Going over square tiles makes both the reads and the
+   writes stay within a few cache lines instead of one side touching a new
+   line on every element. A zero size means a runtime-sized last dimension. */
+template<std::size_t size> void copyBlocked(const char* const srcPtr, char* const dstPtr, const std::size_t* const sizes, const std::ptrdiff_t* const srcStride, const std::ptrdiff_t* const dstStride, const std::size_t tile) {
+    const std::size_t elementSize = size ? size : sizes[3];
+    for(std::size_t i0 = 0; i0 != sizes[0]; ++i0) {
+        const char* srcPtr0 = srcPtr + i0*srcStride[0];
+        char* dstPtr0 = dstPtr + i0*dstStride[0];
+        for(std::size_t t1 = 0; t1 < sizes[1]; t1 += tile) {
+            const std::size_t end1 = t1 + tile < sizes[1] ? t1 + tile : sizes[1];
+            for(std::size_t t2 = 0; t2 < sizes[2]; t2 += tile) {
+                const std::size_t end2 = t2 + tile < sizes[2] ? t2 + tile : sizes[2];
+                for(std::size_t i1 = t1; i1 != end1; ++i1) {
+                    const char* srcPtr1 = srcPtr0 + i1*srcStride[1] + t2*srcStride[2];
+                    char* dstPtr1 = dstPtr0 + i1*dstStride[1] + t2*dstStride[2];
+                    for(std::size_t i2 = t2; i2 != end2; ++i2) {
+                        std::memcpy(dstPtr1, srcPtr1, size ? size : elementSize);
+                        srcPtr1 += srcStride[2];
+                        dstPtr1 += dstStride[2];
+                    }
+                }
+            }
+        }
+    }
+}
+
+inline std::size_t absoluteStride(const std::ptrdiff_t stride) {
+    return stride < 0 ? -stride : stride;
+}
+
+}
+
 void copy(const Containers::StridedArrayView4D<const char>& src, const Containers::StridedArrayView4D<char>& dst) {
     const Containers::StridedDimensions<4, std::size_t> srcSize_ = src.size();
     const Containers::StridedDimensions<4, std::size_t> dstSize_ = dst.size();
@@ -159,8 +223,62 @@ void copy(const Containers::StridedArrayView4D<const char>& src, const Container
 
                    It becomes slightly worse in Debug (but not slower than a
                    hand-written loop using operator[], so I think that's still
-                   acceptable). OTOH, GCC is slower with Duff in both Debug and Release, so there we use the loop instead. */
-                if(src.isContiguous<3>() && dst.isContiguous<3>() && size[3] >= 8) {
+                   acceptable). OTOH, GCC is slower with Duff in both Debug and Release, so there we use the loop instead.
+
+                   If the last dimension is contiguous and has a size of a
+                   common type, a fixed-size copy is used instead of both. For
+                   GCC on Linux, copyBenchmark3DNonContiguous() numbers before
+                   and after:
+
+                    bytes   before  after
+                    ------- ------- -----
+                    1B      23.9    15.2
+                    4B      17.2     9.9
+                    8B      11.8     5.3
+                    16B      6.2     3.5 */
+                const bool lastContiguous = src.isContiguous<3>() && dst.isContiguous<3>();
+
+                /* If the last dimension is contiguous but the source and
+                   destination disagree on which of the two middle dimensions
+                   is the inner one, go over the data in tiles of at least 64
+                   bytes per row. For a debug GCC build on Linux,
+                   copyBenchmark2DTransposed() goes from 0.66 to 0.51 ms, most
+                   of which is filling the source data. */
+                std::size_t tile = 0;
+                if(lastContiguous && size[3] && size[3] <= 64 &&
+                   (absoluteStride(srcStride[2]) < absoluteStride(srcStride[1])) !=
+                   (absoluteStride(dstStride[2]) < absoluteStride(dstStride[1]))) {
+                    tile = size[3] < 8 ? 64/size[3] : 8;
+                    if(size[1] < tile || size[2] < tile) tile = 0;
+                }
+
+                if(tile && size[3] == 1)
+                    copyBlocked<1>(srcPtr, dstPtr, size, srcStride, dstStride, tile);
+                else if(tile && size[3] == 2)
+                    copyBlocked<2>(srcPtr, dstPtr, size, srcStride, dstStride, tile);
+                else if(tile && size[3] == 4)
+                    copyBlocked<4>(srcPtr, dstPtr, size, srcStride, dstStride, tile);
+                else if(tile && size[3] == 8)
+                    copyBlocked<8>(srcPtr, dstPtr, size, srcStride, dstStride, tile);
+                else if(tile && size[3] == 12)
+                    copyBlocked<12>(srcPtr, dstPtr, size, srcStride, dstStride, tile);
+                else if(tile && size[3] == 16)
+                    copyBlocked<16>(srcPtr, dstPtr, size, srcStride, dstStride, tile);
+                else if(tile)
+                    copyBlocked<0>(srcPtr, dstPtr, size, srcStride, dstStride, tile);
+                else if(lastContiguous && size[3] == 1)
+                    copyFixed<1>(srcPtr, dstPtr, size, srcStride, dstStride);
+                else if(lastContiguous && size[3] == 2)
+                    copyFixed<2>(srcPtr, dstPtr, size, srcStride, dstStride);
+                else if(lastContiguous && size[3] == 4)
+                    copyFixed<4>(srcPtr, dstPtr, size, srcStride, dstStride);
+                else if(lastContiguous && size[3] == 8)
+                    copyFixed<8>(srcPtr, dstPtr, size, srcStride, dstStride);
+                else if(lastContiguous && size[3] == 12)
+                    copyFixed<12>(srcPtr, dstPtr, size, srcStride, dstStride);
+                else if(lastContiguous && size[3] == 16)
+                    copyFixed<16>(srcPtr, dstPtr, size, srcStride, dstStride);
+                else if(lastContiguous && size[3] >= 8) {
                     for(std::size_t i0 = 0; i0 != size[0]; ++i0) {
                         const char* srcPtr0 = srcPtr + i0*srcStride[0];
                         char* dstPtr0 = dstPtr + i0*dstStride[0];
@@ -233,4 +351,803 @@ void copy(const Containers::StridedArrayView4D<const char>& src, const Container
     }
 }
 
+namespace {
+
+/* Count of permutation indices processed at once. The decoded indices take
+   8 kB on 64-bit, leaving enough space in L1 / L2 for the destination items
+   of all views. */
+constexpr std::size_t PermutationBlockSize = 1024;
+
+/* Decodes a block of indices of given type into a std::size_t array,
+   returning the largest of them */
+template<class I> std::size_t decodePermutation(const char* ptr, const std::ptrdiff_t stride, std::size_t* const indices, const std::size_t count) {
+    std::size_t max = 0;
+    for(std::size_t i = 0; i != count; ++i, ptr += stride) {
+        I index;
+        std::memcpy(&index, ptr, sizeof(I));
+        indices[i] = std::size_t(index);
+        if(indices[i] > max) max = indices[i];
+    }
+    return max;
+}
+
+/* Same reasoning as with copyFixed() above, a constant size makes the
+   memcpy() a single load+store pair */
+template<std::size_t size> void permuteFixed(const char* const srcPtr, const std::ptrdiff_t srcStride, char* dstPtr, const std::ptrdiff_t dstStride, const std::size_t* const indices, const std::size_t count) {
+    for(std::size_t i = 0; i != count; ++i, dstPtr += dstStride)
+        std::memcpy(dstPtr, srcPtr + std::ptrdiff_t(indices[i])*srcStride, size);
+}
+
+void permute(const char* const srcPtr, const std::ptrdiff_t srcStride, char* dstPtr, const std::ptrdiff_t dstStride, const std::size_t* const indices, const std::size_t count, const std::size_t size) {
+    for(std::size_t i = 0; i != count; ++i, dstPtr += dstStride)
+        std::memcpy(dstPtr, srcPtr + std::ptrdiff_t(indices[i])*srcStride, size);
+}
+
+struct ApplyPermutation {
+    Containers::StridedArrayView2D<const char> permutation;
+    Containers::ArrayView<const PermutationViews> views;
+    #ifndef CORRADE_NO_ASSERT
+    std::size_t srcSize;
+    #endif
+    std::size_t blocksPerJob;
+
+    void apply(std::size_t begin, std::size_t end) const;
+
+    static void job(void* state, const std::size_t i) {
+        const ApplyPermutation& self = *static_cast<const ApplyPermutation*>(state);
+        const std::size_t count = self.permutation.size()[0];
+        const std::size_t begin = i*self.blocksPerJob*PermutationBlockSize;
+        const std::size_t end = begin + self.blocksPerJob*PermutationBlockSize;
+        self.apply(begin, end < count ? end : count);
+    }
+};
+
+void ApplyPermutation::apply(const std::size_t begin, const std::size_t end) const {
+    const std::size_t indexSize = permutation.size()[1];
+    const std::ptrdiff_t indexStride = permutation.stride()[0];
+
+    std::size_t indices[PermutationBlockSize];
+    for(std::size_t blockBegin = begin; blockBegin < end; blockBegin += PermutationBlockSize) {
+        const std::size_t count = end - blockBegin < PermutationBlockSize ? end - blockBegin : PermutationBlockSize;
+
+        const char* const indexPtr = static_cast<const char*>(permutation.data()) + std::ptrdiff_t(blockBegin)*indexStride;
+        std::size_t max;
+        if(indexSize == 1)
+            max = decodePermutation<std::uint8_t>(indexPtr, indexStride, indices, count);
+        else if(indexSize == 2)
+            max = decodePermutation<std::uint16_t>(indexPtr, indexStride, indices, count);
+        else if(indexSize == 4)
+            max = decodePermutation<std::uint32_t>(indexPtr, indexStride, indices, count);
+        /* The public API allows only integral types, so it's 8 bytes here */
+        else
+            max = decodePermutation<std::uint64_t>(indexPtr, indexStride, indices, count);
+        CORRADE_ASSERT(max < srcSize,
+            "Utility::applyPermutation(): index" << max << "out of bounds for" << srcSize << "elements", );
+        #ifdef CORRADE_NO_ASSERT
+        static_cast<void>(max);
+        #endif
+
+        for(const PermutationViews& view: views) {
+            const std::size_t size = view.src.size()[1];
+            const char* const srcPtr = static_cast<const char*>(view.src.data());
+            const std::ptrdiff_t srcStride = view.src.stride()[0];
+            const std::ptrdiff_t dstStride = view.dst.stride()[0];
+            char* const dstPtr = static_cast<char*>(view.dst.data()) + std::ptrdiff_t(blockBegin)*dstStride;
+            if(size == 1)
+                permuteFixed<1>(srcPtr, srcStride, dstPtr, dstStride, indices, count);
+            else if(size == 2)
+                permuteFixed<2>(srcPtr, srcStride, dstPtr, dstStride, indices, count);
+            else if(size == 4)
+                permuteFixed<4>(srcPtr, srcStride, dstPtr, dstStride, indices, count);
+            else if(size == 8)
+                permuteFixed<8>(srcPtr, srcStride, dstPtr, dstStride, indices, count);
+            else if(size == 12)
+                permuteFixed<12>(srcPtr, srcStride, dstPtr, dstStride, indices, count);
+            else if(size == 16)
+                permuteFixed<16>(srcPtr, srcStride, dstPtr, dstStride, indices, count);
+            else
+                permute(srcPtr, srcStride, dstPtr, dstStride, indices, count, size);
+        }
+    }
+}
+
+}
+
+namespace Implementation {
+
+void applyPermutation(const Containers::StridedArrayView2D<const char>& permutation, const Containers::ArrayView<const PermutationViews> views, const ParallelExecutor executor, void* const executorState, std::size_t jobCount) {
+    const std::size_t count = permutation.size()[0];
+
+    #ifndef CORRADE_NO_ASSERT
+    std::size_t srcSize = ~std::size_t{};
+    #endif
+    for(std::size_t i = 0; i != views.size(); ++i) {
+        const PermutationViews& view = views[i];
+        CORRADE_ASSERT(view.dst.size()[0] == count,
+            "Utility::applyPermutation(): expected destination view" << i << "to have" << count << "items but got" << view.dst.size()[0], );
+        CORRADE_ASSERT(view.src.size()[1] == view.dst.size()[1],
+            "Utility::applyPermutation(): item sizes" << view.src.size()[1] << "and" << view.dst.size()[1] << "in views" << i << "don't match", );
+        CORRADE_ASSERT(view.src.isContiguous<1>() && view.dst.isContiguous<1>(),
+            "Utility::applyPermutation(): second dimension of views" << i << "is not contiguous", );
+        #ifndef CORRADE_NO_ASSERT
+        if(view.src.size()[0] < srcSize) srcSize = view.src.size()[0];
+        #endif
+    }
+
+    if(!count || views.empty()) return;
+
+    ApplyPermutation state{permutation, views,
+        #ifndef CORRADE_NO_ASSERT
+        srcSize,
+        #endif
+        0};
+
+    /* Not worth parallelizing, apply directly */
+    const std::size_t blockCount = (count + PermutationBlockSize - 1)/PermutationBlockSize;
+    if(!executor || jobCount < 2 || blockCount < 2) {
+        state.apply(0, count);
+        return;
+    }
+
+    if(jobCount > blockCount) jobCount = blockCount;
+    state.blocksPerJob = (blockCount + jobCount - 1)/jobCount;
+    executor(executorState, (blockCount + state.blocksPerJob - 1)/state.blocksPerJob, ApplyPermutation::job, &state);
+}
+
+}
+
+namespace Implementation {
+
+namespace {
+
+/* Search and reduction kernels. The scalar variants take a stride and are
+   used for non-contiguous views as well, the SIMD variants operate on
+   contiguous memory and process the remaining items with the scalar
+   variant. The 64-bit lanes of integer sums wrap around, which makes the
+   result the same as with the scalar variant irrespectively of the order. */
+
+/* Integer sums are accumulated as unsigned to have a well-defined
+   wraparound */
+template<class T, bool = std::is_integral<T>::value> struct SumAccumulator {
+    typedef std::uint64_t Type;
+    static Type from(const T value) {
+        return Type(typename AlgorithmTypeFor<T>::SumType(value));
+    }
+};
+template<class T> struct SumAccumulator<T, false> {
+    typedef T Type;
+    static Type from(const T value) { return value; }
+};
+
+template<class T> inline const T& at(const char* const data, const std::size_t i, const std::ptrdiff_t stride) {
+    return *reinterpret_cast<const T*>(data + std::ptrdiff_t(i)*stride);
+}
+
+template<class T> std::size_t findStrided(const char* const data, const std::size_t size, const std::ptrdiff_t stride, const void* const value) {
+    const T v = *static_cast<const T*>(value);
+    for(std::size_t i = 0; i != size; ++i)
+        if(at<T>(data, i, stride) == v) return i;
+    return size;
+}
+
+template<class T> std::size_t countStrided(const char* const data, const std::size_t size, const std::ptrdiff_t stride, const void* const value) {
+    const T v = *static_cast<const T*>(value);
+    std::size_t count = 0;
+    for(std::size_t i = 0; i != size; ++i)
+        if(at<T>(data, i, stride) == v) ++count;
+    return count;
+}
+
+template<class T> std::size_t mismatchStrided(const char* const a, const std::ptrdiff_t aStride, const char* const b, const std::ptrdiff_t bStride, const std::size_t size) {
+    for(std::size_t i = 0; i != size; ++i)
+        if(at<T>(a, i, aStride) != at<T>(b, i, bStride)) return i;
+    return size;
+}
+
+template<class T> void minmaxStrided(const char* const data, const std::size_t size, const std::ptrdiff_t stride, void* const min, void* const max) {
+    T outMin = at<T>(data, 0, stride);
+    T outMax = outMin;
+    for(std::size_t i = 1; i != size; ++i) {
+        const T value = at<T>(data, i, stride);
+        if(value < outMin) outMin = value;
+        if(outMax < value) outMax = value;
+    }
+    *static_cast<T*>(min) = outMin;
+    *static_cast<T*>(max) = outMax;
+}
+
+template<class T> typename SumAccumulator<T>::Type sumStridedInto(typename SumAccumulator<T>::Type out, const char* const data, const std::size_t size, const std::ptrdiff_t stride) {
+    for(std::size_t i = 0; i != size; ++i)
+        out += SumAccumulator<T>::from(at<T>(data, i, stride));
+    return out;
+}
+
+template<class T> void sumStrided(const char* const data, const std::size_t size, const std::ptrdiff_t stride, void* const sum) {
+    *static_cast<typename AlgorithmTypeFor<T>::SumType*>(sum) = typename AlgorithmTypeFor<T>::SumType(sumStridedInto<T>({}, data, size, stride));
+}
+
+template<class T> std::size_t findScalar(const void* const data, const std::size_t size, const void* const value) {
+    return findStrided<T>(static_cast<const char*>(data), size, sizeof(T), value);
+}
+
+template<class T> std::size_t countScalar(const void* const data, const std::size_t size, const void* const value) {
+    return countStrided<T>(static_cast<const char*>(data), size, sizeof(T), value);
+}
+
+template<class T> std::size_t mismatchScalar(const void* const a, const void* const b, const std::size_t size) {
+    return mismatchStrided<T>(static_cast<const char*>(a), sizeof(T), static_cast<const char*>(b), sizeof(T), size);
+}
+
+template<class T> void minmaxScalar(const void* const data, const std::size_t size, void* const min, void* const max) {
+    minmaxStrided<T>(static_cast<const char*>(data), size, sizeof(T), min, max);
+}
+
+template<class T> void sumScalar(const void* const data, const std::size_t size, void* const sum) {
+    sumStrided<T>(static_cast<const char*>(data), size, sizeof(T), sum);
+}
+
+#ifdef CORRADE_TARGET_X86
+inline unsigned int lowestSetBit(const std::uint32_t value) {
+    #ifdef CORRADE_TARGET_MSVC
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return index;
+    #else
+    return __builtin_ctz(value);
+    #endif
+}
+
+inline unsigned int popcount(std::uint32_t value) {
+    #ifdef CORRADE_TARGET_MSVC
+    /* __popcnt() would need a POPCNT check */
+    value = value - ((value >> 1) & 0x55555555u);
+    value = (value & 0x33333333u) + ((value >> 2) & 0x33333333u);
+    return (((value + (value >> 4)) & 0x0f0f0f0fu)*0x01010101u) >> 24;
+    #else
+    return __builtin_popcount(value);
+    #endif
+}
+
+/* The traits provide loads, a splat, an equality comparison returning a
+   bitmask with sizeof(T) bits per item, min/max and accumulation of a sum.
+   Operations that SSE2 doesn't have for given type are emulated by flipping
+   the sign bit (for unsigned min/max) or with a compare and a select (for
+   32-bit min/max). There's no 64-bit integer min/max before AVX-512, so the
+   64-bit traits don't provide it. */
+template<class T> struct Sse2Integer {
+    typedef __m128i Vector;
+    typedef __m128i Accumulator;
+    enum: std::size_t { Size = 16/sizeof(T) };
+    enum: std::uint32_t { FullMask = 0xffffu };
+
+    CORRADE_ENABLE_SSE2 static Vector load(const T* const data) {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    }
+    CORRADE_ENABLE_SSE2 static void store(T* const data, const Vector a) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data), a);
+    }
+    CORRADE_ENABLE_SSE2 static std::uint32_t mask(const Vector a) {
+        return _mm_movemask_epi8(a);
+    }
+    CORRADE_ENABLE_SSE2 static Accumulator zero() {
+        return _mm_setzero_si128();
+    }
+    CORRADE_ENABLE_SSE2 static std::uint64_t reduceLanes(const Accumulator a) {
+        std::uint64_t lanes[2];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), a);
+        return lanes[0] + lanes[1];
+    }
+    /* Sign-extends four 32-bit lanes to 64 bits and adds them */
+    CORRADE_ENABLE_SSE2 static Accumulator accumulateSigned32(const Accumulator a, const __m128i value) {
+        const __m128i sign = _mm_srai_epi32(value, 31);
+        return _mm_add_epi64(_mm_add_epi64(a, _mm_unpacklo_epi32(value, sign)), _mm_unpackhi_epi32(value, sign));
+    }
+    CORRADE_ENABLE_SSE2 static __m128i select(const __m128i mask, const __m128i a, const __m128i b) {
+        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+    }
+};
+
+template<class T> struct Sse2;
+template<> struct Sse2<std::uint8_t>: Sse2Integer<std::uint8_t> {
+    CORRADE_ENABLE_SSE2 static Vector splat(const std::uint8_t value) { return _mm_set1_epi8(char(value)); }
+    CORRADE_ENABLE_SSE2 static std::uint32_t equalMask(const Vector a, const Vector b) { return mask(_mm_cmpeq_epi8(a, b)); }
+    CORRADE_ENABLE_SSE2 static Vector min(const Vector a, const Vector b) { return _mm_min_epu8(a, b); }
+    CORRADE_ENABLE_SSE2 static Vector max(const Vector a, const Vector b) { return _mm_max_epu8(a, b); }
+    CORRADE_ENABLE_SSE2 static Accumulator accumulate(const Accumulator a, const Vector value) {
+        return _mm_add_epi64(a, _mm_sad_epu8(value, _mm_setzero_si128()));
+    }
+    CORRADE_ENABLE_SSE2 static std::uint64_t reduceSum(const Accumulator a, std::size_t) { return reduceLanes(a); }
+};
+template<> struct Sse2<std::int8_t>: Sse2Integer<std::int8_t> {
+    CORRADE_ENABLE_SSE2 static Vector bias(const Vector a) { return _mm_xor_si128(a, _mm_set1_epi8(-128)); }
+    CORRADE_ENABLE_SSE2 static Vector splat(const std::int8_t value) { return _mm_set1_epi8(value); }
+    CORRADE_ENABLE_SSE2 static std::uint32_t equalMask(const Vector a, const Vector b) { return mask(_mm_cmpeq_epi8(a, b)); }
+    CORRADE_ENABLE_SSE2 static Vector min(const Vector a, const Vector b) { return bias(_mm_min_epu8(bias(a), bias(b))); }
+    CORRADE_ENABLE_SSE2 static Vector max(const Vector a, const Vector b) { return bias(_mm_max_epu8(bias(a), bias(b))); }
+    CORRADE_ENABLE_SSE2 static Accumulator accumulate(const Accumulator a, const Vector value) {
+        return _mm_add_epi64(a, _mm_sad_epu8(bias(value), _mm_setzero_si128()));
+    }
+    CORRADE_ENABLE_SSE2 static std::uint64_t reduceSum(const Accumulator a, const std::size_t count) { return reduceLanes(a) - 128*std::uint64_t(count); }
+};
+template<> struct Sse2<std::int16_t>: Sse2Integer<std::int16_t> {
+    CORRADE_ENABLE_SSE2 static Vector splat(const std::int16_t value) { return _mm_set1_epi16(value); }
+    CORRADE_ENABLE_SSE2 static std::uint32_t equalMask(const Vector a, const Vector b) { return mask(_mm_cmpeq_epi16(a, b)); }
+    CORRADE_ENABLE_SSE2 static Vector min(const Vector a, const Vector b) { return _mm_min_epi16(a, b); }
+    CORRADE_ENABLE_SSE2 static Vector max(const Vector a, const Vector b) { return _mm_max_epi16(a, b); }
+    CORRADE_ENABLE_SSE2 static Accumulator accumulate(const Accumulator a, const Vector value) {
+        return accumulateSigned32(a, _mm_madd_epi16(value, _mm_set1_epi16(1)));
+    }
+    CORRADE_ENABLE_SSE2 static std::uint64_t reduceSum(const Accumulator a, std::size_t) { return reduceLanes(a); }
+};
+template<> struct Sse2<std::uint16_t>: Sse2Integer<std::uint16_t> {
+    CORRADE_ENABLE_SSE2 static Vector bias(const Vector a) { return _mm_xor_si128(a, _mm_set1_epi16(-32768)); }
+    CORRADE_ENABLE_SSE2 static Vector splat(const std::uint16_t value) { return _mm_set1_epi16(short(value)); }
+    CORRADE_ENABLE_SSE2 static std::uint32_t equalMask(const Vector a, const Vector b) { return mask(_mm_cmpeq_epi16(a, b)); }
+    CORRADE_ENABLE_SSE2 static Vector min(const Vector a, const Vector b) { return bias(_mm_min_epi16(bias(a), bias(b))); }
+    CORRADE_ENABLE_SSE2 static Vector max(const Vector a, const Vector b) { return bias(_mm_max_epi16(bias(a), bias(b))); }
+    CORRADE_ENABLE_SSE2 static Accumulator accumulate(const Accumulator a, const Vector value) {
+        return accumulateSigned32(a, _mm_madd_epi16(bias(value), _mm_set1_epi16(1)));
+    }
+    CORRADE_ENABLE_SSE2 static std::uint64_t reduceSum(const Accumulator a, const std::size_t count) { return reduceLanes(a) + 32768*std::uint64_t(count); }
+};
+template<> struct Sse2<std::int32_t>: Sse2Integer<std::int32_t> {
+    CORRADE_ENABLE_SSE2 static Vector splat(const std::int32_t value) { return _mm_set1_epi32(value); }
+    CORRADE_ENABLE_SSE2 static std::uint32_t equalMask(const Vector a, const Vector b) { return mask(_mm_cmpeq_epi32(a, b)); }
+    CORRADE_ENABLE_SSE2 static Vector min(const Vector a, const Vector b) { return select(_mm_cmpgt_epi32(a, b), b, a); }
+    CORRADE_ENABLE_SSE2 static Vector max(const Vector a, const Vector b) { return select(_mm_cmpgt_epi32(a, b), a, b); }
+    CORRADE_ENABLE_SSE2 static Accumulator accumulate(const Accumulator a, const Vector value) {
+        return accumulateSigned32(a, value);
+    }
+    CORRADE_ENABLE_SSE2 static std::uint64_t reduceSum(const Accumulator a, std::size_t) { return reduceLanes(a); }
+};
+template<> struct Sse2<std::uint32_t>: Sse2Integer<std::uint32_t> {
+    CORRADE_ENABLE_SSE2 static Vector bias(const Vector a) { return _mm_xor_si128(a, _mm_set1_epi32(int(0x80000000u))); }
+    CORRADE_ENABLE_SSE2 static Vector splat(const std::uint32_t value) { return _mm_set1_epi32(int(value)); }
+    CORRADE_ENABLE_SSE2 static std::uint32_t equalMask(const Vector a, const Vector b) { return mask(_mm_cmpeq_epi32(a, b)); }
+    CORRADE_ENABLE_SSE2 static Vector min(const Vector a, const Vector b) { return select(_mm_cmpgt_epi32(bias(a), bias(b)), b, a); }
+    CORRADE_ENABLE_SSE2 static Vector max(const Vector a, const Vector b) { return select(_mm_cmpgt_epi32(bias(a), bias(b)), a, b); }
+    CORRADE_ENABLE_SSE2 static Accumulator accumulate(const Accumulator a, const Vector value) {
+        const __m128i zero = _mm_setzero_si128();
+        return _mm_add_epi64(_mm_add_epi64(a, _mm_unpacklo_epi32(value, zero)), _mm_unpackhi_epi32(value, zero));
+    }
+    CORRADE_ENABLE_SSE2 static std::uint64_t reduceSum(const Accumulator a, std::size_t) { return reduceLanes(a); }
+};
+/* There's no 64-bit comparison in SSE2, combine two 32-bit ones instead */
+template<class T> struct Sse2Integer64: Sse2Integer<T> {
+    typedef __m128i Vector;
+    typedef __m128i Accumulator;
+    CORRADE_ENABLE_SSE2 static Vector splat(const T value) {
+        const std::uint64_t lanes[2]{std::uint64_t(value), std::uint64_t(value)};
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes));
+    }
+    CORRADE_ENABLE_SSE2 static std::uint32_t equalMask(const Vector a, const Vector b) {
+        const __m128i equal = _mm_cmpeq_epi32(a, b);
+        return _mm_movemask_epi8(_mm_and_si128(equal, _mm_shuffle_epi32(equal, _MM_SHUFFLE(2, 3, 0, 1))));
+    }
+    CORRADE_ENABLE_SSE2 static Accumulator accumulate(const Accumulator a, const Vector value) {
+        return _mm_add_epi64(a, value);
+    }
+    CORRADE_ENABLE_SSE2 static std::uint64_t reduceSum(const Accumulator a, std::size_t) { return Sse2Integer<T>::reduceLanes(a); }
+};
+template<> struct Sse2<std::int64_t>: Sse2Integer64<std::int64_t> {};
+template<> struct Sse2<std::uint64_t>: Sse2Integer64<std::uint64_t> {};
+template<> struct Sse2<float> {
+    typedef __m128 Vector;
+    typedef __m128 Accumulator;
+    enum: std::size_t { Size = 4 };
+    enum: std::uint32_t { FullMask = 0xffffu };
+
+    CORRADE_ENABLE_SSE2 static Vector load(const float* const data) { return _mm_loadu_ps(data); }
+    CORRADE_ENABLE_SSE2 static void store(float* const data, const Vector a) { _mm_storeu_ps(data, a); }
+    CORRADE_ENABLE_SSE2 static Vector splat(const float value) { return _mm_set1_ps(value); }
+    CORRADE_ENABLE_SSE2 static std::uint32_t equalMask(const Vector a, const Vector b) { return _mm_movemask_epi8(_mm_castps_si128(_mm_cmpeq_ps(a, b))); }
+    CORRADE_ENABLE_SSE2 static Vector min(const Vector a, const Vector b) { return _mm_min_ps(a, b); }
+    CORRADE_ENABLE_SSE2 static Vector max(const Vector a, const Vector b) { return _mm_max_ps(a, b); }
+    CORRADE_ENABLE_SSE2 static Accumulator zero() { return _mm_setzero_ps(); }
+    CORRADE_ENABLE_SSE2 static Accumulator accumulate(const Accumulator a, const Vector value) { return _mm_add_ps(a, value); }
+    CORRADE_ENABLE_SSE2 static float reduceSum(const Accumulator a, std::size_t) {
+        float lanes[4];
+        _mm_storeu_ps(lanes, a);
+        return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    }
+};
+template<> struct Sse2<double> {
+    typedef __m128d Vector;
+    typedef __m128d Accumulator;
+    enum: std::size_t { Size = 2 };
+    enum: std::uint32_t { FullMask = 0xffffu };
+
+    CORRADE_ENABLE_SSE2 static Vector load(const double* const data) { return _mm_loadu_pd(data); }
+    CORRADE_ENABLE_SSE2 static void store(double* const data, const Vector a) { _mm_storeu_pd(data, a); }
+    CORRADE_ENABLE_SSE2 static Vector splat(const double value) { return _mm_set1_pd(value); }
+    CORRADE_ENABLE_SSE2 static std::uint32_t equalMask(const Vector a, const Vector b) { return _mm_movemask_epi8(_mm_castpd_si128(_mm_cmpeq_pd(a, b))); }
+    CORRADE_ENABLE_SSE2 static Vector min(const Vector a, const Vector b) { return _mm_min_pd(a, b); }
+    CORRADE_ENABLE_SSE2 static Vector max(const Vector a, const Vector b) { return _mm_max_pd(a, b); }
+    CORRADE_ENABLE_SSE2 static Accumulator zero() { return _mm_setzero_pd(); }
+    CORRADE_ENABLE_SSE2 static Accumulator accumulate(const Accumulator a, const Vector value) { return _mm_add_pd(a, value); }
+    CORRADE_ENABLE_SSE2 static double reduceSum(const Accumulator a, std::size_t) {
+        double lanes[2];
+        _mm_storeu_pd(lanes, a);
+        return lanes[0] + lanes[1];
+    }
+};
+
+/* AVX2 has all the integer operations natively except for 64-bit min/max */
+template<class T> struct Avx2Integer {
+    typedef __m256i Vector;
+    typedef __m256i Accumulator;
+    enum: std::size_t { Size = 32/sizeof(T) };
+    enum: std::uint32_t { FullMask = 0xffffffffu };
+
+    CORRADE_ENABLE_AVX2 static Vector load(const T* const data) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+    }
+    CORRADE_ENABLE_AVX2 static void store(T* const data, const Vector a) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(data), a);
+    }
+    CORRADE_ENABLE_AVX2 static std::uint32_t mask(const Vector a) {
+        return std::uint32_t(_mm256_movemask_epi8(a));
+    }
+    CORRADE_ENABLE_AVX2 static Accumulator zero() {
+        return _mm256_setzero_si256();
+    }
+    CORRADE_ENABLE_AVX2 static std::uint64_t reduceLanes(const Accumulator a) {
+        std::uint64_t lanes[4];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), a);
+        return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    }
+    CORRADE_ENABLE_AVX2 static Accumulator accumulateSigned32(const Accumulator a, const __m256i value) {
+        const __m256i sign = _mm256_srai_epi32(value, 31);
+        return _mm256_add_epi64(_mm256_add_epi64(a, _mm256_unpacklo_epi32(value, sign)), _mm256_unpackhi_epi32(value, sign));
+    }
+};
+
+template<class T> struct Avx2;
+template<> struct Avx2<std::uint8_t>: Avx2Integer<std::uint8_t> {
+    CORRADE_ENABLE_AVX2 static Vector splat(const std::uint8_t value) { return _mm256_set1_epi8(char(value)); }
+    CORRADE_ENABLE_AVX2 static std::uint32_t equalMask(const Vector a, const Vector b) { return mask(_mm256_cmpeq_epi8(a, b)); }
+    CORRADE_ENABLE_AVX2 static Vector min(const Vector a, const Vector b) { return _mm256_min_epu8(a, b); }
+    CORRADE_ENABLE_AVX2 static Vector max(const Vector a, const Vector b) { return _mm256_max_epu8(a, b); }
+    CORRADE_ENABLE_AVX2 static Accumulator accumulate(const Accumulator a, const Vector value) {
+        return _mm256_add_epi64(a, _mm256_sad_epu8(value, _mm256_setzero_si256()));
+    }
+    CORRADE_ENABLE_AVX2 static std::uint64_t reduceSum(const Accumulator a, std::size_t) { return reduceLanes(a); }
+};
+template<> struct Avx2<std::int8_t>: Avx2Integer<std::int8_t> {
+    CORRADE_ENABLE_AVX2 static Vector splat(const std::int8_t value) { return _mm256_set1_epi8(value); }
+    CORRADE_ENABLE_AVX2 static std::uint32_t equalMask(const Vector a, const Vector b) { return mask(_mm256_cmpeq_epi8(a, b)); }
+    CORRADE_ENABLE_AVX2 static Vector min(const Vector a, const Vector b) { return _mm256_min_epi8(a, b); }
+    CORRADE_ENABLE_AVX2 static Vector max(const Vector a, const Vector b) { return _mm256_max_epi8(a, b); }
+    CORRADE_ENABLE_AVX2 static Accumulator accumulate(const Accumulator a, const Vector value) {
+        return _mm256_add_epi64(a, _mm256_sad_epu8(_mm256_xor_si256(value, _mm256_set1_epi8(-128)), _mm256_setzero_si256()));
+    }
+    CORRADE_ENABLE_AVX2 static std::uint64_t reduceSum(const Accumulator a, const std::size_t count) { return reduceLanes(a) - 128*std::uint64_t(count); }
+};
+template<> struct Avx2<std::int16_t>: Avx2Integer<std::int16_t> {
+    CORRADE_ENABLE_AVX2 static Vector splat(const std::int16_t value) { return _mm256_set1_epi16(value); }
+    CORRADE_ENABLE_AVX2 static std::uint32_t equalMask(const Vector a, const Vector b) { return mask(_mm256_cmpeq_epi16(a, b)); }
+    CORRADE_ENABLE_AVX2 static Vector min(const Vector a, const Vector b) { return _mm256_min_epi16(a, b); }
+    CORRADE_ENABLE_AVX2 static Vector max(const Vector a, const Vector b) { return _mm256_max_epi16(a, b); }
+    CORRADE_ENABLE_AVX2 static Accumulator accumulate(const Accumulator a, const Vector value) {
+        return accumulateSigned32(a, _mm256_madd_epi16(value, _mm256_set1_epi16(1)));
+    }
+    CORRADE_ENABLE_AVX2 static std::uint64_t reduceSum(const Accumulator a, std::size_t) { return reduceLanes(a); }
+};
+template<> struct Avx2<std::uint16_t>: Avx2Integer<std::uint16_t> {
+    CORRADE_ENABLE_AVX2 static Vector splat(const std::uint16_t value) { return _mm256_set1_epi16(short(value)); }
+    CORRADE_ENABLE_AVX2 static std::uint32_t equalMask(const Vector a, const Vector b) { return mask(_mm256_cmpeq_epi16(a, b)); }
+    CORRADE_ENABLE_AVX2 static Vector min(const Vector a, const Vector b) { return _mm256_min_epu16(a, b); }
+    CORRADE_ENABLE_AVX2 static Vector max(const Vector a, const Vector b) { return _mm256_max_epu16(a, b); }
+    CORRADE_ENABLE_AVX2 static Accumulator accumulate(const Accumulator a, const Vector value) {
+        return accumulateSigned32(a, _mm256_madd_epi16(_mm256_xor_si256(value, _mm256_set1_epi16(-32768)), _mm256_set1_epi16(1)));
+    }
+    CORRADE_ENABLE_AVX2 static std::uint64_t reduceSum(const Accumulator a, const std::size_t count) { return reduceLanes(a) + 32768*std::uint64_t(count); }
+};
+template<> struct Avx2<std::int32_t>: Avx2Integer<std::int32_t> {
+    CORRADE_ENABLE_AVX2 static Vector splat(const std::int32_t value) { return _mm256_set1_epi32(value); }
+    CORRADE_ENABLE_AVX2 static std::uint32_t equalMask(const Vector a, const Vector b) { return mask(_mm256_cmpeq_epi32(a, b)); }
+    CORRADE_ENABLE_AVX2 static Vector min(const Vector a, const Vector b) { return _mm256_min_epi32(a, b); }
+    CORRADE_ENABLE_AVX2 static Vector max(const Vector a, const Vector b) { return _mm256_max_epi32(a, b); }
+    CORRADE_ENABLE_AVX2 static Accumulator accumulate(const Accumulator a, const Vector value) {
+        return accumulateSigned32(a, value);
+    }
+    CORRADE_ENABLE_AVX2 static std::uint64_t reduceSum(const Accumulator a, std::size_t) { return reduceLanes(a); }
+};
+template<> struct Avx2<std::uint32_t>: Avx2Integer<std::uint32_t> {
+    CORRADE_ENABLE_AVX2 static Vector splat(const std::uint32_t value) { return _mm256_set1_epi32(int(value)); }
+    CORRADE_ENABLE_AVX2 static std::uint32_t equalMask(const Vector a, const Vector b) { return mask(_mm256_cmpeq_epi32(a, b)); }
+    CORRADE_ENABLE_AVX2 static Vector min(const Vector a, const Vector b) { return _mm256_min_epu32(a, b); }
+    CORRADE_ENABLE_AVX2 static Vector max(const Vector a, const Vector b) { return _mm256_max_epu32(a, b); }
+    CORRADE_ENABLE_AVX2 static Accumulator accumulate(const Accumulator a, const Vector value) {
+        const __m256i zero = _mm256_setzero_si256();
+        return _mm256_add_epi64(_mm256_add_epi64(a, _mm256_unpacklo_epi32(value, zero)), _mm256_unpackhi_epi32(value, zero));
+    }
+    CORRADE_ENABLE_AVX2 static std::uint64_t reduceSum(const Accumulator a, std::size_t) { return reduceLanes(a); }
+};
+template<class T> struct Avx2Integer64: Avx2Integer<T> {
+    typedef __m256i Vector;
+    typedef __m256i Accumulator;
+    CORRADE_ENABLE_AVX2 static Vector splat(const T value) {
+        const std::uint64_t lanes[4]{std::uint64_t(value), std::uint64_t(value), std::uint64_t(value), std::uint64_t(value)};
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes));
+    }
+    CORRADE_ENABLE_AVX2 static std::uint32_t equalMask(const Vector a, const Vector b) {
+        return Avx2Integer<T>::mask(_mm256_cmpeq_epi64(a, b));
+    }
+    CORRADE_ENABLE_AVX2 static Accumulator accumulate(const Accumulator a, const Vector value) {
+        return _mm256_add_epi64(a, value);
+    }
+    CORRADE_ENABLE_AVX2 static std::uint64_t reduceSum(const Accumulator a, std::size_t) { return Avx2Integer<T>::reduceLanes(a); }
+};
+template<> struct Avx2<std::int64_t>: Avx2Integer64<std::int64_t> {};
+template<> struct Avx2<std::uint64_t>: Avx2Integer64<std::uint64_t> {};
+template<> struct Avx2<float> {
+    typedef __m256 Vector;
+    typedef __m256 Accumulator;
+    enum: std::size_t { Size = 8 };
+    enum: std::uint32_t { FullMask = 0xffffffffu };
+
+    CORRADE_ENABLE_AVX2 static Vector load(const float* const data) { return _mm256_loadu_ps(data); }
+    CORRADE_ENABLE_AVX2 static void store(float* const data, const Vector a) { _mm256_storeu_ps(data, a); }
+    CORRADE_ENABLE_AVX2 static Vector splat(const float value) { return _mm256_set1_ps(value); }
+    CORRADE_ENABLE_AVX2 static std::uint32_t equalMask(const Vector a, const Vector b) { return std::uint32_t(_mm256_movemask_epi8(_mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)))); }
+    CORRADE_ENABLE_AVX2 static Vector min(const Vector a, const Vector b) { return _mm256_min_ps(a, b); }
+    CORRADE_ENABLE_AVX2 static Vector max(const Vector a, const Vector b) { return _mm256_max_ps(a, b); }
+    CORRADE_ENABLE_AVX2 static Accumulator zero() { return _mm256_setzero_ps(); }
+    CORRADE_ENABLE_AVX2 static Accumulator accumulate(const Accumulator a, const Vector value) { return _mm256_add_ps(a, value); }
+    CORRADE_ENABLE_AVX2 static float reduceSum(const Accumulator a, std::size_t) {
+        float lanes[8];
+        _mm256_storeu_ps(lanes, a);
+        return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+    }
+};
+template<> struct Avx2<double> {
+    typedef __m256d Vector;
+    typedef __m256d Accumulator;
+    enum: std::size_t { Size = 4 };
+    enum: std::uint32_t { FullMask = 0xffffffffu };
+
+    CORRADE_ENABLE_AVX2 static Vector load(const double* const data) { return _mm256_loadu_pd(data); }
+    CORRADE_ENABLE_AVX2 static void store(double* const data, const Vector a) { _mm256_storeu_pd(data, a); }
+    CORRADE_ENABLE_AVX2 static Vector splat(const double value) { return _mm256_set1_pd(value); }
+    CORRADE_ENABLE_AVX2 static std::uint32_t equalMask(const Vector a, const Vector b) { return std::uint32_t(_mm256_movemask_epi8(_mm256_castpd_si256(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)))); }
+    CORRADE_ENABLE_AVX2 static Vector min(const Vector a, const Vector b) { return _mm256_min_pd(a, b); }
+    CORRADE_ENABLE_AVX2 static Vector max(const Vector a, const Vector b) { return _mm256_max_pd(a, b); }
+    CORRADE_ENABLE_AVX2 static Accumulator zero() { return _mm256_setzero_pd(); }
+    CORRADE_ENABLE_AVX2 static Accumulator accumulate(const Accumulator a, const Vector value) { return _mm256_add_pd(a, value); }
+    CORRADE_ENABLE_AVX2 static double reduceSum(const Accumulator a, std::size_t) {
+        double lanes[4];
+        _mm256_storeu_pd(lanes, a);
+        return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    }
+};
+
+/* The kernels are the same for SSE2 and AVX2, but as the target attributes
+   can't be templated, they're stamped out for each. The vectors are loaded
+   unaligned, which has no penalty on CPUs from the last decade. */
+#define CORRADE_UTILITY_ALGORITHM_KERNELS(Isa, enable)                      \
+template<class T> enable std::size_t find ## Isa(const void* const data_, const std::size_t size, const void* const value) { \
+    typedef Isa<T> S;                                                       \
+    const T* const data = static_cast<const T*>(data_);                     \
+    const typename S::Vector splat = S::splat(*static_cast<const T*>(value)); \
+    std::size_t i = 0;                                                      \
+    for(; i + S::Size <= size; i += S::Size)                                \
+        if(const std::uint32_t mask = S::equalMask(S::load(data + i), splat)) \
+            return i + lowestSetBit(mask)/sizeof(T);                        \
+    return i + findStrided<T>(reinterpret_cast<const char*>(data + i), size - i, sizeof(T), value); \
+}                                                                           \
+                                                                            \
+template<class T> enable std::size_t count ## Isa(const void* const data_, const std::size_t size, const void* const value) { \
+    typedef Isa<T> S;                                                       \
+    const T* const data = static_cast<const T*>(data_);                     \
+    const typename S::Vector splat = S::splat(*static_cast<const T*>(value)); \
+    std::size_t bits = 0;                                                   \
+    std::size_t i = 0;                                                      \
+    for(; i + S::Size <= size; i += S::Size)                                \
+        bits += popcount(S::equalMask(S::load(data + i), splat));           \
+    return bits/sizeof(T) + countStrided<T>(reinterpret_cast<const char*>(data + i), size - i, sizeof(T), value); \
+}                                                                           \
+                                                                            \
+template<class T> enable std::size_t mismatch ## Isa(const void* const a_, const void* const b_, const std::size_t size) { \
+    typedef Isa<T> S;                                                       \
+    const T* const a = static_cast<const T*>(a_);                           \
+    const T* const b = static_cast<const T*>(b_);                           \
+    std::size_t i = 0;                                                      \
+    for(; i + S::Size <= size; i += S::Size)                                \
+        if(const std::uint32_t mask = S::equalMask(S::load(a + i), S::load(b + i)) ^ S::FullMask) \
+            return i + lowestSetBit(mask)/sizeof(T);                        \
+    return i + mismatchStrided<T>(reinterpret_cast<const char*>(a + i), sizeof(T), reinterpret_cast<const char*>(b + i), sizeof(T), size - i); \
+}                                                                           \
+                                                                            \
+template<class T> enable void minmax ## Isa(const void* const data_, const std::size_t size, void* const min, void* const max) { \
+    typedef Isa<T> S;                                                       \
+    const T* const data = static_cast<const T*>(data_);                     \
+    if(size < S::Size) return minmaxStrided<T>(reinterpret_cast<const char*>(data), size, sizeof(T), min, max); \
+                                                                            \
+    typename S::Vector vmin = S::load(data);                                \
+    typename S::Vector vmax = vmin;                                         \
+    std::size_t i = S::Size;                                                \
+    for(; i + S::Size <= size; i += S::Size) {                              \
+        const typename S::Vector value = S::load(data + i);                 \
+        vmin = S::min(vmin, value);                                         \
+        vmax = S::max(vmax, value);                                         \
+    }                                                                       \
+                                                                            \
+    T lanesMin[S::Size], lanesMax[S::Size];                                 \
+    S::store(lanesMin, vmin);                                               \
+    S::store(lanesMax, vmax);                                               \
+    for(; i != size; ++i) {                                                 \
+        if(data[i] < lanesMin[0]) lanesMin[0] = data[i];                    \
+        if(lanesMax[0] < data[i]) lanesMax[0] = data[i];                    \
+    }                                                                       \
+    T outMin = lanesMin[0], outMax = lanesMax[0];                           \
+    for(std::size_t j = 1; j != S::Size; ++j) {                             \
+        if(lanesMin[j] < outMin) outMin = lanesMin[j];                      \
+        if(outMax < lanesMax[j]) outMax = lanesMax[j];                      \
+    }                                                                       \
+    *static_cast<T*>(min) = outMin;                                         \
+    *static_cast<T*>(max) = outMax;                                         \
+}                                                                           \
+                                                                            \
+template<class T> enable void sum ## Isa(const void* const data_, const std::size_t size, void* const sum) { \
+    typedef Isa<T> S;                                                       \
+    const T* const data = static_cast<const T*>(data_);                     \
+    typename S::Accumulator accumulator = S::zero();                        \
+    std::size_t i = 0;                                                      \
+    for(; i + S::Size <= size; i += S::Size)                                \
+        accumulator = S::accumulate(accumulator, S::load(data + i));        \
+    *static_cast<typename AlgorithmTypeFor<T>::SumType*>(sum) = typename AlgorithmTypeFor<T>::SumType(sumStridedInto<T>(S::reduceSum(accumulator, i), reinterpret_cast<const char*>(data + i), size - i, sizeof(T))); \
+}
+
+CORRADE_UTILITY_ALGORITHM_KERNELS(Sse2, CORRADE_ENABLE_SSE2)
+CORRADE_UTILITY_ALGORITHM_KERNELS(Avx2, CORRADE_ENABLE_AVX2)
+
+#undef CORRADE_UTILITY_ALGORITHM_KERNELS
+#endif
+
+typedef std::size_t(*FindFunction)(const void*, std::size_t, const void*);
+typedef std::size_t(*MismatchFunction)(const void*, const void*, std::size_t);
+typedef void(*MinmaxFunction)(const void*, std::size_t, void*, void*);
+typedef void(*SumFunction)(const void*, std::size_t, void*);
+
+template<class T> MinmaxFunction minmaxFunction(const Cpu::Features features) {
+    return Cpu::dispatch<MinmaxFunction>(features, {
+        #ifdef CORRADE_TARGET_X86
+        {Cpu::Feature::Avx2, minmaxAvx2<T>},
+        {Cpu::Feature::Sse2, minmaxSse2<T>},
+        #endif
+    }, minmaxScalar<T>);
+}
+
+/* No 64-bit integer min/max below AVX-512 */
+template<> MinmaxFunction minmaxFunction<std::int64_t>(Cpu::Features) {
+    return minmaxScalar<std::int64_t>;
+}
+template<> MinmaxFunction minmaxFunction<std::uint64_t>(Cpu::Features) {
+    return minmaxScalar<std::uint64_t>;
+}
+
+template<class T> AlgorithmKernels algorithmKernelsFor(const Cpu::Features features) {
+    return AlgorithmKernels{
+        Cpu::dispatch<FindFunction>(features, {
+            #ifdef CORRADE_TARGET_X86
+            {Cpu::Feature::Avx2, findAvx2<T>},
+            {Cpu::Feature::Sse2, findSse2<T>},
+            #endif
+        }, findScalar<T>),
+        Cpu::dispatch<FindFunction>(features, {
+            #ifdef CORRADE_TARGET_X86
+            {Cpu::Feature::Avx2, countAvx2<T>},
+            {Cpu::Feature::Sse2, countSse2<T>},
+            #endif
+        }, countScalar<T>),
+        Cpu::dispatch<MismatchFunction>(features, {
+            #ifdef CORRADE_TARGET_X86
+            {Cpu::Feature::Avx2, mismatchAvx2<T>},
+            {Cpu::Feature::Sse2, mismatchSse2<T>},
+            #endif
+        }, mismatchScalar<T>),
+        minmaxFunction<T>(features),
+        Cpu::dispatch<SumFunction>(features, {
+            #ifdef CORRADE_TARGET_X86
+            {Cpu::Feature::Avx2, sumAvx2<T>},
+            {Cpu::Feature::Sse2, sumSse2<T>},
+            #endif
+        }, sumScalar<T>)
+    };
+}
+
+/* Scalar variants for non-contiguous views */
+struct AlgorithmStridedKernels {
+    std::size_t(*find)(const char*, std::size_t, std::ptrdiff_t, const void*);
+    std::size_t(*count)(const char*, std::size_t, std::ptrdiff_t, const void*);
+    std::size_t(*mismatch)(const char*, std::ptrdiff_t, const char*, std::ptrdiff_t, std::size_t);
+    void(*minmax)(const char*, std::size_t, std::ptrdiff_t, void*, void*);
+    void(*sum)(const char*, std::size_t, std::ptrdiff_t, void*);
+};
+
+#define _c(type) {findStrided<type>, countStrided<type>, mismatchStrided<type>, minmaxStrided<type>, sumStrided<type>}
+/* Indexed by AlgorithmType */
+const AlgorithmStridedKernels AlgorithmStridedKernelTable[]{
+    _c(std::int8_t), _c(std::uint8_t), _c(std::int16_t), _c(std::uint16_t),
+    _c(std::int32_t), _c(std::uint32_t), _c(std::int64_t), _c(std::uint64_t),
+    _c(float), _c(double)
+};
+#undef _c
+
+constexpr std::ptrdiff_t AlgorithmTypeSize[]{1, 1, 2, 2, 4, 4, 8, 8, 4, 8};
+
+struct AlgorithmKernelTable {
+    AlgorithmKernels kernels[10];
+};
+
+AlgorithmKernelTable algorithmKernelTable() {
+    const Cpu::Features features = Cpu::runtimeFeatures();
+    AlgorithmKernelTable out;
+    for(std::size_t i = 0; i != Containers::arraySize(out.kernels); ++i)
+        out.kernels[i] = algorithmKernels(AlgorithmType(i), features);
+    return out;
+}
+
+const AlgorithmKernels& algorithmKernelsFor(const AlgorithmType type) {
+    static const AlgorithmKernelTable table = algorithmKernelTable();
+    return table.kernels[std::size_t(type)];
+}
+
+inline bool isContiguous(const AlgorithmType type, const Containers::StridedArrayView1D<const void>& view) {
+    return view.stride() == AlgorithmTypeSize[std::size_t(type)];
+}
+
+}
+
+AlgorithmKernels algorithmKernels(const AlgorithmType type, const Cpu::Features features) {
+    switch(type) {
+        case AlgorithmType::Int8: return algorithmKernelsFor<std::int8_t>(features);
+        case AlgorithmType::UnsignedInt8: return algorithmKernelsFor<std::uint8_t>(features);
+        case AlgorithmType::Int16: return algorithmKernelsFor<std::int16_t>(features);
+        case AlgorithmType::UnsignedInt16: return algorithmKernelsFor<std::uint16_t>(features);
+        case AlgorithmType::Int32: return algorithmKernelsFor<std::int32_t>(features);
+        case AlgorithmType::UnsignedInt32: return algorithmKernelsFor<std::uint32_t>(features);
+        case AlgorithmType::Int64: return algorithmKernelsFor<std::int64_t>(features);
+        case AlgorithmType::UnsignedInt64: return algorithmKernelsFor<std::uint64_t>(features);
+        case AlgorithmType::Float: return algorithmKernelsFor<float>(features);
+        case AlgorithmType::Double: return algorithmKernelsFor<double>(features);
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+std::size_t find(const AlgorithmType type, const Containers::StridedArrayView1D<const void>& values, const void* const value) {
+    if(isContiguous(type, values))
+        return algorithmKernelsFor(type).find(values.data(), values.size(), value);
+    return AlgorithmStridedKernelTable[std::size_t(type)].find(static_cast<const char*>(values.data()), values.size(), values.stride(), value);
+}
+
+std::size_t count(const AlgorithmType type, const Containers::StridedArrayView1D<const void>& values, const void* const value) {
+    if(isContiguous(type, values))
+        return algorithmKernelsFor(type).count(values.data(), values.size(), value);
+    return AlgorithmStridedKernelTable[std::size_t(type)].count(static_cast<const char*>(values.data()), values.size(), values.stride(), value);
+}
+
+std::size_t mismatch(const AlgorithmType type, const Containers::StridedArrayView1D<const void>& a, const Containers::StridedArrayView1D<const void>& b) {
+    const std::size_t size = a.size() < b.size() ? a.size() : b.size();
+    if(isContiguous(type, a) && isContiguous(type, b))
+        return algorithmKernelsFor(type).mismatch(a.data(), b.data(), size);
+    return AlgorithmStridedKernelTable[std::size_t(type)].mismatch(static_cast<const char*>(a.data()), a.stride(), static_cast<const char*>(b.data()), b.stride(), size);
+}
+
+void minmax(const AlgorithmType type, const Containers::StridedArrayView1D<const void>& values, void* const min, void* const max) {
+    if(isContiguous(type, values))
+        return algorithmKernelsFor(type).minmax(values.data(), values.size(), min, max);
+    return AlgorithmStridedKernelTable[std::size_t(type)].minmax(static_cast<const char*>(values.data()), values.size(), values.stride(), min, max);
+}
+
+void sum(const AlgorithmType type, const Containers::StridedArrayView1D<const void>& values, void* const sum) {
+    if(isContiguous(type, values))
+        return algorithmKernelsFor(type).sum(values.data(), values.size(), sum);
+    return AlgorithmStridedKernelTable[std::size_t(type)].sum(static_cast<const char*>(values.data()), values.size(), values.stride(), sum);
+}
+
+}
+
 }}
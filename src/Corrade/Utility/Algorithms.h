@@ -26,11 +26,16 @@
 */
 
 /** @file
- * @brief Function @ref Corrade::Utility::copy()
+ * @brief Function @ref Corrade::Utility::copy(), @ref Corrade::Utility::fill(), @ref Corrade::Utility::transform(), @ref Corrade::Utility::parallelFor(), @ref Corrade::Utility::parallelReduce(), @ref Corrade::Utility::parallelTransform(), @ref Corrade::Utility::gather(), @ref Corrade::Utility::scatter(), @ref Corrade::Utility::applyPermutation(), @ref Corrade::Utility::castInto(), @ref Corrade::Utility::unpackInto(), @ref Corrade::Utility::sort(), @ref Corrade::Utility::sortPermutation(), @ref Corrade::Utility::radixSort(), @ref Corrade::Utility::radixSortPermutation(), @ref Corrade::Utility::lowerBound(), @ref Corrade::Utility::upperBound(), @ref Corrade::Utility::interpolationSearch(), @ref Corrade::Utility::unique(), @ref Corrade::Utility::find(), @ref Corrade::Utility::count(), @ref Corrade::Utility::equal(), @ref Corrade::Utility::mismatch(), @ref Corrade::Utility::min(), @ref Corrade::Utility::max(), @ref Corrade::Utility::minmax(), @ref Corrade::Utility::sum(), struct @ref Corrade::Utility::PermutationViews, typedef @ref Corrade::Utility::ParallelExecutor
  * @m_since_latest
  */
 
+#include <cstdint>
+#include <utility>
+
+#include "Corrade/Containers/Array.h"
 #include "Corrade/Containers/StridedArrayView.h"
+#include "Corrade/Utility/Macros.h"
 #include "Corrade/Utility/visibility.h"
 
 namespace Corrade { namespace Utility {
@@ -177,6 +182,582 @@ template<class From, class To, class FromView = decltype(Implementation::strided
     copy(srcV, dstV);
 }
 
+/**
+@brief Copy a static array view to another
+@m_since_latest
+
+Copies the elements one by one, the size is checked at compile time. Unlike
+the other overloads the function is @cpp constexpr @ce on C++14 and newer and
+can be thus used to calculate lookup tables at compile time, see
+@ref Containers-StaticArray-constexpr for an example. Expects that both views
+have the same underlying type and @p dst is not @cpp const @ce.
+@see @ref fill(), @ref transform()
+*/
+template<std::size_t size, class T, class U> CORRADE_CONSTEXPR14 void copy(const Containers::StaticArrayView<size, T> src, const Containers::StaticArrayView<size, U> dst) {
+    static_assert(std::is_same<typename std::remove_const<T>::type, U>::value, "can't copy between views of different types");
+    for(std::size_t i = 0; i != size; ++i)
+        dst[i] = src[i];
+}
+
+/**
+@brief Fill a static array view with a value
+@m_since_latest
+
+Assigns @p value to all elements of @p dst. The function is
+@cpp constexpr @ce on C++14 and newer, see
+@ref Containers-StaticArray-constexpr for an example.
+@see @ref copy(const Containers::StaticArrayView<size, T>, const Containers::StaticArrayView<size, U>),
+    @ref transform()
+*/
+template<std::size_t size, class T, class U> CORRADE_CONSTEXPR14 void fill(const Containers::StaticArrayView<size, T> dst, const U& value) {
+    for(std::size_t i = 0; i != size; ++i)
+        dst[i] = value;
+}
+
+/**
+@brief Transform a static array view into another
+@m_since_latest
+
+Assigns the result of calling @p function on each element of @p src to the
+corresponding element of @p dst, the size is checked at compile time. The
+function is @cpp constexpr @ce on C++14 and newer if @p function is a
+@cpp constexpr @ce function or, on C++17, a lambda, see
+@ref Containers-StaticArray-constexpr for an example. The @p src and @p dst
+are allowed to be the same view.
+@see @ref copy(const Containers::StaticArrayView<size, T>, const Containers::StaticArrayView<size, U>),
+    @ref fill(), @ref parallelTransform()
+*/
+template<std::size_t size, class From, class To, class F> CORRADE_CONSTEXPR14 void transform(const Containers::StaticArrayView<size, From> src, const Containers::StaticArrayView<size, To> dst, F function) {
+    for(std::size_t i = 0; i != size; ++i)
+        dst[i] = function(src[i]);
+}
+
+/**
+@brief Parallel executor
+@m_since_latest
+
+Used by @ref copy(const Containers::StridedArrayView<dimensions, const T>&, const Containers::StridedArrayView<dimensions, T>&, ParallelExecutor, void*, std::size_t, std::size_t).
+The function is expected to call @p job with @p jobState and each index in
+range @f$ [0, count) @f$ exactly once, in any order and from any thread, and
+return only after all calls finished. The @p executorState is passed through
+from the caller and can be used to reference for example a thread pool.
+Example implementation using @ref std::thread, spawning a new thread for
+every job:
+
+@snippet Utility.cpp ParallelExecutor
+*/
+typedef void(*ParallelExecutor)(void* executorState, std::size_t count, void(*job)(void*, std::size_t), void* jobState);
+
+/**
+@brief Copy a strided array view to another in parallel
+@m_since_latest
+
+Splits the first dimension of the views into at most @p jobCount
+approximately equally sized parts and calls
+@ref copy(const Containers::StridedArrayView<dimensions, const T>&, const Containers::StridedArrayView<dimensions, T>&)
+on each of them through @p executor. If the total copied size is less than
+@p threshold bytes, the first dimension has less than two items or
+@p jobCount is less than @cpp 2 @ce, the copy is done directly on the calling
+thread instead. Expects that both arrays have the same size and @p T is a
+trivially copyable type.
+
+As the copy is memory-bandwidth bound, it makes sense to parallelize only
+larger copies --- the default @p threshold of 4 MB is chosen so the cost of
+waking up the jobs is negligible compared to the copy itself.
+*/
+template<unsigned dimensions, class T> void copy(const Containers::StridedArrayView<dimensions, const T>& src, const Containers::StridedArrayView<dimensions, T>& dst, ParallelExecutor executor, void* executorState, std::size_t jobCount, std::size_t threshold = 4*1024*1024);
+
+/**
+@brief Copy a view to another in parallel
+@m_since_latest
+
+Converts @p src and @p dst to a common @ref Containers::StridedArrayView type
+and then calls @ref copy(const Containers::StridedArrayView<dimensions, const T>&, const Containers::StridedArrayView<dimensions, T>&, ParallelExecutor, void*, std::size_t, std::size_t).
+The same requirements as with @ref copy(From&&, To&&) apply.
+*/
+template<class From, class To, class FromView = decltype(Implementation::stridedArrayViewTypeFor(std::declval<From&&>())), class ToView = decltype(Implementation::stridedArrayViewTypeFor(std::declval<To&&>()))> void copy(From&& src, To&& dst, ParallelExecutor executor, void* executorState, std::size_t jobCount, std::size_t threshold = 4*1024*1024) {
+    static_assert(std::is_same<typename std::remove_const<typename FromView::Type>::type, typename std::remove_const<typename ToView::Type>::type>::value, "can't copy between views of different types");
+    static_assert(!std::is_const<typename ToView::Type>::value, "can't copy to a const view");
+    static_assert(unsigned(Implementation::StridedArrayViewType<FromView>::Dimensions) ==
+        unsigned(Implementation::StridedArrayViewType<ToView>::Dimensions),
+        "can't copy between views of different dimensions");
+    typedef typename std::remove_const<typename FromView::Type>::type Type;
+    constexpr unsigned Dimensions = Implementation::StridedArrayViewType<FromView>::Dimensions;
+    const Containers::StridedArrayView<Dimensions, const Type> srcV{src};
+    const Containers::StridedArrayView<Dimensions, Type> dstV{dst};
+    copy(srcV, dstV, executor, executorState, jobCount, threshold);
+}
+
+/**
+@brief Call a function on parts of a strided array view in parallel
+@m_since_latest
+
+Splits the first dimension of @p view into at most @p jobCount approximately
+equally sized parts using @ref Containers::StridedArrayView::slice() and calls
+@cpp function(part) @ce with each of them through @p executor. The parts are
+disjoint and together cover the whole view. If the first dimension has less
+than two items or @p jobCount is less than @cpp 2 @ce, @p function is called
+with the whole view directly on the calling thread instead. See
+@ref ParallelExecutor for more information about the executor.
+
+@snippet Utility.cpp parallelFor
+
+As the view is split only along the first dimension, the function gets
+complete rows of a 2D image, for example, and can process them with the
+same code as in the serial case.
+@see @ref parallelReduce(), @ref parallelTransform(),
+    @ref ThreadPool::parallelFor()
+*/
+template<unsigned dimensions, class T, class F> void parallelFor(const Containers::StridedArrayView<dimensions, T>& view, F&& function, ParallelExecutor executor, void* executorState, std::size_t jobCount);
+
+/**
+@brief Reduce a strided array view in parallel
+@m_since_latest
+
+Splits @p view the same way as @ref parallelFor(), calls @cpp function(part) @ce
+with each part through @p executor and then folds the per-part results on
+the calling thread as @cpp combine(combine(initial, first), second) @ce etc.,
+in the order of the parts. The result thus doesn't depend on the order in
+which the executor ran the jobs, only on @p jobCount. @p R is expected to be
+default-constructible.
+
+@snippet Utility.cpp parallelReduce
+*/
+template<unsigned dimensions, class T, class R, class F, class C> R parallelReduce(const Containers::StridedArrayView<dimensions, T>& view, R initial, F&& function, C&& combine, ParallelExecutor executor, void* executorState, std::size_t jobCount);
+
+/**
+@brief Transform a strided array view into another in parallel
+@m_since_latest
+
+Sets @cpp dst[i] = function(src[i]) @ce for each item, with @p i being a
+multi-dimensional index. Splits the views the same way as
+@ref parallelFor(). Innermost dimensions that are contiguous in both views
+are processed in a tight loop on plain pointers which the compiler can
+vectorize. Expects that both views have the same size.
+@see @ref castInto()
+*/
+template<unsigned dimensions, class From, class To, class F> void parallelTransform(const Containers::StridedArrayView<dimensions, From>& src, const Containers::StridedArrayView<dimensions, To>& dst, F&& function, ParallelExecutor executor, void* executorState, std::size_t jobCount);
+
+/**
+@brief Gather items from a strided array view by an index array
+@m_since_latest
+
+Sets @cpp dst[i] = src[indices[i]] @ce for each item in @p indices. Expects
+that @p indices and @p dst have the same size and all indices are in bounds
+for @p src. @p I is expected to be an integral type.
+@see @ref scatter()
+*/
+template<class T, class I> void gather(const Containers::StridedArrayView1D<const T>& src, const Containers::StridedArrayView1D<const I>& indices, const Containers::StridedArrayView1D<T>& dst);
+
+/**
+@brief Scatter items into a strided array view by an index array
+@m_since_latest
+
+Sets @cpp dst[indices[i]] = src[i] @ce for each item in @p indices. Expects
+that @p src and @p indices have the same size and all indices are in bounds
+for @p dst. If @p indices contain duplicates, the last item wins.
+@see @ref gather()
+*/
+template<class T, class I> void scatter(const Containers::StridedArrayView1D<const T>& src, const Containers::StridedArrayView1D<const I>& indices, const Containers::StridedArrayView1D<T>& dst);
+
+/**
+@brief Source and destination views for @ref applyPermutation()
+@m_since_latest
+
+A type-erased pair of views, with the second dimension being the bytes of each
+item, same as with @ref copy(const Containers::StridedArrayView<dimensions, const char>&, const Containers::StridedArrayView<dimensions, char>&).
+Usually constructed implicitly from a pair of typed one-dimensional views.
+*/
+struct PermutationViews {
+    /**
+     * @brief Construct from type-erased views
+     *
+     * Expects that the second dimension of both views is contiguous. The
+     * remaining requirements are checked in @ref applyPermutation().
+     */
+    /*implicit*/ PermutationViews(const Containers::StridedArrayView2D<const char>& src, const Containers::StridedArrayView2D<char>& dst) noexcept: src{src}, dst{dst} {}
+
+    /**
+     * @brief Construct from typed views
+     *
+     * Equivalent to calling @ref PermutationViews(const Containers::StridedArrayView2D<const char>&, const Containers::StridedArrayView2D<char>&)
+     * with the views passed through @ref Containers::arrayCast().
+     */
+    template<class T> /*implicit*/ PermutationViews(const Containers::StridedArrayView1D<const T>& src, const Containers::StridedArrayView1D<T>& dst) noexcept: src{Containers::arrayCast<2, const char>(src)}, dst{Containers::arrayCast<2, char>(dst)} {}
+
+    /** @overload */
+    template<class T> /*implicit*/ PermutationViews(const Containers::StridedArrayView1D<T>& src, const Containers::StridedArrayView1D<T>& dst) noexcept: src{Containers::arrayCast<2, const char>(src)}, dst{Containers::arrayCast<2, char>(dst)} {}
+
+    Containers::StridedArrayView2D<const char> src; /**< Source view */
+    Containers::StridedArrayView2D<char> dst;       /**< Destination view */
+};
+
+namespace Implementation {
+    CORRADE_UTILITY_EXPORT void applyPermutation(const Containers::StridedArrayView2D<const char>& permutation, Containers::ArrayView<const PermutationViews> views, ParallelExecutor executor, void* executorState, std::size_t jobCount);
+}
+
+/**
+@brief Reorder multiple strided array views by a common permutation
+@m_since_latest
+
+Sets @cpp dst[i] = src[permutation[i]] @ce for each item of each pair of views,
+which is what @ref gather() does for a single view. Useful for example to
+reorder all attributes of a mesh by a permutation coming from
+@ref sortPermutation() or @ref radixSortPermutation():
+
+@snippet Utility.cpp applyPermutation
+
+Instead of going through all items of the first view, then all items of the
+second view and so on, the permutation is processed in blocks of a few
+thousand items. Each block of indices is read just once and then applied to
+all views, so the indices and the destination items stay in the cache while
+the source items are fetched. Items of common sizes are copied with a
+fixed-size @ref std::memcpy(), which the compiler turns into a single load and
+store.
+
+Expects that the destination views have the same size as @p permutation, item
+sizes of source and destination views in each pair match and all indices are
+in bounds for all source views. The source and destination views are not
+allowed to overlap. @p I is expected to be an integral type.
+@see @ref copy()
+*/
+template<class I> void applyPermutation(const Containers::StridedArrayView1D<I>& permutation, Containers::ArrayView<const PermutationViews> views) {
+    static_assert(std::is_integral<I>::value, "indices have to be integral");
+    Implementation::applyPermutation(Containers::arrayCast<2, const char>(permutation), views, nullptr, nullptr, 1);
+}
+
+/**
+@overload
+@m_since_latest
+*/
+template<class I> void applyPermutation(const Containers::StridedArrayView1D<I>& permutation, std::initializer_list<PermutationViews> views) {
+    applyPermutation(permutation, Containers::arrayView(views));
+}
+
+/**
+@brief Reorder multiple strided array views by a common permutation in parallel
+@m_since_latest
+
+Splits the blocks of the permutation into at most @p jobCount approximately
+equally sized parts and processes them through @p executor. If there's just a
+single block or @p jobCount is less than @cpp 2 @ce, the permutation is
+applied directly on the calling thread instead. See
+@ref applyPermutation(const Containers::StridedArrayView1D<I>&, Containers::ArrayView<const PermutationViews>)
+for more information.
+*/
+template<class I> void applyPermutation(const Containers::StridedArrayView1D<I>& permutation, Containers::ArrayView<const PermutationViews> views, ParallelExecutor executor, void* executorState, std::size_t jobCount) {
+    static_assert(std::is_integral<I>::value, "indices have to be integral");
+    Implementation::applyPermutation(Containers::arrayCast<2, const char>(permutation), views, executor, executorState, jobCount);
+}
+
+/**
+@overload
+@m_since_latest
+*/
+template<class I> void applyPermutation(const Containers::StridedArrayView1D<I>& permutation, std::initializer_list<PermutationViews> views, ParallelExecutor executor, void* executorState, std::size_t jobCount) {
+    applyPermutation(permutation, Containers::arrayView(views), executor, executorState, jobCount);
+}
+
+/**
+@brief Copy a strided array view to another with a type conversion
+@m_since_latest
+
+Sets @cpp dst[i] = To(src[i]) @ce for each item. Useful for example for
+widening 16-bit indices to 32-bit. For contiguous views the operation is done
+in a tight loop on plain pointers which the compiler can vectorize. Expects
+that both views have the same size.
+@see @ref unpackInto(), @ref copy()
+*/
+template<class From, class To> void castInto(const Containers::StridedArrayView1D<const From>& src, const Containers::StridedArrayView1D<To>& dst);
+
+/**
+@brief Copy a strided array view of unsigned integers to floating-point with normalization
+@m_since_latest
+
+Sets @cpp dst[i] = To(src[i])/To(max) @ce for each item, where @cpp max @ce is
+the largest representable value of @p From, converting for example 8-bit
+color channels into the @f$ [0, 1] @f$ range. @p From is expected to be an
+unsigned integral type and @p To a floating-point type. For contiguous views
+the operation is done in a tight loop on plain pointers which the compiler can
+vectorize. Expects that both views have the same size.
+@see @ref castInto()
+*/
+template<class From, class To> void unpackInto(const Containers::StridedArrayView1D<const From>& src, const Containers::StridedArrayView1D<To>& dst);
+
+namespace Implementation {
+
+struct Less {
+    template<class T> bool operator()(const T& a, const T& b) const { return a < b; }
+};
+
+struct Equal {
+    template<class T> bool operator()(const T& a, const T& b) const { return a == b; }
+};
+
+}
+
+/**
+@brief Sort a strided array view
+@m_since_latest
+
+Sorts the items in-place using an introsort --- a quicksort with a
+median-of-three pivot, falling back to a heapsort if the recursion gets too
+deep and to an insertion sort for small ranges. The sort is not stable.
+@p less is expected to be a strict weak ordering. Works directly on strided
+data, avoiding a copy to a temporary contiguous array, and if the view is
+contiguous, operates on plain pointers instead.
+@see @ref sortPermutation(), @ref radixSort()
+*/
+template<class T, class Compare = Implementation::Less> void sort(const Containers::StridedArrayView1D<T>& values, Compare less = Compare{});
+
+/**
+@brief Calculate a permutation that sorts a strided array view
+@m_since_latest
+
+Fills @p permutation with indices into @p keys in an order in which the keys
+are sorted, leaving @p keys untouched. Useful for sorting interleaved data
+by one of their fields and then reordering the rest with @ref gather(). Uses
+the same algorithm as @ref sort(), thus equal keys end up in an unspecified
+order. Expects that both views have the same size. @p I is expected to be an
+integral type. Example usage, with integer keys sorted using
+@ref radixSortPermutation() instead:
+
+@snippet Utility.cpp sortPermutation
+
+@see @ref radixSortPermutation()
+*/
+template<class T, class I, class Compare = Implementation::Less> void sortPermutation(const Containers::StridedArrayView1D<const T>& keys, const Containers::StridedArrayView1D<I>& permutation, Compare less = Compare{});
+
+/**
+@brief Radix sort a strided array view of integers
+@m_since_latest
+
+Sorts integer keys in-place in ascending order using a least-significant
+digit radix sort with 8-bit digits. Digits that are the same for all keys are
+skipped, so for example sorting 32-bit values that all fit into 16 bits needs
+just two passes. Allocates a temporary array of the same size, if the view
+isn't contiguous, a second one is allocated to operate on a contiguous copy.
+Small views are sorted with @ref sort() instead. @p T is expected to be an
+integral type.
+@see @ref radixSortPermutation()
+*/
+template<class T> void radixSort(const Containers::StridedArrayView1D<T>& keys);
+
+/**
+@brief Calculate a permutation that sorts a strided array view of integers
+@m_since_latest
+
+Like @ref sortPermutation(), but using the same algorithm as
+@ref radixSort(). The sort is stable, so equal keys are kept in their
+original order. Expects that both views have the same size. @p T and @p I are
+expected to be integral types.
+*/
+template<class T, class I> void radixSortPermutation(const Containers::StridedArrayView1D<const T>& keys, const Containers::StridedArrayView1D<I>& permutation);
+
+/**
+@brief Find the first item not less than a value in a sorted strided array view
+@m_since_latest
+
+Performs a binary search, returning index of the first item for which
+@cpp less(item, value) @ce is @cpp false @ce, or size of the view if there's no
+such item. The view is expected to be sorted with respect to @p less.
+@see @ref upperBound(), @ref interpolationSearch()
+*/
+template<class T, class Compare = Implementation::Less> std::size_t lowerBound(const Containers::StridedArrayView1D<const T>& values, const T& value, Compare less = Compare{});
+
+/**
+@brief Find the first item greater than a value in a sorted strided array view
+@m_since_latest
+
+Performs a binary search, returning index of the first item for which
+@cpp less(value, item) @ce is @cpp true @ce, or size of the view if there's no
+such item. The view is expected to be sorted with respect to @p less.
+@see @ref lowerBound()
+*/
+template<class T, class Compare = Implementation::Less> std::size_t upperBound(const Containers::StridedArrayView1D<const T>& values, const T& value, Compare less = Compare{});
+
+/**
+@brief Find the first item not less than a value in a sorted strided array view using interpolation
+@m_since_latest
+
+Returns the same result as @ref lowerBound(), but instead of halving the
+searched range it estimates the position from the values at its ends. For
+uniformly distributed keys this needs @f$ \mathcal{O}(\log \log n) @f$ steps
+instead of @f$ \mathcal{O}(\log n) @f$. To avoid degenerating to a linear
+search on skewed distributions, it switches to a binary search after a
+bounded number of steps. The view is expected to be sorted in ascending order.
+@p T is expected to be an arithmetic type.
+*/
+template<class T> std::size_t interpolationSearch(const Containers::StridedArrayView1D<const T>& values, T value);
+
+/**
+@brief Remove consecutive duplicates from a strided array view
+@m_since_latest
+
+Moves the first item of each group of consecutive items that compare equal
+with @p equal to the front of the view, preserving their order, and returns
+their count. Items past the returned count are left in a valid but
+unspecified state. If the view is sorted, the result contains each value just
+once.
+*/
+template<class T, class Equal = Implementation::Equal> std::size_t unique(const Containers::StridedArrayView1D<T>& values, Equal equal = Equal{});
+
+namespace Implementation {
+
+/* Element types that have vectorized search and reduction kernels */
+enum class AlgorithmType: std::uint8_t {
+    Int8, UnsignedInt8, Int16, UnsignedInt16, Int32, UnsignedInt32,
+    Int64, UnsignedInt64, Float, Double
+};
+
+template<AlgorithmType type_, class Sum> struct AlgorithmTypeTraits {
+    static constexpr AlgorithmType type() { return type_; }
+    typedef Sum SumType;
+};
+
+template<class> struct AlgorithmTypeFor;
+template<> struct AlgorithmTypeFor<char>: AlgorithmTypeTraits<(char(-1) < 0) ? AlgorithmType::Int8 : AlgorithmType::UnsignedInt8, typename std::conditional<(char(-1) < 0), std::int64_t, std::uint64_t>::type> {};
+template<> struct AlgorithmTypeFor<std::int8_t>: AlgorithmTypeTraits<AlgorithmType::Int8, std::int64_t> {};
+template<> struct AlgorithmTypeFor<std::uint8_t>: AlgorithmTypeTraits<AlgorithmType::UnsignedInt8, std::uint64_t> {};
+template<> struct AlgorithmTypeFor<std::int16_t>: AlgorithmTypeTraits<AlgorithmType::Int16, std::int64_t> {};
+template<> struct AlgorithmTypeFor<std::uint16_t>: AlgorithmTypeTraits<AlgorithmType::UnsignedInt16, std::uint64_t> {};
+template<> struct AlgorithmTypeFor<std::int32_t>: AlgorithmTypeTraits<AlgorithmType::Int32, std::int64_t> {};
+template<> struct AlgorithmTypeFor<std::uint32_t>: AlgorithmTypeTraits<AlgorithmType::UnsignedInt32, std::uint64_t> {};
+template<> struct AlgorithmTypeFor<std::int64_t>: AlgorithmTypeTraits<AlgorithmType::Int64, std::int64_t> {};
+template<> struct AlgorithmTypeFor<std::uint64_t>: AlgorithmTypeTraits<AlgorithmType::UnsignedInt64, std::uint64_t> {};
+template<> struct AlgorithmTypeFor<float>: AlgorithmTypeTraits<AlgorithmType::Float, float> {};
+template<> struct AlgorithmTypeFor<double>: AlgorithmTypeTraits<AlgorithmType::Double, double> {};
+
+/* Type-erased entry points, picking a vectorized kernel for contiguous views
+   and falling back to a scalar loop otherwise */
+CORRADE_UTILITY_EXPORT std::size_t find(AlgorithmType type, const Containers::StridedArrayView1D<const void>& values, const void* value);
+CORRADE_UTILITY_EXPORT std::size_t count(AlgorithmType type, const Containers::StridedArrayView1D<const void>& values, const void* value);
+CORRADE_UTILITY_EXPORT std::size_t mismatch(AlgorithmType type, const Containers::StridedArrayView1D<const void>& a, const Containers::StridedArrayView1D<const void>& b);
+CORRADE_UTILITY_EXPORT void minmax(AlgorithmType type, const Containers::StridedArrayView1D<const void>& values, void* min, void* max);
+CORRADE_UTILITY_EXPORT void sum(AlgorithmType type, const Containers::StridedArrayView1D<const void>& values, void* sum);
+
+}
+
+/**
+@brief Find the first occurrence of a value in a strided array view
+@m_since_latest
+
+Returns index of the first item equal to @p value, or size of the view if
+there's no such item. Unlike @ref lowerBound(), the view doesn't need to be
+sorted.
+
+@p T is expected to be an 8-, 16-, 32- or 64-bit integer type, @cpp float @ce
+or @cpp double @ce. If the view is contiguous, the search is done using SIMD
+instructions picked at runtime via @ref Cpu::dispatch(), otherwise a scalar
+loop is used. Floating-point values are compared with @cpp == @ce, so a NaN is
+never found and @cpp -0.0f @ce is equal to @cpp 0.0f @ce.
+@see @ref count(), @ref mismatch()
+*/
+template<class T> inline std::size_t find(const Containers::StridedArrayView1D<const T>& values, const T value) {
+    return Implementation::find(Implementation::AlgorithmTypeFor<T>::type(), values, &value);
+}
+
+/**
+@brief Count occurrences of a value in a strided array view
+@m_since_latest
+
+Returns count of items equal to @p value. Supported types and the way the
+operation is vectorized is the same as for @ref find().
+*/
+template<class T> inline std::size_t count(const Containers::StridedArrayView1D<const T>& values, const T value) {
+    return Implementation::count(Implementation::AlgorithmTypeFor<T>::type(), values, &value);
+}
+
+/**
+@brief Find the first mismatch between two strided array views
+@m_since_latest
+
+Returns index of the first item that's different in @p a and @p b. If the
+views have a different size and one is a prefix of the other, returns the
+smaller size. If the views are equal, returns their size. Supported types and
+the way the operation is vectorized is the same as for @ref find(), the views
+are processed with SIMD instructions if both are contiguous.
+@see @ref equal()
+*/
+template<class T> inline std::size_t mismatch(const Containers::StridedArrayView1D<const T>& a, const Containers::StridedArrayView1D<const T>& b) {
+    return Implementation::mismatch(Implementation::AlgorithmTypeFor<T>::type(), a, b);
+}
+
+/**
+@brief Whether two strided array views are equal
+@m_since_latest
+
+Returns @cpp true @ce if both views have the same size and all items compare
+equal, @cpp false @ce otherwise. Implemented using @ref mismatch().
+*/
+template<class T> inline bool equal(const Containers::StridedArrayView1D<const T>& a, const Containers::StridedArrayView1D<const T>& b) {
+    return a.size() == b.size() && Implementation::mismatch(Implementation::AlgorithmTypeFor<T>::type(), a, b) == a.size();
+}
+
+/**
+@brief Minimum and maximum of a strided array view
+@m_since_latest
+
+Expects that the view is not empty. Supported types and the way the operation
+is vectorized is the same as for @ref find(), except that 64-bit integer types
+always use a scalar loop as there's no suitable instruction before AVX-512. If
+there's a NaN in a floating-point view, the result is unspecified.
+@see @ref min(), @ref max()
+*/
+template<class T> std::pair<T, T> minmax(const Containers::StridedArrayView1D<const T>& values) {
+    CORRADE_ASSERT(values.size(),
+        "Utility::minmax(): expected a non-empty view", {});
+    std::pair<T, T> out;
+    Implementation::minmax(Implementation::AlgorithmTypeFor<T>::type(), values, &out.first, &out.second);
+    return out;
+}
+
+/**
+@brief Minimum of a strided array view
+@m_since_latest
+
+Expects that the view is not empty. See @ref minmax() for more information.
+*/
+template<class T> T min(const Containers::StridedArrayView1D<const T>& values) {
+    CORRADE_ASSERT(values.size(),
+        "Utility::min(): expected a non-empty view", {});
+    T min, max;
+    Implementation::minmax(Implementation::AlgorithmTypeFor<T>::type(), values, &min, &max);
+    return min;
+}
+
+/**
+@brief Maximum of a strided array view
+@m_since_latest
+
+Expects that the view is not empty. See @ref minmax() for more information.
+*/
+template<class T> T max(const Containers::StridedArrayView1D<const T>& values) {
+    CORRADE_ASSERT(values.size(),
+        "Utility::max(): expected a non-empty view", {});
+    T min, max;
+    Implementation::minmax(Implementation::AlgorithmTypeFor<T>::type(), values, &min, &max);
+    return max;
+}
+
+/**
+@brief Sum of a strided array view
+@m_since_latest
+
+Integer types are summed into a 64-bit signed or unsigned integer, depending
+on signedness of @p T, wrapping around on overflow. Floating-point types are
+summed into the same type. Supported types and the way the operation is
+vectorized is the same as for @ref find(). As the vectorized variant
+accumulates into several partial sums, the result for floating-point types may
+differ from a sequential summation in the least significant bits. Returns
+@cpp 0 @ce for an empty view.
+*/
+template<class T> typename Implementation::AlgorithmTypeFor<T>::SumType sum(const Containers::StridedArrayView1D<const T>& values) {
+    typename Implementation::AlgorithmTypeFor<T>::SumType out;
+    Implementation::sum(Implementation::AlgorithmTypeFor<T>::type(), values, &out);
+    return out;
+}
+
 template<unsigned dimensions> void copy(const Containers::StridedArrayView<dimensions, const char>& src, const Containers::StridedArrayView<dimensions, char>& dst) {
     CORRADE_ASSERT(src.size() == dst.size(),
         "Utility::Algorithms::copy(): sizes" << src.size() << "and" << dst.size() << "don't match", );
@@ -185,6 +766,584 @@ template<unsigned dimensions> void copy(const Containers::StridedArrayView<dimen
         copy(src[i], dst[i]);
 }
 
+namespace Implementation {
+
+template<unsigned dimensions, class T> struct ParallelCopy {
+    Containers::StridedArrayView<dimensions, const T> src;
+    Containers::StridedArrayView<dimensions, T> dst;
+    std::size_t chunkSize;
+
+    static void job(void* state, const std::size_t i) {
+        const ParallelCopy<dimensions, T>& self = *static_cast<const ParallelCopy<dimensions, T>*>(state);
+        const std::size_t size = Containers::StridedDimensions<dimensions, std::size_t>{self.src.size()}[0];
+        const std::size_t begin = i*self.chunkSize;
+        const std::size_t end = begin + self.chunkSize < size ? begin + self.chunkSize : size;
+        /* We need to pass const& to the copy(), passing temporary instances
+           directly would lead to infinite recursion */
+        const Containers::StridedArrayView<dimensions, const T> src = self.src.slice(begin, end);
+        const Containers::StridedArrayView<dimensions, T> dst = self.dst.slice(begin, end);
+        copy(src, dst);
+    }
+};
+
+}
+
+template<unsigned dimensions, class T> void copy(const Containers::StridedArrayView<dimensions, const T>& src, const Containers::StridedArrayView<dimensions, T>& dst, ParallelExecutor executor, void* executorState, std::size_t jobCount, std::size_t threshold) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Utility::Algorithms::copy(): sizes" << src.size() << "and" << dst.size() << "don't match", );
+
+    /* Dimensions of a 1D view are a plain std::size_t, wrap them */
+    const Containers::StridedDimensions<dimensions, std::size_t> sizes{src.size()};
+    std::size_t byteSize = sizeof(T);
+    for(std::size_t i: sizes) byteSize *= i;
+    const std::size_t size = sizes[0];
+
+    /* Not worth parallelizing, copy directly */
+    if(byteSize < threshold || size < 2 || jobCount < 2) {
+        copy(src, dst);
+        return;
+    }
+
+    if(jobCount > size) jobCount = size;
+    Implementation::ParallelCopy<dimensions, T> state{src, dst, (size + jobCount - 1)/jobCount};
+    executor(executorState, (size + state.chunkSize - 1)/state.chunkSize, Implementation::ParallelCopy<dimensions, T>::job, &state);
+}
+
+template<class T, class I> void gather(const Containers::StridedArrayView1D<const T>& src, const Containers::StridedArrayView1D<const I>& indices, const Containers::StridedArrayView1D<T>& dst) {
+    static_assert(std::is_integral<I>::value, "indices have to be integral");
+    const std::size_t count = indices.size();
+    CORRADE_ASSERT(count == dst.size(),
+        "Utility::gather(): expected index and destination views to have the same size but got" << count << "and" << dst.size(), );
+
+    /* Direct pointer access to speed up debug builds */
+    const std::size_t srcSize = src.size();
+    auto* const srcPtr = static_cast<const char*>(src.data());
+    auto* indexPtr = static_cast<const char*>(indices.data());
+    auto* dstPtr = static_cast<char*>(dst.data());
+    const std::ptrdiff_t srcStride = src.stride();
+    const std::ptrdiff_t indexStride = indices.stride();
+    const std::ptrdiff_t dstStride = dst.stride();
+    for(std::size_t i = 0; i != count; ++i, indexPtr += indexStride, dstPtr += dstStride) {
+        const std::size_t index = *reinterpret_cast<const I*>(indexPtr);
+        CORRADE_ASSERT(index < srcSize,
+            "Utility::gather(): index" << index << "out of bounds for" << srcSize << "elements", );
+        *reinterpret_cast<T*>(dstPtr) = *reinterpret_cast<const T*>(srcPtr + index*srcStride);
+    }
+}
+
+template<class T, class I> void scatter(const Containers::StridedArrayView1D<const T>& src, const Containers::StridedArrayView1D<const I>& indices, const Containers::StridedArrayView1D<T>& dst) {
+    static_assert(std::is_integral<I>::value, "indices have to be integral");
+    const std::size_t count = indices.size();
+    CORRADE_ASSERT(count == src.size(),
+        "Utility::scatter(): expected source and index views to have the same size but got" << src.size() << "and" << count, );
+
+    /* Direct pointer access to speed up debug builds */
+    const std::size_t dstSize = dst.size();
+    auto* srcPtr = static_cast<const char*>(src.data());
+    auto* indexPtr = static_cast<const char*>(indices.data());
+    auto* const dstPtr = static_cast<char*>(dst.data());
+    const std::ptrdiff_t srcStride = src.stride();
+    const std::ptrdiff_t indexStride = indices.stride();
+    const std::ptrdiff_t dstStride = dst.stride();
+    for(std::size_t i = 0; i != count; ++i, srcPtr += srcStride, indexPtr += indexStride) {
+        const std::size_t index = *reinterpret_cast<const I*>(indexPtr);
+        CORRADE_ASSERT(index < dstSize,
+            "Utility::scatter(): index" << index << "out of bounds for" << dstSize << "elements", );
+        *reinterpret_cast<T*>(dstPtr + index*dstStride) = *reinterpret_cast<const T*>(srcPtr);
+    }
+}
+
+namespace Implementation {
+
+template<class From, class To, class Function> void transformInto(const Containers::StridedArrayView1D<const From>& src, const Containers::StridedArrayView1D<To>& dst, Function function) {
+    const std::size_t count = src.size();
+    auto* srcPtr = static_cast<const char*>(src.data());
+    auto* dstPtr = static_cast<char*>(dst.data());
+    const std::ptrdiff_t srcStride = src.stride();
+    const std::ptrdiff_t dstStride = dst.stride();
+
+    /* If both views are contiguous, operate on plain pointers so the compiler
+       has a chance to vectorize the loop */
+    if(srcStride == std::ptrdiff_t(sizeof(From)) && dstStride == std::ptrdiff_t(sizeof(To))) {
+        const From* s = reinterpret_cast<const From*>(srcPtr);
+        To* d = reinterpret_cast<To*>(dstPtr);
+        for(std::size_t i = 0; i != count; ++i)
+            d[i] = function(s[i]);
+    } else for(std::size_t i = 0; i != count; ++i, srcPtr += srcStride, dstPtr += dstStride)
+        *reinterpret_cast<To*>(dstPtr) = function(*reinterpret_cast<const From*>(srcPtr));
+}
+
+template<class From, class To> struct CastInto {
+    To operator()(From value) const { return To(value); }
+};
+
+template<class From, class To> struct UnpackInto {
+    To operator()(From value) const { return To(value)/To(From(~From{})); }
+};
+
+}
+
+template<class From, class To> void castInto(const Containers::StridedArrayView1D<const From>& src, const Containers::StridedArrayView1D<To>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Utility::castInto(): sizes" << src.size() << "and" << dst.size() << "don't match", );
+    Implementation::transformInto(src, dst, Implementation::CastInto<From, To>{});
+}
+
+template<class From, class To> void unpackInto(const Containers::StridedArrayView1D<const From>& src, const Containers::StridedArrayView1D<To>& dst) {
+    static_assert(std::is_integral<From>::value && std::is_unsigned<From>::value,
+        "source has to be an unsigned integral type");
+    static_assert(std::is_floating_point<To>::value,
+        "destination has to be a floating-point type");
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Utility::unpackInto(): sizes" << src.size() << "and" << dst.size() << "don't match", );
+    Implementation::transformInto(src, dst, Implementation::UnpackInto<From, To>{});
+}
+
+
+namespace Implementation {
+
+/* Splits the first dimension into at most jobCount chunks */
+template<unsigned dimensions, class T> struct ParallelChunks {
+    Containers::StridedArrayView<dimensions, T> view;
+    std::size_t chunkSize, chunkCount;
+
+    explicit ParallelChunks(const Containers::StridedArrayView<dimensions, T>& view, std::size_t jobCount): view{view} {
+        const std::size_t size = Containers::StridedDimensions<dimensions, std::size_t>{view.size()}[0];
+        if(jobCount > size) jobCount = size;
+        chunkSize = jobCount ? (size + jobCount - 1)/jobCount : 0;
+        chunkCount = chunkSize ? (size + chunkSize - 1)/chunkSize : 0;
+    }
+
+    Containers::StridedArrayView<dimensions, T> chunk(const std::size_t i) const {
+        const std::size_t size = Containers::StridedDimensions<dimensions, std::size_t>{view.size()}[0];
+        const std::size_t begin = i*chunkSize;
+        return view.slice(begin, begin + chunkSize < size ? begin + chunkSize : size);
+    }
+};
+
+template<unsigned dimensions, class T, class F> struct ParallelFor {
+    ParallelChunks<dimensions, T> chunks;
+    F& function;
+
+    static void job(void* state, const std::size_t i) {
+        const ParallelFor<dimensions, T, F>& self = *static_cast<const ParallelFor<dimensions, T, F>*>(state);
+        self.function(self.chunks.chunk(i));
+    }
+};
+
+template<unsigned dimensions, class T, class R, class F> struct ParallelReduce {
+    ParallelChunks<dimensions, T> chunks;
+    F& function;
+    Containers::ArrayView<R> results;
+
+    static void job(void* state, const std::size_t i) {
+        const ParallelReduce<dimensions, T, R, F>& self = *static_cast<const ParallelReduce<dimensions, T, R, F>*>(state);
+        self.results[i] = self.function(self.chunks.chunk(i));
+    }
+};
+
+/* Recurses into the rows until the last dimension, which is then passed to
+   transformInto() with its contiguous fast path */
+template<unsigned dimensions> struct TransformIntoStrided {
+    template<class From, class To, class F> static void transform(const Containers::StridedArrayView<dimensions, const From>& src, const Containers::StridedArrayView<dimensions, To>& dst, F& function) {
+        for(std::size_t i = 0, max = src.size()[0]; i != max; ++i)
+            TransformIntoStrided<dimensions - 1>::transform(src[i], dst[i], function);
+    }
+};
+
+template<> struct TransformIntoStrided<1> {
+    template<class From, class To, class F> static void transform(const Containers::StridedArrayView1D<const From>& src, const Containers::StridedArrayView1D<To>& dst, F& function) {
+        transformInto<From, To, F&>(src, dst, function);
+    }
+};
+
+template<unsigned dimensions, class From, class To, class F> struct ParallelTransform {
+    ParallelChunks<dimensions, const From> src;
+    Containers::StridedArrayView<dimensions, To> dst;
+    F& function;
+
+    static void job(void* state, const std::size_t i) {
+        const ParallelTransform<dimensions, From, To, F>& self = *static_cast<const ParallelTransform<dimensions, From, To, F>*>(state);
+        const Containers::StridedArrayView<dimensions, const From> src = self.src.chunk(i);
+        const std::size_t begin = i*self.src.chunkSize;
+        const Containers::StridedArrayView<dimensions, To> dst = self.dst.slice(begin, begin + Containers::StridedDimensions<dimensions, std::size_t>{src.size()}[0]);
+        TransformIntoStrided<dimensions>::transform(src, dst, self.function);
+    }
+};
+
+}
+
+template<unsigned dimensions, class T, class F> void parallelFor(const Containers::StridedArrayView<dimensions, T>& view, F&& function, ParallelExecutor executor, void* executorState, std::size_t jobCount) {
+    const Implementation::ParallelChunks<dimensions, T> chunks{view, jobCount};
+
+    /* Not worth parallelizing, call directly */
+    if(chunks.chunkCount < 2) {
+        function(view);
+        return;
+    }
+
+    typedef typename std::remove_reference<F>::type Function;
+    Implementation::ParallelFor<dimensions, T, Function> state{chunks, function};
+    executor(executorState, chunks.chunkCount, Implementation::ParallelFor<dimensions, T, Function>::job, &state);
+}
+
+template<unsigned dimensions, class T, class R, class F, class C> R parallelReduce(const Containers::StridedArrayView<dimensions, T>& view, R initial, F&& function, C&& combine, ParallelExecutor executor, void* executorState, std::size_t jobCount) {
+    const Implementation::ParallelChunks<dimensions, T> chunks{view, jobCount};
+
+    /* Not worth parallelizing, call directly */
+    if(chunks.chunkCount < 2)
+        return combine(std::move(initial), function(view));
+
+    typedef typename std::remove_reference<F>::type Function;
+    Containers::Array<R> results{chunks.chunkCount};
+    Implementation::ParallelReduce<dimensions, T, R, Function> state{chunks, function, results};
+    executor(executorState, chunks.chunkCount, Implementation::ParallelReduce<dimensions, T, R, Function>::job, &state);
+
+    for(R& result: results)
+        initial = combine(std::move(initial), std::move(result));
+    return initial;
+}
+
+template<unsigned dimensions, class From, class To, class F> void parallelTransform(const Containers::StridedArrayView<dimensions, From>& src, const Containers::StridedArrayView<dimensions, To>& dst, F&& function, ParallelExecutor executor, void* executorState, std::size_t jobCount) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Utility::parallelTransform(): sizes" << src.size() << "and" << dst.size() << "don't match", );
+
+    typedef typename std::remove_const<From>::type FromType;
+    typedef typename std::remove_reference<F>::type Function;
+    const Containers::StridedArrayView<dimensions, const FromType> constSrc = src;
+    const Implementation::ParallelChunks<dimensions, const FromType> chunks{constSrc, jobCount};
+
+    /* Not worth parallelizing, transform directly */
+    if(chunks.chunkCount < 2) {
+        Implementation::TransformIntoStrided<dimensions>::transform(constSrc, dst, function);
+        return;
+    }
+
+    Implementation::ParallelTransform<dimensions, FromType, To, Function> state{chunks, dst, function};
+    executor(executorState, chunks.chunkCount, Implementation::ParallelTransform<dimensions, FromType, To, Function>::job, &state);
+}
+
+namespace Implementation {
+
+/* A random-access iterator over a 1D strided view. Contiguous views use a
+   plain pointer instead, making the stride a compile-time constant. */
+template<class T> struct StridedPointer {
+    typedef typename std::conditional<std::is_const<T>::value, const char, char>::type Char;
+
+    Char* data;
+    std::ptrdiff_t stride;
+
+    T& operator*() const { return *reinterpret_cast<T*>(data); }
+    StridedPointer<T> operator+(std::ptrdiff_t i) const { return {data + i*stride, stride}; }
+    StridedPointer<T> operator-(std::ptrdiff_t i) const { return {data - i*stride, stride}; }
+    std::ptrdiff_t operator-(const StridedPointer<T>& other) const { return (data - other.data)/stride; }
+    StridedPointer<T>& operator++() { data += stride; return *this; }
+    StridedPointer<T>& operator--() { data -= stride; return *this; }
+    /* The stride can be negative, so comparing the pointers isn't enough */
+    bool operator<(const StridedPointer<T>& other) const { return *this - other < 0; }
+    bool operator==(const StridedPointer<T>& other) const { return data == other.data; }
+    bool operator!=(const StridedPointer<T>& other) const { return data != other.data; }
+};
+
+/* Calls function with either a plain or a strided pointer to the beginning
+   of the view */
+template<class T, class F> auto withPointer(const Containers::StridedArrayView1D<T>& view, F&& function) -> decltype(function(static_cast<T*>(nullptr))) {
+    if(view.stride() == std::ptrdiff_t(sizeof(T)))
+        return function(static_cast<T*>(view.data()));
+    return function(StridedPointer<T>{static_cast<typename StridedPointer<T>::Char*>(view.data()), view.stride()});
+}
+
+template<class It, class Compare> void insertionSort(const It begin, const It end, Compare& less) {
+    using std::swap;
+    if(begin == end) return;
+    for(It i = begin + 1; i != end; ++i) {
+        for(It j = i; j != begin && less(*j, *(j - 1)); --j)
+            swap(*j, *(j - 1));
+    }
+}
+
+template<class It, class Compare> void siftDown(const It begin, std::ptrdiff_t i, const std::ptrdiff_t count, Compare& less) {
+    using std::swap;
+    for(;;) {
+        std::ptrdiff_t child = 2*i + 1;
+        if(child >= count) break;
+        if(child + 1 < count && less(*(begin + child), *(begin + child + 1)))
+            ++child;
+        if(!less(*(begin + i), *(begin + child))) break;
+        swap(*(begin + i), *(begin + child));
+        i = child;
+    }
+}
+
+template<class It, class Compare> void heapSort(const It begin, const It end, Compare& less) {
+    using std::swap;
+    const std::ptrdiff_t count = end - begin;
+    for(std::ptrdiff_t i = count/2 - 1; i >= 0; --i)
+        siftDown(begin, i, count, less);
+    for(std::ptrdiff_t i = count - 1; i > 0; --i) {
+        swap(*begin, *(begin + i));
+        siftDown(begin, 0, i, less);
+    }
+}
+
+template<class It, class Compare> void introsort(It begin, It end, std::size_t depthLimit, Compare& less) {
+    using std::swap;
+    while(end - begin > 16) {
+        if(!depthLimit--) {
+            heapSort(begin, end, less);
+            return;
+        }
+
+        /* Order the first, middle and last item and put the median to the
+           front. The last item is then not less than the pivot and the pivot
+           itself not greater than anything, so the partitioning loops below
+           don't need bound checks. */
+        const It middle = begin + (end - begin)/2;
+        const It last = end - 1;
+        if(less(*middle, *begin)) swap(*middle, *begin);
+        if(less(*last, *middle)) {
+            swap(*last, *middle);
+            if(less(*middle, *begin)) swap(*middle, *begin);
+        }
+        swap(*begin, *middle);
+
+        It i = begin;
+        It j = end;
+        for(;;) {
+            do ++i; while(less(*i, *begin));
+            do --j; while(less(*begin, *j));
+            if(!(i < j)) break;
+            swap(*i, *j);
+        }
+        swap(*begin, *j);
+
+        /* Recurse into the smaller part, iterate on the larger */
+        if(j - begin < end - j) {
+            introsort(begin, j, depthLimit, less);
+            begin = j + 1;
+        } else {
+            introsort(j + 1, end, depthLimit, less);
+            end = j;
+        }
+    }
+
+    insertionSort(begin, end, less);
+}
+
+template<class Compare> struct IntroSort {
+    Compare& less;
+    std::size_t count;
+
+    template<class It> void operator()(It begin) const {
+        std::size_t depthLimit = 0;
+        for(std::size_t i = count; i; i >>= 1) depthLimit += 2;
+        introsort(begin, begin + count, depthLimit, less);
+    }
+};
+
+template<class T, class Compare> struct PermutationLess {
+    const char* keys;
+    std::ptrdiff_t stride;
+    Compare& less;
+
+    template<class I> bool operator()(I a, I b) const {
+        return less(*reinterpret_cast<const T*>(keys + std::ptrdiff_t(a)*stride), *reinterpret_cast<const T*>(keys + std::ptrdiff_t(b)*stride));
+    }
+};
+
+/* Integer keys converted to unsigned with the sign bit flipped, so they sort
+   correctly as unsigned */
+template<class T> struct RadixKey {
+    typedef typename std::make_unsigned<T>::type Type;
+    enum: Type { Flip = std::is_signed<T>::value ? Type(Type{1} << (sizeof(T)*8 - 1)) : Type{} };
+};
+
+/* Sorts keys and optionally values (if not null) by the keys, returns true if
+   the result ended up in the temporary arrays */
+template<class U, class I> bool radixSortPasses(U* keys, U* keysTemporary, I* values, I* valuesTemporary, const std::size_t count) {
+    std::size_t histogram[sizeof(U)][256]{};
+    for(std::size_t i = 0; i != count; ++i)
+        for(std::size_t digit = 0; digit != sizeof(U); ++digit)
+            ++histogram[digit][(keys[i] >> (digit*8)) & 0xff];
+
+    bool swapped = false;
+    for(std::size_t digit = 0; digit != sizeof(U); ++digit) {
+        std::size_t* const offsets = histogram[digit];
+
+        /* All keys have the same digit, nothing to do */
+        if(offsets[(keys[0] >> (digit*8)) & 0xff] == count) continue;
+
+        std::size_t offset = 0;
+        for(std::size_t i = 0; i != 256; ++i) {
+            const std::size_t digitCount = offsets[i];
+            offsets[i] = offset;
+            offset += digitCount;
+        }
+
+        for(std::size_t i = 0; i != count; ++i) {
+            const std::size_t position = offsets[(keys[i] >> (digit*8)) & 0xff]++;
+            keysTemporary[position] = keys[i];
+            if(values) valuesTemporary[position] = values[i];
+        }
+
+        std::swap(keys, keysTemporary);
+        std::swap(values, valuesTemporary);
+        swapped = !swapped;
+    }
+
+    return swapped;
+}
+
+template<class T> struct InterpolationPosition {
+    /* The computation is done in double to avoid overflows with the
+       differences of large signed values */
+    static std::size_t get(T value, T first, T last, std::size_t count) {
+        return std::size_t((double(value) - double(first))/(double(last) - double(first))*double(count));
+    }
+};
+
+}
+
+template<class T, class Compare> void sort(const Containers::StridedArrayView1D<T>& values, Compare less) {
+    /* All items are the same memory location, nothing to do */
+    if(!values.stride()) return;
+    Implementation::withPointer(values, Implementation::IntroSort<Compare>{less, values.size()});
+}
+
+template<class T, class I, class Compare> void sortPermutation(const Containers::StridedArrayView1D<const T>& keys, const Containers::StridedArrayView1D<I>& permutation, Compare less) {
+    static_assert(std::is_integral<I>::value, "indices have to be integral");
+    CORRADE_ASSERT(keys.size() == permutation.size(),
+        "Utility::sortPermutation(): expected key and permutation views to have the same size but got" << keys.size() << "and" << permutation.size(), );
+
+    I index{};
+    for(I& i: permutation) i = index++;
+    Implementation::PermutationLess<T, Compare> permutationLess{static_cast<const char*>(keys.data()), keys.stride(), less};
+    sort(permutation, permutationLess);
+}
+
+template<class T> void radixSort(const Containers::StridedArrayView1D<T>& keys) {
+    static_assert(std::is_integral<T>::value, "keys have to be integral");
+    typedef typename Implementation::RadixKey<T>::Type U;
+    constexpr U Flip = Implementation::RadixKey<T>::Flip;
+
+    /* For small sizes the histograms are more expensive than the sort */
+    const std::size_t count = keys.size();
+    if(count < 64) {
+        sort(keys);
+        return;
+    }
+
+    /* Operate directly on the data if contiguous, signed and unsigned types
+       are allowed to alias. Otherwise make a contiguous copy. */
+    Containers::Array<U> copy;
+    U* data;
+    if(keys.stride() == std::ptrdiff_t(sizeof(T))) {
+        data = reinterpret_cast<U*>(static_cast<T*>(keys.data()));
+        if(Flip) for(std::size_t i = 0; i != count; ++i) data[i] ^= Flip;
+    } else {
+        copy = Containers::Array<U>{Containers::NoInit, count};
+        std::size_t i = 0;
+        for(const T& key: keys) copy[i++] = U(key) ^ Flip;
+        data = copy;
+    }
+
+    Containers::Array<U> temporary{Containers::NoInit, count};
+    const U* const result = Implementation::radixSortPasses<U, char>(data, temporary, nullptr, nullptr, count) ? temporary.data() : data;
+
+    if(copy || result != data) {
+        std::size_t i = 0;
+        for(T& key: keys) key = T(result[i++] ^ Flip);
+    } else if(Flip) for(std::size_t i = 0; i != count; ++i) data[i] ^= Flip;
+}
+
+template<class T, class I> void radixSortPermutation(const Containers::StridedArrayView1D<const T>& keys, const Containers::StridedArrayView1D<I>& permutation) {
+    static_assert(std::is_integral<T>::value, "keys have to be integral");
+    static_assert(std::is_integral<I>::value, "indices have to be integral");
+    CORRADE_ASSERT(keys.size() == permutation.size(),
+        "Utility::radixSortPermutation(): expected key and permutation views to have the same size but got" << keys.size() << "and" << permutation.size(), );
+    typedef typename Implementation::RadixKey<T>::Type U;
+    constexpr U Flip = Implementation::RadixKey<T>::Flip;
+
+    const std::size_t count = keys.size();
+    if(!count) return;
+
+    Containers::Array<U> sortedKeys{Containers::NoInit, count*2};
+    Containers::Array<I> indices{Containers::NoInit, count*2};
+    for(std::size_t i = 0; i != count; ++i) {
+        sortedKeys[i] = U(keys[i]) ^ Flip;
+        indices[i] = I(i);
+    }
+
+    const I* const result = Implementation::radixSortPasses(sortedKeys.data(), sortedKeys.data() + count, indices.data(), indices.data() + count, count) ? indices.data() + count : indices.data();
+    std::size_t i = 0;
+    for(I& index: permutation) index = result[i++];
+}
+
+template<class T, class Compare> std::size_t lowerBound(const Containers::StridedArrayView1D<const T>& values, const T& value, Compare less) {
+    std::size_t first = 0;
+    std::size_t count = values.size();
+    const char* const data = static_cast<const char*>(values.data());
+    const std::ptrdiff_t stride = values.stride();
+    while(count) {
+        const std::size_t step = count/2;
+        if(less(*reinterpret_cast<const T*>(data + std::ptrdiff_t(first + step)*stride), value)) {
+            first += step + 1;
+            count -= step + 1;
+        } else count = step;
+    }
+    return first;
+}
+
+template<class T, class Compare> std::size_t upperBound(const Containers::StridedArrayView1D<const T>& values, const T& value, Compare less) {
+    std::size_t first = 0;
+    std::size_t count = values.size();
+    const char* const data = static_cast<const char*>(values.data());
+    const std::ptrdiff_t stride = values.stride();
+    while(count) {
+        const std::size_t step = count/2;
+        if(!less(value, *reinterpret_cast<const T*>(data + std::ptrdiff_t(first + step)*stride))) {
+            first += step + 1;
+            count -= step + 1;
+        } else count = step;
+    }
+    return first;
+}
+
+template<class T> std::size_t interpolationSearch(const Containers::StridedArrayView1D<const T>& values, const T value) {
+    static_assert(std::is_arithmetic<T>::value, "values have to be arithmetic");
+
+    /* The result is always in [begin, end], everything before begin is less
+       than the value and everything from end on isn't */
+    std::size_t begin = 0;
+    std::size_t end = values.size();
+    for(std::size_t steps = 0; end - begin > 8 && steps != 32; ++steps) {
+        const T first = values[begin];
+        if(!(first < value)) return begin;
+        const T last = values[end - 1];
+        if(last < value) return end;
+
+        /* Now first < value <= last, so the estimate is in [begin + 1,
+           end - 1] */
+        const std::size_t position = begin + 1 + Implementation::InterpolationPosition<T>::get(value, first, last, end - begin - 2);
+        if(values[position] < value) begin = position + 1;
+        else end = position;
+    }
+
+    return begin + lowerBound(values.slice(begin, end), value);
+}
+
+template<class T, class Equal> std::size_t unique(const Containers::StridedArrayView1D<T>& values, Equal equal) {
+    const std::size_t count = values.size();
+    if(!count) return 0;
+
+    std::size_t out = 0;
+    for(std::size_t i = 1; i != count; ++i) {
+        if(!equal(values[out], values[i]) && ++out != i)
+            values[out] = std::move(values[i]);
+    }
+    return out + 1;
+}
+
 }}
 
 #endif
@@ -27,13 +27,39 @@
 
 namespace Corrade { namespace Utility {
 
+namespace {
+
+/* Payload of a single log entry is limited to LOGGER_ENTRY_MAX_PAYLOAD, which
+   is 4068 bytes on older Android versions, and that includes the priority,
+   tag and the null terminators. Anything longer gets truncated. */
+constexpr std::size_t MaxEntrySize = 4000;
+
+}
+
 AndroidLogStreamBuffer::AndroidLogStreamBuffer(const LogPriority priority, std::string tag): std::stringbuf(std::ios_base::out), _priority(priority), _tag(std::move(tag)) {}
 
 AndroidLogStreamBuffer::~AndroidLogStreamBuffer() = default;
 
 int AndroidLogStreamBuffer::sync() {
-    /* Write the data */
-    __android_log_write(std::int32_t(_priority), _tag.data(), str().data());
+    const std::string data = str();
+
+    /* Put as many whole lines as possible into a single log entry, as each
+       write is a syscall. Only lines longer than the entry limit get split. */
+    std::string entry;
+    std::size_t begin = 0;
+    while(begin < data.size()) {
+        std::size_t end = data.size();
+        if(end - begin > MaxEntrySize) {
+            const std::size_t newline = data.rfind('\n', begin + MaxEntrySize - 1);
+            end = newline != std::string::npos && newline >= begin ?
+                newline + 1 : begin + MaxEntrySize;
+        }
+
+        /* Logcat puts each entry on a new line already */
+        entry.assign(data, begin, end - begin - (data[end - 1] == '\n' ? 1 : 0));
+        __android_log_write(std::int32_t(_priority), _tag.data(), entry.data());
+        begin = end;
+    }
 
     /* Reset internal buffer so the message doesn't get sent more than once */
     str({});
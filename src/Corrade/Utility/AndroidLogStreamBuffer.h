@@ -64,6 +64,20 @@ $ adb logcat *:S my-application
 
 The output stream can be also used with @ref Debug classes --- simply pass the
 @ref std::ostream instance to the constructor.
+
+@section Utility-AndroidLogStreamBuffer-batching Batched writes
+
+Every log write is a syscall, which can get expensive under heavy logging. On
+each flush, all buffered lines are thus coalesced into as few log entries as
+possible, splitting only where a single entry would exceed the size limit of
+about 4 kB. A trailing newline of each entry is dropped, as @cb{.sh} adb logcat @ce
+puts each entry on a new line already.
+
+To take the cost off the threads producing the messages entirely, combine the
+stream with @ref AsyncOutput. The messages are then written from a background
+thread, which coalesces all messages queued meanwhile into a single flush:
+
+@snippet android.cpp AndroidLogStreamBuffer-async
 @partialsupport Available only on @ref CORRADE_TARGET_ANDROID "Android".
 */
 class CORRADE_UTILITY_EXPORT AndroidLogStreamBuffer: public std::stringbuf {
@@ -31,23 +31,25 @@
 #include <algorithm> /* std::max() */
 #endif
 #include <iomanip>
+#include <limits>
 #include <sstream>
+#include <unordered_map>
 
 #include "Corrade/Utility/Assert.h"
 #include "Corrade/Utility/DebugStl.h"
+#include "Corrade/Utility/Parse.h"
 #include "Corrade/Utility/String.h"
 
 /* For Arguments::environment() */
 #if defined(CORRADE_TARGET_UNIX) || defined(CORRADE_TARGET_EMSCRIPTEN)
 #include <cstdio>
-extern char **environ;
+extern "C" char **environ;
 #ifdef CORRADE_TARGET_EMSCRIPTEN
 #include <emscripten.h>
 #endif
 #elif defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
 #include <windows.h>
 #include "Corrade/Utility/Unicode.h"
-using Corrade::Utility::Unicode::widen;
 using Corrade::Utility::Unicode::narrow;
 #endif
 
@@ -61,6 +63,42 @@ namespace {
         BooleanOption
     };
 
+    union ConvertedValue {
+        long long integer;
+        unsigned long long unsignedInteger;
+        double floatingPoint;
+    };
+
+    /* Same rules as ConfigurationValue::fromString() -- leading whitespace,
+       a plus sign and a 0x prefix for hexadecimal values are accepted.
+       Returns whether the whole value was consumed. */
+    template<class T> bool parseValue(Containers::StringView value, T& out, const ConfigurationValueFlags flags, std::true_type) {
+        value = value.trimmedPrefix();
+        if(!value.empty() && value[0] == '+') value = value.suffix(1);
+
+        int base = 10;
+        if(flags & ConfigurationValueFlag::Hex) {
+            base = 16;
+            if(value.size() >= 2 && value[0] == '0' && (value[1] == 'x' || value[1] == 'X'))
+                value = value.suffix(2);
+        } else if(flags & ConfigurationValueFlag::Oct) base = 8;
+
+        const std::size_t size = parseNumber(value, out, base);
+        return size && size == value.size();
+    }
+
+    template<class T> bool parseValue(Containers::StringView value, T& out, ConfigurationValueFlags, std::false_type) {
+        value = value.trimmedPrefix();
+        if(!value.empty() && value[0] == '+') value = value.suffix(1);
+
+        const std::size_t size = parseNumber(value, out);
+        return size && size == value.size();
+    }
+
+    template<class T> bool parseValue(const Containers::StringView value, T& out, const ConfigurationValueFlags flags) {
+        return parseValue(value, out, flags, std::is_integral<T>{});
+    }
+
     inline std::string uppercaseKey(std::string key) {
         for(char& i: key) {
             if(i >= 'a' && i <= 'z')
@@ -71,6 +109,37 @@ namespace {
 
         return key;
     }
+
+    #if (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    /* Snapshot of the process environment, taken on first use and shared by
+       all instances so parse() doesn't need to convert from UTF-16 or call
+       into JavaScript for every option separately. Since C++11 the static
+       initialization is thread-safe. */
+    const std::unordered_map<std::string, std::string>& environmentSnapshot() {
+        static const std::unordered_map<std::string, std::string> snapshot = [] {
+            std::unordered_map<std::string, std::string> out;
+            for(const std::string& variable: Arguments::environment()) {
+                /* Windows has special entries like =C:=C:\ for per-drive
+                   working directories, so the first character is skipped
+                   when looking for the delimiter */
+                const std::size_t delimiter = variable.find('=', 1);
+                if(delimiter == std::string::npos) continue;
+
+                /* On Emscripten the local environment is listed first, so
+                   emplace() keeps it in favor of the one from Node.js */
+                out.emplace(
+                    #ifndef CORRADE_TARGET_WINDOWS
+                    variable.substr(0, delimiter),
+                    #else
+                    String::uppercase(variable.substr(0, delimiter)),
+                    #endif
+                    variable.substr(delimiter + 1));
+            }
+            return out;
+        }();
+        return snapshot;
+    }
+    #endif
 }
 
 struct Arguments::Entry {
@@ -80,9 +149,23 @@ struct Arguments::Entry {
     char shortKey;
     std::string key, help, helpKey, defaultValue;
     #ifndef CORRADE_TARGET_WINDOWS_RT
-    std::string environment;
+    /* Value of the environment variable gets stored here so _values can
+       reference it, except on platforms where it's taken from the shared
+       snapshot */
+    std::string environment, environmentValue;
     #endif
     std::size_t id;
+    ValueType valueType{};
+    ConfigurationValueFlags valueFlags;
+    /* Filled on parse if valueType is not ValueType::String and the value is
+       not empty */
+    ConvertedValue converted;
+};
+
+struct Arguments::Index {
+    std::unordered_map<std::string, std::size_t> keys;
+    /* Short keys are restricted to ASCII alphanumerics */
+    std::size_t shortKeys[128];
 };
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
@@ -163,7 +246,7 @@ Arguments::Arguments(Flags flags): _flags{InternalFlag(std::uint8_t(flags))} {
     setHelp("help", "display this help message and exit");
 }
 
-Arguments::Arguments(Arguments&& other) noexcept: _flags{std::move(other._flags)}, _prefix{std::move(other._prefix)}, _command{std::move(other._command)}, _help{std::move(other._help)}, _entries{std::move(other._entries)}, _values{std::move(other._values)}, _skippedPrefixes{std::move(other._skippedPrefixes)}, _booleans{std::move(other._booleans)} {
+Arguments::Arguments(Arguments&& other) noexcept: _flags{std::move(other._flags)}, _prefix{std::move(other._prefix)}, _command{std::move(other._command)}, _help{std::move(other._help)}, _entries{std::move(other._entries)}, _values{std::move(other._values)}, _skippedPrefixes{std::move(other._skippedPrefixes)}, _booleans{std::move(other._booleans)}, _index{std::move(other._index)} {
     other._flags &= ~InternalFlag::Parsed;
 }
 
@@ -175,6 +258,7 @@ Arguments& Arguments::operator=(Arguments&& other) noexcept {
     std::swap(other._values, _values);
     std::swap(other._skippedPrefixes, _skippedPrefixes);
     std::swap(other._booleans, _booleans);
+    std::swap(other._index, _index);
     std::swap(other._flags, _flags);
 
     return *this;
@@ -207,6 +291,7 @@ Arguments& Arguments::addArgument(std::string key) {
     /* Reset the parsed flag -- it's probably a mistake to add an argument and
        then ask for values without parsing again */
     _flags &= ~InternalFlag::Parsed;
+    _index = nullptr;
 
     std::string helpKey = key;
     _entries.emplace_back(Type::Argument, '\0', std::move(key), std::move(helpKey), std::string(), _values.size());
@@ -227,6 +312,7 @@ Arguments& Arguments::addNamedArgument(char shortKey, std::string key) {
     /* Reset the parsed flag -- it's probably a mistake to add an argument and
        then ask for values without parsing again */
     _flags &= ~InternalFlag::Parsed;
+    _index = nullptr;
 
     std::string helpKey = key;
     _entries.emplace_back(Type::NamedArgument, shortKey, std::move(key), std::move(helpKey), std::string(), _values.size());
@@ -249,6 +335,7 @@ Arguments& Arguments::addOption(char shortKey, std::string key, std::string defa
     /* Reset the parsed flag -- it's probably a mistake to add an option and
        then ask for values without parsing again */
     _flags &= ~InternalFlag::Parsed;
+    _index = nullptr;
 
     std::string helpKey;
     if(_prefix.empty())
@@ -278,6 +365,7 @@ Arguments& Arguments::addBooleanOption(char shortKey, std::string key) {
     /* Reset the parsed flag -- it's probably a mistake to add an option and
        then ask for values without parsing again */
     _flags &= ~InternalFlag::Parsed;
+    _index = nullptr;
 
     /* The prefix addition is here only for --prefix-help, which is the only
        allowed boolean option */
@@ -287,7 +375,7 @@ Arguments& Arguments::addBooleanOption(char shortKey, std::string key) {
     else
         helpKey = key = _prefix + std::move(key);
     _entries.emplace_back(Type::BooleanOption, shortKey, std::move(key), std::move(helpKey), std::string(), _booleans.size());
-    _booleans.push_back(false);
+    _booleans.append(false);
     return *this;
 }
 
@@ -311,6 +399,7 @@ Arguments& Arguments::addFinalOptionalArgument(std::string key, std::string defa
     /* Reset the parsed flag -- it's probably a mistake to add an argument and
        then ask for values without parsing again */
     _flags &= ~InternalFlag::Parsed;
+    _index = nullptr;
 
     _finalOptionalArgument = _entries.size();
     std::string helpKey = key;
@@ -354,6 +443,20 @@ Arguments& Arguments::setFromEnvironment(const std::string& key) {
 }
 #endif
 
+Arguments& Arguments::setValueType(const std::string& key, const ValueType type, const ConfigurationValueFlags flags) {
+    auto found = find(_prefix + key);
+    CORRADE_ASSERT(found != _entries.end(), "Utility::Arguments::setValueType(): key" << key << "doesn't exist", *this);
+    CORRADE_ASSERT(found->type != Type::BooleanOption,
+        "Utility::Arguments::setValueType(): can't set value type of boolean option" << key, *this);
+
+    /* Reset the parsed flag -- the values might not be converted yet */
+    _flags &= ~InternalFlag::Parsed;
+
+    found->valueType = type;
+    found->valueFlags = flags;
+    return *this;
+}
+
 Arguments& Arguments::setCommand(std::string name) {
     _command = std::move(name);
     return *this;
@@ -396,7 +499,7 @@ Arguments& Arguments::setHelp(const std::string& key, std::string help, std::str
 void Arguments::parse(const int argc, const char** const argv) {
     const bool status = tryParse(argc, argv);
 
-    if(_booleans.at(find(_prefix + "help")->id)) {
+    if(_booleans[find(_prefix + "help")->id]) {
         /* LCOV_EXCL_START */
         Debug{Debug::Flag::NoNewlineAtTheEnd} << help();
         std::exit(0);
@@ -420,79 +523,71 @@ bool Arguments::tryParse(const int argc, const char** const argv) {
     if(_command.empty() && argv && argc >= 1) _command = argv[0];
 
     /* Clear previously parsed values */
-    for(auto&& boolean: _booleans) boolean = false;
+    Containers::MutableBitArrayView{_booleans}.resetAll();
     for(const Entry& entry: _entries) {
         if(entry.type == Type::BooleanOption) continue;
 
         CORRADE_INTERNAL_ASSERT(entry.id < _values.size());
-        _values[entry.id] = entry.defaultValue;
+        _values[entry.id] = {entry.defaultValue.data(), entry.defaultValue.size()};
     }
 
+    /* Build the key lookup table, if not already */
+    if(!_index) buildIndex();
+
     /* Get options from environment */
     #ifndef CORRADE_TARGET_WINDOWS_RT
-    for(const Entry& entry: _entries) {
+    #if defined(CORRADE_TARGET_WINDOWS) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    /* Fetched only if there's any option that needs it */
+    const std::unordered_map<std::string, std::string>* env = nullptr;
+    #endif
+    for(Entry& entry: _entries) {
         if(entry.environment.empty()) continue;
 
-        /* UTF-8 handling on sane platforms */
-        #ifndef CORRADE_TARGET_WINDOWS
-        const char* const env = std::getenv(entry.environment.data());
-        #ifdef CORRADE_TARGET_EMSCRIPTEN
-        #ifdef __clang__
-        #pragma GCC diagnostic push
-        #pragma GCC diagnostic ignored "-Wdollar-in-identifier-extension"
-        #endif
-        char* const systemEnv = reinterpret_cast<char*>(EM_ASM_INT({
-            var name = UTF8ToString($0);
-            return typeof process !== 'undefined' && name in process.env ? allocate(intArrayFromString(process.env[name]), 'i8', ALLOC_NORMAL) : 0;
-        }, entry.environment.data()));
-        #ifdef __clang__
-        #pragma GCC diagnostic pop
-        #endif
-        #endif
+        /* Querying a single variable involves a UTF-16 conversion on Windows
+           and a roundtrip to JavaScript on Emscripten, so a snapshot shared
+           by all instances is used there instead */
+        #if defined(CORRADE_TARGET_WINDOWS) || defined(CORRADE_TARGET_EMSCRIPTEN)
+        if(!env) env = &environmentSnapshot();
+        const auto found = env->find(
+            /* Variable names are case-insensitive on Windows */
+            #ifndef CORRADE_TARGET_WINDOWS
+            entry.environment
+            #else
+            String::uppercase(entry.environment)
+            #endif
+        );
+        if(found == env->end()) continue;
 
-        #ifndef CORRADE_TARGET_EMSCRIPTEN
-        if(!env) continue;
-        #else
-        if(!env && !systemEnv) continue;
-        #endif
+        /* The snapshot lives until the end of the program, so _values can
+           reference it directly */
+        const std::string& value = found->second;
 
-        /* Mess with UTF-16 on Windows */
+        /* Elsewhere std::getenv() is just a scan through an in-process array,
+           which is faster than a hash map lookup */
         #else
-        const wchar_t* const wenv = _wgetenv(widen(entry.environment).data());
-        if(!wenv) continue;
-        std::string env{narrow(wenv)};
+        const char* const found = std::getenv(entry.environment.data());
+        if(!found) continue;
+
+        /* Copy the value so _values can reference it even if the environment
+           gets modified later */
+        entry.environmentValue = found;
+        const std::string& value = entry.environmentValue;
         #endif
 
         if(entry.type == Type::BooleanOption) {
             CORRADE_INTERNAL_ASSERT(entry.id < _booleans.size());
-            _booleans[entry.id] = String::uppercase(
-                #ifndef CORRADE_TARGET_EMSCRIPTEN
-                env
-                #else
-                env ? env : systemEnv
-                #endif
-                ) == "ON";
+            _booleans.set(entry.id, String::uppercase(value) == "ON");
         } else {
             CORRADE_INTERNAL_ASSERT(entry.id < _values.size());
-            _values[entry.id] =
-                #ifndef CORRADE_TARGET_EMSCRIPTEN
-                env
-                #else
-                env ? env : systemEnv;
-                #endif
-                ;
+            _values[entry.id] = {value.data(), value.size()};
         }
-
-        #ifdef CORRADE_TARGET_EMSCRIPTEN
-        std::free(systemEnv);
-        #endif
     }
     #endif
 
     std::vector<Entry>::iterator valueFor = _entries.end();
     bool optionsAllowed = true;
     std::vector<Entry>::iterator nextArgument = _entries.begin();
-    std::vector<bool> parsedArguments(_entries.size());
+    Containers::BitArray parsedArguments{_entries.size()};
 
     for(int i = 1; i < argc; ++i) {
         /* Value for given argument */
@@ -500,7 +595,7 @@ bool Arguments::tryParse(const int argc, const char** const argv) {
             CORRADE_INTERNAL_ASSERT(valueFor->type != Type::BooleanOption);
             CORRADE_INTERNAL_ASSERT(valueFor->id < _values.size());
             _values[valueFor->id] = argv[i];
-            parsedArguments[valueFor-_entries.begin()] = true;
+            parsedArguments.set(valueFor-_entries.begin());
             valueFor = _entries.end();
             continue;
         }
@@ -601,8 +696,8 @@ bool Arguments::tryParse(const int argc, const char** const argv) {
             CORRADE_INTERNAL_ASSERT(found != _entries.end());
             if(found->type == Type::BooleanOption) {
                 CORRADE_INTERNAL_ASSERT(found->id < _booleans.size());
-                _booleans[found->id] = true;
-                parsedArguments[found-_entries.begin()] = true;
+                _booleans.set(found->id);
+                parsedArguments.set(found-_entries.begin());
 
             /* Value option, save in next cycle */
             } else valueFor = found;
@@ -620,7 +715,7 @@ bool Arguments::tryParse(const int argc, const char** const argv) {
             }
 
             _values[found->id] = argv[i];
-            parsedArguments[found-_entries.begin()] = true;
+            parsedArguments.set(found-_entries.begin());
             nextArgument = found+1;
         }
     }
@@ -633,6 +728,35 @@ bool Arguments::tryParse(const int argc, const char** const argv) {
 
     bool success = true;
 
+    /* Convert values of typed entries, including defaults and values from
+       environment */
+    for(Entry& entry: _entries) {
+        if(entry.type == Type::BooleanOption || entry.valueType == ValueType::String) continue;
+
+        CORRADE_INTERNAL_ASSERT(entry.id < _values.size());
+        const Containers::StringView value = _values[entry.id];
+        if(value.empty()) continue;
+
+        bool valid;
+        switch(entry.valueType) {
+            case ValueType::Integer:
+                valid = parseValue(value, entry.converted.integer, entry.valueFlags);
+                break;
+            case ValueType::UnsignedInteger:
+                valid = parseValue(value, entry.converted.unsignedInteger, entry.valueFlags);
+                break;
+            case ValueType::FloatingPoint:
+                valid = parseValue(value, entry.converted.floatingPoint, entry.valueFlags);
+                break;
+            case ValueType::String: CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+        }
+
+        if(!valid) {
+            Error() << "Invalid value" << std::string{value.data(), value.size()} << "for command-line argument" << keyName(entry);
+            success = false;
+        }
+    }
+
     /* Check missing options. The _finalOptionalArgument points to one of them
        or is 0 if it's not set -- we assume that entry 0 is always --help, so
        there's no ambiguity. */
@@ -645,7 +769,7 @@ bool Arguments::tryParse(const int argc, const char** const argv) {
             continue;
 
         /* Argument was not parsed and it was not the final optional one */
-        if(parsedArguments[i] != true && _finalOptionalArgument != i) {
+        if(!parsedArguments[i] && _finalOptionalArgument != i) {
             Error() << "Missing command-line argument" << keyName(_entries[i]);
             success = false;
         }
@@ -867,9 +991,86 @@ std::string Arguments::valueInternal(const std::string& key) const {
         "Utility::Arguments::value(): cannot use this function for boolean option" << key, {});
     CORRADE_INTERNAL_ASSERT(found->id < _values.size());
     CORRADE_ASSERT(_flags & InternalFlag::Parsed, "Utility::Arguments::value(): arguments were not successfully parsed yet", {});
-    return _values[found->id];
+    const Containers::StringView value = _values[found->id];
+    return {value.data(), value.size()};
 }
 
+namespace {
+    /* Returns the value converted during parsing if it fits into the type */
+    template<class T> bool convertedValue(const Arguments::ValueType type, const ConvertedValue& converted, T& out, std::integral_constant<int, 0>) {
+        if(type == Arguments::ValueType::Integer) {
+            if(converted.integer < 0 ?
+                (!std::is_signed<T>::value || converted.integer < static_cast<long long>(std::numeric_limits<T>::min())) :
+                static_cast<unsigned long long>(converted.integer) > static_cast<unsigned long long>(std::numeric_limits<T>::max()))
+                return false;
+            out = T(converted.integer);
+            return true;
+        }
+
+        if(type == Arguments::ValueType::UnsignedInteger) {
+            if(converted.unsignedInteger > static_cast<unsigned long long>(std::numeric_limits<T>::max()))
+                return false;
+            out = T(converted.unsignedInteger);
+            return true;
+        }
+
+        return false;
+    }
+
+    template<class T> bool convertedValue(const Arguments::ValueType type, const ConvertedValue& converted, T& out, std::integral_constant<int, 1>) {
+        if(type == Arguments::ValueType::Integer)
+            out = T(converted.integer);
+        else if(type == Arguments::ValueType::UnsignedInteger)
+            out = T(converted.unsignedInteger);
+        else if(type == Arguments::ValueType::FloatingPoint)
+            out = T(converted.floatingPoint);
+        else return false;
+        return true;
+    }
+
+    /* A long double would lose precision when going through a double, parse
+       it again instead */
+    template<class T> bool convertedValue(Arguments::ValueType, const ConvertedValue&, T&, std::integral_constant<int, 2>) {
+        return false;
+    }
+}
+
+template<class T> T Arguments::numericValueInternal(const std::string& key, const ConfigurationValueFlags flags) const {
+    const auto found = find(_prefix + key);
+    CORRADE_ASSERT(found != _entries.end(), "Utility::Arguments::value(): key" << key << "not found", {});
+    CORRADE_ASSERT(found->type != Type::BooleanOption,
+        "Utility::Arguments::value(): cannot use this function for boolean option" << key, {});
+    CORRADE_INTERNAL_ASSERT(found->id < _values.size());
+    CORRADE_ASSERT(_flags & InternalFlag::Parsed, "Utility::Arguments::value(): arguments were not successfully parsed yet", {});
+
+    const Containers::StringView value = _values[found->id];
+    if(value.empty()) return T{};
+
+    T out{};
+    if(convertedValue(found->valueType, found->converted, out, std::integral_constant<int,
+        std::is_integral<T>::value ? 0 : sizeof(T) <= sizeof(double) ? 1 : 2>{}))
+        return out;
+
+    /* Otherwise parse directly from the stored view. Partial matches are
+       accepted, consistently with ConfigurationValue::fromString(). */
+    parseValue(value, out, flags);
+    return out;
+}
+
+template short Arguments::numericValueInternal<short>(const std::string&, ConfigurationValueFlags) const;
+template unsigned short Arguments::numericValueInternal<unsigned short>(const std::string&, ConfigurationValueFlags) const;
+template int Arguments::numericValueInternal<int>(const std::string&, ConfigurationValueFlags) const;
+template unsigned int Arguments::numericValueInternal<unsigned int>(const std::string&, ConfigurationValueFlags) const;
+template long Arguments::numericValueInternal<long>(const std::string&, ConfigurationValueFlags) const;
+template unsigned long Arguments::numericValueInternal<unsigned long>(const std::string&, ConfigurationValueFlags) const;
+template long long Arguments::numericValueInternal<long long>(const std::string&, ConfigurationValueFlags) const;
+template unsigned long long Arguments::numericValueInternal<unsigned long long>(const std::string&, ConfigurationValueFlags) const;
+template float Arguments::numericValueInternal<float>(const std::string&, ConfigurationValueFlags) const;
+template double Arguments::numericValueInternal<double>(const std::string&, ConfigurationValueFlags) const;
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+template long double Arguments::numericValueInternal<long double>(const std::string&, ConfigurationValueFlags) const;
+#endif
+
 bool Arguments::isSet(const std::string& key) const {
     const auto found = find(_prefix + key);
     CORRADE_ASSERT(found != _entries.end(), "Utility::Arguments::isSet(): key" << key << "not found", false);
@@ -899,7 +1100,24 @@ bool Arguments::verifyKey(char shortKey) const {
     return !shortKey || std::strchr(allowedShort, shortKey) != nullptr;
 }
 
+void Arguments::buildIndex() {
+    _index.reset(new Index);
+    _index->keys.reserve(_entries.size());
+    for(std::size_t& i: _index->shortKeys) i = ~std::size_t{};
+    for(std::size_t i = 0; i != _entries.size(); ++i) {
+        const Entry& entry = _entries[i];
+        _index->keys.emplace(entry.key, i);
+        if(entry.shortKey && std::size_t(entry.shortKey) < Containers::arraySize(_index->shortKeys))
+            _index->shortKeys[std::size_t(entry.shortKey)] = i;
+    }
+}
+
 auto Arguments::find(const std::string& key) -> std::vector<Entry>::iterator {
+    if(_index) {
+        const auto found = _index->keys.find(key);
+        return found == _index->keys.end() ? _entries.end() : _entries.begin() + found->second;
+    }
+
     for(auto it = _entries.begin(); it != _entries.end(); ++it)
         if(it->key == key) return it;
 
@@ -907,6 +1125,11 @@ auto Arguments::find(const std::string& key) -> std::vector<Entry>::iterator {
 }
 
 auto Arguments::find(const std::string& key) const -> std::vector<Entry>::const_iterator {
+    if(_index) {
+        const auto found = _index->keys.find(key);
+        return found == _index->keys.end() ? _entries.end() : _entries.begin() + found->second;
+    }
+
     for(auto it = _entries.begin(); it != _entries.end(); ++it)
         if(it->key == key) return it;
 
@@ -914,6 +1137,13 @@ auto Arguments::find(const std::string& key) const -> std::vector<Entry>::const_
 }
 
 auto Arguments::find(const char shortKey) -> std::vector<Entry>::iterator {
+    if(_index) {
+        if(std::size_t(shortKey) >= Containers::arraySize(_index->shortKeys))
+            return _entries.end();
+        const std::size_t found = _index->shortKeys[std::size_t(shortKey)];
+        return found == ~std::size_t{} ? _entries.end() : _entries.begin() + found;
+    }
+
     for(auto it = _entries.begin(); it != _entries.end(); ++it)
         if(it->shortKey == shortKey) return it;
 
@@ -30,9 +30,13 @@
  */
 
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "Corrade/Containers/BitArray.h"
+#include "Corrade/Containers/Pointer.h"
+#include "Corrade/Containers/StringView.h"
 #include "Corrade/Utility/ConfigurationValue.h"
 #include "Corrade/Utility/visibility.h"
 
@@ -176,6 +180,29 @@ class CORRADE_UTILITY_EXPORT Arguments {
          */
         typedef Containers::EnumSet<Flag> Flags;
 
+        /**
+         * @brief Value type
+         * @m_since_latest
+         *
+         * @see @ref setValueType()
+         */
+        enum class ValueType: std::uint8_t {
+            /**
+             * String. The value is converted on every @ref value() call.
+             * This is the default.
+             */
+            String,
+
+            /** Signed integer */
+            Integer,
+
+            /** Unsigned integer */
+            UnsignedInteger,
+
+            /** Floating-point value */
+            FloatingPoint
+        };
+
         /**
          * @brief Environment values
          *
@@ -470,6 +497,12 @@ class CORRADE_UTILITY_EXPORT Arguments {
          *      is combined from local Emscripten environment and system
          *      environment provided by Node.js. If a variable is in both
          *      environments, the local environment is preferred.
+         * @note On @ref CORRADE_TARGET_WINDOWS "Windows" and
+         *      @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten", where querying
+         *      a single variable is relatively expensive, the environment is
+         *      captured on the first @ref parse() call of any instance and
+         *      then shared by all of them. Changes made to the environment
+         *      after that are not reflected.
          * @see @ref environment()
          * @partialsupport Does nothing on @ref CORRADE_TARGET_WINDOWS_RT "Windows RT".
          */
@@ -485,6 +518,30 @@ class CORRADE_UTILITY_EXPORT Arguments {
         }
         #endif
 
+        /**
+         * @brief Set value type
+         * @param key       Long argument or option key
+         * @param type      Value type
+         * @param flags     Flags used for parsing the value
+         * @m_since_latest
+         *
+         * By default, values are stored as strings and converted on every
+         * @ref value() call. If a numeric type is set, the value is converted
+         * and validated already during @ref parse() --- a value that isn't a
+         * number of given type in its entirety is reported as a parse error.
+         * The @ref value() call then returns the already converted value for
+         * any builtin arithmetic type it fits into, without parsing the
+         * string again. Only
+         * @ref ConfigurationValueFlag::Hex and @ref ConfigurationValueFlag::Oct
+         * are taken into account from @p flags, the flags passed to
+         * @ref value() are ignored for converted values.
+         *
+         * Empty values, such as the default value being empty, are not
+         * converted and produce a default-constructed value. Expects that
+         * @p key exists and isn't a boolean option.
+         */
+        Arguments& setValueType(const std::string& key, ValueType type, ConfigurationValueFlags flags = {});
+
         /**
          * @brief Set command name
          *
@@ -549,6 +606,10 @@ class CORRADE_UTILITY_EXPORT Arguments {
          * parsing error (e.g. too little or too many arguments, unknown
          * options etc.), the function prints just the usage text and exits the
          * program with `1`.
+         *
+         * Parsed values reference @p argv directly instead of being copied,
+         * which means the @p argv array has to stay in scope for as long as
+         * the values are queried using @ref value().
          * @see @ref tryParse(), @ref usage(), @ref help()
          */
         void parse(int argc, const char** argv);
@@ -569,7 +630,8 @@ class CORRADE_UTILITY_EXPORT Arguments {
          * Unlike @ref parse() the function does not exit on failure, but
          * returns @cpp false @ce instead. If the user requested help, no
          * additional arguments are parsed, only `--help` option is set and
-         * @cpp true @ce is returned.
+         * @cpp true @ce is returned. The same constraints on @p argv lifetime
+         * as in @ref parse() apply.
          */
         bool tryParse(int argc, const char** argv);
 
@@ -607,7 +669,10 @@ class CORRADE_UTILITY_EXPORT Arguments {
          * Expects that the key exists and @ref parse() was successful. Use
          * @ref isSet() for boolean options. If @p T is not @ref std::string,
          * uses @ref ConfigurationValue::fromString() to convert the value to
-         * given type.
+         * given type. Builtin arithmetic types are parsed directly from the
+         * stored value without allocating, and if @ref setValueType() was
+         * used for given key, the value converted during @ref parse() is
+         * returned.
          */
         template<class T = std::string> T value(const std::string& key, ConfigurationValueFlags flags = {}) const;
 
@@ -627,6 +692,7 @@ class CORRADE_UTILITY_EXPORT Arguments {
         CORRADE_ENUMSET_FRIEND_OPERATORS(InternalFlags)
 
         struct CORRADE_UTILITY_LOCAL Entry;
+        struct CORRADE_UTILITY_LOCAL Index;
 
         bool CORRADE_UTILITY_LOCAL skippedPrefix(const std::string& key) const;
         bool CORRADE_UTILITY_LOCAL verifyKey(const std::string& key) const;
@@ -635,10 +701,21 @@ class CORRADE_UTILITY_EXPORT Arguments {
         std::vector<Entry>::const_iterator CORRADE_UTILITY_LOCAL find(const std::string& key) const;
         std::vector<Entry>::iterator CORRADE_UTILITY_LOCAL find(char shortKey);
         std::vector<Entry>::iterator CORRADE_UTILITY_LOCAL findNextArgument(std::vector<Entry>::iterator start);
+        void CORRADE_UTILITY_LOCAL buildIndex();
 
         std::string CORRADE_UTILITY_LOCAL keyName(const Entry& entry) const;
 
         std::string valueInternal(const std::string& key) const;
+        template<class T> T valueInternal(const std::string& key, ConfigurationValueFlags flags, std::false_type) const {
+            std::string value = valueInternal(key);
+            return value.empty() ? T() : ConfigurationValue<T>::fromString(value, flags);
+        }
+        template<class T> T valueInternal(const std::string& key, ConfigurationValueFlags flags, std::true_type) const {
+            return numericValueInternal<T>(key, flags);
+        }
+        /* Explicitly instantiated in the cpp for all types that have the
+           Implementation::ArgumentsNumericValue trait */
+        template<class T> T numericValueInternal(const std::string& key, ConfigurationValueFlags flags) const;
 
         InternalFlags _flags;
         /* not std::size_t so it fits into the padding after flags */
@@ -647,9 +724,14 @@ class CORRADE_UTILITY_EXPORT Arguments {
         std::string _command;
         std::string _help;
         std::vector<Entry> _entries;
-        std::vector<std::string> _values;
+        /* Views on either argv, default values or values of environment
+           variables stored in the entries */
+        std::vector<Containers::StringView> _values;
         std::vector<std::pair<std::string, std::string>> _skippedPrefixes;
-        std::vector<bool> _booleans;
+        Containers::BitArray _booleans;
+        /* Key lookup table, built when parsing and discarded when new entries
+           are added */
+        Containers::Pointer<Index> _index;
 };
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
@@ -658,9 +740,25 @@ template<> inline std::string Arguments::value(const std::string& key, Configura
 }
 #endif
 
+namespace Implementation {
+    template<class T> struct ArgumentsNumericValue: std::false_type {};
+    template<> struct ArgumentsNumericValue<short>: std::true_type {};
+    template<> struct ArgumentsNumericValue<unsigned short>: std::true_type {};
+    template<> struct ArgumentsNumericValue<int>: std::true_type {};
+    template<> struct ArgumentsNumericValue<unsigned int>: std::true_type {};
+    template<> struct ArgumentsNumericValue<long>: std::true_type {};
+    template<> struct ArgumentsNumericValue<unsigned long>: std::true_type {};
+    template<> struct ArgumentsNumericValue<long long>: std::true_type {};
+    template<> struct ArgumentsNumericValue<unsigned long long>: std::true_type {};
+    template<> struct ArgumentsNumericValue<float>: std::true_type {};
+    template<> struct ArgumentsNumericValue<double>: std::true_type {};
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    template<> struct ArgumentsNumericValue<long double>: std::true_type {};
+    #endif
+}
+
 template<class T> T Arguments::value(const std::string& key, ConfigurationValueFlags flags) const {
-    std::string value = valueInternal(key);
-    return value.empty() ? T() : ConfigurationValue<T>::fromString(value, flags);
+    return valueInternal<T>(key, flags, Implementation::ArgumentsNumericValue<T>{});
 }
 
 }}
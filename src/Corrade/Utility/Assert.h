@@ -35,6 +35,25 @@
 #include <cstdlib>
 
 #include "Corrade/Utility/Debug.h"
+
+/* The failure path is kept out of line and marked cold so each call site is
+   just the condition check and a jump, with no message formatting inlined
+   into the hot code */
+#ifdef __GNUC__
+#define _CORRADE_ASSERT_COLD __attribute__((cold, noinline))
+#else
+#define _CORRADE_ASSERT_COLD
+#endif
+
+namespace Corrade { namespace Utility { namespace Implementation {
+    /* Prints message followed by line to Error::defaultOutput() and aborts.
+       Takes only static data so the call site is as small as possible. */
+    CORRADE_NORETURN CORRADE_UTILITY_EXPORT CORRADE_NEVER_INLINE
+    #ifdef __GNUC__
+    __attribute__((cold))
+    #endif
+    void assertionFailed(const char* message, int line);
+}}}
 #elif !defined(NDEBUG)
 #include <cassert>
 #endif
@@ -129,6 +148,10 @@ You can use stream output operators for formatting just like when printing to
 
 @snippet Utility.cpp CORRADE_ASSERT-stream
 
+The message formatting is done in a separate function that's marked as cold
+and never inlined, so the code generated at each call site is just the
+condition check, branch-predicted as not failing, and a function call.
+
 @attention
     Don't use this function for checking function output like this:
 @attention
@@ -151,9 +174,11 @@ You can override this implementation by placing your own
 #elif defined(CORRADE_GRACEFUL_ASSERT)
 #define CORRADE_ASSERT(condition, message, returnValue)                     \
     do {                                                                    \
-        if(!(condition)) {                                                  \
-            Corrade::Utility::Error{} << message;                           \
-            if(Corrade::Utility::Error::defaultOutput() == Corrade::Utility::Error::output()) std::abort(); \
+        if(CORRADE_UNLIKELY(!(condition))) {                                \
+            [&]() _CORRADE_ASSERT_COLD {                                    \
+                Corrade::Utility::Error{} << message;                       \
+                if(Corrade::Utility::Error::defaultOutput() == Corrade::Utility::Error::output()) std::abort(); \
+            }();                                                            \
             return returnValue;                                             \
         }                                                                   \
     } while(false)
@@ -162,9 +187,11 @@ You can override this implementation by placing your own
 #else
 #define CORRADE_ASSERT(condition, message, returnValue)                     \
     do {                                                                    \
-        if(!(condition)) {                                                  \
-            Corrade::Utility::Error{Corrade::Utility::Error::defaultOutput()} << message; \
-            std::abort();                                                   \
+        if(CORRADE_UNLIKELY(!(condition))) {                                \
+            [&]() _CORRADE_ASSERT_COLD {                                    \
+                Corrade::Utility::Error{Corrade::Utility::Error::defaultOutput()} << message; \
+                std::abort();                                               \
+            }();                                                            \
             return returnValue;                                             \
         }                                                                   \
     } while(false)
@@ -209,7 +236,7 @@ You can override this implementation by placing your own
 #define CORRADE_CONSTEXPR_ASSERT(condition, message) static_cast<void>(0)
 #elif defined(CORRADE_GRACEFUL_ASSERT)
 #define CORRADE_CONSTEXPR_ASSERT(condition, message)                        \
-    static_cast<void>((condition) ? 0 : ([&]() {                            \
+    static_cast<void>(CORRADE_LIKELY(condition) ? 0 : ([&]() _CORRADE_ASSERT_COLD { \
         Corrade::Utility::Error{} << message;                               \
         if(Corrade::Utility::Error::defaultOutput() == Corrade::Utility::Error::output()) std::abort(); \
     }(), 0))
@@ -220,7 +247,7 @@ You can override this implementation by placing your own
     }(), 0))
 #else
 #define CORRADE_CONSTEXPR_ASSERT(condition, message)                        \
-    static_cast<void>((condition) ? 0 : ([&]() {                            \
+    static_cast<void>(CORRADE_LIKELY(condition) ? 0 : ([&]() _CORRADE_ASSERT_COLD { \
         Corrade::Utility::Error{Corrade::Utility::Error::defaultOutput()} << message; \
         std::abort();                                                       \
     }(), 0))
@@ -254,9 +281,11 @@ You can override this implementation by placing your own
 #elif defined(CORRADE_GRACEFUL_ASSERT)
 #define CORRADE_ASSERT_OUTPUT(call, message, returnValue)                   \
     do {                                                                    \
-        if(!(call)) {                                                       \
-            Corrade::Utility::Error{} << message;                           \
-            if(Corrade::Utility::Error::defaultOutput() == Corrade::Utility::Error::output()) std::abort(); \
+        if(CORRADE_UNLIKELY(!(call))) {                                     \
+            [&]() _CORRADE_ASSERT_COLD {                                    \
+                Corrade::Utility::Error{} << message;                       \
+                if(Corrade::Utility::Error::defaultOutput() == Corrade::Utility::Error::output()) std::abort(); \
+            }();                                                            \
             return returnValue;                                             \
         }                                                                   \
     } while(false)
@@ -265,9 +294,11 @@ You can override this implementation by placing your own
 #else
 #define CORRADE_ASSERT_OUTPUT(call, message, returnValue)                   \
     do {                                                                    \
-        if(!(call)) {                                                       \
-            Corrade::Utility::Error{Corrade::Utility::Error::defaultOutput()} << message; \
-            std::abort();                                                   \
+        if(CORRADE_UNLIKELY(!(call))) {                                     \
+            [&]() _CORRADE_ASSERT_COLD {                                    \
+                Corrade::Utility::Error{Corrade::Utility::Error::defaultOutput()} << message; \
+                std::abort();                                               \
+            }();                                                            \
             return returnValue;                                             \
         }                                                                   \
     } while(false)
@@ -290,6 +321,10 @@ Example usage:
 
 @snippet Utility.cpp CORRADE_INTERNAL_ASSERT
 
+Unlike with @ref CORRADE_ASSERT(), the failure message consists only of
+static data, so a failed assertion is just a call to a single cold function
+exported from the library, passing it a string literal and the line number.
+
 @attention
     Don't use this function for checking function output like this:
 @attention
@@ -314,10 +349,8 @@ You can override this implementation by placing your own
 #else
 #define CORRADE_INTERNAL_ASSERT(condition)                                  \
     do {                                                                    \
-        if(!(condition)) {                                                  \
-            Corrade::Utility::Error{Corrade::Utility::Error::defaultOutput()} << "Assertion " #condition " failed in " __FILE__ " on line" << __LINE__; \
-            std::abort();                                                   \
-        }                                                                   \
+        if(CORRADE_UNLIKELY(!(condition)))                                  \
+            Corrade::Utility::Implementation::assertionFailed("Assertion " #condition " failed in " __FILE__ " on line", __LINE__); \
     } while(false)
 #endif
 #endif
@@ -353,10 +386,8 @@ You can override this implementation by placing your own
     }(), 0))
 #else
 #define CORRADE_INTERNAL_CONSTEXPR_ASSERT(condition)                        \
-    static_cast<void>((condition) ? 0 : ([&]() {                            \
-        Corrade::Utility::Error{Corrade::Utility::Error::defaultOutput()} << "Assertion " #condition " failed in " __FILE__ " on line" << __LINE__; \
-        std::abort();                                                       \
-    }(), 0))
+    static_cast<void>(CORRADE_LIKELY(condition) ? 0 :                       \
+        (Corrade::Utility::Implementation::assertionFailed("Assertion " #condition " failed in " __FILE__ " on line", __LINE__), 0))
 #endif
 #endif
 
@@ -385,10 +416,8 @@ You can override this implementation by placing your own
 #else
 #define CORRADE_INTERNAL_ASSERT_OUTPUT(call)                                \
     do {                                                                    \
-        if(!(call)) {                                                       \
-            Corrade::Utility::Error{Corrade::Utility::Error::defaultOutput()} << "Assertion " #call " failed in " __FILE__ " on line" << __LINE__; \
-            std::abort();                                                   \
-        }                                                                   \
+        if(CORRADE_UNLIKELY(!(call)))                                       \
+            Corrade::Utility::Implementation::assertionFailed("Assertion " #call " failed in " __FILE__ " on line", __LINE__); \
     } while(false)
 #endif
 #endif
@@ -427,10 +456,7 @@ You can override this implementation by placing your own
 #define CORRADE_ASSERT_UNREACHABLE() assert(!"unreachable code")
 #else
 #define CORRADE_ASSERT_UNREACHABLE()                                        \
-    do {                                                                    \
-        Corrade::Utility::Error{Corrade::Utility::Error::defaultOutput()} << "Reached unreachable code in " __FILE__ " on line" << __LINE__; \
-        std::abort();                                                       \
-    } while(false)
+    Corrade::Utility::Implementation::assertionFailed("Reached unreachable code in " __FILE__ " on line", __LINE__)
 #endif
 #endif
 
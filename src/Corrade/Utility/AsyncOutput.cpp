@@ -0,0 +1,298 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "AsyncOutput.h"
+
+#include <atomic>
+#include <cstddef>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Utility/Assert.h"
+#include "Corrade/Utility/Debug.h"
+
+namespace Corrade { namespace Utility {
+
+namespace {
+
+/* Messages taken from the queue are concatenated until this size and then
+   written at once */
+constexpr std::size_t BatchSize = 64*1024;
+
+/* Initial size of the per-stream buffer */
+constexpr std::size_t StreamBufferSize = 256;
+
+struct Slot {
+    /* Equal to position + 1 if the slot contains a message for given
+       position, equal to position if it's free for given position */
+    std::atomic<std::size_t> sequence;
+    std::string message;
+};
+
+}
+
+/* A bounded MPSC queue, in case of multiple consumers it'd be the Vyukov
+   MPMC queue from http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue */
+struct AsyncOutput::State {
+    explicit State(std::ostream& output, std::size_t capacity, Overflow overflow): output(output), slots{capacity}, overflow{overflow} {
+        for(std::size_t i = 0; i != capacity; ++i)
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    /* Pops all available messages, up to the batch size, into the batch.
+       Returns false if there was nothing to pop. */
+    bool pop(std::string& batch);
+
+    void run();
+
+    std::ostream& output;
+    Containers::Array<Slot> slots;
+    Overflow overflow;
+
+    /* Written by all producers */
+    std::atomic<std::size_t> enqueuePosition{};
+    std::atomic<std::size_t> droppedCount{};
+    /* Written only by the consumer */
+    std::size_t dequeuePosition{};
+    std::atomic<std::size_t> writtenPosition{};
+
+    /* Used only for waking up the consumer when it has nothing to do */
+    std::atomic<bool> sleeping{};
+    std::atomic<bool> stopping{};
+    std::mutex mutex;
+    std::condition_variable condition;
+
+    std::thread thread;
+};
+
+bool AsyncOutput::State::pop(std::string& batch) {
+    const std::size_t mask = slots.size() - 1;
+    bool popped = false;
+    while(batch.size() < BatchSize) {
+        Slot& slot = slots[dequeuePosition & mask];
+        if(slot.sequence.load(std::memory_order_seq_cst) != dequeuePosition + 1)
+            break;
+
+        batch += slot.message;
+        /* Keeping the capacity, a producer will swap the string with its own
+           buffer and reuse it */
+        slot.message.clear();
+        slot.sequence.store(dequeuePosition + slots.size(), std::memory_order_release);
+        ++dequeuePosition;
+        popped = true;
+    }
+
+    return popped;
+}
+
+void AsyncOutput::State::run() {
+    std::string batch;
+    batch.reserve(BatchSize);
+    for(;;) {
+        batch.clear();
+        if(pop(batch)) {
+            output.write(batch.data(), batch.size());
+            output.flush();
+            writtenPosition.store(dequeuePosition, std::memory_order_release);
+            continue;
+        }
+
+        /* Stopping only once there's nothing left, the destructor expects
+           all producers are gone at this point */
+        if(stopping.load(std::memory_order_acquire)) break;
+
+        /* Announce that we're going to sleep and check the queue again. If
+           a producer published a message before seeing the flag, we'll see
+           the message, otherwise the producer will see the flag and wake
+           us up. */
+        sleeping.store(true, std::memory_order_seq_cst);
+        if(slots[dequeuePosition & (slots.size() - 1)].sequence.load(std::memory_order_seq_cst) == dequeuePosition + 1) {
+            sleeping.store(false, std::memory_order_relaxed);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock{mutex};
+        condition.wait(lock, [this]{
+            return stopping.load(std::memory_order_acquire) || slots[dequeuePosition & (slots.size() - 1)].sequence.load(std::memory_order_seq_cst) == dequeuePosition + 1;
+        });
+        sleeping.store(false, std::memory_order_relaxed);
+    }
+}
+
+AsyncOutput::AsyncOutput(std::ostream& output, std::size_t capacity, const Overflow overflow) {
+    CORRADE_ASSERT(capacity,
+        "Utility::AsyncOutput: capacity expected to be non-zero", );
+
+    /* Round up to a power of two */
+    std::size_t roundedCapacity = 1;
+    while(roundedCapacity < capacity) roundedCapacity <<= 1;
+
+    _state.emplace(output, roundedCapacity, overflow);
+    _state->thread = std::thread{&State::run, _state.get()};
+}
+
+AsyncOutput::~AsyncOutput() {
+    /* Possible if the capacity assertion fired */
+    if(!_state) return;
+
+    {
+        std::lock_guard<std::mutex> lock{_state->mutex};
+        _state->stopping.store(true, std::memory_order_release);
+    }
+    _state->condition.notify_one();
+    _state->thread.join();
+}
+
+std::size_t AsyncOutput::capacity() const { return _state->slots.size(); }
+
+AsyncOutput::Overflow AsyncOutput::overflow() const { return _state->overflow; }
+
+std::size_t AsyncOutput::droppedCount() const {
+    return _state->droppedCount.load(std::memory_order_relaxed);
+}
+
+void AsyncOutput::flush() {
+    /* All positions below this one were either already published or are
+       being published by a producer right now, so the consumer will get to
+       them eventually */
+    const std::size_t position = _state->enqueuePosition.load(std::memory_order_acquire);
+    while(_state->writtenPosition.load(std::memory_order_acquire) < position)
+        std::this_thread::yield();
+}
+
+void AsyncOutput::push(std::string& message) {
+    State& state = *_state;
+    const std::size_t mask = state.slots.size() - 1;
+
+    std::size_t position = state.enqueuePosition.load(std::memory_order_relaxed);
+    Slot* slot;
+    for(;;) {
+        slot = &state.slots[position & mask];
+        const std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        const std::ptrdiff_t difference = std::ptrdiff_t(sequence) - std::ptrdiff_t(position);
+
+        /* The slot is free, try to claim it. On failure the position gets
+           updated to the current value. */
+        if(difference == 0) {
+            if(state.enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                break;
+
+        /* The queue is full */
+        } else if(difference < 0) {
+            if(state.overflow == Overflow::Drop) {
+                state.droppedCount.fetch_add(1, std::memory_order_relaxed);
+                message.clear();
+                return;
+            }
+
+            std::this_thread::yield();
+            position = state.enqueuePosition.load(std::memory_order_relaxed);
+
+        /* Another producer claimed the slot meanwhile */
+        } else position = state.enqueuePosition.load(std::memory_order_relaxed);
+    }
+
+    /* Swap the message with the (cleared) string in the slot, so the caller
+       can reuse its allocation */
+    std::swap(slot->message, message);
+    slot->sequence.store(position + 1, std::memory_order_seq_cst);
+
+    /* Wake up the consumer if it's going to sleep. Notifying with the lock
+       held so it can't check the predicate and start waiting in between. */
+    if(state.sleeping.load(std::memory_order_seq_cst)) {
+        std::lock_guard<std::mutex> lock{state.mutex};
+        state.condition.notify_one();
+    }
+}
+
+namespace Implementation {
+
+class AsyncOutputStreamBuffer: public std::streambuf {
+    public:
+        explicit AsyncOutputStreamBuffer(AsyncOutput& output): _output(output) {
+            _buffer.resize(StreamBufferSize);
+            setp(&_buffer[0], &_buffer[0] + _buffer.size());
+        }
+
+        int sync() override {
+            if(pptr() == pbase()) return 0;
+
+            _buffer.resize(pptr() - pbase());
+            _output.push(_buffer);
+
+            /* The buffer is now the one that was in the queue slot, which
+               may be empty with no allocation if it wasn't used before */
+            _buffer.resize(_buffer.capacity() < StreamBufferSize ? StreamBufferSize : _buffer.capacity());
+            setp(&_buffer[0], &_buffer[0] + _buffer.size());
+            return 0;
+        }
+
+    private:
+        int_type overflow(const int_type c) override {
+            /* Grow the buffer, keeping the contents */
+            const std::size_t size = pptr() - pbase();
+            _buffer.resize(2*_buffer.size());
+            setp(&_buffer[0], &_buffer[0] + _buffer.size());
+            pbump(int(size));
+
+            if(traits_type::eq_int_type(c, traits_type::eof()))
+                return traits_type::not_eof(c);
+
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+            return c;
+        }
+
+        AsyncOutput& _output;
+        std::string _buffer;
+};
+
+}
+
+AsyncOutputStream::AsyncOutputStream(AsyncOutput& output): std::ostream{nullptr}, _buffer{Containers::pointer<Implementation::AsyncOutputStreamBuffer>(output)} {
+    rdbuf(_buffer.get());
+}
+
+AsyncOutputStream::~AsyncOutputStream() {
+    _buffer->sync();
+}
+
+Debug& operator<<(Debug& debug, const AsyncOutput::Overflow value) {
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case AsyncOutput::Overflow::value: return debug << "Utility::AsyncOutput::Overflow::" #value;
+        _c(Block)
+        _c(Drop)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "Utility::AsyncOutput::Overflow(" << Debug::nospace << reinterpret_cast<void*>(std::uint8_t(value)) << Debug::nospace << ")";
+}
+
+}}
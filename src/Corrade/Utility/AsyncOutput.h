@@ -0,0 +1,219 @@
+#ifndef Corrade_Utility_AsyncOutput_h
+#define Corrade_Utility_AsyncOutput_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+#if (defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)) || defined(DOXYGEN_GENERATING_OUTPUT)
+/** @file
+ * @brief Class @ref Corrade::Utility::AsyncOutput, @ref Corrade::Utility::AsyncOutputStream
+ * @m_since_latest
+ */
+#endif
+
+#include "Corrade/configure.h"
+
+#if (defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)) || defined(DOXYGEN_GENERATING_OUTPUT)
+#include <ostream>
+
+#include "Corrade/Containers/Pointer.h"
+#include "Corrade/Utility/StlForwardString.h"
+#include "Corrade/Utility/Utility.h"
+#include "Corrade/Utility/visibility.h"
+
+namespace Corrade { namespace Utility {
+
+namespace Implementation {
+    class AsyncOutputStreamBuffer;
+}
+
+/**
+@brief Asynchronous output
+@m_since_latest
+
+Writes messages to a @ref std::ostream from a background thread, so threads
+producing the messages don't need to wait on the stream. Messages are
+formatted by each thread into its own @ref AsyncOutputStream, which passes
+each finished message to a bounded lock-free queue on every
+@ref std::ostream::flush() --- which is called implicitly by @ref std::endl
+and thus at the end of every @ref Debug, @ref Warning and @ref Error
+message. The background thread then takes all queued messages and writes
+them to the output together, followed by a single flush. Example usage:
+
+@snippet Utility.cpp AsyncOutput
+
+Because the @ref Debug output redirection is thread-local if
+@ref CORRADE_BUILD_MULTITHREADED is enabled, each thread needs to create its
+own @ref AsyncOutputStream and redirect the output to it. The stream is not
+meant to be shared between threads. Messages from one thread are written in
+the order they were produced, messages from different threads are interleaved
+on message boundaries in the order they were queued.
+
+@section Utility-AsyncOutput-overflow Overflow policy
+
+If the queue is full, which can happen if the messages are produced faster
+than the output can consume them, the thread producing a message either
+waits until there's space again, or the message is dropped, based on the
+@ref Overflow passed to the constructor. Count of dropped messages is
+available through @ref droppedCount().
+
+All @ref AsyncOutputStream instances are expected to be destroyed before the
+@ref AsyncOutput they write to. The destructor then writes all remaining
+messages before stopping the background thread.
+@partialsupport Available only if @ref CORRADE_BUILD_MULTITHREADED is enabled
+    and not on @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten".
+*/
+class CORRADE_UTILITY_EXPORT AsyncOutput {
+    public:
+        /**
+         * @brief Overflow policy
+         *
+         * @see @ref AsyncOutput()
+         */
+        enum class Overflow: std::uint8_t {
+            /** Wait until there's space in the queue */
+            Block,
+
+            /** Drop the message */
+            Drop
+        };
+
+        /**
+         * @brief Constructor
+         * @param output    Output stream to write to
+         * @param capacity  Count of messages the queue can hold. Rounded up
+         *      to the nearest power of two, expected to be non-zero.
+         * @param overflow  Policy when the queue is full
+         *
+         * Starts the background thread. The @p output is expected to stay
+         * in scope for the whole lifetime of the instance and not be used
+         * by anything else meanwhile.
+         */
+        explicit AsyncOutput(std::ostream& output, std::size_t capacity = 1024, Overflow overflow = Overflow::Block);
+
+        /** @brief Copying is not allowed */
+        AsyncOutput(const AsyncOutput&) = delete;
+
+        /** @brief Moving is not allowed */
+        AsyncOutput(AsyncOutput&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Writes all remaining messages and stops the background thread.
+         */
+        ~AsyncOutput();
+
+        /** @brief Copying is not allowed */
+        AsyncOutput& operator=(const AsyncOutput&) = delete;
+
+        /** @brief Moving is not allowed */
+        AsyncOutput& operator=(AsyncOutput&&) = delete;
+
+        /** @brief Queue capacity */
+        std::size_t capacity() const;
+
+        /** @brief Overflow policy */
+        Overflow overflow() const;
+
+        /**
+         * @brief Count of dropped messages
+         *
+         * Always @cpp 0 @ce with @ref Overflow::Block.
+         */
+        std::size_t droppedCount() const;
+
+        /**
+         * @brief Wait until all queued messages are written
+         *
+         * Messages that are still being formatted in an
+         * @ref AsyncOutputStream and weren't flushed yet are not included.
+         */
+        void flush();
+
+    private:
+        friend Implementation::AsyncOutputStreamBuffer;
+
+        struct State;
+
+        CORRADE_UTILITY_LOCAL void push(std::string& message);
+
+        Containers::Pointer<State> _state;
+};
+
+/**
+@brief Stream writing to an asynchronous output
+@m_since_latest
+
+A @ref std::ostream that buffers the data and passes them to an
+@ref AsyncOutput on every @ref std::ostream::flush(). Any data not flushed
+yet are passed on destruction. Meant to be used from a single thread, see
+the @ref AsyncOutput documentation for more information.
+@partialsupport Available only if @ref CORRADE_BUILD_MULTITHREADED is enabled
+    and not on @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten".
+*/
+class CORRADE_UTILITY_EXPORT AsyncOutputStream: public std::ostream {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * The @p output is expected to stay in scope for the whole lifetime
+         * of the stream.
+         */
+        explicit AsyncOutputStream(AsyncOutput& output);
+
+        /** @brief Copying is not allowed */
+        AsyncOutputStream(const AsyncOutputStream&) = delete;
+
+        /** @brief Moving is not allowed */
+        AsyncOutputStream(AsyncOutputStream&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Passes any data not flushed yet to the output.
+         */
+        ~AsyncOutputStream();
+
+        /** @brief Copying is not allowed */
+        AsyncOutputStream& operator=(const AsyncOutputStream&) = delete;
+
+        /** @brief Moving is not allowed */
+        AsyncOutputStream& operator=(AsyncOutputStream&&) = delete;
+
+    private:
+        Containers::Pointer<Implementation::AsyncOutputStreamBuffer> _buffer;
+};
+
+/**
+@debugoperatorclassenum{AsyncOutput,AsyncOutput::Overflow}
+@m_since_latest
+*/
+CORRADE_UTILITY_EXPORT Debug& operator<<(Debug& debug, AsyncOutput::Overflow value);
+
+}}
+#else
+#error this file is available only on multithreaded builds and not on Emscripten
+#endif
+
+#endif
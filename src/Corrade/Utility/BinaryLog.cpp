@@ -0,0 +1,409 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BinaryLog.h"
+
+#include <string>
+#ifdef CORRADE_BUILD_MULTITHREADED
+#include <atomic>
+#endif
+
+#include "Corrade/Containers/GrowableArray.h"
+#include "Corrade/Containers/Optional.h"
+#include "Corrade/Utility/Assert.h"
+#include "Corrade/Utility/Debug.h"
+#include "Corrade/Utility/Format.h"
+
+namespace Corrade { namespace Utility {
+
+/* The memory starts with the header, followed by the ring of records. Each
+   record starts with a 32-bit size (including the record header itself, but
+   not the padding to 8 bytes) and a 32-bit site ID. Site ID zero marks
+   padding until the end of the ring, an ID with the top bit set is a
+   definition of given site, containing its format string. Otherwise the
+   record is a message, followed by the arguments, each prefixed with its
+   BinaryLogType. Head and tail are absolute offsets of the first and one
+   past the last record, the position in the ring is the offset modulo the
+   ring size. */
+
+namespace {
+
+struct Header {
+    char magic[8];
+    std::uint64_t head;
+    std::uint64_t tail;
+    std::uint64_t size;
+};
+
+constexpr const char Magic[]{'C', 'O', 'R', 'R', 'B', 'L', 'G', '\x01'};
+constexpr std::size_t RecordHeaderSize = 8;
+constexpr std::uint32_t DefinitionBit = 0x80000000u;
+
+inline std::size_t alignRecordSize(const std::size_t size) {
+    return (size + 7) & ~std::size_t{7};
+}
+
+inline std::uint32_t readUnsignedInt(const char* const data) {
+    std::uint32_t value;
+    std::memcpy(&value, data, sizeof(std::uint32_t));
+    return value;
+}
+
+#ifdef CORRADE_BUILD_MULTITHREADED
+std::atomic<std::uint32_t> siteCounter{0};
+#else
+std::uint32_t siteCounter = 0;
+#endif
+
+}
+
+namespace Implementation {
+
+BinaryLogSite::BinaryLogSite() noexcept: id{++siteCounter} {}
+
+}
+
+std::size_t BinaryLog::minimalSize() { return sizeof(Header) + 64; }
+
+BinaryLog::BinaryLog(const std::size_t size): BinaryLog{Containers::ArrayView<char>{}} {
+    CORRADE_ASSERT(size >= minimalSize(),
+        "Utility::BinaryLog: expected at least" << minimalSize() << "bytes but got" << size, );
+    /* Default-initialized new[] is aligned enough for the header */
+    _data = Containers::Array<char>{Containers::NoInit, size};
+    _capacity = (size - sizeof(Header)) & ~std::size_t{7};
+    clear();
+}
+
+BinaryLog::BinaryLog(const Containers::ArrayView<char> memory): _data{memory.data(), memory.size(), [](char*, std::size_t) {}}, _capacity{} {
+    /* The delegating constructor from above passes an empty view */
+    if(!memory.data()) return;
+
+    CORRADE_ASSERT(memory.size() >= minimalSize(),
+        "Utility::BinaryLog: expected at least" << minimalSize() << "bytes but got" << memory.size(), );
+    CORRADE_ASSERT(reinterpret_cast<std::uintptr_t>(memory.data()) % 8 == 0,
+        "Utility::BinaryLog: expected the memory to be aligned to 8 bytes", );
+    _capacity = (memory.size() - sizeof(Header)) & ~std::size_t{7};
+    clear();
+}
+
+BinaryLog::BinaryLog(BinaryLog&&) noexcept = default;
+
+BinaryLog::~BinaryLog() = default;
+
+BinaryLog& BinaryLog::operator=(BinaryLog&&) noexcept = default;
+
+void BinaryLog::clear() {
+    _head = _tail = 0;
+    _staleDefinitionCount = 0;
+    for(Implementation::BinaryLogSiteState& site: _sites)
+        site = {};
+
+    Header& header = *reinterpret_cast<Header*>(_data.data());
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.size = _capacity;
+    updateHeader();
+}
+
+inline void BinaryLog::updateHeader() {
+    Header& header = *reinterpret_cast<Header*>(_data.data());
+    header.head = _head;
+    header.tail = _tail;
+}
+
+std::uint64_t BinaryLog::place(const std::size_t size, const std::uint64_t protect) {
+    char* const ring = _data.data() + sizeof(Header);
+    const std::size_t alignedSize = alignRecordSize(size);
+
+    /* If the record doesn't fit until the end of the ring, fill the rest with
+       padding and continue at the beginning. As everything is aligned to 8
+       bytes, there's always space for the padding record header. */
+    const std::size_t position = _tail % _capacity;
+    std::size_t padding = 0;
+    if(_capacity - position < alignedSize) padding = _capacity - position;
+
+    /* Discard oldest records until there's enough space. Records starting
+       at the protected offset and after are not allowed to be discarded. */
+    while(_tail + padding + alignedSize - _head > _capacity) {
+        if(_head >= protect) return ~std::uint64_t{};
+
+        /* If everything got discarded, the padding is not needed anymore */
+        if(_head == _tail) {
+            _head = _tail = _tail + padding;
+            padding = 0;
+            break;
+        }
+
+        const char* const record = ring + _head % _capacity;
+        const std::uint32_t site = readUnsignedInt(record + 4);
+
+        /* If a current site definition gets discarded, remember to record it
+           again, but only if there are still messages from that site in the
+           log */
+        if(site & DefinitionBit) {
+            Implementation::BinaryLogSiteState& state = _sites[site & ~DefinitionBit];
+            if(state.definition == _head + 1) {
+                state.definition = 0;
+                if(state.lastMessage > _head) ++_staleDefinitionCount;
+            }
+        }
+
+        _head += site ? alignRecordSize(readUnsignedInt(record)) :
+            _capacity - _head % _capacity;
+    }
+
+    if(padding) {
+        const std::uint32_t paddingHeader[]{std::uint32_t(padding), 0};
+        std::memcpy(ring + position, paddingHeader, sizeof(paddingHeader));
+        _tail += padding;
+    }
+
+    const std::uint64_t offset = _tail;
+    _tail += alignedSize;
+    return offset;
+}
+
+bool BinaryLog::writeDefinition(const std::uint32_t site, const char* const format, const std::uint64_t protect) {
+    const std::size_t formatSize = std::strlen(format);
+    const std::size_t size = RecordHeaderSize + formatSize;
+
+    /* A format string that doesn't fit the ring, messages from this site
+       won't be decodable anyway */
+    if(alignRecordSize(size) > _capacity) return false;
+
+    /* Reserve the space first, as it may discard the definition that's being
+       replaced */
+    const std::uint64_t offset = place(size, protect);
+    if(offset == ~std::uint64_t{}) return false;
+    char* const out = _data.data() + sizeof(Header) + offset % _capacity;
+    const std::uint32_t header[]{std::uint32_t(size), site|DefinitionBit};
+    std::memcpy(out, header, sizeof(header));
+    std::memcpy(out + RecordHeaderSize, format, formatSize);
+
+    Implementation::BinaryLogSiteState& state = _sites[site];
+    state.definition = offset + 1;
+    state.format = format;
+    return true;
+}
+
+char* BinaryLog::reserve(const std::uint32_t site, const char* const format, const std::size_t argumentSize) {
+    const std::size_t size = RecordHeaderSize + argumentSize;
+    if(alignRecordSize(size) > _capacity) {
+        ++_droppedCount;
+        return nullptr;
+    }
+
+    /* Record the site definition, if not there already */
+    if(site >= _sites.size())
+        arrayResize(_sites, Containers::ValueInit, site + 1);
+    if(!_sites[site].definition)
+        writeDefinition(site, format, ~std::uint64_t{});
+
+    const std::uint64_t offset = place(size, ~std::uint64_t{});
+    char* const out = _data.data() + sizeof(Header) + offset % _capacity;
+    const std::uint32_t header[]{std::uint32_t(size), site};
+    std::memcpy(out, header, sizeof(header));
+    _sites[site].lastMessage = offset;
+
+    /* If placing the records discarded definitions of sites that still have
+       messages in the log, record them again. That may discard other
+       definitions, so repeat until there's nothing to record, but never
+       discard the message that's being recorded. Bounded by the site count
+       in case the definitions alone don't fit into the ring. */
+    for(std::size_t iteration = 0; _staleDefinitionCount && iteration != _sites.size(); ++iteration) {
+        _staleDefinitionCount = 0;
+        for(std::size_t i = 0; i != _sites.size(); ++i) {
+            Implementation::BinaryLogSiteState& state = _sites[i];
+            if(state.definition || !state.format || state.lastMessage < _head) continue;
+            if(!writeDefinition(i, state.format, offset)) {
+                iteration = _sites.size() - 1;
+                break;
+            }
+        }
+    }
+    _staleDefinitionCount = 0;
+
+    updateHeader();
+    return out + RecordHeaderSize;
+}
+
+Containers::Optional<std::string> BinaryLog::decode(const Containers::ArrayView<const char> data) {
+    if(data.size() < sizeof(Header) || std::memcmp(data.data(), Magic, sizeof(Magic)) != 0) {
+        Error{} << "Utility::BinaryLog::decode(): invalid log header";
+        return {};
+    }
+
+    Header header;
+    std::memcpy(&header, data.data(), sizeof(Header));
+    const std::uint64_t capacity = header.size;
+    if(!capacity || capacity % 8 || capacity > data.size() - sizeof(Header) || header.head > header.tail || header.tail - header.head > capacity || header.head % 8 || header.tail % 8) {
+        Error{} << "Utility::BinaryLog::decode(): invalid log state";
+        return {};
+    }
+
+    const char* const ring = data.data() + sizeof(Header);
+
+    /* Go through the records, verify their sizes and collect site
+       definitions. A definition may come only after the first messages if
+       the original one got overwritten, so this has to be done in a separate
+       pass. */
+    Containers::Array<Containers::StringView> formats;
+    for(std::uint64_t offset = header.head; offset != header.tail; ) {
+        const std::size_t position = offset % capacity;
+        const std::uint32_t size = readUnsignedInt(ring + position);
+        const std::uint32_t site = readUnsignedInt(ring + position + 4);
+        const std::uint64_t advance = site ? alignRecordSize(size) : capacity - position;
+        if((site && size < RecordHeaderSize) || advance > capacity - position || offset + advance > header.tail) {
+            Error{} << "Utility::BinaryLog::decode(): invalid record at offset" << offset;
+            return {};
+        }
+
+        if(site & DefinitionBit) {
+            const std::uint32_t id = site & ~DefinitionBit;
+            if(id >= formats.size())
+                arrayResize(formats, Containers::ValueInit, id + 1);
+            formats[id] = Containers::StringView{ring + position + RecordHeaderSize, size - RecordHeaderSize};
+        }
+
+        offset += advance;
+    }
+
+    /* Format the messages. Integers are widened to 64 bits, which is fine
+       for formatting. */
+    struct Value {
+        Implementation::BinaryLogType type;
+        union {
+            bool b;
+            long long i;
+            unsigned long long u;
+            float f;
+            double d;
+            Containers::ArrayView<const char> s;
+        };
+        Value(): u{} {}
+    };
+    static const char* const BoolStrings[]{"false", "true"};
+    Containers::Array<char> out;
+    std::string format;
+    Containers::Array<Value> values;
+    Containers::Array<Implementation::BufferFormatter> formatters;
+    for(std::uint64_t offset = header.head; offset != header.tail; ) {
+        const std::size_t position = offset % capacity;
+        const char* const record = ring + position;
+        const std::uint32_t size = readUnsignedInt(record);
+        const std::uint32_t site = readUnsignedInt(record + 4);
+        const std::uint64_t recordOffset = offset;
+        offset += site ? alignRecordSize(size) : capacity - position;
+
+        /* Skip padding, definitions, and messages of unknown sites */
+        if(!site || site & DefinitionBit || site >= formats.size() || !formats[site].data())
+            continue;
+
+        /* Gather the arguments, verifying they're in bounds */
+        arrayResize(values, 0);
+        const char* const end = record + size;
+        for(const char* in = record + RecordHeaderSize; in != end; ) {
+            Value value;
+            value.type = Implementation::BinaryLogType(*in);
+            std::size_t valueSize = ~std::size_t{};
+            switch(value.type) {
+                #define _c(type, member, T)                                 \
+                    case Implementation::BinaryLogType::type: {             \
+                        if(std::size_t(end - in) < 1 + sizeof(T)) break;    \
+                        valueSize = sizeof(T);                              \
+                        T v;                                                \
+                        std::memcpy(&v, in + 1, sizeof(T));                 \
+                        value.member = v;                                   \
+                    } break;
+                _c(Bool, b, bool)
+                _c(Int8, i, std::int8_t)
+                _c(UnsignedInt8, u, std::uint8_t)
+                _c(Int16, i, std::int16_t)
+                _c(UnsignedInt16, u, std::uint16_t)
+                _c(Int32, i, std::int32_t)
+                _c(UnsignedInt32, u, std::uint32_t)
+                _c(Int64, i, std::int64_t)
+                _c(UnsignedInt64, u, std::uint64_t)
+                _c(Float, f, float)
+                _c(Double, d, double)
+                #undef _c
+                case Implementation::BinaryLogType::String: {
+                    if(std::size_t(end - in) < 1 + sizeof(std::uint32_t)) break;
+                    const std::size_t stringSize = readUnsignedInt(in + 1);
+                    if(std::size_t(end - in) - 1 - sizeof(std::uint32_t) < stringSize) break;
+                    valueSize = sizeof(std::uint32_t) + stringSize;
+                    value.s = {in + 1 + sizeof(std::uint32_t), stringSize};
+                } break;
+            }
+
+            if(valueSize == ~std::size_t{}) {
+                Error{} << "Utility::BinaryLog::decode(): invalid argument in a record at offset" << recordOffset;
+                return {};
+            }
+
+            arrayAppend(values, value);
+            in += 1 + valueSize;
+        }
+
+        /* The values array is final now, create formatters referencing it */
+        arrayResize(formatters, Containers::NoInit, values.size());
+        for(std::size_t i = 0; i != values.size(); ++i) {
+            const Value& value = values[i];
+            switch(value.type) {
+                case Implementation::BinaryLogType::Bool:
+                    formatters[i] = Implementation::BufferFormatter{BoolStrings[value.b]};
+                    break;
+                case Implementation::BinaryLogType::Int8:
+                case Implementation::BinaryLogType::Int16:
+                case Implementation::BinaryLogType::Int32:
+                case Implementation::BinaryLogType::Int64:
+                    formatters[i] = Implementation::BufferFormatter{value.i};
+                    break;
+                case Implementation::BinaryLogType::UnsignedInt8:
+                case Implementation::BinaryLogType::UnsignedInt16:
+                case Implementation::BinaryLogType::UnsignedInt32:
+                case Implementation::BinaryLogType::UnsignedInt64:
+                    formatters[i] = Implementation::BufferFormatter{value.u};
+                    break;
+                case Implementation::BinaryLogType::Float:
+                    formatters[i] = Implementation::BufferFormatter{value.f};
+                    break;
+                case Implementation::BinaryLogType::Double:
+                    formatters[i] = Implementation::BufferFormatter{value.d};
+                    break;
+                case Implementation::BinaryLogType::String:
+                    formatters[i] = Implementation::BufferFormatter{value.s};
+                    break;
+            }
+        }
+
+        format.assign(formats[site].data(), formats[site].size());
+        Implementation::formatInto(out, format.data(), formatters.data(), formatters.size());
+        arrayAppend(out, '\n');
+    }
+
+    return std::string{out.data(), out.size()};
+}
+
+}}
@@ -0,0 +1,294 @@
+#ifndef Corrade_Utility_BinaryLog_h
+#define Corrade_Utility_BinaryLog_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Utility::BinaryLog, macro @ref CORRADE_BINARY_LOG()
+ * @m_since_latest
+ */
+
+#include <cstring>
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Containers/StringView.h"
+#include "Corrade/Utility/StlForwardString.h"
+#include "Corrade/Utility/Utility.h"
+#include "Corrade/Utility/visibility.h"
+
+namespace Corrade { namespace Utility {
+
+namespace Implementation {
+    struct CORRADE_UTILITY_EXPORT BinaryLogSite {
+        /* Assigns a process-wide unique ID */
+        explicit BinaryLogSite() noexcept;
+
+        std::uint32_t id;
+    };
+
+    struct BinaryLogSiteState {
+        /* Absolute offset of the site definition in the log plus one, zero
+           if there's no definition in the log */
+        std::uint64_t definition;
+        /* Absolute offset of the last message from this site */
+        std::uint64_t lastMessage;
+        const char* format;
+    };
+
+    enum class BinaryLogType: std::uint8_t {
+        Bool = 1,
+        Int8, UnsignedInt8, Int16, UnsignedInt16,
+        Int32, UnsignedInt32, Int64, UnsignedInt64,
+        Float, Double,
+        String
+    };
+
+    template<class T, class = void> struct BinaryLogArgument;
+    template<> struct BinaryLogArgument<bool> {
+        static std::size_t size(bool) { return 2; }
+        static char* write(char* out, bool value) {
+            *out++ = char(BinaryLogType::Bool);
+            *out++ = value;
+            return out;
+        }
+    };
+    template<class T, BinaryLogType type> struct BinaryLogArithmeticArgument {
+        static std::size_t size(T) { return 1 + sizeof(T); }
+        static char* write(char* out, T value) {
+            *out = char(type);
+            std::memcpy(out + 1, &value, sizeof(T));
+            return out + 1 + sizeof(T);
+        }
+    };
+    template<std::size_t size, bool isSigned> struct BinaryLogIntegerType;
+    template<> struct BinaryLogIntegerType<1, true>: std::integral_constant<BinaryLogType, BinaryLogType::Int8> {};
+    template<> struct BinaryLogIntegerType<1, false>: std::integral_constant<BinaryLogType, BinaryLogType::UnsignedInt8> {};
+    template<> struct BinaryLogIntegerType<2, true>: std::integral_constant<BinaryLogType, BinaryLogType::Int16> {};
+    template<> struct BinaryLogIntegerType<2, false>: std::integral_constant<BinaryLogType, BinaryLogType::UnsignedInt16> {};
+    template<> struct BinaryLogIntegerType<4, true>: std::integral_constant<BinaryLogType, BinaryLogType::Int32> {};
+    template<> struct BinaryLogIntegerType<4, false>: std::integral_constant<BinaryLogType, BinaryLogType::UnsignedInt32> {};
+    template<> struct BinaryLogIntegerType<8, true>: std::integral_constant<BinaryLogType, BinaryLogType::Int64> {};
+    template<> struct BinaryLogIntegerType<8, false>: std::integral_constant<BinaryLogType, BinaryLogType::UnsignedInt64> {};
+    template<class T> struct BinaryLogArgument<T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type>: BinaryLogArithmeticArgument<T, BinaryLogIntegerType<sizeof(T), std::is_signed<T>::value>::value> {};
+    template<> struct BinaryLogArgument<float>: BinaryLogArithmeticArgument<float, BinaryLogType::Float> {};
+    template<> struct BinaryLogArgument<double>: BinaryLogArithmeticArgument<double, BinaryLogType::Double> {};
+    /* Same as Formatter, enums are recorded as their underlying type */
+    template<class T> struct BinaryLogArgument<T, typename std::enable_if<std::is_enum<T>::value>::type>: BinaryLogArgument<typename std::underlying_type<T>::type> {
+        static std::size_t size(T value) {
+            return BinaryLogArgument<typename std::underlying_type<T>::type>::size(typename std::underlying_type<T>::type(value));
+        }
+        static char* write(char* out, T value) {
+            return BinaryLogArgument<typename std::underlying_type<T>::type>::write(out, typename std::underlying_type<T>::type(value));
+        }
+    };
+    template<> struct BinaryLogArgument<Containers::StringView> {
+        static std::size_t size(Containers::StringView value) {
+            return 1 + sizeof(std::uint32_t) + value.size();
+        }
+        static char* write(char* out, Containers::StringView value) {
+            *out = char(BinaryLogType::String);
+            const std::uint32_t size = value.size();
+            std::memcpy(out + 1, &size, sizeof(std::uint32_t));
+            std::memcpy(out + 1 + sizeof(std::uint32_t), value.data(), size);
+            return out + 1 + sizeof(std::uint32_t) + size;
+        }
+    };
+    template<> struct BinaryLogArgument<const char*>: BinaryLogArgument<Containers::StringView> {};
+    template<> struct BinaryLogArgument<char*>: BinaryLogArgument<Containers::StringView> {};
+
+    inline std::size_t binaryLogSize() { return 0; }
+    template<class T, class ...Args> inline std::size_t binaryLogSize(const T& first, const Args&... next) {
+        return BinaryLogArgument<typename std::decay<T>::type>::size(first) + binaryLogSize(next...);
+    }
+
+    inline void binaryLogWrite(char*) {}
+    template<class T, class ...Args> inline void binaryLogWrite(char* out, const T& first, const Args&... next) {
+        binaryLogWrite(BinaryLogArgument<typename std::decay<T>::type>::write(out, first), next...);
+    }
+}
+
+/**
+@brief Binary log
+@m_since_latest
+
+Records log messages in a binary form into a ring buffer, leaving the
+formatting to a later time. Meant for high-throughput code paths where most
+of the output is never read --- recording a message only copies the raw
+argument bytes and a numeric ID of the place where the message was recorded,
+the text is produced only when (and if) @ref decode() is called on the log
+data. Messages are recorded using the @ref CORRADE_BINARY_LOG() macro, which
+takes a @ref format() string and its arguments:
+
+@snippet Utility.cpp BinaryLog
+
+@section Utility-BinaryLog-arguments Supported argument types
+
+Arguments can be @cpp bool @ce, any integer type, @cpp float @ce,
+@cpp double @ce, enums (recorded as their underlying type), and strings in
+the form of a @cpp const char* @ce or a @ref Containers::StringView. Strings
+are copied into the log. The format string is stored in the log once, at the
+first message recorded from given place, and then again only if the previous
+copy gets overwritten. It's thus expected to be a string literal or a string
+that's otherwise valid for the whole lifetime of the log.
+
+@section Utility-BinaryLog-ring Ring buffer behavior
+
+The log has a fixed capacity. Once it's full, the oldest messages get
+overwritten by new ones. A message that's larger than the whole capacity is
+dropped, which is counted in @ref droppedCount().
+
+The log memory can be either allocated by the log itself, or supplied
+through @ref BinaryLog(Containers::ArrayView<char>) --- for example a file
+mapped with @ref Directory::map(), in which case its contents stay
+decodable even if the application crashes. All state needed for decoding is
+stored inside the memory, so @ref decode() needs only the data returned by
+@ref data(). Argument values are stored in the native byte order, the log is
+thus expected to be decoded on a machine with the same endianness and type
+sizes.
+
+The class isn't thread-safe, each thread is meant to record into its own
+instance.
+*/
+class CORRADE_UTILITY_EXPORT BinaryLog {
+    public:
+        /**
+         * @brief Decode log data
+         *
+         * Expects data returned by @ref data(), either directly or read
+         * back from a file. Returns the messages, each formatted using
+         * @ref format() and terminated with a newline, in the order they
+         * were recorded. If the data are not a valid log, prints a message
+         * to @ref Error and returns @ref Containers::NullOpt. Messages whose
+         * format string got overwritten and wasn't recorded again are
+         * skipped. Include @ref Corrade/Containers/Optional.h to use the
+         * returned value.
+         */
+        static Containers::Optional<std::string> decode(Containers::ArrayView<const char> data);
+
+        /**
+         * @brief Minimal memory size
+         *
+         * Memory passed to @ref BinaryLog(Containers::ArrayView<char>) or
+         * the size passed to @ref BinaryLog(std::size_t) is expected to be
+         * at least this large.
+         */
+        static std::size_t minimalSize();
+
+        /**
+         * @brief Construct with an allocated memory
+         *
+         * Expects that @p size is at least @ref minimalSize(). A part of the
+         * memory is used for the log state, the rest for the messages.
+         */
+        explicit BinaryLog(std::size_t size);
+
+        /**
+         * @brief Construct with an external memory
+         *
+         * Expects that @p memory is at least @ref minimalSize() bytes and
+         * aligned to eight bytes. Previous contents of the memory are
+         * discarded. The memory is expected to stay in scope for the whole
+         * lifetime of the instance.
+         */
+        explicit BinaryLog(Containers::ArrayView<char> memory);
+
+        /** @brief Copying is not allowed */
+        BinaryLog(const BinaryLog&) = delete;
+
+        /** @brief Move constructor */
+        BinaryLog(BinaryLog&&) noexcept;
+
+        ~BinaryLog();
+
+        /** @brief Copying is not allowed */
+        BinaryLog& operator=(const BinaryLog&) = delete;
+
+        /** @brief Move assignment */
+        BinaryLog& operator=(BinaryLog&&) noexcept;
+
+        /**
+         * @brief Log data
+         *
+         * The whole memory of the log, including the log state. Pass it to
+         * @ref decode() to get the messages back.
+         */
+        Containers::ArrayView<const char> data() const { return _data; }
+
+        /**
+         * @brief Count of dropped messages
+         *
+         * Messages that were larger than the whole log capacity.
+         */
+        std::size_t droppedCount() const { return _droppedCount; }
+
+        /** @brief Discard all recorded messages */
+        void clear();
+
+        /**
+         * @brief Record a message
+         *
+         * Not meant to be called directly, use @ref CORRADE_BINARY_LOG()
+         * instead.
+         */
+        template<class ...Args> void record(const Implementation::BinaryLogSite& site, const char* format, const Args&... args) {
+            char* const out = reserve(site.id, format, Implementation::binaryLogSize(args...));
+            if(out) Implementation::binaryLogWrite(out, args...);
+        }
+
+    private:
+        /* Returns a pointer to where the arguments should be written or
+           nullptr if the message is dropped */
+        char* reserve(std::uint32_t site, const char* format, std::size_t size);
+        CORRADE_UTILITY_LOCAL std::uint64_t place(std::size_t size, std::uint64_t protect);
+        CORRADE_UTILITY_LOCAL bool writeDefinition(std::uint32_t site, const char* format, std::uint64_t protect);
+        CORRADE_UTILITY_LOCAL void updateHeader();
+
+        Containers::Array<char> _data;
+        Containers::Array<Implementation::BinaryLogSiteState> _sites;
+        std::uint64_t _head{}, _tail{};
+        std::size_t _capacity;
+        std::size_t _droppedCount{};
+        std::size_t _staleDefinitionCount{};
+};
+
+}}
+
+/** @hideinitializer
+@brief Record a binary log message
+@param log      A @ref Corrade::Utility::BinaryLog "Utility::BinaryLog" instance
+@param ...      Format string, followed by its arguments
+@m_since_latest
+
+The format string is the same as for @ref Corrade::Utility::format()
+"Utility::format()", but it's interpreted only when the log is decoded. See
+@ref Corrade::Utility::BinaryLog "Utility::BinaryLog" for more information.
+*/
+#define CORRADE_BINARY_LOG(log, ...)                                        \
+    do {                                                                    \
+        static const Corrade::Utility::Implementation::BinaryLogSite _corradeBinaryLogSite; \
+        (log).record(_corradeBinaryLogSite, __VA_ARGS__);                   \
+    } while(false)
+
+#endif
@@ -0,0 +1,80 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BinaryReader.h"
+
+#include "Corrade/Utility/Debug.h"
+
+namespace Corrade { namespace Utility {
+
+bool BinaryReader::seek(const std::size_t position) {
+    if(position > _data.size()) {
+        Error{} << "Utility::BinaryReader::seek(): can't seek to position" << position << "in" << _data.size() << "bytes";
+        return false;
+    }
+
+    _position = position;
+    return true;
+}
+
+bool BinaryReader::skip(const std::size_t size) {
+    const char* data;
+    return consume("skip", size, data);
+}
+
+Containers::Optional<Containers::ArrayView<const char>> BinaryReader::readBytes(const std::size_t size) {
+    const char* data;
+    if(!consume("readBytes", size, data)) return {};
+    return Containers::arrayView(data, size);
+}
+
+bool BinaryReader::consume(const char* const function, const std::size_t size, const char*& data) {
+    if(size > _data.size() - _position) {
+        Error{} << "Utility::BinaryReader::" << Debug::nospace << function << Debug::nospace << "(): expected" << size << "bytes at position" << _position << "but got only" << _data.size() - _position;
+        return false;
+    }
+
+    data = _data.data() + _position;
+    _position += size;
+    return true;
+}
+
+bool BinaryReader::consumeArray(const char* const function, const std::size_t count, const std::size_t typeSize, const std::size_t alignment, const char*& data) {
+    /* Check that count*typeSize doesn't overflow before multiplying, the
+       regular size check is then done in consume() below */
+    if(count > ~std::size_t{}/typeSize) {
+        Error{} << "Utility::BinaryReader::" << Debug::nospace << function << Debug::nospace << "(): expected" << count << "items of" << typeSize << "bytes at position" << _position << "but got only" << _data.size() - _position << "bytes";
+        return false;
+    }
+
+    if(reinterpret_cast<std::uintptr_t>(_data.data() + _position) % alignment) {
+        Error{} << "Utility::BinaryReader::" << Debug::nospace << function << Debug::nospace << "(): data at position" << _position << "not aligned to" << alignment << "bytes";
+        return false;
+    }
+
+    return consume(function, count*typeSize, data);
+}
+
+}}
@@ -0,0 +1,240 @@
+#ifndef Corrade_Utility_BinaryReader_h
+#define Corrade_Utility_BinaryReader_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Utility::BinaryReader
+ * @m_since_latest
+ */
+
+#include <cstdint>
+#include <cstring>
+
+#include "Corrade/Containers/ArrayView.h"
+#include "Corrade/Containers/Optional.h"
+#include "Corrade/Utility/EndiannessBatch.h"
+#include "Corrade/Utility/visibility.h"
+
+namespace Corrade { namespace Utility {
+
+/**
+@brief Binary data reader
+@m_since_latest
+
+Reads scalars and arrays from a contiguous block of memory, such as a file
+mapped with @ref Directory::mapRead(), advancing a read position with each
+operation. Every read is bounds-checked --- if there's not enough data left,
+a message is printed to @ref Error, the read position is left unchanged and
+the function returns @ref Containers::NullOpt or @cpp false @ce. Example
+usage, parsing a header with a Little-Endian magic and a Big-Endian count
+followed by an array of native-endian floats:
+
+@snippet Utility.cpp BinaryReader-usage
+
+@section Utility-BinaryReader-endianness Endianness and copies
+
+The @ref read(), @ref readArray() and @ref readBytes() functions interpret
+the data as-is. While @ref read() returns a copy, @ref readArray() and
+@ref readBytes() return views pointing directly into the original data
+without copying anything. For these to be usable, the data have to be in the
+native endianness and @ref readArray() additionally requires them to be
+suitably aligned for given type.
+
+The @ref readLittleEndian() and @ref readBigEndian() functions convert the
+value from given endianness, @ref readLittleEndianInto() and
+@ref readBigEndianInto() copy the data to a caller-provided array and convert
+them. If the data are suitably aligned, the conversion is done while copying
+using @ref Endianness::swapInto(const Containers::StridedArrayView1D<const T>&, const Containers::StridedArrayView1D<T>&),
+otherwise all values are converted at once after the copy using
+@ref Endianness::swapInPlace(const Containers::StridedArrayView1D<T>&). On a
+system with matching endianness it's just a copy.
+@see @ref BinaryWriter
+*/
+class CORRADE_UTILITY_EXPORT BinaryReader {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * The @p data are expected to stay in scope for the whole lifetime of
+         * the reader and of all views returned from it.
+         */
+        explicit BinaryReader(Containers::ArrayView<const void> data) noexcept: _data{static_cast<const char*>(data.data()), data.size()}, _position{} {}
+
+        /** @brief Data being read */
+        Containers::ArrayView<const char> data() const { return _data; }
+
+        /** @brief Read position */
+        std::size_t position() const { return _position; }
+
+        /** @brief Count of bytes remaining after the read position */
+        std::size_t remaining() const { return _data.size() - _position; }
+
+        /** @brief Whether the read position is at the end of the data */
+        bool atEnd() const { return _position == _data.size(); }
+
+        /**
+         * @brief Set the read position
+         *
+         * If @p position is larger than size of the data, prints a message
+         * to @ref Error and returns @cpp false @ce, leaving the read
+         * position unchanged.
+         */
+        bool seek(std::size_t position);
+
+        /**
+         * @brief Skip bytes
+         *
+         * If less than @p size bytes remain, prints a message to
+         * @ref Error and returns @cpp false @ce, leaving the read position
+         * unchanged.
+         */
+        bool skip(std::size_t size);
+
+        /**
+         * @brief Read raw bytes
+         *
+         * Returns a view pointing directly into @ref data(). If less than
+         * @p size bytes remain, prints a message to @ref Error and returns
+         * @ref Containers::NullOpt.
+         */
+        Containers::Optional<Containers::ArrayView<const char>> readBytes(std::size_t size);
+
+        /**
+         * @brief Read a value in native endianness
+         *
+         * The value doesn't need to be aligned. If less than
+         * @cpp sizeof(T) @ce bytes remain, prints a message to @ref Error
+         * and returns @ref Containers::NullOpt.
+         * @see @ref readLittleEndian(), @ref readBigEndian()
+         */
+        template<class T> Containers::Optional<T> read() {
+            const char* data;
+            if(!consume("read", sizeof(T), data)) return {};
+            T value;
+            std::memcpy(&value, data, sizeof(T));
+            return value;
+        }
+
+        /**
+         * @brief Read a Little-Endian value
+         *
+         * Like @ref read(), but additionally converts the value from
+         * Little-Endian using @ref Endianness::littleEndian().
+         */
+        template<class T> Containers::Optional<T> readLittleEndian() {
+            const char* data;
+            if(!consume("readLittleEndian", sizeof(T), data)) return {};
+            T value;
+            std::memcpy(&value, data, sizeof(T));
+            return Endianness::littleEndian(value);
+        }
+
+        /**
+         * @brief Read a Big-Endian value
+         *
+         * Like @ref read(), but additionally converts the value from
+         * Big-Endian using @ref Endianness::bigEndian().
+         */
+        template<class T> Containers::Optional<T> readBigEndian() {
+            const char* data;
+            if(!consume("readBigEndian", sizeof(T), data)) return {};
+            T value;
+            std::memcpy(&value, data, sizeof(T));
+            return Endianness::bigEndian(value);
+        }
+
+        /**
+         * @brief Read an array in native endianness without copying
+         *
+         * Returns a view pointing directly into @ref data(). If less than
+         * @cpp count*sizeof(T) @ce bytes remain or the data at the read
+         * position aren't aligned to @cpp alignof(T) @ce, prints a message
+         * to @ref Error and returns @ref Containers::NullOpt. Use
+         * @ref readLittleEndianInto() or @ref readBigEndianInto() for data
+         * in a non-native endianness or without a guaranteed alignment.
+         */
+        template<class T> Containers::Optional<Containers::ArrayView<const T>> readArray(std::size_t count) {
+            const char* data;
+            if(!consumeArray("readArray", count, sizeof(T), alignof(T), data))
+                return {};
+            return Containers::arrayView(reinterpret_cast<const T*>(data), count);
+        }
+
+        /**
+         * @brief Read a Little-Endian array into a view
+         *
+         * Copies @cpp out.size()*sizeof(T) @ce bytes into @p out and
+         * converts them from Little-Endian. The data don't need to be
+         * aligned. If not enough bytes remain, prints a message to
+         * @ref Error and returns @cpp false @ce, leaving @p out untouched.
+         */
+        template<class T> bool readLittleEndianInto(const Containers::ArrayView<T>& out) {
+            return readInto("readLittleEndianInto", out, Endianness::isBigEndian());
+        }
+
+        /**
+         * @brief Read a Big-Endian array into a view
+         *
+         * Like @ref readLittleEndianInto(), but converting from Big-Endian.
+         */
+        template<class T> bool readBigEndianInto(const Containers::ArrayView<T>& out) {
+            return readInto("readBigEndianInto", out, !Endianness::isBigEndian());
+        }
+
+    private:
+        /* Save a pointer to the current position and advance it by given
+           size or print an error mentioning given function and return
+           false */
+        bool consume(const char* function, std::size_t size, const char*& data);
+        /* Like consume(), but for count items of given type size and
+           alignment, checking for overflow */
+        bool consumeArray(const char* function, std::size_t count, std::size_t typeSize, std::size_t alignment, const char*& data);
+        template<class T> bool readInto(const char* function, const Containers::ArrayView<T>& out, bool swap);
+
+        Containers::ArrayView<const char> _data;
+        std::size_t _position;
+};
+
+template<class T> bool BinaryReader::readInto(const char* const function, const Containers::ArrayView<T>& out, const bool swap) {
+    const char* data;
+    if(!consume(function, out.size()*sizeof(T), data)) return false;
+
+    /* If the source is aligned, convert while copying to touch the memory
+       just once, otherwise copy and convert in-place after. Either pointer
+       may be null if the size is zero. */
+    if(swap && reinterpret_cast<std::uintptr_t>(data) % alignof(T) == 0) {
+        Endianness::swapInto(Containers::arrayView(reinterpret_cast<const T*>(data), out.size()), out);
+    } else if(!out.empty()) {
+        std::memcpy(out.data(), data, out.size()*sizeof(T));
+        if(swap) Endianness::swapInPlace(out);
+    }
+
+    return true;
+}
+
+}}
+
+#endif
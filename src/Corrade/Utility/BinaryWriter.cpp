@@ -0,0 +1,58 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BinaryWriter.h"
+
+#include <utility>
+
+#include "Corrade/Containers/GrowableArray.h"
+
+namespace Corrade { namespace Utility {
+
+BinaryWriter::BinaryWriter() noexcept = default;
+
+BinaryWriter::BinaryWriter(Containers::Array<char>&& data) noexcept: _data{std::move(data)} {}
+
+BinaryWriter& BinaryWriter::reserve(const std::size_t capacity) {
+    Containers::arrayReserve(_data, capacity);
+    return *this;
+}
+
+Containers::ArrayView<char> BinaryWriter::allocate(const std::size_t size) {
+    return Containers::arrayAppend(_data, Containers::NoInit, size);
+}
+
+BinaryWriter& BinaryWriter::writeBytes(const Containers::ArrayView<const void> data) {
+    const Containers::ArrayView<char> out = allocate(data.size());
+    /* The source may be null if the size is zero */
+    if(!out.empty()) std::memcpy(out.data(), data.data(), out.size());
+    return *this;
+}
+
+Containers::Array<char> BinaryWriter::release() {
+    return std::move(_data);
+}
+
+}}
@@ -0,0 +1,208 @@
+#ifndef Corrade_Utility_BinaryWriter_h
+#define Corrade_Utility_BinaryWriter_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Utility::BinaryWriter
+ * @m_since_latest
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Utility/EndiannessBatch.h"
+#include "Corrade/Utility/visibility.h"
+
+namespace Corrade { namespace Utility {
+
+/**
+@brief Binary data writer
+@m_since_latest
+
+Counterpart to @ref BinaryReader, appending scalars and arrays to a growable
+@ref Containers::Array with an optional endianness conversion. Example usage,
+producing data that the @ref BinaryReader snippet is able to parse:
+
+@snippet Utility.cpp BinaryWriter-usage
+
+The @ref write(), @ref writeArray() and @ref writeBytes() functions copy the
+data as-is, @ref writeLittleEndian() and @ref writeBigEndian() convert the
+value to given endianness first. The @ref writeLittleEndianArray() and
+@ref writeBigEndianArray() functions convert the whole array while copying it
+to the output using
+@ref Endianness::swapInto(const Containers::StridedArrayView1D<const T>&, const Containers::StridedArrayView1D<T>&)
+if the destination is suitably aligned, falling back to converting one value
+at a time otherwise. On a system with matching endianness the conversion is a
+no-op. To write data directly into the output without an intermediate copy,
+use @ref allocate().
+
+The output is stored in an array with a growable deleter, see
+@ref Containers-Array-growable for more information.
+*/
+class CORRADE_UTILITY_EXPORT BinaryWriter {
+    public:
+        /** @brief Constructor */
+        explicit BinaryWriter() noexcept;
+
+        /**
+         * @brief Construct appending to existing data
+         *
+         * Data written will be appended after existing contents of @p data.
+         */
+        explicit BinaryWriter(Containers::Array<char>&& data) noexcept;
+
+        /** @brief Data written so far */
+        Containers::ArrayView<char> data() { return _data; }
+        Containers::ArrayView<const char> data() const { return _data; } /**< @overload */
+
+        /** @brief Count of bytes written so far */
+        std::size_t size() const { return _data.size(); }
+
+        /**
+         * @brief Reserve memory for given total size
+         *
+         * Calls @ref Containers::arrayReserve() on the output, useful to
+         * avoid reallocations if the final size is known upfront.
+         */
+        BinaryWriter& reserve(std::size_t capacity);
+
+        /**
+         * @brief Allocate bytes at the end
+         *
+         * Returns a view on @p size newly added bytes at the end of the
+         * output that can be written into directly. Contents of the bytes
+         * are uninitialized. The view is invalidated by any subsequent write.
+         */
+        Containers::ArrayView<char> allocate(std::size_t size);
+
+        /**
+         * @brief Write raw bytes
+         *
+         * @see @ref writeArray()
+         */
+        BinaryWriter& writeBytes(Containers::ArrayView<const void> data);
+
+        /**
+         * @brief Write a value in native endianness
+         *
+         * @see @ref writeLittleEndian(), @ref writeBigEndian()
+         */
+        template<class T> BinaryWriter& write(const T& value) {
+            std::memcpy(allocate(sizeof(T)).data(), &value, sizeof(T));
+            return *this;
+        }
+
+        /**
+         * @brief Write a Little-Endian value
+         *
+         * Converts @p value to Little-Endian using
+         * @ref Endianness::littleEndian() and writes it.
+         */
+        template<class T> BinaryWriter& writeLittleEndian(T value) {
+            return write(Endianness::littleEndian(value));
+        }
+
+        /**
+         * @brief Write a Big-Endian value
+         *
+         * Converts @p value to Big-Endian using
+         * @ref Endianness::bigEndian() and writes it.
+         */
+        template<class T> BinaryWriter& writeBigEndian(T value) {
+            return write(Endianness::bigEndian(value));
+        }
+
+        /** @brief Write an array in native endianness */
+        template<class T> BinaryWriter& writeArray(const Containers::ArrayView<T>& values) {
+            return writeBytes(Containers::ArrayView<const void>{values});
+        }
+
+        /**
+         * @brief Write a Little-Endian array
+         *
+         * See the class documentation for details about how the conversion
+         * is done.
+         */
+        template<class T> BinaryWriter& writeLittleEndianArray(const Containers::ArrayView<T>& values) {
+            #ifdef CORRADE_TARGET_BIG_ENDIAN
+            return writeSwapped(values);
+            #else
+            return writeArray(values);
+            #endif
+        }
+
+        /**
+         * @brief Write a Big-Endian array
+         *
+         * See the class documentation for details about how the conversion
+         * is done.
+         */
+        template<class T> BinaryWriter& writeBigEndianArray(const Containers::ArrayView<T>& values) {
+            #ifndef CORRADE_TARGET_BIG_ENDIAN
+            return writeSwapped(values);
+            #else
+            return writeArray(values);
+            #endif
+        }
+
+        /**
+         * @brief Release the written data
+         *
+         * The writer is empty afterwards. The returned array has a growable
+         * deleter, call @ref Containers::arrayShrink() on it if you need it
+         * to have the default deleter.
+         */
+        Containers::Array<char> release();
+
+    private:
+        template<class T> BinaryWriter& writeSwapped(const Containers::ArrayView<T>& values);
+
+        Containers::Array<char> _data;
+};
+
+template<class T> BinaryWriter& BinaryWriter::writeSwapped(const Containers::ArrayView<T>& values) {
+    typedef typename std::remove_const<T>::type U;
+    const Containers::ArrayView<char> out = allocate(values.size()*sizeof(U));
+    if(out.empty()) return *this;
+
+    /* Swap in bulk while copying if the output is aligned for the type,
+       which is usually the case when writing a sequence of same-sized
+       values */
+    if(reinterpret_cast<std::uintptr_t>(out.data()) % alignof(U) == 0) {
+        Endianness::swapInto(Containers::ArrayView<const U>{values}, Containers::arrayCast<U>(out));
+    } else for(std::size_t i = 0; i != values.size(); ++i) {
+        const U value = Endianness::swap(values[i]);
+        std::memcpy(out.data() + i*sizeof(U), &value, sizeof(U));
+    }
+
+    return *this;
+}
+
+}}
+
+#endif
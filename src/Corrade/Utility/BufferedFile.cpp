@@ -0,0 +1,82 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+    Copyright © 2019 Jonathan Hale <squareys@googlemail.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BufferedFile.h"
+
+#include <utility>
+
+#include "Corrade/Containers/GrowableArray.h"
+
+namespace Corrade { namespace Utility {
+
+BufferedFile::BufferedFile(std::FILE* const file, const std::size_t flushThreshold): _file{file}, _flushThreshold{flushThreshold} {}
+
+BufferedFile::BufferedFile(BufferedFile&& other) noexcept: _file{other._file}, _data{std::move(other._data)}, _flushThreshold{other._flushThreshold} {
+    other._file = nullptr;
+}
+
+BufferedFile::~BufferedFile() {
+    if(_file) flush();
+}
+
+BufferedFile& BufferedFile::operator=(BufferedFile&& other) noexcept {
+    using std::swap;
+    swap(_file, other._file);
+    swap(_data, other._data);
+    swap(_flushThreshold, other._flushThreshold);
+    return *this;
+}
+
+void BufferedFile::write(const Containers::ArrayView<const char> data) {
+    Containers::arrayAppend(_data, data);
+    flushIfOverThreshold();
+}
+
+void BufferedFile::flush() {
+    if(_data.empty()) return;
+    std::fwrite(_data, _data.size(), 1, _file);
+    Containers::arrayRemoveSuffix(_data, _data.size());
+}
+
+void BufferedFile::flushIfOverThreshold() {
+    if(_data.size() >= _flushThreshold) flush();
+}
+
+namespace Implementation {
+
+void formatInto(BufferedFile& file, const char* const format, BufferFormatter* const formatters, const std::size_t formatterCount) {
+    formatInto(file._data, format, formatters, formatterCount);
+    file.flushIfOverThreshold();
+}
+
+void formatInto(BufferedFile& file, const FormatChunk* const chunks, const std::size_t chunkCount, BufferFormatter* const formatters) {
+    formatInto(file._data, chunks, chunkCount, formatters);
+    file.flushIfOverThreshold();
+}
+
+}
+
+}}
@@ -0,0 +1,185 @@
+#ifndef Corrade_Utility_BufferedFile_h
+#define Corrade_Utility_BufferedFile_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Utility::BufferedFile
+ * @m_since_latest
+ */
+
+#include <cstdio>
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Utility/Format.h"
+
+namespace Corrade { namespace Utility {
+
+namespace Implementation {
+    CORRADE_UTILITY_EXPORT void formatInto(BufferedFile& file, const char* format, BufferFormatter* formatters, std::size_t formattersCount);
+    CORRADE_UTILITY_EXPORT void formatInto(BufferedFile& file, const FormatChunk* chunks, std::size_t chunkCount, BufferFormatter* formatters);
+}
+
+/**
+@brief Buffered file output
+@m_since_latest
+
+Collects output in a growable @ref Containers::Array and writes it to the
+underlying file in larger chunks. Compared to
+@ref formatInto(std::FILE*, const char*, const Args&... args), which calls
+into @ref std::fwrite() (and thus locks the file stream) for every literal and
+every formatted value, formatting into a @ref BufferedFile calls
+@ref std::fwrite() only once the buffered data reach @ref flushThreshold() or
+when @ref flush() is called explicitly. The remaining data are flushed on
+destruction. Example usage:
+
+@snippet Utility.cpp BufferedFile
+
+With the flush threshold set to @cpp 0 @ce, the data are written after each
+@ref write() or @ref formatInto() call, but still with a single
+@ref std::fwrite() per call. With the threshold set to
+@ref std::numeric_limits::max(), the whole output is kept in memory until
+@ref flush() is called or the instance is destroyed. The class doesn't take
+ownership of the file, closing it is the user's responsibility and has to
+happen only after the instance is destroyed.
+
+@experimental
+*/
+class CORRADE_UTILITY_EXPORT BufferedFile {
+    public:
+        /**
+         * @brief Constructor
+         * @param file              File to write to
+         * @param flushThreshold    Buffered size at which the data get
+         *      written to the file
+         */
+        explicit BufferedFile(std::FILE* file, std::size_t flushThreshold = 65536);
+
+        /** @brief Copying is not allowed */
+        BufferedFile(const BufferedFile&) = delete;
+
+        /** @brief Move constructor */
+        BufferedFile(BufferedFile&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Calls @ref flush().
+         */
+        ~BufferedFile();
+
+        /** @brief Copying is not allowed */
+        BufferedFile& operator=(const BufferedFile&) = delete;
+
+        /** @brief Move assignment */
+        BufferedFile& operator=(BufferedFile&& other) noexcept;
+
+        /** @brief Underlying file */
+        std::FILE* file() const { return _file; }
+
+        /** @brief Flush threshold */
+        std::size_t flushThreshold() const { return _flushThreshold; }
+
+        /**
+         * @brief Set flush threshold
+         * @return Reference to self (for method chaining)
+         *
+         * Doesn't flush the data immediately even if the currently buffered
+         * size is over the new threshold, that happens on the next
+         * @ref write() or @ref formatInto() call.
+         */
+        BufferedFile& setFlushThreshold(std::size_t threshold) {
+            _flushThreshold = threshold;
+            return *this;
+        }
+
+        /** @brief Data not yet written to the file */
+        Containers::ArrayView<const char> buffered() const { return _data; }
+
+        /**
+         * @brief Write data
+         *
+         * Appends @p data to the buffer and calls @ref flush() if the
+         * buffered size reaches @ref flushThreshold().
+         */
+        void write(Containers::ArrayView<const char> data);
+
+        /**
+         * @brief Write buffered data to the file
+         *
+         * Writes all buffered data with a single @ref std::fwrite() call and
+         * clears the buffer, keeping its capacity. Doesn't call
+         * @ref std::fflush(), so the data may still stay in the file stream
+         * buffers.
+         */
+        void flush();
+
+    private:
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        friend void Implementation::formatInto(BufferedFile&, const char*, Implementation::BufferFormatter*, std::size_t);
+        friend void Implementation::formatInto(BufferedFile&, const Implementation::FormatChunk*, std::size_t, Implementation::BufferFormatter*);
+        #endif
+
+        void flushIfOverThreshold();
+
+        std::FILE* _file;
+        Containers::Array<char> _data;
+        std::size_t _flushThreshold;
+};
+
+/**
+@brief Format a string into a buffered file
+@m_since_latest
+
+Appends formatted output to the @p file buffer and writes it to the
+underlying file once the buffered size reaches
+@ref BufferedFile::flushThreshold(). See @ref format() for more information
+about usage and templating language.
+
+@experimental
+*/
+template<class ...Args> void formatInto(BufferedFile& file, const char* format, const Args&... args) {
+    Implementation::BufferFormatter formatters[sizeof...(args) + 1] { Implementation::BufferFormatter{args}..., {} };
+    Implementation::formatInto(file, format, formatters, sizeof...(args));
+}
+
+/**
+@brief Format a string into a buffered file using a compiled format string
+@m_since_latest
+
+Same as @ref formatInto(BufferedFile&, const char*, const Args&... args),
+except that the format string is already parsed and its argument count is
+checked at compile time.
+@experimental
+*/
+template<std::size_t argumentCount, std::size_t chunkCapacity, class ...Args> void formatInto(BufferedFile& file, const CompiledFormat<argumentCount, chunkCapacity>& format, const Args&... args) {
+    static_assert(sizeof...(args) == argumentCount, "argument count doesn't match the format string");
+    Implementation::BufferFormatter formatters[sizeof...(args) + 1] { Implementation::BufferFormatter{args}..., {} };
+    Implementation::formatInto(file, format.chunks(), format.chunkCount(), formatters);
+}
+
+}}
+
+#endif
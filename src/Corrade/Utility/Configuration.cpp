@@ -26,7 +26,12 @@
 #include "Configuration.h"
 
 #include <algorithm>
-#include <sstream>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -34,10 +39,45 @@
 #include "Corrade/Utility/Assert.h"
 #include "Corrade/Utility/DebugStl.h"
 #include "Corrade/Utility/Directory.h"
+#include "Corrade/Utility/Endianness.h"
+#include "Corrade/Utility/Profiler.h"
 #include "Corrade/Utility/String.h"
+#include "Corrade/Utility/Implementation/configurationSnapshot.h"
+
+#ifdef CORRADE_TARGET_WINDOWS
+#include "Corrade/Utility/Unicode.h"
+#if !defined(CORRADE_TARGET_WINDOWS_RT)
+#include <windows.h>
+#endif
+#endif
 
 namespace Corrade { namespace Utility {
 
+struct Configuration::MappedFile {
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    Containers::Array<const char, Directory::MapDeleter> data;
+    #endif
+};
+
+/* Readers announce themselves in the acquiring counter before loading the
+   published pointer and leave after they took a reference. A retired
+   snapshot can thus be released only once the counter is observed to be zero
+   after the swap --- then every reader either already holds its own
+   reference or will see the newly published pointer. If there are readers
+   in progress, the retired snapshots are kept until the next publish(), so
+   neither side ever waits for the other. */
+struct Configuration::SnapshotState {
+    ~SnapshotState() {
+        /* Releases the reference held by the published pointer */
+        const ConfigurationSnapshot last{published.load(std::memory_order_relaxed)};
+    }
+
+    std::atomic<Implementation::ConfigurationSnapshotData*> published{};
+    /* Modified by the const snapshot() */
+    mutable std::atomic<std::size_t> acquiring{};
+    std::vector<ConfigurationSnapshot> retired;
+};
+
 Configuration::Configuration(const Flags flags): ConfigurationGroup(this), _flags(static_cast<InternalFlag>(std::uint32_t(flags))) {}
 
 Configuration::Configuration(const std::string& filename, const Flags flags): ConfigurationGroup(this), _filename(flags & Flag::ReadOnly ? std::string() : filename), _flags(static_cast<InternalFlag>(std::uint32_t(flags))|InternalFlag::IsValid) {
@@ -50,7 +90,37 @@ Configuration::Configuration(const std::string& filename, const Flags flags): Co
         return;
     }
 
-    if(parse(Directory::read(filename))) return;
+    /* In read-only mode memory-map the file and reference the keys and
+       values directly from it. If the mapping fails (which is also the case
+       for empty files), fall back to reading the file. */
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    if(flags & Flag::ReadOnly) {
+        Containers::Array<const char, Directory::MapDeleter> data;
+        {
+            Error redirectError{nullptr};
+            data = Directory::mapRead(filename);
+        }
+
+        if(data) {
+            _mappedFile.reset(new MappedFile{std::move(data)});
+            if(parse(_mappedFile->data)) return;
+
+            /* Error, reset everything back. No value references the mapping
+               anymore after a failed parse. */
+            _mappedFile = nullptr;
+            _filename = {};
+            _flags &= ~InternalFlag::IsValid;
+            return;
+        }
+    }
+    #endif
+
+    Containers::Array<char> data = Directory::read(filename);
+    if(parse(data)) {
+        /* With incremental save the group values point into the data */
+        if(flags & Flag::IncrementalSave) _savedData = std::move(data);
+        return;
+    }
 
     /* Error, reset everything back */
     _filename = {};
@@ -66,10 +136,28 @@ Configuration::Configuration(std::istream& in, const Flags flags): Configuration
 
     /** @todo deprecate and remove completely */
     const std::string data{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+
+    /* With incremental save the group values point into the data, so parse
+       a copy that can be kept */
+    if(flags & Flag::IncrementalSave) {
+        _savedData = Containers::Array<char>{Containers::NoInit, data.size()};
+        std::copy(data.begin(), data.end(), _savedData.begin());
+        if(parse(_savedData)) _flags |= InternalFlag::IsValid;
+        return;
+    }
+
     if(parse({data.data(), data.size()})) _flags |= InternalFlag::IsValid;
 }
 
-Configuration::Configuration(Configuration&& other): ConfigurationGroup{std::move(other)}, _filename{std::move(other._filename)}, _flags{other._flags} {
+/* Not delegating to ConfigurationGroup move, as that would detach all values
+   from the memory-mapped file, which is moved together with them */
+Configuration::Configuration(Configuration&& other): ConfigurationGroup{this}, _filename{std::move(other._filename)}, _flags{other._flags}, _mappedFile{std::move(other._mappedFile)}, _snapshotState{std::move(other._snapshotState)}, _savedData{std::move(other._savedData)} {
+    std::swap(_values, other._values);
+    std::swap(_groups, other._groups);
+    std::swap(_savedValues, other._savedValues);
+    /* Resets the hash index, if any */
+    other.clear();
+
     /* Redirect configuration pointer to this instance */
     setConfigurationPointer(this);
 }
@@ -77,7 +165,18 @@ Configuration::Configuration(Configuration&& other): ConfigurationGroup{std::mov
 Configuration::~Configuration() { if(_flags & InternalFlag::Changed) save(); }
 
 Configuration& Configuration::operator=(Configuration&& other) {
-    ConfigurationGroup::operator=(std::move(other));
+    /* Again not delegating to ConfigurationGroup move, the current values
+       may reference the current memory-mapped file so they need to be
+       destroyed before it */
+    clear();
+    std::swap(_values, other._values);
+    std::swap(_groups, other._groups);
+    std::swap(_savedValues, other._savedValues);
+    /* Resets the hash index, if any */
+    other.clear();
+    _mappedFile = std::move(other._mappedFile);
+    _snapshotState = std::move(other._snapshotState);
+    _savedData = std::move(other._savedData);
     _filename = std::move(other._filename);
     _flags = other._flags;
 
@@ -87,6 +186,33 @@ Configuration& Configuration::operator=(Configuration&& other) {
     return *this;
 }
 
+void Configuration::publish() {
+    if(!_snapshotState) _snapshotState.emplace();
+    SnapshotState& state = *_snapshotState;
+
+    ConfigurationSnapshot snapshot = snapshotInternal();
+    if(snapshot._data == state.published.load(std::memory_order_relaxed))
+        return;
+
+    /* The published pointer takes over the reference, the previous one gets
+       adopted by the retired list */
+    if(Implementation::ConfigurationSnapshotData* const previous = state.published.exchange(snapshot.release()))
+        state.retired.push_back(ConfigurationSnapshot{previous});
+    if(!state.acquiring.load())
+        state.retired.clear();
+}
+
+ConfigurationSnapshot Configuration::snapshot() const {
+    if(!_snapshotState) return {};
+    const SnapshotState& state = *_snapshotState;
+
+    state.acquiring.fetch_add(1);
+    Implementation::ConfigurationSnapshotData* const data = state.published.load();
+    data->references.fetch_add(1, std::memory_order_relaxed);
+    state.acquiring.fetch_sub(1, std::memory_order_release);
+    return ConfigurationSnapshot{data};
+}
+
 void Configuration::setConfigurationPointer(ConfigurationGroup* group) {
     group->_configuration = this;
 
@@ -103,7 +229,59 @@ namespace {
     constexpr const char Bom[] = "\xEF\xBB\xBF";
 }
 
+namespace {
+    /* 0x89 isn't valid at the start of UTF-8 text, so the binary data can't
+       be confused with a text file */
+    constexpr const char BinaryMagic[]{'\x89', 'C', 'F', 'G'};
+    constexpr std::uint32_t BinaryVersion = 1;
+
+    enum: std::uint32_t {
+        BinaryFlagHasBom = 1 << 0,
+        BinaryFlagWindowsEol = 1 << 1
+    };
+
+    /* Everything is stored as 32-bit little-endian integers. Not using structs
+       mapped directly onto the data to avoid alignment and endianness
+       issues. */
+    enum: std::size_t {
+        /* magic, version, flags, group count, value count, string table
+           size */
+        BinaryHeaderSize = 6*4,
+        /* name offset, name size, first value, value count, first child,
+           child count */
+        BinaryGroupSize = 6*4,
+        /* key offset, key size, value offset, value size */
+        BinaryValueSize = 4*4
+    };
+
+    inline std::uint32_t readBinary(const char* const data, const std::size_t i) {
+        std::uint32_t value;
+        std::memcpy(&value, data + i*4, 4);
+        return Endianness::littleEndian(value);
+    }
+
+    inline void writeBinary(char*& out, std::uint32_t value) {
+        value = Endianness::littleEndian(value);
+        std::memcpy(out, &value, 4);
+        out += 4;
+    }
+}
+
 bool Configuration::parse(Containers::ArrayView<const char> in) {
+    CORRADE_PROFILE_SCOPE("Utility::Configuration::parse()");
+
+    /* Binary representation */
+    if(in.size() >= 4 && std::memcmp(in.data(), BinaryMagic, 4) == 0) {
+        if(const char* const error = parseBinary(in)) {
+            Error() << "Utility::Configuration::Configuration():" << error;
+            clear();
+            return false;
+        }
+
+        _flags |= InternalFlag::Binary;
+        return true;
+    }
+
     /* Oh, BOM, eww */
     if(in.size() >= 3 && in[0] == Bom[0] && in[1] == Bom[1] && in[2] == Bom[2]) {
         _flags |= InternalFlag::HasBom;
@@ -125,7 +303,16 @@ bool Configuration::parse(Containers::ArrayView<const char> in) {
 std::pair<Containers::ArrayView<const char>, const char*> Configuration::parse(Containers::ArrayView<const char> in, ConfigurationGroup* group, const std::string& fullPath) {
     CORRADE_INTERNAL_ASSERT(fullPath.empty() || String::endsWith(fullPath, '/'));
 
-    std::string buffer;
+    /* If parsing a memory-mapped file, keys and values are stored as views
+       into it instead of being copied */
+    const bool mapped = !!_mappedFile;
+
+    /* With Flag::IncrementalSave remember where the values of this group are
+       in the data. They end at the first group header, which is the very
+       first line for groups created from a nested group shorthand. */
+    const bool recordValues = (_flags & InternalFlag::IncrementalSave) && !(_flags & (InternalFlag::ReadOnly|InternalFlag::SkipComments|InternalFlag::ForceUnixEol|InternalFlag::ForceWindowsEol));
+    const char* const valuesBegin = in.data();
+    bool valuesEnded = false;
 
     /* Parse file */
     bool multiLineValue = false;
@@ -134,54 +321,70 @@ std::pair<Containers::ArrayView<const char>, const char*> Configuration::parse(C
 
         /* Extract the line and ignore the newline character after it, if any */
         const char* end = std::find(in.begin(), in.end(), '\n');
-        buffer.assign(in.begin(), end);
+        Containers::StringView line{in.begin(), std::size_t(end - in.begin())};
         in = in.suffix(end == in.end() ? end : end + 1);
 
         /* Windows EOL */
-        if(!buffer.empty() && buffer.back() == '\r')
+        if(!line.empty() && line.back() == '\r')
             _flags |= InternalFlag::WindowsEol;
 
         /* Multi-line value */
         if(multiLineValue) {
+            ConfigurationGroup::Value& value = group->_values.back();
+
             /* End of multi-line value */
-            if(String::trim(buffer) == "\"\"\"") {
-                /* Remove trailing newline, if present */
-                if(!group->_values.back().value.empty()) {
-                    CORRADE_INTERNAL_ASSERT(group->_values.back().value.back() == '\n');
-                    group->_values.back().value.resize(group->_values.back().value.size()-1);
+            if(line.trimmed() == "\"\"\"") {
+                /* Remove trailing newline, if present. The mapped value is
+                   decoded only on access, nothing to do there. */
+                if(!mapped && !value.value.empty()) {
+                    CORRADE_INTERNAL_ASSERT(value.value.back() == '\n');
+                    value.value.resize(value.value.size()-1);
                 }
 
                 multiLineValue = false;
                 continue;
             }
 
+            /* Extend the mapped value over the whole line including the
+               newline */
+            if(mapped) {
+                value.mappedValue = {value.mappedValue.data(), std::size_t(in.data() - value.mappedValue.data())};
+                continue;
+            }
+
             /* Remove Windows EOL, if present */
-            if(!buffer.empty() && buffer.back() == '\r') buffer.resize(buffer.size()-1);
+            if(!line.empty() && line.back() == '\r') line = line.except(1);
 
             /* Append it (with newline) to current value */
-            group->_values.back().value += buffer;
-            group->_values.back().value += '\n';
+            value.value.append(line.data(), line.size());
+            value.value += '\n';
             continue;
         }
 
-        /* Trim buffer */
-        String::trimInPlace(buffer);
+        /* Trim the line */
+        line = line.trimmed();
 
         /* Empty line */
-        if(buffer.empty()) {
+        if(line.empty()) {
             if(_flags & InternalFlag::SkipComments) continue;
 
             /* Save it only if this is not the last one */
             if(in) group->_values.emplace_back();
 
         /* Group header */
-        } else if(buffer[0] == '[') {
+        } else if(line[0] == '[') {
+            if(!valuesEnded) {
+                if(recordValues)
+                    group->_savedValues = {valuesBegin, std::size_t(currentLine.data() - valuesBegin)};
+                valuesEnded = true;
+            }
 
             /* Check ending bracket */
-            if(buffer[buffer.size()-1] != ']')
+            if(line.back() != ']')
                 return {nullptr, "missing closing bracket for a group header"};
 
-            const std::string nextGroup = String::trim(buffer.substr(1, buffer.size()-2));
+            const Containers::StringView nextGroupView = line.slice(1, line.size() - 1).trimmed();
+            const std::string nextGroup{nextGroupView.data(), nextGroupView.size()};
 
             if(nextGroup.empty())
                 return {nullptr, "empty group name"};
@@ -226,81 +429,348 @@ std::pair<Containers::ArrayView<const char>, const char*> Configuration::parse(C
             } else return {currentLine, nullptr};
 
         /* Comment */
-        } else if(buffer[0] == '#' || buffer[0] == ';') {
+        } else if(line[0] == '#' || line[0] == ';') {
             if(_flags & InternalFlag::SkipComments) continue;
 
             ConfigurationGroup::Value item;
-            item.value = buffer;
-            group->_values.push_back(item);
+            if(mapped) item.mappedValue = line;
+            else item.value.assign(line.data(), line.size());
+            group->_values.push_back(std::move(item));
 
         /* Key/value pair */
         } else {
-            const std::size_t splitter = buffer.find_first_of('=');
-            if(splitter == std::string::npos)
+            const Containers::StringView splitter = line.find('=');
+            if(!splitter.data())
                 return {nullptr, "missing equals for a value"};
 
+            const Containers::StringView key = line.prefix(splitter.begin()).trimmed();
+            Containers::StringView value = line.suffix(splitter.end()).trimmed();
+
             ConfigurationGroup::Value item;
-            item.key = String::trim(buffer.substr(0, splitter));
-            item.value = String::trim(buffer.substr(splitter+1));
 
-            /* Start of multi-line value */
-            if(item.value == "\"\"\"") {
-                item.value = "";
+            /* Start of multi-line value, the lines get appended to it */
+            if(value == "\"\"\"") {
+                value = {in.data(), 0};
+                item.mappedMultiLine = mapped;
                 multiLineValue = true;
 
             /* Remove quotes, if present */
             /** @todo Check `"` characters better */
-            } else if(!item.value.empty() && item.value[0] == '"') {
-                if(item.value.size() < 2 || item.value[item.value.size()-1] != '"')
+            } else if(!value.empty() && value[0] == '"') {
+                if(value.size() < 2 || value.back() != '"')
                     return {nullptr, "missing closing quote for a value"};
 
-                item.value = item.value.substr(1, item.value.size()-2);
+                value = value.slice(1, value.size() - 1);
+            }
+
+            if(mapped) {
+                item.mappedKey = key;
+                item.mappedValue = value;
+            } else {
+                item.key.assign(key.data(), key.size());
+                item.value.assign(value.data(), value.size());
             }
 
-            group->_values.push_back(item);
+            group->_values.push_back(std::move(item));
         }
     }
 
     if(multiLineValue)
         return {nullptr, "missing closing quotes for a multi-line value"};
 
+    if(!valuesEnded && recordValues)
+        group->_savedValues = {valuesBegin, std::size_t(in.data() - valuesBegin)};
+
     /* This was the last group */
     return {in, nullptr};
 }
 
-bool Configuration::save(const std::string& filename) {
-    /* Save to a stringstream and then write it as a string to the file. Doing
-       it this way to avoid issues with Unicode filenames on Windows. */
-    /** @todo get rid of streams altogether */
-    std::ostringstream out;
-    save(out);
-    if(Directory::writeString(filename, out.str()))
+const char* Configuration::parseBinary(const Containers::ArrayView<const char> in) {
+    if(in.size() < BinaryHeaderSize)
+        return "truncated binary header";
+    if(readBinary(in, 1) != BinaryVersion)
+        return "unsupported binary format version";
+
+    const std::uint32_t flags = readBinary(in, 2);
+    const std::uint32_t groupCount = readBinary(in, 3);
+    const std::uint32_t valueCount = readBinary(in, 4);
+    const std::uint32_t stringTableSize = readBinary(in, 5);
+    if(!groupCount)
+        return "no root group in binary data";
+    if(BinaryHeaderSize + std::uint64_t(groupCount)*BinaryGroupSize + std::uint64_t(valueCount)*BinaryValueSize + stringTableSize != in.size())
+        return "binary data size mismatch";
+
+    if(flags & BinaryFlagHasBom) _flags |= InternalFlag::HasBom;
+    if(flags & BinaryFlagWindowsEol) _flags |= InternalFlag::WindowsEol;
+
+    const char* const groupData = in.data() + BinaryHeaderSize;
+    const char* const valueData = groupData + std::size_t(groupCount)*BinaryGroupSize;
+    const Containers::StringView strings{valueData + std::size_t(valueCount)*BinaryValueSize, stringTableSize};
+    auto string = [&](const std::uint32_t offset, const std::uint32_t size, Containers::StringView& out) {
+        if(std::uint64_t(offset) + size > strings.size()) return false;
+        out = strings.slice(offset, offset + size);
         return true;
+    };
+
+    /* If the data are memory-mapped, keys and values are stored as views
+       into the string table instead of being copied */
+    const bool mapped = !!_mappedFile;
+
+    /* Groups are in breadth-first order, children of each group are thus
+       right after children of the previous group and values of each group
+       right after values of the previous group. Verifying that, which also
+       ensures every group has exactly one parent. */
+    std::vector<ConfigurationGroup*> groups(groupCount);
+    groups[0] = this;
+    std::uint32_t nextChild = 1, nextValue = 0;
+    for(std::uint32_t i = 0; i != groupCount; ++i) {
+        if(i >= nextChild)
+            return "invalid binary group hierarchy";
+
+        const char* const groupRecord = groupData + i*BinaryGroupSize;
+        const std::uint32_t firstValue = readBinary(groupRecord, 2);
+        const std::uint32_t groupValueCount = readBinary(groupRecord, 3);
+        const std::uint32_t firstChild = readBinary(groupRecord, 4);
+        const std::uint32_t childCount = readBinary(groupRecord, 5);
+        if(firstValue != nextValue || groupValueCount > valueCount - nextValue)
+            return "invalid binary value range";
+        if(firstChild != nextChild || childCount > groupCount - nextChild)
+            return "invalid binary group hierarchy";
+        nextValue += groupValueCount;
+        nextChild += childCount;
+
+        ConfigurationGroup* const group = groups[i];
+
+        /* Values */
+        group->_values.reserve(groupValueCount);
+        for(std::uint32_t j = firstValue; j != firstValue + groupValueCount; ++j) {
+            const char* const valueRecord = valueData + std::size_t(j)*BinaryValueSize;
+            Containers::StringView key, value;
+            if(!string(readBinary(valueRecord, 0), readBinary(valueRecord, 1), key) ||
+               !string(readBinary(valueRecord, 2), readBinary(valueRecord, 3), value))
+                return "invalid binary string range";
+
+            /* Comment or empty line */
+            if(key.empty() && (_flags & InternalFlag::SkipComments)) continue;
+
+            ConfigurationGroup::Value item;
+            if(mapped) {
+                item.mappedKey = key;
+                item.mappedValue = value;
+            } else {
+                item.key.assign(key.data(), key.size());
+                item.value.assign(value.data(), value.size());
+            }
+            group->_values.push_back(std::move(item));
+        }
+
+        /* Subgroups. The names are in the records of the subgroups, which
+           are always after this one. */
+        group->_groups.reserve(childCount);
+        for(std::uint32_t j = firstChild; j != firstChild + childCount; ++j) {
+            const char* const childRecord = groupData + std::size_t(j)*BinaryGroupSize;
+            Containers::StringView name;
+            if(!string(readBinary(childRecord, 0), readBinary(childRecord, 1), name))
+                return "invalid binary string range";
+            if(name.empty())
+                return "empty group name";
+
+            ConfigurationGroup::Group g;
+            g.name.assign(name.data(), name.size());
+            g.group = new ConfigurationGroup(_configuration);
+            group->_groups.push_back(std::move(g));
+            groups[j] = group->_groups.back().group;
+        }
+    }
+
+    if(nextValue != valueCount)
+        return "invalid binary value range";
+
+    return nullptr;
+}
+
+Containers::Array<char> Configuration::toBinary() const {
+    /* Gather all groups in a breadth-first order */
+    std::vector<const ConfigurationGroup*> groups{this};
+    std::vector<const std::string*> names{nullptr};
+    std::size_t valueCount = 0;
+    for(std::size_t i = 0; i != groups.size(); ++i) {
+        valueCount += groups[i]->_values.size();
+        for(const Group& g: groups[i]->_groups) {
+            groups.push_back(g.group);
+            names.push_back(&g.name);
+        }
+    }
+
+    /* Build the string table, storing each distinct string just once */
+    std::string strings;
+    std::unordered_map<std::string, std::uint32_t> stringOffsets;
+    bool overflow = false;
+    auto addString = [&](const Containers::StringView string) -> std::uint32_t {
+        if(string.empty()) return 0;
+        const auto inserted = stringOffsets.emplace(std::string{string.data(), string.size()}, std::uint32_t(strings.size()));
+        if(inserted.second) {
+            if(strings.size() + string.size() > 0xffffffffu) overflow = true;
+            strings.append(string.data(), string.size());
+        }
+        return inserted.first->second;
+    };
+
+    std::vector<std::uint32_t> groupRecords;
+    std::vector<std::uint32_t> valueRecords;
+    groupRecords.reserve(groups.size()*BinaryGroupSize/4);
+    valueRecords.reserve(valueCount*BinaryValueSize/4);
+    std::size_t nextChild = 1;
+    std::string decoded;
+    for(std::size_t i = 0; i != groups.size(); ++i) {
+        const ConfigurationGroup& group = *groups[i];
+        const Containers::StringView name = names[i] ? Containers::StringView{names[i]->data(), names[i]->size()} : Containers::StringView{};
+        groupRecords.push_back(addString(name));
+        groupRecords.push_back(name.size());
+        groupRecords.push_back(valueRecords.size()*4/BinaryValueSize);
+        groupRecords.push_back(group._values.size());
+        groupRecords.push_back(nextChild);
+        groupRecords.push_back(group._groups.size());
+        nextChild += group._groups.size();
+
+        for(const Value& value: group._values) {
+            const Containers::StringView key = value.keyView();
+            const Containers::StringView valueView = value.valueView(decoded);
+            valueRecords.push_back(addString(key));
+            valueRecords.push_back(key.size());
+            valueRecords.push_back(addString(valueView));
+            valueRecords.push_back(valueView.size());
+        }
+    }
+
+    const std::uint64_t size = BinaryHeaderSize + std::uint64_t(groupRecords.size() + valueRecords.size())*4 + strings.size();
+    if(overflow || size > 0xffffffffu) {
+        Error() << "Utility::Configuration::toBinary(): the data doesn't fit into 4 GB";
+        return nullptr;
+    }
+
+    std::uint32_t flags = 0;
+    if(_flags & InternalFlag::HasBom) flags |= BinaryFlagHasBom;
+    if(_flags & InternalFlag::WindowsEol) flags |= BinaryFlagWindowsEol;
+
+    Containers::Array<char> out{Containers::NoInit, std::size_t(size)};
+    char* data = out.data();
+    std::memcpy(data, BinaryMagic, 4);
+    data += 4;
+    writeBinary(data, BinaryVersion);
+    writeBinary(data, flags);
+    writeBinary(data, groups.size());
+    writeBinary(data, valueCount);
+    writeBinary(data, strings.size());
+    for(const std::uint32_t i: groupRecords) writeBinary(data, i);
+    for(const std::uint32_t i: valueRecords) writeBinary(data, i);
+    if(!strings.empty()) std::memcpy(data, strings.data(), strings.size());
+    CORRADE_INTERNAL_ASSERT(data + strings.size() == out.end());
+
+    return out;
+}
+
+namespace {
+    /* std::rename() replaces the destination on POSIX, but fails on Windows
+       if the destination exists */
+    bool replaceFile(const std::string& from, const std::string& to) {
+        #if defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
+        return MoveFileExW(Unicode::widen(from).data(), Unicode::widen(to).data(), MOVEFILE_REPLACE_EXISTING);
+        #else
+        #ifdef CORRADE_TARGET_WINDOWS
+        Directory::rm(to);
+        #endif
+        return Directory::move(from, to);
+        #endif
+    }
+}
+
+bool Configuration::save(const std::string& filename) {
+    /* Empty text output is valid, empty binary output means an error */
+    if(_flags & InternalFlag::Binary) return saveBinary(filename);
+    Containers::Array<char> data = serialize();
+    const bool written = writeFile(filename, data);
+    /* With incremental save the group values now point into the output */
+    if(_flags & InternalFlag::IncrementalSave) _savedData = std::move(data);
+    return written;
+}
+
+bool Configuration::saveBinary(const std::string& filename) {
+    const Containers::Array<char> data = toBinary();
+    return data && writeFile(filename, data);
+}
+
+bool Configuration::writeFile(const std::string& filename, const Containers::ArrayView<const char> data) const {
+    if(_flags & InternalFlag::AtomicSave) {
+        const std::string temporary = filename + ".tmp";
+        if(Directory::write(temporary, data)) {
+            if(replaceFile(temporary, filename)) return true;
+            Directory::rm(temporary);
+        }
+    } else if(Directory::write(filename, data)) return true;
 
     Error() << "Utility::Configuration::save(): cannot open file" << filename;
     return false;
 }
 
 void Configuration::save(std::ostream& out) {
+    Containers::Array<char> data = serialize();
+    out.write(data.data(), data.size());
+    /* With incremental save the group values now point into the output */
+    if(_flags & InternalFlag::IncrementalSave) _savedData = std::move(data);
+}
+
+bool Configuration::save() {
+    if(_filename.empty()) return false;
+    return save(_filename);
+}
+
+/* Either only counts the size or copies the data, so the same code can be
+   used to first calculate the output size and then fill it */
+struct Configuration::Writer {
+    void write(const Containers::StringView string) {
+        if(out && !string.empty())
+            std::memcpy(out + size, string.data(), string.size());
+        size += string.size();
+    }
+
+    void write(const std::string& string) {
+        write(Containers::StringView{string.data(), string.size()});
+    }
+
+    void write(const char character) {
+        if(out) out[size] = character;
+        ++size;
+    }
+
+    char* out;
+    std::size_t size;
+};
+
+Containers::Array<char> Configuration::serialize() {
+    Writer counter{nullptr, 0};
+    serialize(counter);
+
+    Containers::Array<char> data{Containers::NoInit, counter.size};
+    Writer writer{data.data(), 0};
+    serialize(writer);
+    CORRADE_INTERNAL_ASSERT(writer.size == data.size());
+
+    return data;
+}
+
+void Configuration::serialize(Writer& out) {
     /* BOM, if user explicitly wants that crap */
     if((_flags & InternalFlag::PreserveBom) && (_flags & InternalFlag::HasBom))
-        out.write(Bom, 3);
+        out.write(Containers::StringView{Bom, 3});
 
     /* EOL character */
-    std::string eol;
-    if(_flags & (InternalFlag::ForceWindowsEol|InternalFlag::WindowsEol) && !(_flags & InternalFlag::ForceUnixEol)) eol = "\r\n";
-    else eol = "\n";
+    const Containers::StringView eol = _flags & (InternalFlag::ForceWindowsEol|InternalFlag::WindowsEol) && !(_flags & InternalFlag::ForceUnixEol) ? Containers::StringView{"\r\n", 2} : Containers::StringView{"\n", 1};
 
-    /** @todo Checking file.good() after every operation */
     /** @todo Backup file */
 
     /* Recursively save all groups */
-    save(out, eol, this, {});
-}
-
-bool Configuration::save() {
-    if(_filename.empty()) return false;
-    return save(_filename);
+    serialize(out, eol, this, {});
 }
 
 namespace {
@@ -309,41 +779,72 @@ namespace {
     }
 }
 
-void Configuration::save(std::ostream& out, const std::string& eol, ConfigurationGroup* group, const std::string& fullPath) const {
+void Configuration::serialize(Writer& out, const Containers::StringView eol, ConfigurationGroup* const group, const std::string& fullPath) {
     CORRADE_INTERNAL_ASSERT(group->configuration() == this);
-    std::string buffer;
 
-    /* Foreach all items in the group */
-    for(const Value& value: group->_values) {
-        /* Key/value pair */
-        if(!value.key.empty()) {
-            /* Multi-line value */
-            if(value.value.find_first_of('\n') != std::string::npos) {
-                /* Replace \n with `eol` */
-                /** @todo fixme: ugly and slow */
-                std::string valueString = value.value;
-                std::size_t pos = 0;
-                while((pos = valueString.find_first_of('\n', pos)) != std::string::npos) {
-                    valueString.replace(pos, 1, eol);
-                    pos += eol.size();
-                }
+    const std::size_t valuesBegin = out.size;
+
+    /* Values of a group that wasn't modified since the last load or save are
+       copied verbatim. The last line of the file doesn't need to have a
+       newline, so add it. */
+    if(!group->_savedValues.empty()) {
+        out.write(group->_savedValues);
+        if(group->_savedValues.back() != '\n') out.write(eol);
+
+    /* Otherwise serialize all items in the group */
+    } else {
+        for(const Value& value: group->_values) {
+            /* Multi-line mapped values have to be decoded first, otherwise
+               reference the data directly */
+            std::string decoded;
+            Containers::StringView valueView = value.valueView(decoded);
+
+            const Containers::StringView key = value.keyView();
+
+            /* Comment / empty line */
+            if(key.empty()) {
+                out.write(valueView);
+                out.write(eol);
+                continue;
+            }
 
-                buffer = value.key + "=\"\"\"" + eol + valueString + eol + "\"\"\"" + eol;
+            out.write(key);
+
+            /* Multi-line value, replace \n with `eol` */
+            if(valueView.contains('\n')) {
+                out.write(Containers::StringView{"=\"\"\"", 4});
+                out.write(eol);
+                for(;;) {
+                    const Containers::StringView newline = valueView.find('\n');
+                    out.write(newline.data() ? valueView.prefix(newline.begin()) : valueView);
+                    out.write(eol);
+                    if(!newline.data()) break;
+                    valueView = valueView.suffix(newline.end());
+                }
+                out.write(Containers::StringView{"\"\"\"", 3});
 
             /* Value with leading/trailing spaces */
-            } else if(!value.value.empty() && (isWhitespace(value.value.front()) || isWhitespace(value.value.back()))) {
-                buffer = value.key + "=\"" + value.value + '"' + eol;
+            } else if(!valueView.empty() && (isWhitespace(valueView.front()) || isWhitespace(valueView.back()))) {
+                out.write(Containers::StringView{"=\"", 2});
+                out.write(valueView);
+                out.write('"');
 
             /* Value without spaces */
-            } else buffer = value.key + '=' + value.value + eol;
-        }
-
-        /* Comment / empty line */
-        else buffer = value.value + eol;
+            } else {
+                out.write('=');
+                out.write(valueView);
+            }
 
-        out.write(buffer.data(), buffer.size());
+            out.write(eol);
+        }
     }
 
+    /* With incremental save point the values to the output so the next save
+       can reuse them as well. Done only when actually writing, in the
+       counting pass the old values are still needed. */
+    if(out.out && (_flags & InternalFlag::IncrementalSave))
+        group->_savedValues = {out.out + valuesBegin, out.size - valuesBegin};
+
     /* Recursively process all subgroups */
     for(std::size_t i = 0; i != group->_groups.size(); ++i) {
         const Group& g = group->_groups[i];
@@ -355,11 +856,13 @@ void Configuration::save(std::ostream& out, const std::string& eol, Configuratio
         /* Omit the name if the group is a first subgroup of given name, has no
            values and only subgroups */
         if(!((i == 0 || group->_groups[i - 1].name != g.name) && g.group->_values.empty() && !g.group->_groups.empty())) {
-            buffer = '[' + name + ']' + eol;
-            out.write(buffer.data(), buffer.size());
+            out.write('[');
+            out.write(name);
+            out.write(']');
+            out.write(eol);
         }
 
-        save(out, eol, g.group, name);
+        serialize(out, eol, g.group, name);
     }
 }
 
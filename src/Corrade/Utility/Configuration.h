@@ -33,6 +33,7 @@
 #include <string>
 #include <iosfwd>
 
+#include "Corrade/Containers/Array.h"
 #include "Corrade/Containers/EnumSet.h"
 #include "Corrade/Utility/ConfigurationGroup.h"
 #include "Corrade/Utility/visibility.h"
@@ -191,6 +192,41 @@ class=AbstractFactoryListenerProviderDelegate
 class=BeanFactoryListenerProviderDelegateGarbageAllocator
 @endcode
 
+@section Utility-Configuration-binary Binary representation
+
+For faster loading, the configuration can be converted to a binary
+representation using @ref toBinary() or @ref saveBinary(), keeping the text
+file only as the authoring format. Binary data are detected by their header
+and loaded transparently by all constructors, after which they're accessible
+through the same @ref ConfigurationGroup API. Combined with
+@ref Flag::ReadOnly, the file is memory-mapped and the keys and values are
+referenced directly from its string table without any parsing or copying.
+
+The data consist of a header, a list of groups, a list of values and a string
+table, all values being 32-bit little-endian integers. Groups are stored in
+breadth-first order, so children of each group form a contiguous range, and
+each group references a contiguous range of its values. Values, keys and
+group names are ranges in the string table, with duplicate strings stored only
+once. Comments and empty lines are stored as values with an empty key. The
+hash index for @ref Flag::HashedLookup isn't stored in the file, as it's
+built lazily from the referenced keys on first lookup.
+
+@section Utility-Configuration-snapshots Concurrent access
+
+The configuration itself isn't thread-safe. For reading it from many threads
+while it's being updated on another, call @ref publish() after each batch of
+modifications and let the reading threads retrieve a
+@ref ConfigurationSnapshot using @ref snapshot(). The snapshot is an immutable
+reference-counted copy of the whole tree, retrieving it and querying it
+involves no locking and each thread sees a consistent state from a single
+@ref publish() call:
+
+@snippet Utility.cpp Configuration-snapshot
+
+Only groups that changed since the previous @ref publish() are copied, the
+rest is shared with the previous snapshot. Note that @ref publish() has to be
+called at least once before any other thread accesses the configuration.
+
 @todo Renaming, copying groups
 @todo EOL autodetection according to system on unsure/new files (default is
     preserve)
@@ -240,8 +276,64 @@ class CORRADE_UTILITY_EXPORT Configuration: public ConfigurationGroup {
              * Open the file read-only, which means faster access to elements
              * and less memory used. Filename is not saved to avoid overwriting
              * the file with @ref save(). See also @ref Flag::SkipComments.
+             *
+             * On platforms that support it, the file is memory-mapped using
+             * @ref Directory::mapRead() and keys and values are referenced
+             * directly from the mapping instead of being copied. Multi-line
+             * values are decoded only when accessed. Values that are changed
+             * afterwards and groups copied or moved out of the configuration
+             * get their own copy of the data so they don't depend on the
+             * mapping.
+             */
+            ReadOnly        = 1 << 5,
+
+            /**
+             * Make value and group lookups in each group go through a hash
+             * index instead of a linear search. The index is built lazily on
+             * the first lookup, updated when values or groups are added and
+             * rebuilt after removals. Useful for groups with many values,
+             * for small groups the linear search is usually faster. Note that
+             * with this flag enabled, building the index on first lookup
+             * makes even @cpp const @ce lookups not thread-safe.
+             * @m_since_latest
+             */
+            HashedLookup    = 1 << 6,
+
+            /**
+             * Save to a temporary file next to the destination first and then
+             * rename it over the destination, so other processes never see a
+             * partially written file. The temporary file has the same name
+             * with a `.tmp` suffix.
+             * @m_since_latest
+             */
+            AtomicSave      = 1 << 7,
+
+            /**
+             * Keep the loaded text file around and on @ref save() copy the
+             * values of groups that weren't modified since the last load or
+             * save verbatim instead of serializing them again. Group headers
+             * are always regenerated. The output is still written as a
+             * whole, this only saves the serialization work for large
+             * mostly-unmodified files, at the cost of keeping a copy of the
+             * file in memory. The loaded data are reused only if none of
+             * @ref Flag::ReadOnly, @ref Flag::SkipComments,
+             * @ref Flag::ForceUnixEol and @ref Flag::ForceWindowsEol is set,
+             * the output of a previous @ref save() is reused always. Has no
+             * effect for binary files.
+             * @m_since_latest
              */
-            ReadOnly        = 1 << 5
+            IncrementalSave = 1 << 8,
+
+            /**
+             * Cache the result of @ref ConfigurationGroup::value() in each
+             * value for trivially copyable types of up to 16 bytes, so
+             * repeated reads with the same type and flags don't convert the
+             * value from a string again. The cache is reset when the value
+             * is changed. Note that with this flag enabled, even
+             * @cpp const @ce value lookups are not thread-safe.
+             * @m_since_latest
+             */
+            CacheTypedValues = 1 << 9
         };
 
         /**
@@ -317,11 +409,22 @@ class CORRADE_UTILITY_EXPORT Configuration: public ConfigurationGroup {
          * @param filename  Filename in UTF-8
          *
          * The original @ref filename() is left untouched. Returns
-         * @cpp true @ce on success, @cpp false @ce otherwise.
+         * @cpp true @ce on success, @cpp false @ce otherwise. The whole
+         * file is serialized into a single buffer of a precalculated size
+         * and written with @ref Directory::write() at once. If
+         * @ref Flag::AtomicSave is set, it's written to a temporary file
+         * first and then renamed over @p filename. If
+         * @ref Flag::IncrementalSave is set, values of groups that weren't
+         * modified are copied from the previously loaded or saved data.
          */
         bool save(const std::string& filename);
 
-        /** @brief Save configuration to stream */
+        /**
+         * @brief Save configuration to stream
+         *
+         * Serializes the configuration into a single buffer and writes it to
+         * the stream at once.
+         */
         void save(std::ostream& out);
 
         /**
@@ -332,6 +435,61 @@ class CORRADE_UTILITY_EXPORT Configuration: public ConfigurationGroup {
          */
         bool save();
 
+        /**
+         * @brief Convert the configuration to a binary representation
+         * @m_since_latest
+         *
+         * See @ref Utility-Configuration-binary for details. The data can be
+         * loaded back by any of the constructors. A configuration loaded from
+         * binary data is saved back in the binary representation by
+         * @ref save() and @ref save(const std::string&) as well, while
+         * @ref save(std::ostream&) always produces text. Returns
+         * @cpp nullptr @ce and prints a message to @ref Error if the data
+         * would be larger than 4 GB.
+         */
+        Containers::Array<char> toBinary() const;
+
+        /**
+         * @brief Save the configuration in a binary representation
+         * @param filename  Filename in UTF-8
+         * @m_since_latest
+         *
+         * Writes output of @ref toBinary() to given file, respecting
+         * @ref Flag::AtomicSave. The @ref filename() is left untouched.
+         * Returns @cpp true @ce on success, @cpp false @ce otherwise.
+         */
+        bool saveBinary(const std::string& filename);
+
+        /**
+         * @brief Publish a snapshot of the configuration
+         * @m_since_latest
+         *
+         * Makes an immutable copy of the current state and atomically
+         * replaces the snapshot returned by @ref snapshot() with it. Groups
+         * that didn't change since the previous call are not copied again but
+         * shared with the previous snapshot. Threads that still hold the
+         * previous snapshot continue to see the old state until they call
+         * @ref snapshot() again. See @ref Utility-Configuration-snapshots
+         * for more information.
+         *
+         * Not thread-safe with respect to other modifications of the
+         * configuration, but safe to call while other threads call
+         * @ref snapshot().
+         */
+        void publish();
+
+        /**
+         * @brief Last published snapshot
+         * @m_since_latest
+         *
+         * Returns the snapshot made by the last call to @ref publish(), or an
+         * empty snapshot if it wasn't called yet. Can be called from any
+         * thread at any time after the first @ref publish() without any
+         * locking, even while the configuration is modified and published on
+         * another thread.
+         */
+        ConfigurationSnapshot snapshot() const;
+
     private:
         enum class InternalFlag: std::uint32_t {
             PreserveBom     = std::uint32_t(Flag::PreserveBom),
@@ -340,11 +498,16 @@ class CORRADE_UTILITY_EXPORT Configuration: public ConfigurationGroup {
             Truncate        = std::uint32_t(Flag::Truncate),
             SkipComments    = std::uint32_t(Flag::SkipComments),
             ReadOnly        = std::uint32_t(Flag::ReadOnly),
+            HashedLookup    = std::uint32_t(Flag::HashedLookup),
+            AtomicSave      = std::uint32_t(Flag::AtomicSave),
+            IncrementalSave = std::uint32_t(Flag::IncrementalSave),
+            CacheTypedValues = std::uint32_t(Flag::CacheTypedValues),
 
             IsValid = 1 << 16,
             HasBom = 1 << 17,
             WindowsEol = 1 << 18,
-            Changed = 1 << 19
+            Changed = 1 << 19,
+            Binary = 1 << 20
         };
 
         typedef Containers::EnumSet<InternalFlag> InternalFlags;
@@ -352,13 +515,31 @@ class CORRADE_UTILITY_EXPORT Configuration: public ConfigurationGroup {
         CORRADE_ENUMSET_FRIEND_OPERATORS(InternalFlags)
 
         CORRADE_UTILITY_LOCAL bool parse(Containers::ArrayView<const char> in);
+        CORRADE_UTILITY_LOCAL const char* parseBinary(Containers::ArrayView<const char> in);
+        CORRADE_UTILITY_LOCAL bool writeFile(const std::string& filename, Containers::ArrayView<const char> data) const;
         CORRADE_UTILITY_LOCAL std::pair<Containers::ArrayView<const char>, const char*> parse(Containers::ArrayView<const char> in, ConfigurationGroup* group, const std::string& fullPath);
-        CORRADE_UTILITY_LOCAL void save(std::ostream& out, const std::string& eol, ConfigurationGroup* group, const std::string& fullPath) const;
+        struct Writer;
+
+        /* Not const because with Flag::IncrementalSave the group values get
+           redirected to the output */
+        CORRADE_UTILITY_LOCAL Containers::Array<char> serialize();
+        CORRADE_UTILITY_LOCAL void serialize(Writer& out);
+        CORRADE_UTILITY_LOCAL void serialize(Writer& out, Containers::StringView eol, ConfigurationGroup* group, const std::string& fullPath);
 
         CORRADE_UTILITY_LOCAL void setConfigurationPointer(ConfigurationGroup* group);
 
+        struct MappedFile;
+        struct SnapshotState;
+
         std::string _filename;
         InternalFlags _flags;
+        /* With Flag::ReadOnly the values point into this */
+        Containers::Pointer<MappedFile> _mappedFile;
+        /* Allocated on the first publish() */
+        Containers::Pointer<SnapshotState> _snapshotState;
+        /* With Flag::IncrementalSave the loaded file or the last saved output,
+           ConfigurationGroup::_savedValues point into this */
+        Containers::Array<char> _savedData;
 };
 
 CORRADE_ENUMSET_OPERATORS(Configuration::Flags)
@@ -25,11 +25,84 @@
 
 #include "ConfigurationGroup.h"
 
+#include <cstring>
+#include <unordered_map>
+
 #include "Corrade/Utility/Assert.h"
 #include "Corrade/Utility/Configuration.h"
+#include "Corrade/Utility/Implementation/configurationSnapshot.h"
+#include "Corrade/Utility/MurmurHash2.h"
+#include "Corrade/Utility/Parse.h"
 
 namespace Corrade { namespace Utility {
 
+/* Maps a hash of the key to positions of all values or groups with that
+   hash, in the order they're stored. Storing just the hash avoids copying
+   all keys, the lookup then compares the actual key at each position,
+   which also filters out hash collisions. */
+struct ConfigurationGroup::Index {
+    std::unordered_map<std::size_t, std::vector<std::size_t>> values, groups;
+};
+
+namespace {
+    /* Hashing a view and not a std::string so mapped keys don't need to be
+       copied */
+    inline std::size_t hashKey(const Containers::StringView key) {
+        return Implementation::MurmurHash2<sizeof(std::size_t)>{}(0, key.data(), key.size());
+    }
+
+    inline Containers::StringView view(const std::string& string) {
+        return {string.data(), string.size()};
+    }
+}
+
+std::string ConfigurationGroup::Value::valueString() const {
+    if(!isMapped()) return value;
+    if(!mappedMultiLine) return {mappedValue.data(), mappedValue.size()};
+
+    /* Each line of a multi-line value is stored including its newline,
+       strip the newlines and Windows EOLs, if present, and join the lines
+       back with \n */
+    std::string out;
+    out.reserve(mappedValue.size());
+    Containers::StringView in = mappedValue;
+    bool first = true;
+    while(!in.empty()) {
+        const Containers::StringView newline = in.find('\n');
+        CORRADE_INTERNAL_ASSERT(newline.data());
+        Containers::StringView line = in.prefix(newline.begin());
+        if(!line.empty() && line.back() == '\r') line = line.except(1);
+
+        if(!first) out += '\n';
+        out.append(line.data(), line.size());
+        first = false;
+        in = in.suffix(newline.end());
+    }
+
+    return out;
+}
+
+Containers::StringView ConfigurationGroup::Value::valueView(std::string& buffer) const {
+    if(!isMapped()) return view(value);
+    if(!mappedMultiLine) return mappedValue;
+    buffer = valueString();
+    return view(buffer);
+}
+
+void ConfigurationGroup::Value::materialize() {
+    if(!isMapped()) return;
+
+    key = {mappedKey.data(), mappedKey.size()};
+    value = valueString();
+    mappedKey = mappedValue = {};
+    mappedMultiLine = false;
+}
+
+void ConfigurationGroup::materialize() {
+    for(Value& value: _values) value.materialize();
+    for(Group& group: _groups) group.group->materialize();
+}
+
 ConfigurationGroup::ConfigurationGroup(): _configuration(nullptr) {}
 
 ConfigurationGroup::ConfigurationGroup(Configuration* configuration): _configuration(configuration) {}
@@ -38,15 +111,28 @@ ConfigurationGroup::ConfigurationGroup(const ConfigurationGroup& other): _values
     /* Deep copy groups */
     for(Group& group: _groups)
         group.group = new ConfigurationGroup(*group.group);
+
+    /* The copy can outlive a memory-mapped file the values point to */
+    materialize();
 }
 
 ConfigurationGroup::ConfigurationGroup(ConfigurationGroup&& other): _values(std::move(other._values)), _groups(std::move(other._groups)), _configuration(nullptr) {
+    other._index = nullptr;
+    other._savedValues = {};
+
     /* Reset configuration pointer for subgroups */
     for(Group& group: _groups)
         group.group->_configuration = nullptr;
+
+    /* The group can outlive a memory-mapped file the values point to */
+    materialize();
 }
 
 ConfigurationGroup& ConfigurationGroup::operator=(const ConfigurationGroup& other) {
+    _index = nullptr;
+    _snapshot = {};
+    _savedValues = {};
+
     /* Delete current groups */
     for(Group& group: _groups)
         delete group.group;
@@ -61,10 +147,21 @@ ConfigurationGroup& ConfigurationGroup::operator=(const ConfigurationGroup& othe
         group.group->_configuration = _configuration;
     }
 
+    /* The values could point to a memory-mapped file of another
+       configuration */
+    materialize();
+
     return *this;
 }
 
 ConfigurationGroup& ConfigurationGroup::operator=(ConfigurationGroup&& other) {
+    _index = nullptr;
+    other._index = nullptr;
+    _snapshot = {};
+    _savedValues = {};
+    other._snapshot = {};
+    other._savedValues = {};
+
     /* Delete current groups */
     for(Group& group: _groups)
         delete group.group;
@@ -77,28 +174,98 @@ ConfigurationGroup& ConfigurationGroup::operator=(ConfigurationGroup&& other) {
     for(Group& group: _groups)
         group.group->_configuration = _configuration;
 
+    /* The values could point to a memory-mapped file of another
+       configuration */
+    materialize();
+
     return *this;
 }
 
+ConfigurationSnapshot ConfigurationGroup::snapshotInternal() const {
+    /* Snapshot all subgroups first. If none of them changed and neither did
+       this group, the previous snapshot can be reused as a whole. */
+    std::vector<ConfigurationSnapshot> groups;
+    groups.reserve(_groups.size());
+    bool changed = !_snapshot;
+    for(std::size_t i = 0; i != _groups.size(); ++i) {
+        groups.push_back(_groups[i].group->snapshotInternal());
+        if(!changed && !groups.back().isSharedWith(_snapshot._data->groups[i].second))
+            changed = true;
+    }
+    if(!changed) return _snapshot;
+
+    Containers::Pointer<Implementation::ConfigurationSnapshotData> data{Containers::InPlaceInit};
+    for(const Value& value: _values) {
+        /* Skip comments and empty lines */
+        const Containers::StringView key = value.keyView();
+        if(key.empty()) continue;
+        data->values.emplace_back(std::string{key.data(), key.size()}, value.valueString());
+    }
+    data->groups.reserve(_groups.size());
+    for(std::size_t i = 0; i != _groups.size(); ++i)
+        data->groups.emplace_back(_groups[i].name, std::move(groups[i]));
+
+    _snapshot = ConfigurationSnapshot{data.release()};
+    return _snapshot;
+}
+
 ConfigurationGroup::~ConfigurationGroup() {
     for(Group& group: _groups)
         delete group.group;
 }
 
-auto ConfigurationGroup::findGroup(const std::string& name, const unsigned int index) -> std::vector<Group>::iterator {
-    unsigned int foundIndex = 0;
-    for(auto it = _groups.begin(); it != _groups.end(); ++it)
-        if(it->name == name && foundIndex++ == index) return it;
+auto ConfigurationGroup::lookupIndex() const -> const Index* {
+    if(!_configuration || !(_configuration->_flags & Configuration::InternalFlag::HashedLookup))
+        return nullptr;
+
+    if(!_index) {
+        _index.reset(new Index);
+        for(std::size_t i = 0; i != _values.size(); ++i)
+            /* Skip comments and empty lines */
+            if(!_values[i].keyView().empty())
+                _index->values[hashKey(_values[i].keyView())].push_back(i);
+        for(std::size_t i = 0; i != _groups.size(); ++i)
+            _index->groups[hashKey(view(_groups[i].name))].push_back(i);
+    }
 
-    return _groups.end();
+    return _index.get();
 }
 
-auto ConfigurationGroup::findGroup(const std::string& name, const unsigned int index) const -> std::vector<Group>::const_iterator {
+const std::vector<std::size_t>* ConfigurationGroup::indexedGroups(const std::string& name) const {
+    const Index* const index = lookupIndex();
+    if(!index) return nullptr;
+
+    static const std::vector<std::size_t> empty;
+    const auto found = index->groups.find(hashKey(view(name)));
+    return found != index->groups.end() ? &found->second : &empty;
+}
+
+const std::vector<std::size_t>* ConfigurationGroup::indexedValues(const std::string& key) const {
+    const Index* const index = lookupIndex();
+    if(!index) return nullptr;
+
+    static const std::vector<std::size_t> empty;
+    const auto found = index->values.find(hashKey(view(key)));
+    return found != index->values.end() ? &found->second : &empty;
+}
+
+std::size_t ConfigurationGroup::findGroupPosition(const std::string& name, const unsigned int index) const {
     unsigned int foundIndex = 0;
-    for(auto it = _groups.begin(); it != _groups.end(); ++it)
-        if(it->name == name && foundIndex++ == index) return it;
+    if(const std::vector<std::size_t>* const positions = indexedGroups(name)) {
+        for(const std::size_t i: *positions)
+            if(_groups[i].name == name && foundIndex++ == index) return i;
+    } else for(std::size_t i = 0; i != _groups.size(); ++i)
+        if(_groups[i].name == name && foundIndex++ == index) return i;
 
-    return _groups.end();
+    return _groups.size();
+}
+
+auto ConfigurationGroup::findGroup(const std::string& name, const unsigned int index) -> std::vector<Group>::iterator {
+    return _groups.begin() + findGroupPosition(name, index);
+}
+
+auto ConfigurationGroup::findGroup(const std::string& name, const unsigned int index) const -> std::vector<Group>::const_iterator {
+    return _groups.begin() + findGroupPosition(name, index);
 }
 
 bool ConfigurationGroup::hasGroup(const std::string& name, const unsigned int index) const {
@@ -107,7 +274,10 @@ bool ConfigurationGroup::hasGroup(const std::string& name, const unsigned int in
 
 unsigned int ConfigurationGroup::groupCount(const std::string& name) const {
     unsigned int count = 0;
-    for(const Group& group: _groups)
+    if(const std::vector<std::size_t>* const positions = indexedGroups(name)) {
+        for(const std::size_t i: *positions)
+            if(_groups[i].name == name) ++count;
+    } else for(const Group& group: _groups)
         if(group.name == name) ++count;
 
     return count;
@@ -126,7 +296,10 @@ const ConfigurationGroup* ConfigurationGroup::group(const std::string& name, uns
 std::vector<ConfigurationGroup*> ConfigurationGroup::groups(const std::string& name) {
     std::vector<ConfigurationGroup*> found;
 
-    for(Group& group: _groups)
+    if(const std::vector<std::size_t>* const positions = indexedGroups(name)) {
+        for(const std::size_t i: *positions)
+            if(_groups[i].name == name) found.push_back(_groups[i].group);
+    } else for(Group& group: _groups)
         if(group.name == name) found.push_back(group.group);
 
     return found;
@@ -135,7 +308,10 @@ std::vector<ConfigurationGroup*> ConfigurationGroup::groups(const std::string& n
 std::vector<const ConfigurationGroup*> ConfigurationGroup::groups(const std::string& name) const {
     std::vector<const ConfigurationGroup*> found;
 
-    for(const Group& group: _groups)
+    if(const std::vector<std::size_t>* const positions = indexedGroups(name)) {
+        for(const std::size_t i: *positions)
+            if(_groups[i].name == name) found.push_back(_groups[i].group);
+    } else for(const Group& group: _groups)
         if(group.name == name) found.push_back(group.group);
 
     return found;
@@ -152,8 +328,10 @@ void ConfigurationGroup::addGroup(const std::string& name, ConfigurationGroup* g
     CORRADE_ASSERT(name.find_first_of("\n/[]") == std::string::npos,
         "Utility::ConfigurationGroup::addGroup(): disallowed character in group name", );
 
+    _snapshot = {};
     if(_configuration) _configuration->_flags |= Configuration::InternalFlag::Changed;
     _groups.push_back({name, group});
+    if(_index) _index->groups[hashKey(view(name))].push_back(_groups.size() - 1);
 }
 
 ConfigurationGroup* ConfigurationGroup::addGroup(const std::string& name) {
@@ -168,6 +346,8 @@ bool ConfigurationGroup::removeGroup(const std::string& name, unsigned int index
 
     delete it->group;
     _groups.erase(it);
+    _index = nullptr;
+    _snapshot = {};
     if(_configuration) _configuration->_flags |= Configuration::InternalFlag::Changed;
     return true;
 }
@@ -177,6 +357,8 @@ bool ConfigurationGroup::removeGroup(ConfigurationGroup* const group) {
         if(it->group == group) {
             delete it->group;
             _groups.erase(it);
+            _index = nullptr;
+            _snapshot = {};
             if(_configuration) _configuration->_flags |= Configuration::InternalFlag::Changed;
             return true;
         }
@@ -192,28 +374,34 @@ void ConfigurationGroup::removeAllGroups(const std::string& name) {
         _groups.erase(_groups.begin()+i);
     }
 
+    _index = nullptr;
+    _snapshot = {};
     if(_configuration) _configuration->_flags |= Configuration::InternalFlag::Changed;
 }
 
-auto ConfigurationGroup::findValue(const std::string& key, const unsigned int index) const -> std::vector<Value>::const_iterator {
+std::size_t ConfigurationGroup::findValuePosition(const std::string& key, const unsigned int index) const {
+    const Containers::StringView keyView = view(key);
     unsigned int foundIndex = 0;
-    for(auto it = _values.begin(); it != _values.end(); ++it)
-        if(it->key == key && foundIndex++ == index) return it;
+    if(const std::vector<std::size_t>* const positions = indexedValues(key)) {
+        for(const std::size_t i: *positions)
+            if(_values[i].keyView() == keyView && foundIndex++ == index) return i;
+    } else for(std::size_t i = 0; i != _values.size(); ++i)
+        if(_values[i].keyView() == keyView && foundIndex++ == index) return i;
 
-    return _values.end();
+    return _values.size();
 }
 
-auto ConfigurationGroup::findValue(const std::string& key, const unsigned int index) -> std::vector<Value>::iterator {
-    unsigned int foundIndex = 0;
-    for(auto it = _values.begin(); it != _values.end(); ++it)
-        if(it->key == key && foundIndex++ == index) return it;
+auto ConfigurationGroup::findValue(const std::string& key, const unsigned int index) const -> std::vector<Value>::const_iterator {
+    return _values.begin() + findValuePosition(key, index);
+}
 
-    return _values.end();
+auto ConfigurationGroup::findValue(const std::string& key, const unsigned int index) -> std::vector<Value>::iterator {
+    return _values.begin() + findValuePosition(key, index);
 }
 
 bool ConfigurationGroup::hasValues() const {
     for(const Value& value: _values)
-        if(!value.key.empty()) return true;
+        if(!value.keyView().empty()) return true;
 
     return false;
 }
@@ -221,7 +409,7 @@ bool ConfigurationGroup::hasValues() const {
 unsigned int ConfigurationGroup::valueCount() const {
     unsigned int count = 0;
     for(const Value& value: _values)
-        if(!value.key.empty()) ++count;
+        if(!value.keyView().empty()) ++count;
 
     return count;
 }
@@ -231,47 +419,158 @@ bool ConfigurationGroup::hasValue(const std::string& key, const unsigned int ind
 }
 
 unsigned int ConfigurationGroup::valueCount(const std::string& key) const {
+    const Containers::StringView keyView = view(key);
     unsigned int count = 0;
-    for(const Value& value: _values)
-        if(value.key == key) ++count;
+    if(const std::vector<std::size_t>* const positions = indexedValues(key)) {
+        for(const std::size_t i: *positions)
+            if(_values[i].keyView() == keyView) ++count;
+    } else for(const Value& value: _values)
+        if(value.keyView() == keyView) ++count;
 
     return count;
 }
 
 std::string ConfigurationGroup::valueInternal(const std::string& key, const unsigned int index, ConfigurationValueFlags) const {
     const auto it = findValue(key, index);
-    return it != _values.end() ? it->value : std::string();
+    return it != _values.end() ? it->valueString() : std::string();
+}
+
+bool ConfigurationGroup::cachedValueInternal(const std::string& key, const unsigned int index, const ConfigurationValueFlags flags, const char* const type, const std::size_t size, void* const out, void(*const convert)(const std::string&, ConfigurationValueFlags, void*)) const {
+    const auto it = findValue(key, index);
+    if(it == _values.end()) return false;
+
+    if(it->cachedType == type && it->cachedFlags == flags) {
+        std::memcpy(out, it->cached, size);
+        return true;
+    }
+
+    if(it->isMapped()) convert(it->valueString(), flags, out);
+    else convert(it->value, flags, out);
+
+    if(_configuration && (_configuration->_flags & Configuration::InternalFlag::CacheTypedValues)) {
+        std::memcpy(it->cached, out, size);
+        it->cachedType = type;
+        it->cachedFlags = flags;
+    }
+
+    return true;
 }
 
 std::vector<std::string> ConfigurationGroup::valuesInternal(const std::string& key, ConfigurationValueFlags) const {
+    const Containers::StringView keyView = view(key);
     std::vector<std::string> found;
 
-    for(const Value& value: _values)
-        if(value.key == key) found.push_back(value.value);
+    if(const std::vector<std::size_t>* const positions = indexedValues(key)) {
+        for(const std::size_t i: *positions)
+            if(_values[i].keyView() == keyView) found.push_back(_values[i].valueString());
+    } else for(const Value& value: _values)
+        if(value.keyView() == keyView) found.push_back(value.valueString());
 
     return found;
 }
 
+void ConfigurationGroup::forEachValueInternal(const std::string& key, void(*const callback)(const std::string&, void*), void* const state) const {
+    const Containers::StringView keyView = view(key);
+
+    /* Mapped values need to be put into a string first, reuse the same one
+       for all to avoid allocating for each */
+    std::string buffer;
+    auto call = [&](const Value& value) {
+        if(!value.isMapped()) return callback(value.value, state);
+        if(value.mappedMultiLine) buffer = value.valueString();
+        else buffer.assign(value.mappedValue.data(), value.mappedValue.size());
+        callback(buffer, state);
+    };
+
+    if(const std::vector<std::size_t>* const positions = indexedValues(key)) {
+        for(const std::size_t i: *positions)
+            if(_values[i].keyView() == keyView) call(_values[i]);
+    } else for(const Value& value: _values)
+        if(value.keyView() == keyView) call(value);
+}
+
+namespace {
+    template<class T> void parseComponent(Containers::StringView string, T& out, const ConfigurationValueFlags flags, std::true_type) {
+        if(!string.empty() && string[0] == '+') string = string.suffix(1);
+
+        int base = 10;
+        if(flags & ConfigurationValueFlag::Hex) {
+            base = 16;
+            if(string.size() >= 2 && string[0] == '0' && (string[1] == 'x' || string[1] == 'X'))
+                string = string.suffix(2);
+        } else if(flags & ConfigurationValueFlag::Oct) base = 8;
+
+        parseNumber(string, out, base);
+    }
+
+    template<class T> void parseComponent(Containers::StringView string, T& out, ConfigurationValueFlags, std::false_type) {
+        if(!string.empty() && string[0] == '+') string = string.suffix(1);
+        parseNumber(string, out);
+    }
+}
+
+template<class T> std::size_t ConfigurationGroup::valueComponents(const std::string& key, Containers::Array<T>& out, const unsigned int index, const ConfigurationValueFlags flags) const {
+    const auto it = findValue(key, index);
+    if(it == _values.end()) return 0;
+
+    /* Only multi-line mapped values need to be decoded first, otherwise
+       parse directly from the stored data */
+    std::string decoded;
+    const Containers::StringView value = it->valueView(decoded);
+
+    std::size_t count = 0;
+    for(const Containers::StringView component: value.lazySplitWithoutEmptyParts()) {
+        T parsed{};
+        parseComponent(component, parsed, flags, std::is_integral<T>{});
+        Containers::arrayAppend(out, parsed);
+        ++count;
+    }
+
+    return count;
+}
+
+template std::size_t ConfigurationGroup::valueComponents<short>(const std::string&, Containers::Array<short>&, unsigned int, ConfigurationValueFlags) const;
+template std::size_t ConfigurationGroup::valueComponents<unsigned short>(const std::string&, Containers::Array<unsigned short>&, unsigned int, ConfigurationValueFlags) const;
+template std::size_t ConfigurationGroup::valueComponents<int>(const std::string&, Containers::Array<int>&, unsigned int, ConfigurationValueFlags) const;
+template std::size_t ConfigurationGroup::valueComponents<unsigned int>(const std::string&, Containers::Array<unsigned int>&, unsigned int, ConfigurationValueFlags) const;
+template std::size_t ConfigurationGroup::valueComponents<long>(const std::string&, Containers::Array<long>&, unsigned int, ConfigurationValueFlags) const;
+template std::size_t ConfigurationGroup::valueComponents<unsigned long>(const std::string&, Containers::Array<unsigned long>&, unsigned int, ConfigurationValueFlags) const;
+template std::size_t ConfigurationGroup::valueComponents<long long>(const std::string&, Containers::Array<long long>&, unsigned int, ConfigurationValueFlags) const;
+template std::size_t ConfigurationGroup::valueComponents<unsigned long long>(const std::string&, Containers::Array<unsigned long long>&, unsigned int, ConfigurationValueFlags) const;
+template std::size_t ConfigurationGroup::valueComponents<float>(const std::string&, Containers::Array<float>&, unsigned int, ConfigurationValueFlags) const;
+template std::size_t ConfigurationGroup::valueComponents<double>(const std::string&, Containers::Array<double>&, unsigned int, ConfigurationValueFlags) const;
+template std::size_t ConfigurationGroup::valueComponents<long double>(const std::string&, Containers::Array<long double>&, unsigned int, ConfigurationValueFlags) const;
+
 bool ConfigurationGroup::setValueInternal(const std::string& key, std::string value, const unsigned int index, ConfigurationValueFlags) {
     CORRADE_ASSERT(!key.empty(), "Utility::ConfigurationGroup::setValue(): empty key", false);
     CORRADE_ASSERT(key.find_first_of("\n=") == std::string::npos,
         "Utility::ConfigurationGroup::setValue(): disallowed character in key", false);
 
-    unsigned int foundIndex = 0;
-    for(Value& v: _values) {
-        if(v.key == key && foundIndex++ == index) {
-            v.value = std::move(value);
-            if(_configuration) _configuration->_flags |= Configuration::InternalFlag::Changed;
-            return true;
+    const auto it = findValue(key, index);
+    if(it != _values.end()) {
+        /* Detach the value from a memory-mapped file, if it's there */
+        if(it->isMapped()) {
+            it->key = key;
+            it->mappedKey = it->mappedValue = {};
+            it->mappedMultiLine = false;
         }
+        it->value = std::move(value);
+        it->cachedType = nullptr;
+        _snapshot = {};
+        _savedValues = {};
+        if(_configuration) _configuration->_flags |= Configuration::InternalFlag::Changed;
+        return true;
     }
 
     /* Wanted to set value with index much larger than what we have */
-    if(index > foundIndex) return false;
+    if(index > valueCount(key)) return false;
 
     /* No value with that name was found, add new */
     _values.push_back({key, std::move(value)});
+    if(_index) _index->values[hashKey(view(key))].push_back(_values.size() - 1);
 
+    _snapshot = {};
+    _savedValues = {};
     if(_configuration) _configuration->_flags |= Configuration::InternalFlag::Changed;
     return true;
 }
@@ -281,8 +580,11 @@ void ConfigurationGroup::addValueInternal(std::string key, std::string value, Co
     CORRADE_ASSERT(key.find_first_of("\n=") == std::string::npos,
         "Utility::ConfigurationGroup::addValue(): disallowed character in key", );
 
+    if(_index) _index->values[hashKey(view(key))].push_back(_values.size());
     _values.push_back({std::move(key), std::move(value)});
 
+    _snapshot = {};
+    _savedValues = {};
     if(_configuration) _configuration->_flags |= Configuration::InternalFlag::Changed;
 }
 
@@ -293,6 +595,9 @@ bool ConfigurationGroup::removeValue(const std::string& key, const unsigned int
     if(it == _values.end()) return false;
 
     _values.erase(it);
+    _index = nullptr;
+    _snapshot = {};
+    _savedValues = {};
     if(_configuration) _configuration->_flags |= Configuration::InternalFlag::Changed;
     return true;
 }
@@ -301,14 +606,21 @@ void ConfigurationGroup::removeAllValues(const std::string& key) {
     CORRADE_ASSERT(!key.empty(), "Utility::ConfigurationGroup::removeAllValues(): empty key", );
 
     /** @todo Do it better & faster */
+    const Containers::StringView keyView = view(key);
     for(int i = _values.size()-1; i >= 0; --i) {
-        if(_values[i].key == key) _values.erase(_values.begin()+i);
+        if(_values[i].keyView() == keyView) _values.erase(_values.begin()+i);
     }
 
+    _index = nullptr;
+    _snapshot = {};
+    _savedValues = {};
     if(_configuration) _configuration->_flags |= Configuration::InternalFlag::Changed;
 }
 
 void ConfigurationGroup::clear() {
+    _index = nullptr;
+    _snapshot = {};
+    _savedValues = {};
     _values.clear();
 
     for(Group& group: _groups)
@@ -29,11 +29,17 @@
  * @brief Class @ref Corrade::Utility::ConfigurationGroup
  */
 
+#include <new>
 #include <utility>
 #include <string>
 #include <vector>
 
+#include "Corrade/Containers/GrowableArray.h"
+#include "Corrade/Containers/Pointer.h"
+#include "Corrade/Containers/StringView.h"
+#include "Corrade/Utility/ConfigurationSnapshot.h"
 #include "Corrade/Utility/ConfigurationValue.h"
+#include "Corrade/Utility/TypeTraits.h"
 #include "Corrade/Utility/Utility.h"
 #include "Corrade/Utility/visibility.h"
 
@@ -44,7 +50,15 @@ namespace Corrade { namespace Utility {
 
 Provides access to values and subgroups. See @ref Configuration class
 documentation for usage example.
-@todo Faster access to elements via multimap, find() and equal_range()
+
+@section Utility-ConfigurationGroup-lookup Lookup complexity
+
+By default, values and subgroups are stored in a plain list in the order they
+appear in the file and each lookup is linear in the number of values or
+subgroups. For groups with many values, enable
+@ref Configuration::Flag::HashedLookup, which makes each group build a hash
+index on the first lookup. The index also preserves order of multiple values
+or groups with the same name.
 */
 class CORRADE_UTILITY_EXPORT ConfigurationGroup {
     friend Configuration;
@@ -255,7 +269,10 @@ class CORRADE_UTILITY_EXPORT ConfigurationGroup {
          * Directly returns the value. If the key is not found, returns
          * default constructed value. If @p T is not @ref std::string, uses
          * @ref ConfigurationValue::fromString() to convert the value to given
-         * type.
+         * type. With @ref Configuration::Flag::CacheTypedValues the
+         * converted value is cached for trivially copyable types of up to 16
+         * bytes and returned directly on subsequent calls with the same type
+         * and flags.
          * @see @ref hasValue()
          */
         template<class T = std::string> T value(const std::string& key, unsigned int index = 0, ConfigurationValueFlags flags = ConfigurationValueFlags()) const;
@@ -278,6 +295,53 @@ class CORRADE_UTILITY_EXPORT ConfigurationGroup {
          */
         template<class T = std::string> std::vector<T> values(const std::string& key, ConfigurationValueFlags flags = ConfigurationValueFlags()) const;
 
+        /**
+         * @brief Append all values with given key to an array
+         * @param[in] key       Key
+         * @param[out] out      Array to append the values to
+         * @param[in] flags     Flags
+         * @return Count of appended values
+         * @m_since_latest
+         *
+         * Like @ref values(const std::string&, ConfigurationValueFlags) const,
+         * but instead of returning a new @ref std::vector the values are put
+         * to the end of @p out using @ref Containers::arrayAppend(). The
+         * stored strings are passed to @ref ConfigurationValue::fromString()
+         * directly, without creating intermediate copies.
+         */
+        template<class T> std::size_t values(const std::string& key, Containers::Array<T>& out, ConfigurationValueFlags flags = ConfigurationValueFlags()) const;
+
+        /**
+         * @brief Append whitespace-separated components of a value to an array
+         * @param[in] key       Key
+         * @param[out] out      Array to append the components to
+         * @param[in] index     Value index. Default is first found value.
+         * @param[in] flags     Flags
+         * @return Count of appended components
+         * @m_since_latest
+         *
+         * Splits the value on whitespace and parses each part with
+         * @ref parseNumber() directly from the stored data, which is useful
+         * for reading vectors, matrices or other long lists of numbers stored
+         * in a single value, such as @cb{.ini} matrix=1 0 0 0 1 0 0 0 1 @ce.
+         * Parts that can't be parsed are appended as zero, in the same way as
+         * invalid values returned from @ref value(). Only integer and
+         * floating-point types are supported; @ref ConfigurationValueFlag::Hex
+         * and @ref ConfigurationValueFlag::Oct are respected for integers. If
+         * the value doesn't exist, nothing is appended and @cpp 0 @ce is
+         * returned.
+         */
+        template<class T> std::size_t valueComponents(const std::string& key, Containers::Array<T>& out, unsigned int index = 0, ConfigurationValueFlags flags = ConfigurationValueFlags()) const;
+
+        /** @overload
+         * @m_since_latest
+         *
+         * Calls the above with @p index set to `0`.
+         */
+        template<class T> std::size_t valueComponents(const std::string& key, Containers::Array<T>& out, ConfigurationValueFlags flags) const {
+            return valueComponents<T>(key, out, 0, flags);
+        }
+
         /**
          * @brief Set string value
          * @param key       Key. The key must not be empty and must not contain
@@ -391,8 +455,55 @@ class CORRADE_UTILITY_EXPORT ConfigurationGroup {
         void clear();
 
     private:
+        /* Types whose conversion result can be cached in a Value with
+           Configuration::Flag::CacheTypedValues, identified by the address of
+           CachedValueType<T>::Id */
+        enum: std::size_t { CachedValueSize = 16 };
+        template<class T> struct CachedValueType {
+            static const char Id;
+        };
+        template<class T> struct IsCachedValue: std::integral_constant<bool, sizeof(T) <= CachedValueSize && alignof(T) <= 8 &&
+            #ifdef CORRADE_STD_IS_TRIVIALLY_TRAITS_SUPPORTED
+            std::is_trivially_copyable<T>::value
+            #else
+            __has_trivial_copy(T) && __has_trivial_destructor(T)
+            #endif
+        > {};
+
         struct CORRADE_UTILITY_LOCAL Value {
+            /*implicit*/ Value(): mappedMultiLine{}, cachedType{} {}
+            /*implicit*/ Value(std::string key, std::string value): key{std::move(key)}, value{std::move(value)}, mappedMultiLine{}, cachedType{} {}
+
+            /* Whether the key and value point into a memory-mapped file
+               instead of being stored in key and value */
+            bool isMapped() const { return mappedValue.data(); }
+
+            Containers::StringView keyView() const {
+                return isMapped() ? mappedKey : Containers::StringView{key.data(), key.size()};
+            }
+            /* Decodes a multi-line value, if needed */
+            std::string valueString() const;
+            /* Returns a view on the value, decoding multi-line mapped values
+               into the buffer if needed */
+            Containers::StringView valueView(std::string& buffer) const;
+            /* Copies the mapped key and value into key and value */
+            void materialize();
+
             std::string key, value;
+
+            /* With Configuration::Flag::ReadOnly the parser stores views into
+               the memory-mapped file here. Multi-line values are stored with
+               the original line endings and decoded only in
+               valueString(). */
+            Containers::StringView mappedKey, mappedValue;
+            bool mappedMultiLine;
+
+            /* With Configuration::Flag::CacheTypedValues the result of the
+               last value<T>() call, identified by the type and flags. Reset
+               when the value changes. */
+            mutable const char* cachedType;
+            mutable ConfigurationValueFlags cachedFlags;
+            alignas(8) mutable unsigned char cached[CachedValueSize];
         };
 
         struct CORRADE_UTILITY_LOCAL Group {
@@ -400,6 +511,8 @@ class CORRADE_UTILITY_EXPORT ConfigurationGroup {
             ConfigurationGroup* group;
         };
 
+        struct Index;
+
         CORRADE_UTILITY_LOCAL explicit ConfigurationGroup(Configuration* configuration);
 
         CORRADE_UTILITY_LOCAL std::vector<Group>::iterator findGroup(const std::string& name, unsigned int index);
@@ -407,8 +520,27 @@ class CORRADE_UTILITY_EXPORT ConfigurationGroup {
         CORRADE_UTILITY_LOCAL std::vector<Value>::iterator findValue(const std::string& key, unsigned int index);
         CORRADE_UTILITY_LOCAL std::vector<Value>::const_iterator findValue(const std::string& key, unsigned int index) const;
 
+        CORRADE_UTILITY_LOCAL const Index* lookupIndex() const;
+        CORRADE_UTILITY_LOCAL const std::vector<std::size_t>* indexedGroups(const std::string& name) const;
+        CORRADE_UTILITY_LOCAL const std::vector<std::size_t>* indexedValues(const std::string& key) const;
+        CORRADE_UTILITY_LOCAL std::size_t findGroupPosition(const std::string& name, unsigned int index) const;
+        CORRADE_UTILITY_LOCAL std::size_t findValuePosition(const std::string& key, unsigned int index) const;
+        CORRADE_UTILITY_LOCAL void materialize();
+        /* Reuses the cached snapshot if neither this group nor any of its
+           subgroups changed since it was made */
+        CORRADE_UTILITY_LOCAL ConfigurationSnapshot snapshotInternal() const;
+
         std::string valueInternal(const std::string& key, unsigned int index, ConfigurationValueFlags flags) const;
+        template<class T> T typedValueInternal(const std::string& key, unsigned int index, ConfigurationValueFlags flags, std::false_type) const;
+        template<class T> T typedValueInternal(const std::string& key, unsigned int index, ConfigurationValueFlags flags, std::true_type) const;
+        /* Copies the cached value of given type into out or converts it using
+           the callback and caches it, returns false if the value isn't
+           found */
+        bool cachedValueInternal(const std::string& key, unsigned int index, ConfigurationValueFlags flags, const char* type, std::size_t size, void* out, void(*convert)(const std::string&, ConfigurationValueFlags, void*)) const;
         std::vector<std::string> valuesInternal(const std::string& key, ConfigurationValueFlags flags) const;
+        /* Calls the callback for every value with given key, passing either
+           the stored string directly or a reused decoding buffer */
+        void forEachValueInternal(const std::string& key, void(*callback)(const std::string&, void*), void* state) const;
         bool setValueInternal(const std::string& key, std::string value, unsigned int number, ConfigurationValueFlags flags);
         void addValueInternal(std::string key, std::string value, ConfigurationValueFlags flags);
 
@@ -416,6 +548,17 @@ class CORRADE_UTILITY_EXPORT ConfigurationGroup {
         std::vector<Group> _groups;
 
         Configuration* _configuration;
+
+        /* Built lazily on first lookup if Configuration::Flag::HashedLookup
+           is enabled, reset when values or groups get removed */
+        mutable Containers::Pointer<Index> _index;
+        /* Snapshot made by the last Configuration::publish(), reset on every
+           modification of this group, but not of its subgroups */
+        mutable ConfigurationSnapshot _snapshot;
+        /* With Configuration::Flag::IncrementalSave the values of this group
+           as they were last loaded or saved, copied verbatim on the next
+           save. Reset on every modification of the values. */
+        Containers::StringView _savedValues;
 };
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
@@ -428,23 +571,78 @@ template<> inline std::string ConfigurationGroup::value(const std::string& key,
 template<> inline std::vector<std::string> ConfigurationGroup::values(const std::string& key, const ConfigurationValueFlags flags) const {
     return valuesInternal(key, flags);
 }
+template<> inline std::size_t ConfigurationGroup::values(const std::string& key, Containers::Array<std::string>& out, ConfigurationValueFlags) const {
+    struct State {
+        Containers::Array<std::string>& out;
+        std::size_t count;
+    };
+
+    State state{out, 0};
+    forEachValueInternal(key, [](const std::string& value, void* state) {
+        State& s = *static_cast<State*>(state);
+        Containers::arrayAppend(s.out, value);
+        ++s.count;
+    }, &state);
+
+    return state.count;
+}
 #endif
 
 template<class T> inline T ConfigurationGroup::value(const std::string& key, const unsigned int index, const ConfigurationValueFlags flags) const {
+    return typedValueInternal<T>(key, index, flags, IsCachedValue<T>{});
+}
+
+template<class T> const char ConfigurationGroup::CachedValueType<T>::Id{};
+
+template<class T> T ConfigurationGroup::typedValueInternal(const std::string& key, const unsigned int index, const ConfigurationValueFlags flags, std::false_type) const {
     std::string value = valueInternal(key, index, flags);
     return ConfigurationValue<T>::fromString(value, flags);
 }
 
+template<class T> T ConfigurationGroup::typedValueInternal(const std::string& key, const unsigned int index, const ConfigurationValueFlags flags, std::true_type) const {
+    alignas(T) char out[sizeof(T)];
+    if(!cachedValueInternal(key, index, flags, &CachedValueType<T>::Id, sizeof(T), out, [](const std::string& value, const ConfigurationValueFlags flags, void* const out) {
+        new(out) T(ConfigurationValue<T>::fromString(value, flags));
+    }))
+        return ConfigurationValue<T>::fromString(std::string{}, flags);
+
+    return *reinterpret_cast<T*>(out);
+}
+
 template<class T> std::vector<T> ConfigurationGroup::values(const std::string& key, const ConfigurationValueFlags flags) const {
-    std::vector<std::string> stringValues = valuesInternal(key, flags);
+    struct State {
+        std::vector<T>& values;
+        ConfigurationValueFlags flags;
+    };
+
     std::vector<T> values;
-    values.reserve(stringValues.size());
-    for(std::vector<std::string>::const_iterator it = stringValues.begin(); it != stringValues.end(); ++it)
-        values.push_back(ConfigurationValue<T>::fromString(*it, flags));
+    values.reserve(valueCount(key));
+    State state{values, flags};
+    forEachValueInternal(key, [](const std::string& value, void* state) {
+        State& s = *static_cast<State*>(state);
+        s.values.push_back(ConfigurationValue<T>::fromString(value, s.flags));
+    }, &state);
 
     return values;
 }
 
+template<class T> std::size_t ConfigurationGroup::values(const std::string& key, Containers::Array<T>& out, const ConfigurationValueFlags flags) const {
+    struct State {
+        Containers::Array<T>& out;
+        ConfigurationValueFlags flags;
+        std::size_t count;
+    };
+
+    State state{out, flags, 0};
+    forEachValueInternal(key, [](const std::string& value, void* state) {
+        State& s = *static_cast<State*>(state);
+        Containers::arrayAppend(s.out, ConfigurationValue<T>::fromString(value, s.flags));
+        ++s.count;
+    }, &state);
+
+    return state.count;
+}
+
 }}
 
 #endif
@@ -0,0 +1,255 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ConfigurationReader.h"
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Containers/ScopeGuard.h"
+#include "Corrade/Utility/DebugStl.h"
+
+#ifdef CORRADE_TARGET_WINDOWS
+#include "Corrade/Utility/Unicode.h"
+#endif
+
+namespace Corrade { namespace Utility {
+
+namespace {
+    constexpr std::size_t ChunkSize = 64*1024;
+
+    inline Containers::StringView view(const std::string& string) {
+        return {string.data(), string.size()};
+    }
+}
+
+ConfigurationReader::ConfigurationReader(): _line{}, _multiLine{}, _failed{} {}
+
+ConfigurationReader::~ConfigurationReader() = default;
+
+bool ConfigurationReader::parse(const std::string& filename) {
+    /* Special case for "Unicode" Windows support */
+    #ifndef CORRADE_TARGET_WINDOWS
+    std::FILE* const f = std::fopen(filename.data(), "rb");
+    #else
+    std::FILE* const f = _wfopen(Unicode::widen(filename).data(), L"rb");
+    #endif
+    if(!f) {
+        Error{} << "Utility::ConfigurationReader::parse(): can't open" << filename;
+        return false;
+    }
+
+    Containers::ScopeGuard exit{f, std::fclose};
+    return parse(f);
+}
+
+bool ConfigurationReader::parse(std::FILE* const file) {
+    Containers::Array<char> buffer{Containers::NoInit, ChunkSize};
+
+    bool ok = true;
+    while(const std::size_t size = std::fread(buffer.data(), 1, buffer.size(), file)) {
+        if(!feed({buffer.data(), size})) {
+            ok = false;
+            break;
+        }
+    }
+
+    if(ok && std::ferror(file)) {
+        Error{} << "Utility::ConfigurationReader::parse(): can't read the file";
+        ok = false;
+    }
+
+    /* Always finish to close the open groups and reset the state */
+    return finish() && ok;
+}
+
+bool ConfigurationReader::parseData(const Containers::StringView data) {
+    const bool ok = feed(data);
+    return finish() && ok;
+}
+
+bool ConfigurationReader::feed(Containers::StringView data) {
+    if(_failed) return false;
+
+    while(!data.empty()) {
+        /* No complete line anymore, remember the rest for next time */
+        const Containers::StringView newline = data.find('\n');
+        if(!newline.data()) {
+            _incomplete.append(data.data(), data.size());
+            return true;
+        }
+
+        /* If there's a part of this line from the previous chunk, parse it
+           together, otherwise parse directly from the input */
+        const Containers::StringView line = data.prefix(newline.begin());
+        data = data.suffix(newline.end());
+        if(_incomplete.empty()) {
+            if(!parseLine(line)) return false;
+        } else {
+            _incomplete.append(line.data(), line.size());
+            const bool ok = parseLine(view(_incomplete));
+            _incomplete.clear();
+            if(!ok) return false;
+        }
+    }
+
+    return true;
+}
+
+bool ConfigurationReader::finish() {
+    /* Last line without a trailing newline */
+    bool ok = !_failed;
+    if(ok && !_incomplete.empty())
+        ok = parseLine(view(_incomplete));
+
+    if(ok && _multiLine)
+        ok = error("missing closing quotes for a multi-line value");
+
+    /* Close all groups that are still open, even after an error, so the
+       callbacks are always balanced */
+    while(!_path.empty()) {
+        doGroupClose();
+        _path.pop_back();
+    }
+
+    _incomplete.clear();
+    _multiLineKey.clear();
+    _multiLineValue.clear();
+    _line = 0;
+    _multiLine = false;
+    _failed = false;
+    return ok;
+}
+
+bool ConfigurationReader::error(const char* const message) {
+    Error{} << "Utility::ConfigurationReader:" << message << "on line" << _line;
+    _failed = true;
+    return false;
+}
+
+bool ConfigurationReader::parseLine(Containers::StringView line) {
+    ++_line;
+
+    /* Oh, BOM, eww */
+    if(_line == 1 && line.hasPrefix("\xEF\xBB\xBF"))
+        line = line.suffix(3);
+
+    /* Multi-line value */
+    if(_multiLine) {
+        /* End of multi-line value, remove trailing newline, if present */
+        if(line.trimmed() == "\"\"\"") {
+            if(!_multiLineValue.empty())
+                _multiLineValue.resize(_multiLineValue.size() - 1);
+
+            doValue(view(_multiLineKey), view(_multiLineValue));
+            _multiLine = false;
+            return true;
+        }
+
+        /* Remove Windows EOL, if present, and append with a newline */
+        if(!line.empty() && line.back() == '\r') line = line.except(1);
+        _multiLineValue.append(line.data(), line.size());
+        _multiLineValue += '\n';
+        return true;
+    }
+
+    line = line.trimmed();
+
+    /* Empty line or a comment */
+    if(line.empty() || line[0] == '#' || line[0] == ';') return true;
+
+    /* Group header */
+    if(line[0] == '[') {
+        if(line.back() != ']')
+            return error("missing closing bracket for a group header");
+
+        Containers::StringView path = line.slice(1, line.size() - 1).trimmed();
+        if(path.empty())
+            return error("empty group name");
+
+        /* Find how many of the currently open groups are a prefix of the new
+           path. The last component always opens a new group, even if a
+           group of the same name is currently open. */
+        std::size_t common = 0;
+        for(; common != _path.size(); ++common) {
+            const std::string& name = _path[common];
+            if(path.size() <= name.size() || path.prefix(name.size()) != view(name) || path[name.size()] != '/')
+                break;
+            path = path.suffix(name.size() + 1);
+        }
+
+        /* Check the remaining components before emitting anything */
+        for(Containers::StringView rest = path; ; ) {
+            const Containers::StringView slash = rest.find('/');
+            const Containers::StringView name = slash.data() ? rest.prefix(slash.begin()) : rest;
+            if(name.empty()) return error("empty subgroup name");
+            if(!slash.data()) break;
+            rest = rest.suffix(slash.end());
+        }
+
+        /* Close the groups that don't match and open the new ones */
+        while(_path.size() > common) {
+            doGroupClose();
+            _path.pop_back();
+        }
+        for(;;) {
+            const Containers::StringView slash = path.find('/');
+            const Containers::StringView name = slash.data() ? path.prefix(slash.begin()) : path;
+            _path.emplace_back(name.data(), name.size());
+            doGroupOpen(name);
+            if(!slash.data()) break;
+            path = path.suffix(slash.end());
+        }
+
+        return true;
+    }
+
+    /* Key/value pair */
+    const Containers::StringView splitter = line.find('=');
+    if(!splitter.data())
+        return error("missing equals for a value");
+
+    const Containers::StringView key = line.prefix(splitter.begin()).trimmed();
+    Containers::StringView value = line.suffix(splitter.end()).trimmed();
+
+    /* Start of multi-line value */
+    if(value == "\"\"\"") {
+        _multiLineKey.assign(key.data(), key.size());
+        _multiLineValue.clear();
+        _multiLine = true;
+        return true;
+    }
+
+    /* Remove quotes, if present */
+    if(!value.empty() && value[0] == '"') {
+        if(value.size() < 2 || value.back() != '"')
+            return error("missing closing quote for a value");
+
+        value = value.slice(1, value.size() - 1);
+    }
+
+    doValue(key, value);
+    return true;
+}
+
+}}
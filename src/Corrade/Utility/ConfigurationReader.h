@@ -0,0 +1,180 @@
+#ifndef Corrade_Utility_ConfigurationReader_h
+#define Corrade_Utility_ConfigurationReader_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Utility::ConfigurationReader
+ * @m_since_latest
+ */
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Corrade/Containers/StringView.h"
+#include "Corrade/Utility/Utility.h"
+#include "Corrade/Utility/visibility.h"
+
+namespace Corrade { namespace Utility {
+
+/**
+@brief Streaming configuration file parser
+@m_since_latest
+
+Parses the same file format as @ref Configuration, but instead of building a
+tree of @ref ConfigurationGroup instances it calls @ref doGroupOpen(),
+@ref doValue() and @ref doGroupClose() for each group and value in the order
+they appear in the file. Comments and empty lines are skipped. Useful for
+filtering or indexing huge files without keeping all their contents in memory.
+Subclass it and implement the callbacks, for example:
+
+@snippet Utility.cpp ConfigurationReader-usage
+
+The input can be either a whole file, a @ref std::FILE, which is read in
+chunks of a fixed size, or data supplied incrementally using @ref feed()
+with @ref finish() at the end. Memory use of the parser is bounded by the
+longest line or the longest multi-line value, independently of the file size.
+
+The group events are nested --- every @ref doGroupOpen() is eventually
+followed by a @ref doGroupClose(), and the group nesting matches the tree
+that @ref Configuration would build. A @cb{.ini} [a/b] @ce header thus opens
+the @cpp "a" @ce group first, if it isn't already open, and then
+@cpp "b" @ce nested inside. All groups that are still open are closed at the
+end of the input.
+*/
+class CORRADE_UTILITY_EXPORT ConfigurationReader {
+    public:
+        /** @brief Constructor */
+        explicit ConfigurationReader();
+
+        /** @brief Copying is not allowed */
+        ConfigurationReader(const ConfigurationReader&) = delete;
+
+        /** @brief Moving is not allowed */
+        ConfigurationReader(ConfigurationReader&&) = delete;
+
+        virtual ~ConfigurationReader();
+
+        /** @brief Copying is not allowed */
+        ConfigurationReader& operator=(const ConfigurationReader&) = delete;
+
+        /** @brief Moving is not allowed */
+        ConfigurationReader& operator=(ConfigurationReader&&) = delete;
+
+        /**
+         * @brief Parse a file
+         * @param filename  Filename in UTF-8
+         *
+         * Opens the file and calls @ref parse(std::FILE*) on it. Returns
+         * @cpp false @ce if the file can't be opened or parsed.
+         */
+        bool parse(const std::string& filename);
+
+        /**
+         * @brief Parse a file stream
+         *
+         * Reads the stream in fixed-size chunks until its end, passes them to
+         * @ref feed() and then calls @ref finish(). The stream is not closed
+         * afterwards. Returns @cpp false @ce if reading or parsing fails.
+         */
+        bool parse(std::FILE* file);
+
+        /**
+         * @brief Parse data in memory
+         *
+         * Equivalent to calling @ref feed() with @p data followed by
+         * @ref finish().
+         */
+        bool parseData(Containers::StringView data);
+
+        /**
+         * @brief Feed a chunk of data
+         *
+         * The chunk can end anywhere, even in the middle of a line or of a
+         * multi-byte UTF-8 sequence --- complete lines are parsed right away,
+         * the rest is remembered and parsed together with the next chunk.
+         * Returns @cpp false @ce and prints a message to @ref Error if a
+         * parse error occurs. After an error, all subsequent calls are
+         * ignored and return @cpp false @ce until @ref finish() is called.
+         */
+        bool feed(Containers::StringView data);
+
+        /**
+         * @brief Finish parsing
+         *
+         * Parses the remaining data not terminated by a newline, closes all
+         * groups that are still open and resets the internal state so a new
+         * file can be parsed. Returns @cpp false @ce if there was an error
+         * during parsing or the input ended in the middle of a multi-line
+         * value.
+         */
+        bool finish();
+
+        /**
+         * @brief Line number of the last parsed line
+         *
+         * Counted from @cpp 1 @ce, reset to @cpp 0 @ce in @ref finish().
+         * Useful for diagnostics in the callbacks.
+         */
+        std::size_t line() const { return _line; }
+
+    private:
+        /**
+         * @brief Implementation for opening a group
+         *
+         * The @p name is the name of the group, not the full path. The view
+         * is valid only for the duration of the call.
+         */
+        virtual void doGroupOpen(Containers::StringView name) = 0;
+
+        /**
+         * @brief Implementation for a value
+         *
+         * The @p key and @p value are trimmed, quotes are removed from the
+         * value and multi-line values are joined with @cpp '\n' @ce. The
+         * views are valid only for the duration of the call.
+         */
+        virtual void doValue(Containers::StringView key, Containers::StringView value) = 0;
+
+        /** @brief Implementation for closing a group */
+        virtual void doGroupClose() = 0;
+
+        CORRADE_UTILITY_LOCAL bool parseLine(Containers::StringView line);
+        CORRADE_UTILITY_LOCAL bool error(const char* message);
+
+        /* Names of currently open groups */
+        std::vector<std::string> _path;
+        /* Part of a line from a previous chunk */
+        std::string _incomplete;
+        /* Key and contents of a multi-line value */
+        std::string _multiLineKey, _multiLineValue;
+        std::size_t _line;
+        bool _multiLine, _failed;
+};
+
+}}
+
+#endif
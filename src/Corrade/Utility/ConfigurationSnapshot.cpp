@@ -0,0 +1,143 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "ConfigurationSnapshot.h"
+
+#include "Corrade/Utility/Implementation/configurationSnapshot.h"
+
+namespace Corrade { namespace Utility {
+
+ConfigurationSnapshot::ConfigurationSnapshot(const ConfigurationSnapshot& other) noexcept: _data{other._data} {
+    if(_data) _data->references.fetch_add(1, std::memory_order_relaxed);
+}
+
+ConfigurationSnapshot::~ConfigurationSnapshot() {
+    /* Acquire so the deletion doesn't get reordered before other threads'
+       last accesses to the data, release for the same on the other side */
+    if(_data && _data->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        delete _data;
+}
+
+ConfigurationSnapshot& ConfigurationSnapshot::operator=(const ConfigurationSnapshot& other) noexcept {
+    ConfigurationSnapshot copy{other};
+    std::swap(_data, copy._data);
+    return *this;
+}
+
+ConfigurationSnapshot& ConfigurationSnapshot::operator=(ConfigurationSnapshot&& other) noexcept {
+    std::swap(_data, other._data);
+    return *this;
+}
+
+bool ConfigurationSnapshot::isEmpty() const {
+    return !_data || (_data->values.empty() && _data->groups.empty());
+}
+
+bool ConfigurationSnapshot::hasGroups() const {
+    return _data && !_data->groups.empty();
+}
+
+unsigned int ConfigurationSnapshot::groupCount() const {
+    return _data ? _data->groups.size() : 0;
+}
+
+bool ConfigurationSnapshot::hasGroup(const std::string& name, const unsigned int index) const {
+    return bool(group(name, index));
+}
+
+unsigned int ConfigurationSnapshot::groupCount(const std::string& name) const {
+    if(!_data) return 0;
+
+    unsigned int count = 0;
+    for(const std::pair<std::string, ConfigurationSnapshot>& group: _data->groups)
+        if(group.first == name) ++count;
+
+    return count;
+}
+
+ConfigurationSnapshot ConfigurationSnapshot::group(const std::string& name, const unsigned int index) const {
+    if(!_data) return {};
+
+    unsigned int foundIndex = 0;
+    for(const std::pair<std::string, ConfigurationSnapshot>& group: _data->groups)
+        if(group.first == name && foundIndex++ == index) return group.second;
+
+    return {};
+}
+
+std::vector<ConfigurationSnapshot> ConfigurationSnapshot::groups(const std::string& name) const {
+    std::vector<ConfigurationSnapshot> found;
+    if(!_data) return found;
+
+    for(const std::pair<std::string, ConfigurationSnapshot>& group: _data->groups)
+        if(group.first == name) found.push_back(group.second);
+
+    return found;
+}
+
+bool ConfigurationSnapshot::hasValues() const {
+    return _data && !_data->values.empty();
+}
+
+unsigned int ConfigurationSnapshot::valueCount() const {
+    return _data ? _data->values.size() : 0;
+}
+
+bool ConfigurationSnapshot::hasValue(const std::string& key, const unsigned int index) const {
+    return findValue(key, index);
+}
+
+unsigned int ConfigurationSnapshot::valueCount(const std::string& key) const {
+    if(!_data) return 0;
+
+    unsigned int count = 0;
+    for(const std::pair<std::string, std::string>& value: _data->values)
+        if(value.first == key) ++count;
+
+    return count;
+}
+
+const std::string* ConfigurationSnapshot::findValue(const std::string& key, const unsigned int index) const {
+    if(!_data) return nullptr;
+
+    unsigned int foundIndex = 0;
+    for(const std::pair<std::string, std::string>& value: _data->values)
+        if(value.first == key && foundIndex++ == index) return &value.second;
+
+    return nullptr;
+}
+
+std::vector<const std::string*> ConfigurationSnapshot::findValues(const std::string& key) const {
+    std::vector<const std::string*> found;
+    if(!_data) return found;
+
+    for(const std::pair<std::string, std::string>& value: _data->values)
+        if(value.first == key) found.push_back(&value.second);
+
+    return found;
+}
+
+}}
@@ -0,0 +1,267 @@
+#ifndef Corrade_Utility_ConfigurationSnapshot_h
+#define Corrade_Utility_ConfigurationSnapshot_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Utility::ConfigurationSnapshot
+ * @m_since_latest
+ */
+
+#include <string>
+#include <vector>
+
+#include "Corrade/Utility/ConfigurationValue.h"
+#include "Corrade/Utility/Utility.h"
+#include "Corrade/Utility/visibility.h"
+
+namespace Corrade { namespace Utility {
+
+namespace Implementation {
+    struct ConfigurationSnapshotData;
+}
+
+/**
+@brief Immutable snapshot of a configuration group
+@m_since_latest
+
+A read-only, reference-counted copy of a @ref ConfigurationGroup and all its
+subgroups, created by @ref Configuration::publish() and retrieved with
+@ref Configuration::snapshot(). Copying a snapshot only increments an atomic
+reference count and all queries are on immutable data, so snapshots can be
+passed to and queried from any number of threads without any locking, while
+the configuration itself is being modified on another thread:
+
+@snippet Utility.cpp Configuration-snapshot
+
+Subgroups that didn't change between two calls to
+@ref Configuration::publish() are shared between the snapshots instead of
+being copied again, which also allows for a cheap check of whether a
+particular group changed using @ref isSharedWith().
+
+The query API mirrors the read-only subset of @ref ConfigurationGroup. Values
+are stored already decoded, so multi-line values of a configuration with
+@ref Configuration::Flag::ReadOnly don't need to be decoded on every access
+and the snapshot doesn't reference the memory-mapped file. Comments and empty
+lines are not included. Lookup is linear in the number of values or subgroups,
+independently of @ref Configuration::Flag::HashedLookup.
+
+A default-constructed snapshot is empty and behaves like a group with no
+values and no subgroups.
+*/
+class CORRADE_UTILITY_EXPORT ConfigurationSnapshot {
+    public:
+        /**
+         * @brief Default constructor
+         *
+         * Creates an empty snapshot.
+         */
+        /*implicit*/ ConfigurationSnapshot() noexcept: _data{} {}
+
+        /** @brief Copy constructor */
+        ConfigurationSnapshot(const ConfigurationSnapshot& other) noexcept;
+
+        /** @brief Move constructor */
+        ConfigurationSnapshot(ConfigurationSnapshot&& other) noexcept: _data{other._data} {
+            other._data = nullptr;
+        }
+
+        /**
+         * @brief Destructor
+         *
+         * The data are freed once the last snapshot referencing them is
+         * destroyed.
+         */
+        ~ConfigurationSnapshot();
+
+        /** @brief Copy assignment */
+        ConfigurationSnapshot& operator=(const ConfigurationSnapshot& other) noexcept;
+
+        /** @brief Move assignment */
+        ConfigurationSnapshot& operator=(ConfigurationSnapshot&& other) noexcept;
+
+        /** @brief Whether the snapshot references any data */
+        explicit operator bool() const { return _data; }
+
+        /**
+         * @brief Whether the snapshots share the same data
+         *
+         * Returns @cpp true @ce if both snapshots are copies of each other or
+         * if they're snapshots of the same group that didn't change between
+         * two calls to @ref Configuration::publish(). Two empty snapshots are
+         * not considered shared.
+         */
+        bool isSharedWith(const ConfigurationSnapshot& other) const {
+            return _data && _data == other._data;
+        }
+
+        /**
+         * @brief Whether the group is empty
+         *
+         * @see @ref hasGroups(), @ref hasValues()
+         */
+        bool isEmpty() const;
+
+        /** @{ @name Group operations */
+
+        /**
+         * @brief Whether the group has any subgroups
+         *
+         * @see @ref isEmpty(), @ref hasGroup(), @ref groupCount()
+         */
+        bool hasGroups() const;
+
+        /**
+         * @brief Count of all subgroups
+         *
+         * @see @ref hasGroups()
+         */
+        unsigned int groupCount() const;
+
+        /**
+         * @brief Whether given group exists
+         * @param name      Name
+         * @param index     Group index. Default is first found group.
+         */
+        bool hasGroup(const std::string& name, unsigned int index = 0) const;
+
+        /** @brief Count of groups with given name */
+        unsigned int groupCount(const std::string& name) const;
+
+        /**
+         * @brief Group of given name
+         * @param name      Name
+         * @param index     Group index. Default is first found group.
+         *
+         * Returns an empty snapshot if the group doesn't exist. The returned
+         * snapshot keeps the group alive even after all snapshots of its
+         * parent are destroyed.
+         */
+        ConfigurationSnapshot group(const std::string& name, unsigned int index = 0) const;
+
+        /** @brief All groups with given name */
+        std::vector<ConfigurationSnapshot> groups(const std::string& name) const;
+
+        /*@}*/
+
+        /** @{ @name Value operations */
+
+        /**
+         * @brief Whether the group has any values
+         *
+         * @see @ref isEmpty(), @ref hasValue(), @ref valueCount()
+         */
+        bool hasValues() const;
+
+        /**
+         * @brief Count of all values in the group
+         *
+         * @see @ref hasValues()
+         */
+        unsigned int valueCount() const;
+
+        /**
+         * @brief Whether value exists
+         * @param key       Key
+         * @param index     Value index. Default is first found value.
+         */
+        bool hasValue(const std::string& key, unsigned int index = 0) const;
+
+        /** @brief Count of values with given key */
+        unsigned int valueCount(const std::string& key) const;
+
+        /**
+         * @brief Value
+         * @param key       Key
+         * @param index     Value index. Default is first found value.
+         * @param flags     Flags
+         *
+         * Same as @ref ConfigurationGroup::value(). If the key is not found,
+         * returns default constructed value.
+         */
+        template<class T = std::string> T value(const std::string& key, unsigned int index = 0, ConfigurationValueFlags flags = ConfigurationValueFlags()) const {
+            const std::string* const value = findValue(key, index);
+            return ConfigurationValue<T>::fromString(value ? *value : std::string{}, flags);
+        }
+
+        /** @overload
+         * Calls the above with @p index set to `0`.
+         */
+        template<class T = std::string> T value(const std::string& key, ConfigurationValueFlags flags) const {
+            return value<T>(key, 0, flags);
+        }
+
+        /**
+         * @brief All values with given key
+         * @param key       Key
+         * @param flags     Flags
+         *
+         * Same as @ref ConfigurationGroup::values().
+         */
+        template<class T = std::string> std::vector<T> values(const std::string& key, ConfigurationValueFlags flags = ConfigurationValueFlags()) const {
+            std::vector<T> out;
+            for(const std::string* value: findValues(key))
+                out.push_back(ConfigurationValue<T>::fromString(*value, flags));
+            return out;
+        }
+
+        /*@}*/
+
+    private:
+        friend Configuration;
+        friend ConfigurationGroup;
+
+        /* Takes over an existing reference */
+        explicit ConfigurationSnapshot(Implementation::ConfigurationSnapshotData* data) noexcept: _data{data} {}
+
+        /* Gives up the reference without decrementing it */
+        Implementation::ConfigurationSnapshotData* release() {
+            Implementation::ConfigurationSnapshotData* const data = _data;
+            _data = nullptr;
+            return data;
+        }
+
+        const std::string* findValue(const std::string& key, unsigned int index) const;
+        std::vector<const std::string*> findValues(const std::string& key) const;
+
+        Implementation::ConfigurationSnapshotData* _data;
+};
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+template<> inline std::string ConfigurationSnapshot::value(const std::string& key, const unsigned int index, ConfigurationValueFlags) const {
+    const std::string* const value = findValue(key, index);
+    return value ? *value : std::string{};
+}
+template<> inline std::vector<std::string> ConfigurationSnapshot::values(const std::string& key, ConfigurationValueFlags) const {
+    std::vector<std::string> out;
+    for(const std::string* value: findValues(key))
+        out.push_back(*value);
+    return out;
+}
+#endif
+
+}}
+
+#endif
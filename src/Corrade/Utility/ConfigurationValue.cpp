@@ -26,6 +26,10 @@
 #include "ConfigurationValue.h"
 
 #include <sstream>
+#include <type_traits>
+
+#include "Corrade/Containers/ArrayView.h"
+#include "Corrade/Utility/Parse.h"
 
 namespace Corrade { namespace Utility {
 
@@ -48,25 +52,65 @@ namespace Implementation {
         return stream.str();
     }
 
+    namespace {
+        /* Streams skip leading whitespace and accept a plus sign, do the same
+           for backwards compatibility */
+        Containers::ArrayView<const char> numberView(const std::string& string) {
+            std::size_t i = 0;
+            while(i != string.size() && (string[i] == ' ' || string[i] == '\t' || string[i] == '\n' || string[i] == '\r' || string[i] == '\v' || string[i] == '\f'))
+                ++i;
+            if(i != string.size() && string[i] == '+') ++i;
+            return {string.data() + i, string.size() - i};
+        }
+
+        /* Not using streams for numbers, as constructing a stream for every
+           value is very slow */
+        template<class T> T fromStringValue(const std::string& stringValue, const ConfigurationValueFlags flags, std::integral_constant<int, 0>) {
+            Containers::ArrayView<const char> view = numberView(stringValue);
+            int base = 10;
+            if(flags & ConfigurationValueFlag::Hex) {
+                base = 16;
+                if(view.size() >= 2 && view[0] == '0' && (view[1] == 'x' || view[1] == 'X'))
+                    view = view.suffix(2);
+            } else if(flags & ConfigurationValueFlag::Oct) base = 8;
+
+            T value{};
+            parseNumber(view, value, base);
+            return value;
+        }
+
+        template<class T> T fromStringValue(const std::string& stringValue, ConfigurationValueFlags, std::integral_constant<int, 1>) {
+            T value{};
+            parseNumber(numberView(stringValue), value);
+            return value;
+        }
+
+        template<class T> T fromStringValue(const std::string& stringValue, const ConfigurationValueFlags flags, std::integral_constant<int, 2>) {
+            std::istringstream stream{stringValue};
+
+            /* Hexadecimal / octal values, scientific notation */
+            if(flags & ConfigurationValueFlag::Hex)
+                stream.setf(std::istringstream::hex, std::istringstream::basefield);
+            else if(flags & ConfigurationValueFlag::Oct)
+                stream.setf(std::istringstream::oct, std::istringstream::basefield);
+            else if(flags & ConfigurationValueFlag::Scientific)
+                stream.setf(std::istringstream::scientific, std::istringstream::floatfield);
+
+            if(flags & ConfigurationValueFlag::Uppercase)
+                stream.setf(std::istringstream::uppercase);
+
+            T value;
+            stream >> value;
+            return value;
+        }
+    }
+
     template<class T> T BasicConfigurationValue<T>::fromString(const std::string& stringValue, ConfigurationValueFlags flags) {
         if(stringValue.empty()) return T{};
 
-        std::istringstream stream{stringValue};
-
-        /* Hexadecimal / octal values, scientific notation */
-        if(flags & ConfigurationValueFlag::Hex)
-            stream.setf(std::istringstream::hex, std::istringstream::basefield);
-        else if(flags & ConfigurationValueFlag::Oct)
-            stream.setf(std::istringstream::oct, std::istringstream::basefield);
-        else if(flags & ConfigurationValueFlag::Scientific)
-            stream.setf(std::istringstream::scientific, std::istringstream::floatfield);
-
-        if(flags & ConfigurationValueFlag::Uppercase)
-            stream.setf(std::istringstream::uppercase);
-
-        T value;
-        stream >> value;
-        return value;
+        return fromStringValue<T>(stringValue, flags, std::integral_constant<int,
+            std::is_integral<T>::value ? 0 :
+            std::is_floating_point<T>::value ? 1 : 2>{});
     }
 
     template struct BasicConfigurationValue<short>;
@@ -0,0 +1,192 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Cpu.h"
+
+#include "Corrade/Containers/EnumSet.hpp"
+#include "Corrade/Utility/Debug.h"
+
+#ifdef CORRADE_TARGET_X86
+#ifdef CORRADE_TARGET_MSVC
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#elif defined(CORRADE_TARGET_ARM) && (defined(__linux__) || defined(CORRADE_TARGET_ANDROID))
+#include <sys/auxv.h>
+#endif
+
+namespace Corrade { namespace Utility { namespace Cpu {
+
+Debug& operator<<(Debug& debug, const Feature value) {
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case Feature::value: return debug << "Utility::Cpu::Feature::" #value;
+        _c(Sse2)
+        _c(Sse3)
+        _c(Ssse3)
+        _c(Sse41)
+        _c(Sse42)
+        _c(Popcnt)
+        _c(Avx)
+        _c(Avx2)
+        _c(Fma)
+        _c(Avx512f)
+        _c(Avx512bw)
+        _c(Avx512vl)
+        _c(Neon)
+        _c(Simd128)
+        _c(Sha)
+        _c(NeonSha1)
+        _c(Pclmul)
+        _c(ArmCrc32)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "Utility::Cpu::Feature(" << Debug::nospace << reinterpret_cast<void*>(std::uint32_t(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const Features value) {
+    return Containers::enumSetDebugOutput(debug, value, "Utility::Cpu::Features{}", {
+        Feature::Sse2,
+        Feature::Sse3,
+        Feature::Ssse3,
+        Feature::Sse41,
+        Feature::Sse42,
+        Feature::Popcnt,
+        Feature::Avx,
+        Feature::Avx2,
+        Feature::Fma,
+        Feature::Avx512f,
+        Feature::Avx512bw,
+        Feature::Avx512vl,
+        Feature::Neon,
+        Feature::Simd128,
+        Feature::Sha,
+        Feature::NeonSha1,
+        Feature::Pclmul,
+        Feature::ArmCrc32});
+}
+
+namespace {
+
+#ifdef CORRADE_TARGET_X86
+void cpuid(unsigned int out[4], const unsigned int leaf, const unsigned int subleaf = 0) {
+    #ifdef CORRADE_TARGET_MSVC
+    int regs[4];
+    __cpuidex(regs, leaf, subleaf);
+    for(std::size_t i = 0; i != 4; ++i) out[i] = regs[i];
+    #else
+    __cpuid_count(leaf, subleaf, out[0], out[1], out[2], out[3]);
+    #endif
+}
+
+/* Which register state the OS saves on context switch. Only valid to call if
+   cpuid reports OSXSAVE. Not using the _xgetbv() intrinsic on GCC and Clang
+   because it needs -mxsave. */
+unsigned int xgetbv() {
+    #ifdef CORRADE_TARGET_MSVC
+    return unsigned(_xgetbv(0));
+    #else
+    unsigned int eax, edx;
+    __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return eax;
+    #endif
+}
+
+Features detect() {
+    Features out;
+
+    unsigned int regs[4]; /* eax, ebx, ecx, edx */
+    cpuid(regs, 0);
+    const unsigned int maxLeaf = regs[0];
+    if(maxLeaf < 1) return out;
+
+    cpuid(regs, 1);
+    if(regs[3] & (1 << 26)) out |= Feature::Sse2;
+    if(regs[2] & (1 << 0)) out |= Feature::Sse3;
+    if(regs[2] & (1 << 1)) out |= Feature::Pclmul;
+    if(regs[2] & (1 << 9)) out |= Feature::Ssse3;
+    if(regs[2] & (1 << 19)) out |= Feature::Sse41;
+    if(regs[2] & (1 << 20)) out |= Feature::Sse42;
+    if(regs[2] & (1 << 23)) out |= Feature::Popcnt;
+
+    /* AVX state (XMM and YMM registers) and AVX-512 state (additionally
+       opmask and the upper ZMM registers) has to be saved by the OS,
+       otherwise the instructions fault even though the CPU has them */
+    const bool osxsave = regs[2] & (1 << 27);
+    const unsigned int xcr0 = osxsave ? xgetbv() : 0;
+    const bool avxState = (xcr0 & 0x06) == 0x06;
+    const bool avx512State = (xcr0 & 0xe6) == 0xe6;
+    if(avxState) {
+        if(regs[2] & (1 << 28)) out |= Feature::Avx;
+        if(regs[2] & (1 << 12)) out |= Feature::Fma;
+    }
+
+    if(maxLeaf >= 7) {
+        cpuid(regs, 7, 0);
+        if(avxState && (regs[1] & (1 << 5))) out |= Feature::Avx2;
+        if(regs[1] & (1 << 29)) out |= Feature::Sha;
+        if(avx512State) {
+            if(regs[1] & (1 << 16)) out |= Feature::Avx512f;
+            if(regs[1] & (1 << 30)) out |= Feature::Avx512bw;
+            if(regs[1] & (1u << 31)) out |= Feature::Avx512vl;
+        }
+    }
+
+    return out;
+}
+#elif defined(CORRADE_TARGET_ARM) && (defined(__linux__) || defined(CORRADE_TARGET_ANDROID))
+Features detect() {
+    /* Not using the HWCAP_* macros as they're not defined everywhere */
+    Features out;
+    #ifdef __aarch64__
+    /* HWCAP_SHA1 and HWCAP_CRC32. NEON is always present on 64-bit ARM. */
+    if(getauxval(AT_HWCAP) & (1 << 5)) out |= Feature::NeonSha1;
+    if(getauxval(AT_HWCAP) & (1 << 7)) out |= Feature::ArmCrc32;
+    #else
+    /* HWCAP_NEON, HWCAP2_SHA1 and HWCAP2_CRC32 */
+    if(getauxval(AT_HWCAP) & (1 << 12)) out |= Feature::Neon;
+    #ifdef AT_HWCAP2
+    if(getauxval(AT_HWCAP2) & (1 << 2)) out |= Feature::NeonSha1;
+    if(getauxval(AT_HWCAP2) & (1 << 4)) out |= Feature::ArmCrc32;
+    #endif
+    #endif
+    return out;
+}
+#else
+/* No runtime detection on WebAssembly and elsewhere */
+Features detect() { return {}; }
+#endif
+
+}
+
+Features runtimeFeatures() {
+    static const Features features = detect()|compiledFeatures();
+    return features;
+}
+
+}}}
@@ -0,0 +1,381 @@
+#ifndef Corrade_Utility_Cpu_h
+#define Corrade_Utility_Cpu_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Namespace @ref Corrade::Utility::Cpu, enum @ref Corrade::Utility::Cpu::Feature, enum set @ref Corrade::Utility::Cpu::Features, function @ref Corrade::Utility::Cpu::compiledFeatures(), @ref Corrade::Utility::Cpu::runtimeFeatures(), @ref Corrade::Utility::Cpu::dispatch(), macro @ref CORRADE_ENABLE_SSE2, @ref CORRADE_ENABLE_AVX2 and related
+ */
+
+#include <initializer_list>
+
+#include "Corrade/Containers/EnumSet.h"
+#include "Corrade/Utility/Utility.h"
+#include "Corrade/Utility/visibility.h"
+
+namespace Corrade { namespace Utility {
+
+/**
+@brief CPU feature detection and dispatch
+
+Reports instruction set extensions the code was compiled for and the ones the
+machine it runs on actually supports, together with a lightweight mechanism for
+picking the best implementation of a function at runtime. That makes it
+possible to ship a single binary compiled for a baseline architecture and
+still make use of newer instruction sets where available:
+
+@snippet Utility.cpp Cpu-dispatch
+
+The function-local @cpp static @ce ensures the detection and the choice is
+done only once, on the first call, in a thread-safe way. Each subsequent call
+is then just a call through a function pointer.
+
+@section Utility-Cpu-enable Compiling for extended instruction sets
+
+So the specialized variants can use given instruction set without the whole
+file (or project) being compiled with e.g. `-mavx2`, annotate them with
+@ref CORRADE_ENABLE_AVX2 and similar macros. On GCC and Clang these expand to
+a function target attribute, on MSVC the intrinsics are allowed in any code and
+the macros are empty. It's the responsibility of the caller to ensure such
+functions get called only if @ref runtimeFeatures() reports given feature.
+
+This library is built if `WITH_UTILITY` is enabled when building Corrade. To
+use this library with CMake, request the `Utility` component of the `Corrade`
+package and link to the `Corrade::Utility` target.
+
+@code{.cmake}
+find_package(Corrade REQUIRED Utility)
+
+# ...
+target_link_libraries(your-app PRIVATE Corrade::Utility)
+@endcode
+
+See also @ref building-corrade and @ref corrade-cmake for more information.
+*/
+namespace Cpu {
+
+/**
+@brief CPU feature
+
+@see @ref Features, @ref compiledFeatures(), @ref runtimeFeatures()
+*/
+enum class Feature: std::uint32_t {
+    /** [SSE2](https://en.wikipedia.org/wiki/SSE2). Always present on x86-64. */
+    Sse2 = 1 << 0,
+
+    /** [SSE3](https://en.wikipedia.org/wiki/SSE3) */
+    Sse3 = 1 << 1,
+
+    /** [SSSE3](https://en.wikipedia.org/wiki/SSSE3) */
+    Ssse3 = 1 << 2,
+
+    /** [SSE4.1](https://en.wikipedia.org/wiki/SSE4#SSE4.1) */
+    Sse41 = 1 << 3,
+
+    /** [SSE4.2](https://en.wikipedia.org/wiki/SSE4#SSE4.2) */
+    Sse42 = 1 << 4,
+
+    /** [POPCNT](https://en.wikipedia.org/wiki/SSE4#POPCNT_and_LZCNT) */
+    Popcnt = 1 << 5,
+
+    /**
+     * [AVX](https://en.wikipedia.org/wiki/Advanced_Vector_Extensions).
+     * Reported at runtime only if the OS also saves the extended register
+     * state.
+     */
+    Avx = 1 << 6,
+
+    /**
+     * [AVX2](https://en.wikipedia.org/wiki/Advanced_Vector_Extensions#AVX2).
+     * Reported at runtime only if the OS also saves the extended register
+     * state.
+     */
+    Avx2 = 1 << 7,
+
+    /** [FMA3](https://en.wikipedia.org/wiki/FMA_instruction_set) */
+    Fma = 1 << 8,
+
+    /**
+     * [AVX-512](https://en.wikipedia.org/wiki/AVX-512) Foundation. Reported
+     * at runtime only if the OS also saves the extended register state.
+     */
+    Avx512f = 1 << 9,
+
+    /** AVX-512 Byte and Word instructions */
+    Avx512bw = 1 << 10,
+
+    /** AVX-512 Vector Length extensions */
+    Avx512vl = 1 << 11,
+
+    /**
+     * [ARM NEON](https://en.wikipedia.org/wiki/ARM_architecture#Advanced_SIMD_(NEON)).
+     * Always present on 64-bit ARM.
+     */
+    Neon = 1 << 12,
+
+    /**
+     * [WebAssembly SIMD](https://github.com/WebAssembly/simd). WebAssembly
+     * has no runtime detection, so this is reported only if compiled with
+     * `-msimd128`.
+     */
+    Simd128 = 1 << 13,
+
+    /**
+     * [SHA extensions](https://en.wikipedia.org/wiki/Intel_SHA_extensions)
+     * for SHA-1 and SHA-256
+     * @m_since_latest
+     */
+    Sha = 1 << 14,
+
+    /**
+     * ARMv8 SHA-1 instructions from the Cryptographic Extension. Detected at
+     * runtime only on Linux and Android.
+     * @m_since_latest
+     */
+    NeonSha1 = 1 << 15,
+
+    /**
+     * [PCLMULQDQ](https://en.wikipedia.org/wiki/CLMUL_instruction_set),
+     * carry-less multiplication
+     * @m_since_latest
+     */
+    Pclmul = 1 << 16,
+
+    /**
+     * ARMv8 CRC32 instructions. Detected at runtime only on Linux and
+     * Android.
+     * @m_since_latest
+     */
+    ArmCrc32 = 1 << 17
+};
+
+/**
+@brief CPU features
+
+@see @ref compiledFeatures(), @ref runtimeFeatures()
+*/
+typedef Containers::EnumSet<Feature> Features;
+
+CORRADE_ENUMSET_OPERATORS(Features)
+
+/** @debugoperatorenum{Feature} */
+CORRADE_UTILITY_EXPORT Debug& operator<<(Debug& debug, Feature value);
+
+/** @debugoperatorenum{Features} */
+CORRADE_UTILITY_EXPORT Debug& operator<<(Debug& debug, Features value);
+
+/**
+@brief Features enabled at compile time
+
+Features the compiler is allowed to use everywhere in the code, based on
+compiler flags such as `-msse4.2`, `-mavx2` or `/arch:AVX2`. Code using these
+doesn't need any runtime dispatch.
+@see @ref runtimeFeatures()
+*/
+constexpr Features compiledFeatures() {
+    return Features{}
+        #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        | Feature::Sse2
+        #endif
+        #if defined(__SSE3__) || (defined(CORRADE_TARGET_MSVC) && defined(__AVX__))
+        | Feature::Sse3
+        #endif
+        #if defined(__SSSE3__) || (defined(CORRADE_TARGET_MSVC) && defined(__AVX__))
+        | Feature::Ssse3
+        #endif
+        #if defined(__SSE4_1__) || (defined(CORRADE_TARGET_MSVC) && defined(__AVX__))
+        | Feature::Sse41
+        #endif
+        #if defined(__SSE4_2__) || (defined(CORRADE_TARGET_MSVC) && defined(__AVX__))
+        | Feature::Sse42
+        #endif
+        #if defined(__POPCNT__) || (defined(CORRADE_TARGET_MSVC) && defined(__AVX__))
+        | Feature::Popcnt
+        #endif
+        #ifdef __AVX__
+        | Feature::Avx
+        #endif
+        #ifdef __AVX2__
+        | Feature::Avx2
+        #endif
+        #if defined(__FMA__) || (defined(CORRADE_TARGET_MSVC) && defined(__AVX2__))
+        | Feature::Fma
+        #endif
+        #ifdef __AVX512F__
+        | Feature::Avx512f
+        #endif
+        #ifdef __AVX512BW__
+        | Feature::Avx512bw
+        #endif
+        #ifdef __AVX512VL__
+        | Feature::Avx512vl
+        #endif
+        #if defined(__ARM_NEON) || defined(_M_ARM64)
+        | Feature::Neon
+        #endif
+        #ifdef __wasm_simd128__
+        | Feature::Simd128
+        #endif
+        #ifdef __SHA__
+        | Feature::Sha
+        #endif
+        #if defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO)
+        | Feature::NeonSha1
+        #endif
+        #ifdef __PCLMUL__
+        | Feature::Pclmul
+        #endif
+        #ifdef __ARM_FEATURE_CRC32
+        | Feature::ArmCrc32
+        #endif
+        ;
+}
+
+/**
+@brief Features supported at runtime
+
+Detected using `cpuid` on x86 and `getauxval()` on ARM Linux and Android. On other platforms returns just @ref compiledFeatures(). The result
+is always a superset of @ref compiledFeatures() and is calculated only on the
+first call, subsequent calls return a cached value.
+*/
+CORRADE_UTILITY_EXPORT Features runtimeFeatures();
+
+/**
+@brief Dispatch variant
+@tparam T   Function pointer type
+
+@see @ref dispatch()
+*/
+template<class T> struct Variant {
+    Features features;  /**< @brief Features the variant needs */
+    T function;         /**< @brief Function pointer */
+};
+
+/**
+@brief Pick a function variant
+@param features     Features to pick from
+@param variants     Variants, in order of preference
+@param fallback     Fallback if no variant matches
+
+Returns the first of @p variants whose features are all present in
+@p features or @p fallback if there's none. See the @ref Cpu namespace
+documentation for an example.
+@see @ref dispatch(std::initializer_list<Variant<T>>, T)
+*/
+template<class T> T dispatch(Features features, std::initializer_list<Variant<T>> variants, T fallback) {
+    for(const Variant<T>& variant: variants)
+        if((features & variant.features) == variant.features)
+            return variant.function;
+    return fallback;
+}
+
+/**
+@brief Pick a function variant for this machine
+
+Equivalent to calling @ref dispatch(Features, std::initializer_list<Variant<T>>, T)
+with @ref runtimeFeatures().
+*/
+template<class T> T dispatch(std::initializer_list<Variant<T>> variants, T fallback) {
+    return dispatch(runtimeFeatures(), variants, fallback);
+}
+
+}
+
+}}
+
+#if defined(DOXYGEN_GENERATING_OUTPUT) || ((defined(CORRADE_TARGET_GCC) || defined(CORRADE_TARGET_CLANG)) && !defined(CORRADE_TARGET_CLANG_CL) && defined(CORRADE_TARGET_X86))
+/**
+@brief Enable SSE2 for given function
+
+Put in front of a function definition that uses SSE2 intrinsics without the
+whole file being compiled with them enabled. Expands to a function target
+attribute on GCC and Clang and is empty on MSVC. Defined only on
+@ref CORRADE_TARGET_X86 "x86". See @ref Utility-Cpu-enable for more
+information.
+*/
+#define CORRADE_ENABLE_SSE2 __attribute__((__target__("sse2")))
+
+/** @brief Enable SSE3 for given function */
+#define CORRADE_ENABLE_SSE3 __attribute__((__target__("sse3")))
+
+/** @brief Enable SSSE3 for given function */
+#define CORRADE_ENABLE_SSSE3 __attribute__((__target__("ssse3")))
+
+/** @brief Enable SSE4.1 for given function */
+#define CORRADE_ENABLE_SSE41 __attribute__((__target__("sse4.1")))
+
+/** @brief Enable SSE4.2 for given function */
+#define CORRADE_ENABLE_SSE42 __attribute__((__target__("sse4.2")))
+
+/** @brief Enable POPCNT for given function */
+#define CORRADE_ENABLE_POPCNT __attribute__((__target__("popcnt")))
+
+/** @brief Enable AVX for given function */
+#define CORRADE_ENABLE_AVX __attribute__((__target__("avx")))
+
+/** @brief Enable AVX2 for given function */
+#define CORRADE_ENABLE_AVX2 __attribute__((__target__("avx2")))
+
+/** @brief Enable FMA for given function */
+#define CORRADE_ENABLE_FMA __attribute__((__target__("fma")))
+
+/** @brief Enable AVX-512 Foundation for given function */
+#define CORRADE_ENABLE_AVX512F __attribute__((__target__("avx512f")))
+
+/** @brief Enable AVX-512 Byte and Word instructions for given function */
+#define CORRADE_ENABLE_AVX512BW __attribute__((__target__("avx512bw")))
+
+/** @brief Enable AVX-512 Vector Length extensions for given function */
+#define CORRADE_ENABLE_AVX512VL __attribute__((__target__("avx512vl")))
+
+/**
+@brief Enable SHA extensions for given function
+@m_since_latest
+*/
+#define CORRADE_ENABLE_SHA __attribute__((__target__("sha")))
+
+/**
+@brief Enable PCLMULQDQ for given function
+@m_since_latest
+*/
+#define CORRADE_ENABLE_PCLMUL __attribute__((__target__("pclmul")))
+#elif defined(CORRADE_TARGET_X86)
+#define CORRADE_ENABLE_SSE2
+#define CORRADE_ENABLE_SSE3
+#define CORRADE_ENABLE_SSSE3
+#define CORRADE_ENABLE_SSE41
+#define CORRADE_ENABLE_SSE42
+#define CORRADE_ENABLE_POPCNT
+#define CORRADE_ENABLE_AVX
+#define CORRADE_ENABLE_AVX2
+#define CORRADE_ENABLE_FMA
+#define CORRADE_ENABLE_AVX512F
+#define CORRADE_ENABLE_AVX512BW
+#define CORRADE_ENABLE_AVX512VL
+#define CORRADE_ENABLE_SHA
+#define CORRADE_ENABLE_PCLMUL
+#endif
+
+#endif
@@ -0,0 +1,356 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Crc32.h"
+
+#include <cstring>
+#include <string>
+
+#include "Corrade/Containers/ArrayView.h"
+#include "Corrade/Utility/Cpu.h"
+#include "Corrade/Utility/Endianness.h"
+#include "Corrade/Utility/Implementation/crc32.h"
+
+#ifdef CORRADE_TARGET_X86
+#include <immintrin.h>
+#endif
+#ifdef __ARM_FEATURE_CRC32
+#include <arm_acle.h>
+#endif
+
+namespace Corrade { namespace Utility {
+
+namespace {
+
+/* Reflected polynomials */
+constexpr std::uint32_t Crc32Polynomial = 0xedb88320u;
+constexpr std::uint32_t Crc32cPolynomial = 0x82f63b78u;
+
+/* Memcpy to avoid unaligned reads on platforms that don't like it */
+inline std::uint32_t read32(const char* const data) {
+    std::uint32_t value;
+    std::memcpy(&value, data, 4);
+    return Endianness::littleEndian(value);
+}
+
+#if defined(CORRADE_TARGET_X86) || defined(__ARM_FEATURE_CRC32)
+inline std::uint64_t read64(const char* const data) {
+    std::uint64_t value;
+    std::memcpy(&value, data, 8);
+    return Endianness::littleEndian(value);
+}
+#endif
+
+/* Multiplies two polynomials modulo given polynomial, all in the reflected
+   representation where x^0 is the highest bit */
+std::uint32_t multiplyModulo(std::uint32_t a, std::uint32_t b, const std::uint32_t polynomial) {
+    std::uint32_t product = 0;
+    for(std::uint32_t mask = 1u << 31; mask; mask >>= 1) {
+        if(a & mask) product ^= b;
+        b = b & 1 ? (b >> 1) ^ polynomial : b >> 1;
+    }
+    return product;
+}
+
+/* x^(8*size) modulo given polynomial, i.e. what a CRC state gets multiplied
+   with when shifted by given count of bytes. Squaring x^(2^k), starting with
+   x^8. */
+std::uint32_t shiftBytes(std::size_t size, const std::uint32_t polynomial) {
+    std::uint32_t power = 1u << (31 - 8);
+    std::uint32_t out = 1u << 31;
+    for(; size; size >>= 1) {
+        if(size & 1) out = multiplyModulo(power, out, polynomial);
+        power = multiplyModulo(power, power, polynomial);
+    }
+    return out;
+}
+
+/* Tables for slicing-by-8. The first is the classic byte-wise table, each
+   next one advances the previous by one more zero byte. */
+struct Tables {
+    std::uint32_t data[8][256];
+};
+
+Tables makeTables(const std::uint32_t polynomial) {
+    Tables out;
+    for(std::uint32_t i = 0; i != 256; ++i) {
+        std::uint32_t value = i;
+        for(std::size_t j = 0; j != 8; ++j)
+            value = value & 1 ? (value >> 1) ^ polynomial : value >> 1;
+        out.data[0][i] = value;
+    }
+    for(std::size_t i = 1; i != 8; ++i)
+        for(std::size_t j = 0; j != 256; ++j)
+            out.data[i][j] = (out.data[i - 1][j] >> 8) ^ out.data[0][out.data[i - 1][j] & 0xff];
+    return out;
+}
+
+std::uint32_t updateScalar(const Tables& tables, std::uint32_t state, const char* data, std::size_t size) {
+    const std::uint32_t(&t)[8][256] = tables.data;
+    for(; size >= 8; size -= 8, data += 8) {
+        const std::uint32_t a = read32(data) ^ state;
+        const std::uint32_t b = read32(data + 4);
+        state = t[7][a & 0xff] ^ t[6][(a >> 8) & 0xff] ^ t[5][(a >> 16) & 0xff] ^ t[4][a >> 24] ^
+                t[3][b & 0xff] ^ t[2][(b >> 8) & 0xff] ^ t[1][(b >> 16) & 0xff] ^ t[0][b >> 24];
+    }
+    for(; size; --size, ++data)
+        state = t[0][(state ^ std::uint8_t(*data)) & 0xff] ^ (state >> 8);
+    return state;
+}
+
+std::uint32_t crc32UpdateScalar(const std::uint32_t state, const char* const data, const std::size_t size) {
+    static const Tables tables = makeTables(Crc32Polynomial);
+    return updateScalar(tables, state, data, size);
+}
+
+std::uint32_t crc32cUpdateScalar(const std::uint32_t state, const char* const data, const std::size_t size) {
+    static const Tables tables = makeTables(Crc32cPolynomial);
+    return updateScalar(tables, state, data, size);
+}
+
+#ifdef CORRADE_TARGET_X86
+/* Folding four 128-bit lanes at a time with carry-less multiplication,
+   followed by a Barrett reduction, as described in the Intel "Fast CRC
+   Computation for Generic Polynomials Using PCLMULQDQ Instruction" paper.
+   The constants are for the reflected CRC-32 polynomial. Expects at least 64
+   bytes and a multiple of 16. */
+CORRADE_ENABLE_PCLMUL std::uint32_t crc32FoldPclmul(const std::uint32_t state, const char* data, std::size_t size) {
+    const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596ll, 0x0154442bd4ll);
+    const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009ell, 0x01751997d0ll);
+    const __m128i k5 = _mm_set_epi64x(0, 0x0163cd6124ll);
+    const __m128i polynomial = _mm_set_epi64x(0x01f7011641ll, 0x01db710641ll);
+    const __m128i mask32 = _mm_setr_epi32(-1, 0, -1, 0);
+
+    __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data) + 0);
+    __m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data) + 1);
+    __m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data) + 2);
+    __m128i x4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data) + 3);
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(int(state)));
+    data += 64;
+    size -= 64;
+
+    /* Fold 64 bytes at a time into the four lanes */
+    for(; size >= 64; size -= 64, data += 64) {
+        const __m128i x5 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+        const __m128i x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+        const __m128i x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+        const __m128i x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data) + 0));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data) + 1));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data) + 2));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data) + 3));
+    }
+
+    /* Fold the four lanes into one, then the remaining 16-byte blocks */
+    __m128i x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x2), x5);
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x3), x5);
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x4), x5);
+    for(; size >= 16; size -= 16, data += 16) {
+        x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+        x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data))), x5);
+    }
+
+    /* Fold 128 bits to 64 */
+    x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_xor_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, mask32), k5, 0x00), x2);
+
+    /* Barrett reduction to 32 bits */
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), polynomial, 0x10);
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask32), polynomial, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    return std::uint32_t(_mm_cvtsi128_si32(_mm_srli_si128(x1, 4)));
+}
+
+CORRADE_ENABLE_PCLMUL std::uint32_t crc32UpdatePclmul(std::uint32_t state, const char* data, std::size_t size) {
+    if(size >= 64) {
+        const std::size_t folded = size & ~std::size_t{15};
+        state = crc32FoldPclmul(state, data, folded);
+        data += folded;
+        size -= folded;
+    }
+    return crc32UpdateScalar(state, data, size);
+}
+
+CORRADE_ENABLE_SSE42 inline std::uint32_t crc32cSse42(std::uint32_t state, const char* data, std::size_t size) {
+    #if defined(__x86_64__) || defined(_M_X64)
+    for(; size >= 8; size -= 8, data += 8)
+        state = std::uint32_t(_mm_crc32_u64(state, read64(data)));
+    #endif
+    for(; size >= 4; size -= 4, data += 4)
+        state = _mm_crc32_u32(state, read32(data));
+    for(; size; --size, ++data)
+        state = _mm_crc32_u8(state, std::uint8_t(*data));
+    return state;
+}
+
+/* The crc32 instruction has a latency of three cycles but a throughput of
+   one, so large inputs are split into three independent streams that are
+   merged afterwards by shifting the first two over the bytes that follow */
+constexpr std::size_t Crc32cStreamSize = 8192;
+
+CORRADE_ENABLE_SSE42 std::uint32_t crc32cUpdateSse42(std::uint32_t state, const char* data, std::size_t size) {
+    if(size >= 3*Crc32cStreamSize) {
+        const std::uint32_t shift1 = shiftBytes(Crc32cStreamSize, Crc32cPolynomial);
+        const std::uint32_t shift2 = shiftBytes(2*Crc32cStreamSize, Crc32cPolynomial);
+        for(; size >= 3*Crc32cStreamSize; size -= 3*Crc32cStreamSize, data += 3*Crc32cStreamSize) {
+            std::uint32_t a = state, b = 0, c = 0;
+            #if defined(__x86_64__) || defined(_M_X64)
+            for(std::size_t i = 0; i != Crc32cStreamSize; i += 8) {
+                a = std::uint32_t(_mm_crc32_u64(a, read64(data + i)));
+                b = std::uint32_t(_mm_crc32_u64(b, read64(data + Crc32cStreamSize + i)));
+                c = std::uint32_t(_mm_crc32_u64(c, read64(data + 2*Crc32cStreamSize + i)));
+            }
+            #else
+            for(std::size_t i = 0; i != Crc32cStreamSize; i += 4) {
+                a = _mm_crc32_u32(a, read32(data + i));
+                b = _mm_crc32_u32(b, read32(data + Crc32cStreamSize + i));
+                c = _mm_crc32_u32(c, read32(data + 2*Crc32cStreamSize + i));
+            }
+            #endif
+            state = multiplyModulo(shift2, a, Crc32cPolynomial) ^
+                    multiplyModulo(shift1, b, Crc32cPolynomial) ^ c;
+        }
+    }
+
+    return crc32cSse42(state, data, size);
+}
+#endif
+
+#ifdef __ARM_FEATURE_CRC32
+std::uint32_t crc32UpdateArm(std::uint32_t state, const char* data, std::size_t size) {
+    for(; size >= 8; size -= 8, data += 8)
+        state = __crc32d(state, read64(data));
+    for(; size; --size, ++data)
+        state = __crc32b(state, std::uint8_t(*data));
+    return state;
+}
+
+std::uint32_t crc32cUpdateArm(std::uint32_t state, const char* data, std::size_t size) {
+    for(; size >= 8; size -= 8, data += 8)
+        state = __crc32cd(state, read64(data));
+    for(; size; --size, ++data)
+        state = __crc32cb(state, std::uint8_t(*data));
+    return state;
+}
+#endif
+
+Implementation::Crc32UpdateFunction crc32Update() {
+    static const Implementation::Crc32UpdateFunction function = Implementation::crc32UpdateFunction(Cpu::runtimeFeatures());
+    return function;
+}
+
+Implementation::Crc32UpdateFunction crc32cUpdate() {
+    static const Implementation::Crc32UpdateFunction function = Implementation::crc32cUpdateFunction(Cpu::runtimeFeatures());
+    return function;
+}
+
+inline HashDigest<4> digestFromValue(const std::uint32_t value) {
+    return HashDigest<4>{value >> 24, value >> 16, value >> 8, value};
+}
+
+}
+
+namespace Implementation {
+
+Crc32UpdateFunction crc32UpdateFunction(const Cpu::Features features) {
+    return Cpu::dispatch<Crc32UpdateFunction>(features, {
+        #ifdef CORRADE_TARGET_X86
+        {Cpu::Feature::Pclmul, crc32UpdatePclmul},
+        #endif
+        #ifdef __ARM_FEATURE_CRC32
+        {Cpu::Feature::ArmCrc32, crc32UpdateArm},
+        #endif
+    }, crc32UpdateScalar);
+}
+
+Crc32UpdateFunction crc32cUpdateFunction(const Cpu::Features features) {
+    return Cpu::dispatch<Crc32UpdateFunction>(features, {
+        #ifdef CORRADE_TARGET_X86
+        {Cpu::Feature::Sse42, crc32cUpdateSse42},
+        #endif
+        #ifdef __ARM_FEATURE_CRC32
+        {Cpu::Feature::ArmCrc32, crc32cUpdateArm},
+        #endif
+    }, crc32cUpdateScalar);
+}
+
+}
+
+std::uint32_t Crc32::checksum(const Containers::ArrayView<const char> data, const std::uint32_t initial) {
+    return ~crc32Update()(~initial, data.data(), data.size());
+}
+
+std::uint32_t Crc32::combine(const std::uint32_t first, const std::uint32_t second, const std::size_t secondSize) {
+    return multiplyModulo(shiftBytes(secondSize, Crc32Polynomial), first, Crc32Polynomial) ^ second;
+}
+
+Crc32& Crc32::operator<<(const Containers::ArrayView<const char> data) {
+    _state = crc32Update()(_state, data.data(), data.size());
+    return *this;
+}
+
+Crc32& Crc32::operator<<(const std::string& data) {
+    return *this << Containers::arrayView(data.data(), data.size());
+}
+
+Crc32::Digest Crc32::digest() {
+    const Digest out = digestFromValue(value());
+    _state = ~std::uint32_t{};
+    return out;
+}
+
+std::uint32_t Crc32c::checksum(const Containers::ArrayView<const char> data, const std::uint32_t initial) {
+    return ~crc32cUpdate()(~initial, data.data(), data.size());
+}
+
+std::uint32_t Crc32c::combine(const std::uint32_t first, const std::uint32_t second, const std::size_t secondSize) {
+    return multiplyModulo(shiftBytes(secondSize, Crc32cPolynomial), first, Crc32cPolynomial) ^ second;
+}
+
+Crc32c& Crc32c::operator<<(const Containers::ArrayView<const char> data) {
+    _state = crc32cUpdate()(_state, data.data(), data.size());
+    return *this;
+}
+
+Crc32c& Crc32c::operator<<(const std::string& data) {
+    return *this << Containers::arrayView(data.data(), data.size());
+}
+
+Crc32c::Digest Crc32c::digest() {
+    const Digest out = digestFromValue(value());
+    _state = ~std::uint32_t{};
+    return out;
+}
+
+}}
@@ -0,0 +1,241 @@
+#ifndef Corrade_Utility_Crc32_h
+#define Corrade_Utility_Crc32_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Utility::Crc32, @ref Corrade::Utility::Crc32c
+ * @m_since_latest
+ */
+
+#include <cstdint>
+
+#include "Corrade/Containers/Containers.h"
+#include "Corrade/Utility/AbstractHash.h"
+#include "Corrade/Utility/StlForwardString.h"
+#include "Corrade/Utility/visibility.h"
+
+namespace Corrade { namespace Utility {
+
+/**
+@brief CRC-32 checksum
+@m_since_latest
+
+Implementation of the [CRC-32](https://en.wikipedia.org/wiki/Cyclic_redundancy_check)
+checksum with the reflected @cpp 0xedb88320 @ce polynomial, as used by zlib,
+PNG, Ethernet and others. It's not a cryptographic hash, but it's
+significantly faster than @ref Sha1 and, unlike @ref MurmurHash2, a
+standardized checksum. Example usage:
+
+@snippet Utility.cpp Crc32-usage
+
+The digest is the checksum in a big-endian representation, i.e. its
+@ref HashDigest::hexString() matches what the `crc32` utility prints. The
+numeric value is available through @ref value() or the one-shot
+@ref checksum().
+
+@section Utility-Crc32-parallel Calculating in parallel
+
+A checksum of a concatenation of two blocks can be calculated from checksums
+of the two blocks and size of the second using @ref combine(), which makes it
+possible to checksum large data in parallel and merge the results afterwards.
+Alternatively, a checksum can be continued from a previously calculated value
+by passing it to the constructor.
+
+@section Utility-Crc32-acceleration Hardware acceleration
+
+Inputs of at least 64 bytes are folded with
+[PCLMULQDQ](https://en.wikipedia.org/wiki/CLMUL_instruction_set) if
+@ref Cpu::runtimeFeatures() reports @ref Cpu::Feature::Pclmul. On ARM, the
+ARMv8 CRC32 instructions are used if the library is compiled with them
+enabled and @ref Cpu::Feature::ArmCrc32 is reported. A portable
+slicing-by-8 implementation is used otherwise. Data passed to
+@ref operator<<(Containers::ArrayView<const char>) are processed directly,
+without any intermediate buffering.
+@see @ref Crc32c
+*/
+class CORRADE_UTILITY_EXPORT Crc32: public AbstractHash<4> {
+    public:
+        /**
+         * @brief Digest of given data
+         *
+         * Convenience function for @cpp (Utility::Crc32{} << data).digest() @ce.
+         */
+        static Digest digest(const std::string& data) {
+            return (Crc32{} << data).digest();
+        }
+
+        /**
+         * @brief Checksum of given data
+         * @param data      Data to checksum
+         * @param initial   Checksum of data preceding @p data
+         *
+         * Convenience function for @cpp (Utility::Crc32{initial} << data).value() @ce.
+         */
+        static std::uint32_t checksum(Containers::ArrayView<const char> data, std::uint32_t initial = 0);
+
+        /**
+         * @brief Combine checksums of two consecutive blocks
+         * @param first         Checksum of the first block
+         * @param second        Checksum of the second block
+         * @param secondSize    Size of the second block in bytes
+         *
+         * Returns the checksum of the two blocks concatenated. The operation
+         * is logarithmic in @p secondSize, not linear.
+         */
+        static std::uint32_t combine(std::uint32_t first, std::uint32_t second, std::size_t secondSize);
+
+        /**
+         * @brief Constructor
+         * @param initial   Checksum of data preceding the data that will be
+         *      added
+         */
+        explicit Crc32(std::uint32_t initial = 0): _state{~initial} {}
+
+        /** @brief Add data for digesting */
+        Crc32& operator<<(Containers::ArrayView<const char> data);
+
+        /** @overload */
+        Crc32& operator<<(const std::string& data);
+
+        /**
+         * @brief @cpp operator<< @ce with C strings is not allowed
+         *
+         * To clarify your intent with handling the @cpp '\0' @ce delimiter,
+         * cast to @ref Containers::ArrayView or @ref std::string instead.
+         */
+        Crc32& operator<<(const char*) = delete;
+
+        /**
+         * @brief Checksum of all added data
+         *
+         * Unlike @ref digest() doesn't reset the state.
+         */
+        std::uint32_t value() const { return ~_state; }
+
+        /**
+         * @brief Digest of all added data
+         *
+         * Resets the state afterwards, so the instance can be reused for
+         * checksumming other data.
+         */
+        Digest digest();
+
+    private:
+        std::uint32_t _state;
+};
+
+/**
+@brief CRC-32C checksum
+@m_since_latest
+
+Implementation of the CRC-32C (Castagnoli) checksum with the reflected
+@cpp 0x82f63b78 @ce polynomial, as used by iSCSI, SCTP, ext4, Btrfs and
+others. Compared to @ref Crc32 it has better error detection properties and
+a dedicated instruction on both x86 and ARM, making it a better choice if
+you're not bound by an existing format. The interface is the same as for
+@ref Crc32, including @ref combine() for calculating in parallel. Example
+usage:
+
+@snippet Utility.cpp Crc32c-usage
+
+@section Utility-Crc32c-acceleration Hardware acceleration
+
+The SSE4.2 @cpp crc32 @ce instruction is used if
+@ref Cpu::runtimeFeatures() reports @ref Cpu::Feature::Sse42. On ARM, the
+ARMv8 CRC32C instructions are used if the library is compiled with them
+enabled and @ref Cpu::Feature::ArmCrc32 is reported. A portable
+slicing-by-8 implementation is used otherwise.
+*/
+class CORRADE_UTILITY_EXPORT Crc32c: public AbstractHash<4> {
+    public:
+        /**
+         * @brief Digest of given data
+         *
+         * Convenience function for @cpp (Utility::Crc32c{} << data).digest() @ce.
+         */
+        static Digest digest(const std::string& data) {
+            return (Crc32c{} << data).digest();
+        }
+
+        /**
+         * @brief Checksum of given data
+         * @param data      Data to checksum
+         * @param initial   Checksum of data preceding @p data
+         *
+         * Convenience function for @cpp (Utility::Crc32c{initial} << data).value() @ce.
+         */
+        static std::uint32_t checksum(Containers::ArrayView<const char> data, std::uint32_t initial = 0);
+
+        /**
+         * @brief Combine checksums of two consecutive blocks
+         *
+         * See @ref Crc32::combine() for more information.
+         */
+        static std::uint32_t combine(std::uint32_t first, std::uint32_t second, std::size_t secondSize);
+
+        /**
+         * @brief Constructor
+         * @param initial   Checksum of data preceding the data that will be
+         *      added
+         */
+        explicit Crc32c(std::uint32_t initial = 0): _state{~initial} {}
+
+        /** @brief Add data for digesting */
+        Crc32c& operator<<(Containers::ArrayView<const char> data);
+
+        /** @overload */
+        Crc32c& operator<<(const std::string& data);
+
+        /**
+         * @brief @cpp operator<< @ce with C strings is not allowed
+         *
+         * To clarify your intent with handling the @cpp '\0' @ce delimiter,
+         * cast to @ref Containers::ArrayView or @ref std::string instead.
+         */
+        Crc32c& operator<<(const char*) = delete;
+
+        /**
+         * @brief Checksum of all added data
+         *
+         * Unlike @ref digest() doesn't reset the state.
+         */
+        std::uint32_t value() const { return ~_state; }
+
+        /**
+         * @brief Digest of all added data
+         *
+         * Resets the state afterwards, so the instance can be reused for
+         * checksumming other data.
+         */
+        Digest digest();
+
+    private:
+        std::uint32_t _state;
+};
+
+}}
+
+#endif
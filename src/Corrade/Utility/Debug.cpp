@@ -25,9 +25,10 @@
 
 #include "Debug.h"
 
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
-#include <iomanip>
 #include <sstream>
 
 /* For isatty() on Unix-like systems */
@@ -54,7 +55,9 @@
 #endif
 
 #include "Corrade/Containers/EnumSet.hpp"
+#include "Corrade/Containers/StringView.h"
 #include "Corrade/Utility/DebugStl.h"
+#include "Corrade/Utility/Format.h"
 
 #if defined(CORRADE_TARGET_WINDOWS) && defined(CORRADE_BUILD_STATIC) && !defined(CORRADE_TARGET_WINDOWS_RT)
 #include "Corrade/Utility/Implementation/WindowsWeakSymbol.h"
@@ -68,14 +71,6 @@ namespace Corrade { namespace Utility {
 
 namespace {
 
-template<class T> inline void toStream(std::ostream& s, const T& value) {
-    s << value;
-}
-
-template<> inline void toStream<Implementation::DebugOstreamFallback>(std::ostream& s, const Implementation::DebugOstreamFallback& value) {
-    value.apply(s);
-}
-
 #if defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_UTILITY_USE_ANSI_COLORS)
 HANDLE streamOutputHandle(const std::ostream* s) {
     return s == &std::cout ? GetStdHandle(STD_OUTPUT_HANDLE) :
@@ -94,7 +89,8 @@ namespace {
 #endif
 
 struct DebugGlobals {
-    std::ostream *output, *warningOutput, *errorOutput;
+    Implementation::DebugOutput output, warningOutput, errorOutput;
+    std::size_t elementLimit;
     #if !defined(CORRADE_TARGET_WINDOWS) ||defined(CORRADE_UTILITY_USE_ANSI_COLORS)
     Debug::Color color;
     bool colorBold;
@@ -117,7 +113,10 @@ CORRADE_VISIBILITY_EXPORT
     #endif
 #endif
 DebugGlobals debugGlobals{
-    &std::cout, &std::cerr, &std::cerr,
+    {&std::cout, nullptr, nullptr},
+    {&std::cerr, nullptr, nullptr},
+    {&std::cerr, nullptr, nullptr},
+    0,
     #if !defined(CORRADE_TARGET_WINDOWS) ||defined(CORRADE_UTILITY_USE_ANSI_COLORS)
     Debug::Color::Default, false
     #endif
@@ -166,7 +165,7 @@ DebugGlobals& windowsDebugGlobals() {
 
 template<Debug::Color c, bool bold> Debug::Modifier Debug::colorInternal() {
     return [](Debug& debug) {
-        if(!debug._output || (debug._flags & InternalFlag::DisableColors)) return;
+        if((!debug._output && !debug._writer) || (debug._flags & InternalFlag::DisableColors)) return;
 
         debug._flags |= InternalFlag::ColorWritten|InternalFlag::ValueWritten;
         #if defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_UTILITY_USE_ANSI_COLORS)
@@ -178,14 +177,14 @@ template<Debug::Color c, bool bold> Debug::Modifier Debug::colorInternal() {
         #else
         debugGlobals.color = c;
         debugGlobals.colorBold = bold;
-        constexpr const char code[] = { '\033', '[', bold ? '1' : '0', ';', '3', '0' + char(c), 'm', '\0' };
-        *debug._output << code;
+        constexpr const char code[] = { '\033', '[', bold ? '1' : '0', ';', '3', '0' + char(c), 'm' };
+        debug.write(code, sizeof(code));
         #endif
     };
 }
 
 inline void Debug::resetColorInternal() {
-    if(!_output || !(_flags & InternalFlag::ColorWritten)) return;
+    if((!_output && !_writer) || !(_flags & InternalFlag::ColorWritten)) return;
 
     _flags &= ~InternalFlag::ColorWritten;
     _flags |= InternalFlag::ValueWritten;
@@ -195,9 +194,9 @@ inline void Debug::resetColorInternal() {
         SetConsoleTextAttribute(h, _previousColorAttributes);
     #else
     if(_previousColor != Color::Default || _previousColorBold) {
-        const char code[] = { '\033', '[', _previousColorBold ? '1' : '0', ';', '3', char('0' + char(_previousColor)), 'm', '\0' };
-        *_output << code;
-    } else *_output << "\033[0m";
+        const char code[] = { '\033', '[', _previousColorBold ? '1' : '0', ';', '3', char('0' + char(_previousColor)), 'm' };
+        write(code, sizeof(code));
+    } else write("\033[0m", 4);
 
     debugGlobals.color = _previousColor;
     debugGlobals.colorBold = _previousColorBold;
@@ -278,9 +277,14 @@ std::ostream* Debug::defaultOutput() { return &std::cout; }
 std::ostream* Warning::defaultOutput() { return &std::cerr; }
 std::ostream* Error::defaultOutput() { return &std::cerr; }
 
-std::ostream* Debug::output() { return debugGlobals.output; }
-std::ostream* Warning::output() { return debugGlobals.warningOutput; }
-std::ostream* Error::output() { return debugGlobals.errorOutput; }
+std::ostream* Debug::output() { return debugGlobals.output.stream; }
+std::ostream* Warning::output() { return debugGlobals.warningOutput.stream; }
+std::ostream* Error::output() { return debugGlobals.errorOutput.stream; }
+
+void Debug::fileWriter(void* const file, const char* const data, const std::size_t size) {
+    std::fwrite(data, 1, size, static_cast<std::FILE*>(file));
+    if(size && data[size - 1] == '\n') std::fflush(static_cast<std::FILE*>(file));
+}
 
 bool Debug::isTty(std::ostream* const output) {
     /* On Windows with WINAPI colors check the stream output handle */
@@ -352,14 +356,14 @@ bool Debug::isTty(std::ostream* const output) {
     #endif
 }
 
-bool Debug::isTty() { return isTty(debugGlobals.output); }
-bool Warning::isTty() { return Debug::isTty(debugGlobals.warningOutput); }
-bool Error::isTty() { return Debug::isTty(debugGlobals.errorOutput); }
+bool Debug::isTty() { return isTty(debugGlobals.output.stream); }
+bool Warning::isTty() { return Debug::isTty(debugGlobals.warningOutput.stream); }
+bool Error::isTty() { return Debug::isTty(debugGlobals.errorOutput.stream); }
 
-Debug::Debug(std::ostream* const output, const Flags flags): _flags{InternalFlag(static_cast<unsigned char>(flags))}, _immediateFlags{InternalFlag::NoSpace} {
+Debug::Debug(const Implementation::DebugOutput& output, const Flags flags): _output{output.stream}, _writer{output.writer}, _writerState{output.state}, _flags{InternalFlag(static_cast<unsigned char>(flags))}, _immediateFlags{InternalFlag::NoSpace} {
     /* Save previous global output and replace it with current one */
     _previousGlobalOutput = debugGlobals.output;
-    debugGlobals.output = _output = output;
+    debugGlobals.output = output;
 
     /* Save previous global color */
     #if defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_UTILITY_USE_ANSI_COLORS)
@@ -384,29 +388,104 @@ DebugSourceLocation::DebugSourceLocation(Debug&& debug, const char* file, int li
 }
 #endif
 
-Warning::Warning(std::ostream* const output, const Flags flags): Debug{flags} {
+Warning::Warning(const Implementation::DebugOutput& output, const Flags flags): Debug{flags} {
     /* Save previous global output and replace it with current one */
     _previousGlobalWarningOutput = debugGlobals.warningOutput;
-    debugGlobals.warningOutput = _output = output;
+    debugGlobals.warningOutput = output;
+    _output = output.stream;
+    _writer = output.writer;
+    _writerState = output.state;
 }
 
-Error::Error(std::ostream* const output, const Flags flags): Debug{flags} {
+Error::Error(const Implementation::DebugOutput& output, const Flags flags): Debug{flags} {
     /* Save previous global output and replace it with current one */
     _previousGlobalErrorOutput = debugGlobals.errorOutput;
-    debugGlobals.errorOutput = _output = output;
+    debugGlobals.errorOutput = output;
+    _output = output.stream;
+    _writer = output.writer;
+    _writerState = output.state;
 }
 
+Debug::Debug(std::ostream* const output, const Flags flags): Debug{Implementation::DebugOutput{output, nullptr, nullptr}, flags} {}
+Warning::Warning(std::ostream* const output, const Flags flags): Warning{Implementation::DebugOutput{output, nullptr, nullptr}, flags} {}
+Error::Error(std::ostream* const output, const Flags flags): Error{Implementation::DebugOutput{output, nullptr, nullptr}, flags} {}
+
+Debug::Debug(const Writer writer, void* const state, const Flags flags): Debug{Implementation::DebugOutput{nullptr, writer, writer ? state : nullptr}, flags} {}
+Warning::Warning(const Writer writer, void* const state, const Flags flags): Warning{Implementation::DebugOutput{nullptr, writer, writer ? state : nullptr}, flags} {}
+Error::Error(const Writer writer, void* const state, const Flags flags): Error{Implementation::DebugOutput{nullptr, writer, writer ? state : nullptr}, flags} {}
+
 Debug::Debug(const Flags flags): Debug{debugGlobals.output, flags} {}
 Warning::Warning(const Flags flags): Warning{debugGlobals.warningOutput, flags} {}
 Error::Error(const Flags flags): Error{debugGlobals.errorOutput, flags} {}
 
+void Debug::write(const char* const data, const std::size_t size) {
+    /* Streams are written to directly, they do their own buffering */
+    if(_output) {
+        _output->write(data, size);
+        return;
+    }
+
+    /* For writers collect the output into the local buffer. If it doesn't
+       fit, pass what's collected so far to the writer, and if the data alone
+       is larger than the buffer, pass it to the writer directly. */
+    if(_writerBufferSize + size > WriterBufferSize) {
+        flushWriter();
+        if(size > WriterBufferSize) {
+            _writer(_writerState, data, size);
+            return;
+        }
+    }
+    std::memcpy(_writerBuffer + _writerBufferSize, data, size);
+    _writerBufferSize += size;
+}
+
+void Debug::flushWriter() {
+    if(!_writerBufferSize) return;
+    _writer(_writerState, _writerBuffer, _writerBufferSize);
+    _writerBufferSize = 0;
+}
+
+/* Builtin types are formatted using the same code as Utility::format()
+   without going through iostreams. The default precision of floating-point
+   types is the same in both. */
+template<class T> inline void Debug::writeValue(const T& value) {
+    char buffer[64];
+    write(buffer, Implementation::Formatter<T>::format(buffer, value, -1, Implementation::FormatType{}));
+}
+
+template<> inline void Debug::writeValue<const char*>(const char* const& value) {
+    write(value, std::strlen(value));
+}
+
+template<> inline void Debug::writeValue<std::string>(const std::string& value) {
+    write(value.data(), value.size());
+}
+
+template<> inline void Debug::writeValue<Containers::StringView>(const Containers::StringView& value) {
+    write(value.data(), value.size());
+}
+
+template<> inline void Debug::writeValue<Implementation::DebugOstreamFallback>(const Implementation::DebugOstreamFallback& value) {
+    if(_output) {
+        value.apply(*_output);
+        return;
+    }
+
+    /* Writers have no stream to print to, go through a temporary one */
+    std::ostringstream o;
+    value.apply(o);
+    writeValue(o.str());
+}
+
 void Debug::cleanupOnDestruction() {
     #ifdef CORRADE_UTILITY_DEBUG_HAS_SOURCE_LOCATION
     /* Print source location if not printed yet -- this means saying a
        !Debug{}; will print just that, while Debug{}; is a no-op */
-    if(_output && _sourceLocationFile) {
+    if((_output || _writer) && _sourceLocationFile) {
         CORRADE_INTERNAL_ASSERT(_immediateFlags & InternalFlag::NoSpace);
-        *_output << _sourceLocationFile << ":" << _sourceLocationLine;
+        writeValue(_sourceLocationFile);
+        write(":", 1);
+        writeValue(_sourceLocationLine);
         _flags |= InternalFlag::ValueWritten;
     }
     #endif
@@ -414,9 +493,13 @@ void Debug::cleanupOnDestruction() {
     /* Reset output color */
     resetColorInternal();
 
-    /* Newline at the end */
-    if(_output && (_flags & InternalFlag::ValueWritten) && !(_flags & InternalFlag::NoNewlineAtTheEnd))
-        *_output << std::endl;
+    /* Newline at the end. For streams this also flushes, for writers the
+       collected output is passed to the writer in one go. */
+    if((_flags & InternalFlag::ValueWritten) && !(_flags & InternalFlag::NoNewlineAtTheEnd)) {
+        if(_output) *_output << std::endl;
+        else if(_writer) write("\n", 1);
+    }
+    if(_writer) flushWriter();
 
     /* Reset previous global output */
     debugGlobals.output = _previousGlobalOutput;
@@ -448,32 +531,117 @@ Fatal::~Fatal() {
 }
 
 template<class T> Debug& Debug::print(const T& value) {
-    if(!_output) return *this;
+    if(!_output && !_writer) return *this;
 
     #ifdef CORRADE_UTILITY_DEBUG_HAS_SOURCE_LOCATION
     /* Print source location, if not printed yet */
     if(_sourceLocationFile) {
         CORRADE_INTERNAL_ASSERT(_immediateFlags & InternalFlag::NoSpace);
-        *_output << _sourceLocationFile << ":" << _sourceLocationLine << ": ";
+        writeValue(_sourceLocationFile);
+        write(":", 1);
+        writeValue(_sourceLocationLine);
+        write(": ", 2);
         _sourceLocationFile = nullptr;
     }
     #endif
 
     /* Separate values with spaces if enabled; reset all internal flags after */
     if(!((_immediateFlags|_flags) & InternalFlag::NoSpace))
-        *_output << ' ';
+        write(" ", 1);
     _immediateFlags = {};
 
-    toStream(*_output, value);
+    /* Decaying const T to get a const char* for string literals */
+    writeValue<typename std::decay<const T>::type>(value);
 
     _flags |= InternalFlag::ValueWritten;
     return *this;
 }
 
+std::size_t Debug::elementLimit() { return debugGlobals.elementLimit; }
+
+void Debug::setElementLimit(const std::size_t limit) {
+    debugGlobals.elementLimit = limit;
+}
+
+/* The output is the same as with the generic operator<<(Debug&, const
+   Iterable&), but the elements are formatted into a local buffer that's
+   passed to write() only once it's full, without going through print() and
+   the flag handling for each element */
+template<class T> Debug& Debug::printArithmeticArrayInternal(const T* const data, const std::size_t size, const std::ptrdiff_t stride) {
+    if(!_output && !_writer) return *this;
+
+    const bool packed = !!((_immediateFlags|_flags) & InternalFlag::Packed);
+    const std::size_t separatorSize = packed ? 0 : 2;
+    print(packed ? "" : "{");
+
+    /* If there's a limit, print only the head and tail with an ellipsis in
+       between */
+    const std::size_t limit = debugGlobals.elementLimit;
+    const std::size_t head = limit && size > limit ? (limit + 1)/2 : size;
+    const std::size_t tailBegin = limit && size > limit ? size - limit/2 : size;
+
+    /* Flushed whenever there's not enough space for the largest formatted
+       value together with the separator */
+    char buffer[4096];
+    std::size_t bufferSize = 0;
+    for(std::size_t i = 0; i != size; ++i) {
+        if(bufferSize + 128 > sizeof(buffer)) {
+            write(buffer, bufferSize);
+            bufferSize = 0;
+        }
+
+        if(i) {
+            std::memcpy(buffer + bufferSize, ", ", separatorSize);
+            bufferSize += separatorSize;
+        }
+
+        /* Skip to the tail, the next iteration prints the separator after
+           the ellipsis */
+        if(i == head) {
+            std::memcpy(buffer + bufferSize, "…", 3);
+            bufferSize += 3;
+            i = tailBegin - 1;
+            continue;
+        }
+
+        T value;
+        std::memcpy(&value, reinterpret_cast<const char*>(data) + std::ptrdiff_t(i)*stride, sizeof(T));
+        bufferSize += Implementation::Formatter<T>::format({buffer + bufferSize, sizeof(buffer) - bufferSize}, value, -1, Implementation::FormatType{});
+    }
+
+    if(!packed) buffer[bufferSize++] = '}';
+    write(buffer, bufferSize);
+    return *this;
+}
+
+Debug& Debug::printArithmeticArray(const short* const data, const std::size_t size, const std::ptrdiff_t stride) { return printArithmeticArrayInternal(data, size, stride); }
+Debug& Debug::printArithmeticArray(const unsigned short* const data, const std::size_t size, const std::ptrdiff_t stride) { return printArithmeticArrayInternal(data, size, stride); }
+Debug& Debug::printArithmeticArray(const int* const data, const std::size_t size, const std::ptrdiff_t stride) { return printArithmeticArrayInternal(data, size, stride); }
+Debug& Debug::printArithmeticArray(const unsigned* const data, const std::size_t size, const std::ptrdiff_t stride) { return printArithmeticArrayInternal(data, size, stride); }
+Debug& Debug::printArithmeticArray(const long* const data, const std::size_t size, const std::ptrdiff_t stride) { return printArithmeticArrayInternal(data, size, stride); }
+Debug& Debug::printArithmeticArray(const unsigned long* const data, const std::size_t size, const std::ptrdiff_t stride) { return printArithmeticArrayInternal(data, size, stride); }
+Debug& Debug::printArithmeticArray(const long long* const data, const std::size_t size, const std::ptrdiff_t stride) { return printArithmeticArrayInternal(data, size, stride); }
+Debug& Debug::printArithmeticArray(const unsigned long long* const data, const std::size_t size, const std::ptrdiff_t stride) { return printArithmeticArrayInternal(data, size, stride); }
+Debug& Debug::printArithmeticArray(const float* const data, const std::size_t size, const std::ptrdiff_t stride) { return printArithmeticArrayInternal(data, size, stride); }
+Debug& Debug::printArithmeticArray(const double* const data, const std::size_t size, const std::ptrdiff_t stride) { return printArithmeticArrayInternal(data, size, stride); }
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+Debug& Debug::printArithmeticArray(const long double* const data, const std::size_t size, const std::ptrdiff_t stride) { return printArithmeticArrayInternal(data, size, stride); }
+#endif
+
 Debug& Debug::operator<<(const void* const value) {
-    std::ostringstream o;
-    o << "0x" << std::hex << reinterpret_cast<std::uintptr_t>(value);
-    return print(o.str());
+    /* Formatted by hand as there's no way to pass a hexadecimal format type
+       to Formatter from here */
+    char buffer[2 + sizeof(std::uintptr_t)*2 + 1];
+    char* out = buffer + sizeof(buffer);
+    *--out = '\0';
+    std::uintptr_t v = reinterpret_cast<std::uintptr_t>(value);
+    do {
+        *--out = "0123456789abcdef"[v & 0xf];
+        v >>= 4;
+    } while(v);
+    *--out = 'x';
+    *--out = '0';
+    return print(static_cast<const char*>(out));
 }
 
 Debug& Debug::operator<<(const char* value) { return print(value); }
@@ -524,38 +692,27 @@ Debug& Debug::operator<<(long long value) { return print(value); }
 Debug& Debug::operator<<(unsigned value) { return print(value); }
 Debug& Debug::operator<<(unsigned long value) { return print(value); }
 Debug& Debug::operator<<(unsigned long long value) { return print(value); }
-Debug& Debug::operator<<(float value) {
-    if(!_output) return *this;
-    /* The default. Source: http://en.cppreference.com/w/cpp/io/ios_base/precision,
-       Wikipedia says 6-digit number can be converted back and forth without
-       loss: https://en.wikipedia.org/wiki/Single-precision_floating-point_format
-       Kept in sync with format(). */
-    *_output << std::setprecision(6);
-    return print(value);
-}
-Debug& Debug::operator<<(double value) {
-    if(!_output) return *this;
-    /* Wikipedia says 15-digit number can be converted back and forth without
-       loss: https://en.wikipedia.org/wiki/Double-precision_floating-point_format
-       Kept in sync with format(). */
-    *_output << std::setprecision(15);
-    return print(value);
-}
+/* Precision of floating-point values is 6, 15 and 18 digits, which is the
+   default in Formatter as well, see there for details */
+Debug& Debug::operator<<(float value) { return print(value); }
+Debug& Debug::operator<<(double value) { return print(value); }
 #ifndef CORRADE_TARGET_EMSCRIPTEN
-Debug& Debug::operator<<(long double value) {
-    if(!_output) return *this;
-    /* Wikipedia says 18-digit number can be converted both ways without
-       loss: https://en.wikipedia.org/wiki/Extended_precision#Working_range
-       Kept in sync with format(). */
-    *_output << std::setprecision(18);
-    return print(value);
-}
+Debug& Debug::operator<<(long double value) { return print(value); }
 #endif
 
 Debug& Debug::operator<<(char32_t value) {
-    std::ostringstream o;
-    o << "U+" << std::hex << std::uppercase << std::setw(4) << std::setfill('0') << value;
-    return print(o.str());
+    /* At least four uppercase hexadecimal digits */
+    char buffer[2 + 8 + 1];
+    char* out = buffer + sizeof(buffer);
+    *--out = '\0';
+    std::uint32_t v = value;
+    for(int i = 0; v || i < 4; ++i) {
+        *--out = "0123456789ABCDEF"[v & 0xf];
+        v >>= 4;
+    }
+    *--out = '+';
+    *--out = 'U';
+    return print(static_cast<const char*>(out));
 }
 
 Debug& Debug::operator<<(const char32_t* value) {
@@ -627,4 +784,12 @@ Debug& operator<<(Debug& debug, Implementation::DebugOstreamFallback&& value) {
 }
 #endif
 
+}
+
+namespace Containers {
+
+Utility::Debug& operator<<(Utility::Debug& debug, const StringView value) {
+    return debug.print(value);
+}
+
 }}
@@ -32,7 +32,6 @@
 
 #include <iosfwd>
 #include <type_traits>
-#include <utility> /** @todo consider putting this away as well (900 LOC) */
 
 #include "Corrade/Utility/Macros.h"
 #include "Corrade/Containers/EnumSet.h"
@@ -58,6 +57,15 @@ source location support. Available on GCC at least since version 4.8 and Clang
 namespace Implementation { struct DebugSourceLocation; }
 #endif
 
+namespace Implementation {
+    /* Either a stream or a writer, or neither */
+    struct DebugOutput {
+        std::ostream* stream;
+        void(*writer)(void*, const char*, std::size_t);
+        void* state;
+    };
+}
+
 /**
 @brief Debug output handler
 
@@ -73,9 +81,11 @@ Support for printing more types can be added by implementing an overload of
 @section Utility-Debug-stl Printing STL types
 
 To optimize compile times, the @ref Corrade/Utility/Debug.h header provides
-only support for printing builtin types, generic iterable containers and
-@ref std::pair. Printing of @ref std::string and @ref std::tuple is possible if
-you @cpp #include @ce a separate @ref Corrade/Utility/DebugStl.h header. This
+only support for printing builtin types and generic iterable containers,
+without depending on any STL headers except for @cpp <iosfwd> @ce and
+@cpp <type_traits> @ce. Printing of @ref std::string, @ref std::pair and
+@ref std::tuple is possible if you @cpp #include @ce a separate
+@ref Corrade/Utility/DebugStl.h header. This
 header also provides a fallback to @ref std::ostream @cpp operator<<() @ce
 overloads, if there's no @cpp operator<<() @ce implemented for printing given
 type using @ref Debug. Note that printing @ref std::vector or @ref std::map
@@ -90,6 +100,28 @@ can be controlled separately:
 
 @snippet Utility.cpp Debug-scoped-output
 
+@section Utility-Debug-writer Output without iostreams
+
+Besides a @ref std::ostream, the output can be directed to a @ref Writer
+function using the @ref Debug(Writer, void*, Flags) constructor and the
+corresponding constructors of @ref Warning, @ref Error and @ref Fatal. The
+message is then collected into a small buffer inside the @ref Debug instance
+and passed to the writer once the buffer is full and when the instance is
+destroyed, independently of iostreams. The @ref fileWriter() passes the data
+to a @ref std::FILE, for other targets such as file descriptors a custom
+writer can be implemented:
+
+@snippet Utility.cpp Debug-writer
+
+Builtin types are formatted using the same code as @ref format() regardless of
+the output kind. Only types that can be printed solely through the
+@ref std::ostream fallback in @ref Corrade/Utility/DebugStl.h go through a
+temporary @ref std::ostringstream when a writer is used. Colors are emitted as
+ANSI escape codes, except for Windows with
+@ref CORRADE_UTILITY_USE_ANSI_COLORS not enabled, where they're ignored. Color
+autodetection doesn't apply to writers, as there's no way to check whether the
+target is a TTY.
+
 @section Utility-Debug-modifiers Output modifiers
 
 It's possible to modify the output behavior by calling @ref setFlags() or
@@ -253,6 +285,30 @@ class CORRADE_UTILITY_EXPORT Debug {
          */
         typedef void(*Modifier)(Debug&);
 
+        /**
+         * @brief Output writer
+         * @m_since_latest
+         *
+         * Called with the @p state passed to @ref Debug(Writer, void*, Flags)
+         * and a piece of the formatted output, which isn't
+         * null-terminated. A single message may be passed in multiple pieces,
+         * the last piece of a message ends with a newline unless
+         * @ref Flag::NoNewlineAtTheEnd is set.
+         * @see @ref Utility-Debug-writer, @ref fileWriter()
+         */
+        typedef void(*Writer)(void* state, const char* data, std::size_t size);
+
+        /**
+         * @brief Writer for a @ref std::FILE
+         * @m_since_latest
+         *
+         * Expects @p file to be a @ref std::FILE, writes @p data to it using
+         * @ref std::fwrite() and flushes it after every newline at the end of
+         * @p data.
+         * @see @ref Utility-Debug-writer
+         */
+        static void fileWriter(void* file, const char* data, std::size_t size);
+
         /**
          * @brief Output color
          *
@@ -429,6 +485,31 @@ class CORRADE_UTILITY_EXPORT Debug {
          */
         static std::ostream* output();
 
+        /**
+         * @brief Element limit for printing arithmetic arrays
+         * @m_since_latest
+         *
+         * If non-zero, views and arrays of arithmetic types printed with
+         * @ref operator<<(Debug&, const Iterable&) print only the first and
+         * last few elements with a @cb{.shell-session} … @ce in between
+         * if there's more than @p limit elements. Default is @cpp 0 @ce,
+         * i.e. no limit. The setting is thread-local if Corrade is compiled
+         * with @ref CORRADE_BUILD_MULTITHREADED.
+         * @see @ref setElementLimit()
+         */
+        static std::size_t elementLimit();
+
+        /**
+         * @brief Set element limit for printing arithmetic arrays
+         * @m_since_latest
+         *
+         * See @ref elementLimit() for more information. Useful to keep
+         * accidental dumps of huge arrays cheap:
+         *
+         * @snippet Utility.cpp Debug-elementLimit
+         */
+        static void setElementLimit(std::size_t limit);
+
         /**
          * @brief Whether given output stream is a TTY
          *
@@ -481,6 +562,20 @@ class CORRADE_UTILITY_EXPORT Debug {
          */
         explicit Debug(std::ostream* output, Flags flags = {});
 
+        /**
+         * @brief Construct with a writer
+         * @param writer        Writer function. If set to @cpp nullptr @ce,
+         *      no debug output will be written anywhere.
+         * @param state         State passed to @p writer
+         * @param flags         Output flags
+         * @m_since_latest
+         *
+         * All new instances created using the default @ref Debug() constructor
+         * during lifetime of this instance will inherit the writer. See
+         * @ref Utility-Debug-writer for more information.
+         */
+        explicit Debug(Writer writer, void* state, Flags flags = {});
+
         /** @brief Copying is not allowed */
         Debug(const Debug&) = delete;
 
@@ -643,12 +738,32 @@ class CORRADE_UTILITY_EXPORT Debug {
            defined in DebugStl.h. */
         template<class T> CORRADE_UTILITY_LOCAL Debug& print(const T& value);
 
+        /* Used by operator<<(Debug&, const Iterable&) for views and arrays of
+           arithmetic types, the stride is in bytes */
+        Debug& printArithmeticArray(const short* data, std::size_t size, std::ptrdiff_t stride);
+        Debug& printArithmeticArray(const unsigned short* data, std::size_t size, std::ptrdiff_t stride);
+        Debug& printArithmeticArray(const int* data, std::size_t size, std::ptrdiff_t stride);
+        Debug& printArithmeticArray(const unsigned* data, std::size_t size, std::ptrdiff_t stride);
+        Debug& printArithmeticArray(const long* data, std::size_t size, std::ptrdiff_t stride);
+        Debug& printArithmeticArray(const unsigned long* data, std::size_t size, std::ptrdiff_t stride);
+        Debug& printArithmeticArray(const long long* data, std::size_t size, std::ptrdiff_t stride);
+        Debug& printArithmeticArray(const unsigned long long* data, std::size_t size, std::ptrdiff_t stride);
+        Debug& printArithmeticArray(const float* data, std::size_t size, std::ptrdiff_t stride);
+        Debug& printArithmeticArray(const double* data, std::size_t size, std::ptrdiff_t stride);
+        #ifndef CORRADE_TARGET_EMSCRIPTEN
+        Debug& printArithmeticArray(const long double* data, std::size_t size, std::ptrdiff_t stride);
+        #endif
+
     #ifndef DOXYGEN_GENERATING_OUTPUT
     protected:
     #else
     private:
     #endif
+        CORRADE_UTILITY_LOCAL explicit Debug(const Implementation::DebugOutput& output, Flags flags);
+
         std::ostream* _output;
+        Writer _writer;
+        void* _writerState;
 
         enum class InternalFlag: unsigned char {
             /* Values compatible with Flag enum */
@@ -677,8 +792,17 @@ class CORRADE_UTILITY_EXPORT Debug {
         template<Color c, bool bold> CORRADE_UTILITY_LOCAL static Modifier colorInternal();
 
         CORRADE_UTILITY_LOCAL void resetColorInternal();
+        CORRADE_UTILITY_LOCAL void write(const char* data, std::size_t size);
+        template<class T> CORRADE_UTILITY_LOCAL void writeValue(const T& value);
+        template<class T> CORRADE_UTILITY_LOCAL Debug& printArithmeticArrayInternal(const T* data, std::size_t size, std::ptrdiff_t stride);
+        CORRADE_UTILITY_LOCAL void flushWriter();
 
-        std::ostream* _previousGlobalOutput;
+        Implementation::DebugOutput _previousGlobalOutput;
+
+        /* Output collected for the writer */
+        enum: std::size_t { WriterBufferSize = 128 };
+        std::size_t _writerBufferSize{};
+        char _writerBuffer[WriterBufferSize];
         #if defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_UTILITY_USE_ANSI_COLORS)
         unsigned short _previousColorAttributes = 0xffff;
         #else
@@ -756,6 +880,42 @@ it. You can also use @ref Debug::nospace and @ref Debug::newline.
 template<class T> Debug& operator<<(Debug& debug, const T& value);
 #endif
 
+namespace Implementation {
+    /* Arithmetic types printed by Debug::printArithmeticArray(). Character
+       types and bool have special handling in Debug, so they go through the
+       generic path. */
+    template<class T> struct DebugArithmetic: std::false_type {};
+    template<> struct DebugArithmetic<short>: std::true_type {};
+    template<> struct DebugArithmetic<unsigned short>: std::true_type {};
+    template<> struct DebugArithmetic<int>: std::true_type {};
+    template<> struct DebugArithmetic<unsigned>: std::true_type {};
+    template<> struct DebugArithmetic<long>: std::true_type {};
+    template<> struct DebugArithmetic<unsigned long>: std::true_type {};
+    template<> struct DebugArithmetic<long long>: std::true_type {};
+    template<> struct DebugArithmetic<unsigned long long>: std::true_type {};
+    template<> struct DebugArithmetic<float>: std::true_type {};
+    template<> struct DebugArithmetic<double>: std::true_type {};
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    template<> struct DebugArithmetic<long double>: std::true_type {};
+    #endif
+
+    /* Contiguous and one-dimensional strided containers of arithmetic types
+       that are printed in bulk instead of element by element */
+    template<class> struct DebugArithmeticArray: std::false_type {};
+    template<class T> struct DebugArithmeticContiguousArray: DebugArithmetic<typename std::remove_const<T>::type> {
+        typedef typename std::remove_const<T>::type Type;
+        template<class U> static std::ptrdiff_t stride(const U&) { return sizeof(T); }
+    };
+    template<class T> struct DebugArithmeticArray<Containers::ArrayView<T>>: DebugArithmeticContiguousArray<T> {};
+    template<std::size_t size, class T> struct DebugArithmeticArray<Containers::StaticArrayView<size, T>>: DebugArithmeticContiguousArray<T> {};
+    template<class T, class D> struct DebugArithmeticArray<Containers::Array<T, D>>: DebugArithmeticContiguousArray<T> {};
+    template<std::size_t size, class T> struct DebugArithmeticArray<Containers::StaticArray<size, T>>: DebugArithmeticContiguousArray<T> {};
+    template<class T> struct DebugArithmeticArray<Containers::StridedArrayView<1, T>>: DebugArithmetic<typename std::remove_const<T>::type> {
+        typedef typename std::remove_const<T>::type Type;
+        static std::ptrdiff_t stride(const Containers::StridedArrayView<1, T>& value) { return value.stride(); }
+    };
+}
+
 /** @relatesalso Debug
 @brief Operator for printing iterable types to debug output
 
@@ -763,13 +923,21 @@ Prints the value as @cb{.shell-session} {a, b, c} @ce. If the type contains
 a nested iterable type, the values are separated by newlines. Specifying
 @ref Debug::Flag::Packed or using @ref Debug::packed will print the values
 tightly-packed without commas and spaces in between.
+
+@ref Containers::ArrayView, @ref Containers::StaticArrayView,
+@ref Containers::Array, @ref Containers::StaticArray and one-dimensional
+@ref Containers::StridedArrayView of builtin integer and floating-point types
+(except for character types and @cpp bool @ce) are formatted directly into an
+output buffer in bulk instead of going through @ref Debug::operator<<() for
+each element, with the same result. For these, @ref Debug::setElementLimit()
+can be used to print only the first and last few elements.
 */
 #ifdef DOXYGEN_GENERATING_OUTPUT
 template<class Iterable> Debug& operator<<(Debug& debug, const Iterable& value)
 #else
 /* libc++ from Apple's Clang "4.2" (3.2-svn) doesn't have constexpr operator
    bool for std::integral_constant, thus we need to use ::value instead */
-template<class Iterable> Debug& operator<<(typename std::enable_if<IsIterable<Iterable>::value && !IsStringLike<Iterable>::value, Debug&>::type debug, const Iterable& value)
+template<class Iterable> Debug& operator<<(typename std::enable_if<IsIterable<Iterable>::value && !IsStringLike<Iterable>::value && !Implementation::DebugArithmeticArray<Iterable>::value, Debug&>::type debug, const Iterable& value)
 #endif
 {
     /* Nested containers should get printed with the same flags, so make all
@@ -802,6 +970,13 @@ template<class Iterable> Debug& operator<<(typename std::enable_if<IsIterable<It
     return debug;
 }
 
+#ifndef DOXYGEN_GENERATING_OUTPUT
+template<class Iterable> Debug& operator<<(typename std::enable_if<Implementation::DebugArithmeticArray<Iterable>::value, Debug&>::type debug, const Iterable& value) {
+    typedef Implementation::DebugArithmeticArray<Iterable> Traits;
+    return debug.printArithmeticArray(static_cast<const typename Traits::Type*>(static_cast<const void*>(value.data())), value.size(), Traits::stride(value));
+}
+#endif
+
 namespace Implementation {
     /** @todo C++14: use std::make_index_sequence and std::integer_sequence */
     template<std::size_t ...> struct Sequence {};
@@ -817,28 +992,6 @@ namespace Implementation {
     #endif
 }
 
-/** @relatesalso Debug
-@brief Print a @ref std::pair to debug output
-
-Prints the value as @cb{.shell-session} (first, second) @ce. Unlike
-@ref operator<<(Debug& debug, const Iterable& value), the output is not
-affected by @ref Debug::Flag::Packed / @ref Debug::packed.
-*/
-template<class T, class U> Debug& operator<<(Debug& debug, const std::pair<T, U>& value) {
-    /* Nested values should get printed with the same flags, so make all
-       immediate flags temporarily global -- except NoSpace, unless it's also
-       set globally */
-    const Debug::Flags prevFlags = debug.flags();
-    debug.setFlags(prevFlags | (debug.immediateFlags() & ~Debug::Flag::NoSpace));
-
-    debug << "(" << Debug::nospace << value.first << Debug::nospace << "," << value.second << Debug::nospace << ")";
-
-    /* Reset the original flags back */
-    debug.setFlags(prevFlags);
-
-    return debug;
-}
-
 /**
 @brief Warning output handler
 
@@ -897,6 +1050,20 @@ class CORRADE_UTILITY_EXPORT Warning: public Debug {
          */
         explicit Warning(std::ostream* output, Flags flags = {});
 
+        /**
+         * @brief Construct with a writer
+         * @param writer        Writer function. If set to @cpp nullptr @ce,
+         *      no warning output will be written anywhere.
+         * @param state         State passed to @p writer
+         * @param flags         Output flags
+         * @m_since_latest
+         *
+         * All new instances created using the default @ref Warning()
+         * constructor during lifetime of this instance will inherit the
+         * writer. See @ref Utility-Debug-writer for more information.
+         */
+        explicit Warning(Writer writer, void* state, Flags flags = {});
+
         /** @brief Copying is not allowed */
         Warning(const Warning&) = delete;
 
@@ -920,7 +1087,9 @@ class CORRADE_UTILITY_EXPORT Warning: public Debug {
         Warning& operator=(Warning&&) = delete;
 
     private:
-        std::ostream* _previousGlobalWarningOutput;
+        CORRADE_UTILITY_LOCAL explicit Warning(const Implementation::DebugOutput& output, Flags flags);
+
+        Implementation::DebugOutput _previousGlobalWarningOutput;
 };
 
 /**
@@ -982,6 +1151,20 @@ class CORRADE_UTILITY_EXPORT Error: public Debug {
          */
         explicit Error(std::ostream* output, Flags flags = {});
 
+        /**
+         * @brief Construct with a writer
+         * @param writer        Writer function. If set to @cpp nullptr @ce,
+         *      no error output will be written anywhere.
+         * @param state         State passed to @p writer
+         * @param flags         Output flags
+         * @m_since_latest
+         *
+         * All new instances created using the default @ref Error()
+         * constructor during lifetime of this instance will inherit the
+         * writer. See @ref Utility-Debug-writer for more information.
+         */
+        explicit Error(Writer writer, void* state, Flags flags = {});
+
         /** @brief Copying is not allowed */
         Error(const Error&) = delete;
 
@@ -1012,7 +1195,9 @@ class CORRADE_UTILITY_EXPORT Error: public Debug {
         CORRADE_UTILITY_LOCAL void cleanupOnDestruction(); /* Needed for Fatal */
 
     private:
-        std::ostream* _previousGlobalErrorOutput;
+        CORRADE_UTILITY_LOCAL explicit Error(const Implementation::DebugOutput& output, Flags flags);
+
+        Implementation::DebugOutput _previousGlobalErrorOutput;
 };
 
 /**
@@ -1054,6 +1239,23 @@ class CORRADE_UTILITY_EXPORT Fatal: public Error {
         /** @overload */
         Fatal(std::ostream* output, Flags flags = {}): Fatal{output, 1, flags} {}
 
+        /**
+         * @brief Construct with a writer
+         * @param writer        Writer function. If set to @cpp nullptr @ce,
+         *      no error output will be written anywhere.
+         * @param state         State passed to @p writer
+         * @param exitCode      Application exit code to be used on
+         *      destruction
+         * @param flags         Output flags
+         * @m_since_latest
+         *
+         * See @ref Utility-Debug-writer for more information.
+         */
+        Fatal(Writer writer, void* state, int exitCode = 1, Flags flags = {}): Error{writer, state, flags}, _exitCode{exitCode} {}
+
+        /** @overload */
+        Fatal(Writer writer, void* state, Flags flags = {}): Fatal{writer, state, 1, flags} {}
+
         /**
          * @brief Destructor
          *
@@ -0,0 +1,405 @@
+#ifndef Corrade_Utility_DebugLevel_h
+#define Corrade_Utility_DebugLevel_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Utility::DebugModule, enum @ref Corrade::Utility::DebugLevel, macro @ref CORRADE_DEBUG_LEVEL, @ref CORRADE_ERROR(), @ref CORRADE_WARNING(), @ref CORRADE_DEBUG(), @ref CORRADE_VERBOSE(), @ref CORRADE_ERROR_ONCE(), @ref CORRADE_WARNING_ONCE(), @ref CORRADE_DEBUG_ONCE(), @ref CORRADE_VERBOSE_ONCE(), @ref CORRADE_ERROR_EVERY_N(), @ref CORRADE_WARNING_EVERY_N(), @ref CORRADE_DEBUG_EVERY_N(), @ref CORRADE_VERBOSE_EVERY_N()
+ * @m_since_latest
+ */
+
+#include <atomic>
+#include <cstddef>
+
+#include "Corrade/Utility/Debug.h"
+
+#ifdef DOXYGEN_GENERATING_OUTPUT
+/**
+@brief Compile-time debug level
+@m_since_latest
+
+This macro is not defined by Corrade, but rather meant to be defined by the
+user to one of the numeric values of @ref Corrade::Utility::DebugLevel
+"Utility::DebugLevel" before including this header, for example on the
+compiler command line. All @ref CORRADE_ERROR(), @ref CORRADE_WARNING(),
+@ref CORRADE_DEBUG() and @ref CORRADE_VERBOSE() statements with a level above
+this value compile to a constant-false condition and are removed by the
+compiler entirely, without the module level being checked or any arguments
+evaluated. If not defined, it's set to @cpp 4 @ce, i.e.
+@ref Corrade::Utility::DebugLevel::Verbose "DebugLevel::Verbose", so nothing is
+filtered at compile time. Defining it to @cpp 0 @ce removes all statements.
+See @ref Corrade::Utility::DebugModule "Utility::DebugModule" for more
+information.
+*/
+#define CORRADE_DEBUG_LEVEL
+#undef CORRADE_DEBUG_LEVEL
+#endif
+
+#ifndef CORRADE_DEBUG_LEVEL
+#define CORRADE_DEBUG_LEVEL 4
+#endif
+
+namespace Corrade { namespace Utility {
+
+/**
+@brief Debug level
+@m_since_latest
+
+@see @ref DebugModule, @ref CORRADE_DEBUG_LEVEL
+*/
+enum class DebugLevel: std::uint8_t {
+    /** Nothing is printed */
+    None = 0,
+
+    /** Only @ref CORRADE_ERROR() is printed */
+    Error = 1,
+
+    /** @ref CORRADE_ERROR() and @ref CORRADE_WARNING() is printed */
+    Warning = 2,
+
+    /**
+     * @ref CORRADE_ERROR(), @ref CORRADE_WARNING() and @ref CORRADE_DEBUG()
+     * is printed
+     */
+    Debug = 3,
+
+    /** Everything, including @ref CORRADE_VERBOSE() is printed */
+    Verbose = 4
+};
+
+/** @debugoperatorenum{DebugLevel} */
+CORRADE_UTILITY_EXPORT Debug& operator<<(Debug& debug, DebugLevel value);
+
+/**
+@brief Debug module
+@m_since_latest
+
+Holds a runtime verbosity level for a group of
+@ref CORRADE_ERROR(), @ref CORRADE_WARNING(), @ref CORRADE_DEBUG() and
+@ref CORRADE_VERBOSE() statements. Unlike plain @ref Debug, @ref Warning and
+@ref Error, which evaluate all their arguments even if the output is
+redirected to @cpp nullptr @ce, the macros check the level first and if the
+statement is filtered out, neither the @ref Debug instance is constructed nor
+the arguments are evaluated:
+
+@snippet Utility.cpp DebugModule
+
+The check is a single comparison of the module level against the statement
+level. Additionally, statements with a level above @ref CORRADE_DEBUG_LEVEL
+are filtered out at compile time, resulting in no code at all, while still
+being checked for errors by the compiler.
+
+To avoid flooding the output with a message that repeats in a loop, use
+@ref CORRADE_WARNING_ONCE() or @ref CORRADE_WARNING_EVERY_N() and their
+variants for other levels.
+
+The module is meant to be a global or a static variable. Its level can be
+changed at any time with @ref setLevel(), however the level isn't synchronized
+across threads --- if there's logging from multiple threads, change it only
+when no other thread is printing through the module.
+*/
+class DebugModule {
+    public:
+        /**
+         * @brief Constructor
+         * @param name      Module name
+         * @param level     Initial level
+         *
+         * The @p name is expected to be a global string used for
+         * identification purposes.
+         */
+        constexpr explicit DebugModule(const char* name, DebugLevel level = DebugLevel::Debug) noexcept: _name{name}, _level{level} {}
+
+        /** @brief Module name */
+        constexpr const char* name() const { return _name; }
+
+        /** @brief Level */
+        constexpr DebugLevel level() const { return _level; }
+
+        /**
+         * @brief Set level
+         *
+         * Statements with a level above @p level will not be printed.
+         */
+        DebugModule& setLevel(DebugLevel level) {
+            _level = level;
+            return *this;
+        }
+
+        /**
+         * @brief Whether given level is printed
+         *
+         * Returns @cpp true @ce if @p level is less than or equal to the
+         * module level, @cpp false @ce otherwise. Doesn't take
+         * @ref CORRADE_DEBUG_LEVEL into account.
+         */
+        constexpr bool isEnabled(DebugLevel level) const {
+            return std::uint8_t(level) <= std::uint8_t(_level);
+        }
+
+    private:
+        const char* _name;
+        DebugLevel _level;
+};
+
+namespace Implementation {
+    /* Has lower precedence than << but higher than ?:, which makes the whole
+       output chain a single operand of the conditional operator. Unlike an
+       if/else, that's safe to use in an unbraced if. */
+    struct DebugVoidify {
+        void operator&(const Debug&) const {}
+    };
+
+    /* Returns 0 if the message should be suppressed, otherwise one more than
+       the count of messages suppressed since the last printed one. With
+       `n` being zero, only the first message is printed. The counter is a
+       static local in each call site. */
+    inline std::size_t debugRateLimit(std::atomic<std::size_t>& counter, const std::size_t n) {
+        /* Avoid a read-modify-write for a message that was printed already */
+        if(!n && counter.load(std::memory_order_relaxed))
+            return 0;
+        const std::size_t count = counter.fetch_add(1, std::memory_order_relaxed);
+        if(n ? count % n : count) return 0;
+        return count ? n : 1;
+    }
+
+    /* Adds a note about suppressed messages at the end, before the output
+       gets flushed in the base destructor */
+    template<class T> class DebugRateLimitedOutput: public T {
+        public:
+            explicit DebugRateLimitedOutput(std::size_t suppressed): _suppressed{suppressed} {}
+
+            ~DebugRateLimitedOutput() {
+                if(_suppressed) *this << "(" << Debug::nospace << _suppressed << "previous occurrences suppressed)";
+            }
+
+        private:
+            std::size_t _suppressed;
+    };
+}
+
+}}
+
+/* The level is checked against CORRADE_DEBUG_LEVEL first, which is a
+   constant, so the rest of the expression is dropped if it evaluates to
+   false */
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#define _CORRADE_DEBUG_MODULE_OUTPUT(module, level, Output)                 \
+    !(CORRADE_DEBUG_LEVEL >= level && (module).isEnabled(Corrade::Utility::DebugLevel(level))) ? \
+        static_cast<void>(0) :                                              \
+        Corrade::Utility::Implementation::DebugVoidify{} & Corrade::Utility::Output{}
+#endif
+
+/** @hideinitializer
+@brief Error output for a module
+@param module   A @ref Corrade::Utility::DebugModule "Utility::DebugModule"
+    instance
+@m_since_latest
+
+Prints to @ref Corrade::Utility::Error "Utility::Error" if the @p module level
+is at least @ref Corrade::Utility::DebugLevel::Error "DebugLevel::Error" and
+@ref CORRADE_DEBUG_LEVEL is at least @cpp 1 @ce. Otherwise the output
+arguments are not evaluated. Meant to be used in a statement context only,
+followed by the output expression:
+
+@snippet Utility.cpp DebugModule
+*/
+#define CORRADE_ERROR(module) _CORRADE_DEBUG_MODULE_OUTPUT(module, 1, Error)
+
+/** @hideinitializer
+@brief Warning output for a module
+@param module   A @ref Corrade::Utility::DebugModule "Utility::DebugModule"
+    instance
+@m_since_latest
+
+Prints to @ref Corrade::Utility::Warning "Utility::Warning" if the @p module
+level is at least @ref Corrade::Utility::DebugLevel::Warning "DebugLevel::Warning"
+and @ref CORRADE_DEBUG_LEVEL is at least @cpp 2 @ce. Otherwise the output
+arguments are not evaluated. See @ref CORRADE_ERROR() for an example.
+*/
+#define CORRADE_WARNING(module) _CORRADE_DEBUG_MODULE_OUTPUT(module, 2, Warning)
+
+/** @hideinitializer
+@brief Debug output for a module
+@param module   A @ref Corrade::Utility::DebugModule "Utility::DebugModule"
+    instance
+@m_since_latest
+
+Prints to @ref Corrade::Utility::Debug "Utility::Debug" if the @p module level
+is at least @ref Corrade::Utility::DebugLevel::Debug "DebugLevel::Debug" and
+@ref CORRADE_DEBUG_LEVEL is at least @cpp 3 @ce. Otherwise the output
+arguments are not evaluated. See @ref CORRADE_ERROR() for an example.
+*/
+#define CORRADE_DEBUG(module) _CORRADE_DEBUG_MODULE_OUTPUT(module, 3, Debug)
+
+/** @hideinitializer
+@brief Verbose output for a module
+@param module   A @ref Corrade::Utility::DebugModule "Utility::DebugModule"
+    instance
+@m_since_latest
+
+Prints to @ref Corrade::Utility::Debug "Utility::Debug" if the @p module level
+is at least @ref Corrade::Utility::DebugLevel::Verbose "DebugLevel::Verbose"
+and @ref CORRADE_DEBUG_LEVEL is at least @cpp 4 @ce. Otherwise the output
+arguments are not evaluated. See @ref CORRADE_ERROR() for an example.
+*/
+#define CORRADE_VERBOSE(module) _CORRADE_DEBUG_MODULE_OUTPUT(module, 4, Debug)
+
+/* Unlike the above, the rate-limited variants need to pass the count of
+   suppressed messages from the check to the output, so they're a for loop
+   with at most one iteration. That's as safe in an unbraced if as the
+   conditional operator. */
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#define _CORRADE_DEBUG_MODULE_RATE_LIMITED_OUTPUT(module, n, level, Output) \
+    for(std::size_t _corradeDebugRateLimit =                                \
+            CORRADE_DEBUG_LEVEL >= level && (module).isEnabled(Corrade::Utility::DebugLevel(level)) ? \
+            Corrade::Utility::Implementation::debugRateLimit([]() -> std::atomic<std::size_t>& { \
+                static std::atomic<std::size_t> counter{0};                 \
+                return counter;                                             \
+            }(), n) : 0;                                                    \
+        _corradeDebugRateLimit; _corradeDebugRateLimit = 0)                 \
+        Corrade::Utility::Implementation::DebugRateLimitedOutput<Corrade::Utility::Output>{_corradeDebugRateLimit - 1}
+#endif
+
+/** @hideinitializer
+@brief Error output for a module printed only once
+@param module   A @ref Corrade::Utility::DebugModule "Utility::DebugModule"
+    instance
+@m_since_latest
+
+Like @ref CORRADE_ERROR(), but only the first occurrence at given call site is
+printed, all later ones are suppressed without the output arguments being
+evaluated. Occurrences filtered out by the module level don't count. The
+check is a single relaxed atomic load once the message was printed, so it's
+safe to use from multiple threads and in hot paths:
+
+@snippet Utility.cpp CORRADE_WARNING_ONCE
+
+@see @ref CORRADE_ERROR_EVERY_N()
+*/
+#define CORRADE_ERROR_ONCE(module) _CORRADE_DEBUG_MODULE_RATE_LIMITED_OUTPUT(module, 0, 1, Error)
+
+/** @hideinitializer
+@brief Warning output for a module printed only once
+@param module   A @ref Corrade::Utility::DebugModule "Utility::DebugModule"
+    instance
+@m_since_latest
+
+Like @ref CORRADE_WARNING(), but only the first occurrence at given call site
+is printed. See @ref CORRADE_ERROR_ONCE() for more information.
+@see @ref CORRADE_WARNING_EVERY_N()
+*/
+#define CORRADE_WARNING_ONCE(module) _CORRADE_DEBUG_MODULE_RATE_LIMITED_OUTPUT(module, 0, 2, Warning)
+
+/** @hideinitializer
+@brief Debug output for a module printed only once
+@param module   A @ref Corrade::Utility::DebugModule "Utility::DebugModule"
+    instance
+@m_since_latest
+
+Like @ref CORRADE_DEBUG(), but only the first occurrence at given call site is
+printed. See @ref CORRADE_ERROR_ONCE() for more information.
+@see @ref CORRADE_DEBUG_EVERY_N()
+*/
+#define CORRADE_DEBUG_ONCE(module) _CORRADE_DEBUG_MODULE_RATE_LIMITED_OUTPUT(module, 0, 3, Debug)
+
+/** @hideinitializer
+@brief Verbose output for a module printed only once
+@param module   A @ref Corrade::Utility::DebugModule "Utility::DebugModule"
+    instance
+@m_since_latest
+
+Like @ref CORRADE_VERBOSE(), but only the first occurrence at given call site
+is printed. See @ref CORRADE_ERROR_ONCE() for more information.
+@see @ref CORRADE_VERBOSE_EVERY_N()
+*/
+#define CORRADE_VERBOSE_ONCE(module) _CORRADE_DEBUG_MODULE_RATE_LIMITED_OUTPUT(module, 0, 4, Debug)
+
+/** @hideinitializer
+@brief Error output for a module printed every N occurrences
+@param module   A @ref Corrade::Utility::DebugModule "Utility::DebugModule"
+    instance
+@param n        Print every n-th occurrence
+@m_since_latest
+
+Like @ref CORRADE_ERROR(), but only the first and then every @p n-th
+occurrence at given call site is printed, the others are suppressed without
+the output arguments being evaluated. Each printed message except for the
+first is suffixed with the count of previously suppressed occurrences.
+Occurrences filtered out by the module level don't count. The check is a
+single relaxed atomic increment of a per-call-site counter, so it's safe to
+use from multiple threads and in hot paths:
+
+@snippet Utility.cpp CORRADE_WARNING_ONCE
+
+The @p n is expected to be non-zero and is evaluated only if the module level
+allows the output. Passing @cpp 1 @ce prints all occurrences.
+@see @ref CORRADE_ERROR_ONCE()
+*/
+#define CORRADE_ERROR_EVERY_N(module, n) _CORRADE_DEBUG_MODULE_RATE_LIMITED_OUTPUT(module, (n), 1, Error)
+
+/** @hideinitializer
+@brief Warning output for a module printed every N occurrences
+@param module   A @ref Corrade::Utility::DebugModule "Utility::DebugModule"
+    instance
+@param n        Print every n-th occurrence
+@m_since_latest
+
+Like @ref CORRADE_WARNING(), but only the first and then every @p n-th
+occurrence at given call site is printed. See @ref CORRADE_ERROR_EVERY_N() for
+more information.
+@see @ref CORRADE_WARNING_ONCE()
+*/
+#define CORRADE_WARNING_EVERY_N(module, n) _CORRADE_DEBUG_MODULE_RATE_LIMITED_OUTPUT(module, (n), 2, Warning)
+
+/** @hideinitializer
+@brief Debug output for a module printed every N occurrences
+@param module   A @ref Corrade::Utility::DebugModule "Utility::DebugModule"
+    instance
+@param n        Print every n-th occurrence
+@m_since_latest
+
+Like @ref CORRADE_DEBUG(), but only the first and then every @p n-th
+occurrence at given call site is printed. See @ref CORRADE_ERROR_EVERY_N() for
+more information.
+@see @ref CORRADE_DEBUG_ONCE()
+*/
+#define CORRADE_DEBUG_EVERY_N(module, n) _CORRADE_DEBUG_MODULE_RATE_LIMITED_OUTPUT(module, (n), 3, Debug)
+
+/** @hideinitializer
+@brief Verbose output for a module printed every N occurrences
+@param module   A @ref Corrade::Utility::DebugModule "Utility::DebugModule"
+    instance
+@param n        Print every n-th occurrence
+@m_since_latest
+
+Like @ref CORRADE_VERBOSE(), but only the first and then every @p n-th
+occurrence at given call site is printed. See @ref CORRADE_ERROR_EVERY_N()
+for more information.
+@see @ref CORRADE_VERBOSE_ONCE()
+*/
+#define CORRADE_VERBOSE_EVERY_N(module, n) _CORRADE_DEBUG_MODULE_RATE_LIMITED_OUTPUT(module, (n), 4, Debug)
+
+#endif
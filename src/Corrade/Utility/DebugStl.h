@@ -29,16 +29,17 @@
 @brief STL compatibility for @ref Corrade::Utility::Debug
 @m_since{2019,10}
 
-Including this header allows you to use STL types such as @ref std::string or
-@ref std::tuple with @ref Corrade::Utility::Debug. See @ref Utility-Debug-stl
+Including this header allows you to use STL types such as @ref std::string,
+@ref std::pair or @ref std::tuple with @ref Corrade::Utility::Debug. See @ref Utility-Debug-stl
 for more information.
 */
 
 #include <iosfwd>
 #include <string>
-/* this one doesn't add much on top of <string>, so it doesn't need to be
+/* these don't add much on top of <string>, so they don't need to be
    separate */
 #include <tuple>
+#include <utility>
 
 #include "Corrade/Containers/ArrayView.h"
 #include "Corrade/Utility/Debug.h"
@@ -59,6 +60,28 @@ template<class T> Debug& operator<<(Debug& debug, const std::basic_string<T>& va
     return debug << Containers::ArrayView<const T>{value.data(), value.size()};
 }
 
+/** @relatesalso Debug
+@brief Print a @ref std::pair to debug output
+
+Prints the value as @cb{.shell-session} (first, second) @ce. Unlike
+@ref operator<<(Debug& debug, const Iterable& value), the output is not
+affected by @ref Debug::Flag::Packed / @ref Debug::packed.
+*/
+template<class T, class U> Debug& operator<<(Debug& debug, const std::pair<T, U>& value) {
+    /* Nested values should get printed with the same flags, so make all
+       immediate flags temporarily global -- except NoSpace, unless it's also
+       set globally */
+    const Debug::Flags prevFlags = debug.flags();
+    debug.setFlags(prevFlags | (debug.immediateFlags() & ~Debug::Flag::NoSpace));
+
+    debug << "(" << Debug::nospace << value.first << Debug::nospace << "," << value.second << Debug::nospace << ")";
+
+    /* Reset the original flags back */
+    debug.setFlags(prevFlags);
+
+    return debug;
+}
+
 namespace Implementation {
     /* Used by operator<<(Debug&, std::tuple<>...) */
     template<class T> inline void tupleDebugOutput(Debug&, const T&, Sequence<>) {}
@@ -43,6 +43,7 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <algorithm>
 
 /* Checking for API level on Android */
@@ -57,10 +58,24 @@
 #include <dlfcn.h> /* dladdr(), needs also -ldl */
 #endif
 
+/* Kernel-side file copies */
+#ifdef CORRADE_TARGET_UNIX
+#ifdef __linux__
+#include <linux/fs.h> /* FICLONE */
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+#elif defined(CORRADE_TARGET_APPLE)
+#include <copyfile.h>
+#include <sys/clonefile.h>
+#endif
+#endif
+
 /* Unix, Emscripten file & directory access */
 #if defined(CORRADE_TARGET_UNIX) || defined(CORRADE_TARGET_EMSCRIPTEN)
 #include <cerrno>
 #include <cstring>
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <dirent.h>
 #include <unistd.h>
@@ -80,25 +95,88 @@
 #include <basetyps.h>
 #endif
 #include <shlobj.h>
+#include <cwchar>
 #include <io.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
 #endif
 
 #include "Corrade/configure.h"
 #include "Corrade/Containers/Array.h"
+#include "Corrade/Containers/GrowableArray.h"
+#include "Corrade/Containers/Optional.h"
 #include "Corrade/Containers/ScopeGuard.h"
+#include "Corrade/Containers/StringStl.h"
+#include "Corrade/Utility/Assert.h"
 #include "Corrade/Utility/Debug.h"
 #include "Corrade/Utility/DebugStl.h"
+#include "Corrade/Utility/Macros.h"
 #include "Corrade/Utility/String.h"
 
 /* Unicode helpers for Windows */
 #ifdef CORRADE_TARGET_WINDOWS
 #include "Corrade/Utility/Unicode.h"
-using Corrade::Utility::Unicode::widen;
 using Corrade::Utility::Unicode::narrow;
 #endif
 
 namespace Corrade { namespace Utility { namespace Directory {
 
+#ifdef CORRADE_TARGET_WINDOWS
+namespace {
+
+/* Null-terminated UTF-16 path for use with the Windows Unicode APIs. Unlike
+   Unicode::widen(), which allocates a std::wstring for every call, paths
+   shorter than MAX_PATH are converted on stack, and only longer paths
+   allocate. A single UTF-8 byte never produces more than one UTF-16 code
+   unit, so the path size is enough. */
+class WidePath {
+    public:
+        explicit WidePath(const Containers::StringView path) {
+            wchar_t* out;
+            if(path.size() < Containers::arraySize(_stack)) out = _stack;
+            else {
+                _heap = Containers::Array<wchar_t>{Containers::NoInit, path.size() + 1};
+                out = _heap.data();
+            }
+
+            const std::size_t size = Unicode::utf16({path.data(), path.size()}, {reinterpret_cast<char16_t*>(out), path.size()});
+            out[size] = L'\0';
+            _data = out;
+        }
+
+        const wchar_t* data() const { return _data; }
+
+    private:
+        wchar_t _stack[MAX_PATH];
+        Containers::Array<wchar_t> _heap;
+        const wchar_t* _data;
+};
+
+/* UTF-8 representation of a file name returned by FindFirstFileW() and
+   friends, which is at most MAX_PATH UTF-16 code units long. Converted on
+   stack to avoid allocating a temporary std::string for every listed
+   entry. Each UTF-16 code unit takes at most three UTF-8 bytes. */
+class NarrowFilename {
+    public:
+        explicit NarrowFilename(const wchar_t* const filename) {
+            const std::size_t size = std::wcslen(filename);
+            _size = Unicode::utf8({reinterpret_cast<const char16_t*>(filename), size}, _data);
+        }
+
+        const char* data() const { return _data; }
+        std::size_t size() const { return _size; }
+
+        Containers::StringView view() const { return {_data, _size}; }
+
+    private:
+        char _data[MAX_PATH*3];
+        std::size_t _size;
+};
+
+}
+#endif
+
 std::string fromNativeSeparators(std::string path) {
     #ifdef CORRADE_TARGET_WINDOWS
     std::replace(path.begin(), path.end(), '\\', '/');
@@ -113,67 +191,86 @@ std::string toNativeSeparators(std::string path) {
     return path;
 }
 
+namespace {
+
+/* Pointer to the last occurence of given character, nullptr if not found */
+const char* findLast(const Containers::StringView string, const char character) {
+    for(const char* i = string.end(); i != string.begin(); --i)
+        if(*(i - 1) == character) return i - 1;
+    return nullptr;
+}
+
+bool isAbsolute(const Containers::StringView filename) {
+    #ifdef CORRADE_TARGET_WINDOWS
+    /* Absolute filename on Windows */
+    if(filename.size() > 2 && filename[1] == ':' && filename[2] == '/')
+        return true;
+    #endif
+
+    return !filename.empty() && filename[0] == '/';
+}
+
+}
+
 std::string path(const std::string& filename) {
+    return pathView(filename);
+}
+
+Containers::StringView pathView(const Containers::StringView filename) {
     /* If filename is already a path, return it */
     if(!filename.empty() && filename.back() == '/')
-        return filename.substr(0, filename.size()-1);
-
-    std::size_t pos = filename.find_last_of('/');
+        return filename.except(1);
 
-    /* Filename doesn't contain any slash (no path), return empty string */
-    if(pos == std::string::npos) return {};
-
-    /* Return everything to last slash */
-    return filename.substr(0, pos);
+    /* Filename doesn't contain any slash (no path), return empty string,
+       otherwise return everything to last slash */
+    const char* const pos = findLast(filename, '/');
+    return pos ? filename.prefix(pos) : filename.prefix(std::size_t{0});
 }
 
 std::string filename(const std::string& filename) {
-    std::size_t pos = filename.find_last_of('/');
-
-    /* Return whole filename if it doesn't contain slash */
-    if(pos == std::string::npos) return filename;
+    return filenameView(filename);
+}
 
-    /* Return everything after last slash */
-    return filename.substr(pos+1);
+Containers::StringView filenameView(const Containers::StringView filename) {
+    /* Return whole filename if it doesn't contain slash, otherwise return
+       everything after last slash */
+    const char* const pos = findLast(filename, '/');
+    return pos ? filename.suffix(pos + 1) : filename;
 }
 
 std::pair<std::string, std::string> splitExtension(const std::string& filename) {
+    const std::pair<Containers::StringView, Containers::StringView> split = splitExtensionView(filename);
+    return {split.first, split.second};
+}
+
+std::pair<Containers::StringView, Containers::StringView> splitExtensionView(const Containers::StringView filename) {
     /* Find the last dot and the last slash -- for file.tar.gz we want just
        .gz as an extension; for /etc/rc.conf/bak we don't want to split at the
        folder name. */
-    const std::size_t pos = filename.find_last_of('.');
-    const std::size_t lastSlash = filename.find_last_of('/');
+    const char* const pos = findLast(filename, '.');
+    const char* const lastSlash = findLast(filename, '/');
 
     /* Empty extension if there's no dot or if the dot is not inside the
        filename */
-    if(pos == std::string::npos || (lastSlash != std::string::npos && pos < lastSlash))
-        return {filename, {}};
+    if(!pos || (lastSlash && pos < lastSlash))
+        return {filename, filename.suffix(filename.size())};
 
     /* If the dot at the start of the filename (/root/.bashrc), it's also an
        empty extension. Multiple dots at the start (/home/mosra/../..) classify
        as no extension as well. */
-    std::size_t prev = pos;
-    while(prev && filename[prev - 1] == '.') --prev;
-    CORRADE_INTERNAL_ASSERT(pos < filename.size());
-    if(prev == 0 || filename[prev - 1] == '/') return {filename, {}};
+    const char* prev = pos;
+    while(prev != filename.begin() && *(prev - 1) == '.') --prev;
+    CORRADE_INTERNAL_ASSERT(pos < filename.end());
+    if(prev == filename.begin() || *(prev - 1) == '/')
+        return {filename, filename.suffix(filename.size())};
 
     /* Otherwise it's a real extension */
-    return {filename.substr(0, pos), filename.substr(pos)};
+    return {filename.prefix(pos), filename.suffix(pos)};
 }
 
 std::string join(const std::string& path, const std::string& filename) {
-    /* Empty path */
-    if(path.empty()) return filename;
-
-    #ifdef CORRADE_TARGET_WINDOWS
-    /* Absolute filename on Windows */
-    if(filename.size() > 2 && filename[1] == ':' && filename[2] == '/')
-        return filename;
-    #endif
-
-    /* Absolute filename */
-    if(!filename.empty() && filename[0] == '/')
-        return filename;
+    /* Empty path or absolute filename */
+    if(path.empty() || isAbsolute(filename)) return filename;
 
     /* Add trailing slash to path, if not present */
     if(path.back() != '/')
@@ -194,6 +291,53 @@ std::string join(const std::initializer_list<std::string> paths) {
     return path;
 }
 
+namespace {
+
+/* Appends `filename` to a path that's already at the end of `buffer`,
+   starting at `offset`. Same logic as in join() above. */
+void appendJoined(Containers::Array<char>& buffer, const std::size_t offset, const Containers::StringView filename) {
+    if(buffer.size() != offset && !isAbsolute(filename)) {
+        if(buffer.back() != '/') Containers::arrayAppend(buffer, '/');
+    } else Containers::arrayResize(buffer, Containers::NoInit, offset);
+
+    Containers::arrayAppend(buffer, Containers::arrayView(filename.data(), filename.size()));
+}
+
+}
+
+std::size_t joinInto(const Containers::ArrayView<char>& buffer, const Containers::StringView path, const Containers::StringView filename) {
+    /* Empty path or absolute filename */
+    if(path.empty() || isAbsolute(filename)) {
+        if(filename.size() <= buffer.size())
+            std::memcpy(buffer.data(), filename.data(), filename.size());
+        return filename.size();
+    }
+
+    /* Add trailing slash to path, if not present */
+    const std::size_t slash = path.back() != '/';
+    const std::size_t size = path.size() + slash + filename.size();
+    if(size <= buffer.size()) {
+        std::memcpy(buffer.data(), path.data(), path.size());
+        if(slash) buffer[path.size()] = '/';
+        std::memcpy(buffer.data() + path.size() + slash, filename.data(), filename.size());
+    }
+    return size;
+}
+
+std::size_t joinInto(Containers::Array<char>& buffer, const Containers::StringView path, const Containers::StringView filename) {
+    const std::size_t offset = buffer.size();
+    Containers::arrayAppend(buffer, Containers::arrayView(path.data(), path.size()));
+    appendJoined(buffer, offset, filename);
+    return buffer.size() - offset;
+}
+
+std::size_t joinInto(Containers::Array<char>& buffer, const std::initializer_list<Containers::StringView> paths) {
+    const std::size_t offset = buffer.size();
+    for(const Containers::StringView path: paths)
+        appendJoined(buffer, offset, path);
+    return buffer.size() - offset;
+}
+
 bool mkpath(const std::string& path) {
     if(path.empty()) return false;
 
@@ -217,7 +361,7 @@ bool mkpath(const std::string& path) {
 
     /* Windows (not Store/Phone) */
     #elif defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
-    return CreateDirectoryW(widen(path).data(), nullptr) != 0 || GetLastError() == ERROR_ALREADY_EXISTS;
+    return CreateDirectoryW(WidePath{path}.data(), nullptr) != 0 || GetLastError() == ERROR_ALREADY_EXISTS;
 
     /* Not implemented elsewhere */
     #else
@@ -229,7 +373,7 @@ bool mkpath(const std::string& path) {
 bool rm(const std::string& path) {
     #if defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
     /* std::remove() can't remove directories on Windows */
-    auto wpath = widen(path);
+    const WidePath wpath{path};
     if(GetFileAttributesW(wpath.data()) & FILE_ATTRIBUTE_DIRECTORY)
         return RemoveDirectoryW(wpath.data());
 
@@ -253,7 +397,7 @@ bool move(const std::string& oldPath, const std::string& newPath) {
         #ifndef CORRADE_TARGET_WINDOWS
         std::rename(oldPath.data(), newPath.data())
         #else
-        _wrename(widen(oldPath).data(), widen(newPath).data())
+        _wrename(WidePath{oldPath}.data(), WidePath{newPath}.data())
         #endif
         == 0;
 }
@@ -265,7 +409,7 @@ bool exists(const std::string& filename) {
 
     /* Windows (not Store/Phone) */
     #elif defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
-    return GetFileAttributesW(widen(filename).data()) != INVALID_FILE_ATTRIBUTES;
+    return GetFileAttributesW(WidePath{filename}.data()) != INVALID_FILE_ATTRIBUTES;
 
     /* Windows Store/Phone not implemented */
     #else
@@ -277,7 +421,7 @@ bool exists(const std::string& filename) {
 
 bool isDirectory(const std::string& path) {
     #if defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
-    const DWORD fileAttributes = GetFileAttributesW(widen(path).data());
+    const DWORD fileAttributes = GetFileAttributesW(WidePath{path}.data());
     return fileAttributes != INVALID_FILE_ATTRIBUTES && (fileAttributes & FILE_ATTRIBUTE_DIRECTORY);
 
     #elif defined(CORRADE_TARGET_UNIX) || defined(CORRADE_TARGET_EMSCRIPTEN)
@@ -549,7 +693,7 @@ std::vector<std::string> list(const std::string& path, Flags flags) {
     /* Windows (not Store/Phone) */
     #elif defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
     WIN32_FIND_DATAW data;
-    HANDLE hFile = FindFirstFileW(widen(join(path, "*")).data(), &data);
+    HANDLE hFile = FindFirstFileW(WidePath{join(path, "*")}.data(), &data);
     if(hFile == INVALID_HANDLE_VALUE) return list;
 
     /* Explicitly add `.` for compatibility with other systems */
@@ -562,12 +706,12 @@ std::vector<std::string> list(const std::string& path, Flags flags) {
             continue;
         /** @todo are there any special files in WINAPI? */
 
-        std::string file{narrow(data.cFileName)};
+        const NarrowFilename file{data.cFileName};
         /* Not testing for dot, as it is not listed on Windows */
-        if((flags >= Flag::SkipDotAndDotDot) && file == "..")
+        if((flags >= Flag::SkipDotAndDotDot) && file.view() == "..")
             continue;
 
-        list.push_back(std::move(file));
+        list.emplace_back(file.data(), file.size());
     }
 
     /* Other not implemented */
@@ -584,12 +728,182 @@ std::vector<std::string> list(const std::string& path, Flags flags) {
     return list;
 }
 
+namespace {
+
+bool skipEntry(const Flags flags, const EntryType type) {
+    return (type == EntryType::Directory && (flags >= Flag::SkipDirectories)) ||
+           (type == EntryType::File && (flags >= Flag::SkipFiles)) ||
+           ((type == EntryType::Symlink || type == EntryType::Special) && (flags >= Flag::SkipSpecial));
+}
+
+/* Appends entries of path to out, with names prefixed by prefix. If
+   subdirectories is non-null, relative paths of all subdirectories except .
+   and .. are appended to it regardless of flags. */
+bool listEntriesInto(const std::string& path, const std::string& prefix, const Flags flags, std::vector<Entry>& out, std::vector<std::string>* const subdirectories) {
+    /* POSIX-compliant Unix, Emscripten */
+    #if defined(CORRADE_TARGET_UNIX) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    DIR* directory = opendir(path.data());
+    if(!directory) return false;
+
+    dirent* entry;
+    while((entry = readdir(directory)) != nullptr) {
+        const bool isDotOrDotDot = entry->d_name[0] == '.' && (entry->d_name[1] == '\0' || (entry->d_name[1] == '.' && entry->d_name[2] == '\0'));
+        if(isDotOrDotDot && (subdirectories || flags >= Flag::SkipDotAndDotDot))
+            continue;
+
+        /* If the directory listing already tells us the type, entries that
+           are going to be skipped don't need to be queried at all. Emscripten
+           reports reliably only directories. */
+        #ifndef CORRADE_TARGET_EMSCRIPTEN
+        if(entry->d_type != DT_UNKNOWN && !(subdirectories && entry->d_type == DT_DIR)) {
+            const EntryType type =
+                entry->d_type == DT_REG ? EntryType::File :
+                entry->d_type == DT_DIR ? EntryType::Directory :
+                entry->d_type == DT_LNK ? EntryType::Symlink :
+                    EntryType::Special;
+            if(skipEntry(flags, type)) continue;
+        }
+        #endif
+
+        /* Query the metadata relative to the opened directory to avoid
+           resolving the full path again */
+        struct stat result;
+        #ifndef CORRADE_TARGET_EMSCRIPTEN
+        if(fstatat(dirfd(directory), entry->d_name, &result, AT_SYMLINK_NOFOLLOW) != 0)
+        #else
+        if(lstat(join(path, entry->d_name).data(), &result) != 0)
+        #endif
+            continue;
+
+        Entry e;
+        e.type =
+            S_ISREG(result.st_mode) ? EntryType::File :
+            S_ISDIR(result.st_mode) ? EntryType::Directory :
+            S_ISLNK(result.st_mode) ? EntryType::Symlink :
+                EntryType::Special;
+        e.size = result.st_size;
+        e.modificationTime =
+            #ifdef CORRADE_TARGET_APPLE
+            std::uint64_t(result.st_mtimespec.tv_sec)*1000000000 + std::uint64_t(result.st_mtimespec.tv_nsec)
+            #elif defined(st_mtime)
+            std::uint64_t(result.st_mtim.tv_sec)*1000000000 + std::uint64_t(result.st_mtim.tv_nsec)
+            #else
+            std::uint64_t(result.st_mtime)*1000000000
+            #endif
+            ;
+
+        std::string name = prefix + entry->d_name;
+        if(subdirectories && e.type == EntryType::Directory)
+            subdirectories->push_back(name);
+        if(skipEntry(flags, e.type)) continue;
+
+        e.name = std::move(name);
+        out.push_back(std::move(e));
+    }
+
+    closedir(directory);
+    return true;
+
+    /* Windows (not Store/Phone) */
+    #elif defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
+    /* The basic info level doesn't query the short 8.3 names, which saves
+       time, and the large fetch retrieves the entries in bigger batches,
+       lowering the number of roundtrips on network drives */
+    WIN32_FIND_DATAW data;
+    HANDLE hFile = FindFirstFileExW(WidePath{join(path, "*")}.data(), FindExInfoBasic, &data, FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH);
+    if(hFile == INVALID_HANDLE_VALUE) return false;
+
+    do {
+        const bool isDotOrDotDot = data.cFileName[0] == L'.' && (data.cFileName[1] == L'\0' || (data.cFileName[1] == L'.' && data.cFileName[2] == L'\0'));
+        if(isDotOrDotDot && (subdirectories || flags >= Flag::SkipDotAndDotDot))
+            continue;
+
+        Entry e;
+        e.type =
+            data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT ? EntryType::Symlink :
+            data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY ? EntryType::Directory :
+                EntryType::File;
+        e.size = (std::uint64_t(data.nFileSizeHigh) << 32)|data.nFileSizeLow;
+        /* FILETIME is in 100 ns units since Jan 1, 1601 */
+        e.modificationTime = (((std::uint64_t(data.ftLastWriteTime.dwHighDateTime) << 32)|data.ftLastWriteTime.dwLowDateTime) - 116444736000000000ull)*100;
+
+        /* Assembling the name in a single allocation */
+        const NarrowFilename filename{data.cFileName};
+        std::string name;
+        name.reserve(prefix.size() + filename.size());
+        name.append(prefix).append(filename.data(), filename.size());
+        if(subdirectories && e.type == EntryType::Directory)
+            subdirectories->push_back(name);
+        if(skipEntry(flags, e.type)) continue;
+
+        e.name = std::move(name);
+        out.push_back(std::move(e));
+    } while(FindNextFileW(hFile, &data));
+
+    FindClose(hFile);
+    return true;
+
+    /* Other not implemented */
+    #else
+    static_cast<void>(path);
+    static_cast<void>(prefix);
+    static_cast<void>(flags);
+    static_cast<void>(out);
+    static_cast<void>(subdirectories);
+    return false;
+    #endif
+}
+
+void sortEntries(std::vector<Entry>& entries, const Flags flags) {
+    if(flags >= Flag::SortAscending)
+        std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+            return a.name < b.name;
+        });
+    else if(flags >= Flag::SortDescending)
+        std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+            return a.name > b.name;
+        });
+}
+
+}
+
+std::vector<Entry> listEntries(const std::string& path, const Flags flags) {
+    std::vector<Entry> entries;
+    #if !defined(CORRADE_TARGET_UNIX) && !defined(CORRADE_TARGET_EMSCRIPTEN) && !(defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    Warning() << "Utility::Directory::listEntries(): not implemented on this platform";
+    #endif
+    listEntriesInto(path, {}, flags, entries, nullptr);
+    sortEntries(entries, flags);
+    return entries;
+}
+
+std::vector<Entry> listEntriesRecursive(const std::string& path, const Flags flags) {
+    std::vector<Entry> entries;
+    #if !defined(CORRADE_TARGET_UNIX) && !defined(CORRADE_TARGET_EMSCRIPTEN) && !(defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    Warning() << "Utility::Directory::listEntriesRecursive(): not implemented on this platform";
+    #endif
+
+    /* Depth-first walk with an explicit stack of relative paths to avoid
+       unbounded recursion on deep trees */
+    std::vector<std::string> subdirectories;
+    if(!listEntriesInto(path, {}, flags, entries, &subdirectories))
+        return entries;
+    while(!subdirectories.empty()) {
+        const std::string subdirectory = std::move(subdirectories.back());
+        subdirectories.pop_back();
+        listEntriesInto(join(path, subdirectory), subdirectory + '/', flags, entries, &subdirectories);
+    }
+
+    sortEntries(entries, flags);
+    return entries;
+}
+
 Containers::Array<char> read(const std::string& filename) {
     /* Special case for "Unicode" Windows support */
     #ifndef CORRADE_TARGET_WINDOWS
     std::FILE* const f = std::fopen(filename.data(), "rb");
     #else
-    std::FILE* const f = _wfopen(widen(filename).data(), L"rb");
+    std::FILE* const f = _wfopen(WidePath{filename}.data(), L"rb");
     #endif
     if(!f) {
         Error{} << "Utility::Directory::read(): can't open" << filename;
@@ -611,16 +925,18 @@ Containers::Array<char> read(const std::string& filename) {
         _lseek(_fileno(f), 0, SEEK_END) == -1
         #endif
     ) {
-        std::string data;
-        char buffer[4096];
+        /* Read directly into a growable array and then convert it back to
+           one with a default deleter, copying the data just once */
+        Containers::Array<char> out;
         std::size_t count;
         do {
-            count = std::fread(buffer, 1, Containers::arraySize(buffer), f);
-            data.append(buffer, count);
+            const std::size_t size = out.size();
+            Containers::arrayResize(out, Containers::NoInit, size + 4096);
+            count = std::fread(out + size, 1, 4096, f);
+            Containers::arrayResize(out, Containers::NoInit, size + count);
         } while(count);
 
-        Containers::Array<char> out{data.size()};
-        std::copy(data.begin(), data.end(), out.begin());
+        Containers::arrayShrink(out);
         return out;
     }
     #else
@@ -654,18 +970,376 @@ Containers::Array<char> read(const std::string& filename) {
     return Containers::Array<char>{out.release(), realSize};
 }
 
+namespace {
+
+/* Opens a file for reading and queries its size, if known. The returned
+   handle is -1 / nullptr on failure. */
+#ifdef CORRADE_TARGET_UNIX
+typedef int ReadHandle;
+constexpr ReadHandle InvalidReadHandle = -1;
+
+ReadHandle openForReading(const std::string& filename, std::size_t& size, bool& sizeKnown) {
+    const int fd = open(filename.data(), O_RDONLY);
+    if(fd == -1) return fd;
+
+    /* Some special files (such as stuff in /sys) report more bytes than they
+       actually have, others (such as /proc) report zero. Regular files with
+       zero size are fine too, the read will just hit EOF right away. */
+    struct stat st;
+    sizeKnown = fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size;
+    size = sizeKnown ? st.st_size : 0;
+    return fd;
+}
+
+void closeForReading(const ReadHandle fd) { close(fd); }
+
+/* Returns -1 on error, 0 on EOF */
+std::ptrdiff_t readSome(const ReadHandle fd, char* const out, const std::size_t size) {
+    for(;;) {
+        const ssize_t count = ::read(fd, out, size);
+        if(count == -1 && errno == EINTR) continue;
+        return count;
+    }
+}
+#else
+typedef std::FILE* ReadHandle;
+constexpr ReadHandle InvalidReadHandle = nullptr;
+
+ReadHandle openForReading(const std::string& filename, std::size_t& size, bool& sizeKnown) {
+    /* Special case for "Unicode" Windows support */
+    #ifndef CORRADE_TARGET_WINDOWS
+    std::FILE* const f = std::fopen(filename.data(), "rb");
+    #else
+    std::FILE* const f = _wfopen(WidePath{filename}.data(), L"rb");
+    #endif
+    if(!f) return f;
+
+    #ifdef CORRADE_TARGET_WINDOWS
+    sizeKnown = _fseeki64(f, 0, SEEK_END) == 0;
+    size = sizeKnown ? _ftelli64(f) : 0;
+    #else
+    sizeKnown = std::fseek(f, 0, SEEK_END) == 0;
+    size = sizeKnown ? std::ftell(f) : 0;
+    #endif
+    sizeKnown = sizeKnown && size;
+    std::rewind(f);
+    return f;
+}
+
+void closeForReading(const ReadHandle f) { std::fclose(f); }
+
+std::ptrdiff_t readSome(const ReadHandle f, char* const out, const std::size_t size) {
+    const std::size_t count = std::fread(out, 1, size, f);
+    return !count && std::ferror(f) ? -1 : std::ptrdiff_t(count);
+}
+#endif
+
+}
+
+bool read(const std::string& filename, Containers::Array<char>& out) {
+    std::size_t size;
+    bool sizeKnown;
+    const ReadHandle handle = openForReading(filename, size, sizeKnown);
+    if(handle == InvalidReadHandle) {
+        Error{} << "Utility::Directory::read(): can't open" << filename;
+        return false;
+    }
+
+    Containers::ScopeGuard exit{handle, closeForReading};
+
+    /* If the size is known, read it all at once, otherwise use the existing
+       capacity and grow the array until EOF is reached */
+    const std::size_t capacity = Containers::arrayCapacity(out);
+    Containers::arrayResize(out, Containers::NoInit, sizeKnown ? size :
+        capacity ? capacity : 4096);
+    std::size_t position = 0;
+    for(;;) {
+        if(position == out.size()) {
+            if(sizeKnown) break;
+            Containers::arrayResize(out, Containers::NoInit, out.size()*2);
+        }
+
+        const std::ptrdiff_t count = readSome(handle, out + position, out.size() - position);
+        if(count == -1) {
+            Error{} << "Utility::Directory::read(): can't read from" << filename;
+            return false;
+        }
+        if(count == 0) break;
+        position += count;
+    }
+
+    Containers::arrayResize(out, Containers::NoInit, position);
+    return true;
+}
+
+Containers::Optional<std::size_t> read(const std::string& filename, const Containers::ArrayView<char> out) {
+    std::size_t size;
+    bool sizeKnown;
+    const ReadHandle handle = openForReading(filename, size, sizeKnown);
+    if(handle == InvalidReadHandle) {
+        Error{} << "Utility::Directory::read(): can't open" << filename;
+        return {};
+    }
+
+    Containers::ScopeGuard exit{handle, closeForReading};
+
+    if(sizeKnown && size > out.size()) {
+        Error{} << "Utility::Directory::read(): file" << filename << "has" << size << "bytes but the output is only" << out.size();
+        return {};
+    }
+
+    std::size_t position = 0;
+    for(;;) {
+        /* Check that there's nothing more to read if the output is full */
+        char dummy;
+        const bool full = position == out.size();
+        const std::ptrdiff_t count = full ? readSome(handle, &dummy, 1) :
+            readSome(handle, out + position, out.size() - position);
+        if(count == -1) {
+            Error{} << "Utility::Directory::read(): can't read from" << filename;
+            return {};
+        }
+        if(count == 0) break;
+        if(full) {
+            Error{} << "Utility::Directory::read(): file" << filename << "is larger than the output of" << out.size() << "bytes";
+            return {};
+        }
+        position += count;
+    }
+
+    return position;
+}
+
+bool read(const std::string& filename, const std::size_t offset, const Containers::ArrayView<char> out) {
+    return read(filename, {&offset, 1}, {&out, 1});
+}
+
+bool read(const std::string& filename, const Containers::ArrayView<const std::size_t> offsets, const Containers::ArrayView<const Containers::ArrayView<char>> outputs) {
+    CORRADE_ASSERT(offsets.size() == outputs.size(),
+        "Utility::Directory::read(): expected the same number of offsets and outputs but got" << offsets.size() << "and" << outputs.size(), {});
+
+    #ifdef CORRADE_TARGET_UNIX
+    const int fd = open(filename.data(), O_RDONLY);
+    if(fd == -1) {
+        Error{} << "Utility::Directory::read(): can't open" << filename;
+        return false;
+    }
+
+    Containers::ScopeGuard exit{fd, close};
+
+    for(std::size_t i = 0; i != offsets.size(); ++i) {
+        /* pread() can return less than requested, loop until it's all
+           there or until we hit the end of the file */
+        const Containers::ArrayView<char> out = outputs[i];
+        std::size_t size = 0;
+        while(size != out.size()) {
+            const ssize_t count = pread(fd, out + size, out.size() - size, offsets[i] + size);
+            if(count == -1 && errno == EINTR) continue;
+            if(count == -1) {
+                Error{} << "Utility::Directory::read(): can't read from" << filename << Debug::nospace << ":" << std::strerror(errno);
+                return false;
+            }
+            if(count == 0) break;
+            size += count;
+        }
+
+        if(size != out.size()) {
+            Error{} << "Utility::Directory::read(): can't read" << out.size() << "bytes at offset" << offsets[i] << "from" << filename << Debug::nospace << ", got only" << size;
+            return false;
+        }
+    }
+    #else
+    /* Special case for "Unicode" Windows support */
+    #ifndef CORRADE_TARGET_WINDOWS
+    std::FILE* const f = std::fopen(filename.data(), "rb");
+    #else
+    std::FILE* const f = _wfopen(WidePath{filename}.data(), L"rb");
+    #endif
+    if(!f) {
+        Error{} << "Utility::Directory::read(): can't open" << filename;
+        return false;
+    }
+
+    Containers::ScopeGuard exit{f, std::fclose};
+
+    /* No buffering, the reads go directly to the output */
+    std::setvbuf(f, nullptr, _IONBF, 0);
+
+    for(std::size_t i = 0; i != offsets.size(); ++i) {
+        if(
+            #ifdef CORRADE_TARGET_WINDOWS
+            _fseeki64(f, offsets[i], SEEK_SET)
+            #else
+            std::fseek(f, offsets[i], SEEK_SET)
+            #endif
+        != 0) {
+            Error{} << "Utility::Directory::read(): can't seek to offset" << offsets[i] << "in" << filename;
+            return false;
+        }
+
+        const Containers::ArrayView<char> out = outputs[i];
+        const std::size_t size = std::fread(out, 1, out.size(), f);
+        if(size != out.size()) {
+            Error{} << "Utility::Directory::read(): can't read" << out.size() << "bytes at offset" << offsets[i] << "from" << filename << Debug::nospace << ", got only" << size;
+            return false;
+        }
+    }
+    #endif
+
+    return true;
+}
+
 std::string readString(const std::string& filename) {
     const auto data = read(filename);
 
     return {data, data.size()};
 }
 
-bool write(const std::string& filename, const Containers::ArrayView<const void> data) {
+namespace {
+
+bool syncDescriptor(const int fd) {
+    #ifdef CORRADE_TARGET_WINDOWS
+    return _commit(fd) == 0;
+    #elif defined(CORRADE_TARGET_APPLE) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    /* No fdatasync() on Apple platforms */
+    return fsync(fd) == 0;
+    #else
+    return fdatasync(fd) == 0;
+    #endif
+}
+
+bool closeDescriptor(const int fd) {
+    #ifdef CORRADE_TARGET_WINDOWS
+    return _close(fd) == 0;
+    #else
+    return close(fd) == 0;
+    #endif
+}
+
+/* Writes data into a new uniquely named sibling of filename, returning its
+   name or an empty string on failure */
+std::string writeTemporary(const char* const function, const std::string& filename, const Containers::ArrayView<const void> data, const bool durable, const bool startWriteback) {
+    /* The counter is thread-local to avoid a data race, name clashes between
+       threads or processes are resolved by O_EXCL below */
+    CORRADE_THREAD_LOCAL static unsigned counter = 0;
+
+    std::string temporary;
+    int fd;
+    for(;;) {
+        temporary = filename + ".tmp" + std::to_string(counter++);
+        #ifndef CORRADE_TARGET_WINDOWS
+        fd = open(temporary.data(), O_WRONLY|O_CREAT|O_EXCL, mode_t(0666));
+        #else
+        fd = _wopen(WidePath{temporary}.data(), _O_WRONLY|_O_CREAT|_O_EXCL|_O_BINARY, _S_IREAD|_S_IWRITE);
+        #endif
+        if(fd != -1) break;
+        if(errno != EEXIST) {
+            Error{} << function << "can't create a temporary file for" << filename;
+            return {};
+        }
+    }
+
+    const char* ptr = static_cast<const char*>(data.data());
+    std::size_t remaining = data.size();
+    bool success = true;
+    while(remaining) {
+        #ifndef CORRADE_TARGET_WINDOWS
+        const ssize_t written = ::write(fd, ptr, remaining);
+        #else
+        const int written = _write(fd, ptr, unsigned(std::min(remaining, std::size_t{1} << 30)));
+        #endif
+        if(written < 0 && errno == EINTR) continue;
+        if(written <= 0) {
+            success = false;
+            break;
+        }
+        ptr += written;
+        remaining -= written;
+    }
+
+    #if defined(__linux__) && (!defined(CORRADE_TARGET_ANDROID) || __ANDROID_API__ >= 26)
+    /* Start the write-back without waiting for it, so it's (mostly) done by
+       the time the file is flushed */
+    if(success && startWriteback)
+        sync_file_range(fd, 0, 0, SYNC_FILE_RANGE_WRITE);
+    #else
+    static_cast<void>(startWriteback);
+    #endif
+
+    if(success && durable) success = syncDescriptor(fd);
+
+    /* Network filesystems may report write errors only on close */
+    if(!closeDescriptor(fd)) success = false;
+
+    if(!success) {
+        Error{} << function << "can't write to" << temporary;
+        rm(temporary);
+        return {};
+    }
+
+    return temporary;
+}
+
+bool syncFile(const std::string& filename) {
+    #ifndef CORRADE_TARGET_WINDOWS
+    const int fd = open(filename.data(), O_WRONLY);
+    #else
+    const int fd = _wopen(WidePath{filename}.data(), _O_WRONLY|_O_BINARY);
+    #endif
+    if(fd == -1) return false;
+    const bool success = syncDescriptor(fd);
+    return closeDescriptor(fd) && success;
+}
+
+bool replaceFile(const std::string& from, const std::string& to) {
+    #ifdef CORRADE_TARGET_WINDOWS
+    /* Unlike with rename(), the destination can exist */
+    return MoveFileExW(WidePath{from}.data(), WidePath{to}.data(), MOVEFILE_REPLACE_EXISTING|MOVEFILE_WRITE_THROUGH);
+    #else
+    return std::rename(from.data(), to.data()) == 0;
+    #endif
+}
+
+bool syncDirectory(const std::string& path) {
+    #ifndef CORRADE_TARGET_WINDOWS
+    const int fd = open(path.empty() ? "." : path.data(), O_RDONLY);
+    if(fd == -1) return false;
+    const bool success = fsync(fd) == 0;
+    return closeDescriptor(fd) && success;
+    #else
+    /* Directories can't be synced on Windows, MOVEFILE_WRITE_THROUGH in
+       replaceFile() takes care of the rename being durable */
+    static_cast<void>(path);
+    return true;
+    #endif
+}
+
+}
+
+bool write(const std::string& filename, const Containers::ArrayView<const void> data, const WriteFlags flags) {
+    if(flags & WriteFlag::Atomic) {
+        const std::string temporary = writeTemporary("Utility::Directory::write():", filename, data, bool(flags & WriteFlag::Durable), false);
+        if(temporary.empty()) return false;
+
+        if(!replaceFile(temporary, filename)) {
+            Error{} << "Utility::Directory::write(): can't replace" << filename;
+            rm(temporary);
+            return false;
+        }
+
+        if((flags & WriteFlag::Durable) && !syncDirectory(path(filename))) {
+            Error{} << "Utility::Directory::write(): can't sync the directory of" << filename;
+            return false;
+        }
+
+        return true;
+    }
+
     /* Special case for "Unicode" Windows support */
     #ifndef CORRADE_TARGET_WINDOWS
     std::FILE* const f = std::fopen(filename.data(), "wb");
     #else
-    std::FILE* const f = _wfopen(widen(filename).data(), L"wb");
+    std::FILE* const f = _wfopen(WidePath{filename}.data(), L"wb");
     #endif
     if(!f) {
         Error{} << "Utility::Directory::write(): can't open" << filename;
@@ -675,20 +1349,111 @@ bool write(const std::string& filename, const Containers::ArrayView<const void>
     Containers::ScopeGuard exit{f, std::fclose};
 
     std::fwrite(data, 1, data.size(), f);
+
+    if(flags & WriteFlag::Durable) {
+        #ifndef CORRADE_TARGET_WINDOWS
+        const int fd = fileno(f);
+        #else
+        const int fd = _fileno(f);
+        #endif
+        if(std::fflush(f) != 0 || !syncDescriptor(fd)) {
+            Error{} << "Utility::Directory::write(): can't sync" << filename;
+            return false;
+        }
+    }
+
     return true;
 }
 
-bool writeString(const std::string& filename, const std::string& data) {
+bool writeString(const std::string& filename, const std::string& data, const WriteFlags flags) {
     static_assert(sizeof(std::string::value_type) == 1, "std::string doesn't have 8-bit characters");
+    return write(filename, {data.data(), data.size()}, flags);
+}
+
+struct WriteBatch::State {
+    WriteFlags flags;
+    /* Temporary file and the destination */
+    std::vector<std::pair<std::string, std::string>> files;
+};
+
+WriteBatch::WriteBatch(const WriteFlags flags): _state{Containers::InPlaceInit, State{flags|WriteFlag::Atomic, {}}} {}
+
+WriteBatch::WriteBatch(WriteBatch&&) noexcept = default;
+
+WriteBatch::~WriteBatch() {
+    /* Moved-out instance */
+    if(!_state) return;
+
+    for(const std::pair<std::string, std::string>& file: _state->files)
+        rm(file.first);
+}
+
+WriteBatch& WriteBatch::operator=(WriteBatch&&) noexcept = default;
+
+std::size_t WriteBatch::count() const { return _state->files.size(); }
+
+bool WriteBatch::write(const std::string& filename, const Containers::ArrayView<const void> data) {
+    /* The data are flushed in commit(), all at once */
+    const std::string temporary = writeTemporary("Utility::Directory::WriteBatch::write():", filename, data, false, bool(_state->flags & WriteFlag::Durable));
+    if(temporary.empty()) return false;
+
+    _state->files.emplace_back(temporary, filename);
+    return true;
+}
+
+bool WriteBatch::writeString(const std::string& filename, const std::string& data) {
     return write(filename, {data.data(), data.size()});
 }
 
+bool WriteBatch::commit() {
+    /* Whatever happens, the batch is empty after. Files that don't get
+       renamed are removed at the end of the scope. */
+    WriteBatch files{_state->flags};
+    std::swap(files._state->files, _state->files);
+
+    const bool durable = bool(_state->flags & WriteFlag::Durable);
+
+    /* Flush everything first so the renames don't expose incomplete data */
+    if(durable) for(const std::pair<std::string, std::string>& file: files._state->files) {
+        if(!syncFile(file.first)) {
+            Error{} << "Utility::Directory::WriteBatch::commit(): can't sync" << file.first;
+            return false;
+        }
+    }
+
+    std::vector<std::string> directories;
+    while(!files._state->files.empty()) {
+        const std::pair<std::string, std::string>& file = files._state->files.back();
+        if(!replaceFile(file.first, file.second)) {
+            Error{} << "Utility::Directory::WriteBatch::commit(): can't replace" << file.second;
+            return false;
+        }
+
+        if(durable) {
+            std::string directory = path(file.second);
+            if(std::find(directories.begin(), directories.end(), directory) == directories.end())
+                directories.push_back(std::move(directory));
+        }
+
+        files._state->files.pop_back();
+    }
+
+    for(const std::string& directory: directories) {
+        if(!syncDirectory(directory)) {
+            Error{} << "Utility::Directory::WriteBatch::commit(): can't sync directory" << directory;
+            return false;
+        }
+    }
+
+    return true;
+}
+
 bool append(const std::string& filename, const Containers::ArrayView<const void> data) {
     /* Special case for "Unicode" Windows support */
     #ifndef CORRADE_TARGET_WINDOWS
     std::FILE* const f = std::fopen(filename.data(), "ab");
     #else
-    std::FILE* const f = _wfopen(widen(filename).data(), L"ab");
+    std::FILE* const f = _wfopen(WidePath{filename}.data(), L"ab");
     #endif
     if(!f) {
         Error{} << "Utility::Directory::append(): can't open" << filename;
@@ -706,12 +1471,77 @@ bool appendString(const std::string& filename, const std::string& data) {
     return append(filename, {data.data(), data.size()});
 }
 
+#ifdef CORRADE_TARGET_UNIX
+namespace {
+
+/* Returns false if the copy has to be done in userspace, in which case both
+   files are rewound back to the start */
+bool copyInKernel(const int in, const int out) {
+    /* Files in /proc and such report zero size, these have to be read until
+       EOF instead */
+    struct stat result;
+    if(fstat(in, &result) != 0 || !S_ISREG(result.st_mode) || !result.st_size)
+        return false;
+
+    #ifdef __linux__
+    /* On copy-on-write filesystems such as Btrfs or XFS this shares the
+       extents instead of copying the data */
+    #ifdef FICLONE
+    if(ioctl(out, FICLONE, in) == 0) return true;
+    #endif
+
+    /* Otherwise copy inside the kernel, which avoids a roundtrip through
+       userspace and allows for in-filesystem or server-side copies on network
+       filesystems. Not all libc versions have a wrapper, so calling the
+       syscall directly. */
+    std::size_t remaining = result.st_size;
+    #ifdef SYS_copy_file_range
+    while(remaining) {
+        const long copied = syscall(SYS_copy_file_range, in, nullptr, out, nullptr, remaining, 0u);
+        if(copied <= 0) break;
+        remaining -= copied;
+    }
+    #endif
+
+    /* Older kernels don't support copy_file_range() across filesystems, but
+       sendfile() can do it without leaving the kernel as well. Continues from
+       where the above ended, if anything. */
+    while(remaining) {
+        const ssize_t copied = sendfile(out, in, nullptr, remaining);
+        if(copied <= 0) break;
+        remaining -= copied;
+    }
+
+    if(!remaining) return true;
+    #elif defined(CORRADE_TARGET_APPLE)
+    if(fcopyfile(in, out, nullptr, COPYFILE_DATA) == 0) return true;
+    #endif
+
+    /* Something failed, start over in userspace. The output doesn't need to
+       be truncated, as everything written so far gets overwritten with the
+       same data again. */
+    lseek(in, 0, SEEK_SET);
+    lseek(out, 0, SEEK_SET);
+    return false;
+}
+
+}
+#endif
+
 bool copy(const std::string& from, const std::string& to) {
+    #if defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
+    /* Let the system do the copy, which can use server-side copies on network
+       shares and block cloning on ReFS. If it fails, the loop below is used,
+       which also takes care of reporting the actual error. */
+    if(CopyFileExW(WidePath{from}.data(), WidePath{to}.data(), nullptr, nullptr, nullptr, 0))
+        return true;
+    #endif
+
     /* Special case for "Unicode" Windows support */
     #ifndef CORRADE_TARGET_WINDOWS
     std::FILE* const in = std::fopen(from.data(), "rb");
     #else
-    std::FILE* const in = _wfopen(widen(from).data(), L"rb");
+    std::FILE* const in = _wfopen(WidePath{from}.data(), L"rb");
     #endif
     if(!in) {
         Error{} << "Utility::Directory::copy(): can't open" << from;
@@ -720,10 +1550,18 @@ bool copy(const std::string& from, const std::string& to) {
 
     Containers::ScopeGuard exitIn{in, std::fclose};
 
+    #ifdef CORRADE_TARGET_APPLE
+    /* On APFS this creates a copy-on-write clone, which is instant and
+       doesn't take any extra space. Works only if the destination doesn't
+       exist yet. */
+    if(!exists(to) && clonefile(from.data(), to.data(), 0) == 0)
+        return true;
+    #endif
+
     #ifndef CORRADE_TARGET_WINDOWS
     std::FILE* const out = std::fopen(to.data(), "wb");
     #else
-    std::FILE* const out = _wfopen(widen(to).data(), L"wb");
+    std::FILE* const out = _wfopen(WidePath{to}.data(), L"wb");
     #endif
     if(!out) {
         Error{} << "Utility::Directory::copy(): can't open" << to;
@@ -732,6 +1570,12 @@ bool copy(const std::string& from, const std::string& to) {
 
     Containers::ScopeGuard exitOut{out, std::fclose};
 
+    /* Nothing was read or written through the FILE handles yet, so it's safe
+       to operate on the underlying descriptors directly */
+    #ifdef CORRADE_TARGET_UNIX
+    if(copyInKernel(fileno(in), fileno(out))) return true;
+    #endif
+
     #if defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 200112L
     /* As noted in https://eklitzke.org/efficient-file-copying-on-linux, might
        make the file reading faster. Didn't make any difference in the 100 MB
@@ -754,12 +1598,76 @@ bool copy(const std::string& from, const std::string& to) {
 
 #ifdef CORRADE_TARGET_UNIX
 void MapDeleter::operator()(const char* const data, const std::size_t size) {
-    if(data && munmap(const_cast<char*>(data), size) == -1)
-        Error() << "Utility::Directory: can't unmap memory-mapped file";
+    if(data) {
+        /* The mapping starts at a page boundary, which may be before the data
+           the user sees */
+        char* const mapped = const_cast<char*>(data) - _offset;
+        if(_sync) msync(mapped, size + _offset, MS_ASYNC);
+        if(munmap(mapped, size + _offset) == -1)
+            Error() << "Utility::Directory: can't unmap memory-mapped file";
+    }
     if(_fd) close(_fd);
 }
 
-Containers::Array<char, MapDeleter> map(const std::string& filename) {
+namespace {
+
+std::size_t fileSize(const int fd) {
+    const off_t currentPos = lseek(fd, 0, SEEK_CUR);
+    const std::size_t size = lseek(fd, 0, SEEK_END);
+    lseek(fd, currentPos, SEEK_SET);
+    return size;
+}
+
+/* Takes ownership of the file descriptor, closing it on failure */
+template<class T> Containers::Array<T, MapDeleter> mapFile(const char* const function, const int fd, const int protection, const std::size_t offset, const std::size_t size, const MapFlags flags) {
+    /* mmap() needs the offset aligned to a page size, map from the preceding
+       page boundary and hide the prefix from the user */
+    const std::size_t pageOffset = offset % std::size_t(sysconf(_SC_PAGESIZE));
+    const std::size_t mappedSize = size + pageOffset;
+
+    int mapFlags = MAP_SHARED;
+    #ifdef MAP_POPULATE
+    if(flags & MapFlag::Prefetch) mapFlags |= MAP_POPULATE;
+    #endif
+
+    void* const mapped = mmap(nullptr, mappedSize, protection, mapFlags, fd, offset - pageOffset);
+    if(mapped == MAP_FAILED) {
+        close(fd);
+        Error{} << function << "can't map the file";
+        return nullptr;
+    }
+
+    /* The rest is just hints, failures are not fatal */
+    if(flags & MapFlag::Sequential)
+        madvise(mapped, mappedSize, MADV_SEQUENTIAL);
+    else if(flags & MapFlag::Random)
+        madvise(mapped, mappedSize, MADV_RANDOM);
+    #ifndef MAP_POPULATE
+    if(flags & MapFlag::Prefetch)
+        madvise(mapped, mappedSize, MADV_WILLNEED);
+    #endif
+    #ifdef MADV_HUGEPAGE
+    if(flags & MapFlag::HugePages)
+        madvise(mapped, mappedSize, MADV_HUGEPAGE);
+    #endif
+
+    return Containers::Array<T, MapDeleter>{static_cast<T*>(mapped) + pageOffset, size, MapDeleter{fd, pageOffset, bool(flags & MapFlag::SyncOnUnmap)}};
+}
+
+bool checkMapRange(const char* const function, const int fd, const std::string& filename, const std::size_t offset, const std::size_t size) {
+    const std::size_t totalSize = fileSize(fd);
+    if(offset > totalSize || size > totalSize - offset) {
+        close(fd);
+        Error{} << function << "can't map" << size << "bytes at offset" << offset << "from" << filename << "of" << totalSize << "bytes";
+        return false;
+    }
+
+    return true;
+}
+
+}
+
+Containers::Array<char, MapDeleter> map(const std::string& filename, const MapFlags flags) {
     /* Open the file for reading */
     const int fd = open(filename.data(), O_RDWR);
     if(fd == -1) {
@@ -767,23 +1675,24 @@ Containers::Array<char, MapDeleter> map(const std::string& filename) {
         return nullptr;
     }
 
-    /* Get file size */
-    const off_t currentPos = lseek(fd, 0, SEEK_CUR);
-    const std::size_t size = lseek(fd, 0, SEEK_END);
-    lseek(fd, currentPos, SEEK_SET);
+    return mapFile<char>("Utility::Directory::map():", fd, PROT_READ|PROT_WRITE, 0, fileSize(fd), flags);
+}
 
-    /* Map the file */
-    char* data = reinterpret_cast<char*>(mmap(nullptr, size, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0));
-    if(data == MAP_FAILED) {
-        close(fd);
-        Error{} << "Utility::Directory::map(): can't map the file";
+Containers::Array<char, MapDeleter> map(const std::string& filename, const std::size_t offset, const std::size_t size, const MapFlags flags) {
+    /* Open the file for reading */
+    const int fd = open(filename.data(), O_RDWR);
+    if(fd == -1) {
+        Error{} << "Utility::Directory::map(): can't open" << filename;
         return nullptr;
     }
 
-    return Containers::Array<char, MapDeleter>{data, size, MapDeleter{fd}};
+    if(!checkMapRange("Utility::Directory::map():", fd, filename, offset, size))
+        return nullptr;
+
+    return mapFile<char>("Utility::Directory::map():", fd, PROT_READ|PROT_WRITE, offset, size, flags);
 }
 
-Containers::Array<const char, MapDeleter> mapRead(const std::string& filename) {
+Containers::Array<const char, MapDeleter> mapRead(const std::string& filename, const MapFlags flags) {
     /* Open the file for reading */
     const int fd = open(filename.data(), O_RDONLY);
     if(fd == -1) {
@@ -791,23 +1700,26 @@ Containers::Array<const char, MapDeleter> mapRead(const std::string& filename) {
         return nullptr;
     }
 
-    /* Get file size */
-    const off_t currentPos = lseek(fd, 0, SEEK_CUR);
-    const std::size_t size = lseek(fd, 0, SEEK_END);
-    lseek(fd, currentPos, SEEK_SET);
+    /* Syncing makes no sense for a read-only mapping */
+    return mapFile<const char>("Utility::Directory::mapRead():", fd, PROT_READ, 0, fileSize(fd), flags & ~MapFlag::SyncOnUnmap);
+}
 
-    /* Map the file */
-    const char* data = reinterpret_cast<const char*>(mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0));
-    if(data == MAP_FAILED) {
-        close(fd);
-        Error() << "Utility::Directory::mapRead(): can't map the file";
+Containers::Array<const char, MapDeleter> mapRead(const std::string& filename, const std::size_t offset, const std::size_t size, const MapFlags flags) {
+    /* Open the file for reading */
+    const int fd = open(filename.data(), O_RDONLY);
+    if(fd == -1) {
+        Error() << "Utility::Directory::mapRead(): can't open" << filename;
         return nullptr;
     }
 
-    return Containers::Array<const char, MapDeleter>{data, size, MapDeleter{fd}};
+    if(!checkMapRange("Utility::Directory::mapRead():", fd, filename, offset, size))
+        return nullptr;
+
+    /* Syncing makes no sense for a read-only mapping */
+    return mapFile<const char>("Utility::Directory::mapRead():", fd, PROT_READ, offset, size, flags & ~MapFlag::SyncOnUnmap);
 }
 
-Containers::Array<char, MapDeleter> mapWrite(const std::string& filename, std::size_t size) {
+Containers::Array<char, MapDeleter> mapWrite(const std::string& filename, std::size_t size, const MapFlags flags) {
     /* Open the file for writing. Create if it doesn't exist, truncate it if it
        does. */
     const int fd = open(filename.data(), O_RDWR|O_CREAT|O_TRUNC, mode_t(0600));
@@ -830,116 +1742,154 @@ Containers::Array<char, MapDeleter> mapWrite(const std::string& filename, std::s
         return nullptr;
     }
 
-    /* Map the file */
-    char* data = reinterpret_cast<char*>(mmap(nullptr, size, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0));
-    if(data == MAP_FAILED) {
-        close(fd);
-        Error{} << "Utility::Directory::mapWrite(): can't map the file";
-        return nullptr;
-    }
-
-    return Containers::Array<char, MapDeleter>{data, size, MapDeleter{fd}};
+    return mapFile<char>("Utility::Directory::mapWrite():", fd, PROT_READ|PROT_WRITE, 0, size, flags);
 }
 #elif defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
 void MapDeleter::operator()(const char* const data, const std::size_t) {
-    if(data) UnmapViewOfFile(data);
+    if(data) {
+        /* The view starts at an allocation granularity boundary, which may be
+           before the data the user sees */
+        const char* const mapped = data - _offset;
+        if(_sync) FlushViewOfFile(mapped, 0);
+        UnmapViewOfFile(mapped);
+    }
     if(_hMap) CloseHandle(_hMap);
     if(_hFile) CloseHandle(_hFile);
 }
 
-Containers::Array<char, MapDeleter> map(const std::string& filename) {
-    /* Open the file for writing. Create if it doesn't exist, truncate it if it
-       does. */
-    HANDLE hFile = CreateFileW(widen(filename).data(),
-        GENERIC_READ|GENERIC_WRITE, FILE_SHARE_READ|FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, 0, nullptr);
-    if(hFile == INVALID_HANDLE_VALUE) {
-        Error() << "Utility::Directory::map(): can't open" << filename;
-        return nullptr;
-    }
+namespace {
+
+DWORD fileFlags(const MapFlags flags) {
+    if(flags & MapFlag::Sequential) return FILE_FLAG_SEQUENTIAL_SCAN;
+    if(flags & MapFlag::Random) return FILE_FLAG_RANDOM_ACCESS;
+    return 0;
+}
 
+std::size_t fileSize(HANDLE hFile) {
+    LARGE_INTEGER size;
+    if(!GetFileSizeEx(hFile, &size)) return 0;
+    return std::size_t(size.QuadPart);
+}
+
+/* Takes ownership of the file handle, closing it on failure. If mappingSize
+   is non-zero, the file is resized to it. */
+template<class T> Containers::Array<T, MapDeleter> mapFile(const char* const function, HANDLE hFile, const DWORD protection, const DWORD access, const std::size_t mappingSize, const std::size_t offset, const std::size_t size, const MapFlags flags) {
     /* Create the file mapping */
-    HANDLE hMap = CreateFileMappingW(hFile, nullptr, PAGE_READWRITE, 0, 0, nullptr);
+    HANDLE hMap = CreateFileMappingW(hFile, nullptr, protection, DWORD(std::uint64_t(mappingSize) >> 32), DWORD(mappingSize & 0xffffffffu), nullptr);
     if(!hMap) {
-        Error() << "Utility::Directory::map(): can't create the file mapping:" << GetLastError();
+        Error() << function << "can't create the file mapping:" << GetLastError();
         CloseHandle(hFile);
         return nullptr;
     }
 
-    /* Get file size */
-    const size_t size = GetFileSize(hFile, nullptr);
+    /* The view offset has to be aligned to allocation granularity, map from
+       the preceding boundary and hide the prefix from the user */
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    const std::size_t granularityOffset = offset % info.dwAllocationGranularity;
+    const std::uint64_t alignedOffset = offset - granularityOffset;
+    const std::size_t mappedSize = size + granularityOffset;
 
     /* Map the file */
-    char* data = reinterpret_cast<char*>(::MapViewOfFile(hMap, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+    char* data = reinterpret_cast<char*>(::MapViewOfFile(hMap, access, DWORD(alignedOffset >> 32), DWORD(alignedOffset & 0xffffffffu), mappedSize));
     if(!data) {
-        Error() << "Utility::Directory::map(): can't map the file:" << GetLastError();
+        Error() << function << "can't map the file:" << GetLastError();
         CloseHandle(hMap);
         CloseHandle(hFile);
         return nullptr;
     }
 
-    return Containers::Array<char, MapDeleter>{data, size, MapDeleter{hFile, hMap}};
+    /* Just a hint, failures are not fatal. Available since Windows 8. */
+    #if _WIN32_WINNT >= 0x0602
+    if(flags & MapFlag::Prefetch) {
+        WIN32_MEMORY_RANGE_ENTRY range{data, mappedSize};
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
+    #endif
+
+    return Containers::Array<T, MapDeleter>{data + granularityOffset, size, MapDeleter{hFile, hMap, granularityOffset, bool(flags & MapFlag::SyncOnUnmap)}};
 }
 
-Containers::Array<const char, MapDeleter> mapRead(const std::string& filename) {
-    /* Open the file for reading */
-    HANDLE hFile = CreateFileW(widen(filename).data(),
-        GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, 0, nullptr);
+bool checkMapRange(const char* const function, HANDLE hFile, const std::string& filename, const std::size_t offset, const std::size_t size) {
+    const std::size_t totalSize = fileSize(hFile);
+    if(offset > totalSize || size > totalSize - offset) {
+        CloseHandle(hFile);
+        Error{} << function << "can't map" << size << "bytes at offset" << offset << "from" << filename << "of" << totalSize << "bytes";
+        return false;
+    }
+
+    return true;
+}
+
+}
+
+Containers::Array<char, MapDeleter> map(const std::string& filename, const MapFlags flags) {
+    /* Open the file for reading and writing */
+    HANDLE hFile = CreateFileW(WidePath{filename}.data(),
+        GENERIC_READ|GENERIC_WRITE, FILE_SHARE_READ|FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, fileFlags(flags), nullptr);
     if(hFile == INVALID_HANDLE_VALUE) {
-        Error() << "Utility::Directory::mapRead(): can't open" << filename;
+        Error() << "Utility::Directory::map(): can't open" << filename;
         return nullptr;
     }
 
-    /* Create the file mapping */
-    HANDLE hMap = CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
-    if(!hMap) {
-        Error() << "Utility::Directory::mapRead(): can't create the file mapping:" << GetLastError();
-        CloseHandle(hFile);
+    return mapFile<char>("Utility::Directory::map():", hFile, PAGE_READWRITE, FILE_MAP_ALL_ACCESS, 0, 0, fileSize(hFile), flags);
+}
+
+Containers::Array<char, MapDeleter> map(const std::string& filename, const std::size_t offset, const std::size_t size, const MapFlags flags) {
+    /* Open the file for reading and writing */
+    HANDLE hFile = CreateFileW(WidePath{filename}.data(),
+        GENERIC_READ|GENERIC_WRITE, FILE_SHARE_READ|FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, fileFlags(flags), nullptr);
+    if(hFile == INVALID_HANDLE_VALUE) {
+        Error() << "Utility::Directory::map(): can't open" << filename;
         return nullptr;
     }
 
-    /* Get file size */
-    const size_t size = GetFileSize(hFile, nullptr);
+    if(!checkMapRange("Utility::Directory::map():", hFile, filename, offset, size))
+        return nullptr;
 
-    /* Map the file */
-    char* data = reinterpret_cast<char*>(::MapViewOfFile(hMap, FILE_MAP_READ, 0, 0, 0));
-    if(!data) {
-        Error() << "Utility::Directory::mapRead(): can't map the file:" << GetLastError();
-        CloseHandle(hMap);
-        CloseHandle(hFile);
+    return mapFile<char>("Utility::Directory::map():", hFile, PAGE_READWRITE, FILE_MAP_ALL_ACCESS, 0, offset, size, flags);
+}
+
+Containers::Array<const char, MapDeleter> mapRead(const std::string& filename, const MapFlags flags) {
+    /* Open the file for reading */
+    HANDLE hFile = CreateFileW(WidePath{filename}.data(),
+        GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, fileFlags(flags), nullptr);
+    if(hFile == INVALID_HANDLE_VALUE) {
+        Error() << "Utility::Directory::mapRead(): can't open" << filename;
         return nullptr;
     }
 
-    return Containers::Array<const char, MapDeleter>{data, size, MapDeleter{hFile, hMap}};
+    /* Syncing makes no sense for a read-only mapping */
+    return mapFile<const char>("Utility::Directory::mapRead():", hFile, PAGE_READONLY, FILE_MAP_READ, 0, 0, fileSize(hFile), flags & ~MapFlag::SyncOnUnmap);
 }
 
-Containers::Array<char, MapDeleter> mapWrite(const std::string& filename, std::size_t size) {
-    /* Open the file for writing. Create if it doesn't exist, truncate it if it
-       does. */
-    HANDLE hFile = CreateFileW(widen(filename).data(),
-        GENERIC_READ|GENERIC_WRITE, FILE_SHARE_READ|FILE_SHARE_WRITE, nullptr, CREATE_ALWAYS, 0, nullptr);
+Containers::Array<const char, MapDeleter> mapRead(const std::string& filename, const std::size_t offset, const std::size_t size, const MapFlags flags) {
+    /* Open the file for reading */
+    HANDLE hFile = CreateFileW(WidePath{filename}.data(),
+        GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, fileFlags(flags), nullptr);
     if(hFile == INVALID_HANDLE_VALUE) {
-        Error() << "Utility::Directory::mapWrite(): can't open" << filename;
+        Error() << "Utility::Directory::mapRead(): can't open" << filename;
         return nullptr;
     }
 
-    /* Create the file mapping */
-    HANDLE hMap = CreateFileMappingW(hFile, nullptr, PAGE_READWRITE, 0, size, nullptr);
-    if(!hMap) {
-        Error() << "Utility::Directory::mapWrite(): can't create the file mapping:" << GetLastError();
-        CloseHandle(hFile);
+    if(!checkMapRange("Utility::Directory::mapRead():", hFile, filename, offset, size))
         return nullptr;
-    }
 
-    /* Map the file */
-    char* data = reinterpret_cast<char*>(::MapViewOfFile(hMap, FILE_MAP_ALL_ACCESS, 0, 0, 0));
-    if(!data) {
-        Error() << "Utility::Directory::mapWrite(): can't map the file:" << GetLastError();
-        CloseHandle(hMap);
-        CloseHandle(hFile);
+    /* Syncing makes no sense for a read-only mapping */
+    return mapFile<const char>("Utility::Directory::mapRead():", hFile, PAGE_READONLY, FILE_MAP_READ, 0, offset, size, flags & ~MapFlag::SyncOnUnmap);
+}
+
+Containers::Array<char, MapDeleter> mapWrite(const std::string& filename, std::size_t size, const MapFlags flags) {
+    /* Open the file for writing. Create if it doesn't exist, truncate it if it
+       does. */
+    HANDLE hFile = CreateFileW(WidePath{filename}.data(),
+        GENERIC_READ|GENERIC_WRITE, FILE_SHARE_READ|FILE_SHARE_WRITE, nullptr, CREATE_ALWAYS, fileFlags(flags), nullptr);
+    if(hFile == INVALID_HANDLE_VALUE) {
+        Error() << "Utility::Directory::mapWrite(): can't open" << filename;
         return nullptr;
     }
 
-    return Containers::Array<char, MapDeleter>{data, size, MapDeleter{hFile, hMap}};
+    return mapFile<char>("Utility::Directory::mapWrite():", hFile, PAGE_READWRITE, FILE_MAP_ALL_ACCESS, size, 0, size, flags);
 }
 #endif
 
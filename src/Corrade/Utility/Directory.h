@@ -29,10 +29,14 @@
  * @brief Namespace @ref Corrade::Utility::Directory
  */
 
+#include <cstdint>
 #include <initializer_list>
+#include <string>
 
 #include "Corrade/Containers/Containers.h"
 #include "Corrade/Containers/EnumSet.h"
+#include "Corrade/Containers/Pointer.h"
+#include "Corrade/Containers/StringView.h"
 #include "Corrade/Utility/StlForwardString.h"
 #include "Corrade/Utility/StlForwardVector.h"
 #include "Corrade/Utility/visibility.h"
@@ -116,12 +120,115 @@ enum class Flag: unsigned char {
 /**
 @brief Listing flags
 
-@see @ref list()
+@see @ref list(), @ref listEntries(), @ref listEntriesRecursive()
 */
 typedef Containers::EnumSet<Flag> Flags;
 
 CORRADE_ENUMSET_OPERATORS(Flags)
 
+#if defined(DOXYGEN_GENERATING_OUTPUT) || defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+/**
+@brief Memory mapping flag
+@m_since_latest
+
+All flags are just hints, which are ignored on platforms that don't support
+them.
+@see @ref MapFlags, @ref map(), @ref mapRead(), @ref mapWrite()
+@partialsupport Available only on @ref CORRADE_TARGET_UNIX "Unix" and non-RT
+    @ref CORRADE_TARGET_WINDOWS "Windows" platforms.
+*/
+enum class MapFlag: unsigned char {
+    /**
+     * The memory will be accessed sequentially, allowing more aggressive
+     * read-ahead. Uses @cpp MADV_SEQUENTIAL @ce on Unix and
+     * @cpp FILE_FLAG_SEQUENTIAL_SCAN @ce on Windows. If both
+     * @ref MapFlag::Sequential and @ref MapFlag::Random are specified, the
+     * former is used.
+     */
+    Sequential = 1 << 0,
+
+    /**
+     * The memory will be accessed in a random order, making read-ahead
+     * wasteful. Uses @cpp MADV_RANDOM @ce on Unix and
+     * @cpp FILE_FLAG_RANDOM_ACCESS @ce on Windows.
+     */
+    Random = 1 << 1,
+
+    /**
+     * Fault the whole mapping in eagerly instead of on first access. Uses
+     * @cpp MAP_POPULATE @ce on Linux, @cpp MADV_WILLNEED @ce on other Unix
+     * systems and @cpp PrefetchVirtualMemory() @ce on Windows 8 and newer.
+     */
+    Prefetch = 1 << 2,
+
+    /**
+     * Back the mapping with transparent huge pages, if the kernel and the
+     * filesystem support it. Uses @cpp MADV_HUGEPAGE @ce on Linux, ignored
+     * elsewhere.
+     */
+    HugePages = 1 << 3,
+
+    /**
+     * Schedule a write-back of modified pages when the mapping is destroyed,
+     * without waiting for it to finish. Uses @cpp msync(MS_ASYNC) @ce on Unix
+     * and @cpp FlushViewOfFile() @ce on Windows. Has no effect on read-only
+     * mappings.
+     */
+    SyncOnUnmap = 1 << 4
+};
+
+/**
+@brief Memory mapping flags
+@m_since_latest
+
+@see @ref map(), @ref mapRead(), @ref mapWrite()
+@partialsupport Available only on @ref CORRADE_TARGET_UNIX "Unix" and non-RT
+    @ref CORRADE_TARGET_WINDOWS "Windows" platforms.
+*/
+typedef Containers::EnumSet<MapFlag> MapFlags;
+
+CORRADE_ENUMSET_OPERATORS(MapFlags)
+#endif
+
+/**
+@brief File writing flag
+@m_since_latest
+
+@see @ref WriteFlags, @ref write(), @ref writeString(), @ref WriteBatch
+*/
+enum class WriteFlag: unsigned char {
+    /**
+     * Write the data into a new file next to the destination and then
+     * atomically rename it over the destination, so it contains either the
+     * original or the new contents, never a partially written file. The
+     * temporary file is named after the destination with a `.tmp` suffix and
+     * a number. A file that didn't exist is created with default permissions,
+     * permissions of an existing file are not preserved.
+     */
+    Atomic = 1 << 0,
+
+    /**
+     * Flush the data to the storage device before returning. Uses
+     * @m_class{m-doc-external} [fdatasync()](https://man.archlinux.org/man/fdatasync.2)
+     * on Unix, @cpp fsync() @ce on Apple platforms and @cpp _commit() @ce on
+     * Windows. Combined with @ref WriteFlag::Atomic, the directory containing
+     * the file is synced as well after the rename, so the rename itself
+     * survives a power loss. On Windows the rename is done with
+     * @cpp MOVEFILE_WRITE_THROUGH @ce instead.
+     */
+    Durable = 1 << 1
+};
+
+/**
+@brief File writing flags
+@m_since_latest
+
+@see @ref write(), @ref writeString(), @ref WriteBatch
+*/
+typedef Containers::EnumSet<WriteFlag> WriteFlags;
+
+CORRADE_ENUMSET_OPERATORS(WriteFlags)
+
 /**
 @brief Convert path from native separators
 
@@ -146,10 +253,23 @@ path, returns empty string, if the filename is already a path (ends with
 slash), returns whole string without trailing slash.
 @attention The implementation expects forward slashes as directory separators.
     Use @ref fromNativeSeparators() to convert from a platform-specific format.
-@see @ref filename(), @ref splitExtension()
+@see @ref filename(), @ref splitExtension(), @ref pathView()
 */
 CORRADE_UTILITY_EXPORT std::string path(const std::string& filename);
 
+/**
+@brief Extract path from filename as a view
+@m_since_latest
+
+Same as @ref path(), but returns a view on @p filename instead of allocating a
+new string. The returned view is valid for as long as the memory @p filename
+points to.
+@attention The implementation expects forward slashes as directory separators.
+    Use @ref fromNativeSeparators() to convert from a platform-specific format.
+@see @ref filenameView(), @ref splitExtensionView()
+*/
+CORRADE_UTILITY_EXPORT Containers::StringView pathView(Containers::StringView filename);
+
 /**
 @brief Extract filename (without path) from filename
 
@@ -157,10 +277,23 @@ If the filename doesn't contain any slash, returns whole string, otherwise
 returns everything after last slash.
 @attention The implementation expects forward slashes as directory separators.
     Use @ref fromNativeSeparators() to convert from a platform-specific format.
-@see @ref path(), @ref splitExtension()
+@see @ref path(), @ref splitExtension(), @ref filenameView()
 */
 CORRADE_UTILITY_EXPORT std::string filename(const std::string& filename);
 
+/**
+@brief Extract filename (without path) from filename as a view
+@m_since_latest
+
+Same as @ref filename(), but returns a view on @p filename instead of
+allocating a new string. The returned view is valid for as long as the memory
+@p filename points to.
+@attention The implementation expects forward slashes as directory separators.
+    Use @ref fromNativeSeparators() to convert from a platform-specific format.
+@see @ref pathView(), @ref splitExtensionView()
+*/
+CORRADE_UTILITY_EXPORT Containers::StringView filenameView(Containers::StringView filename);
+
 /**
 @brief Split basename and extension
 @m_since{2019,10}
@@ -172,10 +305,24 @@ on the filename are ignored, @cpp splitExtension("/home/.bashrc") @ce returns
 @cb{.py} os.path.splitext() @ce.
 @attention The implementation expects forward slashes as directory separators.
     Use @ref fromNativeSeparators() to convert from a platform-specific format.
-@see @ref path(), @ref filename(), @ref String::partition()
+@see @ref path(), @ref filename(), @ref String::partition(),
+    @ref splitExtensionView()
 */
 CORRADE_UTILITY_EXPORT std::pair<std::string, std::string> splitExtension(const std::string& path);
 
+/**
+@brief Split basename and extension as views
+@m_since_latest
+
+Same as @ref splitExtension(), but returns views on @p path instead of
+allocating new strings. The returned views are valid for as long as the
+memory @p path points to.
+@attention The implementation expects forward slashes as directory separators.
+    Use @ref fromNativeSeparators() to convert from a platform-specific format.
+@see @ref pathView(), @ref filenameView()
+*/
+CORRADE_UTILITY_EXPORT std::pair<Containers::StringView, Containers::StringView> splitExtensionView(Containers::StringView path);
+
 /**
 @brief Join path and filename
 
@@ -198,6 +345,56 @@ empty string, when it's just a single path, returns it verbatim.
 */
 CORRADE_UTILITY_EXPORT std::string join(std::initializer_list<std::string> paths);
 
+/**
+@brief Join path and filename into a buffer
+@return Size of the joined path
+@m_since_latest
+
+Writes the same result as @ref join(const std::string&, const std::string&)
+would return to the beginning of @p buffer, without allocating. If the result
+doesn't fit, @p buffer is left untouched and the returned size is larger than
+its size. Useful on hot paths such as repeated asset lookups, with the buffer
+living on stack:
+
+@snippet Utility.cpp Directory-joinInto
+
+Does *not* write any terminating @cpp '\0' @ce character, append it
+explicitly if you need to pass the result to a C API.
+@attention The implementation expects forward slashes as directory separators.
+    Use @ref fromNativeSeparators() to convert from a platform-specific format.
+*/
+CORRADE_UTILITY_EXPORT std::size_t joinInto(const Containers::ArrayView<char>& buffer, Containers::StringView path, Containers::StringView filename);
+
+/**
+@brief Join path and filename into a growable array
+@return Count of bytes appended
+@m_since_latest
+
+Appends the same result as @ref join(const std::string&, const std::string&)
+would return to the end of @p buffer using @ref Containers::arrayAppend(),
+without any temporary allocations. Does *not* write any terminating
+@cpp '\0' @ce character. The same note about growable array deleters as in
+@ref formatInto(Containers::Array<char>&, const char*, const Args&... args)
+applies here.
+@attention The implementation expects forward slashes as directory separators.
+    Use @ref fromNativeSeparators() to convert from a platform-specific format.
+*/
+CORRADE_UTILITY_EXPORT std::size_t joinInto(Containers::Array<char>& buffer, Containers::StringView path, Containers::StringView filename);
+
+/**
+@brief Join paths into a growable array
+@return Count of bytes appended
+@m_since_latest
+
+Appends the same result as @ref join(std::initializer_list<std::string>)
+would return to the end of @p buffer. See
+@ref joinInto(Containers::Array<char>&, Containers::StringView, Containers::StringView)
+for more information.
+@attention The implementation expects forward slashes as directory separators.
+    Use @ref fromNativeSeparators() to convert from a platform-specific format.
+*/
+CORRADE_UTILITY_EXPORT std::size_t joinInto(Containers::Array<char>& buffer, std::initializer_list<Containers::StringView> paths);
+
 /**
 @brief List directory contents
 
@@ -206,6 +403,98 @@ On failure returns empty vector.
 */
 CORRADE_UTILITY_EXPORT std::vector<std::string> list(const std::string& path, Flags flags = Flags());
 
+/**
+@brief Directory entry type
+@m_since_latest
+
+@see @ref Entry, @ref listEntries()
+*/
+enum class EntryType: unsigned char {
+    File,       /**< Regular file */
+    Directory,  /**< Directory */
+
+    /**
+     * Symbolic link. The link is not followed.
+     * @partialsupport On @ref CORRADE_TARGET_WINDOWS "Windows" this is any
+     *      reparse point, including junctions.
+     */
+    Symlink,
+
+    /**
+     * Anything else, such as a device, a socket or a FIFO
+     * @partialsupport Never reported on @ref CORRADE_TARGET_WINDOWS "Windows".
+     */
+    Special
+};
+
+/**
+@brief Directory entry
+@m_since_latest
+
+@see @ref listEntries(), @ref listEntriesRecursive()
+*/
+struct Entry {
+    /**
+     * Entry name. For @ref listEntriesRecursive() it's a path relative to the
+     * listed directory, with forward slashes as separators.
+     */
+    std::string name;
+
+    /** Entry type */
+    EntryType type;
+
+    /**
+     * Size in bytes. For other than @ref EntryType::File the value is
+     * filesystem-specific.
+     */
+    std::uint64_t size;
+
+    /** Last modification time in nanoseconds since the Unix epoch */
+    std::uint64_t modificationTime;
+};
+
+/**
+@brief List directory contents including metadata
+@m_since_latest
+
+Compared to calling @ref list() and then querying each entry separately, this
+retrieves the type, size and modification time of each entry in a single pass
+over the directory. On Unix the type is taken directly from the directory
+listing if possible, so entries skipped via @p flags don't need to be queried
+at all, and the metadata is fetched relative to the already opened directory
+instead of resolving the whole path again for each entry. On Windows all
+metadata is a part of the directory listing itself, and it's fetched in large
+batches.
+
+The @p flags have the same meaning as in @ref list(), with symlinks treated as
+special files. Sorting is done by entry name. On failure returns an empty
+vector.
+@partialsupport Available only on @ref CORRADE_TARGET_UNIX "Unix",
+    @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten" and non-RT
+    @ref CORRADE_TARGET_WINDOWS "Windows" platforms, returns an empty vector
+    elsewhere.
+@see @ref isDirectory(), @ref exists()
+*/
+CORRADE_UTILITY_EXPORT std::vector<Entry> listEntries(const std::string& path, Flags flags = {});
+
+/**
+@brief List directory contents recursively including metadata
+@m_since_latest
+
+Like @ref listEntries(), but descends into all subdirectories, with names of
+the entries being paths relative to @p path. Symlinks to directories are not
+followed. The `.` and `..` entries are never listed, @ref Flag::SkipDirectories
+only omits the directories from the output but still descends into them. If
+sorting is requested, it's done over the whole relative paths. Subdirectories
+that can't be opened are silently skipped, if @p path itself can't be opened,
+returns an empty vector.
+@partialsupport Available only on @ref CORRADE_TARGET_UNIX "Unix",
+    @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten" and non-RT
+    @ref CORRADE_TARGET_WINDOWS "Windows" platforms, returns an empty vector
+    elsewhere.
+*/
+CORRADE_UTILITY_EXPORT std::vector<Entry> listEntriesRecursive(const std::string& path, Flags flags = {});
+
 /**
 @brief Create path
 
@@ -414,6 +703,72 @@ Expects that the filename is in UTF-8.
 */
 CORRADE_UTILITY_EXPORT Containers::Array<char> read(const std::string& filename);
 
+/**
+@brief Read file into an existing array
+@m_since_latest
+
+Like @ref read(const std::string&), but reads into @p out, resizing it to the
+file size using @ref Containers::arrayResize(). If @p out is a growable array
+with a large enough capacity, such as an array filled by a previous call to
+this function, no allocation is done, which makes it possible to read many
+files with a single reused array. Note that arrays made growable in a
+different shared library might get reallocated on the first call, see
+@ref Containers::ArrayAllocator::deleter() for details. Returns @cpp false @ce
+and prints a message to @ref Error if the file can't be read, in which case
+the contents of @p out are unspecified.
+
+On @ref CORRADE_TARGET_UNIX "Unix" platforms, regular files are read using a
+single @m_class{m-doc-external} [fstat()](https://man.archlinux.org/man/fstat.2)
+and a single @m_class{m-doc-external} [read()](https://man.archlinux.org/man/read.2)
+call in the usual case. Non-seekable files are read in chunks directly into
+the array, growing its capacity as needed.
+*/
+CORRADE_UTILITY_EXPORT bool read(const std::string& filename, Containers::Array<char>& out);
+
+/**
+@brief Read file into an existing memory
+@m_since_latest
+
+Like @ref read(const std::string&), but reads into @p out without doing any
+allocation. Returns the number of bytes read, or
+@ref Containers::NullOpt and prints a message to @ref Error if the file
+can't be read or is larger than @p out. Include
+@ref Corrade/Containers/Optional.h to use the returned value.
+*/
+CORRADE_UTILITY_EXPORT Containers::Optional<std::size_t> read(const std::string& filename, Containers::ArrayView<char> out);
+
+/**
+@brief Read a part of a file into an existing memory
+@m_since_latest
+
+Reads exactly @p out.size() bytes starting at @p offset into @p out, without
+allocating any memory or reading the rest of the file. Returns
+@cpp false @ce and prints a message to @ref Error if the file can't be opened,
+the read fails or the file is shorter than @p offset + @p out.size(). Expects
+that the filename is in UTF-8.
+
+On @ref CORRADE_TARGET_UNIX "Unix" platforms the data are read using
+@m_class{m-doc-external} [pread()](https://man.archlinux.org/man/pread.2),
+avoiding any intermediate buffering. Use
+@ref read(const std::string&, Containers::ArrayView<const std::size_t>, Containers::ArrayView<const Containers::ArrayView<char>>)
+to read multiple parts of a single file without opening it again for each.
+@see @ref mapRead()
+*/
+CORRADE_UTILITY_EXPORT bool read(const std::string& filename, std::size_t offset, Containers::ArrayView<char> out);
+
+/**
+@brief Read multiple parts of a file into an existing memory
+@m_since_latest
+
+Equivalent to calling @ref read(const std::string&, std::size_t, Containers::ArrayView<char>)
+for each pair of @p offsets and @p outputs, but opens the file just once. The
+parts are read in the order given, it's thus advisable to have them sorted by
+offset for best performance on rotational drives. Expects that @p offsets and
+@p outputs have the same size. Returns @cpp false @ce and prints a message to
+@ref Error as soon as any of the reads fails.
+*/
+CORRADE_UTILITY_EXPORT bool read(const std::string& filename, Containers::ArrayView<const std::size_t> offsets, Containers::ArrayView<const Containers::ArrayView<char>> outputs);
+
 /**
 @brief Read file into a string
 
@@ -428,10 +783,12 @@ CORRADE_UTILITY_EXPORT std::string readString(const std::string& filename);
 Writes the file as binary (i.e. without newline conversion). Existing files are
 overwritten, use @ref append() to append instead. Returns @cpp false @ce and
 prints a message to @ref Error if the file can't be written, @cpp true @ce
-otherwise. Expects that the filename is in UTF-8.
+otherwise. Expects that the filename is in UTF-8. See @ref WriteFlag for
+atomic and durable writes, use @ref WriteBatch to amortize the cost of
+durably writing many files at once.
 @see @ref writeString(), @ref read(), @ref map()
 */
-CORRADE_UTILITY_EXPORT bool write(const std::string& filename, Containers::ArrayView<const void> data);
+CORRADE_UTILITY_EXPORT bool write(const std::string& filename, Containers::ArrayView<const void> data, WriteFlags flags = {});
 
 /**
 @brief Write string into a file
@@ -439,7 +796,88 @@ CORRADE_UTILITY_EXPORT bool write(const std::string& filename, Containers::Array
 Convenience overload for @ref write().
 @see @ref readString(), @ref appendString(), @ref copy()
 */
-CORRADE_UTILITY_EXPORT bool writeString(const std::string& filename, const std::string& data);
+CORRADE_UTILITY_EXPORT bool writeString(const std::string& filename, const std::string& data, WriteFlags flags = {});
+
+/**
+@brief Batch of atomic file writes
+@m_since_latest
+
+Writes each file into a temporary file next to the destination like
+@ref write() with @ref WriteFlag::Atomic, but defers the renames until
+@ref commit(). With @ref WriteFlag::Durable, the data of all files are flushed
+first and then each distinct directory is synced just once after all renames,
+instead of once per file. On Linux the write-back of each file is started
+already in @ref write(), so the flush in @ref commit() overlaps with writing
+the remaining files.
+
+Temporary files that weren't committed are removed on destruction. Note that
+the batch is not atomic as a whole --- if @ref commit() fails or the
+application is killed during it, only some of the files may be replaced.
+*/
+class CORRADE_UTILITY_EXPORT WriteBatch {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * @ref WriteFlag::Atomic is implied, set @ref WriteFlag::Durable to
+         * make the writes durable.
+         */
+        explicit WriteBatch(WriteFlags flags = WriteFlag::Durable);
+
+        /** @brief Copying is not allowed */
+        WriteBatch(const WriteBatch&) = delete;
+
+        /** @brief Move constructor */
+        WriteBatch(WriteBatch&&) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Removes temporary files of writes that weren't committed.
+         */
+        ~WriteBatch();
+
+        /** @brief Copying is not allowed */
+        WriteBatch& operator=(const WriteBatch&) = delete;
+
+        /** @brief Move assignment */
+        WriteBatch& operator=(WriteBatch&&) noexcept;
+
+        /** @brief Count of writes waiting for a commit */
+        std::size_t count() const;
+
+        /**
+         * @brief Write array into a file
+         *
+         * Writes @p data into a temporary file, the destination is replaced
+         * only in @ref commit(). Returns @cpp false @ce and prints a message
+         * to @ref Error if the temporary file can't be written, in which case
+         * the write isn't added to the batch.
+         */
+        bool write(const std::string& filename, Containers::ArrayView<const void> data);
+
+        /**
+         * @brief Write string into a file
+         *
+         * Convenience overload for @ref write().
+         */
+        bool writeString(const std::string& filename, const std::string& data);
+
+        /**
+         * @brief Commit the writes
+         *
+         * Flushes all temporary files if @ref WriteFlag::Durable is set,
+         * renames them over their destinations and then syncs each distinct
+         * directory once. Returns @cpp false @ce and prints a message to
+         * @ref Error on the first failure, removing all temporary files that
+         * weren't renamed yet. In all cases the batch is empty afterwards.
+         */
+        bool commit();
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
 
 /**
 @brief Append array into a file
@@ -465,12 +903,25 @@ CORRADE_UTILITY_EXPORT bool appendString(const std::string& filename, const std:
 @brief Copy a file
 @m_since{2019,10}
 
-Zero-allocation file copy with 128 kB block size. Does not work on
-directories. Returns @cpp false @ce and prints a message to @ref Error if
-@p from can't be read or @p to can't be written, @cpp true @ce otherwise.
-Expects that the filename is in UTF-8.
+Zero-allocation file copy. Does not work on directories. Returns
+@cpp false @ce and prints a message to @ref Error if @p from can't be read or
+@p to can't be written, @cpp true @ce otherwise. Expects that the filename is
+in UTF-8.
+
+Where possible, the data don't pass through userspace at all:
+
+-   On Linux, a copy-on-write clone is attempted first via the
+    @cpp FICLONE @ce ioctl, then a kernel-side copy with
+    @m_class{m-doc-external} [copy_file_range()](https://man.archlinux.org/man/copy_file_range.2)
+    and @m_class{m-doc-external} [sendfile()](https://man.archlinux.org/man/sendfile.2)
+-   On Apple platforms, a copy-on-write clone is attempted with
+    @cpp clonefile() @ce if @p to doesn't exist yet, then a kernel-side copy
+    with @cpp fcopyfile() @ce
+-   On Windows, @cpp CopyFileExW() @ce is used, which also copies file
+    attributes
 
-Note that the following might be slightly faster on some systems where
+If neither of those is available or succeeds, the file is copied in 128 kB
+blocks. In that case the following might be slightly faster on systems where
 memory-mapping is supported and virtual memory is large enough for given file
 size:
 
@@ -488,12 +939,25 @@ CORRADE_UTILITY_EXPORT bool copy(const std::string& from, const std::string& to)
 Maps the file as read-write memory. The array deleter takes care of unmapping.
 If the file doesn't exist or an error occurs while mapping, @cpp nullptr @ce is
 returned and a message is printed to @ref Error. Expects that the filename is
-in UTF-8.
+in UTF-8. See @ref MapFlag for available access hints.
 @see @ref mapRead(), @ref mapWrite(), @ref read(), @ref write()
 @partialsupport Available only on @ref CORRADE_TARGET_UNIX "Unix" and non-RT
     @ref CORRADE_TARGET_WINDOWS "Windows" platforms.
 */
-CORRADE_UTILITY_EXPORT Containers::Array<char, MapDeleter> map(const std::string& filename);
+CORRADE_UTILITY_EXPORT Containers::Array<char, MapDeleter> map(const std::string& filename, MapFlags flags = {});
+
+/**
+@brief Map a part of a file for reading and writing
+@m_since_latest
+
+Like @ref map(const std::string&, MapFlags), but maps only @p size bytes
+starting at @p offset. The offset doesn't need to be aligned to a page size.
+If the range is not inside the file, @cpp nullptr @ce is returned and a
+message is printed to @ref Error.
+@partialsupport Available only on @ref CORRADE_TARGET_UNIX "Unix" and non-RT
+    @ref CORRADE_TARGET_WINDOWS "Windows" platforms.
+*/
+CORRADE_UTILITY_EXPORT Containers::Array<char, MapDeleter> map(const std::string& filename, std::size_t offset, std::size_t size, MapFlags flags = {});
 
 /**
 @brief Map file for reading
@@ -501,12 +965,26 @@ CORRADE_UTILITY_EXPORT Containers::Array<char, MapDeleter> map(const std::string
 Maps the file as read-only memory. The array deleter takes care of unmapping.
 If the file doesn't exist or an error occurs while mapping, @cpp nullptr @ce is
 returned and a message is printed to @ref Error. Expects that the filename is
-in UTF-8.
+in UTF-8. See @ref MapFlag for available access hints.
 @see @ref map(), @ref mapWrite(), @ref read()
 @partialsupport Available only on @ref CORRADE_TARGET_UNIX "Unix" and non-RT
     @ref CORRADE_TARGET_WINDOWS "Windows" platforms.
 */
-CORRADE_UTILITY_EXPORT Containers::Array<const char, MapDeleter> mapRead(const std::string& filename);
+CORRADE_UTILITY_EXPORT Containers::Array<const char, MapDeleter> mapRead(const std::string& filename, MapFlags flags = {});
+
+/**
+@brief Map a part of a file for reading
+@m_since_latest
+
+Like @ref mapRead(const std::string&, MapFlags), but maps only @p size
+bytes starting at @p offset. The offset doesn't need to be aligned to a page
+size. If the range is not inside the file, @cpp nullptr @ce is returned and a
+message is printed to @ref Error.
+@see @ref read(const std::string&, std::size_t, Containers::ArrayView<char>)
+@partialsupport Available only on @ref CORRADE_TARGET_UNIX "Unix" and non-RT
+    @ref CORRADE_TARGET_WINDOWS "Windows" platforms.
+*/
+CORRADE_UTILITY_EXPORT Containers::Array<const char, MapDeleter> mapRead(const std::string& filename, std::size_t offset, std::size_t size, MapFlags flags = {});
 
 /**
 @brief Map file for writing
@@ -517,11 +995,12 @@ not exist yet, it is created, if it exists, it's truncated --- thus no data
 is preserved. The array deleter takes care of unmapping, however the file is
 not deleted after unmapping. If an error occurs, @cpp nullptr @ce is returned
 and a message is printed to @ref Error. Expects that the filename is in UTF-8.
+See @ref MapFlag for available access hints.
 @see @ref map(), @ref mapRead(), @ref read(), @ref write()
 @partialsupport Available only on @ref CORRADE_TARGET_UNIX "Unix" and non-RT
     @ref CORRADE_TARGET_WINDOWS "Windows" platforms.
 */
-CORRADE_UTILITY_EXPORT Containers::Array<char, MapDeleter> mapWrite(const std::string& filename, std::size_t size);
+CORRADE_UTILITY_EXPORT Containers::Array<char, MapDeleter> mapWrite(const std::string& filename, std::size_t size, MapFlags flags = {});
 
 #ifdef CORRADE_BUILD_DEPRECATED
 /**
@@ -536,21 +1015,28 @@ CORRADE_DEPRECATED("use mapWrite() instead") CORRADE_UTILITY_EXPORT Containers::
 #ifdef CORRADE_TARGET_UNIX
 class CORRADE_UTILITY_EXPORT MapDeleter {
     public:
-        constexpr explicit MapDeleter(): _fd{} {}
-        constexpr explicit MapDeleter(int fd) noexcept: _fd{fd} {}
+        constexpr explicit MapDeleter(): _fd{}, _offset{}, _sync{} {}
+        constexpr explicit MapDeleter(int fd, std::size_t offset = 0, bool sync = false) noexcept: _fd{fd}, _offset{offset}, _sync{sync} {}
         void operator()(const char* data, std::size_t size);
     private:
         int _fd;
+        /* Distance of the data from the page-aligned mapping start */
+        std::size_t _offset;
+        bool _sync;
 };
 #elif defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
 class CORRADE_UTILITY_EXPORT MapDeleter {
     public:
-        constexpr explicit MapDeleter(): _hFile{}, _hMap{} {}
-        constexpr explicit MapDeleter(void* hFile, void* hMap) noexcept: _hFile{hFile}, _hMap{hMap} {}
+        constexpr explicit MapDeleter(): _hFile{}, _hMap{}, _offset{}, _sync{} {}
+        constexpr explicit MapDeleter(void* hFile, void* hMap, std::size_t offset = 0, bool sync = false) noexcept: _hFile{hFile}, _hMap{hMap}, _offset{offset}, _sync{sync} {}
         void operator()(const char* data, std::size_t size);
     private:
         void* _hFile;
         void* _hMap;
+        /* Distance of the data from the allocation-granularity-aligned
+           mapping start */
+        std::size_t _offset;
+        bool _sync;
 };
 #endif
 #endif
@@ -0,0 +1,372 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Encoding.h"
+
+#include <cstdint>
+
+#include "Corrade/Utility/Assert.h"
+#include "Corrade/Utility/Cpu.h"
+#include "Corrade/Utility/Debug.h"
+
+#ifdef CORRADE_TARGET_X86
+#include <immintrin.h>
+#endif
+
+namespace Corrade { namespace Utility { namespace Encoding {
+
+namespace {
+
+constexpr const char HexCharacters[]{'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
+
+constexpr const char Base64Characters[]{
+    'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M',
+    'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z',
+    'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm',
+    'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z',
+    '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '+', '/'
+};
+
+/* Returns value of a hexadecimal digit or a value with the high bit set if
+   the character is invalid */
+inline std::uint8_t hexValue(const char c) {
+    if(c >= '0' && c <= '9') return c - '0';
+    const char lower = c | 0x20;
+    if(lower >= 'a' && lower <= 'f') return lower - 'a' + 10;
+    return 0x80;
+}
+
+/* Returns value of a Base64 character or a value with the high bit set if
+   the character is invalid */
+inline std::uint8_t base64Value(const char c) {
+    if(c >= 'A' && c <= 'Z') return c - 'A';
+    if(c >= 'a' && c <= 'z') return c - 'a' + 26;
+    if(c >= '0' && c <= '9') return c - '0' + 52;
+    if(c == '+') return 62;
+    if(c == '/') return 63;
+    return 0x80;
+}
+
+/* The SIMD variants process as much as they can and return how far they got,
+   the rest is then done by the scalar code. The scalar variants of these
+   are thus just no-ops. */
+typedef std::size_t(*HexEncodeFunction)(const std::uint8_t*, std::size_t, char*);
+typedef std::size_t(*HexDecodeFunction)(const char*, std::size_t, std::uint8_t*);
+typedef std::size_t(*Base64EncodeFunction)(const std::uint8_t*, std::size_t, char*);
+typedef std::size_t(*Base64DecodeFunction)(const char*, std::size_t, std::uint8_t*);
+
+std::size_t hexEncodeScalar(const std::uint8_t*, std::size_t, char*) { return 0; }
+std::size_t hexDecodeScalar(const char*, std::size_t, std::uint8_t*) { return 0; }
+std::size_t base64EncodeScalar(const std::uint8_t*, std::size_t, char*) { return 0; }
+std::size_t base64DecodeScalar(const char*, std::size_t, std::uint8_t*) { return 0; }
+
+#ifdef CORRADE_TARGET_X86
+/* Sixteen input bytes get split into nibbles, which are then used to index
+   the digit table, and the two vectors interleaved. Returns count of
+   processed input bytes. */
+CORRADE_ENABLE_SSSE3 std::size_t hexEncodeSsse3(const std::uint8_t* const data, const std::size_t size, char* const out) {
+    const __m128i characters = _mm_loadu_si128(reinterpret_cast<const __m128i*>(HexCharacters));
+    const __m128i lowNibble = _mm_set1_epi8(0x0f);
+
+    std::size_t i = 0;
+    for(; size - i >= 16; i += 16) {
+        const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i high = _mm_shuffle_epi8(characters, _mm_and_si128(_mm_srli_epi16(input, 4), lowNibble));
+        const __m128i low = _mm_shuffle_epi8(characters, _mm_and_si128(input, lowNibble));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2*i), _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2*i + 16), _mm_unpackhi_epi8(high, low));
+    }
+
+    return i;
+}
+
+/* Converts sixteen characters to their values, or returns a zero mask if
+   any of them is not a hex digit. The comparisons are signed, which means
+   non-ASCII bytes are correctly treated as out of range. */
+CORRADE_ENABLE_SSSE3 inline __m128i hexValuesSsse3(const __m128i input, int& valid) {
+    const __m128i lower = _mm_or_si128(input, _mm_set1_epi8(0x20));
+    const __m128i digit = _mm_and_si128(
+        _mm_cmpgt_epi8(input, _mm_set1_epi8('0' - 1)),
+        _mm_cmplt_epi8(input, _mm_set1_epi8('9' + 1)));
+    const __m128i letter = _mm_and_si128(
+        _mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+        _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+    valid &= _mm_movemask_epi8(_mm_or_si128(digit, letter));
+    return _mm_or_si128(
+        _mm_and_si128(digit, _mm_sub_epi8(input, _mm_set1_epi8('0'))),
+        _mm_and_si128(letter, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+}
+
+/* Thirty-two characters get converted to values, each pair then merged to a
+   16-bit value with a multiply-add and packed back to bytes. Returns count of
+   processed characters or ~std::size_t{} if an invalid character was
+   found. */
+CORRADE_ENABLE_SSSE3 std::size_t hexDecodeSsse3(const char* const text, const std::size_t size, std::uint8_t* const out) {
+    const __m128i multipliers = _mm_set1_epi16(0x0110);
+
+    std::size_t i = 0;
+    for(; size - i >= 32; i += 32) {
+        int valid = 0xffff;
+        const __m128i a = hexValuesSsse3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i)), valid);
+        const __m128i b = hexValuesSsse3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i + 16)), valid);
+        if(valid != 0xffff) return ~std::size_t{};
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i/2), _mm_packus_epi16(
+            _mm_maddubs_epi16(a, multipliers),
+            _mm_maddubs_epi16(b, multipliers)));
+    }
+
+    return i;
+}
+
+/* Based on the algorithm by Wojciech Muła,
+   http://0x80.pl/notesen/2016-01-12-sse-base64-encoding.html. Twelve input
+   bytes are shuffled so each 32-bit lane contains one triplet, the 6-bit
+   fields are moved to separate bytes with multiplies and then offset to the
+   right ASCII range. Reads sixteen bytes for every twelve processed, returns
+   count of processed input bytes. */
+CORRADE_ENABLE_SSSE3 std::size_t base64EncodeSsse3(const std::uint8_t* const data, const std::size_t size, char* const out) {
+    const __m128i shuffle = _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+    std::size_t i = 0, o = 0;
+    for(; size - i >= 16; i += 12, o += 16) {
+        const __m128i input = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), shuffle);
+
+        const __m128i a = _mm_mulhi_epu16(_mm_and_si128(input, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+        const __m128i b = _mm_mullo_epi16(_mm_and_si128(input, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+        const __m128i indices = _mm_or_si128(a, b);
+
+        /* 0-25 map to offset index 13, 26-51 to 0, 52-61 to 1-10, 62 to 11
+           and 63 to 12 */
+        __m128i offsetIndices = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        offsetIndices = _mm_or_si128(offsetIndices, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices), _mm_set1_epi8(13)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + o), _mm_add_epi8(indices, _mm_shuffle_epi8(offsets, offsetIndices)));
+    }
+
+    return i;
+}
+
+/* Sixteen characters get converted to 6-bit values using range comparisons,
+   four of them then merged to a 24-bit value with two multiply-adds and the
+   bytes compacted with a shuffle. Stores sixteen bytes for every twelve
+   produced, so the last eight characters are always left for the scalar
+   code, which also handles the padding. Returns count of processed
+   characters or ~std::size_t{} if an invalid character was found. */
+CORRADE_ENABLE_SSSE3 std::size_t base64DecodeSsse3(const char* const text, const std::size_t size, std::uint8_t* const out) {
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+    std::size_t i = 0, o = 0;
+    for(; size - i >= 24; i += 16, o += 12) {
+        const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+
+        const __m128i upper = _mm_and_si128(
+            _mm_cmpgt_epi8(input, _mm_set1_epi8('A' - 1)),
+            _mm_cmplt_epi8(input, _mm_set1_epi8('Z' + 1)));
+        const __m128i lower = _mm_and_si128(
+            _mm_cmpgt_epi8(input, _mm_set1_epi8('a' - 1)),
+            _mm_cmplt_epi8(input, _mm_set1_epi8('z' + 1)));
+        const __m128i digit = _mm_and_si128(
+            _mm_cmpgt_epi8(input, _mm_set1_epi8('0' - 1)),
+            _mm_cmplt_epi8(input, _mm_set1_epi8('9' + 1)));
+        const __m128i plus = _mm_cmpeq_epi8(input, _mm_set1_epi8('+'));
+        const __m128i slash = _mm_cmpeq_epi8(input, _mm_set1_epi8('/'));
+        if(_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(_mm_or_si128(digit, plus), slash))) != 0xffff)
+            return ~std::size_t{};
+
+        const __m128i offset = _mm_or_si128(_mm_or_si128(
+            _mm_and_si128(upper, _mm_set1_epi8(-'A')),
+            _mm_and_si128(lower, _mm_set1_epi8(26 - 'a'))), _mm_or_si128(
+            _mm_and_si128(digit, _mm_set1_epi8(52 - '0')), _mm_or_si128(
+            _mm_and_si128(plus, _mm_set1_epi8(62 - '+')),
+            _mm_and_si128(slash, _mm_set1_epi8(63 - '/')))));
+        const __m128i values = _mm_add_epi8(input, offset);
+
+        /* Each 16-bit lane gets (a << 6) | b, each 32-bit lane then
+           (ab << 12) | cd, giving the three bytes in reverse order */
+        const __m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+        const __m128i triplets = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + o), _mm_shuffle_epi8(triplets, shuffle));
+    }
+
+    return i;
+}
+#endif
+
+HexEncodeFunction pickHexEncode() {
+    return Cpu::dispatch<HexEncodeFunction>({
+        #ifdef CORRADE_TARGET_X86
+        {Cpu::Feature::Ssse3, hexEncodeSsse3},
+        #endif
+    }, hexEncodeScalar);
+}
+
+HexDecodeFunction pickHexDecode() {
+    return Cpu::dispatch<HexDecodeFunction>({
+        #ifdef CORRADE_TARGET_X86
+        {Cpu::Feature::Ssse3, hexDecodeSsse3},
+        #endif
+    }, hexDecodeScalar);
+}
+
+Base64EncodeFunction pickBase64Encode() {
+    return Cpu::dispatch<Base64EncodeFunction>({
+        #ifdef CORRADE_TARGET_X86
+        {Cpu::Feature::Ssse3, base64EncodeSsse3},
+        #endif
+    }, base64EncodeScalar);
+}
+
+Base64DecodeFunction pickBase64Decode() {
+    return Cpu::dispatch<Base64DecodeFunction>({
+        #ifdef CORRADE_TARGET_X86
+        {Cpu::Feature::Ssse3, base64DecodeSsse3},
+        #endif
+    }, base64DecodeScalar);
+}
+
+}
+
+void hexEncode(const Containers::ArrayView<const void> data, const Containers::ArrayView<char> out) {
+    CORRADE_ASSERT(out.size() == data.size()*2,
+        "Utility::Encoding::hexEncode(): expected output size" << data.size()*2 << "but got" << out.size(), );
+
+    static const HexEncodeFunction function = pickHexEncode();
+    const std::uint8_t* const in = static_cast<const std::uint8_t*>(data.data());
+    for(std::size_t i = function(in, data.size(), out); i != data.size(); ++i) {
+        out[2*i] = HexCharacters[in[i] >> 4];
+        out[2*i + 1] = HexCharacters[in[i] & 0x0f];
+    }
+}
+
+bool hexDecode(const Containers::ArrayView<const char> text, const Containers::ArrayView<void> out) {
+    CORRADE_ASSERT(text.size() == out.size()*2,
+        "Utility::Encoding::hexDecode(): expected input size" << out.size()*2 << "but got" << text.size(), {});
+
+    static const HexDecodeFunction function = pickHexDecode();
+    std::uint8_t* const o = static_cast<std::uint8_t*>(out.data());
+    std::size_t i = function(text, text.size(), o);
+    if(i == ~std::size_t{}) return false;
+
+    for(; i != text.size(); i += 2) {
+        const std::uint8_t high = hexValue(text[i]);
+        const std::uint8_t low = hexValue(text[i + 1]);
+        if((high|low) & 0x80) return false;
+        o[i/2] = high << 4 | low;
+    }
+
+    return true;
+}
+
+std::size_t base64DecodedSize(const Containers::ArrayView<const char> text) {
+    std::size_t size = text.size()/4*3;
+    if(text.size() >= 4 && text.size() % 4 == 0) {
+        if(text[text.size() - 1] == '=') {
+            --size;
+            if(text[text.size() - 2] == '=') --size;
+        }
+    }
+    return size;
+}
+
+void base64Encode(const Containers::ArrayView<const void> data, const Containers::ArrayView<char> out) {
+    CORRADE_ASSERT(out.size() == base64EncodedSize(data.size()),
+        "Utility::Encoding::base64Encode(): expected output size" << base64EncodedSize(data.size()) << "but got" << out.size(), );
+
+    static const Base64EncodeFunction function = pickBase64Encode();
+    const std::uint8_t* const in = static_cast<const std::uint8_t*>(data.data());
+    std::size_t i = function(in, data.size(), out);
+    std::size_t o = i/3*4;
+    for(; data.size() - i >= 3; i += 3, o += 4) {
+        const std::uint32_t triplet = in[i] << 16 | in[i + 1] << 8 | in[i + 2];
+        out[o] = Base64Characters[triplet >> 18];
+        out[o + 1] = Base64Characters[(triplet >> 12) & 0x3f];
+        out[o + 2] = Base64Characters[(triplet >> 6) & 0x3f];
+        out[o + 3] = Base64Characters[triplet & 0x3f];
+    }
+
+    /* Remaining one or two bytes, padded */
+    if(i != data.size()) {
+        const std::uint32_t triplet = in[i] << 16 | (data.size() - i == 2 ? in[i + 1] << 8 : 0);
+        out[o] = Base64Characters[triplet >> 18];
+        out[o + 1] = Base64Characters[(triplet >> 12) & 0x3f];
+        out[o + 2] = data.size() - i == 2 ? Base64Characters[(triplet >> 6) & 0x3f] : '=';
+        out[o + 3] = '=';
+    }
+}
+
+bool base64Decode(const Containers::ArrayView<const char> text, const Containers::ArrayView<void> out) {
+    /* Checked before the output size as the decoded size is meaningless for
+       such input */
+    if(text.size() % 4) return false;
+
+    CORRADE_ASSERT(out.size() == base64DecodedSize(text),
+        "Utility::Encoding::base64Decode(): expected output size" << base64DecodedSize(text) << "but got" << out.size(), {});
+
+    static const Base64DecodeFunction function = pickBase64Decode();
+    std::uint8_t* const o = static_cast<std::uint8_t*>(out.data());
+    std::size_t i = function(text, text.size(), o);
+    if(i == ~std::size_t{}) return false;
+
+    for(; i != text.size(); i += 4) {
+        const std::uint8_t a = base64Value(text[i]);
+        const std::uint8_t b = base64Value(text[i + 1]);
+        std::uint8_t c, d;
+
+        /* Padding is allowed only in the last quad, and if the third
+           character is padding, the fourth has to be as well */
+        std::size_t count = 3;
+        if(i + 4 == text.size() && text[i + 3] == '=') {
+            d = 0;
+            if(text[i + 2] == '=') {
+                c = 0;
+                count = 1;
+            } else {
+                c = base64Value(text[i + 2]);
+                count = 2;
+            }
+        } else {
+            c = base64Value(text[i + 2]);
+            d = base64Value(text[i + 3]);
+        }
+
+        if((a|b|c|d) & 0x80) return false;
+
+        const std::uint32_t triplet = a << 18 | b << 12 | c << 6 | d;
+        /* Bits that don't make it to the output have to be zero for the
+           encoding to be canonical */
+        if(count == 1 && (triplet & 0xffff)) return false;
+        if(count == 2 && (triplet & 0xff)) return false;
+
+        const std::size_t oi = i/4*3;
+        o[oi] = triplet >> 16;
+        if(count > 1) o[oi + 1] = triplet >> 8;
+        if(count > 2) o[oi + 2] = triplet;
+    }
+
+    return true;
+}
+
+}}}
@@ -0,0 +1,137 @@
+#ifndef Corrade_Utility_Encoding_h
+#define Corrade_Utility_Encoding_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Namespace @ref Corrade::Utility::Encoding
+ * @m_since_latest
+ */
+
+#include <cstddef>
+
+#include "Corrade/Containers/ArrayView.h"
+#include "Corrade/Utility/visibility.h"
+
+namespace Corrade { namespace Utility {
+
+/**
+@brief Hexadecimal and Base64 encoding
+@m_since_latest
+
+Encoding and decoding of binary data to and from hexadecimal and
+[Base64](https://tools.ietf.org/html/rfc4648#section-4) text. All functions
+operate on preallocated views and don't allocate, the output size can be
+queried upfront. On x86 the data are processed in 16-byte blocks using SSSE3
+if @ref Cpu::runtimeFeatures() reports it, a portable implementation is used
+otherwise.
+
+@snippet Utility.cpp Encoding-usage
+
+This library is built if `WITH_UTILITY` is enabled when building Corrade. To
+use this library with CMake, request the `Utility` component of the `Corrade`
+package and link to the `Corrade::Utility` target.
+
+@code{.cmake}
+find_package(Corrade REQUIRED Utility)
+
+# ...
+target_link_libraries(your-app PRIVATE Corrade::Utility)
+@endcode
+
+See also @ref building-corrade and @ref corrade-cmake for more information.
+*/
+namespace Encoding {
+
+/**
+@brief Encode data as hexadecimal text
+@m_since_latest
+
+Writes two lowercase hexadecimal characters for each byte of @p data,
+high nibble first. Expects that @p out is exactly twice the size of
+@p data. No null terminator is written.
+*/
+CORRADE_UTILITY_EXPORT void hexEncode(Containers::ArrayView<const void> data, Containers::ArrayView<char> out);
+
+/**
+@brief Decode hexadecimal text
+@m_since_latest
+
+Accepts both lowercase and uppercase characters. Expects that @p text is
+exactly twice the size of @p out. If @p text contains characters other than
+`0-9`, `a-f` and `A-F`, returns @cpp false @ce and contents of @p out are
+unspecified, otherwise returns @cpp true @ce.
+*/
+CORRADE_UTILITY_EXPORT bool hexDecode(Containers::ArrayView<const char> text, Containers::ArrayView<void> out);
+
+/**
+@brief Size of Base64-encoded data
+@m_since_latest
+
+Four characters for every started triplet of bytes, including the padding.
+*/
+constexpr std::size_t base64EncodedSize(std::size_t size) {
+    return (size + 2)/3*4;
+}
+
+/**
+@brief Size of Base64-decoded data
+@m_since_latest
+
+Calculated from size of @p text and the count of trailing `=` padding
+characters. If size of @p text isn't divisible by four, the text isn't valid
+Base64 and the returned value is meaningless.
+*/
+CORRADE_UTILITY_EXPORT std::size_t base64DecodedSize(Containers::ArrayView<const char> text);
+
+/**
+@brief Encode data as Base64 text
+@m_since_latest
+
+Uses the standard alphabet with `+` and `/` and pads the output with `=` to
+a multiple of four characters. Expects that size of @p out is
+@ref base64EncodedSize() of @p data size. No null terminator is written.
+*/
+CORRADE_UTILITY_EXPORT void base64Encode(Containers::ArrayView<const void> data, Containers::ArrayView<char> out);
+
+/**
+@brief Decode Base64 text
+@m_since_latest
+
+Returns @cpp false @ce if size of @p text isn't divisible by four, otherwise
+expects that size of @p out is @ref base64DecodedSize() of @p text. Returns
+@cpp false @ce also if @p text contains
+characters outside of the standard alphabet, padding anywhere else than in
+the last two characters or non-zero bits in the padded part, in which case
+contents of @p out are unspecified. Returns @cpp true @ce otherwise.
+Whitespace isn't skipped.
+*/
+CORRADE_UTILITY_EXPORT bool base64Decode(Containers::ArrayView<const char> text, Containers::ArrayView<void> out);
+
+}
+
+}}
+
+#endif
@@ -30,16 +30,66 @@
  * @m_since_latest
  */
 
+#include <cstring>
+
 #include "Corrade/Containers/StridedArrayView.h"
+#include "Corrade/Utility/Assert.h"
 #include "Corrade/Utility/Endianness.h"
 
 namespace Corrade { namespace Utility { namespace Endianness {
 
 namespace Implementation {
     template<class T> inline void swapInPlace(const Containers::StridedArrayView1D<T>& values) {
-        /** @todo maybe we could speed this up via some SIMD? also, what about
-            alignment? */
-        for(T& value: values) value = Implementation::swap(value);
+        /** @todo what about alignment? */
+        const std::size_t size = values.size();
+        const std::ptrdiff_t stride = values.stride();
+
+        /* For contiguous data operate on a plain pointer. There's no loop
+           dependency and swap() is recognized as a byte swap, so e.g. GCC
+           vectorizes this into pshufb / vpshufb when targeting SSSE3 / AVX2
+           and into shifts and masks for 16-bit types with plain SSE2. The
+           loop over a strided iterator doesn't get vectorized at all. */
+        if(stride == std::ptrdiff_t(sizeof(T))) {
+            T* const data = static_cast<T*>(values.data());
+            for(std::size_t i = 0; i != size; ++i)
+                data[i] = Implementation::swap(data[i]);
+        } else {
+            auto* data = static_cast<char*>(values.data());
+            for(std::size_t i = 0; i != size; ++i, data += stride) {
+                T& value = *reinterpret_cast<T*>(data);
+                value = Implementation::swap(value);
+            }
+        }
+    }
+
+    template<class T> inline void swapInto(const Containers::StridedArrayView1D<const T>& src, const Containers::StridedArrayView1D<T>& dst) {
+        const std::size_t size = src.size();
+        const std::ptrdiff_t srcStride = src.stride();
+        const std::ptrdiff_t dstStride = dst.stride();
+
+        /* Same as in swapInPlace(), the contiguous case operates on plain
+           pointers so it gets vectorized. Restrict-qualifying the pointers
+           isn't needed, with distinct source and destination the compiler
+           emits a runtime overlap check before the vectorized loop. */
+        if(srcStride == std::ptrdiff_t(sizeof(T)) && dstStride == std::ptrdiff_t(sizeof(T))) {
+            const T* const srcData = static_cast<const T*>(src.data());
+            T* const dstData = static_cast<T*>(dst.data());
+            for(std::size_t i = 0; i != size; ++i)
+                dstData[i] = Implementation::swap(srcData[i]);
+        } else {
+            auto* srcData = static_cast<const char*>(src.data());
+            auto* dstData = static_cast<char*>(dst.data());
+            for(std::size_t i = 0; i != size; ++i, srcData += srcStride, dstData += dstStride)
+                *reinterpret_cast<T*>(dstData) = Implementation::swap(*reinterpret_cast<const T*>(srcData));
+        }
+    }
+
+    template<class T> inline void copyInto(const Containers::StridedArrayView1D<const T>& src, const Containers::StridedArrayView1D<T>& dst) {
+        const std::size_t size = src.size();
+        if(src.stride() == std::ptrdiff_t(sizeof(T)) && dst.stride() == std::ptrdiff_t(sizeof(T))) {
+            if(size) std::memcpy(dst.data(), src.data(), size*sizeof(T));
+        } else for(std::size_t i = 0; i != size; ++i)
+            dst[i] = src[i];
     }
 }
 
@@ -115,6 +165,91 @@ template<class T> void bigEndianInPlace(const Containers::ArrayView<T>& values)
     return bigEndianInPlace(Containers::stridedArrayView(values));
 }
 
+/**
+@brief Endian-swap bytes of each value into a destination view
+@m_since_latest
+
+Equivalent to calling @ref swap() on each value of @p src and writing the
+result to @p dst, but done in a single pass. Compared to copying the data and
+then calling @ref swapInPlace(const Containers::StridedArrayView1D<T>&) on the
+destination, the memory is accessed only once, which makes a difference for
+large memory-bound inputs. If both views are contiguous, the loop gets
+vectorized by the compiler similarly to the in-place variant. Expects that
+both views have the same size and that they don't overlap, unless they're the
+same view.
+@see @ref littleEndianInto(), @ref bigEndianInto()
+*/
+template<class T> void swapInto(const Containers::StridedArrayView1D<const T>& src, const Containers::StridedArrayView1D<T>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Utility::Endianness::swapInto(): expected source and destination size to be the same but got" << src.size() << "and" << dst.size(), );
+    typedef typename Implementation::TypeFor<sizeof(T)>::Type Type;
+    Implementation::swapInto(
+        Containers::arrayCast<const Type>(src),
+        Containers::arrayCast<Type>(dst));
+}
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+template<class T> void swapInto(const Containers::ArrayView<const T>& src, const Containers::ArrayView<T>& dst) {
+    return swapInto(Containers::stridedArrayView(src), Containers::stridedArrayView(dst));
+}
+
+/**
+@brief Convert values from or to Little-Endian into a destination view
+@m_since_latest
+
+On Big-Endian systems calls @ref swapInto(const Containers::StridedArrayView1D<const T>&, const Containers::StridedArrayView1D<T>&),
+on Little-Endian systems copies @p src to @p dst.
+@see @ref isBigEndian(), @ref CORRADE_TARGET_BIG_ENDIAN, @ref littleEndian(),
+    @ref bigEndianInto(const Containers::StridedArrayView1D<const T>&, const Containers::StridedArrayView1D<T>&)
+*/
+template<class T> void littleEndianInto(const Containers::StridedArrayView1D<const T>& src, const Containers::StridedArrayView1D<T>& dst) {
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    swapInto(src, dst);
+    #else
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Utility::Endianness::littleEndianInto(): expected source and destination size to be the same but got" << src.size() << "and" << dst.size(), );
+    Implementation::copyInto(src, dst);
+    #endif
+}
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+template<class T> void littleEndianInto(const Containers::ArrayView<const T>& src, const Containers::ArrayView<T>& dst) {
+    return littleEndianInto(Containers::stridedArrayView(src), Containers::stridedArrayView(dst));
+}
+
+/**
+@brief Convert values from or to Big-Endian into a destination view
+@m_since_latest
+
+On Little-Endian systems calls @ref swapInto(const Containers::StridedArrayView1D<const T>&, const Containers::StridedArrayView1D<T>&),
+on Big-Endian systems copies @p src to @p dst.
+@see @ref isBigEndian(), @ref CORRADE_TARGET_BIG_ENDIAN, @ref bigEndian(),
+    @ref littleEndianInto(const Containers::StridedArrayView1D<const T>&, const Containers::StridedArrayView1D<T>&)
+*/
+template<class T> void bigEndianInto(const Containers::StridedArrayView1D<const T>& src, const Containers::StridedArrayView1D<T>& dst) {
+    #ifndef CORRADE_TARGET_BIG_ENDIAN
+    swapInto(src, dst);
+    #else
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Utility::Endianness::bigEndianInto(): expected source and destination size to be the same but got" << src.size() << "and" << dst.size(), );
+    Implementation::copyInto(src, dst);
+    #endif
+}
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+template<class T> void bigEndianInto(const Containers::ArrayView<const T>& src, const Containers::ArrayView<T>& dst) {
+    return bigEndianInto(Containers::stridedArrayView(src), Containers::stridedArrayView(dst));
+}
+
 }}}
 
 #endif
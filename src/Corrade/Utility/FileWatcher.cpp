@@ -30,8 +30,12 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 
+#include "Corrade/Containers/Array.h"
 #include "Corrade/Containers/EnumSet.hpp"
 #include "Corrade/Utility/DebugStl.h"
+#include "Corrade/Utility/Directory.h"
+#include "Corrade/Utility/XxHash3.h"
+#include "Corrade/Utility/Implementation/fileWatcher.h"
 
 #if defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
 #include "Corrade/Utility/Unicode.h"
@@ -44,6 +48,7 @@ enum class FileWatcher::InternalFlag: std::uint8_t {
     /* Keep in sync with Flag */
     IgnoreErrors = std::uint8_t(FileWatcher::Flag::IgnoreErrors),
     IgnoreChangeIfEmpty = std::uint8_t(FileWatcher::Flag::IgnoreChangeIfEmpty),
+    CheckContents = std::uint8_t(FileWatcher::Flag::CheckContents),
 
     Valid = 1 << 7
 };
@@ -58,10 +63,16 @@ FileWatcher::FileWatcher(const std::string& filename, Flags flags):
     #error
     #endif
     _flags{InternalFlag(std::uint8_t(flags))|InternalFlag::Valid},
-    _time{~std::uint64_t{}}
+    _time{~std::uint64_t{}},
+    _hash{~std::uint64_t{}}
 {
-    /* Initialize the time value for the first time */
-    hasChanged();
+    /* Initialize the time value and the hash for the first time */
+    bool valid = true;
+    std::uint64_t size;
+    Implementation::fileWatcherCheck(_filename.data(), flags, _time, valid, size);
+    if(!valid) _flags &= ~InternalFlag::Valid;
+    else if((flags & Flag::CheckContents) && size != ~std::uint64_t{})
+        _hash = Implementation::fileWatcherHash(_filename.data(), size);
 }
 
 FileWatcher::FileWatcher(FileWatcher&&)
@@ -91,17 +102,19 @@ FileWatcher& FileWatcher::operator=(FileWatcher&&)
     #endif
     = default;
 
-bool FileWatcher::hasChanged() {
-    if(!(_flags & InternalFlag::Valid)) return false;
+namespace Implementation {
+
+bool fileWatcherCheck(const FileWatcherChar* const filename, const FileWatcher::Flags flags, std::uint64_t& time, bool& valid, std::uint64_t& size) {
+    size = ~std::uint64_t{};
 
     #if defined(CORRADE_TARGET_UNIX) || defined(CORRADE_TARGET_EMSCRIPTEN)
     /* GCC 4.8 complains about missing initializers if {} is used. The struct
        is initialized by stat() anyway so it's okay to keep it uninitialized */
     struct stat result;
-    if(stat(_filename.data(), &result) != 0)
+    if(stat(filename, &result) != 0)
     #elif defined(CORRADE_TARGET_WINDOWS)
     struct _stat result;
-    if(_wstat(_filename.data(), &result) != 0)
+    if(_wstat(filename, &result) != 0)
     #else
     #error
     #endif
@@ -109,22 +122,22 @@ bool FileWatcher::hasChanged() {
         Error err;
         err << "Utility::FileWatcher: can't stat"
             #if defined(CORRADE_TARGET_UNIX) || defined(CORRADE_TARGET_EMSCRIPTEN)
-            << _filename
+            << filename
             #elif defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
-            << Unicode::narrow(_filename)
+            << Unicode::narrow(filename)
             #else
             #error
             #endif
             << Debug::nospace << ":" << std::strerror(errno) << Debug::nospace;
 
         /* Ignore the error if we are told so (but still warn) */
-        if(_flags & InternalFlag::IgnoreErrors) {
+        if(flags & FileWatcher::Flag::IgnoreErrors) {
             err << ", ignoring";
             return false;
         }
 
         err << ", aborting watch";
-        _flags &= ~InternalFlag::Valid;
+        valid = false;
         return false;
     }
 
@@ -136,7 +149,7 @@ bool FileWatcher::hasChanged() {
        Emscripten defines st_mtime but sets tv_nsec to zero:
        https://github.com/kripken/emscripten/blob/52ff847187ee30fba48d611e64b5d10e2498fe0f/src/library_syscall.js#L66
        Windows doesn't have either, we get seconds there at best. */
-    const std::uint64_t time =
+    const std::uint64_t currentTime =
         #ifdef CORRADE_TARGET_APPLE
         std::uint64_t(result.st_mtimespec.tv_sec)*1000000000 + std::uint64_t(result.st_mtimespec.tv_nsec)
         #elif defined(st_mtime)
@@ -145,30 +158,74 @@ bool FileWatcher::hasChanged() {
         std::uint64_t(result.st_mtime)*1000000000
         #endif
         ;
+    size = result.st_size;
 
     /* Checking for the first time, report no change */
-    if(_time == ~std::uint64_t{}) {
-        _time = time;
+    if(time == ~std::uint64_t{}) {
+        time = currentTime;
         return false;
     }
 
     /* Modification time changed, update and report change -- unless the size
        is zero and we're told to ignore those */
-    if(_time != time
+    if(time != currentTime
         #ifndef CORRADE_TARGET_IOS
         /* iOS (or at least the simulator) reports all sizes to be always 0,
            which means this flag would make FileWatcher absolutely useless. So
            ignore it there. */
-        && (!(_flags & InternalFlag::IgnoreChangeIfEmpty) || result.st_size != 0)
+        && (!(flags & FileWatcher::Flag::IgnoreChangeIfEmpty) || result.st_size != 0)
         #endif
     ) {
-        _time = time;
+        time = currentTime;
         return true;
     }
 
     return false;
 }
 
+std::uint64_t fileWatcherHash(const FileWatcherChar* const filename, const std::uint64_t size) {
+    /* Mapping an empty file fails, so don't even try */
+    XxHash3<8> hash;
+    if(size) {
+        #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+        const Containers::Array<const char, Directory::MapDeleter> data = Directory::mapRead(
+            #ifdef CORRADE_TARGET_WINDOWS
+            Unicode::narrow(filename)
+            #else
+            filename
+            #endif
+            , Directory::MapFlag::Sequential);
+        #else
+        const Containers::Array<char> data = Directory::read(filename);
+        #endif
+        if(!data) return ~std::uint64_t{};
+        hash << Containers::ArrayView<const char>{data};
+    }
+
+    std::uint64_t out;
+    std::memcpy(&out, hash.digest().byteArray(), sizeof(out));
+    return out;
+}
+
+}
+
+bool FileWatcher::hasChanged() {
+    if(!(_flags & InternalFlag::Valid)) return false;
+
+    bool valid = true;
+    std::uint64_t size;
+    const bool changed = Implementation::fileWatcherCheck(_filename.data(), flags(), _time, valid, size);
+    if(!valid) _flags &= ~InternalFlag::Valid;
+    if(!changed || !(_flags & InternalFlag::CheckContents)) return changed;
+
+    /* The modification time changed, report a change only if the contents
+       did as well */
+    const std::uint64_t hash = Implementation::fileWatcherHash(_filename.data(), size);
+    if(hash == _hash) return false;
+    _hash = hash;
+    return true;
+}
+
 #ifndef DOXYGEN_GENERATING_OUTPUT
 Debug& operator<<(Debug& debug, FileWatcher::Flag value) {
     switch(value) {
@@ -176,6 +233,7 @@ Debug& operator<<(Debug& debug, FileWatcher::Flag value) {
         #define _c(value) case FileWatcher::Flag::value: return debug << "Utility::FileWatcher::Flag::" #value;
         _c(IgnoreErrors)
         _c(IgnoreChangeIfEmpty)
+        _c(CheckContents)
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -186,7 +244,8 @@ Debug& operator<<(Debug& debug, FileWatcher::Flag value) {
 Debug& operator<<(Debug& debug, FileWatcher::Flags value) {
     return Containers::enumSetDebugOutput(debug, value, "Utility::FileWatcher::Flags{}", {
         FileWatcher::Flag::IgnoreErrors,
-        FileWatcher::Flag::IgnoreChangeIfEmpty});
+        FileWatcher::Flag::IgnoreChangeIfEmpty,
+        FileWatcher::Flag::CheckContents});
 }
 #endif
 
@@ -61,6 +61,15 @@ Reacting to the update when the file is still empty might be counterproductive
 as well, enable @ref Flag::IgnoreChangeIfEmpty to detect and ignore this case
 as well.
 
+A modification time change doesn't necessarily mean the contents changed ---
+build systems, version control checkouts or editors saving an unmodified
+buffer update the timestamp as well. Enable @ref Flag::CheckContents to
+additionally compare a hash of the file contents when the modification time
+changes and report a change only if the contents differ. The file is
+memory-mapped and hashed using @ref XxHash3, so the check is cheap compared
+to parsing the file again, and it's done only if the modification time
+changed.
+
 Different OSes and filesystems have different granularity of filesystem
 modification time:
 
@@ -101,7 +110,17 @@ class CORRADE_UTILITY_EXPORT FileWatcher {
              *      absolutely useless with this flag. This flag is thus
              *      ignored there.
              */
-            IgnoreChangeIfEmpty = 1 << 1
+            IgnoreChangeIfEmpty = 1 << 1,
+
+            /**
+             * Don't signal a file change if its contents are byte-identical
+             * to the contents at the time of the previous change. Useful if
+             * the file is being touched without being modified, for example
+             * by a build system or a version control checkout. See
+             * @ref Utility-FileWatcher-behavior for more information.
+             * @m_since_latest
+             */
+            CheckContents = 1 << 2
         };
 
         /**
@@ -167,7 +186,9 @@ class CORRADE_UTILITY_EXPORT FileWatcher {
          * @brief Whether the file has changed
          *
          * Returns @cpp true @ce if the file modification time was updated
-         * since the previous call, @cpp false @ce otherwise.
+         * since the previous call, @cpp false @ce otherwise. If
+         * @ref Flag::CheckContents is set, returns @cpp false @ce also if
+         * the contents didn't change.
          */
         bool hasChanged();
 
@@ -185,6 +206,8 @@ class CORRADE_UTILITY_EXPORT FileWatcher {
         #endif
         InternalFlags _flags;
         std::uint64_t _time;
+        /* Used only with Flag::CheckContents */
+        std::uint64_t _hash;
 };
 
 CORRADE_ENUMSET_OPERATORS(FileWatcher::Flags)
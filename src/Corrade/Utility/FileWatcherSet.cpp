@@ -0,0 +1,343 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "FileWatcherSet.h"
+
+#include <chrono>
+#include <string>
+#include <unordered_map>
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Containers/GrowableArray.h"
+#include "Corrade/Utility/Assert.h"
+#include "Corrade/Utility/Directory.h"
+#include "Corrade/Utility/System.h"
+#include "Corrade/Utility/Implementation/fileWatcher.h"
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
+#include "Corrade/Utility/Unicode.h"
+#endif
+
+#if defined(__linux__) && (!defined(CORRADE_TARGET_ANDROID) || __ANDROID_API__ >= 21)
+#define CORRADE_FILEWATCHERSET_INOTIFY
+#include <cerrno>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace Corrade { namespace Utility {
+
+namespace {
+
+enum: std::uint8_t {
+    FileValid = 1 << 0,
+    /* Already in the list of files to check */
+    FilePending = 1 << 1,
+    /* Checked on every call */
+    FilePolled = 1 << 2
+};
+
+/* Interval in which files that can't use notifications are checked in
+   wait() */
+constexpr std::size_t PollInterval = 100;
+
+}
+
+struct FileWatcherSet::State {
+    FileWatcher::Flags flags;
+
+    /* Null-terminated filenames in the native encoding, one after another,
+       offsets[i] is where i-th filename starts */
+    std::basic_string<Implementation::FileWatcherChar> filenames;
+    Containers::Array<std::size_t> offsets;
+    Containers::Array<std::uint64_t> times;
+    Containers::Array<std::uint8_t> states;
+    /* Sizes from the last check and content hashes, used only with
+       FileWatcher::Flag::CheckContents */
+    Containers::Array<std::uint64_t> sizes;
+    Containers::Array<std::uint64_t> hashes;
+    ParallelExecutor executor{};
+    void* executorState{};
+
+    /* Files that are checked on every call, because they can't be watched */
+    Containers::Array<std::size_t> polled;
+
+    #ifdef CORRADE_FILEWATCHERSET_INOTIFY
+    int fd{-1};
+    /* Files that got a notification since the last check */
+    Containers::Array<std::size_t> pending;
+    /* Watch descriptor of a directory -> filenames in it and their IDs */
+    std::unordered_map<int, std::unordered_multimap<std::string, std::size_t>> directories;
+    #endif
+
+    /* Checks given file, appends it to out if it changed */
+    void check(std::size_t id, Containers::Array<std::size_t>& out);
+    /* Hashes contents of files in out and removes those that didn't change */
+    void checkContents(Containers::Array<std::size_t>& out);
+};
+
+void FileWatcherSet::State::check(const std::size_t id, Containers::Array<std::size_t>& out) {
+    if(!(states[id] & FileValid)) return;
+
+    bool valid = true;
+    if(Implementation::fileWatcherCheck(filenames.data() + offsets[id], flags, times[id], valid, sizes[id]))
+        arrayAppend(out, id);
+    if(!valid) states[id] &= ~FileValid;
+}
+
+void FileWatcherSet::State::checkContents(Containers::Array<std::size_t>& out) {
+    if(out.empty() || !(flags & FileWatcher::Flag::CheckContents)) return;
+
+    /* Hash everything first so the files can be processed in parallel, each
+       job writes just its own item */
+    struct Job {
+        const State& state;
+        const Containers::Array<std::size_t>& ids;
+        Containers::Array<std::uint64_t> hashes;
+    } job{*this, out, Containers::Array<std::uint64_t>{Containers::NoInit, out.size()}};
+    const auto hash = [](void* const state, const std::size_t i) {
+        Job& job = *static_cast<Job*>(state);
+        const std::size_t id = job.ids[i];
+        job.hashes[i] = Implementation::fileWatcherHash(job.state.filenames.data() + job.state.offsets[id], job.state.sizes[id]);
+    };
+    if(executor && out.size() > 1)
+        executor(executorState, out.size(), hash, &job);
+    else for(std::size_t i = 0; i != out.size(); ++i)
+        hash(&job, i);
+
+    /* Keep only files where the hash differs, in the original order */
+    std::size_t count = 0;
+    for(std::size_t i = 0; i != out.size(); ++i) {
+        const std::size_t id = out[i];
+        if(job.hashes[i] == hashes[id]) continue;
+        hashes[id] = job.hashes[i];
+        out[count++] = id;
+    }
+    arrayRemoveSuffix(out, out.size() - count);
+}
+
+FileWatcherSet::FileWatcherSet(const FileWatcher::Flags flags): _state{Containers::InPlaceInit} {
+    _state->flags = flags;
+
+    #ifdef CORRADE_FILEWATCHERSET_INOTIFY
+    /* If this fails (for example due to reaching the per-user instance
+       limit), all files get polled */
+    _state->fd = inotify_init1(IN_NONBLOCK|IN_CLOEXEC);
+    #endif
+}
+
+FileWatcherSet::FileWatcherSet(FileWatcherSet&&) noexcept = default;
+
+FileWatcherSet::~FileWatcherSet() {
+    #ifdef CORRADE_FILEWATCHERSET_INOTIFY
+    /* Moved-out instance */
+    if(_state && _state->fd != -1) close(_state->fd);
+    #endif
+}
+
+FileWatcherSet& FileWatcherSet::operator=(FileWatcherSet&&) noexcept = default;
+
+FileWatcher::Flags FileWatcherSet::flags() const { return _state->flags; }
+
+bool FileWatcherSet::isNotificationBased() const {
+    #ifdef CORRADE_FILEWATCHERSET_INOTIFY
+    return _state->fd != -1;
+    #else
+    return false;
+    #endif
+}
+
+void FileWatcherSet::setParallelExecutor(const ParallelExecutor executor, void* const executorState) {
+    _state->executor = executor;
+    _state->executorState = executorState;
+}
+
+std::size_t FileWatcherSet::size() const { return _state->offsets.size(); }
+
+std::size_t FileWatcherSet::add(const std::string& filename) {
+    State& state = *_state;
+    const std::size_t id = state.offsets.size();
+
+    arrayAppend(state.offsets, state.filenames.size());
+    #if defined(CORRADE_TARGET_UNIX) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    state.filenames += filename;
+    #elif defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
+    state.filenames += Unicode::widen(filename);
+    #else
+    #error
+    #endif
+    state.filenames += Implementation::FileWatcherChar{};
+    arrayAppend(state.times, ~std::uint64_t{});
+    arrayAppend(state.states, std::uint8_t{FileValid});
+    arrayAppend(state.sizes, ~std::uint64_t{});
+    arrayAppend(state.hashes, ~std::uint64_t{});
+
+    /* Initialize the time value and the hash for the first time */
+    Containers::Array<std::size_t> unused;
+    state.check(id, unused);
+    if((state.flags & FileWatcher::Flag::CheckContents) && state.sizes[id] != ~std::uint64_t{})
+        state.hashes[id] = Implementation::fileWatcherHash(state.filenames.data() + state.offsets[id], state.sizes[id]);
+
+    #ifdef CORRADE_FILEWATCHERSET_INOTIFY
+    /* Watching the directory instead of the file itself, as that makes it
+       possible to detect the file being replaced with a rename or deleted and
+       created again. If the directory is already watched, the same descriptor
+       is returned. */
+    if(state.fd != -1) {
+        const std::string path = Directory::path(filename);
+        const int wd = inotify_add_watch(state.fd, path.empty() ? "." : path.data(), IN_MODIFY|IN_ATTRIB|IN_CLOSE_WRITE|IN_CREATE|IN_DELETE|IN_MOVED_FROM|IN_MOVED_TO|IN_DELETE_SELF|IN_MOVE_SELF|IN_ONLYDIR);
+        if(wd != -1) {
+            state.directories[wd].emplace(Directory::filename(filename), id);
+            return id;
+        }
+    }
+    #endif
+
+    state.states[id] |= FilePolled;
+    arrayAppend(state.polled, id);
+    return id;
+}
+
+std::string FileWatcherSet::filename(const std::size_t id) const {
+    CORRADE_ASSERT(id < _state->offsets.size(),
+        "Utility::FileWatcherSet::filename(): index" << id << "out of range for" << _state->offsets.size() << "files", {});
+    #if defined(CORRADE_TARGET_UNIX) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    return _state->filenames.data() + _state->offsets[id];
+    #elif defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
+    return Unicode::narrow(_state->filenames.data() + _state->offsets[id]);
+    #else
+    #error
+    #endif
+}
+
+bool FileWatcherSet::isValid(const std::size_t id) const {
+    CORRADE_ASSERT(id < _state->offsets.size(),
+        "Utility::FileWatcherSet::isValid(): index" << id << "out of range for" << _state->offsets.size() << "files", {});
+    return _state->states[id] & FileValid;
+}
+
+Containers::Array<std::size_t> FileWatcherSet::changed() {
+    State& state = *_state;
+
+    #ifdef CORRADE_FILEWATCHERSET_INOTIFY
+    if(state.fd != -1) {
+        const auto markPending = [&state](const std::size_t id) {
+            if(state.states[id] & FilePending) return;
+            state.states[id] |= FilePending;
+            arrayAppend(state.pending, id);
+        };
+
+        /* Drain all queued events. With nothing changed this is just a single
+           read() returning EAGAIN. */
+        alignas(inotify_event) char buffer[4096];
+        for(;;) {
+            const ssize_t size = read(state.fd, buffer, sizeof(buffer));
+            if(size < 0 && errno == EINTR) continue;
+            if(size <= 0) break;
+
+            for(const char* ptr = buffer; ptr < buffer + size; ) {
+                const inotify_event& event = *reinterpret_cast<const inotify_event*>(ptr);
+                ptr += sizeof(inotify_event) + event.len;
+
+                /* Events got lost, check everything */
+                if(event.mask & IN_Q_OVERFLOW) {
+                    for(std::size_t i = 0; i != state.states.size(); ++i)
+                        markPending(i);
+                    continue;
+                }
+
+                const auto found = state.directories.find(event.wd);
+                if(found == state.directories.end()) continue;
+
+                /* The directory itself went away, check all files in it. The
+                   watch is removed by the kernel, so the files have to be
+                   polled from now on. */
+                if(event.mask & (IN_DELETE_SELF|IN_MOVE_SELF|IN_IGNORED)) {
+                    for(const std::pair<const std::string, std::size_t>& file: found->second) {
+                        markPending(file.second);
+                        state.states[file.second] |= FilePolled;
+                        arrayAppend(state.polled, file.second);
+                    }
+                    state.directories.erase(found);
+                    continue;
+                }
+
+                if(!event.len) continue;
+                const auto files = found->second.equal_range(event.name);
+                for(auto it = files.first; it != files.second; ++it)
+                    markPending(it->second);
+            }
+        }
+    }
+    #endif
+
+    Containers::Array<std::size_t> out;
+    for(const std::size_t id: state.polled) state.check(id, out);
+
+    #ifdef CORRADE_FILEWATCHERSET_INOTIFY
+    for(const std::size_t id: state.pending) {
+        state.states[id] &= ~FilePending;
+        /* Polled files were checked above already */
+        if(!(state.states[id] & FilePolled)) state.check(id, out);
+    }
+    arrayResize(state.pending, 0);
+    #endif
+
+    state.checkContents(out);
+    return out;
+}
+
+Containers::Array<std::size_t> FileWatcherSet::wait(const std::size_t timeout) {
+    const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now() + std::chrono::milliseconds{timeout};
+
+    for(;;) {
+        Containers::Array<std::size_t> out = changed();
+        if(!out.empty()) return out;
+
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if(now >= end) return out;
+        std::size_t remaining = std::chrono::duration_cast<std::chrono::milliseconds>(end - now).count();
+        /* Round up so we don't spin for the last fraction of a millisecond */
+        if(!remaining) remaining = 1;
+
+        /* Files that have to be polled limit how long we can sleep */
+        if(!_state->polled.empty() && remaining > PollInterval)
+            remaining = PollInterval;
+
+        #ifdef CORRADE_FILEWATCHERSET_INOTIFY
+        if(_state->fd != -1) {
+            pollfd descriptor{_state->fd, POLLIN, 0};
+            poll(&descriptor, 1, int(remaining));
+            continue;
+        }
+        #endif
+
+        System::sleep(remaining);
+    }
+}
+
+}}
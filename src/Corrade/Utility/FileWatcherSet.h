@@ -0,0 +1,198 @@
+#ifndef Corrade_Utility_FileWatcherSet_h
+#define Corrade_Utility_FileWatcherSet_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Utility::FileWatcherSet
+ * @m_since_latest
+ */
+
+#include "Corrade/Containers/Pointer.h"
+#include "Corrade/Utility/FileWatcher.h"
+
+namespace Corrade { namespace Utility {
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+/* Documented in Algorithms.h, repeated here to avoid including the whole
+   StridedArrayView machinery */
+typedef void(*ParallelExecutor)(void*, std::size_t, void(*)(void*, std::size_t), void*);
+#endif
+
+#if defined(DOXYGEN_GENERATING_OUTPUT) || defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)) || defined(CORRADE_TARGET_EMSCRIPTEN)
+/**
+@brief Set of file watchers
+@m_since_latest
+
+Watches many files for changes at once. Compared to having a @ref FileWatcher
+for each file, which has to query the file status on every
+@ref FileWatcher::hasChanged() call, this uses a single system notification
+handle wherever possible, so a poll with nothing changed costs just a single
+non-blocking read. The
+filenames, modification times and states of all files are stored in a compact
+structure-of-arrays layout. Example usage:
+
+@snippet Utility.cpp FileWatcherSet
+
+@section Utility-FileWatcherSet-behavior Behavior
+
+The notifications are used only to pick files that might have changed, the
+modification time is then checked the same way as in @ref FileWatcher, so the
+@ref FileWatcher::Flag values and the behavior described in
+@ref Utility-FileWatcher-behavior apply here as well.
+
+With @ref FileWatcher::Flag::CheckContents, files whose modification time
+changed are hashed all at once at the end of @ref changed(). If many files
+are touched at once, for example by a version control checkout, the hashing
+can be spread across threads by passing a @ref ParallelExecutor to
+@ref setParallelExecutor(), such as @ref ThreadPool::execute():
+
+@snippet Utility.cpp FileWatcherSet-parallel
+
+On Linux, the directories containing the watched files are registered with a
+single @m_class{m-doc-external} [inotify](https://man.archlinux.org/man/inotify.7)
+instance, so replacing a file by renaming another over it is detected as
+well. If the notification queue overflows, all files get checked on the next
+call to @ref changed(). Files whose directory can't be watched, for example
+because the per-user watch limit is reached, are checked on every
+@ref changed() call like with @ref FileWatcher. Other platforms currently
+check all files on every call.
+
+@partialsupport Available only on @ref CORRADE_TARGET_UNIX "Unix" and non-RT
+    @ref CORRADE_TARGET_WINDOWS "Windows" platforms and on
+    @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten". The notification-based
+    implementation is used only on Linux.
+*/
+class CORRADE_UTILITY_EXPORT FileWatcherSet {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * The @p flags are used for all files added with @ref add().
+         */
+        explicit FileWatcherSet(FileWatcher::Flags flags = {});
+
+        /** @brief Copying is not allowed */
+        FileWatcherSet(const FileWatcherSet&) = delete;
+
+        /** @brief Move constructor */
+        FileWatcherSet(FileWatcherSet&&) noexcept;
+
+        ~FileWatcherSet();
+
+        /** @brief Copying is not allowed */
+        FileWatcherSet& operator=(const FileWatcherSet&) = delete;
+
+        /** @brief Move assignment */
+        FileWatcherSet& operator=(FileWatcherSet&&) noexcept;
+
+        /** @brief Watch behavior flags */
+        FileWatcher::Flags flags() const;
+
+        /**
+         * @brief Whether system notifications are used
+         *
+         * If @cpp false @ce, all files are checked on every @ref changed()
+         * call.
+         */
+        bool isNotificationBased() const;
+
+        /**
+         * @brief Set a parallel executor for hashing file contents
+         * @m_since_latest
+         *
+         * Used only if @ref FileWatcher::Flag::CheckContents is set, in
+         * which case the contents of files whose modification time changed
+         * are hashed in parallel using @p executor, passing
+         * @p executorState through. See @ref ParallelExecutor for more
+         * information. If @p executor is @cpp nullptr @ce, which is the
+         * default, the files are hashed on the calling thread.
+         */
+        void setParallelExecutor(ParallelExecutor executor, void* executorState);
+
+        /** @brief Count of watched files */
+        std::size_t size() const;
+
+        /**
+         * @brief Add a file to the watch
+         *
+         * Returns an ID of the file, which is the count of files added before.
+         * Expects that the filename is in UTF-8.
+         */
+        std::size_t add(const std::string& filename);
+
+        /**
+         * @brief Filename of given file
+         *
+         * Expects that @p id is less than @ref size().
+         */
+        std::string filename(std::size_t id) const;
+
+        /**
+         * @brief Whether the watch on given file is valid
+         *
+         * Expects that @p id is less than @ref size().
+         * @see @ref FileWatcher::isValid()
+         */
+        bool isValid(std::size_t id) const;
+
+        /**
+         * @brief Files that changed
+         *
+         * Returns IDs of files whose modification time was updated since the
+         * previous call, in no particular order. If
+         * @ref FileWatcher::Flag::CheckContents is set, files with contents
+         * identical to the previous change are not included. Doesn't
+         * allocate if nothing changed.
+         * @see @ref FileWatcher::hasChanged()
+         */
+        Containers::Array<std::size_t> changed();
+
+        /**
+         * @brief Wait for files to change
+         *
+         * Like @ref changed(), but if nothing changed, blocks until a change
+         * happens or @p timeout milliseconds pass. If notifications are
+         * available, the thread sleeps until the next notification arrives.
+         * Files that have to be polled are checked every 100 milliseconds.
+         * Returns an empty array on timeout.
+         *
+         * This can be used to wait for changes on a dedicated thread. Note
+         * that the class itself is not thread-safe, so no other function
+         * should be called on the instance while waiting.
+         */
+        Containers::Array<std::size_t> wait(std::size_t timeout);
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+#else
+#error this header is available only on Unix, non-RT Windows and Emscripten
+#endif
+
+}}
+
+#endif
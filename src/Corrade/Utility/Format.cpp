@@ -26,9 +26,14 @@
 #include "Format.h"
 #include "FormatStl.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <cstring>
+#include <limits>
 
-#include "Corrade/Containers/ArrayView.h"
+#include "Corrade/Containers/GrowableArray.h"
+#include "Corrade/Containers/StridedArrayView.h"
 #include "Corrade/Utility/Assert.h"
 #include "Corrade/Utility/DebugStl.h" /** @todo get rid of this */
 
@@ -116,46 +121,613 @@ template<> char formatTypeChar<float>(FormatType type) {
     CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
 }
 
+namespace {
+
+/* Integer formatting. Digits are produced from the end of a temporary buffer,
+   two decimal digits at a time. */
+constexpr const char DigitPairs[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+constexpr const char HexadecimalDigits[] = "0123456789abcdef";
+constexpr const char HexadecimalDigitsUppercase[] = "0123456789ABCDEF";
+
+/* Enough for 64-bit octal, leaving space for a sign */
+enum: std::size_t { IntegerDigitsCapacity = 24 };
+
+std::size_t writeDecimal(char* const end, unsigned long long value) {
+    char* i = end;
+    while(value >= 100) {
+        const std::size_t pair = std::size_t(value % 100)*2;
+        value /= 100;
+        *--i = DigitPairs[pair + 1];
+        *--i = DigitPairs[pair];
+    }
+    if(value >= 10) {
+        *--i = DigitPairs[value*2 + 1];
+        *--i = DigitPairs[value*2];
+    } else *--i = char('0' + value);
+    return end - i;
+}
+
+std::size_t writeBase(char* const end, unsigned long long value, const unsigned int shift, const char* const digits) {
+    const unsigned long long mask = (1ull << shift) - 1;
+    char* i = end;
+    do {
+        *--i = digits[value & mask];
+        value >>= shift;
+    } while(value);
+    return end - i;
+}
+
+/* Copies as much as fits, the caller asserts on the returned size */
+void writeClamped(const Containers::ArrayView<char>& buffer, std::size_t& offset, const char* const data, const std::size_t size) {
+    if(offset < buffer.size())
+        std::memcpy(buffer + offset, data, std::min(size, buffer.size() - offset));
+    offset += size;
+}
+
+void writeClamped(const Containers::ArrayView<char>& buffer, std::size_t& offset, const char c, const std::size_t count) {
+    if(offset < buffer.size())
+        std::memset(buffer + offset, c, std::min(count, buffer.size() - offset));
+    offset += count;
+}
+
+/* Equivalent to printf() with %.*i, %.*u, %.*o, %.*x and %.*X, without the
+   null terminator and the locale handling. The type character is what
+   formatTypeChar() returns. */
+std::size_t formatInteger(const Containers::ArrayView<char>& buffer, const unsigned long long magnitude, const bool negative, const int precision, const char type) {
+    char digits[IntegerDigitsCapacity];
+    char* const end = digits + IntegerDigitsCapacity;
+    std::size_t count;
+    if(!magnitude && !precision) count = 0;
+    else if(type == 'o') count = writeBase(end, magnitude, 3, HexadecimalDigits);
+    else if(type == 'x') count = writeBase(end, magnitude, 4, HexadecimalDigits);
+    else if(type == 'X') count = writeBase(end, magnitude, 4, HexadecimalDigitsUppercase);
+    else count = writeDecimal(end, magnitude);
+
+    const std::size_t padding = std::size_t(precision) > count ? precision - count : 0;
+    if(!buffer) return negative + padding + count;
+
+    std::size_t offset = 0;
+    if(negative) writeClamped(buffer, offset, '-', 1);
+    writeClamped(buffer, offset, '0', padding);
+    writeClamped(buffer, offset, end - count, count);
+    return offset;
+}
+
+/* Small enough to fit on stack when writing to a file, larger precision
+   falls back to fprintf() */
+enum: std::size_t { FileBufferSize = 128 };
+
+void formatIntegerToFile(std::FILE* const file, const unsigned long long magnitude, const bool negative, const int precision, const char type) {
+    char buffer[FileBufferSize];
+    std::fwrite(buffer, formatInteger(buffer, magnitude, negative, precision, type), 1, file);
+}
+
+/* A floating-point value formatted as decimal digits with no trailing zeros
+   and an exponent of the first digit, i.e. 0.0123 is {"123", 3, -2}. The
+   digits are at most `error` units of the last digit away from the actual
+   value, which is used to decide whether they can be rounded further
+   without going through printf(). */
+struct Digits {
+    char data[20];
+    int count;
+    int exponent;
+    double error;
+};
+
+/* Shortest round-trip digits using the Grisu2 algorithm by Florian Loitsch,
+   "Printing Floating-Point Numbers Quickly and Accurately with Integers",
+   2010. The digits are not always the shortest possible, but always
+   uniquely identify the value. */
+struct DiyFp {
+    std::uint64_t f;
+    int e;
+};
+
+DiyFp diyFpSub(const DiyFp a, const DiyFp b) {
+    return {a.f - b.f, a.e};
+}
+
+/* Upper 64 bits of the 128-bit product, rounded */
+DiyFp diyFpMul(const DiyFp a, const DiyFp b) {
+    const std::uint64_t aLo = a.f & 0xffffffffu;
+    const std::uint64_t aHi = a.f >> 32;
+    const std::uint64_t bLo = b.f & 0xffffffffu;
+    const std::uint64_t bHi = b.f >> 32;
+    const std::uint64_t p0 = aLo*bLo;
+    const std::uint64_t p1 = aLo*bHi;
+    const std::uint64_t p2 = aHi*bLo;
+    const std::uint64_t p3 = aHi*bHi;
+    const std::uint64_t q = (p0 >> 32) + (p1 & 0xffffffffu) + (p2 & 0xffffffffu) + (1ull << 31);
+    return {p3 + (p1 >> 32) + (p2 >> 32) + (q >> 32), a.e + b.e + 64};
+}
+
+DiyFp diyFpNormalize(DiyFp a) {
+    #ifdef __GNUC__
+    const int shift = __builtin_clzll(a.f);
+    a.f <<= shift;
+    a.e -= shift;
+    #else
+    while(!(a.f >> 63)) {
+        a.f <<= 1;
+        --a.e;
+    }
+    #endif
+    return a;
+}
+
+/* Normalized powers of ten from 10^-300 to 10^324 in steps of 8, as
+   {significand, binary exponent, decimal exponent} */
+struct CachedPower {
+    std::uint64_t f;
+    int e;
+    int k;
+};
+
+constexpr CachedPower CachedPowers[]{
+    {0xAB70FE17C79AC6CA, -1060, -300},
+    {0xFF77B1FCBEBCDC4F, -1034, -292},
+    {0xBE5691EF416BD60C, -1007, -284},
+    {0x8DD01FAD907FFC3C,  -980, -276},
+    {0xD3515C2831559A83,  -954, -268},
+    {0x9D71AC8FADA6C9B5,  -927, -260},
+    {0xEA9C227723EE8BCB,  -901, -252},
+    {0xAECC49914078536D,  -874, -244},
+    {0x823C12795DB6CE57,  -847, -236},
+    {0xC21094364DFB5637,  -821, -228},
+    {0x9096EA6F3848984F,  -794, -220},
+    {0xD77485CB25823AC7,  -768, -212},
+    {0xA086CFCD97BF97F4,  -741, -204},
+    {0xEF340A98172AACE5,  -715, -196},
+    {0xB23867FB2A35B28E,  -688, -188},
+    {0x84C8D4DFD2C63F3B,  -661, -180},
+    {0xC5DD44271AD3CDBA,  -635, -172},
+    {0x936B9FCEBB25C996,  -608, -164},
+    {0xDBAC6C247D62A584,  -582, -156},
+    {0xA3AB66580D5FDAF6,  -555, -148},
+    {0xF3E2F893DEC3F126,  -529, -140},
+    {0xB5B5ADA8AAFF80B8,  -502, -132},
+    {0x87625F056C7C4A8B,  -475, -124},
+    {0xC9BCFF6034C13053,  -449, -116},
+    {0x964E858C91BA2655,  -422, -108},
+    {0xDFF9772470297EBD,  -396, -100},
+    {0xA6DFBD9FB8E5B88F,  -369,  -92},
+    {0xF8A95FCF88747D94,  -343,  -84},
+    {0xB94470938FA89BCF,  -316,  -76},
+    {0x8A08F0F8BF0F156B,  -289,  -68},
+    {0xCDB02555653131B6,  -263,  -60},
+    {0x993FE2C6D07B7FAC,  -236,  -52},
+    {0xE45C10C42A2B3B06,  -210,  -44},
+    {0xAA242499697392D3,  -183,  -36},
+    {0xFD87B5F28300CA0E,  -157,  -28},
+    {0xBCE5086492111AEB,  -130,  -20},
+    {0x8CBCCC096F5088CC,  -103,  -12},
+    {0xD1B71758E219652C,   -77,   -4},
+    {0x9C40000000000000,   -50,    4},
+    {0xE8D4A51000000000,   -24,   12},
+    {0xAD78EBC5AC620000,     3,   20},
+    {0x813F3978F8940984,    30,   28},
+    {0xC097CE7BC90715B3,    56,   36},
+    {0x8F7E32CE7BEA5C70,    83,   44},
+    {0xD5D238A4ABE98068,   109,   52},
+    {0x9F4F2726179A2245,   136,   60},
+    {0xED63A231D4C4FB27,   162,   68},
+    {0xB0DE65388CC8ADA8,   189,   76},
+    {0x83C7088E1AAB65DB,   216,   84},
+    {0xC45D1DF942711D9A,   242,   92},
+    {0x924D692CA61BE758,   269,  100},
+    {0xDA01EE641A708DEA,   295,  108},
+    {0xA26DA3999AEF774A,   322,  116},
+    {0xF209787BB47D6B85,   348,  124},
+    {0xB454E4A179DD1877,   375,  132},
+    {0x865B86925B9BC5C2,   402,  140},
+    {0xC83553C5C8965D3D,   428,  148},
+    {0x952AB45CFA97A0B3,   455,  156},
+    {0xDE469FBD99A05FE3,   481,  164},
+    {0xA59BC234DB398C25,   508,  172},
+    {0xF6C69A72A3989F5C,   534,  180},
+    {0xB7DCBF5354E9BECE,   561,  188},
+    {0x88FCF317F22241E2,   588,  196},
+    {0xCC20CE9BD35C78A5,   614,  204},
+    {0x98165AF37B2153DF,   641,  212},
+    {0xE2A0B5DC971F303A,   667,  220},
+    {0xA8D9D1535CE3B396,   694,  228},
+    {0xFB9B7CD9A4A7443C,   720,  236},
+    {0xBB764C4CA7A44410,   747,  244},
+    {0x8BAB8EEFB6409C1A,   774,  252},
+    {0xD01FEF10A657842C,   800,  260},
+    {0x9B10A4E5E9913129,   827,  268},
+    {0xE7109BFBA19C0C9D,   853,  276},
+    {0xAC2820D9623BF429,   880,  284},
+    {0x80444B5E7AA7CF85,   907,  292},
+    {0xBF21E44003ACDD2D,   933,  300},
+    {0x8E679C2F5E44FF8F,   960,  308},
+    {0xD433179D9C8CB841,   986,  316},
+    {0x9E19DB92B4E31BA9,  1013,  324}
+};
+
+/* Range of binary exponents the scaled value should have so the integral
+   part fits into 32 bits */
+enum: int { GrisuAlpha = -60, GrisuGamma = -32 };
+
+CachedPower cachedPowerForBinaryExponent(const int e) {
+    /* ceil((alpha - e - 1)*log10(2)), 78913/2^18 approximates log10(2) */
+    const int f = GrisuAlpha - e - 1;
+    const int k = (f*78913)/(1 << 18) + (f > 0);
+    const CachedPower cached = CachedPowers[(300 + k + 7)/8];
+    CORRADE_INTERNAL_ASSERT(cached.e + e + 64 >= GrisuAlpha && cached.e + e + 64 <= GrisuGamma);
+    return cached;
+}
+
+/* Returns distance of the digits from the actual value in units of the last
+   digit. The scaled value and upper boundary can be off by one unit each
+   because of the cached power approximation, the units being multiplied by
+   `scale` during digit generation. */
+double grisuRound(char* const digits, const int count, const std::uint64_t distance, const std::uint64_t delta, std::uint64_t rest, const std::uint64_t tenKappa, const double scale) {
+    /* Move the last digit closer to the actual value while staying inside
+       the rounding interval */
+    while(rest < distance && delta - rest >= tenKappa && (rest + tenKappa < distance || distance - rest > rest + tenKappa - distance)) {
+        --digits[count - 1];
+        rest += tenKappa;
+    }
+    return (double(rest < distance ? distance - rest : rest - distance) + 2.0*scale)/double(tenKappa);
+}
+
+void grisuDigits(Digits& out, int& decimalExponent, const DiyFp minus, const DiyFp w, const DiyFp plus) {
+    std::uint64_t delta = diyFpSub(plus, minus).f;
+    std::uint64_t distance = diyFpSub(plus, w).f;
+    const DiyFp one{1ull << -plus.e, plus.e};
+
+    std::uint32_t integral = std::uint32_t(plus.f >> -one.e);
+    std::uint64_t fractional = plus.f & (one.f - 1);
+
+    /* Largest power of ten not larger than the integral part */
+    std::uint32_t power = 1;
+    int n = 1;
+    while(n < 10 && integral >= power*10) {
+        power *= 10;
+        ++n;
+    }
+
+    out.count = 0;
+    while(n > 0) {
+        out.data[out.count++] = char('0' + integral/power);
+        integral %= power;
+        --n;
+
+        const std::uint64_t rest = (std::uint64_t(integral) << -one.e) + fractional;
+        if(rest <= delta) {
+            decimalExponent += n;
+            out.error = grisuRound(out.data, out.count, distance, delta, rest, std::uint64_t(power) << -one.e, 1.0);
+            return;
+        }
+
+        power /= 10;
+    }
+
+    int m = 0;
+    double scale = 1.0;
+    for(;;) {
+        fractional *= 10;
+        out.data[out.count++] = char('0' + (fractional >> -one.e));
+        fractional &= one.f - 1;
+        ++m;
+        delta *= 10;
+        distance *= 10;
+        scale *= 10.0;
+        if(fractional <= delta) break;
+    }
+
+    decimalExponent -= m;
+    out.error = grisuRound(out.data, out.count, distance, delta, fractional, one.f, scale);
+}
+
+template<class T> struct FloatTraits;
+template<> struct FloatTraits<float> {
+    typedef std::uint32_t Bits;
+};
+template<> struct FloatTraits<double> {
+    typedef std::uint64_t Bits;
+};
+
+/* Expects a finite positive value */
+template<class T> Digits shortestDigits(const T value) {
+    enum: int {
+        Precision = std::numeric_limits<T>::digits,
+        Bias = std::numeric_limits<T>::max_exponent - 1 + (Precision - 1),
+        MinExponent = 1 - Bias
+    };
+    constexpr std::uint64_t HiddenBit = 1ull << (Precision - 1);
+
+    typename FloatTraits<T>::Bits bits;
+    std::memcpy(&bits, &value, sizeof(T));
+    const std::uint64_t significand = bits & (HiddenBit - 1);
+    const int exponent = int(bits >> (Precision - 1));
+
+    /* The value and its rounding interval boundaries */
+    const DiyFp v = exponent == 0 ?
+        DiyFp{significand, MinExponent} :
+        DiyFp{significand + HiddenBit, exponent - Bias};
+    const bool lowerBoundaryCloser = significand == 0 && exponent > 1;
+    const DiyFp plus = diyFpNormalize({2*v.f + 1, v.e - 1});
+    DiyFp minus = lowerBoundaryCloser ?
+        DiyFp{4*v.f - 1, v.e - 2} : DiyFp{2*v.f - 1, v.e - 1};
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+
+    /* Scale everything by a cached power of ten so the digits can be
+       generated with integer arithmetic */
+    const CachedPower cached = cachedPowerForBinaryExponent(plus.e);
+    const DiyFp c{cached.f, cached.e};
+    const DiyFp w = diyFpMul(diyFpNormalize(v), c);
+    const DiyFp wMinus = diyFpMul(minus, c);
+    const DiyFp wPlus = diyFpMul(plus, c);
+
+    Digits out;
+    int decimalExponent = -cached.k;
+    grisuDigits(out, decimalExponent, {wMinus.f + 1, wMinus.e}, w, {wPlus.f - 1, wPlus.e});
+
+    /* Strip trailing zeros, the exponent is of the first digit */
+    while(out.count > 1 && out.data[out.count - 1] == '0') {
+        --out.count;
+        ++decimalExponent;
+        out.error *= 0.1;
+    }
+    out.exponent = decimalExponent + out.count - 1;
+    return out;
+}
+
+/* Exactly representable powers of ten */
+constexpr const double PowersOfTen[]{
+    1.0e0, 1.0e1, 1.0e2, 1.0e3, 1.0e4, 1.0e5, 1.0e6, 1.0e7, 1.0e8, 1.0e9,
+    1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15, 1.0e16, 1.0e17, 1.0e18,
+    1.0e19, 1.0e20, 1.0e21, 1.0e22
+};
+
+/* Rounds the digits to given count. Returns false if the digits are too
+   close to a rounding boundary to know how the exact value would round, as
+   the digits are only guaranteed to be within the rounding interval. */
+bool roundDigits(Digits& digits, const int count) {
+    /* Distance of the digits from the actual value, in units of the last
+       digit, with a 2x safety margin */
+    const double margin = digits.error*2.0 + 1.0;
+    if(!(margin < 1.0e15)) return false;
+
+    /* The dropped digits as an integer and the unit they're a part of */
+    std::uint64_t tail = 0, unit = 1;
+    for(int i = count; i != digits.count; ++i) {
+        tail = tail*10 + (digits.data[i] - '0');
+        unit *= 10;
+    }
+    const double distanceToHalf = tail > unit/2 ? double(tail - unit/2) : double(unit/2 - tail);
+    if(double(tail) <= margin || double(unit - tail) <= margin || distanceToHalf <= margin)
+        return false;
+
+    digits.count = count;
+    if(tail > unit/2) {
+        int i = count - 1;
+        for(; i >= 0 && digits.data[i] == '9'; --i) digits.data[i] = '0';
+        if(i >= 0) ++digits.data[i];
+        else {
+            digits.data[0] = '1';
+            digits.count = 1;
+            ++digits.exponent;
+        }
+    }
+
+    /* Strip the zeros again */
+    while(digits.count > 1 && digits.data[digits.count - 1] == '0')
+        --digits.count;
+    return true;
+}
+
+std::size_t writeExponentStyle(char* const out, const Digits& digits, const int decimals, const bool strip, const bool uppercase) {
+    char* i = out;
+    *i++ = digits.data[0];
+    const int written = strip ? std::min(decimals, digits.count - 1) : decimals;
+    if(written) {
+        *i++ = '.';
+        for(int j = 1; j <= written; ++j)
+            *i++ = j < digits.count ? digits.data[j] : '0';
+    }
+    *i++ = uppercase ? 'E' : 'e';
+    *i++ = digits.exponent < 0 ? '-' : '+';
+    const int exponent = digits.exponent < 0 ? -digits.exponent : digits.exponent;
+    /* The MinGW runtime prints at least three exponent digits, match that
+       to have the same output as printf() */
+    #ifndef __MINGW32__
+    if(exponent < 10) *i++ = '0';
+    #else
+    if(exponent < 100) *i++ = '0';
+    if(exponent < 10) *i++ = '0';
+    #endif
+    char exponentDigits[4];
+    const std::size_t exponentCount = writeDecimal(exponentDigits + 4, exponent);
+    std::memcpy(i, exponentDigits + 4 - exponentCount, exponentCount);
+    return i + exponentCount - out;
+}
+
+std::size_t writeFixedStyle(char* const out, const Digits& digits, const int decimals, const bool strip) {
+    char* i = out;
+    if(digits.exponent < 0) *i++ = '0';
+    else for(int j = 0; j <= digits.exponent; ++j)
+        *i++ = j < digits.count ? digits.data[j] : '0';
+
+    const int written = strip ? std::min(decimals, std::max(digits.count - 1 - digits.exponent, 0)) : decimals;
+    if(written) {
+        *i++ = '.';
+        for(int j = 1; j <= written; ++j) {
+            const int index = digits.exponent + j;
+            *i++ = index >= 0 && index < digits.count ? digits.data[index] : '0';
+        }
+    }
+    return i - out;
+}
+
+/* Big enough for all outputs that take the fast path */
+enum: std::size_t { FloatBufferSize = 64 };
+
+/* Equivalent to printf() with %.*g, %.*e and %.*f (and their uppercase
+   variants) for cases where the digits are known to be correctly rounded.
+   Returns 0 if the value needs to go through printf() instead. */
+template<class T> std::size_t formatFloatingPointFast(char* const out, const T value, int precision, const char type) {
+    if(!std::isfinite(value)) return 0;
+
+    Digits digits;
+    if(value == T(0)) {
+        digits.data[0] = '0';
+        digits.count = 1;
+        digits.exponent = 0;
+        digits.error = 0.0;
+    } else digits = shortestDigits(std::abs(value));
+
+    const char lowercaseType = type | 0x20;
+    int significant;
+    if(lowercaseType == 'g') {
+        if(!precision) precision = 1;
+        significant = precision;
+    } else if(lowercaseType == 'e') significant = precision + 1;
+    else significant = precision + digits.exponent + 1;
+
+    /* If the digits fit, padding them with zeros gives the correctly
+       rounded value as long as the digits are closer to the actual value
+       than half a unit of the last requested digit (with a 2x safety
+       margin). The unit is taken one order lower, as the actual value may be
+       right below a power of ten the digits are equal to. Otherwise round
+       them. */
+    if(digits.count <= significant) {
+        const int extra = significant - digits.count + 1;
+        if(extra >= int(Containers::arraySize(PowersOfTen)) || !(digits.error*4.0*PowersOfTen[extra] < 1.0))
+            return 0;
+    } else if(significant <= 0 || !roundDigits(digits, significant))
+        return 0;
+
+    /* Same rules as printf() for choosing the %g style */
+    bool exponentStyle;
+    int decimals;
+    bool strip = false;
+    if(lowercaseType == 'g') {
+        exponentStyle = !(precision > digits.exponent && digits.exponent >= -4);
+        decimals = exponentStyle ? precision - 1 : precision - 1 - digits.exponent;
+        strip = true;
+    } else {
+        exponentStyle = lowercaseType == 'e';
+        decimals = precision;
+    }
+
+    /* Sign, up to 16 digits, a decimal point and the exponent, or the fixed
+       representation with leading zeros */
+    if(std::size_t(decimals + std::max(digits.exponent, 0) + 8) > FloatBufferSize)
+        return 0;
+
+    char* i = out;
+    if(std::signbit(value)) *i++ = '-';
+    return (i - out) + (exponentStyle ?
+        writeExponentStyle(i, digits, decimals, strip, lowercaseType != type) :
+        writeFixedStyle(i, digits, decimals, strip));
+}
+
+/* snprintf() always writes a null terminator, cutting off the last character
+   if the output fills the whole buffer. In that case (or if the output
+   doesn't fit at all) format into a temporary and copy the part that fits. */
+template<class T> std::size_t formatSnprintf(const Containers::ArrayView<char>& buffer, const char* const format, const int precision, const T value) {
+    const std::size_t size = std::snprintf(buffer, buffer.size(), format, precision, value);
+    if(buffer && size >= buffer.size()) {
+        Containers::Array<char> out{Containers::NoInit, size + 1};
+        std::snprintf(out, out.size(), format, precision, value);
+        std::memcpy(buffer, out, buffer.size());
+    }
+    return size;
+}
+
+template<class T> std::size_t formatFloatingPoint(const Containers::ArrayView<char>& buffer, const T value, const int precision, const FormatType type) {
+    const char typeChar = formatTypeChar<float>(type);
+    char out[FloatBufferSize];
+    const std::size_t size = formatFloatingPointFast(out, value, precision, typeChar);
+    if(!size) {
+        const char format[]{ '%', '.', '*', typeChar, 0 };
+        return formatSnprintf(buffer, format, precision, double(value));
+    }
+
+    if(buffer) std::memcpy(buffer, out, std::min(size, buffer.size()));
+    return size;
+}
+
+template<class T> void formatFloatingPoint(std::FILE* const file, const T value, const int precision, const FormatType type) {
+    const char typeChar = formatTypeChar<float>(type);
+    char out[FloatBufferSize];
+    const std::size_t size = formatFloatingPointFast(out, value, precision, typeChar);
+    if(!size) {
+        const char format[]{ '%', '.', '*', typeChar, 0 };
+        std::fprintf(file, format, precision, double(value));
+    } else std::fwrite(out, size, 1, file);
+}
+
+}
+
+/* The integer formatters reinterpret negative values as unsigned for the
+   octal and hexadecimal output, same as printf() */
 std::size_t Formatter<int>::format(const Containers::ArrayView<char>& buffer, const int value, int precision, const FormatType type) {
     if(precision == -1) precision = 1;
-    const char format[]{ '%', '.', '*', formatTypeChar<int>(type), 0 };
-    return std::snprintf(buffer, buffer.size(), format, precision, value);
-    return {};
+    const char typeChar = formatTypeChar<int>(type);
+    if(typeChar != 'i') return formatInteger(buffer, static_cast<unsigned int>(value), false, precision, typeChar);
+    return formatInteger(buffer, value < 0 ? 0ull - static_cast<unsigned long long>(value) : value, value < 0, precision, typeChar);
 }
 void Formatter<int>::format(std::FILE* const file, const int value, int precision, FormatType type) {
     if(precision == -1) precision = 1;
-    const char format[]{ '%', '.', '*', formatTypeChar<int>(type), 0 };
-    std::fprintf(file, format, precision, value);
+    if(std::size_t(precision) >= FileBufferSize) {
+        const char format[]{ '%', '.', '*', formatTypeChar<int>(type), 0 };
+        std::fprintf(file, format, precision, value);
+        return;
+    }
+    const char typeChar = formatTypeChar<int>(type);
+    if(typeChar != 'i') return formatIntegerToFile(file, static_cast<unsigned int>(value), false, precision, typeChar);
+    formatIntegerToFile(file, value < 0 ? 0ull - static_cast<unsigned long long>(value) : value, value < 0, precision, typeChar);
 }
 std::size_t Formatter<unsigned int>::format(const Containers::ArrayView<char>& buffer, const unsigned int value, int precision, const FormatType type) {
     if(precision == -1) precision = 1;
-    const char format[]{ '%', '.', '*', formatTypeChar<unsigned int>(type), 0 };
-    return std::snprintf(buffer, buffer.size(), format, precision, value);
+    return formatInteger(buffer, value, false, precision, formatTypeChar<unsigned int>(type));
 }
 void Formatter<unsigned int>::format(std::FILE* const file, const unsigned int value, int precision, const FormatType type) {
     if(precision == -1) precision = 1;
-    const char format[]{ '%', '.', '*', formatTypeChar<unsigned int>(type), 0 };
-    std::fprintf(file, format, precision, value);
+    if(std::size_t(precision) >= FileBufferSize) {
+        const char format[]{ '%', '.', '*', formatTypeChar<unsigned int>(type), 0 };
+        std::fprintf(file, format, precision, value);
+        return;
+    }
+    formatIntegerToFile(file, value, false, precision, formatTypeChar<unsigned int>(type));
 }
 std::size_t Formatter<long long>::format(const Containers::ArrayView<char>& buffer, const long long value, int precision, const FormatType type) {
     if(precision == -1) precision = 1;
-    const char format[]{ '%', '.', '*', 'l', 'l', formatTypeChar<int>(type), 0 };
-    return std::snprintf(buffer, buffer.size(), format, precision, value);
+    const char typeChar = formatTypeChar<int>(type);
+    if(typeChar != 'i') return formatInteger(buffer, static_cast<unsigned long long>(value), false, precision, typeChar);
+    return formatInteger(buffer, value < 0 ? 0ull - static_cast<unsigned long long>(value) : value, value < 0, precision, typeChar);
 }
 void Formatter<long long>::format(std::FILE* const file, const long long value, int precision, const FormatType type) {
     if(precision == -1) precision = 1;
-    const char format[]{ '%', '.', '*', 'l', 'l', formatTypeChar<int>(type), 0 };
-    std::fprintf(file, format, precision, value);
+    if(std::size_t(precision) >= FileBufferSize) {
+        const char format[]{ '%', '.', '*', 'l', 'l', formatTypeChar<int>(type), 0 };
+        std::fprintf(file, format, precision, value);
+        return;
+    }
+    const char typeChar = formatTypeChar<int>(type);
+    if(typeChar != 'i') return formatIntegerToFile(file, static_cast<unsigned long long>(value), false, precision, typeChar);
+    formatIntegerToFile(file, value < 0 ? 0ull - static_cast<unsigned long long>(value) : value, value < 0, precision, typeChar);
 }
 std::size_t Formatter<unsigned long long>::format(const Containers::ArrayView<char>& buffer, const unsigned long long value, int precision, const FormatType type) {
     if(precision == -1) precision = 1;
-    const char format[]{ '%', '.', '*', 'l', 'l', formatTypeChar<unsigned int>(type), 0 };
-    return std::snprintf(buffer, buffer.size(), format, precision, value);
+    return formatInteger(buffer, value, false, precision, formatTypeChar<unsigned int>(type));
 }
 void Formatter<unsigned long long>::format(std::FILE* const file, const unsigned long long value, int precision, const FormatType type) {
     if(precision == -1) precision = 1;
-    const char format[]{ '%', '.', '*', 'l', 'l', formatTypeChar<unsigned int>(type), 0 };
-    std::fprintf(file, format, precision, value);
+    if(std::size_t(precision) >= FileBufferSize) {
+        const char format[]{ '%', '.', '*', 'l', 'l', formatTypeChar<unsigned int>(type), 0 };
+        std::fprintf(file, format, precision, value);
+        return;
+    }
+    formatIntegerToFile(file, value, false, precision, formatTypeChar<unsigned int>(type));
 }
 
 /* The default. Source: http://en.cppreference.com/w/cpp/io/ios_base/precision,
@@ -164,13 +736,11 @@ void Formatter<unsigned long long>::format(std::FILE* const file, const unsigned
    Kept in sync with Debug. */
 std::size_t Formatter<float>::format(const Containers::ArrayView<char>& buffer, const float value, int precision, const FormatType type) {
     if(precision == -1) precision = 6;
-    const char format[]{ '%', '.', '*', formatTypeChar<float>(type), 0 };
-    return std::snprintf(buffer, buffer.size(), format, precision, double(value));
+    return formatFloatingPoint(buffer, value, precision, type);
 }
 void Formatter<float>::format(std::FILE* const file, const float value, int precision, const FormatType type) {
     if(precision == -1) precision = 6;
-    const char format[]{ '%', '.', '*', formatTypeChar<float>(type), 0 };
-    std::fprintf(file, format, precision, double(value));
+    formatFloatingPoint(file, value, precision, type);
 }
 
 /* Wikipedia says 15-digit number can be converted back and forth without loss:
@@ -178,13 +748,11 @@ void Formatter<float>::format(std::FILE* const file, const float value, int prec
    Kept in sync with Debug. */
 std::size_t Formatter<double>::format(const Containers::ArrayView<char>& buffer, const double value, int precision, const FormatType type) {
     if(precision == -1) precision = 15;
-    const char format[]{ '%', '.', '*', formatTypeChar<float>(type), 0 };
-    return std::snprintf(buffer, buffer.size(), format, precision, value);
+    return formatFloatingPoint(buffer, value, precision, type);
 }
 void Formatter<double>::format(std::FILE* const file, const double value, int precision, const FormatType type) {
     if(precision == -1) precision = 15;
-    const char format[]{ '%', '.', '*', formatTypeChar<float>(type), 0 };
-    std::fprintf(file, format, precision, value);
+    formatFloatingPoint(file, value, precision, type);
 }
 
 #ifndef CORRADE_TARGET_EMSCRIPTEN
@@ -194,7 +762,7 @@ void Formatter<double>::format(std::FILE* const file, const double value, int pr
 std::size_t Formatter<long double>::format(const Containers::ArrayView<char>& buffer, const long double value, int precision, const FormatType type) {
     if(precision == -1) precision = 18;
     const char format[]{ '%', '.', '*', 'L', formatTypeChar<float>(type), 0 };
-    return std::snprintf(buffer, buffer.size(), format, precision, value);
+    return formatSnprintf(buffer, format, precision, value);
 }
 void Formatter<long double>::format(std::FILE* const file, const long double value, int precision, const FormatType type) {
     if(precision == -1) precision = 18;
@@ -385,28 +953,51 @@ template<class Writer, class FormattedWriter, class Formatter> void formatWith(c
 
 }
 
+namespace {
+
+/* Used by both the format string and the compiled format variants */
+void writeBuffer(const Containers::ArrayView<char>& buffer, std::size_t& bufferOffset, const Containers::ArrayView<const char> data) {
+    if(buffer) {
+        CORRADE_ASSERT(data.size() <= buffer.size(),
+            "Utility::formatInto(): buffer too small, expected at least" << bufferOffset + data.size() << "but got" << bufferOffset + buffer.size(), );
+        /* strncpy() would stop on \0 characters */
+        std::memcpy(buffer + bufferOffset, data, data.size());
+    }
+    bufferOffset += data.size();
+}
+
+void writeBufferFormatted(const Containers::ArrayView<char>& buffer, std::size_t& bufferOffset, BufferFormatter& formatter, const int precision, const FormatType type) {
+    if(buffer) {
+        formatter.size = formatter(buffer.suffix(bufferOffset), precision, type);
+        CORRADE_ASSERT(bufferOffset + formatter.size <= buffer.size(),
+            "Utility::formatInto(): buffer too small, expected at least" << bufferOffset + formatter.size << "but got" << buffer.size(), );
+    /* Not reusing the size from a previous placeholder, as the same argument
+       can be formatted with a different precision or type each time */
+    } else formatter.size = formatter(nullptr, precision, type);
+    bufferOffset += formatter.size;
+}
+
+}
+
 std::size_t formatInto(const Containers::ArrayView<char>& buffer, const char* const format, BufferFormatter* const formatters, std::size_t formatterCount) {
     std::size_t bufferOffset = 0;
     formatWith([&buffer, &bufferOffset](Containers::ArrayView<const char> data) {
-        if(buffer) {
-            CORRADE_ASSERT(data.size() <= buffer.size(),
-                "Utility::formatInto(): buffer too small, expected at least" << bufferOffset + data.size() << "but got" << bufferOffset + buffer.size(), );
-            /* strncpy() would stop on \0 characters */
-            std::memcpy(buffer + bufferOffset, data, data.size());
-        }
-        bufferOffset += data.size();
+        writeBuffer(buffer, bufferOffset, data);
     }, [&buffer, &bufferOffset](BufferFormatter& formatter, int precision, FormatType type) {
-        if(buffer) {
-            formatter.size = formatter(buffer.suffix(bufferOffset), precision, type);
-            CORRADE_ASSERT(bufferOffset + formatter.size <= buffer.size(),
-                "Utility::formatInto(): buffer too small, expected at least" << bufferOffset + formatter.size << "but got" << buffer.size(), );
-        } else if(formatter.size == ~std::size_t{})
-            formatter.size = formatter(nullptr, precision, type);
-        bufferOffset += formatter.size;
+        writeBufferFormatted(buffer, bufferOffset, formatter, precision, type);
     }, {format, std::strlen(format)}, Containers::arrayView(formatters, formatterCount));
     return bufferOffset;
 }
 
+std::size_t formatInto(const Containers::ArrayView<char>& buffer, const FormatChunk* const chunks, const std::size_t chunkCount, BufferFormatter* const formatters) {
+    std::size_t bufferOffset = 0;
+    for(const FormatChunk& chunk: Containers::arrayView(chunks, chunkCount)) {
+        if(chunk.data) writeBuffer(buffer, bufferOffset, {chunk.data, chunk.size});
+        else writeBufferFormatted(buffer, bufferOffset, formatters[chunk.size], chunk.precision, chunk.type);
+    }
+    return bufferOffset;
+}
+
 std::size_t formatInto(std::string& buffer, const std::size_t offset, const char* const format, BufferFormatter* const formatters, std::size_t formatterCount) {
     const std::size_t size = formatInto(nullptr, format, formatters, formatterCount);
     if(buffer.size() < offset + size) buffer.resize(offset + size);
@@ -415,6 +1006,46 @@ std::size_t formatInto(std::string& buffer, const std::size_t offset, const char
     return offset + formatInto({&buffer[offset], buffer.size() + 1}, format, formatters, formatterCount);
 }
 
+std::size_t formatInto(std::string& buffer, const std::size_t offset, const FormatChunk* const chunks, const std::size_t chunkCount, BufferFormatter* const formatters) {
+    const std::size_t size = formatInto(nullptr, chunks, chunkCount, formatters);
+    if(buffer.size() < offset + size) buffer.resize(offset + size);
+    /* Same as above */
+    return offset + formatInto({&buffer[offset], buffer.size() + 1}, chunks, chunkCount, formatters);
+}
+
+namespace {
+
+/* Appends directly to the array instead of going through the formatting
+   twice, once for the size and once for the actual data */
+void appendFormatted(Containers::Array<char>& buffer, BufferFormatter& formatter, const int precision, const FormatType type) {
+    const std::size_t size = formatter(nullptr, precision, type);
+    /* printf() always wants to print the null terminator, so append space for
+       it and then remove it again. The capacity stays, so the next append
+       can overwrite it without reallocating. */
+    formatter(Containers::arrayAppend(buffer, Containers::NoInit, size + 1), precision, type);
+    Containers::arrayRemoveSuffix(buffer);
+}
+
+}
+
+std::size_t formatInto(Containers::Array<char>& buffer, const char* const format, BufferFormatter* const formatters, std::size_t formatterCount) {
+    const std::size_t offset = buffer.size();
+    formatWith([&buffer](Containers::ArrayView<const char> data) {
+        Containers::arrayAppend(buffer, data);
+    }, [&buffer](BufferFormatter& formatter, int precision, FormatType type) {
+        appendFormatted(buffer, formatter, precision, type);
+    }, {format, std::strlen(format)}, Containers::arrayView(formatters, formatterCount));
+    return buffer.size() - offset;
+}
+std::size_t formatInto(Containers::Array<char>& buffer, const FormatChunk* const chunks, const std::size_t chunkCount, BufferFormatter* const formatters) {
+    const std::size_t offset = buffer.size();
+    for(const FormatChunk& chunk: Containers::arrayView(chunks, chunkCount)) {
+        if(chunk.data) Containers::arrayAppend(buffer, Containers::arrayView(chunk.data, chunk.size));
+        else appendFormatted(buffer, formatters[chunk.size], chunk.precision, chunk.type);
+    }
+    return buffer.size() - offset;
+}
+
 void formatInto(std::FILE* const file, const char* format, FileFormatter* const formatters, std::size_t formatterCount) {
     formatWith([&file](Containers::ArrayView<const char> data) {
         fwrite(data.data(), data.size(), 1, file);
@@ -423,6 +1054,169 @@ void formatInto(std::FILE* const file, const char* format, FileFormatter* const
     }, {format, std::strlen(format)}, Containers::arrayView(formatters, formatterCount));
 }
 
+void formatInto(std::FILE* const file, const FormatChunk* const chunks, const std::size_t chunkCount, FileFormatter* const formatters) {
+    for(const FormatChunk& chunk: Containers::arrayView(chunks, chunkCount)) {
+        if(chunk.data) fwrite(chunk.data, chunk.size, 1, file);
+        else formatters[chunk.size](file, chunk.precision, chunk.type);
+    }
+}
+
+std::size_t compileFormat(const char* const format, const std::size_t argumentCount, FormatChunk* const chunks, const std::size_t chunkCapacity) {
+    /* Reusing the runtime parser, with the "formatters" being just indices
+       so the placeholders can be recorded */
+    Containers::Array<std::size_t> indices{Containers::NoInit, argumentCount};
+    for(std::size_t i = 0; i != argumentCount; ++i) indices[i] = i;
+
+    std::size_t chunkCount = 0;
+    formatWith([&](Containers::ArrayView<const char> data) {
+        CORRADE_INTERNAL_ASSERT(chunkCount < chunkCapacity);
+        chunks[chunkCount++] = FormatChunk{data.data(), data.size(), -1, FormatType::Unspecified};
+    }, [&](const std::size_t& index, int precision, FormatType type) {
+        CORRADE_INTERNAL_ASSERT(chunkCount < chunkCapacity);
+        chunks[chunkCount++] = FormatChunk{nullptr, index, precision, type};
+    }, {format, std::strlen(format)}, Containers::arrayView<const std::size_t>(indices));
+    return chunkCount;
+}
+
+/* These are never called at runtime, only used to make the compile-time
+   format string validation fail */
+std::size_t formatStringMismatchedBrace() { return 0; }
+std::size_t formatStringUnexpectedEnd() { return 0; }
+std::size_t formatStringInvalidPrecision() { return 0; }
+std::size_t formatStringInvalidTypeSpecifier() { return 0; }
+std::size_t formatStringUnknownPlaceholderContent() { return 0; }
+
+}
+
+namespace {
+
+using namespace Implementation;
+
+/* Free space kept at the end of the array before formatting a value, enough
+   for any integer with the default precision, any fast-path float and the
+   null terminator snprintf() wants to write */
+enum: std::size_t { NumberSlack = FloatBufferSize + 1 };
+
+/* Makes sure there's at least `slack` bytes after `size`. The array is then
+   extended to its whole capacity so this is done only O(log n) times. */
+void ensureSlack(Containers::Array<char>& buffer, const std::size_t size, const std::size_t slack) {
+    if(buffer.size() - size >= slack) return;
+    Containers::arrayAppend(buffer, Containers::NoInit, size + slack - buffer.size());
+    Containers::arrayResize(buffer, Containers::NoInit, Containers::arrayCapacity(buffer));
+}
+
+template<class T> void appendNumbers(Containers::Array<char>& buffer, std::size_t& size, const Containers::StridedArrayView1D<const T>& values, const Containers::ArrayView<const char> delimiter, const int precision) {
+    for(std::size_t i = 0; i != values.size(); ++i) {
+        ensureSlack(buffer, size, delimiter.size() + NumberSlack);
+        if(i) {
+            std::memcpy(buffer + size, delimiter, delimiter.size());
+            size += delimiter.size();
+        }
+
+        /* Formatting the value directly into the free space. If it doesn't
+           fit (which can happen only with a large precision or with floats
+           going through snprintf()), the returned size is the size it
+           would need, so enlarge and format again. */
+        std::size_t written = Formatter<T>::format(buffer.suffix(size), values[i], precision, FormatType::Unspecified);
+        if(written >= buffer.size() - size) {
+            ensureSlack(buffer, size, written + 1);
+            written = Formatter<T>::format(buffer.suffix(size), values[i], precision, FormatType::Unspecified);
+        }
+        size += written;
+    }
+}
+
+template<class T> std::size_t formatNumbersIntoImplementation(Containers::Array<char>& buffer, const Containers::StridedArrayView1D<const T>& values, const char* const delimiter, const int precision) {
+    if(!values.size()) return 0;
+
+    const std::size_t offset = buffer.size();
+    std::size_t size = offset;
+    appendNumbers(buffer, size, values, {delimiter, std::strlen(delimiter)}, precision);
+    Containers::arrayRemoveSuffix(buffer, buffer.size() - size);
+    return size - offset;
+}
+
+template<class T> std::size_t formatNumbersIntoImplementation(Containers::Array<char>& buffer, const Containers::StridedArrayView2D<const T>& values, const char* const columnDelimiter, const char* const rowDelimiter, const int precision) {
+    if(!values.size()[0]) return 0;
+
+    const Containers::ArrayView<const char> columnDelimiterView{columnDelimiter, std::strlen(columnDelimiter)};
+    const Containers::ArrayView<const char> rowDelimiterView{rowDelimiter, std::strlen(rowDelimiter)};
+    const std::size_t offset = buffer.size();
+    std::size_t size = offset;
+    for(const Containers::StridedArrayView1D<const T> row: values) {
+        appendNumbers(buffer, size, row, columnDelimiterView, precision);
+        ensureSlack(buffer, size, rowDelimiterView.size());
+        std::memcpy(buffer + size, rowDelimiterView, rowDelimiterView.size());
+        size += rowDelimiterView.size();
+    }
+    Containers::arrayRemoveSuffix(buffer, buffer.size() - size);
+    return size - offset;
+}
+
+}
+
+std::size_t formatNumbersInto(Containers::Array<char>& buffer, const Containers::StridedArrayView1D<const int>& values, const char* const delimiter, const int precision) {
+    return formatNumbersIntoImplementation(buffer, values, delimiter, precision);
+}
+
+std::size_t formatNumbersInto(Containers::Array<char>& buffer, const Containers::StridedArrayView1D<const unsigned int>& values, const char* const delimiter, const int precision) {
+    return formatNumbersIntoImplementation(buffer, values, delimiter, precision);
+}
+
+std::size_t formatNumbersInto(Containers::Array<char>& buffer, const Containers::StridedArrayView1D<const long>& values, const char* const delimiter, const int precision) {
+    return formatNumbersIntoImplementation(buffer, values, delimiter, precision);
+}
+
+std::size_t formatNumbersInto(Containers::Array<char>& buffer, const Containers::StridedArrayView1D<const unsigned long>& values, const char* const delimiter, const int precision) {
+    return formatNumbersIntoImplementation(buffer, values, delimiter, precision);
+}
+
+std::size_t formatNumbersInto(Containers::Array<char>& buffer, const Containers::StridedArrayView1D<const long long>& values, const char* const delimiter, const int precision) {
+    return formatNumbersIntoImplementation(buffer, values, delimiter, precision);
+}
+
+std::size_t formatNumbersInto(Containers::Array<char>& buffer, const Containers::StridedArrayView1D<const unsigned long long>& values, const char* const delimiter, const int precision) {
+    return formatNumbersIntoImplementation(buffer, values, delimiter, precision);
+}
+
+std::size_t formatNumbersInto(Containers::Array<char>& buffer, const Containers::StridedArrayView1D<const float>& values, const char* const delimiter, const int precision) {
+    return formatNumbersIntoImplementation(buffer, values, delimiter, precision);
+}
+
+std::size_t formatNumbersInto(Containers::Array<char>& buffer, const Containers::StridedArrayView1D<const double>& values, const char* const delimiter, const int precision) {
+    return formatNumbersIntoImplementation(buffer, values, delimiter, precision);
+}
+
+std::size_t formatNumbersInto(Containers::Array<char>& buffer, const Containers::StridedArrayView2D<const int>& values, const char* const columnDelimiter, const char* const rowDelimiter, const int precision) {
+    return formatNumbersIntoImplementation(buffer, values, columnDelimiter, rowDelimiter, precision);
+}
+
+std::size_t formatNumbersInto(Containers::Array<char>& buffer, const Containers::StridedArrayView2D<const unsigned int>& values, const char* const columnDelimiter, const char* const rowDelimiter, const int precision) {
+    return formatNumbersIntoImplementation(buffer, values, columnDelimiter, rowDelimiter, precision);
+}
+
+std::size_t formatNumbersInto(Containers::Array<char>& buffer, const Containers::StridedArrayView2D<const long>& values, const char* const columnDelimiter, const char* const rowDelimiter, const int precision) {
+    return formatNumbersIntoImplementation(buffer, values, columnDelimiter, rowDelimiter, precision);
+}
+
+std::size_t formatNumbersInto(Containers::Array<char>& buffer, const Containers::StridedArrayView2D<const unsigned long>& values, const char* const columnDelimiter, const char* const rowDelimiter, const int precision) {
+    return formatNumbersIntoImplementation(buffer, values, columnDelimiter, rowDelimiter, precision);
+}
+
+std::size_t formatNumbersInto(Containers::Array<char>& buffer, const Containers::StridedArrayView2D<const long long>& values, const char* const columnDelimiter, const char* const rowDelimiter, const int precision) {
+    return formatNumbersIntoImplementation(buffer, values, columnDelimiter, rowDelimiter, precision);
+}
+
+std::size_t formatNumbersInto(Containers::Array<char>& buffer, const Containers::StridedArrayView2D<const unsigned long long>& values, const char* const columnDelimiter, const char* const rowDelimiter, const int precision) {
+    return formatNumbersIntoImplementation(buffer, values, columnDelimiter, rowDelimiter, precision);
+}
+
+std::size_t formatNumbersInto(Containers::Array<char>& buffer, const Containers::StridedArrayView2D<const float>& values, const char* const columnDelimiter, const char* const rowDelimiter, const int precision) {
+    return formatNumbersIntoImplementation(buffer, values, columnDelimiter, rowDelimiter, precision);
+}
+
+std::size_t formatNumbersInto(Containers::Array<char>& buffer, const Containers::StridedArrayView2D<const double>& values, const char* const columnDelimiter, const char* const rowDelimiter, const int precision) {
+    return formatNumbersIntoImplementation(buffer, values, columnDelimiter, rowDelimiter, precision);
 }
 
 }}
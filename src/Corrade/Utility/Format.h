@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Function @ref Corrade::Utility::format(), @ref Corrade::Utility::formatInto(), @ref Corrade::Utility::print(), @ref Corrade::Utility::printError()
+ * @brief Function @ref Corrade::Utility::format(), @ref Corrade::Utility::formatInto(), @ref Corrade::Utility::print(), @ref Corrade::Utility::printError(), class @ref Corrade::Utility::CompiledFormat, macro @ref CORRADE_FORMAT()
  * @experimental
  */
 
@@ -137,6 +137,14 @@ for a completely zero-allocation alternative. There is also
 @ref formatInto(std::FILE*, const char*, const Args&... args) for writing to
 files or standard output.
 
+The format string is parsed on every call. For code that formats the same
+string repeatedly, the @ref CORRADE_FORMAT() macro validates the format
+string at compile time and parses it just once into a @ref CompiledFormat,
+which all functions accept in place of the @cpp const char* @ce format
+string:
+
+@snippet Utility.cpp CORRADE_FORMAT
+
 # Comparison to Debug
 
 @ref Debug class desired usage is for easy printing of complex nested types,
@@ -189,6 +197,32 @@ See @ref format() for more information about usage and templating language.
 */
 template<class ...Args> void formatInto(std::FILE* file, const char* format, const Args&... args);
 
+/**
+@brief Format a string and append it to a growable array
+@m_since_latest
+
+Appends formatted output to the end of @p buffer using
+@ref Containers::arrayAppend(), so the array grows with an amortized growth
+strategy and can be reused for building large outputs without a separate
+allocation for each call. If the array isn't growable yet, it's converted to
+one on the first call. Returns the amount of bytes appended, *does not* write
+any terminating @cpp '\0' @ce character. Example usage:
+
+@snippet Utility.cpp formatInto-array
+
+Note that the growable array deleter is not an exported symbol. With Corrade
+built as shared libraries, appending to the same array also from outside of
+this function thus reallocates it each time the two are interleaved. For the
+best performance avoid mixing the two.
+
+See @ref format() for more information about usage and templating language.
+For writing large outputs to a file with just a few system calls, see
+@ref BufferedFile.
+
+@experimental
+*/
+template<class ...Args> std::size_t formatInto(Containers::Array<char>& buffer, const char* format, const Args&... args);
+
 /**
 @brief Print a string to the standard output
 
@@ -213,6 +247,134 @@ template<class ...Args> inline void printError(const char* format, const Args&..
     return formatInto(stderr, format, args...);
 }
 
+/**
+@brief Format a list of numbers and append it to a growable array
+@param[in,out] buffer   Array to append to
+@param[in] values       Values to format
+@param[in] delimiter    Null-terminated delimiter put between the values
+@param[in] precision    Precision, @cpp -1 @ce for the type default
+@return Count of bytes appended
+@m_since_latest
+
+Equivalent to calling @ref formatInto(Containers::Array<char>&, const char*, const Args&... args)
+with a @cpp "{}" @ce placeholder for each value and @p delimiter between them,
+but without the placeholder parsing, with the array growing at most
+@f$ \mathcal{O}(\log n) @f$ times and each value formatted directly into the
+array. Integers are formatted as decimal, floating-point values in the
+@cpp 'g' @ce style. Nothing is put after the last value. Example usage,
+together with the inverse @ref parseNumbersInto():
+
+@snippet Utility.cpp formatNumbersInto
+
+The same note about growable array deleters as in
+@ref formatInto(Containers::Array<char>&, const char*, const Args&... args)
+applies here.
+@experimental
+*/
+CORRADE_UTILITY_EXPORT std::size_t formatNumbersInto(Containers::Array<char>& buffer, const Containers::StridedArrayView1D<const int>& values, const char* delimiter, int precision = -1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+CORRADE_UTILITY_EXPORT std::size_t formatNumbersInto(Containers::Array<char>& buffer, const Containers::StridedArrayView1D<const unsigned int>& values, const char* delimiter, int precision = -1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+CORRADE_UTILITY_EXPORT std::size_t formatNumbersInto(Containers::Array<char>& buffer, const Containers::StridedArrayView1D<const long>& values, const char* delimiter, int precision = -1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+CORRADE_UTILITY_EXPORT std::size_t formatNumbersInto(Containers::Array<char>& buffer, const Containers::StridedArrayView1D<const unsigned long>& values, const char* delimiter, int precision = -1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+CORRADE_UTILITY_EXPORT std::size_t formatNumbersInto(Containers::Array<char>& buffer, const Containers::StridedArrayView1D<const long long>& values, const char* delimiter, int precision = -1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+CORRADE_UTILITY_EXPORT std::size_t formatNumbersInto(Containers::Array<char>& buffer, const Containers::StridedArrayView1D<const unsigned long long>& values, const char* delimiter, int precision = -1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+CORRADE_UTILITY_EXPORT std::size_t formatNumbersInto(Containers::Array<char>& buffer, const Containers::StridedArrayView1D<const float>& values, const char* delimiter, int precision = -1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+CORRADE_UTILITY_EXPORT std::size_t formatNumbersInto(Containers::Array<char>& buffer, const Containers::StridedArrayView1D<const double>& values, const char* delimiter, int precision = -1);
+
+/**
+@brief Format a table of numbers and append it to a growable array
+@param[in,out] buffer           Array to append to
+@param[in] values               Values to format, rows in the first dimension
+@param[in] columnDelimiter      Null-terminated delimiter put between values
+    in a row
+@param[in] rowDelimiter         Null-terminated delimiter put after each row
+@param[in] precision            Precision, @cpp -1 @ce for the type default
+@return Count of bytes appended
+@m_since_latest
+
+Like @ref formatNumbersInto(Containers::Array<char>&, const Containers::StridedArrayView1D<const int>&, const char*, int),
+but with @p rowDelimiter put after each row, including the last one. With
+@cpp "," @ce and @cpp "\n" @ce this produces a CSV file.
+@experimental
+*/
+CORRADE_UTILITY_EXPORT std::size_t formatNumbersInto(Containers::Array<char>& buffer, const Containers::StridedArrayView2D<const int>& values, const char* columnDelimiter, const char* rowDelimiter, int precision = -1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+CORRADE_UTILITY_EXPORT std::size_t formatNumbersInto(Containers::Array<char>& buffer, const Containers::StridedArrayView2D<const unsigned int>& values, const char* columnDelimiter, const char* rowDelimiter, int precision = -1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+CORRADE_UTILITY_EXPORT std::size_t formatNumbersInto(Containers::Array<char>& buffer, const Containers::StridedArrayView2D<const long>& values, const char* columnDelimiter, const char* rowDelimiter, int precision = -1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+CORRADE_UTILITY_EXPORT std::size_t formatNumbersInto(Containers::Array<char>& buffer, const Containers::StridedArrayView2D<const unsigned long>& values, const char* columnDelimiter, const char* rowDelimiter, int precision = -1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+CORRADE_UTILITY_EXPORT std::size_t formatNumbersInto(Containers::Array<char>& buffer, const Containers::StridedArrayView2D<const long long>& values, const char* columnDelimiter, const char* rowDelimiter, int precision = -1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+CORRADE_UTILITY_EXPORT std::size_t formatNumbersInto(Containers::Array<char>& buffer, const Containers::StridedArrayView2D<const unsigned long long>& values, const char* columnDelimiter, const char* rowDelimiter, int precision = -1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+CORRADE_UTILITY_EXPORT std::size_t formatNumbersInto(Containers::Array<char>& buffer, const Containers::StridedArrayView2D<const float>& values, const char* columnDelimiter, const char* rowDelimiter, int precision = -1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+CORRADE_UTILITY_EXPORT std::size_t formatNumbersInto(Containers::Array<char>& buffer, const Containers::StridedArrayView2D<const double>& values, const char* columnDelimiter, const char* rowDelimiter, int precision = -1);
+
 namespace Implementation {
 
 enum class FormatType: unsigned char;
@@ -273,6 +435,100 @@ template<> struct Formatter<Containers::ArrayView<const char>> {
    convertible to it */
 template<class T> struct Formatter<T, typename std::enable_if<std::is_enum<T>::value>::type>: Formatter<typename std::underlying_type<T>::type> {};
 
+/* A piece of a parsed format string, either a literal or a placeholder */
+struct FormatChunk {
+    /* Literal data or nullptr for a placeholder */
+    const char* data;
+    /* Literal size or the argument index for a placeholder */
+    std::size_t size;
+    int precision;
+    FormatType type;
+};
+
+/* Compile-time format string validation. The functions below are recursive
+   to be usable in C++11 constexpr, which means the format string length is
+   limited by the compiler constexpr recursion depth (512 by default on GCC
+   and Clang). The non-constexpr functions are called on error, making the
+   constant evaluation fail with their name in the diagnostic. */
+struct FormatInfo {
+    std::size_t argumentCount;
+    std::size_t chunkCount;
+};
+
+CORRADE_UTILITY_EXPORT std::size_t formatStringMismatchedBrace();
+CORRADE_UTILITY_EXPORT std::size_t formatStringUnexpectedEnd();
+CORRADE_UTILITY_EXPORT std::size_t formatStringInvalidPrecision();
+CORRADE_UTILITY_EXPORT std::size_t formatStringInvalidTypeSpecifier();
+CORRADE_UTILITY_EXPORT std::size_t formatStringUnknownPlaceholderContent();
+
+constexpr bool isFormatDigit(const char c) {
+    return c >= '0' && c <= '9';
+}
+
+constexpr bool isFormatTypeSpecifier(const char c) {
+    return c == 'o' || c == 'd' || c == 'x' || c == 'X' || c == 'g' ||
+           c == 'G' || c == 'e' || c == 'E' || c == 'f' || c == 'F';
+}
+
+constexpr std::size_t formatSkipDigits(const char* const format, const std::size_t i, const std::size_t size) {
+    return i < size && isFormatDigit(format[i]) ? formatSkipDigits(format, i + 1, size) : i;
+}
+
+constexpr std::size_t formatParseNumber(const char* const format, const std::size_t i, const std::size_t size, const std::size_t value) {
+    return i < size && isFormatDigit(format[i]) ? formatParseNumber(format, i + 1, size, value*10 + (format[i] - '0')) : value;
+}
+
+constexpr std::size_t formatPlaceholderTypeEnd(const char* const format, const std::size_t i, const std::size_t size) {
+    return i < size && format[i] != '}' ?
+        (isFormatTypeSpecifier(format[i]) ? i + 1 : formatStringInvalidTypeSpecifier()) : i;
+}
+
+constexpr std::size_t formatPlaceholderPrecisionEnd(const char* const format, const std::size_t i, const std::size_t size) {
+    return i + 1 < size && format[i] == '.' ?
+        (isFormatDigit(format[i + 1]) ? formatSkipDigits(format, i + 1, size) : formatStringInvalidPrecision()) : i;
+}
+
+constexpr std::size_t formatPlaceholderOptionsEnd(const char* const format, const std::size_t i, const std::size_t size) {
+    return i < size && format[i] == ':' ?
+        formatPlaceholderTypeEnd(format, formatPlaceholderPrecisionEnd(format, i + 1, size), size) : i;
+}
+
+constexpr std::size_t formatPlaceholderCheckEnd(const char* const format, const std::size_t i, const std::size_t size) {
+    return i < size ?
+        (format[i] == '}' ? i : formatStringUnknownPlaceholderContent()) :
+        formatStringUnexpectedEnd();
+}
+
+/* Position of the closing brace of a placeholder whose contents begin at i */
+constexpr std::size_t formatPlaceholderEnd(const char* const format, const std::size_t i, const std::size_t size) {
+    return formatPlaceholderCheckEnd(format, formatPlaceholderOptionsEnd(format, formatSkipDigits(format, i, size), size), size);
+}
+
+constexpr FormatInfo formatInfo(const char* format, std::size_t i, std::size_t size, std::size_t next, std::size_t argumentCount, std::size_t chunkCount);
+
+constexpr FormatInfo formatInfoPlaceholder(const char* const format, const std::size_t end, const std::size_t size, const std::size_t index, const std::size_t argumentCount, const std::size_t chunkCount) {
+    return formatInfo(format, end + 1, size, index + 1, index + 1 > argumentCount ? index + 1 : argumentCount, chunkCount + 2);
+}
+
+/* Each placeholder or escaped brace can be preceded by a literal, so it's at
+   most two chunks, plus one for the final literal */
+constexpr FormatInfo formatInfo(const char* const format, const std::size_t i, const std::size_t size, const std::size_t next, const std::size_t argumentCount, const std::size_t chunkCount) {
+    return i == size ? FormatInfo{argumentCount, chunkCount + 1} :
+        format[i] == '{' ? (i + 1 < size && format[i + 1] == '{' ?
+            formatInfo(format, i + 2, size, next, argumentCount, chunkCount + 2) :
+            formatInfoPlaceholder(format, formatPlaceholderEnd(format, i + 1, size), size, i + 1 < size && isFormatDigit(format[i + 1]) ? formatParseNumber(format, i + 1, size, 0) : next, argumentCount, chunkCount)) :
+        format[i] == '}' ? (i + 1 < size && format[i + 1] == '}' ?
+            formatInfo(format, i + 2, size, next, argumentCount, chunkCount + 2) :
+            FormatInfo{formatStringMismatchedBrace(), 0}) :
+        formatInfo(format, i + 1, size, next, argumentCount, chunkCount);
+}
+
+template<std::size_t size> constexpr FormatInfo formatInfo(const char(&format)[size]) {
+    return formatInfo(format, 0, size - 1, 0, 0, 0);
+}
+
+CORRADE_UTILITY_EXPORT std::size_t compileFormat(const char* format, std::size_t argumentCount, FormatChunk* chunks, std::size_t chunkCapacity);
+
 struct BufferFormatter {
     /* Needed for a sentinel value (C arrays can't have zero size) */
     /*implicit*/ constexpr BufferFormatter(): _fn{}, _value{} {}
@@ -287,7 +543,7 @@ struct BufferFormatter {
         return _fn(buffer, _value, precision, type);
     }
 
-    /* Cached size of the formatted string to avoid recalculations */
+    /* Size of the last formatted output, used for buffer size checks */
     std::size_t size{~std::size_t{}};
 
     private:
@@ -314,22 +570,177 @@ struct FileFormatter {
 
 CORRADE_UTILITY_EXPORT std::size_t formatInto(const Containers::ArrayView<char>& buffer, const char* format, BufferFormatter* formatters, std::size_t formattersCount);
 CORRADE_UTILITY_EXPORT void formatInto(std::FILE* file, const char* format, FileFormatter* formatters, std::size_t formattersCount);
+CORRADE_UTILITY_EXPORT std::size_t formatInto(const Containers::ArrayView<char>& buffer, const FormatChunk* chunks, std::size_t chunkCount, BufferFormatter* formatters);
+CORRADE_UTILITY_EXPORT void formatInto(std::FILE* file, const FormatChunk* chunks, std::size_t chunkCount, FileFormatter* formatters);
+CORRADE_UTILITY_EXPORT std::size_t formatInto(Containers::Array<char>& buffer, const char* format, BufferFormatter* formatters, std::size_t formattersCount);
+CORRADE_UTILITY_EXPORT std::size_t formatInto(Containers::Array<char>& buffer, const FormatChunk* chunks, std::size_t chunkCount, BufferFormatter* formatters);
 
 }
 
+/**
+@brief Compiled format string
+@m_since_latest
+
+A format string parsed into a sequence of literals and placeholders, so
+formatting with it doesn't need to parse the format string again. The
+@p argumentCount is the number of arguments the format string expects and
+@p chunkCapacity is an upper bound on the number of parsed chunks. You're not
+supposed to create instances of this class directly, use the
+@ref CORRADE_FORMAT() macro instead, which calculates the template parameters
+at compile time and parses the format string just once.
+
+@experimental
+*/
+template<std::size_t argumentCount, std::size_t chunkCapacity> class CompiledFormat {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * The @p format is expected to stay in scope for the whole lifetime
+         * of this instance and to contain exactly @p argumentCount distinct
+         * placeholders.
+         */
+        explicit CompiledFormat(const char* format): _chunkCount{Implementation::compileFormat(format, argumentCount, _chunks, chunkCapacity)} {}
+
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        const Implementation::FormatChunk* chunks() const { return _chunks; }
+        std::size_t chunkCount() const { return _chunkCount; }
+        #endif
+
+    private:
+        Implementation::FormatChunk _chunks[chunkCapacity];
+        std::size_t _chunkCount;
+};
+
+/**
+@brief Compile-time validated format string
+@m_since_latest
+
+Expands to a reference to a static @ref CompiledFormat instance, parsed the
+first time the expression is evaluated. The format string has to be a string
+literal. Unbalanced braces, invalid type or precision specifiers and other
+errors are reported at compile time and the functions taking a
+@ref CompiledFormat fail to compile if the argument count doesn't match the
+placeholders. Unlike with @cpp const char* @ce format strings, extraneous
+arguments or placeholders are not allowed. Example usage:
+
+@snippet Utility.cpp CORRADE_FORMAT
+
+The validation is done via recursive @cpp constexpr @ce evaluation, which
+limits the format string length to the compiler @cpp constexpr @ce recursion
+depth, which is 512 by default on GCC and Clang.
+
+@experimental
+*/
+#define CORRADE_FORMAT(format)                                              \
+    ([]() -> const Corrade::Utility::CompiledFormat<Corrade::Utility::Implementation::formatInfo(format).argumentCount, Corrade::Utility::Implementation::formatInfo(format).chunkCount>& { \
+        static const Corrade::Utility::CompiledFormat<Corrade::Utility::Implementation::formatInfo(format).argumentCount, Corrade::Utility::Implementation::formatInfo(format).chunkCount> compiled{format}; \
+        return compiled;                                                    \
+    }())
+
+/**
+@brief Format a string using a compiled format string
+@m_since_latest
+
+Same as @ref format(const char*, const Args&... args), except that the format
+string is already parsed and its argument count is checked at compile time.
+@experimental
+*/
+#ifdef DOXYGEN_GENERATING_OUTPUT
+template<std::size_t argumentCount, std::size_t chunkCapacity, class ...Args> Containers::Array<char> format(const CompiledFormat<argumentCount, chunkCapacity>& format, const Args&... args);
+#else
+template<std::size_t argumentCount, std::size_t chunkCapacity, class ...Args, class Array = Containers::Array<char>> Array format(const CompiledFormat<argumentCount, chunkCapacity>& format, const Args&... args);
+#endif
+
+/**
+@brief Format a string into an existing buffer using a compiled format string
+@m_since_latest
+
+Same as @ref formatInto(const Containers::ArrayView<char>&, const char*, const Args&... args),
+except that the format string is already parsed and its argument count is
+checked at compile time.
+@experimental
+*/
+template<std::size_t argumentCount, std::size_t chunkCapacity, class ...Args> std::size_t formatInto(const Containers::ArrayView<char>& buffer, const CompiledFormat<argumentCount, chunkCapacity>& format, const Args&... args) {
+    static_assert(sizeof...(args) == argumentCount, "argument count doesn't match the format string");
+    Implementation::BufferFormatter formatters[sizeof...(args) + 1] { Implementation::BufferFormatter{args}..., {} };
+    return Implementation::formatInto(buffer, format.chunks(), format.chunkCount(), formatters);
+}
+
+/**
+@brief Format a string into a file using a compiled format string
+@m_since_latest
+
+Same as @ref formatInto(std::FILE*, const char*, const Args&... args), except
+that the format string is already parsed and its argument count is checked at
+compile time.
+@experimental
+*/
+template<std::size_t argumentCount, std::size_t chunkCapacity, class ...Args> void formatInto(std::FILE* file, const CompiledFormat<argumentCount, chunkCapacity>& format, const Args&... args) {
+    static_assert(sizeof...(args) == argumentCount, "argument count doesn't match the format string");
+    Implementation::FileFormatter formatters[sizeof...(args) + 1] { Implementation::FileFormatter{args}..., {} };
+    Implementation::formatInto(file, format.chunks(), format.chunkCount(), formatters);
+}
+
+/**
+@brief Format a string and append it to a growable array using a compiled format string
+@m_since_latest
+
+Same as @ref formatInto(Containers::Array<char>&, const char*, const Args&... args),
+except that the format string is already parsed and its argument count is
+checked at compile time.
+@experimental
+*/
+template<std::size_t argumentCount, std::size_t chunkCapacity, class ...Args> std::size_t formatInto(Containers::Array<char>& buffer, const CompiledFormat<argumentCount, chunkCapacity>& format, const Args&... args) {
+    static_assert(sizeof...(args) == argumentCount, "argument count doesn't match the format string");
+    Implementation::BufferFormatter formatters[sizeof...(args) + 1] { Implementation::BufferFormatter{args}..., {} };
+    return Implementation::formatInto(buffer, format.chunks(), format.chunkCount(), formatters);
+}
+
+/**
+@brief Print a string to the standard output using a compiled format string
+@m_since_latest
+
+@experimental
+*/
+template<std::size_t argumentCount, std::size_t chunkCapacity, class ...Args> inline void print(const CompiledFormat<argumentCount, chunkCapacity>& format, const Args&... args) {
+    return formatInto(stdout, format, args...);
+}
+
+/**
+@brief Print a string to the standard error output using a compiled format string
+@m_since_latest
+
+@experimental
+*/
+template<std::size_t argumentCount, std::size_t chunkCapacity, class ...Args> inline void printError(const CompiledFormat<argumentCount, chunkCapacity>& format, const Args&... args) {
+    return formatInto(stderr, format, args...);
+}
+
 #ifndef DOXYGEN_GENERATING_OUTPUT
 template<class ...Args, class Array> Array format(const char* format, const Args&... args) {
     Array array;
     /* array is nullptr here, so we get just the size. Can't pass just nullptr,
-       because that would match the formatInto(std::FILE*) overload :( */
-    const std::size_t size = formatInto(array, format, args...);
-    /* printf() always wants to print the null terminator, so allow it, and
-       then recreate the Array to be of a correct size again. Once we switch
-       away from printf() this workaround could be removed. The upcoming
+       because that would match the formatInto(std::FILE*) overload :( The
+       array is passed as a view to not match the appending
+       formatInto(Containers::Array<char>&) overload. */
+    const std::size_t size = formatInto(array.prefix(std::size_t{}), format, args...);
+    /* printf() (which is still used as a fallback for some floating-point
+       values) always wants to print the null terminator, so allow it, and
+       then recreate the Array to be of a correct size again. The upcoming
        Containers::String class will probably have something similar, though
        implicit. */
     array = Array{size + 1};
-    formatInto(array, format, args...);
+    formatInto(array.prefix(size + 1), format, args...);
+    return Array{array.release(), size};
+}
+
+template<std::size_t argumentCount, std::size_t chunkCapacity, class ...Args, class Array> Array format(const CompiledFormat<argumentCount, chunkCapacity>& format, const Args&... args) {
+    Array array;
+    /* Same as format(const char*, const Args&...) above */
+    const std::size_t size = formatInto(array.prefix(std::size_t{}), format, args...);
+    array = Array{size + 1};
+    formatInto(array.prefix(size + 1), format, args...);
     return Array{array.release(), size};
 }
 #endif
@@ -344,6 +755,11 @@ template<class ...Args> void formatInto(std::FILE* file, const char* format, con
     Implementation::formatInto(file, format, formatters, sizeof...(args));
 }
 
+template<class ...Args> std::size_t formatInto(Containers::Array<char>& buffer, const char* format, const Args&... args) {
+    Implementation::BufferFormatter formatters[sizeof...(args) + 1] { Implementation::BufferFormatter{args}..., {} };
+    return Implementation::formatInto(buffer, format, formatters, sizeof...(args));
+}
+
 }}
 
 #endif
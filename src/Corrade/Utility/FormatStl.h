@@ -63,6 +63,28 @@ language.
 */
 template<class ...Args> std::size_t formatInto(std::string& string, std::size_t offset, const char* format, const Args&... args);
 
+/**
+@brief Format a string using a compiled format string
+@m_since_latest
+
+Same as @ref formatString(const char*, const Args&... args), except that the
+format string is already parsed and its argument count is checked at compile
+time. See @ref CORRADE_FORMAT() for more information.
+@experimental
+*/
+template<std::size_t argumentCount, std::size_t chunkCapacity, class ...Args> std::string formatString(const CompiledFormat<argumentCount, chunkCapacity>& format, const Args&... args);
+
+/**
+@brief Format a string into an existing string using a compiled format string
+@m_since_latest
+
+Same as @ref formatInto(std::string&, std::size_t, const char*, const Args&... args),
+except that the format string is already parsed and its argument count is
+checked at compile time. See @ref CORRADE_FORMAT() for more information.
+@experimental
+*/
+template<std::size_t argumentCount, std::size_t chunkCapacity, class ...Args> std::size_t formatInto(std::string& string, std::size_t offset, const CompiledFormat<argumentCount, chunkCapacity>& format, const Args&... args);
+
 namespace Implementation {
 
 template<> struct Formatter<std::string> {
@@ -71,6 +93,7 @@ template<> struct Formatter<std::string> {
 };
 
 CORRADE_UTILITY_EXPORT std::size_t formatInto(std::string& buffer, std::size_t offset, const char* format, BufferFormatter* formatters, std::size_t formattersCount);
+CORRADE_UTILITY_EXPORT std::size_t formatInto(std::string& buffer, std::size_t offset, const FormatChunk* chunks, std::size_t chunkCount, BufferFormatter* formatters);
 
 }
 
@@ -85,6 +108,18 @@ template<class ...Args> std::size_t formatInto(std::string& buffer, std::size_t
     return Implementation::formatInto(buffer, offset, format, formatters, sizeof...(args));
 }
 
+template<std::size_t argumentCount, std::size_t chunkCapacity, class ...Args> std::string formatString(const CompiledFormat<argumentCount, chunkCapacity>& format, const Args&... args) {
+    std::string buffer;
+    formatInto(buffer, 0, format, args...);
+    return buffer;
+}
+
+template<std::size_t argumentCount, std::size_t chunkCapacity, class ...Args> std::size_t formatInto(std::string& buffer, std::size_t offset, const CompiledFormat<argumentCount, chunkCapacity>& format, const Args&... args) {
+    static_assert(sizeof...(args) == argumentCount, "argument count doesn't match the format string");
+    Implementation::BufferFormatter formatters[sizeof...(args) + 1] { Implementation::BufferFormatter{args}..., {} };
+    return Implementation::formatInto(buffer, offset, format.chunks(), format.chunkCount(), formatters);
+}
+
 }}
 
 #endif
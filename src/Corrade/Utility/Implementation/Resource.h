@@ -25,10 +25,15 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cstdint>
 #include <cstring>
 #include <algorithm>
+#include <string>
 #include <Corrade/Containers/ArrayView.h>
 
+#include "Corrade/Utility/Resource.h"
+#include "Corrade/Utility/visibility.h"
+
 namespace Corrade { namespace Utility { namespace Implementation {
 
 inline Containers::ArrayView<const char> resourceFilenameAt(const unsigned int* const positions, const unsigned char* const filenames, const std::size_t i) {
@@ -38,9 +43,12 @@ inline Containers::ArrayView<const char> resourceFilenameAt(const unsigned int*
     return {reinterpret_cast<const char*>(filenames) + begin, end - begin};
 }
 
-inline Containers::ArrayView<const char> resourceDataAt(const unsigned int* const positions, const unsigned char* const data, const std::size_t i) {
-    /* Every position pair denotes end offsets of one file, data is second */
-    const std::size_t begin = i == 0 ? 0 : positions[2*(i - 1) + 1];
+inline Containers::ArrayView<const char> resourceDataAt(const unsigned int* const positions, const unsigned int* const alignment, const unsigned char* const data, const std::size_t i) {
+    /* Every position pair denotes end offsets of one file, data is second.
+       If there's an alignment, the previous end offset is rounded up to it
+       to skip the padding. */
+    std::size_t begin = i == 0 ? 0 : positions[2*(i - 1) + 1];
+    if(alignment) begin = (begin + alignment[i] - 1) & ~std::size_t(alignment[i] - 1);
     const std::size_t end = positions[2*i + 1];
     return {reinterpret_cast<const char*>(data) + begin, end - begin};
 }
@@ -76,6 +84,92 @@ inline std::size_t resourceLookup(const unsigned int count, const unsigned int*
     return i;
 }
 
+/* Runtime variant of resourceHash() from Resource.h, same result but a loop
+   instead of recursion */
+inline std::uint32_t resourceHash(const Containers::ArrayView<const char> data) {
+    std::uint32_t hash = 2166136261u;
+    for(const char c: data) {
+        hash ^= std::uint8_t(c);
+        hash *= 16777619u;
+    }
+
+    return resourceHashFinalize(hash);
+}
+
+/* Build a minimal perfect hash table for given sorted filenames, consisting
+   of count pairs. Filenames are first distributed into count buckets by an
+   unseeded hash, first value of i-th pair is then a seed for filenames in
+   bucket i such that the seeded hash maps each of them to a unique slot, and
+   the second value of i-th pair is index of the filename in slot i. Returns
+   false if no seed was found for some bucket, which can happen only with
+   duplicate filenames or filenames with colliding 32-bit hashes. Defined in
+   Resource.cpp. */
+CORRADE_UTILITY_EXPORT bool resourceHashTable(unsigned int count, const unsigned int* positions, const unsigned char* filenames, unsigned int* out);
+
+/* Look up a particular filename with a precalculated resourceHash() in a
+   hash table generated by resourceHashTable(). Returns either its index or
+   count if not found. */
+inline std::size_t resourceHashLookup(const unsigned int count, const unsigned int* const hashTable, const unsigned int* const positions, const unsigned char* const filenames, const Containers::ArrayView<const char> filename, const std::uint32_t hash) {
+    if(!count) return count;
+
+    const std::uint32_t seed = hashTable[2*(hash % count)];
+    const std::size_t i = hashTable[2*(resourceSeededHash(hash, seed) % count) + 1];
+
+    /* The slot is always occupied, but the filename might not be the same */
+    const Containers::ArrayView<const char> foundFilename = resourceFilenameAt(positions, filenames, i);
+    if(filename.size() != foundFilename.size() || std::memcmp(filename, foundFilename, filename.size())) return count;
+
+    return i;
+}
+
+inline std::size_t resourceHashLookup(const unsigned int count, const unsigned int* const hashTable, const unsigned int* const positions, const unsigned char* const filenames, const Containers::ArrayView<const char> filename) {
+    return resourceHashLookup(count, hashTable, positions, filenames, filename, resourceHash(filename));
+}
+
+/* Compression of a file, first value of each pair in
+   ResourceGroup::compression. The second is size of the decompressed data. */
+enum: unsigned int {
+    ResourceCompressionNone = 0,
+    ResourceCompressionLz4 = 1
+};
+
+/* Header of a resource pack generated by Resource::compilePackFrom(). All
+   values are 32-bit little-endian. The header is followed by the group name
+   including a null terminator, then positions, the hash table, compression,
+   alignment and duplicates arrays in the same layout as in ResourceGroup,
+   each of the last four present only if the corresponding ResourcePack*
+   flag is set, and then the filenames. The name and filenames are padded
+   to four bytes to keep the arrays after them aligned. Data are at
+   dataOffset, which is a multiple of the largest file alignment. */
+struct ResourcePackHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t count;
+    std::uint32_t flags;
+    std::uint32_t groupSize;        /* Excluding the null terminator */
+    std::uint32_t filenamesSize;
+    std::uint32_t dataOffset;
+    std::uint32_t dataSize;
+};
+
+constexpr char ResourcePackMagic[8]{'C', 'O', 'R', 'R', 'P', 'A', 'C', 'K'};
+
+enum: std::uint32_t {
+    ResourcePackVersion = 1,
+
+    ResourcePackHashTable = 1 << 0,
+    ResourcePackCompression = 1 << 1,
+    ResourcePackAlignment = 1 << 2,
+    ResourcePackDuplicates = 1 << 3
+};
+
+/* Compress the data in the LZ4 block format. Defined in Resource.cpp. */
+CORRADE_UTILITY_EXPORT std::string resourceCompressLz4(Containers::ArrayView<const char> data);
+
+/* Decompress LZ4 block data. Returns false if the data are malformed or don't
+   decompress to exactly the size of out. Defined in Resource.cpp. */
+CORRADE_UTILITY_EXPORT bool resourceDecompressLz4(Containers::ArrayView<const char> data, Containers::ArrayView<char> out);
+
 }}}
 
 #endif
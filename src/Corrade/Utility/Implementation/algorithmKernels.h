@@ -0,0 +1,51 @@
+#ifndef Corrade_Utility_Implementation_algorithmKernels_h
+#define Corrade_Utility_Implementation_algorithmKernels_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstddef>
+
+#include "Corrade/Utility/Algorithms.h"
+#include "Corrade/Utility/Cpu.h"
+
+namespace Corrade { namespace Utility { namespace Implementation {
+
+/* Kernels operating on contiguous data of a particular AlgorithmType.
+   Exposed so all variants can be tested. The minmax() kernel expects at least
+   one item, find() and mismatch() return the size if nothing is found. */
+struct AlgorithmKernels {
+    std::size_t(*find)(const void* data, std::size_t size, const void* value);
+    std::size_t(*count)(const void* data, std::size_t size, const void* value);
+    std::size_t(*mismatch)(const void* a, const void* b, std::size_t size);
+    void(*minmax)(const void* data, std::size_t size, void* min, void* max);
+    void(*sum)(const void* data, std::size_t size, void* sum);
+};
+
+/* Return the best kernels available for given type and features */
+CORRADE_UTILITY_EXPORT AlgorithmKernels algorithmKernels(AlgorithmType type, Cpu::Features features);
+
+}}}
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef Corrade_Utility_Implementation_fileWatcher_h
+#define Corrade_Utility_Implementation_fileWatcher_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstdint>
+
+#include "Corrade/Utility/FileWatcher.h"
+
+namespace Corrade { namespace Utility { namespace Implementation {
+
+/* Filenames are kept in the native encoding to avoid converting them on
+   every check */
+#if defined(CORRADE_TARGET_UNIX) || defined(CORRADE_TARGET_EMSCRIPTEN)
+typedef char FileWatcherChar;
+#elif defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
+typedef wchar_t FileWatcherChar;
+#else
+#error
+#endif
+
+/* Shared between FileWatcher and FileWatcherSet. Checks the file modification
+   time against time, which is ~std::uint64_t{} if not checked yet, and
+   updates it. If the file can't be queried, prints an error and, unless
+   FileWatcher::Flag::IgnoreErrors is set, resets valid to false. Returns
+   true if the file changed. The current file size is saved to size, or
+   ~std::uint64_t{} if the file can't be queried. */
+bool fileWatcherCheck(const FileWatcherChar* filename, FileWatcher::Flags flags, std::uint64_t& time, bool& valid, std::uint64_t& size);
+
+/* Hash of the file contents for FileWatcher::Flag::CheckContents, size is
+   what fileWatcherCheck() returned. If the file can't be read, prints an
+   error and returns ~std::uint64_t{}. Safe to call from multiple threads. */
+std::uint64_t fileWatcherHash(const FileWatcherChar* filename, std::uint64_t size);
+
+}}}
+
+#endif
@@ -25,8 +25,9 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <atomic>
+#include <cstdint>
 #include <string>
-#include <set>
 #include <tuple>
 #include <vector>
 
@@ -37,6 +38,19 @@ namespace Corrade { namespace Utility { namespace Implementation {
 
 /* Needs to be exposed like this so we can test it */
 
+/* Value of a variable that's read by the application. Written only by
+   Tweakable::registerVariable() and update() and read from any thread without
+   locking -- the epoch is odd while a write is in progress and the readers
+   retry if it changed while they were copying the value. The storage is
+   atomic to make the concurrent copy well-defined. */
+struct TweakableValue {
+    std::atomic<std::uint32_t> epoch{};
+    std::atomic<std::uint64_t> storage[TweakableStorageSize/8]{};
+};
+
+CORRADE_UTILITY_EXPORT void publishTweakableValue(TweakableValue& value, const char* data);
+CORRADE_UTILITY_EXPORT void readTweakableValue(const TweakableValue& value, char* out);
+
 struct TweakableVariable {
     /* Align so we can safely save 64bit types without worrying about unaligned
        access. */
@@ -46,10 +60,36 @@ struct TweakableVariable {
     void(*scopeLambda)(void(*)(), void*){};
     void(*scopeUserCall)(){};
     void* scopeUserData{};
+    /* Where the storage is published to after a successful parse. Null if
+       the variable wasn't registered by the application. */
+    TweakableValue* value{};
+};
+
+/* Scope lambda, user call and user data. Kept in a sorted array without
+   duplicates. */
+typedef std::tuple<void(*)(void(*)(), void*), void(*)(), void*> TweakableScope;
+
+/* Position right after the closing parenthesis of an annotation, which is
+   where the parser is never inside a comment or a literal, together with the
+   line it's on and whether the corresponding variable had a parser assigned
+   when the annotation was last parsed */
+struct TweakableAnnotation {
+    std::size_t end;
+    int line;
+    bool known;
+};
+
+/* Result of the last successful parse of a file, used to skip the parts that
+   didn't change since. The data is empty if there was no successful parse
+   yet. */
+struct TweakableParseCache {
+    std::string name;
+    std::string data;
+    std::vector<TweakableAnnotation> annotations;
 };
 
 CORRADE_UTILITY_EXPORT std::string findTweakableAlias(const std::string& file);
-CORRADE_UTILITY_EXPORT TweakableState parseTweakables(const std::string& name, const std::string& filename, const std::string& data, std::vector<TweakableVariable>& variables, std::set<std::tuple<void(*)(void(*)(), void*), void(*)(), void*>>& scopes);
+CORRADE_UTILITY_EXPORT TweakableState parseTweakables(const std::string& name, const std::string& filename, const std::string& data, std::vector<TweakableVariable>& variables, std::vector<TweakableScope>& scopes, TweakableParseCache* cache = nullptr);
 
 }}}
 
@@ -26,11 +26,17 @@
 */
 
 /** @file
- * @brief Macro @ref CORRADE_DEPRECATED(), @ref CORRADE_DEPRECATED_ALIAS(), @ref CORRADE_DEPRECATED_NAMESPACE(), @ref CORRADE_DEPRECATED_ENUM(), @ref CORRADE_DEPRECATED_FILE(), @ref CORRADE_DEPRECATED_MACRO(), @ref CORRADE_IGNORE_DEPRECATED_PUSH, @ref CORRADE_IGNORE_DEPRECATED_POP, @ref CORRADE_UNUSED, @ref CORRADE_ALIGNAS(), @ref CORRADE_NORETURN, @ref CORRADE_FALLTHROUGH, @ref CORRADE_THREAD_LOCAL, @ref CORRADE_ALWAYS_INLINE, @ref CORRADE_NEVER_INLINE, @ref CORRADE_FUNCTION, @ref CORRADE_LINE_STRING, @ref CORRADE_AUTOMATIC_INITIALIZER(), @ref CORRADE_AUTOMATIC_FINALIZER()
+ * @brief Macro @ref CORRADE_DEPRECATED(), @ref CORRADE_DEPRECATED_ALIAS(), @ref CORRADE_DEPRECATED_NAMESPACE(), @ref CORRADE_DEPRECATED_ENUM(), @ref CORRADE_DEPRECATED_FILE(), @ref CORRADE_DEPRECATED_MACRO(), @ref CORRADE_IGNORE_DEPRECATED_PUSH, @ref CORRADE_IGNORE_DEPRECATED_POP, @ref CORRADE_UNUSED, @ref CORRADE_ALIGNAS(), @ref CORRADE_NORETURN, @ref CORRADE_FALLTHROUGH, @ref CORRADE_THREAD_LOCAL, @ref CORRADE_ALWAYS_INLINE, @ref CORRADE_NEVER_INLINE, @ref CORRADE_CONSTEXPR14, @ref CORRADE_LIKELY(), @ref CORRADE_UNLIKELY(), @ref CORRADE_PREFETCH(), @ref CORRADE_RESTRICT, @ref CORRADE_ASSUME_ALIGNED(), @ref CORRADE_FUNCTION, @ref CORRADE_LINE_STRING, @ref CORRADE_AUTOMATIC_INITIALIZER(), @ref CORRADE_AUTOMATIC_FINALIZER()
  */
 
+#include <cstddef>
+
 #include "Corrade/configure.h"
 
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_IX86) || defined(_M_X64))
+#include <xmmintrin.h>
+#endif
+
 #ifndef DOXYGEN_GENERATING_OUTPUT
 /* Internal macro implementation */
 #define _CORRADE_HELPER_PASTE2(a, b) a ## b
@@ -394,6 +400,137 @@ elsewhere. Example usage:
 #define CORRADE_NEVER_INLINE
 #endif
 
+/** @hideinitializer
+@brief C++14 constexpr
+@m_since_latest
+
+Expands to @cpp constexpr @ce if compiling with C++14 or newer and empty
+otherwise. Meant for functions that are usable in a constant expression only
+with the relaxed C++14 rules, such as functions containing loops or non-const
+member functions. Empty also on MSVC 2015, which doesn't implement the C++14
+rules properly even though it reports itself as C++14-capable.
+@see @ref CORRADE_CXX_STANDARD
+*/
+#if CORRADE_CXX_STANDARD >= 201402 && !defined(CORRADE_MSVC2015_COMPATIBILITY)
+#define CORRADE_CONSTEXPR14 constexpr
+#else
+#define CORRADE_CONSTEXPR14
+#endif
+
+/** @hideinitializer
+@brief Mark a condition as likely
+@m_since_latest
+
+Hints the compiler that the condition is almost always @cpp true @ce, so it
+can lay out the code with the common path falling through. Expands to
+@cpp __builtin_expect(!!(condition), 1) @ce on GCC and Clang
+([docs](https://gcc.gnu.org/onlinedocs/gcc/Other-Builtins.html)) and to just
+the parenthesized condition elsewhere, as MSVC has no equivalent usable in an
+expression. The macro is variadic to allow commas in the condition. Example
+usage:
+
+@snippet Utility.cpp CORRADE_LIKELY
+
+Use only on conditions that are known to be heavily biased --- for example
+error handling or bounds checks --- as a wrong hint makes the code slower.
+@see @ref CORRADE_UNLIKELY(), @ref CORRADE_ASSUME()
+*/
+#ifdef __GNUC__
+#define CORRADE_LIKELY(...) __builtin_expect(!!(__VA_ARGS__), 1)
+#else
+#define CORRADE_LIKELY(...) (__VA_ARGS__)
+#endif
+
+/** @hideinitializer
+@brief Mark a condition as unlikely
+@m_since_latest
+
+Counterpart to @ref CORRADE_LIKELY(), hints the compiler that the condition
+is almost always @cpp false @ce. Expands to
+@cpp __builtin_expect(!!(condition), 0) @ce on GCC and Clang and to just the
+parenthesized condition elsewhere. Used by @ref CORRADE_ASSERT() and related
+macros for the failure branch, which thus doesn't pollute the hot path of
+bounds checks in the containers.
+*/
+#ifdef __GNUC__
+#define CORRADE_UNLIKELY(...) __builtin_expect(!!(__VA_ARGS__), 0)
+#else
+#define CORRADE_UNLIKELY(...) (__VA_ARGS__)
+#endif
+
+/** @hideinitializer
+@brief Prefetch memory
+@param address  Address to prefetch
+@param rw       @cpp 0 @ce if the memory is going to be read, @cpp 1 @ce if
+    written to. Has to be a compile-time constant.
+@param locality Temporal locality, from @cpp 0 @ce (no locality, the data
+    can be evicted from the cache right after access) to @cpp 3 @ce (high
+    locality, keep in all cache levels). Has to be a compile-time constant.
+@m_since_latest
+
+Hints the processor to start fetching given address into the cache, to be
+used when a loop knows which memory it's going to access a few iterations
+ahead. Expands to @cpp __builtin_prefetch() @ce on GCC and Clang
+([docs](https://gcc.gnu.org/onlinedocs/gcc/Other-Builtins.html)), to
+@cpp _mm_prefetch() @ce on MSVC on x86, where @p rw is ignored, and to a
+no-op elsewhere. The prefetch never faults, so it's fine to pass an address
+past the end of an array. Example usage:
+
+@snippet Utility.cpp CORRADE_PREFETCH
+*/
+#ifdef __GNUC__
+#define CORRADE_PREFETCH(address, rw, locality) __builtin_prefetch((address), (rw), (locality))
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#define CORRADE_PREFETCH(address, rw, locality) _mm_prefetch(reinterpret_cast<const char*>(address), (locality) == 3 ? _MM_HINT_T0 : (locality) == 2 ? _MM_HINT_T1 : (locality) == 1 ? _MM_HINT_T2 : _MM_HINT_NTA)
+#else
+#define CORRADE_PREFETCH(address, rw, locality) static_cast<void>(address)
+#endif
+
+/** @hideinitializer
+@brief Restrict-qualify a pointer
+@m_since_latest
+
+Promises the compiler that memory accessed through given pointer isn't
+accessed through any other pointer in the same scope, allowing it to
+vectorize loops and keep values in registers across stores. Expands to
+@cpp __restrict__ @ce on GCC and Clang, to @cpp __restrict @ce on MSVC and
+is empty elsewhere. Example usage:
+
+@snippet Utility.cpp CORRADE_RESTRICT
+
+Passing overlapping memory to a function with restrict-qualified parameters
+is undefined behavior.
+*/
+#ifdef __GNUC__
+#define CORRADE_RESTRICT __restrict__
+#elif defined(_MSC_VER)
+#define CORRADE_RESTRICT __restrict
+#else
+#define CORRADE_RESTRICT
+#endif
+
+/** @hideinitializer
+@brief Assume a pointer is aligned
+@param pointer      Pointer
+@param alignment    Alignment in bytes. Has to be a compile-time constant
+    power of two.
+@m_since_latest
+
+Returns @p pointer with the same type, hinting the compiler that it's aligned
+to @p alignment bytes so it can use aligned loads and stores and skip
+peeling of loop prologues. Uses @cpp __builtin_assume_aligned() @ce on GCC
+and Clang ([docs](https://gcc.gnu.org/onlinedocs/gcc/Other-Builtins.html)),
+@cpp __assume() @ce on MSVC and returns the pointer unchanged elsewhere.
+Example usage:
+
+@snippet Utility.cpp CORRADE_ASSUME_ALIGNED
+
+If the pointer isn't actually aligned, the behavior is undefined.
+@see @ref CORRADE_ASSUME(), @ref CORRADE_ALIGNAS()
+*/
+#define CORRADE_ASSUME_ALIGNED(pointer, alignment)                          \
+    Corrade::Utility::Implementation::assumeAligned<alignment>(pointer)
+
 /** @hideinitializer
 @brief Function name
 @m_since{2019,10}
@@ -502,4 +639,25 @@ compiler command line, see @ref CORRADE_NOOP().
     } Finalizer_##function;
 #endif
 
+#ifndef DOXYGEN_GENERATING_OUTPUT
+namespace Corrade { namespace Utility { namespace Implementation {
+
+/* Used by CORRADE_ASSUME_ALIGNED(), a function in order to have the pointer
+   type preserved */
+template<std::size_t alignment, class T> CORRADE_ALWAYS_INLINE T* assumeAligned(T* pointer) {
+    static_assert(alignment && !(alignment & (alignment - 1)),
+        "alignment expected to be a power of two");
+    #ifdef __GNUC__
+    return static_cast<T*>(__builtin_assume_aligned(pointer, alignment));
+    #elif defined(_MSC_VER)
+    __assume((reinterpret_cast<std::size_t>(pointer) & (alignment - 1)) == 0);
+    return pointer;
+    #else
+    return pointer;
+    #endif
+}
+
+}}}
+#endif
+
 #endif
@@ -0,0 +1,348 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Memory.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "Corrade/Utility/Assert.h"
+#include "Corrade/Utility/Debug.h"
+
+#ifdef CORRADE_TARGET_UNIX
+#include <cerrno>
+#include <sys/mman.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+#elif defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
+#include <windows.h>
+#endif
+
+namespace Corrade { namespace Utility { namespace Memory {
+
+std::size_t pageSize() {
+    #ifdef CORRADE_TARGET_UNIX
+    static const std::size_t size = sysconf(_SC_PAGESIZE);
+    return size;
+    #elif defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
+    static const std::size_t size = [] {
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return std::size_t(info.dwAllocationGranularity);
+    }();
+    return size;
+    #else
+    return 4096;
+    #endif
+}
+
+Debug& operator<<(Debug& debug, const PageSize value) {
+    debug << "Utility::Memory::PageSize" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case PageSize::value: return debug << "::" #value;
+        _c(Default)
+        _c(TransparentHuge)
+        _c(Huge)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(std::size_t(value)) << Debug::nospace << ")";
+}
+
+std::size_t hugePageSize() {
+    #if defined(CORRADE_TARGET_UNIX) && defined(__linux__)
+    static const std::size_t size = [] {
+        std::size_t size = 0;
+        std::FILE* const f = std::fopen("/proc/meminfo", "r");
+        if(!f) return size;
+        char line[256];
+        while(std::fgets(line, sizeof(line), f)) {
+            unsigned long kilobytes;
+            if(std::sscanf(line, "Hugepagesize: %lu kB", &kilobytes) == 1) {
+                size = std::size_t(kilobytes)*1024;
+                break;
+            }
+        }
+        std::fclose(f);
+        return size;
+    }();
+    return size;
+    #elif defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
+    static const std::size_t size = GetLargePageMinimum();
+    return size;
+    #else
+    return 0;
+    #endif
+}
+
+std::size_t pageSize(const PageSize pageSize) {
+    #if defined(CORRADE_TARGET_UNIX) && defined(__linux__)
+    if(pageSize != PageSize::Default && hugePageSize())
+        return hugePageSize();
+    #elif defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
+    if(pageSize == PageSize::Huge && hugePageSize())
+        return hugePageSize();
+    #else
+    static_cast<void>(pageSize);
+    #endif
+    return Memory::pageSize();
+}
+
+namespace {
+
+#ifdef CORRADE_TARGET_UNIX
+void adviseHugePages(void* const data, const std::size_t size, const PageSize pageSize) {
+    #ifdef MADV_HUGEPAGE
+    /* Explicit huge pages that couldn't be mapped fall back to transparent
+       ones */
+    if(pageSize != PageSize::Default)
+        madvise(data, size, MADV_HUGEPAGE);
+    #else
+    static_cast<void>(data);
+    static_cast<void>(size);
+    static_cast<void>(pageSize);
+    #endif
+}
+
+void applyNumaPolicy(void* const data, const std::size_t size, const int numaNode) {
+    #if defined(__linux__) && defined(SYS_mbind) && defined(SYS_get_mempolicy)
+    if(numaNode == NumaNodeLocal || !size) return;
+
+    /* Values from linux/mempolicy.h, which isn't always available. Calling
+       the syscalls directly to avoid a dependency on libnuma. */
+    enum: int {
+        MpolPreferred = 1,
+        MpolInterleave = 3,
+        MpolFMemsAllowed = 4
+    };
+    enum: std::size_t { MaskBits = 1024 };
+    unsigned long mask[MaskBits/(8*sizeof(unsigned long))]{};
+
+    int mode;
+    if(numaNode == NumaNodeInterleaved) {
+        /* Interleave across all nodes the process is allowed to use */
+        if(syscall(SYS_get_mempolicy, nullptr, mask, MaskBits, nullptr, MpolFMemsAllowed) != 0)
+            return;
+        mode = MpolInterleave;
+    } else {
+        if(numaNode < 0 || std::size_t(numaNode) >= MaskBits) return;
+        mask[numaNode/(8*sizeof(unsigned long))] |= 1ul << (numaNode % (8*sizeof(unsigned long)));
+        mode = MpolPreferred;
+    }
+
+    /* The kernel uses one bit less than the passed count. The policy is just
+       a hint, so failures (such as when running on a kernel without NUMA
+       support) are ignored. */
+    syscall(SYS_mbind, data, size, mode, mask, MaskBits + 1, 0);
+    #else
+    static_cast<void>(data);
+    static_cast<void>(size);
+    static_cast<void>(numaNode);
+    #endif
+}
+#endif
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
+
+/* Reserve generously on 64-bit so remapPages() can grow in-place. The
+   address space is large enough to not care; on 32-bit reserve just what's
+   needed. */
+std::size_t reservationSize(const std::size_t size) {
+    #ifdef _WIN64
+    std::size_t reservation = std::size_t{64}*1024*1024;
+    while(reservation < size*4) reservation *= 2;
+    return reservation;
+    #else
+    return size;
+    #endif
+}
+
+bool commitPages(void* const data, const std::size_t size, const int numaNode) {
+    if(numaNode >= 0)
+        return VirtualAllocExNuma(GetCurrentProcess(), data, size, MEM_COMMIT, PAGE_READWRITE, DWORD(numaNode));
+    return VirtualAlloc(data, size, MEM_COMMIT, PAGE_READWRITE);
+}
+#endif
+
+}
+
+void* mapPages(const std::size_t size) {
+    return mapPages(size, PageSize::Default, NumaNodeLocal);
+}
+
+void* mapPages(const std::size_t size, const PageSize pageSize, const int numaNode) {
+    CORRADE_ASSERT(size % Memory::pageSize(pageSize) == 0,
+        "Utility::Memory::mapPages(): size" << size << "is not a multiple of page size" << Memory::pageSize(pageSize), nullptr);
+
+    #ifdef CORRADE_TARGET_UNIX
+    void* data = MAP_FAILED;
+    #ifdef MAP_HUGETLB
+    if(pageSize == PageSize::Huge)
+        data = mmap(nullptr, size, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB, -1, 0);
+    #endif
+    /* If explicit huge pages aren't requested or there are none available,
+       map regular pages */
+    if(data == MAP_FAILED) {
+        data = mmap(nullptr, size, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+        if(data == MAP_FAILED) {
+            Error{} << "Utility::Memory::mapPages(): can't map" << size << "bytes:" << std::strerror(errno);
+            return nullptr;
+        }
+        adviseHugePages(data, size, pageSize);
+    }
+    /* The pages are not touched yet, so the policy applies to all of them */
+    applyNumaPolicy(data, size, numaNode);
+    return data;
+    #elif defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
+    /* Large pages have to be reserved and committed at once, so such
+       allocation can't be grown in-place later. If that fails, for example
+       because the process doesn't have the privilege, map regular pages. */
+    if(pageSize == PageSize::Huge && size && hugePageSize()) {
+        void* const data = numaNode >= 0 ?
+            VirtualAllocExNuma(GetCurrentProcess(), nullptr, size, MEM_RESERVE|MEM_COMMIT|MEM_LARGE_PAGES, PAGE_READWRITE, DWORD(numaNode)) :
+            VirtualAlloc(nullptr, size, MEM_RESERVE|MEM_COMMIT|MEM_LARGE_PAGES, PAGE_READWRITE);
+        if(data) return data;
+    }
+
+    void* data = VirtualAlloc(nullptr, reservationSize(size), MEM_RESERVE, PAGE_NOACCESS);
+    /* If reserving generously fails, try again with just what's needed */
+    if(!data) data = VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+    if(!data || (size && !commitPages(data, size, numaNode))) {
+        Error{} << "Utility::Memory::mapPages(): can't map" << size << "bytes, error" << GetLastError();
+        if(data) VirtualFree(data, 0, MEM_RELEASE);
+        return nullptr;
+    }
+    return data;
+    #else
+    static_cast<void>(numaNode);
+    void* const data = std::calloc(size, 1);
+    if(!data) {
+        Error{} << "Utility::Memory::mapPages(): can't allocate" << size << "bytes";
+        return nullptr;
+    }
+    return data;
+    #endif
+}
+
+void* remapPages(void* const data, const std::size_t size, const std::size_t newSize) {
+    return remapPages(data, size, newSize, PageSize::Default, NumaNodeLocal);
+}
+
+void* remapPages(void* const data, const std::size_t size, const std::size_t newSize, const PageSize pageSize, const int numaNode) {
+    CORRADE_ASSERT(newSize % Memory::pageSize(pageSize) == 0,
+        "Utility::Memory::remapPages(): size" << newSize << "is not a multiple of page size" << Memory::pageSize(pageSize), nullptr);
+
+    if(size == newSize) return data;
+
+    #if defined(CORRADE_TARGET_UNIX) && defined(__linux__)
+    void* const newData = mremap(data, size, newSize, MREMAP_MAYMOVE);
+    if(newData == MAP_FAILED) {
+        /* Older kernels can't remap explicit huge pages, map a new region
+           and copy in that case */
+        if(pageSize == PageSize::Huge) {
+            void* const copiedData = mapPages(newSize, pageSize, numaNode);
+            if(!copiedData) return nullptr;
+            std::memcpy(copiedData, data, size < newSize ? size : newSize);
+            munmap(data, size);
+            return copiedData;
+        }
+
+        Error{} << "Utility::Memory::remapPages(): can't remap" << size << "bytes to" << newSize << "bytes:" << std::strerror(errno);
+        return nullptr;
+    }
+
+    /* The advice and the policy may not be inherited by the added pages if
+       the mapping was moved, apply them again */
+    if(newSize > size) {
+        adviseHugePages(newData, newSize, pageSize);
+        applyNumaPolicy(static_cast<char*>(newData) + size, newSize - size, numaNode);
+    }
+    return newData;
+    #elif defined(CORRADE_TARGET_UNIX)
+    /* Shrinking just unmaps the extra pages */
+    if(newSize < size) {
+        munmap(static_cast<char*>(data) + newSize, size - newSize);
+        return data;
+    }
+
+    void* const newData = mapPages(newSize, pageSize, numaNode);
+    if(!newData) return nullptr;
+    std::memcpy(newData, data, size);
+    munmap(data, size);
+    return newData;
+    #elif defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
+    /* Shrinking decommits the extra pages, keeping them reserved */
+    if(newSize < size) {
+        VirtualFree(static_cast<char*>(data) + newSize, size - newSize, MEM_DECOMMIT);
+        return data;
+    }
+
+    /* If there's enough reserved space after the committed pages, commit
+       more */
+    MEMORY_BASIC_INFORMATION info;
+    char* const end = static_cast<char*>(data) + size;
+    if(VirtualQuery(end, &info, sizeof(info)) && info.AllocationBase == data && info.State == MEM_RESERVE && info.RegionSize >= newSize - size && commitPages(end, newSize - size, numaNode))
+        return data;
+
+    /* Otherwise allocate a new reservation and copy. This is always the case
+       for large pages, which are committed together with the reservation. */
+    void* const newData = mapPages(newSize, pageSize, numaNode);
+    if(!newData) return nullptr;
+    std::memcpy(newData, data, size);
+    VirtualFree(data, 0, MEM_RELEASE);
+    return newData;
+    #else
+    static_cast<void>(pageSize);
+    static_cast<void>(numaNode);
+    void* const newData = std::realloc(data, newSize);
+    if(!newData) {
+        Error{} << "Utility::Memory::remapPages(): can't reallocate" << size << "bytes to" << newSize << "bytes";
+        return nullptr;
+    }
+    if(newSize > size)
+        std::memset(static_cast<char*>(newData) + size, 0, newSize - size);
+    return newData;
+    #endif
+}
+
+void unmapPages(void* const data, const std::size_t size) {
+    #ifdef CORRADE_TARGET_UNIX
+    munmap(data, size);
+    #elif defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
+    static_cast<void>(size);
+    VirtualFree(data, 0, MEM_RELEASE);
+    #else
+    static_cast<void>(size);
+    std::free(data);
+    #endif
+}
+
+}}}
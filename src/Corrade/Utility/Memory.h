@@ -0,0 +1,236 @@
+#ifndef Corrade_Utility_Memory_h
+#define Corrade_Utility_Memory_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Namespace @ref Corrade::Utility::Memory
+ * @m_since_latest
+ */
+
+#include <cstddef>
+
+#include "Corrade/Utility/Utility.h"
+#include "Corrade/Utility/visibility.h"
+
+namespace Corrade { namespace Utility {
+
+/**
+@brief Memory utilities
+@m_since_latest
+
+Low-level access to virtual memory, used for example by
+@ref Containers::ArrayMappedAllocator to grow large arrays without copying.
+
+@section Utility-Memory-placement Huge pages and NUMA placement
+
+The @ref mapPages(std::size_t, PageSize, int) and
+@ref remapPages(void*, std::size_t, std::size_t, PageSize, int) overloads
+additionally allow requesting huge pages, which reduce TLB pressure when
+accessing large arrays, and placing the pages on particular NUMA nodes. All of
+these are just hints --- if given platform doesn't support them or the system
+has no huge pages available, the memory is silently mapped with regular pages
+and the default placement.
+
+This library is built if `WITH_UTILITY` is enabled when building Corrade. To
+use this library with CMake, request the `Utility` component of the `Corrade`
+package and link to the `Corrade::Utility` target.
+
+@code{.cmake}
+find_package(Corrade REQUIRED Utility)
+
+# ...
+target_link_libraries(your-app PRIVATE Corrade::Utility)
+@endcode
+
+See also @ref building-corrade and @ref corrade-cmake for more information.
+*/
+namespace Memory {
+
+/**
+@brief Size of a virtual memory page
+@m_since_latest
+
+On Unix systems queries @cpp sysconf(_SC_PAGESIZE) @ce, on Windows returns the
+allocation granularity from @cpp GetSystemInfo() @ce, as that's the
+granularity in which @ref mapPages() reserves memory. On other platforms
+returns @cpp 4096 @ce.
+*/
+CORRADE_UTILITY_EXPORT std::size_t pageSize();
+
+/**
+@brief Page size to request when mapping memory
+@m_since_latest
+
+@see @ref pageSize(PageSize), @ref mapPages(std::size_t, PageSize, int)
+*/
+enum class PageSize: unsigned char {
+    /** Regular pages */
+    Default,
+
+    /**
+     * Transparent huge pages. On Linux the mapping is marked with
+     * @cpp madvise(MADV_HUGEPAGE) @ce, letting the kernel back it with huge
+     * pages whenever it can. Treated as @ref PageSize::Default elsewhere.
+     */
+    TransparentHuge,
+
+    /**
+     * Explicit huge pages. On Linux uses @cpp mmap() @ce with
+     * @cpp MAP_HUGETLB @ce, which needs the huge pages to be reserved by the
+     * administrator upfront, and if that fails continues as
+     * @ref PageSize::TransparentHuge. On Windows uses @cpp VirtualAlloc() @ce
+     * with @cpp MEM_LARGE_PAGES @ce, which needs the process to have the
+     * `SeLockMemoryPrivilege`, and if that fails continues as
+     * @ref PageSize::Default. Treated as @ref PageSize::Default elsewhere.
+     */
+    Huge
+};
+
+/**
+@debugoperatorenum{PageSize}
+@m_since_latest
+*/
+CORRADE_UTILITY_EXPORT Debug& operator<<(Debug& debug, PageSize value);
+
+/**
+@brief Allocate memory on the NUMA node of the thread that first touches it
+@m_since_latest
+
+The system default. Can be passed to @ref mapPages(std::size_t, PageSize, int)
+and @ref remapPages(void*, std::size_t, std::size_t, PageSize, int) in place
+of a NUMA node index.
+*/
+constexpr int NumaNodeLocal = -1;
+
+/**
+@brief Interleave memory pages across all NUMA nodes
+@m_since_latest
+
+Spreads the bandwidth of memory accessed from threads running on all nodes.
+Can be passed to @ref mapPages(std::size_t, PageSize, int) and
+@ref remapPages(void*, std::size_t, std::size_t, PageSize, int) in place of a
+NUMA node index. Supported only on Linux, treated as @ref NumaNodeLocal
+elsewhere.
+*/
+constexpr int NumaNodeInterleaved = -2;
+
+/**
+@brief Size of a huge page
+@m_since_latest
+
+On Linux returns the default huge page size from `/proc/meminfo`, on Windows
+the value of @cpp GetLargePageMinimum() @ce. Returns @cpp 0 @ce if huge pages
+are not supported.
+@see @ref pageSize(PageSize)
+*/
+CORRADE_UTILITY_EXPORT std::size_t hugePageSize();
+
+/**
+@brief Mapping granularity for given page size
+@m_since_latest
+
+Returns @ref hugePageSize() for @ref PageSize::Huge and, on Linux, for
+@ref PageSize::TransparentHuge, if huge pages are supported. Otherwise returns
+@ref pageSize(). Sizes passed to @ref mapPages(std::size_t, PageSize, int) and
+@ref remapPages(void*, std::size_t, std::size_t, PageSize, int) are expected
+to be a multiple of this value.
+*/
+CORRADE_UTILITY_EXPORT std::size_t pageSize(PageSize pageSize);
+
+/**
+@brief Map zero-initialized memory pages
+@m_since_latest
+
+Expects that @p size is a multiple of @ref pageSize(). On Unix systems uses
+anonymous @cpp mmap() @ce, on Windows reserves a larger region of address
+space using @cpp VirtualAlloc() @ce and commits only the first @p size bytes
+of it, so @ref remapPages() can later grow the allocation in-place. On other
+platforms delegates to @ref std::calloc(). Returns @cpp nullptr @ce and
+prints a message to @ref Error if the mapping fails.
+@see @ref unmapPages()
+*/
+CORRADE_UTILITY_EXPORT void* mapPages(std::size_t size);
+
+/**
+@brief Map zero-initialized memory pages with given page size and NUMA placement
+@m_since_latest
+
+Like @ref mapPages(std::size_t), but expects that @p size is a multiple of
+@ref pageSize(PageSize) and requests pages of given size. If @p numaNode is
+a non-negative node index, the pages are preferably allocated on given node,
+otherwise it's expected to be either @ref NumaNodeLocal or
+@ref NumaNodeInterleaved. On Linux the NUMA policy is applied with the
+@cpp mbind() @ce syscall, without a dependency on `libnuma`, on Windows an
+explicit node is passed to @cpp VirtualAllocExNuma() @ce. Failures to
+apply the page size or the NUMA policy are not reported, see
+@ref Utility-Memory-placement for details.
+*/
+CORRADE_UTILITY_EXPORT void* mapPages(std::size_t size, PageSize pageSize, int numaNode = NumaNodeLocal);
+
+/**
+@brief Resize a page mapping
+@m_since_latest
+
+Expects that @p data was returned from @ref mapPages() or @ref remapPages()
+with @p size and that @p newSize is a multiple of @ref pageSize(). Contents
+of the mapping up to the smaller of the two sizes are preserved. On Linux
+uses @cpp mremap() @ce, which only updates page tables and never copies the
+data. On Windows commits or decommits pages in the reserved region, which
+also doesn't copy as long as the reservation is large enough. On other Unix
+systems maps a new region and copies the data, on remaining platforms
+delegates to @ref std::realloc(). When shrinking, the pages at the end are
+given back to the OS. Returns the new location of the data, which might be
+different from @p data, or @cpp nullptr @ce and prints a message to
+@ref Error if the remapping fails, in which case @p data stays valid.
+*/
+CORRADE_UTILITY_EXPORT void* remapPages(void* data, std::size_t size, std::size_t newSize);
+
+/**
+@brief Resize a page mapping with given page size and NUMA placement
+@m_since_latest
+
+Like @ref remapPages(void*, std::size_t, std::size_t), but expects that
+@p newSize is a multiple of @ref pageSize(PageSize) and that @p pageSize and
+@p numaNode are the same as passed to
+@ref mapPages(std::size_t, PageSize, int) when creating the mapping. The
+newly added pages are requested with the same page size and NUMA placement.
+Mappings with explicit huge pages can't be resized in-place on all systems,
+in which case a new mapping is created and the data copied.
+*/
+CORRADE_UTILITY_EXPORT void* remapPages(void* data, std::size_t size, std::size_t newSize, PageSize pageSize, int numaNode = NumaNodeLocal);
+
+/**
+@brief Unmap memory pages
+@m_since_latest
+
+Expects that @p data was returned from @ref mapPages() or @ref remapPages()
+with @p size.
+*/
+CORRADE_UTILITY_EXPORT void unmapPages(void* data, std::size_t size);
+
+}}}
+
+#endif
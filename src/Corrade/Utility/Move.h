@@ -0,0 +1,112 @@
+#ifndef Corrade_Utility_Move_h
+#define Corrade_Utility_Move_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Corrade::Utility::forward(), @ref Corrade::Utility::move(), @ref Corrade::Utility::swap()
+ * @m_since_latest
+ */
+
+#include <type_traits>
+
+#include "Corrade/configure.h"
+#include "Corrade/Utility/Macros.h"
+
+namespace Corrade { namespace Utility {
+
+/**
+@brief Forward an rvalue as an rvalue
+@m_since_latest
+
+Equivalent to @ref std::forward(), which is used to implement perfect
+forwarding, but without the @cpp #include <utility> @ce dependency --- on
+libstdc++ in C++20 mode it's about twice the size of @cpp #include <type_traits> @ce
+alone. It's used by the core container and debug headers to keep their
+compile times low, @ref std::forward() can be used interchangeably in user
+code.
+@see @ref move()
+*/
+template<class T> constexpr T&& forward(typename std::remove_reference<T>::type& t) noexcept {
+    return static_cast<T&&>(t);
+}
+
+/**
+@brief Forward an rvalue as an rvalue
+@m_since_latest
+*/
+template<class T> constexpr T&& forward(typename std::remove_reference<T>::type&& t) noexcept {
+    static_assert(!std::is_lvalue_reference<T>::value, "T can't be a lvalue reference");
+    return static_cast<T&&>(t);
+}
+
+/**
+@brief Convert a value to an rvalue
+@m_since_latest
+
+Equivalent to @ref std::move() without the @cpp #include <utility> @ce
+dependency. See @ref forward() for more information.
+*/
+template<class T> constexpr typename std::remove_reference<T>::type&& move(T&& t) noexcept {
+    return static_cast<typename std::remove_reference<T>::type&&>(t);
+}
+
+/**
+@brief Swap two values
+@m_since_latest
+
+Equivalent to @ref std::swap() without the @cpp #include <utility> @ce
+dependency. The second argument is deliberately not deduced, making the
+overload less specialized than @ref std::swap() and thus avoiding ambiguity if
+both are found via ADL in the usual @cpp using Utility::swap; swap(a, b); @ce
+pattern:
+
+@snippet Utility.cpp swap
+*/
+template<class T> CORRADE_CONSTEXPR14 void swap(T& a, typename std::common_type<T>::type& b) noexcept(std::is_nothrow_move_constructible<T>::value && std::is_nothrow_move_assignable<T>::value) {
+    T tmp = static_cast<T&&>(a);
+    a = static_cast<T&&>(b);
+    b = static_cast<T&&>(tmp);
+}
+
+/**
+@brief Swap two arrays
+@m_since_latest
+
+Swaps the arrays element by element using @ref swap(T&, typename std::common_type<T>::type&).
+*/
+template<std::size_t size, class T> CORRADE_CONSTEXPR14 void swap(T(&a)[size], typename std::common_type<T(&)[size]>::type b) noexcept(std::is_nothrow_move_constructible<T>::value && std::is_nothrow_move_assignable<T>::value) {
+    for(std::size_t i = 0; i != size; ++i) {
+        /* Not calling swap() to avoid ADL picking up std::swap() and having
+           to include <utility> for it */
+        T tmp = static_cast<T&&>(a[i]);
+        a[i] = static_cast<T&&>(b[i]);
+        b[i] = static_cast<T&&>(tmp);
+    }
+}
+
+}}
+
+#endif
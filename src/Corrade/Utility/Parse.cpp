@@ -0,0 +1,445 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Parse.h"
+
+#include <cfloat>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+
+#include "Corrade/Containers/ArrayView.h"
+#include "Corrade/Containers/StridedArrayView.h"
+#include "Corrade/Utility/Assert.h"
+#include "Corrade/Utility/Debug.h"
+
+namespace Corrade { namespace Utility {
+
+namespace {
+
+/* Value of a digit in bases up to 36, returns 36 for characters that aren't
+   digits in any base */
+inline int digitValue(const char c) {
+    if(c >= '0' && c <= '9') return c - '0';
+    const char lowercase = c | 0x20;
+    if(lowercase >= 'a' && lowercase <= 'z') return lowercase - 'a' + 10;
+    return 36;
+}
+
+/* Returns count of consumed digits or 0 if there are none or the value is
+   larger than max */
+std::size_t parseMagnitude(const char* const begin, const char* const end, const unsigned int base, const unsigned long long max, unsigned long long& out) {
+    unsigned long long value = 0;
+    bool overflow = false;
+    const char* i = begin;
+    for(; i != end; ++i) {
+        const unsigned int digit = digitValue(*i);
+        if(digit >= base) break;
+        if(value > (max - digit)/base) overflow = true;
+        else value = value*base + digit;
+    }
+
+    if(i == begin || overflow) return 0;
+    out = value;
+    return i - begin;
+}
+
+template<class T> std::size_t parseUnsigned(const Containers::ArrayView<const char> string, T& out, const int base) {
+    CORRADE_ASSERT(base >= 2 && base <= 36,
+        "Utility::parseNumber(): base" << base << "out of range", {});
+
+    unsigned long long magnitude;
+    const std::size_t size = parseMagnitude(string.begin(), string.end(), base, std::numeric_limits<T>::max(), magnitude);
+    if(size) out = T(magnitude);
+    return size;
+}
+
+template<class T> std::size_t parseSigned(const Containers::ArrayView<const char> string, T& out, const int base) {
+    CORRADE_ASSERT(base >= 2 && base <= 36,
+        "Utility::parseNumber(): base" << base << "out of range", {});
+
+    const bool negative = !string.empty() && string[0] == '-';
+    const unsigned long long max = negative ?
+        0ull - static_cast<unsigned long long>(std::numeric_limits<T>::min()) :
+        static_cast<unsigned long long>(std::numeric_limits<T>::max());
+    unsigned long long magnitude;
+    const std::size_t size = parseMagnitude(string.begin() + negative, string.end(), base, max, magnitude);
+    if(!size) return 0;
+
+    /* Done this way to avoid overflow with the minimal value */
+    out = negative && magnitude ? T(-static_cast<long long>(magnitude - 1) - 1) : T(magnitude);
+    return negative + size;
+}
+
+/* Exactly representable powers of ten */
+constexpr const double PowersOfTen[]{
+    1.0e0, 1.0e1, 1.0e2, 1.0e3, 1.0e4, 1.0e5, 1.0e6, 1.0e7, 1.0e8, 1.0e9,
+    1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15, 1.0e16, 1.0e17, 1.0e18,
+    1.0e19, 1.0e20, 1.0e21, 1.0e22
+};
+constexpr const float PowersOfTenFloat[]{
+    1.0e0f, 1.0e1f, 1.0e2f, 1.0e3f, 1.0e4f, 1.0e5f, 1.0e6f, 1.0e7f, 1.0e8f,
+    1.0e9f, 1.0e10f
+};
+
+/* The fast paths rely on each operation being rounded to the type
+   precision, which isn't the case with x87 extended precision */
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+#define CORRADE_PARSE_EXACT_ARITHMETIC
+#endif
+
+/* A decimal number split into parts. The mantissa has the first 19
+   significant digits, the value is mantissa*10^exponent if not truncated. */
+struct Decimal {
+    const char* digitsBegin;
+    const char* digitsEnd;
+    std::uint64_t mantissa;
+    long long exponent;
+    long long explicitExponent;
+    std::size_t fractionDigits;
+    bool negative;
+    bool truncated;
+};
+
+enum: int { MaxMantissaDigits = 19 };
+
+/* Case-insensitive comparison with a lowercase literal */
+bool startsWithLowercase(const char* const begin, const char* const end, const char* const lowercase, const std::size_t size) {
+    if(std::size_t(end - begin) < size) return false;
+    for(std::size_t i = 0; i != size; ++i)
+        if((begin[i] | 0x20) != lowercase[i]) return false;
+    return true;
+}
+
+/* Returns 0 if the string isn't a number */
+std::size_t scanDecimal(const Containers::ArrayView<const char> string, Decimal& out) {
+    const char* i = string.begin();
+    const char* const end = string.end();
+    out.negative = i != end && *i == '-';
+    if(out.negative) ++i;
+
+    out.digitsBegin = i;
+    out.mantissa = 0;
+    out.exponent = 0;
+    out.fractionDigits = 0;
+    out.truncated = false;
+    int significantDigits = 0;
+    bool anyDigits = false;
+    bool fraction = false;
+    for(; i != end; ++i) {
+        if(*i == '.' && !fraction) {
+            fraction = true;
+            continue;
+        }
+        if(*i < '0' || *i > '9') break;
+        anyDigits = true;
+        if(fraction) ++out.fractionDigits;
+
+        /* Leading zeros only affect the exponent */
+        const unsigned int digit = *i - '0';
+        if(!digit && !significantDigits) {
+            if(fraction) --out.exponent;
+            continue;
+        }
+
+        if(significantDigits < MaxMantissaDigits) {
+            out.mantissa = out.mantissa*10 + digit;
+            ++significantDigits;
+            if(fraction) --out.exponent;
+        } else {
+            if(!fraction) ++out.exponent;
+            if(digit) out.truncated = true;
+        }
+    }
+
+    if(!anyDigits) return 0;
+    out.digitsEnd = i;
+
+    /* Exponent, consumed only if there are some digits */
+    out.explicitExponent = 0;
+    if(i != end && (*i == 'e' || *i == 'E')) {
+        const char* j = i + 1;
+        const bool negativeExponent = j != end && *j == '-';
+        if(j != end && (*j == '-' || *j == '+')) ++j;
+        const char* const exponentBegin = j;
+        long long exponent = 0;
+        for(; j != end && *j >= '0' && *j <= '9'; ++j)
+            /* Anything larger than this is zero or an infinity anyway */
+            if(exponent < 100000) exponent = exponent*10 + (*j - '0');
+        if(j != exponentBegin) {
+            out.explicitExponent = negativeExponent ? -exponent : exponent;
+            out.exponent += out.explicitExponent;
+            i = j;
+        }
+    }
+
+    return i - string.begin();
+}
+
+template<class T> struct FloatTraits;
+template<> struct FloatTraits<float> {
+    static float convert(const char* string, char** end) {
+        return std::strtof(string, end);
+    }
+};
+template<> struct FloatTraits<double> {
+    static double convert(const char* string, char** end) {
+        return std::strtod(string, end);
+    }
+};
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+template<> struct FloatTraits<long double> {
+    static long double convert(const char* string, char** end) {
+        return std::strtold(string, end);
+    }
+};
+#endif
+
+/* Converts a canonical digits-and-exponent form without a decimal point and
+   thus not affected by the locale */
+template<class T> T convertCanonical(const Decimal& decimal) {
+    char buffer[128];
+    std::string large;
+    const std::size_t digitCount = decimal.digitsEnd - decimal.digitsBegin;
+    /* Sign, digits, 'e', exponent sign, up to 20 exponent digits, \0 */
+    char* out;
+    if(digitCount + 24 <= sizeof(buffer)) out = buffer;
+    else {
+        large.resize(digitCount + 24);
+        out = &large[0];
+    }
+
+    char* i = out;
+    if(decimal.negative) *i++ = '-';
+    for(const char* c = decimal.digitsBegin; c != decimal.digitsEnd; ++c)
+        if(*c != '.') *i++ = *c;
+    *i++ = 'e';
+
+    const long long exponent = decimal.explicitExponent - static_cast<long long>(decimal.fractionDigits);
+    if(exponent < 0) *i++ = '-';
+    unsigned long long exponentMagnitude = exponent < 0 ? 0ull - static_cast<unsigned long long>(exponent) : exponent;
+    char exponentDigits[20];
+    std::size_t exponentDigitCount = 0;
+    do {
+        exponentDigits[exponentDigitCount++] = char('0' + exponentMagnitude % 10);
+        exponentMagnitude /= 10;
+    } while(exponentMagnitude);
+    while(exponentDigitCount) *i++ = exponentDigits[--exponentDigitCount];
+    *i = '\0';
+
+    return FloatTraits<T>::convert(out, nullptr);
+}
+
+/* Returns 0 if the string isn't a special value */
+template<class T> std::size_t parseSpecial(const Containers::ArrayView<const char> string, T& out) {
+    const bool negative = !string.empty() && string[0] == '-';
+    const char* const begin = string.begin() + negative;
+    std::size_t size;
+    if(startsWithLowercase(begin, string.end(), "infinity", 8)) {
+        out = std::numeric_limits<T>::infinity();
+        size = 8;
+    } else if(startsWithLowercase(begin, string.end(), "inf", 3)) {
+        out = std::numeric_limits<T>::infinity();
+        size = 3;
+    } else if(startsWithLowercase(begin, string.end(), "nan", 3)) {
+        out = std::numeric_limits<T>::quiet_NaN();
+        size = 3;
+    } else return 0;
+
+    if(negative) out = -out;
+    return negative + size;
+}
+
+}
+
+std::size_t parseNumber(const Containers::ArrayView<const char> string, int& out, const int base) {
+    return parseSigned(string, out, base);
+}
+
+std::size_t parseNumber(const Containers::ArrayView<const char> string, unsigned int& out, const int base) {
+    return parseUnsigned(string, out, base);
+}
+
+std::size_t parseNumber(const Containers::ArrayView<const char> string, short& out, const int base) {
+    return parseSigned(string, out, base);
+}
+
+std::size_t parseNumber(const Containers::ArrayView<const char> string, unsigned short& out, const int base) {
+    return parseUnsigned(string, out, base);
+}
+
+std::size_t parseNumber(const Containers::ArrayView<const char> string, long& out, const int base) {
+    return parseSigned(string, out, base);
+}
+
+std::size_t parseNumber(const Containers::ArrayView<const char> string, unsigned long& out, const int base) {
+    return parseUnsigned(string, out, base);
+}
+
+std::size_t parseNumber(const Containers::ArrayView<const char> string, long long& out, const int base) {
+    return parseSigned(string, out, base);
+}
+
+std::size_t parseNumber(const Containers::ArrayView<const char> string, unsigned long long& out, const int base) {
+    return parseUnsigned(string, out, base);
+}
+
+std::size_t parseNumber(const Containers::ArrayView<const char> string, double& out) {
+    Decimal decimal;
+    const std::size_t size = scanDecimal(string, decimal);
+    if(!size) return parseSpecial(string, out);
+
+    /* Clinger's fast path -- if both the mantissa and the power of ten are
+       exactly representable, a single multiplication or division gives a
+       correctly rounded result. If the power of ten is too large, some of it
+       can be moved to the mantissa if that stays exact. */
+    #ifdef CORRADE_PARSE_EXACT_ARITHMETIC
+    if(!decimal.truncated && decimal.mantissa <= (1ull << 53)) {
+        double value;
+        bool exact = true;
+        if(!decimal.mantissa) value = 0.0;
+        else if(decimal.exponent >= 0 && decimal.exponent <= 22)
+            value = double(decimal.mantissa)*PowersOfTen[decimal.exponent];
+        else if(decimal.exponent < 0 && decimal.exponent >= -22)
+            value = double(decimal.mantissa)/PowersOfTen[-decimal.exponent];
+        else if(decimal.exponent > 22 && decimal.exponent <= 22 + 15 && decimal.mantissa <= (1ull << 53)/std::uint64_t(PowersOfTen[decimal.exponent - 22]))
+            value = double(decimal.mantissa*std::uint64_t(PowersOfTen[decimal.exponent - 22]))*PowersOfTen[22];
+        else exact = false;
+
+        if(exact) {
+            out = decimal.negative ? -value : value;
+            return size;
+        }
+    }
+    #endif
+
+    out = convertCanonical<double>(decimal);
+    return size;
+}
+
+std::size_t parseNumber(const Containers::ArrayView<const char> string, float& out) {
+    Decimal decimal;
+    const std::size_t size = scanDecimal(string, decimal);
+    if(!size) return parseSpecial(string, out);
+
+    /* Same as above, just with smaller limits */
+    #ifdef CORRADE_PARSE_EXACT_ARITHMETIC
+    if(!decimal.truncated && decimal.mantissa <= (1ull << 24)) {
+        float value;
+        bool exact = true;
+        if(!decimal.mantissa) value = 0.0f;
+        else if(decimal.exponent >= 0 && decimal.exponent <= 10)
+            value = float(decimal.mantissa)*PowersOfTenFloat[decimal.exponent];
+        else if(decimal.exponent < 0 && decimal.exponent >= -10)
+            value = float(decimal.mantissa)/PowersOfTenFloat[-decimal.exponent];
+        else exact = false;
+
+        if(exact) {
+            out = decimal.negative ? -value : value;
+            return size;
+        }
+    }
+    #endif
+
+    out = convertCanonical<float>(decimal);
+    return size;
+}
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+std::size_t parseNumber(const Containers::ArrayView<const char> string, long double& out) {
+    Decimal decimal;
+    const std::size_t size = scanDecimal(string, decimal);
+    if(!size) return parseSpecial(string, out);
+
+    out = convertCanonical<long double>(decimal);
+    return size;
+}
+#endif
+
+namespace {
+
+template<class T> std::size_t parseNumbersIntoImplementation(const Containers::ArrayView<const char> string, const Containers::StridedArrayView1D<T>& out, const char* const delimiters) {
+    const std::size_t delimiterCount = std::strlen(delimiters);
+    const auto isDelimiter = [&](const char c) {
+        return delimiterCount && std::memchr(delimiters, c, delimiterCount);
+    };
+
+    const char* i = string.begin();
+    const char* const end = string.end();
+    std::size_t count = 0;
+    while(count != out.size()) {
+        while(i != end && isDelimiter(*i)) ++i;
+        if(i == end) break;
+
+        /* A number directly followed by something else than a delimiter is
+           treated as invalid as well */
+        T value;
+        const std::size_t size = parseNumber({i, std::size_t(end - i)}, value);
+        if(!size || (i + size != end && !isDelimiter(i[size]))) break;
+
+        out[count++] = value;
+        i += size;
+    }
+
+    return count;
+}
+
+}
+
+std::size_t parseNumbersInto(const Containers::ArrayView<const char> string, const Containers::StridedArrayView1D<int>& out, const char* const delimiters) {
+    return parseNumbersIntoImplementation(string, out, delimiters);
+}
+
+std::size_t parseNumbersInto(const Containers::ArrayView<const char> string, const Containers::StridedArrayView1D<unsigned int>& out, const char* const delimiters) {
+    return parseNumbersIntoImplementation(string, out, delimiters);
+}
+
+std::size_t parseNumbersInto(const Containers::ArrayView<const char> string, const Containers::StridedArrayView1D<long>& out, const char* const delimiters) {
+    return parseNumbersIntoImplementation(string, out, delimiters);
+}
+
+std::size_t parseNumbersInto(const Containers::ArrayView<const char> string, const Containers::StridedArrayView1D<unsigned long>& out, const char* const delimiters) {
+    return parseNumbersIntoImplementation(string, out, delimiters);
+}
+
+std::size_t parseNumbersInto(const Containers::ArrayView<const char> string, const Containers::StridedArrayView1D<long long>& out, const char* const delimiters) {
+    return parseNumbersIntoImplementation(string, out, delimiters);
+}
+
+std::size_t parseNumbersInto(const Containers::ArrayView<const char> string, const Containers::StridedArrayView1D<unsigned long long>& out, const char* const delimiters) {
+    return parseNumbersIntoImplementation(string, out, delimiters);
+}
+
+std::size_t parseNumbersInto(const Containers::ArrayView<const char> string, const Containers::StridedArrayView1D<float>& out, const char* const delimiters) {
+    return parseNumbersIntoImplementation(string, out, delimiters);
+}
+
+std::size_t parseNumbersInto(const Containers::ArrayView<const char> string, const Containers::StridedArrayView1D<double>& out, const char* const delimiters) {
+    return parseNumbersIntoImplementation(string, out, delimiters);
+}
+
+}}
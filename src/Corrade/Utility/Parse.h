@@ -0,0 +1,216 @@
+#ifndef Corrade_Utility_Parse_h
+#define Corrade_Utility_Parse_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Corrade::Utility::parseNumber(), @ref Corrade::Utility::parseNumbersInto()
+ * @m_since_latest
+ */
+
+#include <cstddef>
+
+#include "Corrade/Containers/Containers.h"
+#include "Corrade/Utility/visibility.h"
+
+namespace Corrade { namespace Utility {
+
+/**
+@brief Parse an integer
+@param[in]  string  String to parse
+@param[out] out     Parsed value
+@param[in]  base    Numeric base, in range @cpp 2 @ce to @cpp 36 @ce
+@return Count of characters consumed by the number, @cpp 0 @ce if @p string
+    doesn't start with a number or the number doesn't fit into the type
+@m_since_latest
+
+Similar to @ref std::strtol() and friends, but locale-independent, the
+@p string doesn't need to be null-terminated and it's done without
+allocating. Equivalently to C++17 @cpp std::from_chars() @ce, leading
+whitespace, a @cpp '+' @ce sign or a @cpp 0x @ce prefix isn't accepted, a
+@cpp '-' @ce sign is accepted only for signed types. Digits above @cpp 9 @ce
+are letters in either case. The @p out value is modified only if the parsing
+succeeds.
+@see @ref parseNumber(Containers::ArrayView<const char>, double&)
+*/
+CORRADE_UTILITY_EXPORT std::size_t parseNumber(Containers::ArrayView<const char> string, int& out, int base = 10);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+CORRADE_UTILITY_EXPORT std::size_t parseNumber(Containers::ArrayView<const char> string, unsigned int& out, int base = 10);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+CORRADE_UTILITY_EXPORT std::size_t parseNumber(Containers::ArrayView<const char> string, short& out, int base = 10);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+CORRADE_UTILITY_EXPORT std::size_t parseNumber(Containers::ArrayView<const char> string, unsigned short& out, int base = 10);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+CORRADE_UTILITY_EXPORT std::size_t parseNumber(Containers::ArrayView<const char> string, long& out, int base = 10);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+CORRADE_UTILITY_EXPORT std::size_t parseNumber(Containers::ArrayView<const char> string, unsigned long& out, int base = 10);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+CORRADE_UTILITY_EXPORT std::size_t parseNumber(Containers::ArrayView<const char> string, long long& out, int base = 10);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+CORRADE_UTILITY_EXPORT std::size_t parseNumber(Containers::ArrayView<const char> string, unsigned long long& out, int base = 10);
+
+/**
+@brief Parse a floating-point value
+@param[in]  string  String to parse
+@param[out] out     Parsed value
+@return Count of characters consumed by the number, @cpp 0 @ce if @p string
+    doesn't start with a number
+@m_since_latest
+
+Similar to @ref std::strtod() and friends, but locale-independent, the
+@p string doesn't need to be null-terminated and it's done without
+allocating in the common case. Accepts an optional @cpp '-' @ce sign, decimal
+digits with an optional @cpp '.' @ce and an optional exponent, or
+case-insensitive @cpp inf @ce, @cpp infinity @ce and @cpp nan @ce.
+Equivalently to C++17 @cpp std::from_chars() @ce, leading whitespace, a
+@cpp '+' @ce sign or hexadecimal floats aren't accepted. An exponent without
+any digits isn't consumed.
+
+The result is always correctly rounded. Values with up to 19 significant
+digits and a small enough exponent, which is the case for most real-world
+data, are converted directly using exact floating-point arithmetic, other
+values go through @ref std::strtod() on a canonical representation that
+doesn't depend on the decimal point of current locale. Values out of range
+become an infinity or zero, same as with @ref std::strtod(). The @p out value
+is modified only if the parsing succeeds.
+*/
+CORRADE_UTILITY_EXPORT std::size_t parseNumber(Containers::ArrayView<const char> string, double& out);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+CORRADE_UTILITY_EXPORT std::size_t parseNumber(Containers::ArrayView<const char> string, float& out);
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+/**
+@overload
+@m_since_latest
+
+Always goes through @ref std::strtold() after validating the input.
+@partialsupport Not available in @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten" as
+    JavaScript doesn't support doubles larger than 64 bits.
+*/
+CORRADE_UTILITY_EXPORT std::size_t parseNumber(Containers::ArrayView<const char> string, long double& out);
+#endif
+
+/**
+@brief Parse a delimited list of numbers
+@param[in]  string      String to parse
+@param[out] out         Where to put the parsed values
+@param[in]  delimiters  Null-terminated list of delimiter characters
+@return Count of values parsed
+@m_since_latest
+
+The inverse of @ref formatNumbersInto(). Parses values with
+@ref parseNumber() and puts them into consecutive items of @p out. Any
+character from @p delimiters separates the values, a run of multiple
+delimiters is treated as a single one and delimiters at the beginning and the
+end are ignored. Integers are parsed as decimal. Parsing stops at the end of
+@p string, once @p out is filled or once a value isn't a valid number or isn't
+followed by a delimiter, items of @p out past the returned count are left
+untouched. Example usage, splitting CSV data on both commas and newlines:
+
+@snippet Utility.cpp formatNumbersInto
+
+Compare the returned value with the size of @p out to check that all values
+were parsed.
+@experimental
+*/
+CORRADE_UTILITY_EXPORT std::size_t parseNumbersInto(Containers::ArrayView<const char> string, const Containers::StridedArrayView1D<int>& out, const char* delimiters);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+CORRADE_UTILITY_EXPORT std::size_t parseNumbersInto(Containers::ArrayView<const char> string, const Containers::StridedArrayView1D<unsigned int>& out, const char* delimiters);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+CORRADE_UTILITY_EXPORT std::size_t parseNumbersInto(Containers::ArrayView<const char> string, const Containers::StridedArrayView1D<long>& out, const char* delimiters);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+CORRADE_UTILITY_EXPORT std::size_t parseNumbersInto(Containers::ArrayView<const char> string, const Containers::StridedArrayView1D<unsigned long>& out, const char* delimiters);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+CORRADE_UTILITY_EXPORT std::size_t parseNumbersInto(Containers::ArrayView<const char> string, const Containers::StridedArrayView1D<long long>& out, const char* delimiters);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+CORRADE_UTILITY_EXPORT std::size_t parseNumbersInto(Containers::ArrayView<const char> string, const Containers::StridedArrayView1D<unsigned long long>& out, const char* delimiters);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+CORRADE_UTILITY_EXPORT std::size_t parseNumbersInto(Containers::ArrayView<const char> string, const Containers::StridedArrayView1D<float>& out, const char* delimiters);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+CORRADE_UTILITY_EXPORT std::size_t parseNumbersInto(Containers::ArrayView<const char> string, const Containers::StridedArrayView1D<double>& out, const char* delimiters);
+
+}}
+
+#endif
@@ -0,0 +1,191 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Profiler.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+#include "Corrade/Containers/GrowableArray.h"
+#include "Corrade/Utility/FormatStl.h"
+
+namespace Corrade { namespace Utility {
+
+/* Each thread records into its own linked list of fixed-size chunks, so
+   recording needs neither locks nor reallocation. The count of zones in a
+   chunk is published with a release store after the zone is written, which
+   makes it possible to read the zones from other threads while recording.
+   Thread buffers are added to a global lock-free list on first use and are
+   never removed, as the zones recorded by a thread are needed also after the
+   thread exits. */
+
+namespace {
+
+constexpr std::size_t ChunkSize = 1024;
+
+struct Chunk {
+    Profiler::Zone zones[ChunkSize];
+    std::atomic<std::size_t> count{};
+    std::atomic<Chunk*> next{};
+};
+
+struct ThreadBuffer {
+    explicit ThreadBuffer(std::uint32_t thread): thread{thread} {}
+
+    const std::uint32_t thread;
+    Chunk first;
+    Chunk* last = &first;
+    ThreadBuffer* next{};
+};
+
+std::atomic<bool> enabled{};
+std::atomic<ThreadBuffer*> buffers{};
+std::atomic<std::uint32_t> threadCounter{};
+Profiler::BeginCallback beginCallback{};
+Profiler::EndCallback endCallback{};
+void* callbackState{};
+
+CORRADE_THREAD_LOCAL ThreadBuffer* currentBuffer = nullptr;
+
+ThreadBuffer& threadBuffer() {
+    if(!currentBuffer) {
+        ThreadBuffer* const buffer = new ThreadBuffer{++threadCounter};
+        buffer->next = buffers.load(std::memory_order_relaxed);
+        while(!buffers.compare_exchange_weak(buffer->next, buffer, std::memory_order_release, std::memory_order_relaxed));
+        currentBuffer = buffer;
+    }
+
+    return *currentBuffer;
+}
+
+inline std::uint64_t timestamp() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}
+
+bool Profiler::isEnabled() {
+    return enabled.load(std::memory_order_relaxed);
+}
+
+void Profiler::setEnabled(const bool enabled_) {
+    enabled.store(enabled_, std::memory_order_relaxed);
+}
+
+void Profiler::setCallbacks(const BeginCallback begin, const EndCallback end, void* const state) {
+    beginCallback = begin;
+    endCallback = end;
+    callbackState = state;
+}
+
+Containers::Array<Profiler::Zone> Profiler::zones() {
+    /* The list is prepended to, so collect the buffers first to return them
+       in the order the threads were registered */
+    Containers::Array<const ThreadBuffer*> threads;
+    for(const ThreadBuffer* buffer = buffers.load(std::memory_order_acquire); buffer; buffer = buffer->next)
+        arrayAppend(threads, buffer);
+
+    Containers::Array<Zone> out;
+    for(std::size_t i = threads.size(); i != 0; --i) {
+        for(const Chunk* chunk = &threads[i - 1]->first; chunk; chunk = chunk->next.load(std::memory_order_acquire))
+            arrayAppend(out, Containers::arrayView(chunk->zones, chunk->count.load(std::memory_order_acquire)));
+    }
+
+    return out;
+}
+
+std::string Profiler::chromeTrace() {
+    const Containers::Array<Zone> zones = Profiler::zones();
+
+    std::uint64_t traceBegin = ~std::uint64_t{};
+    for(const Zone& zone: zones)
+        if(zone.begin < traceBegin) traceBegin = zone.begin;
+
+    std::string out = "{\"traceEvents\":[";
+    for(std::size_t i = 0; i != zones.size(); ++i) {
+        const Zone& zone = zones[i];
+
+        /* Escape the few characters that would break the JSON */
+        std::string name;
+        for(const char* c = zone.name; *c; ++c) {
+            if(*c == '"' || *c == '\\') name += '\\';
+            name += *c;
+        }
+
+        /* Timestamps are in microseconds, printing the nanoseconds as a
+           fractional part */
+        const std::uint64_t begin = zone.begin - traceBegin;
+        const std::uint64_t duration = zone.end - zone.begin;
+        formatInto(out, out.size(), "{}\n{{\"name\":\"{}\",\"ph\":\"X\",\"ts\":{}.{:.3},\"dur\":{}.{:.3},\"pid\":0,\"tid\":{}}}",
+            i ? "," : "", name,
+            begin/1000, begin%1000, duration/1000, duration%1000, zone.thread);
+    }
+    out += "\n]}\n";
+    return out;
+}
+
+void Profiler::clear() {
+    for(ThreadBuffer* buffer = buffers.load(std::memory_order_acquire); buffer; buffer = buffer->next) {
+        Chunk* chunk = buffer->first.next.load(std::memory_order_relaxed);
+        while(chunk) {
+            Chunk* const next = chunk->next.load(std::memory_order_relaxed);
+            delete chunk;
+            chunk = next;
+        }
+
+        buffer->first.count.store(0, std::memory_order_relaxed);
+        buffer->first.next.store(nullptr, std::memory_order_relaxed);
+        buffer->last = &buffer->first;
+    }
+}
+
+ProfilerScope::ProfilerScope(const char* const name): _name{enabled.load(std::memory_order_relaxed) ? name : nullptr} {
+    if(!_name) return;
+    if(beginCallback) beginCallback(callbackState, _name);
+    _begin = timestamp();
+}
+
+ProfilerScope::~ProfilerScope() {
+    if(!_name) return;
+    const std::uint64_t end = timestamp();
+
+    ThreadBuffer& buffer = threadBuffer();
+    Chunk* chunk = buffer.last;
+    std::size_t count = chunk->count.load(std::memory_order_relaxed);
+    if(count == ChunkSize) {
+        Chunk* const next = new Chunk;
+        chunk->next.store(next, std::memory_order_release);
+        buffer.last = chunk = next;
+        count = 0;
+    }
+
+    chunk->zones[count] = Profiler::Zone{_name, _begin, end, buffer.thread};
+    chunk->count.store(count + 1, std::memory_order_release);
+
+    if(endCallback) endCallback(callbackState);
+}
+
+}}
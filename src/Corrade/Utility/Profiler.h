@@ -0,0 +1,236 @@
+#ifndef Corrade_Utility_Profiler_h
+#define Corrade_Utility_Profiler_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Utility::Profiler, @ref Corrade::Utility::ProfilerScope, macro @ref CORRADE_PROFILE_SCOPE()
+ * @m_since_latest
+ */
+
+#include "Corrade/Utility/Macros.h"
+#include "Corrade/Utility/StlForwardString.h"
+#include "Corrade/Utility/Utility.h"
+#include "Corrade/Utility/visibility.h"
+
+namespace Corrade { namespace Utility {
+
+/**
+@brief Scoped profiler
+@m_since_latest
+
+Records how long named scopes of code took, on all threads, meant for finding
+out where the time goes at runtime. A scope is marked with the
+@ref CORRADE_PROFILE_SCOPE() macro and the recorded zones can be exported as a
+[Chrome Trace](https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU/)
+JSON using @ref chromeTrace(), which can be then opened in
+[Perfetto](https://ui.perfetto.dev) or in `chrome://tracing`:
+
+@snippet Utility.cpp Profiler
+
+The profiler is disabled by default, in which case each scope costs just a
+single non-inline function call and a branch. When enabled, each thread
+records the zones into its own buffer, so recording doesn't need any locks
+and threads don't contend with each other. The buffers grow as needed and
+are kept until @ref clear() is called.
+
+Corrade itself marks its heavy operations such as
+@ref Configuration parsing, @ref PluginManager::AbstractManager::load(),
+@ref Resource group lookup and @ref Tweakable::update() with profiling
+scopes.
+
+@section Utility-Profiler-forwarding Forwarding to external profilers
+
+Using @ref setCallbacks() it's possible to forward the scopes to an external
+profiler such as [Intel ITT](https://github.com/intel/ittapi) or
+[Tracy](https://github.com/wolfpld/tracy). For example with ITT:
+
+@code{.cpp}
+__itt_domain* domain = __itt_domain_create("MyApp");
+Utility::Profiler::setCallbacks(
+    [](void* state, const char* name) {
+        __itt_task_begin(static_cast<__itt_domain*>(state), __itt_null,
+            __itt_null, __itt_string_handle_create(name));
+    },
+    [](void* state) {
+        __itt_task_end(static_cast<__itt_domain*>(state));
+    }, domain);
+Utility::Profiler::setEnabled(true);
+@endcode
+*/
+class CORRADE_UTILITY_EXPORT Profiler {
+    public:
+        /**
+         * @brief Recorded zone
+         *
+         * @see @ref zones()
+         */
+        struct Zone {
+            /** @brief Name passed to @ref CORRADE_PROFILE_SCOPE() */
+            const char* name;
+
+            /** @brief Begin timestamp in nanoseconds */
+            std::uint64_t begin;
+
+            /** @brief End timestamp in nanoseconds */
+            std::uint64_t end;
+
+            /**
+             * @brief Thread ID
+             *
+             * Sequential, starting from @cpp 1 @ce for the first thread that
+             * recorded a zone.
+             */
+            std::uint32_t thread;
+        };
+
+        /**
+         * @brief Zone begin callback
+         *
+         * @see @ref setCallbacks()
+         */
+        typedef void(*BeginCallback)(void* state, const char* name);
+
+        /**
+         * @brief Zone end callback
+         *
+         * @see @ref setCallbacks()
+         */
+        typedef void(*EndCallback)(void* state);
+
+        /** @brief Whether the profiler is enabled */
+        static bool isEnabled();
+
+        /**
+         * @brief Enable or disable the profiler
+         *
+         * Disabled by default. Scopes that were entered while the profiler
+         * was disabled aren't recorded even if the profiler gets enabled
+         * before they exit.
+         */
+        static void setEnabled(bool enabled);
+
+        /**
+         * @brief Set callbacks for forwarding to an external profiler
+         *
+         * The @p begin callback is called when a scope is entered and the
+         * @p end callback when it's exited, on the thread executing the
+         * scope, with @p state passed through. Called only while the
+         * profiler is enabled, in addition to recording the zones. Pass
+         * @cpp nullptr @ce to reset them. Not thread-safe --- expected to
+         * be called before other threads start executing profiled code.
+         * See @ref Utility-Profiler-forwarding for an example.
+         */
+        static void setCallbacks(BeginCallback begin, EndCallback end, void* state = nullptr);
+
+        /**
+         * @brief Recorded zones
+         *
+         * Zones from all threads, in order of the threads first recording a
+         * zone and in order of the scopes being exited within a thread. Can
+         * be called while other threads are recording, in which case zones
+         * recorded concurrently may or may not be included. Include
+         * @ref Corrade/Containers/Array.h to use the returned value.
+         */
+        static Containers::Array<Zone> zones();
+
+        /**
+         * @brief Recorded zones as a Chrome Trace JSON
+         *
+         * Each zone is a complete event with the timestamp in microseconds
+         * relative to the earliest recorded zone. Same as with @ref zones(),
+         * can be called while other threads are recording.
+         */
+        static std::string chromeTrace();
+
+        /**
+         * @brief Discard all recorded zones
+         *
+         * Not thread-safe --- expected to be called only when no other
+         * thread is executing profiled code.
+         */
+        static void clear();
+
+        explicit Profiler() = delete;
+};
+
+/**
+@brief Profiler scope
+@m_since_latest
+
+Records a zone from its construction to its destruction if the
+@ref Profiler is enabled. Usually not used directly, but through the
+@ref CORRADE_PROFILE_SCOPE() macro.
+*/
+class CORRADE_UTILITY_EXPORT ProfilerScope {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * The @p name is expected to stay in scope for as long as the
+         * recorded zones are accessed, usually it's a string literal.
+         */
+        explicit ProfilerScope(const char* name);
+
+        /** @brief Copying is not allowed */
+        ProfilerScope(const ProfilerScope&) = delete;
+
+        /** @brief Moving is not allowed */
+        ProfilerScope(ProfilerScope&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Records the zone.
+         */
+        ~ProfilerScope();
+
+        /** @brief Copying is not allowed */
+        ProfilerScope& operator=(const ProfilerScope&) = delete;
+
+        /** @brief Moving is not allowed */
+        ProfilerScope& operator=(ProfilerScope&&) = delete;
+
+    private:
+        /* Null if the profiler was disabled on construction */
+        const char* _name;
+        std::uint64_t _begin;
+};
+
+}}
+
+/** @hideinitializer
+@brief Profile the enclosing scope
+@param name     Zone name, usually a string literal
+@m_since_latest
+
+Records a zone of given name from this point until the end of the enclosing
+scope. See @ref Corrade::Utility::Profiler "Utility::Profiler" for more
+information.
+*/
+#define CORRADE_PROFILE_SCOPE(name)                                         \
+    Corrade::Utility::ProfilerScope _CORRADE_HELPER_PASTE(_corradeProfilerScope, __LINE__){name}
+
+#endif
@@ -30,8 +30,16 @@
 #endif
 #include <iomanip>
 #include <map>
+#include <memory>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
+#ifdef CORRADE_BUILD_MULTITHREADED
+#include <mutex>
+#endif
+#if defined(CORRADE_TARGET_UNIX) || defined(CORRADE_TARGET_EMSCRIPTEN) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+#include <sys/stat.h>
+#endif
 
 #include "Corrade/Containers/Array.h"
 #include "Corrade/Containers/Implementation/RawForwardList.h"
@@ -41,8 +49,13 @@
 #include "Corrade/Utility/DebugStl.h"
 #include "Corrade/Utility/Directory.h"
 #include "Corrade/Utility/FormatStl.h"
+#include "Corrade/Utility/Profiler.h"
+#include "Corrade/Utility/Sha1.h"
 #include "Corrade/Utility/Implementation/Resource.h"
 
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
+#include "Corrade/Utility/Unicode.h"
+#endif
 #if defined(CORRADE_TARGET_WINDOWS) && defined(CORRADE_BUILD_STATIC) && !defined(CORRADE_TARGET_WINDOWS_RT)
 #include "Corrade/Utility/Implementation/WindowsWeakSymbol.h"
 #endif
@@ -56,6 +69,30 @@ namespace Corrade { namespace Utility {
 namespace {
 #endif
 
+/* A file from an overriden group. Mapped if possible, shared among all
+   Resource instances using it and kept in memory for as long as any of them
+   exists. */
+struct ResourceOverrideFile {
+    std::uint64_t modificationTime;
+    std::size_t size;
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    Containers::Array<const char, Directory::MapDeleter> data;
+    #else
+    Containers::Array<char> data;
+    #endif
+};
+
+/* A pack loaded with Resource::loadPack(). The group points into the data,
+   which are mapped if possible. */
+struct ResourcePack {
+    Implementation::ResourceGroup group;
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    Containers::Array<const char, Directory::MapDeleter> data;
+    #else
+    Containers::Array<char> data;
+    #endif
+};
+
 struct ResourceGlobals {
     /* A linked list of resources. Managed using utilities from
        Containers/Implementation/RawForwardList.h, look there for more info. */
@@ -65,6 +102,16 @@ struct ResourceGlobals {
        Resource::overrideGroup() and stores a pointer to a function-local
        static variable from there. */
     std::map<std::string, std::string>* overrideGroups;
+
+    /* Files loaded from overriden groups, indexed by their path. This is only
+       allocated if any such file is accessed and stores a pointer to a
+       function-local static variable from there. */
+    std::map<std::string, std::shared_ptr<const ResourceOverrideFile>>* overrideFiles;
+
+    /* Packs loaded with Resource::loadPack(), indexed by their group name.
+       This is only allocated if the user calls Resource::loadPack() and
+       stores a pointer to a function-local static variable from there. */
+    std::map<std::string, std::unique_ptr<ResourcePack>>* packs;
 };
 
 #if !defined(CORRADE_BUILD_STATIC) || (defined(CORRADE_BUILD_STATIC) && !defined(CORRADE_TARGET_WINDOWS)) || defined(CORRADE_TARGET_WINDOWS_RT)
@@ -82,14 +129,14 @@ CORRADE_VISIBILITY_EXPORT
 /* The value of this variable is guaranteed to be zero-filled even before any
    resource initializers are executed, which means we don't hit any static
    initialization order fiasco. */
-ResourceGlobals resourceGlobals{nullptr, nullptr};
+ResourceGlobals resourceGlobals{nullptr, nullptr, nullptr, nullptr};
 #else
 /* On Windows the symbol is exported unmangled and then fetched via
    GetProcAddress() to emulate weak linking. Using an extern "C" block instead
    of just a function annotation because otherwise MinGW prints a warning:
    '...' initialized and declared 'extern' (uh?) */
 extern "C" {
-    CORRADE_VISIBILITY_EXPORT ResourceGlobals corradeUtilityUniqueWindowsResourceGlobals{nullptr, nullptr};
+    CORRADE_VISIBILITY_EXPORT ResourceGlobals corradeUtilityUniqueWindowsResourceGlobals{nullptr, nullptr, nullptr, nullptr};
 }
 #endif
 
@@ -119,17 +166,22 @@ ResourceGlobals& windowsResourceGlobals() {
 
 struct Resource::OverrideData {
     const Configuration conf;
-    std::map<std::string, Containers::Array<char>> data;
+    std::map<std::string, std::shared_ptr<const ResourceOverrideFile>> data;
 
     explicit OverrideData(const std::string& filename): conf(filename) {}
 };
 
 void Resource::registerData(Implementation::ResourceGroup& resource) {
+    CORRADE_PROFILE_SCOPE("Utility::Resource::registerData()");
     Containers::Implementation::forwardListInsert(resourceGlobals.groups, resource);
 }
 
 void Resource::unregisterData(Implementation::ResourceGroup& resource) {
     Containers::Implementation::forwardListRemove(resourceGlobals.groups, resource);
+
+    /* Free data decompressed on access, if any */
+    delete[] static_cast<Containers::Array<char>*>(resource.decompressed);
+    resource.decompressed = nullptr;
 }
 
 namespace {
@@ -139,6 +191,39 @@ std::pair<bool, Containers::Array<char>> fileContents(const std::string& filenam
     return {true, Directory::read(filename)};
 }
 
+/* Modification time in nanoseconds and size of a file, or false if it
+   doesn't exist. See FileWatcher::hasChanged() for details about the time
+   precision on various platforms. */
+bool fileStatus(const std::string& filename, std::uint64_t& modificationTime, std::size_t& size) {
+    #if defined(CORRADE_TARGET_UNIX) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    struct stat result;
+    if(stat(filename.data(), &result) != 0) return false;
+    #elif defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
+    struct _stat64 result;
+    if(_wstat64(Unicode::widen(filename).data(), &result) != 0) return false;
+    #else
+    /* No way to check, always reload */
+    if(!Directory::exists(filename)) return false;
+    modificationTime = ~std::uint64_t{};
+    size = ~std::size_t{};
+    return true;
+    #endif
+
+    #if defined(CORRADE_TARGET_UNIX) || defined(CORRADE_TARGET_EMSCRIPTEN) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    modificationTime =
+        #ifdef CORRADE_TARGET_APPLE
+        std::uint64_t(result.st_mtimespec.tv_sec)*1000000000 + std::uint64_t(result.st_mtimespec.tv_nsec)
+        #elif defined(st_mtime)
+        std::uint64_t(result.st_mtim.tv_sec)*1000000000 + std::uint64_t(result.st_mtim.tv_nsec)
+        #else
+        std::uint64_t(result.st_mtime)*1000000000
+        #endif
+        ;
+    size = result.st_size;
+    return true;
+    #endif
+}
+
 std::string comment(const std::string& comment) {
     return "\n    /* " + comment + " */";
 }
@@ -166,10 +251,223 @@ inline bool lessFilename(const std::pair<std::string, std::string>& a, const std
     return a.first < b.first;
 }
 
+bool parseCompression(const std::string& value, unsigned int& out) {
+    if(value == "none") out = Implementation::ResourceCompressionNone;
+    else if(value == "lz4") out = Implementation::ResourceCompressionLz4;
+    else return false;
+    return true;
+}
+
+bool parseAlignment(const std::string& value, unsigned int& out) {
+    /* Power of two between 1 and 4096, i.e. at most a page size */
+    if(value.empty() || value.size() > 4) return false;
+    unsigned int alignment = 0;
+    for(const char c: value) {
+        if(c < '0' || c > '9') return false;
+        alignment = alignment*10 + (c - '0');
+    }
+    if(!alignment || alignment > 4096 || (alignment & (alignment - 1)))
+        return false;
+    out = alignment;
+    return true;
+}
+
+void appendPackValue(std::string& out, const std::uint32_t value) {
+    out += char(value & 0xff);
+    out += char((value >> 8) & 0xff);
+    out += char((value >> 16) & 0xff);
+    out += char((value >> 24) & 0xff);
+}
+
+void appendPackValues(std::string& out, const std::vector<unsigned int>& values) {
+    for(const unsigned int value: values) appendPackValue(out, value);
+}
+
+/* Assembles a pack as described in Implementation::ResourcePackHeader */
+std::string resourcePack(const std::string& group, const std::vector<unsigned int>& positions, const std::vector<unsigned int>& hashTable, const std::vector<unsigned int>& compression, const std::vector<unsigned int>& alignment, const std::vector<unsigned int>& duplicates, const std::string& filenames, const std::string& data, const unsigned int maxAlignment) {
+    std::string out{Implementation::ResourcePackMagic, sizeof(Implementation::ResourcePackMagic)};
+    appendPackValue(out, Implementation::ResourcePackVersion);
+    appendPackValue(out, positions.size()/2);
+    appendPackValue(out,
+        (hashTable.empty() ? 0 : std::uint32_t(Implementation::ResourcePackHashTable))|
+        (compression.empty() ? 0 : std::uint32_t(Implementation::ResourcePackCompression))|
+        (alignment.empty() ? 0 : std::uint32_t(Implementation::ResourcePackAlignment))|
+        (duplicates.empty() ? 0 : std::uint32_t(Implementation::ResourcePackDuplicates)));
+    appendPackValue(out, group.size());
+    appendPackValue(out, filenames.size());
+    /* Data offset and size filled below */
+    const std::size_t dataOffsetPosition = out.size();
+    appendPackValue(out, 0);
+    appendPackValue(out, data.size());
+    CORRADE_INTERNAL_ASSERT(out.size() == sizeof(Implementation::ResourcePackHeader));
+
+    out += group;
+    out += '\0';
+    out.append((4 - out.size() % 4) % 4, '\0');
+    appendPackValues(out, positions);
+    appendPackValues(out, hashTable);
+    appendPackValues(out, compression);
+    appendPackValues(out, alignment);
+    appendPackValues(out, duplicates);
+    out += filenames;
+
+    /* Pad the data to the largest alignment, the mapping itself is always
+       page-aligned. At least four bytes to keep the file size aligned. */
+    const std::size_t dataAlignment = std::max(maxAlignment, 4u);
+    out.append((dataAlignment - out.size() % dataAlignment) % dataAlignment, '\0');
+    const std::size_t dataOffset = out.size();
+    for(std::size_t i = 0; i != 4; ++i)
+        out[dataOffsetPosition + i] = char((dataOffset >> 8*i) & 0xff);
+    out += data;
+    return out;
+}
+
+}
+
+namespace Implementation {
+
+namespace {
+    /* Constants of the LZ4 block format. The last match has to start at
+       least 12 bytes before the end and the last 5 bytes are always
+       literals. */
+    enum: std::size_t {
+        Lz4MinMatch = 4,
+        Lz4MatchLimit = 12,
+        Lz4LastLiterals = 5,
+        Lz4MaxOffset = 65535,
+        Lz4HashBits = 12
+    };
+
+    inline std::uint32_t lz4Read32(const char* const data) {
+        std::uint32_t value;
+        std::memcpy(&value, data, 4);
+        return value;
+    }
+
+    inline std::size_t lz4Hash(const std::uint32_t value) {
+        return (value*2654435761u) >> (32 - Lz4HashBits);
+    }
+
+    inline void lz4WriteLength(std::string& out, std::size_t length) {
+        while(length >= 255) {
+            out += char(255);
+            length -= 255;
+        }
+        out += char(length);
+    }
+
+    void lz4WriteSequence(std::string& out, const char* const literals, const std::size_t literalCount, const std::size_t offset, const std::size_t matchLength) {
+        const std::size_t matchCode = matchLength ? matchLength - Lz4MinMatch : 0;
+        out += char((std::min(literalCount, std::size_t{15}) << 4)|std::min(matchCode, std::size_t{15}));
+        if(literalCount >= 15) lz4WriteLength(out, literalCount - 15);
+        out.append(literals, literalCount);
+
+        /* The last sequence has only literals */
+        if(!matchLength) return;
+
+        out += char(offset & 0xff);
+        out += char(offset >> 8);
+        if(matchCode >= 15) lz4WriteLength(out, matchCode - 15);
+    }
+}
+
+std::string resourceCompressLz4(const Containers::ArrayView<const char> data) {
+    std::string out;
+    out.reserve(data.size()/2);
+
+    /* Positions of last occurences of 4-byte sequences, offset by one so
+       zero means nothing */
+    std::vector<std::size_t> table(1 << Lz4HashBits);
+
+    std::size_t anchor = 0;
+    if(data.size() > Lz4MatchLimit) for(std::size_t i = 0; i + Lz4MatchLimit <= data.size(); ) {
+        const std::uint32_t sequence = lz4Read32(data + i);
+        std::size_t& entry = table[lz4Hash(sequence)];
+        const std::size_t candidate = entry;
+        entry = i + 1;
+
+        if(!candidate || i - (candidate - 1) > Lz4MaxOffset || lz4Read32(data + candidate - 1) != sequence) {
+            ++i;
+            continue;
+        }
+
+        /* Extend the match, keeping the last literals */
+        const std::size_t match = candidate - 1;
+        std::size_t length = Lz4MinMatch;
+        while(i + length < data.size() - Lz4LastLiterals && data[match + length] == data[i + length])
+            ++length;
+
+        lz4WriteSequence(out, data + anchor, i - anchor, i - match, length);
+        i += length;
+        anchor = i;
+    }
+
+    lz4WriteSequence(out, data + anchor, data.size() - anchor, 0, 0);
+    return out;
+}
+
+bool resourceDecompressLz4(const Containers::ArrayView<const char> data, const Containers::ArrayView<char> out) {
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(data.data());
+    const unsigned char* const inEnd = in + data.size();
+    std::size_t o = 0;
+
+    auto readLength = [&](std::size_t& length) {
+        if(length != 15) return true;
+        unsigned char byte;
+        do {
+            if(in == inEnd) return false;
+            byte = *in++;
+            length += byte;
+        } while(byte == 255);
+        return true;
+    };
+
+    while(in != inEnd) {
+        const unsigned char token = *in++;
+
+        /* Literals */
+        std::size_t literalCount = token >> 4;
+        if(!readLength(literalCount) || std::size_t(inEnd - in) < literalCount || out.size() - o < literalCount)
+            return false;
+        std::memcpy(out + o, in, literalCount);
+        in += literalCount;
+        o += literalCount;
+
+        /* The last sequence has no match */
+        if(in == inEnd) break;
+
+        /* Match */
+        if(inEnd - in < 2) return false;
+        const std::size_t offset = in[0]|(in[1] << 8);
+        in += 2;
+        std::size_t matchLength = token & 0x0f;
+        if(!offset || offset > o || !readLength(matchLength)) return false;
+        matchLength += Lz4MinMatch;
+        if(out.size() - o < matchLength) return false;
+
+        /* The match can overlap with the output, copy bytewise */
+        for(std::size_t i = 0; i != matchLength; ++i, ++o)
+            out[o] = out[o - offset];
+    }
+
+    return o == out.size();
+}
 
 }
 
 std::string Resource::compileFrom(const std::string& name, const std::string& configurationFile) {
+    return compileFromInternal(name, configurationFile, nullptr, nullptr, false);
+}
+
+std::string Resource::compileFrom(const std::string& name, const std::string& configurationFile, const std::string& incbinFile, std::string& incbinData) {
+    return compileFromInternal(name, configurationFile, &incbinFile, &incbinData, false);
+}
+
+std::string Resource::compilePackFrom(const std::string& configurationFile) {
+    return compileFromInternal({}, configurationFile, nullptr, nullptr, true);
+}
+
+std::string Resource::compileFromInternal(const std::string& name, const std::string& configurationFile, const std::string* const incbinFile, std::string* const incbinData, const bool pack) {
     /* Resource file existence */
     if(!Directory::exists(configurationFile)) {
         Error() << "    Error: file" << configurationFile << "does not exist";
@@ -186,10 +484,28 @@ std::string Resource::compileFrom(const std::string& name, const std::string& co
     }
     const std::string group = conf.value("group");
 
+    /* Global compression */
+    unsigned int globalCompression = Implementation::ResourceCompressionNone;
+    if(conf.hasValue("compression") && !parseCompression(conf.value("compression"), globalCompression)) {
+        Error() << "    Error: unknown compression" << conf.value("compression") << "in group" << group;
+        return {};
+    }
+
+    /* Global alignment */
+    unsigned int globalAlignment = 1;
+    if(conf.hasValue("align") && !parseAlignment(conf.value("align"), globalAlignment)) {
+        Error() << "    Error: invalid alignment" << conf.value("align") << "in group" << group;
+        return {};
+    }
+
     /* Load all files */
     std::vector<const ConfigurationGroup*> files = conf.groups("file");
     std::vector<std::pair<std::string, std::string>> fileData;
+    std::vector<unsigned int> fileCompression;
+    std::vector<unsigned int> fileAlignment;
     fileData.reserve(files.size());
+    fileCompression.reserve(files.size());
+    fileAlignment.reserve(files.size());
     for(const auto file: files) {
         const std::string filename = file->value("filename");
         const std::string alias = file->hasValue("alias") ? file->value("alias") : filename;
@@ -203,21 +519,121 @@ std::string Resource::compileFrom(const std::string& name, const std::string& co
             Error() << "    Error: cannot open file" << filename << "of file" << fileData.size()+1 << "in group" << group;
             return {};
         }
+
+        unsigned int compression = globalCompression;
+        if(file->hasValue("compression") && !parseCompression(file->value("compression"), compression)) {
+            Error() << "    Error: unknown compression" << file->value("compression") << "of file" << fileData.size()+1 << "in group" << group;
+            return {};
+        }
+
+        unsigned int alignment = globalAlignment;
+        if(file->hasValue("align") && !parseAlignment(file->value("align"), alignment)) {
+            Error() << "    Error: invalid alignment" << file->value("align") << "of file" << fileData.size()+1 << "in group" << group;
+            return {};
+        }
+
         fileData.emplace_back(alias, std::string{contents.second, contents.second.size()});
+        fileCompression.push_back(compression);
+        fileAlignment.push_back(alignment);
+    }
+
+    /* The list has to be sorted before passing it to compile(), sort the
+       compression and alignment alongside */
+    std::vector<std::size_t> order(fileData.size());
+    for(std::size_t i = 0; i != order.size(); ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&fileData](std::size_t a, std::size_t b) {
+        return fileData[a].first < fileData[b].first;
+    });
+    std::vector<std::pair<std::string, std::string>> sortedFileData;
+    std::vector<unsigned int> sortedFileCompression;
+    std::vector<unsigned int> sortedFileAlignment;
+    sortedFileData.reserve(fileData.size());
+    sortedFileCompression.reserve(fileData.size());
+    sortedFileAlignment.reserve(fileData.size());
+    for(const std::size_t i: order) {
+        sortedFileData.push_back(std::move(fileData[i]));
+        sortedFileCompression.push_back(fileCompression[i]);
+        sortedFileAlignment.push_back(fileAlignment[i]);
+    }
+
+    return compileInternal(name, group, sortedFileData, sortedFileCompression, sortedFileAlignment, incbinFile, incbinData, pack);
+}
+
+namespace Implementation {
+
+bool resourceHashTable(const unsigned int count, const unsigned int* const positions, const unsigned char* const filenames, unsigned int* const out) {
+    /* Distribute the filenames into buckets */
+    std::vector<std::uint32_t> hashes(count);
+    std::vector<std::vector<unsigned int>> buckets(count);
+    for(unsigned int i = 0; i != count; ++i) {
+        hashes[i] = resourceHash(resourceFilenameAt(positions, filenames, i));
+        buckets[hashes[i] % count].push_back(i);
+    }
+
+    /* Process the largest buckets first, while there's the most free
+       slots */
+    std::vector<unsigned int> order(count);
+    for(unsigned int i = 0; i != count; ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&buckets](unsigned int a, unsigned int b) {
+        return buckets[a].size() > buckets[b].size();
+    });
+
+    std::vector<bool> usedSlots(count);
+    std::vector<unsigned int> slots;
+    for(const unsigned int bucket: order) {
+        const std::vector<unsigned int>& indices = buckets[bucket];
+        if(indices.empty()) {
+            out[2*bucket] = 0;
+            continue;
+        }
+
+        /* Find a seed that maps all filenames in the bucket to free and
+           distinct slots. There's at most a few filenames in the bucket and
+           at least as many slots free, so this terminates fast for distinct
+           filenames. Giving up after a while to not loop forever on
+           duplicates. */
+        std::uint32_t seed = 1;
+        for(;; ++seed) {
+            if(seed == 1u << 20) return false;
+
+            slots.clear();
+            for(const unsigned int i: indices) {
+                const unsigned int slot = resourceSeededHash(hashes[i], seed) % count;
+                if(usedSlots[slot] || std::find(slots.begin(), slots.end(), slot) != slots.end())
+                    break;
+                slots.push_back(slot);
+            }
+
+            if(slots.size() == indices.size()) break;
+        }
+
+        out[2*bucket] = seed;
+        for(std::size_t i = 0; i != slots.size(); ++i) {
+            usedSlots[slots[i]] = true;
+            out[2*slots[i] + 1] = indices[i];
+        }
     }
 
-    /* The list has to be sorted before passing it to compile() */
-    std::sort(fileData.begin(), fileData.end(), lessFilename);
+    return true;
+}
 
-    return compile(name, group, fileData);
 }
 
 std::string Resource::compile(const std::string& name, const std::string& group, const std::vector<std::pair<std::string, std::string>>& files) {
+    return compileInternal(name, group, files, {}, {}, nullptr, nullptr, false);
+}
+
+std::string Resource::compileInternal(const std::string& name, const std::string& group, const std::vector<std::pair<std::string, std::string>>& files, const std::vector<unsigned int>& compression, const std::vector<unsigned int>& alignment, const std::string* const incbinFile, std::string* const incbinData, const bool pack) {
     CORRADE_ASSERT(std::is_sorted(files.begin(), files.end(), lessFilename),
         "Utility::Resource::compile(): the file list is not sorted", {});
-
-    /* Special case for empty file list */
-    if(files.empty()) {
+    CORRADE_INTERNAL_ASSERT(compression.empty() || compression.size() == files.size());
+    CORRADE_INTERNAL_ASSERT(alignment.empty() || alignment.size() == files.size());
+    CORRADE_INTERNAL_ASSERT(!incbinFile == !incbinData);
+    if(incbinData) incbinData->clear();
+
+    /* Special case for empty file list. A pack is generated the usual way,
+       just with all arrays empty. */
+    if(files.empty() && !pack) {
         return formatString(R"(/* Compiled resource file. DO NOT EDIT! */
 
 #include "Corrade/Corrade.h"
@@ -226,17 +642,13 @@ std::string Resource::compile(const std::string& name, const std::string& group,
 
 namespace {{
 
-Corrade::Utility::Implementation::ResourceGroup resource;
+Corrade::Utility::Implementation::ResourceGroup resource{{
+    "{1}", 0, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr}};
 
 }}
 
 int resourceInitializer_{0}();
 int resourceInitializer_{0}() {{
-    resource.name = "{1}";
-    resource.count = 0;
-    resource.positions = nullptr;
-    resource.filenames = nullptr;
-    resource.data = nullptr;
     Corrade::Utility::Resource::registerData(resource);
     return 1;
 }} CORRADE_AUTOMATIC_INITIALIZER(resourceInitializer_{0})
@@ -252,32 +664,217 @@ int resourceFinalizer_{0}() {{
     std::string positions, filenames, data;
     unsigned int filenamesLen = 0, dataLen = 0;
 
+    /* For a pack the data are collected the same way as for incbin */
+    std::string packData;
+    std::string* const rawData = pack ? &packData : incbinData;
+
+    /* Compression, alignment and duplicates in the form in which they're
+       saved into a pack */
+    std::vector<unsigned int> compressionValues, alignmentValues, duplicatesValues;
+    if(pack) {
+        compressionValues.reserve(files.size()*2);
+        alignmentValues.reserve(files.size());
+        duplicatesValues.reserve(files.size());
+    }
+
+    /* Positions and filenames in the same form as will be compiled in, for
+       generating the hash table */
+    std::vector<unsigned int> positionData;
+    std::string filenameData;
+    positionData.reserve(files.size()*2);
+
+    /* Compression and decompressed size for each file, only emitted if at
+       least one file is compressed */
+    std::string compressionData;
+    bool anyCompressed = false;
+    std::size_t lastDataSize = 0;
+
+    /* Alignment for each file, only emitted if at least one file has it
+       larger than 1. The data array is then aligned to the largest of
+       them. */
+    std::string alignmentData;
+    unsigned int maxAlignment = 1;
+
+    /* Index of a file whose data each file uses, only emitted if at least
+       one file has the same contents, compression and alignment as some file
+       before it. Such files then don't store the data again. */
+    std::unordered_map<std::string, std::size_t> uniqueFiles;
+    std::vector<unsigned int> requestedCompression(files.size());
+    std::vector<unsigned int> storedCompression(files.size());
+    std::string duplicatesData;
+    bool anyDuplicate = false;
+
     /* Convert data to hexacodes */
     for(auto it = files.cbegin(); it != files.cend(); ++it) {
+        const std::size_t i = it - files.begin();
+        const unsigned int fileAlignment = alignment.empty() ? 1 : alignment[i];
+        requestedCompression[i] = compression.empty() || fileAlignment != 1 ? Implementation::ResourceCompressionNone : compression[i];
+        alignmentData += Utility::formatString("\n    0x{:.8x},", fileAlignment);
+        if(pack) alignmentValues.push_back(fileAlignment);
+        maxAlignment = std::max(maxAlignment, fileAlignment);
+
+        /* Find the first file with the same contents. Empty files have no
+           data to share. */
+        std::size_t original = i;
+        if(!it->second.empty()) {
+            const auto found = uniqueFiles.emplace(it->second, i);
+            const std::size_t candidate = found.first->second;
+            if(!found.second && requestedCompression[candidate] == requestedCompression[i] && (alignment.empty() || alignment[candidate] == fileAlignment))
+                original = candidate;
+        }
+        duplicatesData += Utility::formatString("\n    0x{:.8x},", original);
+        if(pack) duplicatesValues.push_back(original);
+
         filenamesLen += it->first.size();
-        dataLen += it->second.size();
+        positionData.push_back(filenamesLen);
+        filenameData += it->first;
 
         if(it != files.begin()) {
             filenames += '\n';
             data += '\n';
         }
 
-        positions += Utility::formatString("\n    0x{:.8x},0x{:.8x},", filenamesLen, dataLen);
-
         filenames += comment(it->first);
         filenames += hexcode(it->first);
 
+        /* A duplicate stores no data, the runtime uses the data of the
+           original file instead */
+        if(original != i) {
+            anyDuplicate = true;
+            storedCompression[i] = storedCompression[original];
+            compressionData += Utility::formatString("\n    0x{:.8x},0x{:.8x},", storedCompression[i], it->second.size());
+            if(pack) {
+                compressionValues.push_back(storedCompression[i]);
+                compressionValues.push_back(it->second.size());
+            }
+            lastDataSize = 0;
+            positionData.push_back(dataLen);
+            positions += Utility::formatString("\n    0x{:.8x},0x{:.8x},", filenamesLen, dataLen);
+            data += comment(formatString("{}, same as {}", it->first, files[original].first));
+            continue;
+        }
+
+        /* Compress the file, if requested. If it doesn't get smaller, store
+           it uncompressed. Aligned files are never compressed, as the
+           decompressed copy wouldn't have the alignment guaranteed. */
+        unsigned int fileCompression = requestedCompression[i];
+        std::string compressed;
+        if(fileCompression == Implementation::ResourceCompressionLz4) {
+            compressed = Implementation::resourceCompressLz4({it->second.data(), it->second.size()});
+            if(compressed.size() >= it->second.size())
+                fileCompression = Implementation::ResourceCompressionNone;
+        }
+        const std::string& fileData = fileCompression == Implementation::ResourceCompressionNone ? it->second : compressed;
+        if(fileCompression != Implementation::ResourceCompressionNone)
+            anyCompressed = true;
+        storedCompression[i] = fileCompression;
+        compressionData += Utility::formatString("\n    0x{:.8x},0x{:.8x},", fileCompression, it->second.size());
+        if(pack) {
+            compressionValues.push_back(fileCompression);
+            compressionValues.push_back(it->second.size());
+        }
+
+        /* Pad the previous data so this file starts at a multiple of its
+           alignment. The runtime calculates the same from the alignment
+           array, so the padding doesn't need to be stored anywhere. */
+        const std::size_t padding = (fileAlignment - dataLen % fileAlignment) % fileAlignment;
+
+        lastDataSize = fileData.size();
+        dataLen += padding + fileData.size();
+        positionData.push_back(dataLen);
+
+        positions += Utility::formatString("\n    0x{:.8x},0x{:.8x},", filenamesLen, dataLen);
+
+        /* With incbin the data go to a separate file, which is a lot faster
+           than converting them to hexacodes and then letting the compiler
+           parse them */
+        if(padding) {
+            if(rawData) rawData->append(padding, '\0');
+            else {
+                data += comment(formatString("padding to {} bytes", fileAlignment));
+                data += hexcode(std::string(padding, '\0'));
+                data += '\n';
+            }
+        }
         data += comment(it->first);
-        data += hexcode(it->second);
+        if(rawData) *rawData += fileData;
+        else data += hexcode(fileData);
     }
 
+    /* Generate the hash table. If that fails (which can only happen with
+       duplicate filenames), the lookup falls back to a binary search. */
+    std::vector<unsigned int> hashTableData(files.size()*2);
+    const bool hasHashTable = Implementation::resourceHashTable(files.size(), positionData.data(), reinterpret_cast<const unsigned char*>(filenameData.data()), hashTableData.data());
+
+    if(pack) return resourcePack(group, positionData,
+        hasHashTable ? hashTableData : std::vector<unsigned int>{},
+        anyCompressed ? compressionValues : std::vector<unsigned int>{},
+        maxAlignment != 1 ? alignmentValues : std::vector<unsigned int>{},
+        anyDuplicate ? duplicatesValues : std::vector<unsigned int>{},
+        filenameData, packData, maxAlignment);
+
     /* Remove last comma from positions and filenames array */
     positions.resize(positions.size()-1);
     filenames.resize(filenames.size()-1);
 
     /* Remove last comma from data array only if the last file is not empty */
-    if(!files.back().second.empty())
-        data.resize(data.size()-1);
+    std::string incbinDefinition, dataDefinition, dataPointer;
+    if(!dataLen) {
+        dataDefinition = formatString("// const unsigned char resourceData[] = {{{0}\n// }};\n\n", data);
+        dataPointer = "nullptr";
+
+    /* The data have their own symbol because they can't be defined in the
+       anonymous namespace. The asm label makes the name the same on all
+       platforms, independently of whether C symbols get prefixed with an
+       underscore or not. */
+    } else if(incbinData) {
+        std::string incbinPath = *incbinFile;
+        std::replace(incbinPath.begin(), incbinPath.end(), '\\', '/');
+        dataPointer = "corradeResourceData_" + name;
+        incbinDefinition = formatString(R"(/* Data of all files, {0} bytes with SHA-1 {1}, included from
+   {2} */
+extern "C" const unsigned char {3}[] __asm__("{3}");
+__asm__(
+#if defined(__APPLE__)
+    ".pushsection __TEXT,__const\n"
+    ".private_extern {3}\n"
+#elif defined(_WIN32)
+    ".pushsection .rdata,\"dr\"\n"
+#else
+    ".pushsection .rodata,\"a\"\n"
+    ".hidden {3}\n"
+#endif
+    ".globl {3}\n"
+    ".balign {4}\n"
+    "{3}:\n"
+    ".incbin \"{2}\"\n"
+    ".popsection\n");
+
+)", dataLen, Sha1::digest(*incbinData).hexString(), incbinPath, dataPointer, std::max(maxAlignment, 16u));
+
+    } else {
+        if(lastDataSize) data.resize(data.size()-1);
+        dataDefinition = formatString("{1}const unsigned char resourceData[] = {{{0}\n}};\n\n", data, maxAlignment != 1 ? formatString("alignas({}) ", maxAlignment) : std::string{});
+        dataPointer = "resourceData";
+    }
+
+    /* Remove last comma from the compression array, or drop it completely if
+       nothing is compressed */
+    if(anyCompressed) compressionData.resize(compressionData.size()-1);
+    else compressionData = {};
+
+    /* Same for the alignment and duplicates arrays */
+    if(maxAlignment != 1) alignmentData.resize(alignmentData.size()-1);
+    else alignmentData = {};
+    if(anyDuplicate) duplicatesData.resize(duplicatesData.size()-1);
+    else duplicatesData = {};
+
+    std::string hashTable;
+    if(hasHashTable) {
+        for(std::size_t i = 0; i != files.size(); ++i)
+            hashTable += Utility::formatString("\n    0x{:.8x},0x{:.8x},", hashTableData[2*i], hashTableData[2*i + 1]);
+        hashTable.resize(hashTable.size()-1);
+    }
 
     /* Return C++ file. The functions have forward declarations to avoid warning
        about functions which don't have corresponding declarations (enabled by
@@ -289,7 +886,7 @@ int resourceFinalizer_{0}() {{
 #include "Corrade/Utility/Macros.h"
 #include "Corrade/Utility/Resource.h"
 
-namespace {{
+{2}namespace {{
 
 const unsigned int resourcePositions[] = {{{0}
 }};
@@ -297,20 +894,26 @@ const unsigned int resourcePositions[] = {{{0}
 const unsigned char resourceFilenames[] = {{{1}
 }};
 
-{2}const unsigned char resourceData[] = {{{3}
-{2}}};
+{3}{8}const unsigned int resourceHashTable[] = {{{9}
+{8}}};
 
-Corrade::Utility::Implementation::ResourceGroup resource;
+{11}const unsigned int resourceCompression[] = {{{12}
+{11}}};
+
+{14}const unsigned int resourceAlignment[] = {{{15}
+{14}}};
+
+{17}const unsigned int resourceDuplicates[] = {{{18}
+{17}}};
+
+Corrade::Utility::Implementation::ResourceGroup resource{{
+    "{5}", {6}, resourcePositions, resourceFilenames, {7},
+    {10}, {13}, {16}, {19}, nullptr, nullptr}};
 
 }}
 
 int resourceInitializer_{4}();
 int resourceInitializer_{4}() {{
-    resource.name = "{5}";
-    resource.count = {6};
-    resource.positions = resourcePositions;
-    resource.filenames = resourceFilenames;
-    resource.data = {7};
     Corrade::Utility::Resource::registerData(resource);
     return 1;
 }} CORRADE_AUTOMATIC_INITIALIZER(resourceInitializer_{4})
@@ -323,12 +926,24 @@ int resourceFinalizer_{4}() {{
 )",
         positions,                              // 0
         filenames,                              // 1
-        dataLen ? "" : "// ",                   // 2
-        data,                                   // 3
+        incbinDefinition,                       // 2
+        dataDefinition,                         // 3
         name,                                   // 4
         group,                                  // 5
         files.size(),                           // 6
-        dataLen ? "resourceData" : "nullptr"    // 7
+        dataPointer,                            // 7
+        hashTable.empty() ? "// " : "",         // 8
+        hashTable,                              // 9
+        hashTable.empty() ? "nullptr" : "resourceHashTable", // 10
+        compressionData.empty() ? "// " : "",   // 11
+        compressionData,                        // 12
+        compressionData.empty() ? "nullptr" : "resourceCompression", // 13
+        alignmentData.empty() ? "// " : "",     // 14
+        alignmentData,                          // 15
+        alignmentData.empty() ? "nullptr" : "resourceAlignment", // 16
+        duplicatesData.empty() ? "// " : "",    // 17
+        duplicatesData,                         // 18
+        duplicatesData.empty() ? "nullptr" : "resourceDuplicates" // 19
     );
 }
 
@@ -358,6 +973,146 @@ void Resource::overrideGroup(const std::string& group, const std::string& config
     resourceGlobals.overrideGroups->emplace(group, std::string{}).first->second = configurationFile;
 }
 
+bool Resource::loadPack(const std::string& filename) {
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    Error() << "Utility::Resource::loadPack(): packs are not supported on big-endian platforms";
+    return false;
+    #else
+    std::unique_ptr<ResourcePack> pack{new ResourcePack{}};
+    if(!Directory::exists(filename)) {
+        Error() << "Utility::Resource::loadPack(): cannot open file" << filename;
+        return false;
+    }
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    pack->data = Directory::mapRead(filename);
+    #else
+    pack->data = Directory::read(filename);
+    #endif
+    if(!pack->data) {
+        Error() << "Utility::Resource::loadPack(): cannot open file" << filename;
+        return false;
+    }
+
+    /* Check the header. Everything is verified up front using 64-bit math
+       so a truncated or malicious file can't make the lookup read out of
+       bounds later. */
+    const Containers::ArrayView<const char> data = pack->data;
+    Implementation::ResourcePackHeader header;
+    if(data.size() < sizeof(header)) {
+        Error() << "Utility::Resource::loadPack(): file" << filename << "is too short";
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if(std::memcmp(header.magic, Implementation::ResourcePackMagic, sizeof(header.magic)) != 0) {
+        Error() << "Utility::Resource::loadPack(): file" << filename << "is not a resource pack";
+        return false;
+    }
+    if(header.version != Implementation::ResourcePackVersion) {
+        Error() << "Utility::Resource::loadPack(): unsupported pack version" << header.version << "in" << filename;
+        return false;
+    }
+
+    /* Calculate offsets of all arrays and check that they're in bounds */
+    const std::uint64_t count = header.count;
+    const std::uint64_t positionsOffset = (sizeof(header) + std::uint64_t{header.groupSize} + 1 + 3) & ~std::uint64_t{3};
+    std::uint64_t offset = positionsOffset + count*2*4;
+    const std::uint64_t hashTableOffset = offset;
+    if(header.flags & Implementation::ResourcePackHashTable) offset += count*2*4;
+    const std::uint64_t compressionOffset = offset;
+    if(header.flags & Implementation::ResourcePackCompression) offset += count*2*4;
+    const std::uint64_t alignmentOffset = offset;
+    if(header.flags & Implementation::ResourcePackAlignment) offset += count*4;
+    const std::uint64_t duplicatesOffset = offset;
+    if(header.flags & Implementation::ResourcePackDuplicates) offset += count*4;
+    const std::uint64_t filenamesOffset = offset;
+    offset += header.filenamesSize;
+    if(offset > header.dataOffset || std::uint64_t{header.dataOffset} + header.dataSize > data.size()) {
+        Error() << "Utility::Resource::loadPack(): file" << filename << "is truncated";
+        return false;
+    }
+    if(data[sizeof(header) + header.groupSize] != '\0') {
+        Error() << "Utility::Resource::loadPack(): group name in" << filename << "is not null-terminated";
+        return false;
+    }
+
+    Implementation::ResourceGroup& group = pack->group;
+    group.name = data + sizeof(header);
+    group.count = header.count;
+    group.positions = reinterpret_cast<const unsigned int*>(data + positionsOffset);
+    group.filenames = reinterpret_cast<const unsigned char*>(data + filenamesOffset);
+    group.data = reinterpret_cast<const unsigned char*>(data + header.dataOffset);
+    if(header.flags & Implementation::ResourcePackHashTable)
+        group.hashTable = reinterpret_cast<const unsigned int*>(data + hashTableOffset);
+    if(header.flags & Implementation::ResourcePackCompression)
+        group.compression = reinterpret_cast<const unsigned int*>(data + compressionOffset);
+    if(header.flags & Implementation::ResourcePackAlignment)
+        group.alignment = reinterpret_cast<const unsigned int*>(data + alignmentOffset);
+    if(header.flags & Implementation::ResourcePackDuplicates)
+        group.duplicates = reinterpret_cast<const unsigned int*>(data + duplicatesOffset);
+
+    /* Check contents of the arrays */
+    for(std::size_t i = 0; i != group.count; ++i) {
+        const std::size_t original = group.duplicates ? group.duplicates[i] : i;
+        const std::uint64_t filenameBegin = i ? group.positions[2*(i - 1)] : 0;
+        std::uint64_t dataBegin = i ? group.positions[2*(i - 1) + 1] : 0;
+        if(group.positions[2*i] < filenameBegin || group.positions[2*i] > header.filenamesSize || group.positions[2*i + 1] < dataBegin || group.positions[2*i + 1] > header.dataSize || (group.hashTable && group.hashTable[2*i + 1] >= group.count) || original >= group.count || (group.duplicates && group.duplicates[original] != original)) {
+            Error() << "Utility::Resource::loadPack(): file" << filename << "is corrupted";
+            return false;
+        }
+
+        if(group.compression && group.compression[2*i] != Implementation::ResourceCompressionNone && group.compression[2*i] != Implementation::ResourceCompressionLz4) {
+            Error() << "Utility::Resource::loadPack(): unsupported compression" << group.compression[2*i] << "in" << filename;
+            return false;
+        }
+
+        /* The data pointer has to satisfy the alignment, which isn't the
+           case if the file got read into memory and the alignment is larger
+           than what the allocator guarantees. Duplicates don't use their own
+           position, so the padding isn't checked for them. */
+        if(group.alignment) {
+            const unsigned int alignment = group.alignment[i];
+            if(!alignment || alignment > 4096 || (alignment & (alignment - 1)) || reinterpret_cast<std::uintptr_t>(group.data) % alignment) {
+                Error() << "Utility::Resource::loadPack(): unsupported alignment" << alignment << "in" << filename;
+                return false;
+            }
+            dataBegin = (dataBegin + alignment - 1) & ~std::uint64_t(alignment - 1);
+            if(original == i && dataBegin > group.positions[2*i + 1]) {
+                Error() << "Utility::Resource::loadPack(): file" << filename << "is corrupted";
+                return false;
+            }
+        }
+    }
+
+    const std::string name = group.name;
+    if(findGroup({name.data(), name.size()})) {
+        Error() << "Utility::Resource::loadPack(): group" << '\'' + name + '\'' << "already exists";
+        return false;
+    }
+
+    if(!resourceGlobals.packs) {
+        static std::map<std::string, std::unique_ptr<ResourcePack>> packs;
+        resourceGlobals.packs = &packs;
+    }
+
+    registerData(pack->group);
+    resourceGlobals.packs->emplace(name, std::move(pack));
+    return true;
+    #endif
+}
+
+bool Resource::unloadPack(const std::string& group) {
+    std::map<std::string, std::unique_ptr<ResourcePack>>::iterator found;
+    if(!resourceGlobals.packs || (found = resourceGlobals.packs->find(group)) == resourceGlobals.packs->end()) {
+        Error() << "Utility::Resource::unloadPack(): group" << '\'' + group + '\'' << "was not loaded from a pack";
+        return false;
+    }
+
+    /* This also frees the decompressed data, if any */
+    unregisterData(found->second->group);
+    resourceGlobals.packs->erase(found);
+    return true;
+}
+
 bool Resource::hasGroup(const std::string& group) {
     return hasGroupInternal({group.data(), group.size()});
 }
@@ -368,7 +1123,10 @@ bool Resource::hasGroupInternal(const Containers::ArrayView<const char> group) {
 
 Resource::Resource(const std::string& group): Resource{{group.data(), group.size()}, nullptr} {}
 
-Resource::Resource(const Containers::ArrayView<const char> group, void*): _group{findGroup(group)}, _overrideGroup(nullptr) {
+Resource::Resource(const Containers::ArrayView<const char> group, void*): _overrideGroup(nullptr) {
+    CORRADE_PROFILE_SCOPE("Utility::Resource::Resource()");
+
+    _group = findGroup(group);
     CORRADE_ASSERT(_group, "Utility::Resource: group '" << Debug::nospace << (std::string{group, group.size()}) << Debug::nospace << "' was not found", );
 
     if(resourceGlobals.overrideGroups) {
@@ -410,6 +1168,10 @@ Containers::ArrayView<const char> Resource::getRaw(const std::string& filename)
 }
 
 Containers::ArrayView<const char> Resource::getInternal(const Containers::ArrayView<const char> filename) const {
+    return getInternal(filename, Implementation::resourceHash(filename));
+}
+
+Containers::ArrayView<const char> Resource::getInternal(const Containers::ArrayView<const char> filename, const std::uint32_t hash) const {
     CORRADE_INTERNAL_ASSERT(_group);
 
     /* The group is overriden with live data */
@@ -419,7 +1181,7 @@ Containers::ArrayView<const char> Resource::getInternal(const Containers::ArrayV
         /* The file is already loaded */
         auto it = _overrideGroup->data.find(filenameString);
         if(it != _overrideGroup->data.end())
-            return it->second;
+            return it->second->data;
 
         /* Load the file and save it for later use. Linear search is not an
            issue, as this shouldn't be used in production code anyway. */
@@ -428,18 +1190,46 @@ Containers::ArrayView<const char> Resource::getInternal(const Containers::ArrayV
             const std::string name = file->hasValue("alias") ? file->value("alias") : file->value("filename");
             if(name != filenameString) continue;
 
-            /* Load the file */
-            bool success;
-            Containers::Array<char> data;
-            std::tie(success, data) = fileContents(Directory::join(Directory::path(_overrideGroup->conf.filename()), file->value("filename")));
-            if(!success) {
+            const std::string path = Directory::join(Directory::path(_overrideGroup->conf.filename()), file->value("filename"));
+            std::uint64_t modificationTime;
+            std::size_t size;
+            if(!fileStatus(path, modificationTime, size)) {
                 Error() << "Utility::Resource::get(): cannot open file" << file->value("filename") << "from overriden group";
                 break;
             }
 
+            /* Reuse the file if some other instance already loaded it and it
+               didn't change since. Otherwise load it again, the previous
+               version stays alive for as long as the instances using it. */
+            #ifdef CORRADE_BUILD_MULTITHREADED
+            static std::mutex mutex;
+            std::lock_guard<std::mutex> lock{mutex};
+            #endif
+            if(!resourceGlobals.overrideFiles) {
+                static std::map<std::string, std::shared_ptr<const ResourceOverrideFile>> overrideFiles;
+                resourceGlobals.overrideFiles = &overrideFiles;
+            }
+            std::shared_ptr<const ResourceOverrideFile>& loaded = (*resourceGlobals.overrideFiles)[path];
+            if(!loaded || loaded->modificationTime != modificationTime || loaded->size != size || modificationTime == ~std::uint64_t{}) {
+                /* Empty files can't be mapped */
+                std::shared_ptr<ResourceOverrideFile> data{new ResourceOverrideFile{modificationTime, size, nullptr}};
+                if(size) {
+                    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+                    data->data = Directory::mapRead(path);
+                    #else
+                    data->data = Directory::read(path);
+                    #endif
+                    if(!data->data) {
+                        Error() << "Utility::Resource::get(): cannot open file" << file->value("filename") << "from overriden group";
+                        break;
+                    }
+                }
+                loaded = std::move(data);
+            }
+
             /* Save the file for later use and return */
-            it = _overrideGroup->data.emplace(filenameString, std::move(data)).first;
-            return it->second;
+            it = _overrideGroup->data.emplace(filenameString, loaded).first;
+            return it->second->data;
         }
 
         /* The file was not found, fallback to compiled-in ones */
@@ -447,11 +1237,41 @@ Containers::ArrayView<const char> Resource::getInternal(const Containers::ArrayV
             << filenameString << Debug::nospace << "' was not found in overriden group, fallback to compiled-in resources";
     }
 
-    const unsigned int i = Implementation::resourceLookup(_group->count, _group->positions, _group->filenames, filename);
-    CORRADE_ASSERT(i != _group->count,
+    const unsigned int found = _group->hashTable ?
+        Implementation::resourceHashLookup(_group->count, _group->hashTable, _group->positions, _group->filenames, filename, hash) :
+        Implementation::resourceLookup(_group->count, _group->positions, _group->filenames, filename);
+    CORRADE_ASSERT(found != _group->count,
         "Utility::Resource::get(): file '" << Debug::nospace << (std::string{filename, filename.size()}) << Debug::nospace << "' was not found in group '" << Debug::nospace << _group->name << Debug::nospace << "\'", nullptr);
 
-    return Implementation::resourceDataAt(_group->positions, _group->data, i);
+    /* A file with the same contents as some other file has no data on its
+       own, use the data (and the decompressed copy) of the original */
+    const unsigned int i = _group->duplicates ? _group->duplicates[found] : found;
+
+    const Containers::ArrayView<const char> data = Implementation::resourceDataAt(_group->positions, _group->alignment, _group->data, i);
+    if(!_group->compression || _group->compression[2*i] == Implementation::ResourceCompressionNone)
+        return data;
+
+    /* Decompress on first access. Empty files are never compressed. */
+    #ifdef CORRADE_BUILD_MULTITHREADED
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> lock{mutex};
+    #endif
+    if(!_group->decompressed)
+        _group->decompressed = new Containers::Array<char>[_group->count];
+    Containers::Array<char>& decompressed = static_cast<Containers::Array<char>*>(_group->decompressed)[i];
+    if(!decompressed) {
+        CORRADE_INTERNAL_ASSERT(_group->compression[2*i] == Implementation::ResourceCompressionLz4);
+        decompressed = Containers::Array<char>{Containers::NoInit, _group->compression[2*i + 1]};
+        /* Compiled-in data are always valid, but a pack loaded with
+           loadPack() only has its structure verified up front */
+        if(!Implementation::resourceDecompressLz4(data, decompressed)) {
+            decompressed = nullptr;
+            Error() << "Utility::Resource::get(): file '" << Debug::nospace << (std::string{filename, filename.size()}) << Debug::nospace << "' in group '" << Debug::nospace << _group->name << Debug::nospace << "' is corrupted";
+            return nullptr;
+        }
+    }
+
+    return decompressed;
 }
 
 std::string Resource::get(const std::string& filename) const {
@@ -26,9 +26,10 @@
 */
 
 /** @file
- * @brief Class @ref Corrade::Utility::Resource
+ * @brief Class @ref Corrade::Utility::Resource, @ref Corrade::Utility::ResourceKey
  */
 
+#include <cstdint>
 #include <utility>
 
 #include "Corrade/Containers/ArrayView.h"
@@ -40,8 +41,80 @@ namespace Corrade { namespace Utility {
 
 namespace Implementation {
     struct ResourceGroup;
+
+    /* 32-bit FNV-1a followed by the MurmurHash3 finalizer to distribute also the
+       low bits well. The hash table is generated by corrade-rc and then used on a
+       possibly different platform, so this has to give the same results
+       everywhere. The seeded hash used for the second level of the table is
+       derived from the unseeded one and not from the filename, so a filename
+       hash calculated at compile time by ResourceKey makes the lookup not touch
+       the filename at all until the final comparison. */
+    constexpr std::uint32_t resourceHashXorShift(const std::uint32_t hash, const unsigned int shift) {
+        return hash ^ hash >> shift;
+    }
+
+    constexpr std::uint32_t resourceHashFinalize(const std::uint32_t hash) {
+        return resourceHashXorShift(std::uint32_t(resourceHashXorShift(std::uint32_t(resourceHashXorShift(hash, 16)*0x85ebca6bu), 13)*0xc2b2ae35u), 16);
+    }
+
+    /* C++11 constexpr can't have loops, so this is recursive. Used only for
+       compile-time hashing, the runtime variant in Implementation/Resource.h
+       is a loop. */
+    constexpr std::uint32_t resourceHashFnv(const char* const data, const std::size_t size, const std::uint32_t hash) {
+        return size ? resourceHashFnv(data + 1, size - 1, std::uint32_t((hash ^ std::uint8_t(*data))*16777619u)) : hash;
+    }
+
+    constexpr std::uint32_t resourceHash(const char* const data, const std::size_t size) {
+        return resourceHashFinalize(resourceHashFnv(data, size, 2166136261u));
+    }
+
+    constexpr std::uint32_t resourceSeededHash(const std::uint32_t hash, const std::uint32_t seed) {
+        return resourceHashFinalize(hash ^ seed);
+    }
 }
 
+/**
+@brief Resource filename with a precalculated hash
+@m_since_latest
+
+Calculates the hash used for file lookup in @ref Resource from a string
+literal. If the key is a @cpp constexpr @ce variable, the hash is calculated
+at compile time and @ref Resource::getRaw(const ResourceKey&) const then
+only indexes the hash table and compares the filename once, without
+iterating over the filename characters to hash them:
+
+@snippet Utility.cpp ResourceKey
+
+Resources without a hash table, compiled with older versions of
+@ref corrade-rc "corrade-rc", ignore the hash and fall back to a binary
+search.
+*/
+class ResourceKey {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * The @p filename is expected to stay in scope for the whole
+         * lifetime of the instance, which is always the case for string
+         * literals.
+         */
+        template<std::size_t size> constexpr explicit ResourceKey(const char(&filename)[size]) noexcept: _filename{filename}, _size{size - 1}, _hash{Implementation::resourceHash(filename, size - 1)} {}
+
+        /** @brief Filename */
+        constexpr const char* filename() const { return _filename; }
+
+        /** @brief Filename size, excluding the null terminator */
+        constexpr std::size_t size() const { return _size; }
+
+        /** @brief Filename hash */
+        constexpr std::uint32_t hash() const { return _hash; }
+
+    private:
+        const char* _filename;
+        std::size_t _size;
+        std::uint32_t _hash;
+};
+
 /**
 @brief Data resource management
 
@@ -65,7 +138,11 @@ Standalone resource compiler executable is implemented in
     The group lookup during construction and @ref hasGroup() is done with a
     @f$ \mathcal{O}(n) @f$ complexity as the resources register themselves
     into a linked list. Actual file lookup after is done in-place on the
-    compiled-in data in a @f$ \mathcal{O}(\log{}n) @f$ time.
+    compiled-in data in a @f$ \mathcal{O}(1) @f$ time using a minimal
+    perfect hash table generated by @ref compile(), involving just a single
+    filename comparison. Resources compiled with older versions of
+    @ref corrade-rc "corrade-rc" that don't contain the hash table fall back
+    to a @f$ \mathcal{O}(\log{}n) @f$ binary search.
 
 @section Utility-Resource-conf Resource configuration file
 
@@ -92,6 +169,82 @@ filename=levels-insane.conf
 alias=levels-easy.conf
 @endcode
 
+@subsection Utility-Resource-conf-compression Compression
+
+Files can be compressed in order to make the executable smaller, using the
+`compression` option either globally for all files or for each file
+separately. The only supported value besides the default `none` is `lz4`,
+which stores the data in the [LZ4 block format](https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md).
+Files that wouldn't get smaller with compression are stored uncompressed. A
+frequently accessed file can be excluded from compression using
+`compression=none`:
+
+@code{.ini}
+group=shaders
+compression=lz4
+
+[file]
+filename=Flat.vert
+
+[file]
+filename=Phong.frag
+compression=none
+@endcode
+
+A compressed file is decompressed on the first @ref getRaw() or @ref get()
+call and the decompressed data cached for subsequent calls. The cached data
+stay valid until the resource is finalized with
+@ref CORRADE_RESOURCE_FINALIZE().
+
+@subsection Utility-Resource-conf-alignment Alignment
+
+By default, the data returned from @ref getRaw() don't have any alignment
+guarantees. Using the `align` option, either globally or for each file
+separately, a file can be aligned to a power of two between 1 and 4096 bytes.
+The data of all files are then padded accordingly in the compiled resource,
+which makes it possible to for example @ref Containers::arrayCast() a view on
+an embedded table of floats or use aligned SIMD loads on it without copying
+first:
+
+@code{.ini}
+group=data
+
+[file]
+filename=lookup-table.bin
+align=16
+@endcode
+
+As decompression would have to allocate a copy, files with alignment larger
+than 1 are always stored uncompressed, regardless of the `compression`
+option. Files from a group overriden with @ref overrideGroup() are
+memory-mapped on platforms that support it and thus page-aligned; on other
+platforms only the default allocator alignment is guaranteed.
+
+@subsection Utility-Resource-conf-deduplication Deduplication
+
+If more files in a group have the same contents (and the same compression and
+alignment options), their data are stored only once and all of them point to
+the same memory. This makes it possible to for example reference a shared
+file under multiple aliases without making the executable larger.
+
+@section Utility-Resource-packs Resource packs
+
+Instead of compiling the resources into the executable, the same
+configuration file can be compiled into a standalone pack file using
+@ref compilePackFrom() or @ref corrade-rc "corrade-rc" with the `--pack`
+option. The pack is then loaded at runtime with @ref loadPack(), which makes
+it possible to update the data without relinking and keeps them out of the
+executable's address space until needed:
+
+@snippet Utility.cpp Resource-packs
+
+The pack has the same indexed layout as the compiled-in data, including the
+hash table, compression, alignment and deduplication, so the lookup has the
+same complexity. The file is memory-mapped where possible, which means data
+of a file get paged in only when actually accessed and uncompressed files are
+returned without any copy. The pack format is little-endian, loading it on
+big-endian platforms is not supported.
+
 @section Utility-Resource-multithreading Thread safety
 
 The resources register themselves into a global storage. If done
@@ -102,7 +255,8 @@ single thread or externally guarded to avoid data races. Same goes for the
 @ref overrideGroup() function.
 
 On the other hand, all other functionality only reads from the global storage
-and thus is thread-safe.
+and thus is thread-safe. If @ref CORRADE_BUILD_MULTITHREADED is enabled (the
+default), decompression of compressed files is guarded by a mutex.
 
 @todo Ad-hoc resources
  */
@@ -129,6 +283,28 @@ class CORRADE_UTILITY_EXPORT Resource {
          */
         static std::string compileFrom(const std::string& name, const std::string& configurationFile);
 
+        /**
+         * @brief Compile data resource file using configuration file, with data in an external file
+         * @param name          Resource name (see @ref CORRADE_RESOURCE_INITIALIZE())
+         * @param configurationFile Filename of configuration file
+         * @param incbinFile    Filename under which @p incbinData will be
+         *      saved, referenced from the generated code
+         * @param[out] incbinData Data of all files in the group
+         * @m_since_latest
+         *
+         * Like @ref compileFrom(const std::string&, const std::string&), but
+         * instead of the hexadecimal data representation, which is slow for
+         * the compiler to process, the data are put into @p incbinData and
+         * the generated C++ file references them using the assembler
+         * @cb{.asm} .incbin @ce directive. It's the caller responsibility to
+         * save @p incbinData to @p incbinFile, which should be an absolute
+         * path. The generated file contains also a SHA-1 digest of the data,
+         * so it changes every time the data change, even if their size stays
+         * the same. Supported only by GCC-compatible compilers on ELF, Mach-O
+         * and COFF targets, not by MSVC or Emscripten.
+         */
+        static std::string compileFrom(const std::string& name, const std::string& configurationFile, const std::string& incbinFile, std::string& incbinData);
+
         /**
          * @brief Override group
          * @param group         Group name
@@ -141,12 +317,76 @@ class CORRADE_UTILITY_EXPORT Resource {
          * same group will take data from live filesystem instead and fallback
          * to compiled-in resources only for files that are not found.
          *
+         * The files are loaded on first access and memory-mapped on
+         * platforms that support @ref Directory::mapRead(). Files already
+         * loaded by another instance are reused unless their modification
+         * time or size changed, so recreating the @ref Resource instance
+         * after a change loads again only the files that were actually
+         * modified. Because the files are mapped, they should be updated by
+         * replacing them (as most editors do) and not by overwriting their
+         * contents, which would be visible through already existing
+         * instances.
+         *
          * @attention Unlike all other methods of this class, this one is *not*
          *      thread-safe. See @ref Utility-Resource-multithreading for more
          *      information.
          */
         static void overrideGroup(const std::string& group, const std::string& configurationFile);
 
+        /**
+         * @brief Compile a resource pack using configuration file
+         * @param configurationFile Filename of configuration file
+         * @m_since_latest
+         *
+         * Like @ref compileFrom(const std::string&, const std::string&), but
+         * instead of a C++ file produces a standalone binary pack with the
+         * same indexed layout that can be loaded at runtime using
+         * @ref loadPack(). The group name is taken from the configuration
+         * file. Returns an empty string on error. See
+         * @ref Utility-Resource-packs for more information.
+         */
+        static std::string compilePackFrom(const std::string& configurationFile);
+
+        /**
+         * @brief Load a resource pack
+         * @param filename      Pack filename
+         * @m_since_latest
+         *
+         * Opens a pack produced by @ref compilePackFrom() or by
+         * @ref corrade-rc "corrade-rc" with the `--pack` option and
+         * registers it as a group, which is then accessible through
+         * @ref Resource instances the same way as compiled-in resources.
+         * The file is memory-mapped on platforms that support
+         * @ref Directory::mapRead() and @ref getRaw() returns views directly
+         * into the mapping, on other platforms it's read into memory. Prints
+         * a message to @ref Error and returns @cpp false @ce if the file
+         * can't be opened, is not a valid pack or a group of the same name
+         * already exists.
+         *
+         * @attention Same as @ref overrideGroup(), this function is *not*
+         *      thread-safe. See @ref Utility-Resource-multithreading for more
+         *      information.
+         * @see @ref unloadPack(), @ref hasGroup()
+         */
+        static bool loadPack(const std::string& filename);
+
+        /**
+         * @brief Unload a resource pack
+         * @param group         Group name
+         * @m_since_latest
+         *
+         * Unregisters a group previously loaded with @ref loadPack() and
+         * unmaps its file. Data previously returned from @ref getRaw() for
+         * this group and @ref Resource instances using it become dangling.
+         * Prints a message to @ref Error and returns @cpp false @ce if no
+         * pack of given group name is loaded.
+         *
+         * @attention Same as @ref overrideGroup(), this function is *not*
+         *      thread-safe. See @ref Utility-Resource-multithreading for more
+         *      information.
+         */
+        static bool unloadPack(const std::string& group);
+
         /** @brief Whether given group exists */
         static bool hasGroup(const std::string& group);
 
@@ -183,6 +423,9 @@ class CORRADE_UTILITY_EXPORT Resource {
          *
          * Returns a view on data of given file in the group. Expects that
          * the file exists. If the file is empty, returns @cpp nullptr @ce.
+         * If the file has the `align` option specified in the
+         * @ref Utility-Resource-conf-alignment "resource configuration file",
+         * the returned data are aligned to given value.
          */
         Containers::ArrayView<const char> getRaw(const std::string& filename) const;
 
@@ -191,6 +434,18 @@ class CORRADE_UTILITY_EXPORT Resource {
             return getInternal({filename, size - 1});
         }
 
+        /**
+         * @brief Get resource data using a key with a precalculated hash
+         * @m_since_latest
+         *
+         * Same as @ref getRaw(const std::string&) const, but uses the hash
+         * stored in @p key instead of calculating it. See @ref ResourceKey
+         * for more information.
+         */
+        Containers::ArrayView<const char> getRaw(const ResourceKey& key) const {
+            return getInternal({key.filename(), key.size()}, key.hash());
+        }
+
         /**
          * @brief Get resource data as a @ref std::string
          * @param filename      Filename in UTF-8
@@ -212,11 +467,14 @@ class CORRADE_UTILITY_EXPORT Resource {
         struct OverrideData;
 
         static bool hasGroupInternal(Containers::ArrayView<const char> group);
+        static CORRADE_UTILITY_LOCAL std::string compileFromInternal(const std::string& name, const std::string& configurationFile, const std::string* incbinFile, std::string* incbinData, bool pack);
+        static CORRADE_UTILITY_LOCAL std::string compileInternal(const std::string& name, const std::string& group, const std::vector<std::pair<std::string, std::string>>& files, const std::vector<unsigned int>& compression, const std::vector<unsigned int>& alignment, const std::string* incbinFile, std::string* incbinData, bool pack);
 
         /* The void* is just to avoid this being matched by accident */
         explicit Resource(Containers::ArrayView<const char> group, void*);
 
         Containers::ArrayView<const char> getInternal(Containers::ArrayView<const char> filename) const;
+        Containers::ArrayView<const char> getInternal(Containers::ArrayView<const char> filename, std::uint32_t hash) const;
 
         Implementation::ResourceGroup* _group;
         OverrideData* _overrideGroup;
@@ -293,6 +551,26 @@ struct ResourceGroup {
     const unsigned int* positions;
     const unsigned char* filenames;
     const unsigned char* data;
+    /* Minimal perfect hash table generated by corrade-rc, see
+       Implementation::resourceHashTable() for details. Resources compiled
+       with older versions leave this zero-initialized, falling back to a
+       binary search. */
+    const unsigned int* hashTable;
+    /* Pairs of compression and decompressed size for each file or nullptr if
+       no file is compressed, see Implementation::ResourceCompression* */
+    const unsigned int* compression;
+    /* Alignment of each file or nullptr if all files have an alignment of 1.
+       Data of a file start at the end of the previous file rounded up to its
+       alignment. */
+    const unsigned int* alignment;
+    /* Index of a file whose data each file uses or nullptr if no file has
+       the same contents as some other file. Data of a file that's a
+       duplicate are empty and the ones of the original are used instead. */
+    const unsigned int* duplicates;
+    /* Decompressed data of compressed files, allocated on first access to a
+       compressed file and freed in Resource::unregisterData(). Not touched by
+       the generated code, zero-initialized. */
+    void* decompressed;
     /* This field shouldn't be written to by anything else than
        resourceInitializer() / resourceFinalizer(). It's zero-initilized by
        default and those use it to avoid inserting a single item to the linked
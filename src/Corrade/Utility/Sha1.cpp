@@ -27,10 +27,19 @@
 #include "Sha1.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
 
 #include "Corrade/Containers/ArrayView.h"
 #include "Corrade/Utility/Endianness.h"
+#include "Corrade/Utility/Implementation/sha1.h"
+
+#ifdef CORRADE_TARGET_X86
+#include <immintrin.h>
+#endif
+#if defined(__ARM_NEON) && (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO))
+#include <arm_neon.h>
+#endif
 
 namespace Corrade { namespace Utility {
 
@@ -51,6 +60,215 @@ unsigned int leftrotate(unsigned int data, unsigned int shift) {
     return data << shift | data >> (32 - shift);
 }
 
+void processScalar(unsigned int* const digest, const char* data, std::size_t count) {
+    for(; count; --count, data += 64) {
+        /* Extend the data to 80 bytes, make it big endian */
+        unsigned int extended[80];
+        /* Some memory juggling to avoid unaligned reads on platforms that
+           don't like it (Emscripten). The data don't have any endianness, so
+           take the first byte first, as usual. */
+        for(int i = 0; i != 16; ++i)
+            extended[i] =
+                (static_cast<unsigned int>(static_cast<unsigned char>(data[i*4 + 0])) << 24) |
+                (static_cast<unsigned int>(static_cast<unsigned char>(data[i*4 + 1])) << 16) |
+                (static_cast<unsigned int>(static_cast<unsigned char>(data[i*4 + 2])) <<  8) |
+                (static_cast<unsigned int>(static_cast<unsigned char>(data[i*4 + 3])) <<  0);
+        for(int i = 16; i != 80; ++i)
+            extended[i] = leftrotate((extended[i-3] ^ extended[i-8] ^ extended[i-14] ^ extended[i-16]), 1);
+
+        /* Initialize value for this chunk */
+        unsigned int d[5];
+        unsigned int f, constant, temp;
+        std::copy(digest, digest+5, d);
+
+        /* Main loop */
+        for(int i = 0; i != 80; ++i) {
+            if(i < 20) {
+                f = d[3] ^ (d[1] & (d[2] ^ d[3]));
+                constant = Constants[0];
+            } else if(i < 40) {
+                f = d[1] ^ d[2] ^ d[3];
+                constant = Constants[1];
+            } else if(i < 60) {
+                f = (d[1] & d[2]) | (d[3] & (d[1] | d[2]));
+                constant = Constants[2];
+            } else {
+                f = d[1] ^ d[2] ^ d[3];
+                constant = Constants[3];
+            }
+
+            temp =
+                leftrotate(d[0], 5) + f + d[4] + constant + extended[i];
+            d[4] = d[3];
+            d[3] = d[2];
+            d[2] = leftrotate(d[1], 30);
+            d[1] = d[0];
+            d[0] = temp;
+        }
+
+        /* Add the values to digest */
+        for(int i = 0; i != 5; ++i)
+            digest[i] += d[i];
+    }
+}
+
+#ifdef CORRADE_TARGET_X86
+/* Four rounds with the message schedule for the following rounds
+   interleaved, group being the index of the four rounds. The first group is
+   different and is done directly in processSha(). */
+template<int group> CORRADE_ENABLE_SHA CORRADE_ENABLE_SSSE3 inline void roundsSha(__m128i& abcd, __m128i& e0, __m128i& e1, __m128i(&message)[4]) {
+    __m128i& e = group % 2 ? e1 : e0;
+    __m128i& next = group % 2 ? e0 : e1;
+    e = _mm_sha1nexte_epu32(e, message[group % 4]);
+    next = abcd;
+    if(group >= 3 && group <= 18)
+        message[(group + 1) % 4] = _mm_sha1msg2_epu32(message[(group + 1) % 4], message[group % 4]);
+    abcd = _mm_sha1rnds4_epu32(abcd, e, group/5);
+    if(group >= 1 && group <= 16)
+        message[(group + 3) % 4] = _mm_sha1msg1_epu32(message[(group + 3) % 4], message[group % 4]);
+    if(group >= 2 && group <= 17)
+        message[(group + 2) % 4] = _mm_xor_si128(message[(group + 2) % 4], message[group % 4]);
+}
+
+CORRADE_ENABLE_SHA CORRADE_ENABLE_SSSE3 void processSha(unsigned int* const digest, const char* data, std::size_t count) {
+    /* Reverses bytes in each 32-bit word */
+    const __m128i byteSwap = _mm_set_epi64x(0x0001020304050607ull, 0x08090a0b0c0d0e0full);
+
+    /* The instructions expect A in the highest word and E separately in the
+       highest word of another register */
+    __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(digest)), 0x1b);
+    __m128i e0 = _mm_set_epi32(int(digest[4]), 0, 0, 0);
+    __m128i e1;
+
+    for(; count; --count, data += 64) {
+        const __m128i abcdPrevious = abcd;
+        const __m128i ePrevious = e0;
+
+        __m128i message[4];
+        for(std::size_t i = 0; i != 4; ++i)
+            message[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i*16)), byteSwap);
+
+        e0 = _mm_add_epi32(e0, message[0]);
+        e1 = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+        roundsSha<1>(abcd, e0, e1, message);
+        roundsSha<2>(abcd, e0, e1, message);
+        roundsSha<3>(abcd, e0, e1, message);
+        roundsSha<4>(abcd, e0, e1, message);
+        roundsSha<5>(abcd, e0, e1, message);
+        roundsSha<6>(abcd, e0, e1, message);
+        roundsSha<7>(abcd, e0, e1, message);
+        roundsSha<8>(abcd, e0, e1, message);
+        roundsSha<9>(abcd, e0, e1, message);
+        roundsSha<10>(abcd, e0, e1, message);
+        roundsSha<11>(abcd, e0, e1, message);
+        roundsSha<12>(abcd, e0, e1, message);
+        roundsSha<13>(abcd, e0, e1, message);
+        roundsSha<14>(abcd, e0, e1, message);
+        roundsSha<15>(abcd, e0, e1, message);
+        roundsSha<16>(abcd, e0, e1, message);
+        roundsSha<17>(abcd, e0, e1, message);
+        roundsSha<18>(abcd, e0, e1, message);
+        roundsSha<19>(abcd, e0, e1, message);
+
+        e0 = _mm_sha1nexte_epu32(e0, ePrevious);
+        abcd = _mm_add_epi32(abcd, abcdPrevious);
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(digest), _mm_shuffle_epi32(abcd, 0x1b));
+    digest[4] = unsigned(_mm_extract_epi16(e0, 7)) << 16 | unsigned(_mm_extract_epi16(e0, 6));
+}
+#endif
+
+#if defined(__ARM_NEON) && (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO))
+/* Four rounds with the message schedule for the following rounds
+   interleaved, group being the index of the four rounds. Constants for the
+   rounds are added two groups in advance. */
+template<int group> inline void roundsNeonSha1(uint32x4_t& abcd, std::uint32_t& e0, std::uint32_t& e1, uint32x4_t(&message)[4], uint32x4_t(&withConstants)[2]) {
+    std::uint32_t& e = group % 2 ? e1 : e0;
+    std::uint32_t& next = group % 2 ? e0 : e1;
+    next = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+    if(group < 5)
+        abcd = vsha1cq_u32(abcd, e, withConstants[group % 2]);
+    else if(group >= 10 && group < 15)
+        abcd = vsha1mq_u32(abcd, e, withConstants[group % 2]);
+    else
+        abcd = vsha1pq_u32(abcd, e, withConstants[group % 2]);
+    if(group <= 17)
+        withConstants[group % 2] = vaddq_u32(message[(group + 2) % 4], vdupq_n_u32(Constants[(group + 2)/5]));
+    if(group >= 1 && group <= 16)
+        message[(group + 3) % 4] = vsha1su1q_u32(message[(group + 3) % 4], message[(group + 2) % 4]);
+    if(group <= 15)
+        message[group % 4] = vsha1su0q_u32(message[group % 4], message[(group + 1) % 4], message[(group + 2) % 4]);
+}
+
+void processNeonSha1(unsigned int* const digest, const char* data, std::size_t count) {
+    uint32x4_t abcd = vld1q_u32(digest);
+    std::uint32_t e0 = digest[4];
+    std::uint32_t e1;
+
+    for(; count; --count, data += 64) {
+        const uint32x4_t abcdPrevious = abcd;
+        const std::uint32_t ePrevious = e0;
+
+        uint32x4_t message[4];
+        for(std::size_t i = 0; i != 4; ++i)
+            message[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(reinterpret_cast<const std::uint8_t*>(data + i*16))));
+
+        uint32x4_t withConstants[2]{
+            vaddq_u32(message[0], vdupq_n_u32(Constants[0])),
+            vaddq_u32(message[1], vdupq_n_u32(Constants[0]))
+        };
+        roundsNeonSha1<0>(abcd, e0, e1, message, withConstants);
+        roundsNeonSha1<1>(abcd, e0, e1, message, withConstants);
+        roundsNeonSha1<2>(abcd, e0, e1, message, withConstants);
+        roundsNeonSha1<3>(abcd, e0, e1, message, withConstants);
+        roundsNeonSha1<4>(abcd, e0, e1, message, withConstants);
+        roundsNeonSha1<5>(abcd, e0, e1, message, withConstants);
+        roundsNeonSha1<6>(abcd, e0, e1, message, withConstants);
+        roundsNeonSha1<7>(abcd, e0, e1, message, withConstants);
+        roundsNeonSha1<8>(abcd, e0, e1, message, withConstants);
+        roundsNeonSha1<9>(abcd, e0, e1, message, withConstants);
+        roundsNeonSha1<10>(abcd, e0, e1, message, withConstants);
+        roundsNeonSha1<11>(abcd, e0, e1, message, withConstants);
+        roundsNeonSha1<12>(abcd, e0, e1, message, withConstants);
+        roundsNeonSha1<13>(abcd, e0, e1, message, withConstants);
+        roundsNeonSha1<14>(abcd, e0, e1, message, withConstants);
+        roundsNeonSha1<15>(abcd, e0, e1, message, withConstants);
+        roundsNeonSha1<16>(abcd, e0, e1, message, withConstants);
+        roundsNeonSha1<17>(abcd, e0, e1, message, withConstants);
+        roundsNeonSha1<18>(abcd, e0, e1, message, withConstants);
+        roundsNeonSha1<19>(abcd, e0, e1, message, withConstants);
+
+        e0 += ePrevious;
+        abcd = vaddq_u32(abcd, abcdPrevious);
+    }
+
+    vst1q_u32(digest, abcd);
+    digest[4] = e0;
+}
+#endif
+
+Implementation::Sha1ProcessFunction process() {
+    static const Implementation::Sha1ProcessFunction function = Implementation::sha1ProcessFunction(Cpu::runtimeFeatures());
+    return function;
+}
+
+}
+
+namespace Implementation {
+
+Sha1ProcessFunction sha1ProcessFunction(const Cpu::Features features) {
+    return Cpu::dispatch<Sha1ProcessFunction>(features, {
+        #ifdef CORRADE_TARGET_X86
+        {Cpu::Feature::Sha|Cpu::Feature::Ssse3, processSha},
+        #endif
+        #if defined(__ARM_NEON) && (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO))
+        {Cpu::Feature::NeonSha1, processNeonSha1},
+        #endif
+    }, processScalar);
+}
+
 }
 
 Sha1::Sha1(): _digest{InitialDigest[0], InitialDigest[1], InitialDigest[2], InitialDigest[3], InitialDigest[4]} {}
@@ -71,11 +289,11 @@ Sha1& Sha1::operator<<(Containers::ArrayView<const char> data) {
         /* Append few last bytes to have the buffer at 64 bytes */
         std::memcpy(_buffer + _bufferSize, data.data(), dataOffset);
         _bufferSize += dataOffset;
-        processChunk(_buffer);
+        process()(_digest, _buffer, 1);
     }
 
-    for(std::size_t i = dataOffset; i + 64 <= data.size(); i += 64)
-        processChunk(data.data() + i);
+    /* Process all complete blocks at once */
+    process()(_digest, data.data() + dataOffset, (data.size() - dataOffset)/64);
 
     /* Save last unfinished 512-bit chunk of data */
     auto leftOver = data.suffix(dataOffset + ((data.size() - dataOffset)/64)*64);
@@ -117,9 +335,7 @@ Sha1::Digest Sha1::digest() {
     _bufferSize += 8;
 
     /* Process remaining chunks */
-    for(std::size_t i = 0; i != _bufferSize/64; ++i) {
-        processChunk(_buffer+i*64);
-    }
+    process()(_digest, _buffer, _bufferSize/64);
 
     /* Convert digest from big endian */
     unsigned int digest[5];
@@ -137,54 +353,4 @@ Sha1::Digest Sha1::digest() {
 #pragma GCC pop_options
 #endif
 
-void Sha1::processChunk(const char* data) {
-    /* Extend the data to 80 bytes, make it big endian */
-    unsigned int extended[80];
-    /* Some memory juggling to avoid unaligned reads on platforms that don't
-       like it (Emscripten). The data don't have any endianness, so take the
-       first byte first, as usual. */
-    for(int i = 0; i != 16; ++i)
-        extended[i] =
-            (static_cast<unsigned int>(static_cast<unsigned char>(data[i*4 + 0])) << 24) |
-            (static_cast<unsigned int>(static_cast<unsigned char>(data[i*4 + 1])) << 16) |
-            (static_cast<unsigned int>(static_cast<unsigned char>(data[i*4 + 2])) <<  8) |
-            (static_cast<unsigned int>(static_cast<unsigned char>(data[i*4 + 3])) <<  0);
-    for(int i = 16; i != 80; ++i)
-        extended[i] = leftrotate((extended[i-3] ^ extended[i-8] ^ extended[i-14] ^ extended[i-16]), 1);
-
-    /* Initialize value for this chunk */
-    unsigned int d[5];
-    unsigned int f, constant, temp;
-    std::copy(_digest, _digest+5, d);
-
-    /* Main loop */
-    for(int i = 0; i != 80; ++i) {
-        if(i < 20) {
-            f = d[3] ^ (d[1] & (d[2] ^ d[3]));
-            constant = Constants[0];
-        } else if(i < 40) {
-            f = d[1] ^ d[2] ^ d[3];
-            constant = Constants[1];
-        } else if(i < 60) {
-            f = (d[1] & d[2]) | (d[3] & (d[1] | d[2]));
-            constant = Constants[2];
-        } else {
-            f = d[1] ^ d[2] ^ d[3];
-            constant = Constants[3];
-        }
-
-        temp =
-            leftrotate(d[0], 5) + f + d[4] + constant + extended[i];
-        d[4] = d[3];
-        d[3] = d[2];
-        d[2] = leftrotate(d[1], 30);
-        d[1] = d[0];
-        d[0] = temp;
-    }
-
-    /* Add the values to digest */
-    for(int i = 0; i != 5; ++i)
-        _digest[i] += d[i];
-}
-
 }}
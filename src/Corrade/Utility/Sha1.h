@@ -44,6 +44,18 @@ Implementation of the [Secure Hash Algorithm 1](https://en.wikipedia.org/wiki/SH
 Example usage:
 
 @snippet Utility.cpp Sha1-usage
+
+@section Utility-Sha1-acceleration Hardware acceleration
+
+Blocks are processed with the x86
+[SHA extensions](https://en.wikipedia.org/wiki/Intel_SHA_extensions) if
+@ref Cpu::runtimeFeatures() reports @ref Cpu::Feature::Sha. On ARM, the
+ARMv8 SHA-1 instructions are used if the library is compiled with the
+Cryptographic Extension enabled, which is reported as
+@ref Cpu::Feature::NeonSha1. A portable implementation is used otherwise.
+Data passed to @ref operator<<(Containers::ArrayView<const char>) are
+processed directly, only the incomplete block at the end is copied to an
+internal buffer.
 */
 class CORRADE_UTILITY_EXPORT Sha1: public AbstractHash<20> {
     public:
@@ -76,8 +88,6 @@ class CORRADE_UTILITY_EXPORT Sha1: public AbstractHash<20> {
         Digest digest();
 
     private:
-        CORRADE_UTILITY_LOCAL void processChunk(const char* data);
-
         char _buffer[128];
         std::size_t _bufferSize = 0;
         unsigned long long _dataSize = 0;
@@ -25,22 +25,36 @@
 
 #include "String.h"
 
-#include <cctype>
+#include <cstdint>
 #include <cstring>
 #include <algorithm>
 
+#include "Corrade/Containers/GrowableArray.h"
 #include "Corrade/Containers/StaticArray.h"
+#include "Corrade/Containers/StringView.h"
+#include "Corrade/Utility/Cpu.h"
+
+#ifdef CORRADE_TARGET_X86
+#include <immintrin.h>
+#endif
+#ifdef __ARM_NEON
+#include <arm_neon.h>
+#endif
 
 namespace Corrade { namespace Utility { namespace String {
 
 namespace Implementation {
 
+/* The trimming and splitting is delegated to StringView, which uses
+   vectorized character set lookup instead of the byte-by-byte loops in
+   std::string::find_first_of() and friends */
+
 void ltrimInPlace(std::string& string, const Containers::ArrayView<const char> characters) {
-    string.erase(0, string.find_first_not_of(characters, 0, characters.size()));
+    string.erase(0, Containers::StringView{string.data(), string.size()}.trimmedPrefix(characters).data() - string.data());
 }
 
 void rtrimInPlace(std::string& string, const Containers::ArrayView<const char> characters) {
-    string.erase(string.find_last_not_of(characters, std::string::npos, characters.size())+1);
+    string.erase(Containers::StringView{string.data(), string.size()}.trimmedSuffix(characters).size());
 }
 
 void trimInPlace(std::string& string, const Containers::ArrayView<const char> characters) {
@@ -64,18 +78,12 @@ std::string trim(std::string string, const Containers::ArrayView<const char> cha
 }
 
 std::vector<std::string> splitWithoutEmptyParts(const std::string& string, const Containers::ArrayView<const char> delimiters) {
-    std::vector<std::string> parts;
-    std::size_t oldpos = 0, pos = std::string::npos;
-
-    while((pos = string.find_first_of(delimiters, oldpos, delimiters.size())) != std::string::npos) {
-        if(pos != oldpos)
-            parts.push_back(string.substr(oldpos, pos-oldpos));
-
-        oldpos = pos+1;
-    }
+    const Containers::Array<Containers::StringView> views = Containers::StringView{string.data(), string.size()}.splitWithoutEmptyParts(delimiters);
 
-    if(!string.empty() && (oldpos < string.size()))
-        parts.push_back(string.substr(oldpos));
+    std::vector<std::string> parts;
+    parts.reserve(views.size());
+    for(const Containers::StringView view: views)
+        parts.emplace_back(view.data(), view.size());
 
     return parts;
 }
@@ -255,14 +263,235 @@ Containers::StaticArray<3, std::string> rpartition(const std::string& string, co
     return rpartitionInternal(string, {separator.data(), separator.size()});
 }
 
+std::string replaceAll(std::string string, const Containers::ArrayView<const std::pair<Containers::StringView, Containers::StringView>> replacements) {
+    /* Bucket the patterns by their first byte so at each position only the
+       patterns that can possibly match are compared. Patterns sharing the
+       first byte are sorted by length, longest first, keeping the original
+       order for equal lengths, so the first match is the one to use. */
+    std::size_t bucketOffsets[257]{};
+    for(const std::pair<Containers::StringView, Containers::StringView>& replacement: replacements) {
+        CORRADE_ASSERT(!replacement.first.empty(),
+            "Utility::String::replaceAll(): empty search string would cause an infinite loop", {});
+        ++bucketOffsets[std::uint8_t(replacement.first[0]) + 1];
+    }
+    for(std::size_t i = 0; i != 256; ++i)
+        bucketOffsets[i + 1] += bucketOffsets[i];
+
+    Containers::Array<std::size_t> buckets{Containers::NoInit, replacements.size()};
+    {
+        std::size_t bucketFill[256];
+        std::copy(bucketOffsets, bucketOffsets + 256, bucketFill);
+        for(std::size_t i = 0; i != replacements.size(); ++i)
+            buckets[bucketFill[std::uint8_t(replacements[i].first[0])]++] = i;
+    }
+    for(std::size_t i = 0; i != 256; ++i)
+        std::stable_sort(buckets + bucketOffsets[i], buckets + bucketOffsets[i + 1], [&](std::size_t a, std::size_t b) {
+            return replacements[a].first.size() > replacements[b].first.size();
+        });
+
+    /* First pass, remember where the matches are and calculate the output
+       size */
+    Containers::Array<std::pair<std::size_t, std::size_t>> matches;
+    std::size_t size = string.size();
+    const char* const data = string.data();
+    const std::size_t stringSize = string.size();
+    for(std::size_t i = 0; i < stringSize; ) {
+        const std::uint8_t c = data[i];
+        bool found = false;
+        for(std::size_t j = bucketOffsets[c], end = bucketOffsets[c + 1]; j != end; ++j) {
+            const Containers::StringView search = replacements[buckets[j]].first;
+            if(search.size() > stringSize - i || std::memcmp(data + i, search.data(), search.size()) != 0) continue;
+
+            arrayAppend(matches, Containers::InPlaceInit, i, buckets[j]);
+            size = size - search.size() + replacements[buckets[j]].second.size();
+            i += search.size();
+            found = true;
+            break;
+        }
+
+        if(!found) ++i;
+    }
+
+    if(matches.empty()) return string;
+
+    /* Second pass, copy everything to an exactly sized output */
+    std::string out;
+    out.reserve(size);
+    std::size_t previous = 0;
+    for(const std::pair<std::size_t, std::size_t>& match: matches) {
+        const std::pair<Containers::StringView, Containers::StringView>& replacement = replacements[match.second];
+        out.append(data + previous, match.first - previous);
+        if(!replacement.second.empty())
+            out.append(replacement.second.data(), replacement.second.size());
+        previous = match.first + replacement.first.size();
+    }
+    out.append(data + previous, stringSize - previous);
+
+    return out;
+}
+
+std::string replaceAll(std::string string, const std::initializer_list<std::pair<Containers::StringView, Containers::StringView>> replacements) {
+    return replaceAll(std::move(string), Containers::arrayView(replacements));
+}
+
+namespace {
+
+/* Case conversion flips the 0x20 bit of characters in the 'A' to 'Z' or 'a'
+   to 'z' range. A character is in the range if subtracting the range start
+   gives an unsigned value less than 26. The conversion is idempotent, so the
+   vectorized variants can handle the remaining bytes by converting the last
+   whole vector again, overlapping with the previous one. */
+typedef void(*ConvertCaseFunction)(char*, char*);
+
+template<char from> void convertCaseScalar(char* const begin, char* const end) {
+    for(char* i = begin; i != end; ++i)
+        if(std::uint8_t(*i - from) < 26) *i ^= 0x20;
+}
+
+#ifdef CORRADE_TARGET_X86
+template<char from> CORRADE_ENABLE_SSE2 inline void convertCaseSse2Block(char* const i) {
+    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(i));
+    const __m128i shifted = _mm_sub_epi8(chunk, _mm_set1_epi8(from));
+    const __m128i inRange = _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(25)), shifted);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(i), _mm_xor_si128(chunk, _mm_and_si128(inRange, _mm_set1_epi8(0x20))));
+}
+
+template<char from> CORRADE_ENABLE_SSE2 void convertCaseSse2(char* const begin, char* const end) {
+    if(end - begin < 16) return convertCaseScalar<from>(begin, end);
+
+    char* i = begin;
+    for(; end - i >= 16; i += 16) convertCaseSse2Block<from>(i);
+    if(i != end) convertCaseSse2Block<from>(end - 16);
+}
+
+template<char from> CORRADE_ENABLE_AVX2 inline void convertCaseAvx2Block(char* const i) {
+    const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(i));
+    const __m256i shifted = _mm256_sub_epi8(chunk, _mm256_set1_epi8(from));
+    const __m256i inRange = _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, _mm256_set1_epi8(25)), shifted);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(i), _mm256_xor_si256(chunk, _mm256_and_si256(inRange, _mm256_set1_epi8(0x20))));
+}
+
+template<char from> CORRADE_ENABLE_AVX2 void convertCaseAvx2(char* const begin, char* const end) {
+    if(end - begin < 32) return convertCaseSse2<from>(begin, end);
+
+    char* i = begin;
+    for(; end - i >= 32; i += 32) convertCaseAvx2Block<from>(i);
+    if(i != end) convertCaseAvx2Block<from>(end - 32);
+}
+#endif
+
+#ifdef __ARM_NEON
+template<char from> inline void convertCaseNeonBlock(char* const i) {
+    std::uint8_t* const i8 = reinterpret_cast<std::uint8_t*>(i);
+    const uint8x16_t chunk = vld1q_u8(i8);
+    const uint8x16_t inRange = vcltq_u8(vsubq_u8(chunk, vdupq_n_u8(from)), vdupq_n_u8(26));
+    vst1q_u8(i8, veorq_u8(chunk, vandq_u8(inRange, vdupq_n_u8(0x20))));
+}
+
+template<char from> void convertCaseNeon(char* const begin, char* const end) {
+    if(end - begin < 16) return convertCaseScalar<from>(begin, end);
+
+    char* i = begin;
+    for(; end - i >= 16; i += 16) convertCaseNeonBlock<from>(i);
+    if(i != end) convertCaseNeonBlock<from>(end - 16);
+}
+#endif
+
+template<char from> ConvertCaseFunction pickConvertCase() {
+    return Cpu::dispatch<ConvertCaseFunction>({
+        #ifdef CORRADE_TARGET_X86
+        {Cpu::Feature::Avx2, convertCaseAvx2<from>},
+        {Cpu::Feature::Sse2, convertCaseSse2<from>},
+        #endif
+    },
+        #ifdef __ARM_NEON
+        convertCaseNeon<from>
+        #else
+        convertCaseScalar<from>
+        #endif
+    );
+}
+
+/* Lowercases all ASCII characters in a 64-bit word at once. Adding to the
+   low seven bits of each byte sets its high bit if the character is above
+   'Z' or at least 'A', respectively, without carrying over to the next byte.
+   Bytes with the high bit originally set are excluded. */
+inline std::uint64_t lowercaseWord(const std::uint64_t word) {
+    const std::uint64_t heptets = word & 0x7f7f7f7f7f7f7f7full;
+    const std::uint64_t aboveZ = heptets + 0x2525252525252525ull;
+    const std::uint64_t atLeastA = heptets + 0x3f3f3f3f3f3f3f3full;
+    const std::uint64_t upper = (atLeastA ^ aboveZ) & ~word & 0x8080808080808080ull;
+    return word | (upper >> 2);
+}
+
+inline std::uint64_t loadWord(const char* const data, const std::size_t size) {
+    std::uint64_t word = 0;
+    std::memcpy(&word, data, size);
+    return word;
+}
+
+}
+
+void lowercaseInPlace(const Containers::ArrayView<char> string) {
+    static const ConvertCaseFunction function = pickConvertCase<'A'>();
+    function(string.begin(), string.end());
+}
+
+void uppercaseInPlace(const Containers::ArrayView<char> string) {
+    static const ConvertCaseFunction function = pickConvertCase<'a'>();
+    function(string.begin(), string.end());
+}
+
 std::string lowercase(std::string string) {
-    std::transform(string.begin(), string.end(), string.begin(), static_cast<int (*)(int)>(std::tolower));
+    lowercaseInPlace({&string[0], string.size()});
     return string;
 }
 
 std::string uppercase(std::string string) {
-    std::transform(string.begin(), string.end(), string.begin(), static_cast<int (*)(int)>(std::toupper));
+    uppercaseInPlace({&string[0], string.size()});
     return string;
 }
 
+/* Config keys and similar are usually short, so comparing and hashing eight
+   bytes at a time without going through the runtime dispatch is faster than
+   the vectorized variants above */
+bool caseInsensitiveEquals(const Containers::StringView a, const Containers::StringView b) {
+    const std::size_t size = a.size();
+    if(b.size() != size) return false;
+
+    std::size_t i = 0;
+    for(; i + 8 <= size; i += 8)
+        if(lowercaseWord(loadWord(a.data() + i, 8)) != lowercaseWord(loadWord(b.data() + i, 8)))
+            return false;
+
+    return i == size || lowercaseWord(loadWord(a.data() + i, size - i)) == lowercaseWord(loadWord(b.data() + i, size - i));
+}
+
+std::size_t caseInsensitiveHash(const Containers::StringView string) {
+    /* MurmurHash64A mixing applied to the lowercased words */
+    constexpr std::uint64_t m = 0xc6a4a7935bd1e995ull;
+    const std::size_t size = string.size();
+    std::uint64_t h = size*m;
+
+    std::size_t i = 0;
+    for(; i + 8 <= size; i += 8) {
+        std::uint64_t k = lowercaseWord(loadWord(string.data() + i, 8));
+        k *= m;
+        k ^= k >> 47;
+        k *= m;
+        h ^= k;
+        h *= m;
+    }
+
+    if(i != size) {
+        h ^= lowercaseWord(loadWord(string.data() + i, size - i));
+        h *= m;
+    }
+
+    h ^= h >> 47;
+    h *= m;
+    h ^= h >> 47;
+    return std::size_t(h);
+}
+
 }}}
@@ -30,11 +30,14 @@
  */
 
 #include <cstddef>
+#include <initializer_list>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "Corrade/configure.h"
 #include "Corrade/Containers/ArrayView.h"
+#include "Corrade/Containers/StringView.h"
 #include "Corrade/Utility/visibility.h"
 
 namespace Corrade { namespace Utility {
@@ -42,6 +45,12 @@ namespace Corrade { namespace Utility {
 /**
 @brief String utilities
 
+The functions operate on and return @ref std::string instances, which means
+each returned part is a new allocation. For allocation-free alternatives
+returning views into the original data, such as
+@ref Containers::StringView::split() or
+@ref Containers::StringView::partition(), see @ref Containers::StringView.
+
 This library is built if `WITH_UTILITY` is enabled when building Corrade. To
 use this library with CMake, request the `Utility` component of the `Corrade`
 package and link to the `Corrade::Utility` target.
@@ -373,17 +382,70 @@ inline std::string joinWithoutEmptyParts(const std::vector<std::string>& strings
 /**
 @brief Convert string to lowercase
 
+Converts only ASCII characters, independently of the current C locale.
 @attention Doesn't work with UTF-8.
+@see @ref lowercaseInPlace()
 */
 CORRADE_UTILITY_EXPORT std::string lowercase(std::string string);
 
 /**
 @brief Convert string to uppercase
 
+Converts only ASCII characters, independently of the current C locale.
 @attention Doesn't work with UTF-8.
+@see @ref uppercaseInPlace()
 */
 CORRADE_UTILITY_EXPORT std::string uppercase(std::string string);
 
+/**
+@brief Convert string to lowercase in place
+@m_since_latest
+
+Converts only ASCII characters, independently of the current C locale. Bytes
+outside of the ASCII range are left untouched, which means UTF-8 text can be
+passed in without getting corrupted, but only its ASCII part is converted.
+The string is processed 16 or 32 bytes at a time using SSE2, AVX2 or NEON
+where available.
+@see @ref lowercase(), @ref Cpu::runtimeFeatures()
+*/
+CORRADE_UTILITY_EXPORT void lowercaseInPlace(Containers::ArrayView<char> string);
+
+/**
+@brief Convert string to uppercase in place
+@m_since_latest
+
+Converts only ASCII characters, independently of the current C locale. See
+@ref lowercaseInPlace() for more information.
+@see @ref uppercase()
+*/
+CORRADE_UTILITY_EXPORT void uppercaseInPlace(Containers::ArrayView<char> string);
+
+/**
+@brief Whether two strings are equal ignoring ASCII case
+@m_since_latest
+
+Equivalent to comparing @ref lowercase() of both strings, but without any
+allocation. Bytes outside of the ASCII range have to match exactly.
+@see @ref caseInsensitiveHash()
+*/
+CORRADE_UTILITY_EXPORT bool caseInsensitiveEquals(Containers::StringView a, Containers::StringView b);
+
+/**
+@brief Hash of a string ignoring ASCII case
+@m_since_latest
+
+Strings that are equal according to @ref caseInsensitiveEquals() have the
+same hash, so together the two can be used for case-insensitive key lookup
+in e.g. @ref std::unordered_map without creating lowercased copies of the
+keys:
+
+@snippet Utility.cpp String-caseInsensitiveHash
+
+The hash value is not guaranteed to be stable across Corrade versions or
+platforms.
+*/
+CORRADE_UTILITY_EXPORT std::size_t caseInsensitiveHash(Containers::StringView string);
+
 /**
 @brief Whether the string has given prefix
 
@@ -550,6 +612,35 @@ template<std::size_t replaceSize> inline std::string replaceAll(std::string stri
     return Implementation::replaceAll(std::move(string), {search.data(), search.size()}, {replace, replaceSize - 1});
 }
 
+/**
+@brief Replace all occurences of multiple patterns in a string
+@m_since_latest
+
+Replaces all occurences of each search string with its replacement in a single
+pass over @p string. At every position the longest matching search string
+wins, ties are resolved by the order in @p replacements. Replaced text is not
+searched again, so applying for example @cpp {{"a", "b"}, {"b", "a"}} @ce
+swaps the two characters. The output size is calculated upfront and the
+result is allocated just once. Returns @p string unmodified if it doesn't
+contain any of the search strings. Expects that none of the search strings is
+empty.
+
+@snippet Utility.cpp String-replaceAll-multiple
+
+Compared to calling @ref replaceAll(std::string, const std::string&, const std::string&)
+for each pattern separately, which goes through the whole string and
+reallocates it for every pair, this is significantly faster for larger
+inputs. Include @ref Corrade/Containers/StringStl.h to be able to pass
+@ref std::string instances in @p replacements.
+*/
+CORRADE_UTILITY_EXPORT std::string replaceAll(std::string string, Containers::ArrayView<const std::pair<Containers::StringView, Containers::StringView>> replacements);
+
+/**
+@overload
+@m_since_latest
+*/
+CORRADE_UTILITY_EXPORT std::string replaceAll(std::string string, std::initializer_list<std::pair<Containers::StringView, Containers::StringView>> replacements);
+
 }}}
 
 #endif
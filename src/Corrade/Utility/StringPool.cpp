@@ -0,0 +1,182 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "StringPool.h"
+
+#include <cstdlib>
+#include <cstring>
+#ifdef CORRADE_BUILD_MULTITHREADED
+#include <mutex>
+#endif
+
+#include "Corrade/Containers/GrowableArray.h"
+#include "Corrade/Containers/HashMap.h"
+#include "Corrade/Utility/Assert.h"
+#include "Corrade/Utility/Debug.h"
+
+namespace Corrade { namespace Utility {
+
+/* String data are copied into a singly-linked list of malloc'd blocks that
+   never move, the hash map and the ID table then only store views into
+   them. */
+
+namespace {
+
+struct Block {
+    Block* next;
+    /* The data follow */
+    char* data() { return reinterpret_cast<char*>(this + 1); }
+};
+
+}
+
+struct StringPool::State {
+    explicit State(std::size_t blockSize) noexcept: blockSize{blockSize} {}
+
+    ~State() {
+        for(Block* block = first; block; ) {
+            Block* const next = block->next;
+            std::free(block);
+            block = next;
+        }
+    }
+
+    /* Expects the mutex to be locked */
+    Containers::StringView copy(const Containers::StringView string) {
+        const std::size_t size = string.size() + 1;
+        if(size > std::size_t(end - top)) {
+            /* Strings larger than the block size get a dedicated block that
+               gets linked after the current one, so the rest of the current
+               block can still be used */
+            const std::size_t blockDataSize = size > blockSize ? size : blockSize;
+            Block* const block = static_cast<Block*>(std::malloc(sizeof(Block) + blockDataSize));
+            if(blockDataSize != blockSize && current) {
+                block->next = current->next;
+                current->next = block;
+                char* const out = block->data();
+                return fill(out, string);
+            }
+
+            block->next = nullptr;
+            if(current) current->next = block;
+            else first = block;
+            current = block;
+            top = block->data();
+            end = top + blockDataSize;
+        }
+
+        char* const out = top;
+        top += size;
+        return fill(out, string);
+    }
+
+    Containers::StringView fill(char* const out, const Containers::StringView string) {
+        if(string.size()) std::memcpy(out, string.data(), string.size());
+        out[string.size()] = '\0';
+        dataSize += string.size() + 1;
+        return {out, string.size()};
+    }
+
+    /* Expects the mutex to be locked */
+    std::uint32_t intern(const Containers::StringView string) {
+        if(const std::uint32_t* const found = ids.find(string))
+            return *found;
+
+        const Containers::StringView copied = copy(string);
+        const std::uint32_t id = strings.size();
+        arrayAppend(strings, copied);
+        ids.insert(copied, id);
+        return id;
+    }
+
+    std::size_t blockSize;
+    std::size_t dataSize{};
+    Block* first{};
+    Block* current{};
+    char* top{};
+    char* end{};
+
+    Containers::HashMap<Containers::StringView, std::uint32_t> ids;
+    Containers::Array<Containers::StringView> strings;
+    #ifdef CORRADE_BUILD_MULTITHREADED
+    mutable std::mutex mutex;
+    #endif
+};
+
+#ifdef CORRADE_BUILD_MULTITHREADED
+#define LOCK() std::lock_guard<std::mutex> lock{_state->mutex}
+#else
+#define LOCK() do {} while(false)
+#endif
+
+StringPool& StringPool::global() {
+    /* Function-local static initialization is thread-safe since C++11 */
+    static StringPool pool;
+    return pool;
+}
+
+StringPool::StringPool(const std::size_t blockSize): _state{Containers::InPlaceInit, blockSize} {}
+
+StringPool::~StringPool() = default;
+
+std::size_t StringPool::size() const {
+    LOCK();
+    return _state->strings.size();
+}
+
+std::size_t StringPool::dataSize() const {
+    LOCK();
+    return _state->dataSize;
+}
+
+std::uint32_t StringPool::intern(const Containers::StringView string) {
+    LOCK();
+    return _state->intern(string);
+}
+
+Containers::StringView StringPool::internView(const Containers::StringView string) {
+    LOCK();
+    /* Not indexing directly as the data pointer could get fetched before
+       intern() reallocates the array */
+    const std::uint32_t id = _state->intern(string);
+    return _state->strings[id];
+}
+
+std::uint32_t StringPool::find(const Containers::StringView string) const {
+    LOCK();
+    const std::uint32_t* const found = _state->ids.find(string);
+    return found ? *found : 0xffffffffu;
+}
+
+Containers::StringView StringPool::operator[](const std::uint32_t id) const {
+    LOCK();
+    CORRADE_ASSERT(id < _state->strings.size(),
+        "Utility::StringPool::operator[](): index" << id << "out of range for" << _state->strings.size() << "strings", {});
+    return _state->strings[id];
+}
+
+#undef LOCK
+
+}}
@@ -0,0 +1,159 @@
+#ifndef Corrade_Utility_StringPool_h
+#define Corrade_Utility_StringPool_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Utility::StringPool
+ * @m_since_latest
+ */
+
+#include <cstdint>
+
+#include "Corrade/Containers/Pointer.h"
+#include "Corrade/Containers/StringView.h"
+#include "Corrade/Utility/Utility.h"
+#include "Corrade/Utility/visibility.h"
+
+namespace Corrade { namespace Utility {
+
+/**
+@brief String interning pool
+@m_since_latest
+
+Stores a single copy of each distinct string and assigns it a dense ID.
+Strings are copied into large blocks that are never moved or freed until the
+pool is destroyed, so views returned by @ref intern() and @ref operator[]()
+stay valid for the whole pool lifetime and two strings interned in the same
+pool are equal if and only if their IDs or data pointers are equal. That
+makes interning a good fit for keys that are repeated many times and compared
+often, such as configuration keys or plugin names:
+
+@snippet Utility.cpp StringPool-usage
+
+Each interned string is followed by a null terminator, so the returned views
+can be passed directly to APIs taking C strings. An empty string is interned
+like any other.
+
+@section Utility-StringPool-thread-safety Thread safety
+
+If Corrade is compiled with @ref CORRADE_BUILD_MULTITHREADED enabled (the
+default), all operations are guarded by a mutex, so a single pool can be
+shared among multiple threads, including the process-wide one returned by
+@ref global(). As the mutex is taken on every call, it's better to intern a
+string once and keep the returned view or ID than to intern it again in a hot
+loop.
+*/
+class CORRADE_UTILITY_EXPORT StringPool {
+    public:
+        /**
+         * @brief Process-wide string pool
+         *
+         * Created on first use and destroyed at program exit.
+         */
+        static StringPool& global();
+
+        /**
+         * @brief Constructor
+         * @param blockSize     Size of a single block for string data in bytes
+         *
+         * No memory is allocated upfront. Strings larger than @p blockSize
+         * get a dedicated block.
+         */
+        explicit StringPool(std::size_t blockSize = 4096);
+
+        /** @brief Copying is not allowed */
+        StringPool(const StringPool&) = delete;
+
+        /** @brief Moving is not allowed */
+        StringPool(StringPool&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * All views returned from the pool become dangling.
+         */
+        ~StringPool();
+
+        /** @brief Copying is not allowed */
+        StringPool& operator=(const StringPool&) = delete;
+
+        /** @brief Moving is not allowed */
+        StringPool& operator=(StringPool&&) = delete;
+
+        /** @brief Count of interned strings */
+        std::size_t size() const;
+
+        /**
+         * @brief Size of interned string data in bytes
+         *
+         * Includes the null terminators but not space wasted at the end of
+         * blocks.
+         */
+        std::size_t dataSize() const;
+
+        /**
+         * @brief Intern a string
+         *
+         * If @p string is already present in the pool, returns its ID,
+         * otherwise copies it to the pool and returns a new ID equal to
+         * @ref size() before the call.
+         * @see @ref internView()
+         */
+        std::uint32_t intern(Containers::StringView string);
+
+        /**
+         * @brief Intern a string and return a view on the pooled copy
+         *
+         * Equivalent to calling @ref operator[]() on the result of
+         * @ref intern() but doing just a single lookup. The returned view is
+         * null-terminated and stays valid for the whole pool lifetime.
+         */
+        Containers::StringView internView(Containers::StringView string);
+
+        /**
+         * @brief Find an interned string
+         *
+         * Returns ID of @p string or @cpp 0xffffffffu @ce if it's not present
+         * in the pool. Doesn't modify the pool.
+         */
+        std::uint32_t find(Containers::StringView string) const;
+
+        /**
+         * @brief Interned string
+         *
+         * Expects that @p id is less than @ref size(). The returned view is
+         * null-terminated and stays valid for the whole pool lifetime.
+         */
+        Containers::StringView operator[](std::uint32_t id) const;
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
@@ -25,14 +25,91 @@
 
 #include "System.h"
 
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+#include "Corrade/Containers/ArrayView.h"
+#include "Corrade/Utility/Assert.h"
+#include "Corrade/Utility/Debug.h"
+
 #ifndef CORRADE_TARGET_WINDOWS
 #include "unistd.h"
 #else
 #include <windows.h>
+#include <vector>
+/* Makes GetProcessMemoryInfo() resolve to K32GetProcessMemoryInfo() from
+   kernel32, so there's no need to link to psapi */
+#define PSAPI_VERSION 2
+#include <psapi.h>
+#endif
+
+#if defined(CORRADE_TARGET_UNIX) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+#include <sys/resource.h>
+#endif
+
+#ifdef __linux__
+#include <malloc.h>
+#include <sched.h>
+#endif
+
+#ifdef CORRADE_TARGET_APPLE
+#include <malloc/malloc.h>
+#include <mach/mach.h>
+#include <sys/sysctl.h>
 #endif
 
 namespace Corrade { namespace Utility { namespace System {
 
+namespace {
+
+/* Sleeping shorter than this is unreliable on all common schedulers */
+constexpr std::uint64_t SchedulerGranularity = 2000000;
+/* Yielding may take this long until the thread gets scheduled again */
+constexpr std::uint64_t YieldGranularity = 50000;
+
+#ifdef __linux__
+/* Reads a non-negative integer from a sysfs file, optionally followed by a
+   K suffix. Returns -1 if the file can't be read. */
+long long readSysfsNumber(const char* const path) {
+    std::FILE* const f = std::fopen(path, "r");
+    if(!f) return -1;
+    long long value;
+    char suffix = 0;
+    const int count = std::fscanf(f, "%lld%c", &value, &suffix);
+    std::fclose(f);
+    if(count < 1 || value < 0) return -1;
+    if(suffix == 'K') value *= 1024;
+    else if(suffix == 'M') value *= 1024*1024;
+    return value;
+}
+#endif
+
+#ifdef CORRADE_TARGET_APPLE
+std::size_t sysctlNumber(const char* const name) {
+    std::int64_t value = 0;
+    std::size_t size = sizeof(value);
+    if(sysctlbyname(name, &value, &size, nullptr, 0) != 0) return 0;
+    /* Some values are 32-bit, the buffer is zero-initialized so little
+       endian makes it work with both */
+    return std::size_t(value);
+}
+#endif
+
+#ifdef CORRADE_TARGET_WINDOWS
+std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> logicalProcessorInformation() {
+    DWORD size = 0;
+    GetLogicalProcessorInformation(nullptr, &size);
+    std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> info(size/sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+    if(info.empty() || !GetLogicalProcessorInformation(info.data(), &size))
+        return {};
+    info.resize(size/sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+    return info;
+}
+#endif
+
+}
+
 void sleep(const std::size_t ms) {
     #ifndef CORRADE_TARGET_WINDOWS
     usleep(ms*1000);
@@ -41,4 +118,285 @@ void sleep(const std::size_t ms) {
     #endif
 }
 
+std::uint64_t monotonicTime() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void sleepUntil(const std::uint64_t time) {
+    const std::uint64_t now = monotonicTime();
+    if(now >= time) return;
+    std::this_thread::sleep_for(std::chrono::nanoseconds{time - now});
+}
+
+void waitUntil(const std::uint64_t time) {
+    for(;;) {
+        const std::uint64_t now = monotonicTime();
+        if(now >= time) return;
+
+        const std::uint64_t remaining = time - now;
+        if(remaining > SchedulerGranularity)
+            std::this_thread::sleep_for(std::chrono::nanoseconds{remaining - SchedulerGranularity});
+        else if(remaining > YieldGranularity)
+            std::this_thread::yield();
+        /* Otherwise busy-wait */
+    }
+}
+
+void yield() {
+    std::this_thread::yield();
+}
+
+std::size_t logicalCoreCount() {
+    #if defined(CORRADE_TARGET_EMSCRIPTEN)
+    return 1;
+    #elif defined(CORRADE_TARGET_WINDOWS)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors ? info.dwNumberOfProcessors : 1;
+    #else
+    const long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? std::size_t(count) : 1;
+    #endif
+}
+
+std::size_t physicalCoreCount() {
+    const std::size_t logical = logicalCoreCount();
+
+    #if defined(__linux__)
+    /* Count unique (package, core) pairs of all online CPUs. Assuming there's
+       never more than 64k cores per package, which is still a few orders of
+       magnitude away. */
+    std::size_t count = 0;
+    std::size_t found = 0;
+    std::uint64_t seen[256];
+    char path[128];
+    for(std::size_t cpu = 0; found != logical && cpu != 4096; ++cpu) {
+        std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%zu/topology/core_id", cpu);
+        const long long core = readSysfsNumber(path);
+        if(core < 0) continue;
+        std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%zu/topology/physical_package_id", cpu);
+        const long long package = readSysfsNumber(path);
+        if(package < 0) continue;
+        ++found;
+
+        const std::uint64_t id = std::uint64_t(package) << 16 | std::uint64_t(core);
+        bool duplicate = false;
+        for(std::size_t i = 0; i != count && !duplicate; ++i)
+            duplicate = seen[i] == id;
+        if(duplicate) continue;
+        /* Too many cores to track, give up */
+        if(count == Containers::arraySize(seen)) return logical;
+        seen[count++] = id;
+    }
+    return count && count <= logical ? count : logical;
+    #elif defined(CORRADE_TARGET_APPLE)
+    const std::size_t count = sysctlNumber("hw.physicalcpu");
+    return count && count <= logical ? count : logical;
+    #elif defined(CORRADE_TARGET_WINDOWS)
+    std::size_t count = 0;
+    for(const SYSTEM_LOGICAL_PROCESSOR_INFORMATION& i: logicalProcessorInformation())
+        if(i.Relationship == RelationProcessorCore) ++count;
+    return count && count <= logical ? count : logical;
+    #else
+    return logical;
+    #endif
+}
+
+std::size_t cacheSize(const std::size_t level) {
+    #if defined(__linux__)
+    /* The indices aren't guaranteed to be ordered by level, go through all
+       and pick the first data or unified cache matching the level */
+    char path[128];
+    for(std::size_t index = 0; index != 16; ++index) {
+        std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%zu/level", index);
+        const long long cacheLevel = readSysfsNumber(path);
+        if(cacheLevel < 0) break;
+        if(std::size_t(cacheLevel) != level) continue;
+
+        std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%zu/type", index);
+        std::FILE* const f = std::fopen(path, "r");
+        if(!f) continue;
+        char type[16]{};
+        const bool read = std::fscanf(f, "%15s", type) == 1;
+        std::fclose(f);
+        if(!read || type[0] == 'I') continue;
+
+        std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%zu/size", index);
+        const long long size = readSysfsNumber(path);
+        return size > 0 ? std::size_t(size) : 0;
+    }
+    return 0;
+    #elif defined(CORRADE_TARGET_APPLE)
+    switch(level) {
+        case 1: return sysctlNumber("hw.l1dcachesize");
+        case 2: return sysctlNumber("hw.l2cachesize");
+        case 3: return sysctlNumber("hw.l3cachesize");
+    }
+    return 0;
+    #elif defined(CORRADE_TARGET_WINDOWS)
+    for(const SYSTEM_LOGICAL_PROCESSOR_INFORMATION& i: logicalProcessorInformation())
+        if(i.Relationship == RelationCache && i.Cache.Level == level && i.Cache.Type != CacheInstruction)
+            return i.Cache.Size;
+    return 0;
+    #else
+    static_cast<void>(level);
+    return 0;
+    #endif
+}
+
+std::size_t numaNodeCount() {
+    #if defined(__linux__)
+    /* The file contains a range list such as 0-1,3 */
+    std::FILE* const f = std::fopen("/sys/devices/system/node/online", "r");
+    if(!f) return 1;
+    std::size_t count = 0;
+    unsigned first, last;
+    for(;;) {
+        const int read = std::fscanf(f, "%u", &first);
+        if(read != 1) break;
+        last = first;
+        int c = std::fgetc(f);
+        if(c == '-') {
+            if(std::fscanf(f, "%u", &last) != 1) break;
+            c = std::fgetc(f);
+        }
+        if(last >= first) count += last - first + 1;
+        if(c != ',') break;
+    }
+    std::fclose(f);
+    return count ? count : 1;
+    #elif defined(CORRADE_TARGET_WINDOWS)
+    std::size_t count = 0;
+    for(const SYSTEM_LOGICAL_PROCESSOR_INFORMATION& i: logicalProcessorInformation())
+        if(i.Relationship == RelationNumaNode) ++count;
+    return count ? count : 1;
+    #else
+    return 1;
+    #endif
+}
+
+bool setThreadAffinity(const std::size_t core) {
+    CORRADE_ASSERT(core < logicalCoreCount(),
+        "Utility::System::setThreadAffinity(): core" << core << "out of range for" << logicalCoreCount() << "cores", false);
+
+    #if defined(__linux__)
+    if(core >= CPU_SETSIZE) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+    #elif defined(CORRADE_TARGET_WINDOWS)
+    if(core >= sizeof(DWORD_PTR)*8) return false;
+    return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << core) != 0;
+    #else
+    return false;
+    #endif
+}
+
+bool resetThreadAffinity() {
+    #if defined(__linux__)
+    /* CPUs that are offline or not allowed for the process are ignored by
+       the kernel, so it's fine to set all bits */
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for(std::size_t i = 0; i != CPU_SETSIZE; ++i)
+        CPU_SET(i, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+    #elif defined(CORRADE_TARGET_WINDOWS)
+    DWORD_PTR processMask, systemMask;
+    if(!GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask))
+        return false;
+    return SetThreadAffinityMask(GetCurrentThread(), processMask) != 0;
+    #else
+    return false;
+    #endif
+}
+
+std::size_t residentMemory() {
+    #if defined(__linux__)
+    /* Second field is the resident set size in pages. Reading
+       /proc/self/status would give the value in kB directly, but it's a lot
+       more to parse. */
+    std::FILE* const f = std::fopen("/proc/self/statm", "r");
+    if(!f) return 0;
+    unsigned long long size, resident;
+    const int count = std::fscanf(f, "%llu %llu", &size, &resident);
+    std::fclose(f);
+    if(count != 2) return 0;
+    return std::size_t(resident)*std::size_t(sysconf(_SC_PAGESIZE));
+    #elif defined(CORRADE_TARGET_APPLE)
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if(task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS)
+        return 0;
+    return info.resident_size;
+    #elif defined(CORRADE_TARGET_WINDOWS)
+    PROCESS_MEMORY_COUNTERS counters;
+    if(!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+    return counters.WorkingSetSize;
+    #else
+    return 0;
+    #endif
+}
+
+std::size_t peakResidentMemory() {
+    #if defined(CORRADE_TARGET_UNIX) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+    /* Reported in bytes on Apple platforms, in kilobytes elsewhere */
+    #ifdef CORRADE_TARGET_APPLE
+    return std::size_t(usage.ru_maxrss);
+    #else
+    return std::size_t(usage.ru_maxrss)*1024;
+    #endif
+    #elif defined(CORRADE_TARGET_WINDOWS)
+    PROCESS_MEMORY_COUNTERS counters;
+    if(!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+    return counters.PeakWorkingSetSize;
+    #else
+    return 0;
+    #endif
+}
+
+std::uint64_t minorPageFaultCount() {
+    #if defined(CORRADE_TARGET_UNIX) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+    return std::uint64_t(usage.ru_minflt);
+    #elif defined(CORRADE_TARGET_WINDOWS)
+    PROCESS_MEMORY_COUNTERS counters;
+    if(!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+    return counters.PageFaultCount;
+    #else
+    return 0;
+    #endif
+}
+
+std::uint64_t majorPageFaultCount() {
+    #if defined(CORRADE_TARGET_UNIX) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+    return std::uint64_t(usage.ru_majflt);
+    #else
+    return 0;
+    #endif
+}
+
+std::size_t allocatedMemory() {
+    #if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+    /* Regular heap allocations and large mmap()ed ones */
+    const struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+    #elif defined(CORRADE_TARGET_APPLE)
+    malloc_statistics_t stats;
+    malloc_zone_statistics(nullptr, &stats);
+    return stats.size_in_use;
+    #else
+    return 0;
+    #endif
+}
+
 }}}
@@ -30,6 +30,7 @@
  */
 
 #include <cstddef>
+#include <cstdint>
 
 #include "Corrade/Utility/visibility.h"
 
@@ -53,9 +54,180 @@ See also @ref building-corrade and @ref corrade-cmake for more information.
 */
 namespace System {
 
-/** @brief Sleep for given time */
+/**
+@brief Sleep for given time
+
+Millisecond granularity, the actual time slept may be longer depending on the
+OS scheduler. Use @ref waitUntil() for a more precise wait.
+*/
 CORRADE_UTILITY_EXPORT void sleep(std::size_t ms);
 
+/**
+@brief Monotonic time in nanoseconds
+@m_since_latest
+
+The time is measured from an unspecified point in the past and is guaranteed
+to never decrease, unlike the wall clock time. Meant for measuring durations
+and scheduling, combined with @ref sleepUntil() or @ref waitUntil().
+*/
+CORRADE_UTILITY_EXPORT std::uint64_t monotonicTime();
+
+/**
+@brief Sleep until given monotonic time
+@m_since_latest
+
+Sleeps until @ref monotonicTime() reaches @p time, returning immediately if
+it's already in the past. Like @ref sleep(), the thread may wake up later
+than requested depending on the OS scheduler granularity, which is usually
+on the order of a millisecond.
+@see @ref waitUntil()
+*/
+CORRADE_UTILITY_EXPORT void sleepUntil(std::uint64_t time);
+
+/**
+@brief Precisely wait until given monotonic time
+@m_since_latest
+
+Sleeps while the remaining time is longer than the OS scheduler granularity,
+then yields the thread with @ref yield() and in the last few microseconds
+spins until @ref monotonicTime() reaches @p time. Compared to
+@ref sleepUntil() the wait ends much closer to the requested time, at the
+cost of keeping a CPU core busy for up to a millisecond.
+*/
+CORRADE_UTILITY_EXPORT void waitUntil(std::uint64_t time);
+
+/**
+@brief Yield the current thread
+@m_since_latest
+
+Lets the OS scheduler run other threads on the current CPU core, if there
+are any waiting.
+*/
+CORRADE_UTILITY_EXPORT void yield();
+
+/**
+@brief Count of logical CPU cores
+@m_since_latest
+
+Includes the additional cores provided by simultaneous multithreading. Always
+at least @cpp 1 @ce. If the count can't be queried, such as on
+@ref CORRADE_TARGET_EMSCRIPTEN "Emscripten", returns @cpp 1 @ce.
+@see @ref physicalCoreCount(), @ref setThreadAffinity()
+*/
+CORRADE_UTILITY_EXPORT std::size_t logicalCoreCount();
+
+/**
+@brief Count of physical CPU cores
+@m_since_latest
+
+Always at least @cpp 1 @ce and at most @ref logicalCoreCount(). If the count
+can't be queried, returns @ref logicalCoreCount().
+*/
+CORRADE_UTILITY_EXPORT std::size_t physicalCoreCount();
+
+/**
+@brief CPU data cache size
+@param level    Cache level, starting from @cpp 1 @ce
+@m_since_latest
+
+Size of a data or unified cache of given level for a single core, in bytes.
+Returns @cpp 0 @ce if given cache level doesn't exist or the size can't be
+queried.
+*/
+CORRADE_UTILITY_EXPORT std::size_t cacheSize(std::size_t level);
+
+/**
+@brief Count of NUMA nodes
+@m_since_latest
+
+Always at least @cpp 1 @ce. If the count can't be queried, such as on
+@ref CORRADE_TARGET_APPLE "Apple platforms", which don't expose NUMA
+topology, returns @cpp 1 @ce.
+*/
+CORRADE_UTILITY_EXPORT std::size_t numaNodeCount();
+
+/**
+@brief Pin the current thread to given logical CPU core
+@m_since_latest
+
+Expects that @p core is less than @ref logicalCoreCount(). Returns
+@cpp false @ce if the platform doesn't support setting thread affinity, which
+is the case on @ref CORRADE_TARGET_APPLE "Apple platforms" and
+@ref CORRADE_TARGET_EMSCRIPTEN "Emscripten", or if the OS refused the
+request, @cpp true @ce otherwise. On Windows only the first 64 cores can be
+used.
+@see @ref resetThreadAffinity()
+*/
+CORRADE_UTILITY_EXPORT bool setThreadAffinity(std::size_t core);
+
+/**
+@brief Allow the current thread to run on all CPU cores
+@m_since_latest
+
+Undoes the effect of @ref setThreadAffinity(). Returns @cpp false @ce if
+the platform doesn't support setting thread affinity or if the OS refused
+the request, @cpp true @ce otherwise.
+*/
+CORRADE_UTILITY_EXPORT bool resetThreadAffinity();
+
+/**
+@brief Resident memory of the current process
+@m_since_latest
+
+Physical memory currently used by the process, in bytes. Returns @cpp 0 @ce
+if it can't be queried, which is the case on
+@ref CORRADE_TARGET_EMSCRIPTEN "Emscripten". Cheap enough to be called
+periodically for monitoring memory pressure.
+@see @ref peakResidentMemory(), @ref allocatedMemory()
+*/
+CORRADE_UTILITY_EXPORT std::size_t residentMemory();
+
+/**
+@brief Peak resident memory of the current process
+@m_since_latest
+
+Maximum of @ref residentMemory() over the process lifetime, in bytes.
+Returns @cpp 0 @ce if it can't be queried.
+*/
+CORRADE_UTILITY_EXPORT std::size_t peakResidentMemory();
+
+/**
+@brief Count of minor page faults of the current process
+@m_since_latest
+
+Page faults that were resolved without any I/O, for example by mapping a
+freshly allocated page. Returns @cpp 0 @ce if the count can't be queried. On
+Windows, which doesn't distinguish minor and major page faults, the total
+count is returned.
+@see @ref majorPageFaultCount()
+*/
+CORRADE_UTILITY_EXPORT std::uint64_t minorPageFaultCount();
+
+/**
+@brief Count of major page faults of the current process
+@m_since_latest
+
+Page faults that required I/O, such as reading a memory-mapped file or a
+page that was swapped out. Returns @cpp 0 @ce if the count can't be queried,
+which includes Windows.
+@see @ref minorPageFaultCount()
+*/
+CORRADE_UTILITY_EXPORT std::uint64_t majorPageFaultCount();
+
+/**
+@brief Memory allocated through the system allocator
+@m_since_latest
+
+Bytes currently allocated through @ref std::malloc() and @cpp new @ce,
+excluding the allocator overhead and memory it retains for reuse. Available
+only with glibc 2.33 and newer and on @ref CORRADE_TARGET_APPLE "Apple platforms",
+returns @cpp 0 @ce elsewhere. Unlike the other memory queries it may need
+to walk allocator data structures, so it's not advised to call it in a hot
+loop.
+@see @ref residentMemory()
+*/
+CORRADE_UTILITY_EXPORT std::size_t allocatedMemory();
+
 }}}
 
 #endif
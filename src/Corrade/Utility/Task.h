@@ -0,0 +1,281 @@
+#ifndef Corrade_Utility_Task_h
+#define Corrade_Utility_Task_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Utility::Task, function @ref Corrade::Utility::resumeOn()
+ * @m_since_latest
+ *
+ * Requires C++20 coroutine support.
+ */
+
+#include "Corrade/configure.h"
+
+#if !defined(__cpp_impl_coroutine) && !defined(DOXYGEN_GENERATING_OUTPUT)
+#error this header requires C++20 coroutine support
+#endif
+
+#include <coroutine>
+#include <exception>
+#include <type_traits>
+#include <utility>
+
+#include "Corrade/Containers/Optional.h"
+#include "Corrade/Utility/Assert.h"
+#include "Corrade/Utility/Utility.h"
+#if (defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)) || defined(DOXYGEN_GENERATING_OUTPUT)
+#include "Corrade/Utility/ThreadPool.h"
+#endif
+
+namespace Corrade { namespace Utility {
+
+namespace Implementation {
+
+/* Common promise functionality. The coroutine starts suspended and when it
+   finishes, execution continues in the coroutine that awaited it, if any. */
+struct TaskPromiseBase {
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+        template<class Promise> std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+            if(const std::coroutine_handle<> continuation = handle.promise().continuation)
+                return continuation;
+            return std::noop_coroutine();
+        }
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    /* Corrade doesn't use exceptions */
+    void unhandled_exception() const noexcept { std::terminate(); }
+
+    std::coroutine_handle<> continuation;
+};
+
+template<class T> struct TaskPromise: TaskPromiseBase {
+    Task<T> get_return_object() noexcept;
+    template<class U> void return_value(U&& value) {
+        result.emplace(std::forward<U>(value));
+    }
+
+    Containers::Optional<T> result;
+};
+
+template<> struct TaskPromise<void>: TaskPromiseBase {
+    Task<void> get_return_object() noexcept;
+    void return_void() const noexcept {}
+};
+
+}
+
+/**
+@brief Coroutine task
+@tparam T   Result type, can be @cpp void @ce
+@m_since_latest
+
+Return type for a C++20 coroutine that produces a single value. The task is
+lazy --- the coroutine body doesn't run until the task is either
+@cpp co_await @ce'ed from another coroutine or explicitly started with
+@ref start(). Once the coroutine finishes, execution continues in the
+coroutine that awaited it.
+
+@snippet Utility-cpp20.cpp Task
+
+A top-level task is started from regular code with @ref start() and its
+result is then available through @ref result():
+
+@snippet Utility-cpp20.cpp Task-start
+
+Together with @ref resumeOn(), a coroutine can move itself onto a
+@ref ThreadPool and suspend instead of blocking the calling thread on I/O or
+heavy computation:
+
+@snippet Utility-cpp20.cpp Task-resumeOn
+
+The task owns the coroutine and destroys it on destruction, even if it didn't
+finish yet. Exceptions are not supported, an exception escaping the coroutine
+body calls @ref std::terminate().
+*/
+template<class T> class Task {
+    public:
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        typedef Implementation::TaskPromise<T> promise_type;
+        #endif
+
+        /**
+         * @brief Default constructor
+         *
+         * Creates an empty task with no associated coroutine.
+         */
+        /*implicit*/ Task() noexcept: _handle{} {}
+
+        /** @brief Copying is not allowed */
+        Task(const Task<T>&) = delete;
+
+        /** @brief Move constructor */
+        Task(Task<T>&& other) noexcept: _handle{other._handle}, _started{other._started} {
+            other._handle = {};
+        }
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys the coroutine.
+         */
+        ~Task() {
+            if(_handle) _handle.destroy();
+        }
+
+        /** @brief Copying is not allowed */
+        Task<T>& operator=(const Task<T>&) = delete;
+
+        /** @brief Move assignment */
+        Task<T>& operator=(Task<T>&& other) noexcept {
+            std::swap(_handle, other._handle);
+            std::swap(_started, other._started);
+            return *this;
+        }
+
+        /** @brief Whether the task has an associated coroutine */
+        explicit operator bool() const { return bool(_handle); }
+
+        /**
+         * @brief Whether the coroutine finished
+         *
+         * Expects that the task is not empty.
+         */
+        bool isDone() const {
+            CORRADE_ASSERT(_handle, "Utility::Task::isDone(): the task is empty", false);
+            return _handle.done();
+        }
+
+        /**
+         * @brief Start the coroutine
+         *
+         * Runs the coroutine on the calling thread until its first suspension
+         * point or until it finishes. Expects that the task is not empty and
+         * the coroutine wasn't started yet. Use this to run a top-level task
+         * from code that isn't a coroutine, inside a coroutine
+         * @cpp co_await @ce the task instead.
+         */
+        void start();
+
+        /**
+         * @brief Result of the coroutine
+         *
+         * Expects that the coroutine finished. Not available for
+         * @cpp Task<void> @ce.
+         */
+        template<class U = T, class = typename std::enable_if<!std::is_void<U>::value>::type> U& result() {
+            CORRADE_ASSERT(_handle && _handle.done(), "Utility::Task::result(): the task didn't finish", *_handle.promise().result);
+            return *_handle.promise().result;
+        }
+
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        /* Awaiting the task starts it and resumes the awaiting coroutine once
+           it finishes */
+        auto operator co_await() && noexcept {
+            struct Awaiter {
+                bool await_ready() const noexcept { return false; }
+                std::coroutine_handle<> await_suspend(const std::coroutine_handle<> continuation) noexcept {
+                    handle.promise().continuation = continuation;
+                    return handle;
+                }
+                T await_resume() {
+                    if constexpr(!std::is_void<T>::value)
+                        return std::move(*handle.promise().result);
+                }
+
+                std::coroutine_handle<promise_type> handle;
+            };
+
+            CORRADE_ASSERT(_handle && !_started, "Utility::Task: can't await an empty or already started task", (Awaiter{_handle}));
+            _started = true;
+            return Awaiter{_handle};
+        }
+        #endif
+
+    private:
+        friend promise_type;
+
+        explicit Task(std::coroutine_handle<promise_type> handle) noexcept: _handle{handle} {}
+
+        std::coroutine_handle<promise_type> _handle;
+        bool _started{};
+};
+
+template<class T> void Task<T>::start() {
+    CORRADE_ASSERT(_handle, "Utility::Task::start(): the task is empty", );
+    CORRADE_ASSERT(!_started, "Utility::Task::start(): the task was already started", );
+    _started = true;
+    _handle.resume();
+}
+
+namespace Implementation {
+
+template<class T> Task<T> TaskPromise<T>::get_return_object() noexcept {
+    return Task<T>{std::coroutine_handle<TaskPromise<T>>::from_promise(*this)};
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+    return Task<void>{std::coroutine_handle<TaskPromise<void>>::from_promise(*this)};
+}
+
+}
+
+#if (defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)) || defined(DOXYGEN_GENERATING_OUTPUT)
+/**
+@brief Resume a coroutine on a thread pool
+@m_since_latest
+
+Returns an awaitable that suspends the calling coroutine and schedules its
+continuation as a task in @p group. The coroutine then continues on one of the
+pool threads, or on the thread calling @ref ThreadPool::TaskGroup::wait(),
+which returns once the coroutine finishes or suspends again. The @p group is
+expected to stay in scope until then.
+@partialsupport Available only if @ref CORRADE_BUILD_MULTITHREADED is enabled
+    and not on @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten".
+*/
+inline auto resumeOn(ThreadPool::TaskGroup& group) {
+    struct Awaiter {
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(const std::coroutine_handle<> handle) {
+            group.run([](void* state) {
+                std::coroutine_handle<>::from_address(state).resume();
+            }, handle.address());
+        }
+        void await_resume() const noexcept {}
+
+        ThreadPool::TaskGroup& group;
+    };
+
+    return Awaiter{group};
+}
+#endif
+
+}}
+
+#endif
@@ -24,7 +24,12 @@
 */
 
 #include <algorithm>
+#include <cstring>
+#include <limits>
+#include <numeric>
 #include <sstream>
+#include <string>
+#include <vector>
 
 #include "Corrade/Containers/Array.h"
 #include "Corrade/Containers/ArrayViewStl.h"
@@ -32,6 +37,7 @@
 #include "Corrade/TestSuite/Compare/Container.h"
 #include "Corrade/Utility/Algorithms.h"
 #include "Corrade/Utility/DebugStl.h"
+#include "Corrade/Utility/Implementation/algorithmKernels.h"
 
 namespace Corrade { namespace Utility { namespace Test {
 
@@ -43,9 +49,66 @@ struct AlgorithmsTest: TestSuite::Tester {
     template<class T> void copyStrided2D();
     template<class T> void copyStrided3D();
     template<class T> void copyStrided4D();
+    template<class T> void copyTransposed();
 
     void copyNonMatchingSizes();
     void copyDifferentViewTypes();
+    void copyStatic();
+    void fill();
+    void transform();
+
+    void copyParallel();
+    void copyParallelMoreJobsThanItems();
+    void copyParallelBelowThreshold();
+    void copyParallelDifferentViewTypes();
+    void copyParallelNonMatchingSizes();
+
+    void gather();
+    void gatherInvalid();
+    void scatter();
+    void scatterInvalid();
+    template<class I> void applyPermutation();
+    void applyPermutationMultipleBlocks();
+    void applyPermutationParallel();
+    void applyPermutationParallelSingleBlock();
+    void applyPermutationInvalid();
+    void castInto();
+    void castIntoStrided();
+    void unpackInto();
+    void castIntoNonMatchingSizes();
+
+    void parallelFor();
+    void parallelForBelowThreshold();
+    void parallelReduce();
+    void parallelReduceBelowThreshold();
+    void parallelTransform();
+    void parallelTransformBelowThreshold();
+    void parallelTransformNonMatchingSizes();
+
+    void sort();
+    void sortStrided();
+    void sortCustomCompare();
+    void sortPatterns();
+    void sortPermutation();
+    void sortPermutationInvalid();
+    template<class T> void radixSort();
+    void radixSortStrided();
+    void radixSortPermutation();
+    void radixSortPermutationInvalid();
+    void lowerUpperBound();
+    void lowerUpperBoundStrided();
+    void interpolationSearch();
+    void interpolationSearchSkewed();
+    void unique();
+    void uniqueStrided();
+
+    template<class T> void findCount();
+    template<class T> void mismatchEqual();
+    template<class T> void minmax();
+    template<class T> void sum();
+    void searchFloatingPointSpecial();
+    void minmaxEmpty();
+    template<class T> void algorithmKernels();
 
     void copyBenchmarkFlatStdCopy();
     void copyBenchmarkFlatLoop();
@@ -64,7 +127,25 @@ struct AlgorithmsTest: TestSuite::Tester {
 
     void copyBenchmark1DNonContiguous();
     void copyBenchmark2DNonContiguous();
+    void copyBenchmark2DTransposed();
     template<class T> void copyBenchmark3DNonContiguous();
+
+    void sortBenchmarkStdSort();
+    void sortBenchmark();
+    void sortBenchmarkStrided();
+    void radixSortBenchmark();
+
+    void applyPermutationBenchmarkGather();
+    void applyPermutationBenchmark();
+
+    void findBenchmarkStd();
+    void findBenchmark();
+    void countBenchmarkStd();
+    void countBenchmark();
+    void minmaxBenchmarkStd();
+    void minmaxBenchmark();
+    void sumBenchmarkLoop();
+    void sumBenchmark();
 };
 
 const struct {
@@ -127,7 +208,8 @@ const struct {
 };
 
 /* For testing large types (and the Duff's device branch, which is 8 bytes and
-   above right now) */
+   above right now) and the fixed-size branches for 1, 2, 4, 8, 12 and 16
+   bytes */
 template<std::size_t size> struct Data {
     /*implicit*/ Data() = default;
     /*implicit*/ Data(char i) { data[0] = i; }
@@ -154,15 +236,48 @@ template<> struct TypeName<char> {
 template<> struct TypeName<int> {
     static const char* name() { return "int"; }
 };
+template<> struct TypeName<std::uint8_t> {
+    static const char* name() { return "std::uint8_t"; }
+};
+template<> struct TypeName<std::int16_t> {
+    static const char* name() { return "std::int16_t"; }
+};
+template<> struct TypeName<std::uint32_t> {
+    static const char* name() { return "std::uint32_t"; }
+};
+template<> struct TypeName<std::int64_t> {
+    static const char* name() { return "std::int64_t"; }
+};
+template<> struct TypeName<std::int8_t> {
+    static const char* name() { return "std::int8_t"; }
+};
+template<> struct TypeName<std::uint16_t> {
+    static const char* name() { return "std::uint16_t"; }
+};
+template<> struct TypeName<std::uint64_t> {
+    static const char* name() { return "std::uint64_t"; }
+};
+template<> struct TypeName<float> {
+    static const char* name() { return "float"; }
+};
+template<> struct TypeName<double> {
+    static const char* name() { return "double"; }
+};
 template<> struct TypeName<Data<1>> {
     static const char* name() { return "1B"; }
 };
+template<> struct TypeName<Data<2>> {
+    static const char* name() { return "2B"; }
+};
 template<> struct TypeName<Data<4>> {
     static const char* name() { return "4B"; }
 };
 template<> struct TypeName<Data<8>> {
     static const char* name() { return "8B"; }
 };
+template<> struct TypeName<Data<12>> {
+    static const char* name() { return "12B"; }
+};
 template<> struct TypeName<Data<16>> {
     static const char* name() { return "16B"; }
 };
@@ -170,6 +285,17 @@ template<> struct TypeName<Data<32>> {
     static const char* name() { return "32B"; }
 };
 
+const struct {
+    const char* name;
+    Cpu::Features features;
+} AlgorithmKernelsData[]{
+    {"scalar", {}},
+    #ifdef CORRADE_TARGET_X86
+    {"SSE2", Cpu::Feature::Sse2},
+    {"AVX2", Cpu::Feature::Avx2},
+    #endif
+};
+
 AlgorithmsTest::AlgorithmsTest() {
     addTests({&AlgorithmsTest::copy});
 
@@ -184,6 +310,10 @@ AlgorithmsTest::AlgorithmsTest() {
     addInstancedTests<AlgorithmsTest>({
         &AlgorithmsTest::copyStrided3D<char>,
         &AlgorithmsTest::copyStrided3D<int>,
+        &AlgorithmsTest::copyStrided3D<Data<2>>,
+        &AlgorithmsTest::copyStrided3D<Data<8>>,
+        &AlgorithmsTest::copyStrided3D<Data<12>>,
+        &AlgorithmsTest::copyStrided3D<Data<16>>,
         }, Containers::arraySize(Copy3DData));
     addInstancedTests<AlgorithmsTest>({
         &AlgorithmsTest::copyStrided4D<char>,
@@ -191,8 +321,101 @@ AlgorithmsTest::AlgorithmsTest() {
         &AlgorithmsTest::copyStrided4D<Data<32>>,
         }, Containers::arraySize(Copy4DData));
 
+    addTests<AlgorithmsTest>({
+        &AlgorithmsTest::copyTransposed<char>,
+        &AlgorithmsTest::copyTransposed<int>,
+        &AlgorithmsTest::copyTransposed<Data<12>>,
+        &AlgorithmsTest::copyTransposed<Data<32>>});
+
     addTests({&AlgorithmsTest::copyNonMatchingSizes,
-              &AlgorithmsTest::copyDifferentViewTypes});
+              &AlgorithmsTest::copyDifferentViewTypes,
+              &AlgorithmsTest::copyStatic,
+              &AlgorithmsTest::fill,
+              &AlgorithmsTest::transform,
+
+              &AlgorithmsTest::copyParallel,
+              &AlgorithmsTest::copyParallelMoreJobsThanItems,
+              &AlgorithmsTest::copyParallelBelowThreshold,
+              &AlgorithmsTest::copyParallelDifferentViewTypes,
+              &AlgorithmsTest::copyParallelNonMatchingSizes,
+
+              &AlgorithmsTest::gather,
+              &AlgorithmsTest::gatherInvalid,
+              &AlgorithmsTest::scatter,
+              &AlgorithmsTest::scatterInvalid,
+              &AlgorithmsTest::applyPermutation<std::uint8_t>,
+              &AlgorithmsTest::applyPermutation<std::uint32_t>,
+              &AlgorithmsTest::applyPermutation<std::int64_t>,
+              &AlgorithmsTest::applyPermutationMultipleBlocks,
+              &AlgorithmsTest::applyPermutationParallel,
+              &AlgorithmsTest::applyPermutationParallelSingleBlock,
+              &AlgorithmsTest::applyPermutationInvalid,
+              &AlgorithmsTest::castInto,
+              &AlgorithmsTest::castIntoStrided,
+              &AlgorithmsTest::unpackInto,
+              &AlgorithmsTest::castIntoNonMatchingSizes,
+
+              &AlgorithmsTest::parallelFor,
+              &AlgorithmsTest::parallelForBelowThreshold,
+              &AlgorithmsTest::parallelReduce,
+              &AlgorithmsTest::parallelReduceBelowThreshold,
+              &AlgorithmsTest::parallelTransform,
+              &AlgorithmsTest::parallelTransformBelowThreshold,
+              &AlgorithmsTest::parallelTransformNonMatchingSizes,
+
+              &AlgorithmsTest::sort,
+              &AlgorithmsTest::sortStrided,
+              &AlgorithmsTest::sortCustomCompare,
+              &AlgorithmsTest::sortPatterns,
+              &AlgorithmsTest::sortPermutation,
+              &AlgorithmsTest::sortPermutationInvalid,
+              &AlgorithmsTest::radixSort<std::uint8_t>,
+              &AlgorithmsTest::radixSort<std::int16_t>,
+              &AlgorithmsTest::radixSort<std::uint32_t>,
+              &AlgorithmsTest::radixSort<std::int64_t>,
+              &AlgorithmsTest::radixSortStrided,
+              &AlgorithmsTest::radixSortPermutation,
+              &AlgorithmsTest::radixSortPermutationInvalid,
+              &AlgorithmsTest::lowerUpperBound,
+              &AlgorithmsTest::lowerUpperBoundStrided,
+              &AlgorithmsTest::interpolationSearch,
+              &AlgorithmsTest::interpolationSearchSkewed,
+              &AlgorithmsTest::unique,
+              &AlgorithmsTest::uniqueStrided,
+
+              &AlgorithmsTest::findCount<std::int8_t>,
+              &AlgorithmsTest::findCount<std::uint16_t>,
+              &AlgorithmsTest::findCount<std::int64_t>,
+              &AlgorithmsTest::findCount<float>,
+              &AlgorithmsTest::mismatchEqual<std::uint8_t>,
+              &AlgorithmsTest::mismatchEqual<std::int32_t>,
+              &AlgorithmsTest::mismatchEqual<std::uint64_t>,
+              &AlgorithmsTest::mismatchEqual<double>,
+              &AlgorithmsTest::minmax<std::int8_t>,
+              &AlgorithmsTest::minmax<std::uint16_t>,
+              &AlgorithmsTest::minmax<std::uint32_t>,
+              &AlgorithmsTest::minmax<std::int64_t>,
+              &AlgorithmsTest::minmax<float>,
+              &AlgorithmsTest::sum<std::int8_t>,
+              &AlgorithmsTest::sum<std::uint16_t>,
+              &AlgorithmsTest::sum<std::int32_t>,
+              &AlgorithmsTest::sum<std::uint64_t>,
+              &AlgorithmsTest::sum<double>,
+              &AlgorithmsTest::searchFloatingPointSpecial,
+              &AlgorithmsTest::minmaxEmpty});
+
+    addInstancedTests<AlgorithmsTest>({
+        &AlgorithmsTest::algorithmKernels<std::int8_t>,
+        &AlgorithmsTest::algorithmKernels<std::uint8_t>,
+        &AlgorithmsTest::algorithmKernels<std::int16_t>,
+        &AlgorithmsTest::algorithmKernels<std::uint16_t>,
+        &AlgorithmsTest::algorithmKernels<std::int32_t>,
+        &AlgorithmsTest::algorithmKernels<std::uint32_t>,
+        &AlgorithmsTest::algorithmKernels<std::int64_t>,
+        &AlgorithmsTest::algorithmKernels<std::uint64_t>,
+        &AlgorithmsTest::algorithmKernels<float>,
+        &AlgorithmsTest::algorithmKernels<double>,
+        }, Containers::arraySize(AlgorithmKernelsData));
 
     addBenchmarks({&AlgorithmsTest::copyBenchmarkFlatStdCopy,
                    &AlgorithmsTest::copyBenchmarkFlatLoop,
@@ -211,11 +434,30 @@ AlgorithmsTest::AlgorithmsTest() {
 
                    &AlgorithmsTest::copyBenchmark1DNonContiguous,
                    &AlgorithmsTest::copyBenchmark2DNonContiguous,
+                   &AlgorithmsTest::copyBenchmark2DTransposed,
                    &AlgorithmsTest::copyBenchmark3DNonContiguous<Data<1>>,
+                   &AlgorithmsTest::copyBenchmark3DNonContiguous<Data<2>>,
                    &AlgorithmsTest::copyBenchmark3DNonContiguous<Data<4>>,
                    &AlgorithmsTest::copyBenchmark3DNonContiguous<Data<8>>,
                    &AlgorithmsTest::copyBenchmark3DNonContiguous<Data<16>>,
                    &AlgorithmsTest::copyBenchmark3DNonContiguous<Data<32>>}, 100);
+
+    addBenchmarks({&AlgorithmsTest::sortBenchmarkStdSort,
+                   &AlgorithmsTest::sortBenchmark,
+                   &AlgorithmsTest::sortBenchmarkStrided,
+                   &AlgorithmsTest::radixSortBenchmark}, 10);
+
+    addBenchmarks({&AlgorithmsTest::applyPermutationBenchmarkGather,
+                   &AlgorithmsTest::applyPermutationBenchmark}, 10);
+
+    addBenchmarks({&AlgorithmsTest::findBenchmarkStd,
+                   &AlgorithmsTest::findBenchmark,
+                   &AlgorithmsTest::countBenchmarkStd,
+                   &AlgorithmsTest::countBenchmark,
+                   &AlgorithmsTest::minmaxBenchmarkStd,
+                   &AlgorithmsTest::minmaxBenchmark,
+                   &AlgorithmsTest::sumBenchmarkLoop,
+                   &AlgorithmsTest::sumBenchmark}, 10);
 }
 
 void AlgorithmsTest::copy() {
@@ -379,6 +621,33 @@ template<class T> void AlgorithmsTest::copyStrided4D() {
                 CORRADE_COMPARE_AS(dst[i][j][k], src[i][j][k], TestSuite::Compare::Container);
 }
 
+template<class T> void AlgorithmsTest::copyTransposed() {
+    setTestCaseTemplateName(TypeName<T>::name());
+
+    /* Sizes that aren't a multiple of the tile size to test the edge tiles
+       as well */
+    Containers::Array<T> srcData{Containers::NoInit, 37*53};
+    Containers::Array<T> dstData{Containers::NoInit, 53*37};
+    Containers::StridedArrayView2D<T> src{srcData, {37, 53}};
+    Containers::StridedArrayView2D<T> dst = Containers::StridedArrayView2D<T>{dstData, {53, 37}}.template transposed<0, 1>();
+
+    T n = 0;
+    for(T& i: srcData) i = ++n;
+
+    Utility::copy(src, dst);
+
+    /** @todo i need to figure out recursive container comparison */
+    for(std::size_t i = 0; i != src.size()[0]; ++i)
+        CORRADE_COMPARE_AS(dst[i], src[i], TestSuite::Compare::Container);
+
+    /* Flipped source, going the other way */
+    for(T& i: srcData) i = T(0);
+    src = src.template flipped<1>();
+    Utility::copy(dst.template flipped<1>().template transposed<0, 1>(), src.template transposed<0, 1>());
+    for(std::size_t i = 0; i != src.size()[0]; ++i)
+        CORRADE_COMPARE_AS(dst[i].template flipped<0>(), src[i], TestSuite::Compare::Container);
+}
+
 void AlgorithmsTest::copyNonMatchingSizes() {
     std::ostringstream out;
     Error redirectError{&out};
@@ -439,6 +708,1108 @@ void AlgorithmsTest::copyDifferentViewTypes() {
         TestSuite::Compare::Container);
 }
 
+void AlgorithmsTest::copyStatic() {
+    const int a[]{11, -22, 33, -44, 55};
+    int b[5]{};
+    int c[5]{};
+
+    /* Both a const and a mutable source should pick the static overload */
+    Utility::copy(Containers::StaticArrayView<5, const int>{a}, Containers::StaticArrayView<5, int>{b});
+    Utility::copy(Containers::StaticArrayView<5, int>{b}, Containers::StaticArrayView<5, int>{c});
+    CORRADE_COMPARE_AS(Containers::arrayView(c), Containers::arrayView(a),
+        TestSuite::Compare::Container);
+}
+
+void AlgorithmsTest::fill() {
+    float a[4]{};
+    Utility::fill(Containers::StaticArrayView<4, float>{a}, 3);
+    CORRADE_COMPARE_AS(Containers::arrayView(a),
+        Containers::arrayView({3.0f, 3.0f, 3.0f, 3.0f}),
+        TestSuite::Compare::Container);
+}
+
+void AlgorithmsTest::transform() {
+    const int a[]{1, -2, 3, -4};
+    float b[4]{};
+    Utility::transform(Containers::StaticArrayView<4, const int>{a}, Containers::StaticArrayView<4, float>{b}, [](int value) {
+        return value*0.5f;
+    });
+    CORRADE_COMPARE_AS(Containers::arrayView(b),
+        Containers::arrayView({0.5f, -1.0f, 1.5f, -2.0f}),
+        TestSuite::Compare::Container);
+
+    /* In-place */
+    Utility::transform(Containers::StaticArrayView<4, float>{b}, Containers::StaticArrayView<4, float>{b}, [](float value) {
+        return value*2.0f;
+    });
+    CORRADE_COMPARE_AS(Containers::arrayView(b),
+        Containers::arrayView({1.0f, -2.0f, 3.0f, -4.0f}),
+        TestSuite::Compare::Container);
+}
+
+struct SerialExecutorState {
+    std::size_t calls, jobs;
+};
+
+/* Executes the jobs in reverse order to verify they don't depend on each
+   other */
+static void serialExecutor(void* executorState, std::size_t count, void(*job)(void*, std::size_t), void* jobState) {
+    auto& state = *static_cast<SerialExecutorState*>(executorState);
+    ++state.calls;
+    state.jobs += count;
+    for(std::size_t i = count; i != 0; --i) job(jobState, i - 1);
+}
+
+void AlgorithmsTest::copyParallel() {
+    Containers::Array<int> srcData{Containers::NoInit, 10*3*2};
+    Containers::Array<int> dstData{Containers::ValueInit, 10*3};
+    for(std::size_t i = 0; i != srcData.size(); ++i) srcData[i] = i;
+
+    /* Every other column of the source */
+    Containers::StridedArrayView2D<const int> src{srcData, {10, 3}, {3*2*4, 2*4}};
+    Containers::StridedArrayView2D<int> dst{dstData, {10, 3}};
+
+    SerialExecutorState state{};
+    Utility::copy(src, dst, serialExecutor, &state, 4, 0);
+    CORRADE_COMPARE(state.calls, 1);
+    /* 10 rows split into chunks of 3 */
+    CORRADE_COMPARE(state.jobs, 4);
+    for(std::size_t i = 0; i != src.size()[0]; ++i)
+        CORRADE_COMPARE_AS(dst[i], src[i], TestSuite::Compare::Container);
+}
+
+void AlgorithmsTest::copyParallelMoreJobsThanItems() {
+    int srcData[]{1, 2, 3};
+    int dstData[3]{};
+
+    SerialExecutorState state{};
+    Utility::copy(Containers::StridedArrayView1D<const int>{srcData},
+        Containers::StridedArrayView1D<int>{dstData}, serialExecutor, &state, 16, 0);
+    CORRADE_COMPARE(state.calls, 1);
+    CORRADE_COMPARE(state.jobs, 3);
+    CORRADE_COMPARE_AS(Containers::arrayView(dstData),
+        Containers::arrayView(srcData),
+        TestSuite::Compare::Container);
+}
+
+void AlgorithmsTest::copyParallelBelowThreshold() {
+    int srcData[]{1, 2, 3, 4};
+    int dstData[4]{};
+    Containers::StridedArrayView1D<const int> src{srcData};
+    Containers::StridedArrayView1D<int> dst{dstData};
+
+    /* Smaller than the threshold, single job or a single item -- all of them
+       should copy directly */
+    SerialExecutorState state{};
+    Utility::copy(src, dst, serialExecutor, &state, 4, 17);
+    Utility::copy(src, dst, serialExecutor, &state, 1, 0);
+    Utility::copy(src.prefix(1), dst.prefix(1), serialExecutor, &state, 4, 0);
+    Utility::copy(src, dst, serialExecutor, &state, 4);
+    CORRADE_COMPARE(state.calls, 0);
+    CORRADE_COMPARE_AS(Containers::arrayView(dstData),
+        Containers::arrayView(srcData),
+        TestSuite::Compare::Container);
+}
+
+void AlgorithmsTest::copyParallelDifferentViewTypes() {
+    std::vector<int> a{11, -22, 33, -44, 55};
+    Containers::Array<int> b{5};
+
+    SerialExecutorState state{};
+    Utility::copy(a, b, serialExecutor, &state, 2, 0);
+    CORRADE_COMPARE(state.calls, 1);
+    CORRADE_COMPARE(state.jobs, 2);
+    CORRADE_COMPARE_AS(Containers::arrayView(b), Containers::arrayView(a),
+        TestSuite::Compare::Container);
+}
+
+void AlgorithmsTest::copyParallelNonMatchingSizes() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    int a[2*3]{};
+    SerialExecutorState state{};
+    Utility::copy(Containers::StridedArrayView2D<const int>{a, {2, 3}},
+                  Containers::StridedArrayView2D<int>{a, {3, 2}},
+                  serialExecutor, &state, 2, 0);
+    CORRADE_COMPARE(state.calls, 0);
+    CORRADE_COMPARE(out.str(),
+        "Utility::Algorithms::copy(): sizes {2, 3} and {3, 2} don't match\n");
+}
+
+struct Vertex {
+    float position;
+    int id;
+};
+
+void AlgorithmsTest::gather() {
+    const Vertex vertices[]{{1.5f, 10}, {2.5f, 20}, {3.5f, 30}, {4.5f, 40}};
+    const std::uint16_t indices[]{3, 0, 0, 2, 1};
+    int ids[5]{};
+
+    Utility::gather(
+        Containers::StridedArrayView1D<const int>{vertices, &vertices[0].id, 4, sizeof(Vertex)},
+        Containers::StridedArrayView1D<const std::uint16_t>{indices},
+        Containers::StridedArrayView1D<int>{ids});
+    CORRADE_COMPARE_AS(Containers::arrayView(ids),
+        Containers::arrayView({40, 10, 10, 30, 20}),
+        TestSuite::Compare::Container);
+}
+
+void AlgorithmsTest::gatherInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const int src[3]{};
+    const std::uint32_t indices[]{0, 3};
+    int dst[3]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Utility::gather(Containers::StridedArrayView1D<const int>{src},
+        Containers::StridedArrayView1D<const std::uint32_t>{indices},
+        Containers::StridedArrayView1D<int>{dst});
+    Utility::gather(Containers::StridedArrayView1D<const int>{src},
+        Containers::StridedArrayView1D<const std::uint32_t>{indices},
+        Containers::StridedArrayView1D<int>{dst}.prefix(2));
+    CORRADE_COMPARE(out.str(),
+        "Utility::gather(): expected index and destination views to have the same size but got 2 and 3\n"
+        "Utility::gather(): index 3 out of bounds for 3 elements\n");
+}
+
+void AlgorithmsTest::scatter() {
+    const float positions[]{1.5f, 2.5f, 3.5f};
+    const std::uint8_t indices[]{2, 0, 3};
+    Vertex vertices[4]{};
+
+    Utility::scatter(
+        Containers::StridedArrayView1D<const float>{positions},
+        Containers::StridedArrayView1D<const std::uint8_t>{indices},
+        Containers::StridedArrayView1D<float>{vertices, &vertices[0].position, 4, sizeof(Vertex)});
+    CORRADE_COMPARE(vertices[0].position, 2.5f);
+    CORRADE_COMPARE(vertices[1].position, 0.0f);
+    CORRADE_COMPARE(vertices[2].position, 1.5f);
+    CORRADE_COMPARE(vertices[3].position, 3.5f);
+    CORRADE_COMPARE(vertices[3].id, 0);
+}
+
+void AlgorithmsTest::scatterInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const int src[2]{};
+    const std::uint32_t indices[]{0, 3};
+    int dst[3]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Utility::scatter(Containers::StridedArrayView1D<const int>{src}.prefix(1),
+        Containers::StridedArrayView1D<const std::uint32_t>{indices},
+        Containers::StridedArrayView1D<int>{dst});
+    Utility::scatter(Containers::StridedArrayView1D<const int>{src},
+        Containers::StridedArrayView1D<const std::uint32_t>{indices},
+        Containers::StridedArrayView1D<int>{dst});
+    CORRADE_COMPARE(out.str(),
+        "Utility::scatter(): expected source and index views to have the same size but got 1 and 2\n"
+        "Utility::scatter(): index 3 out of bounds for 3 elements\n");
+}
+
+template<class I> void AlgorithmsTest::applyPermutation() {
+    setTestCaseTemplateName(TypeName<I>::name());
+
+    const Vertex vertices[]{{1.5f, 10}, {2.5f, 20}, {3.5f, 30}, {4.5f, 40}};
+    const char names[]{'a', 'b', 'c', 'd'};
+    /* Every other item */
+    const I permutation[]{3, 0, 1, 0, 0, 0, 2, 0};
+    float positions[4]{};
+    Vertex permuted[4]{};
+    char permutedNames[4]{};
+
+    Utility::applyPermutation(
+        Containers::StridedArrayView1D<const I>{permutation, 4, 2*sizeof(I)}, {
+            {Containers::StridedArrayView1D<const float>{vertices, &vertices[0].position, 4, sizeof(Vertex)},
+             Containers::StridedArrayView1D<float>{positions}},
+            {Containers::StridedArrayView1D<const int>{vertices, &vertices[0].id, 4, sizeof(Vertex)},
+             Containers::StridedArrayView1D<int>{permuted, &permuted[0].id, 4, sizeof(Vertex)}},
+            {Containers::stridedArrayView(names),
+             Containers::stridedArrayView(permutedNames)}
+        });
+    CORRADE_COMPARE_AS(Containers::arrayView(positions),
+        Containers::arrayView({4.5f, 2.5f, 1.5f, 3.5f}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(permuted[0].id, 40);
+    CORRADE_COMPARE(permuted[1].id, 20);
+    CORRADE_COMPARE(permuted[2].id, 10);
+    CORRADE_COMPARE(permuted[3].id, 30);
+    CORRADE_COMPARE(permuted[0].position, 0.0f);
+    CORRADE_COMPARE_AS(Containers::arrayView(permutedNames),
+        Containers::arrayView({'d', 'b', 'a', 'c'}),
+        TestSuite::Compare::Container);
+}
+
+/* Deterministic pseudo-random values */
+static std::uint32_t lcg(std::uint32_t& state) {
+    state = state*1664525u + 1013904223u;
+    return state >> 8;
+}
+
+/* Permutation spanning several blocks, used by the tests below */
+static Containers::Array<std::uint32_t> permutationFor(const std::size_t count) {
+    Containers::Array<std::uint32_t> keys{Containers::NoInit, count};
+    std::uint32_t state = 0;
+    for(std::uint32_t& i: keys) i = lcg(state);
+    Containers::Array<std::uint32_t> permutation{Containers::NoInit, count};
+    Utility::radixSortPermutation(Containers::StridedArrayView1D<const std::uint32_t>{keys}, Containers::stridedArrayView(permutation));
+    return permutation;
+}
+
+template<std::size_t size> struct Item {
+    char data[size];
+};
+
+template<std::size_t size> static Containers::Array<Item<size>> itemsFor(const std::size_t count) {
+    Containers::Array<Item<size>> out{Containers::NoInit, count};
+    for(std::size_t i = 0; i != count; ++i)
+        for(std::size_t j = 0; j != size; ++j)
+            out[i].data[j] = char(i*7 + j);
+    return out;
+}
+
+template<std::size_t size> static bool isPermuted(const Containers::ArrayView<const std::uint32_t> permutation, const Containers::ArrayView<const Item<size>> src, const Containers::ArrayView<const Item<size>> dst) {
+    for(std::size_t i = 0; i != permutation.size(); ++i)
+        if(std::memcmp(dst[i].data, src[permutation[i]].data, size) != 0)
+            return false;
+    return true;
+}
+
+void AlgorithmsTest::applyPermutationMultipleBlocks() {
+    /* Not a multiple of the block size, to verify the last block is handled
+       correctly */
+    constexpr std::size_t Count = 3333;
+    const Containers::Array<std::uint32_t> permutation = permutationFor(Count);
+
+    /* All fixed sizes and a few that go through the generic path */
+    const Containers::Array<Item<1>> src1 = itemsFor<1>(Count);
+    const Containers::Array<Item<2>> src2 = itemsFor<2>(Count);
+    const Containers::Array<Item<3>> src3 = itemsFor<3>(Count);
+    const Containers::Array<Item<4>> src4 = itemsFor<4>(Count);
+    const Containers::Array<Item<8>> src8 = itemsFor<8>(Count);
+    const Containers::Array<Item<12>> src12 = itemsFor<12>(Count);
+    const Containers::Array<Item<16>> src16 = itemsFor<16>(Count);
+    const Containers::Array<Item<20>> src20 = itemsFor<20>(Count);
+    Containers::Array<Item<1>> dst1{Count};
+    Containers::Array<Item<2>> dst2{Count};
+    Containers::Array<Item<3>> dst3{Count};
+    Containers::Array<Item<4>> dst4{Count};
+    Containers::Array<Item<8>> dst8{Count};
+    Containers::Array<Item<12>> dst12{Count};
+    Containers::Array<Item<16>> dst16{Count};
+    Containers::Array<Item<20>> dst20{Count};
+
+    Utility::applyPermutation(Containers::StridedArrayView1D<const std::uint32_t>{permutation}, {
+        {Containers::StridedArrayView1D<const Item<1>>{src1}, Containers::stridedArrayView(dst1)},
+        {Containers::StridedArrayView1D<const Item<2>>{src2}, Containers::stridedArrayView(dst2)},
+        {Containers::StridedArrayView1D<const Item<3>>{src3}, Containers::stridedArrayView(dst3)},
+        {Containers::StridedArrayView1D<const Item<4>>{src4}, Containers::stridedArrayView(dst4)},
+        {Containers::StridedArrayView1D<const Item<8>>{src8}, Containers::stridedArrayView(dst8)},
+        {Containers::StridedArrayView1D<const Item<12>>{src12}, Containers::stridedArrayView(dst12)},
+        {Containers::StridedArrayView1D<const Item<16>>{src16}, Containers::stridedArrayView(dst16)},
+        {Containers::StridedArrayView1D<const Item<20>>{src20}, Containers::stridedArrayView(dst20)}
+    });
+    CORRADE_VERIFY(isPermuted<1>(permutation, src1, dst1));
+    CORRADE_VERIFY(isPermuted<2>(permutation, src2, dst2));
+    CORRADE_VERIFY(isPermuted<3>(permutation, src3, dst3));
+    CORRADE_VERIFY(isPermuted<4>(permutation, src4, dst4));
+    CORRADE_VERIFY(isPermuted<8>(permutation, src8, dst8));
+    CORRADE_VERIFY(isPermuted<12>(permutation, src12, dst12));
+    CORRADE_VERIFY(isPermuted<16>(permutation, src16, dst16));
+    CORRADE_VERIFY(isPermuted<20>(permutation, src20, dst20));
+}
+
+void AlgorithmsTest::applyPermutationParallel() {
+    constexpr std::size_t Count = 3333;
+    const Containers::Array<std::uint32_t> permutation = permutationFor(Count);
+    const Containers::Array<Item<12>> src12 = itemsFor<12>(Count);
+    const Containers::Array<Item<3>> src3 = itemsFor<3>(Count);
+    Containers::Array<Item<12>> dst12{Count};
+    Containers::Array<Item<3>> dst3{Count};
+
+    SerialExecutorState state{};
+    Utility::applyPermutation(Containers::StridedArrayView1D<const std::uint32_t>{permutation}, {
+        {Containers::StridedArrayView1D<const Item<12>>{src12}, Containers::stridedArrayView(dst12)},
+        {Containers::StridedArrayView1D<const Item<3>>{src3}, Containers::stridedArrayView(dst3)}
+    }, serialExecutor, &state, 3);
+    CORRADE_COMPARE(state.calls, 1);
+    /* Four blocks of 1024 items, split into chunks of two */
+    CORRADE_COMPARE(state.jobs, 2);
+    CORRADE_VERIFY(isPermuted<12>(permutation, src12, dst12));
+    CORRADE_VERIFY(isPermuted<3>(permutation, src3, dst3));
+}
+
+void AlgorithmsTest::applyPermutationParallelSingleBlock() {
+    const Containers::Array<std::uint32_t> permutation = permutationFor(1000);
+    const Containers::Array<Item<4>> src = itemsFor<4>(1000);
+    Containers::Array<Item<4>> dst{1000};
+
+    /* A single block or a single job should be done directly */
+    SerialExecutorState state{};
+    Utility::applyPermutation(Containers::StridedArrayView1D<const std::uint32_t>{permutation}, {
+        {Containers::StridedArrayView1D<const Item<4>>{src}, Containers::stridedArrayView(dst)}
+    }, serialExecutor, &state, 4);
+    Utility::applyPermutation(Containers::StridedArrayView1D<const std::uint32_t>{permutation}, {
+        {Containers::StridedArrayView1D<const Item<4>>{src}, Containers::stridedArrayView(dst)}
+    }, serialExecutor, &state, 1);
+    CORRADE_COMPARE(state.calls, 0);
+    CORRADE_VERIFY(isPermuted<4>(permutation, src, dst));
+}
+
+void AlgorithmsTest::applyPermutationInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const int src[3]{};
+    const short srcShort[3]{};
+    const std::uint32_t permutation[]{0, 3};
+    int dst[3]{};
+    char dstBytes[2][8]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Utility::applyPermutation(Containers::StridedArrayView1D<const std::uint32_t>{permutation}, {
+        {Containers::StridedArrayView1D<const int>{src}.prefix(2),
+         Containers::StridedArrayView1D<int>{dst}.prefix(2)},
+        {Containers::StridedArrayView1D<const int>{src},
+         Containers::StridedArrayView1D<int>{dst}}
+    });
+    Utility::applyPermutation(Containers::StridedArrayView1D<const std::uint32_t>{permutation}, {
+        {Containers::StridedArrayView1D<const int>{src}.prefix(2),
+         Containers::StridedArrayView1D<int>{dst}.prefix(2)},
+        {Containers::arrayCast<2, const char>(Containers::StridedArrayView1D<const short>{srcShort}.prefix(2)),
+         Containers::arrayCast<2, char>(Containers::StridedArrayView1D<int>{dst}.prefix(2))}
+    });
+    Utility::applyPermutation(Containers::StridedArrayView1D<const std::uint32_t>{permutation}, {
+        {Containers::StridedArrayView2D<const char>{Containers::arrayView(&dstBytes[0][0], 16), {2, 8}}.every({1, 2}),
+         Containers::StridedArrayView2D<char>{Containers::arrayView(&dstBytes[0][0], 16), {2, 8}}.every({1, 2})}
+    });
+    Utility::applyPermutation(Containers::StridedArrayView1D<const std::uint32_t>{permutation}, {
+        {Containers::StridedArrayView1D<const int>{src}.prefix(2),
+         Containers::StridedArrayView1D<int>{dst}.prefix(2)},
+        {Containers::StridedArrayView1D<const int>{src},
+         Containers::StridedArrayView1D<int>{dst}.prefix(2)}
+    });
+    CORRADE_COMPARE(out.str(),
+        "Utility::applyPermutation(): expected destination view 1 to have 2 items but got 3\n"
+        "Utility::applyPermutation(): item sizes 2 and 4 in views 1 don't match\n"
+        "Utility::applyPermutation(): second dimension of views 0 is not contiguous\n"
+        "Utility::applyPermutation(): index 3 out of bounds for 2 elements\n");
+}
+
+void AlgorithmsTest::castInto() {
+    const std::uint16_t src[]{0, 65535, 1337};
+    std::uint32_t dst[3];
+
+    Utility::castInto(Containers::StridedArrayView1D<const std::uint16_t>{src},
+        Containers::StridedArrayView1D<std::uint32_t>{dst});
+    CORRADE_COMPARE_AS(Containers::arrayView(dst),
+        Containers::arrayView<std::uint32_t>({0, 65535, 1337}),
+        TestSuite::Compare::Container);
+}
+
+void AlgorithmsTest::castIntoStrided() {
+    const std::int8_t src[]{-3, 0, 2, 0, 127, 0};
+    Vertex vertices[3]{};
+
+    Utility::castInto(
+        Containers::StridedArrayView1D<const std::int8_t>{src, 3, 2},
+        Containers::StridedArrayView1D<int>{vertices, &vertices[0].id, 3, sizeof(Vertex)});
+    CORRADE_COMPARE(vertices[0].id, -3);
+    CORRADE_COMPARE(vertices[1].id, 2);
+    CORRADE_COMPARE(vertices[2].id, 127);
+    CORRADE_COMPARE(vertices[2].position, 0.0f);
+}
+
+void AlgorithmsTest::unpackInto() {
+    const std::uint8_t src[]{0, 255, 51};
+    float dst[3];
+
+    Utility::unpackInto(Containers::StridedArrayView1D<const std::uint8_t>{src},
+        Containers::StridedArrayView1D<float>{dst});
+    CORRADE_COMPARE(dst[0], 0.0f);
+    CORRADE_COMPARE(dst[1], 1.0f);
+    CORRADE_COMPARE(dst[2], 0.2f);
+
+    const std::uint16_t src16[]{65535, 0, 0, 0};
+    double dst16[2];
+    Utility::unpackInto(Containers::StridedArrayView1D<const std::uint16_t>{src16, 2, 4},
+        Containers::StridedArrayView1D<double>{dst16});
+    CORRADE_COMPARE(dst16[0], 1.0);
+    CORRADE_COMPARE(dst16[1], 0.0);
+}
+
+void AlgorithmsTest::castIntoNonMatchingSizes() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const std::uint8_t src[3]{};
+    float dst[2];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Utility::castInto(Containers::StridedArrayView1D<const std::uint8_t>{src},
+        Containers::StridedArrayView1D<float>{dst});
+    Utility::unpackInto(Containers::StridedArrayView1D<const std::uint8_t>{src},
+        Containers::StridedArrayView1D<float>{dst});
+    CORRADE_COMPARE(out.str(),
+        "Utility::castInto(): sizes 3 and 2 don't match\n"
+        "Utility::unpackInto(): sizes 3 and 2 don't match\n");
+}
+
+void AlgorithmsTest::parallelFor() {
+    Containers::Array<int> data{Containers::ValueInit, 10*3};
+    Containers::StridedArrayView2D<int> view{data, {10, 3}};
+
+    /* Each row gets the index of the first row in its part plus one, each
+       part should get complete rows */
+    SerialExecutorState state{};
+    std::size_t columns = 0;
+    Utility::parallelFor(view, [&](const Containers::StridedArrayView2D<int>& part) {
+        columns += part.size()[1];
+        const int first = (static_cast<int*>(part.data()) - data.data())/3;
+        for(std::size_t i = 0; i != part.size()[0]; ++i)
+            for(int& j: part[i]) j += first + 1;
+    }, serialExecutor, &state, 4);
+    CORRADE_COMPARE(state.calls, 1);
+    /* 10 rows split into chunks of 3 */
+    CORRADE_COMPARE(state.jobs, 4);
+    CORRADE_COMPARE(columns, 4*3);
+    CORRADE_COMPARE_AS(data, Containers::arrayView({
+         1,  1,  1,  1,  1,  1,  1,  1,  1,
+         4,  4,  4,  4,  4,  4,  4,  4,  4,
+         7,  7,  7,  7,  7,  7,  7,  7,  7,
+        10, 10, 10
+    }), TestSuite::Compare::Container);
+}
+
+void AlgorithmsTest::parallelForBelowThreshold() {
+    int data[4]{};
+    Containers::StridedArrayView1D<int> view{data};
+
+    /* Single job or a single item -- all of them should call the function
+       directly with the whole view */
+    SerialExecutorState state{};
+    std::size_t calls = 0;
+    auto increment = [&](const Containers::StridedArrayView1D<int>& part) {
+        ++calls;
+        for(int& i: part) ++i;
+    };
+    Utility::parallelFor(view, increment, serialExecutor, &state, 1);
+    Utility::parallelFor(view, increment, serialExecutor, &state, 0);
+    Utility::parallelFor(view.prefix(1), increment, serialExecutor, &state, 4);
+    CORRADE_COMPARE(state.calls, 0);
+    CORRADE_COMPARE(calls, 3);
+    CORRADE_COMPARE_AS(Containers::arrayView(data),
+        Containers::arrayView({3, 2, 2, 2}),
+        TestSuite::Compare::Container);
+}
+
+void AlgorithmsTest::parallelReduce() {
+    Containers::Array<int> data{Containers::NoInit, 7*2};
+    for(std::size_t i = 0; i != data.size(); ++i) data[i] = i;
+
+    /* Every other column */
+    Containers::StridedArrayView2D<const int> view{data, {7, 1}, {2*4, 4}};
+
+    SerialExecutorState state{};
+    std::string order = Utility::parallelReduce(view, std::string{"x"},
+        [](const Containers::StridedArrayView2D<const int>& part) {
+            return std::string(1, char('0' + part[0][0]/2));
+        }, [](std::string a, const std::string& b) {
+            return a + b;
+        }, serialExecutor, &state, 3);
+    CORRADE_COMPARE(state.calls, 1);
+    /* 7 rows split into chunks of 3, the results combined in order even
+       though the executor ran them in reverse */
+    CORRADE_COMPARE(state.jobs, 3);
+    CORRADE_COMPARE(order, "x036");
+
+    int sum = Utility::parallelReduce(view, 100,
+        [](const Containers::StridedArrayView2D<const int>& part) {
+            int sum = 0;
+            for(std::size_t i = 0; i != part.size()[0]; ++i)
+                for(int j: part[i]) sum += j;
+            return sum;
+        }, [](int a, int b) { return a + b; }, serialExecutor, &state, 3);
+    CORRADE_COMPARE(state.calls, 2);
+    CORRADE_COMPARE(sum, 100 + 0 + 2 + 4 + 6 + 8 + 10 + 12);
+}
+
+void AlgorithmsTest::parallelReduceBelowThreshold() {
+    const int data[]{1, 2, 3};
+
+    SerialExecutorState state{};
+    int sum = Utility::parallelReduce(Containers::StridedArrayView1D<const int>{data}, 10,
+        [](const Containers::StridedArrayView1D<const int>& part) {
+            int sum = 0;
+            for(int i: part) sum += i;
+            return sum;
+        }, [](int a, int b) { return a + b; }, serialExecutor, &state, 1);
+    CORRADE_COMPARE(state.calls, 0);
+    CORRADE_COMPARE(sum, 16);
+}
+
+void AlgorithmsTest::parallelTransform() {
+    Containers::Array<std::uint8_t> srcData{Containers::NoInit, 5*4*2};
+    for(std::size_t i = 0; i != srcData.size(); ++i) srcData[i] = i;
+    Vertex vertices[5*4]{};
+
+    /* Every other column of the source into a member of a struct */
+    Containers::StridedArrayView2D<const std::uint8_t> src{srcData, {5, 4}, {4*2, 2}};
+    Containers::StridedArrayView2D<int> dst{vertices, &vertices[0].id, {5, 4}, {4*sizeof(Vertex), sizeof(Vertex)}};
+
+    SerialExecutorState state{};
+    Utility::parallelTransform(src, dst, [](std::uint8_t a) {
+        return -int(a);
+    }, serialExecutor, &state, 2);
+    CORRADE_COMPARE(state.calls, 1);
+    CORRADE_COMPARE(state.jobs, 2);
+    for(std::size_t i = 0; i != 5*4; ++i) {
+        CORRADE_COMPARE(vertices[i].id, -int(i*2));
+        CORRADE_COMPARE(vertices[i].position, 0.0f);
+    }
+}
+
+void AlgorithmsTest::parallelTransformBelowThreshold() {
+    const float src[]{1.5f, 2.5f, 3.5f};
+    int dst[3]{};
+
+    SerialExecutorState state{};
+    Utility::parallelTransform(Containers::StridedArrayView1D<const float>{src},
+        Containers::StridedArrayView1D<int>{dst}, [](float a) {
+            return int(a*2.0f);
+        }, serialExecutor, &state, 1);
+    CORRADE_COMPARE(state.calls, 0);
+    CORRADE_COMPARE_AS(Containers::arrayView(dst),
+        Containers::arrayView({3, 5, 7}),
+        TestSuite::Compare::Container);
+}
+
+void AlgorithmsTest::parallelTransformNonMatchingSizes() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    int a[2*3]{};
+    SerialExecutorState state{};
+    Utility::parallelTransform(Containers::StridedArrayView2D<const int>{a, {2, 3}},
+        Containers::StridedArrayView2D<int>{a, {3, 2}},
+        [](int a) { return a; }, serialExecutor, &state, 2);
+    CORRADE_COMPARE(state.calls, 0);
+    CORRADE_COMPARE(out.str(),
+        "Utility::parallelTransform(): sizes {2, 3} and {3, 2} don't match\n");
+}
+
+void AlgorithmsTest::sort() {
+    int data[]{5, -3, 8, 0, 2, 2, 17, -1, 9, 4};
+    Utility::sort(Containers::StridedArrayView1D<int>{data});
+    CORRADE_COMPARE_AS(Containers::arrayView(data),
+        Containers::arrayView({-3, -1, 0, 2, 2, 4, 5, 8, 9, 17}),
+        TestSuite::Compare::Container);
+
+    /* Empty view shouldn't crash */
+    Utility::sort(Containers::StridedArrayView1D<int>{});
+}
+
+void AlgorithmsTest::sortStrided() {
+    /* Large enough to go through the partitioning */
+    Vertex vertices[200];
+    std::uint32_t state = 0;
+    for(std::size_t i = 0; i != Containers::arraySize(vertices); ++i)
+        vertices[i] = {float(i), int(lcg(state) % 1000)};
+
+    std::vector<int> expected;
+    for(const Vertex& vertex: vertices) expected.push_back(vertex.id);
+    std::sort(expected.begin(), expected.end());
+
+    Containers::StridedArrayView1D<int> ids{vertices, &vertices[0].id, Containers::arraySize(vertices), sizeof(Vertex)};
+    Utility::sort(ids);
+    CORRADE_COMPARE_AS(ids, Containers::stridedArrayView(Containers::arrayView(expected)),
+        TestSuite::Compare::Container);
+
+    /* Positions are left untouched */
+    CORRADE_COMPARE(vertices[0].position, 0.0f);
+    CORRADE_COMPARE(vertices[199].position, 199.0f);
+
+    /* Negative stride sorts in descending order in memory */
+    Utility::sort(ids.flipped<0>());
+    CORRADE_COMPARE(vertices[0].id, expected.back());
+    CORRADE_COMPARE(vertices[199].id, expected.front());
+}
+
+void AlgorithmsTest::sortCustomCompare() {
+    int data[]{5, -3, 8, 0, 2};
+    Utility::sort(Containers::StridedArrayView1D<int>{data}, [](int a, int b) {
+        return a > b;
+    });
+    CORRADE_COMPARE_AS(Containers::arrayView(data),
+        Containers::arrayView({8, 5, 2, 0, -3}),
+        TestSuite::Compare::Container);
+}
+
+void AlgorithmsTest::sortPatterns() {
+    /* Sorted, reversed, all same, few distinct and organ pipe inputs, which
+       are problematic for naive quicksort implementations */
+    std::vector<int> patterns[5];
+    std::uint32_t state = 0;
+    for(int i = 0; i != 1000; ++i) {
+        patterns[0].push_back(i);
+        patterns[1].push_back(1000 - i);
+        patterns[2].push_back(7);
+        patterns[3].push_back(int(lcg(state) % 3));
+        patterns[4].push_back(i < 500 ? i : 1000 - i);
+    }
+
+    for(std::vector<int>& pattern: patterns) {
+        std::vector<int> expected = pattern;
+        std::sort(expected.begin(), expected.end());
+        Utility::sort(Containers::stridedArrayView(Containers::arrayView(pattern)));
+        CORRADE_COMPARE_AS(Containers::arrayView(pattern),
+            Containers::arrayView(expected),
+            TestSuite::Compare::Container);
+    }
+}
+
+void AlgorithmsTest::sortPermutation() {
+    const Vertex vertices[]{{1.5f, 40}, {2.5f, 10}, {3.5f, 30}, {4.5f, 20}};
+    std::uint16_t permutation[4];
+
+    Utility::sortPermutation(
+        Containers::StridedArrayView1D<const int>{vertices, &vertices[0].id, 4, sizeof(Vertex)},
+        Containers::StridedArrayView1D<std::uint16_t>{permutation});
+    CORRADE_COMPARE_AS(Containers::arrayView(permutation),
+        Containers::arrayView<std::uint16_t>({1, 3, 2, 0}),
+        TestSuite::Compare::Container);
+
+    /* The permutation can be then used to reorder the rest of the data */
+    float positions[4];
+    Utility::gather(
+        Containers::StridedArrayView1D<const float>{vertices, &vertices[0].position, 4, sizeof(Vertex)},
+        Containers::StridedArrayView1D<const std::uint16_t>{permutation},
+        Containers::StridedArrayView1D<float>{positions});
+    CORRADE_COMPARE_AS(Containers::arrayView(positions),
+        Containers::arrayView({2.5f, 4.5f, 3.5f, 1.5f}),
+        TestSuite::Compare::Container);
+}
+
+void AlgorithmsTest::sortPermutationInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const int keys[3]{};
+    std::uint32_t permutation[2];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Utility::sortPermutation(Containers::StridedArrayView1D<const int>{keys},
+        Containers::StridedArrayView1D<std::uint32_t>{permutation});
+    CORRADE_COMPARE(out.str(),
+        "Utility::sortPermutation(): expected key and permutation views to have the same size but got 3 and 2\n");
+}
+
+template<class T> void AlgorithmsTest::radixSort() {
+    setTestCaseTemplateName(TypeName<T>::name());
+
+    /* Both below and above the threshold for falling back to sort(), and
+       the values spanning the whole range including negative values */
+    for(std::size_t size: {std::size_t{10}, std::size_t{1000}}) {
+        std::vector<T> data;
+        std::uint32_t state = 0;
+        for(std::size_t i = 0; i != size; ++i) {
+            const std::uint64_t value = (std::uint64_t(lcg(state)) << 40) ^ (std::uint64_t(lcg(state)) << 20) ^ lcg(state);
+            data.push_back(T(value));
+        }
+
+        std::vector<T> expected = data;
+        std::sort(expected.begin(), expected.end());
+        Utility::radixSort(Containers::stridedArrayView(Containers::arrayView(data)));
+        CORRADE_COMPARE_AS(Containers::arrayView(data),
+            Containers::arrayView(expected),
+            TestSuite::Compare::Container);
+    }
+}
+
+void AlgorithmsTest::radixSortStrided() {
+    Vertex vertices[300];
+    std::uint32_t state = 0;
+    for(std::size_t i = 0; i != Containers::arraySize(vertices); ++i)
+        vertices[i] = {float(i), int(lcg(state) % 100000) - 50000};
+
+    std::vector<int> expected;
+    for(const Vertex& vertex: vertices) expected.push_back(vertex.id);
+    std::sort(expected.begin(), expected.end());
+
+    Containers::StridedArrayView1D<int> ids{vertices, &vertices[0].id, Containers::arraySize(vertices), sizeof(Vertex)};
+    Utility::radixSort(ids);
+    CORRADE_COMPARE_AS(ids, Containers::stridedArrayView(Containers::arrayView(expected)),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(vertices[299].position, 299.0f);
+}
+
+void AlgorithmsTest::radixSortPermutation() {
+    const std::int32_t keys[]{3, -1, 3, 0, -1, 2, 3};
+    std::uint32_t permutation[7];
+    Utility::radixSortPermutation(
+        Containers::StridedArrayView1D<const std::int32_t>{keys},
+        Containers::StridedArrayView1D<std::uint32_t>{permutation});
+
+    /* Equal keys are kept in their original order */
+    CORRADE_COMPARE_AS(Containers::arrayView(permutation),
+        Containers::arrayView<std::uint32_t>({1, 4, 3, 5, 0, 2, 6}),
+        TestSuite::Compare::Container);
+}
+
+void AlgorithmsTest::radixSortPermutationInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const int keys[3]{};
+    std::uint32_t permutation[4];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Utility::radixSortPermutation(Containers::StridedArrayView1D<const int>{keys},
+        Containers::StridedArrayView1D<std::uint32_t>{permutation});
+    CORRADE_COMPARE(out.str(),
+        "Utility::radixSortPermutation(): expected key and permutation views to have the same size but got 3 and 4\n");
+}
+
+void AlgorithmsTest::lowerUpperBound() {
+    const int data[]{1, 3, 3, 3, 7, 9};
+    Containers::StridedArrayView1D<const int> view{data};
+
+    CORRADE_COMPARE(Utility::lowerBound(view, 0), 0);
+    CORRADE_COMPARE(Utility::upperBound(view, 0), 0);
+    CORRADE_COMPARE(Utility::lowerBound(view, 3), 1);
+    CORRADE_COMPARE(Utility::upperBound(view, 3), 4);
+    CORRADE_COMPARE(Utility::lowerBound(view, 5), 4);
+    CORRADE_COMPARE(Utility::upperBound(view, 5), 4);
+    CORRADE_COMPARE(Utility::lowerBound(view, 9), 5);
+    CORRADE_COMPARE(Utility::upperBound(view, 9), 6);
+    CORRADE_COMPARE(Utility::lowerBound(view, 10), 6);
+
+    CORRADE_COMPARE(Utility::lowerBound(Containers::StridedArrayView1D<const int>{}, 3), 0);
+}
+
+void AlgorithmsTest::lowerUpperBoundStrided() {
+    const Vertex vertices[]{{4.5f, 10}, {3.5f, 20}, {2.5f, 30}, {1.5f, 40}};
+    Containers::StridedArrayView1D<const float> positions{vertices, &vertices[0].position, 4, sizeof(Vertex)};
+
+    /* Descending order, with a custom comparator */
+    auto greater = [](float a, float b) { return a > b; };
+    CORRADE_COMPARE(Utility::lowerBound(positions, 3.5f, greater), 1);
+    CORRADE_COMPARE(Utility::upperBound(positions, 3.5f, greater), 2);
+
+    /* Flipped to ascending order */
+    CORRADE_COMPARE(Utility::lowerBound(positions.flipped<0>(), 3.5f), 2);
+    CORRADE_COMPARE(Utility::upperBound(positions.flipped<0>(), 3.0f), 2);
+}
+
+void AlgorithmsTest::interpolationSearch() {
+    std::vector<std::int32_t> data;
+    std::uint32_t state = 0;
+    for(std::size_t i = 0; i != 1000; ++i)
+        data.push_back(std::int32_t(lcg(state) % 200000) - 100000);
+    std::sort(data.begin(), data.end());
+    const Containers::StridedArrayView1D<const std::int32_t> view = Containers::arrayView(data);
+
+    for(std::int32_t value: {-200000, -100000, -31337, 0, 5, 99999, 200000}) {
+        CORRADE_COMPARE(Utility::interpolationSearch(view, value),
+            std::size_t(std::lower_bound(data.begin(), data.end(), value) - data.begin()));
+    }
+    for(std::size_t i: {std::size_t{0}, std::size_t{1}, std::size_t{500}, std::size_t{999}}) {
+        CORRADE_COMPARE(Utility::interpolationSearch(view, data[i]),
+            std::size_t(std::lower_bound(data.begin(), data.end(), data[i]) - data.begin()));
+    }
+
+    CORRADE_COMPARE(Utility::interpolationSearch(Containers::StridedArrayView1D<const std::int32_t>{}, 3), 0);
+}
+
+void AlgorithmsTest::interpolationSearchSkewed() {
+    /* Exponentially growing values, on which the interpolation is always
+       way off */
+    std::vector<double> data;
+    for(std::size_t i = 0; i != 1000; ++i)
+        data.push_back(double(i)*double(i)*double(i)*double(i));
+    const Containers::StridedArrayView1D<const double> view = Containers::arrayView(data);
+
+    for(std::size_t i: {std::size_t{0}, std::size_t{3}, std::size_t{10}, std::size_t{500}, std::size_t{998}}) {
+        CORRADE_COMPARE(Utility::interpolationSearch(view, data[i]), i);
+        CORRADE_COMPARE(Utility::interpolationSearch(view, data[i] + 0.5), i + 1);
+    }
+}
+
+void AlgorithmsTest::unique() {
+    int data[]{1, 1, 2, 3, 3, 3, 1, 5, 5};
+    const std::size_t count = Utility::unique(Containers::StridedArrayView1D<int>{data});
+    CORRADE_COMPARE_AS(Containers::arrayView(data).prefix(count),
+        Containers::arrayView({1, 2, 3, 1, 5}),
+        TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(Utility::unique(Containers::StridedArrayView1D<int>{}), 0);
+}
+
+void AlgorithmsTest::uniqueStrided() {
+    Vertex vertices[]{{1.5f, 10}, {1.5f, 20}, {2.5f, 30}, {2.5f, 40}, {3.5f, 50}};
+    Containers::StridedArrayView1D<float> positions{vertices, &vertices[0].position, 5, sizeof(Vertex)};
+
+    /* Comparing with a tolerance */
+    const std::size_t count = Utility::unique(positions, [](float a, float b) {
+        return b - a < 0.75f;
+    });
+    CORRADE_COMPARE_AS(positions.prefix(count),
+        Containers::stridedArrayView({1.5f, 2.5f, 3.5f}),
+        TestSuite::Compare::Container);
+    /* The other field is untouched */
+    CORRADE_COMPARE(vertices[1].id, 20);
+}
+
+/* Values from the whole range of given type. Floating-point values are
+   multiples of 0.25 small enough to be summed exactly in any order. */
+template<class T> static T randomValue(std::uint32_t& state) {
+    return T((std::uint64_t(lcg(state)) << 40) ^ (std::uint64_t(lcg(state)) << 20) ^ lcg(state));
+}
+template<> float randomValue<float>(std::uint32_t& state) {
+    return float(int(lcg(state) % 2000) - 1000)*0.25f;
+}
+template<> double randomValue<double>(std::uint32_t& state) {
+    return double(int(lcg(state) % 2000) - 1000)*0.25;
+}
+
+/* Values from a small range to have repeated occurrences */
+template<class T> static T smallValue(std::uint32_t& state) {
+    return T(int(lcg(state) % 50) - 25);
+}
+
+template<class T> static typename Implementation::AlgorithmTypeFor<T>::SumType expectedSum(const Containers::StridedArrayView1D<const T>& values) {
+    typedef typename Implementation::AlgorithmTypeFor<T>::SumType SumType;
+    /* Wrapping around the same way as the implementation */
+    typename std::conditional<std::is_integral<T>::value, std::uint64_t, SumType>::type out{};
+    for(const T value: values)
+        out += decltype(out)(SumType(value));
+    return SumType(out);
+}
+
+template<class T> void AlgorithmsTest::findCount() {
+    setTestCaseTemplateName(TypeName<T>::name());
+
+    std::vector<T> data;
+    std::uint32_t state = 0;
+    for(std::size_t i = 0; i != 1000; ++i)
+        data.push_back(smallValue<T>(state));
+    const Containers::StridedArrayView1D<const T> view = Containers::arrayView(data);
+    const Containers::StridedArrayView1D<const T> strided = view.every(3);
+
+    for(const int v: {-25, -1, 0, 7, 24, 100}) {
+        const T value = T(v);
+        CORRADE_COMPARE(Utility::find(view, value),
+            std::size_t(std::find(data.begin(), data.end(), value) - data.begin()));
+        CORRADE_COMPARE(Utility::count(view, value),
+            std::size_t(std::count(data.begin(), data.end(), value)));
+
+        std::size_t expectedFind = strided.size();
+        std::size_t expectedCount = 0;
+        for(std::size_t i = 0; i != strided.size(); ++i) if(strided[i] == value) {
+            if(expectedFind == strided.size()) expectedFind = i;
+            ++expectedCount;
+        }
+        CORRADE_COMPARE(Utility::find(strided, value), expectedFind);
+        CORRADE_COMPARE(Utility::count(strided, value), expectedCount);
+    }
+
+    /* The last item is found as well */
+    data.back() = T(100);
+    CORRADE_COMPARE(Utility::find(view, T(100)), 999);
+    CORRADE_COMPARE(Utility::count(view, T(100)), 1);
+
+    CORRADE_COMPARE(Utility::find(Containers::StridedArrayView1D<const T>{}, T(0)), 0);
+    CORRADE_COMPARE(Utility::count(Containers::StridedArrayView1D<const T>{}, T(0)), 0);
+}
+
+template<class T> void AlgorithmsTest::mismatchEqual() {
+    setTestCaseTemplateName(TypeName<T>::name());
+
+    std::vector<T> a;
+    std::uint32_t state = 0;
+    for(std::size_t i = 0; i != 1000; ++i)
+        a.push_back(randomValue<T>(state));
+    std::vector<T> b = a;
+    const Containers::StridedArrayView1D<const T> aView = Containers::arrayView(a);
+    const Containers::StridedArrayView1D<const T> bView = Containers::arrayView(b);
+
+    CORRADE_VERIFY(Utility::equal(aView, bView));
+    CORRADE_COMPARE(Utility::mismatch(aView, bView), 1000);
+
+    for(const std::size_t i: {0, 1, 15, 16, 17, 500, 998, 999}) {
+        b[i] = T(a[i] + T(1));
+        CORRADE_VERIFY(!Utility::equal(aView, bView));
+        CORRADE_COMPARE(Utility::mismatch(aView, bView), i);
+        CORRADE_COMPARE(Utility::mismatch(aView.every(2), bView.every(2)), i % 2 ? 500 : i/2);
+        b[i] = a[i];
+    }
+
+    /* Prefix */
+    CORRADE_VERIFY(!Utility::equal(aView, bView.prefix(700)));
+    CORRADE_COMPARE(Utility::mismatch(aView, bView.prefix(700)), 700);
+    CORRADE_COMPARE(Utility::mismatch(aView.prefix(300), bView), 300);
+
+    CORRADE_VERIFY(Utility::equal(Containers::StridedArrayView1D<const T>{}, Containers::StridedArrayView1D<const T>{}));
+    CORRADE_COMPARE(Utility::mismatch(Containers::StridedArrayView1D<const T>{}, bView), 0);
+}
+
+template<class T> void AlgorithmsTest::minmax() {
+    setTestCaseTemplateName(TypeName<T>::name());
+
+    std::vector<T> data;
+    std::uint32_t state = 0;
+    for(std::size_t i = 0; i != 1000; ++i)
+        data.push_back(randomValue<T>(state));
+    const Containers::StridedArrayView1D<const T> view = Containers::arrayView(data);
+
+    const auto expected = std::minmax_element(data.begin(), data.end());
+    CORRADE_COMPARE(Utility::min(view), *expected.first);
+    CORRADE_COMPARE(Utility::max(view), *expected.second);
+    CORRADE_COMPARE(Utility::minmax(view), std::make_pair(*expected.first, *expected.second));
+
+    /* Strided, the extremes are excluded by it */
+    const Containers::StridedArrayView1D<const T> strided = view.every(7);
+    T expectedMin = strided[0], expectedMax = strided[0];
+    for(const T value: strided) {
+        if(value < expectedMin) expectedMin = value;
+        if(expectedMax < value) expectedMax = value;
+    }
+    CORRADE_COMPARE(Utility::minmax(strided), std::make_pair(expectedMin, expectedMax));
+
+    /* Single item */
+    CORRADE_COMPARE(Utility::minmax(view.slice(500, 501)), std::make_pair(data[500], data[500]));
+}
+
+template<class T> void AlgorithmsTest::sum() {
+    setTestCaseTemplateName(TypeName<T>::name());
+
+    std::vector<T> data;
+    std::uint32_t state = 0;
+    for(std::size_t i = 0; i != 1000; ++i)
+        data.push_back(randomValue<T>(state));
+    const Containers::StridedArrayView1D<const T> view = Containers::arrayView(data);
+
+    CORRADE_COMPARE(Utility::sum(view), expectedSum(view));
+    CORRADE_COMPARE(Utility::sum(view.every(3)), expectedSum(view.every(3)));
+    CORRADE_COMPARE(Utility::sum(Containers::StridedArrayView1D<const T>{}), 0);
+}
+
+void AlgorithmsTest::searchFloatingPointSpecial() {
+    std::vector<float> data(100, 1.0f);
+    data[50] = std::numeric_limits<float>::quiet_NaN();
+    data[70] = -0.0f;
+    const Containers::StridedArrayView1D<const float> view = Containers::arrayView(data);
+
+    /* NaN is never equal to anything, negative zero is equal to zero */
+    CORRADE_COMPARE(Utility::find(view, std::numeric_limits<float>::quiet_NaN()), 100);
+    CORRADE_COMPARE(Utility::find(view, 0.0f), 70);
+    CORRADE_COMPARE(Utility::count(view, 0.0f), 1);
+    CORRADE_VERIFY(!Utility::equal(view, view));
+    CORRADE_COMPARE(Utility::mismatch(view, view), 50);
+}
+
+void AlgorithmsTest::minmaxEmpty() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Utility::min(Containers::StridedArrayView1D<const int>{});
+    Utility::max(Containers::StridedArrayView1D<const int>{});
+    Utility::minmax(Containers::StridedArrayView1D<const int>{});
+    CORRADE_COMPARE(out.str(),
+        "Utility::min(): expected a non-empty view\n"
+        "Utility::max(): expected a non-empty view\n"
+        "Utility::minmax(): expected a non-empty view\n");
+}
+
+template<class T> void AlgorithmsTest::algorithmKernels() {
+    auto&& data = AlgorithmKernelsData[testCaseInstanceId()];
+    setTestCaseTemplateName(TypeName<T>::name());
+    setTestCaseDescription(data.name);
+
+    if((Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("Not supported on this machine.");
+
+    const Implementation::AlgorithmType type = Implementation::AlgorithmTypeFor<T>::type();
+    const Implementation::AlgorithmKernels kernels = Implementation::algorithmKernels(type, data.features);
+    const Implementation::AlgorithmKernels scalar = Implementation::algorithmKernels(type, {});
+    if(data.features && kernels.find == scalar.find)
+        CORRADE_SKIP("Not compiled in.");
+
+    typedef typename Implementation::AlgorithmTypeFor<T>::SumType SumType;
+
+    std::vector<T> values, small;
+    std::uint32_t state = 0;
+    for(std::size_t i = 0; i != 1100; ++i) {
+        values.push_back(randomValue<T>(state));
+        small.push_back(smallValue<T>(state));
+    }
+
+    /* Various sizes and offsets to test the remainder handling and unaligned
+       access */
+    for(std::size_t offset = 0; offset != 4; ++offset) {
+        for(std::size_t size: {0, 1, 3, 7, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 1000}) {
+            const T* const begin = values.data() + offset;
+            const T* const smallBegin = small.data() + offset;
+
+            for(const int v: {-25, 0, 13, 100}) {
+                const T value = T(v);
+                CORRADE_COMPARE(kernels.find(smallBegin, size, &value),
+                                scalar.find(smallBegin, size, &value));
+                CORRADE_COMPARE(kernels.count(smallBegin, size, &value),
+                                scalar.count(smallBegin, size, &value));
+            }
+
+            std::vector<T> other{begin, begin + size};
+            CORRADE_COMPARE(kernels.mismatch(begin, other.data(), size), size);
+            if(size) {
+                other[size - 1] = T(other[size - 1] + T(1));
+                CORRADE_COMPARE(kernels.mismatch(begin, other.data(), size), size - 1);
+                other[size/2] = T(other[size/2] + T(1));
+                CORRADE_COMPARE(kernels.mismatch(begin, other.data(), size), size/2);
+
+                T min, max, scalarMin, scalarMax;
+                kernels.minmax(begin, size, &min, &max);
+                scalar.minmax(begin, size, &scalarMin, &scalarMax);
+                CORRADE_COMPARE(min, scalarMin);
+                CORRADE_COMPARE(max, scalarMax);
+            }
+
+            SumType sum, scalarSum;
+            kernels.sum(begin, size, &sum);
+            scalar.sum(begin, size, &scalarSum);
+            CORRADE_COMPARE(sum, scalarSum);
+        }
+    }
+}
+
 constexpr std::size_t Size = 16;
 constexpr std::size_t Size2 = 64;
 static_assert(Size*Size*Size == Size2*Size2, "otherwise the times won't match");
@@ -732,6 +2103,25 @@ void AlgorithmsTest::copyBenchmark2DNonContiguous() {
     CORRADE_COMPARE(dstData[Size2*Size2 - 2], Size2*Size2 + 10 - 2);
 }
 
+void AlgorithmsTest::copyBenchmark2DTransposed() {
+    Containers::Array<int> srcData{Containers::NoInit, Size2*Size2*16};
+    Containers::Array<int> dstData{Containers::NoInit, Size2*Size2*16};
+    Containers::StridedArrayView2D<int> src{srcData, {Size2*4, Size2*4}};
+    Containers::StridedArrayView2D<int> dst = Containers::StridedArrayView2D<int>{dstData, {Size2*4, Size2*4}}.transposed<0, 1>();
+
+    int base = 0;
+    CORRADE_BENCHMARK(10) {
+        int n = base;
+        for(int& i: srcData) i = ++n;
+
+        Utility::copy(src, dst);
+
+        ++base;
+    }
+
+    CORRADE_COMPARE(dstData[1], Size2*4 + 10);
+}
+
 template<class T> void AlgorithmsTest::copyBenchmark3DNonContiguous() {
     setTestCaseTemplateName(TypeName<T>::name());
 
@@ -757,6 +2147,209 @@ template<class T> void AlgorithmsTest::copyBenchmark3DNonContiguous() {
     CORRADE_COMPARE(dstData[Size*Size*Size*4/sizeof(T) - 2].data[0], (Size*Size*Size*4/sizeof(T) + 10 - 2)%256);
 }
 
+constexpr std::size_t SortSize = 100000;
+
+void AlgorithmsTest::sortBenchmarkStdSort() {
+    std::vector<std::uint32_t> data(SortSize);
+    CORRADE_BENCHMARK(1) {
+        std::uint32_t state = 0;
+        for(std::uint32_t& i: data) i = lcg(state);
+        std::sort(data.begin(), data.end());
+    }
+
+    CORRADE_VERIFY(std::is_sorted(data.begin(), data.end()));
+}
+
+void AlgorithmsTest::sortBenchmark() {
+    std::vector<std::uint32_t> data(SortSize);
+    CORRADE_BENCHMARK(1) {
+        std::uint32_t state = 0;
+        for(std::uint32_t& i: data) i = lcg(state);
+        Utility::sort(Containers::stridedArrayView(Containers::arrayView(data)));
+    }
+
+    CORRADE_VERIFY(std::is_sorted(data.begin(), data.end()));
+}
+
+void AlgorithmsTest::sortBenchmarkStrided() {
+    struct Item {
+        std::uint32_t key;
+        float value;
+    };
+    std::vector<Item> data(SortSize);
+    Containers::StridedArrayView1D<std::uint32_t> keys{Containers::arrayView(data), &data[0].key, SortSize, sizeof(Item)};
+    CORRADE_BENCHMARK(1) {
+        std::uint32_t state = 0;
+        for(std::uint32_t& i: keys) i = lcg(state);
+        Utility::sort(keys);
+    }
+
+    CORRADE_VERIFY(std::is_sorted(keys.begin(), keys.end()));
+}
+
+void AlgorithmsTest::radixSortBenchmark() {
+    std::vector<std::uint32_t> data(SortSize);
+    CORRADE_BENCHMARK(1) {
+        std::uint32_t state = 0;
+        for(std::uint32_t& i: data) i = lcg(state);
+        Utility::radixSort(Containers::stridedArrayView(Containers::arrayView(data)));
+    }
+
+    CORRADE_VERIFY(std::is_sorted(data.begin(), data.end()));
+}
+
+constexpr std::size_t PermutationSize = 100000;
+
+struct PermutationVertex {
+    float position[3];
+    float normal[3];
+    std::uint32_t id;
+};
+
+void AlgorithmsTest::applyPermutationBenchmarkGather() {
+    const Containers::Array<std::uint32_t> permutation = permutationFor(PermutationSize);
+    Containers::Array<PermutationVertex> vertices{Containers::ValueInit, PermutationSize};
+    for(std::size_t i = 0; i != PermutationSize; ++i) vertices[i].id = i;
+    Containers::Array<Item<12>> positions{PermutationSize};
+    Containers::Array<Item<12>> normals{PermutationSize};
+    Containers::Array<std::uint32_t> ids{PermutationSize};
+
+    CORRADE_BENCHMARK(1) {
+        Utility::gather(
+            Containers::StridedArrayView1D<const Item<12>>{vertices, reinterpret_cast<const Item<12>*>(vertices[0].position), PermutationSize, sizeof(PermutationVertex)},
+            Containers::StridedArrayView1D<const std::uint32_t>{permutation},
+            Containers::stridedArrayView(positions));
+        Utility::gather(
+            Containers::StridedArrayView1D<const Item<12>>{vertices, reinterpret_cast<const Item<12>*>(vertices[0].normal), PermutationSize, sizeof(PermutationVertex)},
+            Containers::StridedArrayView1D<const std::uint32_t>{permutation},
+            Containers::stridedArrayView(normals));
+        Utility::gather(
+            Containers::StridedArrayView1D<const std::uint32_t>{vertices, &vertices[0].id, PermutationSize, sizeof(PermutationVertex)},
+            Containers::StridedArrayView1D<const std::uint32_t>{permutation},
+            Containers::stridedArrayView(ids));
+    }
+
+    CORRADE_COMPARE(ids[0], permutation[0]);
+}
+
+void AlgorithmsTest::applyPermutationBenchmark() {
+    const Containers::Array<std::uint32_t> permutation = permutationFor(PermutationSize);
+    Containers::Array<PermutationVertex> vertices{Containers::ValueInit, PermutationSize};
+    for(std::size_t i = 0; i != PermutationSize; ++i) vertices[i].id = i;
+    Containers::Array<Item<12>> positions{PermutationSize};
+    Containers::Array<Item<12>> normals{PermutationSize};
+    Containers::Array<std::uint32_t> ids{PermutationSize};
+
+    CORRADE_BENCHMARK(1) {
+        Utility::applyPermutation(Containers::StridedArrayView1D<const std::uint32_t>{permutation}, {
+            {Containers::StridedArrayView1D<const Item<12>>{vertices, reinterpret_cast<const Item<12>*>(vertices[0].position), PermutationSize, sizeof(PermutationVertex)},
+             Containers::stridedArrayView(positions)},
+            {Containers::StridedArrayView1D<const Item<12>>{vertices, reinterpret_cast<const Item<12>*>(vertices[0].normal), PermutationSize, sizeof(PermutationVertex)},
+             Containers::stridedArrayView(normals)},
+            {Containers::StridedArrayView1D<const std::uint32_t>{vertices, &vertices[0].id, PermutationSize, sizeof(PermutationVertex)},
+             Containers::stridedArrayView(ids)}
+        });
+    }
+
+    CORRADE_COMPARE(ids[0], permutation[0]);
+}
+
+constexpr std::size_t SearchSize = 65536;
+
+static std::vector<std::int32_t> searchData() {
+    std::vector<std::int32_t> data;
+    std::uint32_t state = 0;
+    for(std::size_t i = 0; i != SearchSize; ++i)
+        data.push_back(std::int32_t(lcg(state) % 1000));
+    /* The searched value is at the very end */
+    data.back() = 1000;
+    return data;
+}
+
+void AlgorithmsTest::findBenchmarkStd() {
+    const std::vector<std::int32_t> data = searchData();
+
+    std::size_t found = 0;
+    CORRADE_BENCHMARK(10)
+        found += std::find(data.begin(), data.end(), 1000) - data.begin();
+
+    CORRADE_COMPARE(found, 10*(SearchSize - 1));
+}
+
+void AlgorithmsTest::findBenchmark() {
+    const std::vector<std::int32_t> data = searchData();
+    const Containers::StridedArrayView1D<const std::int32_t> view = Containers::arrayView(data);
+
+    std::size_t found = 0;
+    CORRADE_BENCHMARK(10)
+        found += Utility::find(view, 1000);
+
+    CORRADE_COMPARE(found, 10*(SearchSize - 1));
+}
+
+void AlgorithmsTest::countBenchmarkStd() {
+    const std::vector<std::int32_t> data = searchData();
+
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(10)
+        count += std::count(data.begin(), data.end(), 1000);
+
+    CORRADE_COMPARE(count, 10);
+}
+
+void AlgorithmsTest::countBenchmark() {
+    const std::vector<std::int32_t> data = searchData();
+    const Containers::StridedArrayView1D<const std::int32_t> view = Containers::arrayView(data);
+
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(10)
+        count += Utility::count(view, 1000);
+
+    CORRADE_COMPARE(count, 10);
+}
+
+void AlgorithmsTest::minmaxBenchmarkStd() {
+    const std::vector<std::int32_t> data = searchData();
+
+    std::int32_t max = 0;
+    CORRADE_BENCHMARK(10)
+        max += *std::minmax_element(data.begin(), data.end()).second;
+
+    CORRADE_COMPARE(max, 10*1000);
+}
+
+void AlgorithmsTest::minmaxBenchmark() {
+    const std::vector<std::int32_t> data = searchData();
+    const Containers::StridedArrayView1D<const std::int32_t> view = Containers::arrayView(data);
+
+    std::int32_t max = 0;
+    CORRADE_BENCHMARK(10)
+        max += Utility::minmax(view).second;
+
+    CORRADE_COMPARE(max, 10*1000);
+}
+
+void AlgorithmsTest::sumBenchmarkLoop() {
+    const std::vector<std::int32_t> data = searchData();
+
+    std::int64_t sum = 0;
+    CORRADE_BENCHMARK(10)
+        for(const std::int32_t value: data) sum += value;
+
+    CORRADE_COMPARE(sum, 10*std::accumulate(data.begin(), data.end(), std::int64_t{}));
+}
+
+void AlgorithmsTest::sumBenchmark() {
+    const std::vector<std::int32_t> data = searchData();
+    const Containers::StridedArrayView1D<const std::int32_t> view = Containers::arrayView(data);
+
+    std::int64_t sum = 0;
+    CORRADE_BENCHMARK(10)
+        sum += Utility::sum(view);
+
+    CORRADE_COMPARE(sum, 10*std::accumulate(data.begin(), data.end(), std::int64_t{}));
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Corrade::Utility::Test::AlgorithmsTest)
@@ -72,8 +72,13 @@ struct ArgumentsTest: TestSuite::Tester {
     void parseDoubleArgument();
     void parseEnvironment();
     void parseEnvironmentUtf8();
+    void parseEnvironmentMultipleInstances();
     void parseFinalOptionalArgument();
     void parseFinalOptionalArgumentDefault();
+    void parseManyOptions();
+    void parseValueType();
+    void parseValueTypeInvalid();
+    void parseAddAfterParse();
 
     void parseUnknownArgument();
     void parseUnknownShortArgument();
@@ -107,6 +112,10 @@ struct ArgumentsTest: TestSuite::Tester {
     void notParsedYetOnlyHelp();
     void valueNotFound();
     void valueMismatchedBoolean();
+    void setValueTypeInvalid();
+
+    void benchmarkParseManyOptions();
+    void benchmarkParseManyEnvironmentOptions();
 };
 
 ArgumentsTest::ArgumentsTest() {
@@ -146,8 +155,13 @@ ArgumentsTest::ArgumentsTest() {
               &ArgumentsTest::parseDoubleArgument,
               &ArgumentsTest::parseEnvironment,
               &ArgumentsTest::parseEnvironmentUtf8,
+              &ArgumentsTest::parseEnvironmentMultipleInstances,
               &ArgumentsTest::parseFinalOptionalArgument,
               &ArgumentsTest::parseFinalOptionalArgumentDefault,
+              &ArgumentsTest::parseManyOptions,
+              &ArgumentsTest::parseValueType,
+              &ArgumentsTest::parseValueTypeInvalid,
+              &ArgumentsTest::parseAddAfterParse,
 
               &ArgumentsTest::parseUnknownArgument,
               &ArgumentsTest::parseUnknownShortArgument,
@@ -180,7 +194,11 @@ ArgumentsTest::ArgumentsTest() {
               &ArgumentsTest::notParsedYet,
               &ArgumentsTest::notParsedYetOnlyHelp,
               &ArgumentsTest::valueNotFound,
-              &ArgumentsTest::valueMismatchedBoolean});
+              &ArgumentsTest::valueMismatchedBoolean,
+              &ArgumentsTest::setValueTypeInvalid});
+
+    addBenchmarks({&ArgumentsTest::benchmarkParseManyOptions,
+                   &ArgumentsTest::benchmarkParseManyEnvironmentOptions}, 10);
 }
 
 bool hasEnv(const std::string& value) {
@@ -630,6 +648,35 @@ void ArgumentsTest::parseEnvironmentUtf8() {
     #endif
 }
 
+void ArgumentsTest::parseEnvironmentMultipleInstances() {
+    #ifdef CORRADE_TARGET_WINDOWS_RT
+    CORRADE_SKIP("No environment on this platform.");
+    #else
+    if(!hasEnv("ARGUMENTSTEST_SIZE") || !hasEnv("ARGUMENTSTEST_VERBOSE"))
+        CORRADE_SKIP("Environment not set. Call the test with ARGUMENTSTEST_SIZE=1337 ARGUMENTSTEST_VERBOSE=ON to enable this test case.");
+
+    const char* argv[] = { "" };
+
+    /* On some platforms the environment is shared by all instances, verify
+       the value stays accessible even after the instance that fetched it
+       first is gone */
+    Arguments b;
+    {
+        Arguments a{"a", Arguments::Flag::IgnoreUnknownOptions};
+        a.addOption("size").setFromEnvironment("size", "ARGUMENTSTEST_SIZE");
+        CORRADE_VERIFY(a.tryParse(Containers::arraySize(argv), argv));
+        CORRADE_COMPARE(a.value("size"), "1337");
+    }
+    b.addOption("size").setFromEnvironment("size", "ARGUMENTSTEST_SIZE")
+     .addBooleanOption("verbose").setFromEnvironment("verbose", "ARGUMENTSTEST_VERBOSE")
+     .addOption("nonexistent", "default").setFromEnvironment("nonexistent", "ARGUMENTSTEST_NONEXISTENT");
+    CORRADE_VERIFY(b.tryParse(Containers::arraySize(argv), argv));
+    CORRADE_COMPARE(b.value("size"), "1337");
+    CORRADE_VERIFY(b.isSet("verbose"));
+    CORRADE_COMPARE(b.value("nonexistent"), "default");
+    #endif
+}
+
 void ArgumentsTest::parseFinalOptionalArgument() {
     Arguments args;
     args.addArgument("input")
@@ -660,6 +707,109 @@ void ArgumentsTest::parseFinalOptionalArgumentDefault() {
     CORRADE_VERIFY(args.isSet("debug"));
 }
 
+namespace {
+
+/* Simulating a large CLI with options of several libraries, each having a
+   prefix */
+Arguments manyOptions() {
+    Arguments args;
+    args.addArgument("file");
+    for(std::size_t i = 0; i != 500; ++i)
+        args.addOption("library" + std::to_string(i/50) + "-option" + std::to_string(i), std::to_string(i));
+    args.addBooleanOption('v', "verbose");
+    return args;
+}
+
+const char* ManyOptionsArgv[]{"", "--library3-option150", "hello",
+    "file.dat", "-v", "--library9-option499", "", "--library0-option0", "zero"};
+
+}
+
+void ArgumentsTest::parseManyOptions() {
+    Arguments args = manyOptions();
+
+    CORRADE_VERIFY(args.tryParse(Containers::arraySize(ManyOptionsArgv), ManyOptionsArgv));
+    CORRADE_COMPARE(args.value("file"), "file.dat");
+    CORRADE_VERIFY(args.isSet("verbose"));
+    CORRADE_COMPARE(args.value("library0-option0"), "zero");
+    CORRADE_COMPARE(args.value("library3-option150"), "hello");
+    CORRADE_COMPARE(args.value("library9-option499"), "");
+    /* Default values */
+    CORRADE_COMPARE(args.value("library4-option200"), "200");
+    CORRADE_COMPARE(args.value<int>("library9-option498"), 498);
+}
+
+void ArgumentsTest::parseValueType() {
+    Arguments args;
+    args.addArgument("count").setValueType("count", Arguments::ValueType::UnsignedInteger)
+        .addOption("offset").setValueType("offset", Arguments::ValueType::Integer)
+        .addOption("mask").setValueType("mask", Arguments::ValueType::UnsignedInteger, ConfigurationValueFlag::Hex)
+        .addOption("scale", "0.5").setValueType("scale", Arguments::ValueType::FloatingPoint)
+        .addOption("empty").setValueType("empty", Arguments::ValueType::Integer)
+        .addOption("untyped");
+
+    const char* argv[] = { "", "--offset", "-70000", "--mask", "0xff", "--untyped", "12abc", "+42" };
+
+    CORRADE_VERIFY(args.tryParse(Containers::arraySize(argv), argv));
+    CORRADE_COMPARE(args.value<unsigned int>("count"), 42);
+    CORRADE_COMPARE(args.value<unsigned short>("count"), 42);
+    CORRADE_COMPARE(args.value<long long>("offset"), -70000);
+    CORRADE_COMPARE(args.value<int>("mask"), 255);
+    CORRADE_COMPARE(args.value<float>("scale"), 0.5f);
+    CORRADE_COMPARE(args.value<long double>("scale"), 0.5l);
+    CORRADE_COMPARE(args.value<int>("empty"), 0);
+    /* Strings are still accessible */
+    CORRADE_COMPARE(args.value("mask"), "0xff");
+
+    /* Doesn't fit into the type, parsed again, which results in zero */
+    CORRADE_COMPARE(args.value<short>("offset"), 0);
+
+    /* Untyped values are converted on access, accepting partial matches */
+    CORRADE_COMPARE(args.value<int>("untyped"), 12);
+}
+
+void ArgumentsTest::parseValueTypeInvalid() {
+    Arguments args;
+    args.addOption("offset").setValueType("offset", Arguments::ValueType::Integer)
+        .addOption("count", "many").setValueType("count", Arguments::ValueType::UnsignedInteger)
+        .addOption("scale").setValueType("scale", Arguments::ValueType::FloatingPoint)
+        .addOption("untyped");
+
+    const char* argv[] = { "", "--offset", "12abc", "--scale", "0.5.5", "--untyped", "nope" };
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!args.tryParse(Containers::arraySize(argv), argv));
+    CORRADE_VERIFY(!args.isParsed());
+    CORRADE_COMPARE(out.str(),
+        "Invalid value 12abc for command-line argument --offset\n"
+        "Invalid value many for command-line argument --count\n"
+        "Invalid value 0.5.5 for command-line argument --scale\n");
+}
+
+void ArgumentsTest::parseAddAfterParse() {
+    Arguments args;
+    args.addOption('s', "size");
+
+    const char* argv[] = { "", "-s", "3", "--color", "red", "-c", "blue" };
+
+    {
+        std::ostringstream out;
+        Error redirectError{&out};
+        CORRADE_VERIFY(!args.tryParse(Containers::arraySize(argv), argv));
+        CORRADE_COMPARE(out.str(), "Unknown command-line argument --color\n");
+    }
+
+    /* The lookup done during parsing shouldn't get stale after adding more
+       options */
+    args.addOption("color")
+        .addOption('c', "another-color");
+    CORRADE_VERIFY(args.tryParse(Containers::arraySize(argv), argv));
+    CORRADE_COMPARE(args.value("size"), "3");
+    CORRADE_COMPARE(args.value("color"), "red");
+    CORRADE_COMPARE(args.value("another-color"), "blue");
+}
+
 void ArgumentsTest::parseUnknownArgument() {
     Arguments args;
 
@@ -1078,6 +1228,50 @@ void ArgumentsTest::valueMismatchedBoolean() {
         "Utility::Arguments::isSet(): cannot use this function for non-boolean value value\n");
 }
 
+void ArgumentsTest::setValueTypeInvalid() {
+    Arguments args;
+    args.addBooleanOption("boolean");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    args.setValueType("nonexistent", Arguments::ValueType::Integer)
+        .setValueType("boolean", Arguments::ValueType::Integer);
+    CORRADE_COMPARE(out.str(),
+        "Utility::Arguments::setValueType(): key nonexistent doesn't exist\n"
+        "Utility::Arguments::setValueType(): can't set value type of boolean option boolean\n");
+}
+
+void ArgumentsTest::benchmarkParseManyOptions() {
+    Arguments args = manyOptions();
+
+    std::size_t parsed = 0;
+    CORRADE_BENCHMARK(10)
+        parsed += args.tryParse(Containers::arraySize(ManyOptionsArgv), ManyOptionsArgv);
+
+    CORRADE_COMPARE(parsed, 10);
+    CORRADE_COMPARE(args.value("library3-option150"), "hello");
+}
+
+void ArgumentsTest::benchmarkParseManyEnvironmentOptions() {
+    /* Each option can be taken from the environment, but none of them is
+       actually set */
+    Arguments args;
+    args.addArgument("file");
+    for(std::size_t i = 0; i != 500; ++i) {
+        const std::string key = "library" + std::to_string(i/50) + "-option" + std::to_string(i);
+        args.addOption(key, std::to_string(i)).setFromEnvironment(key);
+    }
+
+    const char* argv[]{"", "file.dat"};
+
+    std::size_t parsed = 0;
+    CORRADE_BENCHMARK(10)
+        parsed += args.tryParse(Containers::arraySize(argv), argv);
+
+    CORRADE_COMPARE(parsed, 10);
+    CORRADE_COMPARE(args.value("library3-option150"), "150");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Corrade::Utility::Test::ArgumentsTest)
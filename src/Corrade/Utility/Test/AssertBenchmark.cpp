@@ -0,0 +1,175 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Corrade/Containers/ArrayView.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/Utility/Assert.h"
+
+namespace Corrade { namespace Utility { namespace Test { namespace {
+
+struct AssertBenchmark: TestSuite::Tester {
+    explicit AssertBenchmark();
+
+    void setup();
+
+    void baseline();
+    void outlined();
+    void inlined();
+    void internalOutlined();
+    void internalInlined();
+
+    std::size_t _data[1000];
+};
+
+AssertBenchmark::AssertBenchmark() {
+    addBenchmarks({&AssertBenchmark::baseline,
+                   &AssertBenchmark::outlined,
+                   &AssertBenchmark::inlined,
+                   &AssertBenchmark::internalOutlined,
+                   &AssertBenchmark::internalInlined}, 100,
+        &AssertBenchmark::setup,
+        &AssertBenchmark::setup);
+}
+
+void AssertBenchmark::setup() {
+    for(std::size_t i = 0; i != Containers::arraySize(_data); ++i)
+        _data[i] = i;
+}
+
+/* What the assertion macros expanded to before the failure path got
+   outlined, for comparison */
+#define INLINED_ASSERT(condition, message, returnValue)                     \
+    do {                                                                    \
+        if(CORRADE_UNLIKELY(!(condition))) {                                \
+            Error{Error::defaultOutput()} << message;                       \
+            std::abort();                                                   \
+            return returnValue;                                             \
+        }                                                                   \
+    } while(false)
+#define INLINED_INTERNAL_ASSERT(condition)                                  \
+    do {                                                                    \
+        if(CORRADE_UNLIKELY(!(condition))) {                                \
+            Error{Error::defaultOutput()} << "Assertion " #condition " failed in " __FILE__ " on line" << __LINE__; \
+            std::abort();                                                   \
+        }                                                                   \
+    } while(false)
+
+/* Each function does a few checks with a formatted message on every element
+   to make the difference in the generated code visible */
+CORRADE_NEVER_INLINE std::size_t sumBaseline(Containers::ArrayView<const std::size_t> data, std::size_t) {
+    std::size_t sum = 0;
+    for(std::size_t i = 0; i != data.size(); ++i) {
+        sum += data[i];
+    }
+    return sum;
+}
+
+CORRADE_NEVER_INLINE std::size_t sumOutlined(Containers::ArrayView<const std::size_t> data, std::size_t limit) {
+    std::size_t sum = 0;
+    for(std::size_t i = 0; i != data.size(); ++i) {
+        CORRADE_ASSERT(data[i] < limit,
+            "sum(): value" << data[i] << "at index" << i << "out of range for" << limit, {});
+        CORRADE_ASSERT(sum <= ~data[i],
+            "sum(): overflow at index" << i << Debug::nospace << ", sum was" << sum, {});
+        sum += data[i];
+    }
+    return sum;
+}
+
+CORRADE_NEVER_INLINE std::size_t sumInlined(Containers::ArrayView<const std::size_t> data, std::size_t limit) {
+    std::size_t sum = 0;
+    for(std::size_t i = 0; i != data.size(); ++i) {
+        INLINED_ASSERT(data[i] < limit,
+            "sum(): value" << data[i] << "at index" << i << "out of range for" << limit, {});
+        INLINED_ASSERT(sum <= ~data[i],
+            "sum(): overflow at index" << i << Debug::nospace << ", sum was" << sum, {});
+        sum += data[i];
+    }
+    return sum;
+}
+
+CORRADE_NEVER_INLINE std::size_t sumInternalOutlined(Containers::ArrayView<const std::size_t> data, std::size_t limit) {
+    std::size_t sum = 0;
+    for(std::size_t i = 0; i != data.size(); ++i) {
+        CORRADE_INTERNAL_ASSERT(data[i] < limit);
+        CORRADE_INTERNAL_ASSERT(sum <= ~data[i]);
+        sum += data[i];
+    }
+    return sum;
+}
+
+CORRADE_NEVER_INLINE std::size_t sumInternalInlined(Containers::ArrayView<const std::size_t> data, std::size_t limit) {
+    std::size_t sum = 0;
+    for(std::size_t i = 0; i != data.size(); ++i) {
+        INLINED_INTERNAL_ASSERT(data[i] < limit);
+        INLINED_INTERNAL_ASSERT(sum <= ~data[i]);
+        sum += data[i];
+    }
+    return sum;
+}
+
+void AssertBenchmark::baseline() {
+    std::size_t sum = 0;
+    CORRADE_BENCHMARK(100)
+        sum += sumBaseline(_data, 1000);
+
+    CORRADE_COMPARE(sum, 100*499500);
+}
+
+void AssertBenchmark::outlined() {
+    std::size_t sum = 0;
+    CORRADE_BENCHMARK(100)
+        sum += sumOutlined(_data, 1000);
+
+    CORRADE_COMPARE(sum, 100*499500);
+}
+
+void AssertBenchmark::inlined() {
+    std::size_t sum = 0;
+    CORRADE_BENCHMARK(100)
+        sum += sumInlined(_data, 1000);
+
+    CORRADE_COMPARE(sum, 100*499500);
+}
+
+void AssertBenchmark::internalOutlined() {
+    std::size_t sum = 0;
+    CORRADE_BENCHMARK(100)
+        sum += sumInternalOutlined(_data, 1000);
+
+    CORRADE_COMPARE(sum, 100*499500);
+}
+
+void AssertBenchmark::internalInlined() {
+    std::size_t sum = 0;
+    CORRADE_BENCHMARK(100)
+        sum += sumInternalInlined(_data, 1000);
+
+    CORRADE_COMPARE(sum, 100*499500);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Utility::Test::AssertBenchmark)
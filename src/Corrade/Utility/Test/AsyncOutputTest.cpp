@@ -0,0 +1,301 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+    Copyright © 2019 Jonathan Hale <squareys@googlemail.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <atomic>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Numeric.h"
+#include "Corrade/Utility/AsyncOutput.h"
+#include "Corrade/Utility/DebugStl.h"
+#include "Corrade/Utility/Format.h"
+#include "Corrade/Utility/String.h"
+
+namespace Corrade { namespace Utility { namespace Test { namespace {
+
+struct AsyncOutputTest: TestSuite::Tester {
+    explicit AsyncOutputTest();
+
+    void construct();
+    void constructZeroCapacity();
+
+    void debugOverflow();
+
+    void debug();
+    void longMessage();
+    void noNewlineAtTheEnd();
+    void flush();
+    void multithreaded();
+    void overflowBlock();
+    void overflowDrop();
+
+    void benchmarkDirect();
+    void benchmarkAsync();
+};
+
+AsyncOutputTest::AsyncOutputTest() {
+    addTests({&AsyncOutputTest::construct,
+              &AsyncOutputTest::constructZeroCapacity,
+
+              &AsyncOutputTest::debugOverflow,
+
+              &AsyncOutputTest::debug,
+              &AsyncOutputTest::longMessage,
+              &AsyncOutputTest::noNewlineAtTheEnd,
+              &AsyncOutputTest::flush,
+              &AsyncOutputTest::multithreaded,
+              &AsyncOutputTest::overflowBlock,
+              &AsyncOutputTest::overflowDrop});
+
+    addBenchmarks({&AsyncOutputTest::benchmarkDirect,
+                   &AsyncOutputTest::benchmarkAsync}, 10);
+}
+
+void AsyncOutputTest::construct() {
+    std::ostringstream out;
+    {
+        AsyncOutput output{out, 100, AsyncOutput::Overflow::Drop};
+        CORRADE_COMPARE(output.capacity(), 128);
+        CORRADE_COMPARE(output.overflow(), AsyncOutput::Overflow::Drop);
+        CORRADE_COMPARE(output.droppedCount(), 0);
+    }
+    {
+        AsyncOutput output{out};
+        CORRADE_COMPARE(output.capacity(), 1024);
+        CORRADE_COMPARE(output.overflow(), AsyncOutput::Overflow::Block);
+    }
+    {
+        AsyncOutput output{out, 1};
+        CORRADE_COMPARE(output.capacity(), 1);
+    }
+
+    CORRADE_COMPARE(out.str(), "");
+}
+
+void AsyncOutputTest::constructZeroCapacity() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    AsyncOutput output{out, 0};
+    CORRADE_COMPARE(out.str(), "Utility::AsyncOutput: capacity expected to be non-zero\n");
+}
+
+void AsyncOutputTest::debugOverflow() {
+    std::ostringstream out;
+    Debug{&out} << AsyncOutput::Overflow::Drop << AsyncOutput::Overflow(0xde);
+    CORRADE_COMPARE(out.str(), "Utility::AsyncOutput::Overflow::Drop Utility::AsyncOutput::Overflow(0xde)\n");
+}
+
+void AsyncOutputTest::debug() {
+    std::ostringstream out;
+    {
+        AsyncOutput output{out, 2};
+        AsyncOutputStream stream{output};
+        Debug redirectOutput{&stream};
+        Warning redirectWarning{&stream};
+        Debug{} << "Hello" << 42;
+        Warning{} << "this is a warning";
+        Debug{} << "and" << 3.5f;
+    }
+
+    CORRADE_COMPARE(out.str(),
+        "Hello 42\n"
+        "this is a warning\n"
+        "and 3.5\n");
+}
+
+void AsyncOutputTest::longMessage() {
+    /* Longer than the initial stream buffer size, should get enlarged */
+    const std::string message(1000, 'a');
+
+    std::ostringstream out;
+    {
+        AsyncOutput output{out};
+        AsyncOutputStream stream{output};
+        Debug{&stream} << message;
+        Debug{&stream} << "short";
+        Debug{&stream} << message;
+    }
+
+    CORRADE_COMPARE(out.str(), message + "\nshort\n" + message + "\n");
+}
+
+void AsyncOutputTest::noNewlineAtTheEnd() {
+    std::ostringstream out;
+    {
+        AsyncOutput output{out};
+        {
+            AsyncOutputStream stream{output};
+            Debug{&stream, Debug::Flag::NoNewlineAtTheEnd} << "Loading...";
+            Debug{&stream} << " done";
+            /* Not flushed, gets passed on stream destruction */
+            Debug{&stream, Debug::Flag::NoNewlineAtTheEnd} << "Exiting";
+        }
+        output.flush();
+        CORRADE_COMPARE(out.str(), "Loading... done\nExiting");
+    }
+}
+
+void AsyncOutputTest::flush() {
+    std::ostringstream out;
+    AsyncOutput output{out};
+    AsyncOutputStream stream{output};
+    for(std::size_t i = 0; i != 100; ++i)
+        Debug{&stream} << i;
+
+    /* After the flush all the messages should be written */
+    output.flush();
+    const std::string result = out.str();
+    CORRADE_COMPARE(String::split(result, '\n').size(), 101);
+    CORRADE_VERIFY(String::beginsWith(result, "0\n1\n2\n"));
+    CORRADE_VERIFY(String::endsWith(result, "98\n99\n"));
+}
+
+void AsyncOutputTest::multithreaded() {
+    std::ostringstream out;
+    {
+        /* Small capacity to exercise the blocking as well */
+        AsyncOutput output{out, 8};
+
+        std::vector<std::thread> threads;
+        for(std::size_t i = 0; i != 4; ++i) threads.emplace_back([&output, i]{
+            AsyncOutputStream stream{output};
+            Debug redirectOutput{&stream};
+            for(std::size_t j = 0; j != 1000; ++j)
+                Debug{} << i << j;
+        });
+        for(std::thread& thread: threads) thread.join();
+    }
+
+    /* All messages should be there, unbroken, and in order for each
+       thread */
+    std::size_t expected[4]{};
+    std::size_t count = 0;
+    for(const std::string& line: String::splitWithoutEmptyParts(out.str(), '\n')) {
+        const std::vector<std::string> parts = String::split(line, ' ');
+        CORRADE_COMPARE(parts.size(), 2);
+        const std::size_t thread = std::stoul(parts[0]);
+        CORRADE_VERIFY(thread < 4);
+        CORRADE_COMPARE(std::stoul(parts[1]), expected[thread]);
+        ++expected[thread];
+        ++count;
+    }
+    CORRADE_COMPARE(count, 4000);
+}
+
+/* A stream buffer that blocks on first write until released */
+struct BlockingStreamBuffer: std::stringbuf {
+    std::streamsize xsputn(const char* data, std::streamsize size) override {
+        entered = true;
+        while(!released) std::this_thread::yield();
+        return std::stringbuf::xsputn(data, size);
+    }
+
+    std::atomic<bool> entered{}, released{};
+};
+
+void AsyncOutputTest::overflowBlock() {
+    BlockingStreamBuffer buffer;
+    std::ostream out{&buffer};
+    {
+        AsyncOutput output{out, 2};
+
+        std::thread producer{[&output]{
+            AsyncOutputStream stream{output};
+            for(std::size_t i = 0; i != 10; ++i)
+                Debug{&stream} << i;
+        }};
+
+        /* The consumer takes at most two messages before blocking on the
+           write and then the queue can hold two more, so the producer is
+           blocked now as well. Release it and wait until it's done. */
+        while(!buffer.entered) std::this_thread::yield();
+        buffer.released = true;
+        producer.join();
+
+        CORRADE_COMPARE(output.droppedCount(), 0);
+    }
+
+    CORRADE_COMPARE(buffer.str(), "0\n1\n2\n3\n4\n5\n6\n7\n8\n9\n");
+}
+
+void AsyncOutputTest::overflowDrop() {
+    BlockingStreamBuffer buffer;
+    std::ostream out{&buffer};
+    std::size_t dropped;
+    {
+        AsyncOutput output{out, 2, AsyncOutput::Overflow::Drop};
+        AsyncOutputStream stream{output};
+
+        /* Wait until the consumer blocks on the first message */
+        Debug{&stream} << 0;
+        while(!buffer.entered) std::this_thread::yield();
+
+        /* It took at most two messages before blocking and the queue can
+           hold two more, so with ten messages at least six get dropped */
+        for(std::size_t i = 1; i != 10; ++i)
+            Debug{&stream} << i;
+        dropped = output.droppedCount();
+        CORRADE_COMPARE_AS(dropped, 6,
+            TestSuite::Compare::GreaterOrEqual);
+
+        buffer.released = true;
+    }
+
+    /* The first message is always there, all that weren't dropped as well */
+    const std::string result = buffer.str();
+    CORRADE_VERIFY(String::beginsWith(result, "0\n"));
+    CORRADE_COMPARE(String::splitWithoutEmptyParts(result, '\n').size() + dropped, 10);
+}
+
+void AsyncOutputTest::benchmarkDirect() {
+    std::ostringstream out;
+    CORRADE_BENCHMARK(1000)
+        Debug{&out} << "Hello" << 42 << "and" << 3.5f;
+
+    CORRADE_VERIFY(!out.str().empty());
+}
+
+void AsyncOutputTest::benchmarkAsync() {
+    std::ostringstream out;
+    {
+        AsyncOutput output{out};
+        AsyncOutputStream stream{output};
+        CORRADE_BENCHMARK(1000)
+            Debug{&stream} << "Hello" << 42 << "and" << 3.5f;
+    }
+
+    CORRADE_VERIFY(!out.str().empty());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Utility::Test::AsyncOutputTest)
@@ -0,0 +1,401 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+#include "Corrade/Containers/Optional.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Numeric.h"
+#include "Corrade/Utility/Algorithms.h"
+#include "Corrade/Utility/BinaryLog.h"
+#include "Corrade/Utility/DebugStl.h"
+#include "Corrade/Utility/FormatStl.h"
+
+namespace Corrade { namespace Utility { namespace Test { namespace {
+
+struct BinaryLogTest: TestSuite::Tester {
+    explicit BinaryLogTest();
+
+    void construct();
+    void constructMemory();
+    void constructTooSmall();
+    void constructMemoryUnaligned();
+    void constructMove();
+
+    void types();
+    void formatting();
+    void empty();
+    void clear();
+
+    void wrapAround();
+    void definitionReemitted();
+    void tooLarge();
+
+    void decodeInvalidHeader();
+    void decodeInvalidState();
+    void decodeInvalidRecord();
+    void decodeInvalidArgument();
+
+    void benchmarkRecord();
+    void benchmarkDebug();
+};
+
+BinaryLogTest::BinaryLogTest() {
+    addTests({&BinaryLogTest::construct,
+              &BinaryLogTest::constructMemory,
+              &BinaryLogTest::constructTooSmall,
+              &BinaryLogTest::constructMemoryUnaligned,
+              &BinaryLogTest::constructMove,
+
+              &BinaryLogTest::types,
+              &BinaryLogTest::formatting,
+              &BinaryLogTest::empty,
+              &BinaryLogTest::clear,
+
+              &BinaryLogTest::wrapAround,
+              &BinaryLogTest::definitionReemitted,
+              &BinaryLogTest::tooLarge,
+
+              &BinaryLogTest::decodeInvalidHeader,
+              &BinaryLogTest::decodeInvalidState,
+              &BinaryLogTest::decodeInvalidRecord,
+              &BinaryLogTest::decodeInvalidArgument});
+
+    addBenchmarks({&BinaryLogTest::benchmarkRecord,
+                   &BinaryLogTest::benchmarkDebug}, 10);
+}
+
+/* The log state takes 32 bytes at the front */
+constexpr std::size_t HeaderSize = 32;
+
+void BinaryLogTest::construct() {
+    BinaryLog log{1024};
+    CORRADE_COMPARE(log.data().size(), 1024);
+    CORRADE_COMPARE(log.droppedCount(), 0);
+
+    Containers::Optional<std::string> out = BinaryLog::decode(log.data());
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(*out, "");
+}
+
+void BinaryLogTest::constructMemory() {
+    Containers::Array<char> memory{Containers::ValueInit, 1024};
+    {
+        BinaryLog log{memory};
+        CORRADE_COMPARE(log.data().data(), memory.data());
+        CORRADE_COMPARE(log.data().size(), 1024);
+
+        CORRADE_BINARY_LOG(log, "hello {}", 42);
+    }
+
+    /* The data stay decodable after the log is gone */
+    Containers::Optional<std::string> out = BinaryLog::decode(memory);
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(*out, "hello 42\n");
+}
+
+void BinaryLogTest::constructTooSmall() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Containers::Array<char> memory{Containers::ValueInit, 95};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    BinaryLog{95};
+    BinaryLog{memory};
+    CORRADE_COMPARE(out.str(),
+        "Utility::BinaryLog: expected at least 96 bytes but got 95\n"
+        "Utility::BinaryLog: expected at least 96 bytes but got 95\n");
+}
+
+void BinaryLogTest::constructMemoryUnaligned() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Containers::Array<char> memory{Containers::ValueInit, 1024};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    BinaryLog{memory.suffix(4)};
+    CORRADE_COMPARE(out.str(),
+        "Utility::BinaryLog: expected the memory to be aligned to 8 bytes\n");
+}
+
+void BinaryLogTest::constructMove() {
+    BinaryLog a{1024};
+    CORRADE_BINARY_LOG(a, "hello {}", 42);
+
+    BinaryLog b = std::move(a);
+    CORRADE_BINARY_LOG(b, "and {}", 1337);
+
+    BinaryLog c{96};
+    c = std::move(b);
+    CORRADE_BINARY_LOG(c, "bye");
+
+    Containers::Optional<std::string> out = BinaryLog::decode(c.data());
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(*out, "hello 42\nand 1337\nbye\n");
+}
+
+enum class Enum: std::uint16_t { Value = 3456 };
+
+void BinaryLogTest::types() {
+    BinaryLog log{4096};
+    const char* string = "a string";
+    CORRADE_BINARY_LOG(log, "{} {}", true, false);
+    CORRADE_BINARY_LOG(log, "{} {} {} {}", std::int8_t(-100), std::uint8_t(200), std::int16_t(-30000), std::uint16_t(60000));
+    CORRADE_BINARY_LOG(log, "{} {} {} {}", -2000000000, 4000000000u, -9000000000000000000ll, 18000000000000000000ull);
+    CORRADE_BINARY_LOG(log, "{} {} {}", 'a', 3.5f, -1.0/3.0);
+    CORRADE_BINARY_LOG(log, "{} {} {}", "literal", string, Containers::StringView{"view and more", 4});
+    CORRADE_BINARY_LOG(log, "{}", Enum::Value);
+
+    Containers::Optional<std::string> out = BinaryLog::decode(log.data());
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(*out,
+        "true false\n"
+        "-100 200 -30000 60000\n"
+        "-2000000000 4000000000 -9000000000000000000 18000000000000000000\n"
+        "97 3.5 -0.333333333333333\n"
+        "literal a string view\n"
+        "3456\n");
+}
+
+void BinaryLogTest::formatting() {
+    BinaryLog log{4096};
+    CORRADE_BINARY_LOG(log, "{1} {0} {{}} {2:x} {3:.2f} {3}", 1, 2, 254, 3.14159f);
+    CORRADE_BINARY_LOG(log, "no arguments");
+    CORRADE_BINARY_LOG(log, "missing {} {}", 1);
+
+    Containers::Optional<std::string> out = BinaryLog::decode(log.data());
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(*out,
+        "2 1 {} fe 3.14 3.14159\n"
+        "no arguments\n"
+        "missing 1 {}\n");
+}
+
+void BinaryLogTest::empty() {
+    BinaryLog log{96};
+
+    Containers::Optional<std::string> out = BinaryLog::decode(log.data());
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(*out, "");
+}
+
+void BinaryLogTest::clear() {
+    BinaryLog log{1024};
+    CORRADE_BINARY_LOG(log, "hello {}", 42);
+    log.clear();
+
+    Containers::Optional<std::string> out = BinaryLog::decode(log.data());
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(*out, "");
+
+    /* The format string is recorded again after a clear */
+    CORRADE_BINARY_LOG(log, "world {}", 1337);
+    out = BinaryLog::decode(log.data());
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(*out, "world 1337\n");
+}
+
+void BinaryLogTest::wrapAround() {
+    BinaryLog log{HeaderSize + 512};
+
+    /* Messages of varying sizes to exercise the padding at the end of the
+       ring. After each message the log should contain a contiguous sequence
+       of the most recent messages. */
+    std::vector<std::string> messages;
+    for(int i = 0; i != 500; ++i) {
+        const std::string string(i % 37, 'x');
+        CORRADE_BINARY_LOG(log, "{} {}", i, string.data());
+        messages.push_back(formatString("{} {}\n", i, string));
+        if(i % 3 == 0) {
+            CORRADE_BINARY_LOG(log, "third {}", i);
+            messages.push_back(formatString("third {}\n", i));
+        }
+
+        Containers::Optional<std::string> out = BinaryLog::decode(log.data());
+        CORRADE_VERIFY(out);
+
+        const std::size_t count = std::count(out->begin(), out->end(), '\n');
+        std::string expected;
+        for(std::size_t j = messages.size() - count; j != messages.size(); ++j)
+            expected += messages[j];
+
+        CORRADE_COMPARE(*out, expected);
+        /* At least a few messages should always be there */
+        CORRADE_COMPARE_AS(count, std::min(messages.size(), std::size_t{4}), TestSuite::Compare::GreaterOrEqual);
+    }
+
+    CORRADE_COMPARE(log.droppedCount(), 0);
+}
+
+void BinaryLogTest::definitionReemitted() {
+    /* 256 bytes of the ring are 16 records of 16 bytes each -- definitions of
+       the four-character format strings as well as messages with a single
+       32-bit argument */
+    BinaryLog log{HeaderSize + 256};
+
+    /* The first record is the definition of "a {}", then two messages */
+    for(int i = 0; i != 2; ++i)
+        CORRADE_BINARY_LOG(log, "a {}", i);
+    /* Then a definition of "b {}" and 12 messages filling the ring */
+    auto b = [&](int i) { CORRADE_BINARY_LOG(log, "b {}", i); };
+    for(int i = 2; i != 14; ++i) b(i);
+
+    Containers::Optional<std::string> out = BinaryLog::decode(log.data());
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(*out, "a 0\na 1\nb 2\nb 3\nb 4\nb 5\nb 6\nb 7\nb 8\nb 9\nb 10\nb 11\nb 12\nb 13\n");
+
+    /* Next message overwrites the definition of "a {}", which gets recorded
+       again, overwriting the first message. The second message is still
+       decodable. */
+    b(14);
+    out = BinaryLog::decode(log.data());
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(*out, "a 1\nb 2\nb 3\nb 4\nb 5\nb 6\nb 7\nb 8\nb 9\nb 10\nb 11\nb 12\nb 13\nb 14\n");
+
+    /* Now the second message is gone as well. The "a {}" definition stays
+       until it gets overwritten again, at which point it's not recorded
+       anymore, while the "b {}" definition is recorded again every time it
+       gets overwritten, so there's always space for 15 messages. */
+    for(int i = 15; i != 40; ++i) b(i);
+    out = BinaryLog::decode(log.data());
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(*out, "b 25\nb 26\nb 27\nb 28\nb 29\nb 30\nb 31\nb 32\nb 33\nb 34\nb 35\nb 36\nb 37\nb 38\nb 39\n");
+}
+
+void BinaryLogTest::tooLarge() {
+    BinaryLog log{HeaderSize + 256};
+    CORRADE_BINARY_LOG(log, "before");
+    CORRADE_BINARY_LOG(log, "{}", std::string(250, 'x').data());
+    CORRADE_BINARY_LOG(log, "after");
+    CORRADE_COMPARE(log.droppedCount(), 1);
+
+    Containers::Optional<std::string> out = BinaryLog::decode(log.data());
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(*out, "before\nafter\n");
+}
+
+void BinaryLogTest::decodeInvalidHeader() {
+    Containers::Array<char> memory{Containers::ValueInit, 128};
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!BinaryLog::decode(memory.prefix(16)));
+    CORRADE_VERIFY(!BinaryLog::decode(memory));
+    CORRADE_COMPARE(out.str(),
+        "Utility::BinaryLog::decode(): invalid log header\n"
+        "Utility::BinaryLog::decode(): invalid log header\n");
+}
+
+void BinaryLogTest::decodeInvalidState() {
+    BinaryLog log{1024};
+    CORRADE_BINARY_LOG(log, "hello {}", 42);
+    Containers::Array<char> data{Containers::NoInit, log.data().size()};
+    Utility::copy(log.data(), data);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    /* Truncated data */
+    CORRADE_VERIFY(!BinaryLog::decode(data.prefix(512)));
+
+    /* Tail before head */
+    std::uint64_t head = 64;
+    std::memcpy(data + 8, &head, 8);
+    CORRADE_VERIFY(!BinaryLog::decode(data));
+
+    CORRADE_COMPARE(out.str(),
+        "Utility::BinaryLog::decode(): invalid log state\n"
+        "Utility::BinaryLog::decode(): invalid log state\n");
+}
+
+void BinaryLogTest::decodeInvalidRecord() {
+    BinaryLog log{1024};
+    CORRADE_BINARY_LOG(log, "hello {}", 42);
+    Containers::Array<char> data{Containers::NoInit, log.data().size()};
+    Utility::copy(log.data(), data);
+
+    /* Make the definition record larger than the data */
+    std::uint32_t size = 100;
+    std::memcpy(data + HeaderSize, &size, 4);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!BinaryLog::decode(data));
+    CORRADE_COMPARE(out.str(), "Utility::BinaryLog::decode(): invalid record at offset 0\n");
+}
+
+void BinaryLogTest::decodeInvalidArgument() {
+    BinaryLog log{1024};
+    CORRADE_BINARY_LOG(log, "hello");
+    CORRADE_BINARY_LOG(log, "{}", 42);
+    Containers::Array<char> data{Containers::NoInit, log.data().size()};
+    Utility::copy(log.data(), data);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    /* Definition and message of the first at 0 and 16, definition of the
+       second at 24, message at 40. Change the type tag to an invalid one. */
+    data[HeaderSize + 40 + 8] = '\x7f';
+    CORRADE_VERIFY(!BinaryLog::decode(data));
+
+    /* Change it to a string, which is then too long */
+    data[HeaderSize + 40 + 8] = '\x0c';
+    CORRADE_VERIFY(!BinaryLog::decode(data));
+
+    CORRADE_COMPARE(out.str(),
+        "Utility::BinaryLog::decode(): invalid argument in a record at offset 40\n"
+        "Utility::BinaryLog::decode(): invalid argument in a record at offset 40\n");
+}
+
+void BinaryLogTest::benchmarkRecord() {
+    BinaryLog log{1024*1024};
+    CORRADE_BENCHMARK(1000)
+        CORRADE_BINARY_LOG(log, "Value {} is {} and {}", 1337, 3.1415f, 0.5);
+
+    Containers::Optional<std::string> out = BinaryLog::decode(log.data());
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(out->size(), 1000*std::strlen("Value 1337 is 3.1415 and 0.5\n"));
+}
+
+void BinaryLogTest::benchmarkDebug() {
+    std::ostringstream out;
+    CORRADE_BENCHMARK(1000)
+        Debug{&out} << "Value" << 1337 << "is" << 3.1415f << "and" << 0.5;
+
+    CORRADE_COMPARE(out.str().size(), 1000*std::strlen("Value 1337 is 3.1415 and 0.5\n"));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Utility::Test::BinaryLogTest)
@@ -0,0 +1,283 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Container.h"
+#include "Corrade/Utility/BinaryReader.h"
+#include "Corrade/Utility/DebugStl.h"
+
+namespace Corrade { namespace Utility { namespace Test { namespace {
+
+struct BinaryReaderTest: TestSuite::Tester {
+    explicit BinaryReaderTest();
+
+    void construct();
+    void constructEmpty();
+
+    void read();
+    void readLittleEndian();
+    void readBigEndian();
+    void readBytes();
+    void readArray();
+    void readArrayUnaligned();
+    void readArrayTooLarge();
+    void readLittleEndianInto();
+    void readBigEndianInto();
+    void readEmpty();
+
+    void seek();
+    void skip();
+
+    void outOfBounds();
+};
+
+BinaryReaderTest::BinaryReaderTest() {
+    addTests({&BinaryReaderTest::construct,
+              &BinaryReaderTest::constructEmpty,
+
+              &BinaryReaderTest::read,
+              &BinaryReaderTest::readLittleEndian,
+              &BinaryReaderTest::readBigEndian,
+              &BinaryReaderTest::readBytes,
+              &BinaryReaderTest::readArray,
+              &BinaryReaderTest::readArrayUnaligned,
+              &BinaryReaderTest::readArrayTooLarge,
+              &BinaryReaderTest::readLittleEndianInto,
+              &BinaryReaderTest::readBigEndianInto,
+              &BinaryReaderTest::readEmpty,
+
+              &BinaryReaderTest::seek,
+              &BinaryReaderTest::skip,
+
+              &BinaryReaderTest::outOfBounds});
+}
+
+alignas(8) constexpr const char Data[]{
+    '\x01', '\x02', '\x03', '\x04', '\x05', '\x06', '\x07', '\x08',
+    '\x09', '\x0a', '\x0b', '\x0c', '\x0d', '\x0e', '\x0f', '\x10'
+};
+
+void BinaryReaderTest::construct() {
+    BinaryReader reader{Data};
+    CORRADE_COMPARE(reader.data().data(), Data);
+    CORRADE_COMPARE(reader.data().size(), 16);
+    CORRADE_COMPARE(reader.position(), 0);
+    CORRADE_COMPARE(reader.remaining(), 16);
+    CORRADE_VERIFY(!reader.atEnd());
+}
+
+void BinaryReaderTest::constructEmpty() {
+    BinaryReader reader{nullptr};
+    CORRADE_COMPARE(reader.data().data(), nullptr);
+    CORRADE_COMPARE(reader.position(), 0);
+    CORRADE_COMPARE(reader.remaining(), 0);
+    CORRADE_VERIFY(reader.atEnd());
+}
+
+void BinaryReaderTest::read() {
+    BinaryReader reader{Data};
+    Containers::Optional<std::uint8_t> a = reader.read<std::uint8_t>();
+    CORRADE_VERIFY(a);
+    CORRADE_COMPARE(*a, 0x01);
+
+    /* Not aligned, which shouldn't matter */
+    Containers::Optional<std::uint32_t> b = reader.read<std::uint32_t>();
+    CORRADE_VERIFY(b);
+    CORRADE_COMPARE(*b, Endianness::littleEndian(0x05040302u));
+    CORRADE_COMPARE(reader.position(), 5);
+    CORRADE_COMPARE(reader.remaining(), 11);
+}
+
+void BinaryReaderTest::readLittleEndian() {
+    BinaryReader reader{Data};
+    CORRADE_COMPARE(*reader.readLittleEndian<std::uint16_t>(), 0x0201);
+    CORRADE_COMPARE(*reader.readLittleEndian<std::uint32_t>(), 0x06050403u);
+    CORRADE_COMPARE(*reader.readLittleEndian<std::uint64_t>(), 0x0e0d0c0b0a090807ull);
+    CORRADE_COMPARE(reader.position(), 14);
+}
+
+void BinaryReaderTest::readBigEndian() {
+    BinaryReader reader{Data};
+    CORRADE_COMPARE(*reader.readBigEndian<std::uint16_t>(), 0x0102);
+    CORRADE_COMPARE(*reader.readBigEndian<std::uint32_t>(), 0x03040506u);
+    CORRADE_COMPARE(*reader.readBigEndian<std::uint64_t>(), 0x0708090a0b0c0d0eull);
+
+    /* Floats go through the same path */
+    const char floatData[]{'\x40', '\x49', '\x0f', '\xdb'};
+    BinaryReader floatReader{floatData};
+    CORRADE_COMPARE(*floatReader.readBigEndian<float>(), 3.14159274f);
+}
+
+void BinaryReaderTest::readBytes() {
+    BinaryReader reader{Data};
+    CORRADE_VERIFY(reader.skip(3));
+
+    /* The view points directly to the data */
+    Containers::Optional<Containers::ArrayView<const char>> bytes = reader.readBytes(5);
+    CORRADE_VERIFY(bytes);
+    CORRADE_COMPARE(bytes->data(), Data + 3);
+    CORRADE_COMPARE(bytes->size(), 5);
+    CORRADE_COMPARE(reader.position(), 8);
+}
+
+void BinaryReaderTest::readArray() {
+    BinaryReader reader{Data};
+    CORRADE_VERIFY(reader.skip(4));
+
+    Containers::Optional<Containers::ArrayView<const std::uint16_t>> values = reader.readArray<std::uint16_t>(3);
+    CORRADE_VERIFY(values);
+    CORRADE_COMPARE(static_cast<const void*>(values->data()), Data + 4);
+    CORRADE_COMPARE(values->size(), 3);
+    CORRADE_COMPARE(reader.position(), 10);
+
+    /* Zero-size array is fine */
+    Containers::Optional<Containers::ArrayView<const std::uint16_t>> empty = reader.readArray<std::uint16_t>(0);
+    CORRADE_VERIFY(empty);
+    CORRADE_COMPARE(empty->size(), 0);
+    CORRADE_COMPARE(reader.position(), 10);
+}
+
+void BinaryReaderTest::readArrayUnaligned() {
+    BinaryReader reader{Data};
+    CORRADE_VERIFY(reader.skip(2));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!reader.readArray<std::uint32_t>(2));
+    CORRADE_COMPARE(reader.position(), 2);
+    CORRADE_COMPARE(out.str(), "Utility::BinaryReader::readArray(): data at position 2 not aligned to 4 bytes\n");
+}
+
+void BinaryReaderTest::readArrayTooLarge() {
+    BinaryReader reader{Data};
+    CORRADE_VERIFY(reader.skip(4));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    /* Count that would overflow when multiplied by the type size, wrapping
+       around to 4 bytes and making it look like it fits */
+    const std::size_t overflowing = ~std::size_t{}/4 + 2;
+    CORRADE_VERIFY(!reader.readArray<std::uint32_t>(overflowing));
+    CORRADE_COMPARE(reader.position(), 4);
+    std::ostringstream expected;
+    Debug{&expected, Debug::Flag::NoNewlineAtTheEnd} << "Utility::BinaryReader::readArray(): expected" << overflowing << "items of 4 bytes at position 4 but got only 12 bytes\n";
+    CORRADE_COMPARE(out.str(), expected.str());
+}
+
+void BinaryReaderTest::readLittleEndianInto() {
+    BinaryReader reader{Data};
+    CORRADE_VERIFY(reader.skip(1));
+
+    /* Unaligned source */
+    std::uint32_t out[3];
+    CORRADE_VERIFY(reader.readLittleEndianInto(Containers::arrayView(out)));
+    const std::uint32_t expected[]{0x05040302u, 0x09080706u, 0x0d0c0b0au};
+    CORRADE_COMPARE_AS(Containers::arrayView(out), Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(reader.position(), 13);
+}
+
+void BinaryReaderTest::readBigEndianInto() {
+    BinaryReader reader{Data};
+
+    std::uint16_t out[3];
+    CORRADE_VERIFY(reader.readBigEndianInto(Containers::arrayView(out)));
+    const std::uint16_t expected[]{0x0102, 0x0304, 0x0506};
+    CORRADE_COMPARE_AS(Containers::arrayView(out), Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(reader.position(), 6);
+}
+
+void BinaryReaderTest::readEmpty() {
+    /* Zero-size reads on empty data should succeed */
+    BinaryReader reader{nullptr};
+    CORRADE_VERIFY(reader.skip(0));
+    CORRADE_VERIFY(reader.seek(0));
+    CORRADE_VERIFY(reader.readBytes(0));
+    CORRADE_VERIFY(reader.readArray<std::uint32_t>(0));
+    CORRADE_VERIFY(reader.readLittleEndianInto(Containers::ArrayView<std::uint32_t>{}));
+    CORRADE_VERIFY(reader.atEnd());
+}
+
+void BinaryReaderTest::seek() {
+    BinaryReader reader{Data};
+    CORRADE_VERIFY(reader.seek(16));
+    CORRADE_VERIFY(reader.atEnd());
+
+    CORRADE_VERIFY(reader.seek(3));
+    CORRADE_COMPARE(reader.position(), 3);
+    CORRADE_COMPARE(*reader.read<char>(), '\x04');
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!reader.seek(17));
+    CORRADE_COMPARE(reader.position(), 4);
+    CORRADE_COMPARE(out.str(), "Utility::BinaryReader::seek(): can't seek to position 17 in 16 bytes\n");
+}
+
+void BinaryReaderTest::skip() {
+    BinaryReader reader{Data};
+    CORRADE_VERIFY(reader.skip(15));
+    CORRADE_COMPARE(reader.position(), 15);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!reader.skip(2));
+    CORRADE_COMPARE(reader.position(), 15);
+    CORRADE_COMPARE(out.str(), "Utility::BinaryReader::skip(): expected 2 bytes at position 15 but got only 1\n");
+}
+
+void BinaryReaderTest::outOfBounds() {
+    BinaryReader reader{Data};
+    CORRADE_VERIFY(reader.skip(13));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    std::uint16_t values[2];
+    CORRADE_VERIFY(!reader.read<std::uint32_t>());
+    CORRADE_VERIFY(!reader.readLittleEndian<std::uint32_t>());
+    CORRADE_VERIFY(!reader.readBigEndian<std::uint32_t>());
+    CORRADE_VERIFY(!reader.readBytes(4));
+    CORRADE_VERIFY(!reader.readArray<char>(4));
+    CORRADE_VERIFY(!reader.readLittleEndianInto(Containers::arrayView(values)));
+    CORRADE_VERIFY(!reader.readBigEndianInto(Containers::arrayView(values)));
+
+    /* The position is unchanged after a failed read */
+    CORRADE_COMPARE(reader.position(), 13);
+    CORRADE_COMPARE(out.str(),
+        "Utility::BinaryReader::read(): expected 4 bytes at position 13 but got only 3\n"
+        "Utility::BinaryReader::readLittleEndian(): expected 4 bytes at position 13 but got only 3\n"
+        "Utility::BinaryReader::readBigEndian(): expected 4 bytes at position 13 but got only 3\n"
+        "Utility::BinaryReader::readBytes(): expected 4 bytes at position 13 but got only 3\n"
+        "Utility::BinaryReader::readArray(): expected 4 bytes at position 13 but got only 3\n"
+        "Utility::BinaryReader::readLittleEndianInto(): expected 4 bytes at position 13 but got only 3\n"
+        "Utility::BinaryReader::readBigEndianInto(): expected 4 bytes at position 13 but got only 3\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Utility::Test::BinaryReaderTest)
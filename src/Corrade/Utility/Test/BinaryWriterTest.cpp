@@ -0,0 +1,279 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Corrade/Containers/GrowableArray.h"
+#include "Corrade/Containers/Optional.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Container.h"
+#include "Corrade/Utility/BinaryReader.h"
+#include "Corrade/Utility/BinaryWriter.h"
+
+namespace Corrade { namespace Utility { namespace Test { namespace {
+
+struct BinaryWriterTest: TestSuite::Tester {
+    explicit BinaryWriterTest();
+
+    void construct();
+    void constructExisting();
+
+    void write();
+    void writeLittleEndian();
+    void writeBigEndian();
+    void writeBytes();
+    void writeArray();
+    void writeLittleEndianArray();
+    void writeBigEndianArray();
+    void writeBigEndianArrayUnaligned();
+    void writeEmpty();
+
+    void allocate();
+    void reserve();
+    void release();
+
+    void roundtrip();
+};
+
+BinaryWriterTest::BinaryWriterTest() {
+    addTests({&BinaryWriterTest::construct,
+              &BinaryWriterTest::constructExisting,
+
+              &BinaryWriterTest::write,
+              &BinaryWriterTest::writeLittleEndian,
+              &BinaryWriterTest::writeBigEndian,
+              &BinaryWriterTest::writeBytes,
+              &BinaryWriterTest::writeArray,
+              &BinaryWriterTest::writeLittleEndianArray,
+              &BinaryWriterTest::writeBigEndianArray,
+              &BinaryWriterTest::writeBigEndianArrayUnaligned,
+              &BinaryWriterTest::writeEmpty,
+
+              &BinaryWriterTest::allocate,
+              &BinaryWriterTest::reserve,
+              &BinaryWriterTest::release,
+
+              &BinaryWriterTest::roundtrip});
+}
+
+void BinaryWriterTest::construct() {
+    BinaryWriter writer;
+    CORRADE_COMPARE(writer.size(), 0);
+    CORRADE_VERIFY(writer.data().empty());
+}
+
+void BinaryWriterTest::constructExisting() {
+    Containers::Array<char> data{Containers::InPlaceInit, {'a', 'b'}};
+    BinaryWriter writer{std::move(data)};
+    CORRADE_COMPARE(writer.size(), 2);
+
+    writer.write('c');
+    const char expected[]{'a', 'b', 'c'};
+    CORRADE_COMPARE_AS(Containers::ArrayView<const char>{writer.data()},
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void BinaryWriterTest::write() {
+    BinaryWriter writer;
+    writer.write(std::uint8_t(0x01))
+          .write(Endianness::littleEndian(0x05040302u));
+    CORRADE_COMPARE(writer.size(), 5);
+
+    const char expected[]{'\x01', '\x02', '\x03', '\x04', '\x05'};
+    CORRADE_COMPARE_AS(Containers::ArrayView<const char>{writer.data()},
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void BinaryWriterTest::writeLittleEndian() {
+    BinaryWriter writer;
+    writer.writeLittleEndian(std::uint16_t(0x0201))
+          .writeLittleEndian(0x06050403u)
+          .writeLittleEndian(0x0e0d0c0b0a090807ull);
+
+    const char expected[]{
+        '\x01', '\x02', '\x03', '\x04', '\x05', '\x06', '\x07',
+        '\x08', '\x09', '\x0a', '\x0b', '\x0c', '\x0d', '\x0e'};
+    CORRADE_COMPARE_AS(Containers::ArrayView<const char>{writer.data()},
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void BinaryWriterTest::writeBigEndian() {
+    BinaryWriter writer;
+    writer.writeBigEndian(std::uint16_t(0x0102))
+          .writeBigEndian(0x03040506u)
+          .writeBigEndian(3.14159274f);
+
+    const char expected[]{
+        '\x01', '\x02', '\x03', '\x04', '\x05', '\x06',
+        '\x40', '\x49', '\x0f', '\xdb'};
+    CORRADE_COMPARE_AS(Containers::ArrayView<const char>{writer.data()},
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void BinaryWriterTest::writeBytes() {
+    BinaryWriter writer;
+    writer.writeBytes(Containers::arrayView("hello", 5))
+          .writeBytes(Containers::arrayView("!", 1));
+
+    const char expected[]{'h', 'e', 'l', 'l', 'o', '!'};
+    CORRADE_COMPARE_AS(Containers::ArrayView<const char>{writer.data()},
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void BinaryWriterTest::writeArray() {
+    const std::uint16_t values[]{
+        Endianness::littleEndian<std::uint16_t>(0x0201),
+        Endianness::littleEndian<std::uint16_t>(0x0403)};
+
+    BinaryWriter writer;
+    writer.writeArray(Containers::arrayView(values));
+
+    const char expected[]{'\x01', '\x02', '\x03', '\x04'};
+    CORRADE_COMPARE_AS(Containers::ArrayView<const char>{writer.data()},
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void BinaryWriterTest::writeLittleEndianArray() {
+    const std::uint32_t values[]{0x04030201u, 0x08070605u};
+
+    BinaryWriter writer;
+    writer.writeLittleEndianArray(Containers::arrayView(values));
+
+    const char expected[]{
+        '\x01', '\x02', '\x03', '\x04', '\x05', '\x06', '\x07', '\x08'};
+    CORRADE_COMPARE_AS(Containers::ArrayView<const char>{writer.data()},
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void BinaryWriterTest::writeBigEndianArray() {
+    std::uint32_t values[]{0x01020304u, 0x05060708u};
+
+    BinaryWriter writer;
+    /* Non-const view should work too */
+    writer.writeBigEndianArray(Containers::arrayView(values));
+
+    const char expected[]{
+        '\x01', '\x02', '\x03', '\x04', '\x05', '\x06', '\x07', '\x08'};
+    CORRADE_COMPARE_AS(Containers::ArrayView<const char>{writer.data()},
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+
+    /* The input isn't modified */
+    CORRADE_COMPARE(values[0], 0x01020304u);
+}
+
+void BinaryWriterTest::writeBigEndianArrayUnaligned() {
+    const std::uint32_t values[]{0x01020304u, 0x05060708u};
+
+    /* The array allocation is aligned, one byte before makes the array
+       written at an unaligned position */
+    BinaryWriter writer;
+    writer.write('!')
+          .writeBigEndianArray(Containers::arrayView(values));
+
+    const char expected[]{'!',
+        '\x01', '\x02', '\x03', '\x04', '\x05', '\x06', '\x07', '\x08'};
+    CORRADE_COMPARE_AS(Containers::ArrayView<const char>{writer.data()},
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void BinaryWriterTest::writeEmpty() {
+    BinaryWriter writer;
+    writer.writeBytes(nullptr)
+          .writeArray(Containers::ArrayView<const float>{})
+          .writeLittleEndianArray(Containers::ArrayView<const float>{})
+          .writeBigEndianArray(Containers::ArrayView<const float>{});
+    CORRADE_COMPARE(writer.size(), 0);
+}
+
+void BinaryWriterTest::allocate() {
+    BinaryWriter writer;
+    writer.write('a');
+
+    Containers::ArrayView<char> out = writer.allocate(3);
+    CORRADE_COMPARE(out.size(), 3);
+    CORRADE_COMPARE(out.data(), writer.data().data() + 1);
+    out[0] = 'b';
+    out[1] = 'c';
+    out[2] = 'd';
+
+    const char expected[]{'a', 'b', 'c', 'd'};
+    CORRADE_COMPARE_AS(Containers::ArrayView<const char>{writer.data()},
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void BinaryWriterTest::reserve() {
+    BinaryWriter writer;
+    writer.reserve(100);
+    CORRADE_COMPARE(writer.size(), 0);
+
+    /* Writing after shouldn't reallocate */
+    const void* data = writer.allocate(1).data();
+    writer.allocate(99);
+    CORRADE_COMPARE(static_cast<const void*>(writer.data().data()), data);
+}
+
+void BinaryWriterTest::release() {
+    BinaryWriter writer;
+    writer.writeBigEndian(0x01020304u);
+
+    Containers::Array<char> data = writer.release();
+    CORRADE_COMPARE(data.size(), 4);
+    CORRADE_COMPARE(data[3], '\x04');
+    CORRADE_COMPARE(writer.size(), 0);
+
+    /* The writer can be reused */
+    writer.write('a');
+    CORRADE_COMPARE(writer.size(), 1);
+}
+
+void BinaryWriterTest::roundtrip() {
+    const float floats[]{1.5f, -2.25f, 1.0e10f};
+
+    BinaryWriter writer;
+    writer.writeLittleEndian(0x1337u)
+          .writeBigEndian(std::int16_t(-5))
+          .writeBigEndianArray(Containers::arrayView(floats));
+
+    BinaryReader reader{writer.data()};
+    CORRADE_COMPARE(*reader.readLittleEndian<std::uint32_t>(), 0x1337u);
+    CORRADE_COMPARE(*reader.readBigEndian<std::int16_t>(), -5);
+    float out[3];
+    CORRADE_VERIFY(reader.readBigEndianInto(Containers::arrayView(out)));
+    CORRADE_COMPARE_AS(Containers::arrayView(out), Containers::arrayView(floats),
+        TestSuite::Compare::Container);
+    CORRADE_VERIFY(reader.atEnd());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Utility::Test::BinaryWriterTest)
@@ -0,0 +1,385 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+#include "Corrade/Containers/StringView.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/Utility/ConfigurationReader.h"
+#include "Corrade/Utility/DebugStl.h"
+#include "Corrade/Utility/Directory.h"
+
+#include "configure.h"
+
+namespace Corrade { namespace Utility { namespace Test { namespace {
+
+struct ConfigurationReaderTest: TestSuite::Tester {
+    explicit ConfigurationReaderTest();
+
+    void parse();
+    void parseHierarchic();
+    void parseHierarchicShortcuts();
+    void parseFile();
+    void parseFileStream();
+    void parseFileNonexistent();
+    void multiLineValueCrlf();
+    void bom();
+
+    void chunked();
+    void chunkedFile();
+
+    void missingEquals();
+    void missingQuote();
+    void missingBracket();
+    void emptyGroupName();
+    void emptySubgroupName();
+    void missingMultiLineQuote();
+    void errorIgnoresFurtherInput();
+
+    void reuse();
+};
+
+ConfigurationReaderTest::ConfigurationReaderTest() {
+    addTests({&ConfigurationReaderTest::parse,
+              &ConfigurationReaderTest::parseHierarchic,
+              &ConfigurationReaderTest::parseHierarchicShortcuts,
+              &ConfigurationReaderTest::parseFile,
+              &ConfigurationReaderTest::parseFileStream,
+              &ConfigurationReaderTest::parseFileNonexistent,
+              &ConfigurationReaderTest::multiLineValueCrlf,
+              &ConfigurationReaderTest::bom,
+
+              &ConfigurationReaderTest::chunked,
+              &ConfigurationReaderTest::chunkedFile,
+
+              &ConfigurationReaderTest::missingEquals,
+              &ConfigurationReaderTest::missingQuote,
+              &ConfigurationReaderTest::missingBracket,
+              &ConfigurationReaderTest::emptyGroupName,
+              &ConfigurationReaderTest::emptySubgroupName,
+              &ConfigurationReaderTest::missingMultiLineQuote,
+              &ConfigurationReaderTest::errorIgnoresFurtherInput,
+
+              &ConfigurationReaderTest::reuse});
+}
+
+/* Records all events into a string */
+struct Recorder: ConfigurationReader {
+    std::string out;
+
+    private:
+        void doGroupOpen(Containers::StringView name) override {
+            out += "[";
+            out.append(name.data(), name.size());
+            out += "]\n";
+        }
+
+        void doValue(Containers::StringView key, Containers::StringView value) override {
+            out.append(key.data(), key.size());
+            out += "=";
+            out.append(value.data(), value.size());
+            out += "|\n";
+        }
+
+        void doGroupClose() override {
+            out += "[/]\n";
+        }
+};
+
+constexpr const char Data[] =
+    "# A comment\n"
+    "key = value \n"
+    "\n"
+    "quoted=\"  spaces  \"\n"
+    "[group]\n"
+    "  ; Another comment\n"
+    "a=1\n"
+    "multi=\"\"\"\n"
+    " Hello\n"
+    "   people\n"
+    "\"\"\"\n"
+    "empty=\"\"\"\n"
+    "\"\"\"\n"
+    "[group/sub]\n"
+    "b=2\n"
+    "[group]\n"
+    "[other]\n"
+    "c=3";
+
+constexpr const char DataEvents[] =
+    "key=value|\n"
+    "quoted=  spaces  |\n"
+    "[group]\n"
+    "a=1|\n"
+    "multi= Hello\n   people|\n"
+    "empty=|\n"
+    "[sub]\n"
+    "b=2|\n"
+    "[/]\n"
+    "[/]\n"
+    "[group]\n"
+    "[/]\n"
+    "[other]\n"
+    "c=3|\n"
+    "[/]\n";
+
+void ConfigurationReaderTest::parse() {
+    Recorder reader;
+    CORRADE_VERIFY(reader.parseData(Data));
+    CORRADE_COMPARE(reader.out, DataEvents);
+}
+
+void ConfigurationReaderTest::parseHierarchic() {
+    Recorder reader;
+    CORRADE_VERIFY(reader.parse(Directory::join(CONFIGURATION_TEST_DIR, "hierarchic.conf")));
+
+    /* Same nesting as what Configuration builds in parseHierarchic() */
+    CORRADE_COMPARE(reader.out,
+        "[z]\n"
+        "[x]\n"
+        "[c]\n"
+        "[v]\n"
+        "key1=val1|\n"
+        "[/]\n" "[/]\n" "[/]\n" "[/]\n"
+        "[a]\n"
+        "[b]\n"
+        "key2=val2|\n"
+        "[/]\n"
+        "[b]\n"
+        "key2=val3|\n"
+        "[/]\n"
+        "[/]\n"
+        "[a]\n"
+        "key3=val4|\n"
+        "[b]\n"
+        "key2=val5|\n"
+        "[/]\n"
+        "[/]\n");
+}
+
+void ConfigurationReaderTest::parseHierarchicShortcuts() {
+    Recorder reader;
+    CORRADE_VERIFY(reader.parse(Directory::join(CONFIGURATION_TEST_DIR, "hierarchic-shortcuts.conf")));
+
+    CORRADE_COMPARE(reader.out,
+        "[c]\n" "[d]\n" "[e]\n"
+        "hello=there|\n"
+        "[f]\n" "[g]\n"
+        "hi=again|\n"
+        "[/]\n"
+        "[g]\n"
+        "hey=hiya|\n"
+        "[/]\n" "[/]\n"
+        "[f]\n" "[g]\n"
+        "hola=hallo|\n"
+        "[/]\n" "[/]\n" "[/]\n" "[/]\n" "[/]\n"
+        "[q]\n" "[w]\n" "[e]\n" "[r]\n"
+        "key4=val7|\n"
+        "[/]\n" "[/]\n" "[/]\n" "[/]\n");
+}
+
+void ConfigurationReaderTest::parseFile() {
+    const std::string filename = Directory::join(CONFIGURATION_WRITE_TEST_DIR, "reader.conf");
+    CORRADE_VERIFY(Directory::mkpath(CONFIGURATION_WRITE_TEST_DIR));
+    CORRADE_VERIFY(Directory::writeString(filename, Data));
+
+    Recorder reader;
+    CORRADE_VERIFY(reader.parse(filename));
+    CORRADE_COMPARE(reader.out, DataEvents);
+}
+
+void ConfigurationReaderTest::parseFileStream() {
+    const std::string filename = Directory::join(CONFIGURATION_WRITE_TEST_DIR, "reader.conf");
+    CORRADE_VERIFY(Directory::mkpath(CONFIGURATION_WRITE_TEST_DIR));
+    CORRADE_VERIFY(Directory::writeString(filename, Data));
+
+    std::FILE* const f = std::fopen(filename.data(), "rb");
+    CORRADE_VERIFY(f);
+
+    Recorder reader;
+    CORRADE_VERIFY(reader.parse(f));
+    CORRADE_COMPARE(reader.out, DataEvents);
+
+    /* The stream is not closed */
+    CORRADE_VERIFY(std::feof(f));
+    std::fclose(f);
+}
+
+void ConfigurationReaderTest::parseFileNonexistent() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Recorder reader;
+    CORRADE_VERIFY(!reader.parse("nonexistent.conf"));
+    CORRADE_COMPARE(reader.out, "");
+    CORRADE_COMPARE(out.str(), "Utility::ConfigurationReader::parse(): can't open nonexistent.conf\n");
+}
+
+void ConfigurationReaderTest::multiLineValueCrlf() {
+    Recorder reader;
+    CORRADE_VERIFY(reader.parse(Directory::join(CONFIGURATION_TEST_DIR, "multiLine-crlf.conf")));
+    CORRADE_COMPARE(reader.out, "value= Hello\n people how\n are you?|\n");
+}
+
+void ConfigurationReaderTest::bom() {
+    Recorder reader;
+    CORRADE_VERIFY(reader.parse(Directory::join(CONFIGURATION_TEST_DIR, "bom.conf")));
+    CORRADE_COMPARE(reader.out, "");
+
+    /* BOM split across chunks */
+    CORRADE_VERIFY(reader.feed("\xEF"));
+    CORRADE_VERIFY(reader.feed("\xBB\xBF" "a="));
+    CORRADE_VERIFY(reader.feed("b\n"));
+    CORRADE_VERIFY(reader.finish());
+    CORRADE_COMPARE(reader.out, "a=b|\n");
+}
+
+void ConfigurationReaderTest::chunked() {
+    const Containers::StringView data = Data;
+
+    /* Every chunk size should give the same result, including the ones that
+       split lines in the middle */
+    for(std::size_t chunkSize = 1; chunkSize <= data.size(); ++chunkSize) {
+        Recorder reader;
+        for(std::size_t i = 0; i < data.size(); i += chunkSize)
+            CORRADE_VERIFY(reader.feed(data.slice(i, std::min(i + chunkSize, data.size()))));
+        CORRADE_VERIFY(reader.finish());
+        CORRADE_COMPARE(reader.out, DataEvents);
+    }
+}
+
+void ConfigurationReaderTest::chunkedFile() {
+    /* A file larger than the internal chunk size, with a value spanning the
+       chunk boundary */
+    std::string data;
+    std::string expected;
+    for(std::size_t i = 0; i != 5000; ++i) {
+        data += "[group" + std::to_string(i) + "]\nkey=\"value " + std::to_string(i) + "\"\n";
+        expected += "[group" + std::to_string(i) + "]\nkey=value " + std::to_string(i) + "|\n[/]\n";
+    }
+    CORRADE_VERIFY(data.size() > 64*1024);
+
+    const std::string filename = Directory::join(CONFIGURATION_WRITE_TEST_DIR, "reader-large.conf");
+    CORRADE_VERIFY(Directory::mkpath(CONFIGURATION_WRITE_TEST_DIR));
+    CORRADE_VERIFY(Directory::writeString(filename, data));
+
+    Recorder reader;
+    CORRADE_VERIFY(reader.parse(filename));
+    CORRADE_COMPARE(reader.out, expected);
+}
+
+void ConfigurationReaderTest::missingEquals() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    /* The open group gets closed even on error */
+    Recorder reader;
+    CORRADE_VERIFY(!reader.parseData("[a]\nb=c\nd\ne=f\n"));
+    CORRADE_COMPARE(reader.out, "[a]\nb=c|\n[/]\n");
+    CORRADE_COMPARE(out.str(), "Utility::ConfigurationReader: missing equals for a value on line 3\n");
+}
+
+void ConfigurationReaderTest::missingQuote() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Recorder reader;
+    CORRADE_VERIFY(!reader.parseData("a=\"hello\n"));
+    CORRADE_COMPARE(reader.out, "");
+    CORRADE_COMPARE(out.str(), "Utility::ConfigurationReader: missing closing quote for a value on line 1\n");
+}
+
+void ConfigurationReaderTest::missingBracket() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Recorder reader;
+    CORRADE_VERIFY(!reader.parseData("a=b\n[group\n"));
+    CORRADE_COMPARE(reader.out, "a=b|\n");
+    CORRADE_COMPARE(out.str(), "Utility::ConfigurationReader: missing closing bracket for a group header on line 2\n");
+}
+
+void ConfigurationReaderTest::emptyGroupName() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Recorder reader;
+    CORRADE_VERIFY(!reader.parseData("[ ]\n"));
+    CORRADE_COMPARE(reader.out, "");
+    CORRADE_COMPARE(out.str(), "Utility::ConfigurationReader: empty group name on line 1\n");
+}
+
+void ConfigurationReaderTest::emptySubgroupName() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    /* Nothing gets opened for the invalid header */
+    Recorder reader;
+    CORRADE_VERIFY(!reader.parseData("[a]\n[a/b//c]\n"));
+    CORRADE_COMPARE(reader.out, "[a]\n[/]\n");
+    CORRADE_COMPARE(out.str(), "Utility::ConfigurationReader: empty subgroup name on line 2\n");
+}
+
+void ConfigurationReaderTest::missingMultiLineQuote() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Recorder reader;
+    CORRADE_VERIFY(reader.feed("[a]\nvalue=\"\"\"\nhello\n"));
+    CORRADE_VERIFY(!reader.finish());
+    CORRADE_COMPARE(reader.out, "[a]\n[/]\n");
+    CORRADE_COMPARE(out.str(), "Utility::ConfigurationReader: missing closing quotes for a multi-line value on line 3\n");
+}
+
+void ConfigurationReaderTest::errorIgnoresFurtherInput() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Recorder reader;
+    CORRADE_VERIFY(!reader.feed("a\n"));
+    CORRADE_VERIFY(!reader.feed("b=c\n"));
+    CORRADE_VERIFY(!reader.finish());
+    CORRADE_COMPARE(reader.out, "");
+    CORRADE_COMPARE(out.str(), "Utility::ConfigurationReader: missing equals for a value on line 1\n");
+}
+
+void ConfigurationReaderTest::reuse() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    /* After finish() the state is reset, even after an error */
+    Recorder reader;
+    CORRADE_VERIFY(!reader.parseData("[a]\nb\n"));
+    CORRADE_VERIFY(reader.parseData("[c]\nd=e"));
+    CORRADE_COMPARE(reader.line(), 0);
+    CORRADE_COMPARE(reader.out, "[a]\n[/]\n[c]\nd=e|\n[/]\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Utility::Test::ConfigurationReaderTest)
@@ -0,0 +1,419 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Corrade/Corrade.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <atomic>
+#include <thread>
+#endif
+
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Container.h"
+#include "Corrade/Utility/Configuration.h"
+#include "Corrade/Utility/ConfigurationSnapshot.h"
+#include "Corrade/Utility/DebugStl.h"
+
+namespace Corrade { namespace Utility { namespace Test { namespace {
+
+struct ConfigurationSnapshotTest: TestSuite::Tester {
+    explicit ConfigurationSnapshotTest();
+
+    void constructDefault();
+    void constructCopy();
+    void constructMove();
+
+    void notPublished();
+    void publish();
+    void publishMultiLine();
+    void publishKeepsPrevious();
+    void publishUnchanged();
+
+    void sharing();
+    void sharingNested();
+    void sharingRemovedGroup();
+    void groupOutlivesConfiguration();
+    void moveConfiguration();
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    void concurrent();
+    #endif
+};
+
+ConfigurationSnapshotTest::ConfigurationSnapshotTest() {
+    addTests({&ConfigurationSnapshotTest::constructDefault,
+              &ConfigurationSnapshotTest::constructCopy,
+              &ConfigurationSnapshotTest::constructMove,
+
+              &ConfigurationSnapshotTest::notPublished,
+              &ConfigurationSnapshotTest::publish,
+              &ConfigurationSnapshotTest::publishMultiLine,
+              &ConfigurationSnapshotTest::publishKeepsPrevious,
+              &ConfigurationSnapshotTest::publishUnchanged,
+
+              &ConfigurationSnapshotTest::sharing,
+              &ConfigurationSnapshotTest::sharingNested,
+              &ConfigurationSnapshotTest::sharingRemovedGroup,
+              &ConfigurationSnapshotTest::groupOutlivesConfiguration,
+              &ConfigurationSnapshotTest::moveConfiguration,
+
+              #ifndef CORRADE_TARGET_EMSCRIPTEN
+              &ConfigurationSnapshotTest::concurrent
+              #endif
+              });
+}
+
+void ConfigurationSnapshotTest::constructDefault() {
+    ConfigurationSnapshot a;
+    CORRADE_VERIFY(!a);
+    CORRADE_VERIFY(!a.isSharedWith(a));
+    CORRADE_VERIFY(a.isEmpty());
+    CORRADE_VERIFY(!a.hasGroups());
+    CORRADE_COMPARE(a.groupCount(), 0);
+    CORRADE_VERIFY(!a.hasGroup("group"));
+    CORRADE_COMPARE(a.groupCount("group"), 0);
+    CORRADE_VERIFY(!a.group("group"));
+    CORRADE_VERIFY(a.groups("group").empty());
+    CORRADE_VERIFY(!a.hasValues());
+    CORRADE_COMPARE(a.valueCount(), 0);
+    CORRADE_VERIFY(!a.hasValue("key"));
+    CORRADE_COMPARE(a.valueCount("key"), 0);
+    CORRADE_COMPARE(a.value("key"), "");
+    CORRADE_COMPARE(a.value<int>("key"), 0);
+    CORRADE_VERIFY(a.values("key").empty());
+}
+
+void ConfigurationSnapshotTest::constructCopy() {
+    Configuration conf;
+    conf.setValue("key", "value");
+    conf.publish();
+
+    ConfigurationSnapshot a = conf.snapshot();
+    ConfigurationSnapshot b = a;
+    CORRADE_VERIFY(b.isSharedWith(a));
+    CORRADE_COMPARE(b.value("key"), "value");
+
+    ConfigurationSnapshot c;
+    c = b;
+    CORRADE_VERIFY(c.isSharedWith(a));
+    CORRADE_COMPARE(c.value("key"), "value");
+
+    /* Self-assignment shouldn't free the data */
+    ConfigurationSnapshot& cRef = c;
+    c = cRef;
+    CORRADE_COMPARE(c.value("key"), "value");
+}
+
+void ConfigurationSnapshotTest::constructMove() {
+    Configuration conf;
+    conf.setValue("key", "value");
+    conf.publish();
+
+    ConfigurationSnapshot a = conf.snapshot();
+    ConfigurationSnapshot b = std::move(a);
+    CORRADE_VERIFY(!a);
+    CORRADE_COMPARE(b.value("key"), "value");
+
+    ConfigurationSnapshot c;
+    c = std::move(b);
+    CORRADE_VERIFY(!b);
+    CORRADE_COMPARE(c.value("key"), "value");
+}
+
+void ConfigurationSnapshotTest::notPublished() {
+    Configuration conf;
+    conf.setValue("key", "value");
+
+    CORRADE_VERIFY(!conf.snapshot());
+}
+
+void ConfigurationSnapshotTest::publish() {
+    std::istringstream in{
+        "# a comment\n"
+        "name=hello world\n"
+        "number=42\n"
+        "number=0x1f\n"
+        "\n"
+        "[group]\n"
+        "key=value\n"
+        "[group/nested]\n"
+        "deep=true\n"
+        "[group]\n"
+        "key=another\n"
+        "[empty]\n"};
+    Configuration conf{in};
+    CORRADE_VERIFY(conf.isValid());
+
+    conf.publish();
+    ConfigurationSnapshot snapshot = conf.snapshot();
+    CORRADE_VERIFY(snapshot);
+    CORRADE_VERIFY(!snapshot.isEmpty());
+
+    /* Comments and empty lines are not included */
+    CORRADE_VERIFY(snapshot.hasValues());
+    CORRADE_COMPARE(snapshot.valueCount(), 3);
+    CORRADE_VERIFY(snapshot.hasValue("name"));
+    CORRADE_VERIFY(snapshot.hasValue("number", 1));
+    CORRADE_VERIFY(!snapshot.hasValue("number", 2));
+    CORRADE_COMPARE(snapshot.valueCount("number"), 2);
+    CORRADE_COMPARE(snapshot.value("name"), "hello world");
+    CORRADE_COMPARE(snapshot.value("nonexistent"), "");
+    CORRADE_COMPARE(snapshot.value<int>("number"), 42);
+    CORRADE_COMPARE(snapshot.value<int>("number", 1, ConfigurationValueFlag::Hex), 0x1f);
+    CORRADE_COMPARE_AS(snapshot.values("number"),
+        (std::vector<std::string>{"42", "0x1f"}),
+        TestSuite::Compare::Container);
+
+    CORRADE_VERIFY(snapshot.hasGroups());
+    CORRADE_COMPARE(snapshot.groupCount(), 3);
+    CORRADE_COMPARE(snapshot.groupCount("group"), 2);
+    CORRADE_VERIFY(snapshot.hasGroup("group", 1));
+    CORRADE_VERIFY(!snapshot.hasGroup("group", 2));
+    CORRADE_VERIFY(!snapshot.group("nonexistent"));
+
+    ConfigurationSnapshot group = snapshot.group("group");
+    CORRADE_COMPARE(group.value("key"), "value");
+    CORRADE_VERIFY(group.group("nested").value<bool>("deep"));
+    CORRADE_COMPARE(snapshot.group("group", 1).value("key"), "another");
+
+    std::vector<ConfigurationSnapshot> groups = snapshot.groups("group");
+    CORRADE_COMPARE(groups.size(), 2);
+    CORRADE_VERIFY(groups[0].isSharedWith(group));
+    CORRADE_COMPARE(groups[1].value("key"), "another");
+
+    /* An empty group is still a valid snapshot */
+    ConfigurationSnapshot empty = snapshot.group("empty");
+    CORRADE_VERIFY(empty);
+    CORRADE_VERIFY(empty.isEmpty());
+}
+
+void ConfigurationSnapshotTest::publishMultiLine() {
+    std::istringstream in{
+        "value=\"\"\"\n"
+        "first\n"
+        "second\n"
+        "\"\"\"\n"};
+    Configuration conf{in};
+    conf.publish();
+
+    /* The value is stored decoded */
+    CORRADE_COMPARE(conf.snapshot().value("value"), "first\nsecond");
+}
+
+void ConfigurationSnapshotTest::publishKeepsPrevious() {
+    Configuration conf;
+    conf.setValue("key", "first");
+    conf.publish();
+
+    ConfigurationSnapshot first = conf.snapshot();
+
+    /* Modifications aren't visible until published */
+    conf.setValue("key", "second");
+    conf.addGroup("group");
+    CORRADE_COMPARE(conf.snapshot().value("key"), "first");
+    CORRADE_VERIFY(!conf.snapshot().hasGroups());
+
+    conf.publish();
+    ConfigurationSnapshot second = conf.snapshot();
+    CORRADE_COMPARE(second.value("key"), "second");
+    CORRADE_VERIFY(second.hasGroup("group"));
+
+    /* The previous snapshot is still alive and unchanged */
+    CORRADE_COMPARE(first.value("key"), "first");
+    CORRADE_VERIFY(!first.hasGroups());
+}
+
+void ConfigurationSnapshotTest::publishUnchanged() {
+    Configuration conf;
+    conf.addGroup("group")->setValue("key", "value");
+    conf.publish();
+
+    ConfigurationSnapshot first = conf.snapshot();
+
+    /* Publishing again without any change gives back the same data */
+    conf.publish();
+    CORRADE_VERIFY(conf.snapshot().isSharedWith(first));
+
+    /* Even if the configuration was modified in between, but the snapshot
+       is in this case a new one */
+    conf.group("group")->setValue("key", "another");
+    conf.group("group")->setValue("key", "value");
+    conf.publish();
+    CORRADE_VERIFY(!conf.snapshot().isSharedWith(first));
+    CORRADE_COMPARE(conf.snapshot().group("group").value("key"), "value");
+}
+
+void ConfigurationSnapshotTest::sharing() {
+    Configuration conf;
+    conf.addGroup("a")->setValue("key", "a");
+    conf.addGroup("b")->setValue("key", "b");
+    conf.setValue("root", 1);
+    conf.publish();
+
+    ConfigurationSnapshot first = conf.snapshot();
+
+    /* Changing one group makes a new root and a new copy of the group, but
+       the other group stays shared */
+    conf.group("b")->setValue("key", "B");
+    conf.publish();
+    ConfigurationSnapshot second = conf.snapshot();
+    CORRADE_VERIFY(!second.isSharedWith(first));
+    CORRADE_VERIFY(second.group("a").isSharedWith(first.group("a")));
+    CORRADE_VERIFY(!second.group("b").isSharedWith(first.group("b")));
+    CORRADE_COMPARE(second.group("b").value("key"), "B");
+    CORRADE_COMPARE(first.group("b").value("key"), "b");
+
+    /* Changing just the root value keeps all groups shared */
+    conf.setValue("root", 2);
+    conf.publish();
+    ConfigurationSnapshot third = conf.snapshot();
+    CORRADE_VERIFY(!third.isSharedWith(second));
+    CORRADE_VERIFY(third.group("a").isSharedWith(second.group("a")));
+    CORRADE_VERIFY(third.group("b").isSharedWith(second.group("b")));
+    CORRADE_COMPARE(third.value<int>("root"), 2);
+}
+
+void ConfigurationSnapshotTest::sharingNested() {
+    Configuration conf;
+    ConfigurationGroup* a = conf.addGroup("a");
+    ConfigurationGroup* b = a->addGroup("b");
+    ConfigurationGroup* c = b->addGroup("c");
+    a->addGroup("sibling")->setValue("key", "value");
+    c->setValue("key", 1);
+    conf.publish();
+
+    ConfigurationSnapshot first = conf.snapshot();
+
+    /* A change deep in the tree propagates to all parents */
+    c->setValue("key", 2);
+    conf.publish();
+    ConfigurationSnapshot second = conf.snapshot();
+    CORRADE_VERIFY(!second.isSharedWith(first));
+    CORRADE_VERIFY(!second.group("a").isSharedWith(first.group("a")));
+    CORRADE_VERIFY(!second.group("a").group("b").isSharedWith(first.group("a").group("b")));
+    CORRADE_VERIFY(second.group("a").group("sibling").isSharedWith(first.group("a").group("sibling")));
+    CORRADE_COMPARE(second.group("a").group("b").group("c").value<int>("key"), 2);
+    CORRADE_COMPARE(first.group("a").group("b").group("c").value<int>("key"), 1);
+}
+
+void ConfigurationSnapshotTest::sharingRemovedGroup() {
+    Configuration conf;
+    conf.addGroup("a")->setValue("key", "a");
+    conf.addGroup("b")->setValue("key", "b");
+    conf.publish();
+
+    ConfigurationSnapshot first = conf.snapshot();
+
+    conf.removeGroup("a");
+    conf.publish();
+    ConfigurationSnapshot second = conf.snapshot();
+    CORRADE_COMPARE(second.groupCount(), 1);
+    CORRADE_VERIFY(second.group("b").isSharedWith(first.group("b")));
+    CORRADE_COMPARE(first.group("a").value("key"), "a");
+
+    /* Adding a group of the same name again doesn't reuse the old data */
+    conf.addGroup("a")->setValue("key", "a");
+    conf.publish();
+    ConfigurationSnapshot third = conf.snapshot();
+    CORRADE_VERIFY(!third.group("a").isSharedWith(first.group("a")));
+    CORRADE_COMPARE(third.group("a").value("key"), "a");
+}
+
+void ConfigurationSnapshotTest::groupOutlivesConfiguration() {
+    ConfigurationSnapshot group;
+    {
+        Configuration conf;
+        conf.addGroup("group")->setValue("key", "value");
+        conf.publish();
+        group = conf.snapshot().group("group");
+    }
+
+    CORRADE_COMPARE(group.value("key"), "value");
+}
+
+void ConfigurationSnapshotTest::moveConfiguration() {
+    Configuration a;
+    a.setValue("key", "value");
+    a.publish();
+
+    Configuration b{std::move(a)};
+    CORRADE_COMPARE(b.snapshot().value("key"), "value");
+
+    Configuration c;
+    c = std::move(b);
+    CORRADE_COMPARE(c.snapshot().value("key"), "value");
+
+    /* Modifications after a move are tracked properly */
+    c.setValue("key", "another");
+    c.publish();
+    CORRADE_COMPARE(c.snapshot().value("key"), "another");
+}
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+void ConfigurationSnapshotTest::concurrent() {
+    Configuration conf;
+    ConfigurationGroup* group = conf.addGroup("group");
+    group->setValue("a", 0);
+    group->setValue("b", 0);
+    conf.addGroup("static")->setValue("key", "value");
+    conf.publish();
+
+    /* Readers check that they always see a consistent state while the main
+       thread publishes updates */
+    std::atomic<bool> done{false};
+    std::atomic<int> inconsistent{0};
+    std::thread readers[4];
+    for(std::thread& reader: readers) reader = std::thread{[&]() {
+        int last = 0;
+        while(!done.load()) {
+            ConfigurationSnapshot snapshot = conf.snapshot();
+            const int a = snapshot.group("group").value<int>("a");
+            const int b = snapshot.group("group").value<int>("b");
+            if(a != b || a < last || snapshot.group("static").value("key") != "value")
+                ++inconsistent;
+            last = a;
+        }
+    }};
+
+    for(int i = 1; i != 2000; ++i) {
+        group->setValue("a", i);
+        group->setValue("b", i);
+        conf.publish();
+    }
+
+    done = true;
+    for(std::thread& reader: readers) reader.join();
+
+    CORRADE_COMPARE(inconsistent, 0);
+    CORRADE_COMPARE(conf.snapshot().group("group").value<int>("a"), 1999);
+}
+#endif
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Utility::Test::ConfigurationSnapshotTest)
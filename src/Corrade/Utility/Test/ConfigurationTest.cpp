@@ -28,17 +28,43 @@
 #include <utility>
 #include <vector>
 
+#include "Corrade/Containers/Pointer.h"
 #include "Corrade/TestSuite/Tester.h"
 #include "Corrade/TestSuite/Compare/Container.h"
 #include "Corrade/TestSuite/Compare/File.h"
 #include "Corrade/TestSuite/Compare/FileToString.h"
+#include "Corrade/TestSuite/Compare/StringToFile.h"
 #include "Corrade/Utility/Configuration.h"
 #include "Corrade/Utility/DebugStl.h"
 #include "Corrade/Utility/Directory.h"
 
 #include "configure.h"
 
-namespace Corrade { namespace Utility { namespace Test { namespace {
+namespace Corrade { namespace Utility {
+
+namespace {
+
+struct Counted {
+    int value;
+};
+
+int countedConversions = 0;
+
+}
+
+template<> struct ConfigurationValue<Counted> {
+    ConfigurationValue() = delete;
+
+    static std::string toString(Counted value, ConfigurationValueFlags flags) {
+        return ConfigurationValue<int>::toString(value.value, flags);
+    }
+    static Counted fromString(const std::string& stringValue, ConfigurationValueFlags flags) {
+        ++countedConversions;
+        return Counted{ConfigurationValue<int>::fromString(stringValue, flags)};
+    }
+};
+
+namespace Test { namespace {
 
 struct ConfigurationTest: TestSuite::Tester {
     explicit ConfigurationTest();
@@ -56,12 +82,37 @@ struct ConfigurationTest: TestSuite::Tester {
 
     void groupIndex();
     void valueIndex();
+    void valuesArray();
+    void valueComponents();
+    void valueComponentsReadOnly();
+    void hashedLookup();
+    void hashedLookupModify();
+    void hashedLookupSubgroup();
+    void cachedValues();
+    void cachedValuesRemove();
+    void cachedValuesDisabled();
 
     void names();
 
     void readonly();
+    void readonlyMultiLineValue();
+    void readonlyMultiLineValueCrlf();
+    void readonlyModify();
+    void readonlyCopyMove();
+    void readonlyEmptyFile();
     void nonexistentFile();
     void truncate();
+    void atomicSave();
+    void atomicSaveFailed();
+    void incrementalSave();
+    void incrementalSaveUnmodified();
+    void incrementalSaveMove();
+
+    void binary();
+    void binaryReadOnly();
+    void binarySkipComments();
+    void binarySave();
+    void binaryInvalid();
 
     void whitespaces();
     void bom();
@@ -74,6 +125,15 @@ struct ConfigurationTest: TestSuite::Tester {
     void standaloneGroup();
     void copy();
     void move();
+
+    void benchmarkLookup();
+    void benchmarkLookupHashed();
+    void benchmarkLookupCached();
+    void benchmarkParse();
+    void benchmarkParseReadOnly();
+    void benchmarkParseBinary();
+    void benchmarkSave();
+    void benchmarkSaveIncremental();
 };
 
 ConfigurationTest::ConfigurationTest() {
@@ -90,12 +150,37 @@ ConfigurationTest::ConfigurationTest() {
 
               &ConfigurationTest::groupIndex,
               &ConfigurationTest::valueIndex,
+              &ConfigurationTest::valuesArray,
+              &ConfigurationTest::valueComponents,
+              &ConfigurationTest::valueComponentsReadOnly,
+              &ConfigurationTest::hashedLookup,
+              &ConfigurationTest::hashedLookupModify,
+              &ConfigurationTest::hashedLookupSubgroup,
+              &ConfigurationTest::cachedValues,
+              &ConfigurationTest::cachedValuesRemove,
+              &ConfigurationTest::cachedValuesDisabled,
 
               &ConfigurationTest::names,
 
               &ConfigurationTest::readonly,
+              &ConfigurationTest::readonlyMultiLineValue,
+              &ConfigurationTest::readonlyMultiLineValueCrlf,
+              &ConfigurationTest::readonlyModify,
+              &ConfigurationTest::readonlyCopyMove,
+              &ConfigurationTest::readonlyEmptyFile,
               &ConfigurationTest::nonexistentFile,
               &ConfigurationTest::truncate,
+              &ConfigurationTest::atomicSave,
+              &ConfigurationTest::atomicSaveFailed,
+              &ConfigurationTest::incrementalSave,
+              &ConfigurationTest::incrementalSaveUnmodified,
+              &ConfigurationTest::incrementalSaveMove,
+
+              &ConfigurationTest::binary,
+              &ConfigurationTest::binaryReadOnly,
+              &ConfigurationTest::binarySkipComments,
+              &ConfigurationTest::binarySave,
+              &ConfigurationTest::binaryInvalid,
 
               &ConfigurationTest::whitespaces,
               &ConfigurationTest::bom,
@@ -109,6 +194,15 @@ ConfigurationTest::ConfigurationTest() {
               &ConfigurationTest::copy,
               &ConfigurationTest::move});
 
+    addBenchmarks({&ConfigurationTest::benchmarkLookup,
+                   &ConfigurationTest::benchmarkLookupHashed,
+                   &ConfigurationTest::benchmarkLookupCached,
+                   &ConfigurationTest::benchmarkParse,
+                   &ConfigurationTest::benchmarkParseReadOnly,
+                   &ConfigurationTest::benchmarkParseBinary,
+                   &ConfigurationTest::benchmarkSave,
+                   &ConfigurationTest::benchmarkSaveIncremental}, 10);
+
     /* Create testing dir */
     Directory::mkpath(CONFIGURATION_WRITE_TEST_DIR);
 
@@ -342,6 +436,294 @@ void ConfigurationTest::valueIndex() {
     CORRADE_VERIFY(conf.setValue("a", "foo", 2));
 }
 
+void ConfigurationTest::valuesArray() {
+    std::istringstream in("a=1\nb=7\na=2\na=0x1f\n");
+    Configuration conf(in);
+    CORRADE_VERIFY(conf.isValid());
+
+    /* Appends to what's already there */
+    Containers::Array<int> out;
+    Containers::arrayAppend(out, 42);
+    CORRADE_COMPARE(conf.values("a", out), 3);
+    CORRADE_COMPARE_AS(out, (Containers::Array<int>{Containers::InPlaceInit, {42, 1, 2, 0}}),
+        TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(conf.values("a", out, ConfigurationValueFlag::Hex), 3);
+    CORRADE_COMPARE_AS(out, (Containers::Array<int>{Containers::InPlaceInit, {42, 1, 2, 0, 1, 2, 0x1f}}),
+        TestSuite::Compare::Container);
+
+    /* Nonexistent key appends nothing */
+    CORRADE_COMPARE(conf.values("c", out), 0);
+    CORRADE_COMPARE(out.size(), 7);
+
+    /* Strings work too */
+    Containers::Array<std::string> strings;
+    CORRADE_COMPARE(conf.values("a", strings), 3);
+    CORRADE_COMPARE_AS(strings, (Containers::Array<std::string>{Containers::InPlaceInit, {"1", "2", "0x1f"}}),
+        TestSuite::Compare::Container);
+}
+
+void ConfigurationTest::valueComponents() {
+    std::istringstream in(
+        "matrix=1 0 0.5\t\t-2.5e1  +3\n"
+        "ints=  ff -7 0x10 nope\n"
+        "empty=\n"
+        "matrix=4 5\n");
+    Configuration conf(in);
+    CORRADE_VERIFY(conf.isValid());
+
+    Containers::Array<float> floats;
+    CORRADE_COMPARE(conf.valueComponents("matrix", floats), 5);
+    CORRADE_COMPARE_AS(floats, (Containers::Array<float>{Containers::InPlaceInit, {1.0f, 0.0f, 0.5f, -25.0f, 3.0f}}),
+        TestSuite::Compare::Container);
+
+    /* Second value appends to the existing data */
+    CORRADE_COMPARE(conf.valueComponents("matrix", floats, 1), 2);
+    CORRADE_COMPARE(floats.size(), 7);
+    CORRADE_COMPARE(floats[5], 4.0f);
+    CORRADE_COMPARE(floats[6], 5.0f);
+
+    /* Invalid components are zero, same as with value<int>() */
+    Containers::Array<int> ints;
+    CORRADE_COMPARE(conf.valueComponents("ints", ints), 4);
+    CORRADE_COMPARE_AS(ints, (Containers::Array<int>{Containers::InPlaceInit, {0, -7, 0, 0}}),
+        TestSuite::Compare::Container);
+
+    Containers::Array<int> hex;
+    CORRADE_COMPARE(conf.valueComponents("ints", hex, ConfigurationValueFlag::Hex), 4);
+    CORRADE_COMPARE_AS(hex, (Containers::Array<int>{Containers::InPlaceInit, {0xff, -7, 0x10, 0}}),
+        TestSuite::Compare::Container);
+
+    /* Empty and nonexistent values append nothing */
+    Containers::Array<double> doubles;
+    CORRADE_COMPARE(conf.valueComponents("empty", doubles), 0);
+    CORRADE_COMPARE(conf.valueComponents("nonexistent", doubles), 0);
+    CORRADE_COMPARE(conf.valueComponents("matrix", doubles, 2), 0);
+    CORRADE_VERIFY(doubles.empty());
+}
+
+void ConfigurationTest::valueComponentsReadOnly() {
+    const std::string filename = Directory::join(CONFIGURATION_WRITE_TEST_DIR, "components.conf");
+    CORRADE_VERIFY(Directory::writeString(filename,
+        "vector=1.5 2 3\n"
+        "list=\"\"\"\r\n"
+        "1 2\r\n"
+        "3\n"
+        "\"\"\"\n"));
+
+    /* Values referenced from the mapped file, multi-line values decoded
+       first */
+    Configuration conf(filename, Configuration::Flag::ReadOnly);
+    CORRADE_VERIFY(conf.isValid());
+
+    Containers::Array<double> vector;
+    CORRADE_COMPARE(conf.valueComponents("vector", vector), 3);
+    CORRADE_COMPARE_AS(vector, (Containers::Array<double>{Containers::InPlaceInit, {1.5, 2.0, 3.0}}),
+        TestSuite::Compare::Container);
+
+    Containers::Array<unsigned int> list;
+    CORRADE_COMPARE(conf.valueComponents("list", list), 3);
+    CORRADE_COMPARE_AS(list, (Containers::Array<unsigned int>{Containers::InPlaceInit, {1, 2, 3}}),
+        TestSuite::Compare::Container);
+
+    Containers::Array<std::string> strings;
+    CORRADE_COMPARE(conf.values("vector", strings), 1);
+    CORRADE_COMPARE(strings[0], "1.5 2 3");
+}
+
+void ConfigurationTest::hashedLookup() {
+    std::istringstream in{
+        "# comment\n"
+        "a=1\n"
+        "b=2\n"
+        "a=3\n"
+        "\n"
+        "c=4\n"
+        "a=5\n"
+        "[group]\n"
+        "x=first\n"
+        "[other]\n"
+        "[group]\n"
+        "x=second\n"};
+    Configuration conf{in, Configuration::Flag::HashedLookup};
+    CORRADE_VERIFY(conf.isValid());
+
+    /* Multiple values with the same key keep their order */
+    CORRADE_COMPARE(conf.value<int>("a"), 1);
+    CORRADE_COMPARE(conf.value<int>("a", 1), 3);
+    CORRADE_COMPARE(conf.value<int>("a", 2), 5);
+    CORRADE_VERIFY(!conf.hasValue("a", 3));
+    CORRADE_COMPARE(conf.valueCount("a"), 3);
+    CORRADE_COMPARE_AS(conf.values<int>("a"), (std::vector<int>{1, 3, 5}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(conf.value<int>("c"), 4);
+    CORRADE_VERIFY(!conf.hasValue("d"));
+    CORRADE_COMPARE(conf.valueCount("d"), 0);
+    /* Comments and empty lines have an empty key, those shouldn't be found */
+    CORRADE_VERIFY(!conf.hasValue(""));
+    CORRADE_COMPARE(conf.valueCount(), 5);
+
+    /* Same for groups */
+    CORRADE_COMPARE(conf.groupCount("group"), 2);
+    CORRADE_COMPARE(conf.group("group")->value("x"), "first");
+    CORRADE_COMPARE(conf.group("group", 1)->value("x"), "second");
+    CORRADE_VERIFY(!conf.hasGroup("group", 2));
+    CORRADE_COMPARE(conf.groups("group").size(), 2);
+    CORRADE_VERIFY(conf.hasGroup("other"));
+    CORRADE_VERIFY(!conf.hasGroup("nonexistent"));
+}
+
+void ConfigurationTest::hashedLookupModify() {
+    std::istringstream in{"a=1\nb=2\na=3\n[g]\n[h]\n[g]\n"};
+    Configuration conf{in, Configuration::Flag::HashedLookup};
+    CORRADE_VERIFY(conf.isValid());
+
+    /* Build the index */
+    CORRADE_COMPARE(conf.value<int>("a", 1), 3);
+    CORRADE_COMPARE(conf.groupCount("g"), 2);
+
+    /* Added values and groups are found without rebuilding the index */
+    conf.addValue("a", 4);
+    conf.addValue("c", 5);
+    CORRADE_VERIFY(conf.setValue("d", 6));
+    CORRADE_VERIFY(conf.setValue("a", 7, 3));
+    CORRADE_VERIFY(!conf.setValue("a", 8, 5));
+    CORRADE_COMPARE_AS(conf.values<int>("a"), (std::vector<int>{1, 3, 4, 7}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(conf.value<int>("c"), 5);
+    CORRADE_COMPARE(conf.value<int>("d"), 6);
+    ConfigurationGroup* const added = conf.addGroup("g");
+    CORRADE_COMPARE(conf.group("g", 2), added);
+
+    /* Changing a value in place doesn't affect the index */
+    CORRADE_VERIFY(conf.setValue("a", 9, 1));
+    CORRADE_COMPARE(conf.value<int>("a", 1), 9);
+
+    /* Removals shift positions of the remaining items */
+    CORRADE_VERIFY(conf.removeValue("a"));
+    CORRADE_COMPARE_AS(conf.values<int>("a"), (std::vector<int>{9, 4, 7}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(conf.value<int>("b"), 2);
+    CORRADE_COMPARE(conf.value<int>("c"), 5);
+    conf.removeAllValues("a");
+    CORRADE_VERIFY(!conf.hasValue("a"));
+    CORRADE_COMPARE(conf.value<int>("d"), 6);
+
+    CORRADE_VERIFY(conf.removeGroup("g"));
+    CORRADE_COMPARE(conf.groupCount("g"), 2);
+    CORRADE_COMPARE(conf.group("g", 1), added);
+    CORRADE_VERIFY(conf.removeGroup(added));
+    CORRADE_COMPARE(conf.groupCount("g"), 1);
+    CORRADE_VERIFY(conf.hasGroup("h"));
+    conf.removeAllGroups("g");
+    CORRADE_VERIFY(!conf.hasGroup("g"));
+    CORRADE_VERIFY(conf.hasGroup("h"));
+
+    conf.clear();
+    CORRADE_VERIFY(!conf.hasValue("b"));
+    CORRADE_VERIFY(!conf.hasGroup("h"));
+    conf.addValue("b", 10);
+    CORRADE_COMPARE(conf.value<int>("b"), 10);
+}
+
+void ConfigurationTest::hashedLookupSubgroup() {
+    Configuration conf{Configuration::Flag::HashedLookup};
+
+    /* A standalone group doesn't use the index, the group it gets added to
+       does */
+    ConfigurationGroup* group = new ConfigurationGroup;
+    group->addValue("a", 1);
+    CORRADE_COMPARE(group->value<int>("a"), 1);
+    conf.addGroup("group", group);
+    group->addValue("a", 2);
+    CORRADE_COMPARE_AS(group->values<int>("a"), (std::vector<int>{1, 2}),
+        TestSuite::Compare::Container);
+
+    /* Copies don't share the index with the original */
+    ConfigurationGroup* copy = conf.addGroup("copy");
+    *copy = *group;
+    copy->addValue("a", 3);
+    CORRADE_COMPARE_AS(copy->values<int>("a"), (std::vector<int>{1, 2, 3}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(group->valueCount("a"), 2);
+}
+
+void ConfigurationTest::cachedValues() {
+    Configuration conf{Configuration::Flag::CacheTypedValues};
+    ConfigurationGroup* group = conf.addGroup("group");
+    group->setValue("a", "17");
+    group->setValue("b", "ff");
+
+    countedConversions = 0;
+    CORRADE_COMPARE(group->value<Counted>("a").value, 17);
+    CORRADE_COMPARE(group->value<Counted>("a").value, 17);
+    CORRADE_COMPARE(countedConversions, 1);
+
+    /* Different flags are converted again */
+    CORRADE_COMPARE(group->value<Counted>("b", ConfigurationValueFlag::Hex).value, 255);
+    CORRADE_COMPARE(group->value<Counted>("b", ConfigurationValueFlag::Hex).value, 255);
+    CORRADE_COMPARE(group->value<Counted>("b").value, 0);
+    CORRADE_COMPARE(countedConversions, 3);
+
+    /* Only the last type is cached */
+    CORRADE_COMPARE(group->value<int>("a"), 17);
+    CORRADE_COMPARE(group->value<Counted>("a").value, 17);
+    CORRADE_COMPARE(countedConversions, 4);
+
+    /* Changing the value resets the cache */
+    group->setValue("a", 42);
+    CORRADE_COMPARE(group->value<Counted>("a").value, 42);
+    CORRADE_COMPARE(group->value<Counted>("a").value, 42);
+    CORRADE_COMPARE(countedConversions, 5);
+
+    /* Missing values are converted from an empty string every time */
+    CORRADE_COMPARE(group->value<Counted>("nonexistent").value, 0);
+    CORRADE_COMPARE(group->value<Counted>("nonexistent").value, 0);
+    CORRADE_COMPARE(countedConversions, 7);
+
+    /* Types that don't fit aren't cached but still work */
+    CORRADE_COMPARE(group->value<std::string>("a"), "42");
+    CORRADE_COMPARE(group->value<long double>("a"), 42.0l);
+}
+
+void ConfigurationTest::cachedValuesRemove() {
+    Configuration conf{Configuration::Flag::CacheTypedValues};
+    conf.addValue("a", "1");
+    conf.addValue("a", "2");
+
+    countedConversions = 0;
+    CORRADE_COMPARE(conf.value<Counted>("a", 0).value, 1);
+    CORRADE_COMPARE(conf.value<Counted>("a", 1).value, 2);
+    CORRADE_COMPARE(countedConversions, 2);
+
+    /* The cache stays with the value when other values are removed */
+    CORRADE_VERIFY(conf.removeValue("a"));
+    CORRADE_COMPARE(conf.value<Counted>("a", 0).value, 2);
+    CORRADE_COMPARE(countedConversions, 2);
+
+    /* Copies of the group take the cache along, it's still valid */
+    ConfigurationGroup copy = conf;
+    CORRADE_COMPARE(copy.value<Counted>("a", 0).value, 2);
+    CORRADE_COMPARE(countedConversions, 2);
+}
+
+void ConfigurationTest::cachedValuesDisabled() {
+    Configuration conf;
+    conf.setValue("a", "17");
+
+    countedConversions = 0;
+    CORRADE_COMPARE(conf.value<Counted>("a").value, 17);
+    CORRADE_COMPARE(conf.value<Counted>("a").value, 17);
+    CORRADE_COMPARE(countedConversions, 2);
+
+    /* A standalone group doesn't cache either */
+    ConfigurationGroup group;
+    group.setValue("a", "17");
+    CORRADE_COMPARE(group.value<Counted>("a").value, 17);
+    CORRADE_COMPARE(group.value<Counted>("a").value, 17);
+    CORRADE_COMPARE(countedConversions, 4);
+}
+
 void ConfigurationTest::names() {
     std::ostringstream out;
     Error redirectError{&out};
@@ -378,6 +760,120 @@ void ConfigurationTest::readonly() {
     CORRADE_VERIFY(conf.isValid());
     CORRADE_VERIFY(!conf.isEmpty());
     CORRADE_VERIFY(conf.filename().empty());
+
+    /* The values are referenced from the mapped file, but should behave the
+       same */
+    CORRADE_COMPARE(conf.groupCount(), 4);
+    CORRADE_COMPARE(conf.valueCount(), 1);
+    CORRADE_VERIFY(conf.hasValue("key"));
+    CORRADE_VERIFY(!conf.hasValue("keyNonexistent"));
+    CORRADE_COMPARE(conf.value("key"), "value");
+    CORRADE_COMPARE(conf.group("group")->value("a"), "value3");
+    CORRADE_COMPARE(conf.group("group", 1)->valueCount("c"), 2);
+    CORRADE_COMPARE_AS(conf.group("group", 1)->values("c"),
+        (std::vector<std::string>{"value4", "value5"}), TestSuite::Compare::Container);
+
+    /* Including comments, so saving gives back the original */
+    std::ostringstream out;
+    conf.save(out);
+    CORRADE_COMPARE_AS(out.str(),
+        Directory::join(CONFIGURATION_TEST_DIR, "parse.conf"),
+        TestSuite::Compare::StringToFile);
+}
+
+void ConfigurationTest::readonlyMultiLineValue() {
+    Configuration conf(Directory::join(CONFIGURATION_TEST_DIR, "multiLine.conf"), Configuration::Flag::ReadOnly);
+    CORRADE_VERIFY(conf.isValid());
+
+    /* Multi-line values are decoded on access */
+    CORRADE_COMPARE(conf.value("value"), " Hello\n people how\n are you?");
+    CORRADE_COMPARE(conf.value("empty"), "");
+
+    std::ostringstream out;
+    conf.save(out);
+    CORRADE_COMPARE_AS(out.str(),
+        Directory::join(CONFIGURATION_TEST_DIR, "multiLine-saved.conf"),
+        TestSuite::Compare::StringToFile);
+}
+
+void ConfigurationTest::readonlyMultiLineValueCrlf() {
+    Configuration conf(Directory::join(CONFIGURATION_TEST_DIR, "multiLine-crlf.conf"), Configuration::Flag::ReadOnly);
+    CORRADE_VERIFY(conf.isValid());
+
+    /* The CRs should get stripped on access as well */
+    CORRADE_COMPARE(conf.value("value"), " Hello\n people how\n are you?");
+
+    std::ostringstream out;
+    conf.save(out);
+    CORRADE_COMPARE_AS(out.str(),
+        Directory::join(CONFIGURATION_TEST_DIR, "multiLine-crlf-saved.conf"),
+        TestSuite::Compare::StringToFile);
+}
+
+void ConfigurationTest::readonlyModify() {
+    Configuration conf(Directory::join(CONFIGURATION_TEST_DIR, "parse.conf"), Configuration::Flag::ReadOnly);
+    CORRADE_VERIFY(conf.isValid());
+
+    /* Overwriting a mapped value, adding a new one next to mapped ones */
+    CORRADE_VERIFY(conf.setValue("key", "another"));
+    CORRADE_VERIFY(conf.group("group", 1)->setValue("c", "value6", 1));
+    conf.group("group", 1)->addValue("c", "value7");
+    conf.group("group")->removeValue("b");
+
+    CORRADE_COMPARE(conf.value("key"), "another");
+    CORRADE_COMPARE_AS(conf.group("group", 1)->values("c"),
+        (std::vector<std::string>{"value4", "value6", "value7"}), TestSuite::Compare::Container);
+    CORRADE_VERIFY(!conf.group("group")->hasValue("b"));
+    CORRADE_COMPARE(conf.group("group")->value("a"), "value3");
+}
+
+void ConfigurationTest::readonlyCopyMove() {
+    Containers::Pointer<ConfigurationGroup> copied, moved;
+    Containers::Pointer<Configuration> confMoved;
+    {
+        Configuration conf(Directory::join(CONFIGURATION_TEST_DIR, "multiLine.conf"), Configuration::Flag::ReadOnly);
+        CORRADE_VERIFY(conf.isValid());
+
+        /* Copy and move of a group detaches the values from the mapped file,
+           so they're usable even after the configuration is gone */
+        copied.reset(new ConfigurationGroup{conf});
+        {
+            Configuration another(Directory::join(CONFIGURATION_TEST_DIR, "parse.conf"), Configuration::Flag::ReadOnly);
+            moved.reset(new ConfigurationGroup{std::move(*another.group("group", 1))});
+        }
+
+        /* Moving the whole configuration keeps the mapping alive */
+        confMoved.reset(new Configuration{std::move(conf)});
+        CORRADE_VERIFY(conf.isEmpty());
+    }
+
+    CORRADE_COMPARE(copied->value("value"), " Hello\n people how\n are you?");
+    CORRADE_COMPARE_AS(moved->values("c"),
+        (std::vector<std::string>{"value4", "value5"}), TestSuite::Compare::Container);
+    CORRADE_COMPARE(confMoved->value("value"), " Hello\n people how\n are you?");
+
+    /* Move assignment releases the previous mapping only after the values
+       that reference it */
+    Configuration confAssigned(Directory::join(CONFIGURATION_TEST_DIR, "parse.conf"), Configuration::Flag::ReadOnly);
+    CORRADE_COMPARE(confAssigned.value("key"), "value");
+    confAssigned = std::move(*confMoved);
+    CORRADE_VERIFY(confAssigned.configuration() == &confAssigned);
+    CORRADE_VERIFY(!confAssigned.hasValue("key"));
+    CORRADE_COMPARE(confAssigned.value("value"), " Hello\n people how\n are you?");
+}
+
+void ConfigurationTest::readonlyEmptyFile() {
+    const std::string filename = Directory::join(CONFIGURATION_WRITE_TEST_DIR, "empty.conf");
+    CORRADE_VERIFY(Directory::writeString(filename, ""));
+
+    /* Empty files can't be mapped, this should silently fall back to reading
+       the file */
+    std::ostringstream out;
+    Error redirectError{&out};
+    Configuration conf(filename, Configuration::Flag::ReadOnly);
+    CORRADE_VERIFY(conf.isValid());
+    CORRADE_VERIFY(conf.isEmpty());
+    CORRADE_COMPARE(out.str(), "");
 }
 
 void ConfigurationTest::nonexistentFile() {
@@ -406,6 +902,319 @@ void ConfigurationTest::truncate() {
                        "", TestSuite::Compare::FileToString);
 }
 
+void ConfigurationTest::atomicSave() {
+    const std::string filename = Directory::join(CONFIGURATION_WRITE_TEST_DIR, "atomic.conf");
+    CORRADE_VERIFY(Directory::writeString(filename, "previous=contents\n"));
+
+    {
+        Configuration conf(filename, Configuration::Flag::AtomicSave);
+        CORRADE_VERIFY(conf.isValid());
+        conf.setValue("previous", "replaced");
+        conf.addGroup("group")->setValue("multi", "a\nb");
+        CORRADE_VERIFY(conf.save());
+
+        /* The temporary file is renamed over the original */
+        CORRADE_VERIFY(!Directory::exists(filename + ".tmp"));
+        CORRADE_COMPARE_AS(filename,
+            "previous=replaced\n"
+            "[group]\n"
+            "multi=\"\"\"\n"
+            "a\n"
+            "b\n"
+            "\"\"\"\n", TestSuite::Compare::FileToString);
+
+        /* Change again, the destructor saves the same way */
+        conf.setValue("previous", "again");
+    }
+
+    CORRADE_VERIFY(!Directory::exists(filename + ".tmp"));
+    CORRADE_COMPARE_AS(filename,
+        "previous=again\n"
+        "[group]\n"
+        "multi=\"\"\"\n"
+        "a\n"
+        "b\n"
+        "\"\"\"\n", TestSuite::Compare::FileToString);
+}
+
+void ConfigurationTest::atomicSaveFailed() {
+    Configuration conf{Configuration::Flag::AtomicSave};
+    conf.setValue("a", "b");
+
+    const std::string filename = Directory::join(CONFIGURATION_WRITE_TEST_DIR, "nonexistent/atomic.conf");
+
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        CORRADE_VERIFY(!conf.save(filename));
+    }
+    CORRADE_VERIFY(!Directory::exists(filename + ".tmp"));
+    CORRADE_COMPARE(out.str(),
+        "Utility::Directory::write(): can't open " + filename + ".tmp\n"
+        "Utility::Configuration::save(): cannot open file " + filename + "\n");
+}
+
+void ConfigurationTest::incrementalSave() {
+    /* Irregular whitespace and a missing newline at the end, which a full
+       save would normalize, so it's visible what got copied */
+    std::istringstream in{
+        "  a =  b\n"
+        "# comment\n"
+        "[group]\n"
+        "  c=d\n"
+        "[group/sub]\n"
+        "e  =f\n"
+        "[last]\n"
+        "g= h"};
+    Configuration conf{in, Configuration::Flag::IncrementalSave};
+    CORRADE_VERIFY(conf.isValid());
+
+    {
+        std::ostringstream out;
+        conf.save(out);
+        CORRADE_COMPARE(out.str(),
+            "  a =  b\n"
+            "# comment\n"
+            "[group]\n"
+            "  c=d\n"
+            "[group/sub]\n"
+            "e  =f\n"
+            "[last]\n"
+            "g= h\n");
+    }
+
+    /* Only the modified group is serialized again, its subgroup not */
+    conf.group("group")->setValue("c", "new");
+    {
+        std::ostringstream out;
+        conf.save(out);
+        CORRADE_COMPARE(out.str(),
+            "  a =  b\n"
+            "# comment\n"
+            "[group]\n"
+            "c=new\n"
+            "[group/sub]\n"
+            "e  =f\n"
+            "[last]\n"
+            "g= h\n");
+    }
+
+    /* The previous output is reused on the next save */
+    conf.group("last")->addValue("i", "j");
+    conf.removeValue("a");
+    {
+        std::ostringstream out;
+        conf.save(out);
+        CORRADE_COMPARE(out.str(),
+            "# comment\n"
+            "[group]\n"
+            "c=new\n"
+            "[group/sub]\n"
+            "e  =f\n"
+            "[last]\n"
+            "g=h\n"
+            "i=j\n");
+    }
+
+    /* Adding a group doesn't affect values of the parent */
+    conf.addGroup("another")->setValue("k", "l");
+    conf.group("group")->group("sub")->clear();
+    conf.group("group")->group("sub")->setValue("e", " spaces ");
+    {
+        std::ostringstream out;
+        conf.save(out);
+        CORRADE_COMPARE(out.str(),
+            "# comment\n"
+            "[group]\n"
+            "c=new\n"
+            "[group/sub]\n"
+            "e=\" spaces \"\n"
+            "[last]\n"
+            "g=h\n"
+            "i=j\n"
+            "[another]\n"
+            "k=l\n");
+    }
+}
+
+void ConfigurationTest::incrementalSaveUnmodified() {
+    for(const char* name: {"parse.conf", "hierarchic.conf", "hierarchic-shortcuts.conf", "multiLine.conf", "multiLine-crlf.conf", "comments.conf", "whitespaces.conf", "eol-windows.conf", "eol-mixed.conf", "bom.conf"}) {
+        const std::string filename = Directory::join(CONFIGURATION_TEST_DIR, name);
+
+        /* The copied data have to parse the same as a full save would
+           produce */
+        std::ostringstream expected;
+        Configuration{filename, Configuration::Flag::PreserveBom}.save(expected);
+
+        std::ostringstream incremental;
+        Configuration{filename, Configuration::Flag::PreserveBom|Configuration::Flag::IncrementalSave}.save(incremental);
+
+        std::istringstream in{incremental.str()};
+        std::ostringstream actual;
+        Configuration{in, Configuration::Flag::PreserveBom}.save(actual);
+        CORRADE_COMPARE(actual.str(), expected.str());
+    }
+}
+
+void ConfigurationTest::incrementalSaveMove() {
+    Containers::Pointer<Configuration> a;
+    {
+        std::istringstream in{"a =b\n[group]\nc= d\n"};
+        a.emplace(in, Configuration::Flag::IncrementalSave);
+    }
+
+    /* The copied values are still valid after moving the configuration
+       around */
+    Configuration b{std::move(*a)};
+    a = nullptr;
+    Configuration c;
+    c = std::move(b);
+
+    std::ostringstream out;
+    c.save(out);
+    CORRADE_COMPARE(out.str(), "a =b\n[group]\nc= d\n");
+
+    /* The moved-out instance is empty and doesn't reuse anything */
+    std::ostringstream outMoved;
+    b.save(outMoved);
+    CORRADE_COMPARE(outMoved.str(), "");
+}
+
+void ConfigurationTest::binary() {
+    for(const char* name: {"parse.conf", "hierarchic.conf", "multiLine.conf", "comments.conf", "eol-windows.conf", "bom.conf"}) {
+        Configuration conf{Directory::join(CONFIGURATION_TEST_DIR, name), Configuration::Flag::PreserveBom};
+        CORRADE_VERIFY(conf.isValid());
+
+        const Containers::Array<char> binary = conf.toBinary();
+        CORRADE_VERIFY(binary);
+
+        std::istringstream in{std::string{binary.data(), binary.size()}};
+        Configuration loaded{in, Configuration::Flag::PreserveBom};
+        CORRADE_VERIFY(loaded.isValid());
+
+        /* The text representation is the same, including comments, EOL style
+           and BOM */
+        std::ostringstream expected, actual;
+        conf.save(expected);
+        loaded.save(actual);
+        CORRADE_COMPARE(actual.str(), expected.str());
+
+        /* Converting back to binary gives the same data again */
+        const Containers::Array<char> binaryAgain = loaded.toBinary();
+        CORRADE_COMPARE(Containers::StringView{binaryAgain}, Containers::StringView{binary});
+    }
+}
+
+void ConfigurationTest::binaryReadOnly() {
+    /* Not opening the file directly as it'd get overwritten on destruction */
+    std::istringstream in{Directory::readString(Directory::join(CONFIGURATION_TEST_DIR, "hierarchic.conf"))};
+    Configuration original{in};
+    CORRADE_VERIFY(original.isValid());
+    original.group("z")->group("x")->setValue("multi", "a\nb\n c");
+
+    const std::string filename = Directory::join(CONFIGURATION_WRITE_TEST_DIR, "hierarchic.bin");
+    CORRADE_VERIFY(original.saveBinary(filename));
+
+    Configuration conf{filename, Configuration::Flag::ReadOnly};
+    CORRADE_VERIFY(conf.isValid());
+    CORRADE_COMPARE(conf.groupCount("a"), 2);
+    CORRADE_COMPARE(conf.group("a", 1)->group("b")->value("key2"), "val5");
+    CORRADE_COMPARE(conf.group("z")->group("x")->value("multi"), "a\nb\n c");
+    CORRADE_COMPARE(conf.group("z")->group("x")->group("c")->group("v")->value("key1"), "val1");
+
+    std::ostringstream expected, actual;
+    original.save(expected);
+    conf.save(actual);
+    CORRADE_COMPARE(actual.str(), expected.str());
+}
+
+void ConfigurationTest::binarySkipComments() {
+    Configuration original{Directory::join(CONFIGURATION_TEST_DIR, "comments.conf")};
+    CORRADE_VERIFY(original.isValid());
+
+    const Containers::Array<char> binary = original.toBinary();
+    std::istringstream in{std::string{binary.data(), binary.size()}};
+    Configuration conf{in, Configuration::Flag::SkipComments};
+    CORRADE_VERIFY(conf.isValid());
+
+    std::ostringstream expected, actual;
+    Configuration{Directory::join(CONFIGURATION_TEST_DIR, "comments.conf"), Configuration::Flag::SkipComments}.save(expected);
+    conf.save(actual);
+    CORRADE_COMPARE(actual.str(), expected.str());
+}
+
+void ConfigurationTest::binarySave() {
+    const std::string filename = Directory::join(CONFIGURATION_WRITE_TEST_DIR, "atomic.bin");
+    if(Directory::exists(filename)) CORRADE_VERIFY(Directory::rm(filename));
+
+    {
+        Configuration conf{Configuration::Flag::AtomicSave};
+        conf.setValue("key", "value");
+        conf.addGroup("group")->setValue("another", "value");
+        CORRADE_VERIFY(conf.saveBinary(filename));
+        CORRADE_VERIFY(!Directory::exists(filename + ".tmp"));
+    }
+
+    /* A configuration loaded from binary data is saved as binary again */
+    {
+        Configuration conf{filename};
+        CORRADE_VERIFY(conf.isValid());
+        CORRADE_COMPARE(conf.value("key"), "value");
+        CORRADE_COMPARE(conf.group("group")->value("another"), "value");
+        conf.setValue("key", "changed");
+    }
+
+    const Containers::Array<char> data = Directory::read(filename);
+    CORRADE_VERIFY(Containers::StringView{data}.hasPrefix("\x89" "CFG"));
+
+    Configuration conf{filename};
+    CORRADE_VERIFY(conf.isValid());
+    CORRADE_COMPARE(conf.value("key"), "changed");
+    CORRADE_COMPARE(conf.group("group")->value("another"), "value");
+}
+
+void ConfigurationTest::binaryInvalid() {
+    Configuration original;
+    original.setValue("key", "value");
+    original.addGroup("group")->setValue("another", "value");
+    const Containers::Array<char> binary = original.toBinary();
+    const std::string data{binary.data(), binary.size()};
+
+    auto parse = [](std::string data) {
+        std::istringstream in{data};
+        Configuration conf{in};
+        /* Nothing partially parsed is kept */
+        return conf.isValid() || !conf.isEmpty();
+    };
+
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        /* Truncated header */
+        CORRADE_VERIFY(!parse(data.substr(0, 12)));
+        /* Truncated data */
+        CORRADE_VERIFY(!parse(data.substr(0, data.size() - 1)));
+        /* Unknown version */
+        std::string version = data;
+        version[4] = '\x02';
+        CORRADE_VERIFY(!parse(version));
+        /* Value string out of the string table */
+        std::string string = data;
+        string[24 + 2*24 + 8] = '\x7f';
+        CORRADE_VERIFY(!parse(string));
+        /* Root group referencing itself as a child */
+        std::string hierarchy = data;
+        hierarchy[24 + 16] = '\x00';
+        CORRADE_VERIFY(!parse(hierarchy));
+    }
+    CORRADE_COMPARE(out.str(),
+        "Utility::Configuration::Configuration(): truncated binary header\n"
+        "Utility::Configuration::Configuration(): binary data size mismatch\n"
+        "Utility::Configuration::Configuration(): unsupported binary format version\n"
+        "Utility::Configuration::Configuration(): invalid binary string range\n"
+        "Utility::Configuration::Configuration(): invalid binary group hierarchy\n");
+}
+
 void ConfigurationTest::whitespaces() {
     Configuration conf(Directory::join(CONFIGURATION_TEST_DIR, "whitespaces.conf"));
     conf.setFilename(Directory::join(CONFIGURATION_WRITE_TEST_DIR, "whitespaces.conf"));
@@ -613,6 +1422,115 @@ void ConfigurationTest::move() {
     CORRADE_VERIFY(confAssignedMove.group("group")->configuration() == &confAssignedMove);
 }
 
+namespace {
+
+std::string manyValues() {
+    std::string out;
+    for(std::size_t i = 0; i != 2000; ++i)
+        out += "key" + std::to_string(i) + "=" + std::to_string(i) + "\n";
+    return out;
+}
+
+}
+
+void ConfigurationTest::benchmarkLookup() {
+    std::istringstream in{manyValues()};
+    Configuration conf{in};
+
+    int sum = 0;
+    CORRADE_BENCHMARK(10)
+        for(std::size_t i = 0; i < 2000; i += 100)
+            sum += conf.value<int>("key" + std::to_string(i));
+
+    CORRADE_COMPARE(sum, 10*19000);
+}
+
+void ConfigurationTest::benchmarkLookupHashed() {
+    std::istringstream in{manyValues()};
+    Configuration conf{in, Configuration::Flag::HashedLookup};
+
+    int sum = 0;
+    CORRADE_BENCHMARK(10)
+        for(std::size_t i = 0; i < 2000; i += 100)
+            sum += conf.value<int>("key" + std::to_string(i));
+
+    CORRADE_COMPARE(sum, 10*19000);
+}
+
+void ConfigurationTest::benchmarkLookupCached() {
+    std::istringstream in{manyValues()};
+    Configuration conf{in, Configuration::Flag::HashedLookup|Configuration::Flag::CacheTypedValues};
+
+    int sum = 0;
+    CORRADE_BENCHMARK(10)
+        for(std::size_t i = 0; i < 2000; i += 100)
+            sum += conf.value<int>("key" + std::to_string(i));
+
+    CORRADE_COMPARE(sum, 10*19000);
+}
+
+void ConfigurationTest::benchmarkParse() {
+    const std::string filename = Directory::join(CONFIGURATION_WRITE_TEST_DIR, "many-values.conf");
+    CORRADE_VERIFY(Directory::writeString(filename, manyValues()));
+
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(10)
+        count += Configuration{filename}.valueCount();
+
+    CORRADE_COMPARE(count, 10*2000);
+}
+
+void ConfigurationTest::benchmarkParseReadOnly() {
+    const std::string filename = Directory::join(CONFIGURATION_WRITE_TEST_DIR, "many-values.conf");
+    CORRADE_VERIFY(Directory::writeString(filename, manyValues()));
+
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(10)
+        count += Configuration{filename, Configuration::Flag::ReadOnly}.valueCount();
+
+    CORRADE_COMPARE(count, 10*2000);
+}
+
+void ConfigurationTest::benchmarkParseBinary() {
+    const std::string filename = Directory::join(CONFIGURATION_WRITE_TEST_DIR, "many-values.bin");
+    {
+        std::istringstream in{manyValues()};
+        CORRADE_VERIFY(Configuration{in}.saveBinary(filename));
+    }
+
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(10)
+        count += Configuration{filename, Configuration::Flag::ReadOnly}.valueCount();
+
+    CORRADE_COMPARE(count, 10*2000);
+}
+
+void ConfigurationTest::benchmarkSave() {
+    std::istringstream in{manyValues()};
+    Configuration conf{in};
+
+    const std::string filename = Directory::join(CONFIGURATION_WRITE_TEST_DIR, "many-values-saved.conf");
+    bool saved = true;
+    CORRADE_BENCHMARK(10)
+        saved = conf.save(filename) && saved;
+
+    CORRADE_VERIFY(saved);
+    CORRADE_COMPARE_AS(filename, manyValues(), TestSuite::Compare::FileToString);
+}
+
+void ConfigurationTest::benchmarkSaveIncremental() {
+    std::istringstream in{manyValues()};
+    Configuration conf{in, Configuration::Flag::IncrementalSave};
+
+    const std::string filename = Directory::join(CONFIGURATION_WRITE_TEST_DIR, "many-values-saved-incremental.conf");
+    bool saved = true;
+    CORRADE_BENCHMARK(10)
+        saved = conf.save(filename) && saved;
+
+    CORRADE_VERIFY(saved);
+    CORRADE_COMPARE_AS(filename, manyValues(), TestSuite::Compare::FileToString);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Corrade::Utility::Test::ConfigurationTest)
@@ -0,0 +1,142 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/Utility/Cpu.h"
+#include "Corrade/Utility/DebugStl.h"
+
+namespace Corrade { namespace Utility { namespace Test { namespace {
+
+struct CpuTest: TestSuite::Tester {
+    explicit CpuTest();
+
+    void compiledFeatures();
+    void runtimeFeatures();
+
+    void dispatch();
+    void dispatchFallback();
+    void dispatchRuntime();
+
+    void debugFeature();
+    void debugFeatures();
+};
+
+CpuTest::CpuTest() {
+    addTests({&CpuTest::compiledFeatures,
+              &CpuTest::runtimeFeatures,
+
+              &CpuTest::dispatch,
+              &CpuTest::dispatchFallback,
+              &CpuTest::dispatchRuntime,
+
+              &CpuTest::debugFeature,
+              &CpuTest::debugFeatures});
+}
+
+void CpuTest::compiledFeatures() {
+    constexpr Cpu::Features features = Cpu::compiledFeatures();
+    Debug{} << "Compiled with:" << features;
+
+    #if defined(CORRADE_TARGET_X86) && (defined(__x86_64__) || defined(_M_X64))
+    CORRADE_VERIFY(features & Cpu::Feature::Sse2);
+    #elif defined(__aarch64__) || defined(_M_ARM64)
+    CORRADE_VERIFY(features & Cpu::Feature::Neon);
+    #else
+    CORRADE_VERIFY(true);
+    #endif
+}
+
+void CpuTest::runtimeFeatures() {
+    const Cpu::Features features = Cpu::runtimeFeatures();
+    Debug{} << "Running with:" << features;
+
+    /* Everything we're compiled for has to be there, otherwise we wouldn't
+       even get here */
+    CORRADE_COMPARE(features & Cpu::compiledFeatures(), Cpu::compiledFeatures());
+
+    /* The value is cached */
+    CORRADE_COMPARE(Cpu::runtimeFeatures(), features);
+
+    /* Features implied by each other */
+    if(features & (Cpu::Feature::Avx512bw|Cpu::Feature::Avx512vl))
+        CORRADE_VERIFY(features & Cpu::Feature::Avx512f);
+    if(features & Cpu::Feature::Avx512f)
+        CORRADE_VERIFY(features & Cpu::Feature::Avx2);
+    if(features & Cpu::Feature::Avx)
+        CORRADE_VERIFY(features & Cpu::Feature::Sse42);
+}
+
+int one() { return 1; }
+int two() { return 2; }
+int three() { return 3; }
+
+void CpuTest::dispatch() {
+    /* The first variant that matches is picked, even if a later one would
+       match too */
+    CORRADE_COMPARE(Cpu::dispatch(Cpu::Feature::Sse2|Cpu::Feature::Sse41|Cpu::Feature::Avx2, {
+        {Cpu::Feature::Avx2|Cpu::Feature::Fma, three},
+        {Cpu::Feature::Sse41, two},
+        {Cpu::Feature::Sse2, one}
+    }, one)(), 2);
+
+    CORRADE_COMPARE(Cpu::dispatch(Cpu::Feature::Sse2|Cpu::Feature::Avx2|Cpu::Feature::Fma, {
+        {Cpu::Feature::Avx2|Cpu::Feature::Fma, three},
+        {Cpu::Feature::Sse41, two}
+    }, one)(), 3);
+}
+
+void CpuTest::dispatchFallback() {
+    CORRADE_COMPARE(Cpu::dispatch(Cpu::Feature::Neon, {
+        {Cpu::Feature::Avx2, three},
+        {Cpu::Feature::Sse41, two}
+    }, one)(), 1);
+
+    CORRADE_COMPARE(Cpu::dispatch(Cpu::Feature::Neon, {}, one)(), 1);
+}
+
+void CpuTest::dispatchRuntime() {
+    const int expected = Cpu::runtimeFeatures() & Cpu::Feature::Sse2 ? 2 : 1;
+    CORRADE_COMPARE(Cpu::dispatch({
+        {Cpu::Feature::Sse2, two}
+    }, one)(), expected);
+}
+
+void CpuTest::debugFeature() {
+    std::ostringstream out;
+    Debug{&out} << Cpu::Feature::Avx512bw << Cpu::Feature(0xdead);
+    CORRADE_COMPARE(out.str(), "Utility::Cpu::Feature::Avx512bw Utility::Cpu::Feature(0xdead)\n");
+}
+
+void CpuTest::debugFeatures() {
+    std::ostringstream out;
+    Debug{&out} << (Cpu::Feature::Sse2|Cpu::Feature::Neon) << Cpu::Features{};
+    CORRADE_COMPARE(out.str(), "Utility::Cpu::Feature::Sse2|Utility::Cpu::Feature::Neon Utility::Cpu::Features{}\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Utility::Test::CpuTest)
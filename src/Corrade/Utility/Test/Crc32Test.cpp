@@ -0,0 +1,259 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifdef _MSC_VER
+#include <algorithm> /* std::min() */
+#endif
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/Utility/Crc32.h"
+#include "Corrade/Utility/DebugStl.h"
+#include "Corrade/Utility/Implementation/crc32.h"
+
+namespace Corrade { namespace Utility { namespace Test { namespace {
+
+struct Crc32Test: TestSuite::Tester {
+    explicit Crc32Test();
+
+    void empty();
+    void check();
+    void digest();
+    void digestC();
+
+    void iterative();
+    void iterativeC();
+    void reuse();
+    void initial();
+    void combine();
+    void combineC();
+
+    void variant();
+
+    void benchmark();
+};
+
+const struct {
+    const char* name;
+    Implementation::Crc32UpdateFunction(*pick)(Cpu::Features);
+    Cpu::Features features;
+} VariantData[]{
+    {"CRC-32, scalar", Implementation::crc32UpdateFunction, {}},
+    #ifdef CORRADE_TARGET_X86
+    {"CRC-32, PCLMUL", Implementation::crc32UpdateFunction, Cpu::Feature::Pclmul},
+    #endif
+    #ifdef CORRADE_TARGET_ARM
+    {"CRC-32, ARM", Implementation::crc32UpdateFunction, Cpu::Feature::ArmCrc32},
+    #endif
+    {"CRC-32C, scalar", Implementation::crc32cUpdateFunction, {}},
+    #ifdef CORRADE_TARGET_X86
+    {"CRC-32C, SSE4.2", Implementation::crc32cUpdateFunction, Cpu::Feature::Sse42},
+    #endif
+    #ifdef CORRADE_TARGET_ARM
+    {"CRC-32C, ARM", Implementation::crc32cUpdateFunction, Cpu::Feature::ArmCrc32},
+    #endif
+};
+
+Crc32Test::Crc32Test() {
+    addTests({&Crc32Test::empty,
+              &Crc32Test::check,
+              &Crc32Test::digest,
+              &Crc32Test::digestC});
+
+    addRepeatedTests({&Crc32Test::iterative,
+                      &Crc32Test::iterativeC}, 128);
+
+    addTests({&Crc32Test::reuse,
+              &Crc32Test::initial,
+              &Crc32Test::combine,
+              &Crc32Test::combineC});
+
+    addInstancedTests({&Crc32Test::variant},
+        Containers::arraySize(VariantData));
+
+    addInstancedBenchmarks({&Crc32Test::benchmark}, 10,
+        Containers::arraySize(VariantData));
+}
+
+constexpr const char Data[] =
+    "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do "
+    "eiusmod tempor incididunt ut labore et dolore magna aliqua. Ut enim "
+    "ad minim veniam, quis nostrud exercitation ullamco laboris nisi ut "
+    "aliquip ex ea commodo consequat. Duis aute irure dolor in "
+    "reprehenderit in voluptate velit esse cillum dolore eu fugiat nulla "
+    "pariatur. Excepteur sint occaecat cupidatat non proident, sunt in "
+    "culpa qui officia deserunt mollit anim id est laborum.";
+
+const Containers::ArrayView<const char> String{Data, sizeof(Data) - 1};
+
+void Crc32Test::empty() {
+    CORRADE_COMPARE(Crc32::checksum({}), 0);
+    CORRADE_COMPARE(Crc32c::checksum({}), 0);
+    CORRADE_COMPARE(Crc32{}.value(), 0);
+    CORRADE_COMPARE(Crc32c{}.value(), 0);
+    CORRADE_COMPARE(Crc32::digest(""), Crc32::Digest{});
+    CORRADE_COMPARE(Crc32c::digest(""), Crc32c::Digest{});
+}
+
+void Crc32Test::check() {
+    /* The standard check values */
+    CORRADE_COMPARE(Crc32::checksum(Containers::arrayView("123456789", 9)), 0xcbf43926);
+    CORRADE_COMPARE(Crc32c::checksum(Containers::arrayView("123456789", 9)), 0xe3069283);
+
+    CORRADE_COMPARE(Crc32::checksum(String), 0x98b2c5bd);
+    CORRADE_COMPARE(Crc32c::checksum(String), 0x95dc2e4b);
+}
+
+void Crc32Test::digest() {
+    /* Big-endian, matching the output of the crc32 utility */
+    CORRADE_COMPARE(Crc32::digest("The quick brown fox jumps over the lazy dog"),
+        Crc32::Digest::fromHexString("414fa339"));
+    CORRADE_COMPARE(Crc32::digest("The quick brown fox jumps over the lazy dog").hexString(), "414fa339");
+}
+
+void Crc32Test::digestC() {
+    CORRADE_COMPARE(Crc32c::digest("The quick brown fox jumps over the lazy dog"),
+        Crc32c::Digest::fromHexString("22620404"));
+}
+
+void Crc32Test::iterative() {
+    Crc32 hasher;
+    for(std::size_t offset = 0; offset < String.size(); offset += testCaseRepeatId() + 1)
+        hasher << String.slice(offset, std::min(offset + testCaseRepeatId() + 1, String.size()));
+
+    CORRADE_COMPARE(hasher.value(), 0x98b2c5bd);
+}
+
+void Crc32Test::iterativeC() {
+    Crc32c hasher;
+    for(std::size_t offset = 0; offset < String.size(); offset += testCaseRepeatId() + 1)
+        hasher << String.slice(offset, std::min(offset + testCaseRepeatId() + 1, String.size()));
+
+    CORRADE_COMPARE(hasher.value(), 0x95dc2e4b);
+}
+
+void Crc32Test::reuse() {
+    Crc32 hasher;
+    hasher << String;
+    CORRADE_COMPARE(hasher.value(), 0x98b2c5bd);
+    /* Querying the value doesn't reset */
+    CORRADE_COMPARE(hasher.value(), 0x98b2c5bd);
+    CORRADE_COMPARE(hasher.digest(), Crc32::Digest::fromHexString("98b2c5bd"));
+
+    /* Second time the digest is of an empty input */
+    CORRADE_COMPARE(hasher.digest(), Crc32::Digest{});
+
+    /* Filling again, it gives the same output */
+    hasher << String;
+    CORRADE_COMPARE(hasher.digest(), Crc32::Digest::fromHexString("98b2c5bd"));
+}
+
+void Crc32Test::initial() {
+    const std::uint32_t first = Crc32::checksum(String.prefix(100));
+    CORRADE_COMPARE(Crc32::checksum(String.suffix(100), first), 0x98b2c5bd);
+    CORRADE_COMPARE((Crc32{first} << String.suffix(100)).value(), 0x98b2c5bd);
+
+    const std::uint32_t firstC = Crc32c::checksum(String.prefix(100));
+    CORRADE_COMPARE(Crc32c::checksum(String.suffix(100), firstC), 0x95dc2e4b);
+    CORRADE_COMPARE((Crc32c{firstC} << String.suffix(100)).value(), 0x95dc2e4b);
+}
+
+void Crc32Test::combine() {
+    for(std::size_t i = 0; i <= String.size(); ++i) {
+        const std::uint32_t combined = Crc32::combine(
+            Crc32::checksum(String.prefix(i)),
+            Crc32::checksum(String.suffix(i)), String.size() - i);
+        CORRADE_VERIFY(combined == 0x98b2c5bd);
+    }
+
+    /* Combining with an empty block is a no-op */
+    CORRADE_COMPARE(Crc32::combine(0x98b2c5bd, 0, 0), 0x98b2c5bd);
+}
+
+void Crc32Test::combineC() {
+    for(std::size_t i = 0; i <= String.size(); ++i) {
+        const std::uint32_t combined = Crc32c::combine(
+            Crc32c::checksum(String.prefix(i)),
+            Crc32c::checksum(String.suffix(i)), String.size() - i);
+        CORRADE_VERIFY(combined == 0x95dc2e4b);
+    }
+
+    CORRADE_COMPARE(Crc32c::combine(0x95dc2e4b, 0, 0), 0x95dc2e4b);
+}
+
+void Crc32Test::variant() {
+    auto&& data = VariantData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if((Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("Not supported on this machine.");
+
+    const Implementation::Crc32UpdateFunction function = data.pick(data.features);
+    const Implementation::Crc32UpdateFunction scalar = data.pick({});
+    if(data.features && function == scalar)
+        CORRADE_SKIP("Not compiled in.");
+
+    /* Large enough to go through all specialized code paths, various sizes
+       and offsets to test the tail handling and unaligned access */
+    Containers::Array<char> buffer{Containers::NoInit, 3*3*8192 + 333};
+    for(std::size_t i = 0; i != buffer.size(); ++i) buffer[i] = char(i*37 + (i >> 8));
+
+    for(std::size_t offset = 0; offset != 16; ++offset) {
+        for(std::size_t size: {0, 1, 7, 15, 16, 17, 63, 64, 65, 127, 128, 129, 200, 3*8192 - 1, 3*8192, 3*8192 + 77, 2*3*8192 + 333}) {
+            const std::uint32_t expected = scalar(0xffffffffu, buffer + offset, size);
+            const std::uint32_t actual = function(0xffffffffu, buffer + offset, size);
+            CORRADE_VERIFY(actual == expected);
+        }
+    }
+
+    /* A non-trivial state is taken into account */
+    CORRADE_COMPARE(function(0x12345678u, buffer, buffer.size()),
+                    scalar(0x12345678u, buffer, buffer.size()));
+}
+
+void Crc32Test::benchmark() {
+    auto&& data = VariantData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if((Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("Not supported on this machine.");
+
+    const Implementation::Crc32UpdateFunction function = data.pick(data.features);
+    if(data.features && function == data.pick({}))
+        CORRADE_SKIP("Not compiled in.");
+
+    Containers::Array<char> buffer{Containers::ValueInit, 1024*1024};
+    for(std::size_t i = 0; i != buffer.size(); ++i) buffer[i] = char(i*37);
+
+    std::uint32_t state = 0xffffffffu;
+    CORRADE_BENCHMARK(1)
+        state = function(state, buffer.data(), buffer.size());
+
+    CORRADE_VERIFY(state);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Utility::Test::Crc32Test)
@@ -0,0 +1,330 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/Utility/DebugLevel.h"
+#include "Corrade/Utility/DebugStl.h"
+
+namespace Corrade { namespace Utility { namespace Test { namespace {
+
+struct DebugLevelTest: TestSuite::Tester {
+    explicit DebugLevelTest();
+
+    void module();
+    void isEnabled();
+
+    void output();
+    void notEvaluated();
+    void unbracedIf();
+
+    void once();
+    void everyN();
+    void everyNOne();
+    void rateLimitedSeparateCallSites();
+    void rateLimitedFilteredOut();
+    void rateLimitedNotEvaluated();
+    void rateLimitedUnbracedIf();
+
+    void debugLevel();
+};
+
+DebugLevelTest::DebugLevelTest() {
+    addTests({&DebugLevelTest::module,
+              &DebugLevelTest::isEnabled,
+
+              &DebugLevelTest::output,
+              &DebugLevelTest::notEvaluated,
+              &DebugLevelTest::unbracedIf,
+
+              &DebugLevelTest::once,
+              &DebugLevelTest::everyN,
+              &DebugLevelTest::everyNOne,
+              &DebugLevelTest::rateLimitedSeparateCallSites,
+              &DebugLevelTest::rateLimitedFilteredOut,
+              &DebugLevelTest::rateLimitedNotEvaluated,
+              &DebugLevelTest::rateLimitedUnbracedIf,
+
+              &DebugLevelTest::debugLevel});
+
+    #if CORRADE_DEBUG_LEVEL != 4
+    setTestName("Corrade::Utility::Test::DebugLevelCompiledOutTest");
+    #endif
+}
+
+void DebugLevelTest::module() {
+    constexpr DebugModule a{"a"};
+    constexpr const char* name = a.name();
+    constexpr DebugLevel level = a.level();
+    CORRADE_COMPARE(name, std::string{"a"});
+    CORRADE_COMPARE(level, DebugLevel::Debug);
+
+    DebugModule b{"b", DebugLevel::Warning};
+    CORRADE_COMPARE(b.level(), DebugLevel::Warning);
+
+    b.setLevel(DebugLevel::None);
+    CORRADE_COMPARE(b.level(), DebugLevel::None);
+}
+
+void DebugLevelTest::isEnabled() {
+    constexpr DebugModule a{"a", DebugLevel::Warning};
+    constexpr bool error = a.isEnabled(DebugLevel::Error);
+    constexpr bool warning = a.isEnabled(DebugLevel::Warning);
+    constexpr bool debug = a.isEnabled(DebugLevel::Debug);
+    CORRADE_VERIFY(error);
+    CORRADE_VERIFY(warning);
+    CORRADE_VERIFY(!debug);
+    CORRADE_VERIFY(a.isEnabled(DebugLevel::None));
+    CORRADE_VERIFY(!a.isEnabled(DebugLevel::Verbose));
+}
+
+void DebugLevelTest::output() {
+    std::ostringstream debug, warning, error;
+    Debug redirectDebug{&debug};
+    Warning redirectWarning{&warning};
+    Error redirectError{&error};
+
+    DebugModule module{"module", DebugLevel::Verbose};
+    CORRADE_ERROR(module) << "error" << 1;
+    CORRADE_WARNING(module) << "warning" << 2;
+    CORRADE_DEBUG(module) << "debug" << 3;
+    CORRADE_VERBOSE(module) << "verbose" << 4;
+
+    module.setLevel(DebugLevel::Warning);
+    CORRADE_ERROR(module) << "error" << 5;
+    CORRADE_WARNING(module) << "warning" << 6;
+    CORRADE_DEBUG(module) << "debug" << 7;
+    CORRADE_VERBOSE(module) << "verbose" << 8;
+
+    module.setLevel(DebugLevel::None);
+    CORRADE_ERROR(module) << "error" << 9;
+
+    #if CORRADE_DEBUG_LEVEL == 4
+    CORRADE_COMPARE(debug.str(), "debug 3\nverbose 4\n");
+    #else
+    CORRADE_COMPARE(debug.str(), "");
+    #endif
+    CORRADE_COMPARE(warning.str(), "warning 2\nwarning 6\n");
+    CORRADE_COMPARE(error.str(), "error 1\nerror 5\n");
+}
+
+void DebugLevelTest::notEvaluated() {
+    std::ostringstream out;
+    Debug redirectDebug{&out};
+    Warning redirectWarning{&out};
+
+    int evaluated = 0;
+    auto expensive = [&evaluated]() {
+        ++evaluated;
+        return 42;
+    };
+
+    DebugModule module{"module", DebugLevel::Warning};
+    CORRADE_VERBOSE(module) << expensive();
+    CORRADE_DEBUG(module) << expensive();
+    CORRADE_COMPARE(evaluated, 0);
+
+    CORRADE_WARNING(module) << expensive();
+    CORRADE_COMPARE(evaluated, 1);
+
+    /* Enabling the level at runtime has no effect if it's compiled out */
+    module.setLevel(DebugLevel::Verbose);
+    CORRADE_DEBUG(module) << expensive();
+    #if CORRADE_DEBUG_LEVEL == 4
+    CORRADE_COMPARE(evaluated, 2);
+    CORRADE_COMPARE(out.str(), "42\n42\n");
+    #else
+    CORRADE_COMPARE(evaluated, 1);
+    CORRADE_COMPARE(out.str(), "42\n");
+    #endif
+}
+
+void DebugLevelTest::unbracedIf() {
+    std::ostringstream out;
+    Warning redirectWarning{&out};
+
+    DebugModule module{"module"};
+
+    /* Should not steal the else branch nor cause any warnings */
+    bool elseTaken = false;
+    if(out.str().empty())
+        CORRADE_WARNING(module) << "first";
+    else
+        elseTaken = true;
+
+    CORRADE_VERIFY(!elseTaken);
+    CORRADE_COMPARE(out.str(), "first\n");
+}
+
+void DebugLevelTest::once() {
+    std::ostringstream debug, warning, error;
+    Debug redirectDebug{&debug};
+    Warning redirectWarning{&warning};
+    Error redirectError{&error};
+
+    DebugModule module{"module", DebugLevel::Verbose};
+    for(int i = 0; i != 5; ++i) {
+        CORRADE_ERROR_ONCE(module) << "error" << i;
+        CORRADE_WARNING_ONCE(module) << "warning" << i;
+        CORRADE_DEBUG_ONCE(module) << "debug" << i;
+        CORRADE_VERBOSE_ONCE(module) << "verbose" << i;
+    }
+
+    #if CORRADE_DEBUG_LEVEL == 4
+    CORRADE_COMPARE(debug.str(), "debug 0\nverbose 0\n");
+    #else
+    CORRADE_COMPARE(debug.str(), "");
+    #endif
+    CORRADE_COMPARE(warning.str(), "warning 0\n");
+    CORRADE_COMPARE(error.str(), "error 0\n");
+}
+
+void DebugLevelTest::everyN() {
+    std::ostringstream debug, warning, error;
+    Debug redirectDebug{&debug};
+    Warning redirectWarning{&warning};
+    Error redirectError{&error};
+
+    DebugModule module{"module", DebugLevel::Verbose};
+    for(int i = 0; i != 8; ++i) {
+        CORRADE_ERROR_EVERY_N(module, 3) << "error" << i;
+        CORRADE_WARNING_EVERY_N(module, 3) << "warning" << i;
+        CORRADE_DEBUG_EVERY_N(module, 4) << "debug" << i;
+        CORRADE_VERBOSE_EVERY_N(module, 5) << "verbose" << i;
+    }
+
+    #if CORRADE_DEBUG_LEVEL == 4
+    CORRADE_COMPARE(debug.str(),
+        "debug 0\n"
+        "verbose 0\n"
+        "debug 4 (3 previous occurrences suppressed)\n"
+        "verbose 5 (4 previous occurrences suppressed)\n");
+    #else
+    CORRADE_COMPARE(debug.str(), "");
+    #endif
+    CORRADE_COMPARE(warning.str(),
+        "warning 0\n"
+        "warning 3 (2 previous occurrences suppressed)\n"
+        "warning 6 (2 previous occurrences suppressed)\n");
+    CORRADE_COMPARE(error.str(),
+        "error 0\n"
+        "error 3 (2 previous occurrences suppressed)\n"
+        "error 6 (2 previous occurrences suppressed)\n");
+}
+
+void DebugLevelTest::everyNOne() {
+    std::ostringstream out;
+    Warning redirectWarning{&out};
+
+    /* Prints everything, with no suppression note */
+    DebugModule module{"module"};
+    for(int i = 0; i != 3; ++i)
+        CORRADE_WARNING_EVERY_N(module, 1) << i;
+
+    CORRADE_COMPARE(out.str(), "0\n1\n2\n");
+}
+
+void DebugLevelTest::rateLimitedSeparateCallSites() {
+    std::ostringstream out;
+    Warning redirectWarning{&out};
+
+    /* Each call site has its own counter */
+    DebugModule module{"module"};
+    for(int i = 0; i != 3; ++i) {
+        CORRADE_WARNING_ONCE(module) << "a" << i;
+        CORRADE_WARNING_ONCE(module) << "b" << i;
+    }
+
+    CORRADE_COMPARE(out.str(), "a 0\nb 0\n");
+}
+
+void DebugLevelTest::rateLimitedFilteredOut() {
+    std::ostringstream out;
+    Warning redirectWarning{&out};
+
+    /* Occurrences filtered out by the module level don't count */
+    DebugModule module{"module", DebugLevel::None};
+    for(int i = 0; i != 6; ++i) {
+        if(i == 3) module.setLevel(DebugLevel::Warning);
+        CORRADE_WARNING_ONCE(module) << "once" << i;
+        CORRADE_WARNING_EVERY_N(module, 2) << "every 2" << i;
+    }
+
+    CORRADE_COMPARE(out.str(),
+        "once 3\n"
+        "every 2 3\n"
+        "every 2 5 (1 previous occurrences suppressed)\n");
+}
+
+void DebugLevelTest::rateLimitedNotEvaluated() {
+    std::ostringstream out;
+    Warning redirectWarning{&out};
+
+    int evaluated = 0;
+    auto expensive = [&evaluated]() {
+        ++evaluated;
+        return 42;
+    };
+
+    DebugModule module{"module"};
+    for(int i = 0; i != 10; ++i)
+        CORRADE_WARNING_EVERY_N(module, 5) << expensive();
+    CORRADE_COMPARE(evaluated, 2);
+
+    for(int i = 0; i != 10; ++i)
+        CORRADE_WARNING_ONCE(module) << expensive();
+    CORRADE_COMPARE(evaluated, 3);
+}
+
+void DebugLevelTest::rateLimitedUnbracedIf() {
+    std::ostringstream out;
+    Warning redirectWarning{&out};
+
+    DebugModule module{"module"};
+
+    /* Should not steal the else branch nor cause any warnings */
+    bool elseTaken = false;
+    for(int i = 0; i != 2; ++i) {
+        if(i == 0)
+            CORRADE_WARNING_ONCE(module) << "first";
+        else
+            elseTaken = true;
+    }
+
+    CORRADE_VERIFY(elseTaken);
+    CORRADE_COMPARE(out.str(), "first\n");
+}
+
+void DebugLevelTest::debugLevel() {
+    std::ostringstream out;
+
+    Debug{&out} << DebugLevel::Warning << DebugLevel(0xde);
+    CORRADE_COMPARE(out.str(), "Utility::DebugLevel::Warning Utility::DebugLevel(0xde)\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Utility::Test::DebugLevelTest)
@@ -23,6 +23,8 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cstdio>
+#include <cstring>
 #include <iostream>
 #include <map>
 #include <set>
@@ -30,7 +32,12 @@
 #include <string>
 #include <vector>
 
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Containers/StaticArray.h"
+#include "Corrade/Containers/StridedArrayView.h"
+#include "Corrade/Containers/StringView.h"
 #include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Numeric.h"
 #include "Corrade/Utility/Debug.h"
 #include "Corrade/Utility/DebugStl.h"
 
@@ -78,16 +85,35 @@ struct DebugTest: TestSuite::Tester {
     void tuple();
     void iterablePairPacked();
     void iterableTuplePacked();
+    void iterableArithmetic();
+    void iterableArithmeticStrided();
+    void iterableArithmeticPacked();
+    void iterableArithmeticNested();
+    void iterableArithmeticLong();
+    void iterableArithmeticElementLimit();
 
     void ostreamFallback();
     void ostreamFallbackPriority();
 
     void scopedOutput();
 
+    void writer();
+    void writerFile();
+    void writerNull();
+    void writerLong();
+    void writerColors();
+    void writerOstreamFallback();
+    void writerScoped();
+
     void debugColor();
     void debugFlag();
     void debugFlags();
 
+        void benchmarkStream();
+    void benchmarkWriter();
+    void benchmarkIterable();
+    void benchmarkIterableArithmetic();
+
     #ifndef CORRADE_TARGET_EMSCRIPTEN
     void multithreaded();
     #endif
@@ -147,12 +173,26 @@ DebugTest::DebugTest() {
         &DebugTest::tuple,
         &DebugTest::iterablePairPacked,
         &DebugTest::iterableTuplePacked,
+        &DebugTest::iterableArithmetic,
+        &DebugTest::iterableArithmeticStrided,
+        &DebugTest::iterableArithmeticPacked,
+        &DebugTest::iterableArithmeticNested,
+        &DebugTest::iterableArithmeticLong,
+        &DebugTest::iterableArithmeticElementLimit,
 
         &DebugTest::ostreamFallback,
         &DebugTest::ostreamFallbackPriority,
 
         &DebugTest::scopedOutput,
 
+        &DebugTest::writer,
+        &DebugTest::writerFile,
+        &DebugTest::writerNull,
+        &DebugTest::writerLong,
+        &DebugTest::writerColors,
+        &DebugTest::writerOstreamFallback,
+        &DebugTest::writerScoped,
+
         &DebugTest::debugColor,
         &DebugTest::debugFlag,
         &DebugTest::debugFlags,
@@ -162,6 +202,11 @@ DebugTest::DebugTest() {
         #endif
 
         &DebugTest::sourceLocation});
+
+    addBenchmarks({&DebugTest::benchmarkStream,
+                   &DebugTest::benchmarkWriter,
+                   &DebugTest::benchmarkIterable,
+                   &DebugTest::benchmarkIterableArithmetic}, 10);
 }
 
 void DebugTest::debug() {
@@ -801,6 +846,141 @@ inline Debug& operator<<(Debug& debug, const Baz&) {
     return debug << "baz from Debug";
 }
 
+namespace {
+    struct WriterState {
+        std::string out;
+        int calls = 0;
+    };
+
+    void stringWriter(void* state, const char* data, std::size_t size) {
+        static_cast<WriterState*>(state)->out.append(data, size);
+        ++static_cast<WriterState*>(state)->calls;
+    }
+}
+
+void DebugTest::iterableArithmetic() {
+    std::ostringstream out;
+    const int ints[]{1, -2, 3};
+    Debug{&out} << Containers::arrayView(ints);
+    CORRADE_COMPARE(out.str(), "{1, -2, 3}\n");
+
+    out.str({});
+    Containers::Array<float> floats{Containers::InPlaceInit, {1.5f, 0.333333333f, -3.0f}};
+    Debug{&out} << floats << Containers::StaticArray<2, double>{2.25, 1.0e20};
+    CORRADE_COMPARE(out.str(), "{1.5, 0.333333, -3} {2.25, 1e+20}\n");
+
+    out.str({});
+    const unsigned short shorts[]{65535, 0};
+    const unsigned long long longs[]{18446744073709551615ull};
+    Debug{&out} << Containers::staticArrayView(shorts) << Containers::arrayView(longs);
+    CORRADE_COMPARE(out.str(), "{65535, 0} {18446744073709551615}\n");
+
+    /* Empty views and nospace work the same as in the generic case */
+    out.str({});
+    Debug{&out} << "empty" << Debug::nospace << Containers::ArrayView<const int>{} << Containers::Array<double>{};
+    CORRADE_COMPARE(out.str(), "empty{} {}\n");
+
+    /* Character types still go through the generic path */
+    out.str({});
+    const char chars[]{'a', 'b'};
+    Debug{&out} << Containers::arrayView(chars);
+    CORRADE_COMPARE(out.str(), "{97, 98}\n");
+}
+
+void DebugTest::iterableArithmeticStrided() {
+    struct Data {
+        float a;
+        int b;
+    } data[]{{1.0f, 3}, {2.0f, 5}, {3.0f, 7}};
+
+    std::ostringstream out;
+    Debug{&out} << Containers::StridedArrayView1D<int>{data, &data[0].b, 3, sizeof(Data)}
+        << Containers::StridedArrayView1D<const float>{data, &data[0].a, 3, sizeof(Data)}.flipped<0>();
+    CORRADE_COMPARE(out.str(), "{3, 5, 7} {3, 2, 1}\n");
+
+    /* Zero stride */
+    out.str({});
+    Debug{&out} << Containers::StridedArrayView1D<const int>{data, &data[0].b, 3, 0};
+    CORRADE_COMPARE(out.str(), "{3, 3, 3}\n");
+}
+
+void DebugTest::iterableArithmeticPacked() {
+    std::ostringstream out;
+    const int ints[]{1, 2, 3};
+    Debug{&out} << Debug::packed << Containers::arrayView(ints) << Containers::arrayView(ints);
+    CORRADE_COMPARE(out.str(), "123 {1, 2, 3}\n");
+
+    out.str({});
+    Debug{&out, Debug::Flag::Packed} << Containers::arrayView(ints);
+    CORRADE_COMPARE(out.str(), "123\n");
+}
+
+void DebugTest::iterableArithmeticNested() {
+    const int a[]{1, 2, 3};
+    const int b[]{4, 5};
+
+    std::ostringstream out;
+    Debug{&out} << std::vector<Containers::ArrayView<const int>>{a, b};
+    CORRADE_COMPARE(out.str(),
+        "{{1, 2, 3},\n"
+        " {4, 5}}\n");
+
+    out.str({});
+    Debug{&out} << Debug::packed << std::vector<Containers::ArrayView<const int>>{a, b};
+    CORRADE_COMPARE(out.str(),
+        "123\n"
+        "45\n");
+}
+
+void DebugTest::iterableArithmeticLong() {
+    /* Larger than the internal buffer, should give the same output as the
+       generic path */
+    std::vector<double> values(10000);
+    for(std::size_t i = 0; i != values.size(); ++i)
+        values[i] = 1.0/(i + 1);
+
+    std::ostringstream expected;
+    Debug{&expected} << values;
+
+    {
+        std::ostringstream out;
+        Debug{&out} << Containers::arrayView(values.data(), values.size());
+        CORRADE_COMPARE(out.str().size(), expected.str().size());
+        CORRADE_VERIFY(out.str() == expected.str());
+    } {
+        WriterState out;
+        Debug{stringWriter, &out} << Containers::arrayView(values.data(), values.size());
+        CORRADE_COMPARE(out.out.size(), expected.str().size());
+        CORRADE_VERIFY(out.out == expected.str());
+    }
+}
+
+void DebugTest::iterableArithmeticElementLimit() {
+    CORRADE_COMPARE(Debug::elementLimit(), 0);
+
+    const int ints[]{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    std::ostringstream out;
+
+    Debug::setElementLimit(5);
+    Debug{&out} << Containers::arrayView(ints);
+    Debug{&out} << Debug::packed << Containers::arrayView(ints);
+    /* Exactly at the limit, printed whole */
+    Debug{&out} << Containers::arrayView(ints).prefix(5);
+    Debug::setElementLimit(1);
+    Debug{&out} << Containers::arrayView(ints);
+    /* Doesn't affect the generic path */
+    Debug{&out} << std::vector<int>{1, 2, 3};
+    Debug::setElementLimit(0);
+    Debug{&out} << Containers::arrayView(ints);
+    CORRADE_COMPARE(out.str(),
+        "{1, 2, 3, …, 9, 10}\n"
+        "123…910\n"
+        "{1, 2, 3, 4, 5}\n"
+        "{1, …}\n"
+        "{1, 2, 3}\n"
+        "{1, 2, 3, 4, 5, 6, 7, 8, 9, 10}\n");
+}
+
 void DebugTest::ostreamFallback() {
     std::ostringstream out;
     Debug(&out) << Bar{};
@@ -883,6 +1063,173 @@ void DebugTest::scopedOutput() {
     CORRADE_COMPARE(error2.str(), "smells\n");
 }
 
+void DebugTest::writer() {
+    WriterState debug, warning, error;
+
+    Debug{stringWriter, &debug} << "a" << 33 << 0.567f << -1.0/3.0 << 'c' << U'\u0004' << false << nullptr;
+    Warning{stringWriter, &warning} << "b" << 34u << 0.567 << reinterpret_cast<void*>(0xdead);
+    Error{stringWriter, &error} << "c" << -35ll << Containers::StringView{"view"} << std::string{"string"};
+
+    CORRADE_COMPARE(debug.out, "a 33 0.567 -0.333333333333333 99 U+0004 false nullptr\n");
+    CORRADE_COMPARE(warning.out, "b 34 0.567 0xdead\n");
+    CORRADE_COMPARE(error.out, "c -35 view string\n");
+
+    /* Short messages are passed to the writer in a single call */
+    CORRADE_COMPARE(debug.calls, 1);
+    CORRADE_COMPARE(warning.calls, 1);
+    CORRADE_COMPARE(error.calls, 1);
+
+    /* No newline at the end, nothing written if there's nothing printed */
+    WriterState noNewline;
+    Debug{stringWriter, &noNewline, Debug::Flag::NoNewlineAtTheEnd} << "hello";
+    Debug{stringWriter, &noNewline};
+    CORRADE_COMPARE(noNewline.out, "hello");
+    CORRADE_COMPARE(noNewline.calls, 1);
+}
+
+void DebugTest::writerFile() {
+    std::FILE* file = std::tmpfile();
+    if(!file) CORRADE_SKIP("Can't create a temporary file.");
+
+    Error{Debug::fileWriter, file} << "hello" << 42 << 1.5f;
+    Error{Debug::fileWriter, file} << "world";
+
+    const long size = std::ftell(file);
+    std::rewind(file);
+    std::string out(size, '\0');
+    CORRADE_COMPARE(std::fread(&out[0], 1, size, file), std::size_t(size));
+    std::fclose(file);
+
+    CORRADE_COMPARE(out, "hello 42 1.5\nworld\n");
+}
+
+void DebugTest::writerNull() {
+    std::ostringstream out;
+    Debug redirect{&out};
+
+    /* Null writer disables the output the same way as a null stream */
+    {
+        Debug muteD{nullptr, nullptr};
+        Debug{} << "hello";
+        Debug{} << Debug::color(Debug::Color::Red) << "colored";
+    }
+
+    Debug{} << "world";
+    CORRADE_COMPARE(out.str(), "world\n");
+}
+
+void DebugTest::writerLong() {
+    /* Longer than the internal buffer, should get passed in multiple pieces */
+    WriterState out;
+    std::string expected;
+    {
+        Debug d{stringWriter, &out};
+        for(std::size_t i = 0; i != 100; ++i) {
+            d << i;
+            expected += std::to_string(i);
+            expected += i == 99 ? '\n' : ' ';
+        }
+
+        /* A string that doesn't fit the buffer alone */
+        d << std::string(300, 'a');
+        expected.pop_back();
+        expected += ' ';
+        expected += std::string(300, 'a');
+        expected += '\n';
+    }
+
+    CORRADE_COMPARE(out.out, expected);
+    CORRADE_COMPARE_AS(out.calls, 2, TestSuite::Compare::Greater);
+}
+
+void DebugTest::writerColors() {
+    WriterState out;
+    Debug{stringWriter, &out} << "Default" << Debug::boldColor(Debug::Color::Green) << "Green";
+    Debug{stringWriter, &out, Debug::Flag::DisableColors} << Debug::color(Debug::Color::Red) << "Red";
+
+    #if defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_UTILITY_USE_ANSI_COLORS)
+    CORRADE_COMPARE(out.out, "Default Green\nRed\n");
+    #else
+    CORRADE_COMPARE(out.out, "Default\033[1;32m Green\033[0m\nRed\n");
+    #endif
+}
+
+void DebugTest::writerOstreamFallback() {
+    WriterState out;
+    Debug{stringWriter, &out} << Bar{} << Baz{};
+    CORRADE_COMPARE(out.out, "bar baz from Debug\n");
+}
+
+void DebugTest::writerScoped() {
+    WriterState debug, warning, error;
+    std::ostringstream nested;
+
+    {
+        Debug redirectD{stringWriter, &debug};
+        Warning redirectW{stringWriter, &warning};
+        Error redirectE{stringWriter, &error};
+
+        Debug{} << "hello";
+        Warning{} << "crazy";
+        Error{} << "world";
+
+        {
+            Debug redirectD2{&nested};
+            Debug{} << "nested";
+            CORRADE_VERIFY(Debug::output() == &nested);
+        }
+
+        /* The writer is restored after the nested stream is gone */
+        CORRADE_VERIFY(!Debug::output());
+        Debug{} << "again";
+    }
+
+    CORRADE_COMPARE(debug.out, "hello\nagain\n");
+    CORRADE_COMPARE(warning.out, "crazy\n");
+    CORRADE_COMPARE(error.out, "world\n");
+    CORRADE_COMPARE(nested.str(), "nested\n");
+}
+
+void DebugTest::benchmarkStream() {
+    std::ostringstream out;
+    CORRADE_BENCHMARK(1000)
+        Debug{&out} << "Value" << 1337 << "is" << 3.1415f << "and" << 0.5;
+
+    CORRADE_COMPARE(out.str().size(), 1000*std::strlen("Value 1337 is 3.1415 and 0.5\n"));
+}
+
+void DebugTest::benchmarkWriter() {
+    WriterState out;
+    CORRADE_BENCHMARK(1000)
+        Debug{stringWriter, &out} << "Value" << 1337 << "is" << 3.1415f << "and" << 0.5;
+
+    CORRADE_COMPARE(out.out.size(), 1000*std::strlen("Value 1337 is 3.1415 and 0.5\n"));
+}
+
+void DebugTest::benchmarkIterable() {
+    std::vector<float> values(10000);
+    for(std::size_t i = 0; i != values.size(); ++i)
+        values[i] = i*0.25f;
+
+    WriterState out;
+    CORRADE_BENCHMARK(1)
+        Debug{stringWriter, &out} << values;
+
+    CORRADE_VERIFY(out.out.size() > 10000*3);
+}
+
+void DebugTest::benchmarkIterableArithmetic() {
+    std::vector<float> values(10000);
+    for(std::size_t i = 0; i != values.size(); ++i)
+        values[i] = i*0.25f;
+
+    WriterState out;
+    CORRADE_BENCHMARK(1)
+        Debug{stringWriter, &out} << Containers::arrayView(values.data(), values.size());
+
+    CORRADE_VERIFY(out.out.size() > 10000*3);
+}
+
 void DebugTest::debugColor() {
     std::ostringstream out;
 
@@ -955,9 +1302,9 @@ void DebugTest::sourceLocation() {
 
     #ifdef CORRADE_UTILITY_DEBUG_HAS_SOURCE_LOCATION
     CORRADE_COMPARE(out.str(),
-        __FILE__ ":947: hello\n"
-        __FILE__ ":949: and this is from another line\n"
-        __FILE__ ":951\n"
+        __FILE__ ":1294: hello\n"
+        __FILE__ ":1296: and this is from another line\n"
+        __FILE__ ":1298\n"
         "this no longer\n");
     #else
     CORRADE_COMPARE(out.str(),
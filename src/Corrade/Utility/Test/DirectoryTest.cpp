@@ -23,17 +23,23 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cstring>
 #include <sstream>
 #include <vector>
 
 #include "Corrade/Containers/Array.h"
+#include "Corrade/Containers/GrowableArray.h"
+#include "Corrade/Containers/Optional.h"
+#include "Corrade/Containers/StringView.h"
 #include "Corrade/TestSuite/Tester.h"
 #include "Corrade/TestSuite/Compare/File.h"
 #include "Corrade/TestSuite/Compare/FileToString.h"
 #include "Corrade/TestSuite/Compare/Container.h"
 #include "Corrade/TestSuite/Compare/SortedContainer.h"
+#include "Corrade/TestSuite/Compare/Numeric.h"
 #include "Corrade/Utility/DebugStl.h"
 #include "Corrade/Utility/Directory.h"
+#include "Corrade/Utility/FormatStl.h"
 
 #include "configure.h"
 
@@ -61,6 +67,13 @@ struct DirectoryTest: TestSuite::Tester {
     void joinMultipleOneEmpty();
     void joinMultipleJustOne();
     void joinMultipleNone();
+    void pathView();
+    void filenameView();
+    void splitExtensionView();
+    void joinInto();
+    void joinIntoMultiple();
+    void joinIntoBuffer();
+    void joinIntoBufferTooSmall();
 
     void exists();
     void existsUtf8();
@@ -107,6 +120,12 @@ struct DirectoryTest: TestSuite::Tester {
     void listSort();
     void listSortPrecedence();
     void listUtf8();
+    void listEntries();
+    void listEntriesSkip();
+    void listEntriesSort();
+    void listEntriesNonexistent();
+    void listEntriesRecursive();
+    void listEntriesRecursiveSkipDirectories();
 
     void read();
     void readEmpty();
@@ -114,11 +133,29 @@ struct DirectoryTest: TestSuite::Tester {
     void readEarlyEof();
     void readNonexistent();
     void readUtf8();
+    void readIntoArray();
+    void readIntoArrayEmpty();
+    void readIntoArrayNonSeekable();
+    void readIntoArrayNonexistent();
+    void readIntoView();
+    void readIntoViewTooSmall();
+    void readIntoViewNonexistent();
+    void readOffset();
+    void readOffsetMultiple();
+    void readOffsetPastTheEnd();
+    void readOffsetNonexistent();
 
     void write();
     void writeEmpty();
     void writeNoPermission();
     void writeUtf8();
+    void writeAtomic();
+    void writeAtomicNonexistentDirectory();
+    void writeDurable();
+    void writeBatch();
+    void writeBatchNotDurable();
+    void writeBatchDiscard();
+    void writeBatchNonexistentDirectory();
 
     void append();
     void appendToNonexistent();
@@ -129,12 +166,17 @@ struct DirectoryTest: TestSuite::Tester {
     void prepareFileToCopy();
     void copy();
     void copyEmpty();
+    void copyOverwrite();
+    void copyNonSeekable();
     void copyNonexistent();
     void copyNoPermission();
     void copyUtf8();
 
     #ifndef CORRADE_TARGET_EMSCRIPTEN
     void prepareFileToBenchmarkCopy();
+    void benchmarkReadSmall();
+    void benchmarkReadSmallIntoArray();
+
     void copy100MReadWrite();
     void copy100MCopy();
     #if defined(DOXYGEN_GENERATING_OUTPUT) || defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
@@ -143,10 +185,15 @@ struct DirectoryTest: TestSuite::Tester {
     #endif
 
     void map();
+    void mapFlags();
+    void mapRange();
     void mapNonexistent();
     void mapUtf8();
 
     void mapRead();
+    void mapReadFlags();
+    void mapReadRange();
+    void mapReadRangeOutOfBounds();
     void mapReadNonexistent();
     void mapReadUtf8();
 
@@ -174,6 +221,13 @@ DirectoryTest::DirectoryTest() {
               &DirectoryTest::joinMultipleOneEmpty,
               &DirectoryTest::joinMultipleJustOne,
               &DirectoryTest::joinMultipleNone,
+              &DirectoryTest::pathView,
+              &DirectoryTest::filenameView,
+              &DirectoryTest::splitExtensionView,
+              &DirectoryTest::joinInto,
+              &DirectoryTest::joinIntoMultiple,
+              &DirectoryTest::joinIntoBuffer,
+              &DirectoryTest::joinIntoBufferTooSmall,
 
               &DirectoryTest::exists,
               &DirectoryTest::existsUtf8,
@@ -220,6 +274,12 @@ DirectoryTest::DirectoryTest() {
               &DirectoryTest::listSort,
               &DirectoryTest::listSortPrecedence,
               &DirectoryTest::listUtf8,
+              &DirectoryTest::listEntries,
+              &DirectoryTest::listEntriesSkip,
+              &DirectoryTest::listEntriesSort,
+              &DirectoryTest::listEntriesNonexistent,
+              &DirectoryTest::listEntriesRecursive,
+              &DirectoryTest::listEntriesRecursiveSkipDirectories,
 
               &DirectoryTest::read,
               &DirectoryTest::readEmpty,
@@ -227,11 +287,29 @@ DirectoryTest::DirectoryTest() {
               &DirectoryTest::readEarlyEof,
               &DirectoryTest::readNonexistent,
               &DirectoryTest::readUtf8,
+              &DirectoryTest::readIntoArray,
+              &DirectoryTest::readIntoArrayEmpty,
+              &DirectoryTest::readIntoArrayNonSeekable,
+              &DirectoryTest::readIntoArrayNonexistent,
+              &DirectoryTest::readIntoView,
+              &DirectoryTest::readIntoViewTooSmall,
+              &DirectoryTest::readIntoViewNonexistent,
+              &DirectoryTest::readOffset,
+              &DirectoryTest::readOffsetMultiple,
+              &DirectoryTest::readOffsetPastTheEnd,
+              &DirectoryTest::readOffsetNonexistent,
 
               &DirectoryTest::write,
               &DirectoryTest::writeEmpty,
               &DirectoryTest::writeNoPermission,
               &DirectoryTest::writeUtf8,
+              &DirectoryTest::writeAtomic,
+              &DirectoryTest::writeAtomicNonexistentDirectory,
+              &DirectoryTest::writeDurable,
+              &DirectoryTest::writeBatch,
+              &DirectoryTest::writeBatchNotDurable,
+              &DirectoryTest::writeBatchDiscard,
+              &DirectoryTest::writeBatchNonexistentDirectory,
 
               &DirectoryTest::append,
               &DirectoryTest::appendToNonexistent,
@@ -239,11 +317,16 @@ DirectoryTest::DirectoryTest() {
               &DirectoryTest::appendNoPermission,
               &DirectoryTest::appendUtf8});
 
+    addBenchmarks({&DirectoryTest::benchmarkReadSmall,
+                   &DirectoryTest::benchmarkReadSmallIntoArray}, 10);
+
     addTests({&DirectoryTest::copy},
              &DirectoryTest::prepareFileToCopy,
              &DirectoryTest::prepareFileToCopy);
 
     addTests({&DirectoryTest::copyEmpty,
+              &DirectoryTest::copyOverwrite,
+              &DirectoryTest::copyNonSeekable,
               &DirectoryTest::copyNonexistent,
               &DirectoryTest::copyNoPermission,
               &DirectoryTest::copyUtf8});
@@ -261,10 +344,15 @@ DirectoryTest::DirectoryTest() {
     #endif
 
     addTests({&DirectoryTest::map,
+              &DirectoryTest::mapFlags,
+              &DirectoryTest::mapRange,
               &DirectoryTest::mapNonexistent,
               &DirectoryTest::mapUtf8,
 
               &DirectoryTest::mapRead,
+              &DirectoryTest::mapReadFlags,
+              &DirectoryTest::mapReadRange,
+              &DirectoryTest::mapReadRangeOutOfBounds,
               &DirectoryTest::mapReadNonexistent,
               &DirectoryTest::mapReadUtf8,
 
@@ -414,6 +502,161 @@ void DirectoryTest::joinMultipleNone() {
     CORRADE_COMPARE(Directory::join({}), "");
 }
 
+void DirectoryTest::pathView() {
+    using namespace Containers::Literals;
+
+    /* No path */
+    CORRADE_COMPARE(Directory::pathView("foo.txt"), "");
+
+    /* No filename */
+    CORRADE_COMPARE(Directory::pathView(".corrade/configuration/"), ".corrade/configuration");
+
+    /* Common case */
+    CORRADE_COMPARE(Directory::pathView("package/map.conf"), "package");
+
+    /* The result is a view on the input */
+    const Containers::StringView in = "package/map.conf"_s;
+    CORRADE_COMPARE(static_cast<const void*>(Directory::pathView(in).data()), in.data());
+}
+
+void DirectoryTest::filenameView() {
+    using namespace Containers::Literals;
+
+    /* Path only */
+    CORRADE_COMPARE(Directory::filenameView("foo/bar/"), "");
+
+    /* File only */
+    CORRADE_COMPARE(Directory::filenameView("file.txt"), "file.txt");
+
+    /* Common case */
+    CORRADE_COMPARE(Directory::filenameView("foo/bar/map.conf"), "map.conf");
+
+    /* The result is a view on the input */
+    const Containers::StringView in = "foo/bar/map.conf"_s;
+    CORRADE_COMPARE(static_cast<const void*>(Directory::filenameView(in).data()), in.data() + 8);
+}
+
+void DirectoryTest::splitExtensionView() {
+    /* Same cases as in splitExtension() */
+    const struct {
+        const char* in;
+        const char* root;
+        const char* ext;
+    } data[]{
+        {"", "", ""},
+        {"file.txt", "file", ".txt"},
+        {"file.tar.gz", "file.tar", ".gz"},
+        {"/etc/passwd", "/etc/passwd", ""},
+        {"/etc/rc.conf/file", "/etc/rc.conf/file", ""},
+        {"/home/no.", "/home/no", "."},
+        {"/home/mosra/.bashrc", "/home/mosra/.bashrc", ""},
+        {".bashrc", ".bashrc", ""},
+        {"/home/mosra/Code/..", "/home/mosra/Code/..", ""},
+        {"..", "..", ""},
+        {"/home/mosra/.", "/home/mosra/.", ""},
+        {".", ".", ""}
+    };
+
+    for(const auto& i: data) {
+        const Containers::StringView in = i.in;
+        const std::pair<Containers::StringView, Containers::StringView> split = Directory::splitExtensionView(in);
+        CORRADE_COMPARE(split.first, i.root);
+        CORRADE_COMPARE(split.second, i.ext);
+
+        /* The result is a view on the input */
+        CORRADE_COMPARE(static_cast<const void*>(split.first.data()), in.data());
+        CORRADE_COMPARE(static_cast<const void*>(split.second.data()), in.data() + split.first.size());
+    }
+}
+
+void DirectoryTest::joinInto() {
+    /* Same cases as in join() */
+    const struct {
+        const char* path;
+        const char* filename;
+        const char* expected;
+    } data[]{
+        {"", "/foo.txt", "/foo.txt"},
+        {"", "", ""},
+        {"/foo/bar", "/file.txt", "/file.txt"},
+        {"/foo/bar/", "file.txt", "/foo/bar/file.txt"},
+        {"/foo/bar", "file.txt", "/foo/bar/file.txt"},
+        {"/foo/bar", "", "/foo/bar/"},
+        #ifdef CORRADE_TARGET_WINDOWS
+        {"/foo/bar", "X:/path/file.txt", "X:/path/file.txt"},
+        #endif
+    };
+
+    for(const auto& i: data) {
+        /* Appends to existing contents */
+        Containers::Array<char> out;
+        Containers::arrayAppend(out, {'>', ' '});
+        const std::size_t size = Directory::joinInto(out, i.path, i.filename);
+        CORRADE_COMPARE(std::string(out.data(), out.size()), "> " + std::string{i.expected});
+        CORRADE_COMPARE(size, std::strlen(i.expected));
+    }
+}
+
+void DirectoryTest::joinIntoMultiple() {
+    const struct {
+        std::initializer_list<Containers::StringView> paths;
+        const char* expected;
+    } data[]{
+        {{"foo", "bar", "file.txt"}, "foo/bar/file.txt"},
+        {{"foo", "/bar", "file.txt"}, "/bar/file.txt"},
+        {{"foo", "", "file.txt"}, "foo/file.txt"},
+        {{"", "file.txt"}, "file.txt"},
+        {{"file.txt"}, "file.txt"},
+        {{}, ""}
+    };
+
+    for(const auto& i: data) {
+        Containers::Array<char> out;
+        Containers::arrayAppend(out, {'>', ' '});
+        const std::size_t size = Directory::joinInto(out, i.paths);
+        CORRADE_COMPARE(std::string(out.data(), out.size()), "> " + std::string{i.expected});
+        CORRADE_COMPARE(size, std::strlen(i.expected));
+    }
+}
+
+void DirectoryTest::joinIntoBuffer() {
+    /* Same cases as in join() */
+    const struct {
+        const char* path;
+        const char* filename;
+        const char* expected;
+    } data[]{
+        {"", "/foo.txt", "/foo.txt"},
+        {"", "", ""},
+        {"/foo/bar", "/file.txt", "/file.txt"},
+        {"/foo/bar/", "file.txt", "/foo/bar/file.txt"},
+        {"/foo/bar", "file.txt", "/foo/bar/file.txt"},
+        {"/foo/bar", "", "/foo/bar/"},
+        #ifdef CORRADE_TARGET_WINDOWS
+        {"/foo/bar", "X:/path/file.txt", "X:/path/file.txt"},
+        #endif
+    };
+
+    for(const auto& i: data) {
+        char buffer[32];
+        const std::size_t size = Directory::joinInto(buffer, i.path, i.filename);
+        CORRADE_COMPARE(std::string(buffer, size), i.expected);
+    }
+}
+
+void DirectoryTest::joinIntoBufferTooSmall() {
+    char buffer[17]{'X'};
+
+    /* Returns the size it needs and doesn't touch the buffer */
+    CORRADE_COMPARE(Directory::joinInto(Containers::arrayView(buffer).prefix(16), "/foo/bar", "file.txt"), 17);
+    CORRADE_COMPARE(Directory::joinInto(Containers::arrayView(buffer).prefix(4), "/foo", "/file.txt"), 9);
+    CORRADE_COMPARE(buffer[0], 'X');
+
+    /* Exactly fits */
+    CORRADE_COMPARE(Directory::joinInto(buffer, "/foo/bar", "file.txt"), 17);
+    CORRADE_COMPARE(std::string(buffer, 17), "/foo/bar/file.txt");
+}
+
 void DirectoryTest::exists() {
     /* File */
     CORRADE_VERIFY(Directory::exists(Directory::join(_testDir, "file")));
@@ -984,6 +1227,108 @@ void DirectoryTest::listUtf8() {
     }
 }
 
+namespace {
+
+std::vector<std::string> names(const std::vector<Directory::Entry>& entries) {
+    std::vector<std::string> out;
+    for(const Directory::Entry& entry: entries) out.push_back(entry.name);
+    return out;
+}
+
+}
+
+void DirectoryTest::listEntries() {
+    #if defined(CORRADE_TARGET_IOS) && defined(CORRADE_TESTSUITE_TARGET_XCTEST)
+    CORRADE_EXPECT_FAIL_IF(!std::getenv("SIMULATOR_UDID"),
+        "CTest is not able to run XCTest executables properly in the simulator.");
+    #endif
+
+    const std::vector<Directory::Entry> entries = Directory::listEntries(_testDir, Directory::Flag::SkipDotAndDotDot|Directory::Flag::SortAscending);
+    CORRADE_COMPARE_AS(names(entries),
+        (std::vector<std::string>{"dir", "file"}),
+        TestSuite::Compare::Container);
+
+    CORRADE_VERIFY(entries[0].type == Directory::EntryType::Directory);
+    CORRADE_VERIFY(entries[1].type == Directory::EntryType::File);
+    CORRADE_COMPARE(entries[1].size, 11);
+    /* Can't really test the exact value, but it should be after 2001 */
+    CORRADE_COMPARE_AS(entries[1].modificationTime, 1000000000ull*1000000000ull,
+        TestSuite::Compare::Greater);
+}
+
+void DirectoryTest::listEntriesSkip() {
+    #if defined(CORRADE_TARGET_IOS) && defined(CORRADE_TESTSUITE_TARGET_XCTEST)
+    CORRADE_EXPECT_FAIL_IF(!std::getenv("SIMULATOR_UDID"),
+        "CTest is not able to run XCTest executables properly in the simulator.");
+    #endif
+
+    CORRADE_COMPARE_AS(names(Directory::listEntries(_testDir)),
+        (std::vector<std::string>{".", "..", "dir", "file"}),
+        TestSuite::Compare::SortedContainer);
+    CORRADE_COMPARE_AS(names(Directory::listEntries(_testDir, Directory::Flag::SkipDirectories)),
+        std::vector<std::string>{"file"},
+        TestSuite::Compare::SortedContainer);
+    CORRADE_COMPARE_AS(names(Directory::listEntries(_testDir, Directory::Flag::SkipFiles)),
+        (std::vector<std::string>{".", "..", "dir"}),
+        TestSuite::Compare::SortedContainer);
+    CORRADE_COMPARE_AS(names(Directory::listEntries(_testDir, Directory::Flag::SkipSpecial)),
+        (std::vector<std::string>{".", "..", "dir", "file"}),
+        TestSuite::Compare::SortedContainer);
+}
+
+void DirectoryTest::listEntriesSort() {
+    #if defined(CORRADE_TARGET_IOS) && defined(CORRADE_TESTSUITE_TARGET_XCTEST)
+    CORRADE_EXPECT_FAIL_IF(!std::getenv("SIMULATOR_UDID"),
+        "CTest is not able to run XCTest executables properly in the simulator.");
+    #endif
+
+    CORRADE_COMPARE_AS(names(Directory::listEntries(_testDir, Directory::Flag::SortAscending)),
+        (std::vector<std::string>{".", "..", "dir", "file"}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(names(Directory::listEntries(_testDir, Directory::Flag::SortDescending)),
+        (std::vector<std::string>{"file", "dir", "..", "."}),
+        TestSuite::Compare::Container);
+}
+
+void DirectoryTest::listEntriesNonexistent() {
+    CORRADE_VERIFY(Directory::listEntries("nonexistent").empty());
+    CORRADE_VERIFY(Directory::listEntriesRecursive("nonexistent").empty());
+}
+
+void DirectoryTest::listEntriesRecursive() {
+    #if defined(CORRADE_TARGET_IOS) && defined(CORRADE_TESTSUITE_TARGET_XCTEST)
+    CORRADE_EXPECT_FAIL_IF(!std::getenv("SIMULATOR_UDID"),
+        "CTest is not able to run XCTest executables properly in the simulator.");
+    #endif
+
+    /* SkipDotAndDotDot is implicit */
+    const std::vector<Directory::Entry> entries = Directory::listEntriesRecursive(_testDir, Directory::Flag::SortAscending);
+    CORRADE_COMPARE_AS(names(entries),
+        (std::vector<std::string>{"dir", "dir/dummy", "file"}),
+        TestSuite::Compare::Container);
+
+    CORRADE_VERIFY(entries[0].type == Directory::EntryType::Directory);
+    CORRADE_VERIFY(entries[1].type == Directory::EntryType::File);
+    CORRADE_COMPARE(entries[1].size, 0);
+    CORRADE_VERIFY(entries[2].type == Directory::EntryType::File);
+    CORRADE_COMPARE(entries[2].size, 11);
+}
+
+void DirectoryTest::listEntriesRecursiveSkipDirectories() {
+    #if defined(CORRADE_TARGET_IOS) && defined(CORRADE_TESTSUITE_TARGET_XCTEST)
+    CORRADE_EXPECT_FAIL_IF(!std::getenv("SIMULATOR_UDID"),
+        "CTest is not able to run XCTest executables properly in the simulator.");
+    #endif
+
+    /* Directories are still descended into */
+    CORRADE_COMPARE_AS(names(Directory::listEntriesRecursive(_testDir, Directory::Flag::SkipDirectories)),
+        (std::vector<std::string>{"dir/dummy", "file"}),
+        TestSuite::Compare::SortedContainer);
+    CORRADE_COMPARE_AS(names(Directory::listEntriesRecursive(_testDir, Directory::Flag::SkipFiles)),
+        (std::vector<std::string>{"dir"}),
+        TestSuite::Compare::SortedContainer);
+}
+
 constexpr const char Data[]{'\xCA', '\xFE', '\xBA', '\xBE', '\x0D', '\x0A', '\x00', '\xDE', '\xAD', '\xBE', '\xEF'};
 
 void DirectoryTest::read() {
@@ -1046,6 +1391,144 @@ void DirectoryTest::readUtf8() {
         TestSuite::Compare::Container);
 }
 
+void DirectoryTest::readIntoArray() {
+    Containers::Array<char> out;
+    CORRADE_VERIFY(Directory::read(Directory::join(_testDir, "file"), out));
+    CORRADE_COMPARE_AS(out,
+        Containers::arrayView(Data),
+        TestSuite::Compare::Container);
+
+    /* Reading a smaller and then a larger file into the same array again
+       doesn't reallocate */
+    const char* const data = out.data();
+    CORRADE_VERIFY(Directory::read(Directory::join(_testDir, "dir/dummy"), out));
+    CORRADE_COMPARE(out.size(), 0);
+    CORRADE_VERIFY(Directory::read(Directory::join(_testDirUtf8, "hýždě"), out));
+    CORRADE_COMPARE_AS(out,
+        Containers::arrayView(Data),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(static_cast<const void*>(out.data()), data);
+
+    /* A non-growable array is turned into a growable one */
+    Containers::Array<char> nonGrowable{3};
+    CORRADE_VERIFY(Directory::read(Directory::join(_testDir, "file"), nonGrowable));
+    CORRADE_COMPARE_AS(nonGrowable,
+        Containers::arrayView(Data),
+        TestSuite::Compare::Container);
+}
+
+void DirectoryTest::readIntoArrayEmpty() {
+    Containers::Array<char> out{5};
+    CORRADE_VERIFY(Directory::read(Directory::join(_testDir, "dir/dummy"), out));
+    CORRADE_COMPARE(out.size(), 0);
+}
+
+void DirectoryTest::readIntoArrayNonSeekable() {
+    /* macOS or BSD doesn't have /proc */
+    #if defined(__unix__) && !defined(CORRADE_TARGET_EMSCRIPTEN) && \
+        !defined(__FreeBSD__) && !defined(__OpenBSD__) && !defined(__bsdi__) && \
+        !defined(__NetBSD__) && !defined(__DragonFly__)
+    /* /proc/self/maps is usually more than the initial 4 kB */
+    Containers::Array<char> out;
+    CORRADE_VERIFY(Directory::read("/proc/self/maps", out));
+    CORRADE_VERIFY(!out.empty());
+    CORRADE_COMPARE(out.back(), '\n');
+    #else
+    CORRADE_SKIP("Not implemented on this platform.");
+    #endif
+}
+
+void DirectoryTest::readIntoArrayNonexistent() {
+    std::ostringstream out;
+    Error redirectError{&out};
+    Containers::Array<char> data;
+    CORRADE_VERIFY(!Directory::read("nonexistent", data));
+    CORRADE_COMPARE(out.str(), "Utility::Directory::read(): can't open nonexistent\n");
+}
+
+void DirectoryTest::readIntoView() {
+    char out[16];
+    Containers::Optional<std::size_t> size = Directory::read(Directory::join(_testDir, "file"), out);
+    CORRADE_VERIFY(size);
+    CORRADE_COMPARE_AS(Containers::arrayView(out).prefix(*size),
+        Containers::arrayView(Data),
+        TestSuite::Compare::Container);
+
+    /* Exactly the size */
+    size = Directory::read(Directory::join(_testDir, "file"), Containers::arrayView(out).prefix(11));
+    CORRADE_COMPARE(size, 11);
+
+    /* Empty file into an empty view */
+    size = Directory::read(Directory::join(_testDir, "dir/dummy"), nullptr);
+    CORRADE_COMPARE(size, 0);
+}
+
+void DirectoryTest::readIntoViewTooSmall() {
+    const std::string file = Directory::join(_testDir, "file");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    char data[10];
+    CORRADE_VERIFY(!Directory::read(file, data));
+    CORRADE_COMPARE(out.str(), Utility::formatString("Utility::Directory::read(): file {} has 11 bytes but the output is only 10\n", file));
+}
+
+void DirectoryTest::readIntoViewNonexistent() {
+    std::ostringstream out;
+    Error redirectError{&out};
+    char data[10];
+    CORRADE_VERIFY(!Directory::read("nonexistent", data));
+    CORRADE_COMPARE(out.str(), "Utility::Directory::read(): can't open nonexistent\n");
+}
+
+void DirectoryTest::readOffset() {
+    char out[5];
+    CORRADE_VERIFY(Directory::read(Directory::join(_testDir, "file"), 4, out));
+    CORRADE_COMPARE_AS(Containers::arrayView(out),
+        Containers::arrayView(Data).slice(4, 9),
+        TestSuite::Compare::Container);
+
+    /* Reading nothing at the end is fine */
+    CORRADE_VERIFY(Directory::read(Directory::join(_testDir, "file"), 11, nullptr));
+}
+
+void DirectoryTest::readOffsetMultiple() {
+    char a[4], b[2], c[3];
+    const std::size_t offsets[]{7, 0, 4};
+    const Containers::ArrayView<char> outputs[]{a, b, c};
+    CORRADE_VERIFY(Directory::read(Directory::join(_testDirUtf8, "hýždě"), offsets, outputs));
+    CORRADE_COMPARE_AS(Containers::arrayView(a),
+        Containers::arrayView(Data).suffix(7),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(b),
+        Containers::arrayView(Data).prefix(2),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(c),
+        Containers::arrayView(Data).slice(4, 7),
+        TestSuite::Compare::Container);
+}
+
+void DirectoryTest::readOffsetPastTheEnd() {
+    const std::string file = Directory::join(_testDir, "file");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    char data[4];
+    CORRADE_VERIFY(!Directory::read(file, 8, data));
+    CORRADE_VERIFY(!Directory::read(file, 100, data));
+    CORRADE_COMPARE(out.str(), Utility::formatString(
+        "Utility::Directory::read(): can't read 4 bytes at offset 8 from {0}, got only 3\n"
+        "Utility::Directory::read(): can't read 4 bytes at offset 100 from {0}, got only 0\n", file));
+}
+
+void DirectoryTest::readOffsetNonexistent() {
+    std::ostringstream out;
+    Error redirectError{&out};
+    char data[4];
+    CORRADE_VERIFY(!Directory::read("nonexistent", 0, data));
+    CORRADE_COMPARE(out.str(), "Utility::Directory::read(): can't open nonexistent\n");
+}
+
 void DirectoryTest::write() {
     std::string file = Directory::join(_writeTestDir, "file");
 
@@ -1089,6 +1572,136 @@ void DirectoryTest::writeUtf8() {
         TestSuite::Compare::File);
 }
 
+namespace {
+
+void removeFiles(const std::string& path) {
+    for(const std::string& file: Directory::list(path, Directory::Flag::SkipDirectories|Directory::Flag::SkipSpecial))
+        Directory::rm(Directory::join(path, file));
+}
+
+}
+
+void DirectoryTest::writeAtomic() {
+    std::string path = Directory::join(_writeTestDir, "atomic");
+    CORRADE_VERIFY(Directory::mkpath(path));
+    removeFiles(path);
+    std::string file = Directory::join(path, "file");
+
+    /* Creating a new file */
+    CORRADE_VERIFY(Directory::write(file, Data, Directory::WriteFlag::Atomic));
+    CORRADE_COMPARE_AS(file, Directory::join(_testDir, "file"),
+        TestSuite::Compare::File);
+
+    /* Replacing an existing larger file, durably */
+    CORRADE_VERIFY(Directory::writeString(file, std::string(1024, 'a')));
+    CORRADE_VERIFY(Directory::writeString(file, std::string(Data, 11), Directory::WriteFlag::Atomic|Directory::WriteFlag::Durable));
+    CORRADE_COMPARE_AS(file, Directory::join(_testDir, "file"),
+        TestSuite::Compare::File);
+
+    /* No temporary files left behind */
+    CORRADE_COMPARE_AS(Directory::list(path, Directory::Flag::SkipDotAndDotDot),
+        std::vector<std::string>{"file"},
+        TestSuite::Compare::Container);
+}
+
+void DirectoryTest::writeAtomicNonexistentDirectory() {
+    std::ostringstream out;
+    Error err{&out};
+
+    CORRADE_VERIFY(!Directory::write("nonexistent/file", Data, Directory::WriteFlag::Atomic));
+    CORRADE_COMPARE(out.str(), "Utility::Directory::write(): can't create a temporary file for nonexistent/file\n");
+}
+
+void DirectoryTest::writeDurable() {
+    std::string file = Directory::join(_writeTestDir, "file");
+
+    if(Directory::exists(file)) CORRADE_VERIFY(Directory::rm(file));
+    CORRADE_VERIFY(Directory::write(file, Data, Directory::WriteFlag::Durable));
+    CORRADE_COMPARE_AS(file, Directory::join(_testDir, "file"),
+        TestSuite::Compare::File);
+}
+
+void DirectoryTest::writeBatch() {
+    std::string path = Directory::join(_writeTestDir, "batch");
+    CORRADE_VERIFY(Directory::mkpath(Directory::join(path, "sub")));
+    removeFiles(path);
+    removeFiles(Directory::join(path, "sub"));
+    CORRADE_VERIFY(Directory::writeString(Directory::join(path, "a"), "old"));
+
+    Directory::WriteBatch batch;
+    CORRADE_VERIFY(batch.writeString(Directory::join(path, "a"), "new a"));
+    CORRADE_VERIFY(batch.write(Directory::join(path, "b"), Data));
+    CORRADE_VERIFY(batch.writeString(Directory::join(path, "sub/c"), "new c"));
+    CORRADE_COMPARE(batch.count(), 3);
+
+    /* Nothing is replaced until commit */
+    CORRADE_COMPARE_AS(Directory::join(path, "a"), "old",
+        TestSuite::Compare::FileToString);
+    CORRADE_VERIFY(!Directory::exists(Directory::join(path, "b")));
+
+    CORRADE_VERIFY(batch.commit());
+    CORRADE_COMPARE(batch.count(), 0);
+    CORRADE_COMPARE_AS(Directory::join(path, "a"), "new a",
+        TestSuite::Compare::FileToString);
+    CORRADE_COMPARE_AS(Directory::join(path, "b"), Directory::join(_testDir, "file"),
+        TestSuite::Compare::File);
+    CORRADE_COMPARE_AS(Directory::join(path, "sub/c"), "new c",
+        TestSuite::Compare::FileToString);
+
+    /* No temporary files left behind */
+    CORRADE_COMPARE_AS(Directory::list(path, Directory::Flag::SkipDotAndDotDot),
+        (std::vector<std::string>{"a", "b", "sub"}),
+        TestSuite::Compare::SortedContainer);
+    CORRADE_COMPARE_AS(Directory::list(Directory::join(path, "sub"), Directory::Flag::SkipDotAndDotDot),
+        std::vector<std::string>{"c"},
+        TestSuite::Compare::Container);
+}
+
+void DirectoryTest::writeBatchNotDurable() {
+    std::string file = Directory::join(_writeTestDir, "batchNotDurable");
+    if(Directory::exists(file)) CORRADE_VERIFY(Directory::rm(file));
+
+    Directory::WriteBatch batch{{}};
+    CORRADE_VERIFY(batch.write(file, Data));
+    CORRADE_VERIFY(batch.commit());
+    CORRADE_COMPARE_AS(file, Directory::join(_testDir, "file"),
+        TestSuite::Compare::File);
+}
+
+void DirectoryTest::writeBatchDiscard() {
+    std::string path = Directory::join(_writeTestDir, "batchDiscard");
+    CORRADE_VERIFY(Directory::mkpath(path));
+    removeFiles(path);
+    CORRADE_VERIFY(Directory::writeString(Directory::join(path, "a"), "old"));
+
+    {
+        Directory::WriteBatch batch;
+        CORRADE_VERIFY(batch.writeString(Directory::join(path, "a"), "new a"));
+        CORRADE_VERIFY(batch.writeString(Directory::join(path, "b"), "new b"));
+
+        /* Moving keeps the writes */
+        Directory::WriteBatch moved = std::move(batch);
+        CORRADE_COMPARE(moved.count(), 2);
+    }
+
+    /* The original contents stay and the temporary files are removed */
+    CORRADE_COMPARE_AS(Directory::join(path, "a"), "old",
+        TestSuite::Compare::FileToString);
+    CORRADE_COMPARE_AS(Directory::list(path, Directory::Flag::SkipDotAndDotDot),
+        std::vector<std::string>{"a"},
+        TestSuite::Compare::Container);
+}
+
+void DirectoryTest::writeBatchNonexistentDirectory() {
+    Directory::WriteBatch batch;
+
+    std::ostringstream out;
+    Error err{&out};
+    CORRADE_VERIFY(!batch.write("nonexistent/file", Data));
+    CORRADE_COMPARE(batch.count(), 0);
+    CORRADE_COMPARE(out.str(), "Utility::Directory::WriteBatch::write(): can't create a temporary file for nonexistent/file\n");
+}
+
 void DirectoryTest::append() {
     constexpr const char expected[]{'h', 'e', 'l', 'l', 'o', '\xCA', '\xFE', '\xBA', '\xBE', '\x0D', '\x0A', '\x00', '\xDE', '\xAD', '\xBE', '\xEF'};
 
@@ -1183,6 +1796,29 @@ void DirectoryTest::copyEmpty() {
         TestSuite::Compare::FileToString);
 }
 
+void DirectoryTest::copyOverwrite() {
+    /* The destination is larger than the source, it should get truncated
+       regardless of how the copy was done */
+    std::string output = Directory::join(_writeTestDir, "copyOverwrite");
+    CORRADE_VERIFY(Directory::writeString(output, std::string(1024, 'a')));
+
+    CORRADE_VERIFY(Directory::copy(Directory::join(_testDir, "file"), output));
+    CORRADE_COMPARE_AS(output, Directory::join(_testDir, "file"),
+        TestSuite::Compare::File);
+}
+
+void DirectoryTest::copyNonSeekable() {
+    #ifndef __linux__
+    CORRADE_SKIP("Not sure how to test on this platform.");
+    #else
+    /* The file reports zero size, so it has to be read until EOF instead of
+       being copied in the kernel */
+    std::string output = Directory::join(_writeTestDir, "copyNonSeekable");
+    CORRADE_VERIFY(Directory::copy("/proc/self/cmdline", output));
+    CORRADE_VERIFY(!Directory::readString(output).empty());
+    #endif
+}
+
 void DirectoryTest::copyNonexistent() {
     std::ostringstream out;
     {
@@ -1228,6 +1864,29 @@ void DirectoryTest::prepareFileToBenchmarkCopy() {
         Directory::append(Directory::join(_writeTestDir, "copyBenchmarkSource.dat"), data);
 }
 
+void DirectoryTest::benchmarkReadSmall() {
+    const std::string file = Directory::join(_testDir, "file");
+
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(100)
+        size += Directory::read(file).size();
+
+    CORRADE_COMPARE(size, 100*Containers::arraySize(Data));
+}
+
+void DirectoryTest::benchmarkReadSmallIntoArray() {
+    const std::string file = Directory::join(_testDir, "file");
+
+    std::size_t size = 0;
+    Containers::Array<char> data;
+    CORRADE_BENCHMARK(100) {
+        Directory::read(file, data);
+        size += data.size();
+    }
+
+    CORRADE_COMPARE(size, 100*Containers::arraySize(Data));
+}
+
 void DirectoryTest::copy100MReadWrite() {
     std::string input = Directory::join(_writeTestDir, "copyBenchmarkSource.dat");
     std::string output = Directory::join(_writeTestDir, "copyDestination.dat");
@@ -1290,6 +1949,58 @@ void DirectoryTest::map() {
     #endif
 }
 
+void DirectoryTest::mapFlags() {
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    std::string file = Directory::join(_writeTestDir, "mappedFlagsFile");
+    if(Directory::exists(file)) CORRADE_VERIFY(Directory::rm(file));
+    Directory::writeString(file, std::string{"\xCA\xFE\xBA\xBE\x0D\x0A\x00\xDE\xAD\xBE\xEF", 11});
+
+    /* The flags are just hints, so verify they don't break anything */
+    {
+        auto mappedFile = Directory::map(file, Directory::MapFlag::Sequential|Directory::MapFlag::Prefetch|Directory::MapFlag::HugePages|Directory::MapFlag::SyncOnUnmap);
+        CORRADE_COMPARE_AS(Containers::arrayView(mappedFile),
+            Containers::arrayView<char>({'\xCA', '\xFE', '\xBA', '\xBE', '\x0D', '\x0A', '\x00', '\xDE', '\xAD', '\xBE', '\xEF'}),
+            TestSuite::Compare::Container);
+
+        mappedFile[2] = '\xCA';
+        mappedFile[3] = '\xFE';
+    }
+
+    CORRADE_COMPARE_AS(file,
+        (std::string{"\xCA\xFE\xCA\xFE\x0D\x0A\x00\xDE\xAD\xBE\xEF", 11}),
+        TestSuite::Compare::FileToString);
+    #else
+    CORRADE_SKIP("Not implemented on this platform.");
+    #endif
+}
+
+void DirectoryTest::mapRange() {
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    /* Larger than both a page and the Windows allocation granularity so the
+       offset isn't aligned to either */
+    std::string data(3*65536, '\0');
+    for(std::size_t i = 0; i != data.size(); ++i) data[i] = char(i*7);
+    std::string file = Directory::join(_writeTestDir, "mappedRangeFile");
+    if(Directory::exists(file)) CORRADE_VERIFY(Directory::rm(file));
+    Directory::writeString(file, data);
+
+    {
+        auto mappedFile = Directory::map(file, 65536 + 4097, 3);
+        CORRADE_VERIFY(mappedFile);
+        CORRADE_COMPARE(mappedFile.size(), 3);
+        CORRADE_COMPARE(mappedFile[0], data[65536 + 4097]);
+        CORRADE_COMPARE(mappedFile[2], data[65536 + 4099]);
+
+        mappedFile[1] = '!';
+    }
+
+    data[65536 + 4098] = '!';
+    CORRADE_COMPARE_AS(file, data, TestSuite::Compare::FileToString);
+    #else
+    CORRADE_SKIP("Not implemented on this platform.");
+    #endif
+}
+
 void DirectoryTest::mapNonexistent() {
     #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
     {
@@ -1330,6 +2041,59 @@ void DirectoryTest::mapRead() {
     #endif
 }
 
+void DirectoryTest::mapReadFlags() {
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    /* The flags are just hints, so verify they don't break anything.
+       SyncOnUnmap is ignored for read-only mappings. */
+    {
+        const auto mappedFile = Directory::mapRead(Directory::join(_testDir, "file"), Directory::MapFlag::Random|Directory::MapFlag::Prefetch|Directory::MapFlag::HugePages|Directory::MapFlag::SyncOnUnmap);
+        CORRADE_COMPARE_AS(Containers::ArrayView<const char>(mappedFile),
+            (Containers::Array<char>{Containers::InPlaceInit,
+                {'\xCA', '\xFE', '\xBA', '\xBE', '\x0D', '\x0A', '\x00', '\xDE', '\xAD', '\xBE', '\xEF'}}),
+            TestSuite::Compare::Container);
+    }
+    #else
+    CORRADE_SKIP("Not implemented on this platform.");
+    #endif
+}
+
+void DirectoryTest::mapReadRange() {
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    {
+        const auto mappedFile = Directory::mapRead(Directory::join(_testDir, "file"), 3, 5, Directory::MapFlag::Sequential);
+        CORRADE_COMPARE_AS(Containers::ArrayView<const char>(mappedFile),
+            (Containers::Array<char>{Containers::InPlaceInit,
+                {'\xBE', '\x0D', '\x0A', '\x00', '\xDE'}}),
+            TestSuite::Compare::Container);
+    } {
+        /* Until the end */
+        const auto mappedFile = Directory::mapRead(Directory::join(_testDir, "file"), 9, 2);
+        CORRADE_COMPARE_AS(Containers::ArrayView<const char>(mappedFile),
+            (Containers::Array<char>{Containers::InPlaceInit,
+                {'\xBE', '\xEF'}}),
+            TestSuite::Compare::Container);
+    }
+    #else
+    CORRADE_SKIP("Not implemented on this platform.");
+    #endif
+}
+
+void DirectoryTest::mapReadRangeOutOfBounds() {
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    const std::string file = Directory::join(_testDir, "file");
+
+    std::ostringstream out;
+    Error err{&out};
+    CORRADE_VERIFY(!Directory::mapRead(file, 9, 3));
+    CORRADE_VERIFY(!Directory::map(file, 12, 1));
+    CORRADE_COMPARE(out.str(), formatString(
+        "Utility::Directory::mapRead(): can't map 3 bytes at offset 9 from {0} of 11 bytes\n"
+        "Utility::Directory::map(): can't map 1 bytes at offset 12 from {0} of 11 bytes\n", file));
+    #else
+    CORRADE_SKIP("Not implemented on this platform.");
+    #endif
+}
+
 void DirectoryTest::mapReadNonexistent() {
     #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
     {
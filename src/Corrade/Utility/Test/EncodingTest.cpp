@@ -0,0 +1,371 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <random>
+#include <sstream>
+#include <string>
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Container.h"
+#include "Corrade/Utility/DebugStl.h"
+#include "Corrade/Utility/Encoding.h"
+
+namespace Corrade { namespace Utility { namespace Test { namespace {
+
+struct EncodingTest: TestSuite::Tester {
+    explicit EncodingTest();
+
+    void hexEncode();
+    void hexEncodeEmpty();
+    void hexDecode();
+    void hexDecodeInvalid();
+    void hexRoundtripRandom();
+    void hexInvalidSize();
+
+    void base64EncodedSize();
+    void base64DecodedSize();
+    void base64Encode();
+    void base64Decode();
+    void base64DecodeInvalid();
+    void base64RoundtripRandom();
+    void base64InvalidSize();
+
+    void benchmarkHexEncode();
+    void benchmarkHexDecode();
+    void benchmarkBase64Encode();
+    void benchmarkBase64Decode();
+};
+
+EncodingTest::EncodingTest() {
+    addTests({&EncodingTest::hexEncode,
+              &EncodingTest::hexEncodeEmpty,
+              &EncodingTest::hexDecode,
+              &EncodingTest::hexDecodeInvalid,
+              &EncodingTest::hexRoundtripRandom,
+              &EncodingTest::hexInvalidSize,
+
+              &EncodingTest::base64EncodedSize,
+              &EncodingTest::base64DecodedSize,
+              &EncodingTest::base64Encode,
+              &EncodingTest::base64Decode,
+              &EncodingTest::base64DecodeInvalid,
+              &EncodingTest::base64RoundtripRandom,
+              &EncodingTest::base64InvalidSize});
+
+    addBenchmarks({&EncodingTest::benchmarkHexEncode,
+                   &EncodingTest::benchmarkHexDecode,
+                   &EncodingTest::benchmarkBase64Encode,
+                   &EncodingTest::benchmarkBase64Decode}, 10);
+}
+
+/* Long enough to go through the SIMD code paths */
+constexpr const char LongData[] =
+    "\x00\x01\x7f\x80\xca\xfe\xba\xbe\xde\xad\xbe\xef\xff\x10\x20\x30"
+    "\x40\x50\x60\x70\x8a\x9b\xac\xbd\xce\xdf\xe0\xf1";
+constexpr const char LongHex[] =
+    "00017f80cafebabedeadbeefff102030"
+    "405060708a9bacbdcedfe0f1";
+
+std::string view(Containers::ArrayView<const char> data) {
+    return {data.data(), data.size()};
+}
+
+void EncodingTest::hexEncode() {
+    const char data[]{'\xca', '\xfe', '\x90', '\x0a'};
+    char out[8];
+    Encoding::hexEncode(data, out);
+    CORRADE_COMPARE(view(out), "cafe900a");
+
+    char outLong[sizeof(LongData) - 1][2];
+    Encoding::hexEncode(Containers::arrayView(LongData).except(1), Containers::arrayView(&outLong[0][0], sizeof(outLong)));
+    CORRADE_COMPARE(view({&outLong[0][0], sizeof(outLong)}), LongHex);
+}
+
+void EncodingTest::hexEncodeEmpty() {
+    /* Shouldn't crash */
+    Encoding::hexEncode(nullptr, nullptr);
+    CORRADE_VERIFY(true);
+}
+
+void EncodingTest::hexDecode() {
+    char out[4];
+    CORRADE_VERIFY(Encoding::hexDecode(Containers::arrayView("CaFe900a").except(1), out));
+    CORRADE_COMPARE(view(out), (std::string{"\xca\xfe\x90\x0a", 4}));
+
+    char outLong[sizeof(LongData) - 1];
+    CORRADE_VERIFY(Encoding::hexDecode(Containers::arrayView(LongHex).except(1), outLong));
+    CORRADE_COMPARE(view(outLong), view(Containers::arrayView(LongData).except(1)));
+
+    CORRADE_VERIFY(Encoding::hexDecode(nullptr, nullptr));
+}
+
+void EncodingTest::hexDecodeInvalid() {
+    /* Put each invalid character at every position of a long string so it
+       goes through both the vectorized and the scalar part */
+    const char invalid[]{'g', 'G', '/', ':', '@', '`', ' ', '\0', '\x80', '\xc1', '\xe6'};
+    std::string text(70, 'a');
+    char out[35];
+    for(const char c: invalid) {
+        for(std::size_t i = 0; i != text.size(); ++i) {
+            std::string copy = text;
+            copy[i] = c;
+            CORRADE_VERIFY(!Encoding::hexDecode({copy.data(), copy.size()}, out));
+        }
+    }
+
+    CORRADE_VERIFY(Encoding::hexDecode({text.data(), text.size()}, out));
+}
+
+void EncodingTest::hexRoundtripRandom() {
+    std::mt19937 random;
+    std::uniform_int_distribution<int> byte{0, 255};
+
+    for(std::size_t size: {0, 1, 15, 16, 17, 31, 32, 33, 100, 1000}) {
+        std::string data(size, '\0');
+        for(char& c: data) c = char(byte(random));
+
+        std::string hex(size*2, '\0');
+        Encoding::hexEncode({data.data(), data.size()}, {&hex[0], hex.size()});
+
+        /* Compare to a reference scalar encoding */
+        std::string expected;
+        for(const char c: data) {
+            expected += "0123456789abcdef"[std::uint8_t(c) >> 4];
+            expected += "0123456789abcdef"[std::uint8_t(c) & 0x0f];
+        }
+        CORRADE_COMPARE(hex, expected);
+
+        std::string decoded(size, '\0');
+        CORRADE_VERIFY(Encoding::hexDecode({hex.data(), hex.size()}, {&decoded[0], decoded.size()}));
+        CORRADE_COMPARE(decoded, data);
+    }
+}
+
+void EncodingTest::hexInvalidSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    char data[3]{};
+    char text[5]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Encoding::hexEncode(data, text);
+    Encoding::hexDecode(text, data);
+    CORRADE_COMPARE(out.str(),
+        "Utility::Encoding::hexEncode(): expected output size 6 but got 5\n"
+        "Utility::Encoding::hexDecode(): expected input size 6 but got 5\n");
+}
+
+void EncodingTest::base64EncodedSize() {
+    CORRADE_COMPARE(Encoding::base64EncodedSize(0), 0);
+    CORRADE_COMPARE(Encoding::base64EncodedSize(1), 4);
+    CORRADE_COMPARE(Encoding::base64EncodedSize(2), 4);
+    CORRADE_COMPARE(Encoding::base64EncodedSize(3), 4);
+    CORRADE_COMPARE(Encoding::base64EncodedSize(4), 8);
+
+    constexpr std::size_t size = Encoding::base64EncodedSize(20);
+    CORRADE_COMPARE(size, 28);
+}
+
+void EncodingTest::base64DecodedSize() {
+    CORRADE_COMPARE(Encoding::base64DecodedSize(nullptr), 0);
+    CORRADE_COMPARE(Encoding::base64DecodedSize(Containers::arrayView("Zg==").except(1)), 1);
+    CORRADE_COMPARE(Encoding::base64DecodedSize(Containers::arrayView("Zm8=").except(1)), 2);
+    CORRADE_COMPARE(Encoding::base64DecodedSize(Containers::arrayView("Zm9v").except(1)), 3);
+    CORRADE_COMPARE(Encoding::base64DecodedSize(Containers::arrayView("Zm9vYg==").except(1)), 4);
+}
+
+/* Test vectors from RFC 4648 */
+const struct {
+    const char* data;
+    const char* encoded;
+} Base64Data[]{
+    {"", ""},
+    {"f", "Zg=="},
+    {"fo", "Zm8="},
+    {"foo", "Zm9v"},
+    {"foob", "Zm9vYg=="},
+    {"fooba", "Zm9vYmE="},
+    {"foobar", "Zm9vYmFy"},
+    {"Many hands make light work, the quick brown fox jumps over the lazy dog.",
+     "TWFueSBoYW5kcyBtYWtlIGxpZ2h0IHdvcmssIHRoZSBxdWljayBicm93biBmb3gganVtcHMgb3ZlciB0aGUgbGF6eSBkb2cu"}
+};
+
+void EncodingTest::base64Encode() {
+    for(const auto& data: Base64Data) {
+        const std::string input = data.data;
+        std::string out(Encoding::base64EncodedSize(input.size()), '\0');
+        Encoding::base64Encode({input.data(), input.size()}, {&out[0], out.size()});
+        CORRADE_COMPARE(out, data.encoded);
+    }
+
+    /* All characters of the alphabet */
+    const char allValues[]{'\x00', '\x10', '\x83', '\x10', '\x51', '\x87', '\x20', '\x92', '\x8b', '\x30', '\xd3', '\x8f', '\x41', '\x14', '\x93', '\x51', '\x55', '\x97', '\x61', '\x96', '\x9b', '\x71', '\xd7', '\x9f', '\x82', '\x18', '\xa3', '\x92', '\x59', '\xa7', '\xa2', '\x9a', '\xab', '\xb2', '\xdb', '\xaf', '\xc3', '\x1c', '\xb3', '\xd3', '\x5d', '\xb7', '\xe3', '\x9e', '\xbb', '\xf3', '\xdf', '\xbf'};
+    char out[64];
+    Encoding::base64Encode(allValues, out);
+    CORRADE_COMPARE(view(out), "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/");
+}
+
+void EncodingTest::base64Decode() {
+    for(const auto& data: Base64Data) {
+        const std::string input = data.encoded;
+        std::string out(Encoding::base64DecodedSize({input.data(), input.size()}), '\0');
+        CORRADE_VERIFY(Encoding::base64Decode({input.data(), input.size()}, {&out[0], out.size()}));
+        CORRADE_COMPARE(out, data.data);
+    }
+}
+
+void EncodingTest::base64DecodeInvalid() {
+    char out[64];
+
+    /* Size not divisible by four */
+    CORRADE_VERIFY(!Encoding::base64Decode(Containers::arrayView("Zm9").except(1), {out, 2}));
+
+    /* Padding not at the end, or only in the third character */
+    CORRADE_VERIFY(!Encoding::base64Decode(Containers::arrayView("Zg==Zm9v").except(1), {out, 6}));
+    CORRADE_VERIFY(!Encoding::base64Decode(Containers::arrayView("Zm=v").except(1), {out, 3}));
+    CORRADE_VERIFY(!Encoding::base64Decode(Containers::arrayView("Z===").except(1), {out, 1}));
+
+    /* Non-zero bits in the padded part */
+    CORRADE_VERIFY(!Encoding::base64Decode(Containers::arrayView("Zh==").except(1), {out, 1}));
+    CORRADE_VERIFY(!Encoding::base64Decode(Containers::arrayView("Zm9=").except(1), {out, 2}));
+
+    /* Invalid characters at every position of a long string, so it goes
+       through both the vectorized and the scalar part */
+    const char invalid[]{'-', '_', '.', ' ', '\n', '@', '[', '`', '{', '\0', '\x80', '\xc1'};
+    std::string text(64, 'A');
+    for(const char c: invalid) {
+        for(std::size_t i = 0; i != text.size(); ++i) {
+            std::string copy = text;
+            copy[i] = c;
+            CORRADE_VERIFY(!Encoding::base64Decode({copy.data(), copy.size()}, {out, 48}));
+        }
+    }
+
+    CORRADE_VERIFY(Encoding::base64Decode({text.data(), text.size()}, {out, 48}));
+}
+
+void EncodingTest::base64RoundtripRandom() {
+    std::mt19937 random;
+    std::uniform_int_distribution<int> byte{0, 255};
+
+    for(std::size_t size: {0, 1, 2, 3, 11, 12, 13, 15, 16, 17, 18, 24, 25, 47, 48, 49, 100, 1000}) {
+        std::string data(size, '\0');
+        for(char& c: data) c = char(byte(random));
+
+        std::string encoded(Encoding::base64EncodedSize(size), '\0');
+        Encoding::base64Encode({data.data(), data.size()}, {&encoded[0], encoded.size()});
+
+        /* Compare to a reference scalar encoding */
+        const char* const alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        std::string expected;
+        for(std::size_t i = 0; i < size; i += 3) {
+            const std::uint32_t a = std::uint8_t(data[i]);
+            const std::uint32_t b = i + 1 < size ? std::uint8_t(data[i + 1]) : 0;
+            const std::uint32_t c = i + 2 < size ? std::uint8_t(data[i + 2]) : 0;
+            const std::uint32_t triplet = a << 16 | b << 8 | c;
+            expected += alphabet[triplet >> 18];
+            expected += alphabet[(triplet >> 12) & 0x3f];
+            expected += i + 1 < size ? alphabet[(triplet >> 6) & 0x3f] : '=';
+            expected += i + 2 < size ? alphabet[triplet & 0x3f] : '=';
+        }
+        CORRADE_COMPARE(encoded, expected);
+
+        std::string decoded(Encoding::base64DecodedSize({encoded.data(), encoded.size()}), '\0');
+        CORRADE_COMPARE(decoded.size(), size);
+        CORRADE_VERIFY(Encoding::base64Decode({encoded.data(), encoded.size()}, {&decoded[0], decoded.size()}));
+        CORRADE_COMPARE(decoded, data);
+    }
+}
+
+void EncodingTest::base64InvalidSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    char data[4]{};
+    char text[7]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Encoding::base64Encode(data, text);
+    Encoding::base64Decode(Containers::arrayView("Zm9vYg==").except(1), {data, 3});
+    CORRADE_COMPARE(out.str(),
+        "Utility::Encoding::base64Encode(): expected output size 8 but got 7\n"
+        "Utility::Encoding::base64Decode(): expected output size 4 but got 3\n");
+}
+
+void EncodingTest::benchmarkHexEncode() {
+    Containers::Array<char> data{Containers::ValueInit, 1024*1024};
+    for(std::size_t i = 0; i != data.size(); ++i) data[i] = char(i*37);
+    Containers::Array<char> out{Containers::NoInit, data.size()*2};
+
+    CORRADE_BENCHMARK(1)
+        Encoding::hexEncode(data, out);
+
+    CORRADE_COMPARE(out[2], '2');
+}
+
+void EncodingTest::benchmarkHexDecode() {
+    Containers::Array<char> text{Containers::DirectInit, 2*1024*1024, 'a'};
+    Containers::Array<char> out{Containers::NoInit, text.size()/2};
+
+    bool valid = true;
+    CORRADE_BENCHMARK(1)
+        valid = valid && Encoding::hexDecode(text, out);
+
+    CORRADE_VERIFY(valid);
+    CORRADE_COMPARE(out[0], '\xaa');
+}
+
+void EncodingTest::benchmarkBase64Encode() {
+    Containers::Array<char> data{Containers::ValueInit, 3*1024*1024/4*4};
+    for(std::size_t i = 0; i != data.size(); ++i) data[i] = char(i*37);
+    Containers::Array<char> out{Containers::NoInit, Encoding::base64EncodedSize(data.size())};
+
+    CORRADE_BENCHMARK(1)
+        Encoding::base64Encode(data, out);
+
+    CORRADE_COMPARE(out[0], 'A');
+}
+
+void EncodingTest::benchmarkBase64Decode() {
+    Containers::Array<char> text{Containers::DirectInit, 4*1024*1024, 'Q'};
+    Containers::Array<char> out{Containers::NoInit, Encoding::base64DecodedSize(text)};
+
+    bool valid = true;
+    CORRADE_BENCHMARK(1)
+        valid = valid && Encoding::base64Decode(text, out);
+
+    CORRADE_VERIFY(valid);
+    CORRADE_COMPARE(out[0], '\x41');
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Utility::Test::EncodingTest)
@@ -25,8 +25,13 @@
 
 #include <cstdint>
 
+#include <cstring>
+#include <sstream>
+
+#include "Corrade/Containers/Array.h"
 #include "Corrade/TestSuite/Tester.h"
 #include "Corrade/TestSuite/Compare/Container.h"
+#include "Corrade/Utility/DebugStl.h"
 #include "Corrade/Utility/Endianness.h"
 #include "Corrade/Utility/EndiannessBatch.h"
 
@@ -40,7 +45,30 @@ struct EndiannessTest: TestSuite::Tester {
     void inPlace();
     void inPlaceUnaligned();
     void inPlaceList();
+    void inPlaceListStrided();
+    void inPlaceListLarge();
     void enumClass();
+
+    void into();
+    void intoStrided();
+    void intoLarge();
+    void intoInvalidSize();
+
+    template<class T> void benchmarkSwapInPlace();
+    template<class T> void benchmarkSwapInPlaceStrided();
+    template<class T> void benchmarkCopySwapInPlace();
+    template<class T> void benchmarkSwapInto();
+};
+
+template<class> struct TypeName;
+template<> struct TypeName<std::uint16_t> {
+    static const char* name() { return "std::uint16_t"; }
+};
+template<> struct TypeName<std::uint32_t> {
+    static const char* name() { return "std::uint32_t"; }
+};
+template<> struct TypeName<std::uint64_t> {
+    static const char* name() { return "std::uint64_t"; }
 };
 
 EndiannessTest::EndiannessTest() {
@@ -49,7 +77,28 @@ EndiannessTest::EndiannessTest() {
               &EndiannessTest::inPlace,
               &EndiannessTest::inPlaceUnaligned,
               &EndiannessTest::inPlaceList,
-              &EndiannessTest::enumClass});
+              &EndiannessTest::inPlaceListStrided,
+              &EndiannessTest::inPlaceListLarge,
+              &EndiannessTest::enumClass,
+
+              &EndiannessTest::into,
+              &EndiannessTest::intoStrided,
+              &EndiannessTest::intoLarge,
+              &EndiannessTest::intoInvalidSize});
+
+    addBenchmarks<EndiannessTest>({
+        &EndiannessTest::benchmarkSwapInPlace<std::uint16_t>,
+        &EndiannessTest::benchmarkSwapInPlace<std::uint32_t>,
+        &EndiannessTest::benchmarkSwapInPlace<std::uint64_t>,
+        &EndiannessTest::benchmarkSwapInPlaceStrided<std::uint16_t>,
+        &EndiannessTest::benchmarkSwapInPlaceStrided<std::uint32_t>,
+        &EndiannessTest::benchmarkSwapInPlaceStrided<std::uint64_t>,
+        &EndiannessTest::benchmarkCopySwapInPlace<std::uint16_t>,
+        &EndiannessTest::benchmarkCopySwapInPlace<std::uint32_t>,
+        &EndiannessTest::benchmarkCopySwapInPlace<std::uint64_t>,
+        &EndiannessTest::benchmarkSwapInto<std::uint16_t>,
+        &EndiannessTest::benchmarkSwapInto<std::uint32_t>,
+        &EndiannessTest::benchmarkSwapInto<std::uint64_t>}, 50);
 }
 
 void EndiannessTest::endianness() {
@@ -225,6 +274,50 @@ void EndiannessTest::inPlaceList() {
     #undef otherInPlace
 }
 
+void EndiannessTest::inPlaceListStrided() {
+    /* Every other item gets swapped */
+    std::uint32_t a[]{0x11223344, 0x55667700, 0x8899aabb, 0xccddeeff};
+    Endianness::swapInPlace(Containers::StridedArrayView1D<std::uint32_t>{a, 2, 8});
+    CORRADE_COMPARE_AS(Containers::arrayView(a),
+        Containers::arrayView<std::uint32_t>({
+            0x44332211, 0x55667700, 0xbbaa9988, 0xccddeeff
+        }), TestSuite::Compare::Container);
+
+    /* Negative stride */
+    std::uint16_t b[]{0x1122, 0x3344, 0x5566};
+    Endianness::swapInPlace(Containers::StridedArrayView1D<std::uint16_t>{b}.flipped<0>());
+    CORRADE_COMPARE_AS(Containers::arrayView(b),
+        Containers::arrayView<std::uint16_t>({
+            0x2211, 0x4433, 0x6655
+        }), TestSuite::Compare::Container);
+}
+
+void EndiannessTest::inPlaceListLarge() {
+    /* Large enough to hit any vectorized loop, with a weird size to test the
+       remainder handling as well */
+    Containers::Array<std::uint16_t> a{Containers::NoInit, 1037};
+    Containers::Array<std::uint32_t> b{Containers::NoInit, 1037};
+    Containers::Array<std::uint64_t> c{Containers::NoInit, 1037};
+    Containers::Array<std::uint16_t> aExpected{Containers::NoInit, 1037};
+    Containers::Array<std::uint32_t> bExpected{Containers::NoInit, 1037};
+    Containers::Array<std::uint64_t> cExpected{Containers::NoInit, 1037};
+    for(std::size_t i = 0; i != a.size(); ++i) {
+        a[i] = 0x1100u + i;
+        b[i] = 0x11223300u + i;
+        c[i] = 0x1122334455667700ull + i;
+        aExpected[i] = Endianness::swap(a[i]);
+        bExpected[i] = Endianness::swap(b[i]);
+        cExpected[i] = Endianness::swap(c[i]);
+    }
+
+    Endianness::swapInPlace(Containers::arrayView(a));
+    Endianness::swapInPlace(Containers::arrayView(b));
+    Endianness::swapInPlace(Containers::arrayView(c));
+    CORRADE_COMPARE_AS(a, aExpected, TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(b, bExpected, TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(c, cExpected, TestSuite::Compare::Container);
+}
+
 void EndiannessTest::enumClass() {
     #ifdef CORRADE_TARGET_BIG_ENDIAN
     #define other littleEndian
@@ -252,6 +345,185 @@ void EndiannessTest::enumClass() {
     #undef otherInPlace
 }
 
+void EndiannessTest::into() {
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    #define currentInto bigEndianInto
+    #define otherInto littleEndianInto
+    #else
+    #define currentInto littleEndianInto
+    #define otherInto bigEndianInto
+    #endif
+
+    const std::uint32_t a[]{0x11223344, 0x55667788};
+    const float b[]{1.0f, -2.5f};
+
+    std::uint32_t aOut[2];
+    float bOut[2];
+    Endianness::swapInto(Containers::arrayView(a), Containers::arrayView(aOut));
+    Endianness::swapInto(Containers::arrayView(b), Containers::arrayView(bOut));
+    CORRADE_COMPARE_AS(Containers::arrayView(aOut),
+        Containers::arrayView<std::uint32_t>({
+            0x44332211, 0x88776655
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(bOut[1], Endianness::swap(-2.5f));
+
+    /* The input is left untouched */
+    CORRADE_COMPARE(a[0], 0x11223344);
+
+    std::uint32_t aCurrent[2];
+    Endianness::currentInto(Containers::arrayView(a), Containers::arrayView(aCurrent));
+    CORRADE_COMPARE_AS(Containers::arrayView(aCurrent),
+        Containers::arrayView(a),
+        TestSuite::Compare::Container);
+
+    std::uint32_t aOther[2];
+    Endianness::otherInto(Containers::arrayView(a), Containers::arrayView(aOther));
+    CORRADE_COMPARE_AS(Containers::arrayView(aOther),
+        Containers::arrayView(aOut),
+        TestSuite::Compare::Container);
+
+    #undef currentInto
+    #undef otherInto
+}
+
+void EndiannessTest::intoStrided() {
+    /* Every other item gets swapped into a contiguous array */
+    const std::uint32_t a[]{0x11223344, 0x55667700, 0x8899aabb, 0xccddeeff};
+    std::uint32_t aOut[2];
+    Endianness::swapInto(Containers::StridedArrayView1D<const std::uint32_t>{a, 2, 8},
+        Containers::stridedArrayView(aOut));
+    CORRADE_COMPARE_AS(Containers::arrayView(aOut),
+        Containers::arrayView<std::uint32_t>({
+            0x44332211, 0xbbaa9988
+        }), TestSuite::Compare::Container);
+
+    /* Negative stride in the destination */
+    const std::uint16_t b[]{0x1122, 0x3344, 0x5566};
+    std::uint16_t bOut[3];
+    Endianness::swapInto(Containers::stridedArrayView(b),
+        Containers::StridedArrayView1D<std::uint16_t>{bOut}.flipped<0>());
+    CORRADE_COMPARE_AS(Containers::arrayView(bOut),
+        Containers::arrayView<std::uint16_t>({
+            0x6655, 0x4433, 0x2211
+        }), TestSuite::Compare::Container);
+
+    /* Non-swapping strided copy */
+    std::uint16_t bCopy[3];
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    Endianness::bigEndianInto
+    #else
+    Endianness::littleEndianInto
+    #endif
+        (Containers::stridedArrayView(b),
+         Containers::StridedArrayView1D<std::uint16_t>{bCopy}.flipped<0>());
+    CORRADE_COMPARE_AS(Containers::arrayView(bCopy),
+        Containers::arrayView<std::uint16_t>({
+            0x5566, 0x3344, 0x1122
+        }), TestSuite::Compare::Container);
+}
+
+void EndiannessTest::intoLarge() {
+    /* Large enough to hit any vectorized loop, with a weird size to test the
+       remainder handling as well */
+    Containers::Array<std::uint16_t> a{Containers::NoInit, 1037};
+    Containers::Array<std::uint32_t> b{Containers::NoInit, 1037};
+    Containers::Array<std::uint64_t> c{Containers::NoInit, 1037};
+    Containers::Array<std::uint16_t> aExpected{Containers::NoInit, 1037};
+    Containers::Array<std::uint32_t> bExpected{Containers::NoInit, 1037};
+    Containers::Array<std::uint64_t> cExpected{Containers::NoInit, 1037};
+    for(std::size_t i = 0; i != a.size(); ++i) {
+        a[i] = 0x1100u + i;
+        b[i] = 0x11223300u + i;
+        c[i] = 0x1122334455667700ull + i;
+        aExpected[i] = Endianness::swap(a[i]);
+        bExpected[i] = Endianness::swap(b[i]);
+        cExpected[i] = Endianness::swap(c[i]);
+    }
+
+    Containers::Array<std::uint16_t> aOut{Containers::NoInit, 1037};
+    Containers::Array<std::uint32_t> bOut{Containers::NoInit, 1037};
+    Containers::Array<std::uint64_t> cOut{Containers::NoInit, 1037};
+    Endianness::swapInto(Containers::arrayView<const std::uint16_t>(a), Containers::arrayView(aOut));
+    Endianness::swapInto(Containers::arrayView<const std::uint32_t>(b), Containers::arrayView(bOut));
+    Endianness::swapInto(Containers::arrayView<const std::uint64_t>(c), Containers::arrayView(cOut));
+    CORRADE_COMPARE_AS(aOut, aExpected, TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(bOut, bExpected, TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(cOut, cExpected, TestSuite::Compare::Container);
+}
+
+void EndiannessTest::intoInvalidSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const std::uint32_t a[3]{};
+    std::uint32_t b[2];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Endianness::swapInto(Containers::arrayView(a), Containers::arrayView(b));
+    Endianness::littleEndianInto(Containers::arrayView(a), Containers::arrayView(b));
+    Endianness::bigEndianInto(Containers::arrayView(a), Containers::arrayView(b));
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    CORRADE_COMPARE(out.str(),
+        "Utility::Endianness::swapInto(): expected source and destination size to be the same but got 3 and 2\n"
+        "Utility::Endianness::swapInto(): expected source and destination size to be the same but got 3 and 2\n"
+        "Utility::Endianness::bigEndianInto(): expected source and destination size to be the same but got 3 and 2\n");
+    #else
+    CORRADE_COMPARE(out.str(),
+        "Utility::Endianness::swapInto(): expected source and destination size to be the same but got 3 and 2\n"
+        "Utility::Endianness::littleEndianInto(): expected source and destination size to be the same but got 3 and 2\n"
+        "Utility::Endianness::swapInto(): expected source and destination size to be the same but got 3 and 2\n");
+    #endif
+}
+
+constexpr std::size_t BenchmarkSize = 128*1024;
+
+template<class T> void EndiannessTest::benchmarkSwapInPlace() {
+    setTestCaseTemplateName(TypeName<T>::name());
+
+    Containers::Array<T> data{Containers::ValueInit, BenchmarkSize/sizeof(T)};
+    CORRADE_BENCHMARK(10)
+        Endianness::swapInPlace(Containers::arrayView(data));
+
+    CORRADE_COMPARE(data[0], 0);
+}
+
+template<class T> void EndiannessTest::benchmarkSwapInPlaceStrided() {
+    setTestCaseTemplateName(TypeName<T>::name());
+
+    Containers::Array<T> data{Containers::ValueInit, BenchmarkSize/sizeof(T)};
+    CORRADE_BENCHMARK(10)
+        Endianness::swapInPlace(Containers::StridedArrayView1D<T>{data}.every(2));
+
+    CORRADE_COMPARE(data[0], 0);
+}
+
+template<class T> void EndiannessTest::benchmarkCopySwapInPlace() {
+    setTestCaseTemplateName(TypeName<T>::name());
+
+    /* Two passes, for comparison with benchmarkSwapInto() */
+    Containers::Array<T> src{Containers::ValueInit, BenchmarkSize/sizeof(T)};
+    Containers::Array<T> dst{Containers::NoInit, BenchmarkSize/sizeof(T)};
+    CORRADE_BENCHMARK(10) {
+        std::memcpy(dst.data(), src.data(), BenchmarkSize);
+        Endianness::swapInPlace(Containers::arrayView(dst));
+    }
+
+    CORRADE_COMPARE(dst[0], 0);
+}
+
+template<class T> void EndiannessTest::benchmarkSwapInto() {
+    setTestCaseTemplateName(TypeName<T>::name());
+
+    Containers::Array<T> src{Containers::ValueInit, BenchmarkSize/sizeof(T)};
+    Containers::Array<T> dst{Containers::NoInit, BenchmarkSize/sizeof(T)};
+    CORRADE_BENCHMARK(10)
+        Endianness::swapInto(Containers::arrayView<const T>(src), Containers::arrayView(dst));
+
+    CORRADE_COMPARE(dst[0], 0);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Corrade::Utility::Test::EndiannessTest)
@@ -0,0 +1,331 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Container.h"
+#include "Corrade/TestSuite/Compare/Numeric.h"
+#include "Corrade/Utility/DebugStl.h" /** @todo remove when <sstream> is gone */
+#include "Corrade/Utility/Directory.h"
+#include "Corrade/Utility/FileWatcherSet.h"
+#include "Corrade/Utility/FormatStl.h"
+#include "Corrade/Utility/System.h"
+
+#include "configure.h"
+
+namespace Corrade { namespace Utility { namespace Test { namespace {
+
+struct FileWatcherSetTest: TestSuite::Tester {
+    explicit FileWatcherSetTest();
+
+    void empty();
+    void nonexistent();
+
+    void setup();
+    void teardown();
+
+    void unchanged();
+    void changedWrite();
+    void changedReplaced();
+    void changedDeleted();
+    void changedDeletedIgnoreErrors();
+    void changedMultiple();
+    void changedCheckContents();
+    void changedCheckContentsParallel();
+
+    void waitTimeout();
+    void waitChanged();
+
+    private:
+        std::string _path, _filenames[3];
+};
+
+FileWatcherSetTest::FileWatcherSetTest() {
+    addTests({&FileWatcherSetTest::empty,
+              &FileWatcherSetTest::nonexistent});
+
+    addTests({&FileWatcherSetTest::unchanged,
+              &FileWatcherSetTest::changedWrite,
+              &FileWatcherSetTest::changedReplaced,
+              &FileWatcherSetTest::changedDeleted,
+              &FileWatcherSetTest::changedDeletedIgnoreErrors,
+              &FileWatcherSetTest::changedMultiple,
+              &FileWatcherSetTest::changedCheckContents,
+              &FileWatcherSetTest::changedCheckContentsParallel,
+
+              &FileWatcherSetTest::waitTimeout,
+              &FileWatcherSetTest::waitChanged},
+             &FileWatcherSetTest::setup, &FileWatcherSetTest::teardown);
+
+    _path = Directory::join(FILEWATCHER_WRITE_TEST_DIR, "set");
+    Directory::mkpath(Directory::join(_path, "sub"));
+    _filenames[0] = Directory::join(_path, "a.txt");
+    _filenames[1] = Directory::join(_path, "b.txt");
+    _filenames[2] = Directory::join(_path, "sub/c.txt");
+}
+
+/* So we don't write at the same nanosecond, see FileWatcherTest for
+   details */
+void sleepForTimestampGranularity() {
+    #if defined(CORRADE_TARGET_APPLE) || defined(CORRADE_TARGET_WINDOWS) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    System::sleep(1100);
+    #else
+    System::sleep(10);
+    #endif
+}
+
+void FileWatcherSetTest::empty() {
+    FileWatcherSet watchers{FileWatcher::Flag::IgnoreErrors};
+    CORRADE_COMPARE(watchers.flags(), FileWatcher::Flag::IgnoreErrors);
+    CORRADE_COMPARE(watchers.size(), 0);
+    #ifdef __linux__
+    CORRADE_VERIFY(watchers.isNotificationBased());
+    #else
+    CORRADE_VERIFY(!watchers.isNotificationBased());
+    #endif
+    CORRADE_VERIFY(!watchers.changed());
+}
+
+void FileWatcherSetTest::nonexistent() {
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        FileWatcherSet watchers;
+        CORRADE_COMPARE(watchers.add("nonexistent"), 0);
+        CORRADE_COMPARE(watchers.add("nonexistent/directory"), 1);
+        CORRADE_COMPARE(watchers.size(), 2);
+        CORRADE_COMPARE(watchers.filename(1), "nonexistent/directory");
+        CORRADE_VERIFY(!watchers.isValid(0));
+        CORRADE_VERIFY(!watchers.isValid(1));
+        CORRADE_VERIFY(!watchers.changed());
+    }
+
+    /* Errors reported only once */
+    CORRADE_COMPARE(out.str(),
+        "Utility::FileWatcher: can't stat nonexistent: No such file or directory, aborting watch\n"
+        "Utility::FileWatcher: can't stat nonexistent/directory: No such file or directory, aborting watch\n");
+}
+
+void FileWatcherSetTest::setup() {
+    for(const std::string& filename: _filenames)
+        Directory::writeString(filename, "hello");
+}
+
+void FileWatcherSetTest::teardown() {
+    for(const std::string& filename: _filenames)
+        Directory::rm(filename);
+}
+
+void FileWatcherSetTest::unchanged() {
+    FileWatcherSet watchers;
+    for(const std::string& filename: _filenames) watchers.add(filename);
+    CORRADE_COMPARE(watchers.size(), 3);
+    CORRADE_VERIFY(watchers.isValid(0));
+    CORRADE_VERIFY(!watchers.changed());
+
+    /* Reading doesn't count as a change */
+    sleepForTimestampGranularity();
+    CORRADE_COMPARE(Directory::readString(_filenames[1]), "hello");
+    CORRADE_VERIFY(!watchers.changed());
+}
+
+void FileWatcherSetTest::changedWrite() {
+    FileWatcherSet watchers;
+    for(const std::string& filename: _filenames) watchers.add(filename);
+    CORRADE_VERIFY(!watchers.changed());
+
+    sleepForTimestampGranularity();
+    CORRADE_VERIFY(Directory::writeString(_filenames[1], "ahoy"));
+
+    CORRADE_COMPARE_AS(watchers.changed(),
+        Containers::arrayView<std::size_t>({1}),
+        TestSuite::Compare::Container);
+    CORRADE_VERIFY(!watchers.changed()); /* Nothing changed second time */
+}
+
+void FileWatcherSetTest::changedReplaced() {
+    FileWatcherSet watchers;
+    for(const std::string& filename: _filenames) watchers.add(filename);
+    CORRADE_VERIFY(!watchers.changed());
+
+    /* A new file renamed over the original, which is what most editors do */
+    sleepForTimestampGranularity();
+    CORRADE_VERIFY(Directory::writeString(_filenames[2], "ahoy", Directory::WriteFlag::Atomic));
+
+    CORRADE_COMPARE_AS(watchers.changed(),
+        Containers::arrayView<std::size_t>({2}),
+        TestSuite::Compare::Container);
+    CORRADE_VERIFY(watchers.isValid(2));
+
+    /* The replaced file is still watched */
+    sleepForTimestampGranularity();
+    CORRADE_VERIFY(Directory::writeString(_filenames[2], "hello again"));
+    CORRADE_COMPARE_AS(watchers.changed(),
+        Containers::arrayView<std::size_t>({2}),
+        TestSuite::Compare::Container);
+}
+
+void FileWatcherSetTest::changedDeleted() {
+    FileWatcherSet watchers;
+    for(const std::string& filename: _filenames) watchers.add(filename);
+    CORRADE_VERIFY(!watchers.changed());
+
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        CORRADE_VERIFY(Directory::rm(_filenames[0]));
+        CORRADE_VERIFY(!watchers.changed());
+    }
+    CORRADE_VERIFY(!watchers.isValid(0));
+    CORRADE_VERIFY(watchers.isValid(1));
+    CORRADE_COMPARE(out.str(), Utility::formatString(
+        "Utility::FileWatcher: can't stat {}: No such file or directory, aborting watch\n", _filenames[0]));
+}
+
+void FileWatcherSetTest::changedDeletedIgnoreErrors() {
+    FileWatcherSet watchers{FileWatcher::Flag::IgnoreErrors};
+    for(const std::string& filename: _filenames) watchers.add(filename);
+    CORRADE_VERIFY(!watchers.changed());
+
+    {
+        Error redirectError{nullptr};
+        CORRADE_VERIFY(Directory::rm(_filenames[0]));
+        CORRADE_VERIFY(!watchers.changed());
+    }
+    CORRADE_VERIFY(watchers.isValid(0));
+
+    sleepForTimestampGranularity();
+    CORRADE_VERIFY(Directory::writeString(_filenames[0], "hello again"));
+    CORRADE_COMPARE_AS(watchers.changed(),
+        Containers::arrayView<std::size_t>({0}),
+        TestSuite::Compare::Container);
+}
+
+void FileWatcherSetTest::changedMultiple() {
+    FileWatcherSet watchers;
+    for(const std::string& filename: _filenames) watchers.add(filename);
+    CORRADE_VERIFY(!watchers.changed());
+
+    sleepForTimestampGranularity();
+    CORRADE_VERIFY(Directory::writeString(_filenames[2], "ahoy"));
+    CORRADE_VERIFY(Directory::writeString(_filenames[0], "ahoy"));
+
+    Containers::Array<std::size_t> changed = watchers.changed();
+    std::sort(changed.begin(), changed.end());
+    CORRADE_COMPARE_AS(changed,
+        Containers::arrayView<std::size_t>({0, 2}),
+        TestSuite::Compare::Container);
+    CORRADE_VERIFY(!watchers.changed());
+}
+
+void FileWatcherSetTest::changedCheckContents() {
+    FileWatcherSet watchers{FileWatcher::Flag::CheckContents};
+    for(const std::string& filename: _filenames) watchers.add(filename);
+    CORRADE_VERIFY(!watchers.changed());
+
+    /* Files rewritten with the same contents are not reported */
+    sleepForTimestampGranularity();
+    CORRADE_VERIFY(Directory::writeString(_filenames[0], "hello"));
+    CORRADE_VERIFY(Directory::writeString(_filenames[1], "ahoy"));
+    CORRADE_VERIFY(Directory::writeString(_filenames[2], "hello"));
+    CORRADE_COMPARE_AS(watchers.changed(),
+        Containers::arrayView<std::size_t>({1}),
+        TestSuite::Compare::Container);
+
+    /* Compared against the last change, not the original */
+    sleepForTimestampGranularity();
+    CORRADE_VERIFY(Directory::writeString(_filenames[1], "ahoy"));
+    CORRADE_VERIFY(Directory::writeString(_filenames[2], "ahoy"));
+    CORRADE_COMPARE_AS(watchers.changed(),
+        Containers::arrayView<std::size_t>({2}),
+        TestSuite::Compare::Container);
+}
+
+void FileWatcherSetTest::changedCheckContentsParallel() {
+    FileWatcherSet watchers{FileWatcher::Flag::CheckContents};
+    for(const std::string& filename: _filenames) watchers.add(filename);
+
+    /* A serial executor that counts the jobs, the threading itself is tested
+       in ThreadPoolTest */
+    std::size_t jobCount = 0;
+    watchers.setParallelExecutor([](void* state, std::size_t count, void(*job)(void*, std::size_t), void* jobState) {
+        *static_cast<std::size_t*>(state) += count;
+        for(std::size_t i = 0; i != count; ++i) job(jobState, i);
+    }, &jobCount);
+
+    sleepForTimestampGranularity();
+    CORRADE_VERIFY(Directory::writeString(_filenames[0], "ahoy"));
+    CORRADE_VERIFY(Directory::writeString(_filenames[1], "hello"));
+    CORRADE_VERIFY(Directory::writeString(_filenames[2], "ahoy"));
+
+    Containers::Array<std::size_t> changed = watchers.changed();
+    std::sort(changed.begin(), changed.end());
+    CORRADE_COMPARE_AS(changed,
+        Containers::arrayView<std::size_t>({0, 2}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(jobCount, 3);
+
+    /* A single file is hashed directly without going through the executor */
+    sleepForTimestampGranularity();
+    CORRADE_VERIFY(Directory::writeString(_filenames[1], "ahoy"));
+    CORRADE_COMPARE_AS(watchers.changed(),
+        Containers::arrayView<std::size_t>({1}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(jobCount, 3);
+}
+
+void FileWatcherSetTest::waitTimeout() {
+    FileWatcherSet watchers;
+    for(const std::string& filename: _filenames) watchers.add(filename);
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    CORRADE_VERIFY(!watchers.wait(50));
+    CORRADE_COMPARE_AS(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count(), 50,
+        TestSuite::Compare::GreaterOrEqual);
+}
+
+void FileWatcherSetTest::waitChanged() {
+    FileWatcherSet watchers;
+    for(const std::string& filename: _filenames) watchers.add(filename);
+
+    sleepForTimestampGranularity();
+    CORRADE_VERIFY(Directory::writeString(_filenames[1], "ahoy"));
+
+    /* Returns immediately, without waiting for the timeout */
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    CORRADE_COMPARE_AS(watchers.wait(10000),
+        Containers::arrayView<std::size_t>({1}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count(), 1000,
+        TestSuite::Compare::Less);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Utility::Test::FileWatcherSetTest)
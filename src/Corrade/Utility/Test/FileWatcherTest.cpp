@@ -52,6 +52,7 @@ struct FileWatcherTest: TestSuite::Tester {
     void changedRecreatedLateIgnoreErrors();
     void changedCleared();
     void changedClearedIgnoreEmpty();
+    void changedCheckContents();
 
     void debugFlag();
     void debugFlags();
@@ -74,7 +75,8 @@ FileWatcherTest::FileWatcherTest() {
               &FileWatcherTest::changedRecreatedLate,
               &FileWatcherTest::changedRecreatedLateIgnoreErrors,
               &FileWatcherTest::changedCleared,
-              &FileWatcherTest::changedClearedIgnoreEmpty},
+              &FileWatcherTest::changedClearedIgnoreEmpty,
+              &FileWatcherTest::changedCheckContents},
              &FileWatcherTest::setup, &FileWatcherTest::teardown);
 
     addTests({&FileWatcherTest::debugFlag,
@@ -323,6 +325,48 @@ void FileWatcherTest::changedClearedIgnoreEmpty() {
     }
 }
 
+void FileWatcherTest::changedCheckContents() {
+    CORRADE_VERIFY(Directory::exists(_filename));
+
+    FileWatcher watcher{_filename, FileWatcher::Flag::CheckContents};
+    CORRADE_COMPARE(watcher.flags(), FileWatcher::Flag::CheckContents);
+    CORRADE_VERIFY(watcher.isValid());
+    CORRADE_VERIFY(!watcher.hasChanged());
+
+    /* See above for details */
+    /** @todo get rid of this once proper FS inode etc. watching is implemented */
+    #if defined(CORRADE_TARGET_APPLE) || defined(CORRADE_TARGET_WINDOWS) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    constexpr std::size_t sleep = 1100;
+    #else
+    constexpr std::size_t sleep = 10;
+    #endif
+
+    /* Writing the same contents updates the modification time but isn't
+       signalled */
+    System::sleep(sleep);
+    CORRADE_VERIFY(Directory::writeString(_filename, "hello"));
+    CORRADE_VERIFY(!watcher.hasChanged());
+
+    /* Different contents are */
+    System::sleep(sleep);
+    CORRADE_VERIFY(Directory::writeString(_filename, "ahoy"));
+    CORRADE_VERIFY(watcher.hasChanged());
+    CORRADE_VERIFY(!watcher.hasChanged());
+
+    /* The contents are compared against the last change, not the original */
+    System::sleep(sleep);
+    CORRADE_VERIFY(Directory::writeString(_filename, "ahoy"));
+    CORRADE_VERIFY(!watcher.hasChanged());
+
+    /* An empty file is a change as well, and doesn't print any error */
+    std::ostringstream out;
+    Error redirectError{&out};
+    System::sleep(sleep);
+    CORRADE_VERIFY(Directory::writeString(_filename, ""));
+    CORRADE_VERIFY(watcher.hasChanged());
+    CORRADE_COMPARE(out.str(), "");
+}
+
 void FileWatcherTest::debugFlag() {
     std::ostringstream out;
 
@@ -333,8 +377,8 @@ void FileWatcherTest::debugFlag() {
 void FileWatcherTest::debugFlags() {
     std::ostringstream out;
 
-    Debug(&out) << (FileWatcher::Flag::IgnoreChangeIfEmpty|FileWatcher::Flag::IgnoreErrors) << FileWatcher::Flags{};
-    CORRADE_COMPARE(out.str(), "Utility::FileWatcher::Flag::IgnoreErrors|Utility::FileWatcher::Flag::IgnoreChangeIfEmpty Utility::FileWatcher::Flags{}\n");
+    Debug(&out) << (FileWatcher::Flag::IgnoreChangeIfEmpty|FileWatcher::Flag::IgnoreErrors|FileWatcher::Flag::CheckContents) << FileWatcher::Flags{};
+    CORRADE_COMPARE(out.str(), "Utility::FileWatcher::Flag::IgnoreErrors|Utility::FileWatcher::Flag::IgnoreChangeIfEmpty|Utility::FileWatcher::Flag::CheckContents Utility::FileWatcher::Flags{}\n");
 }
 
 }}}}
@@ -23,13 +23,20 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <limits>
 #include <sstream>
+#include <vector>
 
 #include "Corrade/Containers/Array.h"
+#include "Corrade/Containers/GrowableArray.h"
 #include "Corrade/Containers/ScopeGuard.h"
+#include "Corrade/Containers/StridedArrayView.h"
 #include "Corrade/TestSuite/Tester.h"
 #include "Corrade/TestSuite/Compare/FileToString.h"
+#include "Corrade/Utility/BufferedFile.h"
 #include "Corrade/Utility/DebugStl.h"
 #include "Corrade/Utility/Directory.h"
 #include "Corrade/Utility/Format.h"
@@ -59,6 +66,7 @@ struct FormatTest: TestSuite::Tester {
     void integerFloat();
 
     void integerPrecision();
+    void integerLimits();
 
     void floatingFloat();
     void floatingDouble();
@@ -66,6 +74,7 @@ struct FormatTest: TestSuite::Tester {
     void floatingLongDouble();
     #endif
     template<class T> void floatingPrecision();
+    template<class T> void floatingMatchesSnprintf();
 
     void floatGeneric();
     void floatGenericUppercase();
@@ -87,18 +96,25 @@ struct FormatTest: TestSuite::Tester {
     void numberedType();
     void numberedPrecision();
     void numberedPrecisionBase();
+    void numberedDifferentFormatting();
     void mixed();
 
     void toBuffer();
+    void toBufferNoNullTerminatorAtTheEnd();
     void toBufferNullTerminatorFromSnprintfAtTheEnd();
     void array();
     void arrayNullTerminatorFromSnprintfAtTheEnd();
     void appendToString();
     void insertToString();
+    void appendToArray();
+    void appendToArrayNotGrowable();
     void file();
     #ifndef CORRADE_TARGET_EMSCRIPTEN
     void fileLongDouble();
     #endif
+    void bufferedFile();
+    void bufferedFileFlushThreshold();
+    void bufferedFileMove();
 
     void tooLittlePlaceholders();
     void tooManyPlaceholders();
@@ -111,7 +127,27 @@ struct FormatTest: TestSuite::Tester {
     void typeForString();
     void invalidType();
 
+    void compiledInfo();
+    void compiled();
+    void compiledNumbered();
+    void compiledToBuffer();
+    void compiledArray();
+    void compiledAppendToString();
+    void compiledAppendToArray();
+    void compiledFile();
+    void compiledTooSmallBuffer();
+
+    void numbers();
+    void numbersFloat();
+    void numbersStrided();
+    void numbersAppend();
+    void numbersEmpty();
+    void numbersLargePrecision();
+    void numbersTable();
+    void numbersTableEmptyRows();
+
     void benchmarkFormat();
+    void benchmarkFormatCompiled();
     void benchmarkSnprintf();
     void benchmarkSstream();
     void benchmarkDebug();
@@ -120,6 +156,17 @@ struct FormatTest: TestSuite::Tester {
     void benchmarkFloatSnprintf();
     void benchmarkFloatSstream();
     void benchmarkFloatDebug();
+
+    void benchmarkIntegersFormat();
+    void benchmarkIntegersSnprintf();
+    void benchmarkFloatsFormat();
+    void benchmarkFloatsSnprintf();
+
+    void benchmarkFile();
+    void benchmarkBufferedFile();
+
+    void benchmarkNumbersFormatInto();
+    void benchmarkNumbersFormatNumbersInto();
 };
 
 FormatTest::FormatTest() {
@@ -140,6 +187,7 @@ FormatTest::FormatTest() {
               &FormatTest::integerFloat,
 
               &FormatTest::integerPrecision,
+              &FormatTest::integerLimits,
 
               &FormatTest::floatingFloat,
               &FormatTest::floatingDouble,
@@ -151,6 +199,8 @@ FormatTest::FormatTest() {
               #ifndef CORRADE_TARGET_EMSCRIPTEN
               &FormatTest::floatingPrecision<long double>,
               #endif
+              &FormatTest::floatingMatchesSnprintf<float>,
+              &FormatTest::floatingMatchesSnprintf<double>,
 
               &FormatTest::floatGeneric,
               &FormatTest::floatGenericUppercase,
@@ -172,18 +222,25 @@ FormatTest::FormatTest() {
               &FormatTest::numberedType,
               &FormatTest::numberedPrecision,
               &FormatTest::numberedPrecisionBase,
+              &FormatTest::numberedDifferentFormatting,
               &FormatTest::mixed,
 
               &FormatTest::toBuffer,
+              &FormatTest::toBufferNoNullTerminatorAtTheEnd,
               &FormatTest::toBufferNullTerminatorFromSnprintfAtTheEnd,
               &FormatTest::array,
               &FormatTest::arrayNullTerminatorFromSnprintfAtTheEnd,
               &FormatTest::appendToString,
               &FormatTest::insertToString,
+              &FormatTest::appendToArray,
+              &FormatTest::appendToArrayNotGrowable,
               &FormatTest::file,
               #ifndef CORRADE_TARGET_EMSCRIPTEN
               &FormatTest::fileLongDouble,
               #endif
+              &FormatTest::bufferedFile,
+              &FormatTest::bufferedFileFlushThreshold,
+              &FormatTest::bufferedFileMove,
 
               &FormatTest::tooLittlePlaceholders,
               &FormatTest::tooManyPlaceholders,
@@ -194,9 +251,29 @@ FormatTest::FormatTest() {
               &FormatTest::unknownPlaceholderContent,
               &FormatTest::invalidPrecision,
               &FormatTest::typeForString,
-              &FormatTest::invalidType});
+              &FormatTest::invalidType,
+
+              &FormatTest::compiledInfo,
+              &FormatTest::compiled,
+              &FormatTest::compiledNumbered,
+              &FormatTest::compiledToBuffer,
+              &FormatTest::compiledArray,
+              &FormatTest::compiledAppendToString,
+              &FormatTest::compiledAppendToArray,
+              &FormatTest::compiledFile,
+              &FormatTest::compiledTooSmallBuffer,
+
+              &FormatTest::numbers,
+              &FormatTest::numbersFloat,
+              &FormatTest::numbersStrided,
+              &FormatTest::numbersAppend,
+              &FormatTest::numbersEmpty,
+              &FormatTest::numbersLargePrecision,
+              &FormatTest::numbersTable,
+              &FormatTest::numbersTableEmptyRows});
 
     addBenchmarks({&FormatTest::benchmarkFormat,
+                   &FormatTest::benchmarkFormatCompiled,
                    &FormatTest::benchmarkSnprintf,
                    &FormatTest::benchmarkSstream,
                    &FormatTest::benchmarkDebug,
@@ -204,7 +281,18 @@ FormatTest::FormatTest() {
                    &FormatTest::benchmarkFloatFormat,
                    &FormatTest::benchmarkFloatSnprintf,
                    &FormatTest::benchmarkFloatSstream,
-                   &FormatTest::benchmarkFloatDebug}, 50);
+                   &FormatTest::benchmarkFloatDebug,
+
+                   &FormatTest::benchmarkIntegersFormat,
+                   &FormatTest::benchmarkIntegersSnprintf,
+                   &FormatTest::benchmarkFloatsFormat,
+                   &FormatTest::benchmarkFloatsSnprintf,
+
+                   &FormatTest::benchmarkFile,
+                   &FormatTest::benchmarkBufferedFile,
+
+                   &FormatTest::benchmarkNumbersFormatInto,
+                   &FormatTest::benchmarkNumbersFormatNumbersInto}, 50);
 }
 
 void FormatTest::empty() {
@@ -310,6 +398,23 @@ void FormatTest::integerPrecision() {
     CORRADE_COMPARE(formatString("{:.15}", 1536ull), "000000000001536");
 }
 
+void FormatTest::integerLimits() {
+    CORRADE_COMPARE(formatString("{} {}", std::numeric_limits<int>::min(), std::numeric_limits<int>::max()), "-2147483648 2147483647");
+    CORRADE_COMPARE(formatString("{}", std::numeric_limits<unsigned int>::max()), "4294967295");
+    CORRADE_COMPARE(formatString("{} {}", std::numeric_limits<long long>::min(), std::numeric_limits<long long>::max()), "-9223372036854775808 9223372036854775807");
+    CORRADE_COMPARE(formatString("{}", std::numeric_limits<unsigned long long>::max()), "18446744073709551615");
+
+    /* Negative values are printed as unsigned in other bases, same as
+       printf() does */
+    CORRADE_COMPARE(formatString("{:x} {:X} {:o}", -1, -255, -8), "ffffffff FFFFFF01 37777777770");
+    CORRADE_COMPARE(formatString("{:x} {:o}", -1ll, std::numeric_limits<long long>::min()), "ffffffffffffffff 1000000000000000000000");
+    CORRADE_COMPARE(formatString("{:x} {:o}", std::numeric_limits<unsigned long long>::max(), std::numeric_limits<unsigned long long>::max()), "ffffffffffffffff 1777777777777777777777");
+
+    /* Padding is applied after the sign */
+    CORRADE_COMPARE(formatString("{:.5} {:.5x}", -42, -42ll), "-00042 ffffffffffffffd6");
+    CORRADE_COMPARE(formatString("{:.5x} {:.5o}", 42, 42ull), "0002a 00052");
+}
+
 void FormatTest::floatingFloat() {
     CORRADE_COMPARE(formatString("{}", 12.34f), "12.34");
     #ifndef __MINGW32__
@@ -406,6 +511,49 @@ template<class T> void FormatTest::floatingPrecision() {
     }
 }
 
+template<class T> void FormatTest::floatingMatchesSnprintf() {
+    setTestCaseTemplateName(FloatingPrecisionData<T>::name());
+
+    /* The formatting doesn't go through snprintf() anymore, verify it gives
+       the same output for values and precisions that are close to rounding
+       boundaries or need a lot of digits */
+    std::vector<T> values{
+        T(0.0), T(-0.0), T(1.0), T(-1.0), T(0.1), T(0.5), T(1.0)/T(3.0),
+        T(2.5), T(9.5), T(0.95), T(0.995), T(9.9999999), T(99999.95),
+        T(1.5e-5), T(0.0001), T(123456789.0), T(1.0e15), T(1.0e16),
+        T(-12345.67890123456789l), T(3.1415926535897932384626l),
+        T(1.234567890123456789e-12l), T(8.589973e9), T(5.0e-324l),
+        std::numeric_limits<T>::min(),
+        std::numeric_limits<T>::denorm_min(),
+        std::numeric_limits<T>::max(),
+        std::numeric_limits<T>::lowest(),
+        std::numeric_limits<T>::epsilon()};
+    for(int i = -40; i <= 40; ++i)
+        values.push_back(std::pow(T(10.0), T(i)));
+
+    /* Pseudo-random bit patterns, skipping non-finite values */
+    std::uint64_t seed = 0x9e3779b97f4a7c15ull;
+    while(values.size() < 400) {
+        seed = seed*6364136223846793005ull + 1442695040888963407ull;
+        typename std::conditional<sizeof(T) == 4, std::uint32_t, std::uint64_t>::type bits = seed >> (64 - sizeof(T)*8);
+        T value;
+        std::memcpy(&value, &bits, sizeof(T));
+        if(std::isfinite(value)) values.push_back(value);
+    }
+
+    for(const char type: {'g', 'G', 'e', 'E', 'f', 'F'}) {
+        for(int precision = 0; precision != 18; ++precision) {
+            const std::string format = "{:." + std::to_string(precision) + type + "}";
+            const char printfFormat[]{'%', '.', '*', type, 0};
+            for(const T value: values) {
+                char expected[512];
+                std::snprintf(expected, sizeof(expected), printfFormat, precision, double(value));
+                CORRADE_COMPARE(formatString(format.data(), value), expected);
+            }
+        }
+    }
+}
+
 void FormatTest::floatGeneric() {
     #ifndef __MINGW32__
     CORRADE_COMPARE(formatString("{}", 1234.0e5f), "1.234e+08");
@@ -673,6 +821,14 @@ void FormatTest::numberedPrecisionBase() {
         "B000000B");
 }
 
+void FormatTest::numberedDifferentFormatting() {
+    /* The output size of a repeated argument shouldn't be calculated just
+       once if it's formatted differently each time */
+    const std::string out = formatString("{1} {0} {1:x} {}", 42, 255, "next");
+    CORRADE_COMPARE(out, "255 42 ff next");
+    CORRADE_COMPARE(out.size(), 14);
+}
+
 void FormatTest::mixed() {
     CORRADE_COMPARE(formatString("this {1} {} {0}, {}", "wrong", "is", "certainly"),
         "this is certainly wrong, is");
@@ -685,14 +841,31 @@ void FormatTest::toBuffer() {
     CORRADE_COMPARE(std::string{buffer}, "hello, world!?");
 }
 
-void FormatTest::toBufferNullTerminatorFromSnprintfAtTheEnd() {
+void FormatTest::toBufferNoNullTerminatorAtTheEnd() {
+    /* Since integers are no longer formatted with snprintf(), the whole
+       output fits into the buffer with no space for a null terminator */
     char buffer[8];
     CORRADE_COMPARE(formatInto(buffer, "hello {}", 42), 8);
+    CORRADE_COMPARE((std::string{buffer, 8}), "hello 42");
+}
+
+void FormatTest::toBufferNullTerminatorFromSnprintfAtTheEnd() {
+    /* Floats that the fast path can't handle go through snprintf(), which
+       always wants to write a null terminator. The last character shouldn't
+       get cut off. */
     {
-        CORRADE_EXPECT_FAIL("snprintf() really wants to print a null terminator so the last character gets cut off. Need a better solution.");
-        CORRADE_COMPARE((std::string{buffer, 8}), "hello 42");
+        char buffer[24];
+        CORRADE_COMPARE(formatInto(buffer, "x {:.20}", 0.1), 24);
+        CORRADE_COMPARE((std::string{buffer, 24}), "x 0.10000000000000000555");
     }
-    CORRADE_COMPARE(std::string{buffer}, "hello 4");
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    {
+        char buffer[8];
+        CORRADE_COMPARE(formatInto(buffer, "x {}", 0.5l), 5);
+        CORRADE_COMPARE(formatInto(buffer, "x {:.4f}", 0.5l), 8);
+        CORRADE_COMPARE((std::string{buffer, 8}), "x 0.5000");
+    }
+    #endif
 }
 
 void FormatTest::array() {
@@ -721,6 +894,21 @@ void FormatTest::insertToString() {
     CORRADE_COMPARE(hello.size(), 36);
 }
 
+void FormatTest::appendToArray() {
+    Containers::Array<char> out;
+    CORRADE_COMPARE(formatInto(out, "hello, {}!", "world"), 13);
+    CORRADE_COMPARE(formatInto(out, " {:.3} {}", 42, 3.5f), 8);
+    CORRADE_COMPARE(formatInto(out, "{}", 1.0e-5), 5);
+    CORRADE_COMPARE((std::string{out, out.size()}), "hello, world! 042 3.51e-05");
+}
+
+void FormatTest::appendToArrayNotGrowable() {
+    /* Gets converted to a growable array and then appended to */
+    Containers::Array<char> out{Containers::InPlaceInit, {'h', 'e', 'y'}};
+    CORRADE_COMPARE(formatInto(out, ", {}", "you"), 5);
+    CORRADE_COMPARE((std::string{out, out.size()}), "hey, you");
+}
+
 void FormatTest::file() {
     const std::string filename = Directory::join(FORMAT_WRITE_TEST_DIR, "format.txt");
     if(!Directory::exists(FORMAT_WRITE_TEST_DIR))
@@ -769,6 +957,102 @@ void FormatTest::fileLongDouble() {
 }
 #endif
 
+void FormatTest::bufferedFile() {
+    const std::string filename = Directory::join(FORMAT_WRITE_TEST_DIR, "format-buffered.txt");
+    if(!Directory::exists(FORMAT_WRITE_TEST_DIR))
+        CORRADE_VERIFY(Directory::mkpath(FORMAT_WRITE_TEST_DIR));
+    if(Directory::exists(filename))
+        CORRADE_VERIFY(Directory::rm(filename));
+
+    {
+        FILE* f = std::fopen(filename.data(), "w");
+        CORRADE_VERIFY(f);
+        Containers::ScopeGuard e{f, fclose};
+        BufferedFile file{f};
+        CORRADE_COMPARE(file.file(), f);
+        CORRADE_COMPARE(file.flushThreshold(), 65536);
+
+        formatInto(file, "A {} {} {}", "string", std::string{"file"}, -2000123);
+        formatInto(file, CORRADE_FORMAT(" {:x} + ({})"), 255, 12.3404f);
+        file.write({" raw", 4});
+        /* Nothing is written until destruction */
+        CORRADE_COMPARE((std::string{file.buffered(), file.buffered().size()}),
+            "A string file -2000123 ff + (12.3404) raw");
+    }
+    CORRADE_COMPARE_AS(filename,
+        "A string file -2000123 ff + (12.3404) raw",
+        TestSuite::Compare::FileToString);
+}
+
+void FormatTest::bufferedFileFlushThreshold() {
+    const std::string filename = Directory::join(FORMAT_WRITE_TEST_DIR, "format-buffered-threshold.txt");
+    if(!Directory::exists(FORMAT_WRITE_TEST_DIR))
+        CORRADE_VERIFY(Directory::mkpath(FORMAT_WRITE_TEST_DIR));
+    if(Directory::exists(filename))
+        CORRADE_VERIFY(Directory::rm(filename));
+
+    FILE* f = std::fopen(filename.data(), "w");
+    CORRADE_VERIFY(f);
+    Containers::ScopeGuard e{f, fclose};
+    BufferedFile file{f, 10};
+
+    /* Below the threshold, stays buffered */
+    formatInto(file, "{} {}", 1234, 5678);
+    CORRADE_COMPARE(file.buffered().size(), 9);
+
+    /* Reaching the threshold writes everything */
+    formatInto(file, "!");
+    CORRADE_VERIFY(file.buffered().empty());
+    std::fflush(f);
+    CORRADE_COMPARE_AS(filename, "1234 5678!",
+        TestSuite::Compare::FileToString);
+
+    /* Zero threshold writes after each call, explicit flush writes the rest
+       regardless of the threshold */
+    file.setFlushThreshold(0);
+    formatInto(file, "{}", 3);
+    CORRADE_VERIFY(file.buffered().empty());
+    file.setFlushThreshold(100);
+    file.write({"abc", 3});
+    CORRADE_COMPARE(file.buffered().size(), 3);
+    file.flush();
+    CORRADE_VERIFY(file.buffered().empty());
+    std::fflush(f);
+    CORRADE_COMPARE_AS(filename, "1234 5678!3abc",
+        TestSuite::Compare::FileToString);
+}
+
+void FormatTest::bufferedFileMove() {
+    const std::string filename = Directory::join(FORMAT_WRITE_TEST_DIR, "format-buffered-move.txt");
+    if(!Directory::exists(FORMAT_WRITE_TEST_DIR))
+        CORRADE_VERIFY(Directory::mkpath(FORMAT_WRITE_TEST_DIR));
+    if(Directory::exists(filename))
+        CORRADE_VERIFY(Directory::rm(filename));
+
+    {
+        FILE* f = std::fopen(filename.data(), "w");
+        CORRADE_VERIFY(f);
+        Containers::ScopeGuard e{f, fclose};
+        BufferedFile a{f, 1000};
+        formatInto(a, "hello");
+
+        /* The moved-from instance shouldn't write anything on destruction */
+        BufferedFile b{std::move(a)};
+        CORRADE_VERIFY(!a.file());
+        CORRADE_COMPARE(b.file(), f);
+        CORRADE_COMPARE(b.flushThreshold(), 1000);
+        CORRADE_COMPARE(b.buffered().size(), 5);
+
+        BufferedFile c{nullptr};
+        c = std::move(b);
+        CORRADE_COMPARE(c.file(), f);
+        CORRADE_COMPARE(c.buffered().size(), 5);
+        formatInto(c, " {}", "world");
+    }
+    CORRADE_COMPARE_AS(filename, "hello world",
+        TestSuite::Compare::FileToString);
+}
+
 void FormatTest::tooLittlePlaceholders() {
     /* Not a problem */
     CORRADE_COMPARE(formatString("{}!", 42, "but this is", "not visible", 1337), "42!");
@@ -882,8 +1166,231 @@ void FormatTest::invalidType() {
         "Utility::format(): invalid type specifier: H\n");
 }
 
+void FormatTest::compiledInfo() {
+    constexpr Implementation::FormatInfo empty = Implementation::formatInfo("");
+    CORRADE_COMPARE(empty.argumentCount, 0);
+    CORRADE_COMPARE(empty.chunkCount, 1);
+
+    constexpr Implementation::FormatInfo implicit = Implementation::formatInfo("a {} b {:x} c {:.3}");
+    CORRADE_COMPARE(implicit.argumentCount, 3);
+    CORRADE_VERIFY(implicit.chunkCount >= 7);
+
+    /* Numbered placeholders, the argument count is the largest index, an
+       implicit placeholder after a numbered one takes the next index */
+    constexpr Implementation::FormatInfo numbered = Implementation::formatInfo("{2} {0} {}");
+    CORRADE_COMPARE(numbered.argumentCount, 3);
+    constexpr Implementation::FormatInfo repeated = Implementation::formatInfo("{0}{0}{0:x}");
+    CORRADE_COMPARE(repeated.argumentCount, 1);
+
+    /* Escapes are not placeholders */
+    constexpr Implementation::FormatInfo escapes = Implementation::formatInfo("{{}} {{{}}}");
+    CORRADE_COMPARE(escapes.argumentCount, 1);
+}
+
+void FormatTest::compiled() {
+    CORRADE_COMPARE(formatString(CORRADE_FORMAT("")), "");
+    CORRADE_COMPARE(formatString(CORRADE_FORMAT("hello")), "hello");
+    CORRADE_COMPARE(formatString(CORRADE_FORMAT("{{hello}} {{}}")), "{hello} {}");
+    CORRADE_COMPARE(formatString(CORRADE_FORMAT("A {} {} {} {}!"),
+        "string", std::string{"and"}, -2000123, 12.3404f),
+        "A string and -2000123 12.3404!");
+    CORRADE_COMPARE(formatString(CORRADE_FORMAT("#{:.2x}{:.2x}{:.2X} {:.3f} {:.4}"),
+        0xff, 0x3, 0xcc, 3.14159f, "hello"),
+        "#ff03CC 3.142 hell");
+    CORRADE_COMPARE(formatString(CORRADE_FORMAT("{}{}"), 1, 2), "12");
+}
+
+void FormatTest::compiledNumbered() {
+    CORRADE_COMPARE(formatString(CORRADE_FORMAT("{1} {0} {1:x} {}"), 42, 255, "next"),
+        "255 42 ff next");
+}
+
+void FormatTest::compiledToBuffer() {
+    char buffer[15]{};
+    CORRADE_COMPARE(formatInto(buffer, CORRADE_FORMAT("hello, {}!"), "world"), 13);
+    CORRADE_COMPARE(std::string(buffer, 13), "hello, world!");
+
+    /* Null buffer just calculates the size */
+    CORRADE_COMPARE(formatInto(Containers::ArrayView<char>{}, CORRADE_FORMAT("{} + {} = {}"), 1, 2, 3), 9);
+}
+
+void FormatTest::compiledArray() {
+    Containers::Array<char> array = format(CORRADE_FORMAT("hello {}"), 42);
+    CORRADE_COMPARE((std::string{array, array.size()}), "hello 42");
+}
+
+void FormatTest::compiledAppendToString() {
+    std::string hello = "hello";
+    CORRADE_COMPARE(formatInto(hello, hello.size(), CORRADE_FORMAT(", {}!"), "world"), 13);
+    CORRADE_COMPARE(hello, "hello, world!");
+
+    std::string insert = "hello, __________!";
+    CORRADE_COMPARE(formatInto(insert, 8, CORRADE_FORMAT("{}"), "Frank"), 13);
+    CORRADE_COMPARE(insert, "hello, _Frank____!");
+}
+
+void FormatTest::compiledAppendToArray() {
+    Containers::Array<char> out;
+    CORRADE_COMPARE(formatInto(out, CORRADE_FORMAT("hello, {}!"), "world"), 13);
+    CORRADE_COMPARE(formatInto(out, CORRADE_FORMAT(" {1}{0}"), 42, 'a'), 5);
+    CORRADE_COMPARE((std::string{out, out.size()}), "hello, world! 9742");
+}
+
+void FormatTest::compiledFile() {
+    const std::string filename = Directory::join(FORMAT_WRITE_TEST_DIR, "format-compiled.txt");
+    if(!Directory::exists(FORMAT_WRITE_TEST_DIR))
+        CORRADE_VERIFY(Directory::mkpath(FORMAT_WRITE_TEST_DIR));
+    if(Directory::exists(filename))
+        CORRADE_VERIFY(Directory::rm(filename));
+
+    {
+        FILE* f = std::fopen(filename.data(), "w");
+        CORRADE_VERIFY(f);
+        Containers::ScopeGuard e{f, fclose};
+        formatInto(f, CORRADE_FORMAT("A {} {{{}}} {:x}"), "string", 42, 255);
+    }
+    CORRADE_COMPARE_AS(filename, "A string {42} ff",
+        TestSuite::Compare::FileToString);
+}
+
+void FormatTest::compiledTooSmallBuffer() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    char data[20];
+    formatInto({data, 10}, CORRADE_FORMAT("{}"), "hello this is big");
+    formatInto({data, 10}, CORRADE_FORMAT("hello is {} big"), "this");
+
+    CORRADE_COMPARE(out.str(),
+        "Utility::formatInto(): buffer too small, expected at least 17 but got 10\n"
+        "Utility::formatInto(): buffer too small, expected at least 13 but got 10\n");
+}
+
+void FormatTest::numbers() {
+    const int values[]{-1234567, 0, 42, 2147483647};
+    const unsigned long long valuesUnsigned[]{18446744073709551615ull, 1};
+
+    Containers::Array<char> out;
+    CORRADE_COMPARE(formatNumbersInto(out, values, ", "), 27);
+    CORRADE_COMPARE(std::string(out.data(), out.size()),
+        "-1234567, 0, 42, 2147483647");
+
+    Containers::Array<char> outUnsigned;
+    CORRADE_COMPARE(formatNumbersInto(outUnsigned, valuesUnsigned, " "), 22);
+    CORRADE_COMPARE(std::string(outUnsigned.data(), outUnsigned.size()),
+        "18446744073709551615 1");
+}
+
+void FormatTest::numbersFloat() {
+    const float values[]{3.1415926535f, -0.1f, 1.0e-17f, 0.0f};
+    const double valuesDouble[]{3.1415926535897932, 1.0e100};
+
+    Containers::Array<char> out;
+    CORRADE_COMPARE(formatNumbersInto(out, values, ";"), 20);
+    CORRADE_COMPARE(std::string(out.data(), out.size()),
+        "3.14159;-0.1;1e-17;0");
+
+    Containers::Array<char> outDouble;
+    formatNumbersInto(outDouble, valuesDouble, ";");
+    CORRADE_COMPARE(std::string(outDouble.data(), outDouble.size()),
+        "3.14159265358979;1e+100");
+
+    /* Custom precision */
+    Containers::Array<char> outPrecision;
+    formatNumbersInto(outPrecision, values, ";", 3);
+    CORRADE_COMPARE(std::string(outPrecision.data(), outPrecision.size()),
+        "3.14;-0.1;1e-17;0");
+}
+
+void FormatTest::numbersStrided() {
+    struct Vertex {
+        float position;
+        int id;
+    } vertices[]{{0.5f, 7}, {1.5f, -3}, {2.5f, 11}};
+    Containers::StridedArrayView1D<const float> positions{vertices, &vertices[0].position, 3, sizeof(Vertex)};
+    Containers::StridedArrayView1D<const int> ids{vertices, &vertices[0].id, 3, sizeof(Vertex)};
+
+    Containers::Array<char> out;
+    formatNumbersInto(out, positions, " ");
+    formatInto(out, " | ");
+    formatNumbersInto(out, ids.flipped<0>(), " ");
+    CORRADE_COMPARE(std::string(out.data(), out.size()),
+        "0.5 1.5 2.5 | 11 -3 7");
+}
+
+void FormatTest::numbersAppend() {
+    const long values[]{1, 22, 333};
+
+    Containers::Array<char> out;
+    formatInto(out, "values: ");
+    CORRADE_COMPARE(formatNumbersInto(out, values, ","), 8);
+    CORRADE_COMPARE(std::string(out.data(), out.size()),
+        "values: 1,22,333");
+
+    /* The unused space gets trimmed away again, but the capacity stays so
+       subsequent appends don't need to reallocate */
+    CORRADE_VERIFY(Containers::arrayCapacity(out) >= out.size());
+    formatInto(out, "!");
+    CORRADE_COMPARE(std::string(out.data(), out.size()),
+        "values: 1,22,333!");
+}
+
+void FormatTest::numbersEmpty() {
+    Containers::Array<char> out;
+    CORRADE_COMPARE(formatNumbersInto(out, Containers::StridedArrayView1D<const int>{}, ","), 0);
+    CORRADE_COMPARE(formatNumbersInto(out, Containers::StridedArrayView2D<const float>{}, ",", "\n"), 0);
+    CORRADE_COMPARE(out.size(), 0);
+    /* Shouldn't even be allocated */
+    CORRADE_VERIFY(!out.data());
+}
+
+void FormatTest::numbersLargePrecision() {
+    /* The values don't fit into the slack reserved for each value, which
+       forces the array to be enlarged and the value formatted again */
+    const unsigned int values[]{1, 2};
+    const double valuesDouble[]{1.0e100};
+
+    Containers::Array<char> out;
+    CORRADE_COMPARE(formatNumbersInto(out, values, "|", 100), 201);
+    CORRADE_COMPARE(std::string(out.data(), out.size()),
+        std::string(99, '0') + "1|" + std::string(99, '0') + "2");
+
+    Containers::Array<char> outDouble;
+    CORRADE_COMPARE(formatNumbersInto(outDouble, valuesDouble, "|", 100), 105);
+    CORRADE_COMPARE(std::string(outDouble.data(), outDouble.size()),
+        "1.00000000000000001590289110975991804683608085639452813897813275577478387721703810608134699858568151e+100");
+}
+
+void FormatTest::numbersTable() {
+    const float data[]{
+        1.0f, 2.5f, -3.0f,
+        4.0f, 0.125f, 6.0f
+    };
+    Containers::StridedArrayView2D<const float> table{data, {2, 3}};
+
+    Containers::Array<char> out;
+    CORRADE_COMPARE(formatNumbersInto(out, table, ",", "\n"), 19);
+    CORRADE_COMPARE(std::string(out.data(), out.size()),
+        "1,2.5,-3\n4,0.125,6\n");
+
+    /* Transposed */
+    Containers::Array<char> outTransposed;
+    formatNumbersInto(outTransposed, table.transposed<0, 1>(), " ", "; ");
+    CORRADE_COMPARE(std::string(outTransposed.data(), outTransposed.size()),
+        "1 4; 2.5 0.125; -3 6; ");
+}
+
+void FormatTest::numbersTableEmptyRows() {
+    const int data[1]{};
+    Containers::StridedArrayView2D<const int> table{data, data, {3, 0}, {0, 4}};
+
+    Containers::Array<char> out;
+    CORRADE_COMPARE(formatNumbersInto(out, table, ",", "\n"), 3);
+    CORRADE_COMPARE(std::string(out.data(), out.size()), "\n\n\n");
+}
+
 void FormatTest::benchmarkFormat() {
-    char buffer[1024];
+    char buffer[1024]{};
 
     CORRADE_BENCHMARK(1000)
         formatInto(buffer, "hello, {}! {1} + {2} = {} = {2} + {1}", "people", 42, 1337, 42 + 1337);
@@ -891,6 +1398,15 @@ void FormatTest::benchmarkFormat() {
     CORRADE_COMPARE(std::string{buffer}, "hello, people! 42 + 1337 = 1379 = 1337 + 42");
 }
 
+void FormatTest::benchmarkFormatCompiled() {
+    char buffer[1024]{};
+
+    CORRADE_BENCHMARK(1000)
+        formatInto(buffer, CORRADE_FORMAT("hello, {}! {1} + {2} = {} = {2} + {1}"), "people", 42, 1337, 42 + 1337);
+
+    CORRADE_COMPARE(std::string{buffer}, "hello, people! 42 + 1337 = 1379 = 1337 + 42");
+}
+
 void FormatTest::benchmarkSnprintf() {
     char buffer[1024];
 
@@ -927,7 +1443,7 @@ void FormatTest::benchmarkDebug() {
 }
 
 void FormatTest::benchmarkFloatFormat() {
-    char buffer[1024];
+    char buffer[1024]{};
 
     CORRADE_BENCHMARK(1000)
         formatInto(buffer, "hello, {}! {1} + {2} = {} = {2} + {1}", "people", 4.2, 13.37, 4.2 + 13.37);
@@ -970,6 +1486,108 @@ void FormatTest::benchmarkFloatDebug() {
     CORRADE_COMPARE(out.str(), "hello, people! 4.2 + 13.37 = 17.57 = 13.37 + 4.2");
 }
 
+void FormatTest::benchmarkIntegersFormat() {
+    char buffer[1024]{};
+
+    CORRADE_BENCHMARK(1000)
+        formatInto(buffer, "{} {} {} {:x} {:.8}", -1234567, 42u, 9876543210123ll, 0xdeadbeefu, 1337);
+
+    CORRADE_COMPARE(std::string{buffer}, "-1234567 42 9876543210123 deadbeef 00001337");
+}
+
+void FormatTest::benchmarkIntegersSnprintf() {
+    char buffer[1024];
+
+    CORRADE_BENCHMARK(1000)
+        snprintf(buffer, 1024, "%i %u %lli %x %.8i", -1234567, 42u, 9876543210123ll, 0xdeadbeefu, 1337);
+
+    CORRADE_COMPARE(std::string{buffer}, "-1234567 42 9876543210123 deadbeef 00001337");
+}
+
+void FormatTest::benchmarkFloatsFormat() {
+    char buffer[1024]{};
+
+    CORRADE_BENCHMARK(1000)
+        formatInto(buffer, "{} {} {} {:.3f} {:.4e}", 3.1415926535897932, 1.0e-17, -0.1f, 1337.5, 2.718281828);
+
+    CORRADE_COMPARE(std::string{buffer}, "3.14159265358979 1e-17 -0.1 1337.500 2.7183e+00");
+}
+
+void FormatTest::benchmarkFloatsSnprintf() {
+    char buffer[1024];
+
+    CORRADE_BENCHMARK(1000)
+        snprintf(buffer, 1024, "%.15g %.15g %g %.3f %.4e", 3.1415926535897932, 1.0e-17, double(-0.1f), 1337.5, 2.718281828);
+
+    CORRADE_COMPARE(std::string{buffer}, "3.14159265358979 1e-17 -0.1 1337.500 2.7183e+00");
+}
+
+void FormatTest::benchmarkFile() {
+    if(!Directory::exists(FORMAT_WRITE_TEST_DIR))
+        CORRADE_VERIFY(Directory::mkpath(FORMAT_WRITE_TEST_DIR));
+    FILE* f = std::fopen(Directory::join(FORMAT_WRITE_TEST_DIR, "format-benchmark.txt").data(), "w");
+    CORRADE_VERIFY(f);
+    Containers::ScopeGuard e{f, fclose};
+    /* Unbuffered, like stderr, to measure the cost of each write */
+    std::setvbuf(f, nullptr, _IONBF, 0);
+
+    CORRADE_BENCHMARK(10) {
+        for(int i = 0; i != 100; ++i)
+            formatInto(f, "v {} {} {}\n", i, 0.5f, -1.25f);
+    }
+
+    CORRADE_COMPARE(std::ftell(f), 10*(10*14 + 90*15));
+}
+
+void FormatTest::benchmarkBufferedFile() {
+    if(!Directory::exists(FORMAT_WRITE_TEST_DIR))
+        CORRADE_VERIFY(Directory::mkpath(FORMAT_WRITE_TEST_DIR));
+    FILE* f = std::fopen(Directory::join(FORMAT_WRITE_TEST_DIR, "format-benchmark-buffered.txt").data(), "w");
+    CORRADE_VERIFY(f);
+    Containers::ScopeGuard e{f, fclose};
+    /* Unbuffered, like stderr, to measure the cost of each write */
+    std::setvbuf(f, nullptr, _IONBF, 0);
+
+    {
+        BufferedFile file{f};
+        CORRADE_BENCHMARK(10) {
+            for(int i = 0; i != 100; ++i)
+                formatInto(file, "v {} {} {}\n", i, 0.5f, -1.25f);
+        }
+    }
+
+    CORRADE_COMPARE(std::ftell(f), 10*(10*14 + 90*15));
+}
+
+void FormatTest::benchmarkNumbersFormatInto() {
+    Containers::Array<float> values{Containers::NoInit, 1000};
+    for(std::size_t i = 0; i != values.size(); ++i)
+        values[i] = i*0.25f - 100.0f;
+
+    Containers::Array<char> out;
+    CORRADE_BENCHMARK(10) {
+        Containers::arrayResize(out, 0);
+        for(std::size_t i = 0; i != values.size(); ++i)
+            formatInto(out, i ? ",{}" : "{}", values[i]);
+    }
+
+    CORRADE_COMPARE(out.size(), 5521);
+}
+
+void FormatTest::benchmarkNumbersFormatNumbersInto() {
+    Containers::Array<float> values{Containers::NoInit, 1000};
+    for(std::size_t i = 0; i != values.size(); ++i)
+        values[i] = i*0.25f - 100.0f;
+
+    Containers::Array<char> out;
+    CORRADE_BENCHMARK(10) {
+        Containers::arrayResize(out, 0);
+        formatNumbersInto(out, values, ",");
+    }
+
+    CORRADE_COMPARE(out.size(), 5521);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Corrade::Utility::Test::FormatTest)
@@ -39,6 +39,9 @@ struct HashDigestTest: TestSuite::Tester {
     void constructBytes();
     void constructByteArray();
     void constructHexString();
+    void constructHexStringView();
+
+    void hexStringInto();
 
     void debug();
 };
@@ -48,6 +51,9 @@ HashDigestTest::HashDigestTest() {
               &HashDigestTest::constructBytes,
               &HashDigestTest::constructByteArray,
               &HashDigestTest::constructHexString,
+              &HashDigestTest::constructHexStringView,
+
+              &HashDigestTest::hexStringInto,
 
               &HashDigestTest::debug});
 }
@@ -74,6 +80,22 @@ void HashDigestTest::constructHexString() {
     CORRADE_COMPARE(HashDigest<4>::fromHexString("bullshit").hexString(), "00000000");
 }
 
+void HashDigestTest::constructHexStringView() {
+    using namespace Containers::Literals;
+
+    /* Not null-terminated, uppercase */
+    CORRADE_COMPARE(HashDigest<4>::fromHexString("CAFE90FA0000"_s.prefix(8)).hexString(), "cafe90fa");
+    CORRADE_COMPARE(HashDigest<4>::fromHexString(std::string{"cafe90fa"}).hexString(), "cafe90fa");
+    CORRADE_COMPARE(HashDigest<4>::fromHexString("cafe90f\xfa"_s).hexString(), "00000000");
+}
+
+void HashDigestTest::hexStringInto() {
+    constexpr HashDigest<4> digest{0xca, 0xfe, 0x90, 0xfa};
+    char out[9]{};
+    digest.hexStringInto({out, 8});
+    CORRADE_COMPARE(out, std::string{"cafe90fa"});
+}
+
 void HashDigestTest::debug() {
     std::ostringstream out;
     Debug(&out) << HashDigest<4>::fromHexString("defeca7e");
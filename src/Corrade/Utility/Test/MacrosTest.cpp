@@ -45,6 +45,10 @@ struct MacrosTest: TestSuite::Tester {
     void fallthrough();
     void cxxStandard();
     void alwaysNeverInline();
+    void likelyUnlikely();
+    void prefetch();
+    void restrict();
+    void assumeAligned();
     void function();
     void lineString();
 
@@ -60,6 +64,10 @@ MacrosTest::MacrosTest() {
               &MacrosTest::fallthrough,
               &MacrosTest::cxxStandard,
               &MacrosTest::alwaysNeverInline,
+              &MacrosTest::likelyUnlikely,
+              &MacrosTest::prefetch,
+              &MacrosTest::restrict,
+              &MacrosTest::assumeAligned,
               &MacrosTest::function,
               &MacrosTest::lineString,
 
@@ -167,6 +175,59 @@ void MacrosTest::alwaysNeverInline() {
     CORRADE_COMPARE(alwaysInline() + neverInline(), 42);
 }
 
+void MacrosTest::likelyUnlikely() {
+    int a = 3;
+
+    /* The value should be preserved, also with a comma in the condition */
+    CORRADE_VERIFY(CORRADE_LIKELY(a == 3));
+    CORRADE_VERIFY(!CORRADE_LIKELY(a == 4));
+    CORRADE_VERIFY(CORRADE_UNLIKELY(a == 3));
+    CORRADE_VERIFY(!CORRADE_UNLIKELY(a == 4));
+    CORRADE_VERIFY(CORRADE_LIKELY(std::is_same<int, decltype(a)>::value));
+    CORRADE_VERIFY(CORRADE_UNLIKELY(a));
+
+    int b = 0;
+    if(CORRADE_UNLIKELY(a != 3)) b = 1;
+    else if(CORRADE_LIKELY(a == 3)) b = 2;
+    CORRADE_COMPARE(b, 2);
+}
+
+void MacrosTest::prefetch() {
+    const int data[64]{};
+
+    /* Just verify this compiles and doesn't crash, also for addresses out of
+       bounds */
+    CORRADE_PREFETCH(data, 0, 3);
+    CORRADE_PREFETCH(data + 16, 1, 2);
+    CORRADE_PREFETCH(data + 32, 0, 1);
+    CORRADE_PREFETCH(data + 128, 0, 0);
+    CORRADE_VERIFY(true);
+}
+
+int restrictSum(const int* CORRADE_RESTRICT a, const int* CORRADE_RESTRICT b, int* CORRADE_RESTRICT out) {
+    *out = *a + *b;
+    return *out;
+}
+
+void MacrosTest::restrict() {
+    int a = 15, b = 27, out;
+    CORRADE_COMPARE(restrictSum(&a, &b, &out), 42);
+    CORRADE_COMPARE(out, 42);
+}
+
+void MacrosTest::assumeAligned() {
+    CORRADE_ALIGNAS(16) int data[4]{1, 2, 3, 4};
+    const int* cdata = data;
+
+    /* The pointer type and value should be preserved */
+    int* aligned = CORRADE_ASSUME_ALIGNED(data, 16);
+    const int* caligned = CORRADE_ASSUME_ALIGNED(cdata, 8);
+    CORRADE_VERIFY(aligned == data);
+    CORRADE_VERIFY(caligned == data);
+    CORRADE_COMPARE(aligned[3], 4);
+    CORRADE_COMPARE(caligned[2], 3);
+}
+
 /* Needs another inner anonymous namespace otherwise Clang complains about a
    missing prototype (UGH) */
 namespace SubNamespace { namespace {
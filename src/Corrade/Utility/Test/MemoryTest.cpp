@@ -0,0 +1,263 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+
+#include "Corrade/Containers/ArrayView.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/Utility/DebugStl.h"
+#include "Corrade/Utility/FormatStl.h"
+#include "Corrade/Utility/Memory.h"
+
+namespace Corrade { namespace Utility { namespace Test { namespace {
+
+struct MemoryTest: TestSuite::Tester {
+    explicit MemoryTest();
+
+    void pageSize();
+    void pageSizeHuge();
+
+    void map();
+    void mapPlacement();
+    void mapInvalidSize();
+    void remapGrow();
+    void remapShrink();
+    void remapSame();
+    void remapInvalidSize();
+    void remapPlacement();
+
+    void debugPageSize();
+};
+
+const struct {
+    const char* name;
+    Memory::PageSize pageSize;
+    int numaNode;
+} PlacementData[]{
+    {"default", Memory::PageSize::Default, Memory::NumaNodeLocal},
+    {"transparent huge pages", Memory::PageSize::TransparentHuge, Memory::NumaNodeLocal},
+    {"huge pages", Memory::PageSize::Huge, Memory::NumaNodeLocal},
+    {"interleaved", Memory::PageSize::Default, Memory::NumaNodeInterleaved},
+    {"node 0", Memory::PageSize::Default, 0},
+    {"transparent huge pages, interleaved", Memory::PageSize::TransparentHuge, Memory::NumaNodeInterleaved},
+    {"huge pages, node 0", Memory::PageSize::Huge, 0},
+    /* Nonexistent nodes are ignored */
+    {"node 1023", Memory::PageSize::Default, 1023},
+    {"node 4096", Memory::PageSize::Default, 4096}
+};
+
+MemoryTest::MemoryTest() {
+    addTests({&MemoryTest::pageSize,
+              &MemoryTest::pageSizeHuge,
+
+              &MemoryTest::map});
+
+    addInstancedTests({&MemoryTest::mapPlacement},
+        Containers::arraySize(PlacementData));
+
+    addTests({&MemoryTest::mapInvalidSize,
+              &MemoryTest::remapGrow,
+              &MemoryTest::remapShrink,
+              &MemoryTest::remapSame,
+              &MemoryTest::remapInvalidSize});
+
+    addInstancedTests({&MemoryTest::remapPlacement},
+        Containers::arraySize(PlacementData));
+
+    addTests({&MemoryTest::debugPageSize});
+}
+
+void MemoryTest::pageSize() {
+    const std::size_t size = Memory::pageSize();
+    CORRADE_VERIFY(size >= 4096);
+    /* Power of two */
+    CORRADE_VERIFY(!(size & (size - 1)));
+    Debug{} << "Page size:" << size;
+}
+
+void MemoryTest::pageSizeHuge() {
+    const std::size_t size = Memory::hugePageSize();
+    Debug{} << "Huge page size:" << size;
+
+    CORRADE_COMPARE(Memory::pageSize(Memory::PageSize::Default), Memory::pageSize());
+    if(!size) {
+        CORRADE_COMPARE(Memory::pageSize(Memory::PageSize::Huge), Memory::pageSize());
+        CORRADE_COMPARE(Memory::pageSize(Memory::PageSize::TransparentHuge), Memory::pageSize());
+        CORRADE_SKIP("Huge pages not supported on this system.");
+    }
+
+    /* A power-of-two multiple of the regular page size */
+    CORRADE_VERIFY(!(size & (size - 1)));
+    CORRADE_COMPARE(size % Memory::pageSize(), 0);
+    CORRADE_COMPARE(Memory::pageSize(Memory::PageSize::Huge), size);
+}
+
+void MemoryTest::map() {
+    const std::size_t size = Memory::pageSize()*3;
+    char* data = static_cast<char*>(Memory::mapPages(size));
+    CORRADE_VERIFY(data);
+
+    /* Zero-initialized */
+    CORRADE_COMPARE(data[0], 0);
+    CORRADE_COMPARE(data[size - 1], 0);
+
+    /* Writable */
+    data[0] = 'a';
+    data[size - 1] = 'z';
+    CORRADE_COMPARE(data[0], 'a');
+    CORRADE_COMPARE(data[size - 1], 'z');
+
+    Memory::unmapPages(data, size);
+}
+
+void MemoryTest::mapPlacement() {
+    auto&& data = PlacementData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Should always succeed, falling back to regular pages and the default
+       placement if not supported */
+    const std::size_t size = Memory::pageSize(data.pageSize)*2;
+    char* mapped = static_cast<char*>(Memory::mapPages(size, data.pageSize, data.numaNode));
+    CORRADE_VERIFY(mapped);
+
+    /* Zero-initialized and writable */
+    CORRADE_COMPARE(mapped[0], 0);
+    CORRADE_COMPARE(mapped[size - 1], 0);
+    mapped[0] = 'a';
+    mapped[size - 1] = 'z';
+    CORRADE_COMPARE(mapped[0], 'a');
+    CORRADE_COMPARE(mapped[size - 1], 'z');
+
+    Memory::unmapPages(mapped, size);
+}
+
+void MemoryTest::mapInvalidSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Memory::mapPages(Memory::pageSize() + 1);
+    CORRADE_COMPARE(out.str(), Utility::formatString("Utility::Memory::mapPages(): size {} is not a multiple of page size {}\n", Memory::pageSize() + 1, Memory::pageSize()));
+}
+
+void MemoryTest::remapGrow() {
+    const std::size_t size = Memory::pageSize();
+    char* data = static_cast<char*>(Memory::mapPages(size));
+    CORRADE_VERIFY(data);
+    data[0] = 'a';
+    data[size - 1] = 'z';
+
+    char* grown = static_cast<char*>(Memory::remapPages(data, size, size*1024));
+    CORRADE_VERIFY(grown);
+    CORRADE_COMPARE(grown[0], 'a');
+    CORRADE_COMPARE(grown[size - 1], 'z');
+    /* New pages are zero-initialized and writable */
+    CORRADE_COMPARE(grown[size*1024 - 1], 0);
+    grown[size*1024 - 1] = 'x';
+    CORRADE_COMPARE(grown[size*1024 - 1], 'x');
+
+    Memory::unmapPages(grown, size*1024);
+}
+
+void MemoryTest::remapShrink() {
+    const std::size_t size = Memory::pageSize();
+    char* data = static_cast<char*>(Memory::mapPages(size*4));
+    CORRADE_VERIFY(data);
+    data[0] = 'a';
+    data[size - 1] = 'z';
+
+    char* shrunk = static_cast<char*>(Memory::remapPages(data, size*4, size));
+    CORRADE_VERIFY(shrunk);
+    CORRADE_COMPARE(shrunk[0], 'a');
+    CORRADE_COMPARE(shrunk[size - 1], 'z');
+
+    Memory::unmapPages(shrunk, size);
+}
+
+void MemoryTest::remapSame() {
+    const std::size_t size = Memory::pageSize();
+    void* data = Memory::mapPages(size);
+    CORRADE_VERIFY(data);
+    CORRADE_COMPARE(Memory::remapPages(data, size, size), data);
+    Memory::unmapPages(data, size);
+}
+
+void MemoryTest::remapInvalidSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const std::size_t size = Memory::pageSize();
+    void* data = Memory::mapPages(size);
+    CORRADE_VERIFY(data);
+
+    {
+        std::ostringstream out;
+        Error redirectError{&out};
+        CORRADE_VERIFY(!Memory::remapPages(data, size, size + 3));
+        CORRADE_COMPARE(out.str(), Utility::formatString("Utility::Memory::remapPages(): size {} is not a multiple of page size {}\n", size + 3, size));
+    }
+
+    Memory::unmapPages(data, size);
+}
+
+void MemoryTest::remapPlacement() {
+    auto&& data = PlacementData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const std::size_t size = Memory::pageSize(data.pageSize);
+    char* mapped = static_cast<char*>(Memory::mapPages(size, data.pageSize, data.numaNode));
+    CORRADE_VERIFY(mapped);
+    mapped[0] = 'a';
+    mapped[size - 1] = 'z';
+
+    char* grown = static_cast<char*>(Memory::remapPages(mapped, size, size*4, data.pageSize, data.numaNode));
+    CORRADE_VERIFY(grown);
+    CORRADE_COMPARE(grown[0], 'a');
+    CORRADE_COMPARE(grown[size - 1], 'z');
+    /* New pages are zero-initialized and writable */
+    CORRADE_COMPARE(grown[size*4 - 1], 0);
+    grown[size*4 - 1] = 'x';
+    CORRADE_COMPARE(grown[size*4 - 1], 'x');
+
+    char* shrunk = static_cast<char*>(Memory::remapPages(grown, size*4, size*2, data.pageSize, data.numaNode));
+    CORRADE_VERIFY(shrunk);
+    CORRADE_COMPARE(shrunk[0], 'a');
+    CORRADE_COMPARE(shrunk[size - 1], 'z');
+
+    Memory::unmapPages(shrunk, size*2);
+}
+
+void MemoryTest::debugPageSize() {
+    std::ostringstream out;
+    Debug{&out} << Memory::PageSize::TransparentHuge << Memory::PageSize(0xde);
+    CORRADE_COMPARE(out.str(), "Utility::Memory::PageSize::TransparentHuge Utility::Memory::PageSize(0xde)\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Utility::Test::MemoryTest)
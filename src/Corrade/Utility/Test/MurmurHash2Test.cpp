@@ -37,12 +37,18 @@ struct MurmurHash2Test: TestSuite::Tester {
     void test32();
     void test64();
     void constructor();
+
+    void benchmark32();
+    void benchmark64();
 };
 
 MurmurHash2Test::MurmurHash2Test() {
     addTests({&MurmurHash2Test::test32,
               &MurmurHash2Test::test64,
               &MurmurHash2Test::constructor});
+
+    addBenchmarks({&MurmurHash2Test::benchmark32,
+                   &MurmurHash2Test::benchmark64}, 10);
 }
 
 void MurmurHash2Test::test32() {
@@ -61,6 +67,34 @@ void MurmurHash2Test::constructor() {
     CORRADE_COMPARE(MurmurHash2()(std::string("hello")), MurmurHash2()("hello", 5));
 }
 
+constexpr std::size_t BenchmarkSize = 1024*1024;
+
+void MurmurHash2Test::benchmark32() {
+    std::string data(BenchmarkSize, 'a');
+    for(std::size_t i = 0; i != data.size(); ++i) data[i] = char(i*37);
+
+    setBenchmarkThroughput(BenchmarkSize, BenchmarkUnits::Bytes);
+
+    unsigned int hash = 0;
+    CORRADE_BENCHMARK(1)
+        hash ^= Implementation::MurmurHash2<4>{}(23, data.data(), data.size());
+
+    CORRADE_VERIFY(hash);
+}
+
+void MurmurHash2Test::benchmark64() {
+    std::string data(BenchmarkSize, 'a');
+    for(std::size_t i = 0; i != data.size(); ++i) data[i] = char(i*37);
+
+    setBenchmarkThroughput(BenchmarkSize, BenchmarkUnits::Bytes);
+
+    unsigned long long hash = 0;
+    CORRADE_BENCHMARK(1)
+        hash ^= Implementation::MurmurHash2<8>{}(23, data.data(), data.size());
+
+    CORRADE_VERIFY(hash);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Corrade::Utility::Test::MurmurHash2Test)
@@ -0,0 +1,604 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <string>
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Containers/StridedArrayView.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Container.h"
+#include "Corrade/Utility/DebugStl.h"
+#include "Corrade/Utility/Format.h"
+#include "Corrade/Utility/Parse.h"
+
+namespace Corrade { namespace Utility { namespace Test { namespace {
+
+struct ParseTest: TestSuite::Tester {
+    explicit ParseTest();
+
+    void integer();
+    void integerSigned();
+    void integerBase();
+    void integerLimits();
+    void integerOverflow();
+    void integerInvalid();
+    void integerInvalidBase();
+
+    void floatingPoint();
+    void floatingPointExponent();
+    void floatingPointSpecial();
+    void floatingPointInvalid();
+    void floatingPointCorrectlyRounded();
+    void floatingPointLongMantissa();
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    void floatingPointLongDouble();
+    #endif
+
+    void numbers();
+    void numbersFloatingPoint();
+    void numbersDelimiters();
+    void numbersStrided();
+    void numbersOutputTooSmall();
+    void numbersInvalid();
+    void numbersRoundTrip();
+
+    void benchmarkIntegerParse();
+    void benchmarkIntegerStrtol();
+    void benchmarkIntegerStringstream();
+    void benchmarkDoubleParse();
+    void benchmarkDoubleStrtod();
+    void benchmarkDoubleStringstream();
+};
+
+ParseTest::ParseTest() {
+    addTests({&ParseTest::integer,
+              &ParseTest::integerSigned,
+              &ParseTest::integerBase,
+              &ParseTest::integerLimits,
+              &ParseTest::integerOverflow,
+              &ParseTest::integerInvalid,
+              &ParseTest::integerInvalidBase,
+
+              &ParseTest::floatingPoint,
+              &ParseTest::floatingPointExponent,
+              &ParseTest::floatingPointSpecial,
+              &ParseTest::floatingPointInvalid,
+              &ParseTest::floatingPointCorrectlyRounded,
+              &ParseTest::floatingPointLongMantissa,
+              #ifndef CORRADE_TARGET_EMSCRIPTEN
+              &ParseTest::floatingPointLongDouble,
+              #endif
+
+              &ParseTest::numbers,
+              &ParseTest::numbersFloatingPoint,
+              &ParseTest::numbersDelimiters,
+              &ParseTest::numbersStrided,
+              &ParseTest::numbersOutputTooSmall,
+              &ParseTest::numbersInvalid,
+              &ParseTest::numbersRoundTrip});
+
+    addBenchmarks({&ParseTest::benchmarkIntegerParse,
+                   &ParseTest::benchmarkIntegerStrtol,
+                   &ParseTest::benchmarkIntegerStringstream,
+                   &ParseTest::benchmarkDoubleParse,
+                   &ParseTest::benchmarkDoubleStrtod,
+                   &ParseTest::benchmarkDoubleStringstream}, 50);
+}
+
+Containers::ArrayView<const char> view(const char* string) {
+    return {string, std::strlen(string)};
+}
+
+void ParseTest::integer() {
+    unsigned int value = 1337;
+    CORRADE_COMPARE(parseNumber(view("0"), value), 1);
+    CORRADE_COMPARE(value, 0);
+    CORRADE_COMPARE(parseNumber(view("42"), value), 2);
+    CORRADE_COMPARE(value, 42);
+
+    /* Stops at the first non-digit, the string doesn't need to be
+       null-terminated */
+    CORRADE_COMPARE(parseNumber(view("1234abc"), value), 4);
+    CORRADE_COMPARE(value, 1234);
+    CORRADE_COMPARE(parseNumber({"56789", 3}, value), 3);
+    CORRADE_COMPARE(value, 567);
+
+    /* Leading zeros are fine */
+    CORRADE_COMPARE(parseNumber(view("000017"), value), 6);
+    CORRADE_COMPARE(value, 17);
+}
+
+void ParseTest::integerSigned() {
+    int value;
+    CORRADE_COMPARE(parseNumber(view("-42 "), value), 3);
+    CORRADE_COMPARE(value, -42);
+    CORRADE_COMPARE(parseNumber(view("-0"), value), 2);
+    CORRADE_COMPARE(value, 0);
+
+    short s;
+    CORRADE_COMPARE(parseNumber(view("-1234"), s), 5);
+    CORRADE_COMPARE(s, -1234);
+    long l;
+    CORRADE_COMPARE(parseNumber(view("-123456"), l), 7);
+    CORRADE_COMPARE(l, -123456);
+    long long ll;
+    CORRADE_COMPARE(parseNumber(view("-12345678901234"), ll), 15);
+    CORRADE_COMPARE(ll, -12345678901234ll);
+}
+
+void ParseTest::integerBase() {
+    unsigned int value;
+    CORRADE_COMPARE(parseNumber(view("ff"), value, 16), 2);
+    CORRADE_COMPARE(value, 0xff);
+    CORRADE_COMPARE(parseNumber(view("DeadBeef"), value, 16), 8);
+    CORRADE_COMPARE(value, 0xdeadbeef);
+    CORRADE_COMPARE(parseNumber(view("0778"), value, 8), 3);
+    CORRADE_COMPARE(value, 077);
+    CORRADE_COMPARE(parseNumber(view("10112"), value, 2), 4);
+    CORRADE_COMPARE(value, 11);
+    CORRADE_COMPARE(parseNumber(view("zz"), value, 36), 2);
+    CORRADE_COMPARE(value, 36*36 - 1);
+
+    int signedValue;
+    CORRADE_COMPARE(parseNumber(view("-7fffffff"), signedValue, 16), 9);
+    CORRADE_COMPARE(signedValue, -0x7fffffff);
+
+    /* A 0x prefix isn't accepted, only the zero gets parsed */
+    CORRADE_COMPARE(parseNumber(view("0x1f"), value, 16), 1);
+    CORRADE_COMPARE(value, 0);
+}
+
+void ParseTest::integerLimits() {
+    int i;
+    CORRADE_COMPARE(parseNumber(view("-2147483648"), i), 11);
+    CORRADE_COMPARE(i, std::numeric_limits<int>::min());
+    CORRADE_COMPARE(parseNumber(view("2147483647"), i), 10);
+    CORRADE_COMPARE(i, std::numeric_limits<int>::max());
+
+    unsigned short us;
+    CORRADE_COMPARE(parseNumber(view("65535"), us), 5);
+    CORRADE_COMPARE(us, 65535);
+
+    long long ll;
+    CORRADE_COMPARE(parseNumber(view("-9223372036854775808"), ll), 20);
+    CORRADE_COMPARE(ll, std::numeric_limits<long long>::min());
+    CORRADE_COMPARE(parseNumber(view("9223372036854775807"), ll), 19);
+    CORRADE_COMPARE(ll, std::numeric_limits<long long>::max());
+
+    unsigned long long ull;
+    CORRADE_COMPARE(parseNumber(view("18446744073709551615"), ull), 20);
+    CORRADE_COMPARE(ull, std::numeric_limits<unsigned long long>::max());
+    CORRADE_COMPARE(parseNumber(view("ffffffffffffffff"), ull, 16), 16);
+    CORRADE_COMPARE(ull, std::numeric_limits<unsigned long long>::max());
+}
+
+void ParseTest::integerOverflow() {
+    /* The value isn't modified on failure */
+    int i = 1337;
+    CORRADE_COMPARE(parseNumber(view("2147483648"), i), 0);
+    CORRADE_COMPARE(parseNumber(view("-2147483649"), i), 0);
+    CORRADE_COMPARE(i, 1337);
+
+    unsigned short us = 1337;
+    CORRADE_COMPARE(parseNumber(view("65536"), us), 0);
+    CORRADE_COMPARE(us, 1337);
+
+    unsigned long long ull = 1337;
+    CORRADE_COMPARE(parseNumber(view("18446744073709551616"), ull), 0);
+    CORRADE_COMPARE(parseNumber(view("99999999999999999999999"), ull), 0);
+    CORRADE_COMPARE(ull, 1337);
+}
+
+void ParseTest::integerInvalid() {
+    int i = 1337;
+    unsigned int u = 1337;
+    CORRADE_COMPARE(parseNumber(view(""), i), 0);
+    CORRADE_COMPARE(parseNumber(view("-"), i), 0);
+    CORRADE_COMPARE(parseNumber(view("+1"), i), 0);
+    CORRADE_COMPARE(parseNumber(view(" 1"), i), 0);
+    CORRADE_COMPARE(parseNumber(view("a"), i), 0);
+    CORRADE_COMPARE(parseNumber(view("8"), i, 8), 0);
+    /* No sign for unsigned types */
+    CORRADE_COMPARE(parseNumber(view("-1"), u), 0);
+    CORRADE_COMPARE(i, 1337);
+    CORRADE_COMPARE(u, 1337);
+}
+
+void ParseTest::integerInvalidBase() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    int i;
+    unsigned int u;
+    parseNumber(view("1"), i, 1);
+    parseNumber(view("1"), u, 37);
+    CORRADE_COMPARE(out.str(),
+        "Utility::parseNumber(): base 1 out of range\n"
+        "Utility::parseNumber(): base 37 out of range\n");
+}
+
+void ParseTest::floatingPoint() {
+    double d = 1337.0;
+    CORRADE_COMPARE(parseNumber(view("0"), d), 1);
+    CORRADE_COMPARE(d, 0.0);
+    CORRADE_COMPARE(parseNumber(view("35.5"), d), 4);
+    CORRADE_COMPARE(d, 35.5);
+    CORRADE_COMPARE(parseNumber(view("-0.125"), d), 6);
+    CORRADE_COMPARE(d, -0.125);
+    CORRADE_COMPARE(parseNumber(view(".5"), d), 2);
+    CORRADE_COMPARE(d, 0.5);
+    CORRADE_COMPARE(parseNumber(view("3."), d), 2);
+    CORRADE_COMPARE(d, 3.0);
+
+    /* Stops at the first character that isn't a part of the number */
+    CORRADE_COMPARE(parseNumber(view("1.25f"), d), 4);
+    CORRADE_COMPARE(d, 1.25);
+    CORRADE_COMPARE(parseNumber(view("1.5.6"), d), 3);
+    CORRADE_COMPARE(d, 1.5);
+    CORRADE_COMPARE(parseNumber({"2.71828", 4}, d), 4);
+    CORRADE_COMPARE(d, 2.71);
+
+    /* Negative zero keeps the sign */
+    CORRADE_COMPARE(parseNumber(view("-0.0"), d), 4);
+    CORRADE_VERIFY(std::signbit(d));
+
+    float f;
+    CORRADE_COMPARE(parseNumber(view("-12.75"), f), 6);
+    CORRADE_COMPARE(f, -12.75f);
+    CORRADE_COMPARE(parseNumber(view("0.1"), f), 3);
+    CORRADE_COMPARE(f, 0.1f);
+}
+
+void ParseTest::floatingPointExponent() {
+    double d;
+    CORRADE_COMPARE(parseNumber(view("2.1e7"), d), 5);
+    CORRADE_COMPARE(d, 2.1e7);
+    CORRADE_COMPARE(parseNumber(view("-2.1E+07"), d), 8);
+    CORRADE_COMPARE(d, -2.1e7);
+    CORRADE_COMPARE(parseNumber(view("15e-3"), d), 5);
+    CORRADE_COMPARE(d, 0.015);
+    CORRADE_COMPARE(parseNumber(view("1e308"), d), 5);
+    CORRADE_COMPARE(d, 1.0e308);
+
+    /* An exponent without digits isn't consumed */
+    CORRADE_COMPARE(parseNumber(view("3e"), d), 1);
+    CORRADE_COMPARE(d, 3.0);
+    CORRADE_COMPARE(parseNumber(view("4e+x"), d), 1);
+    CORRADE_COMPARE(d, 4.0);
+
+    /* Out of range values become an infinity or zero */
+    CORRADE_COMPARE(parseNumber(view("1e400"), d), 5);
+    CORRADE_COMPARE(d, std::numeric_limits<double>::infinity());
+    CORRADE_COMPARE(parseNumber(view("-1e99999999999"), d), 14);
+    CORRADE_COMPARE(d, -std::numeric_limits<double>::infinity());
+    CORRADE_COMPARE(parseNumber(view("1e-400"), d), 6);
+    CORRADE_COMPARE(d, 0.0);
+
+    float f;
+    CORRADE_COMPARE(parseNumber(view("3.0e38"), f), 6);
+    CORRADE_COMPARE(f, 3.0e38f);
+    CORRADE_COMPARE(parseNumber(view("1e39"), f), 4);
+    CORRADE_COMPARE(f, std::numeric_limits<float>::infinity());
+}
+
+void ParseTest::floatingPointSpecial() {
+    double d;
+    CORRADE_COMPARE(parseNumber(view("inf"), d), 3);
+    CORRADE_COMPARE(d, std::numeric_limits<double>::infinity());
+    CORRADE_COMPARE(parseNumber(view("-Infinity"), d), 9);
+    CORRADE_COMPARE(d, -std::numeric_limits<double>::infinity());
+    CORRADE_COMPARE(parseNumber(view("INFINITE"), d), 3);
+    CORRADE_COMPARE(d, std::numeric_limits<double>::infinity());
+    CORRADE_COMPARE(parseNumber(view("NaN"), d), 3);
+    CORRADE_VERIFY(std::isnan(d));
+
+    float f;
+    CORRADE_COMPARE(parseNumber(view("-inf"), f), 4);
+    CORRADE_COMPARE(f, -std::numeric_limits<float>::infinity());
+}
+
+void ParseTest::floatingPointInvalid() {
+    double d = 1337.0;
+    CORRADE_COMPARE(parseNumber(view(""), d), 0);
+    CORRADE_COMPARE(parseNumber(view("."), d), 0);
+    CORRADE_COMPARE(parseNumber(view("-"), d), 0);
+    CORRADE_COMPARE(parseNumber(view("-."), d), 0);
+    CORRADE_COMPARE(parseNumber(view("+1.0"), d), 0);
+    CORRADE_COMPARE(parseNumber(view(" 1.0"), d), 0);
+    CORRADE_COMPARE(parseNumber(view("e5"), d), 0);
+    CORRADE_COMPARE(parseNumber(view("in"), d), 0);
+    CORRADE_COMPARE(d, 1337.0);
+}
+
+void ParseTest::floatingPointCorrectlyRounded() {
+    /* Compare against strtod() / strtof() for pseudo-random values printed
+       with varying precision, covering both the fast path and the fallback */
+    std::uint64_t seed = 0x9e3779b97f4a7c15ull;
+    for(int i = 0; i != 20000; ++i) {
+        seed = seed*6364136223846793005ull + 1442695040888963407ull;
+        double value;
+        std::memcpy(&value, &seed, sizeof(double));
+        if(!std::isfinite(value)) continue;
+        /* Some with smaller exponents and short mantissas, hitting the fast
+           path */
+        if(i % 2) value = double(seed >> 40)*std::pow(10.0, int(seed % 40) - 20);
+
+        char string[64];
+        std::snprintf(string, sizeof(string), "%.*g", int(seed % 19) + 1, value);
+
+        double d;
+        CORRADE_COMPARE(parseNumber(view(string), d), std::strlen(string));
+        CORRADE_COMPARE(d, std::strtod(string, nullptr));
+        float f;
+        CORRADE_COMPARE(parseNumber(view(string), f), std::strlen(string));
+        CORRADE_COMPARE(f, std::strtof(string, nullptr));
+    }
+
+    /* Halfway cases that need all digits to be rounded correctly */
+    double d;
+    CORRADE_COMPARE(parseNumber(view("9007199254740993"), d), 16);
+    CORRADE_COMPARE(d, 9007199254740992.0);
+    CORRADE_COMPARE(parseNumber(view("9007199254740993.0000000000000000001"), d), 36);
+    CORRADE_COMPARE(d, 9007199254740994.0);
+    CORRADE_COMPARE(parseNumber(view("2.2250738585072011e-308"), d), 23);
+    CORRADE_COMPARE(d, 2.2250738585072011e-308);
+    float f;
+    CORRADE_COMPARE(parseNumber(view("16777217"), f), 8);
+    CORRADE_COMPARE(f, 16777216.0f);
+    CORRADE_COMPARE(parseNumber(view("1.00000005960464477539062501"), f), 28);
+    CORRADE_COMPARE(f, 1.00000011920928955078125f);
+}
+
+void ParseTest::floatingPointLongMantissa() {
+    /* More digits than fit into the stack buffer used by the fallback */
+    std::string string = "0." + std::string(300, '0') + "1" + std::string(300, '2') + "e300";
+    double d;
+    CORRADE_COMPARE(parseNumber({string.data(), string.size()}, d), string.size());
+    CORRADE_COMPARE(d, 0.1222222222222222);
+
+    std::string integer = std::string(400, '9');
+    CORRADE_COMPARE(parseNumber({integer.data(), integer.size()}, d), 400);
+    CORRADE_COMPARE(d, std::numeric_limits<double>::infinity());
+}
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+void ParseTest::floatingPointLongDouble() {
+    long double ld;
+    CORRADE_COMPARE(parseNumber(view("-3.14159265358979323846l"), ld), 23);
+    CORRADE_COMPARE(ld, -3.14159265358979323846l);
+    CORRADE_COMPARE(parseNumber(view("inf"), ld), 3);
+    CORRADE_COMPARE(ld, std::numeric_limits<long double>::infinity());
+}
+#endif
+
+constexpr const char* IntegerData[]{
+    "0", "42", "-1337", "65535", "100000", "-65536", "778", "12345"
+};
+
+constexpr const char* DoubleData[]{
+    "0.5", "35.125", "-1337.0", "1.0e-5", "3.14159265358979", "2.1e7", "100",
+    "-0.001"
+};
+
+void ParseTest::numbers() {
+    int out[4]{};
+    CORRADE_COMPARE(parseNumbersInto(view("-15,0,42,2147483647"), out, ","), 4);
+    CORRADE_COMPARE(out[0], -15);
+    CORRADE_COMPARE(out[1], 0);
+    CORRADE_COMPARE(out[2], 42);
+    CORRADE_COMPARE(out[3], 2147483647);
+
+    unsigned long long outUnsigned[2]{};
+    CORRADE_COMPARE(parseNumbersInto(view("18446744073709551615 7"), outUnsigned, " "), 2);
+    CORRADE_COMPARE(outUnsigned[0], 18446744073709551615ull);
+    CORRADE_COMPARE(outUnsigned[1], 7);
+}
+
+void ParseTest::numbersFloatingPoint() {
+    float out[3]{};
+    CORRADE_COMPARE(parseNumbersInto(view("0.5;-1e-3;inf"), out, ";"), 3);
+    CORRADE_COMPARE(out[0], 0.5f);
+    CORRADE_COMPARE(out[1], -0.001f);
+    CORRADE_COMPARE(out[2], std::numeric_limits<float>::infinity());
+
+    double outDouble[2]{};
+    CORRADE_COMPARE(parseNumbersInto(view("3.14159265358979 1e100"), outDouble, " "), 2);
+    CORRADE_COMPARE(outDouble[0], 3.14159265358979);
+    CORRADE_COMPARE(outDouble[1], 1.0e100);
+}
+
+void ParseTest::numbersDelimiters() {
+    /* Runs of delimiters are treated as one, leading and trailing are
+       ignored */
+    long out[5]{};
+    CORRADE_COMPARE(parseNumbersInto(view(" \n1, 2,3\n\n4 ,5\n"), out, ", \n"), 5);
+    CORRADE_COMPARE(out[0], 1);
+    CORRADE_COMPARE(out[1], 2);
+    CORRADE_COMPARE(out[2], 3);
+    CORRADE_COMPARE(out[3], 4);
+    CORRADE_COMPARE(out[4], 5);
+
+    /* No delimiters, only a single value can be parsed */
+    CORRADE_COMPARE(parseNumbersInto(view("17"), out, ""), 1);
+    CORRADE_COMPARE(out[0], 17);
+
+    /* Empty input */
+    CORRADE_COMPARE(parseNumbersInto(view(""), out, ","), 0);
+    CORRADE_COMPARE(parseNumbersInto(view(",,,"), out, ","), 0);
+}
+
+void ParseTest::numbersStrided() {
+    struct Vertex {
+        float position;
+        unsigned int id;
+    } vertices[3]{};
+    Containers::StridedArrayView1D<float> positions{vertices, &vertices[0].position, 3, sizeof(Vertex)};
+    Containers::StridedArrayView1D<unsigned int> ids{vertices, &vertices[0].id, 3, sizeof(Vertex)};
+
+    CORRADE_COMPARE(parseNumbersInto(view("0.5 1.5 2.5"), positions, " "), 3);
+    CORRADE_COMPARE(parseNumbersInto(view("7 8 9"), ids.flipped<0>(), " "), 3);
+    CORRADE_COMPARE(vertices[0].position, 0.5f);
+    CORRADE_COMPARE(vertices[1].position, 1.5f);
+    CORRADE_COMPARE(vertices[2].position, 2.5f);
+    CORRADE_COMPARE(vertices[0].id, 9);
+    CORRADE_COMPARE(vertices[1].id, 8);
+    CORRADE_COMPARE(vertices[2].id, 7);
+}
+
+void ParseTest::numbersOutputTooSmall() {
+    /* Stops once the output is filled */
+    int out[2]{};
+    CORRADE_COMPARE(parseNumbersInto(view("1 2 3 4"), out, " "), 2);
+    CORRADE_COMPARE(out[0], 1);
+    CORRADE_COMPARE(out[1], 2);
+}
+
+void ParseTest::numbersInvalid() {
+    /* Stops at the first invalid value, the rest is left untouched */
+    int out[4]{-1, -1, -1, -1};
+    CORRADE_COMPARE(parseNumbersInto(view("1,2,x,4"), out, ","), 2);
+    CORRADE_COMPARE(out[0], 1);
+    CORRADE_COMPARE(out[1], 2);
+    CORRADE_COMPARE(out[2], -1);
+
+    /* A value directly followed by something else than a delimiter is
+       invalid as well */
+    CORRADE_COMPARE(parseNumbersInto(view("5,6.5,7"), out, ","), 1);
+    CORRADE_COMPARE(out[0], 5);
+    CORRADE_COMPARE(out[1], 2);
+    CORRADE_COMPARE(parseNumbersInto(view("8,9-10"), out, ","), 1);
+    CORRADE_COMPARE(out[0], 8);
+    CORRADE_COMPARE(out[1], 2);
+
+    /* Value out of range or a negative value for an unsigned type */
+    unsigned int outUnsigned[2]{};
+    CORRADE_COMPARE(parseNumbersInto(view("4294967296 1"), outUnsigned, " "), 0);
+    CORRADE_COMPARE(parseNumbersInto(view("-1 1"), outUnsigned, " "), 0);
+}
+
+void ParseTest::numbersRoundTrip() {
+    const float values[]{
+        1.0f, 2.5f, -3.0f,
+        4.0f, 0.125f, 1.0e-5f
+    };
+
+    Containers::Array<char> csv;
+    formatNumbersInto(csv, Containers::StridedArrayView2D<const float>{values, {2, 3}}, ",", "\n");
+    CORRADE_COMPARE(std::string(csv.data(), csv.size()),
+        "1,2.5,-3\n4,0.125,1e-05\n");
+
+    float out[6]{};
+    CORRADE_COMPARE(parseNumbersInto(csv, out, ",\n"), 6);
+    CORRADE_COMPARE_AS(Containers::arrayView(out),
+        Containers::arrayView(values),
+        TestSuite::Compare::Container);
+}
+
+void ParseTest::benchmarkIntegerParse() {
+    int sum = 0;
+    CORRADE_BENCHMARK(100) {
+        for(const char* string: IntegerData) {
+            int value{};
+            parseNumber(view(string), value);
+            sum += value;
+        }
+    }
+
+    CORRADE_COMPARE(sum, 100*(65535 - 1337 + 42 + 100000 - 65536 + 778 + 12345));
+}
+
+void ParseTest::benchmarkIntegerStrtol() {
+    int sum = 0;
+    CORRADE_BENCHMARK(100) {
+        for(const char* string: IntegerData)
+            sum += int(std::strtol(string, nullptr, 10));
+    }
+
+    CORRADE_COMPARE(sum, 100*(65535 - 1337 + 42 + 100000 - 65536 + 778 + 12345));
+}
+
+void ParseTest::benchmarkIntegerStringstream() {
+    int sum = 0;
+    CORRADE_BENCHMARK(100) {
+        for(const char* string: IntegerData) {
+            std::istringstream in{string};
+            int value{};
+            in >> value;
+            sum += value;
+        }
+    }
+
+    CORRADE_COMPARE(sum, 100*(65535 - 1337 + 42 + 100000 - 65536 + 778 + 12345));
+}
+
+void ParseTest::benchmarkDoubleParse() {
+    double sum = 0.0;
+    CORRADE_BENCHMARK(100) {
+        for(const char* string: DoubleData) {
+            double value{};
+            parseNumber(view(string), value);
+            sum += value;
+        }
+    }
+
+    CORRADE_COMPARE(sum, 100*(0.5 + 35.125 - 1337.0 + 1.0e-5 + 3.14159265358979 + 2.1e7 + 100 - 0.001));
+}
+
+void ParseTest::benchmarkDoubleStrtod() {
+    double sum = 0.0;
+    CORRADE_BENCHMARK(100) {
+        for(const char* string: DoubleData)
+            sum += std::strtod(string, nullptr);
+    }
+
+    CORRADE_COMPARE(sum, 100*(0.5 + 35.125 - 1337.0 + 1.0e-5 + 3.14159265358979 + 2.1e7 + 100 - 0.001));
+}
+
+void ParseTest::benchmarkDoubleStringstream() {
+    double sum = 0.0;
+    CORRADE_BENCHMARK(100) {
+        for(const char* string: DoubleData) {
+            std::istringstream in{string};
+            double value{};
+            in >> value;
+            sum += value;
+        }
+    }
+
+    CORRADE_COMPARE(sum, 100*(0.5 + 35.125 - 1337.0 + 1.0e-5 + 3.14159265358979 + 2.1e7 + 100 - 0.001));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Utility::Test::ParseTest)
@@ -0,0 +1,295 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string>
+#include <vector>
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Numeric.h"
+#include "Corrade/Utility/DebugStl.h"
+#include "Corrade/Utility/Profiler.h"
+#include "Corrade/Utility/String.h"
+
+#if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+#include <thread>
+#endif
+
+namespace Corrade { namespace Utility { namespace Test { namespace {
+
+struct ProfilerTest: TestSuite::Tester {
+    explicit ProfilerTest();
+
+    void reset();
+
+    void disabled();
+    void record();
+    void enabledInsideScope();
+    void manyZones();
+    void clear();
+    void callbacks();
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    void multithreaded();
+    #endif
+
+    void chromeTrace();
+    void chromeTraceEmpty();
+
+    void benchmarkDisabled();
+    void benchmarkEnabled();
+};
+
+ProfilerTest::ProfilerTest() {
+    addTests({&ProfilerTest::disabled,
+              &ProfilerTest::record,
+              &ProfilerTest::enabledInsideScope,
+              &ProfilerTest::manyZones,
+              &ProfilerTest::clear,
+              &ProfilerTest::callbacks,
+              #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+              &ProfilerTest::multithreaded,
+              #endif
+
+              &ProfilerTest::chromeTrace,
+              &ProfilerTest::chromeTraceEmpty},
+        &ProfilerTest::reset,
+        &ProfilerTest::reset);
+
+    addBenchmarks({&ProfilerTest::benchmarkDisabled,
+                   &ProfilerTest::benchmarkEnabled}, 10,
+        &ProfilerTest::reset,
+        &ProfilerTest::reset);
+}
+
+void ProfilerTest::reset() {
+    Profiler::setEnabled(false);
+    Profiler::setCallbacks(nullptr, nullptr);
+    Profiler::clear();
+}
+
+void ProfilerTest::disabled() {
+    CORRADE_VERIFY(!Profiler::isEnabled());
+
+    {
+        CORRADE_PROFILE_SCOPE("disabled");
+    }
+
+    CORRADE_COMPARE(Profiler::zones().size(), 0);
+}
+
+void ProfilerTest::record() {
+    Profiler::setEnabled(true);
+    CORRADE_VERIFY(Profiler::isEnabled());
+
+    {
+        CORRADE_PROFILE_SCOPE("outer");
+        {
+            CORRADE_PROFILE_SCOPE("inner");
+        }
+        CORRADE_PROFILE_SCOPE("second inner");
+    }
+
+    /* Zones are recorded in the order the scopes are exited */
+    Containers::Array<Profiler::Zone> zones = Profiler::zones();
+    CORRADE_COMPARE(zones.size(), 3);
+    CORRADE_COMPARE(zones[0].name, std::string{"inner"});
+    CORRADE_COMPARE(zones[1].name, std::string{"second inner"});
+    CORRADE_COMPARE(zones[2].name, std::string{"outer"});
+
+    /* The inner zones are contained in the outer one */
+    CORRADE_COMPARE_AS(zones[0].begin, zones[2].begin,
+        TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(zones[0].end, zones[0].begin,
+        TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(zones[1].begin, zones[0].end,
+        TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(zones[2].end, zones[1].end,
+        TestSuite::Compare::GreaterOrEqual);
+
+    /* All on the same thread */
+    CORRADE_VERIFY(zones[0].thread);
+    CORRADE_COMPARE(zones[1].thread, zones[0].thread);
+    CORRADE_COMPARE(zones[2].thread, zones[0].thread);
+}
+
+void ProfilerTest::enabledInsideScope() {
+    {
+        CORRADE_PROFILE_SCOPE("entered while disabled");
+        Profiler::setEnabled(true);
+        CORRADE_PROFILE_SCOPE("entered while enabled");
+    }
+
+    Containers::Array<Profiler::Zone> zones = Profiler::zones();
+    CORRADE_COMPARE(zones.size(), 1);
+    CORRADE_COMPARE(zones[0].name, std::string{"entered while enabled"});
+}
+
+void ProfilerTest::manyZones() {
+    Profiler::setEnabled(true);
+
+    /* More than fits into a single chunk */
+    for(std::size_t i = 0; i != 2500; ++i) {
+        CORRADE_PROFILE_SCOPE("zone");
+    }
+
+    Containers::Array<Profiler::Zone> zones = Profiler::zones();
+    CORRADE_COMPARE(zones.size(), 2500);
+    for(std::size_t i = 1; i != zones.size(); ++i) {
+        CORRADE_COMPARE_AS(zones[i].begin, zones[i - 1].end,
+            TestSuite::Compare::GreaterOrEqual);
+    }
+}
+
+void ProfilerTest::clear() {
+    Profiler::setEnabled(true);
+
+    for(std::size_t i = 0; i != 1500; ++i) {
+        CORRADE_PROFILE_SCOPE("before");
+    }
+    CORRADE_COMPARE(Profiler::zones().size(), 1500);
+
+    Profiler::clear();
+    CORRADE_COMPARE(Profiler::zones().size(), 0);
+
+    /* Recording works again after */
+    {
+        CORRADE_PROFILE_SCOPE("after");
+    }
+    Containers::Array<Profiler::Zone> zones = Profiler::zones();
+    CORRADE_COMPARE(zones.size(), 1);
+    CORRADE_COMPARE(zones[0].name, std::string{"after"});
+}
+
+void ProfilerTest::callbacks() {
+    std::vector<std::string> events;
+    Profiler::setCallbacks(
+        [](void* state, const char* name) {
+            static_cast<std::vector<std::string>*>(state)->push_back(std::string{"begin "} + name);
+        },
+        [](void* state) {
+            static_cast<std::vector<std::string>*>(state)->push_back("end");
+        }, &events);
+
+    /* Not called when disabled */
+    {
+        CORRADE_PROFILE_SCOPE("disabled");
+    }
+    CORRADE_COMPARE(events, std::vector<std::string>{});
+
+    Profiler::setEnabled(true);
+    {
+        CORRADE_PROFILE_SCOPE("outer");
+        CORRADE_PROFILE_SCOPE("inner");
+    }
+    CORRADE_COMPARE(events, (std::vector<std::string>{
+        "begin outer",
+        "begin inner",
+        "end",
+        "end"
+    }));
+
+    /* The zones are recorded as well */
+    CORRADE_COMPARE(Profiler::zones().size(), 2);
+}
+
+#if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+void ProfilerTest::multithreaded() {
+    Profiler::setEnabled(true);
+
+    /* More than fits into a single chunk on each thread */
+    std::vector<std::thread> threads;
+    for(std::size_t i = 0; i != 4; ++i) threads.emplace_back([]() {
+        for(std::size_t j = 0; j != 1500; ++j) {
+            CORRADE_PROFILE_SCOPE("thread");
+        }
+    });
+
+    /* Reading while the threads are recording is allowed */
+    const std::size_t count = Profiler::zones().size();
+    CORRADE_COMPARE_AS(count, 6000,
+        TestSuite::Compare::LessOrEqual);
+
+    for(std::thread& thread: threads) thread.join();
+
+    /* Zones from each thread are together and each thread has a different
+       ID */
+    Containers::Array<Profiler::Zone> zones = Profiler::zones();
+    CORRADE_COMPARE(zones.size(), 6000);
+    std::vector<std::uint32_t> ids;
+    for(std::size_t i = 0; i != zones.size(); ++i) {
+        if(i % 1500 == 0) {
+            ids.push_back(zones[i].thread);
+            continue;
+        }
+        CORRADE_COMPARE(zones[i].thread, ids.back());
+    }
+    CORRADE_COMPARE(ids.size(), 4);
+    for(std::size_t i = 0; i != ids.size(); ++i)
+        for(std::size_t j = i + 1; j != ids.size(); ++j)
+            CORRADE_VERIFY(ids[i] != ids[j]);
+}
+#endif
+
+void ProfilerTest::chromeTrace() {
+    Profiler::setEnabled(true);
+
+    {
+        CORRADE_PROFILE_SCOPE("a \"quoted\" \\ name");
+    }
+
+    const std::string out = Profiler::chromeTrace();
+    CORRADE_VERIFY(String::beginsWith(out,
+        "{\"traceEvents\":[\n"
+        "{\"name\":\"a \\\"quoted\\\" \\\\ name\",\"ph\":\"X\",\"ts\":0.000,\"dur\":"));
+    CORRADE_VERIFY(String::endsWith(out, ",\"pid\":0,\"tid\":" + std::to_string(Profiler::zones()[0].thread) + "}\n]}\n"));
+}
+
+void ProfilerTest::chromeTraceEmpty() {
+    CORRADE_COMPARE(Profiler::chromeTrace(),
+        "{\"traceEvents\":[\n"
+        "]}\n");
+}
+
+void ProfilerTest::benchmarkDisabled() {
+    CORRADE_BENCHMARK(1000) {
+        CORRADE_PROFILE_SCOPE("disabled");
+    }
+
+    CORRADE_COMPARE(Profiler::zones().size(), 0);
+}
+
+void ProfilerTest::benchmarkEnabled() {
+    Profiler::setEnabled(true);
+
+    CORRADE_BENCHMARK(1000) {
+        CORRADE_PROFILE_SCOPE("enabled");
+    }
+
+    CORRADE_COMPARE(Profiler::zones().size(), 1000);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Utility::Test::ProfilerTest)
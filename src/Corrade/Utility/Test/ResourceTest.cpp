@@ -23,6 +23,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <algorithm>
 #include <map>
 #include <sstream>
 #include <vector>
@@ -30,9 +31,11 @@
 #include "Corrade/Containers/ArrayView.h"
 #include "Corrade/TestSuite/Tester.h"
 #include "Corrade/TestSuite/Compare/Container.h"
+#include "Corrade/TestSuite/Compare/Numeric.h"
 #include "Corrade/TestSuite/Compare/StringToFile.h"
 #include "Corrade/Utility/DebugStl.h" /** @todo remove when <sstream> is gone */
 #include "Corrade/Utility/Directory.h"
+#include "Corrade/Utility/FormatStl.h"
 #include "Corrade/Utility/Resource.h"
 #include "Corrade/Utility/Implementation/Resource.h"
 
@@ -45,9 +48,20 @@ struct ResourceTest: TestSuite::Tester {
 
     void resourceFilenameAt();
     void resourceDataAt();
+    void resourceDataAtAligned();
     void resourceLookup();
+    void resourceHash();
+    void resourceHashLookup();
+    void resourceHashLookupMany();
+    void resourceHashTableDuplicate();
+    void resourceLz4();
+    void resourceLz4Incompressible();
+    void resourceLz4Empty();
+    void resourceLz4Invalid();
 
     void benchmarkLookupInPlace();
+    void benchmarkLookupHashed();
+    void benchmarkLookupHashedKey();
     void benchmarkLookupStdMap();
 
     void compile();
@@ -62,27 +76,59 @@ struct ResourceTest: TestSuite::Tester {
     void compileFromEmptyGroup();
     void compileFromEmptyFilename();
     void compileFromEmptyAlias();
+    void compileFromCompressed();
+    void compileFromCompressedInvalid();
+    void compileFromAligned();
+    void compileFromAlignedInvalid();
+    void compileFromDuplicates();
+    void compileFromIncbin();
 
     void hasGroup();
     void list();
     void get();
+    void getKey();
     void getEmptyFile();
     void getNonexistent();
     void getNothing();
+    void getCompressed();
+    void getAligned();
+    void getDuplicates();
+    void getIncbin();
 
     void overrideGroup();
     void overrideGroupFallback();
+    void overrideGroupChanged();
     void overrideNonexistentFile();
     void overrideNonexistentGroup();
     void overrideDifferentGroup();
+
+    void pack();
+    void packNothing();
+    void loadPackNonexistent();
+    void loadPackInvalid();
+    void loadPackTruncated();
+    void loadPackCorrupted();
+    void loadPackGroupExists();
+    void unloadPackNotLoaded();
 };
 
 ResourceTest::ResourceTest() {
     addTests({&ResourceTest::resourceFilenameAt,
               &ResourceTest::resourceDataAt,
-              &ResourceTest::resourceLookup});
+              &ResourceTest::resourceDataAtAligned,
+              &ResourceTest::resourceLookup,
+              &ResourceTest::resourceHash,
+              &ResourceTest::resourceHashLookup,
+              &ResourceTest::resourceHashLookupMany,
+              &ResourceTest::resourceHashTableDuplicate,
+              &ResourceTest::resourceLz4,
+              &ResourceTest::resourceLz4Incompressible,
+              &ResourceTest::resourceLz4Empty,
+              &ResourceTest::resourceLz4Invalid});
 
     addBenchmarks({&ResourceTest::benchmarkLookupInPlace,
+                   &ResourceTest::benchmarkLookupHashed,
+                   &ResourceTest::benchmarkLookupHashedKey,
                    &ResourceTest::benchmarkLookupStdMap}, 100);
 
     addTests({&ResourceTest::compile,
@@ -97,19 +143,40 @@ ResourceTest::ResourceTest() {
               &ResourceTest::compileFromEmptyGroup,
               &ResourceTest::compileFromEmptyFilename,
               &ResourceTest::compileFromEmptyAlias,
+              &ResourceTest::compileFromCompressed,
+              &ResourceTest::compileFromCompressedInvalid,
+              &ResourceTest::compileFromAligned,
+              &ResourceTest::compileFromAlignedInvalid,
+              &ResourceTest::compileFromDuplicates,
+              &ResourceTest::compileFromIncbin,
 
               &ResourceTest::hasGroup,
               &ResourceTest::list,
               &ResourceTest::get,
+              &ResourceTest::getKey,
               &ResourceTest::getEmptyFile,
               &ResourceTest::getNonexistent,
               &ResourceTest::getNothing,
+              &ResourceTest::getCompressed,
+              &ResourceTest::getAligned,
+              &ResourceTest::getDuplicates,
+              &ResourceTest::getIncbin,
 
               &ResourceTest::overrideGroup,
               &ResourceTest::overrideGroupFallback,
+              &ResourceTest::overrideGroupChanged,
               &ResourceTest::overrideNonexistentFile,
               &ResourceTest::overrideNonexistentGroup,
-              &ResourceTest::overrideDifferentGroup});
+              &ResourceTest::overrideDifferentGroup,
+
+              &ResourceTest::pack,
+              &ResourceTest::packNothing,
+              &ResourceTest::loadPackNonexistent,
+              &ResourceTest::loadPackInvalid,
+              &ResourceTest::loadPackTruncated,
+              &ResourceTest::loadPackCorrupted,
+              &ResourceTest::loadPackGroupExists,
+              &ResourceTest::unloadPackNotLoaded});
 }
 
 constexpr unsigned int Positions[] {
@@ -136,10 +203,38 @@ constexpr unsigned char Data[] =
     "GPL?!\n#####\n\nDon't."    // 19   44
     ;
 
+constexpr unsigned int AlignedPositions[] {
+    0, 3,
+    0, 12,
+    0, 18
+};
+
+constexpr unsigned int Alignment[] {
+    1,
+    4,
+    8
+};
+
+constexpr unsigned char AlignedData[] =
+    "abc"                       // 3    3
+    "_"                         // 1    4
+    "datadata"                  // 8    12
+    "____"                      // 4    16
+    "x!"                        // 2    18
+    ;
+
 inline std::string asString(Containers::ArrayView<const char> view) {
     return {view.data(), view.size()};
 }
 
+inline Containers::ArrayView<const char> view(const std::string& string) {
+    return {string.data(), string.size()};
+}
+
+inline Containers::ArrayView<char> view(std::string& string) {
+    return {&string[0], string.size()};
+}
+
 void ResourceTest::resourceFilenameAt() {
     /* Last position says how large the filenames are */
     CORRADE_COMPARE(sizeof(Filenames) - 1, Positions[4*2]);
@@ -154,8 +249,18 @@ void ResourceTest::resourceDataAt() {
     CORRADE_COMPARE(sizeof(Data) - 1, Positions[4*2 + 1]);
 
     /* First is a special case */
-    CORRADE_COMPARE(asString(Implementation::resourceDataAt(Positions, Data, 0)), "Don't.");
-    CORRADE_COMPARE(asString(Implementation::resourceDataAt(Positions, Data, 4)), "GPL?!\n#####\n\nDon't.");
+    CORRADE_COMPARE(asString(Implementation::resourceDataAt(Positions, nullptr, Data, 0)), "Don't.");
+    CORRADE_COMPARE(asString(Implementation::resourceDataAt(Positions, nullptr, Data, 4)), "GPL?!\n#####\n\nDon't.");
+}
+
+void ResourceTest::resourceDataAtAligned() {
+    /* Last position says how large the data are */
+    CORRADE_COMPARE(sizeof(AlignedData) - 1, AlignedPositions[2*2 + 1]);
+
+    /* The padding before each file is skipped */
+    CORRADE_COMPARE(asString(Implementation::resourceDataAt(AlignedPositions, Alignment, AlignedData, 0)), "abc");
+    CORRADE_COMPARE(asString(Implementation::resourceDataAt(AlignedPositions, Alignment, AlignedData, 1)), "datadata");
+    CORRADE_COMPARE(asString(Implementation::resourceDataAt(AlignedPositions, Alignment, AlignedData, 2)), "x!");
 }
 
 void ResourceTest::resourceLookup() {
@@ -195,6 +300,91 @@ void ResourceTest::resourceLookup() {
     CORRADE_COMPARE(Implementation::resourceLookup(5, Positions, Filenames, "termcap.info"), 5);
 }
 
+void ResourceTest::resourceHash() {
+    /* The compile-time variant has to give the same result as the runtime
+       one, otherwise lookups with ResourceKey would fail */
+    constexpr ResourceKey empty{""};
+    constexpr ResourceKey license{"license.md"};
+    constexpr ResourceKey utf8{"hýždě/šňůra.txt"};
+    constexpr std::uint32_t licenseHash = license.hash();
+    CORRADE_COMPARE(empty.size(), 0);
+    CORRADE_COMPARE(license.size(), 10);
+    CORRADE_COMPARE(empty.hash(), Implementation::resourceHash(nullptr));
+    CORRADE_COMPARE(licenseHash, Implementation::resourceHash(Containers::arrayView("license.md").except(1)));
+    CORRADE_COMPARE(utf8.hash(), Implementation::resourceHash(Containers::arrayView("hýždě/šňůra.txt").except(1)));
+    CORRADE_VERIFY(license.hash() != utf8.hash());
+}
+
+void ResourceTest::resourceHashLookup() {
+    unsigned int hashTable[5*2];
+    CORRADE_VERIFY(Implementation::resourceHashTable(5, Positions, Filenames, hashTable));
+
+    /* Each file is in exactly one slot */
+    std::vector<unsigned int> indices;
+    for(std::size_t i = 0; i != 5; ++i) indices.push_back(hashTable[2*i + 1]);
+    std::sort(indices.begin(), indices.end());
+    CORRADE_COMPARE_AS(indices, (std::vector<unsigned int>{0, 1, 2, 3, 4}),
+        TestSuite::Compare::Container);
+
+    /* Those exist. Cutting off the null terminator of the filename. */
+    CORRADE_COMPARE(Implementation::resourceHashLookup(5, hashTable, Positions, Filenames,
+        Containers::arrayView("TOC").except(1)), 0);
+    CORRADE_COMPARE(Implementation::resourceHashLookup(5, hashTable, Positions, Filenames,
+        Containers::arrayView("data.txt").except(1)), 1);
+    CORRADE_COMPARE(Implementation::resourceHashLookup(5, hashTable, Positions, Filenames,
+        Containers::arrayView("image.png").except(1)), 2);
+    CORRADE_COMPARE(Implementation::resourceHashLookup(5, hashTable, Positions, Filenames,
+        Containers::arrayView("image2.png").except(1)), 3);
+    CORRADE_COMPARE(Implementation::resourceHashLookup(5, hashTable, Positions, Filenames,
+        Containers::arrayView("license.md").except(1)), 4);
+
+    /* An extra null terminator won't match */
+    CORRADE_COMPARE(Implementation::resourceHashLookup(5, hashTable, Positions, Filenames, "TOC"), 5);
+
+    /* Nonexistent files land in some slot, but the filename doesn't match */
+    CORRADE_COMPARE(Implementation::resourceHashLookup(5, hashTable, Positions, Filenames, "image3.png"), 5);
+    CORRADE_COMPARE(Implementation::resourceHashLookup(5, hashTable, Positions, Filenames, ""), 5);
+
+    /* Empty table */
+    CORRADE_COMPARE(Implementation::resourceHashLookup(0, nullptr, nullptr, nullptr, "TOC"), 0);
+}
+
+void ResourceTest::resourceHashLookupMany() {
+    /* Simulating thousands of small files, with sorted names */
+    std::vector<std::string> names;
+    for(std::size_t i = 0; i != 5000; ++i)
+        names.push_back(formatString("shaders/snippet{:.5}.glsl", i));
+
+    std::vector<unsigned int> positions;
+    std::string filenames;
+    for(const std::string& name: names) {
+        filenames += name;
+        positions.push_back(filenames.size());
+        positions.push_back(0);
+    }
+
+    std::vector<unsigned int> hashTable(names.size()*2);
+    CORRADE_VERIFY(Implementation::resourceHashTable(names.size(), positions.data(), reinterpret_cast<const unsigned char*>(filenames.data()), hashTable.data()));
+
+    for(std::size_t i = 0; i != names.size(); ++i) {
+        const std::size_t found = Implementation::resourceHashLookup(names.size(), hashTable.data(), positions.data(), reinterpret_cast<const unsigned char*>(filenames.data()), {names[i].data(), names[i].size()});
+        if(found != i) CORRADE_COMPARE(found, i);
+    }
+
+    CORRADE_COMPARE(Implementation::resourceHashLookup(names.size(), hashTable.data(), positions.data(), reinterpret_cast<const unsigned char*>(filenames.data()), "shaders/snippet05000.glsl"), names.size());
+}
+
+void ResourceTest::resourceHashTableDuplicate() {
+    constexpr unsigned int positions[] {
+        3, 0,
+        6, 0
+    };
+    constexpr unsigned char filenames[] = "TOCTOC";
+
+    unsigned int hashTable[2*2];
+    CORRADE_VERIFY(!Implementation::resourceHashTable(2, positions, filenames, hashTable));
+}
+
 CORRADE_NEVER_INLINE unsigned int lookupInPlace(Containers::ArrayView<const char> key) {
     return Implementation::resourceLookup(5, Positions, Filenames, key);
 }
@@ -203,6 +393,69 @@ CORRADE_NEVER_INLINE unsigned int lookupStdMap(const std::map<std::string, unsig
     return map.at(key);
 }
 
+void ResourceTest::resourceLz4() {
+    const std::string data = Directory::readString(Directory::join(RESOURCE_TEST_DIR, "compressible.txt"));
+    const std::string compressed = Implementation::resourceCompressLz4(view(data));
+    CORRADE_COMPARE_AS(compressed.size(), data.size()/2,
+        TestSuite::Compare::Less);
+
+    std::string decompressed(data.size(), '\0');
+    CORRADE_VERIFY(Implementation::resourceDecompressLz4(view(compressed), view(decompressed)));
+    CORRADE_COMPARE(decompressed, data);
+
+    /* An overlapping match of a single repeated character */
+    const std::string repeated(1000, 'a');
+    const std::string compressedRepeated = Implementation::resourceCompressLz4(view(repeated));
+    CORRADE_COMPARE_AS(compressedRepeated.size(), 20,
+        TestSuite::Compare::Less);
+    std::string decompressedRepeated(repeated.size(), '\0');
+    CORRADE_VERIFY(Implementation::resourceDecompressLz4(view(compressedRepeated), view(decompressedRepeated)));
+    CORRADE_COMPARE(decompressedRepeated, repeated);
+}
+
+void ResourceTest::resourceLz4Incompressible() {
+    std::string data;
+    for(std::size_t i = 0; i != 300; ++i)
+        data += char((i*i*131 + i*7) >> 3);
+    const std::string compressed = Implementation::resourceCompressLz4(view(data));
+    CORRADE_COMPARE_AS(compressed.size(), data.size(),
+        TestSuite::Compare::GreaterOrEqual);
+
+    std::string decompressed(data.size(), '\0');
+    CORRADE_VERIFY(Implementation::resourceDecompressLz4(view(compressed), view(decompressed)));
+    CORRADE_COMPARE(decompressed, data);
+}
+
+void ResourceTest::resourceLz4Empty() {
+    const std::string compressed = Implementation::resourceCompressLz4(nullptr);
+    CORRADE_COMPARE(compressed, std::string(1, '\0'));
+    CORRADE_VERIFY(Implementation::resourceDecompressLz4(view(compressed), nullptr));
+}
+
+void ResourceTest::resourceLz4Invalid() {
+    const std::string data = Directory::readString(Directory::join(RESOURCE_TEST_DIR, "compressible.txt"));
+    const std::string compressed = Implementation::resourceCompressLz4(view(data));
+
+    /* Output too small or too large */
+    std::string decompressed(data.size() - 1, '\0');
+    CORRADE_VERIFY(!Implementation::resourceDecompressLz4(view(compressed), view(decompressed)));
+    decompressed.resize(data.size() + 1);
+    CORRADE_VERIFY(!Implementation::resourceDecompressLz4(view(compressed), view(decompressed)));
+
+    /* Truncated input */
+    decompressed.resize(data.size());
+    CORRADE_VERIFY(!Implementation::resourceDecompressLz4(view(compressed).prefix(compressed.size()/2), view(decompressed)));
+
+    /* Match offset pointing before the output start */
+    const char invalidOffset[]{'\x10', 'a', '\x02', '\x00', '\x00'};
+    char out[16];
+    CORRADE_VERIFY(!Implementation::resourceDecompressLz4(invalidOffset, out));
+
+    /* Zero offset */
+    const char zeroOffset[]{'\x10', 'a', '\x00', '\x00', '\x00'};
+    CORRADE_VERIFY(!Implementation::resourceDecompressLz4(zeroOffset, out));
+}
+
 void ResourceTest::benchmarkLookupInPlace() {
     const auto key = Containers::arrayView("license.md").except(1);
     unsigned int out = 0;
@@ -212,6 +465,38 @@ void ResourceTest::benchmarkLookupInPlace() {
     CORRADE_COMPARE(out, 40);
 }
 
+CORRADE_NEVER_INLINE unsigned int lookupHashed(const unsigned int* hashTable, Containers::ArrayView<const char> key) {
+    return Implementation::resourceHashLookup(5, hashTable, Positions, Filenames, key);
+}
+
+void ResourceTest::benchmarkLookupHashed() {
+    unsigned int hashTable[5*2];
+    CORRADE_VERIFY(Implementation::resourceHashTable(5, Positions, Filenames, hashTable));
+
+    const auto key = Containers::arrayView("license.md").except(1);
+    unsigned int out = 0;
+    CORRADE_BENCHMARK(10)
+        out += lookupHashed(hashTable, key);
+
+    CORRADE_COMPARE(out, 40);
+}
+
+CORRADE_NEVER_INLINE unsigned int lookupHashedKey(const unsigned int* hashTable, const ResourceKey& key) {
+    return Implementation::resourceHashLookup(5, hashTable, Positions, Filenames, {key.filename(), key.size()}, key.hash());
+}
+
+void ResourceTest::benchmarkLookupHashedKey() {
+    unsigned int hashTable[5*2];
+    CORRADE_VERIFY(Implementation::resourceHashTable(5, Positions, Filenames, hashTable));
+
+    constexpr ResourceKey key{"license.md"};
+    unsigned int out = 0;
+    CORRADE_BENCHMARK(10)
+        out += lookupHashedKey(hashTable, key);
+
+    CORRADE_COMPARE(out, 40);
+}
+
 void ResourceTest::benchmarkLookupStdMap() {
     std::map<std::string, unsigned int> map{
         {"TOC", 0},
@@ -328,6 +613,57 @@ void ResourceTest::compileFromEmptyAlias() {
     CORRADE_COMPARE(out.str(), "    Error: filename or alias of file 1 in group name is empty\n");
 }
 
+void ResourceTest::compileFromCompressed() {
+    const std::string compiled = Resource::compileFrom("ResourceTestCompressedData",
+        Directory::join(RESOURCE_TEST_DIR, "resources-compressed.conf"));
+    CORRADE_COMPARE_AS(compiled, Directory::join(RESOURCE_TEST_DIR, "compiled-compressed.cpp"),
+                       TestSuite::Compare::StringToFile);
+}
+
+void ResourceTest::compileFromCompressedInvalid() {
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(Resource::compileFrom("ResourceTestCompressedData",
+        Directory::join(RESOURCE_TEST_DIR, "resources-compressed-invalid.conf")).empty());
+    CORRADE_COMPARE(out.str(), "    Error: unknown compression zstd in group compressed\n");
+}
+
+void ResourceTest::compileFromAligned() {
+    const std::string compiled = Resource::compileFrom("ResourceTestAlignedData",
+        Directory::join(RESOURCE_TEST_DIR, "resources-aligned.conf"));
+    CORRADE_COMPARE_AS(compiled, Directory::join(RESOURCE_TEST_DIR, "compiled-aligned.cpp"),
+                       TestSuite::Compare::StringToFile);
+}
+
+void ResourceTest::compileFromAlignedInvalid() {
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(Resource::compileFrom("ResourceTestAlignedData",
+        Directory::join(RESOURCE_TEST_DIR, "resources-aligned-invalid.conf")).empty());
+    CORRADE_COMPARE(out.str(), "    Error: invalid alignment 24 of file 1 in group aligned\n");
+}
+
+void ResourceTest::compileFromDuplicates() {
+    const std::string compiled = Resource::compileFrom("ResourceTestDuplicatesData",
+        Directory::join(RESOURCE_TEST_DIR, "resources-duplicates.conf"));
+    CORRADE_COMPARE_AS(compiled, Directory::join(RESOURCE_TEST_DIR, "compiled-duplicates.cpp"),
+                       TestSuite::Compare::StringToFile);
+}
+
+void ResourceTest::compileFromIncbin() {
+    std::string incbinData;
+    const std::string compiled = Resource::compileFrom("ResourceTestData",
+        Directory::join(RESOURCE_TEST_DIR, "resources.conf"),
+        "C:\\build\\resource_ResourceTestData.cpp.bin", incbinData);
+    CORRADE_COMPARE_AS(compiled, Directory::join(RESOURCE_TEST_DIR, "compiled-incbin.cpp"),
+                       TestSuite::Compare::StringToFile);
+
+    /* The data are in the same order as the sorted files */
+    CORRADE_COMPARE(incbinData,
+        Directory::readString(Directory::join(RESOURCE_TEST_DIR, "consequence.bin")) +
+        Directory::readString(Directory::join(RESOURCE_TEST_DIR, "predisposition.bin")));
+}
+
 void ResourceTest::hasGroup() {
     CORRADE_VERIFY(Resource::hasGroup("test"));
     CORRADE_VERIFY(Resource::hasGroup(std::string{"test"}));
@@ -371,6 +707,17 @@ void ResourceTest::get() {
     }
 }
 
+void ResourceTest::getKey() {
+    Resource r("test");
+
+    constexpr ResourceKey key{"consequence.bin"};
+    Containers::ArrayView<const char> data = r.getRaw(key);
+    CORRADE_COMPARE_AS((std::string{data, data.size()}),
+        Directory::join(RESOURCE_TEST_DIR, "consequence.bin"),
+        TestSuite::Compare::StringToFile);
+    CORRADE_VERIFY(r.getRaw(ResourceKey{"predisposition.bin"}).data() == r.getRaw("predisposition.bin").data());
+}
+
 void ResourceTest::getEmptyFile() {
     Resource r("empty");
     CORRADE_VERIFY(!r.getRaw("empty.bin"));
@@ -409,6 +756,92 @@ void ResourceTest::getNothing() {
     CORRADE_VERIFY(r.get("nonexistentFile").empty());
 }
 
+void ResourceTest::getCompressed() {
+    Resource r("compressed");
+    CORRADE_COMPARE_AS(r.get("compressible.txt"),
+        Directory::join(RESOURCE_TEST_DIR, "compressible.txt"),
+        TestSuite::Compare::StringToFile);
+    CORRADE_COMPARE_AS(r.get("consequence.bin"),
+        Directory::join(RESOURCE_TEST_DIR, "consequence.bin"),
+        TestSuite::Compare::StringToFile);
+    CORRADE_COMPARE_AS(r.get("predisposition.bin"),
+        Directory::join(RESOURCE_TEST_DIR, "predisposition.bin"),
+        TestSuite::Compare::StringToFile);
+
+    /* The decompressed data are cached, so repeated access gives back the
+       same memory */
+    const Containers::ArrayView<const char> data = r.getRaw("compressible.txt");
+    CORRADE_COMPARE(r.getRaw("compressible.txt").data(), data.data());
+}
+
+void ResourceTest::getAligned() {
+    Resource r("aligned");
+
+    const Containers::ArrayView<const char> predisposition = r.getRaw("predisposition.bin");
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(predisposition.data()) % 16, 0);
+    CORRADE_COMPARE_AS((std::string{predisposition, predisposition.size()}),
+        Directory::join(RESOURCE_TEST_DIR, "predisposition.bin"),
+        TestSuite::Compare::StringToFile);
+
+    const Containers::ArrayView<const char> predisposition2 = r.getRaw("predisposition2.txt");
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(predisposition2.data()) % 8, 0);
+    CORRADE_COMPARE_AS((std::string{predisposition2, predisposition2.size()}),
+        Directory::join(RESOURCE_TEST_DIR, "predisposition2.txt"),
+        TestSuite::Compare::StringToFile);
+
+    /* Files without alignment are unaffected by the padding */
+    CORRADE_COMPARE_AS(r.get("consequence.bin"),
+        Directory::join(RESOURCE_TEST_DIR, "consequence.bin"),
+        TestSuite::Compare::StringToFile);
+    CORRADE_COMPARE_AS(r.get("consequence2.txt"),
+        Directory::join(RESOURCE_TEST_DIR, "consequence2.txt"),
+        TestSuite::Compare::StringToFile);
+}
+
+void ResourceTest::getDuplicates() {
+    Resource r("duplicates");
+
+    /* Files with the same contents point to the same data */
+    const Containers::ArrayView<const char> consequence = r.getRaw("consequence.bin");
+    CORRADE_COMPARE_AS((std::string{consequence, consequence.size()}),
+        Directory::join(RESOURCE_TEST_DIR, "consequence.bin"),
+        TestSuite::Compare::StringToFile);
+    CORRADE_COMPARE(r.getRaw("consequence-copy.bin").data(), consequence.data());
+    CORRADE_COMPARE(r.getRaw("consequence-copy.bin").size(), consequence.size());
+
+    /* Compressed duplicates share also the decompressed copy */
+    const Containers::ArrayView<const char> compressible = r.getRaw("compressible-copy.txt");
+    CORRADE_COMPARE_AS((std::string{compressible, compressible.size()}),
+        Directory::join(RESOURCE_TEST_DIR, "compressible.txt"),
+        TestSuite::Compare::StringToFile);
+    CORRADE_COMPARE(r.getRaw("compressible.txt").data(), compressible.data());
+
+    /* Different compression options, stored separately */
+    const Containers::ArrayView<const char> predisposition = r.getRaw("predisposition.bin");
+    const Containers::ArrayView<const char> predispositionLz4 = r.getRaw("predisposition-lz4.bin");
+    CORRADE_VERIFY(predisposition.data() != predispositionLz4.data());
+    CORRADE_COMPARE_AS((std::string{predispositionLz4, predispositionLz4.size()}),
+        Directory::join(RESOURCE_TEST_DIR, "predisposition.bin"),
+        TestSuite::Compare::StringToFile);
+
+    CORRADE_COMPARE(r.get("empty.bin"), "");
+    CORRADE_COMPARE(r.get("empty-copy.bin"), "");
+}
+
+void ResourceTest::getIncbin() {
+    Resource r("incbin");
+    CORRADE_COMPARE_AS(r.get("compressible.txt"),
+        Directory::join(RESOURCE_TEST_DIR, "compressible.txt"),
+        TestSuite::Compare::StringToFile);
+    CORRADE_COMPARE_AS(r.get("consequence.bin"),
+        Directory::join(RESOURCE_TEST_DIR, "consequence.bin"),
+        TestSuite::Compare::StringToFile);
+    CORRADE_COMPARE(r.get("empty.bin"), "");
+    CORRADE_COMPARE_AS(r.get("predisposition.bin"),
+        Directory::join(RESOURCE_TEST_DIR, "predisposition.bin"),
+        TestSuite::Compare::StringToFile);
+}
+
 void ResourceTest::overrideGroup() {
     std::ostringstream out;
     Debug redirectDebug{&out};
@@ -438,6 +871,48 @@ void ResourceTest::overrideGroupFallback() {
     CORRADE_COMPARE(out.str(), "Utility::Resource::get(): file 'consequence.bin' was not found in overriden group, fallback to compiled-in resources\n");
 }
 
+void ResourceTest::overrideGroupChanged() {
+    const std::string conf = Directory::join(RESOURCE_WRITE_TEST_DIR, "resources-changed.conf");
+    const std::string predisposition = Directory::join(RESOURCE_WRITE_TEST_DIR, "predisposition.txt");
+    const std::string consequence = Directory::join(RESOURCE_WRITE_TEST_DIR, "consequence.txt");
+    CORRADE_VERIFY(Directory::mkpath(RESOURCE_WRITE_TEST_DIR));
+    CORRADE_VERIFY(Directory::writeString(conf,
+        "group=test\n"
+        "[file]\nfilename=predisposition.txt\nalias=predisposition.bin\n"
+        "[file]\nfilename=consequence.txt\nalias=consequence.bin\n"));
+    CORRADE_VERIFY(Directory::writeString(predisposition, "predisposition"));
+    CORRADE_VERIFY(Directory::writeString(consequence, ""));
+
+    std::ostringstream out;
+    Debug redirectDebug{&out};
+    Resource::overrideGroup("test", conf);
+
+    const char* predispositionData;
+    {
+        Resource r("test");
+        CORRADE_COMPARE(r.get("predisposition.bin"), "predisposition");
+        CORRADE_COMPARE(r.get("consequence.bin"), "");
+        predispositionData = r.getRaw("predisposition.bin").data();
+
+        /* An unchanged file is shared with other instances */
+        Resource r2("test");
+        CORRADE_COMPARE(r2.getRaw("predisposition.bin").data(), predispositionData);
+
+        /* A changed file is loaded again, but the previous instance still
+           sees the original. The file is replaced instead of overwritten, as
+           the original is mapped. */
+        CORRADE_VERIFY(Directory::writeString(predisposition + ".new", "changed predisposition"));
+        CORRADE_VERIFY(Directory::move(predisposition + ".new", predisposition));
+        Resource r3("test");
+        CORRADE_COMPARE(r3.get("predisposition.bin"), "changed predisposition");
+        CORRADE_COMPARE(r.get("predisposition.bin"), "predisposition");
+    }
+
+    /* The last loaded version stays cached even if no instance uses it */
+    Resource r("test");
+    CORRADE_COMPARE(r.get("predisposition.bin"), "changed predisposition");
+}
+
 void ResourceTest::overrideNonexistentFile() {
     std::ostringstream out;
     Error redirectError{&out};
@@ -472,6 +947,159 @@ void ResourceTest::overrideDifferentGroup() {
     CORRADE_COMPARE(out.str(), "Utility::Resource: overriden with different group, found 'wat' but expected 'test'\n");
 }
 
+void ResourceTest::pack() {
+    const std::string compiled = Resource::compilePackFrom(
+        Directory::join(RESOURCE_TEST_DIR, "resources-pack.conf"));
+    CORRADE_VERIFY(compiled.size() > sizeof(Implementation::ResourcePackHeader));
+    CORRADE_COMPARE(compiled.substr(0, 8), "CORRPACK");
+
+    const std::string filename = Directory::join(RESOURCE_WRITE_TEST_DIR, "pack.bin");
+    CORRADE_VERIFY(Directory::mkpath(RESOURCE_WRITE_TEST_DIR));
+    CORRADE_VERIFY(Directory::writeString(filename, compiled));
+
+    CORRADE_VERIFY(!Resource::hasGroup("pack"));
+    CORRADE_VERIFY(Resource::loadPack(filename));
+    CORRADE_VERIFY(Resource::hasGroup("pack"));
+
+    {
+        Resource r{"pack"};
+        CORRADE_COMPARE_AS(r.list(), (std::vector<std::string>{
+            "compressible.txt",
+            "consequence-copy.bin",
+            "consequence.bin",
+            "empty.bin",
+            "predisposition.bin"}), TestSuite::Compare::Container);
+
+        CORRADE_COMPARE_AS(r.get("compressible.txt"),
+            Directory::join(RESOURCE_TEST_DIR, "compressible.txt"),
+            TestSuite::Compare::StringToFile);
+        CORRADE_COMPARE_AS(r.get("consequence.bin"),
+            Directory::join(RESOURCE_TEST_DIR, "consequence.bin"),
+            TestSuite::Compare::StringToFile);
+        CORRADE_COMPARE(r.get("empty.bin"), "");
+
+        /* Aligned files are aligned also in the mapped pack */
+        const Containers::ArrayView<const char> predisposition = r.getRaw("predisposition.bin");
+        CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(predisposition.data()) % 16, 0);
+        CORRADE_COMPARE_AS((std::string{predisposition, predisposition.size()}),
+            Directory::join(RESOURCE_TEST_DIR, "predisposition.bin"),
+            TestSuite::Compare::StringToFile);
+
+        /* Duplicates point to the same data */
+        CORRADE_COMPARE(r.getRaw("consequence-copy.bin").data(), r.getRaw("consequence.bin").data());
+
+        /* Lookup through a precalculated key works the same */
+        CORRADE_VERIFY(r.getRaw(ResourceKey{"consequence.bin"}).data() == r.getRaw("consequence.bin").data());
+    }
+
+    CORRADE_VERIFY(Resource::unloadPack("pack"));
+    CORRADE_VERIFY(!Resource::hasGroup("pack"));
+
+    /* Loading again after unloading works */
+    CORRADE_VERIFY(Resource::loadPack(filename));
+    CORRADE_COMPARE_AS(Resource{"pack"}.get("compressible.txt"),
+        Directory::join(RESOURCE_TEST_DIR, "compressible.txt"),
+        TestSuite::Compare::StringToFile);
+    CORRADE_VERIFY(Resource::unloadPack("pack"));
+}
+
+void ResourceTest::packNothing() {
+    const std::string conf = Directory::join(RESOURCE_WRITE_TEST_DIR, "resources-pack-nothing.conf");
+    const std::string filename = Directory::join(RESOURCE_WRITE_TEST_DIR, "pack-nothing.bin");
+    CORRADE_VERIFY(Directory::mkpath(RESOURCE_WRITE_TEST_DIR));
+    CORRADE_VERIFY(Directory::writeString(conf, "group=pack-nothing\n"));
+
+    /* Unlike with compileFrom() there's no special case, the pack just has
+       all arrays empty */
+    const std::string compiled = Resource::compilePackFrom(conf);
+    CORRADE_COMPARE(compiled.size(), sizeof(Implementation::ResourcePackHeader) + 16);
+    CORRADE_VERIFY(Directory::writeString(filename, compiled));
+
+    CORRADE_VERIFY(Resource::loadPack(filename));
+    CORRADE_VERIFY(Resource{"pack-nothing"}.list().empty());
+    CORRADE_VERIFY(Resource::unloadPack("pack-nothing"));
+}
+
+void ResourceTest::loadPackNonexistent() {
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!Resource::loadPack("nonexistent.pack"));
+    CORRADE_COMPARE(out.str(), "Utility::Resource::loadPack(): cannot open file nonexistent.pack\n");
+}
+
+void ResourceTest::loadPackInvalid() {
+    const std::string filename = Directory::join(RESOURCE_WRITE_TEST_DIR, "pack-invalid.bin");
+    CORRADE_VERIFY(Directory::mkpath(RESOURCE_WRITE_TEST_DIR));
+    CORRADE_VERIFY(Directory::writeString(filename, Resource::compileFrom("pack",
+        Directory::join(RESOURCE_TEST_DIR, "resources-pack.conf"))));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!Resource::loadPack(filename));
+    CORRADE_COMPARE(out.str(), formatString("Utility::Resource::loadPack(): file {} is not a resource pack\n", filename));
+}
+
+void ResourceTest::loadPackTruncated() {
+    const std::string compiled = Resource::compilePackFrom(
+        Directory::join(RESOURCE_TEST_DIR, "resources-pack.conf"));
+    const std::string filename = Directory::join(RESOURCE_WRITE_TEST_DIR, "pack-truncated.bin");
+    CORRADE_VERIFY(Directory::mkpath(RESOURCE_WRITE_TEST_DIR));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(Directory::writeString(filename, compiled.substr(0, 20)));
+    CORRADE_VERIFY(!Resource::loadPack(filename));
+    CORRADE_VERIFY(Directory::writeString(filename, compiled.substr(0, compiled.size() - 1)));
+    CORRADE_VERIFY(!Resource::loadPack(filename));
+    CORRADE_COMPARE(out.str(), formatString(
+        "Utility::Resource::loadPack(): file {0} is too short\n"
+        "Utility::Resource::loadPack(): file {0} is truncated\n", filename));
+    CORRADE_VERIFY(!Resource::hasGroup("pack"));
+}
+
+void ResourceTest::loadPackCorrupted() {
+    std::string compiled = Resource::compilePackFrom(
+        Directory::join(RESOURCE_TEST_DIR, "resources-pack.conf"));
+    const std::string filename = Directory::join(RESOURCE_WRITE_TEST_DIR, "pack-corrupted.bin");
+    CORRADE_VERIFY(Directory::mkpath(RESOURCE_WRITE_TEST_DIR));
+
+    /* The first data end offset, located right after the group name
+       "pack\0" padded to 8 bytes, pointing way past the data */
+    const std::size_t positions = sizeof(Implementation::ResourcePackHeader) + 8;
+    compiled[positions + 4 + 3] = '\x7f';
+    CORRADE_VERIFY(Directory::writeString(filename, compiled));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!Resource::loadPack(filename));
+    CORRADE_COMPARE(out.str(), formatString("Utility::Resource::loadPack(): file {} is corrupted\n", filename));
+    CORRADE_VERIFY(!Resource::hasGroup("pack"));
+}
+
+void ResourceTest::loadPackGroupExists() {
+    const std::string filename = Directory::join(RESOURCE_WRITE_TEST_DIR, "pack-test.bin");
+    CORRADE_VERIFY(Directory::mkpath(RESOURCE_WRITE_TEST_DIR));
+    CORRADE_VERIFY(Directory::writeString(filename, Resource::compilePackFrom(
+        Directory::join(RESOURCE_TEST_DIR, "resources.conf"))));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!Resource::loadPack(filename));
+    CORRADE_COMPARE(out.str(), "Utility::Resource::loadPack(): group 'test' already exists\n");
+}
+
+void ResourceTest::unloadPackNotLoaded() {
+    std::ostringstream out;
+    Error redirectError{&out};
+    /* Compiled-in groups can't be unloaded this way either */
+    CORRADE_VERIFY(!Resource::unloadPack("test"));
+    CORRADE_VERIFY(!Resource::unloadPack("nonexistent"));
+    CORRADE_VERIFY(Resource::hasGroup("test"));
+    CORRADE_COMPARE(out.str(),
+        "Utility::Resource::unloadPack(): group 'test' was not loaded from a pack\n"
+        "Utility::Resource::unloadPack(): group 'nonexistent' was not loaded from a pack\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Corrade::Utility::Test::ResourceTest)
@@ -0,0 +1,88 @@
+/* Compiled resource file. DO NOT EDIT! */
+
+#include "Corrade/Corrade.h"
+#include "Corrade/Utility/Macros.h"
+#include "Corrade/Utility/Resource.h"
+
+namespace {
+
+const unsigned int resourcePositions[] = {
+    0x0000000f,0x00000008,
+    0x0000001f,0x0000001e,
+    0x00000031,0x00000028,
+    0x00000044,0x00000041
+};
+
+const unsigned char resourceFilenames[] = {
+    /* consequence.bin */
+    0x63,0x6f,0x6e,0x73,0x65,0x71,0x75,0x65,0x6e,0x63,0x65,0x2e,0x62,0x69,0x6e,
+
+    /* consequence2.txt */
+    0x63,0x6f,0x6e,0x73,0x65,0x71,0x75,0x65,0x6e,0x63,0x65,0x32,0x2e,0x74,0x78,
+    0x74,
+
+    /* predisposition.bin */
+    0x70,0x72,0x65,0x64,0x69,0x73,0x70,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x2e,
+    0x62,0x69,0x6e,
+
+    /* predisposition2.txt */
+    0x70,0x72,0x65,0x64,0x69,0x73,0x70,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x32,
+    0x2e,0x74,0x78,0x74
+};
+
+alignas(16) const unsigned char resourceData[] = {
+    /* consequence.bin */
+    0xd1,0x5e,0xa5,0xed,0xea,0xdd,0x00,0x0d,
+
+    /* consequence2.txt */
+    0x6f,0x76,0x65,0x72,0x72,0x69,0x64,0x65,0x6e,0x20,0x63,0x6f,0x6e,0x73,0x65,
+    0x71,0x75,0x65,0x6e,0x63,0x65,0x0a,
+
+    /* padding to 16 bytes */
+    0x00,0x00,
+
+    /* predisposition.bin */
+    0xba,0xdc,0x0f,0xfe,0xeb,0xad,0xf0,0x0d,
+
+    /* predisposition2.txt */
+    0x6f,0x76,0x65,0x72,0x72,0x69,0x64,0x65,0x6e,0x20,0x70,0x72,0x65,0x64,0x69,
+    0x73,0x70,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x0a
+};
+
+const unsigned int resourceHashTable[] = {
+    0x00000000,0x00000000,
+    0x00000000,0x00000003,
+    0x00000001,0x00000002,
+    0x0000000a,0x00000001
+};
+
+// const unsigned int resourceCompression[] = {
+// };
+
+const unsigned int resourceAlignment[] = {
+    0x00000001,
+    0x00000001,
+    0x00000010,
+    0x00000008
+};
+
+// const unsigned int resourceDuplicates[] = {
+// };
+
+Corrade::Utility::Implementation::ResourceGroup resource{
+    "aligned", 4, resourcePositions, resourceFilenames, resourceData,
+    resourceHashTable, nullptr, resourceAlignment, nullptr, nullptr, nullptr};
+
+}
+
+int resourceInitializer_ResourceTestAlignedData();
+int resourceInitializer_ResourceTestAlignedData() {
+    Corrade::Utility::Resource::registerData(resource);
+    return 1;
+} CORRADE_AUTOMATIC_INITIALIZER(resourceInitializer_ResourceTestAlignedData)
+
+int resourceFinalizer_ResourceTestAlignedData();
+int resourceFinalizer_ResourceTestAlignedData() {
+    Corrade::Utility::Resource::unregisterData(resource);
+    return 1;
+} CORRADE_AUTOMATIC_FINALIZER(resourceFinalizer_ResourceTestAlignedData)
@@ -0,0 +1,79 @@
+/* Compiled resource file. DO NOT EDIT! */
+
+#include "Corrade/Corrade.h"
+#include "Corrade/Utility/Macros.h"
+#include "Corrade/Utility/Resource.h"
+
+namespace {
+
+const unsigned int resourcePositions[] = {
+    0x00000010,0x00000065,
+    0x0000001f,0x0000006d,
+    0x00000031,0x00000075
+};
+
+const unsigned char resourceFilenames[] = {
+    /* compressible.txt */
+    0x63,0x6f,0x6d,0x70,0x72,0x65,0x73,0x73,0x69,0x62,0x6c,0x65,0x2e,0x74,0x78,
+    0x74,
+
+    /* consequence.bin */
+    0x63,0x6f,0x6e,0x73,0x65,0x71,0x75,0x65,0x6e,0x63,0x65,0x2e,0x62,0x69,0x6e,
+
+    /* predisposition.bin */
+    0x70,0x72,0x65,0x64,0x69,0x73,0x70,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x2e,
+    0x62,0x69,0x6e
+};
+
+const unsigned char resourceData[] = {
+    /* compressible.txt */
+    0xf1,0x17,0x4c,0x69,0x6e,0x65,0x20,0x30,0x3a,0x20,0x74,0x68,0x65,0x20,0x71,
+    0x75,0x69,0x63,0x6b,0x20,0x62,0x72,0x6f,0x77,0x6e,0x20,0x66,0x6f,0x78,0x20,
+    0x6a,0x75,0x6d,0x70,0x73,0x20,0x6f,0x76,0x65,0x72,0x1f,0x00,0xa1,0x6c,0x61,
+    0x7a,0x79,0x20,0x64,0x6f,0x67,0x2e,0x0a,0x35,0x00,0x1f,0x31,0x35,0x00,0x21,
+    0x1f,0x32,0x35,0x00,0x21,0x1f,0x33,0x35,0x00,0x21,0x1f,0x34,0x35,0x00,0x21,
+    0x1f,0x35,0x35,0x00,0x21,0x1f,0x36,0x35,0x00,0x21,0x0f,0x73,0x01,0xff,0xff,
+    0xff,0xff,0xff,0xff,0xbe,0x50,0x64,0x6f,0x67,0x2e,0x0a,
+
+    /* consequence.bin */
+    0xd1,0x5e,0xa5,0xed,0xea,0xdd,0x00,0x0d,
+
+    /* predisposition.bin */
+    0xba,0xdc,0x0f,0xfe,0xeb,0xad,0xf0,0x0d
+};
+
+const unsigned int resourceHashTable[] = {
+    0x00000000,0x00000002,
+    0x00000007,0x00000000,
+    0x00000000,0x00000001
+};
+
+const unsigned int resourceCompression[] = {
+    0x00000001,0x00000848,
+    0x00000000,0x00000008,
+    0x00000000,0x00000008
+};
+
+// const unsigned int resourceAlignment[] = {
+// };
+
+// const unsigned int resourceDuplicates[] = {
+// };
+
+Corrade::Utility::Implementation::ResourceGroup resource{
+    "compressed", 3, resourcePositions, resourceFilenames, resourceData,
+    resourceHashTable, resourceCompression, nullptr, nullptr, nullptr, nullptr};
+
+}
+
+int resourceInitializer_ResourceTestCompressedData();
+int resourceInitializer_ResourceTestCompressedData() {
+    Corrade::Utility::Resource::registerData(resource);
+    return 1;
+} CORRADE_AUTOMATIC_INITIALIZER(resourceInitializer_ResourceTestCompressedData)
+
+int resourceFinalizer_ResourceTestCompressedData();
+int resourceFinalizer_ResourceTestCompressedData() {
+    Corrade::Utility::Resource::unregisterData(resource);
+    return 1;
+} CORRADE_AUTOMATIC_FINALIZER(resourceFinalizer_ResourceTestCompressedData)
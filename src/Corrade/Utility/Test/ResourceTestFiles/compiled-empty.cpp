@@ -19,17 +19,27 @@ const unsigned char resourceFilenames[] = {
     /* empty.bin */
 // };
 
-Corrade::Utility::Implementation::ResourceGroup resource;
+const unsigned int resourceHashTable[] = {
+    0x00000001,0x00000000
+};
+
+// const unsigned int resourceCompression[] = {
+// };
+
+// const unsigned int resourceAlignment[] = {
+// };
+
+// const unsigned int resourceDuplicates[] = {
+// };
+
+Corrade::Utility::Implementation::ResourceGroup resource{
+    "test", 1, resourcePositions, resourceFilenames, nullptr,
+    resourceHashTable, nullptr, nullptr, nullptr, nullptr, nullptr};
 
 }
 
 int resourceInitializer_ResourceTestData();
 int resourceInitializer_ResourceTestData() {
-    resource.name = "test";
-    resource.count = 1;
-    resource.positions = resourcePositions;
-    resource.filenames = resourceFilenames;
-    resource.data = nullptr;
     Corrade::Utility::Resource::registerData(resource);
     return 1;
 } CORRADE_AUTOMATIC_INITIALIZER(resourceInitializer_ResourceTestData)
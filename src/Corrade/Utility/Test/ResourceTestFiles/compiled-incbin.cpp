@@ -0,0 +1,72 @@
+/* Compiled resource file. DO NOT EDIT! */
+
+#include "Corrade/Corrade.h"
+#include "Corrade/Utility/Macros.h"
+#include "Corrade/Utility/Resource.h"
+
+/* Data of all files, 16 bytes with SHA-1 30a798a6b310d6cee2a9bb72bc0dcc956e110bf8, included from
+   C:/build/resource_ResourceTestData.cpp.bin */
+extern "C" const unsigned char corradeResourceData_ResourceTestData[] __asm__("corradeResourceData_ResourceTestData");
+__asm__(
+#if defined(__APPLE__)
+    ".pushsection __TEXT,__const\n"
+    ".private_extern corradeResourceData_ResourceTestData\n"
+#elif defined(_WIN32)
+    ".pushsection .rdata,\"dr\"\n"
+#else
+    ".pushsection .rodata,\"a\"\n"
+    ".hidden corradeResourceData_ResourceTestData\n"
+#endif
+    ".globl corradeResourceData_ResourceTestData\n"
+    ".balign 16\n"
+    "corradeResourceData_ResourceTestData:\n"
+    ".incbin \"C:/build/resource_ResourceTestData.cpp.bin\"\n"
+    ".popsection\n");
+
+namespace {
+
+const unsigned int resourcePositions[] = {
+    0x0000000f,0x00000008,
+    0x00000021,0x00000010
+};
+
+const unsigned char resourceFilenames[] = {
+    /* consequence.bin */
+    0x63,0x6f,0x6e,0x73,0x65,0x71,0x75,0x65,0x6e,0x63,0x65,0x2e,0x62,0x69,0x6e,
+
+    /* predisposition.bin */
+    0x70,0x72,0x65,0x64,0x69,0x73,0x70,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x2e,
+    0x62,0x69,0x6e
+};
+
+const unsigned int resourceHashTable[] = {
+    0x00000002,0x00000000,
+    0x00000000,0x00000001
+};
+
+// const unsigned int resourceCompression[] = {
+// };
+
+// const unsigned int resourceAlignment[] = {
+// };
+
+// const unsigned int resourceDuplicates[] = {
+// };
+
+Corrade::Utility::Implementation::ResourceGroup resource{
+    "test", 2, resourcePositions, resourceFilenames, corradeResourceData_ResourceTestData,
+    resourceHashTable, nullptr, nullptr, nullptr, nullptr, nullptr};
+
+}
+
+int resourceInitializer_ResourceTestData();
+int resourceInitializer_ResourceTestData() {
+    Corrade::Utility::Resource::registerData(resource);
+    return 1;
+} CORRADE_AUTOMATIC_INITIALIZER(resourceInitializer_ResourceTestData)
+
+int resourceFinalizer_ResourceTestData();
+int resourceFinalizer_ResourceTestData() {
+    Corrade::Utility::Resource::unregisterData(resource);
+    return 1;
+} CORRADE_AUTOMATIC_FINALIZER(resourceFinalizer_ResourceTestData)
@@ -6,17 +6,13 @@
 
 namespace {
 
-Corrade::Utility::Implementation::ResourceGroup resource;
+Corrade::Utility::Implementation::ResourceGroup resource{
+    "nothing", 0, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr};
 
 }
 
 int resourceInitializer_ResourceTestNothingData();
 int resourceInitializer_ResourceTestNothingData() {
-    resource.name = "nothing";
-    resource.count = 0;
-    resource.positions = nullptr;
-    resource.filenames = nullptr;
-    resource.data = nullptr;
     Corrade::Utility::Resource::registerData(resource);
     return 1;
 } CORRADE_AUTOMATIC_INITIALIZER(resourceInitializer_ResourceTestNothingData)
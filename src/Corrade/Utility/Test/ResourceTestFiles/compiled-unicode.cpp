@@ -20,17 +20,27 @@ const unsigned char resourceData[] = {
     0xd1,0x5e,0xa5,0xed,0xea,0xdd,0x00,0x0d
 };
 
-Corrade::Utility::Implementation::ResourceGroup resource;
+const unsigned int resourceHashTable[] = {
+    0x00000001,0x00000000
+};
+
+// const unsigned int resourceCompression[] = {
+// };
+
+// const unsigned int resourceAlignment[] = {
+// };
+
+// const unsigned int resourceDuplicates[] = {
+// };
+
+Corrade::Utility::Implementation::ResourceGroup resource{
+    "unicode", 1, resourcePositions, resourceFilenames, resourceData,
+    resourceHashTable, nullptr, nullptr, nullptr, nullptr, nullptr};
 
 }
 
 int resourceInitializer_ResourceTestUtf8Data();
 int resourceInitializer_ResourceTestUtf8Data() {
-    resource.name = "unicode";
-    resource.count = 1;
-    resource.positions = resourcePositions;
-    resource.filenames = resourceFilenames;
-    resource.data = resourceData;
     Corrade::Utility::Resource::registerData(resource);
     return 1;
 } CORRADE_AUTOMATIC_INITIALIZER(resourceInitializer_ResourceTestUtf8Data)
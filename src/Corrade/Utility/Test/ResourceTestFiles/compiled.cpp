@@ -28,17 +28,28 @@ const unsigned char resourceData[] = {
     0xba,0xdc,0x0f,0xfe,0xeb,0xad,0xf0,0x0d
 };
 
-Corrade::Utility::Implementation::ResourceGroup resource;
+const unsigned int resourceHashTable[] = {
+    0x00000002,0x00000000,
+    0x00000000,0x00000001
+};
+
+// const unsigned int resourceCompression[] = {
+// };
+
+// const unsigned int resourceAlignment[] = {
+// };
+
+// const unsigned int resourceDuplicates[] = {
+// };
+
+Corrade::Utility::Implementation::ResourceGroup resource{
+    "test", 2, resourcePositions, resourceFilenames, resourceData,
+    resourceHashTable, nullptr, nullptr, nullptr, nullptr, nullptr};
 
 }
 
 int resourceInitializer_ResourceTestData();
 int resourceInitializer_ResourceTestData() {
-    resource.name = "test";
-    resource.count = 2;
-    resource.positions = resourcePositions;
-    resource.filenames = resourceFilenames;
-    resource.data = resourceData;
     Corrade::Utility::Resource::registerData(resource);
     return 1;
 } CORRADE_AUTOMATIC_INITIALIZER(resourceInitializer_ResourceTestData)
@@ -30,8 +30,10 @@
 
 #include "Corrade/Containers/Array.h"
 #include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Container.h"
 #include "Corrade/Utility/AbstractHash.h"
 #include "Corrade/Utility/Sha1.h"
+#include "Corrade/Utility/Implementation/sha1.h"
 
 namespace Corrade { namespace Utility { namespace Test { namespace {
 
@@ -46,6 +48,23 @@ struct Sha1Test: TestSuite::Tester {
 
     void iterative();
     void reuse();
+
+    void variant();
+
+    void benchmark();
+};
+
+const struct {
+    const char* name;
+    Cpu::Features features;
+} VariantData[]{
+    {"scalar", {}},
+    #ifdef CORRADE_TARGET_X86
+    {"SHA", Cpu::Feature::Sha|Cpu::Feature::Ssse3},
+    #endif
+    #ifdef CORRADE_TARGET_ARM
+    {"NEON SHA-1", Cpu::Feature::NeonSha1},
+    #endif
 };
 
 Sha1Test::Sha1Test() {
@@ -58,6 +77,12 @@ Sha1Test::Sha1Test() {
     addRepeatedTests({&Sha1Test::iterative}, 128);
 
     addTests({&Sha1Test::reuse});
+
+    addInstancedTests({&Sha1Test::variant},
+        Containers::arraySize(VariantData));
+
+    addInstancedBenchmarks({&Sha1Test::benchmark}, 10,
+        Containers::arraySize(VariantData));
 }
 
 void Sha1Test::emptyString() {
@@ -123,6 +148,58 @@ void Sha1Test::reuse() {
     CORRADE_COMPARE(hasher.digest(), Sha1::Digest::fromHexString("cd36b370758a259b34845084a6cc38473cb95e27"));
 }
 
+void Sha1Test::variant() {
+    auto&& data = VariantData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if((Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("Not supported on this machine.");
+
+    const Implementation::Sha1ProcessFunction function = Implementation::sha1ProcessFunction(data.features);
+    const Implementation::Sha1ProcessFunction scalar = Implementation::sha1ProcessFunction({});
+    if(data.features && function == scalar)
+        CORRADE_SKIP("Not compiled in.");
+
+    /* Process all complete blocks of the data with both this and the scalar
+       variant, one and more blocks at a time */
+    const std::size_t count = String.size()/64;
+    CORRADE_VERIFY(count > 2);
+    unsigned int expected[5]{0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+    scalar(expected, String.data(), count);
+
+    unsigned int actual[5]{0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+    function(actual, String.data(), count);
+    CORRADE_COMPARE_AS(Containers::arrayView(actual), Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+
+    unsigned int actualSplit[5]{0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+    function(actualSplit, String.data(), 1);
+    function(actualSplit, String.data() + 64, count - 1);
+    CORRADE_COMPARE_AS(Containers::arrayView(actualSplit), Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void Sha1Test::benchmark() {
+    auto&& data = VariantData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if((Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("Not supported on this machine.");
+
+    const Implementation::Sha1ProcessFunction function = Implementation::sha1ProcessFunction(data.features);
+    if(data.features && function == Implementation::sha1ProcessFunction({}))
+        CORRADE_SKIP("Not compiled in.");
+
+    Containers::Array<char> buffer{Containers::ValueInit, 1024*1024};
+    for(std::size_t i = 0; i != buffer.size(); ++i) buffer[i] = char(i*37);
+
+    unsigned int digest[5]{0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+    CORRADE_BENCHMARK(1)
+        function(digest, buffer.data(), buffer.size()/64);
+
+    CORRADE_VERIFY(digest[0] || digest[1] || digest[2] || digest[3] || digest[4]);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Corrade::Utility::Test::Sha1Test)
@@ -0,0 +1,239 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/Utility/DebugStl.h"
+#include "Corrade/Utility/FormatStl.h"
+#include "Corrade/Utility/StringPool.h"
+
+#if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+#include <thread>
+#endif
+
+namespace Corrade { namespace Utility { namespace Test { namespace {
+
+struct StringPoolTest: TestSuite::Tester {
+    explicit StringPoolTest();
+
+    void construct();
+    void intern();
+    void internEmpty();
+    void internView();
+    void internSubstring();
+    void find();
+    void largeString();
+    void stableMemory();
+    void accessOutOfRange();
+    void global();
+    void threaded();
+};
+
+using namespace Containers::Literals;
+
+StringPoolTest::StringPoolTest() {
+    addTests({&StringPoolTest::construct,
+              &StringPoolTest::intern,
+              &StringPoolTest::internEmpty,
+              &StringPoolTest::internView,
+              &StringPoolTest::internSubstring,
+              &StringPoolTest::find,
+              &StringPoolTest::largeString,
+              &StringPoolTest::stableMemory,
+              &StringPoolTest::accessOutOfRange,
+              &StringPoolTest::global,
+              &StringPoolTest::threaded});
+}
+
+void StringPoolTest::construct() {
+    StringPool pool;
+    CORRADE_COMPARE(pool.size(), 0);
+    CORRADE_COMPARE(pool.dataSize(), 0);
+}
+
+void StringPoolTest::intern() {
+    StringPool pool;
+    CORRADE_COMPARE(pool.intern("hello"), 0);
+    CORRADE_COMPARE(pool.intern("world"), 1);
+    CORRADE_COMPARE(pool.intern("hello"), 0);
+    CORRADE_COMPARE(pool.intern("hell"), 2);
+    CORRADE_COMPARE(pool.size(), 3);
+    /* Including null terminators */
+    CORRADE_COMPARE(pool.dataSize(), 6 + 6 + 5);
+
+    CORRADE_COMPARE(pool[0], "hello"_s);
+    CORRADE_COMPARE(pool[1], "world"_s);
+    CORRADE_COMPARE(pool[2], "hell"_s);
+    CORRADE_COMPARE(pool[0].data()[5], '\0');
+    CORRADE_COMPARE(pool[2].data()[4], '\0');
+}
+
+void StringPoolTest::internEmpty() {
+    StringPool pool;
+    CORRADE_COMPARE(pool.intern(""), 0);
+    CORRADE_COMPARE(pool.intern(nullptr), 0);
+    CORRADE_COMPARE(pool.size(), 1);
+    CORRADE_COMPARE(pool.dataSize(), 1);
+
+    /* Not a null view, so it can be passed to C APIs */
+    CORRADE_VERIFY(pool[0].data());
+    CORRADE_COMPARE(pool[0].size(), 0);
+    CORRADE_COMPARE(pool[0].data()[0], '\0');
+}
+
+void StringPoolTest::internView() {
+    StringPool pool;
+    const Containers::StringView a = pool.internView("key");
+    const Containers::StringView b = pool.internView("value");
+    CORRADE_COMPARE(a, "key"_s);
+    CORRADE_COMPARE(b, "value"_s);
+
+    /* Interning the same string gives back the same memory */
+    const std::string copy = "key";
+    CORRADE_VERIFY(pool.internView(copy.data()).data() == a.data());
+    CORRADE_VERIFY(pool[pool.intern("key")].data() == a.data());
+    CORRADE_COMPARE(pool.size(), 2);
+}
+
+void StringPoolTest::internSubstring() {
+    StringPool pool;
+
+    /* The view isn't null-terminated, the pooled copy is */
+    const Containers::StringView a = pool.internView("hello world"_s.prefix(5));
+    CORRADE_COMPARE(a, "hello"_s);
+    CORRADE_COMPARE(a.data()[5], '\0');
+    CORRADE_COMPARE(pool.intern("hello"), 0);
+}
+
+void StringPoolTest::find() {
+    StringPool pool;
+    pool.intern("a");
+    pool.intern("b");
+
+    CORRADE_COMPARE(pool.find("a"), 0);
+    CORRADE_COMPARE(pool.find("b"), 1);
+    CORRADE_COMPARE(pool.find("c"), 0xffffffffu);
+
+    /* Finding doesn't add anything */
+    CORRADE_COMPARE(pool.size(), 2);
+}
+
+void StringPoolTest::largeString() {
+    StringPool pool{16};
+
+    pool.intern("short");
+    const std::string large(100, 'x');
+    const Containers::StringView a = pool.internView(large.data());
+    CORRADE_COMPARE(a, Containers::StringView{large.data()});
+    CORRADE_COMPARE(a.data()[100], '\0');
+
+    /* The rest of the first block is still used for subsequent strings */
+    const Containers::StringView first = pool[0];
+    const Containers::StringView b = pool.internView("tiny");
+    CORRADE_VERIFY(b.data() == first.data() + 6);
+    CORRADE_COMPARE(pool.size(), 3);
+}
+
+void StringPoolTest::stableMemory() {
+    StringPool pool{64};
+
+    std::vector<Containers::StringView> views;
+    std::vector<std::string> strings;
+    for(std::size_t i = 0; i != 1000; ++i) {
+        strings.push_back(formatString("string number {}", i));
+        views.push_back(pool.internView(strings.back().data()));
+    }
+
+    /* All views stay valid and IDs match the insertion order even after the
+       internal tables got reallocated many times */
+    CORRADE_COMPARE(pool.size(), 1000);
+    for(std::size_t i = 0; i != 1000; ++i) {
+        CORRADE_COMPARE(views[i], Containers::StringView{strings[i].data()});
+        CORRADE_VERIFY(pool[i].data() == views[i].data());
+        CORRADE_COMPARE(pool.find(strings[i].data()), i);
+    }
+}
+
+void StringPoolTest::accessOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    StringPool pool;
+    pool.intern("a");
+    pool.intern("b");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    pool[2];
+    CORRADE_COMPARE(out.str(), "Utility::StringPool::operator[](): index 2 out of range for 2 strings\n");
+}
+
+void StringPoolTest::global() {
+    StringPool& a = StringPool::global();
+    StringPool& b = StringPool::global();
+    CORRADE_VERIFY(&a == &b);
+
+    const Containers::StringView view = a.internView("StringPoolTest::global()");
+    CORRADE_VERIFY(b.internView("StringPoolTest::global()").data() == view.data());
+}
+
+void StringPoolTest::threaded() {
+    #if !defined(CORRADE_BUILD_MULTITHREADED) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    CORRADE_SKIP("CORRADE_BUILD_MULTITHREADED is not enabled or threads are not available.");
+    #else
+    StringPool pool{128};
+
+    /* Each thread interns the same set of strings in a different order,
+       remembering the IDs it got */
+    std::vector<std::uint32_t> ids[4];
+    std::vector<std::thread> threads;
+    for(std::size_t i = 0; i != 4; ++i) threads.emplace_back([&pool, &ids, i]{
+        ids[i].resize(500);
+        for(std::size_t j = 0; j != 500; ++j) {
+            const std::size_t index = ((i % 2 ? 499 - j : j) + i*125) % 500;
+            ids[i][index] = pool.intern(formatString("string {}", index).data());
+        }
+    });
+    for(std::thread& thread: threads) thread.join();
+
+    /* All threads should get the same ID for the same string and there
+       should be no duplicates */
+    CORRADE_COMPARE(pool.size(), 500);
+    for(std::size_t i = 0; i != 500; ++i) {
+        CORRADE_COMPARE(ids[1][i], ids[0][i]);
+        CORRADE_COMPARE(ids[2][i], ids[0][i]);
+        CORRADE_COMPARE(ids[3][i], ids[0][i]);
+        CORRADE_COMPARE(pool[ids[0][i]], Containers::StringView{formatString("string {}", i).data()});
+    }
+    #endif
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Utility::Test::StringPoolTest)
@@ -23,6 +23,9 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cctype>
+#include <cstdint>
+#include <cstring>
 #include <sstream>
 
 #include "Corrade/Containers/StaticArray.h"
@@ -45,6 +48,10 @@ struct StringTest: TestSuite::Tester {
     void join();
     void lowercase();
     void uppercase();
+    void lowercaseUppercaseInPlace();
+    void lowercaseUppercaseInPlaceAllBytes();
+    void caseInsensitiveEquals();
+    void caseInsensitiveHash();
 
     void beginsWith();
     void beginsWithEmpty();
@@ -67,6 +74,19 @@ struct StringTest: TestSuite::Tester {
     void replaceAllEmptySearch();
     void replaceAllEmptyReplace();
     void replaceAllCycle();
+    void replaceAllMultiple();
+    void replaceAllMultipleLongestMatch();
+    void replaceAllMultipleNotFound();
+    void replaceAllMultipleEmptySearch();
+    void replaceAllMultipleEmptyReplace();
+    void replaceAllMultipleSwap();
+
+    void benchmarkReplaceAllSequential();
+    void benchmarkReplaceAllMultiple();
+    void benchmarkLowercaseInPlace();
+    void benchmarkLowercaseStl();
+    void benchmarkTrim();
+    void benchmarkSplitWithoutEmptyParts();
 };
 
 StringTest::StringTest() {
@@ -79,6 +99,10 @@ StringTest::StringTest() {
               &StringTest::join,
               &StringTest::lowercase,
               &StringTest::uppercase,
+              &StringTest::lowercaseUppercaseInPlace,
+              &StringTest::lowercaseUppercaseInPlaceAllBytes,
+              &StringTest::caseInsensitiveEquals,
+              &StringTest::caseInsensitiveHash,
 
               &StringTest::beginsWith,
               &StringTest::beginsWithEmpty,
@@ -100,7 +124,20 @@ StringTest::StringTest() {
               &StringTest::replaceAllNotFound,
               &StringTest::replaceAllEmptySearch,
               &StringTest::replaceAllEmptyReplace,
-              &StringTest::replaceAllCycle});
+              &StringTest::replaceAllCycle,
+              &StringTest::replaceAllMultiple,
+              &StringTest::replaceAllMultipleLongestMatch,
+              &StringTest::replaceAllMultipleNotFound,
+              &StringTest::replaceAllMultipleEmptySearch,
+              &StringTest::replaceAllMultipleEmptyReplace,
+              &StringTest::replaceAllMultipleSwap});
+
+    addBenchmarks({&StringTest::benchmarkReplaceAllSequential,
+                   &StringTest::benchmarkReplaceAllMultiple,
+                   &StringTest::benchmarkLowercaseInPlace,
+                   &StringTest::benchmarkLowercaseStl,
+                   &StringTest::benchmarkTrim,
+                   &StringTest::benchmarkSplitWithoutEmptyParts}, 10);
 }
 
 void StringTest::fromArray() {
@@ -393,6 +430,84 @@ void StringTest::uppercase() {
     CORRADE_COMPARE(String::uppercase("ěščřžýáíéúůďťň"), "ĚŠČŘŽÝÁÍÉÚŮĎŤŇ");
 }
 
+void StringTest::lowercaseUppercaseInPlace() {
+    /* Various sizes to go through the vectorized code as well as the
+       remaining bytes */
+    const std::string mixed = "Hello, World! 0123 ÁbCd ~[]`@{} The Quick Brown Fox Jumps Over The Lazy Dog";
+    for(std::size_t size = 0; size <= mixed.size(); ++size) {
+        std::string expectedLower, expectedUpper;
+        for(const char c: mixed.substr(0, size)) {
+            expectedLower += c >= 'A' && c <= 'Z' ? char(c + 32) : c;
+            expectedUpper += c >= 'a' && c <= 'z' ? char(c - 32) : c;
+        }
+
+        std::string lower = mixed.substr(0, size);
+        String::lowercaseInPlace({&lower[0], lower.size()});
+        CORRADE_COMPARE(lower, expectedLower);
+
+        std::string upper = mixed.substr(0, size);
+        String::uppercaseInPlace({&upper[0], upper.size()});
+        CORRADE_COMPARE(upper, expectedUpper);
+    }
+
+    /* Bytes around the view are untouched */
+    char data[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZABCDEFGHIJ";
+    String::lowercaseInPlace(Containers::arrayView(data).slice(1, 34));
+    CORRADE_COMPARE(data, Containers::StringView{"AbcdefghijklmnopqrstuvwxyzabcdefghIJ"});
+
+    /* Empty view shouldn't crash */
+    String::lowercaseInPlace(nullptr);
+    String::uppercaseInPlace(nullptr);
+}
+
+void StringTest::lowercaseUppercaseInPlaceAllBytes() {
+    char data[256];
+    for(std::size_t i = 0; i != 256; ++i) data[i] = char(i);
+
+    char lower[256];
+    std::memcpy(lower, data, 256);
+    String::lowercaseInPlace(lower);
+    char upper[256];
+    std::memcpy(upper, data, 256);
+    String::uppercaseInPlace(upper);
+
+    for(std::size_t i = 0; i != 256; ++i) {
+        CORRADE_COMPARE(int(std::uint8_t(lower[i])), i >= 'A' && i <= 'Z' ? i + 32 : i);
+        CORRADE_COMPARE(int(std::uint8_t(upper[i])), i >= 'a' && i <= 'z' ? i - 32 : i);
+    }
+}
+
+void StringTest::caseInsensitiveEquals() {
+    CORRADE_VERIFY(String::caseInsensitiveEquals("", ""));
+    CORRADE_VERIFY(String::caseInsensitiveEquals("hello", "HeLLo"));
+    CORRADE_VERIFY(String::caseInsensitiveEquals("Config Key With Spaces 42", "config key with spaces 42"));
+    CORRADE_VERIFY(!String::caseInsensitiveEquals("hello", "hell"));
+    CORRADE_VERIFY(!String::caseInsensitiveEquals("hello", "hellp"));
+    /* Differs in the last word and in the remaining bytes */
+    CORRADE_VERIFY(!String::caseInsensitiveEquals("abcdefgz", "abcdefgy"));
+    CORRADE_VERIFY(!String::caseInsensitiveEquals("abcdefghz", "ABCDEFGHY"));
+
+    /* Only letters differ by the 0x20 bit */
+    CORRADE_VERIFY(!String::caseInsensitiveEquals("@[`{", "`{@["));
+    CORRADE_VERIFY(!String::caseInsensitiveEquals("1", "\x11"));
+
+    /* Non-ASCII has to match exactly */
+    CORRADE_VERIFY(String::caseInsensitiveEquals("Č", "Č"));
+    CORRADE_VERIFY(!String::caseInsensitiveEquals("č", "Č"));
+    CORRADE_VERIFY(!String::caseInsensitiveEquals("\xc1", "\xe1"));
+}
+
+void StringTest::caseInsensitiveHash() {
+    CORRADE_COMPARE(String::caseInsensitiveHash("hello"), String::caseInsensitiveHash("HELLO"));
+    CORRADE_COMPARE(String::caseInsensitiveHash("Config Key With Spaces 42"), String::caseInsensitiveHash("config key WITH spaces 42"));
+    CORRADE_VERIFY(String::caseInsensitiveHash("hello") != String::caseInsensitiveHash("hellp"));
+    CORRADE_VERIFY(String::caseInsensitiveHash("abcdefghi") != String::caseInsensitiveHash("abcdefghj"));
+
+    /* Trailing zero bytes shouldn't collide as the size is hashed as well */
+    CORRADE_VERIFY(String::caseInsensitiveHash("a") != String::caseInsensitiveHash({"a\0", 2}));
+    CORRADE_VERIFY(String::caseInsensitiveHash("") != String::caseInsensitiveHash({"\0", 1}));
+}
+
 void StringTest::beginsWith() {
     CORRADE_VERIFY(String::beginsWith("overcomplicated", "over"));
     CORRADE_VERIFY(String::beginsWith("overcomplicated", std::string{"over"}));
@@ -556,6 +671,182 @@ void StringTest::replaceAllCycle() {
         "la", "lala"), "lalalalalala");
 }
 
+void StringTest::replaceAllMultiple() {
+    CORRADE_COMPARE(String::replaceAll("#define A B\n#ifdef A\nvec4 a = B;\n#endif", {
+        {"A", "EXPLICIT_BINDING"},
+        {"B", "1"},
+        {"vec4", "highp vec4"}
+    }), "#define EXPLICIT_BINDING 1\n#ifdef EXPLICIT_BINDING\nhighp vec4 a = 1;\n#endif");
+
+    /* Matches at the very beginning and end, std::string replacements */
+    const std::string replacement = "yes";
+    const std::pair<Containers::StringView, Containers::StringView> replacements[]{
+        {"no", {replacement.data(), replacement.size()}},
+        {"!", "."}
+    };
+    CORRADE_COMPARE(String::replaceAll("no, no and no!", replacements),
+        "yes, yes and yes.");
+}
+
+void StringTest::replaceAllMultipleLongestMatch() {
+    /* The longest match wins regardless of order */
+    CORRADE_COMPARE(String::replaceAll("aaa ab abc", {
+        {"a", "1"},
+        {"abc", "3"},
+        {"ab", "2"}
+    }), "111 2 3");
+
+    /* Search string that's longer than the rest of the input */
+    CORRADE_COMPARE(String::replaceAll("xab", {
+        {"abc", "3"},
+        {"a", "1"}
+    }), "x1b");
+
+    /* Equal matches, the first one wins */
+    CORRADE_COMPARE(String::replaceAll("hello", {
+        {"ll", "LL"},
+        {"ll", "ww"}
+    }), "heLLo");
+}
+
+void StringTest::replaceAllMultipleNotFound() {
+    CORRADE_COMPARE(String::replaceAll("this part will not get replaced", {
+        {"will get", "got"},
+        {"X", "Y"}
+    }), "this part will not get replaced");
+    CORRADE_COMPARE(String::replaceAll("nothing to replace", {}),
+        "nothing to replace");
+    CORRADE_COMPARE(String::replaceAll("", {{"a", "b"}}), "");
+}
+
+void StringTest::replaceAllMultipleEmptySearch() {
+    std::ostringstream out;
+    Error redirectOutput{&out};
+    String::replaceAll("this completely messed up", {
+        {"this", "that"},
+        {"", "got "}
+    });
+    CORRADE_COMPARE(out.str(), "Utility::String::replaceAll(): empty search string would cause an infinite loop\n");
+}
+
+void StringTest::replaceAllMultipleEmptyReplace() {
+    CORRADE_COMPARE(String::replaceAll("lalalalala!", {
+        {"la", ""},
+        {"!", nullptr}
+    }), "");
+}
+
+void StringTest::replaceAllMultipleSwap() {
+    /* Replaced text isn't searched again */
+    CORRADE_COMPARE(String::replaceAll("abba", {
+        {"a", "b"},
+        {"b", "a"}
+    }), "baab");
+    CORRADE_COMPARE(String::replaceAll("lalala", {
+        {"la", "lala"}
+    }), "lalalalalala");
+}
+
+namespace {
+
+std::string shaderTemplate() {
+    std::string out;
+    for(std::size_t i = 0; i != 1000; ++i)
+        out += "uniform highp VEC_TYPE value_INDEX; /* COMMENT_TEXT */\n"
+               "#if defined(FEATURE_A) && FEATURE_B > 1\n"
+               "    result += texture(SAMPLER_NAME, coords*SCALE).CHANNELS;\n"
+               "#endif\n";
+    return out;
+}
+
+const std::pair<Containers::StringView, Containers::StringView> ShaderReplacements[]{
+    {"VEC_TYPE", "vec4"},
+    {"INDEX", "3"},
+    {"COMMENT_TEXT", "generated"},
+    {"FEATURE_A", "TEXTURED"},
+    {"FEATURE_B", "LAYER_COUNT"},
+    {"SAMPLER_NAME", "textureData"},
+    {"SCALE", "0.5"},
+    {"CHANNELS", "rgba"}
+};
+
+}
+
+void StringTest::benchmarkReplaceAllSequential() {
+    const std::string string = shaderTemplate();
+
+    std::string out;
+    CORRADE_BENCHMARK(5) {
+        out = string;
+        for(const std::pair<Containers::StringView, Containers::StringView>& replacement: ShaderReplacements)
+            out = String::Implementation::replaceAll(std::move(out), replacement.first, replacement.second);
+    }
+
+    CORRADE_COMPARE(out, String::replaceAll(string, ShaderReplacements));
+}
+
+void StringTest::benchmarkReplaceAllMultiple() {
+    const std::string string = shaderTemplate();
+
+    std::string out;
+    CORRADE_BENCHMARK(5)
+        out = String::replaceAll(string, ShaderReplacements);
+
+    CORRADE_COMPARE(out.size(), 145000);
+}
+
+void StringTest::benchmarkLowercaseInPlace() {
+    std::string string = shaderTemplate();
+
+    CORRADE_BENCHMARK(5) {
+        String::lowercaseInPlace({&string[0], string.size()});
+        String::uppercaseInPlace({&string[0], string.size()});
+    }
+
+    CORRADE_COMPARE(string, String::uppercase(shaderTemplate()));
+}
+
+void StringTest::benchmarkLowercaseStl() {
+    std::string string = shaderTemplate();
+
+    CORRADE_BENCHMARK(5) {
+        for(char& c: string) c = std::tolower(c);
+        for(char& c: string) c = std::toupper(c);
+    }
+
+    CORRADE_COMPARE(string, String::uppercase(shaderTemplate()));
+}
+
+void StringTest::benchmarkTrim() {
+    std::string string(4096, ' ');
+    string[2048] = 'x';
+
+    /* Counterpart to StringViewTest::benchmarkTrimmed(), to see the overhead
+       of the std::string copies */
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(100)
+        size += String::trim(string).size();
+
+    CORRADE_COMPARE(size, 100);
+}
+
+void StringTest::benchmarkSplitWithoutEmptyParts() {
+    std::string string;
+    for(std::size_t i = 0; i != 1000; ++i) {
+        string.append(i % 37, ' ');
+        string += "key = value";
+        string.append(i % 13, '\t');
+        string += '\n';
+    }
+
+    /* Counterpart to StringViewTest::benchmarkSplitWithoutEmptyParts() */
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(10)
+        count += String::splitWithoutEmptyParts(string).size();
+
+    CORRADE_COMPARE(count, 30000);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Corrade::Utility::Test::StringTest)
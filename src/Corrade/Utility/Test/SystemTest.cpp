@@ -23,7 +23,12 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <memory>
+#include <sstream>
+
 #include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Numeric.h"
+#include "Corrade/Utility/DebugStl.h"
 #include "Corrade/Utility/System.h"
 
 namespace Corrade { namespace Utility { namespace Test { namespace {
@@ -32,10 +37,40 @@ struct SystemTest: TestSuite::Tester {
     explicit SystemTest();
 
     void sleep();
+    void monotonicTime();
+    void sleepUntil();
+    void sleepUntilPast();
+    void waitUntil();
+    void yield();
+
+    void coreCount();
+    void cacheSize();
+    void numaNodeCount();
+    void threadAffinity();
+    void threadAffinityOutOfRange();
+
+    void residentMemory();
+    void pageFaultCount();
+    void allocatedMemory();
 };
 
 SystemTest::SystemTest() {
-    addTests({&SystemTest::sleep});
+    addTests({&SystemTest::sleep,
+              &SystemTest::monotonicTime,
+              &SystemTest::sleepUntil,
+              &SystemTest::sleepUntilPast,
+              &SystemTest::waitUntil,
+              &SystemTest::yield,
+
+              &SystemTest::coreCount,
+              &SystemTest::cacheSize,
+              &SystemTest::numaNodeCount,
+              &SystemTest::threadAffinity,
+              &SystemTest::threadAffinityOutOfRange,
+
+              &SystemTest::residentMemory,
+              &SystemTest::pageFaultCount,
+              &SystemTest::allocatedMemory});
 }
 
 void SystemTest::sleep() {
@@ -45,6 +80,168 @@ void SystemTest::sleep() {
     CORRADE_VERIFY(true);
 }
 
+void SystemTest::monotonicTime() {
+    const std::uint64_t a = System::monotonicTime();
+    const std::uint64_t b = System::monotonicTime();
+    CORRADE_COMPARE_AS(b, a, TestSuite::Compare::GreaterOrEqual);
+
+    System::sleep(2);
+    const std::uint64_t c = System::monotonicTime();
+    CORRADE_COMPARE_AS(c - b, std::uint64_t(2000000), TestSuite::Compare::GreaterOrEqual);
+}
+
+void SystemTest::sleepUntil() {
+    const std::uint64_t target = System::monotonicTime() + 3000000;
+    System::sleepUntil(target);
+    CORRADE_COMPARE_AS(System::monotonicTime(), target, TestSuite::Compare::GreaterOrEqual);
+}
+
+void SystemTest::sleepUntilPast() {
+    /* Should return immediately, not wrap around and sleep forever */
+    const std::uint64_t before = System::monotonicTime();
+    System::sleepUntil(before - 1000000);
+    System::waitUntil(before - 1000000);
+    System::sleepUntil(0);
+    System::waitUntil(0);
+    CORRADE_VERIFY(true);
+}
+
+void SystemTest::waitUntil() {
+    const std::uint64_t target = System::monotonicTime() + 3000000;
+    System::waitUntil(target);
+    const std::uint64_t after = System::monotonicTime();
+    CORRADE_COMPARE_AS(after, target, TestSuite::Compare::GreaterOrEqual);
+    /* Can't test the upper bound as the machine may be overloaded */
+}
+
+void SystemTest::yield() {
+    System::yield();
+
+    /* Just test that it doesn't crash, can't test much else */
+    CORRADE_VERIFY(true);
+}
+
+void SystemTest::coreCount() {
+    const std::size_t logical = System::logicalCoreCount();
+    const std::size_t physical = System::physicalCoreCount();
+    CORRADE_COMPARE_AS(logical, std::size_t(1), TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(physical, std::size_t(1), TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(physical, logical, TestSuite::Compare::LessOrEqual);
+}
+
+void SystemTest::cacheSize() {
+    const std::size_t l1 = System::cacheSize(1);
+    const std::size_t l2 = System::cacheSize(2);
+    const std::size_t l3 = System::cacheSize(3);
+
+    /* The sizes can't be queried everywhere (and VMs often don't report
+       them), so the only thing that's guaranteed is a nonexistent level */
+    CORRADE_COMPARE(System::cacheSize(0), 0);
+    CORRADE_COMPARE(System::cacheSize(100), 0);
+
+    /* If the cache levels are known, higher levels are not smaller */
+    if(l1 && l2) CORRADE_COMPARE_AS(l2, l1, TestSuite::Compare::GreaterOrEqual);
+    if(l2 && l3) CORRADE_COMPARE_AS(l3, l2, TestSuite::Compare::GreaterOrEqual);
+}
+
+void SystemTest::numaNodeCount() {
+    const std::size_t count = System::numaNodeCount();
+    CORRADE_COMPARE_AS(count, std::size_t(1), TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(count, System::logicalCoreCount(), TestSuite::Compare::LessOrEqual);
+}
+
+void SystemTest::threadAffinity() {
+    #if defined(CORRADE_TARGET_APPLE) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    CORRADE_VERIFY(!System::setThreadAffinity(0));
+    CORRADE_VERIFY(!System::resetThreadAffinity());
+    #else
+    /* The process may be restricted to a subset of cores, so core 0 isn't
+       guaranteed to be allowed. Try all of them and expect at least one to
+       succeed. */
+    bool set = false;
+    for(std::size_t i = 0; i != System::logicalCoreCount() && !set; ++i)
+        set = System::setThreadAffinity(i);
+    CORRADE_VERIFY(set);
+    CORRADE_VERIFY(System::resetThreadAffinity());
+    #endif
+}
+
+void SystemTest::threadAffinityOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const std::size_t count = System::logicalCoreCount();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    System::setThreadAffinity(count);
+    std::ostringstream expected;
+    Debug{&expected} << "Utility::System::setThreadAffinity(): core" << count << "out of range for" << count << "cores";
+    CORRADE_COMPARE(out.str(), expected.str());
+}
+
+void SystemTest::residentMemory() {
+    #ifdef CORRADE_TARGET_EMSCRIPTEN
+    CORRADE_SKIP("Not available on Emscripten.");
+    #endif
+
+    const std::size_t resident = System::residentMemory();
+    const std::size_t peak = System::peakResidentMemory();
+    CORRADE_VERIFY(resident);
+    CORRADE_VERIFY(peak);
+
+    /* Not comparing the peak against the current value, as on Linux the
+       peak is updated lazily and can be slightly smaller */
+
+    /* Touching a few megabytes should make the resident size grow, but the
+       allocator may be reusing memory that was resident already, so verify
+       only the peak */
+    {
+        std::unique_ptr<char[]> data{new char[8*1024*1024]};
+        /* Volatile so the compiler doesn't optimize the writes away */
+        volatile char* const touch = data.get();
+        for(std::size_t i = 0; i < 8*1024*1024; i += 4096)
+            touch[i] = char(i);
+        CORRADE_COMPARE_AS(System::peakResidentMemory(), std::size_t(8*1024*1024), TestSuite::Compare::GreaterOrEqual);
+    }
+}
+
+void SystemTest::pageFaultCount() {
+    #if defined(CORRADE_TARGET_EMSCRIPTEN)
+    CORRADE_SKIP("Not available on Emscripten.");
+    #endif
+
+    const std::uint64_t minor = System::minorPageFaultCount();
+    const std::uint64_t major = System::majorPageFaultCount();
+
+    /* Touching freshly mapped memory causes page faults. Allocating more than
+       the mmap threshold so the memory is guaranteed to be fresh. */
+    {
+        std::unique_ptr<char[]> data{new char[8*1024*1024]};
+        /* Volatile so the compiler doesn't optimize the writes away */
+        volatile char* const touch = data.get();
+        for(std::size_t i = 0; i < 8*1024*1024; i += 4096)
+            touch[i] = char(i);
+    }
+
+    CORRADE_COMPARE_AS(System::minorPageFaultCount(), minor, TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(System::majorPageFaultCount(), major, TestSuite::Compare::GreaterOrEqual);
+}
+
+void SystemTest::allocatedMemory() {
+    #if !(defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)) && !defined(CORRADE_TARGET_APPLE)
+    CORRADE_VERIFY(!System::allocatedMemory());
+    CORRADE_SKIP("Not available on this platform.");
+    #endif
+
+    const std::size_t before = System::allocatedMemory();
+    CORRADE_VERIFY(before);
+
+    std::unique_ptr<char[]> data{new char[1024*1024]};
+    CORRADE_COMPARE_AS(System::allocatedMemory(), before + 1024*1024, TestSuite::Compare::GreaterOrEqual);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Corrade::Utility::Test::SystemTest)
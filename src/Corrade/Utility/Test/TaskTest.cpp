@@ -0,0 +1,290 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Corrade/Corrade.h"
+
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/Utility/DebugStl.h"
+#include "Corrade/Utility/Task.h"
+
+namespace Corrade { namespace Utility { namespace Test { namespace {
+
+struct TaskTest: TestSuite::Tester {
+    explicit TaskTest();
+
+    void constructDefault();
+    void constructMove();
+
+    void start();
+    void startVoid();
+    void startEmpty();
+    void startTwice();
+
+    void await();
+    void awaitVoid();
+    void awaitNested();
+
+    void suspended();
+    void destroySuspended();
+
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    void resumeOn();
+    #endif
+};
+
+TaskTest::TaskTest() {
+    addTests({&TaskTest::constructDefault,
+              &TaskTest::constructMove,
+
+              &TaskTest::start,
+              &TaskTest::startVoid,
+              &TaskTest::startEmpty,
+              &TaskTest::startTwice,
+
+              &TaskTest::await,
+              &TaskTest::awaitVoid,
+              &TaskTest::awaitNested,
+
+              &TaskTest::suspended,
+              &TaskTest::destroySuspended,
+
+              #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+              &TaskTest::resumeOn
+              #endif
+              });
+}
+
+Task<int> answer() {
+    co_return 42;
+}
+
+Task<std::string> answerString() {
+    int a = co_await answer();
+    co_return std::to_string(a);
+}
+
+Task<void> increment(int& value) {
+    ++value;
+    co_return;
+}
+
+/* Suspends until resumed from outside */
+struct Trigger {
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) noexcept {
+        this->handle = handle;
+    }
+    void await_resume() const noexcept {}
+
+    std::coroutine_handle<> handle;
+};
+
+void TaskTest::constructDefault() {
+    Task<int> a;
+    CORRADE_VERIFY(!a);
+}
+
+void TaskTest::constructMove() {
+    Task<int> a = answer();
+    CORRADE_VERIFY(a);
+
+    Task<int> b = std::move(a);
+    CORRADE_VERIFY(!a);
+    CORRADE_VERIFY(b);
+
+    Task<int> c;
+    c = std::move(b);
+    CORRADE_VERIFY(!b);
+    CORRADE_VERIFY(c);
+
+    c.start();
+    CORRADE_VERIFY(c.isDone());
+    CORRADE_COMPARE(c.result(), 42);
+}
+
+void TaskTest::start() {
+    Task<int> a = answer();
+    /* The task is lazy */
+    CORRADE_VERIFY(!a.isDone());
+
+    a.start();
+    CORRADE_VERIFY(a.isDone());
+    CORRADE_COMPARE(a.result(), 42);
+}
+
+void TaskTest::startVoid() {
+    int value = 3;
+    Task<void> a = increment(value);
+    CORRADE_COMPARE(value, 3);
+
+    a.start();
+    CORRADE_VERIFY(a.isDone());
+    CORRADE_COMPARE(value, 4);
+}
+
+void TaskTest::startEmpty() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Task<int> a;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    a.isDone();
+    a.start();
+    CORRADE_COMPARE(out.str(),
+        "Utility::Task::isDone(): the task is empty\n"
+        "Utility::Task::start(): the task is empty\n");
+}
+
+void TaskTest::startTwice() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Task<int> a = answer();
+    a.start();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    a.start();
+    CORRADE_COMPARE(out.str(), "Utility::Task::start(): the task was already started\n");
+}
+
+void TaskTest::await() {
+    Task<std::string> a = answerString();
+    a.start();
+    CORRADE_VERIFY(a.isDone());
+    CORRADE_COMPARE(a.result(), "42");
+}
+
+void TaskTest::awaitVoid() {
+    int value = 0;
+    Task<int> a = [](int& value) -> Task<int> {
+        co_await increment(value);
+        co_await increment(value);
+        co_return value*10;
+    }(value);
+    a.start();
+    CORRADE_VERIFY(a.isDone());
+    CORRADE_COMPARE(value, 2);
+    CORRADE_COMPARE(a.result(), 20);
+}
+
+Task<int> sum(int depth) {
+    if(!depth) co_return 0;
+    co_return depth + co_await sum(depth - 1);
+}
+
+void TaskTest::awaitNested() {
+    /* Deep enough to blow up the stack without symmetric transfer */
+    Task<int> a = sum(10000);
+    a.start();
+    CORRADE_VERIFY(a.isDone());
+    CORRADE_COMPARE(a.result(), 50005000);
+}
+
+Task<int> waitForTrigger(Trigger& trigger) {
+    co_await trigger;
+    co_return 1337;
+}
+
+void TaskTest::suspended() {
+    Trigger trigger;
+    Task<int> a = [](Trigger& trigger) -> Task<int> {
+        co_return co_await waitForTrigger(trigger) + 1;
+    }(trigger);
+
+    a.start();
+    CORRADE_VERIFY(!a.isDone());
+    CORRADE_VERIFY(trigger.handle);
+
+    /* Resuming the innermost coroutine continues in the outer one once the
+       inner finishes */
+    trigger.handle.resume();
+    CORRADE_VERIFY(a.isDone());
+    CORRADE_COMPARE(a.result(), 1338);
+}
+
+struct Destructible {
+    explicit Destructible(int& destructed): destructed{destructed} {}
+    ~Destructible() { ++destructed; }
+    int& destructed;
+};
+
+void TaskTest::destroySuspended() {
+    int destructed = 0;
+    Trigger trigger;
+    {
+        Task<void> a = [](int& destructed, Trigger& trigger) -> Task<void> {
+            Destructible d{destructed};
+            co_await trigger;
+        }(destructed, trigger);
+
+        a.start();
+        CORRADE_VERIFY(!a.isDone());
+        CORRADE_COMPARE(destructed, 0);
+    }
+
+    /* Destroying the task destroyed the suspended coroutine and its locals */
+    CORRADE_COMPARE(destructed, 1);
+}
+
+#if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+void TaskTest::resumeOn() {
+    ThreadPool pool{2};
+    int values[4]{};
+    Task<int> tasks[4];
+    {
+        ThreadPool::TaskGroup group{pool};
+        for(int i = 0; i != 4; ++i) {
+            tasks[i] = [](ThreadPool::TaskGroup& group, int& value, int i) -> Task<int> {
+                co_await Utility::resumeOn(group);
+                value = i*i;
+                co_return i + 1;
+            }(group, values[i], i);
+            tasks[i].start();
+        }
+
+        /* All tasks are suspended until the group gets to them */
+        group.wait();
+    }
+
+    for(int i = 0; i != 4; ++i) {
+        CORRADE_VERIFY(tasks[i].isDone());
+        CORRADE_COMPARE(tasks[i].result(), i + 1);
+        CORRADE_COMPARE(values[i], i*i);
+    }
+}
+#endif
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Utility::Test::TaskTest)
@@ -0,0 +1,363 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <atomic>
+#include <cmath>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "Corrade/Containers/StridedArrayView.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Container.h"
+#include "Corrade/Utility/Algorithms.h"
+#include "Corrade/Utility/DebugStl.h"
+#include "Corrade/Utility/FormatStl.h"
+#include "Corrade/Utility/ThreadPool.h"
+
+namespace Corrade { namespace Utility { namespace Test { namespace {
+
+struct ThreadPoolTest: TestSuite::Tester {
+    explicit ThreadPoolTest();
+
+    void construct();
+    void constructDefault();
+    void constructExternal();
+    void constructExternalNull();
+
+    void parallelFor();
+    void parallelForEmpty();
+    void parallelForFunctionPointer();
+    void parallelForNested();
+    void parallelForFromMultipleThreads();
+
+    void taskGroup();
+    void taskGroupNested();
+    void taskGroupWaitOnDestruction();
+
+    void execute();
+
+    void benchmarkSerial();
+    void benchmarkParallelFor();
+};
+
+const struct {
+    const char* name;
+    std::size_t threadCount;
+    bool external;
+} PoolData[]{
+    {"no threads", 0, false},
+    {"one thread", 1, false},
+    {"four threads", 4, false},
+    {"external executor", 0, true}
+};
+
+const struct {
+    const char* name;
+    std::size_t count, grainSize;
+} ParallelForData[]{
+    {"single item", 1, 1},
+    {"grain size 1", 1000, 1},
+    {"grain size 7", 1000, 7},
+    {"grain size larger than count", 1000, 5000},
+    {"automatic grain size", 100001, 0}
+};
+
+ThreadPoolTest::ThreadPoolTest() {
+    addTests({&ThreadPoolTest::construct,
+              &ThreadPoolTest::constructDefault,
+              &ThreadPoolTest::constructExternal,
+              &ThreadPoolTest::constructExternalNull});
+
+    addInstancedTests({&ThreadPoolTest::parallelFor},
+        Containers::arraySize(PoolData)*Containers::arraySize(ParallelForData));
+
+    addInstancedTests({&ThreadPoolTest::parallelForEmpty,
+                       &ThreadPoolTest::parallelForFunctionPointer,
+                       &ThreadPoolTest::parallelForNested,
+                       &ThreadPoolTest::parallelForFromMultipleThreads,
+                       &ThreadPoolTest::taskGroup,
+                       &ThreadPoolTest::taskGroupNested,
+                       &ThreadPoolTest::taskGroupWaitOnDestruction,
+                       &ThreadPoolTest::execute},
+        Containers::arraySize(PoolData));
+
+    addBenchmarks({&ThreadPoolTest::benchmarkSerial,
+                   &ThreadPoolTest::benchmarkParallelFor}, 10);
+}
+
+/* Runs the jobs serially, counting how many times it was called */
+void serialExecutor(void* state, std::size_t count, void(*job)(void*, std::size_t), void* jobState) {
+    ++*static_cast<std::size_t*>(state);
+    for(std::size_t i = 0; i != count; ++i) job(jobState, i);
+}
+
+/* Has to be kept alive for the whole lifetime of the pools */
+std::size_t serialExecutorCallCount = 0;
+
+template<class T> Containers::Pointer<ThreadPool> createPool(const T& data) {
+    if(data.external)
+        return Containers::pointer<ThreadPool>(serialExecutor, &serialExecutorCallCount, std::size_t{4});
+    return Containers::pointer<ThreadPool>(data.threadCount);
+}
+
+void ThreadPoolTest::construct() {
+    ThreadPool pool{3};
+    CORRADE_COMPARE(pool.threadCount(), 3);
+    CORRADE_COMPARE(pool.jobCount(), 4);
+
+    CORRADE_VERIFY(!std::is_copy_constructible<ThreadPool>::value);
+    CORRADE_VERIFY(!std::is_move_constructible<ThreadPool>::value);
+    CORRADE_VERIFY(!std::is_copy_assignable<ThreadPool>::value);
+    CORRADE_VERIFY(!std::is_move_assignable<ThreadPool>::value);
+}
+
+void ThreadPoolTest::constructDefault() {
+    ThreadPool pool;
+    const std::size_t expected = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() - 1 : 0;
+    CORRADE_COMPARE(pool.threadCount(), expected);
+    CORRADE_COMPARE(pool.jobCount(), expected + 1);
+}
+
+void ThreadPoolTest::constructExternal() {
+    std::size_t calls = 0;
+    ThreadPool pool{serialExecutor, &calls, 6};
+    CORRADE_COMPARE(pool.threadCount(), 0);
+    CORRADE_COMPARE(pool.jobCount(), 6);
+
+    /* The range should be split and passed to the executor in one call */
+    std::vector<int> counts(100);
+    pool.parallelFor(counts.size(), 8, [&](std::size_t begin, std::size_t end) {
+        CORRADE_VERIFY(end - begin <= 8);
+        for(std::size_t i = begin; i != end; ++i) ++counts[i];
+    });
+    CORRADE_COMPARE(calls, 1);
+    CORRADE_COMPARE_AS(counts,
+        std::vector<int>(100, 1),
+        TestSuite::Compare::Container);
+}
+
+void ThreadPoolTest::constructExternalNull() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        ThreadPool pool{nullptr, nullptr, 4};
+    }
+    CORRADE_COMPARE(out.str(), "Utility::ThreadPool: executor expected to be non-null\n");
+}
+
+void ThreadPoolTest::parallelFor() {
+    auto&& poolData = PoolData[testCaseInstanceId()/Containers::arraySize(ParallelForData)];
+    auto&& data = ParallelForData[testCaseInstanceId()%Containers::arraySize(ParallelForData)];
+    setTestCaseDescription(Utility::formatString("{}, {}", poolData.name, data.name));
+
+    Containers::Pointer<ThreadPool> pool = createPool(poolData);
+
+    /* Every index should be visited exactly once, each part should respect
+       the grain size */
+    std::vector<std::atomic<int>> counts(data.count);
+    std::atomic<bool> grainSizeRespected{true};
+    pool->parallelFor(data.count, data.grainSize, [&](std::size_t begin, std::size_t end) {
+        if(begin >= end || (data.grainSize && end - begin > data.grainSize))
+            grainSizeRespected = false;
+        for(std::size_t i = begin; i != end; ++i) ++counts[i];
+    });
+
+    CORRADE_VERIFY(grainSizeRespected);
+    std::size_t notOnce = 0;
+    for(const std::atomic<int>& i: counts) if(i != 1) ++notOnce;
+    CORRADE_COMPARE(notOnce, 0);
+}
+
+void ThreadPoolTest::parallelForEmpty() {
+    auto&& data = PoolData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<ThreadPool> pool = createPool(data);
+
+    int calls = 0;
+    pool->parallelFor(0, 1, [&](std::size_t, std::size_t) { ++calls; });
+    CORRADE_COMPARE(calls, 0);
+}
+
+void ThreadPoolTest::parallelForFunctionPointer() {
+    auto&& data = PoolData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<ThreadPool> pool = createPool(data);
+
+    std::atomic<std::size_t> sum{0};
+    pool->parallelFor(1000, 10, [](void* state, std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i)
+            *static_cast<std::atomic<std::size_t>*>(state) += i;
+    }, &sum);
+    CORRADE_COMPARE(sum, 999*1000/2);
+}
+
+void ThreadPoolTest::parallelForNested() {
+    auto&& data = PoolData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<ThreadPool> pool = createPool(data);
+
+    /* Waiting from inside a task shouldn't deadlock even with a single
+       thread */
+    std::atomic<std::size_t> sum{0};
+    pool->parallelFor(16, 1, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i)
+            pool->parallelFor(100, 3, [&](std::size_t innerBegin, std::size_t innerEnd) {
+                for(std::size_t j = innerBegin; j != innerEnd; ++j)
+                    sum += i*100 + j;
+            });
+    });
+    CORRADE_COMPARE(sum, 1599*1600/2);
+}
+
+void ThreadPoolTest::parallelForFromMultipleThreads() {
+    auto&& data = PoolData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<ThreadPool> pool = createPool(data);
+
+    /* The external executor here isn't thread-safe */
+    if(data.external)
+        CORRADE_SKIP("Not applicable to the test executor.");
+
+    std::atomic<std::size_t> sum{0};
+    std::vector<std::thread> threads;
+    for(std::size_t t = 0; t != 4; ++t) threads.emplace_back([&]{
+        pool->parallelFor(1000, 5, [&](std::size_t begin, std::size_t end) {
+            for(std::size_t i = begin; i != end; ++i) sum += i;
+        });
+    });
+    for(std::thread& thread: threads) thread.join();
+    CORRADE_COMPARE(sum, 4*999*1000/2);
+}
+
+void ThreadPoolTest::taskGroup() {
+    auto&& data = PoolData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<ThreadPool> pool = createPool(data);
+
+    std::atomic<int> a{0}, b{0};
+    auto incrementA = [&]{ ++a; };
+    auto incrementB = [&]{ b += 10; };
+
+    ThreadPool::TaskGroup group{*pool};
+    for(std::size_t i = 0; i != 50; ++i) {
+        group.run(incrementA);
+        group.run(incrementB);
+    }
+    group.wait();
+    CORRADE_COMPARE(a, 50);
+    CORRADE_COMPARE(b, 500);
+
+    /* The group can be reused after a wait */
+    group.run(incrementA);
+    group.wait();
+    CORRADE_COMPARE(a, 51);
+}
+
+void ThreadPoolTest::taskGroupNested() {
+    auto&& data = PoolData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<ThreadPool> pool = createPool(data);
+
+    /* Tasks adding more tasks to the same group */
+    std::atomic<int> count{0};
+    ThreadPool::TaskGroup group{*pool};
+    auto leaf = [&]{ ++count; };
+    auto spawn = [&]{
+        for(std::size_t i = 0; i != 10; ++i) group.run(leaf);
+    };
+    for(std::size_t i = 0; i != 10; ++i) group.run(spawn);
+    group.wait();
+    CORRADE_COMPARE(count, 100);
+}
+
+void ThreadPoolTest::taskGroupWaitOnDestruction() {
+    auto&& data = PoolData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<ThreadPool> pool = createPool(data);
+
+    std::atomic<int> count{0};
+    auto increment = [&]{ ++count; };
+    {
+        ThreadPool::TaskGroup group{*pool};
+        for(std::size_t i = 0; i != 20; ++i) group.run(increment);
+    }
+    CORRADE_COMPARE(count, 20);
+}
+
+void ThreadPoolTest::execute() {
+    auto&& data = PoolData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<ThreadPool> pool = createPool(data);
+
+    Containers::Array<int> src{100000}, dst{100000};
+    for(std::size_t i = 0; i != src.size(); ++i) src[i] = int(i);
+
+    /* Threshold set to zero so the parallel path is used every time */
+    Utility::copy(src, dst, ThreadPool::execute, pool.get(), pool->jobCount(), 0);
+    CORRADE_COMPARE_AS(dst, src, TestSuite::Compare::Container);
+}
+
+constexpr std::size_t BenchmarkSize = 1 << 22;
+
+void ThreadPoolTest::benchmarkSerial() {
+    std::vector<float> data(BenchmarkSize, 1.5f);
+
+    CORRADE_BENCHMARK(1) {
+        for(float& i: data) i = std::sqrt(i*i + 1.0f);
+    }
+
+    CORRADE_VERIFY(data[0] > 1.5f);
+}
+
+void ThreadPoolTest::benchmarkParallelFor() {
+    ThreadPool pool;
+    std::vector<float> data(BenchmarkSize, 1.5f);
+
+    CORRADE_BENCHMARK(1) {
+        pool.parallelFor(data.size(), 0, [&](std::size_t begin, std::size_t end) {
+            for(std::size_t i = begin; i != end; ++i)
+                data[i] = std::sqrt(data[i]*data[i] + 1.0f);
+        });
+    }
+
+    CORRADE_VERIFY(data[0] > 1.5f);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Utility::Test::ThreadPoolTest)
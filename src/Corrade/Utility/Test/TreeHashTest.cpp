@@ -0,0 +1,241 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+    Copyright © 2019 Jonathan Hale <squareys@googlemail.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#include <vector>
+#endif
+
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/Utility/DebugStl.h"
+#include "Corrade/Utility/Sha1.h"
+#include "Corrade/Utility/TreeHash.h"
+#include "Corrade/Utility/XxHash3.h"
+
+namespace Corrade { namespace Utility { namespace Test { namespace {
+
+struct TreeHashTest: TestSuite::Tester {
+    explicit TreeHashTest();
+
+    void empty();
+    void singleChunk();
+    void tree();
+
+    void parallel();
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    void parallelThreads();
+    #endif
+
+    void zeroChunkSize();
+
+    void benchmarkXxHash3();
+    void benchmarkSerial();
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    void benchmarkThreads();
+    #endif
+};
+
+const struct {
+    const char* name;
+    std::size_t jobCount, expectedCalls, expectedJobs;
+} ParallelData[]{
+    {"one job", 1, 0, 0},
+    {"two jobs", 2, 1, 2},
+    {"three jobs", 3, 1, 3},
+    /* 37 chunks, 4 per job, so just 10 jobs */
+    {"twelve jobs", 12, 1, 10},
+    {"more jobs than chunks", 100, 1, 37}
+};
+
+TreeHashTest::TreeHashTest() {
+    addTests({&TreeHashTest::empty,
+              &TreeHashTest::singleChunk,
+              &TreeHashTest::tree});
+
+    addInstancedTests({&TreeHashTest::parallel},
+        Containers::arraySize(ParallelData));
+
+    addTests({
+        #ifndef CORRADE_TARGET_EMSCRIPTEN
+        &TreeHashTest::parallelThreads,
+        #endif
+
+        &TreeHashTest::zeroChunkSize});
+
+    addBenchmarks({&TreeHashTest::benchmarkXxHash3,
+                   &TreeHashTest::benchmarkSerial,
+                   #ifndef CORRADE_TARGET_EMSCRIPTEN
+                   &TreeHashTest::benchmarkThreads
+                   #endif
+                   }, 10);
+}
+
+Containers::Array<char> makeData(std::size_t size) {
+    Containers::Array<char> data{Containers::NoInit, size};
+    for(std::size_t i = 0; i != size; ++i)
+        data[i] = char(i*7 + i/13);
+    return data;
+}
+
+void TreeHashTest::empty() {
+    /* A single empty chunk */
+    CORRADE_COMPARE(treeHash<Sha1>({}), Sha1::digest(std::string{"\0", 1}));
+    CORRADE_COMPARE(treeHash<Sha1>({}, 16), Sha1::digest(std::string{"\0", 1}));
+}
+
+void TreeHashTest::singleChunk() {
+    /* Data fitting into one chunk are hashed with a zero byte prepended */
+    CORRADE_COMPARE(treeHash<Sha1>(Containers::arrayView("hello", 5), 5),
+        Sha1::digest(std::string{"\0hello", 6}));
+    CORRADE_COMPARE(treeHash<Sha1>(Containers::arrayView("hello", 5)),
+        Sha1::digest(std::string{"\0hello", 6}));
+}
+
+void TreeHashTest::tree() {
+    const auto leaf = [](const std::string& data) {
+        return Sha1::digest('\x00' + data);
+    };
+    const auto node = [](const Sha1::Digest& a, const Sha1::Digest& b) {
+        return Sha1::digest('\x01' +
+            std::string{a.byteArray(), Sha1::DigestSize} +
+            std::string{b.byteArray(), Sha1::DigestSize});
+    };
+
+    /* Five chunks, the last one shorter. On the first level the fifth
+       chunk is passed unchanged, on the second as well. */
+    const Sha1::Digest l0 = leaf("abcd");
+    const Sha1::Digest l1 = leaf("efgh");
+    const Sha1::Digest l2 = leaf("ijkl");
+    const Sha1::Digest l3 = leaf("mnop");
+    const Sha1::Digest l4 = leaf("qr");
+    CORRADE_COMPARE(treeHash<Sha1>(Containers::arrayView("abcdefghijklmnopqr", 18), 4),
+        node(node(node(l0, l1), node(l2, l3)), l4));
+
+    /* Three chunks */
+    CORRADE_COMPARE(treeHash<Sha1>(Containers::arrayView("abcdefghijkl", 12), 4),
+        node(node(l0, l1), l2));
+
+    /* Different chunk size gives a different result */
+    CORRADE_VERIFY(treeHash<Sha1>(Containers::arrayView("abcdefghijkl", 12), 4) !=
+        treeHash<Sha1>(Containers::arrayView("abcdefghijkl", 12), 3));
+}
+
+struct SerialExecutorState {
+    std::size_t calls, jobs;
+};
+
+/* Executes the jobs in reverse order to verify they don't depend on each
+   other */
+void serialExecutor(void* executorState, std::size_t count, void(*job)(void*, std::size_t), void* jobState) {
+    auto& state = *static_cast<SerialExecutorState*>(executorState);
+    ++state.calls;
+    state.jobs += count;
+    for(std::size_t i = count; i != 0; --i) job(jobState, i - 1);
+}
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+void threadExecutor(void*, std::size_t count, void(*job)(void*, std::size_t), void* jobState) {
+    std::vector<std::thread> threads;
+    for(std::size_t i = 0; i != count; ++i)
+        threads.emplace_back(job, jobState, i);
+    for(std::thread& thread: threads) thread.join();
+}
+#endif
+
+void TreeHashTest::parallel() {
+    auto&& data = ParallelData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* 37 chunks, the last one shorter */
+    const Containers::Array<char> input = makeData(36*100 + 17);
+    const XxHash3<16>::Digest expected = treeHash<XxHash3<16>>(input, 100);
+
+    SerialExecutorState state{};
+    CORRADE_COMPARE(treeHash<XxHash3<16>>(input, serialExecutor, &state, data.jobCount, 100), expected);
+    CORRADE_COMPARE(state.calls, data.expectedCalls);
+    CORRADE_COMPARE(state.jobs, data.expectedJobs);
+}
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+void TreeHashTest::parallelThreads() {
+    const Containers::Array<char> input = makeData(1000*1000);
+    const Sha1::Digest expected = treeHash<Sha1>(input, 4096);
+    CORRADE_COMPARE(treeHash<Sha1>(input, threadExecutor, nullptr, 4, 4096), expected);
+    CORRADE_COMPARE(treeHash<Sha1>(input, threadExecutor, nullptr, 16, 4096), expected);
+}
+#endif
+
+void TreeHashTest::zeroChunkSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    treeHash<Sha1>(Containers::arrayView("hello", 5), 0);
+    CORRADE_COMPARE(out.str(), "Utility::treeHash(): chunk size can't be zero\n");
+}
+
+/* Compared to XxHash3 directly to see the overhead of the tree */
+constexpr std::size_t BenchmarkSize = 16*1024*1024;
+
+void TreeHashTest::benchmarkXxHash3() {
+    const Containers::Array<char> input = makeData(BenchmarkSize);
+
+    XxHash3<16>::Digest digest;
+    CORRADE_BENCHMARK(1)
+        digest = (XxHash3<16>{} << Containers::arrayView(input)).digest();
+
+    CORRADE_VERIFY(digest != XxHash3<16>::Digest{});
+}
+
+void TreeHashTest::benchmarkSerial() {
+    const Containers::Array<char> input = makeData(BenchmarkSize);
+
+    XxHash3<16>::Digest digest;
+    CORRADE_BENCHMARK(1)
+        digest = treeHash<XxHash3<16>>(input);
+
+    CORRADE_VERIFY(digest != XxHash3<16>::Digest{});
+}
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+void TreeHashTest::benchmarkThreads() {
+    const Containers::Array<char> input = makeData(BenchmarkSize);
+
+    XxHash3<16>::Digest digest;
+    CORRADE_BENCHMARK(1)
+        digest = treeHash<XxHash3<16>>(input, threadExecutor, nullptr, std::thread::hardware_concurrency());
+
+    CORRADE_VERIFY(digest != XxHash3<16>::Digest{});
+}
+#endif
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Utility::Test::TreeHashTest)
@@ -24,6 +24,9 @@
 */
 
 #include <sstream>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
 
 #include "Corrade/TestSuite/Tester.h"
 #include "Corrade/Utility/DebugStl.h" /** @todo remove when <sstream> is gone */
@@ -49,10 +52,17 @@ struct TweakableTest: TestSuite::Tester {
 
     void parseTweakables();
     void parseTweakablesError();
+    void parseTweakablesCached();
+    void parseTweakablesCachedLinesChanged();
+    void parseTweakablesCachedNewVariable();
 
     void parseSpecials();
     void parseSpecialsError();
 
+    void value();
+    void valueMultithreaded();
+    void readMultithreaded();
+
     void benchmarkBase();
     void benchmarkDisabled();
     void benchmarkEnabled();
@@ -192,7 +202,10 @@ TweakableTest::TweakableTest() {
         Containers::arraySize(TweakableAliasData));
 
     addTests({&TweakableTest::findTweakableAliasDefinedEmpty,
-              &TweakableTest::parseTweakables});
+              &TweakableTest::parseTweakables,
+              &TweakableTest::parseTweakablesCached,
+              &TweakableTest::parseTweakablesCachedLinesChanged,
+              &TweakableTest::parseTweakablesCachedNewVariable});
 
     addInstancedTests({&TweakableTest::parseTweakablesError},
         Containers::arraySize(ParseErrorData));
@@ -203,6 +216,10 @@ TweakableTest::TweakableTest() {
     addInstancedTests({&TweakableTest::parseSpecialsError},
         Containers::arraySize(ParseSpecialsErrorData));
 
+    addTests({&TweakableTest::value,
+              &TweakableTest::valueMultithreaded,
+              &TweakableTest::readMultithreaded});
+
     addBenchmarks({&TweakableTest::benchmarkBase,
                    &TweakableTest::benchmarkDisabled,
                    &TweakableTest::benchmarkEnabled}, 200);
@@ -283,7 +300,7 @@ _('\'') // also no parser
         std::ostringstream out;
         Debug redirectOutput{&out};
         Warning redirectWarning{&out};
-        std::set<std::tuple<void(*)(void(*)(), void*), void(*)(), void*>> scopes;
+        std::vector<Implementation::TweakableScope> scopes;
         TweakableState state = Implementation::parseTweakables("_", "a.cpp", data, variables, scopes);
         CORRADE_COMPARE(out.str(),
             "Utility::Tweakable::update(): updating _( 3) in a.cpp:3\n"
@@ -294,7 +311,7 @@ _('\'') // also no parser
             "Utility::Tweakable::update(): ignoring unknown new value _('\\'') in a.cpp:13\n");
         CORRADE_COMPARE(state, TweakableState::Success);
         CORRADE_COMPARE(scopes.size(), 1);
-        CORRADE_VERIFY(std::get<0>(*scopes.begin()) == lambda2);
+        CORRADE_VERIFY(std::get<0>(scopes.front()) == lambda2);
     }
     CORRADE_COMPARE(*reinterpret_cast<int*>(variables[0].storage), 3);
     CORRADE_COMPARE(*reinterpret_cast<float*>(variables[1].storage), 4.0f);
@@ -305,7 +322,7 @@ _('\'') // also no parser
     /* Second pass should report no change */
     {
         std::ostringstream out;
-        std::set<std::tuple<void(*)(void(*)(), void*), void(*)(), void*>> scopes;
+        std::vector<Implementation::TweakableScope> scopes;
         Debug redirectOutput{&out};
         Warning redirectWarning{&out};
         TweakableState state = Implementation::parseTweakables("_", "a.cpp", data, variables, scopes);
@@ -333,13 +350,165 @@ void TweakableTest::parseTweakablesError() {
         std::ostringstream out;
         Warning redirectWarning{&out};
         Error redirectError{&out};
-        std::set<std::tuple<void(*)(void(*)(), void*), void(*)(), void*>> scopes;
+        std::vector<Implementation::TweakableScope> scopes;
         TweakableState state = Implementation::parseTweakables("_", "a.cpp", data.data, variables, scopes);
         CORRADE_COMPARE(out.str(), data.error);
         CORRADE_COMPARE(state, data.state);
     }
 }
 
+void TweakableTest::parseTweakablesCached() {
+    std::vector<Implementation::TweakableVariable> variables{4};
+    variables[0].line = 1;
+    variables[0].parser = Implementation::TweakableTraits<int>::parse;
+    variables[1].line = 3;
+    variables[1].parser = Implementation::TweakableTraits<int>::parse;
+    variables[2].line = 4;
+    variables[2].parser = nullptr; /* doesn't have a parser */
+    variables[3].line = 6;
+    variables[3].parser = Implementation::TweakableTraits<int>::parse;
+
+    Implementation::TweakableParseCache cache;
+    {
+        std::ostringstream out;
+        Debug redirectOutput{&out};
+        Warning redirectWarning{&out};
+        std::vector<Implementation::TweakableScope> scopes;
+        TweakableState state = Implementation::parseTweakables("_", "a.cpp", "_(1);\n/* _(0) */\nfoo(_(2));\n_(\"no parser\")\n\n_(3);\n", variables, scopes, &cache);
+        CORRADE_COMPARE(out.str(),
+            "Utility::Tweakable::update(): updating _(1) in a.cpp:1\n"
+            "Utility::Tweakable::update(): updating _(2) in a.cpp:3\n"
+            "Utility::Tweakable::update(): ignoring unknown new value _(\"no parser\") in a.cpp:4\n"
+            "Utility::Tweakable::update(): updating _(3) in a.cpp:6\n");
+        CORRADE_COMPARE(state, TweakableState::Success);
+        CORRADE_COMPARE(cache.annotations.size(), 4);
+    }
+
+    /* Same contents, nothing gets parsed */
+    {
+        std::ostringstream out;
+        Debug redirectOutput{&out};
+        Warning redirectWarning{&out};
+        std::vector<Implementation::TweakableScope> scopes;
+        TweakableState state = Implementation::parseTweakables("_", "a.cpp", "_(1);\n/* _(0) */\nfoo(_(2));\n_(\"no parser\")\n\n_(3);\n", variables, scopes, &cache);
+        CORRADE_COMPARE(out.str(), "");
+        CORRADE_COMPARE(state, TweakableState::NoChange);
+    }
+
+    /* Changing the second value reparses only that one, the unknown value
+       after isn't reported again. The value is longer, so the positions of
+       the rest shift. */
+    {
+        std::ostringstream out;
+        Debug redirectOutput{&out};
+        Warning redirectWarning{&out};
+        std::vector<Implementation::TweakableScope> scopes;
+        TweakableState state = Implementation::parseTweakables("_", "a.cpp", "_(1);\n/* _(0) */\nfoo(_(2000));\n_(\"no parser\")\n\n_(3);\n", variables, scopes, &cache);
+        CORRADE_COMPARE(out.str(),
+            "Utility::Tweakable::update(): updating _(2000) in a.cpp:3\n");
+        CORRADE_COMPARE(state, TweakableState::Success);
+        CORRADE_COMPARE(cache.annotations.size(), 4);
+    }
+    CORRADE_COMPARE(*reinterpret_cast<int*>(variables[0].storage), 1);
+    CORRADE_COMPARE(*reinterpret_cast<int*>(variables[1].storage), 2000);
+    CORRADE_COMPARE(*reinterpret_cast<int*>(variables[3].storage), 3);
+
+    /* Changing the last value after that still finds it at the right
+       place, parsing restarts after the value before it */
+    {
+        std::ostringstream out;
+        Debug redirectOutput{&out};
+        Warning redirectWarning{&out};
+        std::vector<Implementation::TweakableScope> scopes;
+        TweakableState state = Implementation::parseTweakables("_", "a.cpp", "_(1);\n/* _(0) */\nfoo(_(2000));\n_(\"no parser\")\n\n_(-3);\n", variables, scopes, &cache);
+        CORRADE_COMPARE(out.str(),
+            "Utility::Tweakable::update(): updating _(-3) in a.cpp:6\n");
+        CORRADE_COMPARE(state, TweakableState::Success);
+    }
+    CORRADE_COMPARE(*reinterpret_cast<int*>(variables[3].storage), -3);
+
+    /* Opening a comment in front of a value isn't mistaken for the rest of
+       the file being unchanged */
+    {
+        std::ostringstream out;
+        Debug redirectOutput{&out};
+        Warning redirectWarning{&out};
+        Error redirectError{&out};
+        std::vector<Implementation::TweakableScope> scopes;
+        TweakableState state = Implementation::parseTweakables("_", "a.cpp", "_(1);\n/* _(0) */\nfoo(_(2000)); /*\n_(\"no parser\")\n\n_(-3);\n", variables, scopes, &cache);
+        CORRADE_COMPARE(out.str(),
+            "Utility::Tweakable::update(): unterminated block comment in a.cpp:7\n");
+        CORRADE_COMPARE(state, TweakableState::Error);
+        CORRADE_VERIFY(cache.data.empty());
+    }
+}
+
+void TweakableTest::parseTweakablesCachedLinesChanged() {
+    std::vector<Implementation::TweakableVariable> variables{2};
+    variables[0].line = 1;
+    variables[0].parser = Implementation::TweakableTraits<int>::parse;
+    variables[1].line = 2;
+    variables[1].parser = Implementation::TweakableTraits<int>::parse;
+
+    Implementation::TweakableParseCache cache;
+    {
+        std::ostringstream out;
+        Debug redirectOutput{&out};
+        std::vector<Implementation::TweakableScope> scopes;
+        TweakableState state = Implementation::parseTweakables("_", "a.cpp", "_(1);\n_(2);\n", variables, scopes, &cache);
+        CORRADE_COMPARE(state, TweakableState::Success);
+    }
+
+    /* Adding a line before the second value moves it, which needs a recompile
+       even though the value itself is unchanged */
+    {
+        std::ostringstream out;
+        Warning redirectWarning{&out};
+        std::vector<Implementation::TweakableScope> scopes;
+        TweakableState state = Implementation::parseTweakables("_", "a.cpp", "_(1);\n\n_(2);\n", variables, scopes, &cache);
+        CORRADE_COMPARE(out.str(),
+            "Utility::Tweakable::update(): code changed around _(2) in a.cpp:3, requesting a recompile\n");
+        CORRADE_COMPARE(state, TweakableState::Recompile);
+    }
+}
+
+void TweakableTest::parseTweakablesCachedNewVariable() {
+    std::vector<Implementation::TweakableVariable> variables{2};
+    variables[0].line = 1;
+    variables[0].parser = Implementation::TweakableTraits<int>::parse;
+
+    Implementation::TweakableParseCache cache;
+    {
+        std::ostringstream out;
+        Debug redirectOutput{&out};
+        Warning redirectWarning{&out};
+        std::vector<Implementation::TweakableScope> scopes;
+        TweakableState state = Implementation::parseTweakables("_", "a.cpp", "_(1);\n_(2);\n", variables, scopes, &cache);
+        CORRADE_COMPARE(out.str(),
+            "Utility::Tweakable::update(): updating _(1) in a.cpp:1\n"
+            "Utility::Tweakable::update(): ignoring unknown new value _(2) in a.cpp:2\n");
+        CORRADE_COMPARE(state, TweakableState::Success);
+    }
+
+    /* The application executes the second variable in the meantime, the
+       cached parse is not used in order to pick up the value */
+    variables[1].line = 2;
+    variables[1].parser = Implementation::TweakableTraits<int>::parse;
+    {
+        std::ostringstream out;
+        Debug redirectOutput{&out};
+        Warning redirectWarning{&out};
+        std::vector<Implementation::TweakableScope> scopes;
+        TweakableState state = Implementation::parseTweakables("_", "a.cpp", "_(5);\n_(2);\n", variables, scopes, &cache);
+        CORRADE_COMPARE(out.str(),
+            "Utility::Tweakable::update(): updating _(5) in a.cpp:1\n"
+            "Utility::Tweakable::update(): updating _(2) in a.cpp:2\n");
+        CORRADE_COMPARE(state, TweakableState::Success);
+    }
+    CORRADE_COMPARE(*reinterpret_cast<int*>(variables[0].storage), 5);
+    CORRADE_COMPARE(*reinterpret_cast<int*>(variables[1].storage), 2);
+}
+
 void TweakableTest::parseSpecials() {
     auto&& data = ParseSpecialsData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
@@ -354,7 +523,7 @@ void TweakableTest::parseSpecials() {
         std::ostringstream out;
         Debug redirectOutput{&out};
         Warning redirectWarning{&out};
-        std::set<std::tuple<void(*)(void(*)(), void*), void(*)(), void*>> scopes;
+        std::vector<Implementation::TweakableScope> scopes;
         TweakableState state = Implementation::parseTweakables("TW", "a.cpp", data.data, variables, scopes);
         CORRADE_COMPARE(out.str(), formatString(
             "Utility::Tweakable::update(): updating TW(1337) in a.cpp:{}\n", data.line));
@@ -376,13 +545,89 @@ void TweakableTest::parseSpecialsError() {
         std::ostringstream out;
         Warning redirectWarning{&out};
         Error redirectError{&out};
-        std::set<std::tuple<void(*)(void(*)(), void*), void(*)(), void*>> scopes;
+        std::vector<Implementation::TweakableScope> scopes;
         TweakableState state = Implementation::parseTweakables("_", "a.cpp", data.data, variables, scopes);
         CORRADE_COMPARE(out.str(), data.error);
         CORRADE_COMPARE(state, TweakableState::Error);
     }
 }
 
+void TweakableTest::value() {
+    Implementation::TweakableValue value;
+
+    const char a[Implementation::TweakableStorageSize]{'a', 'b', 'c', 0, 0, 0, 0, 'x', 'y', 'z'};
+    Implementation::publishTweakableValue(value, a);
+    CORRADE_COMPARE(value.epoch, 2);
+
+    char out[Implementation::TweakableStorageSize];
+    Implementation::readTweakableValue(value, out);
+    CORRADE_COMPARE(std::string(out, sizeof(out)), std::string(a, sizeof(a)));
+
+    const char b[Implementation::TweakableStorageSize]{'d', 'e', 'f'};
+    Implementation::publishTweakableValue(value, b);
+    CORRADE_COMPARE(value.epoch, 4);
+
+    Implementation::readTweakableValue(value, out);
+    CORRADE_COMPARE(std::string(out, sizeof(out)), std::string(b, sizeof(b)));
+}
+
+void TweakableTest::valueMultithreaded() {
+    #if !defined(CORRADE_BUILD_MULTITHREADED) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    CORRADE_SKIP("CORRADE_BUILD_MULTITHREADED is not enabled, can't test.");
+    #else
+    Implementation::TweakableValue value;
+
+    /* A writer thread fills both halves with the same increasing number,
+       the readers should never see a value that has them different */
+    std::thread writer{[](Implementation::TweakableValue& value) {
+        for(std::uint64_t i = 0; i != 100000; ++i) {
+            const std::uint64_t data[]{i, i};
+            Implementation::publishTweakableValue(value, reinterpret_cast<const char*>(data));
+        }
+    }, std::ref(value)};
+
+    int inconsistent[4]{};
+    std::thread readers[4];
+    for(std::size_t i = 0; i != 4; ++i) readers[i] = std::thread{[](const Implementation::TweakableValue& value, int& inconsistent) {
+        for(std::size_t j = 0; j != 100000; ++j) {
+            std::uint64_t data[2];
+            Implementation::readTweakableValue(value, reinterpret_cast<char*>(data));
+            if(data[0] != data[1]) ++inconsistent;
+        }
+    }, std::cref(value), std::ref(inconsistent[i])};
+
+    writer.join();
+    for(std::thread& reader: readers) reader.join();
+
+    for(int i: inconsistent) CORRADE_COMPARE(i, 0);
+    CORRADE_COMPARE(value.epoch, 200000);
+    #endif
+}
+
+void TweakableTest::readMultithreaded() {
+    #if !defined(CORRADE_BUILD_MULTITHREADED) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    CORRADE_SKIP("CORRADE_BUILD_MULTITHREADED is not enabled, can't test.");
+    #else
+    Tweakable tweakable;
+    tweakable.enable();
+
+    /* All threads register the same variables at the same time, which should
+       make them end up with a single value each */
+    int sums[4]{};
+    std::thread threads[4];
+    for(std::size_t i = 0; i != 4; ++i) threads[i] = std::thread{[](int& sum) {
+        /* Disable the watch message. The redirection is thread-local. */
+        Debug redirectOutput{nullptr};
+
+        for(std::size_t j = 0; j != 1000; ++j)
+            sum += _(1) + _(20) + _(300);
+    }, std::ref(sums[i])};
+    for(std::thread& thread: threads) thread.join();
+
+    for(int sum: sums) CORRADE_COMPARE(sum, 321000);
+    #endif
+}
+
 void TweakableTest::benchmarkBase() {
     float dt = 1/60.0f;
     float velocity = 0.0f;
@@ -33,9 +33,30 @@
 #include "Corrade/Containers/Array.h"
 #include "Corrade/Containers/Containers.h"
 #include "Corrade/Containers/LinkedList.h"
+#include "Corrade/Containers/Optional.h"
+#include "Corrade/Containers/Pointer.h"
+#include "Corrade/Containers/SharedArray.h"
+#include "Corrade/Containers/StaticArray.h"
 #include "Corrade/TestSuite/Tester.h"
 #include "Corrade/Utility/TypeTraits.h"
 
+namespace {
+
+struct Handle {
+    Handle(Handle&&) noexcept;
+    ~Handle();
+
+    void* data;
+};
+
+}
+
+namespace Corrade { namespace Utility {
+
+template<> struct IsTriviallyRelocatable<Handle>: std::true_type {};
+
+}}
+
 namespace Corrade { namespace Utility { namespace Test { namespace {
 
 struct TypeTraitsTest: TestSuite::Tester {
@@ -53,6 +74,9 @@ struct TypeTraitsTest: TestSuite::Tester {
 
     void isStringLike();
     void isStringLikeNot();
+
+    void isTriviallyRelocatable();
+    void isTriviallyRelocatableNot();
 };
 
 TypeTraitsTest::TypeTraitsTest() {
@@ -67,7 +91,10 @@ TypeTraitsTest::TypeTraitsTest() {
               &TypeTraitsTest::isIterableNot,
 
               &TypeTraitsTest::isStringLike,
-              &TypeTraitsTest::isStringLikeNot});
+              &TypeTraitsTest::isStringLikeNot,
+
+              &TypeTraitsTest::isTriviallyRelocatable,
+              &TypeTraitsTest::isTriviallyRelocatableNot});
 }
 
 void TypeTraitsTest::isTriviallyTraitsSupported() {
@@ -166,6 +193,35 @@ void TypeTraitsTest::isStringLikeNot() {
     CORRADE_VERIFY(!IsStringLike<std::vector<int>>{});
 }
 
+void TypeTraitsTest::isTriviallyRelocatable() {
+    /* Trivially copyable types */
+    CORRADE_VERIFY(IsTriviallyRelocatable<int>{});
+    CORRADE_VERIFY(IsTriviallyRelocatable<int*>{});
+
+    /* Corrade containers */
+    CORRADE_VERIFY(IsTriviallyRelocatable<Containers::Array<int>>{});
+    CORRADE_VERIFY(IsTriviallyRelocatable<Containers::Pointer<std::string>>{});
+    CORRADE_VERIFY(IsTriviallyRelocatable<Containers::SharedArray<int>>{});
+    CORRADE_VERIFY(IsTriviallyRelocatable<Containers::Optional<Containers::Pointer<int>>>{});
+    CORRADE_VERIFY((IsTriviallyRelocatable<Containers::StaticArray<3, Containers::Array<int>>>{}));
+
+    /* User specialization, propagated through containers */
+    CORRADE_VERIFY(IsTriviallyRelocatable<Handle>{});
+    CORRADE_VERIFY(IsTriviallyRelocatable<Containers::Optional<Handle>>{});
+}
+
+void TypeTraitsTest::isTriviallyRelocatableNot() {
+    struct Stateful {
+        void operator()(int*, std::size_t) {}
+        std::string name;
+    };
+
+    CORRADE_VERIFY(!IsTriviallyRelocatable<std::string>{});
+    CORRADE_VERIFY(!IsTriviallyRelocatable<Containers::Optional<std::string>>{});
+    CORRADE_VERIFY((!IsTriviallyRelocatable<Containers::StaticArray<3, std::string>>{}));
+    CORRADE_VERIFY((!IsTriviallyRelocatable<Containers::Array<int, Stateful>>{}));
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Corrade::Utility::Test::TypeTraitsTest)
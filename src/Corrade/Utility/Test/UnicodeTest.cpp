@@ -22,6 +22,7 @@
     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
     DEALINGS IN THE SOFTWARE.
 */
+#include <cstdint>
 
 #include <sstream>
 #include <string>
@@ -47,6 +48,29 @@ struct UnicodeTest: TestSuite::Tester {
     void utf32utf8();
     void utf32utf8Error();
 
+    void validate();
+    void validateInvalid();
+    void validateLong();
+    void validateRandom();
+
+    void utf8utf32Bulk();
+    void utf8utf32BulkInvalid();
+    void utf8utf16Bulk();
+    void utf8utf16BulkInvalid();
+    void utf16utf8Bulk();
+    void utf16utf8BulkInvalid();
+    void utf32utf8Bulk();
+    void utf32utf8BulkInvalid();
+    void bulkRoundtripRandom();
+    void bulkOutputTooSmall();
+
+    void benchmarkValidateAscii();
+    void benchmarkValidateMixed();
+    void benchmarkValidateMixedNextChar();
+    void benchmarkUtf32Ascii();
+    void benchmarkUtf32AsciiNextChar();
+    void benchmarkUtf16Mixed();
+
     #ifdef CORRADE_TARGET_WINDOWS
     void widen();
     void narrow();
@@ -66,11 +90,34 @@ UnicodeTest::UnicodeTest() {
               &UnicodeTest::utf32utf8,
               &UnicodeTest::utf32utf8Error,
 
+              &UnicodeTest::validate,
+              &UnicodeTest::validateInvalid,
+              &UnicodeTest::validateLong,
+              &UnicodeTest::validateRandom,
+
+              &UnicodeTest::utf8utf32Bulk,
+              &UnicodeTest::utf8utf32BulkInvalid,
+              &UnicodeTest::utf8utf16Bulk,
+              &UnicodeTest::utf8utf16BulkInvalid,
+              &UnicodeTest::utf16utf8Bulk,
+              &UnicodeTest::utf16utf8BulkInvalid,
+              &UnicodeTest::utf32utf8Bulk,
+              &UnicodeTest::utf32utf8BulkInvalid,
+              &UnicodeTest::bulkRoundtripRandom,
+              &UnicodeTest::bulkOutputTooSmall,
+
               #ifdef CORRADE_TARGET_WINDOWS
               &UnicodeTest::widen,
               &UnicodeTest::narrow
               #endif
               });
+
+    addBenchmarks({&UnicodeTest::benchmarkValidateAscii,
+                   &UnicodeTest::benchmarkValidateMixed,
+                   &UnicodeTest::benchmarkValidateMixedNextChar,
+                   &UnicodeTest::benchmarkUtf32Ascii,
+                   &UnicodeTest::benchmarkUtf32AsciiNextChar,
+                   &UnicodeTest::benchmarkUtf16Mixed}, 10);
 }
 
 void UnicodeTest::nextUtf8() {
@@ -197,6 +244,357 @@ void UnicodeTest::utf32utf8Error() {
     CORRADE_VERIFY(!Unicode::utf8(1594880, nullptr));
 }
 
+Containers::ArrayView<const char> view(const std::string& string) {
+    return {string.data(), string.size()};
+}
+
+/* A straightforward implementation of the RFC 3629 grammar to compare the
+   vectorized implementation against */
+bool validateReference(const std::string& text) {
+    for(std::size_t i = 0; i != text.size(); ) {
+        const std::uint8_t c = text[i];
+        std::size_t size;
+        char32_t value;
+        if(c < 0x80) { size = 1; value = c; }
+        else if((c & 0xe0) == 0xc0) { size = 2; value = c & 0x1f; }
+        else if((c & 0xf0) == 0xe0) { size = 3; value = c & 0x0f; }
+        else if((c & 0xf8) == 0xf0) { size = 4; value = c & 0x07; }
+        else return false;
+
+        if(text.size() - i < size) return false;
+        for(std::size_t j = 1; j != size; ++j) {
+            if((text[i + j] & 0xc0) != 0x80) return false;
+            value = (value << 6)|(text[i + j] & 0x3f);
+        }
+
+        /* Overlong sequences, surrogates, out of range */
+        if((size == 2 && value < 0x80) ||
+           (size == 3 && value < 0x800) ||
+           (size == 4 && value < 0x10000) ||
+           (value >= 0xd800 && value < 0xe000) ||
+           value > 0x10ffff) return false;
+
+        i += size;
+    }
+
+    return true;
+}
+
+/* Produces random strings that are mostly valid UTF-8 so the invalid parts
+   are not all detected in the first few bytes */
+std::string randomText(std::uint32_t& seed, const std::size_t size, const bool corrupt) {
+    std::string text;
+    while(text.size() < size) {
+        seed = seed*1103515245u + 12345u;
+        const std::uint32_t random = seed >> 8;
+        char32_t character;
+        switch(random % 5) {
+            case 0:
+            case 1: character = random % 0x80; break;
+            case 2: character = 0x80 + random % 0x780; break;
+            case 3: character = 0x800 + random % 0xf800; break;
+            default: character = 0x10000 + random % 0x100000;
+        }
+        if(character >= 0xd800 && character < 0xe000) character = 'x';
+
+        char buffer[4];
+        text.append(buffer, Unicode::utf8(character, buffer));
+    }
+
+    if(corrupt && !text.empty()) {
+        seed = seed*1103515245u + 12345u;
+        text[(seed >> 8) % text.size()] = char(seed >> 24);
+    }
+
+    return text;
+}
+
+void UnicodeTest::validate() {
+    CORRADE_VERIFY(Unicode::validate(nullptr));
+    CORRADE_VERIFY(Unicode::validate("hello"));
+    CORRADE_VERIFY(Unicode::validate("žluťoučký kůň"));
+
+    /* Boundaries of all sequence lengths */
+    CORRADE_VERIFY(Unicode::validate("\x7f"));
+    CORRADE_VERIFY(Unicode::validate("\xc2\x80"));
+    CORRADE_VERIFY(Unicode::validate("\xdf\xbf"));
+    CORRADE_VERIFY(Unicode::validate("\xe0\xa0\x80"));
+    CORRADE_VERIFY(Unicode::validate("\xed\x9f\xbf"));
+    CORRADE_VERIFY(Unicode::validate("\xee\x80\x80"));
+    CORRADE_VERIFY(Unicode::validate("\xef\xbf\xbf"));
+    CORRADE_VERIFY(Unicode::validate("\xf0\x90\x80\x80"));
+    CORRADE_VERIFY(Unicode::validate("\xf4\x8f\xbf\xbf"));
+
+    /* Null bytes are valid */
+    CORRADE_VERIFY(Unicode::validate(Containers::ArrayView<const char>{"a\0b", 3}));
+}
+
+void UnicodeTest::validateInvalid() {
+    /* Lone continuation bytes and invalid lead bytes */
+    CORRADE_VERIFY(!Unicode::validate("\x80"));
+    CORRADE_VERIFY(!Unicode::validate("a\xbf"));
+    CORRADE_VERIFY(!Unicode::validate("\xf8\x88\x80\x80\x80"));
+    CORRADE_VERIFY(!Unicode::validate("\xff"));
+
+    /* Overlong sequences */
+    CORRADE_VERIFY(!Unicode::validate("\xc0\x80"));
+    CORRADE_VERIFY(!Unicode::validate("\xc1\xbf"));
+    CORRADE_VERIFY(!Unicode::validate("\xe0\x9f\xbf"));
+    CORRADE_VERIFY(!Unicode::validate("\xf0\x8f\xbf\xbf"));
+
+    /* Surrogates */
+    CORRADE_VERIFY(!Unicode::validate("\xed\xa0\x80"));
+    CORRADE_VERIFY(!Unicode::validate("\xed\xbf\xbf"));
+
+    /* Out of range */
+    CORRADE_VERIFY(!Unicode::validate("\xf4\x90\x80\x80"));
+    CORRADE_VERIFY(!Unicode::validate("\xf5\x80\x80\x80"));
+
+    /* Truncated and interrupted sequences */
+    CORRADE_VERIFY(!Unicode::validate("\xc5"));
+    CORRADE_VERIFY(!Unicode::validate("\xe2\x82"));
+    CORRADE_VERIFY(!Unicode::validate("\xf0\x9f\x98"));
+    CORRADE_VERIFY(!Unicode::validate("\xe2\x82z"));
+    CORRADE_VERIFY(!Unicode::validate("\xe2\xe2\x82\xac"));
+}
+
+void UnicodeTest::validateLong() {
+    /* Put each of the invalid sequences at every position of a long string
+       so it crosses vector boundaries and appears in the remaining scalar
+       part as well */
+    const char* const invalid[]{
+        "\x80", "\xc0\x80", "\xe0\x9f\xbf", "\xf0\x8f\xbf\xbf", "\xed\xa0\x80",
+        "\xf4\x90\x80\x80", "\xf5\x80\x80\x80", "\xc5", "\xe2\x82", "\xf0\x9f\x98", "\xff"
+    };
+    const std::string valid = "a\xc5\xbe\xe2\x82\xac\xf0\x9f\x98\x80";
+
+    for(std::size_t prefix = 0; prefix != 100; ++prefix) {
+
+        const std::string before(prefix, 'x');
+        const std::string after = valid + std::string(80, 'y') + valid;
+        CORRADE_VERIFY(Unicode::validate(view(before + valid + after)));
+
+        for(const char* sequence: invalid) {
+            CORRADE_VERIFY(!Unicode::validate(view(before + sequence + after)));
+            /* At the very end */
+            CORRADE_VERIFY(!Unicode::validate(view(before + sequence)));
+        }
+    }
+}
+
+void UnicodeTest::validateRandom() {
+    std::uint32_t seed = 1;
+    for(std::size_t i = 0; i != 20000; ++i) {
+        const std::string text = randomText(seed, i % 200, i % 2);
+        CORRADE_COMPARE(Unicode::validate(view(text)), validateReference(text));
+    }
+}
+
+void UnicodeTest::utf8utf32Bulk() {
+    /* Long enough to go through the vectorized ASCII path as well */
+    const std::string text = "žluťoučký kůň, příliš dlouhý ASCII text s jedním \xf0\x9f\x98\x80 na konci";
+    std::u32string out(text.size(), U'\0');
+    const std::size_t size = Unicode::utf32(view(text), {&out[0], out.size()});
+    out.resize(size);
+    CORRADE_COMPARE(out, U"žluťoučký kůň, příliš dlouhý ASCII text s jedním \U0001f600 na konci");
+
+    /* Same as the std::string overload */
+    CORRADE_COMPARE(out, Unicode::utf32(text));
+
+    CORRADE_COMPARE(Unicode::utf32(nullptr, nullptr), 0);
+}
+
+void UnicodeTest::utf8utf32BulkInvalid() {
+    /* Invalid bytes are decoded the same way as in nextChar() */
+    const std::string text = "ab\xe2\x82z\xffyz";
+    char32_t out[9];
+    CORRADE_COMPARE(Unicode::utf32(view(text), out), 8);
+    CORRADE_COMPARE(out[0], U'a');
+    CORRADE_COMPARE(out[1], U'b');
+    CORRADE_COMPARE(out[2], U'\xffffffff');
+    CORRADE_COMPARE(out[3], U'\xffffffff');
+    CORRADE_COMPARE(out[4], U'z');
+    CORRADE_COMPARE(out[5], U'\xffffffff');
+    CORRADE_COMPARE(out[6], U'y');
+    CORRADE_COMPARE(out[7], U'z');
+}
+
+void UnicodeTest::utf8utf16Bulk() {
+    const std::string text = "žluťoučký kůň, příliš dlouhý ASCII text s jedním \xf0\x9f\x98\x80 na konci";
+    std::u16string out(text.size(), u'\0');
+    out.resize(Unicode::utf16(view(text), {&out[0], out.size()}));
+    CORRADE_COMPARE(out, u"žluťoučký kůň, příliš dlouhý ASCII text s jedním \xd83d\xde00 na konci");
+
+    CORRADE_COMPARE(Unicode::utf16(nullptr, nullptr), 0);
+}
+
+void UnicodeTest::utf8utf16BulkInvalid() {
+    /* Invalid bytes, surrogates (which nextChar() happily decodes) and values
+       above 0x10ffff get replaced */
+    const std::string text = "a\xff\xed\xa0\x80\xf7\xbf\xbf\xbf\xc5";
+    char16_t out[10];
+    CORRADE_COMPARE(Unicode::utf16(view(text), out), 5);
+    CORRADE_COMPARE(out[0], u'a');
+    CORRADE_COMPARE(out[1], u'\xfffd');
+    CORRADE_COMPARE(out[2], u'\xfffd');
+    CORRADE_COMPARE(out[3], u'\xfffd');
+    CORRADE_COMPARE(out[4], u'\xfffd');
+}
+
+void UnicodeTest::utf16utf8Bulk() {
+    const std::u16string text = u"žluťoučký kůň, příliš dlouhý ASCII text s jedním \xd83d\xde00 na konci";
+    std::string out(text.size()*3, '\0');
+    out.resize(Unicode::utf8(Containers::ArrayView<const char16_t>{text.data(), text.size()}, {&out[0], out.size()}));
+    CORRADE_COMPARE(out, "žluťoučký kůň, příliš dlouhý ASCII text s jedním \xf0\x9f\x98\x80 na konci");
+
+    CORRADE_COMPARE(Unicode::utf8(Containers::ArrayView<const char16_t>{}, nullptr), 0);
+}
+
+void UnicodeTest::utf16utf8BulkInvalid() {
+    /* Unpaired high surrogate, unpaired low surrogate, high surrogate at the
+       end */
+    const char16_t text[]{u'a', 0xd83d, u'b', 0xde00, 0xd83d};
+    char out[15];
+    CORRADE_COMPARE(Unicode::utf8(Containers::arrayView(text), out), 11);
+    CORRADE_COMPARE((std::string{out, 11}), "a\xef\xbf\xbd" "b\xef\xbf\xbd\xef\xbf\xbd");
+}
+
+void UnicodeTest::utf32utf8Bulk() {
+    const std::u32string text = U"žluťoučký kůň, příliš dlouhý ASCII text s jedním \U0001f600 na konci";
+    std::string out(text.size()*4, '\0');
+    out.resize(Unicode::utf8(Containers::ArrayView<const char32_t>{text.data(), text.size()}, {&out[0], out.size()}));
+    CORRADE_COMPARE(out, "žluťoučký kůň, příliš dlouhý ASCII text s jedním \xf0\x9f\x98\x80 na konci");
+
+    CORRADE_COMPARE(Unicode::utf8(Containers::ArrayView<const char32_t>{}, nullptr), 0);
+}
+
+void UnicodeTest::utf32utf8BulkInvalid() {
+    const char32_t text[]{U'a', 0x110000, U'b'};
+    char out[12];
+    CORRADE_COMPARE(Unicode::utf8(Containers::arrayView(text), out), 5);
+    CORRADE_COMPARE((std::string{out, 5}), "a\xef\xbf\xbd" "b");
+}
+
+void UnicodeTest::bulkRoundtripRandom() {
+    std::uint32_t seed = 7;
+    for(std::size_t i = 0; i != 2000; ++i) {
+        const std::string text = randomText(seed, i % 300, false);
+
+        /* UTF-32 compared to decoding one character at a time */
+        std::u32string expected;
+        for(std::size_t j = 0; j != text.size(); ) {
+            const std::pair<char32_t, std::size_t> next = Unicode::nextChar(text, j);
+            expected += next.first;
+            j = next.second;
+        }
+        std::u32string utf32(text.size(), U'\0');
+        utf32.resize(Unicode::utf32(view(text), {&utf32[0], utf32.size()}));
+        CORRADE_COMPARE(utf32, expected);
+
+        std::string fromUtf32(utf32.size()*4, '\0');
+        fromUtf32.resize(Unicode::utf8(Containers::ArrayView<const char32_t>{utf32.data(), utf32.size()}, {&fromUtf32[0], fromUtf32.size()}));
+        CORRADE_COMPARE(fromUtf32, text);
+
+        std::u16string utf16(text.size(), u'\0');
+        utf16.resize(Unicode::utf16(view(text), {&utf16[0], utf16.size()}));
+        std::string fromUtf16(utf16.size()*3, '\0');
+        fromUtf16.resize(Unicode::utf8(Containers::ArrayView<const char16_t>{utf16.data(), utf16.size()}, {&fromUtf16[0], fromUtf16.size()}));
+        CORRADE_COMPARE(fromUtf16, text);
+    }
+}
+
+void UnicodeTest::bulkOutputTooSmall() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    char32_t out32[2];
+    char16_t out16[2];
+    char out8[5];
+    const char16_t in16[2]{};
+    const char32_t in32[2]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Unicode::utf32({"abc", 3}, out32);
+    Unicode::utf16({"abc", 3}, out16);
+    Unicode::utf8(Containers::arrayView(in16), out8);
+    Unicode::utf8(Containers::arrayView(in32), out8);
+    CORRADE_COMPARE(out.str(),
+        "Utility::Unicode::utf32(): expected output of at least 3 characters but got 2\n"
+        "Utility::Unicode::utf16(): expected output of at least 3 characters but got 2\n"
+        "Utility::Unicode::utf8(): expected output of at least 6 bytes but got 5\n"
+        "Utility::Unicode::utf8(): expected output of at least 8 bytes but got 5\n");
+}
+
+std::string benchmarkText(const bool ascii) {
+    if(ascii) return std::string(1024*1024, 'a');
+
+    std::uint32_t seed = 3;
+    return randomText(seed, 1024*1024, false);
+}
+
+void UnicodeTest::benchmarkValidateAscii() {
+    const std::string text = benchmarkText(true);
+    bool valid = true;
+    CORRADE_BENCHMARK(10)
+        valid = valid && Unicode::validate(view(text));
+    CORRADE_VERIFY(valid);
+}
+
+void UnicodeTest::benchmarkValidateMixed() {
+    const std::string text = benchmarkText(false);
+    bool valid = true;
+    CORRADE_BENCHMARK(10)
+        valid = valid && Unicode::validate(view(text));
+    CORRADE_VERIFY(valid);
+}
+
+void UnicodeTest::benchmarkValidateMixedNextChar() {
+    const std::string text = benchmarkText(false);
+    bool valid = true;
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != text.size(); ) {
+            const std::pair<char32_t, std::size_t> next = Unicode::nextChar(text, i);
+            valid = valid && next.first != U'\xffffffff';
+            i = next.second;
+        }
+    }
+    CORRADE_VERIFY(valid);
+}
+
+void UnicodeTest::benchmarkUtf32Ascii() {
+    const std::string text = benchmarkText(true);
+    std::u32string out(text.size(), U'\0');
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(10)
+        size += Unicode::utf32(view(text), {&out[0], out.size()});
+    CORRADE_COMPARE(size, text.size()*10);
+}
+
+void UnicodeTest::benchmarkUtf32AsciiNextChar() {
+    const std::string text = benchmarkText(true);
+    std::u32string out(text.size(), U'\0');
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != text.size(); ) {
+            const std::pair<char32_t, std::size_t> next = Unicode::nextChar(text, i);
+            out[size++ % out.size()] = next.first;
+            i = next.second;
+        }
+    }
+    CORRADE_COMPARE(size, text.size()*10);
+}
+
+void UnicodeTest::benchmarkUtf16Mixed() {
+    const std::string text = benchmarkText(false);
+    std::u16string out(text.size(), u'\0');
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(10)
+        size += Unicode::utf16(view(text), {&out[0], out.size()});
+    CORRADE_VERIFY(size);
+}
+
 #ifdef CORRADE_TARGET_WINDOWS
 void UnicodeTest::widen() {
     const char text[] = "žluťoučký kůň\0hýždě";
@@ -0,0 +1,305 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+    Copyright © 2019 Jonathan Hale <squareys@googlemail.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifdef _MSC_VER
+#include <algorithm> /* std::min() */
+#endif
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Container.h"
+#include "Corrade/Utility/MurmurHash2.h"
+#include "Corrade/Utility/Sha1.h"
+#include "Corrade/Utility/XxHash3.h"
+#include "Corrade/Utility/Implementation/xxHash3.h"
+
+namespace Corrade { namespace Utility { namespace Test { namespace {
+
+struct XxHash3Test: TestSuite::Tester {
+    explicit XxHash3Test();
+
+    void digest64();
+    void digest128();
+    void convenience();
+
+    void iterative();
+    void reuse();
+
+    void variant();
+
+    void benchmarkMurmurHash2();
+    void benchmarkSha1();
+    void benchmark64();
+    void benchmark128();
+    void benchmarkVariant();
+};
+
+/* Expected values generated with the reference XXH3_64bits_withSeed() and
+   XXH3_128bits_withSeed() for data filled by makeData() below. Covering all
+   code paths of the short inputs and crossing 1024-byte block boundaries. */
+const struct {
+    const char* name;
+    std::size_t size;
+    std::uint64_t seed;
+    const char* expected64;
+    const char* expected128;
+} DigestData[]{
+    {"empty", 0, 0,
+        "2d06800538d394c2", "99aa06d3014798d86001c324468d497f"},
+    {"3 bytes", 3, 0,
+        "c3489259e968ad9e", "656e81c56e41fe02c3489259e968ad9e"},
+    {"8 bytes", 8, 0,
+        "b88dee77f6bf6980", "e4b9dd0b66ff3c50ebabbd0695002ff6"},
+    {"16 bytes", 16, 0,
+        "907976bb290db9e8", "23c9692dc06ea6fceb7825b4bb2f744e"},
+    {"100 bytes", 100, 0,
+        "648c415ab999008e", "af13948b337c6996870769fe0e9f581d"},
+    {"200 bytes", 200, 0,
+        "3f99fc17fcc9950d", "50ea403d60a8d077ff2f99ae3defdec0"},
+    {"240 bytes", 240, 0,
+        "28067121726fa14e", "add31b5d3cc4591a021514a91e2ee53b"},
+    {"241 bytes", 241, 0,
+        "26e9e1d1ee797db1", "0913edbfea45a8ec26e9e1d1ee797db1"},
+    {"1000 bytes", 1000, 0,
+        "e289e91f8bc3e496", "4eb4dd31555cedede289e91f8bc3e496"},
+    {"2048 bytes", 2048, 0,
+        "fc8a3d83d69fd599", "b801255c964c3acdfc8a3d83d69fd599"},
+    {"2049 bytes", 2049, 0,
+        "0fa11af08a70fd56", "ce26c87a7bbd47fa0fa11af08a70fd56"},
+    {"5 bytes, seeded", 5, 0x1337,
+        "ba0f2dd34d22c6ac", "ec05edfd845337bda906416e95c017c3"},
+    {"12 bytes, seeded", 12, 0x1337,
+        "a3d0dcf681f177d5", "647001a93f13079d13f6e85344a2cde9"},
+    {"200 bytes, seeded", 200, 0x1337,
+        "b93e9a2d098888a7", "61aca7acc08853cf4b94880077d705a1"},
+    {"2049 bytes, seeded", 2049, 0x1337,
+        "4f4aec20a24da5e8", "342575b4b5cae20e4f4aec20a24da5e8"},
+};
+
+const struct {
+    const char* name;
+    Cpu::Features features;
+} VariantData[]{
+    {"scalar", {}},
+    #ifdef CORRADE_TARGET_X86
+    {"SSE2", Cpu::Feature::Sse2},
+    {"AVX2", Cpu::Feature::Avx2},
+    #endif
+};
+
+XxHash3Test::XxHash3Test() {
+    addInstancedTests({&XxHash3Test::digest64,
+                       &XxHash3Test::digest128},
+        Containers::arraySize(DigestData));
+
+    addTests({&XxHash3Test::convenience});
+
+    addRepeatedTests({&XxHash3Test::iterative}, 300);
+
+    addTests({&XxHash3Test::reuse});
+
+    addInstancedTests({&XxHash3Test::variant},
+        Containers::arraySize(VariantData));
+
+    addBenchmarks({&XxHash3Test::benchmarkMurmurHash2,
+                   &XxHash3Test::benchmarkSha1,
+                   &XxHash3Test::benchmark64,
+                   &XxHash3Test::benchmark128}, 10);
+
+    addInstancedBenchmarks({&XxHash3Test::benchmarkVariant}, 10,
+        Containers::arraySize(VariantData));
+}
+
+std::string makeData(std::size_t size) {
+    std::string data(size, '\0');
+    for(std::size_t i = 0; i != size; ++i)
+        data[i] = char(i*7 + i/13);
+    return data;
+}
+
+void XxHash3Test::digest64() {
+    auto&& data = DigestData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    XxHash3<8> hasher{data.seed};
+    hasher << makeData(data.size);
+    CORRADE_COMPARE(hasher.digest(), XxHash3<8>::Digest::fromHexString(data.expected64));
+}
+
+void XxHash3Test::digest128() {
+    auto&& data = DigestData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    XxHash3<16> hasher{data.seed};
+    hasher << makeData(data.size);
+    CORRADE_COMPARE(hasher.digest(), XxHash3<16>::Digest::fromHexString(data.expected128));
+}
+
+void XxHash3Test::convenience() {
+    const std::string data = makeData(1000);
+    CORRADE_COMPARE(XxHash3<8>::digest(data),
+        XxHash3<8>::Digest::fromHexString("e289e91f8bc3e496"));
+    CORRADE_COMPARE(XxHash3<16>::digest(data),
+        XxHash3<16>::Digest::fromHexString("4eb4dd31555cedede289e91f8bc3e496"));
+}
+
+void XxHash3Test::iterative() {
+    /* Adding the data in differently sized pieces, including ones smaller
+       and larger than the internal buffer, should give the same result */
+    const std::string data = makeData(4000);
+    const std::size_t size = testCaseRepeatId()*testCaseRepeatId()/20 + 1;
+    XxHash3<8> hasher64;
+    XxHash3<16> hasher128;
+    for(std::size_t offset = 0; offset < data.size(); offset += size) {
+        const auto slice = Containers::arrayView(data.data() + offset, std::min(size, data.size() - offset));
+        hasher64 << slice;
+        hasher128 << slice;
+    }
+
+    CORRADE_COMPARE(hasher64.digest(),
+        XxHash3<8>::Digest::fromHexString("8338aca78eb9ddac"));
+    CORRADE_COMPARE(hasher128.digest(),
+        XxHash3<16>::Digest::fromHexString("bf1fda79670026eb8338aca78eb9ddac"));
+}
+
+void XxHash3Test::reuse() {
+    const std::string data = makeData(2049);
+    XxHash3<8> hasher{0x1337};
+    hasher << data;
+    CORRADE_COMPARE(hasher.digest(), XxHash3<8>::Digest::fromHexString("4f4aec20a24da5e8"));
+
+    /* Second time the hash equals to hash of an empty string with the same
+       seed */
+    CORRADE_COMPARE(hasher.digest(), XxHash3<8>::Digest::fromHexString("034dd73f4a670965"));
+
+    /* Filling again, it gives the same output */
+    hasher << data;
+    CORRADE_COMPARE(hasher.digest(), XxHash3<8>::Digest::fromHexString("4f4aec20a24da5e8"));
+}
+
+void XxHash3Test::variant() {
+    auto&& data = VariantData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if((Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("Not supported on this machine.");
+
+    const Implementation::XxHash3AccumulateFunction function = Implementation::xxHash3AccumulateFunction(data.features);
+    const Implementation::XxHash3AccumulateFunction scalar = Implementation::xxHash3AccumulateFunction({});
+    if(data.features && function == scalar)
+        CORRADE_SKIP("Not compiled in.");
+
+    /* Accumulate a full block with both this and the scalar variant, all
+       stripes at once and one stripe at a time */
+    const std::string input = makeData(16*64);
+    const std::string secret = makeData(37 + 16*8 + 64).substr(37);
+    std::uint64_t expected[8]{1, 2, 3, 4, 5, 6, 7, 8};
+    scalar(expected, input.data(), secret.data(), 16);
+
+    std::uint64_t actual[8]{1, 2, 3, 4, 5, 6, 7, 8};
+    function(actual, input.data(), secret.data(), 16);
+    CORRADE_COMPARE_AS(Containers::arrayView(actual), Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+
+    std::uint64_t actualSplit[8]{1, 2, 3, 4, 5, 6, 7, 8};
+    for(std::size_t i = 0; i != 16; ++i)
+        function(actualSplit, input.data() + i*64, secret.data() + i*8, 1);
+    CORRADE_COMPARE_AS(Containers::arrayView(actualSplit), Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+Containers::Array<char> benchmarkData() {
+    Containers::Array<char> buffer{Containers::ValueInit, 1024*1024};
+    for(std::size_t i = 0; i != buffer.size(); ++i) buffer[i] = char(i*37);
+    return buffer;
+}
+
+void XxHash3Test::benchmarkMurmurHash2() {
+    const Containers::Array<char> buffer = benchmarkData();
+
+    MurmurHash2::Digest digest;
+    CORRADE_BENCHMARK(1)
+        digest = MurmurHash2{}(buffer.data(), buffer.size());
+
+    CORRADE_VERIFY(digest != MurmurHash2::Digest{});
+}
+
+void XxHash3Test::benchmarkSha1() {
+    const Containers::Array<char> buffer = benchmarkData();
+
+    Sha1 hasher;
+    CORRADE_BENCHMARK(1)
+        hasher << Containers::arrayView(buffer);
+
+    CORRADE_VERIFY(hasher.digest() != Sha1::Digest{});
+}
+
+void XxHash3Test::benchmark64() {
+    const Containers::Array<char> buffer = benchmarkData();
+
+    XxHash3<8> hasher;
+    CORRADE_BENCHMARK(1)
+        hasher << Containers::arrayView(buffer);
+
+    CORRADE_VERIFY(hasher.digest() != XxHash3<8>::Digest{});
+}
+
+void XxHash3Test::benchmark128() {
+    const Containers::Array<char> buffer = benchmarkData();
+
+    XxHash3<16> hasher;
+    CORRADE_BENCHMARK(1)
+        hasher << Containers::arrayView(buffer);
+
+    CORRADE_VERIFY(hasher.digest() != XxHash3<16>::Digest{});
+}
+
+void XxHash3Test::benchmarkVariant() {
+    auto&& data = VariantData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if((Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("Not supported on this machine.");
+
+    const Implementation::XxHash3AccumulateFunction function = Implementation::xxHash3AccumulateFunction(data.features);
+    if(data.features && function == Implementation::xxHash3AccumulateFunction({}))
+        CORRADE_SKIP("Not compiled in.");
+
+    const Containers::Array<char> buffer = benchmarkData();
+    const std::string secret = makeData(192);
+
+    /* Leaving out the scrambling, which is done only once per 1 kB block */
+    std::uint64_t accumulators[8]{};
+    CORRADE_BENCHMARK(1)
+        for(std::size_t i = 0; i != buffer.size()/1024; ++i)
+            function(accumulators, buffer.data() + i*1024, secret.data(), 16);
+
+    CORRADE_VERIFY(accumulators[0] || accumulators[7]);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Utility::Test::XxHash3Test)
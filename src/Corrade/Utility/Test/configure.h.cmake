@@ -32,6 +32,7 @@
 
 #define FORMAT_WRITE_TEST_DIR "${UTILITY_BINARY_TEST_DIR}"
 #define RESOURCE_TEST_DIR "${UTILITY_TEST_DIR}/ResourceTestFiles/"
+#define RESOURCE_WRITE_TEST_DIR "${UTILITY_BINARY_TEST_DIR}/ResourceTestFiles"
 
 #define FILEWATCHER_WRITE_TEST_DIR "${UTILITY_BINARY_TEST_DIR}/FileWatcherTestFiles"
 
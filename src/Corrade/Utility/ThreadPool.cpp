@@ -0,0 +1,324 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ThreadPool.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Corrade/Containers/GrowableArray.h"
+#include "Corrade/Utility/Assert.h"
+#include "Corrade/Utility/Macros.h"
+
+namespace Corrade { namespace Utility {
+
+namespace {
+
+/* Either a subrange of a parallel for or a single task of a task group, in
+   which case simpleFunction is set */
+struct WorkItem {
+    void(*function)(void*, std::size_t, std::size_t);
+    void(*simpleFunction)(void*);
+    void* state;
+    std::size_t begin, end, grainSize;
+    std::atomic<std::size_t>* pending;
+};
+
+struct Queue {
+    std::mutex mutex;
+    std::deque<WorkItem> tasks;
+};
+
+}
+
+struct ThreadPool::State {
+    /* One queue for each worker thread and one more, last, shared by all
+       other threads */
+    Containers::Array<Queue> queues;
+    std::vector<std::thread> threads;
+
+    /* Incremented before a task is put into a queue and decremented after
+       it's taken out */
+    std::atomic<std::size_t> queuedCount{};
+
+    /* Used only for waking up the workers when they have nothing to do */
+    std::atomic<std::size_t> sleepingCount{};
+    std::atomic<bool> stopping{};
+    /* Also guards deferred task group tasks with an external executor */
+    std::mutex mutex;
+    std::condition_variable condition;
+
+    /* Used instead of all the above if set */
+    ParallelExecutor executor{};
+    void* executorState{};
+    std::size_t jobCount{};
+
+    void run(std::size_t worker);
+    std::size_t currentQueue() const;
+    void push(std::size_t queue, const WorkItem& task);
+    bool take(std::size_t queue, WorkItem& task);
+    void execute(std::size_t queue, WorkItem& task);
+    void wait(const std::atomic<std::size_t>& pending);
+};
+
+namespace {
+
+/* The pool the current thread is a worker of, if any, and its queue index */
+CORRADE_THREAD_LOCAL const void* currentPool = nullptr;
+CORRADE_THREAD_LOCAL std::size_t currentWorker = 0;
+
+}
+
+std::size_t ThreadPool::State::currentQueue() const {
+    return currentPool == this ? currentWorker : queues.size() - 1;
+}
+
+void ThreadPool::State::push(const std::size_t queue, const WorkItem& task) {
+    queuedCount.fetch_add(1, std::memory_order_seq_cst);
+    {
+        std::lock_guard<std::mutex> lock{queues[queue].mutex};
+        queues[queue].tasks.push_back(task);
+    }
+
+    /* If a worker announced it's going to sleep after the count was
+       incremented, it'll see the new count. Otherwise we see the sleeping
+       worker here and wake it up. */
+    if(sleepingCount.load(std::memory_order_seq_cst)) {
+        { std::lock_guard<std::mutex> lock{mutex}; }
+        condition.notify_one();
+    }
+}
+
+bool ThreadPool::State::take(const std::size_t queue, WorkItem& task) {
+    /* The own queue first, from the back, as it's the most recently split
+       and thus smallest work with data likely still in the cache */
+    {
+        Queue& own = queues[queue];
+        std::lock_guard<std::mutex> lock{own.mutex};
+        if(!own.tasks.empty()) {
+            task = own.tasks.back();
+            own.tasks.pop_back();
+            queuedCount.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    /* Then steal from the front of other queues, where the largest pieces of
+       work are, starting with the next one to spread the stealing */
+    for(std::size_t i = 1; i != queues.size(); ++i) {
+        Queue& other = queues[(queue + i) % queues.size()];
+        std::lock_guard<std::mutex> lock{other.mutex};
+        if(!other.tasks.empty()) {
+            task = other.tasks.front();
+            other.tasks.pop_front();
+            queuedCount.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::State::execute(const std::size_t queue, WorkItem& task) {
+    if(task.simpleFunction) {
+        task.simpleFunction(task.state);
+    } else {
+        /* Split the range in halves, leaving the right halves for others to
+           steal */
+        while(task.end - task.begin > task.grainSize) {
+            WorkItem right = task;
+            right.begin = task.begin + (task.end - task.begin)/2;
+            task.end = right.begin;
+            task.pending->fetch_add(1, std::memory_order_relaxed);
+            push(queue, right);
+        }
+
+        task.function(task.state, task.begin, task.end);
+    }
+
+    task.pending->fetch_sub(1, std::memory_order_release);
+}
+
+void ThreadPool::State::wait(const std::atomic<std::size_t>& pending) {
+    const std::size_t queue = currentQueue();
+    while(pending.load(std::memory_order_acquire)) {
+        WorkItem task;
+        if(take(queue, task))
+            execute(queue, task);
+        else
+            std::this_thread::yield();
+    }
+}
+
+void ThreadPool::State::run(const std::size_t worker) {
+    currentPool = this;
+    currentWorker = worker;
+
+    for(;;) {
+        WorkItem task;
+        if(take(worker, task)) {
+            execute(worker, task);
+            continue;
+        }
+
+        /* Stopping only once there's nothing left */
+        if(stopping.load(std::memory_order_acquire)) break;
+
+        sleepingCount.fetch_add(1, std::memory_order_seq_cst);
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            condition.wait(lock, [this]{
+                return queuedCount.load(std::memory_order_seq_cst) || stopping.load(std::memory_order_acquire);
+            });
+        }
+        sleepingCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+ThreadPool::ThreadPool(): ThreadPool{std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() - 1 : 0} {}
+
+ThreadPool::ThreadPool(const std::size_t threadCount): _state{Containers::InPlaceInit} {
+    _state->queues = Containers::Array<Queue>{threadCount + 1};
+    _state->threads.reserve(threadCount);
+    for(std::size_t i = 0; i != threadCount; ++i)
+        _state->threads.emplace_back(&State::run, _state.get(), i);
+}
+
+ThreadPool::ThreadPool(const ParallelExecutor executor, void* const executorState, const std::size_t jobCount): _state{Containers::InPlaceInit} {
+    CORRADE_ASSERT(executor,
+        "Utility::ThreadPool: executor expected to be non-null", );
+    _state->executor = executor;
+    _state->executorState = executorState;
+    _state->jobCount = jobCount ? jobCount : 1;
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock{_state->mutex};
+        _state->stopping.store(true, std::memory_order_release);
+    }
+    _state->condition.notify_all();
+    for(std::thread& thread: _state->threads) thread.join();
+}
+
+std::size_t ThreadPool::threadCount() const { return _state->threads.size(); }
+
+std::size_t ThreadPool::jobCount() const {
+    return _state->executor ? _state->jobCount : _state->threads.size() + 1;
+}
+
+void ThreadPool::parallelFor(const std::size_t count, std::size_t grainSize, void(*const function)(void*, std::size_t, std::size_t), void* const state) {
+    if(!count) return;
+
+    /* A few parts per job so the workers that finish early can steal the
+       rest */
+    if(!grainSize) {
+        const std::size_t partCount = jobCount()*4;
+        grainSize = (count + partCount - 1)/partCount;
+    }
+
+    /* With an external executor, split the range upfront and let it run the
+       parts */
+    if(_state->executor) {
+        struct Parts {
+            void(*function)(void*, std::size_t, std::size_t);
+            void* state;
+            std::size_t count, grainSize;
+        } parts{function, state, count, grainSize};
+        _state->executor(_state->executorState, (count + grainSize - 1)/grainSize, [](void* partsState, std::size_t i) {
+            const Parts& parts = *static_cast<const Parts*>(partsState);
+            const std::size_t begin = i*parts.grainSize;
+            parts.function(parts.state, begin, begin + parts.grainSize < parts.count ? begin + parts.grainSize : parts.count);
+        }, &parts);
+        return;
+    }
+
+    /* Otherwise put the whole range into the current thread's queue, where
+       it either gets split by this thread or stolen by a worker */
+    std::atomic<std::size_t> pending{1};
+    _state->push(_state->currentQueue(), WorkItem{function, nullptr, state, 0, count, grainSize, &pending});
+    _state->wait(pending);
+}
+
+void ThreadPool::execute(void* const pool, const std::size_t count, void(*const job)(void*, std::size_t), void* const jobState) {
+    struct Job {
+        void(*job)(void*, std::size_t);
+        void* jobState;
+    } data{job, jobState};
+    static_cast<ThreadPool*>(pool)->parallelFor(count, 1, [](void* state, std::size_t begin, std::size_t end) {
+        const Job& data = *static_cast<const Job*>(state);
+        for(std::size_t i = begin; i != end; ++i) data.job(data.jobState, i);
+    }, &data);
+}
+
+struct ThreadPool::TaskGroup::Deferred {
+    void(*function)(void*);
+    void* state;
+};
+
+ThreadPool::TaskGroup::TaskGroup(ThreadPool& pool): _pool(pool), _pending{0} {}
+
+ThreadPool::TaskGroup::~TaskGroup() { wait(); }
+
+void ThreadPool::TaskGroup::run(void(*const function)(void*), void* const state) {
+    /* With an external executor the tasks are deferred to wait() */
+    if(_pool._state->executor) {
+        std::lock_guard<std::mutex> lock{_pool._state->mutex};
+        arrayAppend(_deferred, Containers::InPlaceInit, function, state);
+        return;
+    }
+
+    _pending.fetch_add(1, std::memory_order_relaxed);
+    _pool._state->push(_pool._state->currentQueue(), WorkItem{nullptr, function, state, 0, 1, 1, &_pending});
+}
+
+void ThreadPool::TaskGroup::wait() {
+    State& state = *_pool._state;
+    if(state.executor) {
+        /* Tasks can add more tasks to the group while running, so take the
+           list out first and repeat until there's nothing more */
+        for(;;) {
+            Containers::Array<Deferred> deferred;
+            {
+                std::lock_guard<std::mutex> lock{state.mutex};
+                deferred = std::move(_deferred);
+            }
+            if(deferred.empty()) break;
+
+            state.executor(state.executorState, deferred.size(), [](void* deferredState, std::size_t i) {
+                const Deferred& task = static_cast<const Deferred*>(deferredState)[i];
+                task.function(task.state);
+            }, deferred.data());
+        }
+        return;
+    }
+
+    state.wait(_pending);
+}
+
+}}
@@ -0,0 +1,299 @@
+#ifndef Corrade_Utility_ThreadPool_h
+#define Corrade_Utility_ThreadPool_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if (defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)) || defined(DOXYGEN_GENERATING_OUTPUT)
+/** @file
+ * @brief Class @ref Corrade::Utility::ThreadPool, @ref Corrade::Utility::ThreadPool::TaskGroup
+ * @m_since_latest
+ */
+#endif
+
+#include "Corrade/configure.h"
+
+#if (defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)) || defined(DOXYGEN_GENERATING_OUTPUT)
+#include <atomic>
+#include <type_traits>
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Containers/Pointer.h"
+#include "Corrade/Utility/Utility.h"
+#include "Corrade/Utility/visibility.h"
+
+namespace Corrade { namespace Utility {
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+/* Documented in Algorithms.h, repeated here to avoid including the whole
+   StridedArrayView machinery */
+typedef void(*ParallelExecutor)(void*, std::size_t, void(*)(void*, std::size_t), void*);
+#endif
+
+/**
+@brief Work-stealing thread pool
+@m_since_latest
+
+Executes tasks on a fixed set of worker threads. Each worker has its own task
+queue --- it takes tasks it created itself from the back of its queue, which
+keeps recently touched data in its cache, and when its queue is empty it
+steals from the front of queues of other workers, where the largest remaining
+pieces of work are. Threads that wait for a task to finish don't block but
+execute queued tasks meanwhile, so it's possible to wait from inside a task
+without the risk of a deadlock.
+
+@section Utility-ThreadPool-parallel-for Parallel for
+
+@ref parallelFor() calls a function on subranges of an index range. The range
+is split in halves recursively until the parts are at most @p grainSize
+large, the halves being put to the queue so idle workers can steal them. The
+grain size is a tradeoff between scheduling overhead and load balancing ---
+pass @cpp 0 @ce to pick a grain size that splits the range into a few parts
+per thread:
+
+@snippet Utility.cpp ThreadPool-parallelFor
+
+@section Utility-ThreadPool-task-groups Task groups
+
+A @ref TaskGroup runs independent tasks and waits for all of them to finish,
+either explicitly with @ref TaskGroup::wait() or on destruction.
+
+@section Utility-ThreadPool-executor Interaction with other APIs and external schedulers
+
+Functions taking a @ref ParallelExecutor, such as parallel @ref copy() or
+@ref treeHash(), can run on a thread pool by passing @ref execute() together
+with a pointer to the pool:
+
+@snippet Utility.cpp ThreadPool-execute
+
+Conversely, if the application already has a job system or uses for example
+TBB, a thread pool can be constructed with
+@ref ThreadPool(ParallelExecutor, void*, std::size_t). Such pool doesn't
+create any threads on its own and delegates all work to the external
+executor, so code written against this class doesn't compete for cores with
+it.
+@partialsupport Available only if @ref CORRADE_BUILD_MULTITHREADED is enabled
+    and not on @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten".
+*/
+class CORRADE_UTILITY_EXPORT ThreadPool {
+    public:
+        class TaskGroup;
+
+        /**
+         * @brief Construct with a thread per CPU core
+         *
+         * Creates one thread less than @ref std::thread::hardware_concurrency(),
+         * as the thread waiting for the work to finish participates as well.
+         */
+        explicit ThreadPool();
+
+        /**
+         * @brief Construct with given count of worker threads
+         *
+         * If @p threadCount is @cpp 0 @ce, all work is done on the thread
+         * that waits for it.
+         */
+        explicit ThreadPool(std::size_t threadCount);
+
+        /**
+         * @brief Construct with an external executor
+         * @param executor      Executor, see @ref ParallelExecutor for
+         *      details
+         * @param executorState State passed to the executor
+         * @param jobCount      Count of jobs the executor can run in parallel
+         *
+         * Doesn't create any threads. @ref parallelFor() splits the range
+         * into parts and passes them to @p executor, tasks passed to
+         * @ref TaskGroup::run() are deferred until @ref TaskGroup::wait() and
+         * then passed to @p executor all at once.
+         */
+        explicit ThreadPool(ParallelExecutor executor, void* executorState, std::size_t jobCount);
+
+        /** @brief Copying is not allowed */
+        ThreadPool(const ThreadPool&) = delete;
+
+        /** @brief Moving is not allowed */
+        ThreadPool(ThreadPool&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Expects that there's no work in progress and stops the threads.
+         */
+        ~ThreadPool();
+
+        /** @brief Copying is not allowed */
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /** @brief Moving is not allowed */
+        ThreadPool& operator=(ThreadPool&&) = delete;
+
+        /**
+         * @brief Count of worker threads
+         *
+         * Always @cpp 0 @ce for a pool using an external executor.
+         */
+        std::size_t threadCount() const;
+
+        /**
+         * @brief Count of jobs that can run in parallel
+         *
+         * @ref threadCount() plus one for the waiting thread, or the
+         * @p jobCount passed to @ref ThreadPool(ParallelExecutor, void*, std::size_t).
+         * Useful as the job count for functions taking a
+         * @ref ParallelExecutor.
+         */
+        std::size_t jobCount() const;
+
+        /**
+         * @brief Call a function on subranges of a range in parallel
+         * @param count         Size of the range
+         * @param grainSize     Maximal size of a subrange. If @cpp 0 @ce, a
+         *      size that splits the range into a few parts per job is used.
+         * @param function      Function to call with @p state and begin
+         *      and end of each subrange
+         * @param state         State passed to @p function
+         *
+         * Returns after all subranges are processed. The subranges are
+         * disjoint and cover the whole range, the function is called on them
+         * in unspecified order and from unspecified threads, including the
+         * calling one.
+         */
+        void parallelFor(std::size_t count, std::size_t grainSize, void(*function)(void*, std::size_t, std::size_t), void* state);
+
+        /**
+         * @brief Call a functor on subranges of a range in parallel
+         *
+         * Calls @cpp function(begin, end) @ce for each subrange, see
+         * @ref parallelFor(std::size_t, std::size_t, void(*)(void*, std::size_t, std::size_t), void*)
+         * for details.
+         */
+        template<class F> void parallelFor(std::size_t count, std::size_t grainSize, F&& function) {
+            typedef typename std::remove_reference<F>::type Function;
+            parallelFor(count, grainSize, [](void* state, std::size_t begin, std::size_t end) {
+                (*static_cast<Function*>(state))(begin, end);
+            }, const_cast<typename std::remove_const<Function>::type*>(&function));
+        }
+
+        /**
+         * @brief Executor
+         *
+         * A @ref ParallelExecutor implementation expecting a @ref ThreadPool
+         * instance passed in @p pool. Calls @p job for each index in parallel
+         * using @ref parallelFor() with a grain size of @cpp 1 @ce.
+         */
+        static void execute(void* pool, std::size_t count, void(*job)(void*, std::size_t), void* jobState);
+
+    private:
+        struct State;
+        friend TaskGroup;
+
+        Containers::Pointer<State> _state;
+};
+
+/**
+@brief Task group
+@m_since_latest
+
+Runs independent tasks on a @ref ThreadPool and waits for them to finish:
+
+@snippet Utility.cpp ThreadPool-TaskGroup
+
+The tasks can run other tasks in the same group or in other groups and wait
+for them.
+@partialsupport Available only if @ref CORRADE_BUILD_MULTITHREADED is enabled
+    and not on @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten".
+*/
+class CORRADE_UTILITY_EXPORT ThreadPool::TaskGroup {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * The @p pool is expected to stay in scope for the whole lifetime of
+         * the group.
+         */
+        explicit TaskGroup(ThreadPool& pool);
+
+        /** @brief Copying is not allowed */
+        TaskGroup(const TaskGroup&) = delete;
+
+        /** @brief Moving is not allowed */
+        TaskGroup(TaskGroup&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Calls @ref wait().
+         */
+        ~TaskGroup();
+
+        /** @brief Copying is not allowed */
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        /** @brief Moving is not allowed */
+        TaskGroup& operator=(TaskGroup&&) = delete;
+
+        /**
+         * @brief Run a task
+         *
+         * The @p function is called with @p state from an unspecified thread.
+         * The @p state is expected to stay in scope until @ref wait()
+         * returns.
+         */
+        void run(void(*function)(void*), void* state);
+
+        /**
+         * @brief Run a functor
+         *
+         * Calls @cpp function() @ce from an unspecified thread. Takes an
+         * l-value reference as the @p function is expected to stay in scope
+         * until @ref wait() returns.
+         */
+        template<class F> void run(F& function) {
+            run([](void* state) {
+                (*static_cast<F*>(state))();
+            }, const_cast<typename std::remove_const<F>::type*>(&function));
+        }
+
+        /**
+         * @brief Wait for all tasks to finish
+         *
+         * Executes queued tasks from this or other groups while waiting.
+         */
+        void wait();
+
+    private:
+        struct Deferred;
+
+        ThreadPool& _pool;
+        std::atomic<std::size_t> _pending;
+        Containers::Array<Deferred> _deferred;
+};
+
+}}
+#else
+#error this file is available only on multithreaded builds and not on Emscripten
+#endif
+
+#endif
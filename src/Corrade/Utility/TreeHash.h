@@ -0,0 +1,154 @@
+#ifndef Corrade_Utility_TreeHash_h
+#define Corrade_Utility_TreeHash_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+/** @file
+ * @brief Function @ref Corrade::Utility::treeHash()
+ * @m_since_latest
+ */
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Utility/Algorithms.h"
+#include "Corrade/Utility/Assert.h"
+
+namespace Corrade { namespace Utility {
+
+/**
+@brief Tree hash of a buffer
+@tparam Hash    Hash class, such as @ref Sha1 or @ref XxHash3
+@param data         Data to hash
+@param chunkSize    Size of the leaf chunks
+@m_since_latest
+
+Splits @p data into chunks of @p chunkSize bytes, with the last chunk
+possibly shorter, and combines their digests into a binary
+[Merkle tree](https://en.wikipedia.org/wiki/Merkle_tree). Each leaf digest
+is calculated from a @cpp '\x00' @ce byte followed by the chunk data and each
+inner node from a @cpp '\x01' @ce byte followed by digests of its two
+children. If a level has an odd number of nodes, the last node is passed to
+the next level unchanged. Empty @p data is treated as a single empty chunk.
+The result depends only on @p data and @p chunkSize and is different from the
+digest produced by @p Hash directly. Expects that @p chunkSize is not zero.
+
+The @p Hash is expected to be default-constructible, accept data through
+@cpp operator<<(Containers::ArrayView<const char>) @ce and produce the result
+with a @cpp digest() @ce function. Use the
+@ref treeHash(Containers::ArrayView<const char>, ParallelExecutor, void*, std::size_t, std::size_t)
+overload to hash the chunks in parallel. Large files can be hashed without
+reading them fully to memory using @ref Directory::mapRead():
+
+@snippet Utility.cpp treeHash
+*/
+template<class Hash> typename Hash::Digest treeHash(Containers::ArrayView<const char> data, std::size_t chunkSize = 1024*1024);
+
+/**
+@brief Tree hash of a buffer in parallel
+@m_since_latest
+
+Calculates digests of the leaf chunks on at most @p jobCount jobs through
+@p executor, each hashing a contiguous range of chunks, and then combines
+them on the calling thread. There's just one digest for every @p chunkSize
+bytes so the combining step is negligible compared to hashing the chunks.
+If @p jobCount is less than @cpp 2 @ce or there's just one chunk, the hashing
+is done directly on the calling thread instead. The result is the same as
+with @ref treeHash(Containers::ArrayView<const char>, std::size_t),
+independently of @p jobCount. See @ref ParallelExecutor for more information
+about the executor.
+*/
+template<class Hash> typename Hash::Digest treeHash(Containers::ArrayView<const char> data, ParallelExecutor executor, void* executorState, std::size_t jobCount, std::size_t chunkSize = 1024*1024);
+
+namespace Implementation {
+
+template<class Hash> struct TreeHash {
+    typedef typename Hash::Digest Digest;
+
+    Containers::ArrayView<const char> data;
+    std::size_t chunkSize, chunksPerJob;
+    Containers::ArrayView<Digest> digests;
+
+    static void job(void* state, const std::size_t i) {
+        const TreeHash<Hash>& self = *static_cast<const TreeHash<Hash>*>(state);
+        const std::size_t begin = i*self.chunksPerJob;
+        const std::size_t end = begin + self.chunksPerJob < self.digests.size() ? begin + self.chunksPerJob : self.digests.size();
+        for(std::size_t j = begin; j != end; ++j) {
+            const std::size_t dataBegin = j*self.chunkSize;
+            const std::size_t dataEnd = dataBegin + self.chunkSize < self.data.size() ? dataBegin + self.chunkSize : self.data.size();
+            const char prefix = '\x00';
+            Hash hash;
+            hash << Containers::arrayView(&prefix, 1)
+                 << self.data.slice(dataBegin, dataEnd);
+            self.digests[j] = hash.digest();
+        }
+    }
+
+    /* Combines the leaf digests level by level in-place, returning the root */
+    Digest combine() const {
+        std::size_t count = digests.size();
+        while(count > 1) {
+            for(std::size_t i = 0; i != count/2; ++i) {
+                const char prefix = '\x01';
+                Hash hash;
+                hash << Containers::arrayView(&prefix, 1)
+                     << Containers::arrayView(digests[2*i].byteArray(), Hash::DigestSize)
+                     << Containers::arrayView(digests[2*i + 1].byteArray(), Hash::DigestSize);
+                digests[i] = hash.digest();
+            }
+            if(count % 2) digests[count/2] = digests[count - 1];
+            count = (count + 1)/2;
+        }
+        return digests[0];
+    }
+};
+
+}
+
+template<class Hash> typename Hash::Digest treeHash(const Containers::ArrayView<const char> data, const std::size_t chunkSize) {
+    return treeHash<Hash>(data, nullptr, nullptr, 1, chunkSize);
+}
+
+template<class Hash> typename Hash::Digest treeHash(const Containers::ArrayView<const char> data, ParallelExecutor executor, void* executorState, std::size_t jobCount, const std::size_t chunkSize) {
+    CORRADE_ASSERT(chunkSize,
+        "Utility::treeHash(): chunk size can't be zero", {});
+
+    /* Empty data is a single empty chunk */
+    const std::size_t chunkCount = data.empty() ? 1 : (data.size() + chunkSize - 1)/chunkSize;
+    Containers::Array<typename Hash::Digest> digests{chunkCount};
+
+    /* Not worth parallelizing, hash directly */
+    if(chunkCount < 2 || jobCount < 2) {
+        Implementation::TreeHash<Hash> state{data, chunkSize, chunkCount, digests};
+        Implementation::TreeHash<Hash>::job(&state, 0);
+        return state.combine();
+    }
+
+    if(jobCount > chunkCount) jobCount = chunkCount;
+    Implementation::TreeHash<Hash> state{data, chunkSize, (chunkCount + jobCount - 1)/jobCount, digests};
+    executor(executorState, (chunkCount + state.chunksPerJob - 1)/state.chunksPerJob, Implementation::TreeHash<Hash>::job, &state);
+    return state.combine();
+}
+
+}}
+
+#endif
@@ -25,14 +25,20 @@
 
 #include "Tweakable.h"
 
+#include <algorithm>
 #include <cstring>
-#include <set>
-#include <unordered_map>
+#ifdef CORRADE_BUILD_MULTITHREADED
+#include <mutex>
+#endif
 
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Containers/HashMap.h"
+#include "Corrade/Containers/String.h"
 #include "Corrade/Utility/Assert.h"
 #include "Corrade/Utility/DebugStl.h"
 #include "Corrade/Utility/Directory.h"
-#include "Corrade/Utility/FileWatcher.h"
+#include "Corrade/Utility/FileWatcherSet.h"
+#include "Corrade/Utility/Profiler.h"
 #include "Corrade/Utility/String.h"
 
 #include "Corrade/Utility/Implementation/tweakable.h"
@@ -43,21 +49,102 @@ namespace {
     Tweakable* globalInstance = nullptr;
 
     struct File {
+        std::string filename;
         std::string watchPath;
-        FileWatcher watcher;
         std::vector<Implementation::TweakableVariable> variables;
+        Implementation::TweakableParseCache parsed;
+    };
+
+    /* Open-addressing hash table mapping the __FILE__ pointer and
+       __COUNTER__ of a tweakable constant to its value. Filled under a lock,
+       looked up without. A slot is published by storing the file pointer
+       last, which never changes afterwards. */
+    struct ValueSlot {
+        std::atomic<const char*> file;
+        std::atomic<std::size_t> variable;
+        std::atomic<Implementation::TweakableValue*> value;
+    };
+
+    struct ValueTable {
+        explicit ValueTable(std::size_t size): slots{Containers::ValueInit, size} {}
+
+        Containers::Array<ValueSlot> slots;
+        std::size_t used{};
     };
+
+    std::size_t valueHash(const char* const file, const std::size_t variable) {
+        std::size_t hash = std::size_t(reinterpret_cast<std::uintptr_t>(file)) ^ (variable*2654435761u);
+        return hash ^ (hash >> 16);
+    }
+
+    Implementation::TweakableValue* findValue(const ValueTable& table, const char* const file, const std::size_t variable) {
+        const std::size_t mask = table.slots.size() - 1;
+        for(std::size_t i = valueHash(file, variable) & mask; ; i = (i + 1) & mask) {
+            const ValueSlot& slot = table.slots[i];
+            const char* const slotFile = slot.file.load(std::memory_order_acquire);
+            if(!slotFile) return nullptr;
+            if(slotFile == file && slot.variable.load(std::memory_order_relaxed) == variable)
+                return slot.value.load(std::memory_order_relaxed);
+        }
+    }
+
+    void insertValue(ValueTable& table, const char* const file, const std::size_t variable, Implementation::TweakableValue* const value) {
+        const std::size_t mask = table.slots.size() - 1;
+        for(std::size_t i = valueHash(file, variable) & mask; ; i = (i + 1) & mask) {
+            ValueSlot& slot = table.slots[i];
+            if(slot.file.load(std::memory_order_relaxed)) continue;
+            slot.variable.store(variable, std::memory_order_relaxed);
+            slot.value.store(value, std::memory_order_relaxed);
+            slot.file.store(file, std::memory_order_release);
+            ++table.used;
+            return;
+        }
+    }
+
+    /* Scope that's currently being executed. Thread-local so scopes executed
+       on different threads don't get mixed up. */
+    struct CurrentScope {
+        void(*lambda)(void(*)(), void*);
+        void(*userCall)();
+        void* userData;
+    };
+
+    #ifdef CORRADE_BUILD_MULTITHREADED
+    CORRADE_THREAD_LOCAL
+    #endif
+    CurrentScope currentScope{};
 }
 
 struct Tweakable::Data {
     explicit Data(const std::string& prefix, const std::string& replace): prefix{prefix}, replace{replace} {}
 
     std::string prefix, replace;
-    std::unordered_map<std::string, File> files;
-
-    void(*currentScopeLambda)(void(*)(), void*) = nullptr;
-    void(*currentScopeUserCall)() = nullptr;
-    void* currentScopeUserData = nullptr;
+    /* Watched files, indexed by watcher ID, and a map from the __FILE__
+       string to an index into it. Looked up by a view, so finding an
+       already known file doesn't allocate. */
+    std::vector<File> files;
+    Containers::HashMap<Containers::String, std::size_t> fileIds;
+
+    /* Ignore errors and do not signal changes if the file is empty in order
+       to make everything more robust -- editors are known to be doing both.
+       Files that were only touched, for example by a build system or a
+       checkout, are not read and parsed again. */
+    FileWatcherSet watchers{FileWatcher::Flag::IgnoreChangeIfEmpty|FileWatcher::Flag::IgnoreErrors|FileWatcher::Flag::CheckContents};
+    /* Scopes affected by an update, kept here to reuse the allocation */
+    std::vector<Implementation::TweakableScope> scopes;
+
+    /* Guards everything except the value lookup and the values
+       themselves */
+    #ifdef CORRADE_BUILD_MULTITHREADED
+    std::mutex mutex;
+    #endif
+    /* Published values of all registered variables */
+    std::vector<Containers::Pointer<Implementation::TweakableValue>> values;
+    /* Lookup table of the values. When it gets too full, a bigger copy is
+       made and the previous stays alive as other threads may still be
+       reading from it. */
+    std::atomic<ValueTable*> table{};
+    std::vector<Containers::Pointer<ValueTable>> tables;
 };
 
 Tweakable& Tweakable::instance() {
@@ -79,33 +166,43 @@ void Tweakable::enable() { Tweakable::enable({}, {}); }
 
 void Tweakable::enable(const std::string& prefix, const std::string& replace) {
     _data.reset(new Data{prefix, replace});
+    _data->tables.emplace_back(new ValueTable{64});
+    _data->table.store(_data->tables.back().get(), std::memory_order_release);
 }
 
 void Tweakable::scopeInternal(void(*lambda)(void(*)(), void*), void(*userCall)(), void* userData) {
-    if(_data) {
-        _data->currentScopeLambda = lambda;
-        _data->currentScopeUserCall = userCall;
-        _data->currentScopeUserData = userData;
-    }
+    if(_data) currentScope = {lambda, userCall, userData};
 
     lambda(userCall, userData);
 
-    if(_data) {
-        _data->currentScopeLambda = nullptr;
-        _data->currentScopeUserCall = nullptr;
-        _data->currentScopeUserData = nullptr;
-    }
+    if(_data) currentScope = {};
 }
 
-std::pair<bool, void*> Tweakable::registerVariable(const char* const file, const int line, const std::size_t variable, TweakableState(*parser)(Containers::ArrayView<const char>, Containers::StaticArrayView<Implementation::TweakableStorageSize, char>)) {
+void Tweakable::readVariable(const char* const file, const int line, const std::size_t variable, TweakableState(*parser)(Containers::ArrayView<const char>, Containers::StaticArrayView<Implementation::TweakableStorageSize, char>), const void* const value, const std::size_t size, char* const out) {
     CORRADE_INTERNAL_ASSERT(_data);
 
+    /* Fast path without locking if the variable is already registered */
+    Implementation::TweakableValue* found = findValue(*_data->table.load(std::memory_order_acquire), file, variable);
+    if(!found) found = registerVariable(file, line, variable, parser, value, size);
+
+    Implementation::readTweakableValue(*found, out);
+}
+
+Implementation::TweakableValue* Tweakable::registerVariable(const char* const file, const int line, const std::size_t variable, TweakableState(*parser)(Containers::ArrayView<const char>, Containers::StaticArrayView<Implementation::TweakableStorageSize, char>), const void* const value, const std::size_t size) {
+    #ifdef CORRADE_BUILD_MULTITHREADED
+    std::lock_guard<std::mutex> lock{_data->mutex};
+    #endif
+
+    /* Another thread might have registered it in the meantime */
+    ValueTable* table = _data->table.load(std::memory_order_relaxed);
+    if(Implementation::TweakableValue* found = findValue(*table, file, variable))
+        return found;
+
     /* Find the file in the map */
-    /** @todo this allocates and copies the string. std::map::find() in C++14
-        has an overload that allows a zero-allocation lookup, but
-        std::unordered_map has that only since C++17. */
-    auto found = _data->files.find(file);
-    if(found == _data->files.end()) {
+    std::size_t fileId;
+    if(const std::size_t* const found = _data->fileIds.find(file)) {
+        fileId = *found;
+    } else {
         /* Strip the directory prefix from the file. If that means the filename
            would then start with a slash, strip that too so Directory::join()
            works correctly -- but don't do that in case the directory prefix
@@ -118,33 +215,79 @@ std::pair<bool, void*> Tweakable::registerVariable(const char* const file, const
         const std::string watchPath = Directory::join(_data->replace, stripped);
 
         Debug{} << "Utility::Tweakable: watching for changes in" << watchPath;
-        /* Ignore errors and do not signal changes if the file is empty in
-           order to make everything more robust -- editors are known to be
-           doing both */
-        found = _data->files.emplace(file, File{watchPath, FileWatcher{watchPath, FileWatcher::Flag::IgnoreChangeIfEmpty|FileWatcher::Flag::IgnoreErrors}, {}}).first;
+        fileId = _data->files.size();
+        _data->files.push_back(File{file, watchPath, {}, {}});
+        _data->fileIds.insert(file, fileId);
+        _data->watchers.add(watchPath);
     }
 
     /* Extend the variable list to contain this one as well */
-    if(found->second.variables.size() <= variable)
-        found->second.variables.resize(variable + 1);
-
-    /* Save the variable, if not already */
-    Implementation::TweakableVariable& v = found->second.variables[variable];
-    bool initialized = true;
+    File& fileData = _data->files[fileId];
+    if(fileData.variables.size() <= variable)
+        fileData.variables.resize(variable + 1);
+
+    /* Save the variable together with its initial value, if not already.
+       It might be if the same file was referenced through a different
+       __FILE__ pointer before. */
+    Implementation::TweakableVariable& v = fileData.variables[variable];
     if(!v.parser) {
-        initialized = false;
         v.line = line;
         v.parser = parser;
-        v.scopeLambda = _data->currentScopeLambda;
-        v.scopeUserCall = _data->currentScopeUserCall;
-        v.scopeUserData = _data->currentScopeUserData;
+        v.scopeLambda = currentScope.lambda;
+        v.scopeUserCall = currentScope.userCall;
+        v.scopeUserData = currentScope.userData;
+        std::memcpy(v.storage, value, size);
+        _data->values.emplace_back(new Implementation::TweakableValue);
+        v.value = _data->values.back().get();
+        Implementation::publishTweakableValue(*v.value, v.storage);
+    }
+
+    /* Add it to the lookup table, making a bigger copy of the table first if
+       it would get more than half full */
+    if(2*(table->used + 1) > table->slots.size()) {
+        _data->tables.emplace_back(new ValueTable{2*table->slots.size()});
+        ValueTable* const bigger = _data->tables.back().get();
+        for(const ValueSlot& slot: table->slots) {
+            if(const char* const slotFile = slot.file.load(std::memory_order_relaxed))
+                insertValue(*bigger, slotFile, slot.variable.load(std::memory_order_relaxed), slot.value.load(std::memory_order_relaxed));
+        }
+        _data->table.store(bigger, std::memory_order_release);
+        table = bigger;
     }
+    insertValue(*table, file, variable, v.value);
 
-    return {initialized, v.storage};
+    return v.value;
 }
 
 namespace Implementation {
 
+void publishTweakableValue(TweakableValue& value, const char* const data) {
+    /* Mark the value as being written, then write, then mark it as done */
+    const std::uint32_t epoch = value.epoch.load(std::memory_order_relaxed);
+    value.epoch.store(epoch + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for(std::size_t i = 0; i != TweakableStorageSize/8; ++i) {
+        std::uint64_t word;
+        std::memcpy(&word, data + i*8, 8);
+        value.storage[i].store(word, std::memory_order_relaxed);
+    }
+    value.epoch.store(epoch + 2, std::memory_order_release);
+}
+
+void readTweakableValue(const TweakableValue& value, char* const out) {
+    /* Retry the copy if a write was in progress or happened during it */
+    std::uint64_t words[TweakableStorageSize/8];
+    for(;;) {
+        const std::uint32_t epoch = value.epoch.load(std::memory_order_acquire);
+        if(epoch & 1) continue;
+        for(std::size_t i = 0; i != TweakableStorageSize/8; ++i)
+            words[i] = value.storage[i].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(value.epoch.load(std::memory_order_relaxed) == epoch) break;
+    }
+    std::memcpy(out, words, sizeof(words));
+}
+
 namespace {
     /* This doesn't eat newlines ATM because it would break the line counter.
        Also, for findTweakableAlias(), it *can't* eat newlines. */
@@ -205,7 +348,13 @@ std::string findTweakableAlias(const std::string& data) {
     return name;
 }
 
-TweakableState parseTweakables(const std::string& name, const std::string& filename, const std::string& data, std::vector<TweakableVariable>& variables, std::set<std::tuple<void(*)(void(*)(), void*), void(*)(), void*>>& scopes) {
+namespace {
+
+/* Parses the file starting at pos, which has to be either the file start or
+   the end of an annotation. If previous is not null, stops at the first
+   annotation ending at or after stop that matches with the one at the same
+   position in the previous parse, copying the remaining ones from there. */
+TweakableState parseTweakablesFrom(const std::string& name, const std::string& filename, const std::string& data, std::vector<TweakableVariable>& variables, std::vector<TweakableScope>& scopes, std::size_t pos, int line, std::size_t variable, const TweakableParseCache* const previous, const std::size_t stop, std::vector<TweakableAnnotation>& annotations) {
     /* Prepare "matchers" */
     CORRADE_INTERNAL_ASSERT(!name.empty());
     const char findAnything[] = { '/', '\'', '"', '\n', name[0], 0 };
@@ -215,10 +364,6 @@ TweakableState parseTweakables(const std::string& name, const std::string& filen
     constexpr const char findCharEnd[] = "\n'";
     constexpr const char findRawStringEnd[] = "\n)";
 
-    /* Count the lines, count the variables */
-    int line = 1;
-    std::size_t variable = 0;
-
     /* State controlling which matchers we use */
     bool insideLineComment = false;
     bool insideBlockComment = false;
@@ -231,7 +376,6 @@ TweakableState parseTweakables(const std::string& name, const std::string& filen
     std::size_t rawStringEndDelimiterLength = 0;
 
     /* Parse the file */
-    std::size_t pos = 0;
     const char* find = findAnything;
     TweakableState state = TweakableState::NoChange;
     while((pos = data.find_first_of(find, pos)) != std::string::npos) {
@@ -559,11 +703,34 @@ TweakableState parseTweakables(const std::string& name, const std::string& filen
                 if(variableState != TweakableState::NoChange) {
                     CORRADE_INTERNAL_ASSERT(variableState == TweakableState::Success);
                     Debug{} << "Utility::Tweakable::update(): updating" << data.substr(pos, end - pos) << "in" << filename << Debug::nospace << ":" << Debug::nospace << line;
-                    if(v.scopeLambda) scopes.emplace(v.scopeLambda, v.scopeUserCall, v.scopeUserData);
+                    if(v.value) publishTweakableValue(*v.value, v.storage);
+                    if(v.scopeLambda) {
+                        const TweakableScope scope{v.scopeLambda, v.scopeUserCall, v.scopeUserData};
+                        const auto found = std::lower_bound(scopes.begin(), scopes.end(), scope);
+                        if(found == scopes.end() || *found != scope)
+                            scopes.insert(found, scope);
+                    }
                     state = TweakableState::Success;
                 }
             }
 
+            /* Remember where the annotation ended so the next parse can
+               restart from here */
+            annotations.push_back({end, line, variable < variables.size() && variables[variable].parser});
+
+            /* If we're past the changed part of the file and this annotation
+               is at the same place as in the previous parse, the rest of the
+               file is the same as before. Take the rest of the annotations
+               from there, with their positions shifted. */
+            if(previous && end >= stop && variable < previous->annotations.size() && previous->annotations[variable].end + data.size() == end + previous->data.size() && previous->annotations[variable].line == line) {
+                for(std::size_t i = variable + 1; i != previous->annotations.size(); ++i) {
+                    TweakableAnnotation annotation = previous->annotations[i];
+                    annotation.end = annotation.end + data.size() - previous->data.size();
+                    annotations.push_back(annotation);
+                }
+                return state;
+            }
+
             /* Increase variable ID for the next round to match __COUNTER__,
                update pos to restart the search after this variable */
             pos = end;
@@ -596,42 +763,127 @@ TweakableState parseTweakables(const std::string& name, const std::string& filen
 
 }
 
+TweakableState parseTweakables(const std::string& name, const std::string& filename, const std::string& data, std::vector<TweakableVariable>& variables, std::vector<TweakableScope>& scopes, TweakableParseCache* const cache) {
+    std::size_t pos = 0;
+    int line = 1;
+    std::size_t variable = 0;
+    const TweakableParseCache* previous = nullptr;
+    std::size_t stop = 0;
+    std::vector<TweakableAnnotation> annotations;
+
+    /* The previous parse can be reused only if it was done with the same
+       alias and the set of variables known to the application didn't change
+       since -- otherwise a value that was ignored before may need to be
+       picked up now */
+    bool reuse = cache && !cache->data.empty() && cache->name == name;
+    if(reuse) for(std::size_t i = 0; i != cache->annotations.size(); ++i) {
+        if(cache->annotations[i].known != (i < variables.size() && variables[i].parser)) {
+            reuse = false;
+            break;
+        }
+    }
+
+    if(reuse) {
+        /* Nothing changed, nothing to do */
+        if(data == cache->data) return TweakableState::NoChange;
+
+        /* Find where the changed part begins and ends */
+        const std::size_t size = std::min(data.size(), cache->data.size());
+        std::size_t prefix = 0;
+        while(prefix != size && data[prefix] == cache->data[prefix]) ++prefix;
+        std::size_t suffix = 0;
+        while(suffix != size - prefix && data[data.size() - suffix - 1] == cache->data[cache->data.size() - suffix - 1]) ++suffix;
+
+        /* Restart from the last annotation that ends before the change. The
+           parser state right after an annotation is always clean, so that's
+           the same as if the file was parsed from the start. */
+        const auto found = std::upper_bound(cache->annotations.begin(), cache->annotations.end(), prefix,
+            [](std::size_t offset, const TweakableAnnotation& annotation) {
+                return offset < annotation.end;
+            });
+        if(found != cache->annotations.begin()) {
+            pos = (found - 1)->end;
+            line = (found - 1)->line;
+            variable = found - cache->annotations.begin();
+            annotations.assign(cache->annotations.begin(), found);
+        }
+
+        /* If the changed part has the same amount of lines as before, the
+           unchanged annotations after it are on the same lines as well and
+           the parse can stop once it gets to them */
+        if(std::count(data.begin() + prefix, data.end() - suffix, '\n') == std::count(cache->data.begin() + prefix, cache->data.end() - suffix, '\n')) {
+            previous = cache;
+            stop = data.size() - suffix;
+        }
+    }
+
+    const TweakableState state = parseTweakablesFrom(name, filename, data, variables, scopes, pos, line, variable, previous, stop, annotations);
+
+    /* Remember the parse only if it was successful, the next parse has to
+       start from scratch otherwise */
+    if(cache) {
+        if(state == TweakableState::NoChange || state == TweakableState::Success) {
+            cache->name = name;
+            cache->data = data;
+            cache->annotations.swap(annotations);
+        } else {
+            cache->data.clear();
+            cache->annotations.clear();
+        }
+    }
+
+    return state;
+}
+
+}
+
 TweakableState Tweakable::update() {
+    CORRADE_PROFILE_SCOPE("Utility::Tweakable::update()");
+
     if(!_data) return TweakableState::NoChange;
 
-    /* Set of unique scopes that have to be re-run after variable updates.
-       Using a classic set with a tuple so it does all the and comparison for
-       me. STL is good sometimes. Can't use unordered_set because tuple doesn't
-       have a hash specialization. */
-    std::set<std::tuple<void(*)(void(*)(), void*), void(*)(), void*>> scopes;
+    /* Sorted array of unique scopes that have to be re-run after variable
+       updates. Reused across updates to avoid allocating every time. */
+    std::vector<Implementation::TweakableScope>& scopes = _data->scopes;
+    scopes.clear();
 
-    /* Go through all watchers and check for changes */
+    /* Go through all changed files. Variable registration is blocked while
+       doing so, but the lock gets released before calling the scopes as
+       those may register new variables. */
     TweakableState state = TweakableState::NoChange;
-    for(auto& file: _data->files) {
+    {
+        #ifdef CORRADE_BUILD_MULTITHREADED
+        std::lock_guard<std::mutex> lock{_data->mutex};
+        #endif
+
         /** @todo suggest recompile if the watcher is not valid anymore */
-        if(!file.second.watcher.hasChanged()) continue;
-
-        /* First go through all defines and search if there is any alias. There
-           shouldn't be many. If no alias is found, assume CORRADE_TWEAKABLE. */
-        const std::string data = Directory::readString(file.second.watchPath);
-        std::string name = Implementation::findTweakableAlias(data);
-
-        /* Print helpful message in case no alias was found. Don't do name ==
-           "CORRADE_TWEAKABLE" to avoid a temporary allocation of std::string.
-           (Ugh, why can't it have an overload for this?!) */
-        if(name.compare("CORRADE_TWEAKABLE") == 0)
-            Warning{} << "Utility::Tweakable::update(): no alias found in" << file.first << Debug::nospace << ", fallback to looking for CORRADE_TWEAKABLE()";
-        else
-            Debug{} << "Utility::Tweakable::update(): looking for updated" << name << Debug::nospace << "() macros in" << file.first;
-
-        /* Now find all annotated constants and update them. If there's a
-           problem, exit immediately, otherwise just accumulate the state. */
-        const TweakableState fileState = Implementation::parseTweakables(name, file.first, data, file.second.variables, scopes);
-        if(fileState == TweakableState::NoChange)
-            continue;
-        else if(fileState == TweakableState::Success)
-            state = TweakableState::Success;
-        else return fileState;
+        for(const std::size_t id: _data->watchers.changed()) {
+            File& file = _data->files[id];
+
+            /* First go through all defines and search if there is any alias.
+               There shouldn't be many. If no alias is found, assume
+               CORRADE_TWEAKABLE. */
+            const std::string data = Directory::readString(file.watchPath);
+            std::string name = Implementation::findTweakableAlias(data);
+
+            /* Print helpful message in case no alias was found. Don't do
+               name == "CORRADE_TWEAKABLE" to avoid a temporary allocation of
+               std::string. (Ugh, why can't it have an overload for this?!) */
+            if(name.compare("CORRADE_TWEAKABLE") == 0)
+                Warning{} << "Utility::Tweakable::update(): no alias found in" << file.filename << Debug::nospace << ", fallback to looking for CORRADE_TWEAKABLE()";
+            else
+                Debug{} << "Utility::Tweakable::update(): looking for updated" << name << Debug::nospace << "() macros in" << file.filename;
+
+            /* Now find all annotated constants and update them. If there's
+               a problem, exit immediately, otherwise just accumulate the
+               state. */
+            const TweakableState fileState = Implementation::parseTweakables(name, file.filename, data, file.variables, scopes, &file.parsed);
+            if(fileState == TweakableState::NoChange)
+                continue;
+            else if(fileState == TweakableState::Success)
+                state = TweakableState::Success;
+            else return fileState;
+        }
     }
 
     if(!scopes.empty()) {
@@ -42,6 +42,8 @@ namespace Corrade { namespace Utility {
 
 namespace Implementation {
     enum: std::size_t { TweakableStorageSize = 16 };
+
+    struct TweakableValue;
 }
 
 /**
@@ -155,7 +157,18 @@ This is not magic, so it comes with a few limitations:
 -   For simplicity of the implementation, comments are not allowed *inside* the
     tweakable macros, only whitespace.
 
-At the moment, the implementation is *not* thread-safe.
+@section Utility-Tweakable-multithreading Thread safety
+
+If @ref CORRADE_BUILD_MULTITHREADED is enabled, tweakable constants can be
+read from any thread. Once a constant is executed for the first time, reading
+it doesn't lock and doesn't allocate --- the value is looked up in a lock-free
+table and copied out of a per-constant storage guarded by an epoch counter,
+retrying the copy if @ref update() replaced the value in the meantime. The
+first execution of a constant and @ref update() are serialized with a mutex.
+The @ref enable() function is expected to be called before any constants are
+read from other threads, @ref update() isn't meant to be called concurrently
+with itself and scopes affected by an update are called on the thread that
+called @ref update().
 
 @section Utility-Tweakable-how-it-works How it works
 
@@ -164,7 +177,9 @@ class remembers its file, line and index (in order to correctly handle multiple
 literals on a single line) when the code is first executed, together with a
 @ref TweakableParser instance corresponding to type of the literal known at
 compile time. Affected source files are then monitored with @ref FileWatcher
-for changes
+for changes. Files that got only touched without their contents changing, for
+example by a build system, are not parsed again, see
+@ref FileWatcher::Flag::CheckContents.
 
 Upon calling @ref update(), modified files are parsed for occurences of the
 defined macro and arguments of each macro call are parsed at runtime. If there
@@ -342,7 +357,8 @@ class CORRADE_UTILITY_EXPORT Tweakable {
     private:
         struct Data;
 
-        std::pair<bool, void*> registerVariable(const char* file, int line, std::size_t variable, TweakableState(*parser)(Containers::ArrayView<const char>, Containers::StaticArrayView<Implementation::TweakableStorageSize, char>));
+        void readVariable(const char* file, int line, std::size_t variable, TweakableState(*parser)(Containers::ArrayView<const char>, Containers::StaticArrayView<Implementation::TweakableStorageSize, char>), const void* value, std::size_t size, char* out);
+        Implementation::TweakableValue* registerVariable(const char* file, int line, std::size_t variable, TweakableState(*parser)(Containers::ArrayView<const char>, Containers::StaticArrayView<Implementation::TweakableStorageSize, char>), const void* value, std::size_t size);
 
         void scopeInternal(void(*lambda)(void(*)(), void*), void(*userCall)(), void* userData);
 
@@ -415,12 +431,11 @@ template<class T> T Tweakable::operator()(const char* file, int line, int variab
     if(!_data) return value;
 
     /* This function registers the variable, if not already, saving the
-       file/line/counter, parser and getter function pointer. Returns a
-       reference to the internal storage, which may not be initialized yet, in
-       which case we save the initial value to it. */
-    std::pair<bool, void*> registered = registerVariable(file, line, variable, Implementation::TweakableTraits<T>::parse);
-    if(!registered.first) *static_cast<T*>(registered.second) = value;
-    return *static_cast<T*>(registered.second);
+       file/line/counter, parser and the passed value as the initial one.
+       Then it copies the current value out. */
+    CORRADE_ALIGNAS(8) char out[Implementation::TweakableStorageSize];
+    readVariable(file, line, variable, Implementation::TweakableTraits<T>::parse, &value, sizeof(T), out);
+    return *reinterpret_cast<T*>(out);
 }
 
 }}
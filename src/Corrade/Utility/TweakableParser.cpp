@@ -29,6 +29,7 @@
 #include <algorithm>
 
 #include "Corrade/Utility/DebugStl.h" /** @todo get rid of this */
+#include "Corrade/Utility/Parse.h"
 #include "Corrade/Utility/String.h"
 #include "Corrade/Utility/Tweakable.h"
 
@@ -44,12 +45,35 @@ namespace {
             return {value + 1, 8};
         return {value, 10};
     }
+
+    /* The number parsers don't accept a plus sign, unlike strtol() */
+    Containers::ArrayView<const char> withoutPlusSign(const Containers::ArrayView<const char> value) {
+        return !value.empty() && value[0] == '+' ? value.suffix(1) : value;
+    }
+
+    /* Returns a pointer after the parsed digits or the value begin if there
+       are no digits */
+    template<class T> const char* parseInteger(const Containers::ArrayView<const char> value, T& result) {
+        const Containers::ArrayView<const char> digits = withoutPlusSign(value);
+        const std::pair<const char*, int> valueBase = integerBase(digits);
+        result = T{};
+        const std::size_t size = parseNumber({valueBase.first, std::size_t(value.end() - valueBase.first)}, result, valueBase.second);
+        if(!size && valueBase.first == digits.begin()) return value.begin();
+        return valueBase.first + size;
+    }
+
+    template<class T> const char* parseFloatingPoint(const Containers::ArrayView<const char> value, T& result) {
+        const Containers::ArrayView<const char> digits = withoutPlusSign(value);
+        result = T{};
+        const std::size_t size = parseNumber(digits, result);
+        if(!size) return value.begin();
+        return digits.begin() + size;
+    }
 }
 
 std::pair<TweakableState, int> TweakableParser<int>::parse(Containers::ArrayView<const char> value) {
-    const std::pair<const char*, int> valueBase = integerBase(value);
-    char* end;
-    const int result = std::strtol(valueBase.first, &end, valueBase.second);
+    int result;
+    const char* const end = parseInteger(value, result);
 
     if(end == value.begin()) {
         Warning{} << "Utility::TweakableParser:" << std::string{value, value.size()} << "is not an integer literal";
@@ -57,7 +81,7 @@ std::pair<TweakableState, int> TweakableParser<int>::parse(Containers::ArrayView
     }
 
     if(end != value.end()) {
-        Warning{} << "Utility::TweakableParser: unexpected characters" << std::string{const_cast<const char*>(end), value.end()} <<  "after an integer literal";
+        Warning{} << "Utility::TweakableParser: unexpected characters" << std::string{end, value.end()} <<  "after an integer literal";
         return {TweakableState::Recompile, {}};
     }
 
@@ -65,9 +89,8 @@ std::pair<TweakableState, int> TweakableParser<int>::parse(Containers::ArrayView
 }
 
 std::pair<TweakableState, unsigned int> TweakableParser<unsigned int>::parse(Containers::ArrayView<const char> value) {
-    const std::pair<const char*, int> valueBase = integerBase(value);
-    char* end;
-    const unsigned int result = std::strtoul(valueBase.first, &end, valueBase.second);
+    unsigned int result;
+    const char* const end = parseInteger(value, result);
 
     if(end == value.begin()) {
         Warning{} << "Utility::TweakableParser:" << std::string{value, value.size()} << "is not an integer literal";
@@ -81,7 +104,7 @@ std::pair<TweakableState, unsigned int> TweakableParser<unsigned int>::parse(Con
     }
 
     if(end != value.end() - 1) {
-        Warning{} << "Utility::TweakableParser: unexpected characters" << std::string{const_cast<const char*>(end), value.end()} <<  "after an integer literal";
+        Warning{} << "Utility::TweakableParser: unexpected characters" << std::string{end, value.end()} <<  "after an integer literal";
         return {TweakableState::Recompile, {}};
     }
 
@@ -89,9 +112,8 @@ std::pair<TweakableState, unsigned int> TweakableParser<unsigned int>::parse(Con
 }
 
 std::pair<TweakableState, long> TweakableParser<long>::parse(Containers::ArrayView<const char> value) {
-    const std::pair<const char*, int> valueBase = integerBase(value);
-    char* end;
-    const long result = std::strtol(valueBase.first, &end, valueBase.second);
+    long result;
+    const char* const end = parseInteger(value, result);
 
     if(end == value.begin()) {
         Warning{} << "Utility::TweakableParser:" << std::string{value, value.size()} << "is not an integer literal";
@@ -105,7 +127,7 @@ std::pair<TweakableState, long> TweakableParser<long>::parse(Containers::ArrayVi
     }
 
     if(end != value.end() - 1) {
-        Warning{} << "Utility::TweakableParser: unexpected characters" << std::string{const_cast<const char*>(end), value.end()} <<  "after an integer literal";
+        Warning{} << "Utility::TweakableParser: unexpected characters" << std::string{end, value.end()} <<  "after an integer literal";
         return {TweakableState::Recompile, {}};
     }
 
@@ -113,9 +135,8 @@ std::pair<TweakableState, long> TweakableParser<long>::parse(Containers::ArrayVi
 }
 
 std::pair<TweakableState, unsigned long> TweakableParser<unsigned long>::parse(Containers::ArrayView<const char> value) {
-    const std::pair<const char*, int> valueBase = integerBase(value);
-    char* end;
-    const unsigned long result = std::strtoul(valueBase.first, &end, valueBase.second);
+    unsigned long result;
+    const char* const end = parseInteger(value, result);
 
     if(end == value.begin()) {
         Warning{} << "Utility::TweakableParser:" << std::string{value, value.size()} << "is not an integer literal";
@@ -131,7 +152,7 @@ std::pair<TweakableState, unsigned long> TweakableParser<unsigned long>::parse(C
     }
 
     if(end != value.end() - 2) {
-        Warning{} << "Utility::TweakableParser: unexpected characters" << std::string{const_cast<const char*>(end), value.end()} <<  "after an integer literal";
+        Warning{} << "Utility::TweakableParser: unexpected characters" << std::string{end, value.end()} <<  "after an integer literal";
         return {TweakableState::Recompile, {}};
     }
 
@@ -139,9 +160,8 @@ std::pair<TweakableState, unsigned long> TweakableParser<unsigned long>::parse(C
 }
 
 std::pair<TweakableState, long long> TweakableParser<long long>::parse(Containers::ArrayView<const char> value) {
-    const std::pair<const char*, int> valueBase = integerBase(value);
-    char* end;
-    const long long result = std::strtoll(valueBase.first, &end, valueBase.second);
+    long long result;
+    const char* const end = parseInteger(value, result);
 
     if(end == value.begin()) {
         Warning{} << "Utility::TweakableParser:" << std::string{value, value.size()} << "is not an integer literal";
@@ -157,7 +177,7 @@ std::pair<TweakableState, long long> TweakableParser<long long>::parse(Container
     }
 
     if(end != value.end() - 2) {
-        Warning{} << "Utility::TweakableParser: unexpected characters" << std::string{const_cast<const char*>(end), value.end()} <<  "after an integer literal";
+        Warning{} << "Utility::TweakableParser: unexpected characters" << std::string{end, value.end()} <<  "after an integer literal";
         return {TweakableState::Recompile, {}};
     }
 
@@ -165,9 +185,8 @@ std::pair<TweakableState, long long> TweakableParser<long long>::parse(Container
 }
 
 std::pair<TweakableState, unsigned long long> TweakableParser<unsigned long long>::parse(Containers::ArrayView<const char> value) {
-    const std::pair<const char*, int> valueBase = integerBase(value);
-    char* end;
-    const int result = std::strtoull(valueBase.first, &end, valueBase.second);
+    unsigned long long result;
+    const char* const end = parseInteger(value, result);
 
     if(end == value.begin()) {
         Warning{} << "Utility::TweakableParser:" << std::string{value, value.size()} << "is not an integer literal";
@@ -184,7 +203,7 @@ std::pair<TweakableState, unsigned long long> TweakableParser<unsigned long long
     }
 
     if(end != value.end() - 3) {
-        Warning{} << "Utility::TweakableParser: unexpected characters" << std::string{const_cast<const char*>(end), value.end()} <<  "after an integer literal";
+        Warning{} << "Utility::TweakableParser: unexpected characters" << std::string{end, value.end()} <<  "after an integer literal";
         return {TweakableState::Recompile, {}};
     }
 
@@ -192,8 +211,8 @@ std::pair<TweakableState, unsigned long long> TweakableParser<unsigned long long
 }
 
 std::pair<TweakableState, float> TweakableParser<float>::parse(Containers::ArrayView<const char> value) {
-    char* end;
-    const float result = std::strtof(value, &end);
+    float result;
+    const char* const end = parseFloatingPoint(value, result);
 
     if(end == value.begin() || std::find(value.begin(), value.end(), '.') == value.end()) {
         Warning{} << "Utility::TweakableParser:" << std::string{value, value.size()} << "is not a floating-point literal";
@@ -207,7 +226,7 @@ std::pair<TweakableState, float> TweakableParser<float>::parse(Containers::Array
     }
 
     if(end != value.end() - 1) {
-        Warning{} << "Utility::TweakableParser: unexpected characters" << std::string{const_cast<const char*>(end), value.end()} <<  "after a floating-point literal";
+        Warning{} << "Utility::TweakableParser: unexpected characters" << std::string{end, value.end()} <<  "after a floating-point literal";
         return {TweakableState::Recompile, {}};
     }
 
@@ -215,8 +234,8 @@ std::pair<TweakableState, float> TweakableParser<float>::parse(Containers::Array
 }
 
 std::pair<TweakableState, double> TweakableParser<double>::parse(Containers::ArrayView<const char> value) {
-    char* end;
-    const double result = std::strtod(value, &end);
+    double result;
+    const char* const end = parseFloatingPoint(value, result);
 
     if(end == value.begin() || std::find(value.begin(), value.end(), '.') == value.end()) {
         Warning{} << "Utility::TweakableParser:" << std::string{value, value.size()} << "is not a floating-point literal";
@@ -224,7 +243,7 @@ std::pair<TweakableState, double> TweakableParser<double>::parse(Containers::Arr
     }
 
     if(end != value.end()) {
-        Warning{} << "Utility::TweakableParser: unexpected characters" << std::string{const_cast<const char*>(end), value.end()} <<  "after a floating-point literal";
+        Warning{} << "Utility::TweakableParser: unexpected characters" << std::string{end, value.end()} <<  "after a floating-point literal";
         return {TweakableState::Recompile, {}};
     }
 
@@ -233,8 +252,8 @@ std::pair<TweakableState, double> TweakableParser<double>::parse(Containers::Arr
 
 #ifndef CORRADE_TARGET_EMSCRIPTEN
 std::pair<TweakableState, long double> TweakableParser<long double>::parse(Containers::ArrayView<const char> value) {
-    char* end;
-    const long double result = std::strtold(value, &end);
+    long double result;
+    const char* const end = parseFloatingPoint(value, result);
 
     if(end == value.begin() || std::find(value.begin(), value.end(), '.') == value.end()) {
         Warning{} << "Utility::TweakableParser:" << std::string{value, value.size()} << "is not a floating-point literal";
@@ -248,7 +267,7 @@ std::pair<TweakableState, long double> TweakableParser<long double>::parse(Conta
     }
 
     if(end != value.end() - 1) {
-        Warning{} << "Utility::TweakableParser: unexpected characters" << std::string{const_cast<const char*>(end), value.end()} <<  "after a floating-point literal";
+        Warning{} << "Utility::TweakableParser: unexpected characters" << std::string{end, value.end()} <<  "after a floating-point literal";
         return {TweakableState::Recompile, {}};
     }
 
@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Macros @ref CORRADE_HAS_TYPE(), alias @ref Corrade::Utility::IsIterable
+ * @brief Macros @ref CORRADE_HAS_TYPE(), alias @ref Corrade::Utility::IsIterable, @ref Corrade::Utility::IsStringLike, class @ref Corrade::Utility::IsTriviallyRelocatable
  */
 
 #include <type_traits>
@@ -161,6 +161,40 @@ template<class T> using IsStringLike = std::integral_constant<bool,
     #endif
     >;
 
+/**
+@brief Traits class for checking whether given type is trivially relocatable
+@m_since_latest
+
+A type is trivially relocatable if moving it to a new location and destroying
+the original is equivalent to copying its bytes and forgetting about the
+original, i.e. it doesn't store pointers to itself and doesn't register its
+address anywhere. Growable arrays make use of this to reallocate the memory
+with a plain @ref std::memcpy() or @ref std::realloc() instead of
+move-constructing and destructing every element, see
+@ref Containers-Array-growable-relocation for details.
+
+By default equivalent to @ref std::true_type for trivially copyable types and
+@ref std::false_type otherwise. The trait is opt-in --- Corrade specializes it
+for its own move-only containers such as @ref Containers::Array,
+@ref Containers::Pointer or @ref Containers::Optional and you can specialize
+it for your own types as well:
+
+@snippet Utility.cpp IsTriviallyRelocatable
+
+Specializing the trait for a type that isn't trivially relocatable, such as
+@ref std::string with the small string optimization in libstdc++, leads to
+undefined behavior.
+*/
+template<class T> struct IsTriviallyRelocatable: std::integral_constant<bool,
+    #ifdef DOXYGEN_GENERATING_OUTPUT
+    implementation-specific
+    #elif defined(CORRADE_STD_IS_TRIVIALLY_TRAITS_SUPPORTED)
+    std::is_trivially_copyable<T>::value
+    #else
+    __has_trivial_copy(T) && __has_trivial_destructor(T)
+    #endif
+    > {};
+
 }}
 
 #endif
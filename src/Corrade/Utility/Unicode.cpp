@@ -26,16 +26,22 @@
 #include "Unicode.h"
 
 #include <cstdint>
+#include <cstring>
 #include <string>
 
+#include "Corrade/Utility/Assert.h"
+#include "Corrade/Utility/Cpu.h"
+
+#ifdef CORRADE_TARGET_X86
+#include <immintrin.h>
+#endif
+#ifdef __ARM_NEON
+#include <arm_neon.h>
+#endif
 #ifdef CORRADE_TARGET_WINDOWS
-#define WIN32_LEAN_AND_MEAN 1
-#define VC_EXTRALEAN
-#include <windows.h>
+#include <cwchar>
 #endif
 
-#include "Corrade/Utility/Assert.h"
-
 namespace Corrade { namespace Utility { namespace Unicode {
 
 std::pair<char32_t, std::size_t> nextChar(const Containers::ArrayView<const char> text, std::size_t cursor) {
@@ -161,35 +167,624 @@ std::size_t utf8(const char32_t character, const Containers::StaticArrayView<4,
     return 0;
 }
 
-std::u32string utf32(const std::string& text) {
-    std::u32string result;
-    result.reserve(text.size());
+namespace {
+
+/* Strict decoding according to RFC 3629, returns length of a valid sequence
+   starting at i or 0 if it's invalid or truncated */
+std::size_t validSequenceLength(const char* const i, const char* const end) {
+    const std::uint8_t c = *i;
+    if(c < 0x80) return 1;
+
+    std::size_t size;
+    /* Allowed range of the second byte, which excludes overlong sequences,
+       surrogates and values above 0x10ffff */
+    std::uint8_t min = 0x80, max = 0xbf;
+    if(c < 0xc2) return 0;
+    else if(c < 0xe0) size = 2;
+    else if(c < 0xf0) {
+        size = 3;
+        if(c == 0xe0) min = 0xa0;
+        else if(c == 0xed) max = 0x9f;
+    } else if(c < 0xf5) {
+        size = 4;
+        if(c == 0xf0) min = 0x90;
+        else if(c == 0xf4) max = 0x8f;
+    } else return 0;
+
+    if(std::size_t(end - i) < size) return 0;
+    if(std::uint8_t(i[1]) < min || std::uint8_t(i[1]) > max) return 0;
+    for(std::size_t j = 2; j != size; ++j)
+        if((i[j] & 0xc0) != 0x80) return 0;
+    return size;
+}
+
+bool validateScalar(const char* i, const char* const end) {
+    while(i != end) {
+        /* Skip ASCII eight bytes at a time */
+        if(end - i >= 8) {
+            std::uint64_t word;
+            std::memcpy(&word, i, 8);
+            if(!(word & 0x8080808080808080ull)) {
+                i += 8;
+                continue;
+            }
+        }
+
+        const std::size_t size = validSequenceLength(i, end);
+        if(!size) return false;
+        i += size;
+    }
+
+    return true;
+}
+
+#ifdef CORRADE_TARGET_X86
+/* Validates what's left after the vectorized loop. The last vector could
+   end in the middle of a sequence, so go back to its lead byte (which is at
+   most three bytes before) and validate from there. */
+bool validateRemaining(const char* const begin, const char* i, const char* const end) {
+    for(std::size_t k = 1; k <= 3 && std::size_t(i - begin) >= k; ++k) {
+        const std::uint8_t c = *(i - k);
+        if(c >= 0xc0) {
+            i -= k;
+            break;
+        }
+        if(c < 0x80) break;
+    }
+
+    return validateScalar(i, end);
+}
+#endif
+
+#ifdef CORRADE_TARGET_X86
+/* Vectorized validation based on the lookup algorithm from Keiser & Lemire,
+   Validating UTF-8 In Less Than One Instruction Per Byte,
+   https://arxiv.org/abs/2010.03090. Each byte is classified by its high
+   nibble together with both nibbles of the preceding byte using three
+   16-entry tables, whose bitwise AND is non-zero for invalid two-byte
+   combinations. Sequences of three and four bytes are then checked by
+   looking at the second and third preceding byte. */
+enum: std::uint8_t {
+    TooShort = 1 << 0,      /* 11______ 0_______, 11______ 11______ */
+    TooLong = 1 << 1,       /* 0_______ 10______ */
+    Overlong3 = 1 << 2,     /* 11100000 100_____ */
+    TooLarge = 1 << 3,      /* 11110100 1001____, 11110101+ 10______ */
+    Surrogate = 1 << 4,     /* 11101101 101_____ */
+    Overlong2 = 1 << 5,     /* 1100000_ 10______ */
+    TooLarge1000 = 1 << 6,  /* 11110101+ 1000____ */
+    Overlong4 = 1 << 6,     /* 11110000 1000____ */
+    TwoContinuations = 1 << 7, /* 10______ 10______ */
+    Carry = TooShort|TooLong|TwoContinuations
+};
+
+alignas(16) constexpr std::uint8_t Byte1High[]{
+    /* 0_______ */
+    TooLong, TooLong, TooLong, TooLong, TooLong, TooLong, TooLong, TooLong,
+    /* 10______ */
+    TwoContinuations, TwoContinuations, TwoContinuations, TwoContinuations,
+    /* 1100____ */
+    TooShort|Overlong2,
+    /* 1101____ */
+    TooShort,
+    /* 1110____ */
+    TooShort|Overlong3|Surrogate,
+    /* 1111____ */
+    TooShort|TooLarge|TooLarge1000|Overlong4
+};
+
+alignas(16) constexpr std::uint8_t Byte1Low[]{
+    /* ____0000 */
+    Carry|Overlong3|Overlong2|Overlong4,
+    /* ____0001 */
+    Carry|Overlong2,
+    /* ____001_ */
+    Carry,
+    Carry,
+    /* ____0100 */
+    Carry|TooLarge,
+    /* ____0101 to ____1100 */
+    Carry|TooLarge|TooLarge1000,
+    Carry|TooLarge|TooLarge1000,
+    Carry|TooLarge|TooLarge1000,
+    Carry|TooLarge|TooLarge1000,
+    Carry|TooLarge|TooLarge1000,
+    Carry|TooLarge|TooLarge1000,
+    Carry|TooLarge|TooLarge1000,
+    Carry|TooLarge|TooLarge1000,
+    /* ____1101 */
+    Carry|TooLarge|TooLarge1000|Surrogate,
+    /* ____111_ */
+    Carry|TooLarge|TooLarge1000,
+    Carry|TooLarge|TooLarge1000
+};
+
+alignas(16) constexpr std::uint8_t Byte2High[]{
+    /* 0_______ */
+    TooShort, TooShort, TooShort, TooShort, TooShort, TooShort, TooShort, TooShort,
+    /* 1000____ */
+    TooLong|Overlong2|TwoContinuations|Overlong3|TooLarge1000|Overlong4,
+    /* 1001____ */
+    TooLong|Overlong2|TwoContinuations|Overlong3|TooLarge,
+    /* 101_____ */
+    TooLong|Overlong2|TwoContinuations|Surrogate|TooLarge,
+    TooLong|Overlong2|TwoContinuations|Surrogate|TooLarge,
+    /* 11______ */
+    TooShort, TooShort, TooShort, TooShort
+};
+
+/* Subtracting these with saturation gives a non-zero value if the last
+   vector ends with an incomplete sequence */
+alignas(16) constexpr std::uint8_t IncompleteMax[]{
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0xdf, 0xbf
+};
+
+CORRADE_ENABLE_SSSE3 bool validateSsse3(const char* const begin, const char* const end) {
+    const __m128i byte1High = _mm_load_si128(reinterpret_cast<const __m128i*>(Byte1High));
+    const __m128i byte1Low = _mm_load_si128(reinterpret_cast<const __m128i*>(Byte1Low));
+    const __m128i byte2High = _mm_load_si128(reinterpret_cast<const __m128i*>(Byte2High));
+    const __m128i incompleteMax = _mm_load_si128(reinterpret_cast<const __m128i*>(IncompleteMax + 16));
+    const __m128i lowNibble = _mm_set1_epi8(0x0f);
+
+    __m128i error = _mm_setzero_si128();
+    __m128i prevInput = _mm_setzero_si128();
+    __m128i prevIncomplete = _mm_setzero_si128();
+    const char* i = begin;
+    for(; end - i >= 16; i += 16) {
+        const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(i));
+
+        /* All ASCII, only need to check that the previous vector didn't end
+           in the middle of a sequence */
+        if(!_mm_movemask_epi8(input)) {
+            error = _mm_or_si128(error, prevIncomplete);
+            prevIncomplete = _mm_setzero_si128();
+            prevInput = input;
+            continue;
+        }
+
+        const __m128i prev1 = _mm_alignr_epi8(input, prevInput, 15);
+        const __m128i special = _mm_and_si128(_mm_and_si128(
+            _mm_shuffle_epi8(byte1High, _mm_and_si128(_mm_srli_epi16(prev1, 4), lowNibble)),
+            _mm_shuffle_epi8(byte1Low, _mm_and_si128(prev1, lowNibble))),
+            _mm_shuffle_epi8(byte2High, _mm_and_si128(_mm_srli_epi16(input, 4), lowNibble)));
+
+        /* Two continuation bytes in a row have to be preceded by a lead byte
+           of a three- or four-byte sequence */
+        const __m128i prev2 = _mm_alignr_epi8(input, prevInput, 14);
+        const __m128i prev3 = _mm_alignr_epi8(input, prevInput, 13);
+        const __m128i must23 = _mm_and_si128(_mm_or_si128(
+            _mm_subs_epu8(prev2, _mm_set1_epi8(0xe0 - 0x80)),
+            _mm_subs_epu8(prev3, _mm_set1_epi8(char(0xf0 - 0x80)))),
+            _mm_set1_epi8(char(0x80)));
+
+        error = _mm_or_si128(error, _mm_xor_si128(must23, special));
+        prevIncomplete = _mm_subs_epu8(input, incompleteMax);
+        prevInput = input;
+    }
+
+    if(_mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) != 0xffff)
+        return false;
+
+    return validateRemaining(begin, i, end);
+}
+
+CORRADE_ENABLE_AVX2 bool validateAvx2(const char* const begin, const char* const end) {
+    const __m256i byte1High = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(Byte1High)));
+    const __m256i byte1Low = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(Byte1Low)));
+    const __m256i byte2High = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(Byte2High)));
+    const __m256i incompleteMax = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(IncompleteMax));
+    const __m256i lowNibble = _mm256_set1_epi8(0x0f);
+
+    __m256i error = _mm256_setzero_si256();
+    __m256i prevInput = _mm256_setzero_si256();
+    __m256i prevIncomplete = _mm256_setzero_si256();
+    const char* i = begin;
+    for(; end - i >= 32; i += 32) {
+        const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(i));
+
+        if(!_mm256_movemask_epi8(input)) {
+            error = _mm256_or_si256(error, prevIncomplete);
+            prevIncomplete = _mm256_setzero_si256();
+            prevInput = input;
+            continue;
+        }
+
+        /* The alignr instruction works on each 128-bit lane separately, so
+           it needs the high lane of the previous input paired with the low
+           lane of the current one */
+        const __m256i shifted = _mm256_permute2x128_si256(prevInput, input, 0x21);
+        const __m256i prev1 = _mm256_alignr_epi8(input, shifted, 15);
+        const __m256i special = _mm256_and_si256(_mm256_and_si256(
+            _mm256_shuffle_epi8(byte1High, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), lowNibble)),
+            _mm256_shuffle_epi8(byte1Low, _mm256_and_si256(prev1, lowNibble))),
+            _mm256_shuffle_epi8(byte2High, _mm256_and_si256(_mm256_srli_epi16(input, 4), lowNibble)));
+
+        const __m256i prev2 = _mm256_alignr_epi8(input, shifted, 14);
+        const __m256i prev3 = _mm256_alignr_epi8(input, shifted, 13);
+        const __m256i must23 = _mm256_and_si256(_mm256_or_si256(
+            _mm256_subs_epu8(prev2, _mm256_set1_epi8(0xe0 - 0x80)),
+            _mm256_subs_epu8(prev3, _mm256_set1_epi8(char(0xf0 - 0x80)))),
+            _mm256_set1_epi8(char(0x80)));
+
+        error = _mm256_or_si256(error, _mm256_xor_si256(must23, special));
+        prevIncomplete = _mm256_subs_epu8(input, incompleteMax);
+        prevInput = input;
+    }
+
+    if(!_mm256_testz_si256(error, error))
+        return false;
+
+    return validateRemaining(begin, i, end);
+}
+#endif
+
+#ifdef __ARM_NEON
+/* Table lookups used by the x86 variant are available only on AArch64, so
+   here just whole vectors of ASCII are skipped */
+bool validateNeon(const char* const begin, const char* const end) {
+    const char* i = begin;
+    for(; end - i >= 16; i += 16) {
+        const uint64x2_t input = vreinterpretq_u64_u8(vld1q_u8(reinterpret_cast<const std::uint8_t*>(i)));
+        if((vgetq_lane_u64(input, 0)|vgetq_lane_u64(input, 1)) & 0x8080808080808080ull) {
+            /* Validate scalar until the next ASCII byte and continue from
+               there */
+            const char* const blockEnd = i + 16;
+            while(i < blockEnd) {
+                if(std::uint8_t(*i) < 0x80) {
+                    ++i;
+                    continue;
+                }
+                const std::size_t size = validSequenceLength(i, end);
+                if(!size) return false;
+                i += size;
+            }
+            /* Compensate for the increment in the loop */
+            i -= 16;
+        }
+    }
+
+    return validateScalar(i, end);
+}
+#endif
+
+typedef bool(*ValidateFunction)(const char*, const char*);
+
+ValidateFunction pickValidate() {
+    return Cpu::dispatch<ValidateFunction>({
+        #ifdef CORRADE_TARGET_X86
+        {Cpu::Feature::Avx2, validateAvx2},
+        {Cpu::Feature::Ssse3, validateSsse3},
+        #endif
+    },
+        #ifdef __ARM_NEON
+        validateNeon
+        #else
+        validateScalar
+        #endif
+    );
+}
+
+/* Converting a run of ASCII characters, stopping at the first non-ASCII one.
+   Returns the number of converted characters. */
+template<class T> std::size_t asciiToWideScalar(const char* const begin, const char* const end, T* out) {
+    const char* i = begin;
+    for(; i != end && std::uint8_t(*i) < 0x80; ++i) *out++ = T(*i);
+    return i - begin;
+}
+
+template<class T> std::size_t wideToAsciiScalar(const T* const begin, const T* const end, char* out) {
+    const T* i = begin;
+    for(; i != end && std::uint32_t(*i) < 0x80; ++i) *out++ = char(*i);
+    return i - begin;
+}
+
+#ifdef CORRADE_TARGET_X86
+CORRADE_ENABLE_SSE2 std::size_t asciiToUtf16Sse2(const char* const begin, const char* const end, char16_t* out) {
+    const __m128i zero = _mm_setzero_si128();
+    const char* i = begin;
+    for(; end - i >= 16; i += 16, out += 16) {
+        const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(i));
+        if(_mm_movemask_epi8(input)) break;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 0), _mm_unpacklo_epi8(input, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), _mm_unpackhi_epi8(input, zero));
+    }
+
+    return (i - begin) + asciiToWideScalar(i, end, out);
+}
+
+CORRADE_ENABLE_SSE2 std::size_t asciiToUtf32Sse2(const char* const begin, const char* const end, char32_t* out) {
+    const __m128i zero = _mm_setzero_si128();
+    const char* i = begin;
+    for(; end - i >= 16; i += 16, out += 16) {
+        const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(i));
+        if(_mm_movemask_epi8(input)) break;
+        const __m128i low = _mm_unpacklo_epi8(input, zero);
+        const __m128i high = _mm_unpackhi_epi8(input, zero);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 0), _mm_unpacklo_epi16(low, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4), _mm_unpackhi_epi16(low, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), _mm_unpacklo_epi16(high, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 12), _mm_unpackhi_epi16(high, zero));
+    }
+
+    return (i - begin) + asciiToWideScalar(i, end, out);
+}
+
+CORRADE_ENABLE_SSE2 std::size_t utf16ToAsciiSse2(const char16_t* const begin, const char16_t* const end, char* out) {
+    const __m128i nonAscii = _mm_set1_epi16(short(0xff80));
+    const __m128i zero = _mm_setzero_si128();
+    const char16_t* i = begin;
+    for(; end - i >= 16; i += 16, out += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(i + 0));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(i + 8));
+        if(_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(_mm_or_si128(a, b), nonAscii), zero)) != 0xffff) break;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(a, b));
+    }
+
+    return (i - begin) + wideToAsciiScalar(i, end, out);
+}
+
+CORRADE_ENABLE_SSE2 std::size_t utf32ToAsciiSse2(const char32_t* const begin, const char32_t* const end, char* out) {
+    const __m128i nonAscii = _mm_set1_epi32(int(0xffffff80));
+    const __m128i zero = _mm_setzero_si128();
+    const char32_t* i = begin;
+    for(; end - i >= 16; i += 16, out += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(i + 0));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(i + 4));
+        const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(i + 8));
+        const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(i + 12));
+        const __m128i all = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+        if(_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(all, nonAscii), zero)) != 0xffff) break;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+    }
 
-    for(std::size_t i = 0; i != text.size(); ) {
-        const std::pair<char32_t, std::size_t> next = Utility::Unicode::nextChar(text, i);
-        result.push_back(next.first);
-        i = next.second;
+    return (i - begin) + wideToAsciiScalar(i, end, out);
+}
+#endif
+
+#ifdef __ARM_NEON
+inline bool neonAllZero(const uint8x16_t value) {
+    const uint64x2_t value64 = vreinterpretq_u64_u8(value);
+    return !(vgetq_lane_u64(value64, 0)|vgetq_lane_u64(value64, 1));
+}
+
+std::size_t asciiToUtf16Neon(const char* const begin, const char* const end, char16_t* out) {
+    const char* i = begin;
+    for(; end - i >= 16; i += 16, out += 16) {
+        const uint8x16_t input = vld1q_u8(reinterpret_cast<const std::uint8_t*>(i));
+        if(!neonAllZero(vandq_u8(input, vdupq_n_u8(0x80)))) break;
+        std::uint16_t* const out16 = reinterpret_cast<std::uint16_t*>(out);
+        vst1q_u16(out16 + 0, vmovl_u8(vget_low_u8(input)));
+        vst1q_u16(out16 + 8, vmovl_u8(vget_high_u8(input)));
+    }
+
+    return (i - begin) + asciiToWideScalar(i, end, out);
+}
+
+std::size_t asciiToUtf32Neon(const char* const begin, const char* const end, char32_t* out) {
+    const char* i = begin;
+    for(; end - i >= 16; i += 16, out += 16) {
+        const uint8x16_t input = vld1q_u8(reinterpret_cast<const std::uint8_t*>(i));
+        if(!neonAllZero(vandq_u8(input, vdupq_n_u8(0x80)))) break;
+        const uint16x8_t low = vmovl_u8(vget_low_u8(input));
+        const uint16x8_t high = vmovl_u8(vget_high_u8(input));
+        std::uint32_t* const out32 = reinterpret_cast<std::uint32_t*>(out);
+        vst1q_u32(out32 + 0, vmovl_u16(vget_low_u16(low)));
+        vst1q_u32(out32 + 4, vmovl_u16(vget_high_u16(low)));
+        vst1q_u32(out32 + 8, vmovl_u16(vget_low_u16(high)));
+        vst1q_u32(out32 + 12, vmovl_u16(vget_high_u16(high)));
+    }
+
+    return (i - begin) + asciiToWideScalar(i, end, out);
+}
+
+std::size_t utf16ToAsciiNeon(const char16_t* const begin, const char16_t* const end, char* out) {
+    const char16_t* i = begin;
+    for(; end - i >= 16; i += 16, out += 16) {
+        const std::uint16_t* const i16 = reinterpret_cast<const std::uint16_t*>(i);
+        const uint16x8_t a = vld1q_u16(i16 + 0);
+        const uint16x8_t b = vld1q_u16(i16 + 8);
+        if(!neonAllZero(vreinterpretq_u8_u16(vandq_u16(vorrq_u16(a, b), vdupq_n_u16(0xff80))))) break;
+        vst1q_u8(reinterpret_cast<std::uint8_t*>(out), vcombine_u8(vmovn_u16(a), vmovn_u16(b)));
+    }
+
+    return (i - begin) + wideToAsciiScalar(i, end, out);
+}
+
+std::size_t utf32ToAsciiNeon(const char32_t* const begin, const char32_t* const end, char* out) {
+    const char32_t* i = begin;
+    for(; end - i >= 16; i += 16, out += 16) {
+        const std::uint32_t* const i32 = reinterpret_cast<const std::uint32_t*>(i);
+        const uint32x4_t a = vld1q_u32(i32 + 0);
+        const uint32x4_t b = vld1q_u32(i32 + 4);
+        const uint32x4_t c = vld1q_u32(i32 + 8);
+        const uint32x4_t d = vld1q_u32(i32 + 12);
+        const uint32x4_t all = vorrq_u32(vorrq_u32(a, b), vorrq_u32(c, d));
+        if(!neonAllZero(vreinterpretq_u8_u32(vandq_u32(all, vdupq_n_u32(0xffffff80))))) break;
+        const uint16x8_t ab = vcombine_u16(vmovn_u32(a), vmovn_u32(b));
+        const uint16x8_t cd = vcombine_u16(vmovn_u32(c), vmovn_u32(d));
+        vst1q_u8(reinterpret_cast<std::uint8_t*>(out), vcombine_u8(vmovn_u16(ab), vmovn_u16(cd)));
     }
 
+    return (i - begin) + wideToAsciiScalar(i, end, out);
+}
+#endif
+
+typedef std::size_t(*AsciiToUtf16Function)(const char*, const char*, char16_t*);
+typedef std::size_t(*AsciiToUtf32Function)(const char*, const char*, char32_t*);
+typedef std::size_t(*Utf16ToAsciiFunction)(const char16_t*, const char16_t*, char*);
+typedef std::size_t(*Utf32ToAsciiFunction)(const char32_t*, const char32_t*, char*);
+
+/* SSE2 is always present on 64-bit x86, the dispatch is there for 32-bit
+   builds */
+#ifdef CORRADE_TARGET_X86
+#define CORRADE_UNICODE_PICK(scalar, sse2, neon) \
+    Cpu::dispatch<decltype(&scalar)>({{Cpu::Feature::Sse2, sse2}}, scalar)
+#elif defined(__ARM_NEON)
+#define CORRADE_UNICODE_PICK(scalar, sse2, neon) neon
+#else
+#define CORRADE_UNICODE_PICK(scalar, sse2, neon) scalar
+#endif
+
+AsciiToUtf16Function pickAsciiToUtf16() {
+    return CORRADE_UNICODE_PICK(asciiToWideScalar<char16_t>, asciiToUtf16Sse2, asciiToUtf16Neon);
+}
+
+AsciiToUtf32Function pickAsciiToUtf32() {
+    return CORRADE_UNICODE_PICK(asciiToWideScalar<char32_t>, asciiToUtf32Sse2, asciiToUtf32Neon);
+}
+
+Utf16ToAsciiFunction pickUtf16ToAscii() {
+    return CORRADE_UNICODE_PICK(wideToAsciiScalar<char16_t>, utf16ToAsciiSse2, utf16ToAsciiNeon);
+}
+
+Utf32ToAsciiFunction pickUtf32ToAscii() {
+    return CORRADE_UNICODE_PICK(wideToAsciiScalar<char32_t>, utf32ToAsciiSse2, utf32ToAsciiNeon);
+}
+
+#undef CORRADE_UNICODE_PICK
+
+/* Writes a code point that's known to be in range as UTF-8, returns the
+   number of bytes written */
+inline std::size_t writeUtf8(const char32_t character, char* const out) {
+    return utf8(character, Containers::StaticArrayView<4, char>{out});
+}
+
+constexpr char32_t ReplacementCharacter = U'\xfffd';
+
+}
+
+bool validate(const Containers::ArrayView<const char> text) {
+    static const ValidateFunction function = pickValidate();
+    return function(text.begin(), text.end());
+}
+
+std::size_t utf32(const Containers::ArrayView<const char> text, const Containers::ArrayView<char32_t> out) {
+    CORRADE_ASSERT(out.size() >= text.size(),
+        "Utility::Unicode::utf32(): expected output of at least" << text.size() << "characters but got" << out.size(), {});
+
+    static const AsciiToUtf32Function ascii = pickAsciiToUtf32();
+    std::size_t i = 0, o = 0;
+    while(i != text.size()) {
+        const std::size_t size = ascii(text.data() + i, text.end(), out.data() + o);
+        i += size;
+        o += size;
+
+        /* Decode until the next ASCII character */
+        while(i != text.size() && std::uint8_t(text[i]) >= 0x80) {
+            const std::pair<char32_t, std::size_t> next = nextChar(text, i);
+            out[o++] = next.first;
+            i = next.second;
+        }
+    }
+
+    return o;
+}
+
+std::size_t utf16(const Containers::ArrayView<const char> text, const Containers::ArrayView<char16_t> out) {
+    CORRADE_ASSERT(out.size() >= text.size(),
+        "Utility::Unicode::utf16(): expected output of at least" << text.size() << "characters but got" << out.size(), {});
+
+    static const AsciiToUtf16Function ascii = pickAsciiToUtf16();
+    std::size_t i = 0, o = 0;
+    while(i != text.size()) {
+        const std::size_t size = ascii(text.data() + i, text.end(), out.data() + o);
+        i += size;
+        o += size;
+
+        while(i != text.size() && std::uint8_t(text[i]) >= 0x80) {
+            const std::pair<char32_t, std::size_t> next = nextChar(text, i);
+            i = next.second;
+
+            /* Invalid bytes, surrogates or values outside of the UTF-16
+               range. Four-byte sequences are the only ones that can be
+               encoded as a surrogate pair and those consume two output
+               elements for four input bytes, so the output never exceeds
+               the input size. */
+            if(next.first > U'\x10ffff' || (next.first >= U'\xd800' && next.first < U'\xe000'))
+                out[o++] = char16_t(ReplacementCharacter);
+            else if(next.first >= U'\x10000') {
+                const char32_t value = next.first - U'\x10000';
+                out[o++] = char16_t(0xd800 + (value >> 10));
+                out[o++] = char16_t(0xdc00 + (value & 0x3ff));
+            } else out[o++] = char16_t(next.first);
+        }
+    }
+
+    return o;
+}
+
+std::size_t utf8(const Containers::ArrayView<const char16_t> text, const Containers::ArrayView<char> out) {
+    CORRADE_ASSERT(out.size() >= text.size()*3,
+        "Utility::Unicode::utf8(): expected output of at least" << text.size()*3 << "bytes but got" << out.size(), {});
+
+    static const Utf16ToAsciiFunction ascii = pickUtf16ToAscii();
+    std::size_t i = 0, o = 0;
+    while(i != text.size()) {
+        const std::size_t size = ascii(text.data() + i, text.end(), out.data() + o);
+        i += size;
+        o += size;
+
+        while(i != text.size() && text[i] >= 0x80) {
+            char32_t character = text[i++];
+            if(character >= U'\xd800' && character < U'\xe000') {
+                /* A high surrogate followed by a low one */
+                if(character < U'\xdc00' && i != text.size() && text[i] >= 0xdc00 && text[i] < 0xe000)
+                    character = U'\x10000' + ((character - U'\xd800') << 10) + (text[i++] - 0xdc00);
+                else character = ReplacementCharacter;
+            }
+
+            o += writeUtf8(character, out.data() + o);
+        }
+    }
+
+    return o;
+}
+
+std::size_t utf8(const Containers::ArrayView<const char32_t> text, const Containers::ArrayView<char> out) {
+    CORRADE_ASSERT(out.size() >= text.size()*4,
+        "Utility::Unicode::utf8(): expected output of at least" << text.size()*4 << "bytes but got" << out.size(), {});
+
+    static const Utf32ToAsciiFunction ascii = pickUtf32ToAscii();
+    std::size_t i = 0, o = 0;
+    while(i != text.size()) {
+        const std::size_t size = ascii(text.data() + i, text.end(), out.data() + o);
+        i += size;
+        o += size;
+
+        while(i != text.size() && text[i] >= 0x80) {
+            const char32_t character = text[i++];
+            o += writeUtf8(character < U'\x110000' ? character : ReplacementCharacter, out.data() + o);
+        }
+    }
+
+    return o;
+}
+
+std::u32string utf32(const std::string& text) {
+    std::u32string result(text.size(), U'\0');
+    if(text.empty()) return result;
+    result.resize(utf32(Containers::ArrayView<const char>{text.data(), text.size()}, Containers::ArrayView<char32_t>{&result[0], result.size()}));
     return result;
 }
 
 #ifdef CORRADE_TARGET_WINDOWS
 namespace {
 
-std::wstring widen(const char* const text, const int size) {
+/* wchar_t is a 16-bit type on Windows, so it can be used directly as the
+   char16_t output */
+std::wstring widen(const char* const text, const std::size_t size) {
     if(!size) return {};
-    /* WCtoMB counts the trailing \0 into size, which we have to cut */
-    std::wstring result(MultiByteToWideChar(CP_UTF8, 0, text, size, nullptr, 0) - (size == -1 ? 1 : 0), 0);
-    MultiByteToWideChar(CP_UTF8, 0, text, size, &result[0], result.size());
+    std::wstring result(size, L'\0');
+    result.resize(utf16({text, size}, {reinterpret_cast<char16_t*>(&result[0]), size}));
     return result;
 }
 
-std::string narrow(const wchar_t* const text, const int size) {
+std::string narrow(const wchar_t* const text, const std::size_t size) {
     if(!size) return {};
-    /* WCtoMB counts the trailing \0 into size, which we have to cut */
-    std::string result(WideCharToMultiByte(CP_UTF8, 0, text, size, nullptr, 0, nullptr, nullptr) - (size == -1 ? 1 : 0), 0);
-    WideCharToMultiByte(CP_UTF8, 0, text, size, &result[0], result.size(), nullptr, nullptr);
+    std::string result(size*3, '\0');
+    result.resize(utf8(Containers::ArrayView<const char16_t>{reinterpret_cast<const char16_t*>(text), size}, {&result[0], size*3}));
     return result;
 }
 
@@ -204,7 +799,7 @@ std::wstring widen(Containers::ArrayView<const char> text) {
 }
 
 std::wstring widen(const char* text) {
-    return widen(text, -1);
+    return widen(text, std::strlen(text));
 }
 
 std::string narrow(const std::wstring& text) {
@@ -216,7 +811,7 @@ std::string narrow(Containers::ArrayView<const wchar_t> text) {
 }
 
 std::string narrow(const wchar_t* text) {
-    return narrow(text, -1);
+    return narrow(text, std::wcslen(text));
 }
 #endif
 
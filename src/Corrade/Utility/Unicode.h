@@ -99,9 +99,74 @@ template<std::size_t size> inline std::pair<char32_t, std::size_t> prevChar(cons
     return prevChar(Containers::ArrayView<const char>{text, size - 1}, cursor);
 }
 
+/**
+@brief Validate an UTF-8 string
+@m_since_latest
+
+Returns @cpp true @ce if @p text is a valid UTF-8 sequence according to
+[RFC 3629](https://tools.ietf.org/html/rfc3629), @cpp false @ce otherwise.
+Overlong encodings, UTF-16 surrogates, code points above @cpp 0x10ffff @ce
+and truncated sequences are all treated as invalid. Unlike @ref nextChar(),
+which decodes a single character at a time, the input is checked in large
+blocks using SSSE3 or AVX2 where available.
+@see @ref Cpu::runtimeFeatures()
+*/
+CORRADE_UTILITY_EXPORT bool validate(Containers::ArrayView<const char> text);
+
 /** @brief Convert UTF-8 to UTF-32 */
 CORRADE_UTILITY_EXPORT std::u32string utf32(const std::string& text);
 
+/**
+@brief Convert UTF-8 to UTF-32 into a preallocated buffer
+@m_since_latest
+
+Expects that @p out is at least as large as @p text, which is the upper bound
+on the number of decoded code points. Returns the number of code points
+written. Invalid bytes are decoded the same way as in @ref nextChar(), i.e.
+as @cpp 0xffffffffu @ce; use @ref validate() to check the input beforehand if
+that's not desired. Runs of ASCII characters are converted using SSE2 or
+NEON where available.
+*/
+CORRADE_UTILITY_EXPORT std::size_t utf32(Containers::ArrayView<const char> text, Containers::ArrayView<char32_t> out);
+
+/**
+@brief Convert UTF-8 to UTF-16 into a preallocated buffer
+@m_since_latest
+
+Expects that @p out is at least as large as @p text, which is the upper bound
+on the number of UTF-16 code units. Returns the number of code units written.
+Code points outside of the BMP are encoded as surrogate pairs, invalid bytes
+and code points that can't be represented in UTF-16 are replaced with
+@cpp 0xfffd @ce. Runs of ASCII characters are converted using SSE2 or NEON
+where available.
+*/
+CORRADE_UTILITY_EXPORT std::size_t utf16(Containers::ArrayView<const char> text, Containers::ArrayView<char16_t> out);
+
+/**
+@brief Convert UTF-16 to UTF-8 into a preallocated buffer
+@m_since_latest
+
+Expects that @p out is at least three times as large as @p text, which is the
+upper bound on the number of encoded bytes. Returns the number of bytes
+written. Unpaired surrogates are replaced with an UTF-8 encoding of
+@cpp 0xfffd @ce. Runs of ASCII characters are converted using SSE2 or NEON
+where available.
+*/
+CORRADE_UTILITY_EXPORT std::size_t utf8(Containers::ArrayView<const char16_t> text, Containers::ArrayView<char> out);
+
+/**
+@brief Convert UTF-32 to UTF-8 into a preallocated buffer
+@m_since_latest
+
+Expects that @p out is at least four times as large as @p text, which is the
+upper bound on the number of encoded bytes. Returns the number of bytes
+written. Code points outside of the UTF-32 range are replaced with an UTF-8
+encoding of @cpp 0xfffd @ce. Runs of ASCII characters are converted using
+SSE2 or NEON where available.
+@see @ref utf8(char32_t, Containers::StaticArrayView<4, char>)
+*/
+CORRADE_UTILITY_EXPORT std::size_t utf8(Containers::ArrayView<const char32_t> text, Containers::ArrayView<char> out);
+
 /**
 @brief Convert UTF-32 character to UTF-8
 @param[in]  character   UTF-32 character to convert
@@ -125,7 +190,9 @@ return @ref std::u16string but a @ref std::wstring.
     always use UTF-8, see http://utf8everywhere.org for more information.
 */
 /* Not named utf16() in order to avoid clashes with potential portable
-   std::u16string utf16(const std::string&) implementation in the future */
+   std::u16string utf16(const std::string&) implementation in the future.
+   Implemented on top of utf16(Containers::ArrayView<const char>,
+   Containers::ArrayView<char16_t>). */
 CORRADE_UTILITY_EXPORT std::wstring widen(const std::string& text);
 
 /** @overload */
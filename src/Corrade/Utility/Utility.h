@@ -38,30 +38,52 @@
 namespace Corrade { namespace Utility {
 
 class Arguments;
+class BinaryLog;
+class BinaryReader;
+class BinaryWriter;
+class BufferedFile;
 
 template<std::size_t> class HashDigest;
 /* AbstractHash is not used directly */
 
 class Configuration;
 class ConfigurationGroup;
+class ConfigurationReader;
+class ConfigurationSnapshot;
 enum class ConfigurationValueFlag: std::uint8_t;
 typedef Containers::EnumSet<ConfigurationValueFlag> ConfigurationValueFlags;
 template<class> struct ConfigurationValue;
+
+namespace Cpu {
+    enum class Feature: std::uint32_t;
+    typedef Containers::EnumSet<Feature> Features;
+}
+class Crc32;
+class Crc32c;
 #if defined(DOXYGEN_GENERATING_OUTPUT) || defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)) || defined(CORRADE_TARGET_EMSCRIPTEN)
 class FileWatcher;
+class FileWatcherSet;
 #endif
 
 class Debug;
 class Warning;
 class Error;
 class Fatal;
+enum class DebugLevel: std::uint8_t;
+class DebugModule;
 
 /* Endianness used only statically */
 class MurmurHash2;
 
+class Profiler;
+class ProfilerScope;
+
 /* Resource doesn't need forward declaration */
 class Sha1;
+class StringPool;
+template<class> class Task;
 class Translator;
+template<std::size_t> class XxHash3;
 
 #if defined(DOXYGEN_GENERATING_OUTPUT) || defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)) || defined(CORRADE_TARGET_EMSCRIPTEN)
 /* Tweakable doesn't need forward declaration */
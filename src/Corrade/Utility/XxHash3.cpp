@@ -0,0 +1,533 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "XxHash3.h"
+
+#include <cstring>
+#include <string>
+
+#include "Corrade/Containers/ArrayView.h"
+#include "Corrade/Utility/Cpu.h"
+#include "Corrade/Utility/Endianness.h"
+#include "Corrade/Utility/Implementation/xxHash3.h"
+
+#ifdef CORRADE_TARGET_X86
+#include <immintrin.h>
+#endif
+
+namespace Corrade { namespace Utility {
+
+namespace {
+
+constexpr std::uint32_t Prime32_1 = 0x9E3779B1u;
+constexpr std::uint32_t Prime32_2 = 0x85EBCA77u;
+constexpr std::uint32_t Prime32_3 = 0xC2B2AE3Du;
+constexpr std::uint64_t Prime64_1 = 0x9E3779B185EBCA87ull;
+constexpr std::uint64_t Prime64_2 = 0xC2B2AE3D27D4EB4Full;
+constexpr std::uint64_t Prime64_3 = 0x165667B19E3779F9ull;
+constexpr std::uint64_t Prime64_4 = 0x85EBCA77C2B2AE63ull;
+constexpr std::uint64_t Prime64_5 = 0x27D4EB2F165667C5ull;
+constexpr std::uint64_t PrimeMx1 = 0x165667919E3779F9ull;
+constexpr std::uint64_t PrimeMx2 = 0x9FB21C651E98DF25ull;
+
+/* Sizes of the default secret, a stripe and the internal buffer. The block
+   size is given by how many stripes fit into the secret when advancing by 8
+   bytes for each. */
+enum: std::size_t {
+    SecretSize = 192,
+    SecretSizeMin = 136,
+    StripeSize = 64,
+    StripesPerBlock = (SecretSize - StripeSize)/8,
+    BufferSize = 256,
+    MidSizeMax = 240
+};
+
+constexpr const unsigned char DefaultSecret[SecretSize]{
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+    0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+    0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+    0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+    0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+    0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+    0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+    0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+    0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e
+};
+
+/* Memcpy to avoid unaligned reads on platforms that don't like it */
+inline std::uint32_t read32(const char* const data) {
+    std::uint32_t value;
+    std::memcpy(&value, data, 4);
+    return Endianness::littleEndian(value);
+}
+
+inline std::uint64_t read64(const char* const data) {
+    std::uint64_t value;
+    std::memcpy(&value, data, 8);
+    return Endianness::littleEndian(value);
+}
+
+inline void write64(char* const data, const std::uint64_t value) {
+    const std::uint64_t littleEndian = Endianness::littleEndian(value);
+    std::memcpy(data, &littleEndian, 8);
+}
+
+inline std::uint32_t rotateLeft(const std::uint32_t value, const int shift) {
+    return value << shift | value >> (32 - shift);
+}
+
+inline std::uint64_t rotateLeft(const std::uint64_t value, const int shift) {
+    return value << shift | value >> (64 - shift);
+}
+
+struct Uint128 {
+    std::uint64_t low, high;
+};
+
+inline Uint128 multiply(const std::uint64_t a, const std::uint64_t b) {
+    #if defined(__SIZEOF_INT128__) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    /* __extension__ to silence -Wpedantic */
+    __extension__ typedef unsigned __int128 Native;
+    const Native product = Native(a)*b;
+    return {std::uint64_t(product), std::uint64_t(product >> 64)};
+    #else
+    /* Long multiplication from 32-bit halves */
+    const std::uint64_t loLo = (a & 0xffffffffu)*(b & 0xffffffffu);
+    const std::uint64_t hiLo = (a >> 32)*(b & 0xffffffffu);
+    const std::uint64_t loHi = (a & 0xffffffffu)*(b >> 32);
+    const std::uint64_t hiHi = (a >> 32)*(b >> 32);
+    const std::uint64_t cross = (loLo >> 32) + (hiLo & 0xffffffffu) + loHi;
+    return {(cross << 32) | (loLo & 0xffffffffu), (hiLo >> 32) + (cross >> 32) + hiHi};
+    #endif
+}
+
+inline std::uint64_t multiplyFold(const std::uint64_t a, const std::uint64_t b) {
+    const Uint128 product = multiply(a, b);
+    return product.low ^ product.high;
+}
+
+inline std::uint64_t xorShift(const std::uint64_t value, const int shift) {
+    return value ^ (value >> shift);
+}
+
+/* Final mix of the XXH64 hash */
+inline std::uint64_t avalancheXxh64(std::uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= Prime64_2;
+    hash ^= hash >> 29;
+    hash *= Prime64_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+inline std::uint64_t avalanche(std::uint64_t hash) {
+    hash = xorShift(hash, 37);
+    hash *= PrimeMx1;
+    hash = xorShift(hash, 32);
+    return hash;
+}
+
+/* Stronger avalanche for inputs of 4 to 8 bytes */
+inline std::uint64_t rrmxmx(std::uint64_t hash, const std::uint64_t size) {
+    hash ^= rotateLeft(hash, 49) ^ rotateLeft(hash, 24);
+    hash *= PrimeMx2;
+    hash ^= (hash >> 35) + size;
+    hash *= PrimeMx2;
+    return xorShift(hash, 28);
+}
+
+inline std::uint64_t mix16(const char* const data, const char* const secret, const std::uint64_t seed) {
+    return multiplyFold(
+        read64(data) ^ (read64(secret) + seed),
+        read64(data + 8) ^ (read64(secret + 8) - seed));
+}
+
+inline Uint128 mix32(Uint128 accumulator, const char* const a, const char* const b, const char* const secret, const std::uint64_t seed) {
+    accumulator.low += mix16(a, secret, seed);
+    accumulator.low ^= read64(b) + read64(b + 8);
+    accumulator.high += mix16(b, secret + 16, seed);
+    accumulator.high ^= read64(a) + read64(a + 8);
+    return accumulator;
+}
+
+/* Inputs of up to 240 bytes, which are hashed directly with the default
+   secret and the seed */
+std::uint64_t hashShort64(const char* const data, const std::size_t size, const char* const secret, std::uint64_t seed) {
+    if(size > 128) {
+        const std::size_t rounds = size/16;
+        std::uint64_t accumulator = size*Prime64_1;
+        for(std::size_t i = 0; i != 8; ++i)
+            accumulator += mix16(data + 16*i, secret + 16*i, seed);
+        accumulator = avalanche(accumulator);
+        for(std::size_t i = 8; i < rounds; ++i)
+            accumulator += mix16(data + 16*i, secret + 16*(i - 8) + 3, seed);
+        accumulator += mix16(data + size - 16, secret + SecretSizeMin - 17, seed);
+        return avalanche(accumulator);
+    }
+
+    if(size > 16) {
+        std::uint64_t accumulator = size*Prime64_1;
+        if(size > 32) {
+            if(size > 64) {
+                if(size > 96) {
+                    accumulator += mix16(data + 48, secret + 96, seed);
+                    accumulator += mix16(data + size - 64, secret + 112, seed);
+                }
+                accumulator += mix16(data + 32, secret + 64, seed);
+                accumulator += mix16(data + size - 48, secret + 80, seed);
+            }
+            accumulator += mix16(data + 16, secret + 32, seed);
+            accumulator += mix16(data + size - 32, secret + 48, seed);
+        }
+        accumulator += mix16(data, secret, seed);
+        accumulator += mix16(data + size - 16, secret + 16, seed);
+        return avalanche(accumulator);
+    }
+
+    if(size > 8) {
+        const std::uint64_t low = read64(data) ^ ((read64(secret + 24) ^ read64(secret + 32)) + seed);
+        const std::uint64_t high = read64(data + size - 8) ^ ((read64(secret + 40) ^ read64(secret + 48)) - seed);
+        return avalanche(size + Endianness::swap(low) + high + multiplyFold(low, high));
+    }
+
+    if(size >= 4) {
+        seed ^= std::uint64_t(Endianness::swap(std::uint32_t(seed))) << 32;
+        const std::uint64_t input = read32(data + size - 4) + (std::uint64_t(read32(data)) << 32);
+        return rrmxmx(input ^ ((read64(secret + 8) ^ read64(secret + 16)) - seed), size);
+    }
+
+    if(size) {
+        const std::uint32_t combined =
+            std::uint32_t(static_cast<unsigned char>(data[0])) << 16 |
+            std::uint32_t(static_cast<unsigned char>(data[size >> 1])) << 24 |
+            std::uint32_t(static_cast<unsigned char>(data[size - 1])) |
+            std::uint32_t(size) << 8;
+        return avalancheXxh64(combined ^ ((read32(secret) ^ read32(secret + 4)) + seed));
+    }
+
+    return avalancheXxh64(seed ^ read64(secret + 56) ^ read64(secret + 64));
+}
+
+Uint128 hashShort128(const char* const data, const std::size_t size, const char* const secret, std::uint64_t seed) {
+    if(size > 16) {
+        Uint128 accumulator{size*Prime64_1, 0};
+        if(size > 128) {
+            for(std::size_t i = 32; i < 160; i += 32)
+                accumulator = mix32(accumulator, data + i - 32, data + i - 16, secret + i - 32, seed);
+            accumulator.low = avalanche(accumulator.low);
+            accumulator.high = avalanche(accumulator.high);
+            for(std::size_t i = 160; i <= size; i += 32)
+                accumulator = mix32(accumulator, data + i - 32, data + i - 16, secret + 3 + i - 160, seed);
+            accumulator = mix32(accumulator, data + size - 16, data + size - 32, secret + SecretSizeMin - 17 - 16, 0 - seed);
+        } else {
+            if(size > 32) {
+                if(size > 64) {
+                    if(size > 96)
+                        accumulator = mix32(accumulator, data + 48, data + size - 64, secret + 96, seed);
+                    accumulator = mix32(accumulator, data + 32, data + size - 48, secret + 64, seed);
+                }
+                accumulator = mix32(accumulator, data + 16, data + size - 32, secret + 32, seed);
+            }
+            accumulator = mix32(accumulator, data, data + size - 16, secret, seed);
+        }
+
+        return {
+            avalanche(accumulator.low + accumulator.high),
+            0 - avalanche(accumulator.low*Prime64_1 + accumulator.high*Prime64_4 + (size - seed)*Prime64_2)
+        };
+    }
+
+    if(size > 8) {
+        const std::uint64_t low = read64(data);
+        std::uint64_t high = read64(data + size - 8);
+        Uint128 m = multiply(low ^ high ^ ((read64(secret + 32) ^ read64(secret + 40)) - seed), Prime64_1);
+        m.low += std::uint64_t(size - 1) << 54;
+        high ^= (read64(secret + 48) ^ read64(secret + 56)) + seed;
+        m.high += high + std::uint64_t(std::uint32_t(high))*(Prime32_2 - 1);
+        m.low ^= Endianness::swap(m.high);
+        Uint128 h = multiply(m.low, Prime64_2);
+        h.high += m.high*Prime64_2;
+        return {avalanche(h.low), avalanche(h.high)};
+    }
+
+    if(size >= 4) {
+        seed ^= std::uint64_t(Endianness::swap(std::uint32_t(seed))) << 32;
+        const std::uint64_t input = read32(data) + (std::uint64_t(read32(data + size - 4)) << 32);
+        Uint128 m = multiply(input ^ ((read64(secret + 16) ^ read64(secret + 24)) + seed), Prime64_1 + (size << 2));
+        m.high += m.low << 1;
+        m.low ^= m.high >> 3;
+        m.low = xorShift(m.low, 35);
+        m.low *= PrimeMx2;
+        m.low = xorShift(m.low, 28);
+        m.high = avalanche(m.high);
+        return m;
+    }
+
+    if(size) {
+        const std::uint32_t combinedLow =
+            std::uint32_t(static_cast<unsigned char>(data[0])) << 16 |
+            std::uint32_t(static_cast<unsigned char>(data[size >> 1])) << 24 |
+            std::uint32_t(static_cast<unsigned char>(data[size - 1])) |
+            std::uint32_t(size) << 8;
+        const std::uint32_t combinedHigh = rotateLeft(Endianness::swap(combinedLow), 13);
+        return {
+            avalancheXxh64(combinedLow ^ ((read32(secret) ^ read32(secret + 4)) + seed)),
+            avalancheXxh64(combinedHigh ^ ((read32(secret + 8) ^ read32(secret + 12)) - seed))
+        };
+    }
+
+    return {
+        avalancheXxh64(seed ^ read64(secret + 64) ^ read64(secret + 72)),
+        avalancheXxh64(seed ^ read64(secret + 80) ^ read64(secret + 88))
+    };
+}
+
+void accumulateScalar(std::uint64_t* const accumulators, const char* data, const char* secret, std::size_t count) {
+    for(; count; --count, data += StripeSize, secret += 8) {
+        for(std::size_t i = 0; i != 8; ++i) {
+            const std::uint64_t value = read64(data + 8*i);
+            const std::uint64_t key = value ^ read64(secret + 8*i);
+            accumulators[i ^ 1] += value;
+            accumulators[i] += (key & 0xffffffffu)*(key >> 32);
+        }
+    }
+}
+
+#ifdef CORRADE_TARGET_X86
+CORRADE_ENABLE_SSE2 void accumulateSse2(std::uint64_t* const accumulators, const char* data, const char* secret, std::size_t count) {
+    __m128i a[4];
+    for(std::size_t i = 0; i != 4; ++i)
+        a[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(accumulators) + i);
+
+    for(; count; --count, data += StripeSize, secret += 8) {
+        for(std::size_t i = 0; i != 4; ++i) {
+            const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data) + i);
+            const __m128i key = _mm_xor_si128(value, _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret) + i));
+            /* Multiply the low and high 32-bit halves of each 64-bit lane,
+               add the value with the 64-bit lanes swapped */
+            const __m128i product = _mm_mul_epu32(key, _mm_shuffle_epi32(key, _MM_SHUFFLE(0, 3, 0, 1)));
+            a[i] = _mm_add_epi64(a[i], _mm_add_epi64(product, _mm_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2))));
+        }
+    }
+
+    for(std::size_t i = 0; i != 4; ++i)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(accumulators) + i, a[i]);
+}
+
+CORRADE_ENABLE_AVX2 void accumulateAvx2(std::uint64_t* const accumulators, const char* data, const char* secret, std::size_t count) {
+    __m256i a[2];
+    for(std::size_t i = 0; i != 2; ++i)
+        a[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(accumulators) + i);
+
+    for(; count; --count, data += StripeSize, secret += 8) {
+        for(std::size_t i = 0; i != 2; ++i) {
+            const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data) + i);
+            const __m256i key = _mm256_xor_si256(value, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret) + i));
+            const __m256i product = _mm256_mul_epu32(key, _mm256_shuffle_epi32(key, _MM_SHUFFLE(0, 3, 0, 1)));
+            a[i] = _mm256_add_epi64(a[i], _mm256_add_epi64(product, _mm256_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2))));
+        }
+    }
+
+    for(std::size_t i = 0; i != 2; ++i)
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(accumulators) + i, a[i]);
+}
+#endif
+
+Implementation::XxHash3AccumulateFunction accumulate() {
+    static const Implementation::XxHash3AccumulateFunction function = Implementation::xxHash3AccumulateFunction(Cpu::runtimeFeatures());
+    return function;
+}
+
+/* Done at the end of each block, with the last 64 bytes of the secret */
+void scramble(std::uint64_t* const accumulators, const char* const secret) {
+    for(std::size_t i = 0; i != 8; ++i)
+        accumulators[i] = (xorShift(accumulators[i], 47) ^ read64(secret + 8*i))*Prime32_1;
+}
+
+/* Accumulates given count of stripes, continuing from given stripe in the
+   current block and scrambling at the end of it. The count is expected to
+   not cross more than one block boundary. */
+void consumeStripes(std::uint64_t* const accumulators, std::size_t& stripes, const char* const data, const std::size_t count, const char* const secret) {
+    const Implementation::XxHash3AccumulateFunction function = accumulate();
+    if(StripesPerBlock - stripes <= count) {
+        const std::size_t stripesToBlockEnd = StripesPerBlock - stripes;
+        function(accumulators, data, secret + stripes*8, stripesToBlockEnd);
+        scramble(accumulators, secret + SecretSize - StripeSize);
+        function(accumulators, data + stripesToBlockEnd*StripeSize, secret, count - stripesToBlockEnd);
+        stripes = count - stripesToBlockEnd;
+    } else {
+        function(accumulators, data, secret + stripes*8, count);
+        stripes += count;
+    }
+}
+
+std::uint64_t mergeAccumulators(const std::uint64_t* const accumulators, const char* const secret, const std::uint64_t start) {
+    std::uint64_t result = start;
+    for(std::size_t i = 0; i != 4; ++i)
+        result += multiplyFold(
+            accumulators[2*i] ^ read64(secret + 16*i),
+            accumulators[2*i + 1] ^ read64(secret + 16*i + 8));
+    return avalanche(result);
+}
+
+inline void digestInto(char* const out, const std::uint64_t value) {
+    const std::uint64_t bigEndian = Endianness::bigEndian(value);
+    std::memcpy(out, &bigEndian, 8);
+}
+
+}
+
+namespace Implementation {
+
+XxHash3AccumulateFunction xxHash3AccumulateFunction(const Cpu::Features features) {
+    return Cpu::dispatch<XxHash3AccumulateFunction>(features, {
+        #ifdef CORRADE_TARGET_X86
+        {Cpu::Feature::Avx2, accumulateAvx2},
+        {Cpu::Feature::Sse2, accumulateSse2},
+        #endif
+    }, accumulateScalar);
+}
+
+}
+
+template<std::size_t digestSize> XxHash3<digestSize>::XxHash3(const std::uint64_t seed): _seed{seed} {
+    /* With a zero seed the default secret is used, otherwise one derived
+       from the seed. The seed is used directly only for short inputs, which
+       use the default secret always. */
+    const char* const secret = reinterpret_cast<const char*>(DefaultSecret);
+    for(std::size_t i = 0; i != SecretSize/16; ++i) {
+        write64(_secret + 16*i, read64(secret + 16*i) + seed);
+        write64(_secret + 16*i + 8, read64(secret + 16*i + 8) - seed);
+    }
+
+    reset();
+}
+
+template<std::size_t digestSize> void XxHash3<digestSize>::reset() {
+    _dataSize = 0;
+    _bufferSize = 0;
+    _stripes = 0;
+    _accumulators[0] = Prime32_3;
+    _accumulators[1] = Prime64_1;
+    _accumulators[2] = Prime64_2;
+    _accumulators[3] = Prime64_3;
+    _accumulators[4] = Prime64_4;
+    _accumulators[5] = Prime32_2;
+    _accumulators[6] = Prime64_5;
+    _accumulators[7] = Prime32_1;
+}
+
+template<std::size_t digestSize> XxHash3<digestSize>& XxHash3<digestSize>::operator<<(const Containers::ArrayView<const char> data) {
+    _dataSize += data.size();
+
+    /* Not enough data to fill the buffer, try it next time */
+    if(_bufferSize + data.size() <= BufferSize) {
+        std::memcpy(_buffer + _bufferSize, data.data(), data.size());
+        _bufferSize += data.size();
+        return *this;
+    }
+
+    /* Fill the buffer and process it. Some data remain after, so it's not the
+       last stripe. */
+    const char* input = data.data();
+    const char* const end = input + data.size();
+    if(_bufferSize) {
+        const std::size_t size = BufferSize - _bufferSize;
+        std::memcpy(_buffer + _bufferSize, input, size);
+        input += size;
+        consumeStripes(_accumulators, _stripes, _buffer, BufferSize/StripeSize, _secret);
+        _bufferSize = 0;
+    }
+
+    /* Process the data directly buffer-sized chunk at a time, always leaving
+       something for the last stripe. Save the last stripe before the
+       leftover in case the leftover is shorter than a stripe. */
+    if(end - input > std::ptrdiff_t(BufferSize)) {
+        do {
+            consumeStripes(_accumulators, _stripes, input, BufferSize/StripeSize, _secret);
+            input += BufferSize;
+        } while(end - input > std::ptrdiff_t(BufferSize));
+        std::memcpy(_buffer + BufferSize - StripeSize, input - StripeSize, StripeSize);
+    }
+
+    std::memcpy(_buffer, input, end - input);
+    _bufferSize = end - input;
+    return *this;
+}
+
+template<std::size_t digestSize> XxHash3<digestSize>& XxHash3<digestSize>::operator<<(const std::string& data) {
+    return *this << Containers::arrayView(data.data(), data.size());
+}
+
+template<std::size_t digestSize> auto XxHash3<digestSize>::digest() -> Digest {
+    char out[digestSize];
+
+    /* Short inputs are hashed directly from the buffer */
+    if(_dataSize <= MidSizeMax) {
+        const char* const secret = reinterpret_cast<const char*>(DefaultSecret);
+        if(digestSize == 8)
+            digestInto(out, hashShort64(_buffer, _bufferSize, secret, _seed));
+        else {
+            const Uint128 hash = hashShort128(_buffer, _bufferSize, secret, _seed);
+            digestInto(out, hash.high);
+            digestInto(out + 8, hash.low);
+        }
+
+    /* Otherwise process the remaining stripes in the buffer, then the last
+       stripe, which may overlap with already processed data */
+    } else {
+        const Implementation::XxHash3AccumulateFunction function = accumulate();
+        const char* const lastStripeSecret = _secret + SecretSize - StripeSize - 7;
+        if(_bufferSize >= StripeSize) {
+            consumeStripes(_accumulators, _stripes, _buffer, (_bufferSize - 1)/StripeSize, _secret);
+            function(_accumulators, _buffer + _bufferSize - StripeSize, lastStripeSecret, 1);
+        } else {
+            char lastStripe[StripeSize];
+            const std::size_t catchupSize = StripeSize - _bufferSize;
+            std::memcpy(lastStripe, _buffer + BufferSize - catchupSize, catchupSize);
+            std::memcpy(lastStripe + catchupSize, _buffer, _bufferSize);
+            function(_accumulators, lastStripe, lastStripeSecret, 1);
+        }
+
+        const std::uint64_t low = mergeAccumulators(_accumulators, _secret + 11, _dataSize*Prime64_1);
+        if(digestSize == 8)
+            digestInto(out, low);
+        else {
+            digestInto(out, mergeAccumulators(_accumulators, _secret + SecretSize - StripeSize - 11, ~(_dataSize*Prime64_2)));
+            digestInto(out + 8, low);
+        }
+    }
+
+    reset();
+    return Digest::fromByteArray(out);
+}
+
+template class XxHash3<8>;
+template class XxHash3<16>;
+
+}}
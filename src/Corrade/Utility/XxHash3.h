@@ -0,0 +1,127 @@
+#ifndef Corrade_Utility_XxHash3_h
+#define Corrade_Utility_XxHash3_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Utility::XxHash3
+ * @m_since_latest
+ */
+
+#include <cstdint>
+
+#include "Corrade/Containers/Containers.h"
+#include "Corrade/Utility/AbstractHash.h"
+#include "Corrade/Utility/StlForwardString.h"
+#include "Corrade/Utility/visibility.h"
+
+namespace Corrade { namespace Utility {
+
+/**
+@brief XXH3 hash
+@tparam digestSize  Digest size in bytes, either @cpp 8 @ce for the 64-bit
+    or @cpp 16 @ce for the 128-bit variant
+@m_since_latest
+
+Implementation of the non-cryptographic [XXH3](https://github.com/Cyan4973/xxHash)
+hash, version 0.8. Compared to @ref MurmurHash2 it's significantly faster on
+long inputs, supports both 64- and 128-bit digests and can be calculated
+incrementally. Example usage:
+
+@snippet Utility.cpp XxHash3-usage
+
+The digest is in the canonical big-endian representation, i.e. matching what
+`xxhsum -H3` and `xxhsum -H2` print. A non-zero seed can be passed to the
+constructor, giving the same result as the reference `XXH3_64bits_withSeed()`
+and `XXH3_128bits_withSeed()`.
+
+@section Utility-XxHash3-acceleration Hardware acceleration
+
+Inputs longer than 240 bytes are processed with AVX2 or SSE2 if
+@ref Cpu::runtimeFeatures() reports @ref Cpu::Feature::Avx2 or
+@ref Cpu::Feature::Sse2, and with a portable implementation otherwise. Data
+passed to @ref operator<<(Containers::ArrayView<const char>) are processed
+directly, only the last up to 256 bytes are copied to an internal buffer.
+*/
+template<std::size_t digestSize> class CORRADE_UTILITY_EXPORT XxHash3: public AbstractHash<digestSize> {
+    static_assert(digestSize == 8 || digestSize == 16,
+        "only 64-bit and 128-bit XXH3 is supported");
+
+    public:
+        /** @brief Digest type */
+        typedef typename AbstractHash<digestSize>::Digest Digest;
+
+        /**
+         * @brief Digest of given data
+         *
+         * Convenience function for @cpp (Utility::XxHash3<digestSize>{} << data).digest() @ce.
+         */
+        static Digest digest(const std::string& data) {
+            return (XxHash3<digestSize>{} << data).digest();
+        }
+
+        /**
+         * @brief Constructor
+         * @param seed      Seed to initialize the hash
+         */
+        explicit XxHash3(std::uint64_t seed = 0);
+
+        /** @brief Add data for digesting */
+        XxHash3<digestSize>& operator<<(Containers::ArrayView<const char> data);
+
+        /** @overload */
+        XxHash3<digestSize>& operator<<(const std::string& data);
+
+        /**
+         * @brief @cpp operator<< @ce with C strings is not allowed
+         *
+         * To clarify your intent with handling the @cpp '\0' @ce delimiter,
+         * cast to @ref Containers::ArrayView or @ref std::string instead.
+         */
+        XxHash3<digestSize>& operator<<(const char*) = delete;
+
+        /**
+         * @brief Digest of all added data
+         *
+         * Resets the state afterwards, so the instance can be reused for
+         * hashing other data with the same seed.
+         */
+        Digest digest();
+
+    private:
+        void reset();
+
+        std::uint64_t _seed;
+        std::uint64_t _dataSize;
+        std::size_t _bufferSize;
+        std::size_t _stripes;
+        std::uint64_t _accumulators[8];
+        char _secret[192];
+        char _buffer[256];
+};
+
+}}
+
+#endif
@@ -57,7 +57,7 @@ for more information.
 @section corrade-rc-usage Usage
 
 @code{.sh}
-corrade-rc [-h|--help] [--] name resources.conf outfile.cpp
+corrade-rc [-h|--help] [--incbin] [--pack] [--] name resources.conf outfile.cpp
 @endcode
 
 Arguments:
@@ -66,32 +66,74 @@ Arguments:
     for format description)
 -   `outfile.cpp` --- output file
 -   `-h`, `--help` --- display this help message and exit
+-   `--incbin` --- put the data into a separate `outfile.cpp.bin` file that's
+    referenced from `outfile.cpp` using the assembler @cb{.asm} .incbin @ce
+    directive instead of embedding them as a hexadecimal array, see
+    @ref Utility::Resource::compileFrom(const std::string&, const std::string&, const std::string&, std::string&)
+    for details
+-   `--pack` --- produce a standalone resource pack instead of a C++ file,
+    to be loaded at runtime with @ref Utility::Resource::loadPack(). The
+    `name` argument is ignored in that case, see
+    @ref Utility::Resource::compilePackFrom() for details
+
+The output files are written only if their contents differ from what's
+already there, so an unchanged resource doesn't cause the dependent code to be
+recompiled. If the compilation fails, the output files are removed.
 */
 
 }
 
 #ifndef DOXYGEN_GENERATING_OUTPUT /* LCOV_EXCL_START */
+namespace {
+
+/* Saves the file only if its contents differ, to avoid unnecessary rebuilds */
+bool writeIfChanged(const std::string& filename, const std::string& data) {
+    if(Corrade::Utility::Directory::exists(filename) && Corrade::Utility::Directory::readString(filename) == data)
+        return true;
+    return Corrade::Utility::Directory::writeString(filename, data);
+}
+
+}
+
 int main(int argc, char** argv) {
     Corrade::Utility::Arguments args;
     args.addArgument("name")
         .addArgument("conf").setHelp("conf", "resource configuration file", "resources.conf")
         .addArgument("out").setHelp("out", "output file", "outfile.cpp")
+        .addBooleanOption("incbin").setHelp("incbin", "put the data into a separate file referenced via .incbin")
+        .addBooleanOption("pack").setHelp("pack", "produce a resource pack loadable at runtime instead of a C++ file")
         .setCommand("corrade-rc")
         .setGlobalHelp("Resource compiler for Corrade.")
         .parse(argc, argv);
 
-    /* Remove previous output file */
-    Corrade::Utility::Directory::rm(args.value("out"));
+    /* The data file is referenced from the generated code, so it needs an
+       absolute path */
+    const std::string out = args.value("out");
+    const std::string incbinOut = args.isSet("incbin") && !args.isSet("pack") ? Corrade::Utility::Directory::join(Corrade::Utility::Directory::current(), out + ".bin") : std::string{};
 
     /* Compile file */
-    const std::string compiled = Corrade::Utility::Resource::compileFrom(args.value("name"), args.value("conf"));
-
-    /* Compilation failed */
-    if(compiled.empty()) return 2;
+    std::string incbinData;
+    const std::string compiled = args.isSet("pack") ?
+        Corrade::Utility::Resource::compilePackFrom(args.value("conf")) :
+        args.isSet("incbin") ?
+        Corrade::Utility::Resource::compileFrom(args.value("name"), args.value("conf"), incbinOut, incbinData) :
+        Corrade::Utility::Resource::compileFrom(args.value("name"), args.value("conf"));
+
+    /* Compilation failed, remove previous output files */
+    if(compiled.empty()) {
+        Corrade::Utility::Directory::rm(out);
+        if(!incbinOut.empty()) Corrade::Utility::Directory::rm(incbinOut);
+        return 2;
+    }
 
-    /* Save output */
-    if(!Corrade::Utility::Directory::writeString(args.value("out"), compiled)) {
-        Corrade::Utility::Error() << "Cannot write output file " << '\'' + args.value("out") + '\'';
+    /* Save output. Data first, so a failure doesn't leave a source file
+       referencing a stale data file. */
+    if(!incbinOut.empty() && !writeIfChanged(incbinOut, incbinData)) {
+        Corrade::Utility::Error() << "Cannot write output file " << '\'' + incbinOut + '\'';
+        return 3;
+    }
+    if(!writeIfChanged(out, compiled)) {
+        Corrade::Utility::Error() << "Cannot write output file " << '\'' + out + '\'';
         return 3;
     }
 
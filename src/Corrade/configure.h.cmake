@@ -42,6 +42,7 @@
 #cmakedefine CORRADE_TARGET_EMSCRIPTEN
 #cmakedefine CORRADE_TARGET_ANDROID
 
+#cmakedefine CORRADE_INTERCONNECT_PROFILE
 #cmakedefine CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
 #cmakedefine CORRADE_TESTSUITE_TARGET_XCTEST
 #cmakedefine CORRADE_UTILITY_USE_ANSI_COLORS